@@ -26,7 +26,7 @@ with GPU acceleration.
 import sys as _sys
 
 import numpy as _np
-from cunumeric import linalg, random
+from cunumeric import fft, linalg, random, sparse
 from cunumeric.array import ndarray
 from cunumeric.module import *
 from cunumeric.ufunc import *
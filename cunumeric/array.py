@@ -13,6 +13,7 @@
 # limitations under the License.
 #
 
+import sys
 import warnings
 from collections.abc import Iterable
 from functools import reduce
@@ -30,6 +31,54 @@ from .runtime import runtime
 from .utils import unimplemented
 
 
+class _RefcountProbe(object):
+    def refcount(self):
+        return sys.getrefcount(self)
+
+
+# The reference count that a method sees for an object that only the
+# expression calling the method holds, as in (a + b).copy(). Such an object
+# dies as soon as the method returns.
+_TEMPORARY_REFCOUNT = _RefcountProbe().refcount()
+
+# Operand type pairs for which binary ops convert the narrower operand as it
+# is loaded instead of through a temporary. Match these to BinaryOpPromotion
+# in binary_op_util.h
+_binary_op_promotions = {
+    (np.dtype(np.int32), np.dtype(np.int64)),
+    (np.dtype(np.int32), np.dtype(np.float64)),
+    (np.dtype(np.int64), np.dtype(np.float64)),
+    (np.dtype(np.float32), np.dtype(np.float64)),
+    (np.dtype(np.uint8), np.dtype(np.int32)),
+    (np.dtype(np.uint8), np.dtype(np.int64)),
+    (np.dtype(np.uint8), np.dtype(np.float32)),
+    (np.dtype(np.uint8), np.dtype(np.float64)),
+    (np.dtype(np.uint16), np.dtype(np.int32)),
+    (np.dtype(np.uint16), np.dtype(np.int64)),
+    (np.dtype(np.uint16), np.dtype(np.float32)),
+    (np.dtype(np.uint16), np.dtype(np.float64)),
+}
+
+# The unary ops that produce the real magnitudes of complex inputs
+_MAGNITUDE_UNARY_OPS = (UnaryOpCode.ABSOLUTE, UnaryOpCode.ABS2)
+
+# Sums and products of narrow unsigned inputs that the reduction tasks
+# accumulate in a wider output type directly. Match these to
+# unary_red_widens in unary_red_util.h
+_unary_red_widenings = {
+    (np.dtype(src), np.dtype(dst))
+    for src in (np.uint8, np.uint16)
+    for dst in (
+        np.int32,
+        np.int64,
+        np.uint32,
+        np.uint64,
+        np.float32,
+        np.float64,
+    )
+}
+
+
 def add_boilerplate(*array_params: str, mutates_self: bool = False):
     """
     Adds required boilerplate to the wrapped cuNumeric ndarray member function.
@@ -103,13 +152,16 @@ def add_boilerplate(*array_params: str, mutates_self: bool = False):
 
             # Handle the case where all array-like parameters are scalar, by
             # performing the operation on the equivalent scalar numpy arrays.
-            # NOTE: This implicitly blocks on the contents of these arrays.
+            # Only scalars whose values are already known here take this path;
+            # scalars still being computed by tasks (e.g. the results of
+            # reductions) go through the deferred path so that nothing blocks
+            # until Python actually asks for the value.
             if all(
-                arg._thunk.scalar
+                arg._thunk.scalar and arg._thunk.value_known
                 for (idx, arg) in enumerate(args)
                 if (idx in indices or idx == 0) and isinstance(arg, ndarray)
             ) and all(
-                v._thunk.scalar
+                v._thunk.scalar and v._thunk.value_known
                 for (k, v) in kwargs.items()
                 if (k in keys or k == "where") and isinstance(v, ndarray)
             ):
@@ -676,7 +728,7 @@ class ndarray(object):
         )
 
     def __matmul__(self, value):
-        return self.dot(value, stacklevel=2)
+        return self._matmul(value, stacklevel=2)
 
     def __mod__(self, rhs):
         rhs_array = self.convert_to_cunumeric_ndarray(rhs)
@@ -713,6 +765,11 @@ class ndarray(object):
             ndarray(shape=thunk.shape, thunk=thunk) for thunk in thunks
         )
 
+    @add_boilerplate()
+    def argwhere(self, stacklevel=1):
+        thunk = self._thunk.argwhere(stacklevel=stacklevel + 1)
+        return ndarray(shape=thunk.shape, thunk=thunk)
+
     def __nonzero__(self):
         return self.__array__(stacklevel=2).__nonzero__()
 
@@ -932,12 +989,10 @@ class ndarray(object):
         )
         return self.convert_to_cunumeric_ndarray(numpy_array, stacklevel=3)
 
-    @unimplemented
-    def argsort(self, axis=-1, kind=None, order=None):
-        numpy_array = self.__array__(stacklevel=3).argsort(
-            axis=axis, kind=kind, order=order
+    def argsort(self, axis=-1, kind=None, order=None, stacklevel=1):
+        return self._sort(
+            axis, kind, order, argsort=True, stacklevel=(stacklevel + 1)
         )
-        return self.convert_to_cunumeric_ndarray(numpy_array, stacklevel=3)
 
     def astype(
         self, dtype, order="C", casting="unsafe", subok=True, copy=True
@@ -1040,7 +1095,7 @@ class ndarray(object):
         else:
             return out_arr
 
-    def cholesky(self, no_tril=False, stacklevel=1):
+    def cholesky(self, no_tril=False, info=None, stacklevel=1):
         input = self
         if input.dtype.kind not in ("f", "c"):
             input = input.astype("float64")
@@ -1050,9 +1105,29 @@ class ndarray(object):
             stacklevel=stacklevel + 1,
             inputs=(input,),
         )
+        flag = None
+        if info is not None:
+            if info.shape != ():
+                raise ValueError("info must be a 0-d array")
+            if info.dtype == np.int32:
+                flag = info
+            else:
+                flag = ndarray(
+                    shape=(),
+                    dtype=np.int32,
+                    stacklevel=stacklevel + 1,
+                    inputs=(input,),
+                )
         output._thunk.cholesky(
-            input._thunk, no_tril=no_tril, stacklevel=(stacklevel + 1)
+            input._thunk,
+            no_tril=no_tril,
+            info=None if flag is None else flag._thunk,
+            stacklevel=(stacklevel + 1),
         )
+        if flag is not None and flag is not info:
+            info._thunk.convert(
+                flag._thunk, stacklevel=(stacklevel + 1), warn=False
+            )
         return output
 
     def clip(self, min=None, max=None, out=None):
@@ -1099,9 +1174,11 @@ class ndarray(object):
     def conjugate(self, stacklevel=1):
         return self.conj(stacklevel)
 
-    def convolve(self, v, mode, stacklevel=1):
+    def convolve(
+        self, v, mode, out=None, stride=1, dilation=1, stacklevel=1
+    ):
         assert mode == "same"
-        if self.ndim != v.ndim:
+        if self.ndim < v.ndim:
             raise RuntimeError("Arrays should have the same dimensions")
         elif self.ndim > 3:
             raise NotImplementedError(
@@ -1110,34 +1187,120 @@ class ndarray(object):
 
         if self.dtype != v.dtype:
             v = v.astype(self.dtype)
-        out = ndarray(
-            shape=self.shape,
-            dtype=self.dtype,
-            stacklevel=(stacklevel + 1),
-            inputs=(self, v),
+        # The leading axes that the filter lacks are batch axes, along which
+        # every signal is convolved with the same filter
+        if self.ndim > v.ndim:
+            v = v.reshape((1,) * (self.ndim - v.ndim) + v.shape)
+        stride = self._convolve_steps(stride, "stride")
+        dilation = self._convolve_steps(dilation, "dilation")
+        # A strided convolution keeps every stride-th point of the plain one
+        shape = tuple(
+            (extent + step - 1) // step
+            for extent, step in zip(self.shape, stride)
         )
+        if out is not None:
+            out = self.convert_to_cunumeric_ndarray(
+                out, stacklevel=(stacklevel + 1), share=True
+            )
+            if out.shape != shape:
+                raise ValueError("Output array has the wrong shape")
+            if out.dtype != self.dtype:
+                raise TypeError("Output array has the wrong type")
+        else:
+            out = ndarray(
+                shape=shape,
+                dtype=self.dtype,
+                stacklevel=(stacklevel + 1),
+                inputs=(self, v),
+            )
         self._thunk.convolve(
-            v._thunk, out._thunk, mode, stacklevel=(stacklevel + 1)
+            v._thunk,
+            out._thunk,
+            mode,
+            stride,
+            dilation,
+            stacklevel=(stacklevel + 1),
         )
         return out
 
+    def _convolve_steps(self, steps, name):
+        # Strides and dilations are either one for all axes or one per axis
+        if isinstance(steps, int):
+            steps = (steps,) * self.ndim
+        steps = tuple(steps)
+        if len(steps) != self.ndim:
+            raise ValueError(f"{name} must have one entry per axis")
+        if any(step < 1 for step in steps):
+            raise ValueError(f"{name} must be positive")
+        return steps
+
     def copy(self, order="C"):
+        # A temporary whose thunk nothing else can see hands the thunk over
+        # to the copy, which saves both the copy and a second store
+        if (
+            sys.getrefcount(self) <= _TEMPORARY_REFCOUNT
+            and self._thunk.exclusive
+        ):
+            return ndarray(shape=None, thunk=self._thunk)
         # We don't care about dimension order in cuNumeric
         return self.__copy__()
 
-    @unimplemented
-    def cumprod(self, axis=None, dtype=None, out=None):
-        numpy_array = self.__array__(stacklevel=3).cumprod(
-            axis=axis, dtype=dtype, out=out
+    def cumprod(self, axis=None, dtype=None, out=None, stacklevel=1):
+        return self._scan(
+            UnaryRedCode.PROD, axis, dtype, out, stacklevel=(stacklevel + 1)
         )
-        return self.convert_to_cunumeric_ndarray(numpy_array, stacklevel=3)
 
-    @unimplemented
-    def cumsum(self, axis=None, dtype=None, out=None):
-        numpy_array = self.__array__(stacklevel=3).cumsum(
-            axis=axis, dtype=dtype, out=out
+    def cumsum(self, axis=None, dtype=None, out=None, stacklevel=1):
+        return self._scan(
+            UnaryRedCode.SUM, axis, dtype, out, stacklevel=(stacklevel + 1)
         )
-        return self.convert_to_cunumeric_ndarray(numpy_array, stacklevel=3)
+
+    # Inclusive scan along an axis or, when it is None, of the flattened
+    # array. Sums and products of booleans and narrow integers accumulate
+    # in the default integer types, as in NumPy.
+    def _scan(self, op, axis, dtype, out, stacklevel):
+        if axis is None:
+            array = self.ravel(stacklevel=(stacklevel + 1))
+            axis = 0
+        else:
+            if self.ndim == 0:
+                raise ValueError("Illegal 'axis' value")
+            if axis < 0:
+                axis = self.ndim + axis
+            if axis < 0 or axis >= self.ndim:
+                raise ValueError("Illegal 'axis' value")
+            array = self
+        if dtype is not None:
+            dtype = np.dtype(dtype)
+        elif op not in (UnaryRedCode.SUM, UnaryRedCode.PROD):
+            dtype = self.dtype
+        elif self.dtype.kind in ("b", "i") and self.dtype.itemsize < 8:
+            dtype = np.dtype(np.int64)
+        elif self.dtype.kind == "u" and self.dtype.itemsize < 8:
+            dtype = np.dtype(np.uint64)
+        else:
+            dtype = self.dtype
+        if array.dtype != dtype:
+            array = array.astype(dtype)
+
+        result = ndarray(array.shape, dtype=dtype, inputs=(array,))
+        result._thunk.scan(
+            array._thunk, op, axis, stacklevel=(stacklevel + 1)
+        )
+        if out is None:
+            return result
+        if out.shape != result.shape:
+            raise ValueError(
+                f"output array of shape {out.shape} does not match the "
+                f"result of shape {result.shape}"
+            )
+        if out.dtype != dtype:
+            out._thunk.convert(result._thunk, stacklevel=(stacklevel + 1))
+        else:
+            out._thunk.copy(
+                result._thunk, deep=True, stacklevel=(stacklevel + 1)
+            )
+        return out
 
     @unimplemented
     def diagonal(self, offset=0, axis1=0, axis2=1):
@@ -1267,6 +1430,148 @@ class ndarray(object):
         else:
             return out
 
+    # The optional scale, bias and activation are applied to the products
+    # as an epilogue of the GEMMs, before the result is stored
+    def _matmul(
+        self,
+        rhs,
+        out=None,
+        scale=1.0,
+        bias=None,
+        activation=UnaryOpCode.COPY,
+        stacklevel=1,
+    ):
+        rhs_array = self.convert_to_cunumeric_ndarray(
+            rhs, stacklevel=(stacklevel + 1)
+        )
+        if self.ndim == 0 or rhs_array.ndim == 0:
+            raise ValueError(
+                "matmul: Input operand does not have enough dimensions"
+            )
+        rhs_ndim = rhs_array.ndim
+        epilogue = (
+            scale != 1.0 or bias is not None or activation != UnaryOpCode.COPY
+        )
+        if not epilogue and self.ndim <= 2 and rhs_array.ndim <= 2:
+            return self.dot(rhs_array, out=out, stacklevel=(stacklevel + 1))
+
+        out_dtype = self.find_common_type(self, rhs_array)
+        if bias is not None:
+            bias = self.convert_to_cunumeric_ndarray(
+                bias, stacklevel=(stacklevel + 1)
+            )
+            n = rhs_array.shape[-1] if rhs_ndim > 1 else 1
+            if bias.shape != (n,):
+                raise ValueError(
+                    f"matmul bias must have shape ({n},), got {bias.shape}"
+                )
+            out_dtype = self.find_common_type(self, rhs_array, bias)
+        if out_dtype not in (np.float16, np.float32, np.float64):
+            raise NotImplementedError(
+                f"matmul of stacked matrices of type {out_dtype}"
+            )
+
+        # Without an inner dimension there are no GEMMs to fuse into, and
+        # the zero products leave only the bias and the activation
+        if epilogue and self.shape[-1] == 0:
+            result = self._matmul(rhs_array, stacklevel=(stacklevel + 1))
+            if result.dtype != out_dtype:
+                result = result.astype(out_dtype)
+            if bias is not None:
+                result = self.perform_binary_op(
+                    BinaryOpCode.ADD,
+                    result,
+                    bias,
+                    stacklevel=(stacklevel + 1),
+                )
+            if activation != UnaryOpCode.COPY:
+                result = self.perform_unary_op(
+                    activation, result, stacklevel=(stacklevel + 1)
+                )
+            if out is None:
+                return result
+            out._thunk.copy(
+                result._thunk, deep=False, stacklevel=(stacklevel + 1)
+            )
+            return out
+
+        # Vectors are promoted to matrices and the extra dimension dropped
+        # from the result at the end, like NumPy does
+        lhs_array = self
+        if lhs_array.ndim == 1:
+            lhs_array = lhs_array.reshape((1,) + lhs_array.shape)
+        if rhs_array.ndim == 1:
+            rhs_array = rhs_array.reshape(rhs_array.shape + (1,))
+        if lhs_array.shape[-1] != rhs_array.shape[-2]:
+            raise ValueError("Dimension mismatch for matmul")
+
+        batch_shape = broadcast_shapes(
+            lhs_array.shape[:-2], rhs_array.shape[:-2]
+        )
+        out_shape = batch_shape
+        if self.ndim > 1:
+            out_shape += (lhs_array.shape[-2],)
+        if rhs_ndim > 1:
+            out_shape += (rhs_array.shape[-1],)
+        if out is not None and out.shape != out_shape:
+            raise ValueError("Dimension mismatch for matmul")
+
+        # The task wants both operands in the output type and with the full
+        # batch shape, so broadcast operands get materialized here
+        def prepare(array):
+            shape = batch_shape + array.shape[-2:]
+            if array.dtype != out_dtype:
+                temp = ndarray(
+                    shape=array.shape,
+                    dtype=out_dtype,
+                    stacklevel=(stacklevel + 2),
+                    inputs=(array,),
+                )
+                temp._thunk.convert(array._thunk, stacklevel=(stacklevel + 2))
+                array = temp
+            if array.shape == shape:
+                return array
+            result = ndarray(
+                shape=shape,
+                dtype=out_dtype,
+                stacklevel=(stacklevel + 2),
+                inputs=(array,),
+            )
+            result._thunk.copy(
+                array._thunk, deep=False, stacklevel=(stacklevel + 2)
+            )
+            return result
+
+        lhs_array = prepare(lhs_array)
+        rhs_array = prepare(rhs_array)
+
+        result = ndarray(
+            shape=batch_shape + (lhs_array.shape[-2], rhs_array.shape[-1]),
+            dtype=out_dtype,
+            stacklevel=(stacklevel + 1),
+            inputs=(lhs_array, rhs_array),
+        )
+        result._thunk.batched_matmul(
+            lhs_array._thunk,
+            rhs_array._thunk,
+            scale=scale,
+            bias=None if bias is None else bias._thunk,
+            activation=activation,
+            stacklevel=(stacklevel + 1),
+        )
+        if result.shape != out_shape:
+            result = result.reshape(out_shape, stacklevel=(stacklevel + 1))
+
+        if out is None:
+            return result
+        if out.dtype != out_dtype:
+            out._thunk.convert(result._thunk, stacklevel=(stacklevel + 1))
+        else:
+            out._thunk.copy(
+                result._thunk, deep=False, stacklevel=(stacklevel + 1)
+            )
+        return out
+
     def dump(self, file):
         self.__array__(stacklevel=2).dump(file=file)
 
@@ -1445,6 +1750,7 @@ class ndarray(object):
             UnaryRedCode.PROD,
             self_array,
             axis=axis,
+            dtype=dtype,
             dst=out,
             keepdims=keepdims,
             initial=initial,
@@ -1452,12 +1758,39 @@ class ndarray(object):
             stacklevel=(stacklevel + 1),
         )
 
-    @unimplemented
-    def ptp(self, axis=None, out=None, keepdims=False):
-        numpy_array = self.__array__(stacklevel=3).ptp(
-            axis=axis, out=out, keepdims=keepdims
+    @add_boilerplate()
+    def ptp(self, axis=None, out=None, keepdims=False, stacklevel=1):
+        if self.dtype.kind == "c":
+            # Complex values are not ordered by our min/max reductions
+            numpy_array = self.__array__(stacklevel=(stacklevel + 1)).ptp(
+                axis=axis, keepdims=keepdims
+            )
+            result = self.convert_to_cunumeric_ndarray(
+                numpy_array, stacklevel=(stacklevel + 1)
+            )
+            if out is None:
+                return result
+            return self.perform_unary_op(
+                UnaryOpCode.COPY,
+                result,
+                dst=out,
+                stacklevel=(stacklevel + 1),
+            )
+        # The minimum and the maximum come out of the same pass
+        minimum, maximum = self.perform_multi_reduction(
+            (UnaryRedCode.MIN, UnaryRedCode.MAX),
+            self,
+            axis=axis,
+            keepdims=keepdims,
+            stacklevel=(stacklevel + 1),
+        )
+        return self.perform_binary_op(
+            BinaryOpCode.SUBTRACT,
+            maximum,
+            minimum,
+            out=out,
+            stacklevel=(stacklevel + 1),
         )
-        return self.convert_to_cunumeric_ndarray(numpy_array, stacklevel=3)
 
     @unimplemented
     def put(self, indices, values, mode="raise"):
@@ -1468,10 +1801,43 @@ class ndarray(object):
     def ravel(self, order="C", stacklevel=1):
         return self.reshape(-1, order=order, stacklevel=(stacklevel + 1))
 
-    @unimplemented
-    def repeat(self, repeats, axis=None):
-        numpy_array = self.__array__(stacklevel=3).repeat(repeats, axis=axis)
-        return self.convert_to_cunumeric_ndarray(numpy_array, stacklevel=3)
+    def repeat(self, repeats, axis=None, stacklevel=1):
+        # Only a single repeat count for every element is handled natively
+        if np.size(repeats) != 1 or np.ndim(repeats) > 1:
+            numpy_array = unimplemented(np.repeat)(
+                self.__array__(stacklevel=(stacklevel + 2)),
+                repeats,
+                axis=axis,
+            )
+            return self.convert_to_cunumeric_ndarray(
+                numpy_array, stacklevel=(stacklevel + 2)
+            )
+        repeats = int(np.asarray(repeats).item())
+        if repeats < 0:
+            raise ValueError("negative dimensions are not allowed")
+        if axis is None:
+            array = self.ravel(stacklevel=(stacklevel + 1))
+            axis = 0
+        else:
+            if self.ndim == 0:
+                raise ValueError("Illegal 'axis' value")
+            if axis < 0:
+                axis = self.ndim + axis
+            if axis < 0 or axis >= self.ndim:
+                raise ValueError("Illegal 'axis' value")
+            array = self
+        shape = list(array.shape)
+        shape[axis] *= repeats
+        result = ndarray(
+            shape=tuple(shape),
+            dtype=self.dtype,
+            stacklevel=(stacklevel + 1),
+            inputs=(array,),
+        )
+        result._thunk.repeat(
+            array._thunk, repeats, axis, stacklevel=(stacklevel + 1)
+        )
+        return result
 
     def reshape(self, shape, order="C", stacklevel=1):
         if shape != -1:
@@ -1547,12 +1913,46 @@ class ndarray(object):
         )
         return self.convert_to_cunumeric_ndarray(numpy_array, stacklevel=3)
 
-    @unimplemented
-    def searchsorted(self, v, side="left", sorter=None):
-        numpy_array = self.__array__(stacklevel=3).searchsorted(
-            v=v, side=side, sorter=sorter
+    def searchsorted(self, v, side="left", sorter=None, stacklevel=1):
+        if self.ndim != 1:
+            raise ValueError("searchsorted needs a 1-D array")
+        if side not in ("left", "right"):
+            raise ValueError(f"side must be 'left' or 'right', got {side}")
+        if sorter is not None:
+            sorter = ndarray.convert_to_cunumeric_ndarray(sorter)
+            array = self[sorter]
+        else:
+            array = self
+        v = ndarray.convert_to_cunumeric_ndarray(v)
+        if self.dtype.kind == "c" or v.dtype.kind == "c":
+            warnings.warn(
+                "cuNumeric has not implemented searchsorted for complex "
+                "arrays and is falling back to canonical numpy. You may "
+                "notice significantly decreased performance for this "
+                "function call.",
+                stacklevel=(stacklevel + 1),
+                category=RuntimeWarning,
+            )
+            numpy_array = array.__array__(stacklevel=(stacklevel + 1))
+            result = numpy_array.searchsorted(
+                v.__array__(stacklevel=(stacklevel + 1)), side=side
+            )
+            return self.convert_to_cunumeric_ndarray(
+                result, stacklevel=(stacklevel + 1)
+            )
+
+        dtype = np.result_type(array.dtype, v.dtype)
+        if array.dtype != dtype:
+            array = array.astype(dtype)
+        if v.dtype != dtype:
+            v = v.astype(dtype)
+        # Scalar values are looked up as a single element array
+        values = v.reshape(1) if v.ndim == 0 else v
+        result = ndarray(values.shape, dtype=np.int64, inputs=(array, values))
+        result._thunk.searchsorted(
+            array._thunk, values._thunk, side, stacklevel=(stacklevel + 1)
         )
-        return self.convert_to_cunumeric_ndarray(numpy_array, stacklevel=3)
+        return result.reshape(()) if v.ndim == 0 else result
 
     def setfield(self, val, dtype, offset=0):
         raise NotImplementedError(
@@ -1565,12 +1965,55 @@ class ndarray(object):
             write=write, align=align, uic=uic
         )
 
-    @unimplemented
-    def sort(self, axis=-1, kind=None, order=None):
-        numpy_array = self.__array__(stacklevel=3).sort(
-            axis=axis, kind=kind, order=order
+    def sort(self, axis=-1, kind=None, order=None, stacklevel=1):
+        if axis is None:
+            raise ValueError("ndarray.sort needs an axis")
+        result = self._sort(
+            axis, kind, order, argsort=False, stacklevel=(stacklevel + 1)
         )
-        return self.convert_to_cunumeric_ndarray(numpy_array, stacklevel=3)
+        self._thunk.copy(result._thunk, deep=True, stacklevel=(stacklevel + 1))
+
+    # Sort along an axis or, when it is None, the flattened array. All sorts
+    # are stable, so every 'kind' is honored by the same algorithm. The SORT
+    # task sorts the last axis, so any other one is swapped with it first.
+    def _sort(self, axis, kind, order, argsort, stacklevel):
+        if order is not None or self.dtype.kind == "c" or self.ndim == 0:
+            warnings.warn(
+                "cuNumeric has not implemented sorting 0-d or complex arrays "
+                "or with 'order' and is falling back to canonical numpy. You "
+                "may notice significantly decreased performance for this "
+                "function call.",
+                stacklevel=(stacklevel + 1),
+                category=RuntimeWarning,
+            )
+            numpy_array = self.__array__(stacklevel=(stacklevel + 1))
+            func = np.argsort if argsort else np.sort
+            return self.convert_to_cunumeric_ndarray(
+                func(numpy_array, axis=axis, kind=kind, order=order),
+                stacklevel=(stacklevel + 1),
+            )
+
+        if axis is None:
+            array = self.ravel(stacklevel=(stacklevel + 1))
+            axis = 0
+        else:
+            if axis < 0:
+                axis = self.ndim + axis
+            if axis < 0 or axis >= self.ndim:
+                raise ValueError("Illegal 'axis' value")
+            array = self
+        last = array.ndim - 1
+        if axis != last:
+            array = array.swapaxes(axis, last)
+        result = ndarray(
+            array.shape,
+            dtype=np.dtype(np.int64) if argsort else self.dtype,
+            inputs=(array,),
+        )
+        result._thunk.sort(array._thunk, argsort, stacklevel=(stacklevel + 1))
+        if axis != last:
+            result = result.swapaxes(axis, last)
+        return result
 
     def squeeze(self, axis=None):
         if axis is not None:
@@ -1597,12 +2040,29 @@ class ndarray(object):
             shape=None, thunk=self._thunk.squeeze(axis, stacklevel=2)
         )
 
-    @unimplemented
-    def std(self, axis=None, dtype=None, out=None, ddof=0, keepdims=False):
-        numpy_array = self.__array__(stacklevel=3).std(
-            axis=axis, dtype=dtype, out=out, ddof=ddof, keepdims=keepdims
+    @add_boilerplate()
+    def std(
+        self,
+        axis=None,
+        dtype=None,
+        out=None,
+        ddof=0,
+        keepdims=False,
+        stacklevel=1,
+    ):
+        variance = self.var(
+            axis=axis,
+            dtype=dtype,
+            ddof=ddof,
+            keepdims=keepdims,
+            stacklevel=(stacklevel + 1),
+        )
+        return self.perform_unary_op(
+            UnaryOpCode.SQRT,
+            variance,
+            dst=out if out is not None else variance,
+            stacklevel=(stacklevel + 1),
         )
-        return self.convert_to_cunumeric_ndarray(numpy_array, stacklevel=3)
 
     @add_boilerplate()
     def sum(
@@ -1630,6 +2090,7 @@ class ndarray(object):
             UnaryRedCode.SUM,
             self_array,
             axis=axis,
+            dtype=dtype,
             dst=out,
             keepdims=keepdims,
             initial=initial,
@@ -1671,6 +2132,31 @@ class ndarray(object):
     def tostring(self, order="C"):
         return self.__array__(stacklevel=2).tostring(order=order)
 
+    def topk(self, k, axis=-1, largest=True, stacklevel=1):
+        if self.ndim == 0:
+            raise ValueError("topk needs an array with at least one dimension")
+        if axis is None:
+            extent = self.size
+        else:
+            if axis < 0:
+                axis = self.ndim + axis
+            if axis < 0 or axis >= self.ndim:
+                raise ValueError("Illegal 'axis' value")
+            extent = self.shape[axis]
+        if k < 1 or k > extent:
+            raise ValueError(
+                f"k must be between 1 and {extent} for topk, got {k}"
+            )
+        if self.dtype.kind == "c":
+            raise TypeError("topk does not support complex arrays")
+        values, indices = self._thunk.topk(
+            k, axis, largest, stacklevel=(stacklevel + 1)
+        )
+        return (
+            ndarray(shape=values.shape, thunk=values),
+            ndarray(shape=indices.shape, thunk=indices),
+        )
+
     @unimplemented
     def trace(self, offset=0, axis1=0, axis2=1, dtype=None, out=None):
         numpy_array = self.__array__(stacklevel=3).trace(
@@ -1713,12 +2199,76 @@ class ndarray(object):
         result._thunk.flip(self._thunk, axis, stacklevel=(stacklevel + 1))
         return result
 
-    @unimplemented
-    def var(self, axis=None, dtype=None, out=None, ddof=0, keepdims=False):
-        numpy_array = self.__array__(stacklevel=3).var(
-            axis=axis, dtype=dtype, out=out, ddof=ddof, keepdims=keepdims
+    @add_boilerplate()
+    def var(
+        self,
+        axis=None,
+        dtype=None,
+        out=None,
+        ddof=0,
+        keepdims=False,
+        stacklevel=1,
+    ):
+        # Pick our dtype if it wasn't picked yet
+        if dtype is None:
+            if self.dtype.kind != "f" and self.dtype.kind != "c":
+                dtype = np.dtype(np.float64)
+            else:
+                dtype = self.dtype
+        else:
+            dtype = np.dtype(dtype)
+        # The variance of a complex array is the sum of the variances
+        # of its real and imaginary parts
+        if dtype.kind == "c":
+            part_dtype = np.finfo(dtype).dtype
+            real = self.real.var(
+                axis=axis,
+                dtype=part_dtype,
+                ddof=ddof,
+                keepdims=keepdims,
+                stacklevel=(stacklevel + 1),
+            )
+            imag = self.imag.var(
+                axis=axis,
+                dtype=part_dtype,
+                ddof=ddof,
+                keepdims=keepdims,
+                stacklevel=(stacklevel + 1),
+            )
+            return self.perform_binary_op(
+                BinaryOpCode.ADD,
+                real,
+                imag,
+                out=out,
+                stacklevel=(stacklevel + 1),
+            )
+        # Half precision variances are accumulated in single precision
+        if dtype == np.float16:
+            src_dtype = np.dtype(np.float32)
+        else:
+            src_dtype = dtype
+        if self.dtype != src_dtype:
+            src = ndarray(
+                shape=self.shape,
+                dtype=src_dtype,
+                stacklevel=(stacklevel + 1),
+                inputs=(self,),
+            )
+            src._thunk.convert(self._thunk, stacklevel=(stacklevel + 1))
+        else:
+            src = self
+        # Merge running means and squared deviations in a single pass,
+        # which avoids the cancellation of sum(x * x) - sum(x) ** 2 / n
+        return self.perform_unary_reduction(
+            UnaryRedCode.VARIANCE,
+            src,
+            axis=axis,
+            dtype=dtype if out is None else None,
+            dst=out,
+            keepdims=keepdims,
+            args=(np.array(ddof, dtype=np.int64),),
+            stacklevel=(stacklevel + 1),
         )
-        return self.convert_to_cunumeric_ndarray(numpy_array, stacklevel=3)
 
     def view(self, dtype=None, type=None):
         if dtype is not None and dtype != self.dtype:
@@ -1739,6 +2289,25 @@ class ndarray(object):
             raise ValueError("where parameter must have same shape as output")
         return where._thunk
 
+    # The result of an operation computed in a temporary of another type is
+    # converted to the output, of which a where mask only overwrites the
+    # elements it selects
+    @staticmethod
+    def convert_into(dst, temp, where, stacklevel):
+        if not isinstance(where, ndarray):
+            dst._thunk.convert(temp._thunk, stacklevel=(stacklevel + 1))
+            return
+        converted = ndarray(
+            dst.shape,
+            dtype=dst.dtype,
+            stacklevel=(stacklevel + 1),
+            inputs=(temp, where),
+        )
+        converted._thunk.convert(temp._thunk, stacklevel=(stacklevel + 1))
+        dst._thunk.putmask(
+            where._thunk, converted._thunk, stacklevel=(stacklevel + 1)
+        )
+
     @staticmethod
     def find_common_type(*args):
         array_types = list()
@@ -1808,13 +2377,13 @@ class ndarray(object):
         op_dtype = (
             dst.dtype
             if out_dtype is None
-            and not (op == UnaryOpCode.ABSOLUTE and src.dtype.kind == "c")
+            and not (op in _MAGNITUDE_UNARY_OPS and src.dtype.kind == "c")
             else src.dtype
         )
         if check_types:
             if out_dtype is None:
                 if dst.dtype != src.dtype and not (
-                    op == UnaryOpCode.ABSOLUTE and src.dtype.kind == "c"
+                    op in _MAGNITUDE_UNARY_OPS and src.dtype.kind == "c"
                 ):
                     temp = ndarray(
                         dst.shape,
@@ -1832,9 +2401,7 @@ class ndarray(object):
                         args,
                         stacklevel=(stacklevel + 1),
                     )
-                    dst._thunk.convert(
-                        temp._thunk, stacklevel=(stacklevel + 1)
-                    )
+                    cls.convert_into(dst, temp, where, stacklevel + 1)
                 else:
                     dst._thunk.unary_op(
                         op,
@@ -1864,9 +2431,7 @@ class ndarray(object):
                         args,
                         stacklevel=(stacklevel + 1),
                     )
-                    dst._thunk.convert(
-                        temp._thunk, stacklevel=(stacklevel + 1)
-                    )
+                    cls.convert_into(dst, temp, where, stacklevel + 1)
                 else:
                     dst._thunk.unary_op(
                         op,
@@ -1916,6 +2481,12 @@ class ndarray(object):
                     '"where" array must broadcast against source array '
                     "for reduction"
                 )
+            # The mask selects elements of the source, so unlike the where
+            # mask of an elementwise operation it is not checked against the
+            # shape of the output
+            where_thunk = where._thunk
+        else:
+            where_thunk = where
         # Compute the output shape
         if axis is not None:
             to_reduce = set()
@@ -1937,7 +2508,7 @@ class ndarray(object):
                     elif ax >= src.ndim:
                         raise ValueError("Illegal 'axis' value")
                     to_reduce.add(ax)
-                axes = axis
+                axes = tuple(sorted(to_reduce))
             else:
                 raise TypeError(
                     "Illegal type passed for 'axis' argument "
@@ -1988,7 +2559,12 @@ class ndarray(object):
             return dst
         if check_types and src.dtype != dst.dtype:
             out_dtype = cls.find_common_type(src, dst)
-            if src.dtype != out_dtype:
+            # The task itself can widen a narrow source
+            widened = (
+                op in (UnaryRedCode.SUM, UnaryRedCode.PROD)
+                and (src.dtype, out_dtype) in _unary_red_widenings
+            )
+            if src.dtype != out_dtype and not widened:
                 temp = ndarray(
                     src.shape,
                     dtype=out_dtype,
@@ -2008,9 +2584,7 @@ class ndarray(object):
                 temp._thunk.unary_reduction(
                     op,
                     src._thunk,
-                    cls.get_where_thunk(
-                        where, dst.shape, stacklevel=(stacklevel + 1)
-                    ),
+                    where_thunk,
                     axes,
                     keepdims,
                     args,
@@ -2022,9 +2596,7 @@ class ndarray(object):
                 dst._thunk.unary_reduction(
                     op,
                     src._thunk,
-                    cls.get_where_thunk(
-                        where, dst.shape, stacklevel=(stacklevel + 1)
-                    ),
+                    where_thunk,
                     axes,
                     keepdims,
                     args,
@@ -2035,9 +2607,7 @@ class ndarray(object):
             dst._thunk.unary_reduction(
                 op,
                 src._thunk,
-                cls.get_where_thunk(
-                    where, dst.shape, stacklevel=(stacklevel + 1)
-                ),
+                where_thunk,
                 axes,
                 keepdims,
                 args,
@@ -2046,6 +2616,89 @@ class ndarray(object):
             )
         return dst
 
+    # For performing several reductions of the same array in a single pass
+    @classmethod
+    def perform_multi_reduction(
+        cls, ops, src, axis=None, keepdims=False, stacklevel=2
+    ):
+        if axis is not None:
+            if type(axis) == int:
+                axis = (axis,)
+            elif type(axis) != tuple:
+                raise TypeError(
+                    "Illegal type passed for 'axis' argument "
+                    + str(type(axis))
+                )
+            to_reduce = set()
+            for ax in axis:
+                if ax < 0:
+                    ax = src.ndim + ax
+                if ax < 0 or ax >= src.ndim:
+                    raise ValueError("Illegal 'axis' value")
+                to_reduce.add(ax)
+            axes = tuple(sorted(to_reduce))
+            out_shape = ()
+            for dim in range(src.ndim):
+                if dim in to_reduce:
+                    if keepdims:
+                        out_shape += (1,)
+                else:
+                    out_shape += (src.shape[dim],)
+        else:
+            # Collapsing down to a single value in this case
+            axes = None
+            out_shape = ()
+            keepdims = False
+        thunks = src._thunk.multi_reduction(
+            ops, out_shape, axes, keepdims, stacklevel=(stacklevel + 1)
+        )
+        return tuple(
+            ndarray(shape=None, stacklevel=(stacklevel + 1), thunk=thunk)
+            for thunk in thunks
+        )
+
+    # For computing the inner products of several pairs of vectors in a single
+    # pass over them
+    @classmethod
+    def perform_multi_dot(cls, pairs, stacklevel=2):
+        # Every distinct vector is passed once and the pairs refer to them
+        # by position
+        vectors = []
+        indices = []
+        for pair in pairs:
+            idx = []
+            for vector in pair:
+                for (pos, other) in enumerate(vectors):
+                    if other is vector:
+                        break
+                else:
+                    pos = len(vectors)
+                    vectors.append(vector)
+                idx.append(pos)
+            indices.append(tuple(idx))
+        out_dtype = cls.find_common_type(*vectors)
+        thunks = []
+        for vector in vectors:
+            if vector.dtype != out_dtype:
+                temp = ndarray(
+                    shape=vector.shape,
+                    dtype=out_dtype,
+                    stacklevel=(stacklevel + 1),
+                    inputs=(vector,),
+                )
+                temp._thunk.convert(
+                    vector._thunk, stacklevel=(stacklevel + 1)
+                )
+                vector = temp
+            thunks.append(vector._thunk)
+        results = thunks[0].multi_dot(
+            tuple(thunks), tuple(indices), stacklevel=(stacklevel + 1)
+        )
+        return tuple(
+            ndarray(shape=None, stacklevel=(stacklevel + 1), thunk=thunk)
+            for thunk in results
+        )
+
     # Return a new cuNumeric array for a binary operation
     @classmethod
     def perform_binary_op(
@@ -2112,7 +2765,16 @@ class ndarray(object):
         if check_types:
             if one.dtype != two.dtype:
                 common_type = cls.find_common_type(one, two)
-                if one.dtype != common_type:
+                # The task itself can promote a narrower operand
+                if (
+                    two.dtype == common_type
+                    and (one.dtype, common_type) in _binary_op_promotions
+                ) or (
+                    one.dtype == common_type
+                    and (two.dtype, common_type) in _binary_op_promotions
+                ):
+                    common_type = None
+                if common_type is not None and one.dtype != common_type:
                     temp = ndarray(
                         shape=one.shape,
                         dtype=common_type,
@@ -2123,7 +2785,7 @@ class ndarray(object):
                         one._thunk, stacklevel=(stacklevel + 1)
                     )
                     one = temp
-                if two.dtype != common_type:
+                if common_type is not None and two.dtype != common_type:
                     temp = ndarray(
                         shape=two.shape,
                         dtype=common_type,
@@ -2151,7 +2813,7 @@ class ndarray(object):
                     args,
                     stacklevel=(stacklevel + 1),
                 )
-                out._thunk.convert(temp._thunk, stacklevel=(stacklevel + 1))
+                cls.convert_into(out, temp, where, stacklevel + 1)
             else:
                 out._thunk.binary_op(
                     op,
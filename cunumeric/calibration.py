@@ -0,0 +1,132 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+from __future__ import absolute_import, division, print_function
+
+import json
+import math
+import os
+import socket
+import time
+
+import numpy as np
+
+from .config import BinaryOpCode
+from .deferred import DeferredArray
+
+# The volumes at which eager and deferred execution are compared
+_VOLUMES = [1 << k for k in range(8, 23, 2)]
+_REPEATS = 5
+
+
+def calibration_file():
+    path = os.environ.get("CUNUMERIC_CALIBRATION_FILE")
+    if path is not None:
+        return path
+    return os.path.join(
+        os.path.expanduser("~"), ".cache", "cunumeric", "calibration.json"
+    )
+
+
+# Calibrations only carry over to runs on the same host with the same
+# processors, as those decide where deferred tasks run
+def _machine(runtime):
+    return f"{socket.gethostname()}/{runtime.num_procs}/{runtime.num_gpus}"
+
+
+def _read_entries(path):
+    try:
+        with open(path) as f:
+            entries = json.load(f)
+    except (OSError, ValueError):
+        return dict()
+    return entries if isinstance(entries, dict) else dict()
+
+
+def load_calibration(runtime):
+    """Return the calibration of this machine, if it has been calibrated
+
+    :meta private:
+    """
+    return _read_entries(calibration_file()).get(_machine(runtime))
+
+
+def _best_time(func):
+    func()
+    best = math.inf
+    for _ in range(_REPEATS):
+        start = time.perf_counter()
+        func()
+        best = min(best, time.perf_counter() - start)
+    return best
+
+
+def _deferred_operand(runtime, volume):
+    dtype = np.dtype(np.float64)
+    store = runtime.legate_context.create_store(
+        dtype, shape=(volume,), optimize_scalar=True
+    )
+    array = DeferredArray(runtime, store, dtype)
+    array.fill(np.array(1.0, dtype=dtype))
+    # Write the value out so that the timed operation reads a store
+    array.base
+    return array
+
+
+def _eager_time(volume):
+    lhs = np.empty(volume)
+    rhs1 = np.ones(volume)
+    rhs2 = np.ones(volume)
+    return _best_time(lambda: np.add(rhs1, rhs2, out=lhs))
+
+
+def _deferred_time(runtime, volume):
+    lhs = _deferred_operand(runtime, volume)
+    rhs1 = _deferred_operand(runtime, volume)
+    rhs2 = _deferred_operand(runtime, volume)
+
+    def add():
+        lhs.binary_op(BinaryOpCode.ADD, rhs1, rhs2, True, ())
+        # Flush anything that is still waiting to be fused and wait for
+        # the task to finish
+        lhs.base
+        runtime.legate_runtime.issue_execution_fence(block=True)
+
+    return _best_time(add)
+
+
+def calibrate(runtime):
+    """Measure the volume up to which element-wise operations run faster
+    eagerly in NumPy than as deferred tasks, and record it for this machine
+
+    :meta private:
+    """
+    max_eager_volume = 0
+    for volume in _VOLUMES:
+        if _deferred_time(runtime, volume) <= _eager_time(volume):
+            break
+        max_eager_volume = volume
+
+    calibration = {"max_eager_volume": max_eager_volume}
+
+    path = calibration_file()
+    entries = _read_entries(path)
+    entries[_machine(runtime)] = calibration
+    directory = os.path.dirname(path)
+    if directory:
+        os.makedirs(directory, exist_ok=True)
+    with open(path, "w") as f:
+        json.dump(entries, f, indent=2, sort_keys=True)
+    return calibration
@@ -81,34 +81,74 @@ _cunumeric = cunumeric_lib.shared_object
 @unique
 class CuNumericOpCode(IntEnum):
     ARANGE = _cunumeric.CUNUMERIC_ARANGE
+    BATCHED_MATMUL = _cunumeric.CUNUMERIC_BATCHED_MATMUL
+    BATCHED_SOLVE = _cunumeric.CUNUMERIC_BATCHED_SOLVE
     BINARY_OP = _cunumeric.CUNUMERIC_BINARY_OP
     BINARY_RED = _cunumeric.CUNUMERIC_BINARY_RED
     BINCOUNT = _cunumeric.CUNUMERIC_BINCOUNT
+    BUCKET = _cunumeric.CUNUMERIC_BUCKET
     CHOOSE = _cunumeric.CUNUMERIC_CHOOSE
+    COMPRESS = _cunumeric.CUNUMERIC_COMPRESS
     CONTRACT = _cunumeric.CUNUMERIC_CONTRACT
     CONVERT = _cunumeric.CUNUMERIC_CONVERT
     CONVOLVE = _cunumeric.CUNUMERIC_CONVOLVE
     DIAG = _cunumeric.CUNUMERIC_DIAG
     DOT = _cunumeric.CUNUMERIC_DOT
     EYE = _cunumeric.CUNUMERIC_EYE
+    FFT = _cunumeric.CUNUMERIC_FFT
     FILL = _cunumeric.CUNUMERIC_FILL
     FLIP = _cunumeric.CUNUMERIC_FLIP
+    FMA = _cunumeric.CUNUMERIC_FMA
+    FUSED_OP = _cunumeric.CUNUMERIC_FUSED_OP
+    GATHER = _cunumeric.CUNUMERIC_GATHER
     GEMM = _cunumeric.CUNUMERIC_GEMM
+    GEQRF = _cunumeric.CUNUMERIC_GEQRF
+    GESVD = _cunumeric.CUNUMERIC_GESVD
+    GETRF = _cunumeric.CUNUMERIC_GETRF
+    GETRS = _cunumeric.CUNUMERIC_GETRS
+    GRAM = _cunumeric.CUNUMERIC_GRAM
+    HISTOGRAM = _cunumeric.CUNUMERIC_HISTOGRAM
+    INTERP = _cunumeric.CUNUMERIC_INTERP
+    KMEANS_ASSIGN = _cunumeric.CUNUMERIC_KMEANS_ASSIGN
+    KRON = _cunumeric.CUNUMERIC_KRON
+    LASWP = _cunumeric.CUNUMERIC_LASWP
     LOAD_CUDALIBS = _cunumeric.CUNUMERIC_LOAD_CUDALIBS
+    LOAD_NPY = _cunumeric.CUNUMERIC_LOAD_NPY
+    LSTM_GATES = _cunumeric.CUNUMERIC_LSTM_GATES
     MATMUL = _cunumeric.CUNUMERIC_MATMUL
     MATVECMUL = _cunumeric.CUNUMERIC_MATVECMUL
+    MULTI_DOT = _cunumeric.CUNUMERIC_MULTI_DOT
     NONZERO = _cunumeric.CUNUMERIC_NONZERO
+    PAD = _cunumeric.CUNUMERIC_PAD
+    PERMUTE_COPY = _cunumeric.CUNUMERIC_PERMUTE_COPY
+    PLACE = _cunumeric.CUNUMERIC_PLACE
+    POLYVAL = _cunumeric.CUNUMERIC_POLYVAL
     POTRF = _cunumeric.CUNUMERIC_POTRF
+    QUANTIZE = _cunumeric.CUNUMERIC_QUANTIZE
+    QUANTIZED_MATVEC = _cunumeric.CUNUMERIC_QUANTIZED_MATVEC
     RAND = _cunumeric.CUNUMERIC_RAND
     READ = _cunumeric.CUNUMERIC_READ
+    REPEAT = _cunumeric.CUNUMERIC_REPEAT
+    RESHAPE = _cunumeric.CUNUMERIC_RESHAPE
+    ROLLING = _cunumeric.CUNUMERIC_ROLLING
+    SAVE_NPY = _cunumeric.CUNUMERIC_SAVE_NPY
     SCALAR_UNARY_RED = _cunumeric.CUNUMERIC_SCALAR_UNARY_RED
+    SCAN = _cunumeric.CUNUMERIC_SCAN
+    SCATTER = _cunumeric.CUNUMERIC_SCATTER
+    SEARCHSORTED = _cunumeric.CUNUMERIC_SEARCHSORTED
+    SEGMENT_REDUCE = _cunumeric.CUNUMERIC_SEGMENT_REDUCE
+    SORT = _cunumeric.CUNUMERIC_SORT
+    SPMM = _cunumeric.CUNUMERIC_SPMM
+    STENCIL = _cunumeric.CUNUMERIC_STENCIL
     SYRK = _cunumeric.CUNUMERIC_SYRK
     TILE = _cunumeric.CUNUMERIC_TILE
+    TOPK = _cunumeric.CUNUMERIC_TOPK
     TRANSPOSE_COPY_2D = _cunumeric.CUNUMERIC_TRANSPOSE_COPY_2D
     TRILU = _cunumeric.CUNUMERIC_TRILU
     TRSM = _cunumeric.CUNUMERIC_TRSM
     UNARY_OP = _cunumeric.CUNUMERIC_UNARY_OP
     UNARY_RED = _cunumeric.CUNUMERIC_UNARY_RED
+    UNIQUE = _cunumeric.CUNUMERIC_UNIQUE
     UNLOAD_CUDALIBS = _cunumeric.CUNUMERIC_UNLOAD_CUDALIBS
     WHERE = _cunumeric.CUNUMERIC_WHERE
     WRITE = _cunumeric.CUNUMERIC_WRITE
@@ -136,6 +176,8 @@ class BinaryOpCode(IntEnum):
     POWER = 17
     SUBTRACT = 18
     ALLCLOSE = 19
+    SOFTMAX = 20
+    MUL_CONJ = 21
 
 
 # Match these to UnaryOpCode in unary_op_util.h
@@ -169,6 +211,16 @@ class UnaryOpCode(IntEnum):
     REAL = 26
     IMAG = 27
     GETARG = 28
+    GETVAR = 29
+    GETSUM = 30
+    GETNORM = 31
+    ERF = 32
+    EXPM1 = 33
+    LOG1P = 34
+    SIGMOID = 35
+    SOFTPLUS = 36
+    GETLSE = 37
+    ABS2 = 38
 
 
 # Match these to UnaryRedCode in unary_red_util.h
@@ -184,6 +236,29 @@ class UnaryRedCode(IntEnum):
     ARGMIN = 8
     CONTAINS = 9
     COUNT_NONZERO = 10
+    SUM_SQUARES = 11
+    VARIANCE = 12
+    NANARGMAX = 13
+    NANARGMIN = 14
+    NANCOUNT = 15
+    NANMAX = 16
+    NANMIN = 17
+    NANPROD = 18
+    NANSUM = 19
+    BINNED_SUM = 20
+    NORM1 = 21
+    NORM2 = 22
+    NORMINF = 23
+    NORMNEGINF = 24
+    LOGSUMEXP = 25
+
+
+# Match these to FusedOpKind in fused_op_util.h
+@unique
+class FusedOpKind(IntEnum):
+    UNARY = 0
+    BINARY = 1
+    ARANGE = 2
 
 
 # Match these to RandGenCode in rand_util.h
@@ -192,6 +267,47 @@ class RandGenCode(IntEnum):
     UNIFORM = 1
     NORMAL = 2
     INTEGER = 3
+    PERMUTATION = 4
+    EXPONENTIAL = 5
+    GAMMA = 6
+    BETA = 7
+    POISSON = 8
+    BINOMIAL = 9
+    BERNOULLI = 10
+
+
+# Match these to RandBackend in rand_util.h
+@unique
+class RandBackend(IntEnum):
+    PHILOX = 0
+    STREAM = 1
+
+
+# Match these to FFTType in fft_util.h
+@unique
+class FFTType(IntEnum):
+    C2C = 1
+    R2C = 2
+    C2R = 3
+
+
+# Match these to RollingOpCode in rolling.h
+@unique
+class RollingOpCode(IntEnum):
+    SUM = 0
+    MEAN = 1
+    MIN = 2
+    MAX = 3
+
+
+# Match these to PadMode in pad.h
+@unique
+class PadMode(IntEnum):
+    CONSTANT = 0
+    EDGE = 1
+    REFLECT = 2
+    SYMMETRIC = 3
+    WRAP = 4
 
 
 # Match these to CuNumericRedopID in cunumeric_c.h
@@ -199,6 +315,10 @@ class RandGenCode(IntEnum):
 class CuNumericRedopCode(IntEnum):
     ARGMAX = 1
     ARGMIN = 2
+    VARIANCE = 3
+    BINNED_SUM = 4
+    NORM = 5
+    LOGSUMEXP = 6
 
 
 # Match these to CuNumericTunable in cunumeric_c.h
@@ -207,3 +327,13 @@ class CuNumericTunable(IntEnum):
     NUM_GPUS = _cunumeric.CUNUMERIC_TUNABLE_NUM_GPUS
     NUM_PROCS = _cunumeric.CUNUMERIC_TUNABLE_NUM_PROCS
     MAX_EAGER_VOLUME = _cunumeric.CUNUMERIC_TUNABLE_MAX_EAGER_VOLUME
+    MIN_CHOLESKY_TILE_SIZE = (
+        _cunumeric.CUNUMERIC_TUNABLE_MIN_CHOLESKY_TILE_SIZE
+    )
+    MIN_CHOLESKY_MATRIX_SIZE = (
+        _cunumeric.CUNUMERIC_TUNABLE_MIN_CHOLESKY_MATRIX_SIZE
+    )
+
+
+# Match this to QUANT_BLOCK in matrix/block_quant.h
+QUANT_BLOCK = 64
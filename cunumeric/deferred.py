@@ -13,11 +13,11 @@
 # limitations under the License.
 #
 
+import os
 import warnings
 import weakref
 from collections.abc import Iterable
 from functools import reduce
-from itertools import product
 
 import numpy as np
 
@@ -25,9 +25,15 @@ import legate.core.types as ty
 from legate.core import *  # noqa F403
 
 from .config import *  # noqa F403
-from .linalg.cholesky import cholesky
+from .fft.slab import fft
+from .fusion import broadcast_store, evaluate_generated, hold_window
+from .halo import add_halo_input, stencil_halo
+from .linalg.cholesky import cholesky, cholesky_solve, triangular_solve
+from .linalg.qr import qr, svd
+from .linalg.solve import solve
+from .linalg.summa import summa, use_summa
 from .thunk import NumPyThunk
-from .utils import get_arg_value_dtype
+from .utils import get_arg_value_dtype, get_binned_sum_state
 
 
 def _complex_field_dtype(dtype):
@@ -41,6 +47,10 @@ def _complex_field_dtype(dtype):
         assert False
 
 
+# Types in which an addition of a product runs as a single FMA task
+_fma_dtypes = (np.dtype(np.float32), np.dtype(np.float64))
+
+
 def _prod(tpl):
     return reduce(lambda a, b: a * b, tpl, 1)
 
@@ -74,6 +84,17 @@ def auto_convert(indices, keys=[]):
     return decorator
 
 
+# The unary ops that have a fast-math variant, see _fast_math_args
+_FAST_MATH_UNARY_OPS = (
+    UnaryOpCode.COS,
+    UnaryOpCode.EXP,
+    UnaryOpCode.LOG,
+    UnaryOpCode.SIGMOID,
+    UnaryOpCode.SIN,
+    UnaryOpCode.TANH,
+)
+
+
 def profile(func):
     def wrapper(*args, **kwargs):
         self = args[0]
@@ -83,7 +104,9 @@ def profile(func):
 
         result = func(*args, **kwargs)
 
-        self.runtime.profile_callsite(stacklevel, True, callsite)
+        self.runtime.profile_callsite(
+            stacklevel, True, callsite, operation=func.__name__
+        )
 
         return result
 
@@ -145,6 +168,22 @@ class _CuNumericNDarray(object):
         }
 
 
+# Matrix products with at most this many columns on the right are computed as
+# a tall-skinny product that reads the matrix once
+_MAX_MULTI_RHS = 32
+
+# Inner products computed by a single MULTI_DOT launch, which must match
+# MAX_MULTI_DOTS in matrix/multi_dot.h
+_MAX_MULTI_DOTS = 4
+
+# How many sampled elements the splitters of a sample sort are picked from
+# per bucket, and the fewest elements per bucket worth a sample sort
+_SORT_SAMPLES_PER_BUCKET = 64
+
+# Bins above which bincount range-partitions its output across the
+# processors rather than reducing into a full copy of it on every one
+_BINCOUNT_MAX_BROADCAST_BINS = 1 << 20
+
 _UNARY_RED_TO_REDUCTION_OPS = {
     UnaryRedCode.SUM: ReductionOp.ADD,
     UnaryRedCode.PROD: ReductionOp.MUL,
@@ -156,6 +195,21 @@ _UNARY_RED_TO_REDUCTION_OPS = {
     UnaryRedCode.COUNT_NONZERO: ReductionOp.ADD,
     UnaryRedCode.ALL: ReductionOp.MUL,
     UnaryRedCode.ANY: ReductionOp.ADD,
+    UnaryRedCode.SUM_SQUARES: ReductionOp.ADD,
+    UnaryRedCode.VARIANCE: CuNumericRedopCode.VARIANCE,
+    UnaryRedCode.BINNED_SUM: CuNumericRedopCode.BINNED_SUM,
+    UnaryRedCode.NORM1: ReductionOp.ADD,
+    UnaryRedCode.NORM2: CuNumericRedopCode.NORM,
+    UnaryRedCode.NORMINF: ReductionOp.MAX,
+    UnaryRedCode.NORMNEGINF: ReductionOp.MIN,
+    UnaryRedCode.LOGSUMEXP: CuNumericRedopCode.LOGSUMEXP,
+    UnaryRedCode.NANARGMAX: CuNumericRedopCode.ARGMAX,
+    UnaryRedCode.NANARGMIN: CuNumericRedopCode.ARGMIN,
+    UnaryRedCode.NANCOUNT: ReductionOp.ADD,
+    UnaryRedCode.NANMAX: ReductionOp.MAX,
+    UnaryRedCode.NANMIN: ReductionOp.MIN,
+    UnaryRedCode.NANPROD: ReductionOp.MUL,
+    UnaryRedCode.NANSUM: ReductionOp.ADD,
 }
 
 
@@ -196,9 +250,77 @@ _UNARY_RED_IDENTITIES = {
     UnaryRedCode.COUNT_NONZERO: lambda _: 0,
     UnaryRedCode.ALL: lambda _: True,
     UnaryRedCode.ANY: lambda _: False,
+    UnaryRedCode.SUM_SQUARES: lambda _: 0,
+    UnaryRedCode.VARIANCE: lambda _: (0, 0, 0),
+    UnaryRedCode.NANARGMAX: lambda ty: (
+        np.iinfo(np.int64).min,
+        max_identity(ty),
+    ),
+    UnaryRedCode.NANARGMIN: lambda ty: (
+        np.iinfo(np.int64).min,
+        min_identity(ty),
+    ),
+    UnaryRedCode.NANCOUNT: lambda _: 0,
+    UnaryRedCode.NANMAX: max_identity,
+    UnaryRedCode.NANMIN: min_identity,
+    UnaryRedCode.NANPROD: lambda _: 1,
+    UnaryRedCode.NANSUM: lambda _: 0,
+    UnaryRedCode.BINNED_SUM: lambda _: get_binned_sum_state(0),
+    UnaryRedCode.NORM1: lambda _: 0,
+    UnaryRedCode.NORM2: lambda _: (0, 0, 0),
+    # The magnitudes are never negative, so the norm of nothing is zero
+    UnaryRedCode.NORMINF: lambda _: 0,
+    UnaryRedCode.NORMNEGINF: min_identity,
+    UnaryRedCode.LOGSUMEXP: lambda _: (0, -np.inf, 0),
+}
+
+# The reductions whose where mask can be applied by substituting their
+# identity for the masked out elements
+_MASKABLE_UNARY_RED_OPS = (
+    UnaryRedCode.SUM,
+    UnaryRedCode.PROD,
+    UnaryRedCode.MIN,
+    UnaryRedCode.MAX,
+    UnaryRedCode.COUNT_NONZERO,
+    UnaryRedCode.ALL,
+    UnaryRedCode.ANY,
+    UnaryRedCode.SUM_SQUARES,
+    UnaryRedCode.NANMAX,
+    UnaryRedCode.NANMIN,
+    UnaryRedCode.NANPROD,
+    UnaryRedCode.NANSUM,
+)
+
+# The binary operations that combine the results of a reduction over the
+# blocks of a streamed array
+_UNARY_RED_COMBINE_OPS = {
+    UnaryRedCode.SUM: BinaryOpCode.ADD,
+    UnaryRedCode.PROD: BinaryOpCode.MULTIPLY,
+    UnaryRedCode.MIN: BinaryOpCode.MINIMUM,
+    UnaryRedCode.MAX: BinaryOpCode.MAXIMUM,
+    UnaryRedCode.COUNT_NONZERO: BinaryOpCode.ADD,
+    UnaryRedCode.ALL: BinaryOpCode.LOGICAL_AND,
+    UnaryRedCode.ANY: BinaryOpCode.LOGICAL_OR,
+    UnaryRedCode.SUM_SQUARES: BinaryOpCode.ADD,
+    UnaryRedCode.NANCOUNT: BinaryOpCode.ADD,
+    UnaryRedCode.NANPROD: BinaryOpCode.MULTIPLY,
+    UnaryRedCode.NANSUM: BinaryOpCode.ADD,
 }
 
 
+# The reductions that the SCALAR_UNARY_RED and UNARY_RED tasks can't apply
+# to an element-wise expression of their inputs
+_UNMAPPED_UNARY_RED_OPS = {
+    UnaryRedCode.ALL,
+    UnaryRedCode.ANY,
+    UnaryRedCode.ARGMAX,
+    UnaryRedCode.ARGMIN,
+    UnaryRedCode.CONTAINS,
+    UnaryRedCode.COUNT_NONZERO,
+    UnaryRedCode.NANARGMAX,
+    UnaryRedCode.NANARGMIN,
+}
+
 class DeferredArray(NumPyThunk):
     """This is a deferred thunk for describing NumPy computations.
     It is backed by either a Legion logical region or a Legion future
@@ -211,25 +333,178 @@ class DeferredArray(NumPyThunk):
         NumPyThunk.__init__(self, runtime, dtype)
         assert base is not None
         assert isinstance(base, Store)
-        self.base = base  # a Legate Store
+        self._base = base  # a Legate Store
+        # True only while nothing else has seen the store of this array,
+        # which makes it safe to defer writes into it
+        self._fresh = False
+        # True while the store of this array was created for it and no view,
+        # alias or NumPy array of the store exists. Together with the number
+        # of ndarrays wrapping this array, it tells whether an ndarray that
+        # is about to die can hand this array over instead of copying it.
+        self._owns_store = False
+        self._wrappers = 0
+        # The value of a scalar array created from host data, which is
+        # forgotten as soon as anyone else touches the store
+        self._scalar_value = None
         self.numpy_array = (
             None if numpy_array is None else weakref.ref(numpy_array)
         )
+        # The matrix this is the transposed view of, if any, which lets
+        # dot recognize the product of a matrix with its own transpose
+        self.transpose_source = None
+        # True while this is a lower triangular Cholesky factor whose store
+        # still holds garbage above the diagonal. Triangular solves read
+        # the store as it is, and the upper triangle is only cleared once
+        # anything else asks for the store.
+        self._stale_upper = False
+        # Set while this is a diagonal matrix whose store has not been
+        # written yet, to the values on the diagonal, either a host scalar
+        # or a vector thunk, and the offset of the diagonal. Products and
+        # sums with the matrix only touch its diagonal, and the store is
+        # only filled in once anything else asks for it.
+        self._diagonal = None
+        # Set while this array is filled with a single value that has not
+        # been written to its store yet. Element-wise operations and
+        # reductions take the value as a scalar, and the store is only
+        # filled once anything else asks for it.
+        self._constant = None
+        # Set while this is a range that has not been written to its store
+        # yet, to its start, stop and step. Element-wise operations compute
+        # the values from the coordinates instead of reading them.
+        self._arange = None
+
+    def __del__(self):
+        # The store of a temporary that nobody else has seen goes back to the
+        # runtime for the next temporary of the same shape and type
+        recycler = self.runtime.recycler
+        if (
+            recycler is not None
+            and not self.runtime.destroyed
+            and getattr(self, "_owns_store", False)
+            and self._base.kind != Future
+            and self._base.ndim > 0
+        ):
+            recycler.release(self._base, np.dtype(self.dtype))
 
     def __str__(self):
-        return f"DeferredArray(base: {self.base})"
+        return f"DeferredArray(base: {self._base})"
+
+    @property
+    def base(self):
+        # Anyone asking for the store must see the effects of all the
+        # element-wise operations that are still waiting to be fused
+        self.runtime.elements.flush()
+        fusion = self.runtime.fusion
+        if fusion is not None:
+            fusion.flush()
+        self.runtime.products.flush()
+        launches = self.runtime.launches
+        if launches is not None and launches.holds(self):
+            launches.flush()
+        self._fresh = False
+        self._scalar_value = None
+        if self._stale_upper:
+            self._stale_upper = False
+            self._clear_upper()
+        if self._diagonal is not None:
+            values, k = self._diagonal
+            self._diagonal = None
+            self._write_diagonal(values, k)
+        if self._constant is not None:
+            value = self._constant
+            self._constant = None
+            self._fill_value(value)
+        if self._arange is not None:
+            start, stop, step = self._arange
+            self._arange = None
+            self._write_arange(start, stop, step)
+        return self._base
+
+    # The value of every element of the array, when it is known here
+    @property
+    def _uniform_value(self):
+        if self._scalar_value is not None:
+            return self._scalar_value
+        if self._constant is not None and self.runtime.is_host_scalar_type(
+            self.dtype
+        ):
+            return self._constant.reshape(())[()]
+        return None
+
+    @property
+    def triangular_base(self):
+        # The store for tasks that only read the lower triangle of the
+        # array, which can skip clearing the upper triangle
+        if not self._stale_upper:
+            return self.base
+        self.runtime.elements.flush()
+        fusion = self.runtime.fusion
+        if fusion is not None:
+            fusion.flush()
+        self.runtime.products.flush()
+        launches = self.runtime.launches
+        if launches is not None and launches.holds(self):
+            launches.flush()
+        return self._base
+
+    def _clear_upper(self):
+        task = self.context.create_task(CuNumericOpCode.TRILU)
+        task.add_output(self._base)
+        task.add_input(self._base)
+        task.add_scalar_arg(True, bool)
+        task.add_scalar_arg(0, ty.int32)
+        task.add_alignment(self._base, self._base)
+        task.execute()
+
+    @base.setter
+    def base(self, base):
+        self._base = base
+        self._owns_store = False
+
+    # Whether a task writing this array from the operands can be held back
+    # in the launch window, which is only known before anyone asks for the
+    # store of the array
+    def _can_hold_launch(self, srcs):
+        launches = self.runtime.launches
+        return launches is not None and launches.can_record(self, srcs)
+
+    def _submit(self, task, srcs, held):
+        if held:
+            self.runtime.launches.record(task, self, srcs)
+        else:
+            task.execute()
+
+    def wrap(self, ndarray):
+        self._wrappers += 1
+
+    @property
+    def exclusive(self):
+        return self._owns_store and self._wrappers <= 1
+
+    @property
+    def value_known(self):
+        # Values computed by tasks stay futures until Python asks for them
+        if not self.scalar:
+            return False
+        if self._uniform_value is not None:
+            return True
+        return self.numpy_array is not None and self.numpy_array() is not None
 
     @property
     def storage(self):
+        # Whoever asks for the storage can alias it
+        self._owns_store = False
         storage = self.base.storage
         if self.base.kind == Future:
             return storage
         else:
             return (storage.region, storage.field.field_id)
 
+    # The shape is known without the contents of the store, so asking for it
+    # doesn't count as reading the store
     @property
     def shape(self):
-        return tuple(self.base.shape)
+        return tuple(self._base.shape)
 
     @property
     def ndim(self):
@@ -261,6 +536,7 @@ class DeferredArray(NumPyThunk):
                 dtype=self.dtype,
             )
         else:
+            self._owns_store = False
             alloc = self.base.get_inline_allocation(self.context)
 
             def construct_ndarray(shape, address, strides):
@@ -339,6 +615,24 @@ class DeferredArray(NumPyThunk):
         if self.scalar and rhs.scalar:
             self.base.set_storage(rhs.base.storage)
             return
+        # Multi-dimensional copies, such as the ones that materialize
+        # transposed or swapped views, go through a task that tiles the
+        # innermost axes of the source and the target when they differ
+        if self.ndim >= 2 and rhs.dtype == self.dtype:
+            fusion = self.runtime.fusion
+            if fusion is not None and fusion.record_unary(
+                self, UnaryOpCode.COPY, rhs.dtype, rhs, []
+            ):
+                return
+            lhs = self.base
+            src = rhs._broadcast(lhs.shape)
+
+            task = self.context.create_task(CuNumericOpCode.PERMUTE_COPY)
+            task.add_output(lhs)
+            task.add_input(src)
+            task.add_alignment(lhs, src)
+            task.execute()
+            return
         self.unary_op(
             UnaryOpCode.COPY,
             rhs.dtype,
@@ -351,7 +645,7 @@ class DeferredArray(NumPyThunk):
 
     @property
     def scalar(self):
-        return self.base.scalar
+        return self._base.scalar
 
     def get_scalar_array(self, stacklevel):
         assert self.scalar
@@ -415,6 +709,7 @@ class DeferredArray(NumPyThunk):
 
     def _get_view(self, key):
         key = self._unpack_ellipsis(key, self.ndim)
+        self._owns_store = False
         store = self.base
         shift = 0
         for dim, k in enumerate(key):
@@ -437,21 +732,247 @@ class DeferredArray(NumPyThunk):
         )
 
     def _broadcast(self, shape):
-        result = self.base
-        diff = len(shape) - result.ndim
-        for dim in range(diff):
-            result = result.promote(dim, shape[dim])
+        return broadcast_store(self.base, shape)
+
+    # Boolean masks of the same shape as the array are handled by the
+    # COMPRESS and PLACE tasks, which read the mask directly instead of
+    # going through the coordinates of its nonzeros
+    def _is_boolean_mask(self, key):
+        return (
+            self.ndim > 0
+            and isinstance(key, NumPyThunk)
+            and key.dtype == np.bool_
+            and key.shape == self.shape
+        )
+
+    # Return the tile size and the number of tiles of the outermost
+    # dimension that give every processor about the same share of a mask
+    def _mask_tiling(self):
+        extent = self.shape[0]
+        num_tiles = max(1, min(self.runtime.num_procs, extent))
+        tile = (extent + num_tiles - 1) // num_tiles
+        return tile, (extent + tile - 1) // tile
+
+    def _compress(self, mask, stacklevel):
+        mask = self.runtime.to_deferred_array(mask, stacklevel=stacklevel + 1)
+        result = self.runtime.create_unbound_thunk(self.dtype)
+
+        if self.ndim == 1 or self.size == 0:
+            task = self.context.create_task(CuNumericOpCode.COMPRESS)
+            task.add_input(self.base)
+            task.add_input(mask.base)
+            task.add_alignment(self.base, mask.base)
+        else:
+            # The pieces of an unbound store are concatenated in the order
+            # of the launch, so only the outermost dimension is tiled to
+            # keep the selected values in row-major order
+            tile, num_tiles = self._mask_tiling()
+            tile_shape = (tile,) + self.shape[1:]
+            task = self.context.create_task(
+                CuNumericOpCode.COMPRESS,
+                manual=True,
+                launch_domain=Rect(hi=(num_tiles,) + (1,) * (self.ndim - 1)),
+            )
+            task.add_input(self.base.partition_by_tiling(tile_shape))
+            task.add_input(mask.base.partition_by_tiling(tile_shape))
+        task.add_output(result.base)
+
+        task.execute()
+        return result
+
+    def _place(self, mask, rhs, stacklevel):
+        if self.size == 0:
+            return
+        mask = self.runtime.to_deferred_array(mask, stacklevel=stacklevel + 1)
+        if rhs._scalar_value is not None:
+            self._where(mask, rhs, None)
+            return
+        values = rhs.base
+
+        if rhs.size == 1:
+            while values.ndim > 1:
+                values = values.project(0, 0)
+            if values.ndim == 0:
+                values = values.promote(0, 1)
+
+            task = self.context.create_task(CuNumericOpCode.PLACE)
+            task.add_output(self.base)
+            task.add_input(self.base)
+            task.add_input(mask.base)
+            task.add_input(values)
+            task.add_scalar_arg(True, bool)
+            task.add_alignment(self.base, mask.base)
+            task.add_broadcast(values)
+
+            task.execute()
+            return
+
+        # Every tile of the outermost dimension takes the values after those
+        # of the tiles before it, so the tiles are counted first
+        tile, num_tiles = self._mask_tiling()
+        extent = self.shape[0]
+        bounds = [
+            (lo, min(lo + tile, extent)) for lo in range(0, extent, tile)
+        ]
+        counts = []
+        for lo, hi in bounds:
+            view = DeferredArray(
+                self.runtime,
+                base=mask.base.slice(0, slice(lo, hi)),
+                dtype=mask.dtype,
+            )
+            count = self.runtime.create_empty_thunk(
+                (), np.dtype(np.uint64), inputs=[mask]
+            )
+            count.unary_reduction(
+                UnaryRedCode.COUNT_NONZERO,
+                view,
+                True,
+                None,
+                False,
+                None,
+                None,
+                stacklevel=stacklevel + 1,
+            )
+            counts.append(count)
+        counts = [
+            int(count.get_scalar_array(stacklevel + 1)) for count in counts
+        ]
+        total = sum(counts)
+        if rhs.ndim != 1 or rhs.shape[0] != total:
+            raise ValueError(
+                "NumPy boolean array indexing assignment cannot assign "
+                f"{rhs.size} input values to the {total} output values "
+                "where the mask is true"
+            )
+
+        offset = 0
+        for (lo, hi), count in zip(bounds, counts):
+            if count == 0:
+                continue
+            out = self.base.slice(0, slice(lo, hi))
+            task = self.context.create_task(
+                CuNumericOpCode.PLACE,
+                manual=True,
+                launch_domain=Rect(hi=(1,)),
+            )
+            task.add_output(out)
+            task.add_input(out)
+            task.add_input(mask.base.slice(0, slice(lo, hi)))
+            task.add_input(values.slice(0, slice(offset, offset + count)))
+            task.add_scalar_arg(False, bool)
+            task.execute()
+            offset += count
+
+    # Tuples of one integer index array per dimension select points of a
+    # multi-dimensional array, which the GATHER and SCATTER tasks read and
+    # write directly
+    def _is_point_index(self, key):
+        return (
+            isinstance(key, tuple)
+            and len(key) == self.ndim
+            and all(
+                isinstance(k, NumPyThunk) and k.dtype.kind in ("i", "u")
+                for k in key
+            )
+        )
+
+    # Broadcast the index arrays of the key against each other, returning
+    # the shape of the selection and an int64 store per index array
+    def _index_stores(self, key, stacklevel):
+        shape = np.broadcast(*(np.empty(k.shape, dtype=[]) for k in key)).shape
+        stores = []
+        for k in key:
+            k = self.runtime.to_deferred_array(k, stacklevel=stacklevel + 1)
+            if k.dtype != np.int64:
+                index = self.runtime.create_empty_thunk(
+                    k.shape, np.dtype(np.int64), inputs=[k]
+                )
+                index.convert(k, stacklevel=stacklevel + 1)
+                k = index
+            stores.append(k._broadcast(shape))
+        return shape, stores
+
+    def _gather(self, key, stacklevel):
+        shape, indices = self._index_stores(key, stacklevel + 1)
+        result = self.runtime.create_empty_thunk(
+            shape, self.dtype, inputs=[self]
+        )
+        if result.size == 0:
+            return result
 
-        for dim in range(len(shape)):
-            if result.shape[dim] != shape[dim]:
-                assert result.shape[dim] == 1
-                result = result.project(dim, 0).promote(dim, shape[dim])
+        task = self.context.create_task(CuNumericOpCode.GATHER)
+        task.add_output(result.base)
+        task.add_input(self.base)
+        for index in indices:
+            task.add_input(index)
+            task.add_alignment(result.base, index)
+        task.add_broadcast(self.base)
 
+        task.execute()
         return result
 
+    # Write the values into the selected points, or fold them in with the
+    # given reduction. Assignments run in a single task, so that the last of
+    # repeated indices wins as it does in NumPy, whereas reductions take any
+    # partitioning of the indices, each piece reducing into the whole array.
+    def _scatter(self, key, rhs, redop, stacklevel):
+        shape, indices = self._index_stores(key, stacklevel + 1)
+        if 0 in shape:
+            return
+        values = rhs._broadcast(shape)
+
+        if redop is None:
+            task = self.context.create_task(
+                CuNumericOpCode.SCATTER,
+                manual=True,
+                launch_domain=Rect(hi=(1,)),
+            )
+            task.add_output(self.base)
+            task.add_input(self.base)
+        else:
+            task = self.context.create_task(CuNumericOpCode.SCATTER)
+            task.add_reduction(self.base, redop)
+            task.add_broadcast(self.base)
+        for index in indices:
+            task.add_input(index)
+        task.add_input(values)
+        task.add_scalar_arg(-1 if redop is None else int(redop), ty.int32)
+        if redop is not None:
+            for index in indices:
+                task.add_alignment(values, index)
+
+        task.execute()
+
+    @auto_convert([2])
+    def scatter_reduce(self, key, rhs, op, stacklevel=0):
+        redops = {"add": ReductionOp.ADD, "maximum": ReductionOp.MAX}
+        if not isinstance(key, tuple):
+            key = (key,)
+        if (
+            op not in redops
+            or self.dtype.kind not in ("b", "i", "u", "f")
+            or not self._is_point_index(key)
+        ):
+            raise NotImplementedError(
+                f"{op}.at needs an integer index array per dimension of an "
+                "array of booleans, integers or floats"
+            )
+        assert self.dtype == rhs.dtype
+        self._scatter(key, rhs, redops[op], stacklevel=(stacklevel + 1))
+        if self.runtime.shadow_debug:
+            self.shadow.scatter_reduce(
+                key, rhs.shadow, op, stacklevel=(stacklevel + 1)
+            )
+            self.runtime.check_shadow(self, "scatter_reduce")
+
     def get_item(self, key, stacklevel=0):
         # Check to see if this is advanced indexing or not
-        if self._is_advanced_indexing(key):
+        if self._is_boolean_mask(key):
+            result = self._compress(key, stacklevel=(stacklevel + 1))
+        elif self.ndim > 1 and self._is_point_index(key):
+            result = self._gather(key, stacklevel=(stacklevel + 1))
+        elif self._is_advanced_indexing(key):
             # Create the indexing array
             index_array = self._create_indexing_array(
                 key, stacklevel=(stacklevel + 1)
@@ -485,12 +1006,8 @@ class DeferredArray(NumPyThunk):
                 result = self.runtime.create_empty_thunk(
                     (), self.dtype, inputs=[self]
                 )
-
-                task = self.context.create_task(CuNumericOpCode.READ)
-                task.add_input(input.base)
-                task.add_output(result.base)
-
-                task.execute()
+                # Consecutive scalar reads are issued as a single task
+                self.runtime.elements.record_read(result, input.base)
 
         if self.runtime.shadow_debug:
             result.shadow = self.shadow.get_item(
@@ -503,7 +1020,11 @@ class DeferredArray(NumPyThunk):
     def set_item(self, key, rhs, stacklevel=0):
         assert self.dtype == rhs.dtype
         # Check to see if this is advanced indexing or not
-        if self._is_advanced_indexing(key):
+        if self._is_boolean_mask(key):
+            self._place(key, rhs, stacklevel=(stacklevel + 1))
+        elif self.ndim > 1 and self._is_point_index(key):
+            self._scatter(key, rhs, None, stacklevel=(stacklevel + 1))
+        elif self._is_advanced_indexing(key):
             # Create the indexing array
             index_array = self._create_indexing_array(
                 key, stacklevel=(stacklevel + 1)
@@ -633,13 +1154,13 @@ class DeferredArray(NumPyThunk):
         #
         # Update 9/22/2021: the non-affineness with delinearization leads
         # to non-contiguous subregions in several places, and thus we
-        # decided to avoid using it and make copies instead. This means
-        # the third case in the table above now leads to two copies, one from
-        # the source to a 1-D temporary array and one from that temporary
-        # to the target array. We expect that such reshaping requests are
-        # infrequent enough that the extra copies are causing any noticeable
-        # performance issues, but we will revisit this decision later once
-        # we have enough evidence that that's not the case.
+        # decided to avoid using it and make copies instead.
+        #
+        # Views that only split extents are delinearized again when the
+        # leading dimension of the target has at least one tile per
+        # processor. Those tiles cover whole blocks of the source and stay
+        # contiguous. Every other case is a single RESHAPE copy that maps
+        # the points of the target onto the source in row-major order.
 
         in_dim = 0
         out_dim = 0
@@ -687,67 +1208,18 @@ class DeferredArray(NumPyThunk):
 
         needs_linearization = any(len(src_g) > 1 for src_g, _ in groups)
         needs_delinearization = any(len(tgt_g) > 1 for _, tgt_g in groups)
-        needs_copy = needs_linearization or needs_delinearization
+        needs_copy = needs_linearization or (
+            needs_delinearization and newshape[0] < self.runtime.num_procs
+        )
 
         if needs_copy:
-            tmp_shape = ()
-            for src_g, tgt_g in groups:
-                if len(src_g) > 1 and len(tgt_g) > 1:
-                    tmp_shape += (_prod(tgt_g),)
-                else:
-                    tmp_shape += tgt_g
-
             result = self.runtime.create_empty_thunk(
-                tmp_shape, dtype=self.dtype, inputs=[self]
+                newshape, dtype=self.dtype, inputs=[self]
             )
-
-            src = self.base
-            tgt = result.base
-
-            src_dim = 0
-            tgt_dim = 0
-            for src_g, tgt_g in groups:
-                diff = 1
-                if src_g == tgt_g:
-                    assert len(src_g) == 1
-                elif len(src_g) == 0:
-                    assert tgt_g == (1,)
-                    src = src.promote(src_dim, 1)
-                elif len(tgt_g) == 0:
-                    assert src_g == (1,)
-                    tgt = tgt.promote(tgt_dim, 1)
-                elif len(src_g) == 1:
-                    src = src.delinearize(src_dim, tgt_g)
-                    diff = len(tgt_g)
-                else:
-                    tgt = tgt.delinearize(tgt_dim, src_g)
-                    diff = len(src_g)
-
-                src_dim += diff
-                tgt_dim += diff
-
-            assert src.shape == tgt.shape
-
-            src_array = DeferredArray(self.runtime, src, self.dtype)
-            tgt_array = DeferredArray(self.runtime, tgt, self.dtype)
-            tgt_array.copy(src_array, deep=True, stacklevel=stacklevel + 1)
-
-            if needs_delinearization and needs_linearization:
-                src = result.base
-                src_dim = 0
-                for src_g, tgt_g in groups:
-                    if len(src_g) > 1 and len(tgt_g) > 1:
-                        src = src.delinearize(src_dim, tgt_g)
-                        src_dim += len(tgt_g)
-
-                assert src.shape == newshape
-                src_array = DeferredArray(self.runtime, src, self.dtype)
-                result = self.runtime.create_empty_thunk(
-                    newshape, dtype=self.dtype, inputs=[self]
-                )
-                result.copy(src_array, deep=True, stacklevel=stacklevel + 1)
+            result._reshape_copy(self)
 
         else:
+            self._owns_store = False
             src = self.base
             src_dim = 0
             for src_g, tgt_g in groups:
@@ -762,8 +1234,9 @@ class DeferredArray(NumPyThunk):
                     src = src.project(src_dim, 1)
                     diff = 0
                 else:
-                    # unreachable
-                    assert False
+                    assert len(src_g) == 1
+                    src = src.delinearize(src_dim, tgt_g)
+                    diff = len(tgt_g)
 
                 src_dim += diff
 
@@ -771,6 +1244,37 @@ class DeferredArray(NumPyThunk):
 
         return result
 
+    # Copies the source, which has the same number of elements, in
+    # row-major order into this array. The target is split into blocks
+    # along its first dimension and every block is copied by its own task
+    # from the rows of the source that hold its elements.
+    def _reshape_copy(self, src):
+        if self.size == 0:
+            return
+        out = self.base
+        extent = self.shape[0]
+        out_row = int(_prod(self.shape[1:]))
+        in_row = int(_prod(src.shape[1:]))
+        num_blocks = min(self.runtime.num_procs, extent)
+        block = (extent + num_blocks - 1) // num_blocks
+
+        for lo in range(0, extent, block):
+            hi = min(lo + block, extent)
+            flat_lo = lo * out_row
+            flat_hi = hi * out_row
+            in_lo = flat_lo // in_row
+            in_hi = (flat_hi + in_row - 1) // in_row
+
+            task = self.context.create_task(
+                CuNumericOpCode.RESHAPE,
+                manual=True,
+                launch_domain=Rect(hi=(1,)),
+            )
+            task.add_output(out.slice(0, slice(lo, hi)))
+            task.add_input(src.base.slice(0, slice(in_lo, in_hi)))
+            task.add_scalar_arg(flat_lo - in_lo * in_row, ty.int64)
+            task.execute()
+
     def squeeze(self, axis, stacklevel):
         result = self.base
         if axis is None:
@@ -791,6 +1295,7 @@ class DeferredArray(NumPyThunk):
                 '"axis" argument for squeeze must be int-like or tuple-like'
             )
         result = DeferredArray(self.runtime, result, self.dtype)
+        self._owns_store = False
         if self.runtime.shadow_debug:
             result.shadow = self.shadow.squeeze(
                 axis, stacklevel=stacklevel + 1
@@ -808,6 +1313,9 @@ class DeferredArray(NumPyThunk):
 
         result = self.base.transpose(dims)
         result = DeferredArray(self.runtime, result, self.dtype)
+        self._owns_store = False
+        if self.ndim == 2:
+            result.transpose_source = self
 
         if self.runtime.shadow_debug:
             result.shadow = self.shadow.swapaxes(
@@ -835,6 +1343,7 @@ class DeferredArray(NumPyThunk):
                 stacklevel=(stacklevel + 1),
             )
 
+        held = lhs_array._can_hold_launch((rhs_array,))
         lhs = lhs_array.base
         rhs = rhs_array.base
 
@@ -845,45 +1354,131 @@ class DeferredArray(NumPyThunk):
 
         task.add_alignment(lhs, rhs)
 
-        task.execute()
+        lhs_array._submit(task, (rhs_array,), held)
 
     @profile
     @auto_convert([1, 2])
     @shadow_debug("convolve", [1, 2])
-    def convolve(self, v, lhs, mode, stacklevel=0, callsite=None):
+    def convolve(
+        self, v, lhs, mode, stride, dilation, stacklevel=0, callsite=None
+    ):
         input = self.base
         filter = v.base
         out = lhs.base
 
+        # A dilated filter spreads its points dilation input points apart
+        extents = tuple(
+            (extent - 1) * step + 1
+            for extent, step in zip(filter.shape, dilation)
+        )
+        if any(step != 1 for step in stride):
+            self._strided_convolve(filter, out, stride, dilation, extents)
+            return
+
+        # Leading axes along which the filter has a single point are batch
+        # axes, which hold independent signals that need no halo
+        batch_dims = 0
+        while batch_dims < self.ndim - 1 and filter.shape[batch_dims] == 1:
+            batch_dims += 1
+        num_procs = self.runtime.num_procs
+        if batch_dims > 0:
+            split = max(range(batch_dims), key=lambda dim: out.shape[dim])
+            if out.shape[split] >= num_procs:
+                self._batched_convolve(filter, out, split, dilation)
+                return
+
         task = self.context.create_task(CuNumericOpCode.CONVOLVE)
 
-        offsets = (filter.shape + 1) // 2
-        stencils = []
-        for offset in offsets:
-            stencils.append((-offset, 0, offset))
-        stencils = list(product(*stencils))
-        stencils.remove((0,) * self.ndim)
+        # Output points read the input up to the center of the filter away
+        # on either side, which is none along the batch axes
+        halo = tuple((extent // 2, extent // 2) for extent in extents)
 
         p_out = task.declare_partition(out)
-        p_input = task.declare_partition(input)
-        p_stencils = []
-        for _ in stencils:
-            p_stencils.append(task.declare_partition(input, complete=False))
-
         task.add_output(out, partition=p_out)
         task.add_input(filter)
-        task.add_input(input, partition=p_input)
-        for p_stencil in p_stencils:
-            task.add_input(input, partition=p_stencil)
-        task.add_scalar_arg(self.shape, (ty.int64,))
+        p_input = add_halo_input(task, input, halo)
+        self._add_convolve_args(task, (1,) * self.ndim, dilation)
 
         task.add_constraint(p_out == p_input)
-        for stencil, p_stencil in zip(stencils, p_stencils):
-            task.add_constraint(p_input + stencil <= p_stencil)
         task.add_broadcast(filter)
 
         task.execute()
 
+    def _add_convolve_args(self, task, stride, dilation, offset=None):
+        if offset is None:
+            offset = (0,) * self.ndim
+        task.add_scalar_arg(self.shape, (ty.int64,))
+        task.add_scalar_arg(tuple(stride), (ty.int64,))
+        task.add_scalar_arg(tuple(dilation), (ty.int64,))
+        task.add_scalar_arg(tuple(offset), (ty.int64,))
+
+    def _batched_convolve(self, filter, out, split, dilation):
+        # Every point of the launch takes whole signals, so the arrays are
+        # only tiled along the split batch axis and all points read the same
+        # filter
+        num_procs = self.runtime.num_procs
+        extent = out.shape[split]
+        block = (extent + num_procs - 1) // num_procs
+        color_shape = [1] * self.ndim
+        color_shape[split] = (extent + block - 1) // block
+        tile = tuple(
+            block if dim == split else out.shape[dim]
+            for dim in range(self.ndim)
+        )
+
+        task = self.context.create_task(
+            CuNumericOpCode.CONVOLVE,
+            manual=True,
+            launch_domain=Rect(hi=tuple(color_shape)),
+        )
+        task.add_output(out.partition_by_tiling(tile))
+        task.add_input(filter)
+        task.add_input(self.base.partition_by_tiling(tile))
+        self._add_convolve_args(task, (1,) * self.ndim, dilation)
+        task.execute()
+
+    def _strided_convolve(self, filter, out, stride, dilation, extents):
+        # The output tiles of a strided convolution cover stride times as
+        # many input points as they hold, which no partition of the input
+        # can line up with. The output is instead split into blocks along
+        # its widest axis and every block is convolved by its own task on
+        # the slice of the input under the block and its halo. The offset
+        # moves the points of the output slice onto the input slice.
+        split = max(range(self.ndim), key=lambda dim: out.shape[dim])
+        extent = out.shape[split]
+        num_blocks = min(self.runtime.num_procs, extent)
+        block = (extent + num_blocks - 1) // num_blocks
+        step = stride[split]
+        center = extents[split] // 2
+
+        for lo in range(0, extent, block):
+            hi = min(lo + block, extent)
+            in_lo = max(lo * step - center, 0)
+            in_hi = min(
+                (hi - 1) * step + extents[split] - center, self.shape[split]
+            )
+            offset = [0] * self.ndim
+            offset[split] = lo * step - in_lo
+
+            task = self.context.create_task(
+                CuNumericOpCode.CONVOLVE,
+                manual=True,
+                launch_domain=Rect(hi=(1,)),
+            )
+            task.add_output(out.slice(split, slice(lo, hi)))
+            task.add_input(filter)
+            task.add_input(self.base.slice(split, slice(in_lo, in_hi)))
+            self._add_convolve_args(task, stride, dilation, offset)
+            task.execute()
+
+    @profile
+    @auto_convert([1])
+    @shadow_debug("fft", [1])
+    def fft(
+        self, rhs, axes, kind, inverse, scale, stacklevel=0, callsite=None
+    ):
+        fft(self, rhs, axes, kind, inverse, scale)
+
     # Fill the cuNumeric array with the value in the numpy array
     @profile
     def _fill(self, value, stacklevel=0, callsite=None):
@@ -908,14 +1503,71 @@ class DeferredArray(NumPyThunk):
             task.add_output(self.base)
             task.add_input(value)
             task.add_scalar_arg(argval, bool)
+            task.add_scalar_arg(False, bool)
 
             task.execute()
 
+    # Fill with the single element of rhs, by value when it is known here
+    def _fill_from(self, rhs, stacklevel=0, callsite=None):
+        assert rhs.scalar
+        value = rhs._uniform_value
+        if value is None or self.scalar:
+            self._fill(rhs.base, stacklevel=stacklevel + 1, callsite=callsite)
+        else:
+            self._fill_value(
+                np.array(value, dtype=self.dtype), stacklevel + 1, callsite
+            )
+
     @shadow_debug("fill", [])
     def fill(self, numpy_array, stacklevel=0, callsite=None):
         assert isinstance(numpy_array, np.ndarray)
         assert numpy_array.size == 1
         assert self.dtype == numpy_array.dtype
+        # Arrays that nobody has seen yet only remember the value, which is
+        # written out once their store is needed
+        if self._fresh and not self.scalar and self.dtype.kind != "V":
+            self._fresh = False
+            self._constant = numpy_array.copy()
+            return
+        self._fill_value(numpy_array, stacklevel + 1, callsite)
+
+    # Every point task reads or writes the rows of its own tile of the data,
+    # so nothing is staged through the driver
+    def _npy_task(self, op_code, path):
+        task = self.context.create_task(op_code)
+        task.add_scalar_arg(tuple(os.fsencode(path)), (ty.uint8,))
+        task.add_scalar_arg(self.shape, (ty.int64,))
+        return task
+
+    @profile
+    @shadow_debug("load_npy", [])
+    def load_npy(self, path, offset, stacklevel=0, callsite=None):
+        task = self._npy_task(CuNumericOpCode.LOAD_NPY, path)
+        task.add_scalar_arg(offset, ty.int64)
+        task.add_output(self.base)
+        task.execute()
+
+    @profile
+    def save_npy(self, path, offset, stacklevel=0, callsite=None):
+        task = self._npy_task(CuNumericOpCode.SAVE_NPY, path)
+        task.add_scalar_arg(offset, ty.int64)
+        task.add_input(self.base)
+        task.execute()
+        # Like np.save, the file is complete once this returns
+        self.runtime.legate_runtime.issue_execution_fence(block=True)
+
+    def _fill_value(self, numpy_array, stacklevel=0, callsite=None):
+        # Values that tasks take as scalar arguments are passed by value, so
+        # the fill neither makes a future nor maps an instance for it
+        if not self.scalar and self.runtime.is_host_scalar_type(self.dtype):
+            task = self.context.create_task(CuNumericOpCode.FILL)
+            task.add_output(self.base)
+            task.add_scalar_arg(False, bool)
+            task.add_scalar_arg(True, bool)
+            task.add_scalar_arg(numpy_array.reshape(())[()], self.dtype)
+
+            task.execute()
+            return
         # Have to copy the numpy array because this launch is asynchronous
         # and we need to make sure the application doesn't mutate the value
         # so make a future result, this is immediate so no dependence
@@ -929,6 +1581,8 @@ class DeferredArray(NumPyThunk):
     @auto_convert([1, 2])
     @shadow_debug("dot", [1, 2])
     def dot(self, src1, src2, stacklevel=0, callsite=None):
+        if self._diagonal_dot(src1, src2, stacklevel, callsite):
+            return
         rhs1_array = src1
         rhs2_array = src2
         lhs_array = self
@@ -1033,14 +1687,36 @@ class DeferredArray(NumPyThunk):
                 rhs1 = rhs1_array.base.promote(1, n)
                 lhs = lhs_array.base.promote(0, m)
 
-            task = self.context.create_task(CuNumericOpCode.MATVECMUL)
-            task.add_reduction(lhs, ReductionOp.ADD)
-            task.add_input(rhs1)
-            task.add_input(rhs2)
-            task.add_scalar_arg(left_matrix, bool)
+            if left_matrix and rhs1_array.transpose_source is not None:
+                # A transposed matrix, as in A.T @ x, is split along the rows
+                # of A only, so that every point task multiplies whole rows
+                # of its source in place with a transposed GEMV and the
+                # partial products are reduced into the output
+                extent = n
+                num_tiles = max(1, min(self.runtime.num_procs, extent))
+                tile = (m, (extent + num_tiles - 1) // num_tiles)
+                num_tiles = (extent + tile[1] - 1) // tile[1]
+
+                task = self.context.create_task(
+                    CuNumericOpCode.MATVECMUL,
+                    manual=True,
+                    launch_domain=Rect(hi=(1, num_tiles)),
+                )
+                task.add_reduction(
+                    lhs.partition_by_tiling(tile), ReductionOp.ADD
+                )
+                task.add_input(rhs1.partition_by_tiling(tile))
+                task.add_input(rhs2.partition_by_tiling(tile))
+                task.add_scalar_arg(left_matrix, bool)
+            else:
+                task = self.context.create_task(CuNumericOpCode.MATVECMUL)
+                task.add_reduction(lhs, ReductionOp.ADD)
+                task.add_input(rhs1)
+                task.add_input(rhs2)
+                task.add_scalar_arg(left_matrix, bool)
 
-            task.add_alignment(lhs, rhs1)
-            task.add_alignment(lhs, rhs2)
+                task.add_alignment(lhs, rhs1)
+                task.add_alignment(lhs, rhs2)
 
             task.execute()
 
@@ -1086,9 +1762,57 @@ class DeferredArray(NumPyThunk):
                 )
                 return
 
-            if rhs1_array.dtype == np.float16:
+            # The product of a matrix with its own transpose is symmetric,
+            # so only one triangle of it is computed
+            if (
+                rhs1_array.transpose_source is rhs2_array
+                and rhs2_array.dtype == self.dtype
+                and self.dtype in (np.float32, np.float64)
+            ):
+                self._gram(
+                    rhs2_array, stacklevel=stacklevel + 1, callsite=callsite
+                )
+                return
+
+            # A few right-hand sides, as in block Krylov solvers, are
+            # multiplied in a single pass over the matrix: the batched
+            # product tiles only the rows, so every point task streams its
+            # rows once against all of the vectors, and there is neither a
+            # zero fill nor a reduction of partial sums
+            if (
+                N <= _MAX_MULTI_RHS
+                and M >= N * self.runtime.num_procs
+                and not (
+                    rhs1_array.dtype == np.float16
+                    and self.runtime.half_matmul_output
+                )
+                and rhs1_array.dtype not in (np.int8, np.uint8)
+            ):
+                lhs_array.batched_matmul(
+                    rhs1_array,
+                    rhs2_array,
+                    stacklevel=stacklevel + 1,
+                    callsite=callsite,
+                )
+                return
+
+            # Unless asked for a half precision result, float16 products
+            # accumulate into a float32 temporary
+            accumulate_in_float = (
+                rhs1_array.dtype == np.float16
+                and not self.runtime.half_matmul_output
+            )
+            # 8-bit integer products accumulate in int32, so an int32 output
+            # keeps the full accumulators and any other one is converted
+            accumulate_in_int = (
+                rhs1_array.dtype in (np.int8, np.uint8)
+                and self.dtype != np.int32
+            )
+            if accumulate_in_float or accumulate_in_int:
                 lhs_array = self.runtime.create_empty_thunk(
-                    self.shape, np.dtype(np.float32), inputs=[self]
+                    self.shape,
+                    np.dtype(np.float32 if accumulate_in_float else np.int32),
+                    inputs=[self],
                 )
 
             rhs1_array = rhs1_array._copy_if_overlapping(
@@ -1109,19 +1833,25 @@ class DeferredArray(NumPyThunk):
             rhs1 = rhs1_array.base.promote(2, N)
             rhs2 = rhs2_array.base.promote(0, M)
 
-            task = self.context.create_task(CuNumericOpCode.MATMUL)
-            task.add_reduction(lhs, ReductionOp.ADD)
-            task.add_input(rhs1)
-            task.add_input(rhs2)
+            # Large products on many processors go through SUMMA, which
+            # keeps the partial sums of every tile on the processor that
+            # owns it instead of reducing them across the inner dimension
+            if use_summa(self.runtime, M, N, K):
+                summa(self.context, self.runtime.num_procs, lhs, rhs1, rhs2)
+            else:
+                task = self.context.create_task(CuNumericOpCode.MATMUL)
+                task.add_reduction(lhs, ReductionOp.ADD)
+                task.add_input(rhs1)
+                task.add_input(rhs2)
 
-            task.add_alignment(lhs, rhs1)
-            task.add_alignment(lhs, rhs2)
+                task.add_alignment(lhs, rhs1)
+                task.add_alignment(lhs, rhs2)
 
-            task.execute()
+                task.execute()
 
             # If we used an accumulation buffer, we should copy the results
             # back to the lhs
-            if rhs1_array.dtype == np.float16:
+            if accumulate_in_float or accumulate_in_int:
                 # Since we're still in the middle of operation, we haven't had
                 # a chance to get the shadow array for this intermediate array,
                 # so we manually attach a shadow array for it
@@ -1141,64 +1871,312 @@ class DeferredArray(NumPyThunk):
                 f"dot between {rhs1_array.ndim}d and {rhs2_array.ndim}d arrays"
             )
 
-    @profile
-    @auto_convert([2, 4])
-    @shadow_debug("contract", [2, 4])
-    def contract(
-        self,
-        lhs_modes,
-        rhs1_thunk,
-        rhs1_modes,
-        rhs2_thunk,
-        rhs2_modes,
-        mode2extent,
-        stacklevel=0,
-        callsite=None,
-    ):
-        lhs_thunk = self
+    # Compute the Gram matrix X^T X of the matrix X. Every row block of X
+    # adds its own Gram matrix to the result, with SYRK computing the lower
+    # triangle and the task mirroring it to the upper one.
+    def _gram(self, rhs, stacklevel=0, callsite=None):
+        m, n = rhs.shape
+        assert self.shape == (n, n)
 
-        # TODO: More sanity checks (no duplicate modes, no singleton modes, no
-        # broadcasting, ...)
+        self.fill(
+            np.array(0, dtype=self.dtype),
+            stacklevel=stacklevel + 1,
+            callsite=callsite,
+        )
+        if m == 0:
+            return
 
-        # Casting should have been handled by the frontend
-        assert lhs_thunk.dtype is rhs1_thunk.dtype
-        assert lhs_thunk.dtype is rhs2_thunk.dtype
+        rhs = rhs._copy_if_overlapping(self, stacklevel=stacklevel + 1)
+        tile = (m + self.runtime.num_procs - 1) // self.runtime.num_procs
+        count = (m + tile - 1) // tile
 
-        # Handle store overlap
-        rhs1_thunk = rhs1_thunk._copy_if_overlapping(lhs_thunk)
-        rhs2_thunk = rhs2_thunk._copy_if_overlapping(lhs_thunk)
+        task = self.context.create_task(
+            CuNumericOpCode.GRAM,
+            manual=True,
+            launch_domain=Rect(hi=(count, 1)),
+        )
+        task.add_reduction(self.base, ReductionOp.ADD)
+        task.add_input(rhs.base.partition_by_tiling((tile, n)))
+        task.execute()
 
-        # Clear output array
-        # TODO: We should be able to do this in the core
-        lhs_thunk.fill(
-            np.array(0, dtype=lhs_thunk.dtype),
-            stacklevel=(stacklevel + 1),
-            callsite=callsite,
+    # Multiply the CSR matrix made of the row pointers pos, the column
+    # indices crd and the values vals with the dense vector or matrix rhs.
+    # The rows are split into blocks of about the same amount of work, which
+    # takes the host copy of the row pointers in indptr, and every block is
+    # multiplied by its own task on its slices of the three stores.
+    @profile
+    @auto_convert([1, 2, 3, 4])
+    @shadow_debug("spmm", [1, 2, 3, 4])
+    def spmm(self, pos, crd, vals, rhs, indptr, stacklevel=0, callsite=None):
+        lhs = self.base
+        rhs_store = rhs.base
+        if self.ndim == 1:
+            lhs = lhs.promote(1, 1)
+            rhs_store = rhs_store.promote(1, 1)
+
+        m = self.shape[0]
+        num_blocks = min(self.runtime.num_procs, m)
+        # Every row costs a little even without nonzeros
+        work = indptr + np.arange(m + 1)
+        targets = (np.arange(1, num_blocks) * work[-1]) // num_blocks
+        splits = np.unique(
+            np.concatenate(([0], np.searchsorted(work, targets), [m]))
         )
 
-        lhs = lhs_thunk.base
-        rhs1 = rhs1_thunk.base
-        rhs2 = rhs2_thunk.base
+        for lo, hi in zip(splits[:-1], splits[1:]):
+            nz_lo, nz_hi = int(indptr[lo]), int(indptr[hi])
+            task = self.context.create_task(
+                CuNumericOpCode.SPMM, manual=True, launch_domain=Rect(hi=(1,))
+            )
+            task.add_output(lhs.slice(0, slice(lo, hi)))
+            task.add_input(pos.base.slice(0, slice(lo, hi + 1)))
+            task.add_input(crd.base.slice(0, slice(nz_lo, nz_hi)))
+            task.add_input(vals.base.slice(0, slice(nz_lo, nz_hi)))
+            task.add_input(rhs_store)
+            task.execute()
 
-        # The underlying libraries are not guaranteed to work with stride
-        # values of 0. The frontend should therefore handle broadcasting
-        # directly, instead of promoting stores.
-        assert not lhs.has_fake_dims()
-        assert not rhs1.has_fake_dims()
-        assert not rhs2.has_fake_dims()
+    # Every task of the block-quantized kernels gets whole rows of the
+    # codes, the scales and the values, which have a block of codes and a
+    # scale for every QUANT_BLOCK elements of a row
+    def _quantized_task(self, op_code, rows):
+        tile = (rows + self.runtime.num_procs - 1) // self.runtime.num_procs
+        num_tiles = (rows + tile - 1) // tile
+        task = self.context.create_task(
+            op_code, manual=True, launch_domain=Rect(hi=(num_tiles, 1))
+        )
 
-        # Transpose arrays according to alphabetical order of mode labels
-        def alphabetical_transpose(store, modes):
-            perm = [dim for (_, dim) in sorted(zip(modes, range(len(modes))))]
-            return store.transpose(perm)
+        def rows_of(array):
+            if array.ndim == 1:
+                return array.base.promote(1, 1).partition_by_tiling((tile, 1))
+            return array.base.partition_by_tiling((tile, array.shape[1]))
 
-        lhs = alphabetical_transpose(lhs, lhs_modes)
-        rhs1 = alphabetical_transpose(rhs1, rhs1_modes)
-        rhs2 = alphabetical_transpose(rhs2, rhs2_modes)
+        return task, rows_of
 
-        # Promote dimensions as required to align the stores
-        lhs_dim_mask = []
-        rhs1_dim_mask = []
+    @profile
+    @auto_convert([1, 2])
+    @shadow_debug("quantize", [1, 2])
+    def quantize(self, scales, values, bits, stacklevel=0, callsite=None):
+        if values.size == 0:
+            return
+        rows = values.shape[0]
+        task, rows_of = self._quantized_task(CuNumericOpCode.QUANTIZE, rows)
+        task.add_output(rows_of(self))
+        task.add_output(rows_of(scales))
+        task.add_input(rows_of(values))
+        task.add_scalar_arg(bits, ty.int32)
+        task.add_scalar_arg(False, bool)
+        task.execute()
+
+    @profile
+    @auto_convert([1, 2])
+    @shadow_debug("dequantize", [1, 2])
+    def dequantize(self, codes, scales, bits, stacklevel=0, callsite=None):
+        if self.size == 0:
+            return
+        rows = self.shape[0]
+        task, rows_of = self._quantized_task(CuNumericOpCode.QUANTIZE, rows)
+        task.add_output(rows_of(self))
+        task.add_input(rows_of(codes))
+        task.add_input(rows_of(scales))
+        task.add_scalar_arg(bits, ty.int32)
+        task.add_scalar_arg(True, bool)
+        task.execute()
+
+    # The codes are decoded as they are loaded, so the matrix is only ever
+    # read in its compressed form
+    @profile
+    @auto_convert([1, 2, 3])
+    @shadow_debug("quantized_matvec", [1, 2, 3])
+    def quantized_matvec(
+        self, codes, scales, rhs, bits, stacklevel=0, callsite=None
+    ):
+        rows = self.shape[0]
+        if rows == 0:
+            return
+        if rhs.size == 0:
+            self.fill(
+                np.array(0, dtype=self.dtype),
+                stacklevel=stacklevel + 1,
+                callsite=callsite,
+            )
+            return
+        rhs = rhs._copy_if_overlapping(self, stacklevel=stacklevel + 1)
+        task, rows_of = self._quantized_task(
+            CuNumericOpCode.QUANTIZED_MATVEC, rows
+        )
+        task.add_output(rows_of(self))
+        task.add_input(rows_of(codes))
+        task.add_input(rows_of(scales))
+        task.add_input(rhs.base)
+        task.add_scalar_arg(bits, ty.int32)
+        task.execute()
+
+    @profile
+    @auto_convert([1, 2], ["bias"])
+    @shadow_debug("batched_matmul", [1, 2], ["bias"])
+    def batched_matmul(
+        self,
+        src1,
+        src2,
+        scale=1.0,
+        bias=None,
+        activation=UnaryOpCode.COPY,
+        stacklevel=0,
+        callsite=None,
+    ):
+        rhs1_array = src1
+        rhs2_array = src2
+        lhs_array = self
+
+        # All operands share the same leading batch shape, or are a single
+        # matrix each
+        assert rhs1_array.ndim == rhs2_array.ndim == lhs_array.ndim >= 2
+        assert rhs1_array.shape[:-2] == rhs2_array.shape[:-2]
+        assert rhs1_array.shape[:-2] == lhs_array.shape[:-2]
+
+        epilogue = (
+            scale != 1.0 or bias is not None or activation != UnaryOpCode.COPY
+        )
+        # Products with an empty inner dimension have no GEMM to fuse into
+        assert rhs1_array.shape[-1] > 0 or not epilogue
+
+        if rhs1_array.dtype == np.float16:
+            lhs_array = self.runtime.create_empty_thunk(
+                self.shape, np.dtype(np.float32), inputs=[self]
+            )
+
+        if rhs1_array.shape[-1] == 0:
+            lhs_array.fill(
+                np.array(0, dtype=lhs_array.dtype),
+                stacklevel=(stacklevel + 1),
+                callsite=callsite,
+            )
+        else:
+            rhs1_array = rhs1_array._copy_if_overlapping(
+                lhs_array, stacklevel=stacklevel + 1
+            )
+            rhs2_array = rhs2_array._copy_if_overlapping(
+                lhs_array, stacklevel=stacklevel + 1
+            )
+            # The bias is added in the accumulation type
+            if bias is not None and bias.dtype != lhs_array.dtype:
+                temp = self.runtime.create_empty_thunk(
+                    bias.shape, lhs_array.dtype, inputs=[bias]
+                )
+                temp.convert(bias, stacklevel=stacklevel + 1, warn=False)
+                bias = temp
+
+            # Tile the stores along the outermost dimension only, so that
+            # every point task gets whole matrices, or whole rows of a single
+            # matrix, and writes its products directly instead of reducing
+            # partial sums
+            lhs = lhs_array.base
+            rhs1 = rhs1_array.base
+            rhs2 = rhs2_array.base
+
+            extent = lhs.shape[0]
+            num_tiles = max(1, min(self.runtime.num_procs, extent))
+            tile = (extent + num_tiles - 1) // num_tiles
+            num_tiles = (extent + tile - 1) // tile
+
+            def tiling(store):
+                tile_shape = (tile,) + tuple(store.shape)[1:]
+                return store.partition_by_tiling(tile_shape)
+
+            launch_domain = Rect(hi=(num_tiles,) + (1,) * (lhs.ndim - 1))
+            task = self.context.create_task(
+                CuNumericOpCode.BATCHED_MATMUL,
+                manual=True,
+                launch_domain=launch_domain,
+            )
+            task.add_output(tiling(lhs))
+            task.add_input(tiling(rhs1))
+            # The right operand of a single matrix product goes whole to
+            # every point task
+            task.add_input(rhs2 if lhs.ndim == 2 else tiling(rhs2))
+            if bias is not None:
+                task.add_input(bias.base)
+            task.add_scalar_arg(scale, ty.float64)
+            task.add_scalar_arg(activation, ty.int32)
+
+            task.execute()
+
+        # If we used an accumulation buffer, we should copy the results
+        # back to the lhs
+        if rhs1_array.dtype == np.float16:
+            # Since we're still in the middle of operation, we haven't had
+            # a chance to get the shadow array for this intermediate array,
+            # so we manually attach a shadow array for it
+            if self.runtime.shadow_debug:
+                lhs_array.shadow = self.runtime.to_eager_array(
+                    lhs_array,
+                    stacklevel + 1,
+                )
+            self.convert(
+                lhs_array,
+                stacklevel=stacklevel + 1,
+                warn=False,
+                callsite=callsite,
+            )
+
+    @profile
+    @auto_convert([2, 4])
+    @shadow_debug("contract", [2, 4])
+    def contract(
+        self,
+        lhs_modes,
+        rhs1_thunk,
+        rhs1_modes,
+        rhs2_thunk,
+        rhs2_modes,
+        mode2extent,
+        stacklevel=0,
+        callsite=None,
+    ):
+        lhs_thunk = self
+
+        # TODO: More sanity checks (no duplicate modes, no singleton modes, no
+        # broadcasting, ...)
+
+        # Casting should have been handled by the frontend
+        assert lhs_thunk.dtype is rhs1_thunk.dtype
+        assert lhs_thunk.dtype is rhs2_thunk.dtype
+
+        # Handle store overlap
+        rhs1_thunk = rhs1_thunk._copy_if_overlapping(lhs_thunk)
+        rhs2_thunk = rhs2_thunk._copy_if_overlapping(lhs_thunk)
+
+        # Clear output array
+        # TODO: We should be able to do this in the core
+        lhs_thunk.fill(
+            np.array(0, dtype=lhs_thunk.dtype),
+            stacklevel=(stacklevel + 1),
+            callsite=callsite,
+        )
+
+        lhs = lhs_thunk.base
+        rhs1 = rhs1_thunk.base
+        rhs2 = rhs2_thunk.base
+
+        # The underlying libraries are not guaranteed to work with stride
+        # values of 0. The frontend should therefore handle broadcasting
+        # directly, instead of promoting stores.
+        assert not lhs.has_fake_dims()
+        assert not rhs1.has_fake_dims()
+        assert not rhs2.has_fake_dims()
+
+        # Transpose arrays according to alphabetical order of mode labels
+        def alphabetical_transpose(store, modes):
+            perm = [dim for (_, dim) in sorted(zip(modes, range(len(modes))))]
+            return store.transpose(perm)
+
+        lhs = alphabetical_transpose(lhs, lhs_modes)
+        rhs1 = alphabetical_transpose(rhs1, rhs1_modes)
+        rhs2 = alphabetical_transpose(rhs2, rhs2_modes)
+
+        # Promote dimensions as required to align the stores
+        lhs_dim_mask = []
+        rhs1_dim_mask = []
         rhs2_dim_mask = []
         for (dim, mode) in enumerate(sorted(mode2extent.keys())):
             extent = mode2extent[mode]
@@ -1227,6 +2205,7 @@ class DeferredArray(NumPyThunk):
         task.add_scalar_arg(tuple(lhs_dim_mask), (bool,))
         task.add_scalar_arg(tuple(rhs1_dim_mask), (bool,))
         task.add_scalar_arg(tuple(rhs2_dim_mask), (bool,))
+        task.add_scalar_arg(self.runtime.complex_3m, bool)
         task.add_alignment(lhs, rhs1)
         task.add_alignment(lhs, rhs2)
         task.execute()
@@ -1282,6 +2261,17 @@ class DeferredArray(NumPyThunk):
         )
         assert rhs.dtype == self.dtype
 
+        # A new diagonal matrix is only written out when it is read, and
+        # keeps a copy of the diagonal until then
+        if not extract and self._fresh:
+            values = self.runtime.create_empty_thunk(
+                rhs.shape, rhs.dtype, inputs=[rhs]
+            )
+            values.copy(rhs, stacklevel=stacklevel + 1, callsite=callsite)
+            self._fresh = False
+            self._diagonal = (values, k)
+            return
+
         # Issue a fill operation to get the output initialized
         if extract:
             diag_array.fill(
@@ -1296,9 +2286,11 @@ class DeferredArray(NumPyThunk):
                 callsite=callsite,
             )
 
-        matrix = matrix_array.base
-        diag = diag_array.base
+        self._launch_diag(matrix_array.base, diag_array.base, extract, k)
 
+    # With zero set, a constructed matrix gets zeros off the diagonal in
+    # the same pass that writes the diagonal, instead of being filled first
+    def _launch_diag(self, matrix, diag, extract, k, zero=False):
         if k > 0:
             matrix = matrix.slice(1, slice(k, None))
         elif k < 0:
@@ -1316,20 +2308,188 @@ class DeferredArray(NumPyThunk):
             task.add_input(matrix)
         else:
             task.add_output(matrix)
-            task.add_input(matrix)
+            if not zero:
+                task.add_input(matrix)
             task.add_input(diag)
 
         task.add_scalar_arg(extract, bool)
+        task.add_scalar_arg(zero, bool)
 
         task.add_alignment(matrix, diag)
 
         task.execute()
 
+    def _diagonal_length(self, k):
+        rows, cols = self.shape
+        return max(0, min(rows, cols - k) if k >= 0 else min(rows + k, cols))
+
+    def _diagonal_vector(self, values, k):
+        if isinstance(values, DeferredArray):
+            return values
+        vector = self.runtime.create_empty_thunk(
+            (self._diagonal_length(k),), self.dtype, inputs=[self]
+        )
+        vector.fill(np.array(values, dtype=self.dtype))
+        return vector
+
+    def _write_diagonal(self, values, k):
+        if self._diagonal_length(k) == 0:
+            self.fill(np.array(0, dtype=self.dtype))
+            return
+        vector = self._diagonal_vector(values, k)
+        # Only the rows or columns before the diagonal starts are outside
+        # of the slice the task writes
+        if k != 0:
+            axis = 1 if k > 0 else 0
+            outside = DeferredArray(
+                self.runtime,
+                base=self._base.slice(axis, slice(0, abs(k))),
+                dtype=self.dtype,
+            )
+            outside.fill(np.array(0, dtype=self.dtype))
+        self._launch_diag(self._base, vector.base, False, k, zero=True)
+
+    # Add the values of a diagonal to the same diagonal of this matrix,
+    # which only reads and writes that diagonal
+    def _add_to_diagonal(self, values, k, op_code, stacklevel, callsite):
+        if self._diagonal_length(k) == 0:
+            return
+        current = self.runtime.create_empty_thunk(
+            (self._diagonal_length(k),), self.dtype, inputs=[self]
+        )
+        current.diag(
+            self, True, k, stacklevel=stacklevel + 1, callsite=callsite
+        )
+        if not isinstance(values, DeferredArray):
+            values = self.runtime.create_scalar(
+                np.array(values, dtype=self.dtype).data,
+                self.dtype,
+                shape=(),
+                wrap=True,
+            )
+        current.binary_op(
+            op_code,
+            current,
+            values,
+            True,
+            (),
+            stacklevel=stacklevel + 1,
+            callsite=callsite,
+        )
+        self._launch_diag(self.base, current.base, False, k)
+
+    # Sums and differences of a matrix and a diagonal matrix, and products
+    # of a diagonal matrix with a scalar, never materialize the diagonal
+    # matrix
+    def _diagonal_binary_op(
+        self, op_code, src1, src2, args, stacklevel, callsite
+    ):
+        if args or (src1._diagonal is None and src2._diagonal is None):
+            return False
+        if src1.dtype != self.dtype or src2.dtype != self.dtype:
+            return False
+
+        if op_code == BinaryOpCode.MULTIPLY:
+            if src1._diagonal is not None:
+                diag, scale = src1, src2
+            else:
+                diag, scale = src2, src1
+            if (
+                scale._scalar_value is None
+                or not self._fresh
+                or self.shape != diag.shape
+            ):
+                return False
+            values, k = diag._diagonal
+            if isinstance(values, DeferredArray):
+                scaled = self.runtime.create_empty_thunk(
+                    values.shape, self.dtype, inputs=[values]
+                )
+                scaled.binary_op(
+                    op_code,
+                    values,
+                    scale,
+                    True,
+                    (),
+                    stacklevel=stacklevel + 1,
+                    callsite=callsite,
+                )
+            else:
+                scaled = np.array(
+                    values * scale._scalar_value, dtype=self.dtype
+                )
+            self._fresh = False
+            self._diagonal = (scaled, k)
+            return True
+
+        if op_code not in (BinaryOpCode.ADD, BinaryOpCode.SUBTRACT):
+            return False
+        if src2._diagonal is not None and src1._diagonal is None:
+            dense, diag = src1, src2
+        elif op_code == BinaryOpCode.ADD and src2._diagonal is None:
+            dense, diag = src2, src1
+        else:
+            return False
+        if dense.shape != self.shape or diag.shape != self.shape:
+            return False
+        values, k = diag._diagonal
+        if dense is not self:
+            self.copy(dense, stacklevel=stacklevel + 1, callsite=callsite)
+        self._add_to_diagonal(values, k, op_code, stacklevel, callsite)
+        return True
+
+    # Products with a diagonal matrix scale the rows or the columns of the
+    # other operand
+    def _diagonal_dot(self, src1, src2, stacklevel, callsite):
+        if src1.dtype != self.dtype or src2.dtype != self.dtype:
+            return False
+        if src1._diagonal is not None and src2._diagonal is None:
+            diag, dense = src1, src2
+        elif src2._diagonal is not None and src1._diagonal is None:
+            diag, dense = src2, src1
+        else:
+            return False
+        values, k = diag._diagonal
+        if k != 0 or diag.shape[0] != diag.shape[1]:
+            return False
+
+        if not isinstance(values, DeferredArray):
+            scale = self.runtime.create_scalar(
+                np.array(values, dtype=self.dtype).data,
+                self.dtype,
+                shape=(),
+                wrap=True,
+            )
+        elif diag is src1 and dense.ndim == 2:
+            # Every row of the product is scaled by its diagonal entry
+            scale = DeferredArray(
+                self.runtime,
+                values.base.promote(1, dense.shape[1]),
+                dtype=self.dtype,
+            )
+        else:
+            scale = values
+        self.binary_op(
+            BinaryOpCode.MULTIPLY,
+            dense,
+            scale,
+            True,
+            (),
+            stacklevel=stacklevel + 1,
+            callsite=callsite,
+        )
+        return True
+
     # Create an identity array with the ones offset from the diagonal by k
     @profile
     @shadow_debug("eye", [])
     def eye(self, k, stacklevel=0, callsite=None):
         assert self.ndim == 2  # Only 2-D arrays should be here
+        # The identity is only written out when someone reads it
+        if self._fresh:
+            self._fresh = False
+            self._diagonal = (np.array(1, dtype=self.dtype), k)
+            return
         # First issue a fill to zero everything out
         self.fill(
             np.array(0, dtype=self.dtype),
@@ -1355,6 +2515,21 @@ class DeferredArray(NumPyThunk):
             self.base.set_storage(future)
             return
 
+        # A new range is only written out once its store is needed
+        if (
+            self._fresh
+            and self.dtype.kind != "b"
+            and self.runtime.is_host_scalar_type(self.dtype)
+        ):
+            self._fresh = False
+            self._arange = tuple(
+                np.array(value, dtype=self.dtype)[()]
+                for value in (start, stop, step)
+            )
+            return
+        self._write_arange(start, stop, step)
+
+    def _write_arange(self, start, stop, step):
         def create_scalar(value, dtype):
             array = np.array(value, dtype)
             return self.runtime.create_scalar(
@@ -1372,6 +2547,36 @@ class DeferredArray(NumPyThunk):
 
         task.execute()
 
+    # Lay out the sources one after another along the axis. Each source is
+    # copied straight into its slice of the result by a copy aligned with
+    # the source, which involves no temporaries and no tasks.
+    @profile
+    def concatenate(self, sources, axis, stacklevel=0, callsite=None):
+        sources = [
+            self.runtime.to_deferred_array(src, stacklevel=stacklevel + 1)
+            for src in sources
+        ]
+        lhs = self.base
+        offset = 0
+        for src in sources:
+            extent = src.shape[axis]
+            if extent == 0 or src.size == 0:
+                offset += extent
+                continue
+            dst = lhs.slice(axis, slice(offset, offset + extent))
+            offset += extent
+            # Values held in futures are not in any region to copy from
+            if src.scalar:
+                view = DeferredArray(self.runtime, base=dst, dtype=self.dtype)
+                view.copy(src, stacklevel=stacklevel + 1)
+                continue
+
+            copy = self.context.create_copy()
+            copy.add_input(src.base)
+            copy.add_output(dst)
+            copy.add_alignment(src.base, dst)
+            copy.execute()
+
     # Tile the src array onto the destination array
     @profile
     @auto_convert([1])
@@ -1382,8 +2587,25 @@ class DeferredArray(NumPyThunk):
         assert src_array.ndim <= dst_array.ndim
         assert src_array.dtype == dst_array.dtype
         if src_array.scalar:
-            self._fill(
-                src_array.base, stacklevel=stacklevel + 1, callsite=callsite
+            self._fill_from(
+                src_array, stacklevel=stacklevel + 1, callsite=callsite
+            )
+            return
+
+        # When all the repeated dimensions have a single element, the result
+        # is a broadcast of the source, which the copy reads through a
+        # promoted view aligned with the result instead of replicating the
+        # source to every processor
+        offset = len(reps) - src_array.ndim
+        if all(
+            extent == 1 or reps[offset + dim] == 1
+            for (dim, extent) in enumerate(src_array.shape)
+        ):
+            self.copy(
+                src_array,
+                deep=True,
+                stacklevel=stacklevel + 1,
+                callsite=callsite,
             )
             return
 
@@ -1396,6 +2618,30 @@ class DeferredArray(NumPyThunk):
 
         task.execute()
 
+    # Kronecker product of rhs1 and rhs2, both with as many dimensions as
+    # the result. Every point of the result reads the element of rhs1 at its
+    # quotient by the shape of rhs2 and the element of rhs2 at the remainder,
+    # so neither operand is tiled out to the size of the result.
+    @profile
+    @auto_convert([1, 2])
+    @shadow_debug("kron", [1, 2])
+    def kron(self, rhs1, rhs2, stacklevel=0, callsite=None):
+        if self.size == 0:
+            return
+        assert rhs1.ndim == self.ndim and rhs2.ndim == self.ndim
+        assert rhs1.dtype == self.dtype and rhs2.dtype == self.dtype
+
+        task = self.context.create_task(CuNumericOpCode.KRON)
+
+        task.add_output(self.base)
+        task.add_input(rhs1.base)
+        task.add_input(rhs2.base)
+
+        task.add_broadcast(rhs1.base)
+        task.add_broadcast(rhs2.base)
+
+        task.execute()
+
     # Transpose the matrix dimensions
     @profile
     @auto_convert([1])
@@ -1407,6 +2653,9 @@ class DeferredArray(NumPyThunk):
         assert lhs_array.ndim == rhs_array.ndim
         assert lhs_array.ndim == len(axes)
         lhs_array.base = rhs_array.base.transpose(axes)
+        rhs_array._owns_store = False
+        if tuple(axes) == (1, 0):
+            lhs_array.transpose_source = rhs_array
 
     @profile
     @auto_convert([1])
@@ -1430,87 +2679,1044 @@ class DeferredArray(NumPyThunk):
     @auto_convert([1])
     @shadow_debug("flip", [1])
     def flip(self, rhs, axes, stacklevel=0, callsite=None):
+        if self.size == 0:
+            return
+        if self.ndim == 0:
+            self.copy(rhs, deep=True, stacklevel=stacklevel + 1)
+            return
+
         input = rhs.base
         output = self.base
 
         if axes is None:
-            axes = list(range(self.ndim))
+            axes = tuple(range(self.ndim))
         elif not isinstance(axes, tuple):
             axes = (axes,)
+        axes = tuple(axis % self.ndim for axis in axes)
+
+        # The output is split into blocks along its widest axis and every
+        # block is written by its own task from the mirrored slice of the
+        # input, so no task needs more than the input it reads. Both slices
+        # start at zero, where the task flips them in place.
+        split = max(range(self.ndim), key=lambda dim: self.shape[dim])
+        extent = self.shape[split]
+        num_blocks = min(self.runtime.num_procs, extent)
+        block = (extent + num_blocks - 1) // num_blocks
+
+        for lo in range(0, extent, block):
+            hi = min(lo + block, extent)
+            if split in axes:
+                in_lo, in_hi = extent - hi, extent - lo
+            else:
+                in_lo, in_hi = lo, hi
 
-        task = self.context.create_task(CuNumericOpCode.FLIP)
-        task.add_output(output)
-        task.add_input(input)
-        task.add_scalar_arg(axes, (ty.int32,))
+            task = self.context.create_task(
+                CuNumericOpCode.FLIP,
+                manual=True,
+                launch_domain=Rect(hi=(1,)),
+            )
+            task.add_output(output.slice(split, slice(lo, hi)))
+            task.add_input(input.slice(split, slice(in_lo, in_hi)))
+            task.add_scalar_arg(axes, (ty.int32,))
+            task.execute()
 
-        task.add_broadcast(input)
-        task.add_alignment(input, output)
+    @profile
+    @auto_convert([1])
+    @shadow_debug("repeat", [1])
+    def repeat(self, rhs, repeats, axis, stacklevel=0, callsite=None):
+        if self.size == 0:
+            return
+        if rhs.scalar:
+            self._fill_from(rhs, stacklevel=stacklevel + 1, callsite=callsite)
+            return
 
-        task.execute()
+        input = rhs.base
+        output = self.base
 
-    # Perform a bin count operation on the array
-    @profile
-    @auto_convert([1], ["weights"])
-    @shadow_debug("bincount", [1])
-    def bincount(self, rhs, stacklevel=0, weights=None, callsite=None):
-        weight_array = weights
-        src_array = rhs
-        dst_array = self
-        assert src_array.size > 1
-        assert dst_array.ndim == 1
-        if weight_array is not None:
-            assert src_array.shape == weight_array.shape or (
-                src_array.size == 1 and weight_array.size == 1
-            )
-        else:
-            weight_array = self.runtime.create_scalar(
-                np.array(1, dtype=np.int64),
-                np.dtype(np.int64),
-                shape=(),
-                wrap=True,
+        # Like flip, the output is split into blocks along the repeated axis
+        # and every block reads the input elements it expands. A block that
+        # starts in the middle of a run tells the task how far into the run
+        # it is.
+        extent = self.shape[axis]
+        num_blocks = min(self.runtime.num_procs, extent)
+        block = (extent + num_blocks - 1) // num_blocks
+
+        for lo in range(0, extent, block):
+            hi = min(lo + block, extent)
+            in_lo = lo // repeats
+            in_hi = (hi + repeats - 1) // repeats
+
+            task = self.context.create_task(
+                CuNumericOpCode.REPEAT,
+                manual=True,
+                launch_domain=Rect(hi=(1,)),
             )
+            task.add_output(output.slice(axis, slice(lo, hi)))
+            task.add_input(input.slice(axis, slice(in_lo, in_hi)))
+            task.add_scalar_arg(axis, ty.int32)
+            task.add_scalar_arg(repeats, ty.int64)
+            task.add_scalar_arg(lo % repeats, ty.int64)
+            task.execute()
 
-        dst_array.fill(
-            np.array(0, dst_array.dtype),
-            stacklevel=stacklevel + 1,
-            callsite=callsite,
-        )
+    @profile
+    @auto_convert([1])
+    @shadow_debug("pad", [1])
+    def pad(
+        self,
+        rhs,
+        pad_width,
+        mode,
+        constant_value,
+        stacklevel=0,
+        callsite=None,
+    ):
+        if self.size == 0:
+            return
+        if rhs.size == 0:
+            self.fill(constant_value, stacklevel=stacklevel + 1)
+            return
+        if rhs.scalar:
+            # The single element either goes everywhere or to the one point
+            # that the constant surrounds
+            if mode != PadMode.CONSTANT:
+                self._fill_from(
+                    rhs, stacklevel=stacklevel + 1, callsite=callsite
+                )
+                return
+            self.fill(constant_value, stacklevel=stacklevel + 1)
+            center = self.base
+            for dim, (before, _) in enumerate(pad_width):
+                center = center.slice(dim, slice(before, before + 1))
+            center = DeferredArray(self.runtime, center, self.dtype)
+            center.copy(rhs, deep=True, stacklevel=stacklevel + 1)
+            return
 
-        task = self.context.create_task(CuNumericOpCode.BINCOUNT)
-        task.add_reduction(dst_array.base, ReductionOp.ADD)
-        task.add_input(src_array.base)
-        task.add_input(weight_array.base)
+        value = self.runtime.create_scalar(constant_value.data, self.dtype)
+        value = self.context.create_store(
+            self.dtype, shape=(1,), storage=value, optimize_scalar=True
+        )
 
-        task.add_broadcast(dst_array.base)
-        if not weight_array.scalar:
-            task.add_alignment(src_array.base, weight_array.base)
+        # Each point of the output either falls inside the input or maps
+        # onto it through the padding mode, which for reflections and wraps
+        # can be anywhere along the axis, so every task sees the whole input
+        # the same way tile does
+        task = self.context.create_task(CuNumericOpCode.PAD)
 
-        task.execute()
+        task.add_output(self.base)
+        task.add_input(rhs.base)
+        task.add_input(value)
+        task.add_scalar_arg(
+            tuple(before for (before, _) in pad_width), (ty.int64,)
+        )
+        task.add_scalar_arg(mode, ty.int32)
+
+        task.add_broadcast(rhs.base)
+
+        task.execute()
+
+    # Evaluate the polynomial with the coefficients, highest power first, at
+    # every point of the source
+    @profile
+    @auto_convert([1])
+    @shadow_debug("polyval", [1])
+    def polyval(self, src, coefficients, stacklevel=0, callsite=None):
+        if self.size == 0:
+            return
+        task = self.context.create_task(CuNumericOpCode.POLYVAL)
+
+        task.add_input(src.base)
+        task.add_output(self.base)
+        task.add_scalar_arg(tuple(coefficients), (self.dtype,))
+        task.add_alignment(src.base, self.base)
+
+        task.execute()
+
+    # Reduce the window of the source that ends at every point along the
+    # axis, or the part of it that lies inside of the array
+    @profile
+    @auto_convert([1])
+    @shadow_debug("rolling", [1])
+    def rolling(self, src, op, axis, window, stacklevel=0, callsite=None):
+        if self.size == 0:
+            return
+
+        src = src._copy_if_overlapping(self, stacklevel=(stacklevel + 1))
+
+        task = self.context.create_task(CuNumericOpCode.ROLLING)
+
+        halo = tuple(
+            (window - 1 if dim == axis else 0, 0) for dim in range(self.ndim)
+        )
+        p_out = task.declare_partition(self.base)
+        task.add_output(self.base, partition=p_out)
+        p_src = add_halo_input(task, src.base, halo)
+        task.add_scalar_arg(op.value, ty.int32)
+        task.add_scalar_arg(axis, ty.int32)
+        task.add_scalar_arg(window, ty.int64)
+
+        task.add_constraint(p_out == p_src)
+
+        task.execute()
+
+    # Update the interior of the array with a weighted sum of shifted
+    # copies of the source and copy the rest of it
+    @profile
+    @auto_convert([1])
+    @shadow_debug("stencil", [1])
+    def stencil(self, src, offsets, coefficients, stacklevel=0, callsite=None):
+        if self.size == 0:
+            return
+
+        # Points of the output read their neighbors in the source, so the
+        # two can't share their storage
+        src = src._copy_if_overlapping(self, stacklevel=(stacklevel + 1))
+
+        task = self.context.create_task(CuNumericOpCode.STENCIL)
+
+        p_out = task.declare_partition(self.base)
+        task.add_output(self.base, partition=p_out)
+        p_src = add_halo_input(task, src.base, stencil_halo(offsets))
+        task.add_scalar_arg(self.shape, (ty.int64,))
+        task.add_scalar_arg(
+            tuple(shift for offset in offsets for shift in offset),
+            (ty.int64,),
+        )
+        task.add_scalar_arg(tuple(coefficients), (self.dtype,))
+
+        task.add_constraint(p_out == p_src)
+
+        task.execute()
+
+    # Perform a bin count operation on the array
+    @profile
+    @auto_convert([1], ["weights"])
+    @shadow_debug("bincount", [1])
+    def bincount(self, rhs, stacklevel=0, weights=None, callsite=None):
+        weight_array = weights
+        src_array = rhs
+        dst_array = self
+        assert src_array.size > 1
+        assert dst_array.ndim == 1
+        if weight_array is not None:
+            assert src_array.shape == weight_array.shape or (
+                src_array.size == 1 and weight_array.size == 1
+            )
+        else:
+            weight_array = self.runtime.create_scalar(
+                np.array(1, dtype=np.int64),
+                np.dtype(np.int64),
+                shape=(),
+                wrap=True,
+            )
+
+        dst_array.fill(
+            np.array(0, dst_array.dtype),
+            stacklevel=stacklevel + 1,
+            callsite=callsite,
+        )
+
+        if (
+            self.runtime.num_procs > 1
+            and src_array.ndim == 1
+            and dst_array.size > _BINCOUNT_MAX_BROADCAST_BINS
+        ):
+            self._partitioned_bincount(
+                src_array, weights, weight_array, stacklevel + 1
+            )
+            return
+
+        task = self.context.create_task(CuNumericOpCode.BINCOUNT)
+        task.add_reduction(dst_array.base, ReductionOp.ADD)
+        task.add_input(src_array.base)
+        task.add_input(weight_array.base)
+
+        task.add_broadcast(dst_array.base)
+        if not weight_array.scalar:
+            task.add_alignment(src_array.base, weight_array.base)
+
+        task.execute()
+
+    # Histogram of rhs over the num_bins + 1 sorted float64 edges, which are
+    # evenly spaced when uniform is set
+    @profile
+    @auto_convert([1, 2], ["weights"])
+    @shadow_debug("histogram", [1, 2], ["weights"])
+    def histogram(
+        self, rhs, edges, uniform, stacklevel=0, weights=None, callsite=None
+    ):
+        assert self.ndim == 1 and rhs.ndim <= 1
+        assert edges.shape == (self.shape[0] + 1,)
+        if weights is not None:
+            assert weights.shape == rhs.shape
+            weight_array = weights
+        else:
+            weight_array = self.runtime.create_scalar(
+                np.array(1, dtype=np.int64),
+                np.dtype(np.int64),
+                shape=(),
+                wrap=True,
+            )
+
+        self.fill(
+            np.array(0, self.dtype),
+            stacklevel=stacklevel + 1,
+            callsite=callsite,
+        )
+
+        task = self.context.create_task(CuNumericOpCode.HISTOGRAM)
+        task.add_reduction(self.base, ReductionOp.ADD)
+        task.add_input(rhs.base)
+        task.add_input(edges.base)
+        task.add_input(weight_array.base)
+        task.add_scalar_arg(uniform, bool)
+
+        task.add_broadcast(self.base)
+        task.add_broadcast(edges.base)
+        if not weight_array.scalar:
+            task.add_alignment(rhs.base, weight_array.base)
+
+        task.execute()
+
+    # Bincount into bins cut into one range per processor. A BUCKET task
+    # routes every value, with its weight if any, to the range of its bin,
+    # and a single task then counts the values of each range into it.
+    def _partitioned_bincount(self, rhs, weights, unit_weight, stacklevel):
+        num_bins = self.shape[0]
+        num_procs = self.runtime.num_procs
+        tile = (num_bins + num_procs - 1) // num_procs
+        num_ranges = (num_bins + tile - 1) // tile
+
+        # BUCKET carries the weights along as float64
+        if weights is not None and weights.dtype != np.float64:
+            converted = self.runtime.create_empty_thunk(
+                weights.shape, np.dtype(np.float64), inputs=[weights]
+            )
+            converted.convert(weights, stacklevel=stacklevel + 1, warn=False)
+            weights = converted
+
+        # The last bin of every range but the final one, clipped to the type
+        # of the values so that the splitters compare with them
+        ends = np.arange(1, num_ranges, dtype=np.int64) * tile - 1
+        ends = np.minimum(ends, np.iinfo(rhs.dtype).max).astype(rhs.dtype)
+        splitters = self.runtime.find_or_create_array_thunk(
+            ends, stacklevel=(stacklevel + 1), defer=True
+        )
+
+        values = [
+            self.runtime.create_unbound_thunk(rhs.dtype)
+            for _ in range(num_ranges)
+        ]
+        range_weights = [
+            self.runtime.create_unbound_thunk(np.dtype(np.float64))
+            for _ in range(num_ranges if weights is not None else 0)
+        ]
+
+        task = self.context.create_task(CuNumericOpCode.BUCKET)
+        task.add_input(rhs.base)
+        task.add_input(splitters.base)
+        if weights is not None:
+            task.add_input(weights.base)
+            task.add_alignment(rhs.base, weights.base)
+        for bucket in values + range_weights:
+            task.add_output(bucket.base)
+        task.add_broadcast(splitters.base)
+
+        task.execute()
+
+        for index in range(num_ranges):
+            if values[index].shape[0] == 0:
+                continue
+            lo = index * tile
+            hi = min(lo + tile, num_bins)
+            task = self.context.create_task(
+                CuNumericOpCode.BINCOUNT,
+                manual=True,
+                launch_domain=Rect(hi=(1,)),
+            )
+            task.add_reduction(
+                self.base.slice(0, slice(lo, hi)), ReductionOp.ADD
+            )
+            task.add_input(values[index].base)
+            if weights is not None:
+                task.add_input(range_weights[index].base)
+            else:
+                task.add_input(unit_weight.base)
+            task.add_scalar_arg(lo, ty.int64)
+            task.execute()
+
+    # Fold every row of values into the row of this array that its label
+    # picks, which is what np.add.at(self, labels, values) does for SUM, and
+    # count the rows of every label into counts if given. The labels must lie
+    # within the rows of this array. Every task gets whole rows of the values
+    # and folds them into a full copy of this array, unless that has too many
+    # elements, in which case the rows are routed to ranges of the labels.
+    @profile
+    @auto_convert([1, 2], ["counts"])
+    @shadow_debug("segment_reduce", [1, 2], ["counts"])
+    def segment_reduce(
+        self, labels, values, op, stacklevel=0, counts=None, callsite=None
+    ):
+        n = labels.shape[0]
+        assert labels.ndim == 1 and values.shape[0] == n
+        assert self.shape[1:] == values.shape[1:] and self.ndim <= 2
+        assert self.dtype == values.dtype
+        if values.size == 0:
+            return
+
+        if labels.dtype != np.int64:
+            converted = self.runtime.create_empty_thunk(
+                labels.shape, np.dtype(np.int64), inputs=[labels]
+            )
+            converted.convert(labels, stacklevel=stacklevel + 1, warn=False)
+            labels = converted
+
+        # The rows are always (n, d), with a single column for 1-D values
+        if self.ndim == 1:
+            lhs = self.base.promote(1, 1)
+            rows = values.base.promote(1, 1)
+        else:
+            lhs = self.base
+            rows = values.base
+
+        if (
+            self.runtime.num_procs > 1
+            and self.size > _BINCOUNT_MAX_BROADCAST_BINS
+            and self.dtype.kind == "f"
+        ):
+            self._partitioned_segment_reduce(
+                lhs, labels, values, rows, op, counts, stacklevel + 1
+            )
+            return
+
+        d = rows.shape[1]
+        tile = (n + self.runtime.num_procs - 1) // self.runtime.num_procs
+        num_tiles = (n + tile - 1) // tile
+
+        task = self.context.create_task(
+            CuNumericOpCode.SEGMENT_REDUCE,
+            manual=True,
+            launch_domain=Rect(hi=(num_tiles, 1)),
+        )
+        task.add_reduction(lhs, _UNARY_RED_TO_REDUCTION_OPS[op])
+        if counts is not None:
+            task.add_reduction(counts.base.promote(1, 1), ReductionOp.ADD)
+        segments = labels.base.promote(1, 1)
+        task.add_input(segments.partition_by_tiling((tile, 1)))
+        task.add_input(rows.partition_by_tiling((tile, d)))
+        task.add_scalar_arg(op.value, ty.int32)
+        task.add_scalar_arg(0, ty.int64)
+
+        task.execute()
+
+    # Segment reduce into rows cut into one range of labels per processor.
+    # BUCKET only carries float64 weights along with the labels, so every
+    # column of the values takes a BUCKET task of its own, which routes the
+    # column to the ranges of its labels. A single task then folds the
+    # column of each range into it.
+    def _partitioned_segment_reduce(
+        self, lhs, labels, values, rows, op, counts, stacklevel
+    ):
+        num_segments, d = lhs.shape
+        num_procs = self.runtime.num_procs
+        tile = (num_segments + num_procs - 1) // num_procs
+        num_ranges = (num_segments + tile - 1) // tile
+
+        if values.dtype != np.float64:
+            converted = self.runtime.create_empty_thunk(
+                values.shape, np.dtype(np.float64), inputs=[values]
+            )
+            converted.convert(values, stacklevel=stacklevel + 1, warn=False)
+            rows = (
+                converted.base.promote(1, 1)
+                if converted.ndim == 1
+                else converted.base
+            )
+
+        ends = np.arange(1, num_ranges, dtype=np.int64) * tile - 1
+        splitters = self.runtime.find_or_create_array_thunk(
+            ends, stacklevel=(stacklevel + 1), defer=True
+        )
+
+        for col in range(d):
+            column = rows.project(1, col)
+            range_labels = [
+                self.runtime.create_unbound_thunk(np.dtype(np.int64))
+                for _ in range(num_ranges)
+            ]
+            range_values = [
+                self.runtime.create_unbound_thunk(np.dtype(np.float64))
+                for _ in range(num_ranges)
+            ]
+
+            task = self.context.create_task(CuNumericOpCode.BUCKET)
+            task.add_input(labels.base)
+            task.add_input(splitters.base)
+            task.add_input(column)
+            task.add_alignment(labels.base, column)
+            for bucket in range_labels + range_values:
+                task.add_output(bucket.base)
+            task.add_broadcast(splitters.base)
+
+            task.execute()
+
+            for index in range(num_ranges):
+                if range_labels[index].shape[0] == 0:
+                    continue
+                lo = index * tile
+                hi = min(lo + tile, num_segments)
+                column_values = range_values[index]
+                # The values come back at the type of this array, which
+                # float64 holds exactly
+                if self.dtype != np.float64:
+                    converted = self.runtime.create_empty_thunk(
+                        column_values.shape, self.dtype, inputs=[column_values]
+                    )
+                    converted.convert(
+                        column_values, stacklevel=stacklevel + 1, warn=False
+                    )
+                    column_values = converted
+                task = self.context.create_task(
+                    CuNumericOpCode.SEGMENT_REDUCE,
+                    manual=True,
+                    launch_domain=Rect(hi=(1,)),
+                )
+                task.add_reduction(
+                    lhs.slice(0, slice(lo, hi)).slice(1, slice(col, col + 1)),
+                    _UNARY_RED_TO_REDUCTION_OPS[op],
+                )
+                if counts is not None and col == 0:
+                    task.add_reduction(
+                        counts.base.slice(0, slice(lo, hi)).promote(1, 1),
+                        ReductionOp.ADD,
+                    )
+                task.add_input(range_labels[index].base.promote(1, 1))
+                task.add_input(column_values.base.promote(1, 1))
+                task.add_scalar_arg(op.value, ty.int32)
+                task.add_scalar_arg(lo, ty.int64)
+                task.execute()
+
+    def nonzero(self, stacklevel=0, callsite=None):
+        results = tuple(
+            self.runtime.create_unbound_thunk(np.dtype(np.int64))
+            for _ in range(self.ndim)
+        )
+
+        task = self.context.create_task(CuNumericOpCode.NONZERO)
+
+        task.add_input(self.base)
+        for result in results:
+            task.add_output(result.base)
+        task.add_scalar_arg(False, bool)
+
+        task.execute()
+        return results
+
+    # The same compaction as nonzero, writing the coordinates of every
+    # nonzero next to each other, so that they come out as the rows of a
+    # single (N, ndim) array instead of ndim arrays that need stacking
+    def argwhere(self, stacklevel=0, callsite=None):
+        result = self.runtime.create_unbound_thunk(np.dtype(np.int64))
+
+        task = self.context.create_task(CuNumericOpCode.NONZERO)
+
+        task.add_input(self.base)
+        task.add_output(result.base)
+        task.add_scalar_arg(True, bool)
+
+        task.execute()
+
+        rows = result.base.shape[0] // self.ndim
+        return DeferredArray(
+            self.runtime,
+            base=result.base.delinearize(0, (rows, self.ndim)),
+            dtype=result.dtype,
+        )
+
+    # Return the distinct values and the number of times each of them
+    # occurs, in no particular order
+    @profile
+    def unique(self, stacklevel=0, callsite=None):
+        values, counts = self._aggregate_unique(self.base, None, manual=False)
+        # Every task aggregates its own tile, so a value can come out of
+        # several of them. The partial tables are no longer than the number
+        # of distinct values of each tile, so a single task merges them.
+        if self.runtime.num_procs > 1 and values.shape[0] > 1:
+            values, counts = self._aggregate_unique(
+                values.base, counts.base, manual=True
+            )
+        return values, counts
+
+    def _aggregate_unique(self, keys, counts, manual):
+        values = self.runtime.create_unbound_thunk(self.dtype)
+        value_counts = self.runtime.create_unbound_thunk(np.dtype(np.int64))
+
+        if manual:
+            task = self.context.create_task(
+                CuNumericOpCode.UNIQUE,
+                manual=True,
+                launch_domain=Rect(hi=(1,)),
+            )
+        else:
+            task = self.context.create_task(CuNumericOpCode.UNIQUE)
+        task.add_input(keys)
+        if counts is not None:
+            task.add_input(counts)
+            if not manual:
+                task.add_alignment(keys, counts)
+        task.add_output(values.base)
+        task.add_output(value_counts.base)
+        task.add_scalar_arg(counts is not None, bool)
+
+        task.execute()
+        return values, value_counts
+
+    # Label every row of points with its nearest row of centroids in a single
+    # pass, without the n x k matrix of distances. When sums is given, the
+    # same pass also sums up the points, their counts and their squared
+    # distances for every cluster. Every point task gets whole rows and all
+    # of the centroids.
+    @profile
+    @auto_convert([1, 2])
+    @shadow_debug("kmeans_assign", [1, 2], ["sums", "counts", "inertia"])
+    def kmeans_assign(
+        self,
+        points,
+        centroids,
+        stacklevel=0,
+        sums=None,
+        counts=None,
+        inertia=None,
+        callsite=None,
+    ):
+        n, d = points.shape
+        assert self.shape == (n,) and centroids.shape[1] == d
+        assert points.dtype == centroids.dtype
+
+        if sums is not None:
+            for partial in (sums, counts, inertia):
+                partial.fill(
+                    np.array(0, dtype=partial.dtype),
+                    stacklevel=stacklevel + 1,
+                    callsite=callsite,
+                )
+        if n == 0:
+            return
+
+        tile = (n + self.runtime.num_procs - 1) // self.runtime.num_procs
+        num_tiles = (n + tile - 1) // tile
+
+        task = self.context.create_task(
+            CuNumericOpCode.KMEANS_ASSIGN,
+            manual=True,
+            launch_domain=Rect(hi=(num_tiles, 1)),
+        )
+        labels = self.base.promote(1, 1)
+        task.add_output(labels.partition_by_tiling((tile, 1)))
+        task.add_input(points.base.partition_by_tiling((tile, d)))
+        task.add_input(centroids.base)
+        if sums is not None:
+            task.add_reduction(sums.base, ReductionOp.ADD)
+            task.add_reduction(counts.base, ReductionOp.ADD)
+            task.add_reduction(inertia.base, ReductionOp.ADD)
+
+        task.execute()
+
+    # Launch the gates of an LSTM step over the (b, d) cell state, where every
+    # task gets whole rows of all stores, as the gates of a column are found
+    # in the four column blocks of the (b, 4 * d) ones
+    def _issue_lstm_gates(
+        self, inputs, outputs, backward, has_prev, has_dc=False
+    ):
+        b = self.shape[0]
+        tile = (b + self.runtime.num_procs - 1) // self.runtime.num_procs
+        num_tiles = (b + tile - 1) // tile
+
+        task = self.context.create_task(
+            CuNumericOpCode.LSTM_GATES,
+            manual=True,
+            launch_domain=Rect(hi=(num_tiles, 1)),
+        )
+        for array in inputs:
+            task.add_input(
+                array.base.partition_by_tiling((tile, array.shape[1]))
+            )
+        for array in outputs:
+            task.add_output(
+                array.base.partition_by_tiling((tile, array.shape[1]))
+            )
+        task.add_scalar_arg(backward, bool)
+        task.add_scalar_arg(has_prev, bool)
+        task.add_scalar_arg(has_dc, bool)
+
+        task.execute()
+
+    # Compute the hidden state of an LSTM step into this array, along with
+    # its cell state, the tanh of that and the activated gates, from the
+    # pre-activations of the gates and the previous cell state in one pass
+    @profile
+    @auto_convert([4], ["c_prev"])
+    @shadow_debug("lstm_gates", [1, 2, 3, 4], ["c_prev"])
+    def lstm_gates(
+        self,
+        c,
+        tanh_c,
+        gates,
+        pre,
+        stacklevel=0,
+        c_prev=None,
+        callsite=None,
+    ):
+        b, d = self.shape
+        assert pre.shape == (b, 4 * d) and gates.shape == (b, 4 * d)
+        if self.size == 0:
+            return
+        inputs = [pre] if c_prev is None else [pre, c_prev]
+        self._issue_lstm_gates(
+            inputs, [self, c, tanh_c, gates], False, c_prev is not None
+        )
+
+    # Compute the gradient of the pre-activations of an LSTM step into this
+    # array, and that of the previous cell state into dc_prev unless there
+    # is none, from the saved gates and the gradients of the step's outputs
+    @profile
+    @auto_convert([1, 2, 3], ["dc", "c_prev"])
+    @shadow_debug(
+        "lstm_gates_backward", [1, 2, 3], ["dc", "c_prev", "dc_prev"]
+    )
+    def lstm_gates_backward(
+        self,
+        gates,
+        tanh_c,
+        dh,
+        stacklevel=0,
+        dc=None,
+        c_prev=None,
+        dc_prev=None,
+        callsite=None,
+    ):
+        b, d = dh.shape
+        assert self.shape == (b, 4 * d) and gates.shape == (b, 4 * d)
+        assert (dc_prev is None) == (c_prev is None)
+        if self.size == 0:
+            return
+        inputs = [gates, tanh_c, dh]
+        outputs = [self]
+        if dc is not None:
+            inputs.append(dc)
+        if c_prev is not None:
+            inputs.append(c_prev)
+            outputs.append(dc_prev)
+        self._issue_lstm_gates(
+            inputs, outputs, True, c_prev is not None, dc is not None
+        )
+
+    # Select the k best elements along an axis, or of the flattened array
+    # when the axis is None, returning thunks for their values and indices
+    # in best-first order
+    @profile
+    def topk(self, k, axis, largest, stacklevel=0, callsite=None):
+        if axis is None:
+            out_shape = (k,)
+        else:
+            out_shape = self.shape[:axis] + (k,) + self.shape[axis + 1 :]
+        values = self.runtime.create_empty_thunk(
+            out_shape, dtype=self.dtype, inputs=[self]
+        )
+        indices = self.runtime.create_empty_thunk(
+            out_shape, dtype=np.dtype(np.int64), inputs=[self]
+        )
+        candidates = self.runtime.create_unbound_thunk(
+            self.runtime.get_arg_dtype(self.dtype)
+        )
+        axis_arg = -1 if axis is None else axis
+
+        # Every piece first keeps its best k elements of each row, so that
+        # only those candidates need to be merged
+        task = self.context.create_task(CuNumericOpCode.TOPK)
+
+        task.add_input(self.base)
+        task.add_output(candidates.base)
+        task.add_scalar_arg(k, ty.int32)
+        task.add_scalar_arg(axis_arg, ty.int32)
+        task.add_scalar_arg(largest, bool)
+        task.add_scalar_arg(self.shape, (ty.int64,))
+
+        task.execute()
+
+        task = self.context.create_task(CuNumericOpCode.TOPK)
+
+        task.add_input(candidates.base)
+        task.add_output(values.base)
+        task.add_output(indices.base)
+        task.add_scalar_arg(k, ty.int32)
+        task.add_scalar_arg(axis_arg, ty.int32)
+        task.add_scalar_arg(largest, bool)
+        task.add_scalar_arg(self.shape, (ty.int64,))
+        task.add_broadcast(candidates.base)
+        task.add_broadcast(values.base)
+        task.add_broadcast(indices.base)
+
+        task.execute()
+        return values, indices
+
+    # Sort the array along its last dimension into either the sorted values
+    # or the int64 indices that sort them. Rows are sorted by the pieces that
+    # hold them, while a 1-D array that spans several processors goes
+    # through a sample sort.
+    @profile
+    @auto_convert([1])
+    @shadow_debug("sort", [1])
+    def sort(self, rhs, argsort=False, stacklevel=0, callsite=None):
+        if rhs.size == 0:
+            return
+        assert self.shape == rhs.shape
+        if (
+            rhs.ndim == 1
+            and self.runtime.num_procs > 1
+            and rhs.size >= self.runtime.num_procs * _SORT_SAMPLES_PER_BUCKET
+        ):
+            self._sample_sort(rhs, argsort, stacklevel=(stacklevel + 1))
+            return
+
+        if rhs.ndim == 1:
+            task = self.context.create_task(
+                CuNumericOpCode.SORT,
+                manual=True,
+                launch_domain=Rect(hi=(1,)),
+            )
+            task.add_input(rhs.base)
+            task.add_output(self.base)
+        else:
+            tile, num_tiles = rhs._mask_tiling()
+            tile_shape = (tile,) + rhs.shape[1:]
+            task = self.context.create_task(
+                CuNumericOpCode.SORT,
+                manual=True,
+                launch_domain=Rect(hi=(num_tiles,) + (1,) * (rhs.ndim - 1)),
+            )
+            task.add_input(rhs.base.partition_by_tiling(tile_shape))
+            task.add_output(self.base.partition_by_tiling(tile_shape))
+        task.add_scalar_arg(argsort, bool)
+
+        task.execute()
+
+    # The splitters come from a random sample of a few elements per bucket
+    # and delimit one bucket per processor. The BUCKET task exchanges the
+    # elements by returning every bucket in an unbound store, whose pieces
+    # are concatenated, and one task per bucket then sorts it into its
+    # slice of the output. The global indices travel with the elements for
+    # an argsort and break ties, so the result is that of a stable sort.
+    def _sample_sort(self, rhs, argsort, stacklevel):
+        extent = rhs.shape[0]
+        num_buckets = self.runtime.num_procs
+        num_samples = num_buckets * _SORT_SAMPLES_PER_BUCKET
+
+        positions = np.random.default_rng(extent).integers(
+            0, extent, size=num_samples, dtype=np.int64
+        )
+        positions = self.runtime.find_or_create_array_thunk(
+            positions, stacklevel=(stacklevel + 1), defer=True
+        )
+        samples = rhs._gather((positions,), stacklevel=(stacklevel + 1))
+        # NumPy also sorts NaNs after every other value
+        samples = np.sort(samples.__numpy_array__(stacklevel + 1))
+        picks = np.arange(1, num_buckets) * num_samples // num_buckets
+        splitters = self.runtime.find_or_create_array_thunk(
+            np.ascontiguousarray(samples[picks]),
+            stacklevel=(stacklevel + 1),
+            defer=True,
+        )
+
+        values = [
+            self.runtime.create_unbound_thunk(rhs.dtype)
+            for _ in range(num_buckets)
+        ]
+        indices = [
+            self.runtime.create_unbound_thunk(np.dtype(np.int64))
+            for _ in range(num_buckets if argsort else 0)
+        ]
+
+        task = self.context.create_task(CuNumericOpCode.BUCKET)
+        task.add_input(rhs.base)
+        task.add_input(splitters.base)
+        for bucket in values + indices:
+            task.add_output(bucket.base)
+        task.add_broadcast(splitters.base)
+
+        task.execute()
+
+        offset = 0
+        for bucket in range(num_buckets):
+            size = values[bucket].shape[0]
+            if size == 0:
+                continue
+            task = self.context.create_task(
+                CuNumericOpCode.SORT,
+                manual=True,
+                launch_domain=Rect(hi=(1,)),
+            )
+            task.add_input(values[bucket].base)
+            if argsort:
+                task.add_input(indices[bucket].base)
+            task.add_output(self.base.slice(0, slice(offset, offset + size)))
+            task.add_scalar_arg(argsort, bool)
+            task.execute()
+            offset += size
+        assert offset == extent
+
+    # Find the int64 positions at which the values would be inserted into
+    # the sorted 1-D array rhs to keep it sorted
+    @profile
+    @auto_convert([1, 2])
+    @shadow_debug("searchsorted", [1, 2])
+    def searchsorted(self, rhs, v, side, stacklevel=0, callsite=None):
+        if self.size == 0:
+            return
+        assert rhs.ndim == 1 and rhs.dtype == v.dtype
+        assert self.shape == v.shape
+
+        task = self.context.create_task(CuNumericOpCode.SEARCHSORTED)
+
+        task.add_input(rhs.base)
+        task.add_input(v.base)
+        task.add_output(self.base)
+        task.add_scalar_arg(side == "right", bool)
+        task.add_broadcast(rhs.base)
+        task.add_alignment(v.base, self.base)
+
+        task.execute()
+
+    # Interpolate the piecewise linear function with the values fp at the
+    # sorted 1-D breakpoints xp at the points of x, all of them doubles.
+    # Either bound left as None takes the value at the nearest breakpoint.
+    @profile
+    @auto_convert([1, 2, 3])
+    @shadow_debug("interp", [1, 2, 3])
+    def interp(self, x, xp, fp, left, right, stacklevel=0, callsite=None):
+        if self.size == 0:
+            return
+        assert xp.ndim == 1 and xp.shape == fp.shape
+        assert self.shape == x.shape
+
+        task = self.context.create_task(CuNumericOpCode.INTERP)
+
+        task.add_input(xp.base)
+        task.add_input(fp.base)
+        task.add_input(x.base)
+        task.add_output(self.base)
+        task.add_scalar_arg(left is not None, bool)
+        task.add_scalar_arg(0.0 if left is None else float(left), ty.float64)
+        task.add_scalar_arg(right is not None, bool)
+        task.add_scalar_arg(
+            0.0 if right is None else float(right), ty.float64
+        )
+        task.add_broadcast(xp.base)
+        task.add_broadcast(fp.base)
+        task.add_alignment(x.base, self.base)
+
+        task.execute()
+
+    # Inclusive scan of rhs along an axis with one of the SUM, PROD, MAX and
+    # MIN reductions. The axis is cut into one tile per processor: every
+    # tile is scanned locally and returns the totals of its rows, a single
+    # task scans the totals of the tiles, and every tile but the first then
+    # folds in the scanned total of the tiles before it.
+    @profile
+    @auto_convert([1])
+    @shadow_debug("scan", [1])
+    def scan(self, rhs, op, axis, stacklevel=0, callsite=None):
+        if self.size == 0:
+            return
+        assert self.shape == rhs.shape and self.dtype == rhs.dtype
+        extent = self.shape[axis]
+        num_tiles = max(1, min(self.runtime.num_procs, extent))
+        tile = (extent + num_tiles - 1) // num_tiles
+        num_tiles = (extent + tile - 1) // tile
+
+        def along_axis(value, default):
+            return tuple(
+                value if dim == axis else default[dim]
+                for dim in range(self.ndim)
+            )
 
-    def nonzero(self, stacklevel=0, callsite=None):
-        results = tuple(
-            self.runtime.create_unbound_thunk(np.dtype(np.int64))
-            for _ in range(self.ndim)
+        ones = (1,) * self.ndim
+        tile_shape = along_axis(tile, self.shape)
+        totals_shape = along_axis(num_tiles, self.shape)
+        totals_tile = along_axis(1, self.shape)
+
+        def add_scalars(task, fixup):
+            task.add_scalar_arg(op.value, ty.int32)
+            task.add_scalar_arg(axis, ty.int32)
+            task.add_scalar_arg(fixup, bool)
+
+        task = self.context.create_task(
+            CuNumericOpCode.SCAN,
+            manual=True,
+            launch_domain=Rect(hi=along_axis(num_tiles, ones)),
         )
+        task.add_input(rhs.base.partition_by_tiling(tile_shape))
+        task.add_output(self.base.partition_by_tiling(tile_shape))
+        if num_tiles > 1:
+            totals = self.runtime.create_empty_thunk(
+                totals_shape, self.dtype, inputs=[self]
+            )
+            task.add_output(totals.base.partition_by_tiling(totals_tile))
+        add_scalars(task, False)
+        task.execute()
 
-        task = self.context.create_task(CuNumericOpCode.NONZERO)
+        if num_tiles == 1:
+            return
 
-        task.add_input(self.base)
-        for result in results:
-            task.add_output(result.base)
+        prefixes = self.runtime.create_empty_thunk(
+            totals_shape, self.dtype, inputs=[self]
+        )
+        task = self.context.create_task(
+            CuNumericOpCode.SCAN,
+            manual=True,
+            launch_domain=Rect(hi=(1,)),
+        )
+        task.add_input(totals.base)
+        task.add_output(prefixes.base)
+        add_scalars(task, False)
+        task.execute()
 
+        rest = self.base.slice(axis, slice(tile, extent))
+        rest = rest.partition_by_tiling(tile_shape)
+        task = self.context.create_task(
+            CuNumericOpCode.SCAN,
+            manual=True,
+            launch_domain=Rect(hi=along_axis(num_tiles - 1, ones)),
+        )
+        prefix = prefixes.base.slice(axis, slice(0, num_tiles - 1))
+        task.add_input(prefix.partition_by_tiling(totals_tile))
+        task.add_output(rest)
+        task.add_input(rest)
+        add_scalars(task, True)
         task.execute()
-        return results
 
+    # Generators pass their own key and the first counter they have not drawn
+    # yet as the stream; the other draws take the global epoch
     @profile
-    def random(self, gen_code, args, stacklevel=0, callsite=None):
+    def random(
+        self, gen_code, args, stacklevel=0, callsite=None, stream=None
+    ):
         task = self.context.create_task(CuNumericOpCode.RAND)
 
+        if stream is None:
+            key, base = self.runtime.get_next_random_epoch(), 0
+        else:
+            key, base = stream
         task.add_output(self.base)
         task.add_scalar_arg(gen_code.value, ty.int32)
-        epoch = self.runtime.get_next_random_epoch()
-        task.add_scalar_arg(epoch, ty.uint32)
+        task.add_scalar_arg(key, ty.uint32)
         task.add_scalar_arg(self.compute_strides(self.shape), (ty.int64,))
+        backend = (
+            RandBackend.STREAM
+            if self.runtime.fast_random
+            else RandBackend.PHILOX
+        )
+        task.add_scalar_arg(backend.value, ty.int32)
+        task.add_scalar_arg(base, ty.uint64)
         self.add_arguments(task, args)
 
         task.execute()
@@ -1518,8 +3724,10 @@ class DeferredArray(NumPyThunk):
         if self.runtime.shadow_debug:
             self.shadow = self.runtime.to_eager_array(self, stacklevel + 1)
 
-    def random_uniform(self, stacklevel, low=0, high=1, callsite=None):
-        assert self.dtype == np.float64
+    def random_uniform(
+        self, stacklevel, low=0, high=1, callsite=None, stream=None
+    ):
+        assert self.dtype.kind == "f"
         low = np.array(low, self.dtype)
         high = np.array(high, self.dtype)
         self.random(
@@ -1527,19 +3735,23 @@ class DeferredArray(NumPyThunk):
             [low, high],
             stacklevel=stacklevel + 1,
             callsite=callsite,
+            stream=stream,
         )
 
-    def random_normal(self, stacklevel, callsite=None):
-        assert self.dtype == np.float64
+    def random_normal(self, stacklevel, callsite=None, stream=None):
+        assert self.dtype.kind == "f"
         self.random(
             RandGenCode.NORMAL,
             [],
             stacklevel=stacklevel + 1,
             callsite=callsite,
+            stream=stream,
         )
 
-    def random_integer(self, low, high, stacklevel, callsite=None):
-        assert self.dtype.kind == "i"
+    def random_integer(
+        self, low, high, stacklevel, callsite=None, stream=None
+    ):
+        assert self.dtype.kind in ("i", "u")
         low = np.array(low, self.dtype)
         high = np.array(high, self.dtype)
         self.random(
@@ -1547,6 +3759,43 @@ class DeferredArray(NumPyThunk):
             [low, high],
             stacklevel=stacklevel + 1,
             callsite=callsite,
+            stream=stream,
+        )
+
+    def random_permutation(self, stacklevel, callsite=None, stream=None):
+        assert self.ndim == 1 and self.dtype == np.int64
+        self.random(
+            RandGenCode.PERMUTATION,
+            [np.array(self.shape[0], self.dtype)],
+            stacklevel=stacklevel + 1,
+            callsite=callsite,
+            stream=stream,
+        )
+
+    def random_bernoulli(
+        self, p, on_value, off_value, stacklevel, callsite=None, stream=None
+    ):
+        self.random(
+            RandGenCode.BERNOULLI,
+            [
+                np.array(p, np.float64),
+                np.array(on_value, self.dtype),
+                np.array(off_value, self.dtype),
+            ],
+            stacklevel=stacklevel + 1,
+            callsite=callsite,
+            stream=stream,
+        )
+
+    def random_distribution(
+        self, gen_code, args, stacklevel, callsite=None, stream=None
+    ):
+        self.random(
+            gen_code,
+            args,
+            stacklevel=stacklevel + 1,
+            callsite=callsite,
+            stream=stream,
         )
 
     # Perform the unary operation and put the result in the array
@@ -1556,18 +3805,192 @@ class DeferredArray(NumPyThunk):
     def unary_op(
         self, op, op_dtype, src, where, args, stacklevel=0, callsite=None
     ):
+        if args is None and op in _FAST_MATH_UNARY_OPS:
+            args = self._fast_math_args(src.dtype)
+        masked = where is not True
+        if masked:
+            where = self.runtime.to_deferred_array(
+                where, stacklevel=(stacklevel + 1)
+            )
+        if self._stream_elementwise(
+            (src, where) if masked else (src,),
+            lambda lhs, srcs: lhs.unary_op(
+                op,
+                op_dtype,
+                srcs[0],
+                srcs[1] if masked else True,
+                args,
+                stacklevel + 1,
+            ),
+        ):
+            return
+        if not masked:
+            fusion = self.runtime.fusion
+            if fusion is not None and fusion.record_unary(
+                self, op, op_dtype, src, args
+            ):
+                return
+            if (
+                op != UnaryOpCode.CLIP
+                and op_dtype == self.dtype
+                and self._generated_op(FusedOpKind.UNARY, op, (src,), args)
+            ):
+                return
+
+        held = not masked and self._can_hold_launch((src,))
         lhs = self.base
-        rhs = src._broadcast(lhs.shape)
+        arrays = [src._broadcast(lhs.shape)]
+        # The mask is read after the operand, and so is the output when it
+        # is not updated in place already
+        inplace = masked and src is self
+        if masked:
+            arrays.append(where._broadcast(lhs.shape))
+            if not inplace:
+                arrays.append(lhs)
 
         task = self.context.create_task(CuNumericOpCode.UNARY_OP)
         task.add_output(lhs)
-        task.add_input(rhs)
+        for rhs in arrays:
+            task.add_input(rhs)
         task.add_scalar_arg(op.value, ty.int32)
+        task.add_scalar_arg(masked, bool)
+        task.add_scalar_arg(inplace, bool)
         self.add_arguments(task, args)
 
-        task.add_alignment(lhs, rhs)
+        for rhs in arrays:
+            task.add_alignment(lhs, rhs)
+
+        self._submit(task, (src,), held)
+
+    # Operations on arrays larger than the stream chunk size are issued one
+    # block of the outermost dimension at a time, so that only a block of
+    # each operand has to be in GPU memory at once. Legion brings the next
+    # block in while the tasks of the current one run.
+    def _stream_bounds(self, array):
+        chunk_size = self.runtime.stream_chunk_size
+        if chunk_size == 0 or self.runtime.shadow_debug:
+            return None
+        if array.ndim == 0 or array.size == 0:
+            return None
+        extent = array.shape[0]
+        row_size = array.size // extent * array.dtype.itemsize
+        rows = max(1, chunk_size // row_size)
+        if rows >= extent:
+            return None
+        return [(lo, min(lo + rows, extent)) for lo in range(0, extent, rows)]
+
+    def _stream_elementwise(self, srcs, launch):
+        bounds = self._stream_bounds(self)
+        if bounds is None:
+            return False
+        # Operands that hold a single value are passed whole to every block
+        stores = [
+            None if src.ndim == 0 else src._broadcast(self.shape)
+            for src in srcs
+        ]
+        for (lo, hi) in bounds:
+            lhs = DeferredArray(
+                self.runtime,
+                base=self.base.slice(0, slice(lo, hi)),
+                dtype=self.dtype,
+            )
+            views = tuple(
+                src
+                if store is None
+                else DeferredArray(
+                    self.runtime,
+                    base=store.slice(0, slice(lo, hi)),
+                    dtype=src.dtype,
+                )
+                for (src, store) in zip(srcs, stores)
+            )
+            launch(lhs, views)
+        return True
 
-        task.execute()
+    def _stream_reduction(
+        self, op, src, where, axes, keepdims, args, initial, stacklevel
+    ):
+        # Only reductions to a single value are streamed, by combining the
+        # results of the blocks
+        if self.size != 1 or op not in _UNARY_RED_COMBINE_OPS:
+            return False
+        if where is not True or initial is not None:
+            return False
+        bounds = self._stream_bounds(src)
+        if bounds is None:
+            return False
+        partials = []
+        for (lo, hi) in bounds:
+            view = DeferredArray(
+                self.runtime,
+                base=src.base.slice(0, slice(lo, hi)),
+                dtype=src.dtype,
+            )
+            partial = self.runtime.create_empty_thunk(
+                self.shape, self.dtype, inputs=[self]
+            )
+            partial.unary_reduction(
+                op,
+                view,
+                True,
+                axes,
+                keepdims,
+                args,
+                None,
+                stacklevel=stacklevel + 1,
+            )
+            partials.append(partial)
+        combine = _UNARY_RED_COMBINE_OPS[op]
+        self.binary_op(
+            combine, partials[0], partials[1], True, None, stacklevel + 1
+        )
+        for partial in partials[2:]:
+            self.binary_op(combine, self, partial, True, None, stacklevel + 1)
+        return True
+
+    # Some reductions of an array that holds a single value follow from the
+    # value alone, without reading the array
+    def _reduce_uniform(self, op, src, where, initial, stacklevel):
+        value = src._uniform_value
+        if value is None or where is not True or initial is not None:
+            return False
+        if src.size == 0 or self.size == 0:
+            return False
+        if op in (UnaryRedCode.MAX, UnaryRedCode.MIN):
+            if self.dtype != src.dtype:
+                return False
+            result = value
+        elif op in (UnaryRedCode.ALL, UnaryRedCode.ANY):
+            result = bool(value)
+        elif op == UnaryRedCode.COUNT_NONZERO:
+            result = src.size // self.size if value != 0 else 0
+        else:
+            return False
+        self.fill(
+            np.array(result, dtype=self.dtype), stacklevel=stacklevel + 1
+        )
+        return True
+
+    # The elements outside of the where mask of a reduction are replaced by
+    # the identity of the operator, passed to the WHERE task by value, so
+    # that the masked source is written in a single pass and the reduction
+    # tasks themselves never see the mask
+    def _mask_reduction_source(self, op, src, where):
+        if op not in _MASKABLE_UNARY_RED_OPS:
+            raise NotImplementedError(
+                "cuNumeric does not support a where mask for this reduction"
+            )
+        identity = self.runtime.create_scalar(
+            np.array(_UNARY_RED_IDENTITIES[op](src.dtype), src.dtype).data,
+            src.dtype,
+            shape=(),
+            wrap=True,
+        )
+        result = self.runtime.create_empty_thunk(
+            src.shape, dtype=src.dtype, inputs=[src, where]
+        )
+        result._where(where, src, identity)
+        return result
 
     # Perform a unary reduction operation from one set of dimensions down to
     # fewer
@@ -1590,6 +4013,172 @@ class DeferredArray(NumPyThunk):
         rhs_array = src
         assert lhs_array.ndim <= rhs_array.ndim
 
+        if where is not True:
+            where = self.runtime.to_deferred_array(
+                where, stacklevel=(stacklevel + 1)
+            )
+            src = self._mask_reduction_source(op, src, where)
+            rhs_array = src
+            where = True
+
+        if self._reduce_uniform(op, src, where, initial, stacklevel):
+            return
+
+        expression = self._pending_expression(op, src, args)
+        if expression is None:
+            if self._stream_reduction(
+                op, src, where, axes, keepdims, args, initial, stacklevel
+            ):
+                return
+            self._issue_unary_reduction(
+                op,
+                src,
+                axes,
+                keepdims,
+                args,
+                initial,
+                None,
+                stacklevel,
+                callsite,
+            )
+            return
+
+        # The reduction evaluates the expression that is still pending on
+        # the source as it reads the leaves, so the windows holding it must
+        # not write the source out in the meantime. The source stays
+        # pending for anyone who reads it later.
+        products = self.runtime.products
+        factors = products.factors_of(src)
+        if factors is not None:
+            products.take()
+        with hold_window(self.runtime):
+            self._issue_unary_reduction(
+                op,
+                src,
+                axes,
+                keepdims,
+                args,
+                initial,
+                expression,
+                stacklevel,
+                callsite,
+            )
+        if factors is not None:
+            products.record(src, *factors)
+
+    # The leaves, the code, the result registers and the constants of the
+    # FUSED_OP program that computes src, when the element-wise operation
+    # that writes it is still pending in a window, or None otherwise
+    def _pending_expression(self, op, src, args):
+        if op in _UNMAPPED_UNARY_RED_OPS or src.ndim == 0:
+            return None
+        # Arguments are passed to the tasks as extra inputs after the source,
+        # except for the ddof of variances, which only finalizes the result
+        if args and op != UnaryRedCode.VARIANCE:
+            return None
+        # Expressions are evaluated in the type of the output, so a sum or a
+        # product that widens a narrow source reads it directly
+        if src.dtype != self.dtype and op in (
+            UnaryRedCode.SUM,
+            UnaryRedCode.PROD,
+        ):
+            return None
+        expression = None
+        fusion = self.runtime.fusion
+        if fusion is not None:
+            expression = fusion.expression_of(src, self)
+        if expression is None:
+            factors = self.runtime.products.factors_of(src)
+            if factors is None:
+                return None
+            code = (int(FusedOpKind.BINARY), BinaryOpCode.MULTIPLY.value, 0, 1)
+            expression = (list(factors), code, (2,), ())
+        # The windows read the leaves again when they are flushed, so the
+        # reduction must not write any of them
+        if self._base.kind != Future:
+            for leaf in expression[0]:
+                if leaf._base.kind != Future and self._base.overlaps(
+                    leaf._base
+                ):
+                    return None
+        return expression
+
+    def _add_reduction_source(self, task, src, expression):
+        if expression is None:
+            task.add_input(src.base)
+            return [src.base]
+        leaves, _, _, _ = expression
+        stores = [leaf._broadcast(src.shape) for leaf in leaves]
+        for store in stores:
+            task.add_input(store)
+        return stores
+
+    def _add_expression_args(self, task, src, expression):
+        if expression is None:
+            return
+        _, code, results, constants = expression
+        task.add_scalar_arg(tuple(code), (ty.int32,))
+        task.add_scalar_arg(tuple(results), (ty.int32,))
+        task.add_scalar_arg(tuple(constants), (src.dtype,))
+
+    def _issue_unary_reduction(
+        self,
+        op,
+        src,
+        axes,
+        keepdims,
+        args,
+        initial,
+        expression,
+        stacklevel,
+        callsite,
+    ):
+        lhs_array = self
+        rhs_array = src
+
+        # In deterministic mode, floating point sums are reduced into binned
+        # accumulators, whose bits do not depend on the order of additions
+        if (
+            op == UnaryRedCode.SUM
+            and self.runtime.deterministic
+            and rhs_array.dtype == self.dtype
+            and rhs_array.dtype in (np.float32, np.float64)
+        ):
+            op = UnaryRedCode.BINNED_SUM
+            if initial is not None:
+                initial = get_binned_sum_state(
+                    np.array(initial, dtype=rhs_array.dtype)
+                )
+
+        # Variances are reduced into Welford accumulators, which are
+        # finalized with the ddof in args once the reduction is done, and
+        # binned sums, 2-norms and log-sum-exps are turned into the output
+        # type the same way
+        variance = op == UnaryRedCode.VARIANCE
+        binned_sum = op == UnaryRedCode.BINNED_SUM
+        norm = op == UnaryRedCode.NORM2
+        lse = op == UnaryRedCode.LOGSUMEXP
+        if variance or binned_sum or norm or lse:
+            if variance:
+                assert initial is None
+                acc_dtype = self.runtime.get_variance_dtype(rhs_array.dtype)
+            elif norm:
+                assert initial is None
+                acc_dtype = self.runtime.get_norm_dtype(rhs_array.dtype)
+            elif lse:
+                assert initial is None
+                acc_dtype = self.runtime.get_logsumexp_dtype(rhs_array.dtype)
+            else:
+                acc_dtype = self.runtime.get_binned_sum_dtype(rhs_array.dtype)
+            lhs_array = self.runtime.create_empty_thunk(
+                self.shape,
+                dtype=acc_dtype,
+                inputs=[self],
+            )
+            red_args = None
+        else:
+            red_args = args
+
         # See if we are doing reduction to a point or another region
         if lhs_array.size == 1:
             assert axes is None or len(axes) == (
@@ -1598,7 +4187,10 @@ class DeferredArray(NumPyThunk):
 
             task = self.context.create_task(CuNumericOpCode.SCALAR_UNARY_RED)
 
-            fill_value = _UNARY_RED_IDENTITIES[op](rhs_array.dtype)
+            if initial is not None:
+                fill_value = initial
+            else:
+                fill_value = _UNARY_RED_IDENTITIES[op](rhs_array.dtype)
 
             lhs_array.fill(
                 np.array(fill_value, dtype=lhs_array.dtype),
@@ -1606,16 +4198,30 @@ class DeferredArray(NumPyThunk):
                 callsite=callsite,
             )
 
+            # The partial results of the point tasks are folded by legate,
+            # which reduces the futures that they return. Folding them with
+            # an NCCL allreduce instead would need every point to run at the
+            # same time on a communicator of all the GPUs, and legate has no
+            # way yet of handing one to the tasks of a library
             task.add_reduction(lhs_array.base, _UNARY_RED_TO_REDUCTION_OPS[op])
-            task.add_input(rhs_array.base)
+            inputs = self._add_reduction_source(task, rhs_array, expression)
             task.add_scalar_arg(op, ty.int32)
 
-            self.add_arguments(task, args)
+            self.add_arguments(task, red_args)
+            self._add_expression_args(task, rhs_array, expression)
+
+            for store in inputs[1:]:
+                task.add_alignment(inputs[0], store)
 
             task.execute()
 
         else:
-            argred = op in (UnaryRedCode.ARGMAX, UnaryRedCode.ARGMIN)
+            argred = op in (
+                UnaryRedCode.ARGMAX,
+                UnaryRedCode.ARGMIN,
+                UnaryRedCode.NANARGMAX,
+                UnaryRedCode.NANARGMIN,
+            )
 
             if argred:
                 argred_dtype = self.runtime.get_arg_dtype(rhs_array.dtype)
@@ -1642,29 +4248,28 @@ class DeferredArray(NumPyThunk):
             # If output dims is not 0, then we must have axes
             assert axes is not None
             # Reduction to a smaller array
+            # All the dimensions being collapsed are reduced in one task,
+            # with the output broadcast along each of them
+            axes = tuple(sorted(axes))
             result = lhs_array.base
             if keepdims:
-                for axis in axes:
+                for axis in reversed(axes):
                     result = result.project(axis, 0)
             for axis in axes:
                 result = result.promote(axis, rhs_array.shape[axis])
-            # Iterate over all the dimension(s) being collapsed and build a
-            # temporary field that we will reduce down to the final value
-            if len(axes) > 1:
-                raise NotImplementedError(
-                    "Need support for reducing multiple dimensions"
-                )
 
             task = self.context.create_task(CuNumericOpCode.UNARY_RED)
 
-            task.add_input(rhs_array.base)
+            inputs = self._add_reduction_source(task, rhs_array, expression)
             task.add_reduction(result, _UNARY_RED_TO_REDUCTION_OPS[op])
-            task.add_scalar_arg(axis, ty.int32)
+            task.add_scalar_arg(axes, (ty.int32,))
             task.add_scalar_arg(op, ty.int32)
 
-            self.add_arguments(task, args)
+            self.add_arguments(task, red_args)
+            self._add_expression_args(task, rhs_array, expression)
 
-            task.add_alignment(result, rhs_array.base)
+            for store in inputs:
+                task.add_alignment(result, store)
 
             task.execute()
 
@@ -1679,6 +4284,179 @@ class DeferredArray(NumPyThunk):
                     callsite=callsite,
                 )
 
+        if variance:
+            self.unary_op(
+                UnaryOpCode.GETVAR,
+                self.dtype,
+                lhs_array,
+                True,
+                args,
+                stacklevel=stacklevel + 1,
+                callsite=callsite,
+            )
+        elif binned_sum:
+            self.unary_op(
+                UnaryOpCode.GETSUM,
+                self.dtype,
+                lhs_array,
+                True,
+                [],
+                stacklevel=stacklevel + 1,
+                callsite=callsite,
+            )
+        elif norm:
+            self.unary_op(
+                UnaryOpCode.GETNORM,
+                self.dtype,
+                lhs_array,
+                True,
+                [],
+                stacklevel=stacklevel + 1,
+                callsite=callsite,
+            )
+        elif lse:
+            self.unary_op(
+                UnaryOpCode.GETLSE,
+                self.dtype,
+                lhs_array,
+                True,
+                [],
+                stacklevel=stacklevel + 1,
+                callsite=callsite,
+            )
+
+    # Perform several reductions of this array in a single sweep over it,
+    # returning one thunk per reduction
+    @profile
+    def multi_reduction(
+        self, ops, out_shape, axes, keepdims, stacklevel=0, callsite=None
+    ):
+        results = tuple(
+            self.runtime.create_empty_thunk(
+                out_shape, dtype=self.dtype, inputs=[self]
+            )
+            for _ in ops
+        )
+        for (op, result) in zip(ops, results):
+            result.fill(
+                np.array(_UNARY_RED_IDENTITIES[op](self.dtype), self.dtype),
+                stacklevel=(stacklevel + 1),
+                callsite=callsite,
+            )
+
+        # See if we are doing reduction to a point or another region
+        if results[0].size == 1:
+            task = self.context.create_task(CuNumericOpCode.SCALAR_UNARY_RED)
+
+            for (op, result) in zip(ops, results):
+                task.add_reduction(
+                    result.base, _UNARY_RED_TO_REDUCTION_OPS[op]
+                )
+            task.add_input(self.base)
+            task.add_scalar_arg(tuple(op.value for op in ops), (ty.int32,))
+
+            task.execute()
+
+        else:
+            assert axes is not None
+            task = self.context.create_task(CuNumericOpCode.UNARY_RED)
+
+            task.add_input(self.base)
+            for (op, result) in zip(ops, results):
+                store = result.base
+                if keepdims:
+                    for axis in reversed(axes):
+                        store = store.project(axis, 0)
+                for axis in axes:
+                    store = store.promote(axis, self.shape[axis])
+                task.add_reduction(store, _UNARY_RED_TO_REDUCTION_OPS[op])
+                task.add_alignment(store, self.base)
+            task.add_scalar_arg(axes, (ty.int32,))
+            task.add_scalar_arg(tuple(op.value for op in ops), (ty.int32,))
+
+            task.execute()
+
+        return results
+
+    # Compute the inner products of several pairs of vectors in a single pass
+    # over them, returning one thunk per pair. The pairs name the vectors by
+    # their positions, so a vector shared by several pairs is read only once.
+    @profile
+    def multi_dot(self, vectors, pairs, stacklevel=0, callsite=None):
+        vectors = tuple(
+            self.runtime.to_deferred_array(vector, stacklevel=stacklevel + 1)
+            for vector in vectors
+        )
+        dtype = vectors[0].dtype
+        # 16-bit floats accumulate in 32-bit floats, as in dot
+        acc_dtype = np.dtype(np.float32) if dtype == np.float16 else dtype
+
+        results = []
+        for start in range(0, len(pairs), _MAX_MULTI_DOTS):
+            chunk = pairs[start : start + _MAX_MULTI_DOTS]
+            used = sorted(set(idx for pair in chunk for idx in pair))
+            operands = tuple(vectors[idx] for idx in used)
+
+            sums = tuple(
+                self.runtime.create_empty_thunk(
+                    (), acc_dtype, inputs=operands
+                )
+                for _ in chunk
+            )
+            for result in sums:
+                result.fill(
+                    np.array(0, dtype=acc_dtype),
+                    stacklevel=(stacklevel + 1),
+                    callsite=callsite,
+                )
+
+            task = self.context.create_task(CuNumericOpCode.MULTI_DOT)
+            for result in sums:
+                task.add_reduction(result.base, ty.ReductionOp.ADD)
+            for operand in operands:
+                task.add_input(operand.base)
+            for operand in operands[1:]:
+                task.add_alignment(operands[0].base, operand.base)
+            task.add_scalar_arg(
+                tuple(used.index(idx) for pair in chunk for idx in pair),
+                (ty.int32,),
+            )
+            task.execute()
+
+            results.extend(sums)
+
+        if acc_dtype != dtype:
+            converted = []
+            for result in results:
+                out = self.runtime.create_empty_thunk(
+                    (), dtype, inputs=[result]
+                )
+                out.convert(
+                    result,
+                    stacklevel=stacklevel + 1,
+                    warn=False,
+                    callsite=callsite,
+                )
+                converted.append(out)
+            results = converted
+
+        return tuple(results)
+
+    # Ranges that are not written out yet are computed from the coordinates
+    # of the elements of the operations that consume them
+    # The tasks take whether to use the fast-math variant of an op as an
+    # extra argument, which only float32 ones have and which defaults to
+    # what the runtime says
+    def _fast_math_args(self, dtype):
+        if not self.runtime.fast_math or dtype != np.float32:
+            return None
+        return (np.array(True),)
+
+    def _generated_op(self, kind, op_code, srcs, args):
+        if all(src._arange is None for src in srcs):
+            return False
+        return evaluate_generated(self.runtime, self, kind, op_code, srcs)
+
     # Perform the binary operation and put the result in the lhs array
     @profile
     @auto_convert([2, 3])
@@ -1686,23 +4464,186 @@ class DeferredArray(NumPyThunk):
     def binary_op(
         self, op_code, src1, src2, where, args, stacklevel=0, callsite=None
     ):
+        if args is None and op_code == BinaryOpCode.POWER:
+            args = self._fast_math_args(src1.dtype)
+        masked = where is not True
+        if masked:
+            where = self.runtime.to_deferred_array(
+                where, stacklevel=(stacklevel + 1)
+            )
+        if self._stream_elementwise(
+            (src1, src2, where) if masked else (src1, src2),
+            lambda lhs, srcs: lhs.binary_op(
+                op_code,
+                srcs[0],
+                srcs[1],
+                srcs[2] if masked else True,
+                args,
+                stacklevel + 1,
+            ),
+        ):
+            return
+        # The elements outside of a where mask keep their values, which only
+        # the BINARY_OP task itself knows how to do
+        if not masked and self._fast_binary_op(
+            op_code, src1, src2, args, stacklevel, callsite
+        ):
+            return
+
+        # Operands whose values are known here are passed by value so the
+        # task does not need to stream a broadcast store. An array updated
+        # in place needs its store anyway.
+        value1 = None if src1 is self else src1._uniform_value
+        value2 = None if src2 is self else src2._uniform_value
+        if src1.dtype != src2.dtype:
+            scalar_operand = 0
+        elif value2 is not None and value1 is None:
+            scalar_operand = 2
+        elif value1 is not None and value2 is None:
+            scalar_operand = 1
+        else:
+            scalar_operand = 0
+
+        held = not masked and self._can_hold_launch((src1, src2))
         lhs = self.base
-        rhs1 = src1._broadcast(lhs.shape)
-        rhs2 = src2._broadcast(lhs.shape)
+        if scalar_operand == 1:
+            arrays = [src2._broadcast(lhs.shape)]
+        elif scalar_operand == 2:
+            arrays = [src1._broadcast(lhs.shape)]
+        else:
+            arrays = [
+                src1._broadcast(lhs.shape),
+                src2._broadcast(lhs.shape),
+            ]
+        # Updates like a += b can write into the first input directly
+        inplace = (
+            src1 is self
+            and src1.dtype == self.dtype
+            and src2.dtype == src1.dtype
+        )
+
+        # The mask is read after the operands, and so is the output when it
+        # is not updated in place already
+        if masked:
+            arrays.append(where._broadcast(lhs.shape))
+            if not inplace:
+                arrays.append(lhs)
 
         # Populate the Legate launcher
         task = self.context.create_task(CuNumericOpCode.BINARY_OP)
         task.add_output(lhs)
-        task.add_input(rhs1)
-        task.add_input(rhs2)
+        for rhs in arrays:
+            task.add_input(rhs)
         task.add_scalar_arg(op_code.value, ty.int32)
+        task.add_scalar_arg(inplace, bool)
+        task.add_scalar_arg(scalar_operand, ty.int32)
+        task.add_scalar_arg(masked, bool)
+        if scalar_operand == 1:
+            task.add_scalar_arg(value1, src1.dtype)
+        elif scalar_operand == 2:
+            task.add_scalar_arg(value2, src2.dtype)
         self.add_arguments(task, args)
 
-        task.add_alignment(lhs, rhs1)
-        task.add_alignment(lhs, rhs2)
+        for rhs in arrays:
+            task.add_alignment(lhs, rhs)
+
+        self._submit(task, (src1, src2), held)
+
+    def _fast_binary_op(self, op_code, src1, src2, args, stacklevel, callsite):
+        if self._diagonal_binary_op(
+            op_code, src1, src2, args, stacklevel, callsite
+        ):
+            return True
+        fusion = self.runtime.fusion
+        if fusion is not None and fusion.record_binary(
+            self, op_code, src1, src2, args
+        ):
+            return True
+        if self._generated_op(FusedOpKind.BINARY, op_code, (src1, src2), args):
+            return True
+        if op_code == BinaryOpCode.MULTIPLY and self._defer_product(
+            src1, src2, args
+        ):
+            return True
+        if op_code == BinaryOpCode.ADD and self._fused_multiply_add(
+            src1, src2, args
+        ):
+            return True
+        return False
+
+    def _defer_product(self, src1, src2, args):
+        # Only products into temporaries can wait for a consuming addition
+        if (
+            not self._fresh
+            or self._base.ndim == 0
+            or args
+            or self.dtype not in _fma_dtypes
+            or src1.dtype != self.dtype
+            or src2.dtype != self.dtype
+        ):
+            return False
+        self.runtime.products.record(self, src1, src2)
+        return True
+
+    def _fused_multiply_add(self, src1, src2, args):
+        if (
+            self._base.ndim == 0
+            or args
+            or self.dtype not in _fma_dtypes
+            or src1.dtype != self.dtype
+            or src2.dtype != self.dtype
+            or src1 is src2
+        ):
+            return False
+
+        products = self.runtime.products
+        for product, addend in ((src1, src2), (src2, src1)):
+            factors = products.factors_of(product)
+            if factors is not None:
+                break
+        else:
+            return False
+        # Overwriting a factor would change the product if it is read later
+        for factor in factors:
+            if factor._base.kind != Future and self._base.overlaps(
+                factor._base
+            ):
+                return False
+
+        products.take()
+        a, x = factors
+        if a._scalar_value is None and x._scalar_value is not None:
+            a, x = x, a
+        coefficient = a._scalar_value
+
+        lhs = self.base
+        # The factors are broadcast to the shape of the product first
+        shape = tuple(product._base.shape)
+        arrays = [x] if coefficient is not None else [a, x]
+        stores = [
+            broadcast_store(array._broadcast(shape), lhs.shape)
+            for array in arrays
+        ]
+        stores.append(addend._broadcast(lhs.shape))
+
+        task = self.context.create_task(CuNumericOpCode.FMA)
+        task.add_output(lhs)
+        for store in stores:
+            task.add_input(store)
+        task.add_scalar_arg(coefficient is not None, bool)
+        if coefficient is not None:
+            task.add_scalar_arg(coefficient, self.dtype)
+
+        for store in stores:
+            task.add_alignment(lhs, store)
 
         task.execute()
 
+        # The product itself is still available to anyone who reads it
+        if product is not self:
+            products.record(product, *factors)
+        return True
+
     @profile
     @auto_convert([2, 3])
     @shadow_debug("binary_reduction", [2, 3])
@@ -1730,7 +4671,13 @@ class DeferredArray(NumPyThunk):
         task.add_input(rhs1)
         task.add_input(rhs2)
         task.add_scalar_arg(op.value, ty.int32)
-        self.add_arguments(task, args)
+        # The tolerances of allclose are passed by value
+        if op == BinaryOpCode.ALLCLOSE:
+            rtol, atol = args
+            task.add_scalar_arg(float(rtol), ty.float64)
+            task.add_scalar_arg(float(atol), ty.float64)
+        else:
+            self.add_arguments(task, args)
 
         task.add_alignment(rhs1, rhs2)
 
@@ -1740,21 +4687,49 @@ class DeferredArray(NumPyThunk):
     @auto_convert([1, 2, 3])
     @shadow_debug("where", [1, 2, 3])
     def where(self, src1, src2, src3, stacklevel=0, callsite=None):
+        self._where(src1, src2, src3)
+
+    @profile
+    @auto_convert([1, 2])
+    @shadow_debug("putmask", [1, 2])
+    def putmask(self, mask, values, stacklevel=0, callsite=None):
+        self._where(mask, values, None)
+
+    # Branches whose values are known here are passed by value instead of
+    # being streamed as broadcast stores. Without a second branch the array
+    # is updated in place and only the elements under the mask are written.
+    def _where(self, mask, src1, src2):
         lhs = self.base
-        rhs1 = src1._broadcast(lhs.shape)
-        rhs2 = src2._broadcast(lhs.shape)
-        rhs3 = src3._broadcast(lhs.shape)
+        inplace = src2 is None
+        branches = [src1] if inplace else [src1, src2]
+        by_value = [
+            src is not self
+            and src._uniform_value is not None
+            and src.dtype == self.dtype
+            for src in branches
+        ]
 
         # Populate the Legate launcher
         task = self.context.create_task(CuNumericOpCode.WHERE)
         task.add_output(lhs)
-        task.add_input(rhs1)
-        task.add_input(rhs2)
-        task.add_input(rhs3)
-
-        task.add_alignment(lhs, rhs1)
-        task.add_alignment(lhs, rhs2)
-        task.add_alignment(lhs, rhs3)
+        rhs = mask._broadcast(lhs.shape)
+        task.add_input(rhs)
+        task.add_alignment(lhs, rhs)
+        for src, scalar in zip(branches, by_value):
+            if scalar:
+                continue
+            rhs = src._broadcast(lhs.shape)
+            task.add_input(rhs)
+            task.add_alignment(lhs, rhs)
+        if inplace:
+            task.add_input(lhs)
+
+        task.add_scalar_arg(by_value[0], bool)
+        task.add_scalar_arg(not inplace and by_value[1], bool)
+        task.add_scalar_arg(inplace, bool)
+        for src, scalar in zip(branches, by_value):
+            if scalar:
+                task.add_scalar_arg(src._uniform_value, src.dtype)
 
         task.execute()
 
@@ -1764,13 +4739,7 @@ class DeferredArray(NumPyThunk):
             return
         for numpy_array in args:
             assert numpy_array.size == 1
-            scalar = self.runtime.create_scalar(
-                numpy_array.data,
-                numpy_array.dtype,
-                shape=(1,),
-                wrap=True,
-            )
-            task.add_input(scalar.base)
+            task.add_input(self.runtime.get_scalar_arg(numpy_array))
 
     @staticmethod
     def compute_strides(shape):
@@ -1782,11 +4751,87 @@ class DeferredArray(NumPyThunk):
         return result
 
     @profile
-    @auto_convert([1])
-    @shadow_debug("cholesky", [1])
-    def cholesky(self, src, no_tril=False, stacklevel=0, callsite=None):
-        cholesky(self, src, stacklevel=stacklevel + 1, callsite=callsite)
+    @auto_convert([1], ["info"])
+    @shadow_debug("cholesky", [1], ["info"])
+    def cholesky(
+        self, src, no_tril=False, info=None, stacklevel=0, callsite=None
+    ):
+        cholesky(
+            self, src, info=info, stacklevel=stacklevel + 1, callsite=callsite
+        )
+        # The upper triangle is cleared when someone actually reads it
         if not no_tril:
-            self.trilu(
-                self, 0, True, stacklevel=stacklevel + 1, callsite=callsite
+            self._stale_upper = True
+
+    @profile
+    @auto_convert([1, 2])
+    @shadow_debug("solve", [1, 2])
+    def solve(self, a, b, stacklevel=0, callsite=None):
+        # A Cholesky factor is known to be lower triangular, so a forward
+        # substitution solves the system without any factorization
+        if a._stale_upper:
+            triangular_solve(
+                self,
+                a,
+                b,
+                (False,),
+                stacklevel=stacklevel + 1,
+                callsite=callsite,
             )
+        else:
+            solve(self, a, b, stacklevel=stacklevel + 1, callsite=callsite)
+
+    @profile
+    @auto_convert([1, 2])
+    @shadow_debug("cholesky_solve", [1, 2])
+    def cholesky_solve(self, factor, b, stacklevel=0, callsite=None):
+        cholesky_solve(
+            self, factor, b, stacklevel=stacklevel + 1, callsite=callsite
+        )
+
+    # Solve the stack of small systems a[i] x[i] = b[i] into this array, or
+    # invert the matrices of a when b is None. The stores are tiled along
+    # the batch only, so that every task solves whole systems.
+    @profile
+    @auto_convert([1], ["b"])
+    @shadow_debug("batched_solve", [1], ["b"])
+    def batched_solve(
+        self, a, stacklevel=0, b=None, cholesky=False, callsite=None
+    ):
+        assert self.ndim == 3 and a.ndim == 3
+        if self.size == 0:
+            return
+        extent = self.shape[0]
+        num_tiles = max(1, min(self.runtime.num_procs, extent))
+        tile = (extent + num_tiles - 1) // num_tiles
+        num_tiles = (extent + tile - 1) // tile
+
+        def tiling(store):
+            tile_shape = (tile,) + tuple(store.shape)[1:]
+            return store.partition_by_tiling(tile_shape)
+
+        task = self.context.create_task(
+            CuNumericOpCode.BATCHED_SOLVE,
+            manual=True,
+            launch_domain=Rect(hi=(num_tiles, 1, 1)),
+        )
+        task.add_output(tiling(self.base))
+        task.add_input(tiling(a.base))
+        if b is not None:
+            task.add_input(tiling(b.base))
+        task.add_scalar_arg(cholesky, bool)
+
+        task.execute()
+
+    # The factors are only unique up to the signs of their columns, so the
+    # QR decomposition has no shadow check
+    @profile
+    @auto_convert([1], ["q"])
+    def qr(self, a, q=None, stacklevel=0, callsite=None):
+        qr(self, a, q=q, stacklevel=stacklevel + 1, callsite=callsite)
+
+    @profile
+    @auto_convert([1], ["u", "vh"])
+    @shadow_debug("svd", [1], ["u", "vh"])
+    def svd(self, a, u=None, vh=None, stacklevel=0, callsite=None):
+        svd(self, a, u=u, vh=vh, stacklevel=stacklevel + 1, callsite=callsite)
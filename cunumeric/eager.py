@@ -15,12 +15,54 @@
 
 from __future__ import absolute_import, division, print_function
 
+import math
+
 import numpy as np
 
-from .config import BinaryOpCode, UnaryOpCode, UnaryRedCode
+from .config import (
+    QUANT_BLOCK,
+    BinaryOpCode,
+    FFTType,
+    PadMode,
+    RollingOpCode,
+    UnaryOpCode,
+    UnaryRedCode,
+)
+from .halo import stencil_halo
 from .thunk import NumPyThunk
 
 
+def _sigmoid(x):
+    with np.errstate(over="ignore"):
+        return 1.0 / (1.0 + np.exp(-x))
+
+
+# The unary ops that NumPy has no ufuncs for, which are computed in double
+# precision and copied into the output
+_SPECIAL_UNARY_OPS = {
+    UnaryOpCode.ERF: np.vectorize(math.erf, otypes=[np.float64]),
+    UnaryOpCode.SIGMOID: _sigmoid,
+    UnaryOpCode.SOFTPLUS: lambda x: np.logaddexp(0.0, x),
+}
+
+
+
+# The rows of a block-quantized matrix as (rows, blocks, QUANT_BLOCK) codes,
+# with the 4-bit codes unpacked from their bytes
+def _quantized_codes(codes, bits):
+    if bits == 4:
+        low = np.left_shift(codes, 4).astype(np.int8) >> 4
+        high = codes >> 4
+        codes = np.stack((low, high), axis=-1).reshape(codes.shape[0], -1)
+    return codes.reshape(codes.shape[0], -1, QUANT_BLOCK)
+
+
+def _dequantize(codes, scales, bits, cols, dtype):
+    codes = _quantized_codes(codes, bits)
+    values = scales.astype(dtype)[..., np.newaxis] * codes.astype(dtype)
+    return values.reshape(codes.shape[0], -1)[:, :cols]
+
+
 class EagerArray(NumPyThunk):
     """This is an eager thunk for describing NumPy computations.
     It is backed by a standard NumPy array that stores the result
@@ -102,12 +144,17 @@ class EagerArray(NumPyThunk):
                         wrap=True,
                     )
                 else:
+                    # Nothing outside this tree has seen the array unless it
+                    # escaped, so Legion can take its buffer over as the
+                    # first instance of the store instead of a copy of it
                     self.deferred = self.runtime.find_or_create_array_thunk(
                         self.array,
                         stacklevel=(stacklevel + 1),
                         share=self.escaped,
                         defer=True,
                     )
+                    if not self.escaped:
+                        self.release_array()
             else:
                 # Traverse up the tree to make the deferred array
                 self.parent.to_deferred_array(stacklevel=(stacklevel + 1))
@@ -130,6 +177,19 @@ class EagerArray(NumPyThunk):
                 child.to_deferred_array(stacklevel=(stacklevel + 1))
         return self.deferred
 
+    def release_array(self):
+        """Drops the references of a tree that has migrated to its buffer,
+        whose lifetime then follows the attachment of the store. Only the
+        shapes are kept, as everything else goes to the deferred arrays.
+        :meta private:
+        """
+        self.array = np.broadcast_to(
+            np.empty((), dtype=self.array.dtype), self.array.shape
+        )
+        if self.children is not None:
+            for child in self.children:
+                child.release_array()
+
     def imag(self, stacklevel):
         if self.deferred is not None:
             return self.deferred.imag(stacklevel=(stacklevel + 1))
@@ -146,16 +206,60 @@ class EagerArray(NumPyThunk):
 
         return EagerArray(self.runtime, self.array.conj())
 
-    def convolve(self, v, out, mode, stacklevel):
+    def convolve(self, v, out, mode, stride, dilation, stacklevel):
         if self.deferred is not None:
-            self.deferred(v, out, mode, stacklevel=(stacklevel + 1))
+            self.deferred.convolve(
+                v, out, mode, stride, dilation, stacklevel=(stacklevel + 1)
+            )
         else:
+            filter = v.array
+            # A dilated filter is the filter with dilation - 1 zeros between
+            # its points, and a strided convolution keeps every stride-th
+            # point of the plain one
+            if any(step != 1 for step in dilation):
+                shape = tuple(
+                    (extent - 1) * step + 1
+                    for extent, step in zip(filter.shape, dilation)
+                )
+                filter = np.zeros(shape, dtype=v.array.dtype)
+                filter[tuple(slice(None, None, step) for step in dilation)] = (
+                    v.array
+                )
             if self.ndim == 1:
-                out.array = np.convolve(self.array, v.array, mode)
+                result = np.convolve(self.array, filter, mode)
             else:
                 from scipy.signal import convolve
 
-                out.array = convolve(self.array, v.array, mode)
+                result = convolve(self.array, filter, mode)
+            out.array[:] = result[
+                tuple(slice(None, None, step) for step in stride)
+            ]
+
+    def fft(self, rhs, axes, kind, inverse, scale, stacklevel):
+        if self.shadow:
+            rhs = self.runtime.to_eager_array(rhs, stacklevel=(stacklevel + 1))
+        elif self.deferred is None:
+            self.check_eager_args((stacklevel + 1), rhs)
+        if self.deferred is not None:
+            self.deferred.fft(
+                rhs, axes, kind, inverse, scale, stacklevel=(stacklevel + 1)
+            )
+        else:
+            # NumPy normalizes the inverse transforms, which the thunk leaves
+            # to the scale
+            axes = list(axes)
+            if kind == FFTType.R2C:
+                result = np.fft.rfftn(rhs.array, axes=axes)
+            elif kind == FFTType.C2R:
+                s = [self.shape[axis] for axis in axes]
+                result = np.fft.irfftn(rhs.array, s=s, axes=axes) * np.prod(s)
+            elif inverse:
+                s = [self.shape[axis] for axis in axes]
+                result = np.fft.ifftn(rhs.array, axes=axes) * np.prod(s)
+            else:
+                result = np.fft.fftn(rhs.array, axes=axes)
+            self.array[:] = result * scale
+            self.runtime.profile_callsite(stacklevel + 1, False)
 
     def copy(self, rhs, deep, stacklevel):
         if self.shadow:
@@ -179,6 +283,12 @@ class EagerArray(NumPyThunk):
             return self.deferred.scalar
         return self.array.size == 1
 
+    @property
+    def value_known(self):
+        if self.deferred is not None:
+            return self.deferred.value_known
+        return True
+
     def get_scalar_array(self, stacklevel):
         if self.deferred is not None:
             return self.deferred.get_scalar_array(stacklevel=(stacklevel + 1))
@@ -238,6 +348,21 @@ class EagerArray(NumPyThunk):
                 else:
                     self.array[key] = value
 
+    def scatter_reduce(self, key, value, op, stacklevel):
+        if self.shadow:
+            value = self.runtime.to_eager_array(
+                value, stacklevel=(stacklevel + 1)
+            )
+        elif self.deferred is None:
+            self.check_eager_args((stacklevel + 1), value)
+        if self.deferred is not None:
+            self.deferred.scatter_reduce(
+                key, value, op, stacklevel=(stacklevel + 1)
+            )
+        else:
+            index_key = self._create_indexing_key(key, stacklevel + 1)
+            getattr(np, op).at(self.array, index_key, value.array)
+
     def reshape(self, newshape, order, stacklevel):
         if self.deferred is not None:
             return self.deferred.reshape(
@@ -314,6 +439,24 @@ class EagerArray(NumPyThunk):
             self.array.fill(value)
             self.runtime.profile_callsite(stacklevel + 1, False)
 
+    def load_npy(self, path, offset, stacklevel):
+        if self.deferred is not None:
+            self.deferred.load_npy(path, offset, stacklevel=(stacklevel + 1))
+        else:
+            self.array[...] = np.fromfile(
+                path, dtype=self.dtype, count=self.array.size, offset=offset
+            ).reshape(self.shape)
+            self.runtime.profile_callsite(stacklevel + 1, False)
+
+    def save_npy(self, path, offset, stacklevel):
+        if self.deferred is not None:
+            self.deferred.save_npy(path, offset, stacklevel=(stacklevel + 1))
+        else:
+            with open(path, "r+b") as f:
+                f.seek(offset)
+                np.ascontiguousarray(self.array).tofile(f)
+            self.runtime.profile_callsite(stacklevel + 1, False)
+
     def dot(self, rhs1, rhs2, stacklevel):
         if self.shadow:
             rhs1 = self.runtime.to_eager_array(
@@ -327,7 +470,172 @@ class EagerArray(NumPyThunk):
         if self.deferred is not None:
             self.deferred.dot(rhs1, rhs2, stacklevel=(stacklevel + 1))
         else:
-            np.dot(rhs1.array, rhs2.array, out=self.array)
+            # NumPy only writes products into an output of their own type,
+            # so wider outputs, like int32 ones for int8 operands, take
+            # converted operands
+            dtype = self.array.dtype
+            np.dot(
+                rhs1.array.astype(dtype, copy=False),
+                rhs2.array.astype(dtype, copy=False),
+                out=self.array,
+            )
+            self.runtime.profile_callsite(stacklevel + 1, False)
+
+    def spmm(self, pos, crd, vals, rhs, indptr, stacklevel):
+        if self.shadow:
+            pos = self.runtime.to_eager_array(pos, stacklevel=(stacklevel + 1))
+            crd = self.runtime.to_eager_array(crd, stacklevel=(stacklevel + 1))
+            vals = self.runtime.to_eager_array(
+                vals, stacklevel=(stacklevel + 1)
+            )
+            rhs = self.runtime.to_eager_array(rhs, stacklevel=(stacklevel + 1))
+        elif self.deferred is None:
+            self.check_eager_args((stacklevel + 1), pos, crd, vals, rhs)
+        if self.deferred is not None:
+            self.deferred.spmm(
+                pos, crd, vals, rhs, indptr, stacklevel=(stacklevel + 1)
+            )
+        else:
+            counts = np.diff(pos.array)
+            rows = np.repeat(np.arange(counts.size), counts)
+            dense = rhs.array.reshape(rhs.array.shape[0], -1)
+            out = np.zeros((counts.size, dense.shape[1]), dtype=self.dtype)
+            np.add.at(out, rows, vals.array[:, np.newaxis] * dense[crd.array])
+            self.array[:] = out.reshape(self.array.shape)
+            self.runtime.profile_callsite(stacklevel + 1, False)
+
+    def quantize(self, scales, values, bits, stacklevel):
+        if self.shadow:
+            scales = self.runtime.to_eager_array(
+                scales, stacklevel=(stacklevel + 1)
+            )
+            values = self.runtime.to_eager_array(
+                values, stacklevel=(stacklevel + 1)
+            )
+        elif self.deferred is None:
+            self.check_eager_args((stacklevel + 1), scales, values)
+        if self.deferred is not None:
+            self.deferred.quantize(
+                scales, values, bits, stacklevel=(stacklevel + 1)
+            )
+        else:
+            rows, blocks = scales.array.shape
+            padded = np.zeros((rows, blocks * QUANT_BLOCK), values.array.dtype)
+            padded[:, : values.array.shape[1]] = values.array
+            padded = padded.reshape(rows, blocks, QUANT_BLOCK)
+            max_code = 127 if bits == 8 else 7
+            scale = (np.abs(padded).max(axis=2) / max_code).astype(np.float32)
+            with np.errstate(divide="ignore"):
+                inverse = np.where(scale > 0, np.float32(1) / scale, 0)
+            inverse = inverse[..., np.newaxis].astype(padded.dtype)
+            codes = np.rint(padded * inverse)
+            codes = np.clip(codes, -max_code, max_code).astype(np.int8)
+            codes = codes.reshape(rows, -1)
+            if bits == 4:
+                codes = (codes[:, 0::2] & 0xF) | (codes[:, 1::2] << 4)
+            scales.array[...] = scale
+            self.array[...] = codes
+            self.runtime.profile_callsite(stacklevel + 1, False)
+
+    def dequantize(self, codes, scales, bits, stacklevel):
+        if self.shadow:
+            codes = self.runtime.to_eager_array(
+                codes, stacklevel=(stacklevel + 1)
+            )
+            scales = self.runtime.to_eager_array(
+                scales, stacklevel=(stacklevel + 1)
+            )
+        elif self.deferred is None:
+            self.check_eager_args((stacklevel + 1), codes, scales)
+        if self.deferred is not None:
+            self.deferred.dequantize(
+                codes, scales, bits, stacklevel=(stacklevel + 1)
+            )
+        else:
+            self.array[...] = _dequantize(
+                codes.array,
+                scales.array,
+                bits,
+                self.array.shape[1],
+                self.array.dtype,
+            )
+            self.runtime.profile_callsite(stacklevel + 1, False)
+
+    def quantized_matvec(self, codes, scales, rhs, bits, stacklevel):
+        if self.shadow:
+            codes = self.runtime.to_eager_array(
+                codes, stacklevel=(stacklevel + 1)
+            )
+            scales = self.runtime.to_eager_array(
+                scales, stacklevel=(stacklevel + 1)
+            )
+            rhs = self.runtime.to_eager_array(rhs, stacklevel=(stacklevel + 1))
+        elif self.deferred is None:
+            self.check_eager_args((stacklevel + 1), codes, scales, rhs)
+        if self.deferred is not None:
+            self.deferred.quantized_matvec(
+                codes, scales, rhs, bits, stacklevel=(stacklevel + 1)
+            )
+        else:
+            matrix = _dequantize(
+                codes.array,
+                scales.array,
+                bits,
+                rhs.array.shape[0],
+                self.array.dtype,
+            )
+            self.array[...] = matrix.dot(rhs.array)
+            self.runtime.profile_callsite(stacklevel + 1, False)
+
+    def batched_matmul(
+        self,
+        rhs1,
+        rhs2,
+        scale=1.0,
+        bias=None,
+        activation=UnaryOpCode.COPY,
+        stacklevel=0,
+    ):
+        if self.shadow:
+            rhs1 = self.runtime.to_eager_array(
+                rhs1, stacklevel=(stacklevel + 1)
+            )
+            rhs2 = self.runtime.to_eager_array(
+                rhs2, stacklevel=(stacklevel + 1)
+            )
+            if bias is not None:
+                bias = self.runtime.to_eager_array(
+                    bias, stacklevel=(stacklevel + 1)
+                )
+        elif self.deferred is None:
+            if bias is not None:
+                self.check_eager_args((stacklevel + 1), rhs1, rhs2, bias)
+            else:
+                self.check_eager_args((stacklevel + 1), rhs1, rhs2)
+        if self.deferred is not None:
+            self.deferred.batched_matmul(
+                rhs1,
+                rhs2,
+                scale=scale,
+                bias=bias,
+                activation=activation,
+                stacklevel=(stacklevel + 1),
+            )
+        else:
+            np.matmul(rhs1.array, rhs2.array, out=self.array)
+            if scale != 1.0:
+                self.array *= scale
+            if bias is not None:
+                self.array += bias.array
+            if activation != UnaryOpCode.COPY:
+                self.unary_op(
+                    activation,
+                    self.dtype,
+                    self,
+                    True,
+                    [],
+                    stacklevel=(stacklevel + 1),
+                )
             self.runtime.profile_callsite(stacklevel + 1, False)
 
     def transpose(self, rhs, axes, stacklevel):
@@ -452,6 +760,24 @@ class EagerArray(NumPyThunk):
             self.array = np.arange(start, stop, step, self.dtype)
             self.runtime.profile_callsite(stacklevel + 1, False)
 
+    def concatenate(self, sources, axis, stacklevel):
+        if self.shadow:
+            sources = [
+                self.runtime.to_eager_array(src, stacklevel=(stacklevel + 1))
+                for src in sources
+            ]
+        elif self.deferred is None:
+            self.check_eager_args((stacklevel + 1), *sources)
+        if self.deferred is not None:
+            self.deferred.concatenate(
+                sources, axis, stacklevel=(stacklevel + 1)
+            )
+        else:
+            np.concatenate(
+                [src.array for src in sources], axis=axis, out=self.array
+            )
+            self.runtime.profile_callsite(stacklevel + 1, False)
+
     def tile(self, rhs, reps, stacklevel):
         if self.shadow:
             rhs = self.runtime.to_eager_array(rhs, stacklevel=(stacklevel + 1))
@@ -463,6 +789,155 @@ class EagerArray(NumPyThunk):
             self.array[:] = np.tile(rhs.array, reps)
             self.runtime.profile_callsite(stacklevel + 1, False)
 
+    def kron(self, rhs1, rhs2, stacklevel):
+        if self.shadow:
+            rhs1 = self.runtime.to_eager_array(
+                rhs1, stacklevel=(stacklevel + 1)
+            )
+            rhs2 = self.runtime.to_eager_array(
+                rhs2, stacklevel=(stacklevel + 1)
+            )
+        elif self.deferred is None:
+            self.check_eager_args((stacklevel + 1), rhs1, rhs2)
+        if self.deferred is not None:
+            self.deferred.kron(rhs1, rhs2, stacklevel=(stacklevel + 1))
+        else:
+            self.array[...] = np.kron(rhs1.array, rhs2.array)
+            self.runtime.profile_callsite(stacklevel + 1, False)
+
+    def repeat(self, rhs, repeats, axis, stacklevel):
+        if self.shadow:
+            rhs = self.runtime.to_eager_array(rhs, stacklevel=(stacklevel + 1))
+        elif self.deferred is None:
+            self.check_eager_args((stacklevel + 1), rhs)
+        if self.deferred is not None:
+            self.deferred.repeat(
+                rhs, repeats, axis, stacklevel=(stacklevel + 1)
+            )
+        else:
+            self.array[:] = np.repeat(rhs.array, repeats, axis=axis)
+            self.runtime.profile_callsite(stacklevel + 1, False)
+
+    def pad(self, rhs, pad_width, mode, constant_value, stacklevel):
+        if self.shadow:
+            rhs = self.runtime.to_eager_array(rhs, stacklevel=(stacklevel + 1))
+        elif self.deferred is None:
+            self.check_eager_args((stacklevel + 1), rhs)
+        if self.deferred is not None:
+            self.deferred.pad(
+                rhs,
+                pad_width,
+                mode,
+                constant_value,
+                stacklevel=(stacklevel + 1),
+            )
+        else:
+            kwargs = {}
+            if mode == PadMode.CONSTANT:
+                kwargs["constant_values"] = constant_value
+            self.array[:] = np.pad(
+                rhs.array, pad_width, mode=mode.name.lower(), **kwargs
+            )
+            self.runtime.profile_callsite(stacklevel + 1, False)
+
+    def stencil(self, rhs, offsets, coefficients, stacklevel):
+        if self.shadow:
+            rhs = self.runtime.to_eager_array(rhs, stacklevel=(stacklevel + 1))
+        elif self.deferred is None:
+            self.check_eager_args((stacklevel + 1), rhs)
+        if self.deferred is not None:
+            self.deferred.stencil(
+                rhs, offsets, coefficients, stacklevel=(stacklevel + 1)
+            )
+        else:
+            result = rhs.array.copy()
+            halo = stencil_halo(offsets)
+            interior = tuple(
+                slice(lo, extent - hi)
+                for (lo, hi), extent in zip(halo, result.shape)
+            )
+            if all(
+                extent > lo + hi
+                for (lo, hi), extent in zip(halo, result.shape)
+            ):
+                acc = np.zeros_like(result[interior])
+                for offset, coefficient in zip(offsets, coefficients):
+                    acc += coefficient * rhs.array[
+                        tuple(
+                            slice(lo + shift, extent - hi + shift)
+                            for (lo, hi), extent, shift in zip(
+                                halo, result.shape, offset
+                            )
+                        )
+                    ]
+                result[interior] = acc
+            self.array[...] = result
+            self.runtime.profile_callsite(stacklevel + 1, False)
+
+    def polyval(self, rhs, coefficients, stacklevel):
+        if self.shadow:
+            rhs = self.runtime.to_eager_array(rhs, stacklevel=(stacklevel + 1))
+        elif self.deferred is None:
+            self.check_eager_args((stacklevel + 1), rhs)
+        if self.deferred is not None:
+            self.deferred.polyval(
+                rhs, coefficients, stacklevel=(stacklevel + 1)
+            )
+        else:
+            self.array[...] = np.polyval(
+                np.array(coefficients, dtype=self.array.dtype), rhs.array
+            )
+            self.runtime.profile_callsite(stacklevel + 1, False)
+
+    def interp(self, x, xp, fp, left, right, stacklevel):
+        if self.shadow:
+            x = self.runtime.to_eager_array(x, stacklevel=(stacklevel + 1))
+            xp = self.runtime.to_eager_array(xp, stacklevel=(stacklevel + 1))
+            fp = self.runtime.to_eager_array(fp, stacklevel=(stacklevel + 1))
+        elif self.deferred is None:
+            self.check_eager_args((stacklevel + 1), x, xp, fp)
+        if self.deferred is not None:
+            self.deferred.interp(
+                x, xp, fp, left, right, stacklevel=(stacklevel + 1)
+            )
+        else:
+            self.array[...] = np.interp(
+                x.array, xp.array, fp.array, left=left, right=right
+            )
+            self.runtime.profile_callsite(stacklevel + 1, False)
+
+    def rolling(self, rhs, op, axis, window, stacklevel):
+        if self.shadow:
+            rhs = self.runtime.to_eager_array(rhs, stacklevel=(stacklevel + 1))
+        elif self.deferred is None:
+            self.check_eager_args((stacklevel + 1), rhs)
+        if self.deferred is not None:
+            self.deferred.rolling(
+                rhs, op, axis, window, stacklevel=(stacklevel + 1)
+            )
+        else:
+            # Eager arrays are small enough to fold in every shift of the
+            # window one after the other
+            src = np.moveaxis(rhs.array, axis, -1)
+            result = src.copy()
+            combine = {
+                RollingOpCode.SUM: np.add,
+                RollingOpCode.MEAN: np.add,
+                RollingOpCode.MIN: np.minimum,
+                RollingOpCode.MAX: np.maximum,
+            }[op]
+            extent = src.shape[-1]
+            for shift in range(1, min(window, extent)):
+                combine(
+                    result[..., shift:],
+                    src[..., : extent - shift],
+                    out=result[..., shift:],
+                )
+            if op == RollingOpCode.MEAN:
+                result /= np.minimum(np.arange(1, extent + 1), window)
+            self.array[...] = np.moveaxis(result, -1, axis)
+            self.runtime.profile_callsite(stacklevel + 1, False)
+
     def bincount(self, rhs, stacklevel, weights=None):
         if self.shadow:
             rhs = self.runtime.to_eager_array(rhs, stacklevel=(stacklevel + 1))
@@ -487,6 +962,71 @@ class EagerArray(NumPyThunk):
             )
             self.runtime.profile_callsite(stacklevel + 1, False)
 
+    def histogram(self, rhs, edges, uniform, stacklevel, weights=None):
+        if self.shadow:
+            rhs = self.runtime.to_eager_array(rhs, stacklevel=(stacklevel + 1))
+            edges = self.runtime.to_eager_array(
+                edges, stacklevel=(stacklevel + 1)
+            )
+            if weights is not None:
+                weights = self.runtime.to_eager_array(
+                    weights, stacklevel=(stacklevel + 1)
+                )
+        elif self.deferred is None:
+            if weights is not None:
+                self.check_eager_args((stacklevel + 1), rhs, edges, weights)
+            else:
+                self.check_eager_args((stacklevel + 1), rhs, edges)
+        if self.deferred is not None:
+            self.deferred.histogram(
+                rhs,
+                edges,
+                uniform,
+                stacklevel=(stacklevel + 1),
+                weights=weights,
+            )
+        else:
+            self.array[:] = np.histogram(
+                rhs.array,
+                bins=edges.array,
+                weights=weights.array if weights is not None else None,
+            )[0]
+            self.runtime.profile_callsite(stacklevel + 1, False)
+
+    def segment_reduce(self, labels, values, op, stacklevel, counts=None):
+        if self.shadow:
+            labels = self.runtime.to_eager_array(
+                labels, stacklevel=(stacklevel + 1)
+            )
+            values = self.runtime.to_eager_array(
+                values, stacklevel=(stacklevel + 1)
+            )
+        elif self.deferred is None:
+            self.check_eager_args((stacklevel + 1), labels, values)
+        if self.deferred is not None:
+            if counts is not None and self.runtime.is_eager_array(counts):
+                counts = counts.to_deferred_array(stacklevel=(stacklevel + 1))
+            self.deferred.segment_reduce(
+                labels,
+                values,
+                op,
+                stacklevel=(stacklevel + 1),
+                counts=counts,
+            )
+        else:
+            ufuncs = {
+                UnaryRedCode.SUM: np.add,
+                UnaryRedCode.PROD: np.multiply,
+                UnaryRedCode.MAX: np.maximum,
+                UnaryRedCode.MIN: np.minimum,
+            }
+            ufuncs[op].at(self.array, labels.array, values.array)
+            if counts is not None:
+                counts.array[:] += np.bincount(
+                    labels.array, minlength=self.shape[0]
+                )
+            self.runtime.profile_callsite(stacklevel + 1, False)
+
     def nonzero(self, stacklevel):
         if self.deferred is not None:
             return self.deferred.nonzero(stacklevel=(stacklevel + 1))
@@ -497,47 +1037,302 @@ class EagerArray(NumPyThunk):
                 result += (EagerArray(self.runtime, array),)
             return result
 
-    def sort(self, rhs, stacklevel):
+    def argwhere(self, stacklevel):
+        if self.deferred is not None:
+            return self.deferred.argwhere(stacklevel=(stacklevel + 1))
+        else:
+            return EagerArray(self.runtime, np.argwhere(self.array))
+
+    def unique(self, stacklevel):
+        if self.deferred is not None:
+            return self.deferred.unique(stacklevel=(stacklevel + 1))
+        else:
+            values, counts = np.unique(self.array, return_counts=True)
+            return (
+                EagerArray(self.runtime, values),
+                EagerArray(self.runtime, counts.astype(np.int64)),
+            )
+
+    def kmeans_assign(
+        self,
+        points,
+        centroids,
+        stacklevel,
+        sums=None,
+        counts=None,
+        inertia=None,
+    ):
+        if self.shadow:
+            points = self.runtime.to_eager_array(
+                points, stacklevel=(stacklevel + 1)
+            )
+            centroids = self.runtime.to_eager_array(
+                centroids, stacklevel=(stacklevel + 1)
+            )
+        elif self.deferred is None:
+            self.check_eager_args((stacklevel + 1), points, centroids)
+        if self.deferred is not None:
+            # The partial sums come out of the same task as the labels
+            if sums is not None:
+                sums, counts, inertia = (
+                    partial.to_deferred_array(stacklevel=(stacklevel + 1))
+                    if self.runtime.is_eager_array(partial)
+                    else partial
+                    for partial in (sums, counts, inertia)
+                )
+            self.deferred.kmeans_assign(
+                points,
+                centroids,
+                stacklevel=(stacklevel + 1),
+                sums=sums,
+                counts=counts,
+                inertia=inertia,
+            )
+        else:
+            diffs = points.array[:, np.newaxis, :] - centroids.array
+            distances = np.sum(diffs * diffs, axis=2)
+            labels = np.argmin(distances, axis=1)
+            self.array[:] = labels
+            if sums is not None:
+                nearest = distances[np.arange(labels.size), labels]
+                sums.array[:] = 0
+                np.add.at(sums.array, labels, points.array)
+                counts.array[:] = np.bincount(
+                    labels, minlength=centroids.shape[0]
+                )
+                inertia.array[...] = np.sum(nearest, dtype=np.float64)
+            self.runtime.profile_callsite(stacklevel + 1, False)
+
+    def _deferred_outputs(self, outputs, stacklevel):
+        return tuple(
+            None
+            if output is None
+            else output.to_deferred_array(stacklevel=(stacklevel + 1))
+            if self.runtime.is_eager_array(output)
+            else output
+            for output in outputs
+        )
+
+    def lstm_gates(self, c, tanh_c, gates, pre, stacklevel, c_prev=None):
+        if self.shadow:
+            pre = self.runtime.to_eager_array(pre, stacklevel=(stacklevel + 1))
+            if c_prev is not None:
+                c_prev = self.runtime.to_eager_array(
+                    c_prev, stacklevel=(stacklevel + 1)
+                )
+        elif self.deferred is None:
+            # The outputs are checked too, as they are written in place
+            arrays = [pre, c, tanh_c, gates]
+            if c_prev is not None:
+                arrays.append(c_prev)
+            self.check_eager_args((stacklevel + 1), *arrays)
+        if self.deferred is not None:
+            # The other outputs come out of the same task as the hidden state
+            c, tanh_c, gates = self._deferred_outputs(
+                (c, tanh_c, gates), stacklevel + 1
+            )
+            self.deferred.lstm_gates(
+                c,
+                tanh_c,
+                gates,
+                pre,
+                stacklevel=(stacklevel + 1),
+                c_prev=c_prev,
+            )
+        else:
+            d = self.shape[1]
+            activated = gates.array
+            activated[:, : 3 * d] = 1.0 / (
+                1.0 + np.exp(-pre.array[:, : 3 * d])
+            )
+            activated[:, 3 * d :] = np.tanh(pre.array[:, 3 * d :])
+            cell = activated[:, :d] * activated[:, 3 * d :]
+            if c_prev is not None:
+                cell += activated[:, d : 2 * d] * c_prev.array
+            c.array[:] = cell
+            tanh_c.array[:] = np.tanh(cell)
+            self.array[:] = activated[:, 2 * d : 3 * d] * tanh_c.array
+            self.runtime.profile_callsite(stacklevel + 1, False)
+
+    def lstm_gates_backward(
+        self, gates, tanh_c, dh, stacklevel, dc=None, c_prev=None, dc_prev=None
+    ):
+        if self.shadow:
+            gates, tanh_c, dh = (
+                self.runtime.to_eager_array(array, stacklevel=(stacklevel + 1))
+                for array in (gates, tanh_c, dh)
+            )
+            if dc is not None:
+                dc = self.runtime.to_eager_array(
+                    dc, stacklevel=(stacklevel + 1)
+                )
+            if c_prev is not None:
+                c_prev = self.runtime.to_eager_array(
+                    c_prev, stacklevel=(stacklevel + 1)
+                )
+        elif self.deferred is None:
+            arrays = [gates, tanh_c, dh, dc, c_prev, dc_prev]
+            self.check_eager_args(
+                (stacklevel + 1), *(a for a in arrays if a is not None)
+            )
+        if self.deferred is not None:
+            (dc_prev,) = self._deferred_outputs((dc_prev,), stacklevel + 1)
+            self.deferred.lstm_gates_backward(
+                gates,
+                tanh_c,
+                dh,
+                stacklevel=(stacklevel + 1),
+                dc=dc,
+                c_prev=c_prev,
+                dc_prev=dc_prev,
+            )
+        else:
+            d = dh.shape[1]
+            g = gates.array
+            i, f, o, a = (g[:, k * d : (k + 1) * d] for k in range(4))
+            t = tanh_c.array
+            cell = (1 - t * t) * o * dh.array
+            if dc is not None:
+                cell += dc.array
+            prev = 0 if c_prev is None else c_prev.array
+            self.array[:, :d] = a * cell * i * (1 - i)
+            self.array[:, d : 2 * d] = prev * cell * f * (1 - f)
+            self.array[:, 2 * d : 3 * d] = t * dh.array * o * (1 - o)
+            self.array[:, 3 * d :] = i * cell * (1 - a * a)
+            if c_prev is not None:
+                dc_prev.array[:] = f * cell
+            self.runtime.profile_callsite(stacklevel + 1, False)
+
+    def topk(self, k, axis, largest, stacklevel):
+        if self.deferred is not None:
+            return self.deferred.topk(
+                k, axis, largest, stacklevel=(stacklevel + 1)
+            )
+        array = self.array.ravel() if axis is None else self.array
+        axis = -1 if axis is None else axis
+        # Stable sorts keep ties in index order; negating floats keeps the
+        # NaNs last, while other types sort the flipped array instead
+        if not largest:
+            order = np.argsort(array, axis=axis, kind="stable")
+        elif array.dtype.kind == "f":
+            order = np.argsort(-array, axis=axis, kind="stable")
+        else:
+            flipped = np.argsort(
+                np.flip(array, axis), axis=axis, kind="stable"
+            )
+            order = array.shape[axis] - 1 - np.flip(flipped, axis)
+        indices = np.take(order, np.arange(k), axis=axis)
+        values = np.take_along_axis(array, indices, axis=axis)
+        self.runtime.profile_callsite(stacklevel + 1, False)
+        return (
+            EagerArray(self.runtime, values),
+            EagerArray(self.runtime, indices.astype(np.int64)),
+        )
+
+    def sort(self, rhs, argsort, stacklevel):
         if self.shadow:
             rhs = self.runtime.to_eager_array(rhs, stacklevel=(stacklevel + 1))
         elif self.deferred is None:
             self.check_eager_args((stacklevel + 1), rhs)
         if self.deferred is not None:
-            self.deferred.sort(rhs, stacklevel=(stacklevel + 1))
+            self.deferred.sort(rhs, argsort, stacklevel=(stacklevel + 1))
+        else:
+            if argsort:
+                self.array[...] = np.argsort(rhs.array, axis=-1, kind="stable")
+            else:
+                self.array[...] = np.sort(rhs.array, axis=-1)
+            self.runtime.profile_callsite(stacklevel + 1, False)
+
+    def searchsorted(self, rhs, v, side, stacklevel):
+        if self.shadow:
+            rhs = self.runtime.to_eager_array(rhs, stacklevel=(stacklevel + 1))
+            v = self.runtime.to_eager_array(v, stacklevel=(stacklevel + 1))
+        elif self.deferred is None:
+            self.check_eager_args((stacklevel + 1), rhs, v)
+        if self.deferred is not None:
+            self.deferred.searchsorted(
+                rhs, v, side, stacklevel=(stacklevel + 1)
+            )
         else:
-            self.array[:] = np.sort(rhs.array)
+            self.array[...] = np.searchsorted(rhs.array, v.array, side=side)
             self.runtime.profile_callsite(stacklevel + 1, False)
 
-    def random_uniform(self, low, high, stacklevel):
+    def scan(self, rhs, op, axis, stacklevel):
+        if self.shadow:
+            rhs = self.runtime.to_eager_array(rhs, stacklevel=(stacklevel + 1))
+        elif self.deferred is None:
+            self.check_eager_args((stacklevel + 1), rhs)
+        if self.deferred is not None:
+            self.deferred.scan(rhs, op, axis, stacklevel=(stacklevel + 1))
+        else:
+            funcs = {
+                UnaryRedCode.SUM: np.add,
+                UnaryRedCode.PROD: np.multiply,
+                UnaryRedCode.MAX: np.maximum,
+                UnaryRedCode.MIN: np.minimum,
+            }
+            funcs[op].accumulate(rhs.array, axis=axis, out=self.array)
+            self.runtime.profile_callsite(stacklevel + 1, False)
+
+    # Draws for a generator come from a NumPy Philox generator with the same
+    # key and counter, which makes them reproducible but not the same values
+    # as the RAND task makes
+    @staticmethod
+    def _random_source(stream):
+        if stream is None:
+            return None
+        key, base = stream
+        return np.random.Generator(np.random.Philox(key=key, counter=base))
+
+    def random_uniform(self, stacklevel, low=0, high=1, stream=None):
         assert not self.shadow
         if self.deferred is not None:
-            self.deferred.random_uniform(stacklevel=(stacklevel + 1))
+            self.deferred.random_uniform(
+                stacklevel=(stacklevel + 1), low=low, high=high, stream=stream
+            )
         else:
-            if self.array.size == 1:
+            source = self._random_source(stream)
+            if source is not None:
+                self.array[...] = source.uniform(
+                    low, high, size=self.array.shape
+                )
+            elif self.array.size == 1:
                 self.array.fill(np.random.uniform(low, high))
             else:
                 self.array[:] = np.random.uniform(
-                    low, high, size=self.array.shape, dtype=self.array.dtype
+                    low, high, size=self.array.shape
                 )
         self.runtime.profile_callsite(stacklevel + 1, False)
 
-    def random_normal(self, stacklevel):
+    def random_normal(self, stacklevel, stream=None):
         assert not self.shadow
         if self.deferred is not None:
-            self.deferred.random_normal(stacklevel=(stacklevel + 1))
+            self.deferred.random_normal(
+                stacklevel=(stacklevel + 1), stream=stream
+            )
         else:
-            if self.array.size == 1:
+            source = self._random_source(stream)
+            if source is not None:
+                self.array[...] = source.standard_normal(self.array.shape)
+            elif self.array.size == 1:
                 self.array.fill(np.random.randn())
             else:
                 self.array[:] = np.random.randn(*(self.array.shape))
             self.runtime.profile_callsite(stacklevel + 1, False)
 
-    def random_integer(self, low, high, stacklevel):
+    def random_integer(self, low, high, stacklevel, stream=None):
         assert not self.shadow
         if self.deferred is not None:
-            self.deferred.random_integer(stacklevel=(stacklevel + 1))
+            self.deferred.random_integer(
+                low, high, stacklevel=(stacklevel + 1), stream=stream
+            )
         else:
-            if self.array.size == 1:
+            source = self._random_source(stream)
+            if source is not None:
+                self.array[...] = source.integers(
+                    low, high, size=self.array.shape, dtype=self.array.dtype
+                )
+            elif self.array.size == 1:
                 self.array.fill(np.random.randint(low, high))
             else:
                 self.array[:] = np.random.randint(
@@ -545,6 +1340,56 @@ class EagerArray(NumPyThunk):
                 )
             self.runtime.profile_callsite(stacklevel + 1, False)
 
+    def random_permutation(self, stacklevel, stream=None):
+        assert not self.shadow
+        if self.deferred is not None:
+            self.deferred.random_permutation(
+                stacklevel=(stacklevel + 1), stream=stream
+            )
+        else:
+            source = self._random_source(stream)
+            if source is None:
+                source = np.random
+            self.array[:] = source.permutation(self.array.size)
+            self.runtime.profile_callsite(stacklevel + 1, False)
+
+    def random_bernoulli(
+        self, p, on_value, off_value, stacklevel, stream=None
+    ):
+        assert not self.shadow
+        if self.deferred is not None:
+            self.deferred.random_bernoulli(
+                p,
+                on_value,
+                off_value,
+                stacklevel=(stacklevel + 1),
+                stream=stream,
+            )
+        else:
+            source = self._random_source(stream)
+            if source is None:
+                source = np.random
+            self.array[...] = np.where(
+                source.random(self.array.shape) < p, on_value, off_value
+            )
+            self.runtime.profile_callsite(stacklevel + 1, False)
+
+    def random_distribution(self, gen_code, args, stacklevel, stream=None):
+        assert not self.shadow
+        if self.deferred is not None:
+            self.deferred.random_distribution(
+                gen_code, args, stacklevel=(stacklevel + 1), stream=stream
+            )
+        else:
+            source = self._random_source(stream)
+            if source is None:
+                source = np.random
+            sample = getattr(source, gen_code.name.lower())
+            self.array[...] = sample(
+                *(arg.item() for arg in args), size=self.array.shape
+            )
+            self.runtime.profile_callsite(stacklevel + 1, False)
+
     def unary_op(self, op, op_type, rhs, where, args, stacklevel):
         if self.shadow:
             rhs = self.runtime.to_eager_array(rhs, stacklevel=(stacklevel + 1))
@@ -570,6 +1415,19 @@ class EagerArray(NumPyThunk):
                 if not isinstance(where, EagerArray)
                 else where.array,
             )
+        elif op == UnaryOpCode.ABS2:
+            if rhs.array.dtype.kind == "c":
+                value = np.square(rhs.array.real) + np.square(rhs.array.imag)
+            else:
+                value = np.square(rhs.array)
+            np.copyto(
+                self.array,
+                value,
+                casting="unsafe",
+                where=where
+                if not isinstance(where, EagerArray)
+                else where.array,
+            )
         elif op == UnaryOpCode.ARCCOS:
             np.arccos(
                 rhs.array,
@@ -748,6 +1606,31 @@ class EagerArray(NumPyThunk):
                 if not isinstance(where, EagerArray)
                 else where.array,
             )
+        elif op == UnaryOpCode.EXPM1:
+            np.expm1(
+                rhs.array,
+                out=self.array,
+                where=where
+                if not isinstance(where, EagerArray)
+                else where.array,
+            )
+        elif op == UnaryOpCode.LOG1P:
+            np.log1p(
+                rhs.array,
+                out=self.array,
+                where=where
+                if not isinstance(where, EagerArray)
+                else where.array,
+            )
+        elif op in _SPECIAL_UNARY_OPS:
+            np.copyto(
+                self.array,
+                _SPECIAL_UNARY_OPS[op](rhs.array.astype(np.float64)),
+                casting="unsafe",
+                where=where
+                if not isinstance(where, EagerArray)
+                else where.array,
+            )
         else:
             raise RuntimeError("unsupported unary op " + str(op))
         self.runtime.profile_callsite(stacklevel + 1, False)
@@ -864,11 +1747,147 @@ class EagerArray(NumPyThunk):
             except Exception:
                 np.sum(rhs.array, out=self.array, axis=axes, keepdims=keepdims)
         elif op == UnaryRedCode.COUNT_NONZERO:
-            self.array[()] = np.count_nonzero(rhs.array, axis=axes)
+            self.array[()] = np.count_nonzero(
+                rhs.array, axis=axes, keepdims=keepdims
+            )
+        elif op == UnaryRedCode.VARIANCE:
+            np.var(
+                rhs.array,
+                out=self.array,
+                axis=axes,
+                ddof=int(args[0]),
+                keepdims=keepdims,
+            )
+        elif op == UnaryRedCode.SUM_SQUARES:
+            np.sum(
+                np.square(rhs.array),
+                out=self.array,
+                axis=axes,
+                keepdims=keepdims,
+            )
+        elif op == UnaryRedCode.NORM1:
+            np.sum(
+                np.abs(rhs.array), out=self.array, axis=axes, keepdims=keepdims
+            )
+        elif op == UnaryRedCode.NORM2:
+            # Scale the squares by the largest magnitude, like the tasks do,
+            # so that they cannot overflow
+            magnitudes = np.abs(rhs.array)
+            largest = np.amax(magnitudes, axis=axes, keepdims=True, initial=0)
+            # Zero, infinite and NaN norms are the largest magnitude itself
+            exact = np.isfinite(largest) & (largest != 0)
+            scale = np.where(exact, largest, 1)
+            ssq = np.sum(
+                np.square(magnitudes / scale), axis=axes, keepdims=True
+            )
+            result = np.where(exact, scale * np.sqrt(ssq), largest)
+            if not keepdims:
+                result = np.squeeze(result, axis=axes)
+            self.array[...] = result
+        elif op == UnaryRedCode.NORMINF:
+            np.amax(
+                np.abs(rhs.array),
+                out=self.array,
+                axis=axes,
+                keepdims=keepdims,
+                initial=0,
+            )
+        elif op == UnaryRedCode.NORMNEGINF:
+            np.amin(
+                np.abs(rhs.array), out=self.array, axis=axes, keepdims=keepdims
+            )
+        elif op == UnaryRedCode.LOGSUMEXP:
+            # Shift by the largest value, like the tasks do, so that the
+            # exponentials cannot overflow
+            largest = np.amax(
+                rhs.array, axis=axes, keepdims=True, initial=-np.inf
+            )
+            shift = np.where(np.isfinite(largest), largest, 0)
+            result = (
+                np.log(
+                    np.sum(np.exp(rhs.array - shift), axis=axes, keepdims=True)
+                )
+                + shift
+            )
+            if not keepdims:
+                result = np.squeeze(result, axis=axes)
+            self.array[...] = result
+        elif op == UnaryRedCode.NANARGMAX:
+            assert len(axes) == 1
+            self.array[...] = np.nanargmax(rhs.array, axis=axes[0])
+        elif op == UnaryRedCode.NANARGMIN:
+            assert len(axes) == 1
+            self.array[...] = np.nanargmin(rhs.array, axis=axes[0])
+        elif op == UnaryRedCode.NANMAX:
+            np.nanmax(rhs.array, out=self.array, axis=axes, keepdims=keepdims)
+        elif op == UnaryRedCode.NANMIN:
+            np.nanmin(rhs.array, out=self.array, axis=axes, keepdims=keepdims)
+        elif op == UnaryRedCode.NANPROD:
+            np.nanprod(
+                rhs.array, out=self.array, axis=axes, keepdims=keepdims
+            )
+        elif op == UnaryRedCode.NANSUM:
+            np.nansum(rhs.array, out=self.array, axis=axes, keepdims=keepdims)
         else:
             raise RuntimeError("unsupported unary reduction op " + str(op))
         self.runtime.profile_callsite(stacklevel + 1, False)
 
+    def multi_reduction(self, ops, out_shape, axes, keepdims, stacklevel):
+        if self.deferred is not None:
+            return self.deferred.multi_reduction(
+                ops, out_shape, axes, keepdims, stacklevel=(stacklevel + 1)
+            )
+        result = ()
+        for op in ops:
+            if op == UnaryRedCode.MIN:
+                array = self.array.min(axis=axes, keepdims=keepdims)
+            elif op == UnaryRedCode.MAX:
+                array = self.array.max(axis=axes, keepdims=keepdims)
+            elif op == UnaryRedCode.SUM:
+                array = self.array.sum(
+                    axis=axes, dtype=self.array.dtype, keepdims=keepdims
+                )
+            elif op == UnaryRedCode.SUM_SQUARES:
+                array = np.square(self.array).sum(
+                    axis=axes, dtype=self.array.dtype, keepdims=keepdims
+                )
+            elif op == UnaryRedCode.NANSUM:
+                array = np.nansum(
+                    self.array,
+                    axis=axes,
+                    dtype=self.array.dtype,
+                    keepdims=keepdims,
+                )
+            elif op == UnaryRedCode.NANCOUNT:
+                array = (~np.isnan(self.array)).sum(
+                    axis=axes, dtype=self.array.dtype, keepdims=keepdims
+                )
+            else:
+                raise RuntimeError(
+                    "unsupported multi-reduction op " + str(op)
+                )
+            array = np.asarray(array).reshape(out_shape)
+            result += (EagerArray(self.runtime, array),)
+        self.runtime.profile_callsite(stacklevel + 1, False)
+        return result
+
+    def multi_dot(self, vectors, pairs, stacklevel):
+        if self.deferred is None:
+            self.check_eager_args((stacklevel + 1), *vectors)
+        if self.deferred is not None:
+            return self.deferred.multi_dot(
+                vectors, pairs, stacklevel=(stacklevel + 1)
+            )
+        result = tuple(
+            EagerArray(
+                self.runtime,
+                np.asarray(np.dot(vectors[i].array, vectors[j].array)),
+            )
+            for (i, j) in pairs
+        )
+        self.runtime.profile_callsite(stacklevel + 1, False)
+        return result
+
     def binary_op(self, op, rhs1, rhs2, where, args, stacklevel):
         if self.shadow:
             rhs1 = self.runtime.to_eager_array(
@@ -1061,6 +2080,23 @@ class EagerArray(NumPyThunk):
                     if not isinstance(where, EagerArray)
                     else where.array,
                 )
+            elif op == BinaryOpCode.MUL_CONJ:
+                np.multiply(
+                    rhs1.array,
+                    np.conj(rhs2.array),
+                    out=self.array,
+                    where=where
+                    if not isinstance(where, EagerArray)
+                    else where.array,
+                )
+            elif op == BinaryOpCode.SOFTMAX:
+                np.exp(
+                    rhs1.array - rhs2.array,
+                    out=self.array,
+                    where=where
+                    if not isinstance(where, EagerArray)
+                    else where.array,
+                )
             else:
                 raise RuntimeError("unsupported binary op " + str(op))
             self.runtime.profile_callsite(stacklevel + 1, False)
@@ -1113,6 +2149,27 @@ class EagerArray(NumPyThunk):
             self.array[:] = np.where(rhs1.array, rhs2.array, rhs3.array)
             self.runtime.profile_callsite(stacklevel + 1, False)
 
+    def putmask(self, mask, values, stacklevel):
+        if self.shadow:
+            mask = self.runtime.to_eager_array(
+                mask, stacklevel=(stacklevel + 1)
+            )
+            values = self.runtime.to_eager_array(
+                values, stacklevel=(stacklevel + 1)
+            )
+        elif self.deferred is None:
+            self.check_eager_args((stacklevel + 1), mask, values)
+        if self.deferred is not None:
+            self.deferred.putmask(mask, values, stacklevel=(stacklevel + 1))
+        else:
+            # The mask broadcasts to the array like on the deferred path
+            np.putmask(
+                self.array,
+                np.broadcast_to(mask.array, self.array.shape),
+                values.array,
+            )
+            self.runtime.profile_callsite(stacklevel + 1, False)
+
     def trilu(self, rhs, k, lower, stacklevel):
         if self.shadow:
             rhs = self.runtime.to_eager_array(rhs, stacklevel=stacklevel + 1)
@@ -1127,13 +2184,134 @@ class EagerArray(NumPyThunk):
                 self.array[:] = np.triu(rhs.array, k)
             self.runtime.profile_callsite(stacklevel + 1, False)
 
-    def cholesky(self, src, no_tril, stacklevel):
+    def solve(self, a, b, stacklevel):
+        if self.shadow:
+            a = self.runtime.to_eager_array(a, stacklevel=(stacklevel + 1))
+            b = self.runtime.to_eager_array(b, stacklevel=(stacklevel + 1))
+        elif self.deferred is None:
+            self.check_eager_args((stacklevel + 1), a, b)
+        if self.deferred is not None:
+            self.deferred.solve(a, b, stacklevel=(stacklevel + 1))
+        else:
+            self.array[:] = np.linalg.solve(a.array, b.array)
+            self.runtime.profile_callsite(stacklevel + 1, False)
+
+    def cholesky_solve(self, factor, b, stacklevel):
+        if self.shadow:
+            factor = self.runtime.to_eager_array(
+                factor, stacklevel=(stacklevel + 1)
+            )
+            b = self.runtime.to_eager_array(b, stacklevel=(stacklevel + 1))
+        elif self.deferred is None:
+            self.check_eager_args((stacklevel + 1), factor, b)
+        if self.deferred is not None:
+            self.deferred.cholesky_solve(
+                factor, b, stacklevel=(stacklevel + 1)
+            )
+        else:
+            lower = np.tril(factor.array)
+            y = np.linalg.solve(lower, b.array)
+            self.array[:] = np.linalg.solve(lower.conj().T, y)
+            self.runtime.profile_callsite(stacklevel + 1, False)
+
+    def batched_solve(self, a, stacklevel, b=None, cholesky=False):
+        if self.shadow:
+            a = self.runtime.to_eager_array(a, stacklevel=(stacklevel + 1))
+            if b is not None:
+                b = self.runtime.to_eager_array(b, stacklevel=(stacklevel + 1))
+        elif self.deferred is None:
+            if b is None:
+                self.check_eager_args((stacklevel + 1), a)
+            else:
+                self.check_eager_args((stacklevel + 1), a, b)
+        if self.deferred is not None:
+            self.deferred.batched_solve(
+                a, stacklevel=(stacklevel + 1), b=b, cholesky=cholesky
+            )
+        else:
+            if b is None:
+                rhs = np.broadcast_to(np.eye(a.shape[-1]), a.shape)
+            else:
+                rhs = b.array
+            if cholesky:
+                # Only the lower triangle is read, like the tasks do
+                lower = np.linalg.cholesky(a.array)
+                y = np.linalg.solve(lower, rhs)
+                upper = np.swapaxes(lower, -1, -2)
+                self.array[:] = np.linalg.solve(upper, y)
+            else:
+                self.array[:] = np.linalg.solve(a.array, rhs)
+            self.runtime.profile_callsite(stacklevel + 1, False)
+
+    def qr(self, a, q=None, stacklevel=0):
+        if self.shadow:
+            a = self.runtime.to_eager_array(a, stacklevel=(stacklevel + 1))
+            if q is not None:
+                q = self.runtime.to_eager_array(q, stacklevel=(stacklevel + 1))
+        elif self.deferred is None:
+            if q is None:
+                self.check_eager_args((stacklevel + 1), a)
+            else:
+                self.check_eager_args((stacklevel + 1), a, q)
+        if self.deferred is not None:
+            self.deferred.qr(a, q=q, stacklevel=(stacklevel + 1))
+        else:
+            if q is None:
+                self.array[:] = np.linalg.qr(a.array, mode="r")
+            else:
+                q.array[:], self.array[:] = np.linalg.qr(a.array)
+            self.runtime.profile_callsite(stacklevel + 1, False)
+
+    def svd(self, a, u=None, vh=None, stacklevel=0):
+        if self.shadow:
+            a = self.runtime.to_eager_array(a, stacklevel=(stacklevel + 1))
+            if u is not None:
+                u = self.runtime.to_eager_array(u, stacklevel=(stacklevel + 1))
+            if vh is not None:
+                vh = self.runtime.to_eager_array(
+                    vh, stacklevel=(stacklevel + 1)
+                )
+        elif self.deferred is None:
+            args = tuple(arg for arg in (a, u, vh) if arg is not None)
+            self.check_eager_args((stacklevel + 1), *args)
+        if self.deferred is not None:
+            self.deferred.svd(a, u=u, vh=vh, stacklevel=(stacklevel + 1))
+        else:
+            if u is None and vh is None:
+                self.array[:] = np.linalg.svd(a.array, compute_uv=False)
+            else:
+                u_array, self.array[:], vh_array = np.linalg.svd(
+                    a.array, full_matrices=False
+                )
+                if u is not None:
+                    u.array[:] = u_array
+                if vh is not None:
+                    vh.array[:] = vh_array
+            self.runtime.profile_callsite(stacklevel + 1, False)
+
+    def cholesky(self, src, no_tril, info=None, stacklevel=0):
         if self.shadow:
             src = self.runtime.to_eager_array(src, stacklevel=(stacklevel + 1))
+            if info is not None:
+                info = self.runtime.to_eager_array(
+                    info, stacklevel=(stacklevel + 1)
+                )
         elif self.deferred is None:
-            self.check_eager_args((stacklevel + 1), src)
+            if info is None:
+                self.check_eager_args((stacklevel + 1), src)
+            else:
+                self.check_eager_args((stacklevel + 1), src, info)
         if self.deferred is not None:
-            self.deferred.cholesky(src, stacklevel=(stacklevel + 1))
+            self.deferred.cholesky(
+                src, no_tril=no_tril, info=info, stacklevel=(stacklevel + 1)
+            )
         else:
-            self.array[:] = np.linalg.cholesky(src.array)
+            try:
+                self.array[:] = np.linalg.cholesky(src.array)
+                if info is not None:
+                    info.array.fill(0)
+            except np.linalg.LinAlgError:
+                if info is None:
+                    raise
+                info.array.fill(1)
             self.runtime.profile_callsite(stacklevel + 1, False)
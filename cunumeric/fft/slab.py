@@ -0,0 +1,144 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+from cunumeric.config import CuNumericOpCode, FFTType
+
+from legate.core import Rect, types as ty
+
+
+def fft_task(
+    context, num_procs, output, input, axes, kind, inverse, scale, split
+):
+    """
+    Launch the FFT task on the stores. Every point transforms whole lines
+    along the axes, so the stores are only tiled along the ``split`` axis,
+    which must not be one of them, or not at all when it is ``None``.
+    """
+    ndim = output.ndim
+    out_tile = tuple(output.shape[dim] for dim in range(ndim))
+    in_tile = tuple(input.shape[dim] for dim in range(ndim))
+    color_shape = [1] * ndim
+    if split is not None:
+        extent = output.shape[split]
+        block = (extent + num_procs - 1) // num_procs
+        color_shape[split] = (extent + block - 1) // block
+        out_tile = out_tile[:split] + (block,) + out_tile[split + 1 :]
+        in_tile = in_tile[:split] + (block,) + in_tile[split + 1 :]
+
+    task = context.create_task(
+        CuNumericOpCode.FFT,
+        manual=True,
+        launch_domain=Rect(hi=tuple(color_shape)),
+    )
+    task.add_output(output.partition_by_tiling(out_tile))
+    task.add_input(input.partition_by_tiling(in_tile))
+    task.add_scalar_arg(kind, ty.int32)
+    task.add_scalar_arg(inverse, ty.bool_)
+    task.add_scalar_arg(axes, (ty.int32,))
+    task.add_scalar_arg(scale, ty.float64)
+    task.execute()
+
+
+def _widest(store, axes):
+    return max(axes, key=lambda dim: store.shape[dim])
+
+
+def fft(output, input, axes, kind, inverse, scale):
+    """
+    Compute the transform of ``input`` along ``axes`` into ``output``.
+    For a real transform, the last of the axes is the one that holds n
+    real values on one side and n / 2 + 1 complex coefficients on the
+    other.
+
+    When some axes of the array are not transformed, the lines along the
+    transformed ones are independent and the arrays are split into pencils
+    along the widest of the others. Transforms over all the axes of an
+    array take a slab decomposition instead: the first axis is transformed
+    separately from the rest, with the array split along it for the rest
+    and along another axis for it, so that the two steps are only coupled
+    by a global transpose that the runtime carries out between them.
+    """
+    if output.size == 0:
+        return
+    runtime = output.runtime
+    context = output.context
+    lhs = output.base
+    rhs = input.base
+
+    num_procs = runtime.num_procs
+    others = tuple(dim for dim in range(output.ndim) if dim not in axes)
+    if num_procs == 1 or (not others and len(axes) == 1):
+        split = None
+    elif others:
+        split = _widest(lhs, others)
+    else:
+        # The partial transform needs the precision of the complex side
+        first, rest = axes[0], axes[1:]
+        complex_side = input if kind == FFTType.C2R else output
+        temp = runtime.create_empty_thunk(
+            complex_side.shape, complex_side.dtype, inputs=[input]
+        )
+        across = _widest(
+            temp.base, tuple(dim for dim in range(output.ndim) if dim != first)
+        )
+        if kind == FFTType.C2R:
+            fft_task(
+                context,
+                num_procs,
+                temp.base,
+                rhs,
+                (first,),
+                FFTType.C2C,
+                inverse,
+                1.0,
+                across,
+            )
+            fft_task(
+                context,
+                num_procs,
+                lhs,
+                temp.base,
+                rest,
+                kind,
+                inverse,
+                scale,
+                first,
+            )
+        else:
+            fft_task(
+                context,
+                num_procs,
+                temp.base,
+                rhs,
+                rest,
+                kind,
+                inverse,
+                1.0,
+                first,
+            )
+            fft_task(
+                context,
+                num_procs,
+                lhs,
+                temp.base,
+                (first,),
+                FFTType.C2C,
+                inverse,
+                scale,
+                across,
+            )
+        return
+
+    fft_task(context, num_procs, lhs, rhs, axes, kind, inverse, scale, split)
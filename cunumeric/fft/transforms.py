@@ -0,0 +1,203 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+from cunumeric.array import ndarray
+from cunumeric.config import FFTType
+from cunumeric.doc_utils import copy_docstring
+from cunumeric.module import zeros as _zeros
+
+# Unlike NumPy, which always computes in double precision, single precision
+# inputs are transformed in single precision, as in scipy.fft
+
+
+def _complex_dtype(dtype):
+    if dtype in (np.float16, np.float32, np.complex64):
+        return np.dtype(np.complex64)
+    return np.dtype(np.complex128)
+
+
+def _real_dtype(dtype):
+    if dtype in (np.float16, np.float32, np.complex64):
+        return np.dtype(np.float32)
+    return np.dtype(np.float64)
+
+
+def _normalize_axes(a, s, axes):
+    if axes is None:
+        if s is None:
+            axes = range(a.ndim)
+        else:
+            axes = range(a.ndim - len(s), a.ndim)
+    result = []
+    for axis in axes:
+        if axis < -a.ndim or axis >= a.ndim:
+            raise ValueError(
+                f"axis {axis} is out of bounds for array of dimension "
+                f"{a.ndim}"
+            )
+        result.append(axis % a.ndim)
+    if len(set(result)) != len(result):
+        raise ValueError("repeated axis in FFT axes")
+    if s is not None and len(s) != len(result):
+        raise ValueError("Shape and axes have different lengths.")
+    return tuple(result)
+
+
+def _scale(norm, count, inverse):
+    if norm is None or norm == "backward":
+        return 1.0 / count if inverse else 1.0
+    if norm == "ortho":
+        return 1.0 / np.sqrt(count)
+    if norm == "forward":
+        return 1.0 if inverse else 1.0 / count
+    raise ValueError(
+        f'Invalid norm value {norm}; should be "backward", "ortho" or '
+        '"forward".'
+    )
+
+
+def _resize(a, sizes, axes):
+    # Crops or zero-pads the array along the axes to the sizes
+    shape = list(a.shape)
+    for axis, size in zip(axes, sizes):
+        shape[axis] = size
+    shape = tuple(shape)
+    if shape == a.shape:
+        return a
+    result = _zeros(shape, dtype=a.dtype, stacklevel=3)
+    common = tuple(slice(0, min(n, m)) for n, m in zip(shape, a.shape))
+    result[common] = a[common]
+    return result
+
+
+def _execute(a, s, axes, norm, kind, inverse):
+    a = ndarray.convert_to_cunumeric_ndarray(a, stacklevel=3)
+    axes = _normalize_axes(a, s, axes)
+    if s is None:
+        s = [a.shape[axis] for axis in axes]
+        if kind == FFTType.C2R:
+            s[-1] = 2 * (s[-1] - 1)
+    s = tuple(s)
+    for size in s:
+        if size < 1:
+            raise ValueError(
+                f"Invalid number of FFT data points ({size}) specified."
+            )
+
+    if kind == FFTType.R2C:
+        a = a.astype(_real_dtype(a.dtype))
+        dtype = _complex_dtype(a.dtype)
+    elif kind == FFTType.C2R:
+        a = a.astype(_complex_dtype(a.dtype))
+        dtype = _real_dtype(a.dtype)
+    else:
+        a = a.astype(_complex_dtype(a.dtype))
+        dtype = a.dtype
+
+    # The complex side of a real transform only holds the n / 2 + 1
+    # coefficients of the last axis that the Hermitian symmetry doesn't
+    # determine
+    in_sizes = s
+    out_shape = list(a.shape)
+    for axis, size in zip(axes, s):
+        out_shape[axis] = size
+    if kind == FFTType.R2C:
+        out_shape[axes[-1]] = s[-1] // 2 + 1
+    elif kind == FFTType.C2R:
+        in_sizes = s[:-1] + (s[-1] // 2 + 1,)
+    a = _resize(a, in_sizes, axes)
+
+    count = int(np.prod(s))
+    out = ndarray(
+        shape=tuple(out_shape), dtype=dtype, stacklevel=3, inputs=(a,)
+    )
+    out._thunk.fft(
+        a._thunk,
+        axes,
+        kind,
+        inverse,
+        _scale(norm, count, inverse),
+        stacklevel=3,
+    )
+    return out
+
+
+def _single(n, axis):
+    return (None if n is None else (n,)), (axis,)
+
+
+@copy_docstring(np.fft.fft)
+def fft(a, n=None, axis=-1, norm=None):
+    s, axes = _single(n, axis)
+    return _execute(a, s, axes, norm, FFTType.C2C, False)
+
+
+@copy_docstring(np.fft.ifft)
+def ifft(a, n=None, axis=-1, norm=None):
+    s, axes = _single(n, axis)
+    return _execute(a, s, axes, norm, FFTType.C2C, True)
+
+
+@copy_docstring(np.fft.rfft)
+def rfft(a, n=None, axis=-1, norm=None):
+    s, axes = _single(n, axis)
+    return _execute(a, s, axes, norm, FFTType.R2C, False)
+
+
+@copy_docstring(np.fft.irfft)
+def irfft(a, n=None, axis=-1, norm=None):
+    s, axes = _single(n, axis)
+    return _execute(a, s, axes, norm, FFTType.C2R, True)
+
+
+@copy_docstring(np.fft.fft2)
+def fft2(a, s=None, axes=(-2, -1), norm=None):
+    return _execute(a, s, axes, norm, FFTType.C2C, False)
+
+
+@copy_docstring(np.fft.ifft2)
+def ifft2(a, s=None, axes=(-2, -1), norm=None):
+    return _execute(a, s, axes, norm, FFTType.C2C, True)
+
+
+@copy_docstring(np.fft.rfft2)
+def rfft2(a, s=None, axes=(-2, -1), norm=None):
+    return _execute(a, s, axes, norm, FFTType.R2C, False)
+
+
+@copy_docstring(np.fft.irfft2)
+def irfft2(a, s=None, axes=(-2, -1), norm=None):
+    return _execute(a, s, axes, norm, FFTType.C2R, True)
+
+
+@copy_docstring(np.fft.fftn)
+def fftn(a, s=None, axes=None, norm=None):
+    return _execute(a, s, axes, norm, FFTType.C2C, False)
+
+
+@copy_docstring(np.fft.ifftn)
+def ifftn(a, s=None, axes=None, norm=None):
+    return _execute(a, s, axes, norm, FFTType.C2C, True)
+
+
+@copy_docstring(np.fft.rfftn)
+def rfftn(a, s=None, axes=None, norm=None):
+    return _execute(a, s, axes, norm, FFTType.R2C, False)
+
+
+@copy_docstring(np.fft.irfftn)
+def irfftn(a, s=None, axes=None, norm=None):
+    return _execute(a, s, axes, norm, FFTType.C2R, True)
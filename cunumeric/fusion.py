@@ -0,0 +1,568 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+from __future__ import absolute_import, division, print_function
+
+import weakref
+from contextlib import contextmanager
+
+import legate.core.types as ty
+
+from .config import BinaryOpCode, CuNumericOpCode, FusedOpKind, UnaryOpCode
+
+# Match these to the limits in fused_op_util.h
+MAX_INPUTS = 8
+MAX_OUTPUTS = 8
+MAX_INSTRUCTIONS = 16
+
+# Match this to MAX_BATCHED_ELEMENTS in item/item_util.h
+MAX_BATCHED_ELEMENTS = 64
+
+# The number of tasks that the launch window holds back at most
+MAX_HELD_LAUNCHES = 32
+
+# The number of dead stores of each shape and type kept for reuse
+MAX_RECYCLED_STORES = 4
+
+
+def broadcast_store(store, shape):
+    diff = len(shape) - store.ndim
+    for dim in range(diff):
+        store = store.promote(dim, shape[dim])
+
+    for dim in range(len(shape)):
+        if store.shape[dim] != shape[dim]:
+            assert store.shape[dim] == 1
+            store = store.project(dim, 0).promote(dim, shape[dim])
+
+    return store
+
+
+def _compile(instructions, generators, ndim, roots):
+    """Turns the instructions that the roots depend on into the code of a
+    FUSED_OP program. Returns the registers of the leaves and of the
+    instructions along with the code and the constants of the program.
+
+    :meta private:
+    """
+    live = [False] * len(instructions)
+    for idx in roots:
+        live[idx] = True
+    for idx in reversed(range(len(instructions))):
+        if not live[idx]:
+            continue
+        for (src_kind, src_idx) in instructions[idx].srcs:
+            if src_kind == "inst":
+                live[src_idx] = True
+
+    leaf_regs = dict()
+    for idx, inst in enumerate(instructions):
+        if not live[idx]:
+            continue
+        for (src_kind, src_idx) in inst.srcs:
+            if src_kind == "leaf" and src_idx not in leaf_regs:
+                leaf_regs[src_idx] = len(leaf_regs)
+
+    num_inputs = len(leaf_regs)
+    code = []
+    # The ranges come first and index the last dimension, along which
+    # a 1-D range is broadcast, with their start and step in constants
+    gen_regs = dict()
+    constants = []
+    for idx, inst in enumerate(instructions):
+        if not live[idx]:
+            continue
+        for (src_kind, src_idx) in inst.srcs:
+            if src_kind == "gen" and src_idx not in gen_regs:
+                gen_regs[src_idx] = num_inputs + len(code) // 4
+                code.extend(
+                    (
+                        int(FusedOpKind.ARANGE),
+                        ndim - 1,
+                        len(constants) // 2,
+                        0,
+                    )
+                )
+                constants.extend(generators[src_idx])
+    inst_regs = dict()
+    src_regs = {"leaf": leaf_regs, "gen": gen_regs, "inst": inst_regs}
+    for idx, inst in enumerate(instructions):
+        if not live[idx]:
+            continue
+        regs = [src_regs[kind][src] for (kind, src) in inst.srcs]
+        if len(regs) == 1:
+            regs.append(0)
+        inst_regs[idx] = num_inputs + len(code) // 4
+        code.extend((int(inst.kind), inst.op_code.value, regs[0], regs[1]))
+    return leaf_regs, code, inst_regs, constants
+
+
+class _Instruction(object):
+    __slots__ = ["kind", "op_code", "srcs", "lhs"]
+
+    def __init__(self, kind, op_code, srcs, lhs):
+        self.kind = kind
+        self.op_code = op_code
+        # Each source is either ("leaf", index), ("inst", index) or
+        # ("gen", index) for a range computed from the coordinates
+        self.srcs = srcs
+        # A weak reference to the array that holds the result
+        self.lhs = lhs
+
+
+class FusionWindow(object):
+    """Records consecutive element-wise operations on arrays of the same
+    shape and type so that they can be issued as a single FUSED_OP task.
+
+    The window is flushed whenever the store of any deferred array is
+    requested, which guarantees that no other operation can observe an
+    array that has a pending write.
+
+    :meta private:
+    """
+
+    def __init__(self, runtime):
+        self.runtime = runtime
+        self._clear()
+
+    def _clear(self):
+        self.shape = None
+        self.dtype = None
+        # Strong references to the leaves keep their ids stable
+        self.leaves = []
+        self.leaf_ids = dict()
+        # The start and step of the ranges that are not written out yet,
+        # which the task evaluates instead of reading them
+        self.generators = []
+        self.generator_ids = dict()
+        self.instructions = []
+        self.pending = dict()
+
+    @property
+    def empty(self):
+        return len(self.instructions) == 0
+
+    def record_unary(self, lhs, op_code, op_dtype, src, args):
+        if op_code == UnaryOpCode.CLIP or op_dtype != lhs.dtype:
+            return False
+        return self._record(lhs, FusedOpKind.UNARY, op_code, (src,), args)
+
+    def record_binary(self, lhs, op_code, src1, src2, args):
+        return self._record(
+            lhs, FusedOpKind.BINARY, op_code, (src1, src2), args
+        )
+
+    def _can_record(self, lhs, srcs, args, immediate):
+        if args is not None and len(args) > 0:
+            return False
+        # We only write to arrays that nobody else has seen yet, as anything
+        # else might be aliased by a view, unless the window is flushed
+        # right away
+        if not (lhs._fresh or immediate) or lhs._base.ndim == 0:
+            return False
+        for src in srcs:
+            if src is lhs or src.dtype != lhs.dtype:
+                return False
+            # Leaves are read straight from their stores when the window
+            # flushes, which would skip clearing a Cholesky factor or
+            # writing out a constant
+            if (
+                src._stale_upper
+                or src._diagonal is not None
+                or src._constant is not None
+            ):
+                return False
+        return True
+
+    def _record(self, lhs, kind, op_code, srcs, args, immediate=False):
+        if not self._can_record(lhs, srcs, args, immediate):
+            return False
+
+        # Going through the base property here would flush the window
+        shape = tuple(lhs._base.shape)
+        if not self.empty and (
+            self.shape != shape or self.dtype != lhs.dtype
+        ):
+            self.flush()
+
+        new_leaves = set(
+            id(src)
+            for src in srcs
+            if self._pending_index(src) is None
+            and src._arange is None
+            and id(src) not in self.leaf_ids
+        )
+        # Every range takes an instruction of its own
+        new_generators = set(
+            id(src)
+            for src in srcs
+            if self._pending_index(src) is None
+            and src._arange is not None
+            and id(src) not in self.generator_ids
+        )
+        num_instructions = len(self.instructions) + len(self.generators)
+        if (
+            num_instructions + len(new_generators) >= MAX_INSTRUCTIONS
+            or len(self.leaves) + len(new_leaves) > MAX_INPUTS
+        ):
+            self.flush()
+
+        self.shape = shape
+        self.dtype = lhs.dtype
+
+        operands = []
+        for src in srcs:
+            index = self._pending_index(src)
+            if index is not None:
+                operands.append(("inst", index))
+                continue
+            key = id(src)
+            if src._arange is not None:
+                if key not in self.generator_ids:
+                    self.generator_ids[key] = len(self.generators)
+                    start, _, step = src._arange
+                    self.generators.append((start, step))
+                operands.append(("gen", self.generator_ids[key]))
+                continue
+            if key not in self.leaf_ids:
+                self.leaf_ids[key] = len(self.leaves)
+                self.leaves.append(src)
+            operands.append(("leaf", self.leaf_ids[key]))
+
+        index = len(self.instructions)
+        self.instructions.append(
+            _Instruction(kind, op_code, tuple(operands), weakref.ref(lhs))
+        )
+        self.pending[id(lhs)] = index
+        lhs._fresh = False
+        return True
+
+    def _pending_index(self, array):
+        # The pending arrays are only weakly referenced, so their ids may
+        # have been recycled by the time we see them again
+        index = self.pending.get(id(array))
+        if index is None or self.instructions[index].lhs() is not array:
+            return None
+        return index
+
+    def expression_of(self, array, output):
+        """Returns the leaves, the code, the result register and the
+        constants of the program that computes array, which is pending in
+        the window, or None when it is not. A task writing output can only
+        evaluate the program in place of reading array when the window
+        does not write output as well.
+        """
+        index = self._pending_index(array)
+        if index is None or self._pending_index(output) is not None:
+            return None
+        leaf_regs, code, inst_regs, constants = _compile(
+            self.instructions, self.generators, len(self.shape), [index]
+        )
+        # Reductions take the shape of their inputs from the first leaf
+        if len(leaf_regs) == 0:
+            return None
+        leaves = [None] * len(leaf_regs)
+        for leaf_idx, reg in leaf_regs.items():
+            leaves[reg] = self.leaves[leaf_idx]
+        return leaves, code, (inst_regs[index],), constants
+
+    def flush(self):
+        if self.empty:
+            return
+        # Leaves may be the results of scalar reads or of launches still in
+        # their windows
+        self.runtime.elements.flush()
+        if self.runtime.launches is not None:
+            self.runtime.launches.flush()
+        instructions = self.instructions
+        leaves = self.leaves
+        generators = self.generators
+        shape = self.shape
+        dtype = self.dtype
+        # Clear the window first as accessing the stores below must not
+        # recursively flush it
+        self._clear()
+
+        # Only the arrays that are still alive need to be written back
+        outputs = []
+        for idx, inst in enumerate(instructions):
+            lhs = inst.lhs()
+            if lhs is not None:
+                outputs.append((lhs, idx))
+        if len(outputs) == 0:
+            return
+
+        # Only the instructions and leaves that live outputs depend on are
+        # compiled
+        leaf_regs, code, inst_regs, constants = _compile(
+            instructions, generators, len(shape), [idx for (_, idx) in outputs]
+        )
+        num_inputs = len(leaf_regs)
+
+        inputs = [None] * num_inputs
+        for leaf_idx, reg in leaf_regs.items():
+            inputs[reg] = broadcast_store(leaves[leaf_idx]._base, shape)
+
+        # A chain may leave more live arrays than a single task can write,
+        # in which case the remaining ones are written by tasks that
+        # evaluate the same program again
+        for start in range(0, len(outputs), MAX_OUTPUTS):
+            chunk = outputs[start : start + MAX_OUTPUTS]
+            self._launch(
+                [lhs._base for (lhs, _) in chunk],
+                inputs,
+                code,
+                [inst_regs[idx] for (_, idx) in chunk],
+                constants,
+                dtype,
+            )
+
+    def _launch(self, outputs, inputs, code, results, constants, dtype):
+        task = self.runtime.legate_context.create_task(
+            CuNumericOpCode.FUSED_OP
+        )
+        for store in outputs:
+            task.add_output(store)
+        for store in inputs:
+            task.add_input(store)
+        task.add_scalar_arg(tuple(code), (ty.int32,))
+        task.add_scalar_arg(tuple(results), (ty.int32,))
+        task.add_scalar_arg(tuple(constants), (dtype,))
+
+        for store in outputs[1:]:
+            task.add_alignment(outputs[0], store)
+        for store in inputs:
+            task.add_alignment(outputs[0], store)
+
+        task.execute()
+
+
+@contextmanager
+def hold_window(runtime):
+    """Keeps the operations pending in the fusion window of the runtime
+    from being issued while the body runs, which must neither write the
+    arrays that the window reads nor touch the arrays that it writes.
+
+    :meta private:
+    """
+    window = runtime.fusion
+    runtime.fusion = None
+    try:
+        yield
+    finally:
+        runtime.fusion = window
+
+
+def evaluate_generated(runtime, lhs, kind, op_code, srcs):
+    """Issues a single element-wise operation with operands that are ranges
+    not written out yet as a FUSED_OP task, which computes their values
+    from the coordinates of the elements. Returns False when the operation
+    cannot be evaluated this way.
+
+    :meta private:
+    """
+    # The output is overwritten as a whole, but anything pending on it must
+    # land first
+    lhs.base
+    window = FusionWindow(runtime)
+    if not window._record(lhs, kind, op_code, srcs, None, immediate=True):
+        return False
+    window.flush()
+    return True
+
+
+class ProductWindow(object):
+    """Holds back the most recent element-wise product written to a fresh
+    array so that an addition consuming it can be issued as a single FMA
+    task. Like the fusion window, the product is computed on its own as soon
+    as the store of any deferred array is requested.
+
+    :meta private:
+    """
+
+    def __init__(self):
+        self._clear()
+
+    def _clear(self):
+        # A weak reference to the array that holds the product, whose
+        # computation is skipped altogether if it dies first
+        self.lhs = None
+        self.factors = None
+
+    def record(self, lhs, src1, src2):
+        self.flush()
+        self.lhs = weakref.ref(lhs)
+        self.factors = (src1, src2)
+
+    def factors_of(self, array):
+        if self.lhs is None or self.lhs() is not array:
+            return None
+        return self.factors
+
+    def take(self):
+        factors = self.factors
+        self._clear()
+        return factors
+
+    def flush(self):
+        if self.lhs is None:
+            return
+        lhs = self.lhs()
+        src1, src2 = self.take()
+        if lhs is not None:
+            lhs._fresh = False
+            lhs.binary_op(
+                BinaryOpCode.MULTIPLY, src1, src2, None, [], stacklevel=1
+            )
+
+
+class ElementWindow(object):
+    """Holds back the reads of single elements into fresh scalars, so that a
+    run of them going into scalars of the same type is issued as a single
+    READ task. Like the other windows, the reads are issued as soon as the
+    store of any deferred array is requested, which is in particular how
+    the results and any later writes to the arrays that were read see them.
+
+    Scalar writes are not held back: views of different elements of one
+    array are not known to be disjoint, so several of them could not be
+    written by one task.
+
+    :meta private:
+    """
+
+    def __init__(self, runtime):
+        self.runtime = runtime
+        self._clear()
+
+    def _clear(self):
+        self.dtype = None
+        # The scalars are only weakly referenced, so that the reads of
+        # scalars that die before the window flushes are skipped
+        self.results = []
+        self.sources = []
+
+    def record_read(self, result, source):
+        if self.dtype != result.dtype or (
+            len(self.results) == MAX_BATCHED_ELEMENTS
+        ):
+            self.flush()
+        self.dtype = result.dtype
+        self.results.append(weakref.ref(result))
+        self.sources.append(source)
+
+    def flush(self):
+        if self.dtype is None:
+            return
+        results = self.results
+        sources = self.sources
+        self._clear()
+
+        reads = [
+            (result()._base, source)
+            for (result, source) in zip(results, sources)
+            if result() is not None
+        ]
+        if len(reads) == 0:
+            return
+        task = self.runtime.legate_context.create_task(CuNumericOpCode.READ)
+        for (result, source) in reads:
+            task.add_input(source)
+            task.add_output(result)
+        task.execute()
+
+
+class LaunchWindow(object):
+    """Holds back the tasks that write fresh arrays, so that a run of
+    independent launches is submitted back to back once anyone needs one
+    of them, and the tasks whose results die before that are never
+    submitted at all. Only arrays that own their stores are held or read
+    by held tasks, so requesting the store of any of them is the only way
+    to observe or overwrite what a held task touches, and that flushes the
+    window.
+
+    :meta private:
+    """
+
+    def __init__(self, runtime):
+        self.runtime = runtime
+        self._clear()
+
+    def _clear(self):
+        # The tasks go with weak references to the arrays they write
+        self.launches = []
+        # The arrays that the held tasks write or read, by their ids
+        self.arrays = dict()
+
+    def holds(self, array):
+        # The arrays are only weakly referenced, so their ids may have been
+        # recycled by the time we see them again
+        entry = self.arrays.get(id(array))
+        return entry is not None and entry() is array
+
+    def can_record(self, lhs, srcs):
+        if not (lhs._fresh and lhs._owns_store) or lhs._base.ndim == 0:
+            return False
+        return all(src is not lhs and src._owns_store for src in srcs)
+
+    def record(self, task, lhs, srcs):
+        if len(self.launches) == MAX_HELD_LAUNCHES:
+            self.flush()
+        self.launches.append((task, weakref.ref(lhs)))
+        for array in (lhs,) + tuple(srcs):
+            self.arrays[id(array)] = weakref.ref(array)
+
+    def flush(self):
+        if len(self.launches) == 0:
+            return
+        launches = self.launches
+        self._clear()
+        # No held task reads what another one writes, so dropping the ones
+        # whose results are dead cannot change what the others see
+        for (task, lhs) in launches:
+            if lhs() is not None:
+                task.execute()
+
+
+class StoreRecycler(object):
+    """Keeps the stores of dead temporaries for the next arrays of the same
+    shape and type, which then write the instances that the dead arrays
+    were mapped to rather than asking for new ones. Only stores that no
+    view, alias or NumPy array was ever made of come back here.
+
+    :meta private:
+    """
+
+    def __init__(self, runtime):
+        self.runtime = runtime
+        self.stores = dict()
+
+    def release(self, store, dtype):
+        stores = self.stores.setdefault((tuple(store.shape), dtype), [])
+        if len(stores) < MAX_RECYCLED_STORES:
+            stores.append(store)
+
+    def take(self, shape, dtype):
+        stores = self.stores.get((tuple(shape), dtype))
+        if not stores:
+            return None
+        # Tasks held back in the windows may still read the store, and they
+        # must be issued before anyone writes it again
+        self.runtime.elements.flush()
+        if self.runtime.launches is not None:
+            self.runtime.launches.flush()
+        return stores.pop()
+
+    def clear(self):
+        self.stores = dict()
@@ -0,0 +1,70 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+from itertools import product
+
+
+def halo_stencils(halo):
+    """
+    Return the offsets of the shifted tiles that cover the halo of a tile,
+    given the (lo, hi) widths of the halo along every dimension. Dimensions
+    without a halo on one side take no shifted tiles on that side.
+    """
+    offsets = []
+    for lo, hi in halo:
+        offsets.append(
+            tuple(
+                offset
+                for offset, width in ((-lo, lo), (0, 1), (hi, hi))
+                if width > 0
+            )
+        )
+    stencils = list(product(*offsets))
+    stencils.remove((0,) * len(halo))
+    return stencils
+
+
+def stencil_halo(offsets):
+    """
+    Return the (lo, hi) widths of the halo that a stencil with the given
+    offsets reads around the points it updates.
+    """
+    return tuple(
+        (max(0, -min(dim_offsets)), max(0, max(dim_offsets)))
+        for dim_offsets in zip(*offsets)
+    )
+
+
+def add_halo_input(task, store, halo):
+    """
+    Add store to the task as a tile together with the (lo, hi) widths of
+    halo around it along every dimension, and return the partition of the
+    tile. Every shifted tile is passed as another input after the tile
+    itself, which the mapper maps to the instance of the tile, so tasks
+    see a single instance that covers both.
+
+    That instance stays valid across repeated launches that keep the
+    same tiles, so when the store alternates between being the output of
+    one launch and the input of the next, as it does with preallocated
+    buffers in iterative stencils, only the ghost parts of the halo move
+    from one launch to the next instead of the whole tile.
+    """
+    p_tile = task.declare_partition(store)
+    task.add_input(store, partition=p_tile)
+    for stencil in halo_stencils(halo):
+        p_stencil = task.declare_partition(store, complete=False)
+        task.add_input(store, partition=p_stencil)
+        task.add_constraint(p_tile + stencil <= p_stencil)
+    return p_tile
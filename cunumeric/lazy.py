@@ -59,6 +59,9 @@ class LazyArray(NumPyThunk):
     def set_item(self, key, value, stacklevel):
         raise NotImplementedError("Implement in derived classes")
 
+    def scatter_reduce(self, key, value, op, stacklevel):
+        raise NotImplementedError("Implement in derived classes")
+
     def reshape(self, newshape, order, stacklevel):
         raise NotImplementedError("Implement in derived classes")
 
@@ -74,9 +77,36 @@ class LazyArray(NumPyThunk):
     def fill(self, value, stacklevel):
         raise NotImplementedError("Implement in derived classes")
 
+    def load_npy(self, path, offset, stacklevel):
+        raise NotImplementedError("Implement in derived classes")
+
+    def save_npy(self, path, offset, stacklevel):
+        raise NotImplementedError("Implement in derived classes")
+
     def dot(self, rhs1, rhs2, stacklevel):
         raise NotImplementedError("Implement in derived classes")
 
+    def spmm(self, pos, crd, vals, rhs, indptr, stacklevel):
+        raise NotImplementedError("Implement in derived classes")
+
+    def fft(self, rhs, axes, kind, inverse, scale, stacklevel):
+        raise NotImplementedError("Implement in derived classes")
+
+    def batched_matmul(self, rhs1, rhs2, scale, bias, activation, stacklevel):
+        raise NotImplementedError("Implement in derived classes")
+
+    def solve(self, a, b, stacklevel):
+        raise NotImplementedError("Implement in derived classes")
+
+    def cholesky_solve(self, factor, b, stacklevel):
+        raise NotImplementedError("Implement in derived classes")
+
+    def qr(self, a, q, stacklevel):
+        raise NotImplementedError("Implement in derived classes")
+
+    def svd(self, a, u, vh, stacklevel):
+        raise NotImplementedError("Implement in derived classes")
+
     def transpose(self, rhs, axes, stacklevel):
         raise NotImplementedError("Implement in derived classes")
 
@@ -92,6 +122,9 @@ class LazyArray(NumPyThunk):
     ):
         raise NotImplementedError("Implement in derived classes")
 
+    def putmask(self, mask, values, stacklevel):
+        raise NotImplementedError("Implement in derived classes")
+
     def choose(
         self,
         *args,
@@ -111,16 +144,46 @@ class LazyArray(NumPyThunk):
     def eye(self, k, stacklevel):
         raise NotImplementedError("Implement in derived classes")
 
+    def concatenate(self, sources, axis, stacklevel):
+        raise NotImplementedError("Implement in derived classes")
+
     def tile(self, rhs, reps, stacklevel):
         raise NotImplementedError("Implement in derived classes")
 
+    def repeat(self, rhs, repeats, axis, stacklevel):
+        raise NotImplementedError("Implement in derived classes")
+
+    def pad(self, rhs, pad_width, mode, constant_value, stacklevel):
+        raise NotImplementedError("Implement in derived classes")
+
+    def stencil(self, rhs, offsets, coefficients, stacklevel):
+        raise NotImplementedError("Implement in derived classes")
+
     def bincount(self, rhs, stacklevel, weights=None):
         raise NotImplementedError("Implement in derived classes")
 
+    def histogram(self, rhs, edges, uniform, stacklevel, weights=None):
+        raise NotImplementedError("Implement in derived classes")
+
+    def segment_reduce(self, labels, values, op, stacklevel, counts=None):
+        raise NotImplementedError("Implement in derived classes")
+
     def nonzero(self, stacklevel):
         raise NotImplementedError("Implement in derived classes")
 
-    def sort(self, rhs, stacklevel):
+    def unique(self, stacklevel):
+        raise NotImplementedError("Implement in derived classes")
+
+    def topk(self, k, axis, largest, stacklevel):
+        raise NotImplementedError("Implement in derived classes")
+
+    def sort(self, rhs, argsort, stacklevel):
+        raise NotImplementedError("Implement in derived classes")
+
+    def searchsorted(self, rhs, v, side, stacklevel):
+        raise NotImplementedError("Implement in derived classes")
+
+    def scan(self, rhs, op, axis, stacklevel):
         raise NotImplementedError("Implement in derived classes")
 
     def random_uniform(self, stacklevel):
@@ -132,6 +195,15 @@ class LazyArray(NumPyThunk):
     def random_integer(self, low, high, stacklevel):
         raise NotImplementedError("Implement in derived classes")
 
+    def random_permutation(self, stacklevel):
+        raise NotImplementedError("Implement in derived classes")
+
+    def random_bernoulli(self, p, on_value, off_value, stacklevel):
+        raise NotImplementedError("Implement in derived classes")
+
+    def random_distribution(self, gen_code, args, stacklevel):
+        raise NotImplementedError("Implement in derived classes")
+
     def unary_op(self, op, op_type, rhs, where, args, stacklevel):
         raise NotImplementedError("Implement in derived classes")
 
@@ -140,6 +212,12 @@ class LazyArray(NumPyThunk):
     ):
         raise NotImplementedError("Implement in derived classes")
 
+    def multi_reduction(self, ops, out_shape, axes, keepdims, stacklevel):
+        raise NotImplementedError("Implement in derived classes")
+
+    def multi_dot(self, vectors, pairs, stacklevel):
+        raise NotImplementedError("Implement in derived classes")
+
     def binary_op(self, op, rhs1, rhs2, where, args, stacklevel):
         raise NotImplementedError("Implement in derived classes")
 
@@ -13,10 +13,11 @@
 # limitations under the License.
 #
 
+import numpy as np
 
 from cunumeric.config import CuNumericOpCode
 
-from legate.core import Rect, types as ty
+from legate.core import ReductionOp, Rect, types as ty
 
 
 def transpose_copy(context, launch_domain, p_input, p_output):
@@ -34,13 +35,15 @@ def transpose_copy(context, launch_domain, p_input, p_output):
     task.execute()
 
 
-def potrf(context, p_output, i):
+def potrf(context, p_output, i, info, row_major=False):
     launch_domain = Rect(lo=(i, i), hi=(i + 1, i + 1))
     task = context.create_task(
         CuNumericOpCode.POTRF, manual=True, launch_domain=launch_domain
     )
     task.add_output(p_output)
     task.add_input(p_output)
+    task.add_reduction(info, ReductionOp.MAX)
+    task.add_scalar_arg(row_major, ty.bool_)
     task.execute()
 
 
@@ -58,6 +61,15 @@ def trsm(context, p_output, i, lo, hi):
     task.add_output(lhs)
     task.add_input(rhs)
     task.add_input(lhs)
+    # Solve against the transpose of the lower triangular diagonal tile
+    # from the right: left, lower, transpose, unit_diagonal and row_major.
+    # The whole panel feeds the next step, so it is on the critical path
+    task.add_scalar_arg(False, ty.bool_)
+    task.add_scalar_arg(True, ty.bool_)
+    task.add_scalar_arg(True, ty.bool_)
+    task.add_scalar_arg(False, ty.bool_)
+    task.add_scalar_arg(True, ty.bool_)
+    task.add_scalar_arg(True, ty.bool_)
     task.execute()
 
 
@@ -72,6 +84,10 @@ def syrk(context, p_output, k, i):
     task.add_output(lhs)
     task.add_input(rhs)
     task.add_input(lhs)
+    # The tiles are in row major order, and the update of the next
+    # diagonal tile is on the critical path
+    task.add_scalar_arg(True, ty.bool_)
+    task.add_scalar_arg(k == i + 1, ty.bool_)
     task.execute()
 
 
@@ -91,13 +107,15 @@ def gemm(context, p_output, k, i, lo, hi):
     task.add_input(rhs1, proj=lambda p: (p[0], i))
     task.add_input(rhs2)
     task.add_input(lhs)
+    # The second tile is transposed and the tiles are in row major order.
+    # The updates of the next column panel are on the critical path
+    task.add_scalar_arg(True, ty.bool_)
+    task.add_scalar_arg(False, ty.bool_)
+    task.add_scalar_arg(True, ty.bool_)
+    task.add_scalar_arg(k == i + 1, ty.bool_)
     task.execute()
 
 
-MIN_CHOLESKY_TILE_SIZE = 2048
-MIN_CHOLESKY_MATRIX_SIZE = 8192
-
-
 # TODO: We need a better cost model
 def choose_color_shape(runtime, shape):
     if runtime.test_mode:
@@ -106,8 +124,13 @@ def choose_color_shape(runtime, shape):
     else:
         extent = shape[0]
         # If there's only one processor or the matrix is too small,
-        # don't even bother to partition it at all
-        if runtime.num_procs == 1 or extent <= MIN_CHOLESKY_MATRIX_SIZE:
+        # don't even bother to partition it at all. The cross-over
+        # point comes from the mapper, as it depends on the processor
+        # kind that will run the factorization
+        if (
+            runtime.num_procs == 1
+            or extent <= runtime.min_cholesky_matrix_size
+        ):
             return (1, 1)
 
         # If the matrix is big enough to warrant partitioning,
@@ -115,7 +138,8 @@ def choose_color_shape(runtime, shape):
         num_tiles = runtime.num_procs
         max_num_tiles = runtime.num_procs * 4
         while (
-            (extent + num_tiles - 1) // num_tiles > MIN_CHOLESKY_TILE_SIZE
+            (extent + num_tiles - 1) // num_tiles
+            > runtime.min_cholesky_tile_size
             and num_tiles * 2 <= max_num_tiles
         ):
             num_tiles *= 2
@@ -123,7 +147,7 @@ def choose_color_shape(runtime, shape):
         return (num_tiles, num_tiles)
 
 
-def cholesky(output, input, stacklevel=0, callsite=None):
+def cholesky(output, input, info=None, stacklevel=0, callsite=None):
     shape = output.base.shape
     color_shape = choose_color_shape(output.runtime, shape)
     tile_shape = (shape + color_shape - 1) // color_shape
@@ -131,13 +155,168 @@ def cholesky(output, input, stacklevel=0, callsite=None):
     n = color_shape[0]
 
     context = output.context
-    p_input = input.base.partition_by_tiling(tile_shape)
+    runtime = output.runtime
+    # Every POTRF folds into this flag whether its tile turned out not to be
+    # positive definite. The flag is a future, so checking it is up to the
+    # caller and nothing here waits for the factorization.
+    if info is None:
+        info = runtime.create_empty_thunk(
+            (), np.dtype(np.int32), inputs=[output]
+        )
+    info.fill(
+        np.array(0, dtype=np.int32),
+        stacklevel=stacklevel + 1,
+        callsite=callsite,
+    )
+
+    # Every task of the factorization flips its transpose flags to work
+    # on row major tiles, so the factor is computed in place on a plain
+    # copy of the input and stays in the layout the rest of the program
+    # reads it in, without going through a Fortran order re-layout
+    output.copy(input, stacklevel=stacklevel + 1, callsite=callsite)
     p_output = output.base.partition_by_tiling(tile_shape)
-    transpose_copy(context, Rect(hi=color_shape), p_input, p_output)
 
     for i in range(n):
-        potrf(context, p_output, i)
+        potrf(context, p_output, i, info.base, row_major=True)
         trsm(context, p_output, i, i + 1, n)
         for k in range(i + 1, n):
             syrk(context, p_output, k, i)
             gemm(context, p_output, k, i, k + 1, n)
+
+
+def trsm_solve(
+    context, p_output, factor, transpose, launch_domain, critical=False
+):
+    task = context.create_task(
+        CuNumericOpCode.TRSM, manual=True, launch_domain=launch_domain
+    )
+    task.add_output(p_output)
+    task.add_input(factor)
+    task.add_input(p_output)
+    # Solve against the lower triangular factor, or its transpose, from the
+    # left: left, lower, transpose, unit_diagonal and row_major. Both the
+    # factor and the right-hand side are in row major order
+    task.add_scalar_arg(True, ty.bool_)
+    task.add_scalar_arg(True, ty.bool_)
+    task.add_scalar_arg(transpose, ty.bool_)
+    task.add_scalar_arg(False, ty.bool_)
+    task.add_scalar_arg(True, ty.bool_)
+    task.add_scalar_arg(critical, ty.bool_)
+    task.execute()
+
+
+def gemm_solve(context, p_output, p_factor, i, lo, hi, transpose):
+    if lo >= hi:
+        return
+
+    # Subtract the product of the factor tiles in the column (or the row,
+    # when transposed) of the diagonal tile i with the block of the
+    # solution that was just found from the blocks of the right-hand side
+    def factor_proj(p):
+        return (i, p[0]) if transpose else (p[0], i)
+
+    # Only the block next in line is on the critical path
+    next_block = hi - 1 if transpose else lo
+    for (block_lo, block_hi, critical) in (
+        (next_block, next_block + 1, True),
+        (lo, next_block, False),
+        (next_block + 1, hi, False),
+    ):
+        if block_lo >= block_hi:
+            continue
+        launch_domain = Rect(lo=(block_lo, 0), hi=(block_hi, 1))
+        task = context.create_task(
+            CuNumericOpCode.GEMM, manual=True, launch_domain=launch_domain
+        )
+        task.add_output(p_output)
+        task.add_input(p_factor, proj=factor_proj)
+        task.add_input(p_output, proj=lambda p: (i, 0))
+        task.add_input(p_output)
+        # The factor tile is (conjugate) transposed in the backward
+        # substitution, and the tiles are in row major order
+        task.add_scalar_arg(False, ty.bool_)
+        task.add_scalar_arg(transpose, ty.bool_)
+        task.add_scalar_arg(True, ty.bool_)
+        task.add_scalar_arg(critical, ty.bool_)
+        task.execute()
+
+
+def triangular_solve(
+    output, factor, b, transposes, stacklevel=0, callsite=None
+):
+    """
+    Solve ``L x = b`` by substitution against the lower triangular factor
+    ``L``, or its conjugate transpose, once for every flag of
+    ``transposes``. Only the lower triangle of the factor is read, so the
+    upper triangle that a Cholesky decomposition leaves behind never needs
+    to be cleared.
+
+    A factor large enough to be tiled for the decomposition is tiled the
+    same way here, and the right-hand side is split into the matching
+    blocks of rows. The substitution then walks the tile rows: a TRSM
+    solves one block of every column of the right-hand side at once
+    against the diagonal tile, and GEMMs subtract it from the blocks that
+    are still to be solved, which lets the solve of the next block start
+    while the remaining updates are in flight.
+    """
+    runtime = output.runtime
+    factor_store = factor.triangular_base
+    output.copy(b, stacklevel=stacklevel + 1, callsite=callsite)
+    store = output.base
+    if output.ndim == 1:
+        store = store.promote(1, 1)
+
+    shape = factor_store.shape
+    color_shape = choose_color_shape(runtime, shape)
+    if color_shape[0] > 1:
+        tile_shape = (shape + color_shape - 1) // color_shape
+        color_shape = (shape + tile_shape - 1) // tile_shape
+        n = color_shape[0]
+        p_factor = factor_store.partition_by_tiling(tile_shape)
+        p_output = store.partition_by_tiling((tile_shape[0], store.shape[1]))
+        context = output.context
+        for transpose in transposes:
+            order = range(n - 1, -1, -1) if transpose else range(n)
+            for i in order:
+                trsm_solve(
+                    context,
+                    p_output,
+                    p_factor.get_child_store(i, i),
+                    transpose,
+                    Rect(lo=(i, 0), hi=(i + 1, 1)),
+                    critical=True,
+                )
+                if transpose:
+                    gemm_solve(context, p_output, p_factor, i, 0, i, True)
+                else:
+                    gemm_solve(context, p_output, p_factor, i, i + 1, n, False)
+        return
+
+    # Every point solves for its own block of columns of the right-hand
+    # side against the whole factor
+    num_cols = store.shape[1]
+    num_blocks = min(runtime.num_procs, num_cols)
+    block = (num_cols + num_blocks - 1) // num_blocks
+    num_blocks = (num_cols + block - 1) // block
+    p_output = store.partition_by_tiling((store.shape[0], block))
+    launch_domain = Rect(hi=(1, num_blocks))
+    for transpose in transposes:
+        trsm_solve(
+            output.context, p_output, factor_store, transpose, launch_domain
+        )
+
+
+def cholesky_solve(output, factor, b, stacklevel=0, callsite=None):
+    """
+    Solve ``L L^H x = b`` with a forward substitution against the lower
+    triangular factor ``L`` followed by a backward substitution against
+    its conjugate transpose.
+    """
+    triangular_solve(
+        output,
+        factor,
+        b,
+        (False, True),
+        stacklevel=stacklevel + 1,
+        callsite=callsite,
+    )
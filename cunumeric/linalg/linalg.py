@@ -13,70 +13,917 @@
 # limitations under the License.
 #
 
+import operator
+
 import numpy as np
 from cunumeric.array import ndarray
-from cunumeric.module import sqrt as _sqrt
+from cunumeric.config import UnaryRedCode
+from cunumeric.module import (
+    add as _add,
+    eye as _eye,
+    fused_matmul as _fused_matmul,
+    matmul as _matmul,
+    maximum as _maximum,
+    sqrt as _sqrt,
+)
+
+
+def cholesky(a, info=None):
+    """
+    Cholesky decomposition.
 
+    Return the lower triangular factor L of a Hermitian positive-definite
+    matrix, such that ``a = L @ L.H``.
 
-def cholesky(a):
+    Parameters
+    ----------
+    a : array_like
+        Hermitian positive-definite input matrix of shape ``(M, M)``.
+    info : ndarray, optional
+        A 0-d integer array that is set to a non-zero value when ``a``
+        turns out not to be positive definite. Unlike NumPy, which raises
+        ``LinAlgError``, the check doesn't wait for the factorization to
+        finish; the failure only becomes visible once ``info`` is read.
+        This argument is a cuNumeric extension.
+
+    Returns
+    -------
+    L : ndarray
+        Lower triangular Cholesky factor of ``a``.
+    """
     lg_array = ndarray.convert_to_cunumeric_ndarray(a)
-    shape = lg_array.shape
-    if len(shape) < 2:
+    _check_square(lg_array)
+    return lg_array.cholesky(info=info, stacklevel=2)
+
+
+def _solve_dtype(*arrays):
+    dtype = np.result_type(*(array.dtype for array in arrays))
+    if dtype == np.float16:
+        raise TypeError("array type float16 is unsupported in linalg")
+    if dtype.kind not in ("f", "c"):
+        dtype = np.dtype(np.float64)
+    return dtype
+
+
+def _check_square(a, stacked=False):
+    if a.ndim < 2:
         raise ValueError(
-            f"{len(shape)}-dimensional array given. "
+            f"{a.ndim}-dimensional array given. "
             "Array must be at least two-dimensional"
         )
-    elif shape[-1] != shape[-2]:
+    elif a.shape[-1] != a.shape[-2]:
         raise ValueError("Last 2 dimensions of the array must be square")
 
-    if len(shape) > 2:
+    if a.ndim > 2 and not stacked:
         raise NotImplementedError(
             "cuNumeric needs to support stacked 2d arrays"
         )
-    return lg_array.cholesky(stacklevel=2)
 
 
-def norm(x, ord=None, axis=None, keepdims=False, stacklevel=1):
-    lg_array = ndarray.convert_to_cunumeric_ndarray(x)
-    if (axis is None and lg_array.ndim == 1) or type(axis) == int:
-        # Handle the weird norm cases
-        if ord == np.inf:
-            return abs(lg_array).max(
-                axis=axis, keepdims=keepdims, stacklevel=(stacklevel + 1)
-            )
-        elif ord == -np.inf:
-            return abs(lg_array).min(
-                axis=axis, keepdims=keepdims, stacklevel=(stacklevel + 1)
-            )
-        elif ord == 0:
-            # Check for where things are not zero and convert to integer
-            # for sum
-            temp = (lg_array != 0).astype(np.int64)
-            return temp.sum(
-                axis=axis, keepdims=keepdims, stacklevel=(stacklevel + 1)
+# The largest stacked systems that are solved a whole system per thread,
+# which matches BATCHED_SOLVE_MAX_N in the tasks
+_BATCHED_SOLVE_MAX_N = 32
+
+
+def _batched_solve(a, b, cholesky, stacklevel):
+    batch_shape = a.shape[:-2]
+    n = a.shape[-1]
+    if b is None:
+        out_shape = a.shape
+    else:
+        # Like NumPy, right-hand sides with one dimension less than the
+        # matrices are stacks of vectors
+        vector = b.ndim == a.ndim - 1
+        if b.ndim not in (a.ndim - 1, a.ndim):
+            raise ValueError(
+                f"b of shape {b.shape} does not match a of shape {a.shape}"
             )
-        elif ord == 1:
-            return abs(lg_array).sum(
-                axis=axis, keepdims=keepdims, stacklevel=stacklevel + 1
+        if b.shape[: len(batch_shape)] != batch_shape:
+            raise NotImplementedError(
+                "cuNumeric needs to support broadcasting stacked systems"
             )
-        elif ord is None or ord == 2:
-            s = (lg_array.conj() * lg_array).real
-            return _sqrt(
-                s.sum(axis=axis, keepdims=keepdims, stacklevel=stacklevel + 1)
+        if b.shape[len(batch_shape)] != n:
+            raise ValueError(
+                f"b has {b.shape[len(batch_shape)]} rows, but a is {n} by {n}"
             )
-        elif isinstance(ord, str):
-            raise ValueError(f"Invalid norm order '{ord}' for vectors")
-        elif type(ord) == int:
-            absx = abs(lg_array)
-            absx **= ord
-            ret = absx.sum(
-                axis=axis, keepdims=keepdims, stacklevel=(stacklevel + 1)
+        out_shape = b.shape
+
+    dtype = _solve_dtype(a) if b is None else _solve_dtype(a, b)
+    if a.dtype != dtype:
+        a = a.astype(dtype)
+    if b is not None and b.dtype != dtype:
+        b = b.astype(dtype)
+
+    # Complex and larger systems are solved one at a time
+    if dtype.kind == "c" or n > _BATCHED_SOLVE_MAX_N:
+        output = ndarray(
+            shape=out_shape,
+            dtype=dtype,
+            stacklevel=stacklevel + 1,
+            inputs=(a,) if b is None else (a, b),
+        )
+        for index in np.ndindex(*batch_shape):
+            if b is None:
+                output[index] = inv(a[index], stacklevel=stacklevel + 1)
+            elif cholesky:
+                output[index] = cholesky_solve(
+                    a[index], b[index], stacklevel=stacklevel + 1
+                )
+            else:
+                output[index] = solve(
+                    a[index], b[index], stacklevel=stacklevel + 1
+                )
+        return output
+
+    batch = int(np.prod(batch_shape))
+    a = a.reshape((batch, n, n))
+    if b is not None:
+        b = b.reshape((batch, n, 1 if vector else b.shape[-1]))
+    output = ndarray(
+        shape=(batch, n, n) if b is None else b.shape,
+        dtype=dtype,
+        stacklevel=stacklevel + 1,
+        inputs=(a,) if b is None else (a, b),
+    )
+    if output.size > 0:
+        output._thunk.batched_solve(
+            a._thunk,
+            stacklevel=(stacklevel + 1),
+            b=None if b is None else b._thunk,
+            cholesky=cholesky,
+        )
+    return output.reshape(out_shape)
+
+
+def _check_system(a, b):
+    _check_square(a)
+    if b.ndim not in (1, 2):
+        raise NotImplementedError(
+            "cuNumeric needs to support stacked right-hand sides"
+        )
+    if b.shape[0] != a.shape[0]:
+        raise ValueError(
+            f"b has {b.shape[0]} rows, but a is {a.shape[0]} by "
+            f"{a.shape[1]}"
+        )
+
+
+def solve(a, b, stacklevel=1):
+    lg_a = ndarray.convert_to_cunumeric_ndarray(a)
+    lg_b = ndarray.convert_to_cunumeric_ndarray(b)
+    if lg_a.ndim > 2:
+        _check_square(lg_a, stacked=True)
+        return _batched_solve(lg_a, lg_b, False, stacklevel + 1)
+    _check_system(lg_a, lg_b)
+
+    dtype = _solve_dtype(lg_a, lg_b)
+    if lg_a.dtype != dtype:
+        lg_a = lg_a.astype(dtype)
+    if lg_b.dtype != dtype:
+        lg_b = lg_b.astype(dtype)
+
+    output = ndarray(
+        shape=lg_b.shape,
+        dtype=dtype,
+        stacklevel=stacklevel + 1,
+        inputs=(lg_a, lg_b),
+    )
+    if output.size == 0:
+        return output
+    output._thunk.solve(lg_a._thunk, lg_b._thunk, stacklevel=(stacklevel + 1))
+    return output
+
+
+def _factor_dtype(dtype, factor_dtype):
+    if factor_dtype is None:
+        return dtype
+    factor_dtype = np.dtype(factor_dtype)
+    if factor_dtype == np.float16:
+        raise NotImplementedError(
+            "cuNumeric needs to support float16 Cholesky factorizations"
+        )
+    if factor_dtype.kind != dtype.kind:
+        raise TypeError(
+            f"cannot factor a {dtype} system in {factor_dtype} precision"
+        )
+    # A factorization more precise than the system gains nothing
+    if factor_dtype.itemsize >= dtype.itemsize:
+        return dtype
+    return factor_dtype
+
+
+def _cholesky_solve(factor, b, stacklevel):
+    output = ndarray(
+        shape=b.shape,
+        dtype=b.dtype,
+        stacklevel=stacklevel + 1,
+        inputs=(factor, b),
+    )
+    output._thunk.cholesky_solve(
+        factor._thunk, b._thunk, stacklevel=(stacklevel + 1)
+    )
+    return output
+
+
+def cholesky_solve(a, b, factor_dtype=None, max_iters=10, stacklevel=1):
+    """
+    Solve a Hermitian positive-definite linear system ``a x = b`` with the
+    Cholesky decomposition of ``a``. This function is a cuNumeric
+    extension.
+
+    When ``factor_dtype`` is less precise than the system, ``a`` is
+    factored in that precision, which is considerably faster, and the
+    solution is then iteratively refined: every step computes the residual
+    in the precision of the system and solves for the correction against
+    the low precision factor. Well-conditioned systems reach the accuracy
+    of the full precision solve in a few steps. Systems that fail to do so
+    within ``max_iters`` steps are solved again with a full precision
+    factorization.
+
+    Parameters
+    ----------
+    a : array_like
+        Hermitian positive-definite matrix of shape ``(M, M)``, or a stack
+        of them of shape ``(..., M, M)``.
+    b : array_like
+        Right-hand side of shape ``(M,)`` or ``(M, K)``, or a stack of them
+        of shape ``(..., M)`` or ``(..., M, K)``.
+    factor_dtype : dtype, optional
+        Precision of the factorization, such as float32 for a float64
+        system. The precision of the system is used by default. Stacks of
+        systems are always factored in their own precision.
+    max_iters : int, optional
+        Maximum number of refinement steps.
+
+    Returns
+    -------
+    x : ndarray
+        Solution of the system, in the precision of ``a`` and ``b``.
+    """
+    lg_a = ndarray.convert_to_cunumeric_ndarray(a)
+    lg_b = ndarray.convert_to_cunumeric_ndarray(b)
+    if lg_a.ndim > 2:
+        _check_square(lg_a, stacked=True)
+        return _batched_solve(lg_a, lg_b, True, stacklevel + 1)
+    _check_system(lg_a, lg_b)
+
+    dtype = _solve_dtype(lg_a, lg_b)
+    if lg_a.dtype != dtype:
+        lg_a = lg_a.astype(dtype)
+    if lg_b.dtype != dtype:
+        lg_b = lg_b.astype(dtype)
+    if lg_b.size == 0:
+        return lg_b.copy()
+
+    low = _factor_dtype(dtype, factor_dtype)
+    if low == dtype:
+        factor = lg_a.cholesky(no_tril=True, stacklevel=stacklevel + 1)
+        return _cholesky_solve(factor, lg_b, stacklevel + 1)
+
+    factor = lg_a.astype(low).cholesky(no_tril=True, stacklevel=stacklevel + 1)
+    x = _cholesky_solve(factor, lg_b.astype(low), stacklevel + 1)
+    x = x.astype(dtype)
+
+    # The stopping test of LAPACK's mixed precision solvers: the residual
+    # has to be within a small multiple of the rounding error that a full
+    # precision solve would make
+    n = lg_a.shape[0]
+    eps = np.finfo(dtype).eps
+    a_norm = float(abs(lg_a).sum(axis=1).max())
+    threshold = np.sqrt(n) * a_norm * eps
+    for step in range(max_iters + 1):
+        r = lg_b - lg_a @ x
+        if float(abs(r).max()) <= threshold * float(abs(x).max()):
+            return x
+        if step < max_iters:
+            d = _cholesky_solve(factor, r.astype(low), stacklevel + 1)
+            x += d.astype(dtype)
+
+    factor = lg_a.cholesky(no_tril=True, stacklevel=stacklevel + 1)
+    return _cholesky_solve(factor, lg_b, stacklevel + 1)
+
+
+def cho_solve(c, b, stacklevel=1):
+    """
+    Solve a Hermitian positive-definite linear system ``a x = b`` given
+    the lower triangular Cholesky factor ``c`` of ``a``, as returned by
+    :func:`cholesky`. This function is a cuNumeric extension.
+
+    The system is solved by a forward substitution against ``c`` followed
+    by a backward substitution against its conjugate transpose. Only the
+    lower triangle of ``c`` is read. All of the columns of ``b`` are solved
+    together, so factoring once and solving many right-hand sides costs a
+    single pair of substitutions.
+
+    Parameters
+    ----------
+    c : array_like
+        Lower triangular Cholesky factor of shape ``(M, M)``.
+    b : array_like
+        Right-hand side of shape ``(M,)`` or ``(M, K)``.
+
+    Returns
+    -------
+    x : ndarray
+        Solution of the system.
+    """
+    lg_c = ndarray.convert_to_cunumeric_ndarray(c)
+    lg_b = ndarray.convert_to_cunumeric_ndarray(b)
+    _check_system(lg_c, lg_b)
+
+    dtype = _solve_dtype(lg_c, lg_b)
+    if lg_c.dtype != dtype:
+        lg_c = lg_c.astype(dtype)
+    if lg_b.dtype != dtype:
+        lg_b = lg_b.astype(dtype)
+    if lg_b.size == 0:
+        return lg_b.copy()
+    return _cholesky_solve(lg_c, lg_b, stacklevel + 1)
+
+
+def inv(a, stacklevel=1):
+    lg_array = ndarray.convert_to_cunumeric_ndarray(a)
+    if lg_array.ndim > 2:
+        _check_square(lg_array, stacked=True)
+        return _batched_solve(lg_array, None, False, stacklevel + 1)
+    _check_square(lg_array)
+    dtype = _solve_dtype(lg_array)
+    n = lg_array.shape[0]
+    identity = _eye(n, dtype=dtype, stacklevel=stacklevel + 1)
+    return solve(lg_array, identity, stacklevel=stacklevel + 1)
+
+
+class _MatmulBuffers(object):
+    """
+    The products of a chain of matrix multiplications go into a few arrays
+    that are allocated once and handed out again as soon as nothing refers
+    to them, so every product of the chain writes into a store whose
+    partitions the previous products already made. Products never write
+    into one of their own operands.
+    """
+
+    def __init__(self, shape, dtype, inputs, stacklevel):
+        self.shape = shape
+        self.dtype = dtype
+        self.inputs = inputs
+        self.stacklevel = stacklevel
+        self.free = []
+
+    def multiply(self, lhs, rhs):
+        if self.free:
+            out = self.free.pop()
+        else:
+            out = ndarray(
+                shape=self.shape,
+                dtype=self.dtype,
+                stacklevel=self.stacklevel + 1,
+                inputs=self.inputs,
             )
-            ret **= 1 / ord
-            return ret
+        # The stacked case goes through the batched matmul, and the rest
+        # through dot, which switches to SUMMA on large matrices
+        if lhs.ndim > 2:
+            _matmul(lhs, rhs, out=out)
         else:
-            raise ValueError("Invalid 'ord' argument passed to norm")
+            lhs.dot(rhs, out=out, stacklevel=self.stacklevel + 1)
+        return out
+
+    def release(self, array, *live):
+        if array is not None and all(array is not other for other in live):
+            self.free.append(array)
+
+    # Squares array times times, releasing array unless it is kept
+    def square(self, array, times, keep=()):
+        for _ in range(times):
+            result = self.multiply(array, array)
+            self.release(array, *keep)
+            array = result
+        return array
+
+
+def matrix_power(a, n, stacklevel=1):
+    lg_a = ndarray.convert_to_cunumeric_ndarray(a)
+    _check_square(lg_a, stacked=True)
+    try:
+        n = operator.index(n)
+    except TypeError:
+        raise TypeError("exponent must be an integer")
+
+    if n < 0:
+        lg_a = inv(lg_a, stacklevel=stacklevel + 1)
+        n = -n
+    if n == 0:
+        result = ndarray(
+            shape=lg_a.shape,
+            dtype=lg_a.dtype,
+            stacklevel=stacklevel + 1,
+            inputs=(lg_a,),
+        )
+        result[...] = _eye(lg_a.shape[-1], dtype=lg_a.dtype)
+        return result
+    if n == 1 or lg_a.size == 0:
+        return lg_a.copy()
+
+    # Binary exponentiation, where the squares of the base and the partial
+    # products take turns in the same few buffers
+    buffers = _MatmulBuffers(lg_a.shape, lg_a.dtype, (lg_a,), stacklevel + 1)
+    base = lg_a
+    result = None
+    while True:
+        if n & 1:
+            if result is None:
+                result = base
+            else:
+                product = buffers.multiply(result, base)
+                buffers.release(result, lg_a, base)
+                result = product
+        n >>= 1
+        if n == 0:
+            break
+        square = buffers.multiply(base, base)
+        buffers.release(base, lg_a, result)
+        base = square
+    return result.copy() if result is lg_a else result
+
+
+# The largest 1-norms of the scaled matrix for which the Pade approximants
+# of degree 3, 5, 7, 9 and 13 are accurate to double precision, and the
+# coefficients of the approximants, from Higham, "The scaling and squaring
+# method for the matrix exponential revisited" (2005)
+_EXPM_THETAS = (
+    (3, 1.495585217958292e-2),
+    (5, 2.539398330063230e-1),
+    (7, 9.504178996162932e-1),
+    (9, 2.097847961257068e0),
+    (13, 5.371920351148152e0),
+)
+_EXPM_COEFFICIENTS = {
+    3: (120.0, 60.0, 12.0, 1.0),
+    5: (30240.0, 15120.0, 3360.0, 420.0, 30.0, 1.0),
+    7: (
+        17297280.0,
+        8648640.0,
+        1995840.0,
+        277200.0,
+        25200.0,
+        1512.0,
+        56.0,
+        1.0,
+    ),
+    9: (
+        17643225600.0,
+        8821612800.0,
+        2075673600.0,
+        302702400.0,
+        30270240.0,
+        2162160.0,
+        110880.0,
+        3960.0,
+        90.0,
+        1.0,
+    ),
+    13: (
+        64764752532480000.0,
+        32382376266240000.0,
+        7771770303897600.0,
+        1187353796428800.0,
+        129060195264000.0,
+        10559470521600.0,
+        670442572800.0,
+        33522128640.0,
+        1323241920.0,
+        40840800.0,
+        960960.0,
+        16380.0,
+        182.0,
+        1.0,
+    ),
+}
+
+
+def expm(a, stacklevel=1):
+    """
+    Matrix exponential, computed with a Pade approximant of the matrix
+    scaled down by a power of two, which is then squared back up. This
+    function is a cuNumeric extension.
+
+    The degree of the approximant and the number of squarings are chosen
+    from the 1-norm of ``a`` as in ``scipy.linalg.expm``, which takes the
+    norm back to the host once. The powers of the matrix and the squarings
+    reuse the same few buffers.
+
+    Parameters
+    ----------
+    a : array_like
+        Square matrix of shape ``(M, M)``.
+
+    Returns
+    -------
+    out : ndarray
+        The exponential of ``a``.
+    """
+    lg_a = ndarray.convert_to_cunumeric_ndarray(a)
+    _check_square(lg_a)
+    dtype = _solve_dtype(lg_a)
+    if lg_a.dtype != dtype:
+        lg_a = lg_a.astype(dtype)
+    n = lg_a.shape[0]
+    if n == 0:
+        return lg_a.copy()
+
+    norm = float(abs(lg_a).sum(axis=0).max())
+    squarings = 0
+    for degree, theta in _EXPM_THETAS:
+        if norm <= theta:
+            break
+    else:
+        squarings = max(0, int(np.ceil(np.log2(norm / theta))))
+        lg_a = lg_a * (0.5**squarings)
+    b = _EXPM_COEFFICIENTS[degree]
+
+    buffers = _MatmulBuffers(lg_a.shape, dtype, (lg_a,), stacklevel + 1)
+    identity = _eye(n, dtype=dtype)
+    a2 = buffers.multiply(lg_a, lg_a)
+    if degree == 13:
+        a4 = buffers.multiply(a2, a2)
+        a6 = buffers.multiply(a4, a2)
+        u = buffers.multiply(a6, b[13] * a6 + b[11] * a4 + b[9] * a2)
+        u += b[7] * a6 + b[5] * a4 + b[3] * a2 + b[1] * identity
+        v = buffers.multiply(a6, b[12] * a6 + b[10] * a4 + b[8] * a2)
+        v += b[6] * a6 + b[4] * a4 + b[2] * a2 + b[0] * identity
+    else:
+        # The even powers of the matrix up to the degree of the approximant
+        powers = [identity, a2]
+        while 2 * len(powers) <= degree:
+            powers.append(buffers.multiply(powers[-1], a2))
+        u = b[1] * identity
+        v = b[0] * identity
+        for (j, power) in enumerate(powers[1:], start=1):
+            u += b[2 * j + 1] * power
+            v += b[2 * j] * power
+    u = buffers.multiply(lg_a, u)
+
+    result = solve(v - u, v + u, stacklevel=stacklevel + 1)
+    return buffers.square(result, squarings)
+
+
+def _qr_dtype(a):
+    dtype = _solve_dtype(a)
+    if dtype.kind == "c":
+        raise NotImplementedError(
+            "cuNumeric needs to support complex QR and SVD"
+        )
+    return dtype
+
+
+def _check_tall(a, name):
+    if a.ndim != 2:
+        raise NotImplementedError(
+            f"cuNumeric only supports the {name} of two-dimensional arrays"
+        )
+
+
+def qr(a, mode="reduced", stacklevel=1):
+    """
+    Compute the qr factorization of a matrix.
+
+    Factor the matrix ``a`` as ``qr``, where ``q`` is orthonormal and ``r``
+    is upper-triangular. The matrix is split into row blocks that are
+    factored independently, and their R factors are combined in a
+    reduction tree (TSQR), which suits matrices with many more rows than
+    columns.
+
+    Parameters
+    ----------
+    a : array_like
+        Matrix of shape ``(M, N)`` to be factored, with ``M >= N``.
+    mode : {'reduced', 'r'}, optional
+        Return both factors with shapes ``(M, N)`` and ``(N, N)``, or only
+        ``r``. The 'complete' mode is only supported for square matrices,
+        where it is the same as 'reduced'.
+
+    Returns
+    -------
+    q : ndarray
+        Matrix with orthonormal columns. Not returned for mode 'r'.
+    r : ndarray
+        Upper-triangular matrix. Its rows may differ in sign from the ones
+        NumPy computes.
+    """
+    lg_array = ndarray.convert_to_cunumeric_ndarray(a)
+    _check_tall(lg_array, "QR decomposition")
+    m, n = lg_array.shape
+    if mode not in ("reduced", "complete", "r", "raw"):
+        raise ValueError(f"Unrecognized mode '{mode}'")
+    if mode == "raw" or (mode == "complete" and m != n):
+        raise NotImplementedError(
+            f"cuNumeric needs to support the '{mode}' mode of qr"
+        )
+    if m < n:
+        raise NotImplementedError(
+            "cuNumeric needs to support the QR decomposition of matrices "
+            "with more columns than rows"
+        )
+
+    dtype = _qr_dtype(lg_array)
+    if lg_array.dtype != dtype:
+        lg_array = lg_array.astype(dtype)
+
+    r = ndarray(
+        shape=(n, n),
+        dtype=dtype,
+        stacklevel=stacklevel + 1,
+        inputs=(lg_array,),
+    )
+    q = None
+    if mode != "r":
+        q = ndarray(
+            shape=(m, n),
+            dtype=dtype,
+            stacklevel=stacklevel + 1,
+            inputs=(lg_array,),
+        )
+    if lg_array.size > 0:
+        r._thunk.qr(
+            lg_array._thunk,
+            q=None if q is None else q._thunk,
+            stacklevel=(stacklevel + 1),
+        )
+    return r if q is None else (q, r)
+
+
+def svd(
+    a, full_matrices=True, compute_uv=True, hermitian=False, stacklevel=1
+):
+    """
+    Singular Value Decomposition.
+
+    The matrix is first factored by the distributed QR decomposition of
+    ``qr``, and the small ``R`` factor is then decomposed by a single task.
+    This suits matrices with many more rows than columns, or the other way
+    around.
+
+    Parameters
+    ----------
+    a : array_like
+        Matrix of shape ``(M, N)``.
+    full_matrices : bool, optional
+        Only the reduced decomposition is supported for non-square
+        matrices, so this must be False unless ``M == N``.
+    compute_uv : bool, optional
+        Whether or not to compute ``u`` and ``vh`` in addition to ``s``.
+    hermitian : bool, optional
+        Ignored.
+
+    Returns
+    -------
+    u : ndarray
+        Left singular vectors, of shape ``(M, K)`` with ``K = min(M, N)``.
+        Only returned when ``compute_uv`` is True.
+    s : ndarray
+        Singular values in descending order, of shape ``(K,)``.
+    vh : ndarray
+        Conjugate transposed right singular vectors, of shape ``(K, N)``.
+        Only returned when ``compute_uv`` is True.
+    """
+    lg_array = ndarray.convert_to_cunumeric_ndarray(a)
+    _check_tall(lg_array, "SVD")
+    m, n = lg_array.shape
+    if compute_uv and full_matrices and m != n:
+        raise NotImplementedError(
+            "cuNumeric needs to support full_matrices=True for non-square "
+            "matrices"
+        )
+
+    # The SVD of a wide matrix comes from the SVD of its transpose
+    if m < n:
+        result = svd(
+            lg_array.T,
+            full_matrices=full_matrices,
+            compute_uv=compute_uv,
+            stacklevel=stacklevel + 1,
+        )
+        if not compute_uv:
+            return result
+        u, s, vh = result
+        return vh.T, s, u.T
+
+    dtype = _qr_dtype(lg_array)
+    if lg_array.dtype != dtype:
+        lg_array = lg_array.astype(dtype)
+
+    def create(shape):
+        return ndarray(
+            shape=shape,
+            dtype=dtype,
+            stacklevel=stacklevel + 2,
+            inputs=(lg_array,),
+        )
+
+    s = create((n,))
+    u = create((m, n)) if compute_uv else None
+    vh = create((n, n)) if compute_uv else None
+    if lg_array.size > 0:
+        s._thunk.svd(
+            lg_array._thunk,
+            u=None if u is None else u._thunk,
+            vh=None if vh is None else vh._thunk,
+            stacklevel=(stacklevel + 1),
+        )
+    return (u, s, vh) if compute_uv else s
+
+
+# Vector norms that are computed by a single reduction over the magnitudes
+# of the elements. The 2-norm folds scaled sums of squares, which cannot
+# overflow, but only exists in single and double precision.
+_NORM_REDUCTIONS = {
+    None: UnaryRedCode.NORM2,
+    2: UnaryRedCode.NORM2,
+    1: UnaryRedCode.NORM1,
+    np.inf: UnaryRedCode.NORMINF,
+    -np.inf: UnaryRedCode.NORMNEGINF,
+}
+
+
+def _norm_reduction(x, ord):
+    if isinstance(ord, str) or ord not in _NORM_REDUCTIONS:
+        return None
+    op = _NORM_REDUCTIONS[ord]
+    if op == UnaryRedCode.NORM2:
+        supported = (np.float32, np.float64)
     else:
+        supported = (np.float16, np.float32, np.float64)
+    return op if x.dtype in supported else None
+
+
+def _vector_norm(x, ord, axis, keepdims, stacklevel):
+    op = _norm_reduction(x, ord)
+    if op is not None:
+        return ndarray.perform_unary_reduction(
+            op, x, axis=axis, keepdims=keepdims, stacklevel=(stacklevel + 1)
+        )
+    # Handle the weird norm cases
+    if ord == np.inf:
+        return abs(x).max(
+            axis=axis, keepdims=keepdims, stacklevel=(stacklevel + 1)
+        )
+    elif ord == -np.inf:
+        return abs(x).min(
+            axis=axis, keepdims=keepdims, stacklevel=(stacklevel + 1)
+        )
+    elif ord == 0:
+        # Check for where things are not zero and convert to integer
+        # for sum
+        temp = (x != 0).astype(np.int64)
+        return temp.sum(
+            axis=axis, keepdims=keepdims, stacklevel=(stacklevel + 1)
+        )
+    elif ord == 1:
+        return abs(x).sum(
+            axis=axis, keepdims=keepdims, stacklevel=stacklevel + 1
+        )
+    elif ord is None or ord == 2:
+        s = (x.conj() * x).real
+        return _sqrt(
+            s.sum(axis=axis, keepdims=keepdims, stacklevel=stacklevel + 1)
+        )
+    elif isinstance(ord, str):
+        raise ValueError(f"Invalid norm order '{ord}' for vectors")
+    elif type(ord) == int:
+        absx = abs(x)
+        absx **= ord
+        ret = absx.sum(
+            axis=axis, keepdims=keepdims, stacklevel=(stacklevel + 1)
+        )
+        ret **= 1 / ord
+        return ret
+    else:
+        raise ValueError("Invalid 'ord' argument passed to norm")
+
+
+def _matrix_norm(x, ord, axis, keepdims, stacklevel):
+    row_axis, col_axis = (ax + x.ndim if ax < 0 else ax for ax in axis)
+    if not (0 <= row_axis < x.ndim and 0 <= col_axis < x.ndim):
+        raise ValueError("Illegal 'axis' value")
+    if row_axis == col_axis:
+        raise ValueError("Duplicate axes given.")
+    if ord in (None, "f", "fro"):
+        ret = _vector_norm(
+            x, None, (row_axis, col_axis), False, stacklevel + 1
+        )
+    elif ord in (1, -1, np.inf, -np.inf):
+        # The largest or smallest 1-norm of the columns, or of the rows
+        if ord in (1, -1):
+            sum_axis, ext_axis = row_axis, col_axis
+        else:
+            sum_axis, ext_axis = col_axis, row_axis
+        if ext_axis > sum_axis:
+            ext_axis -= 1
+        sums = _vector_norm(x, 1, sum_axis, False, stacklevel + 1)
+        if ord > 0:
+            ret = sums.max(axis=ext_axis, stacklevel=(stacklevel + 1))
+        else:
+            ret = sums.min(axis=ext_axis, stacklevel=(stacklevel + 1))
+    elif ord in (2, -2, "nuc"):
         raise NotImplementedError(
-            "cuNumeric needs support for other kinds of norms"
+            "cuNumeric needs support for singular value based norms"
         )
+    else:
+        raise ValueError("Invalid norm order for matrices.")
+    if keepdims:
+        shape = list(x.shape)
+        shape[row_axis] = 1
+        shape[col_axis] = 1
+        ret = ret.reshape(tuple(shape))
+    return ret
+
+
+def norm(x, ord=None, axis=None, keepdims=False, stacklevel=1):
+    lg_array = ndarray.convert_to_cunumeric_ndarray(x)
+    # Like NumPy, compute the norms of integer arrays in double precision
+    if lg_array.dtype.kind in ("b", "i", "u"):
+        lg_array = lg_array.astype(np.float64)
+    if axis is None:
+        ndim = lg_array.ndim
+        if ord is None or (ord in ("f", "fro") and ndim == 2):
+            # The Frobenius norm is the 2-norm of the flattened array
+            ret = _vector_norm(lg_array, None, None, False, stacklevel + 1)
+            if keepdims:
+                ret = ret.reshape((1,) * ndim)
+            return ret
+        axis = tuple(range(ndim))
+    elif type(axis) == int:
+        axis = (axis,)
+    if len(axis) == 1:
+        return _vector_norm(lg_array, ord, axis[0], keepdims, stacklevel + 1)
+    elif len(axis) == 2:
+        return _matrix_norm(lg_array, ord, axis, keepdims, stacklevel + 1)
+    else:
+        raise ValueError("Improper number of dimensions to norm.")
+
+
+def cdist(xa, xb, metric="euclidean", stacklevel=1):
+    """
+    Compute the distance between each pair of rows of two matrices.
+
+    The squared distances are expanded into ``|a|^2 + |b|^2 - 2 a.b``, so
+    the cross terms of all the pairs come out of a single matrix product,
+    with the squared norms of the rows of ``xb`` added in its epilogue. The
+    differences of the rows, which would take ``M * K * N`` elements, are
+    never formed.
+
+    Parameters
+    ----------
+    xa : array_like
+        Matrix of shape ``(M, N)``.
+    xb : array_like
+        Matrix of shape ``(K, N)``.
+    metric : {"euclidean", "sqeuclidean"}, optional
+        Whether to compute the Euclidean distances or their squares.
+
+    Returns
+    -------
+    out : ndarray
+        Matrix of shape ``(M, K)`` that holds the distance between
+        ``xa[i]`` and ``xb[j]`` at ``(i, j)``.
+
+    Notes
+    -----
+    This function is a cuNumeric extension, modeled after
+    ``scipy.spatial.distance.cdist``. The expansion loses precision for the
+    pairs whose distance is much smaller than the norms of their rows, and
+    the squared distances that rounding makes negative are clamped to zero.
+    """
+    if metric not in ("euclidean", "sqeuclidean"):
+        raise ValueError(f"Unsupported distance metric '{metric}'")
+    lg_a = ndarray.convert_to_cunumeric_ndarray(xa)
+    lg_b = ndarray.convert_to_cunumeric_ndarray(xb)
+    if lg_a.ndim != 2 or lg_b.ndim != 2:
+        raise ValueError("xa and xb must be two-dimensional")
+    if lg_a.shape[1] != lg_b.shape[1]:
+        raise ValueError("xa and xb must have the same number of columns")
+
+    dtype = _solve_dtype(lg_a, lg_b)
+    if dtype.kind == "c":
+        raise TypeError("cdist does not support complex arrays")
+    if lg_a.dtype != dtype:
+        lg_a = lg_a.astype(dtype)
+    if lg_b.dtype != dtype:
+        lg_b = lg_b.astype(dtype)
+
+    a_squares = ndarray.perform_unary_reduction(
+        UnaryRedCode.SUM_SQUARES, lg_a, axis=1, stacklevel=(stacklevel + 1)
+    )
+    b_squares = ndarray.perform_unary_reduction(
+        UnaryRedCode.SUM_SQUARES, lg_b, axis=1, stacklevel=(stacklevel + 1)
+    )
+    out = _fused_matmul(lg_a, lg_b.T, bias=b_squares, scale=-2.0)
+    _add(
+        out,
+        a_squares.reshape((lg_a.shape[0], 1)),
+        out=out,
+        stacklevel=(stacklevel + 1),
+    )
+    _maximum(out, 0, out=out, stacklevel=(stacklevel + 1))
+    if metric == "euclidean":
+        _sqrt(out, out=out, stacklevel=(stacklevel + 1))
+    return out
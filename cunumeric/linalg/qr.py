@@ -0,0 +1,201 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+
+from cunumeric.config import CuNumericOpCode, UnaryOpCode
+
+from legate.core import Rect, types as ty
+
+# Number of R factors that are stacked and factored together at every level
+# of the reduction tree
+TSQR_RADIX = 8
+
+
+def choose_row_tiling(num_procs, m, n):
+    # Every row block must be at least as tall as it is wide, including the
+    # last one, for it to have an explicit Q of the same shape
+    num_tiles = max(1, min(num_procs, m // n))
+    while True:
+        tile = (m + num_tiles - 1) // num_tiles
+        count = (m + tile - 1) // tile
+        if num_tiles == 1 or m - (count - 1) * tile >= n:
+            return tile, count
+        num_tiles -= 1
+
+
+def geqrf(context, p_array, p_r, count):
+    task = context.create_task(
+        CuNumericOpCode.GEQRF,
+        manual=True,
+        launch_domain=Rect(hi=(count, 1)),
+    )
+    task.add_output(p_array)
+    task.add_output(p_r)
+    task.add_input(p_array)
+    task.execute()
+
+
+def multiply_blocks(context, p_lhs, p_rhs1, p_rhs2, count):
+    # Each row block of the left operand is multiplied by its own n x n
+    # block of the right operand, as with a block diagonal matrix
+    task = context.create_task(
+        CuNumericOpCode.BATCHED_MATMUL,
+        manual=True,
+        launch_domain=Rect(hi=(count, 1)),
+    )
+    task.add_output(p_lhs)
+    task.add_input(p_rhs1)
+    task.add_input(p_rhs2)
+    task.add_scalar_arg(1.0, ty.float64)
+    task.add_scalar_arg(UnaryOpCode.COPY, ty.int32)
+    task.execute()
+
+
+def tsqr(r, work, stacklevel=0, callsite=None):
+    """
+    Tall-skinny QR decomposition (TSQR). Every point of the first level
+    factors its own row block of the matrix with GEQRF. The n x n R factors
+    of the blocks are stacked, and the stack is factored again in groups of
+    TSQR_RADIX blocks, level by level, until a single R factor is left.
+
+    GEQRF leaves the Q factor of every block in place of the block, so the
+    matrix is overwritten. The levels of the tree are returned for form_q,
+    together with the Q factor at the top of the tree.
+    """
+    runtime = r.runtime
+    context = r.context
+    m, n = work.shape
+
+    tile, count = choose_row_tiling(runtime.num_procs, m, n)
+    levels = []
+    while count > 1:
+        stack = runtime.create_empty_thunk(
+            (count * n, n), work.dtype, inputs=[work]
+        )
+        p_work = work.base.partition_by_tiling((tile, n))
+        p_stack = stack.base.partition_by_tiling((n, n))
+        geqrf(context, p_work, p_stack, count)
+        levels.append((work, tile, count))
+
+        work = stack
+        count = (count + TSQR_RADIX - 1) // TSQR_RADIX
+        tile = TSQR_RADIX * n if count > 1 else work.shape[0]
+
+    p_work = work.base.partition_by_tiling(work.shape)
+    geqrf(context, p_work, r.base.partition_by_tiling((n, n)), 1)
+    return levels, work
+
+
+def form_q(q, levels, top, right=None, stacklevel=0, callsite=None):
+    """
+    Forms the Q factor of a TSQR top-down, multiplying the Q factor of
+    every block by its own block of the Q factor of the level above. When a
+    matrix on the right is given, the product of Q and that matrix is
+    formed instead, at no extra cost.
+    """
+    runtime = q.runtime
+    context = q.context
+    n = q.shape[1]
+
+    result = top
+    if right is not None:
+        lhs = q
+        if len(levels) > 0:
+            lhs = runtime.create_empty_thunk(top.shape, q.dtype, inputs=[top])
+        multiply_blocks(
+            context,
+            lhs.base.partition_by_tiling(top.shape),
+            top.base.partition_by_tiling(top.shape),
+            right.base.partition_by_tiling((n, n)),
+            1,
+        )
+        result = lhs
+
+    for level, (work, tile, count) in reversed(list(enumerate(levels))):
+        lhs = q
+        if level > 0:
+            lhs = runtime.create_empty_thunk(
+                work.shape, q.dtype, inputs=[work]
+            )
+        multiply_blocks(
+            context,
+            lhs.base.partition_by_tiling((tile, n)),
+            work.base.partition_by_tiling((tile, n)),
+            result.base.partition_by_tiling((n, n)),
+            count,
+        )
+        result = lhs
+
+    if result is not q:
+        q.copy(result, stacklevel=stacklevel + 1, callsite=callsite)
+
+
+def gesvd(context, a, u, s, vt):
+    task = context.create_task(
+        CuNumericOpCode.GESVD, manual=True, launch_domain=Rect(hi=(1,))
+    )
+    task.add_output(u.base)
+    task.add_output(s.base)
+    task.add_output(vt.base)
+    task.add_input(a.base)
+    task.execute()
+
+
+def qr(r, a, q=None, stacklevel=0, callsite=None):
+    runtime = r.runtime
+    m, n = a.shape
+
+    # A matrix factored by a single task can have its Q formed in place
+    _, count = choose_row_tiling(runtime.num_procs, m, n)
+    if q is not None and count == 1:
+        work = q
+    else:
+        work = runtime.create_empty_thunk(a.shape, a.dtype, inputs=[a])
+    work.copy(a, stacklevel=stacklevel + 1, callsite=callsite)
+
+    levels, top = tsqr(r, work, stacklevel=stacklevel + 1, callsite=callsite)
+    if q is not None:
+        form_q(q, levels, top, stacklevel=stacklevel + 1, callsite=callsite)
+
+
+def svd(s, a, u=None, vh=None, stacklevel=0, callsite=None):
+    """
+    Reduced SVD of a tall-skinny matrix through its QR decomposition. The
+    R factor is small enough to be decomposed by a single GESVD task, as
+    R = U_R S V^T, and the left singular vectors are then Q U_R.
+    """
+    runtime = s.runtime
+    n = a.shape[1]
+
+    work = runtime.create_empty_thunk(a.shape, a.dtype, inputs=[a])
+    work.copy(a, stacklevel=stacklevel + 1, callsite=callsite)
+    r = runtime.create_empty_thunk((n, n), a.dtype, inputs=[a])
+    levels, top = tsqr(r, work, stacklevel=stacklevel + 1, callsite=callsite)
+
+    u_r = runtime.create_empty_thunk((n, n), a.dtype, inputs=[r])
+    if vh is None:
+        vh = runtime.create_empty_thunk((n, n), a.dtype, inputs=[r])
+    gesvd(s.context, r, u_r, s, vh)
+
+    if u is not None:
+        form_q(
+            u,
+            levels,
+            top,
+            right=u_r,
+            stacklevel=stacklevel + 1,
+            callsite=callsite,
+        )
@@ -0,0 +1,180 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+
+from cunumeric.config import CuNumericOpCode
+
+from legate.core import Rect, types as ty
+
+from .cholesky import choose_color_shape, transpose_copy
+
+
+def getrf(context, panel, pivots, offset):
+    task = context.create_task(
+        CuNumericOpCode.GETRF, manual=True, launch_domain=Rect(hi=(1,))
+    )
+    task.add_output(panel)
+    task.add_output(pivots)
+    task.add_input(panel)
+    task.add_scalar_arg(offset, ty.int32)
+    task.execute()
+
+
+def laswp(context, p_slab, pivots, offset, lo, hi):
+    if lo >= hi:
+        return
+
+    launch_domain = Rect(lo=(0, lo), hi=(1, hi))
+    task = context.create_task(
+        CuNumericOpCode.LASWP, manual=True, launch_domain=launch_domain
+    )
+    task.add_output(p_slab)
+    task.add_input(p_slab)
+    task.add_input(pivots)
+    task.add_scalar_arg(offset, ty.int32)
+    task.execute()
+
+
+def trsm(context, p_output, i, lo, hi):
+    if lo >= hi:
+        return
+
+    rhs = p_output.get_child_store(i, i)
+    lhs = p_output
+
+    launch_domain = Rect(lo=(i, lo), hi=(i + 1, hi))
+    task = context.create_task(
+        CuNumericOpCode.TRSM, manual=True, launch_domain=launch_domain
+    )
+    task.add_output(lhs)
+    task.add_input(rhs)
+    task.add_input(lhs)
+    # Solve against the unit lower triangular diagonal tile from the left:
+    # left, lower, transpose, unit_diagonal and row_major, as the LU
+    # factorization works on Fortran order tiles. The row panel feeds the
+    # whole trailing update, so the solve is on the critical path
+    task.add_scalar_arg(True, ty.bool_)
+    task.add_scalar_arg(True, ty.bool_)
+    task.add_scalar_arg(False, ty.bool_)
+    task.add_scalar_arg(True, ty.bool_)
+    task.add_scalar_arg(False, ty.bool_)
+    task.add_scalar_arg(True, ty.bool_)
+    task.execute()
+
+
+def gemm(context, p_output, i, lo, hi, col_lo, col_hi, critical):
+    if lo >= hi or col_lo >= col_hi:
+        return
+
+    lhs = p_output
+
+    launch_domain = Rect(lo=(lo, col_lo), hi=(hi, col_hi))
+    task = context.create_task(
+        CuNumericOpCode.GEMM, manual=True, launch_domain=launch_domain
+    )
+    task.add_output(lhs)
+    task.add_input(p_output, proj=lambda p: (p[0], i))
+    task.add_input(p_output, proj=lambda p: (i, p[1]))
+    task.add_input(lhs)
+    # Neither tile is transposed and both are in Fortran order
+    task.add_scalar_arg(False, ty.bool_)
+    task.add_scalar_arg(False, ty.bool_)
+    task.add_scalar_arg(False, ty.bool_)
+    task.add_scalar_arg(critical, ty.bool_)
+    task.execute()
+
+
+def getrs(context, p_output, lu, pivots, launch_domain):
+    task = context.create_task(
+        CuNumericOpCode.GETRS, manual=True, launch_domain=launch_domain
+    )
+    task.add_output(p_output)
+    task.add_input(lu)
+    task.add_input(pivots)
+    task.add_input(p_output)
+    task.execute()
+
+
+def lu_factor(lu, pivots, input, stacklevel=0, callsite=None):
+    """
+    Right-looking blocked LU decomposition with partial pivoting. The
+    column panel of each step, from the diagonal tile down, is factored by
+    a single GETRF, which picks the pivots among all rows of the panel. The
+    row interchanges are then applied to the other column blocks, and the
+    trailing matrix is updated with the TRSM and GEMM tasks of the Cholesky
+    decomposition.
+    """
+    shape = lu.base.shape
+    color_shape = choose_color_shape(lu.runtime, shape)
+    tile_shape = (shape + color_shape - 1) // color_shape
+    color_shape = (shape + tile_shape - 1) // tile_shape
+    n = color_shape[0]
+    extent = shape[0]
+    tile = tile_shape[0]
+
+    context = lu.context
+    p_input = input.base.partition_by_tiling(tile_shape)
+    p_lu = lu.base.partition_by_tiling(tile_shape)
+    transpose_copy(context, Rect(hi=color_shape), p_input, p_lu)
+
+    for i in range(n):
+        lo = i * tile
+        hi = min(lo + tile, extent)
+        # Sliced stores are indexed from the row where they start, so the
+        # tasks take that row to relate the pivots to the whole matrix
+        slab = lu.base.slice(0, slice(lo, extent))
+        panel = slab.slice(1, slice(lo, hi))
+        panel_pivots = pivots.base.slice(0, slice(lo, hi))
+        getrf(context, panel, panel_pivots, lo)
+
+        p_slab = slab.partition_by_tiling((extent - lo, tile))
+        laswp(context, p_slab, panel_pivots, lo, 0, i)
+        laswp(context, p_slab, panel_pivots, lo, i + 1, n)
+
+        trsm(context, p_lu, i, i + 1, n)
+        # Only the update of the next column panel is on the critical
+        # path, the rest of the trailing matrix fills the gaps around it
+        gemm(context, p_lu, i, i + 1, n, i + 1, i + 2, True)
+        gemm(context, p_lu, i, i + 1, n, i + 2, n, False)
+
+
+def solve(output, a, b, stacklevel=0, callsite=None):
+    runtime = output.runtime
+    lu = runtime.create_empty_thunk(a.shape, a.dtype, inputs=[a])
+    pivots = runtime.create_empty_thunk(
+        (a.shape[0],), np.dtype(np.int32), inputs=[a]
+    )
+    lu_factor(lu, pivots, a, stacklevel=stacklevel + 1, callsite=callsite)
+
+    output.copy(b, stacklevel=stacklevel + 1, callsite=callsite)
+    store = output.base
+    if output.ndim == 1:
+        store = store.promote(1, 1)
+
+    # Every point solves for its own block of columns of the right-hand
+    # side against the whole factorization
+    num_cols = store.shape[1]
+    num_blocks = min(runtime.num_procs, num_cols)
+    block = (num_cols + num_blocks - 1) // num_blocks
+    num_blocks = (num_cols + block - 1) // block
+    p_output = store.partition_by_tiling((store.shape[0], block))
+    getrs(
+        output.context,
+        p_output,
+        lu.base,
+        pivots.base,
+        Rect(hi=(1, num_blocks)),
+    )
@@ -0,0 +1,94 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+from cunumeric.config import CuNumericOpCode
+
+from legate.core import ReductionOp, Rect
+
+# SUMMA only pays off once the k dimension of the default decomposition
+# would be split across many processors, and on matrices large enough that
+# every processor owns a sizable tile of the product
+SUMMA_MIN_PROCS = 16
+SUMMA_MIN_EXTENT = 4096
+
+
+def use_summa(runtime, m, n, k):
+    if runtime.num_procs < 2:
+        return False
+    if runtime.test_mode:
+        return True
+    return (
+        runtime.num_procs >= SUMMA_MIN_PROCS
+        and min(m, n, k) >= SUMMA_MIN_EXTENT
+    )
+
+
+def choose_summa_grid(num_procs, m, n):
+    # Pick the factorization of the processors into a grid whose aspect
+    # ratio is closest to that of the product, so that the tiles are about
+    # square and the panels sent along the rows and columns are balanced
+    best = None
+    for rows in range(1, num_procs + 1):
+        if num_procs % rows != 0:
+            continue
+        cols = num_procs // rows
+        mismatch = abs(rows * n - cols * m)
+        if best is None or mismatch < best[0]:
+            best = (mismatch, rows, cols)
+    return best[1], best[2]
+
+
+def summa(context, num_procs, lhs, rhs1, rhs2):
+    """
+    Scalable universal matrix multiply (SUMMA). The product is split over a
+    grid of processors, and every processor accumulates its own tile of it.
+    At every step, the panels of the next block of the inner dimension are
+    sent to the processors of their grid row and column, so the partial
+    products never leave the processor that owns the tile, unlike with the
+    3-D decomposition that reduces them across the inner dimension.
+
+    The stores are the product and its operands promoted to the 3-D (m, k,
+    n) iteration space of MATMUL, which every step launches on a 2-D slice
+    of it.
+    """
+    m, k, n = lhs.shape
+    rows, cols = choose_summa_grid(num_procs, m, n)
+    steps = max(rows, cols)
+
+    tile = (
+        (m + rows - 1) // rows,
+        (k + steps - 1) // steps,
+        (n + cols - 1) // cols,
+    )
+    steps = (k + tile[1] - 1) // tile[1]
+    p_lhs = lhs.partition_by_tiling(tile)
+    p_rhs1 = rhs1.partition_by_tiling(tile)
+    p_rhs2 = rhs2.partition_by_tiling(tile)
+    launch_domain = Rect(
+        hi=((m + tile[0] - 1) // tile[0], 1, (n + tile[2] - 1) // tile[2])
+    )
+
+    for step in range(steps):
+
+        def proj(p, step=step):
+            return (p[0], step, p[2])
+
+        task = context.create_task(
+            CuNumericOpCode.MATMUL, manual=True, launch_domain=launch_domain
+        )
+        task.add_reduction(p_lhs, ReductionOp.ADD, proj=proj)
+        task.add_input(p_rhs1, proj=proj)
+        task.add_input(p_rhs2, proj=proj)
+        task.execute()
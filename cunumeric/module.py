@@ -14,19 +14,28 @@
 #
 
 import math
+import os
 import re
 import sys
 from inspect import signature
-from itertools import chain
+from itertools import chain, product
 from typing import Optional, Set
 
 import numpy as np
 import opt_einsum as oe
 
 from .array import ndarray
-from .config import BinaryOpCode, UnaryOpCode, UnaryRedCode
+from .config import (
+    BinaryOpCode,
+    PadMode,
+    RollingOpCode,
+    UnaryOpCode,
+    UnaryRedCode,
+)
 from .doc_utils import copy_docstring
+from .quantized import quantized_array
 from .runtime import runtime
+from .sparse import csr_matrix
 
 try:
     xrange  # Python 2
@@ -110,16 +119,19 @@ def add_boilerplate(*array_params: str):
 
             # Handle the case where all array-like parameters are scalar, by
             # performing the operation on the equivalent scalar numpy arrays.
-            # NOTE: This implicitly blocks on the contents of these arrays.
+            # Only scalars whose values are already known here take this path;
+            # scalars still being computed by tasks (e.g. the results of
+            # reductions) go through the deferred path so that nothing blocks
+            # until Python actually asks for the value.
             if (
                 hasattr(np, func.__name__)
                 and all(
-                    arg._thunk.scalar
+                    arg._thunk.scalar and arg._thunk.value_known
                     for (idx, arg) in enumerate(args)
                     if (idx in indices) and isinstance(arg, ndarray)
                 )
                 and all(
-                    v._thunk.scalar
+                    v._thunk.scalar and v._thunk.value_known
                     for (k, v) in kwargs.items()
                     if (k in keys or k == "where") and isinstance(v, ndarray)
                 )
@@ -494,6 +506,43 @@ def flip(m, axis=None):
     return array.flip(axis=axis)
 
 
+@copy_docstring(np.roll)
+def roll(a, shift, axis=None):
+    array = ndarray.convert_to_cunumeric_ndarray(a)
+    if axis is None:
+        return roll(array.ravel(), shift, axis=0).reshape(array.shape)
+    shifts = {}
+    for ax, sh in np.broadcast(axis, shift):
+        ax = int(ax)
+        if ax < -array.ndim or ax >= array.ndim:
+            raise ValueError("Illegal 'axis' value")
+        ax %= array.ndim
+        shifts[ax] = shifts.get(ax, 0) + int(sh)
+    # Every rolled axis splits into the two halves that swap places, so the
+    # result is assembled from one offset copy per combination of halves
+    pieces = []
+    for dim in range(array.ndim):
+        extent = array.shape[dim]
+        sh = shifts.get(dim, 0) % extent if extent > 0 else 0
+        if sh == 0:
+            pieces.append(((slice(None), slice(None)),))
+        else:
+            pieces.append(
+                (
+                    (slice(sh, None), slice(None, extent - sh)),
+                    (slice(None, sh), slice(extent - sh, None)),
+                )
+            )
+    result = ndarray(array.shape, dtype=array.dtype, inputs=(array,))
+    if array.size == 0:
+        return result
+    for combination in product(*pieces):
+        dst = tuple(dst for (dst, _) in combination)
+        src = tuple(src for (_, src) in combination)
+        result[dst] = array[src]
+    return result
+
+
 # Changing kind of array
 
 
@@ -537,6 +586,63 @@ def tile(a, reps):
     return result
 
 
+@copy_docstring(np.repeat)
+def repeat(a, repeats, axis=None):
+    array = ndarray.convert_to_cunumeric_ndarray(a)
+    return array.repeat(repeats, axis=axis, stacklevel=2)
+
+
+# Padding arrays
+
+
+@copy_docstring(np.pad)
+def pad(array, pad_width, mode="constant", **kwargs):
+    array = ndarray.convert_to_cunumeric_ndarray(array)
+    if not isinstance(mode, str) or mode.upper() not in PadMode.__members__:
+        raise NotImplementedError(f"pad does not support the {mode} mode")
+    constant_values = kwargs.pop("constant_values", 0)
+    if mode in ("reflect", "symmetric"):
+        if kwargs.pop("reflect_type", "even") != "even":
+            raise NotImplementedError("pad only supports even reflections")
+    if kwargs:
+        raise ValueError(
+            f"unsupported keyword arguments for mode '{mode}': {set(kwargs)}"
+        )
+    if mode == "constant" and np.ndim(constant_values) != 0:
+        raise NotImplementedError("pad only supports a scalar constant value")
+
+    pad_width = np.broadcast_to(np.asarray(pad_width), (array.ndim, 2))
+    if pad_width.dtype.kind not in "iu":
+        raise TypeError("`pad_width` must be of integral type.")
+    if (pad_width < 0).any():
+        raise ValueError("index can't contain negative values")
+    pad_width = tuple(
+        (int(before), int(after)) for (before, after) in pad_width
+    )
+
+    out_shape = ()
+    for dim, (before, after) in enumerate(pad_width):
+        extent = array.shape[dim]
+        if mode != "constant" and extent == 0 and before + after > 0:
+            raise ValueError(
+                f"can't extend empty axis {dim} using modes other than "
+                "'constant' or 'empty'"
+            )
+        out_shape += (extent + before + after,)
+    if array.ndim == 0:
+        return array.copy()
+
+    result = ndarray(out_shape, dtype=array.dtype, inputs=(array,))
+    result._thunk.pad(
+        array._thunk,
+        pad_width,
+        PadMode[mode.upper()],
+        np.array(constant_values, dtype=array.dtype),
+        stacklevel=2,
+    )
+    return result
+
+
 # Spliting arrays
 @copy_docstring(np.vsplit)
 def vsplit(a, indices):
@@ -676,16 +782,229 @@ def invert(a, out=None, where=True, dtype=None):
 # Matrix and vector products
 @copy_docstring(np.dot)
 def dot(a, b, out=None):
+    if isinstance(a, (csr_matrix, quantized_array)):
+        return a.dot(b, out=out, stacklevel=2)
     a_array = ndarray.convert_to_cunumeric_ndarray(a)
     if out is not None:
         out = ndarray.convert_to_cunumeric_ndarray(out, share=True)
     return a_array.dot(b, out=out, stacklevel=2)
 
 
-# Trivial multi-tensor contraction strategy: contract in input order
-class NullOptimizer(oe.paths.PathOptimizer):
+@copy_docstring(np.matmul)
+def matmul(a, b, out=None):
+    if isinstance(a, (csr_matrix, quantized_array)):
+        return a.dot(b, out=out, stacklevel=2)
+    a_array = ndarray.convert_to_cunumeric_ndarray(a)
+    if out is not None:
+        out = ndarray.convert_to_cunumeric_ndarray(out, share=True)
+    return a_array._matmul(b, out=out, stacklevel=2)
+
+
+@copy_docstring(np.kron)
+def kron(a, b):
+    a_array = ndarray.convert_to_cunumeric_ndarray(a)
+    b_array = ndarray.convert_to_cunumeric_ndarray(b)
+    if a_array.ndim == 0 or b_array.ndim == 0:
+        return multiply(a_array, b_array)
+    dtype = ndarray.find_common_type(a_array, b_array)
+    if a_array.dtype != dtype:
+        a_array = a_array.astype(dtype)
+    if b_array.dtype != dtype:
+        b_array = b_array.astype(dtype)
+    # The operand with fewer dimensions is viewed with leading unit ones
+    ndim = max(a_array.ndim, b_array.ndim)
+    if a_array.ndim < ndim:
+        a_array = a_array.reshape((1,) * (ndim - a_array.ndim) + a_array.shape)
+    if b_array.ndim < ndim:
+        b_array = b_array.reshape((1,) * (ndim - b_array.ndim) + b_array.shape)
+    out_shape = tuple(x * y for (x, y) in zip(a_array.shape, b_array.shape))
+    result = ndarray(out_shape, dtype=dtype, inputs=(a_array, b_array))
+    result._thunk.kron(a_array._thunk, b_array._thunk, stacklevel=2)
+    return result
+
+
+@copy_docstring(np.outer)
+def outer(a, b, out=None):
+    a_array = ndarray.convert_to_cunumeric_ndarray(a).ravel()
+    b_array = ndarray.convert_to_cunumeric_ndarray(b).ravel()
+    # The outer product is the Kronecker product of a column and a row
+    result = kron(
+        a_array.reshape((a_array.size, 1)), b_array.reshape((1, b_array.size))
+    )
+    if out is None:
+        return result
+    out = ndarray.convert_to_cunumeric_ndarray(out, share=True)
+    if out.shape != result.shape:
+        raise ValueError(
+            f"output array has shape {out.shape} "
+            f"but the outer product has shape {result.shape}"
+        )
+    out[...] = result
+    return out
+
+
+def dots(*pairs):
+    """
+    Compute the inner products of several pairs of vectors in one pass.
+
+    A vector that appears in several pairs, like ``r`` in
+    ``dots((r, r), (r, z))``, is read only once per element, and all of the
+    products are computed by a single task instead of one per product.
+
+    Parameters
+    ----------
+    *pairs : tuple of array_like
+        Pairs of one-dimensional arrays of the same length.
+
+    Returns
+    -------
+    out : tuple of ndarray
+        One zero-dimensional array per pair, holding its inner product.
+    """
+    if len(pairs) == 0:
+        raise ValueError("dots needs at least one pair of vectors")
+    arrays = []
+    for pair in pairs:
+        if len(pair) != 2:
+            raise ValueError("dots takes pairs of vectors")
+        a = ndarray.convert_to_cunumeric_ndarray(pair[0])
+        b = ndarray.convert_to_cunumeric_ndarray(pair[1])
+        if a.ndim != 1 or b.ndim != 1:
+            raise ValueError("dots only supports one-dimensional arrays")
+        if a.shape != b.shape:
+            raise ValueError("Dimension mismatch for dot")
+        arrays.append((a, b))
+    return ndarray.perform_multi_dot(arrays, stacklevel=2)
+
+
+# Unary operators that can run as the activation of a fused matmul
+_MATMUL_ACTIVATIONS = {
+    "absolute": UnaryOpCode.ABSOLUTE,
+    "arccos": UnaryOpCode.ARCCOS,
+    "arcsin": UnaryOpCode.ARCSIN,
+    "arctan": UnaryOpCode.ARCTAN,
+    "ceil": UnaryOpCode.CEIL,
+    "cos": UnaryOpCode.COS,
+    "erf": UnaryOpCode.ERF,
+    "exp": UnaryOpCode.EXP,
+    "exp2": UnaryOpCode.EXP2,
+    "expm1": UnaryOpCode.EXPM1,
+    "floor": UnaryOpCode.FLOOR,
+    "log": UnaryOpCode.LOG,
+    "log10": UnaryOpCode.LOG10,
+    "log1p": UnaryOpCode.LOG1P,
+    "negative": UnaryOpCode.NEGATIVE,
+    "rint": UnaryOpCode.RINT,
+    "sigmoid": UnaryOpCode.SIGMOID,
+    "sign": UnaryOpCode.SIGN,
+    "sin": UnaryOpCode.SIN,
+    "softplus": UnaryOpCode.SOFTPLUS,
+    "sqrt": UnaryOpCode.SQRT,
+    "tan": UnaryOpCode.TAN,
+    "tanh": UnaryOpCode.TANH,
+}
+
+
+def fused_matmul(a, b, bias=None, scale=1.0, activation=None, out=None):
+    """
+    Compute ``activation(scale * matmul(a, b) + bias)`` in a single pass.
+
+    The scale, the bias and the activation are applied to each product
+    right after it is computed, so the result is written only once instead
+    of being read back by separate element-wise operations.
+
+    Parameters
+    ----------
+    a, b : array_like
+        Input arrays, with the same semantics as in matmul.
+    bias : array_like, optional
+        Vector added to every row of the products. Its length must match
+        the last dimension of the result.
+    scale : float, optional
+        Factor the products are multiplied by before the bias is added.
+    activation : str or callable, optional
+        Name of a unary operator, or the operator itself, such as "tanh" or
+        cunumeric.exp, applied last.
+    out : ndarray, optional
+        Array to store the result in.
+
+    Returns
+    -------
+    out : ndarray
+        The result of the product with the epilogue applied.
+    """
+    if activation is None:
+        op_code = UnaryOpCode.COPY
+    else:
+        name = getattr(activation, "__name__", activation)
+        if name not in _MATMUL_ACTIVATIONS:
+            raise ValueError(f"unsupported matmul activation {activation}")
+        op_code = _MATMUL_ACTIVATIONS[name]
+    a_array = ndarray.convert_to_cunumeric_ndarray(a)
+    if out is not None:
+        out = ndarray.convert_to_cunumeric_ndarray(out, share=True)
+    return a_array._matmul(
+        b,
+        out=out,
+        scale=scale,
+        bias=bias,
+        activation=op_code,
+        stacklevel=2,
+    )
+
+
+# Expressions with up to this many operands are ordered by dynamic
+# programming, and any larger ones greedily
+_EINSUM_DP_MAX_OPERANDS = 12
+
+# The number of einsum plans that are kept around for repeated expressions
+_EINSUM_PLAN_CACHE_SIZE = 256
+
+
+# Multi-tensor contraction strategy: the order of the pairwise contractions
+# minimizes the FLOPs and the sizes of the intermediates together, as they
+# can differ by orders of magnitude between orders. The search behind this
+# grows exponentially with the number of operands, so large networks are
+# ordered by the cheapest contraction available at each step instead.
+class EinsumPlanner(oe.paths.PathOptimizer):
     def __call__(self, inputs, output, size_dict, memory_limit=None):
-        return [(0, 1)] + [(0, -1)] * (len(inputs) - 2)
+        if len(inputs) <= _EINSUM_DP_MAX_OPERANDS:
+            optimizer = oe.DynamicProgramming(minimize="combo")
+        else:
+            optimizer = oe.paths.greedy
+        return optimizer(inputs, output, size_dict, memory_limit)
+
+
+# The pairwise contractions of the expressions einsum was called with, by
+# the shapes of their operands and the way the order was picked
+_einsum_plans = {}
+
+
+def _einsum_plan(expr, operands, optimize):
+    key = None
+    if isinstance(optimize, (bool, str)):
+        key = (expr, tuple(op.shape for op in operands), optimize)
+        plan = _einsum_plans.get(key)
+        if plan is not None:
+            return plan
+    if isinstance(optimize, bool):
+        optimize = EinsumPlanner()
+    # This call normalizes the expression (adds the output part if it's
+    # missing, expands '...') and checks for some errors (mismatch on number
+    # of dimensions between operand and expression, wrong number of operands,
+    # unknown modes on output, a mode appearing under two different
+    # non-singleton extents).
+    _, contractions = oe.contract_path(
+        expr, *operands, einsum_call=True, optimize=optimize
+    )
+    plan = tuple(
+        (indices, sub_expr) for (indices, _, sub_expr, _, _) in contractions
+    )
+    if key is not None:
+        if len(_einsum_plans) >= _EINSUM_PLAN_CACHE_SIZE:
+            del _einsum_plans[next(iter(_einsum_plans))]
+        _einsum_plans[key] = plan
+    return plan
 
 
 # Generalized tensor contraction
@@ -892,23 +1211,19 @@ def _contract(expr, a, b=None, out=None, stacklevel=1):
 
 @copy_docstring(np.einsum)
 def einsum(expr, *operands, out=None, optimize=False):
-    if not optimize:
-        optimize = NullOptimizer()
-    # This call normalizes the expression (adds the output part if it's
-    # missing, expands '...') and checks for some errors (mismatch on number
-    # of dimensions between operand and expression, wrong number of operands,
-    # unknown modes on output, a mode appearing under two different
-    # non-singleton extents).
-    operands, contractions = oe.contract_path(
-        expr, *operands, einsum_call=True, optimize=optimize
-    )
-    for (indices, _, sub_expr, _, _) in contractions:
+    operands = [ndarray.convert_to_cunumeric_ndarray(op) for op in operands]
+    # Unless a strategy or a path is requested, the order of the
+    # contractions is always optimized
+    plan = _einsum_plan(expr, operands, optimize)
+    for (indices, sub_expr) in plan:
         sub_opers = [operands.pop(i) for i in indices]
         if len(operands) == 0:  # last iteration
             sub_result = _contract(sub_expr, *sub_opers, out=out)
         else:
             sub_result = _contract(sub_expr, *sub_opers)
         operands.append(sub_result)
+        # Intermediates are released once the step consuming them is issued
+        del sub_opers, sub_result
     assert len(operands) == 1
     return operands[0]
 
@@ -1377,6 +1692,15 @@ def rint(a, out=None, where=True, dtype=None, stacklevel=1, **kwargs):
 # Trigonometric functions
 
 
+# The transcendental functions take the keyword fast_math, which picks the
+# faster, less accurate float32 variant for this call over the default set
+# with -cunumeric:fast-math. Other types always use the precise functions.
+def _fast_math_args(fast_math):
+    if fast_math is None:
+        return None
+    return (np.array(fast_math, dtype=np.bool_),)
+
+
 @copy_docstring(np.arccos)
 def arccos(a, out=None, where=True, dtype=None, **kwargs):
     lg_array = ndarray.convert_to_cunumeric_ndarray(a)
@@ -1441,7 +1765,7 @@ def arctan(a, out=None, where=True, dtype=None, **kwargs):
 
 
 @copy_docstring(np.cos)
-def cos(a, out=None, where=True, dtype=None, **kwargs):
+def cos(a, out=None, where=True, dtype=None, fast_math=None, **kwargs):
     lg_array = ndarray.convert_to_cunumeric_ndarray(a)
     where = ndarray.convert_to_predicate_ndarray(where, stacklevel=2)
     # Floats keep their floating point kind, otherwise switch to float64
@@ -1458,6 +1782,7 @@ def cos(a, out=None, where=True, dtype=None, **kwargs):
         dst=out,
         where=where,
         out_dtype=out_dtype,
+        args=_fast_math_args(fast_math),
     )
 
 
@@ -1483,7 +1808,7 @@ def sign(a, out=None, where=True, dtype=None, **kwargs):
 
 
 @copy_docstring(np.sin)
-def sin(a, out=None, where=True, dtype=None, **kwargs):
+def sin(a, out=None, where=True, dtype=None, fast_math=None, **kwargs):
     lg_array = ndarray.convert_to_cunumeric_ndarray(a)
     where = ndarray.convert_to_predicate_ndarray(where, stacklevel=2)
     # Floats keep their floating point kind, otherwise switch to float64
@@ -1500,6 +1825,7 @@ def sin(a, out=None, where=True, dtype=None, **kwargs):
         dst=out,
         where=where,
         out_dtype=out_dtype,
+        args=_fast_math_args(fast_math),
     )
 
 
@@ -1528,7 +1854,7 @@ def tan(a, out=None, where=True, dtype=None, **kwargs):
 
 
 @copy_docstring(np.tanh)
-def tanh(a, out=None, where=True, dtype=None, **kwargs):
+def tanh(a, out=None, where=True, dtype=None, fast_math=None, **kwargs):
     lg_array = ndarray.convert_to_cunumeric_ndarray(a)
     where = ndarray.convert_to_predicate_ndarray(where, stacklevel=2)
     # Floats keep their floating point kind, otherwise switch to float64
@@ -1545,6 +1871,7 @@ def tanh(a, out=None, where=True, dtype=None, **kwargs):
         dst=out,
         where=where,
         out_dtype=out_dtype,
+        args=_fast_math_args(fast_math),
     )
 
 
@@ -1577,6 +1904,18 @@ def add(a, b, out=None, where=True, dtype=None, stacklevel=1):
     )
 
 
+@copy_docstring(np.cumprod)
+def cumprod(a, axis=None, dtype=None, out=None):
+    lg_array = ndarray.convert_to_cunumeric_ndarray(a)
+    return lg_array.cumprod(axis=axis, dtype=dtype, out=out, stacklevel=2)
+
+
+@copy_docstring(np.cumsum)
+def cumsum(a, axis=None, dtype=None, out=None):
+    lg_array = ndarray.convert_to_cunumeric_ndarray(a)
+    return lg_array.cumsum(axis=axis, dtype=dtype, out=out, stacklevel=2)
+
+
 @copy_docstring(np.divide)
 def divide(a, b, out=None, where=True, dtype=None):
     # For python 3 switch this to truedivide
@@ -1642,6 +1981,61 @@ def multiply(a, b, out=None, where=True, dtype=None, stacklevel=1):
     )
 
 
+def mul_conj(a, b, out=None, where=True, dtype=None, stacklevel=1):
+    """
+    Multiply ``a`` by the complex conjugate of ``b`` element-wise.
+
+    The product is computed in one pass, without materializing the
+    conjugate of ``b``. Real inputs are simply multiplied.
+
+    Parameters
+    ----------
+    a, b : array_like
+        Input arrays, which must be broadcastable to a common shape.
+    out : ndarray, optional
+        Array to store the result in.
+    where : array_like, optional
+        Only the elements where this is True are computed.
+    dtype : data-type, optional
+        Type of the result.
+
+    Returns
+    -------
+    out : ndarray
+        The products ``a * conj(b)``.
+
+    See Also
+    --------
+    numpy.multiply, numpy.conjugate
+    """
+    a_array = ndarray.convert_to_cunumeric_ndarray(
+        a, stacklevel=(stacklevel + 1)
+    )
+    b_array = ndarray.convert_to_cunumeric_ndarray(
+        b, stacklevel=(stacklevel + 1)
+    )
+    where = ndarray.convert_to_predicate_ndarray(
+        where, stacklevel=(stacklevel + 1)
+    )
+    if out is not None:
+        out = ndarray.convert_to_cunumeric_ndarray(
+            out, stacklevel=(stacklevel + 1), share=True
+        )
+    if ndarray.find_common_type(a_array, b_array).kind == "c":
+        op = BinaryOpCode.MUL_CONJ
+    else:
+        op = BinaryOpCode.MULTIPLY
+    return ndarray.perform_binary_op(
+        op,
+        a_array,
+        b_array,
+        out=out,
+        out_dtype=dtype,
+        where=where,
+        stacklevel=(stacklevel + 1),
+    )
+
+
 @copy_docstring(np.prod)
 def prod(
     a,
@@ -1729,6 +2123,65 @@ def sum(
     )
 
 
+# Only floating point arrays can hold NaNs. The NaN-skipping reductions drop
+# them inside the fold for real floats, while complex arrays get them replaced
+# by the identity of the reduction up front
+def _replace_nans(a, identity):
+    if a.dtype.kind != "c":
+        return a
+    return where(isnan(a), identity, a)
+
+
+@copy_docstring(np.nanprod)
+def nanprod(a, axis=None, dtype=None, out=None, keepdims=False):
+    lg_array = ndarray.convert_to_cunumeric_ndarray(a)
+    if out is not None:
+        out = ndarray.convert_to_cunumeric_ndarray(out, share=True)
+    if lg_array.dtype.kind != "f":
+        return prod(
+            _replace_nans(lg_array, 1),
+            axis=axis,
+            dtype=dtype,
+            out=out,
+            keepdims=keepdims,
+            stacklevel=2,
+        )
+    return ndarray.perform_unary_reduction(
+        UnaryRedCode.NANPROD,
+        lg_array,
+        axis=axis,
+        dtype=dtype,
+        dst=out,
+        keepdims=keepdims,
+        stacklevel=2,
+    )
+
+
+@copy_docstring(np.nansum)
+def nansum(a, axis=None, dtype=None, out=None, keepdims=False):
+    lg_array = ndarray.convert_to_cunumeric_ndarray(a)
+    if out is not None:
+        out = ndarray.convert_to_cunumeric_ndarray(out, share=True)
+    if lg_array.dtype.kind != "f":
+        return sum(
+            _replace_nans(lg_array, 0),
+            axis=axis,
+            dtype=dtype,
+            out=out,
+            keepdims=keepdims,
+            stacklevel=2,
+        )
+    return ndarray.perform_unary_reduction(
+        UnaryRedCode.NANSUM,
+        lg_array,
+        axis=axis,
+        dtype=dtype,
+        dst=out,
+        keepdims=keepdims,
+        stacklevel=2,
+    )
+
+
 @copy_docstring(np.true_divide)
 def true_divide(a, b, out=None, where=True, dtype=None, stacklevel=1):
     a_array = ndarray.convert_to_cunumeric_ndarray(
@@ -1805,7 +2258,9 @@ def true_divide(a, b, out=None, where=True, dtype=None, stacklevel=1):
 
 
 @copy_docstring(np.exp)
-def exp(a, out=None, where=True, dtype=None, stacklevel=1, **kwargs):
+def exp(
+    a, out=None, where=True, dtype=None, stacklevel=1, fast_math=None, **kwargs
+):
     lg_array = ndarray.convert_to_cunumeric_ndarray(a)
     where = ndarray.convert_to_predicate_ndarray(
         where, stacklevel=(stacklevel + 1)
@@ -1823,6 +2278,41 @@ def exp(a, out=None, where=True, dtype=None, stacklevel=1, **kwargs):
         dst=out,
         where=where,
         out_dtype=out_dtype,
+        args=_fast_math_args(fast_math),
+    )
+
+
+# The real-valued functions below keep floating point kinds like exp does,
+# compute everything else in float64, and have no complex versions
+def _real_unary_op(op_code, name, a, out, where, dtype, stacklevel, args=None):
+    lg_array = ndarray.convert_to_cunumeric_ndarray(a)
+    if lg_array.dtype.kind == "c":
+        raise NotImplementedError(f"{name} does not support complex arrays")
+    where = ndarray.convert_to_predicate_ndarray(
+        where, stacklevel=(stacklevel + 1)
+    )
+    if lg_array.dtype.kind == "f":
+        out_dtype = lg_array.dtype
+    else:
+        out_dtype = np.dtype(np.float64)
+    if out is not None:
+        out = ndarray.convert_to_cunumeric_ndarray(out, share=True)
+    return ndarray.perform_unary_op(
+        op_code,
+        lg_array,
+        dtype=dtype,
+        dst=out,
+        where=where,
+        out_dtype=out_dtype,
+        args=args,
+        stacklevel=(stacklevel + 1),
+    )
+
+
+@copy_docstring(np.expm1)
+def expm1(a, out=None, where=True, dtype=None, stacklevel=1, **kwargs):
+    return _real_unary_op(
+        UnaryOpCode.EXPM1, "expm1", a, out, where, dtype, stacklevel + 1
     )
 
 
@@ -1849,7 +2339,9 @@ def exp2(a, out=None, where=True, dtype=None, stacklevel=1, **kwargs):
 
 
 @copy_docstring(np.log)
-def log(a, out=None, where=True, dtype=None, stacklevel=1, **kwargs):
+def log(
+    a, out=None, where=True, dtype=None, stacklevel=1, fast_math=None, **kwargs
+):
     lg_array = ndarray.convert_to_cunumeric_ndarray(a)
     where = ndarray.convert_to_predicate_ndarray(
         where, stacklevel=(stacklevel + 1)
@@ -1867,6 +2359,7 @@ def log(a, out=None, where=True, dtype=None, stacklevel=1, **kwargs):
         dst=out,
         where=where,
         out_dtype=out_dtype,
+        args=_fast_math_args(fast_math),
     )
 
 
@@ -1892,8 +2385,24 @@ def log10(a, out=None, where=True, dtype=None, stacklevel=1, **kwargs):
     )
 
 
+@copy_docstring(np.log1p)
+def log1p(a, out=None, where=True, dtype=None, stacklevel=1, **kwargs):
+    return _real_unary_op(
+        UnaryOpCode.LOG1P, "log1p", a, out, where, dtype, stacklevel + 1
+    )
+
+
 @copy_docstring(np.power)
-def power(x1, x2, out=None, where=True, dtype=None, stacklevel=1, **kwargs):
+def power(
+    x1,
+    x2,
+    out=None,
+    where=True,
+    dtype=None,
+    stacklevel=1,
+    fast_math=None,
+    **kwargs,
+):
     x1_array = ndarray.convert_to_cunumeric_ndarray(
         x1, stacklevel=(stacklevel + 1)
     )
@@ -1928,6 +2437,7 @@ def power(x1, x2, out=None, where=True, dtype=None, stacklevel=1, **kwargs):
         out_dtype=dtype,
         where=where,
         stacklevel=(stacklevel + 1),
+        args=_fast_math_args(fast_math),
     )
 
 
@@ -1949,6 +2459,399 @@ def square(a, out=None, where=True, dtype=None, **kwargs):
     )
 
 
+# Special functions
+#
+# NumPy has no versions of these, so they follow scipy.special where it has
+# them
+
+
+def erf(a, out=None, where=True, dtype=None, stacklevel=1):
+    """
+    Compute the error function element-wise.
+
+    Parameters
+    ----------
+    a : array_like
+        Input array.
+    out : ndarray, optional
+        Array to store the result in.
+    where : array_like, optional
+        Only the elements where this is True are computed.
+    dtype : data-type, optional
+        Type of the result. Floating point inputs keep their type and all
+        others produce float64.
+
+    Returns
+    -------
+    out : ndarray
+        ``2 / sqrt(pi) * integral(exp(-t**2), t=0..a)`` for each element.
+
+    See Also
+    --------
+    scipy.special.erf
+    """
+    return _real_unary_op(
+        UnaryOpCode.ERF, "erf", a, out, where, dtype, stacklevel + 1
+    )
+
+
+def sigmoid(a, out=None, where=True, dtype=None, stacklevel=1, fast_math=None):
+    """
+    Compute the logistic sigmoid ``1 / (1 + exp(-a))`` element-wise.
+
+    Large positive and negative inputs saturate to 1 and 0.
+
+    Parameters
+    ----------
+    a : array_like
+        Input array.
+    out : ndarray, optional
+        Array to store the result in.
+    where : array_like, optional
+        Only the elements where this is True are computed.
+    dtype : data-type, optional
+        Type of the result. Floating point inputs keep their type and all
+        others produce float64.
+    fast_math : bool, optional
+        Use the faster, less accurate float32 exponential for this call, see
+        ``exp``.
+
+    Returns
+    -------
+    out : ndarray
+        The sigmoid of each element.
+
+    See Also
+    --------
+    scipy.special.expit
+    """
+    return _real_unary_op(
+        UnaryOpCode.SIGMOID,
+        "sigmoid",
+        a,
+        out,
+        where,
+        dtype,
+        stacklevel + 1,
+        args=_fast_math_args(fast_math),
+    )
+
+
+def softplus(a, out=None, where=True, dtype=None, stacklevel=1):
+    """
+    Compute the softplus ``log(1 + exp(a))`` element-wise.
+
+    The result neither overflows for large inputs nor loses small values
+    for very negative ones, unlike evaluating the expression directly.
+
+    Parameters
+    ----------
+    a : array_like
+        Input array.
+    out : ndarray, optional
+        Array to store the result in.
+    where : array_like, optional
+        Only the elements where this is True are computed.
+    dtype : data-type, optional
+        Type of the result. Floating point inputs keep their type and all
+        others produce float64.
+
+    Returns
+    -------
+    out : ndarray
+        The softplus of each element.
+
+    See Also
+    --------
+    numpy.logaddexp
+    """
+    return _real_unary_op(
+        UnaryOpCode.SOFTPLUS, "softplus", a, out, where, dtype, stacklevel + 1
+    )
+
+
+def _logsumexp_input(a, name):
+    # The reduction only exists in single and double precision, so other
+    # inputs are computed in the nearest of the two
+    lg_array = ndarray.convert_to_cunumeric_ndarray(a)
+    if lg_array.dtype.kind == "c":
+        raise NotImplementedError(f"{name} does not support complex arrays")
+    if lg_array.dtype == np.float16:
+        return lg_array.astype(np.float32), lg_array.dtype
+    if lg_array.dtype.kind != "f":
+        return lg_array.astype(np.float64), None
+    return lg_array, None
+
+
+def logsumexp(a, axis=None, keepdims=False, stacklevel=1):
+    """
+    Compute the log of the sum of exponentials of the elements along the
+    given axes.
+
+    The result is computed in a single pass over the input that keeps a
+    running maximum and a sum of exponentials relative to it, so it neither
+    overflows for large inputs nor underflows for very negative ones.
+
+    Parameters
+    ----------
+    a : array_like
+        Input array.
+    axis : int or tuple of ints, optional
+        Axes over which the sum is taken. By default all elements are
+        summed.
+    keepdims : bool, optional
+        If True, the reduced axes are left in the result with size one.
+
+    Returns
+    -------
+    out : ndarray
+        ``log(sum(exp(a)))`` along the given axes. Integer and boolean
+        inputs produce float64.
+
+    See Also
+    --------
+    scipy.special.logsumexp
+    """
+    lg_array, half = _logsumexp_input(a, "logsumexp")
+    result = ndarray.perform_unary_reduction(
+        UnaryRedCode.LOGSUMEXP,
+        lg_array,
+        axis=axis,
+        keepdims=keepdims,
+        stacklevel=(stacklevel + 1),
+    )
+    return result if half is None else result.astype(half)
+
+
+def softmax(a, axis=None, stacklevel=1):
+    """
+    Compute the softmax ``exp(a) / sum(exp(a))`` along the given axes.
+
+    The exponentials are taken relative to the log-sum-exp of the input, so
+    the result is computed with one reduction and one element-wise pass and
+    without overflow.
+
+    Parameters
+    ----------
+    a : array_like
+        Input array.
+    axis : int or tuple of ints, optional
+        Axes over which the softmax is normalized. By default all elements
+        are.
+
+    Returns
+    -------
+    out : ndarray
+        An array of the shape of ``a`` whose values along the given axes sum
+        to one. Integer and boolean inputs produce float64.
+
+    See Also
+    --------
+    scipy.special.softmax
+    """
+    lg_array, half = _logsumexp_input(a, "softmax")
+    lse = ndarray.perform_unary_reduction(
+        UnaryRedCode.LOGSUMEXP,
+        lg_array,
+        axis=axis,
+        keepdims=True,
+        stacklevel=(stacklevel + 1),
+    )
+    result = ndarray.perform_binary_op(
+        BinaryOpCode.SOFTMAX,
+        lg_array,
+        lse,
+        out_dtype=lg_array.dtype,
+        stacklevel=(stacklevel + 1),
+    )
+    return result if half is None else result.astype(half)
+
+
+def _lstm_array(a, name, shape, dtype):
+    lg_array = ndarray.convert_to_cunumeric_ndarray(a)
+    if lg_array.shape != shape:
+        raise ValueError(
+            f"{name} of shape {lg_array.shape} does not match the expected "
+            f"shape {shape}"
+        )
+    if lg_array.dtype != dtype:
+        lg_array = lg_array.astype(dtype)
+    return lg_array
+
+
+def _lstm_outputs(out, shapes, dtype, inputs):
+    if out is None:
+        return tuple(
+            ndarray(shape, dtype=dtype, inputs=inputs) for shape in shapes
+        )
+    if len(out) != len(shapes):
+        raise ValueError(f"out must be a tuple of {len(shapes)} arrays")
+    out = tuple(
+        ndarray.convert_to_cunumeric_ndarray(array, share=True)
+        for array in out
+    )
+    for (array, shape) in zip(out, shapes):
+        if array.shape != shape or array.dtype != dtype:
+            raise ValueError(
+                f"output of shape {array.shape} and type {array.dtype} does "
+                f"not match the expected shape {shape} and type {dtype}"
+            )
+    return out
+
+
+def lstm_gates(ifog, c_prev=None, out=None):
+    """
+    Compute the gates and the new states of an LSTM step.
+
+    The four column blocks of ``ifog`` are the pre-activations of the input,
+    forget, output and cell gates, which are activated and combined with the
+    previous cell state in a single pass, rather than one operation and one
+    temporary at a time::
+
+        i, f, o = sigmoid(ifog[:, :3 * d]) split in three
+        g = tanh(ifog[:, 3 * d:])
+        c = i * g + f * c_prev
+        h = o * tanh(c)
+
+    Parameters
+    ----------
+    ifog : array_like
+        Array of shape (b, 4 * d) with the pre-activations of the gates.
+    c_prev : array_like, optional
+        Array of shape (b, d) with the previous cell state. By default it is
+        zero, as at the first step.
+    out : tuple of ndarray, optional
+        The arrays to store ``h``, ``c``, ``tanh_c`` and ``gates`` in, which
+        must have the shapes and the type of the results.
+
+    Returns
+    -------
+    h : ndarray
+        The new hidden state, of shape (b, d).
+    c : ndarray
+        The new cell state, of shape (b, d).
+    tanh_c : ndarray
+        The tanh of the new cell state, of shape (b, d).
+    gates : ndarray
+        The activated gates, of shape (b, 4 * d).
+
+    Notes
+    -----
+    Inputs of types other than float32 are computed in float64.
+
+    See Also
+    --------
+    lstm_gates_backward
+    """
+    lg_ifog = ndarray.convert_to_cunumeric_ndarray(ifog)
+    if lg_ifog.ndim != 2 or lg_ifog.shape[1] % 4 != 0:
+        raise ValueError("ifog must be a 2-D array of 4 * d columns")
+    if lg_ifog.dtype.kind == "c":
+        raise NotImplementedError("lstm_gates does not support complex")
+    dtype = np.dtype(np.float32 if lg_ifog.dtype == np.float32 else np.float64)
+    b, d = lg_ifog.shape[0], lg_ifog.shape[1] // 4
+    lg_ifog = _lstm_array(lg_ifog, "ifog", (b, 4 * d), dtype)
+    inputs = (lg_ifog,)
+    if c_prev is not None:
+        c_prev = _lstm_array(c_prev, "c_prev", (b, d), dtype)
+        inputs += (c_prev,)
+
+    h, c, tanh_c, gates = _lstm_outputs(
+        out, ((b, d), (b, d), (b, d), (b, 4 * d)), dtype, inputs
+    )
+    h._thunk.lstm_gates(
+        c._thunk,
+        tanh_c._thunk,
+        gates._thunk,
+        lg_ifog._thunk,
+        stacklevel=2,
+        c_prev=None if c_prev is None else c_prev._thunk,
+    )
+    return h, c, tanh_c, gates
+
+
+def lstm_gates_backward(gates, tanh_c, dh, dc=None, c_prev=None, out=None):
+    """
+    Backpropagate through the gates of an LSTM step.
+
+    This is the gradient of ``lstm_gates``, computed from the activated
+    gates and the tanh of the cell state it returned in a single pass.
+
+    Parameters
+    ----------
+    gates : array_like
+        Array of shape (b, 4 * d) with the activated gates of the step.
+    tanh_c : array_like
+        Array of shape (b, d) with the tanh of the cell state of the step.
+    dh : array_like
+        Array of shape (b, d) with the gradient of the hidden state.
+    dc : array_like, optional
+        Array of shape (b, d) with the gradient of the cell state that flows
+        back from the next step. By default it is zero, as at the last step.
+    c_prev : array_like, optional
+        Array of shape (b, d) with the previous cell state. By default it is
+        zero, as at the first step.
+    out : tuple of ndarray, optional
+        The arrays to store ``difog`` and, if ``c_prev`` is given,
+        ``dc_prev`` in.
+
+    Returns
+    -------
+    difog : ndarray
+        The gradient of the pre-activations of the gates, of shape
+        (b, 4 * d).
+    dc_prev : ndarray or None
+        The gradient of the previous cell state, of shape (b, d), or None
+        if ``c_prev`` is not given.
+
+    Notes
+    -----
+    Inputs of types other than float32 are computed in float64.
+
+    See Also
+    --------
+    lstm_gates
+    """
+    lg_gates = ndarray.convert_to_cunumeric_ndarray(gates)
+    if lg_gates.ndim != 2 or lg_gates.shape[1] % 4 != 0:
+        raise ValueError("gates must be a 2-D array of 4 * d columns")
+    if lg_gates.dtype.kind == "c":
+        raise NotImplementedError(
+            "lstm_gates_backward does not support complex"
+        )
+    dtype = np.dtype(
+        np.float32 if lg_gates.dtype == np.float32 else np.float64
+    )
+    b, d = lg_gates.shape[0], lg_gates.shape[1] // 4
+    lg_gates = _lstm_array(lg_gates, "gates", (b, 4 * d), dtype)
+    tanh_c = _lstm_array(tanh_c, "tanh_c", (b, d), dtype)
+    dh = _lstm_array(dh, "dh", (b, d), dtype)
+    if dc is not None:
+        dc = _lstm_array(dc, "dc", (b, d), dtype)
+    if c_prev is not None:
+        c_prev = _lstm_array(c_prev, "c_prev", (b, d), dtype)
+    inputs = tuple(
+        array
+        for array in (lg_gates, tanh_c, dh, dc, c_prev)
+        if array is not None
+    )
+
+    shapes = ((b, 4 * d),) if c_prev is None else ((b, 4 * d), (b, d))
+    outputs = _lstm_outputs(out, shapes, dtype, inputs)
+    difog = outputs[0]
+    dc_prev = None if c_prev is None else outputs[1]
+    difog._thunk.lstm_gates_backward(
+        lg_gates._thunk,
+        tanh_c._thunk,
+        dh._thunk,
+        stacklevel=2,
+        dc=None if dc is None else dc._thunk,
+        c_prev=None if c_prev is None else c_prev._thunk,
+        dc_prev=None if dc_prev is None else dc_prev._thunk,
+    )
+    return difog, dc_prev
+
+
 # Miscellaneous
 
 
@@ -1974,15 +2877,65 @@ def absolute(a, out=None, where=True, **kwargs):
 abs = absolute  # alias
 
 
-@copy_docstring(np.ceil)
-def ceil(a, out=None, where=True, dtype=None, **kwargs):
-    lg_array = ndarray.convert_to_cunumeric_ndarray(a)
-    where = ndarray.convert_to_predicate_ndarray(where, stacklevel=2)
-    # If this is an integer array then there is nothing to do for ceil
-    if (
-        lg_array.dtype.kind == "i"
-        or lg_array.dtype.kind == "u"
-        or lg_array.dtype.kind == "b"
+def abs2(a, out=None, where=True, stacklevel=1):
+    """
+    Compute the squared magnitude ``absolute(a)**2`` element-wise.
+
+    The real and imaginary parts of complex inputs are squared and summed
+    in one pass, without the square root and the scaling against overflow
+    of the absolute value.
+
+    Parameters
+    ----------
+    a : array_like
+        Input array.
+    out : ndarray, optional
+        Array to store the result in.
+    where : array_like, optional
+        Only the elements where this is True are computed.
+
+    Returns
+    -------
+    out : ndarray
+        The squared magnitude of each element, which is real for complex
+        inputs.
+
+    See Also
+    --------
+    numpy.absolute, numpy.square
+    """
+    lg_array = ndarray.convert_to_cunumeric_ndarray(
+        a, stacklevel=(stacklevel + 1)
+    )
+    if lg_array.dtype == np.bool_:
+        return multiply(
+            lg_array, lg_array, out=out, where=where, stacklevel=stacklevel + 1
+        )
+    where = ndarray.convert_to_predicate_ndarray(
+        where, stacklevel=(stacklevel + 1)
+    )
+    if out is not None:
+        out = ndarray.convert_to_cunumeric_ndarray(
+            out, stacklevel=(stacklevel + 1), share=True
+        )
+    return ndarray.perform_unary_op(
+        UnaryOpCode.ABS2,
+        lg_array,
+        dst=out,
+        where=where,
+        stacklevel=(stacklevel + 1),
+    )
+
+
+@copy_docstring(np.ceil)
+def ceil(a, out=None, where=True, dtype=None, **kwargs):
+    lg_array = ndarray.convert_to_cunumeric_ndarray(a)
+    where = ndarray.convert_to_predicate_ndarray(where, stacklevel=2)
+    # If this is an integer array then there is nothing to do for ceil
+    if (
+        lg_array.dtype.kind == "i"
+        or lg_array.dtype.kind == "u"
+        or lg_array.dtype.kind == "b"
     ):
         return lg_array
     if out is not None:
@@ -2053,18 +3006,261 @@ def sqrt(a, out=None, where=True, dtype=None, stacklevel=1, **kwargs):
     )
 
 
+# Unlike NumPy, the result can go into a preallocated out array, which lets
+# iterative convolutions alternate between two buffers whose tiles stay
+# resident, so that only the halos move between iterations
 @copy_docstring(np.convolve)
-def convolve(a, v, mode="full"):
+def convolve(a, v, mode="full", out=None, stride=1, dilation=1):
     a_lg = ndarray.convert_to_cunumeric_ndarray(a, stacklevel=2)
     v_lg = ndarray.convert_to_cunumeric_ndarray(v, stacklevel=2)
 
     if mode != "same":
         raise NotImplementedError("Need to implement other convolution modes")
 
-    if a_lg.size < v_lg.size:
+    # A filter with fewer dimensions than the signal is applied to each of
+    # the signals along the leading axes
+    if a_lg.ndim < v_lg.ndim or (
+        a_lg.ndim == v_lg.ndim and a_lg.size < v_lg.size
+    ):
         v_lg, a_lg = a_lg, v_lg
 
-    return a_lg.convolve(v_lg, mode, stacklevel=2)
+    # The stride and the dilation are cuNumeric extensions: the result keeps
+    # every stride-th point of the convolution with the filter that has
+    # dilation - 1 zeros between its points
+    return a_lg.convolve(
+        v_lg, mode, out=out, stride=stride, dilation=dilation, stacklevel=2
+    )
+
+
+# A correlation is the convolution with the conjugate of the flipped filter,
+# so it takes the same fast paths as convolutions and needs no task of its own
+@copy_docstring(np.correlate)
+def correlate(a, v, mode="valid", stride=1, dilation=1):
+    a_lg = ndarray.convert_to_cunumeric_ndarray(a, stacklevel=2)
+    v_lg = ndarray.convert_to_cunumeric_ndarray(v, stacklevel=2)
+
+    if mode != "same":
+        raise NotImplementedError("Need to implement other correlation modes")
+
+    v_lg = flip(v_lg)
+    if v_lg.dtype.kind == "c":
+        v_lg = v_lg.conj()
+    return a_lg.convolve(
+        v_lg, mode, stride=stride, dilation=dilation, stacklevel=2
+    )
+
+
+# Match this to MAX_STENCIL_POINTS in stencil/stencil.h
+_STENCIL_MAX_POINTS = 32
+
+
+def stencil(a, offsets, coefficients, out=None):
+    """
+    Apply a stencil to the interior of an array.
+
+    Every point of the result at least the reach of the stencil away from
+    the boundary is the sum of its neighbors at the offsets scaled by the
+    coefficients, and every other point is copied from the input. Swapping
+    the input and the output between the steps of an iterative kernel
+    keeps the tiles of both resident, so that only their halos move from
+    one step to the next.
+
+    Parameters
+    ----------
+    a : array_like
+        Input array.
+    offsets : sequence of tuples of ints
+        Offsets of the neighbors, with one entry per dimension of the input.
+    coefficients : sequence of scalars
+        Weights of the neighbors at the offsets.
+    out : ndarray, optional
+        Array to store the result in. It must have the shape and the type
+        of the input.
+
+    Returns
+    -------
+    out : ndarray
+        The input with the stencil applied to its interior.
+    """
+    a_lg = ndarray.convert_to_cunumeric_ndarray(a, stacklevel=2)
+    if a_lg.ndim == 0:
+        raise ValueError("stencils need an array with at least one dimension")
+    offsets = tuple(
+        tuple(int(shift) for shift in offset) for offset in offsets
+    )
+    if any(len(offset) != a_lg.ndim for offset in offsets):
+        raise ValueError("every offset needs a shift for each dimension")
+    if len(coefficients) != len(offsets):
+        raise ValueError("stencils need a coefficient for each offset")
+    if not 0 < len(offsets) <= _STENCIL_MAX_POINTS:
+        raise ValueError(
+            f"stencils take between 1 and {_STENCIL_MAX_POINTS} points"
+        )
+    coefficients = np.asarray(coefficients, dtype=a_lg.dtype)
+    if out is None:
+        out = ndarray(a_lg.shape, dtype=a_lg.dtype, inputs=(a_lg,))
+    else:
+        out = ndarray.convert_to_cunumeric_ndarray(out, share=True)
+        if out.shape != a_lg.shape:
+            raise ValueError("out must have the shape of the input")
+        if out.dtype != a_lg.dtype:
+            raise TypeError("out must have the type of the input")
+    out._thunk.stencil(
+        a_lg._thunk, offsets, tuple(coefficients.tolist()), stacklevel=2
+    )
+    return out
+
+
+# Match this to MAX_POLYVAL_COEFFICIENTS in unary/polyval.h
+_POLYVAL_MAX_COEFFICIENTS = 32
+
+
+@copy_docstring(np.polyval)
+def polyval(p, x):
+    if isinstance(p, np.poly1d):
+        p = p.coeffs
+    elif isinstance(p, ndarray):
+        p = p.__array__()
+    p = np.asarray(p)
+    if p.ndim != 1:
+        raise ValueError("polyval needs a 1-D array of coefficients")
+    x_lg = ndarray.convert_to_cunumeric_ndarray(x, stacklevel=2)
+    if p.size == 0:
+        return zeros(x_lg.shape, dtype=x_lg.dtype)
+    dtype = np.result_type(p.dtype, x_lg.dtype)
+    if dtype.kind == "b":
+        dtype = np.dtype(np.int64)
+    x_lg = x_lg.astype(dtype)
+    coefficients = p.astype(dtype)
+    # The task takes the leading coefficients and the rest are folded in with
+    # Horner's rule one element-wise step at a time
+    head = coefficients[:_POLYVAL_MAX_COEFFICIENTS]
+    result = ndarray(x_lg.shape, dtype=dtype, inputs=(x_lg,))
+    result._thunk.polyval(x_lg._thunk, tuple(head.tolist()), stacklevel=2)
+    for coefficient in coefficients[_POLYVAL_MAX_COEFFICIENTS:]:
+        result = result * x_lg + coefficient
+    return result
+
+
+@copy_docstring(np.interp)
+def interp(x, xp, fp, left=None, right=None, period=None):
+    x_lg = ndarray.convert_to_cunumeric_ndarray(x, stacklevel=2)
+    xp_lg = ndarray.convert_to_cunumeric_ndarray(xp, stacklevel=2)
+    fp_lg = ndarray.convert_to_cunumeric_ndarray(fp, stacklevel=2)
+    if xp_lg.ndim != 1 or fp_lg.ndim != 1:
+        raise ValueError("Data points must be 1D sequences")
+    if xp_lg.shape != fp_lg.shape:
+        raise ValueError("fp and xp are not of the same length")
+    if xp_lg.size == 0:
+        raise ValueError("array of sample points is empty")
+    if fp_lg.dtype.kind == "c":
+        real = interp(
+            x_lg,
+            xp_lg,
+            fp_lg.real,
+            None if left is None else np.real(left),
+            None if right is None else np.real(right),
+            period,
+        )
+        imag = interp(
+            x_lg,
+            xp_lg,
+            fp_lg.imag,
+            None if left is None else np.imag(left),
+            None if right is None else np.imag(right),
+            period,
+        )
+        return real + 1j * imag
+
+    x_lg = x_lg.astype(np.float64)
+    if period is not None:
+        if period == 0:
+            raise ValueError("period must be a non-zero value")
+        period = abs(period)
+        left = right = None
+        # The table is small, so it is wrapped around on the host the way
+        # NumPy does it
+        xp_np = xp_lg.__array__().astype(np.float64) % period
+        order = np.argsort(xp_np)
+        xp_np = xp_np[order]
+        fp_np = fp_lg.__array__().astype(np.float64)[order]
+        xp_lg = ndarray.convert_to_cunumeric_ndarray(
+            np.concatenate((xp_np[-1:] - period, xp_np, xp_np[:1] + period))
+        )
+        fp_lg = ndarray.convert_to_cunumeric_ndarray(
+            np.concatenate((fp_np[-1:], fp_np, fp_np[:1]))
+        )
+        x_lg = x_lg % period
+    result = ndarray(x_lg.shape, dtype=np.dtype(np.float64), inputs=(x_lg,))
+    result._thunk.interp(
+        x_lg._thunk,
+        xp_lg.astype(np.float64)._thunk,
+        fp_lg.astype(np.float64)._thunk,
+        left,
+        right,
+        stacklevel=2,
+    )
+    return result
+
+
+def rolling(a, window, op="mean", axis=-1):
+    """
+    Reduce the windows of consecutive elements along an axis.
+
+    The result holds the reduction of every window of window elements that
+    fits in the input along the axis, like reducing the last axis of
+    ``numpy.lib.stride_tricks.sliding_window_view(a, window, axis)``. The
+    windows are reduced with a constant number of operations per element
+    whatever their length, rather than the length of the window that a
+    convolution with a filter of ones takes.
+
+    Parameters
+    ----------
+    a : array_like
+        Input array.
+    window : int
+        Number of elements in every window.
+    op : {'sum', 'mean', 'min', 'max'}, optional
+        Reduction applied to the windows.
+    axis : int, optional
+        Axis along which the windows slide.
+
+    Returns
+    -------
+    out : ndarray
+        The reduced windows, with ``a.shape[axis] - window + 1`` entries
+        along the axis.
+    """
+    a_lg = ndarray.convert_to_cunumeric_ndarray(a, stacklevel=2)
+    if a_lg.ndim == 0:
+        raise ValueError("rolling needs an array with at least one dimension")
+    if not isinstance(op, str) or op.upper() not in RollingOpCode.__members__:
+        raise ValueError(f"unsupported rolling reduction: {op}")
+    op = RollingOpCode[op.upper()]
+    if not -a_lg.ndim <= axis < a_lg.ndim:
+        raise ValueError(f"axis {axis} is out of bounds")
+    axis %= a_lg.ndim
+    window = int(window)
+    if not 0 < window <= a_lg.shape[axis]:
+        raise ValueError(
+            "window must be at least 1 and at most the extent of the axis"
+        )
+    if op == RollingOpCode.MEAN and a_lg.dtype.kind not in ("f", "c"):
+        a_lg = a_lg.astype(np.float64)
+    elif op == RollingOpCode.SUM and a_lg.dtype.kind == "b":
+        a_lg = a_lg.astype(np.int64)
+    elif op in (RollingOpCode.MIN, RollingOpCode.MAX):
+        if a_lg.dtype.kind == "c":
+            raise TypeError("rolling min and max need real values")
+    windows = ndarray(a_lg.shape, dtype=a_lg.dtype, inputs=(a_lg,))
+    windows._thunk.rolling(a_lg._thunk, op, axis, window, stacklevel=2)
+    # The leading points along the axis hold the windows that are clipped to
+    # the start of the array
+    valid = tuple(
+        slice(window - 1, None) if dim == axis else slice(None)
+        for dim in range(a_lg.ndim)
+    )
+    return windows[valid]
 
 
 # ### SORTING, SEARCHING and COUNTING
@@ -2092,6 +3288,58 @@ def argmin(a, axis=None, out=None):
     return lg_array.argmin(axis=axis, out=out, stacklevel=2)
 
 
+def _nan_arg_reduction(op, lg_array, axis, out):
+    if lg_array.size == 1:
+        return 0
+    if axis is None:
+        axis = lg_array.ndim - 1
+    elif type(axis) != int:
+        raise TypeError("'axis' argument must be an 'int'")
+    elif axis < 0 or axis >= lg_array.ndim:
+        raise TypeError("invalid 'axis' argument " + str(axis))
+    return ndarray.perform_unary_reduction(
+        op,
+        lg_array,
+        axis=axis,
+        dtype=np.dtype(np.int64),
+        dst=out,
+        check_types=False,
+        stacklevel=3,
+    )
+
+
+@copy_docstring(np.nanargmax)
+def nanargmax(a, axis=None, out=None):
+    lg_array = ndarray.convert_to_cunumeric_ndarray(a)
+    if out is not None:
+        if out.dtype != np.int64:
+            raise ValueError("output array must have int64 dtype")
+        out = ndarray.convert_to_cunumeric_ndarray(out, share=True)
+    if lg_array.dtype.kind != "f":
+        return lg_array.argmax(axis=axis, out=out, stacklevel=2)
+    return _nan_arg_reduction(UnaryRedCode.NANARGMAX, lg_array, axis, out)
+
+
+@copy_docstring(np.nanargmin)
+def nanargmin(a, axis=None, out=None):
+    lg_array = ndarray.convert_to_cunumeric_ndarray(a)
+    if out is not None:
+        if out.dtype != np.int64:
+            raise ValueError("output array must have int64 dtype")
+        out = ndarray.convert_to_cunumeric_ndarray(out, share=True)
+    if lg_array.dtype.kind != "f":
+        return lg_array.argmin(axis=axis, out=out, stacklevel=2)
+    return _nan_arg_reduction(UnaryRedCode.NANARGMIN, lg_array, axis, out)
+
+
+_BINCOUNT_WEIGHT_TYPES = (
+    np.dtype(np.float32),
+    np.dtype(np.float64),
+    np.dtype(np.int32),
+    np.dtype(np.int64),
+)
+
+
 @copy_docstring(np.bincount)
 def bincount(a, weights=None, minlength=0):
     lg_array = ndarray.convert_to_cunumeric_ndarray(a)
@@ -2101,8 +3349,10 @@ def bincount(a, weights=None, minlength=0):
             raise ValueError("weights array must be same shape for bincount")
         if lg_weights.dtype.kind == "c":
             raise ValueError("weights must be convertible to float64")
-        # Make sure the weights are float64
-        lg_weights = lg_weights.astype(np.float64)
+        # The bins are float64 either way, but these weights are summed
+        # without converting them first
+        if lg_weights.dtype not in _BINCOUNT_WEIGHT_TYPES:
+            lg_weights = lg_weights.astype(np.float64)
     if lg_array.dtype.kind != "i" and lg_array.dtype.kind != "u":
         raise TypeError("input array for bincount must be integer type")
     # If nobody told us the size then compute it
@@ -2114,7 +3364,7 @@ def bincount(a, weights=None, minlength=0):
             out = zeros((minlength,), dtype=np.dtype(np.int64), stacklevel=2)
             out[lg_array[0]] = 1
         else:
-            out = zeros((minlength,), dtype=lg_weights.dtype, stacklevel=2)
+            out = zeros((minlength,), dtype=np.float64, stacklevel=2)
             index = lg_array[0]
             out[index] = weights[index]
     else:
@@ -2129,7 +3379,7 @@ def bincount(a, weights=None, minlength=0):
         else:
             out = ndarray(
                 (minlength,),
-                dtype=lg_weights.dtype,
+                dtype=np.dtype(np.float64),
                 inputs=(lg_array, weights),
             )
             out._thunk.bincount(
@@ -2138,12 +3388,315 @@ def bincount(a, weights=None, minlength=0):
     return out
 
 
+@copy_docstring(np.histogram)
+def histogram(a, bins=10, range=None, weights=None, density=None):
+    lg_array = ndarray.convert_to_cunumeric_ndarray(a)
+    if lg_array.dtype.kind == "c":
+        raise TypeError("histogram does not support complex input")
+    lg_weights = None
+    if weights is not None:
+        lg_weights = ndarray.convert_to_cunumeric_ndarray(weights)
+        if lg_weights.shape != lg_array.shape:
+            raise ValueError("weights should have the same shape as a.")
+        if lg_weights.dtype.kind == "c":
+            raise ValueError("weights must be convertible to float64")
+        weights_dtype = lg_weights.dtype
+        lg_weights = lg_weights.ravel().astype(np.float64)
+    lg_array = lg_array.ravel()
+
+    if isinstance(bins, str):
+        raise NotImplementedError("histogram does not support bin estimators")
+    if np.ndim(bins) == 0:
+        num_bins = int(bins)
+        if num_bins < 1:
+            raise ValueError("`bins` must be positive, when an integer")
+        if range is not None:
+            first, last = (float(edge) for edge in range)
+            if first > last:
+                raise ValueError(
+                    "max must be larger than min in range parameter."
+                )
+        elif lg_array.size == 0:
+            first, last = 0.0, 1.0
+        else:
+            first, last = float(amin(lg_array)), float(amax(lg_array))
+        if not (np.isfinite(first) and np.isfinite(last)):
+            raise ValueError(
+                f"autodetected range of [{first}, {last}] is not finite"
+            )
+        if first == last:
+            first, last = first - 0.5, last + 0.5
+        edges = np.linspace(first, last, num_bins + 1)
+        uniform = True
+    else:
+        if isinstance(bins, ndarray):
+            bins = bins.__array__()
+        edges = np.asarray(bins, dtype=np.float64)
+        if edges.ndim != 1:
+            raise ValueError("`bins` must be 1d, when an array")
+        if np.any(edges[:-1] > edges[1:]):
+            raise ValueError(
+                "`bins` must increase monotonically, when an array"
+            )
+        num_bins = edges.size - 1
+        uniform = False
+
+    lg_edges = array(edges)
+    dtype = np.dtype(np.int64 if weights is None else np.float64)
+    if lg_array.size == 0:
+        hist = zeros((num_bins,), dtype=dtype, stacklevel=2)
+    else:
+        hist = ndarray(
+            (num_bins,),
+            dtype=dtype,
+            inputs=(lg_array, lg_weights),
+        )
+        hist._thunk.histogram(
+            lg_array._thunk,
+            lg_edges._thunk,
+            uniform,
+            stacklevel=2,
+            weights=lg_weights._thunk if lg_weights is not None else None,
+        )
+
+    if density:
+        widths = array(np.diff(edges))
+        return hist / widths / hist.sum(), lg_edges
+    if weights is not None and weights_dtype != dtype:
+        hist = hist.astype(weights_dtype)
+    return hist, lg_edges
+
+
+def kmeans_assign(points, centroids, return_sums=False):
+    """
+    Assign every point to its nearest centroid, as the assignment step of
+    k-means clustering does.
+
+    This is a single pass over the points that keeps the distances of one
+    point at a time, rather than the (n, k) matrix of all distances that
+    ``argmin(((points[:, None] - centroids) ** 2).sum(2), axis=1)`` builds.
+
+    Parameters
+    ----------
+    points : array_like
+        Array of shape (n, d) with one point per row.
+    centroids : array_like
+        Array of shape (k, d) with one centroid per row.
+    return_sums : bool, optional
+        Also return the sums, the counts and the total squared distance of
+        the points of every cluster, which come out of the same pass.
+
+    Returns
+    -------
+    labels : ndarray
+        Index of the nearest centroid of every point, as an int64 array of
+        shape (n,). Ties go to the lower index, like argmin.
+    sums : ndarray
+        Sum of the points of every cluster, as a float64 array of shape
+        (k, d). Only returned if return_sums is True.
+    counts : ndarray
+        Number of points of every cluster, as an int64 array of shape (k,).
+        Only returned if return_sums is True.
+    inertia : ndarray
+        Sum of the squared distances of all points to their nearest
+        centroids, as a float64 array of shape (). Only returned if
+        return_sums is True.
+
+    Notes
+    -----
+    Points and centroids of types other than float32 are computed in
+    float64.
+    """
+    lg_points = ndarray.convert_to_cunumeric_ndarray(points)
+    lg_centroids = ndarray.convert_to_cunumeric_ndarray(centroids)
+    if lg_points.ndim != 2 or lg_centroids.ndim != 2:
+        raise ValueError("points and centroids must be 2-D arrays")
+    if lg_points.shape[1] != lg_centroids.shape[1]:
+        raise ValueError(
+            f"points of {lg_points.shape[1]} coordinates do not match "
+            f"centroids of {lg_centroids.shape[1]} coordinates"
+        )
+    if lg_centroids.shape[0] == 0 or lg_centroids.shape[1] == 0:
+        raise ValueError("need at least one centroid of one coordinate")
+    if lg_points.dtype.kind == "c" or lg_centroids.dtype.kind == "c":
+        raise NotImplementedError("kmeans_assign does not support complex")
+
+    dtype = np.dtype(
+        np.float32
+        if lg_points.dtype == np.float32 and lg_centroids.dtype == np.float32
+        else np.float64
+    )
+    if lg_points.dtype != dtype:
+        lg_points = lg_points.astype(dtype)
+    if lg_centroids.dtype != dtype:
+        lg_centroids = lg_centroids.astype(dtype)
+
+    n, d = lg_points.shape
+    k = lg_centroids.shape[0]
+    inputs = (lg_points, lg_centroids)
+    labels = ndarray((n,), dtype=np.dtype(np.int64), inputs=inputs)
+    if not return_sums:
+        labels._thunk.kmeans_assign(
+            lg_points._thunk, lg_centroids._thunk, stacklevel=2
+        )
+        return labels
+
+    sums = ndarray((k, d), dtype=np.dtype(np.float64), inputs=inputs)
+    counts = ndarray((k,), dtype=np.dtype(np.int64), inputs=inputs)
+    inertia = ndarray((), dtype=np.dtype(np.float64), inputs=inputs)
+    labels._thunk.kmeans_assign(
+        lg_points._thunk,
+        lg_centroids._thunk,
+        stacklevel=2,
+        sums=sums._thunk,
+        counts=counts._thunk,
+        inertia=inertia._thunk,
+    )
+    return labels, sums, counts, inertia
+
+
+def segment_reduce(values, labels, num_segments=None, op="sum"):
+    """
+    Reduce the rows of an array that share the same label.
+
+    Row ``i`` of the result is the reduction of all rows ``j`` of values
+    with ``labels[j] == i``, which is what ``np.add.at(out, labels, values)``
+    computes for a sum, but for rows of any width and in a single pass.
+    Along with the labels that :func:`kmeans_assign` finds, the means of the
+    clusters make up the update step of k-means clustering.
+
+    Parameters
+    ----------
+    values : array_like
+        Array of shape (n,) or (n, d) with one row per label.
+    labels : array_like
+        Integer array of shape (n,), whose entries lie in
+        ``[0, num_segments)``.
+    num_segments : int, optional
+        Number of rows of the result. The default is one more than the
+        largest label.
+    op : {"sum", "prod", "min", "max", "mean"}, optional
+        The reduction of the rows of every label.
+
+    Returns
+    -------
+    out : ndarray
+        Array of shape (num_segments,) or (num_segments, d) and the type of
+        values, or of float64 for the mean of integer values.
+
+    Notes
+    -----
+    Labels without rows get the identity of the reduction, which is
+    infinite for the minimum and maximum of floating point values, and
+    their mean is NaN.
+    """
+    lg_values = ndarray.convert_to_cunumeric_ndarray(values)
+    lg_labels = ndarray.convert_to_cunumeric_ndarray(labels)
+    if lg_labels.ndim != 1:
+        raise ValueError("labels must be a 1-D array")
+    if lg_labels.dtype.kind not in ("i", "u"):
+        raise TypeError("labels must be an integer array")
+    if lg_values.ndim not in (1, 2) or lg_values.shape[0] != lg_labels.size:
+        raise ValueError(
+            "values must be a 1-D or 2-D array with one row per label"
+        )
+    op_codes = {
+        "sum": UnaryRedCode.SUM,
+        "prod": UnaryRedCode.PROD,
+        "min": UnaryRedCode.MIN,
+        "max": UnaryRedCode.MAX,
+        "mean": UnaryRedCode.SUM,
+    }
+    if op not in op_codes:
+        raise ValueError(f"unsupported segment reduction {op}")
+    if lg_values.dtype.kind not in ("i", "u", "f"):
+        raise NotImplementedError(
+            "segment_reduce only supports integer and floating point values"
+        )
+    if num_segments is None:
+        num_segments = int(amax(lg_labels)) + 1 if lg_labels.size > 0 else 0
+
+    if op == "mean" and lg_values.dtype.kind != "f":
+        lg_values = lg_values.astype(np.float64)
+    dtype = lg_values.dtype
+    if op in ("sum", "mean"):
+        identity = 0
+    elif op == "prod":
+        identity = 1
+    elif dtype.kind == "f":
+        identity = np.inf if op == "min" else -np.inf
+    else:
+        info = np.iinfo(dtype)
+        identity = info.max if op == "min" else info.min
+
+    out = full(
+        (num_segments,) + lg_values.shape[1:], identity, dtype, stacklevel=2
+    )
+    counts = None
+    if op == "mean":
+        counts = zeros((num_segments,), dtype=np.int64, stacklevel=2)
+    if lg_labels.size > 0:
+        out._thunk.segment_reduce(
+            lg_labels._thunk,
+            lg_values._thunk,
+            op_codes[op],
+            stacklevel=2,
+            counts=counts._thunk if counts is not None else None,
+        )
+    if op == "mean":
+        counts = counts.astype(dtype)
+        if out.ndim > 1:
+            counts = counts[:, np.newaxis]
+        out = out / counts
+    return out
+
+
 @copy_docstring(np.nonzero)
 def nonzero(a):
     lg_array = ndarray.convert_to_cunumeric_ndarray(a)
     return lg_array.nonzero()
 
 
+@copy_docstring(np.argwhere)
+def argwhere(a):
+    lg_array = ndarray.convert_to_cunumeric_ndarray(a)
+    # A 0-d array has a single row of no coordinates when it is nonzero
+    if lg_array.ndim == 0:
+        return empty((int(bool(lg_array)), 0), dtype=np.int64)
+    return lg_array.argwhere()
+
+
+def topk(a, k, axis=-1, largest=True):
+    """
+    Return the k largest (or smallest) elements along an axis.
+
+    Unlike a full sort, only the selected elements are ever ordered, so
+    this is much cheaper than sorting when k is small.
+
+    Parameters
+    ----------
+    a : array_like
+        Input array.
+    k : int
+        Number of elements to select, between 1 and the extent of the axis.
+    axis : int or None, optional
+        Axis to select along. If None, the flattened array is used.
+    largest : bool, optional
+        Select the largest elements if True, the smallest ones otherwise.
+
+    Returns
+    -------
+    values : ndarray
+        The selected elements, best first. NaNs rank below every other
+        value and ties keep the element with the lower index first.
+    indices : ndarray
+        Indices of the selected elements along the axis, or into the
+        flattened array if axis is None.
+    """
+    lg_array = ndarray.convert_to_cunumeric_ndarray(a)
+    return lg_array.topk(k, axis=axis, largest=largest, stacklevel=2)
+
+
 @copy_docstring(np.where)
 def where(a, x=None, y=None):
     if x is None or y is None:
@@ -2204,50 +3757,122 @@ def where(a, x=None, y=None):
     )
 
 
+@copy_docstring(np.putmask)
+def putmask(a, mask, values):
+    if not isinstance(a, ndarray):
+        raise TypeError("putmask: first argument must be an array")
+    mask = ndarray.convert_to_cunumeric_ndarray(mask)
+    values = ndarray.convert_to_cunumeric_ndarray(values)
+    if mask.shape != a.shape:
+        raise ValueError("putmask: mask and data must be the same size")
+    if values.size != 1 and values.shape != a.shape:
+        if values.size != a.size:
+            raise NotImplementedError(
+                "cuNumeric does not repeat the values of putmask "
+                "that do not match the size of the array"
+            )
+        values = values.reshape(a.shape)
+    if a.size == 0:
+        return
+    if mask.dtype != np.bool_:
+        mask = mask.astype(np.bool_)
+    if values.dtype != a.dtype:
+        values = values.astype(a.dtype)
+    a._thunk.putmask(mask._thunk, values._thunk, stacklevel=2)
+
+
 # def extract(a, x):
 #    raise NotImplementedError("extract")
 
-# def sort(a, axis=-1, kind='quicksort', order=None):
-#    # No need to sort anything with just one element
-#    if a.size == 1:
-#        raise NotImplementedError("Need to drop dimensions here")
-#        return a
-#    lg_array = ndarray.convert_to_cunumeric_ndarray(a)
-#    if order is not None:
-#        raise NotImplementedError("No support for non-None 'order' for sort")
-#    if kind != 'quicksort':
-#        warnings.warn("cuNumeric uses a different algorithm than "+str(kind)+
-#                      " for sorting",
-#                      category=RuntimeWarning, stacklevel=2)
-#    # Make the out array
-#    if lg_array.ndim > 1:
-#        # We only support sorting the full array right now
-#        if axis is not None:
-#            raise NotImplementedError("cuNumeric only supports sorting full "
-#                                      "arrays at the moment")
-#        # Flatten the output array
-#        out_size = lg_array.shape[0]
-#        for d in xrange(1,lg_array.ndim):
-#            out_size *= lg_array.shape[d]
-#        out = ndarray((out_size,), dtype=lg_array.dtype)
-#    else:
-#        out = ndarray(lg_array.shape, dtype=lg_array.dtype)
-#    out._thunk.sort(lg_array._thunk, stacklevel=2)
-#    return out
+
+# Sorting
+
+
+@copy_docstring(np.sort)
+def sort(a, axis=-1, kind=None, order=None):
+    lg_array = ndarray.convert_to_cunumeric_ndarray(a)
+    return lg_array._sort(axis, kind, order, argsort=False, stacklevel=2)
+
+
+@copy_docstring(np.argsort)
+def argsort(a, axis=-1, kind=None, order=None):
+    lg_array = ndarray.convert_to_cunumeric_ndarray(a)
+    return lg_array._sort(axis, kind, order, argsort=True, stacklevel=2)
+
+
+@copy_docstring(np.searchsorted)
+def searchsorted(a, v, side="left", sorter=None):
+    lg_array = ndarray.convert_to_cunumeric_ndarray(a)
+    return lg_array.searchsorted(v, side=side, sorter=sorter, stacklevel=2)
+
+
+@copy_docstring(np.unique)
+def unique(
+    ar,
+    return_index=False,
+    return_inverse=False,
+    return_counts=False,
+    axis=None,
+):
+    if return_index or return_inverse or axis is not None:
+        raise NotImplementedError(
+            "cuNumeric only supports unique on the flattened array without "
+            "the index or inverse arrays"
+        )
+    lg_array = ndarray.convert_to_cunumeric_ndarray(ar)
+    # Values that fit in a machine word are aggregated in hash tables, which
+    # only sorts the distinct values instead of the whole array
+    if lg_array.dtype.kind in ("b", "i", "u") or lg_array.dtype in (
+        np.float32,
+        np.float64,
+    ):
+        values, counts = lg_array._thunk.unique(stacklevel=2)
+        values = ndarray(shape=values.shape, thunk=values)
+        counts = ndarray(shape=counts.shape, thunk=counts)
+        if values.size > 1:
+            order = values.argsort()
+            values = values[order]
+            counts = counts[order]
+        return (values, counts) if return_counts else values
+    if return_counts:
+        raise NotImplementedError(
+            "cuNumeric only supports the counts of unique values of boolean, "
+            "integer and single or double precision types"
+        )
+    flat = lg_array._sort(None, None, None, argsort=False, stacklevel=2)
+    if flat.size <= 1:
+        return flat
+    # Keep every element that differs from the one before it in the sorted
+    # array. NaNs never compare equal, but sort last, so only the first of
+    # them is kept, as NumPy does.
+    changes = not_equal(flat[1:], flat[:-1])
+    if flat.dtype.kind == "f":
+        changes = logical_and(changes, logical_not(isnan(flat[:-1])))
+    mask = ndarray(flat.shape, dtype=np.dtype(np.bool_), inputs=(flat,))
+    mask[0] = True
+    mask[1:] = changes
+    return flat[mask]
 
 # Counting
 
 
 @copy_docstring(np.count_nonzero)
 @add_boilerplate("a")
-def count_nonzero(a, axis=None, stacklevel=1):
-    if a.size == 0:
-        return 0
+def count_nonzero(a, axis=None, keepdims=False, stacklevel=1):
+    if axis is None:
+        if not keepdims:
+            if a.size == 0:
+                return 0
+        else:
+            axis = tuple(range(a.ndim))
+    # The elements are tested and counted in the reduction kernels, so inputs
+    # of any type, booleans included, are never converted to the counter type
     return ndarray.perform_unary_reduction(
         UnaryRedCode.COUNT_NONZERO,
         a,
         axis=axis,
         dtype=np.dtype(np.uint64),
+        keepdims=keepdims,
         stacklevel=(stacklevel + 1),
         check_types=False,
     )
@@ -2259,7 +3884,15 @@ def count_nonzero(a, axis=None, stacklevel=1):
 
 
 @copy_docstring(np.amax)
-def amax(a, axis=None, out=None, keepdims=False, stacklevel=1):
+def amax(
+    a,
+    axis=None,
+    out=None,
+    keepdims=False,
+    initial=None,
+    where=True,
+    stacklevel=1,
+):
     lg_array = ndarray.convert_to_cunumeric_ndarray(
         a, stacklevel=(stacklevel + 1)
     )
@@ -2268,12 +3901,25 @@ def amax(a, axis=None, out=None, keepdims=False, stacklevel=1):
             out, stacklevel=(stacklevel + 1), share=True
         )
     return lg_array.max(
-        axis=axis, out=out, keepdims=keepdims, stacklevel=(stacklevel + 1)
+        axis=axis,
+        out=out,
+        keepdims=keepdims,
+        initial=initial,
+        where=where,
+        stacklevel=(stacklevel + 1),
     )
 
 
 @copy_docstring(np.amin)
-def amin(a, axis=None, out=None, keepdims=False, stacklevel=1):
+def amin(
+    a,
+    axis=None,
+    out=None,
+    keepdims=False,
+    initial=None,
+    where=True,
+    stacklevel=1,
+):
     lg_array = ndarray.convert_to_cunumeric_ndarray(
         a, stacklevel=(stacklevel + 1)
     )
@@ -2282,13 +3928,64 @@ def amin(a, axis=None, out=None, keepdims=False, stacklevel=1):
             out, stacklevel=(stacklevel + 1), share=True
         )
     return lg_array.min(
-        axis=axis, out=out, keepdims=keepdims, stacklevel=(stacklevel + 1)
+        axis=axis,
+        out=out,
+        keepdims=keepdims,
+        initial=initial,
+        where=where,
+        stacklevel=(stacklevel + 1),
     )
 
 
 @copy_docstring(np.max)
-def max(a, axis=None, out=None, keepdims=False):
-    return amax(a, axis=axis, out=out, keepdims=keepdims, stacklevel=2)
+def max(a, axis=None, out=None, keepdims=False, initial=None, where=True):
+    return amax(
+        a,
+        axis=axis,
+        out=out,
+        keepdims=keepdims,
+        initial=initial,
+        where=where,
+        stacklevel=2,
+    )
+
+
+@copy_docstring(np.nanmax)
+def nanmax(a, axis=None, out=None, keepdims=False):
+    lg_array = ndarray.convert_to_cunumeric_ndarray(a)
+    if out is not None:
+        out = ndarray.convert_to_cunumeric_ndarray(out, share=True)
+    if lg_array.dtype.kind != "f":
+        return lg_array.max(
+            axis=axis, out=out, keepdims=keepdims, stacklevel=2
+        )
+    return ndarray.perform_unary_reduction(
+        UnaryRedCode.NANMAX,
+        lg_array,
+        axis=axis,
+        dst=out,
+        keepdims=keepdims,
+        stacklevel=2,
+    )
+
+
+@copy_docstring(np.nanmin)
+def nanmin(a, axis=None, out=None, keepdims=False):
+    lg_array = ndarray.convert_to_cunumeric_ndarray(a)
+    if out is not None:
+        out = ndarray.convert_to_cunumeric_ndarray(out, share=True)
+    if lg_array.dtype.kind != "f":
+        return lg_array.min(
+            axis=axis, out=out, keepdims=keepdims, stacklevel=2
+        )
+    return ndarray.perform_unary_reduction(
+        UnaryRedCode.NANMIN,
+        lg_array,
+        axis=axis,
+        dst=out,
+        keepdims=keepdims,
+        stacklevel=2,
+    )
 
 
 @copy_docstring(np.maximum)
@@ -2318,8 +4015,16 @@ def maximum(a, b, out=None, where=True, dtype=None, stacklevel=1, **kwargs):
 
 
 @copy_docstring(np.min)
-def min(a, axis=None, out=None, keepdims=False):
-    return amin(a, axis=axis, out=out, keepdims=keepdims, stacklevel=2)
+def min(a, axis=None, out=None, keepdims=False, initial=None, where=True):
+    return amin(
+        a,
+        axis=axis,
+        out=out,
+        keepdims=keepdims,
+        initial=initial,
+        where=where,
+        stacklevel=2,
+    )
 
 
 @copy_docstring(np.minimum)
@@ -2374,6 +4079,20 @@ def mod(a, b, out=None, where=True, dtype=None, stacklevel=1):
     )
 
 
+@copy_docstring(np.ptp)
+def ptp(a, axis=None, out=None, keepdims=False, stacklevel=1):
+    lg_array = ndarray.convert_to_cunumeric_ndarray(
+        a, stacklevel=(stacklevel + 1)
+    )
+    if out is not None:
+        out = ndarray.convert_to_cunumeric_ndarray(
+            out, stacklevel=(stacklevel + 1), share=True
+        )
+    return lg_array.ptp(
+        axis=axis, out=out, keepdims=keepdims, stacklevel=(stacklevel + 1)
+    )
+
+
 # Averages and variances
 
 
@@ -2387,6 +4106,71 @@ def mean(a, axis=None, dtype=None, out=None, keepdims=False):
     )
 
 
+@copy_docstring(np.nanmean)
+def nanmean(a, axis=None, dtype=None, out=None, keepdims=False):
+    lg_array = ndarray.convert_to_cunumeric_ndarray(a)
+    if out is not None:
+        out = ndarray.convert_to_cunumeric_ndarray(out, share=True)
+    if lg_array.dtype.kind == "c":
+        raise NotImplementedError("nanmean does not support complex arrays")
+    if lg_array.dtype.kind != "f":
+        return lg_array.mean(
+            axis=axis, dtype=dtype, out=out, keepdims=keepdims, stacklevel=2
+        )
+    if dtype is None:
+        dtype = lg_array.dtype
+    # The sum and the count of the non-NaN elements come out of the same
+    # pass. Half precision cannot count far, so it accumulates in single.
+    acc_dtype = np.dtype(np.float32) if dtype == np.float16 else dtype
+    if lg_array.dtype != acc_dtype:
+        lg_array = lg_array.astype(acc_dtype)
+    total, count = ndarray.perform_multi_reduction(
+        (UnaryRedCode.NANSUM, UnaryRedCode.NANCOUNT),
+        lg_array,
+        axis=axis,
+        keepdims=keepdims,
+        stacklevel=2,
+    )
+    return ndarray.perform_binary_op(
+        BinaryOpCode.DIVIDE,
+        total,
+        count,
+        out=out,
+        dtype=dtype if out is None else None,
+        stacklevel=2,
+    )
+
+
+@copy_docstring(np.std)
+def std(a, axis=None, dtype=None, out=None, ddof=0, keepdims=False):
+    lg_array = ndarray.convert_to_cunumeric_ndarray(a)
+    if out is not None:
+        out = ndarray.convert_to_cunumeric_ndarray(out, share=True)
+    return lg_array.std(
+        axis=axis,
+        dtype=dtype,
+        out=out,
+        ddof=ddof,
+        keepdims=keepdims,
+        stacklevel=2,
+    )
+
+
+@copy_docstring(np.var)
+def var(a, axis=None, dtype=None, out=None, ddof=0, keepdims=False):
+    lg_array = ndarray.convert_to_cunumeric_ndarray(a)
+    if out is not None:
+        out = ndarray.convert_to_cunumeric_ndarray(out, share=True)
+    return lg_array.var(
+        axis=axis,
+        dtype=dtype,
+        out=out,
+        ddof=ddof,
+        keepdims=keepdims,
+        stacklevel=2,
+    )
+
+
 # ### STACKING and CONCATENATION ###
 
 
@@ -2395,67 +4179,82 @@ def row_stack(inputs):
     return vstack(inputs)
 
 
-@copy_docstring(np.vstack)
-def vstack(inputs):
-    # Check to see if we can build a new tuple of cuNumeric arrays
-    dtype = None
-    cunumeric_inputs = list()
-    for inp in inputs:
-        lg_array = ndarray.convert_to_cunumeric_ndarray(inp)
-        if dtype is None:
-            ndim = lg_array.ndim
-            shape = lg_array.shape
-            dtype = lg_array.dtype
-            if lg_array.ndim == 1:
-                leading_dim = 1
-            else:
-                leading_dim = lg_array.shape[0]
-        else:
-            # Check that the types and shapes match
-            if lg_array.ndim != ndim:
-                raise TypeError(
-                    "All arguments to vstack must have the same number of"
-                    " dimensions"
-                )
-            if ndim > 1:
-                for dim in xrange(1, ndim):
-                    if shape[dim] != lg_array.shape[dim]:
-                        raise TypeError(
-                            "All arguments to vstack must have the same "
-                            "dimension size in all dimensions except the first"
-                        )
-            if lg_array.dtype != dtype:
-                raise TypeError(
-                    "All arguments to vstack must have the same type"
+@copy_docstring(np.concatenate)
+def concatenate(inputs, axis=0, out=None, dtype=None):
+    arrays = [ndarray.convert_to_cunumeric_ndarray(inp) for inp in inputs]
+    if len(arrays) == 0:
+        raise ValueError("need at least one array to concatenate")
+    if axis is None:
+        arrays = [array.ravel() for array in arrays]
+        axis = 0
+    ndim = arrays[0].ndim
+    if ndim == 0:
+        raise ValueError("zero-dimensional arrays cannot be concatenated")
+    if axis < -ndim or axis >= ndim:
+        raise ValueError(
+            f"axis {axis} is out of bounds for array of dimension {ndim}"
+        )
+    axis = axis % ndim
+    shape = list(arrays[0].shape)
+    for array in arrays[1:]:
+        if array.ndim != ndim:
+            raise ValueError(
+                "all the input arrays must have same number of dimensions"
+            )
+        for dim in range(ndim):
+            if dim != axis and array.shape[dim] != shape[dim]:
+                raise ValueError(
+                    "all the input array dimensions except for the "
+                    "concatenation axis must match exactly"
                 )
-            if lg_array.ndim == 1:
-                leading_dim += 1
-            else:
-                leading_dim += lg_array.shape[0]
-        # Save the input array for later
-        cunumeric_inputs.append(lg_array)
-    # Once we are here we have all our inputs arrays, so make the output
-    if len(shape) == 1:
-        out_shape = (leading_dim,) + shape
-        out_array = ndarray(
-            shape=out_shape, dtype=dtype, inputs=cunumeric_inputs
-        )
-        # Copy the values over from the inputs
-        for idx, inp in enumerate(cunumeric_inputs):
-            out_array[idx, :] = inp
+        shape[axis] += array.shape[axis]
+    shape = tuple(shape)
+
+    if out is not None:
+        if out.shape != shape:
+            raise ValueError("Output array is the wrong shape")
+        dtype = out.dtype
+    elif dtype is None:
+        dtype = np.result_type(*(array.dtype for array in arrays))
     else:
-        out_shape = (leading_dim,)
-        for dim in xrange(1, ndim):
-            out_shape += (shape[dim],)
-        out_array = ndarray(
-            shape=out_shape, dtype=dtype, inputs=cunumeric_inputs
-        )
-        # Copy the values over from the inputs
-        offset = 0
-        for inp in cunumeric_inputs:
-            out_array[offset : offset + inp.shape[0], ...] = inp
-            offset += inp.shape[0]
-    return out_array
+        dtype = np.dtype(dtype)
+    arrays = [
+        array if array.dtype == dtype else array.astype(dtype)
+        for array in arrays
+    ]
+    if out is None:
+        out = ndarray(shape=shape, dtype=dtype, inputs=arrays)
+    out._thunk.concatenate(
+        [array._thunk for array in arrays], axis, stacklevel=2
+    )
+    return out
+
+
+@copy_docstring(np.vstack)
+def vstack(inputs):
+    arrays = [ndarray.convert_to_cunumeric_ndarray(inp) for inp in inputs]
+    if len(arrays) == 0:
+        raise ValueError("need at least one array to concatenate")
+    # Check that the types and shapes match
+    ndim = arrays[0].ndim
+    dtype = arrays[0].dtype
+    for array in arrays[1:]:
+        if array.ndim != ndim:
+            raise TypeError(
+                "All arguments to vstack must have the same number of"
+                " dimensions"
+            )
+        if array.shape[1:] != arrays[0].shape[1:]:
+            raise TypeError(
+                "All arguments to vstack must have the same "
+                "dimension size in all dimensions except the first"
+            )
+        if array.dtype != dtype:
+            raise TypeError("All arguments to vstack must have the same type")
+    # Vectors become the rows of the result
+    if ndim == 1:
+        arrays = [array.reshape((1,) + array.shape) for array in arrays]
+    return concatenate(arrays, axis=0)
 
 
 # ### FILE I/O ###
@@ -2561,6 +4360,41 @@ def fromstring(string, dtype=float, count=-1, sep=""):
     return ndarray.convert_to_cunumeric_ndarray(numpy_array)
 
 
+@copy_docstring(np.memmap)
+def memmap(filename, dtype=np.uint8, mode="r+", offset=0, shape=None):
+    # The file is attached to directly, so updates of writable maps reach
+    # it without a copy. Arrays larger than memory are best used with
+    # CUNUMERIC_STREAM_CHUNK_SIZE set, which streams element-wise
+    # operations and reductions through the GPUs in blocks.
+    mapped = np.memmap(
+        filename, dtype=dtype, mode=mode, offset=offset, shape=shape
+    )
+    thunk = runtime.get_numpy_thunk(
+        mapped, stacklevel=2, share=(mode != "r")
+    )
+    return ndarray(shape=None, stacklevel=2, thunk=thunk)
+
+
+def _read_npy_header(filename):
+    # Returns the shape, type and data offset of an .npy file whose data the
+    # tasks can read, or None if it has to go through NumPy
+    with open(filename, "rb") as f:
+        try:
+            version = np.lib.format.read_magic(f)
+        except ValueError:
+            return None
+        if version == (1, 0):
+            header = np.lib.format.read_array_header_1_0(f)
+        elif version == (2, 0):
+            header = np.lib.format.read_array_header_2_0(f)
+        else:
+            return None
+        shape, fortran_order, dtype = header
+        if fortran_order or not runtime.is_supported_type(dtype):
+            return None
+        return shape, dtype, f.tell()
+
+
 @copy_docstring(np.load)
 def load(
     file,
@@ -2569,6 +4403,15 @@ def load(
     fix_imports=True,
     encoding="ASCII",
 ):
+    # Large .npy files are read by the tasks of each tile in parallel
+    if isinstance(file, (str, os.PathLike)) and mmap_mode is None:
+        filename = os.path.abspath(os.fspath(file))
+        header = _read_npy_header(filename)
+        if header is not None and len(header[0]) > 0:
+            shape, dtype, offset = header
+            result = ndarray(shape, dtype=dtype, stacklevel=2)
+            result._thunk.load_npy(filename, offset, stacklevel=2)
+            return result
     numpy_array = np.load(
         file,
         mmap_mode=mmap_mode,
@@ -2579,6 +4422,38 @@ def load(
     return ndarray.convert_to_cunumeric_ndarray(numpy_array)
 
 
+@copy_docstring(np.save)
+def save(file, arr, allow_pickle=True, fix_imports=True):
+    array = ndarray.convert_to_cunumeric_ndarray(arr)
+    if not isinstance(file, (str, os.PathLike)) or array.ndim == 0:
+        np.save(
+            file,
+            array.__array__(stacklevel=2),
+            allow_pickle=allow_pickle,
+            fix_imports=fix_imports,
+        )
+        return
+    filename = os.path.abspath(os.fspath(file))
+    if not filename.endswith(".npy"):
+        filename += ".npy"
+    header = {
+        "descr": np.lib.format.dtype_to_descr(array.dtype),
+        "fortran_order": False,
+        "shape": array.shape,
+    }
+    # The header is written here and the tasks of every tile write their
+    # part of the data in parallel
+    with open(filename, "wb") as f:
+        try:
+            np.lib.format.write_array_header_1_0(f, header)
+        except ValueError:
+            f.seek(0)
+            np.lib.format.write_array_header_2_0(f, header)
+        offset = f.tell()
+        f.truncate(offset + array.nbytes)
+    array._thunk.save_npy(filename, offset, stacklevel=2)
+
+
 @copy_docstring(np.loadtxt)
 def loadtxt(
     fname,
@@ -2622,3 +4497,27 @@ def memmap(
         order=order,
     )
     return ndarray.convert_to_cunumeric_ndarray(numpy_array, share=True)
+
+
+# ### PROFILING ###
+
+
+def memory_report():
+    """
+    Report the peak memory that each kind of task has used so far.
+
+    The memory of tasks is only recorded when ``CUNUMERIC_MEMORY_REPORT=1`` is
+    set in the environment. The instances are the most bytes of arrays that
+    one launch of the task was mapped to in each kind of memory, and the
+    temporaries the most bytes of task-local buffers it held at once, so the
+    operations that would overflow a memory show up at the top.
+
+    Returns
+    -------
+    report : dict
+        ``"tasks"`` is a list with the ``"task"``, ``"launches"``,
+        ``"instances"`` and ``"temporaries"`` of each task, largest first.
+        ``"callsites"`` lists the ``"function"``, ``"file"`` and ``"line"`` of
+        each callsite, with the ``"operations"`` it issued and how often.
+    """
+    return runtime.get_memory_report()
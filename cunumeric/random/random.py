@@ -16,6 +16,7 @@
 import numpy as np
 import numpy.random as nprandom
 from cunumeric.array import ndarray
+from cunumeric.config import RandGenCode
 from cunumeric.runtime import runtime
 
 
@@ -25,26 +26,36 @@ def seed(init=None):
     runtime.set_next_random_epoch(int(init))
 
 
-def rand(*shapeargs):
+# The dtype keywords of rand, randn and random are cuNumeric extensions that
+# generate half and single precision values directly, rather than converting
+# double precision ones
+def _float_dtype(dtype, name):
+    dtype = np.dtype(dtype)
+    if dtype.type not in (np.float16, np.float32, np.float64):
+        raise TypeError(f"cunumeric.random.{name} must be given a float dtype")
+    return dtype
+
+
+def rand(*shapeargs, dtype=np.float64):
     if shapeargs is None:
         return nprandom.rand()
-    result = ndarray(shapeargs, dtype=np.dtype(np.float64))
+    result = ndarray(shapeargs, dtype=_float_dtype(dtype, "rand"))
     result._thunk.random_uniform(stacklevel=2)
     return result
 
 
-def randn(*shapeargs):
+def randn(*shapeargs, dtype=np.float64):
     if shapeargs is None:
         return nprandom.randn()
-    result = ndarray(shapeargs, dtype=np.dtype(np.float64))
+    result = ndarray(shapeargs, dtype=_float_dtype(dtype, "randn"))
     result._thunk.random_normal(stacklevel=2)
     return result
 
 
-def random(shape=None):
+def random(shape=None, dtype=np.float64):
     if shape is None:
         return nprandom.random()
-    result = ndarray(shape, dtype=np.dtype(np.float64))
+    result = ndarray(shape, dtype=_float_dtype(dtype, "random"))
     result._thunk.random_uniform(stacklevel=2)
     return result
 
@@ -56,8 +67,7 @@ def randint(low, high=None, size=None, dtype=None):
         dtype = np.dtype(dtype)
     else:
         dtype = np.dtype(np.int64)
-    # TODO: randint must support unsigned integer dtypes as well
-    if dtype.kind != "i":
+    if dtype.kind not in ("i", "u"):
         raise TypeError(
             "cunumeric.random.randint must be given an integer dtype"
         )
@@ -87,8 +97,7 @@ def uniform(low, high=None, size=None, dtype=None):
         dtype = np.dtype(dtype)
     else:
         dtype = np.dtype(np.float64)
-    if dtype.kind != "f":
-        raise TypeError("cunumeric.random.uniform must be given a float dtype")
+    dtype = _float_dtype(dtype, "uniform")
     if not isinstance(size, tuple):
         size = (size,)
     result = ndarray(size, dtype=dtype)
@@ -101,3 +110,411 @@ def uniform(low, high=None, size=None, dtype=None):
             )
         result._thunk.random_uniform(low=low, high=high, stacklevel=2)
     return result
+
+
+# Permutations come from a counter-based bijection of the indices, so every
+# point of the result is computed where it lives without sorting random keys
+def permutation(x):
+    if isinstance(x, (int, np.integer)):
+        if x < 0:
+            raise ValueError("negative dimensions are not allowed")
+        result = ndarray((int(x),), dtype=np.dtype(np.int64))
+        result._thunk.random_permutation(stacklevel=2)
+        return result
+    x = ndarray.convert_to_cunumeric_ndarray(x)
+    if x.ndim == 0:
+        raise IndexError("x must be an integer or at least 1-dimensional")
+    return _take_rows(x, permutation(x.shape[0]))
+
+
+def _take_rows(x, rows):
+    if x.ndim == 1:
+        return x[rows]
+    # Gathers only index 1-D arrays, so the rows are gathered from the
+    # flattened array with the indices of all of their elements
+    from cunumeric.module import arange
+
+    width = x.size // x.shape[0]
+    indices = rows.reshape((rows.shape[0], 1)) * width + arange(width)
+    shape = (rows.shape[0],) + x.shape[1:]
+    return x.reshape((x.size,))[indices.reshape((indices.size,))].reshape(
+        shape
+    )
+
+
+def shuffle(x):
+    if not isinstance(x, ndarray):
+        return nprandom.shuffle(x)
+    if x.ndim == 0:
+        raise TypeError("shuffle needs an array of at least one dimension")
+    x[:] = _take_rows(x, permutation(x.shape[0]))
+
+
+def choice(a, size=None, replace=True, p=None):
+    if p is not None:
+        if isinstance(a, ndarray):
+            a = a.__array__()
+        return ndarray.convert_to_cunumeric_ndarray(
+            nprandom.choice(a, size=size, replace=replace, p=p)
+        )
+    if isinstance(a, (int, np.integer)):
+        if a <= 0:
+            raise ValueError("a must be greater than 0")
+        population = None
+        n = int(a)
+    else:
+        population = ndarray.convert_to_cunumeric_ndarray(a)
+        if population.ndim != 1:
+            raise ValueError("a must be 1-dimensional")
+        n = population.shape[0]
+        if n == 0:
+            raise ValueError("a cannot be empty")
+
+    shape = () if size is None else size
+    if not isinstance(shape, tuple):
+        shape = (shape,)
+    count = int(np.prod(shape))
+    if replace:
+        indices = randint(0, n, size=max(count, 1))
+    else:
+        if count > n:
+            raise ValueError(
+                "Cannot take a larger sample than population when "
+                "'replace=False'"
+            )
+        # The leading entries of a permutation are a sample without
+        # replacement
+        indices = permutation(n)[: max(count, 1)]
+
+    if size is None:
+        index = int(indices[0])
+        return index if population is None else population[index]
+    indices = indices[:count]
+    if population is not None:
+        indices = population[indices]
+    return indices.reshape(shape)
+
+
+# The remaining distributions are generated by the RAND task as long as their
+# parameters are scalars. Parameters that vary per draw are left to NumPy.
+def _scalars(*params):
+    return all(np.isscalar(param) for param in params)
+
+
+def _distribution(gen_code, params, size, dtype):
+    if not isinstance(size, tuple):
+        size = (size,)
+    result = ndarray(size, dtype=np.dtype(dtype))
+    args = [np.array(param, type(param)) for param in params]
+    result._thunk.random_distribution(gen_code, args, stacklevel=3)
+    return result
+
+
+def exponential(scale=1.0, size=None):
+    if size is None or not _scalars(scale):
+        return nprandom.exponential(scale, size)
+    if scale < 0:
+        raise ValueError("scale < 0")
+    return _distribution(
+        RandGenCode.EXPONENTIAL, [float(scale)], size, np.float64
+    )
+
+
+def gamma(shape, scale=1.0, size=None):
+    if size is None or not _scalars(shape, scale):
+        return nprandom.gamma(shape, scale, size)
+    if shape < 0:
+        raise ValueError("shape < 0")
+    if scale < 0:
+        raise ValueError("scale < 0")
+    return _distribution(
+        RandGenCode.GAMMA, [float(shape), float(scale)], size, np.float64
+    )
+
+
+def beta(a, b, size=None):
+    if size is None or not _scalars(a, b):
+        return nprandom.beta(a, b, size)
+    if a <= 0:
+        raise ValueError("a <= 0")
+    if b <= 0:
+        raise ValueError("b <= 0")
+    return _distribution(
+        RandGenCode.BETA, [float(a), float(b)], size, np.float64
+    )
+
+
+def poisson(lam=1.0, size=None):
+    if size is None or not _scalars(lam):
+        return nprandom.poisson(lam, size)
+    if lam < 0:
+        raise ValueError("lam < 0")
+    return _distribution(RandGenCode.POISSON, [float(lam)], size, np.int64)
+
+
+def binomial(n, p, size=None):
+    if size is None or not _scalars(n, p):
+        return nprandom.binomial(n, p, size)
+    if n < 0:
+        raise ValueError("n < 0")
+    if not 0 <= p <= 1:
+        raise ValueError("p < 0, p > 1 or p is NaN")
+    if n == 1:
+        return bernoulli(p, size, dtype=np.int64)
+    return _distribution(
+        RandGenCode.BINOMIAL, [int(n), float(p)], size, np.int64
+    )
+
+
+# bernoulli and dropout_mask are cuNumeric extensions. They compare the random
+# bits with the probability inside the RAND task and write the values of the
+# requested dtype directly, so masks take no float64 or boolean temporaries.
+def bernoulli(p=0.5, size=None, dtype=bool):
+    if size is None:
+        return dtype(nprandom.random() < p)
+    if not 0 <= p <= 1:
+        raise ValueError("p < 0, p > 1 or p is NaN")
+    if not isinstance(size, tuple):
+        size = (size,)
+    result = ndarray(size, dtype=np.dtype(dtype))
+    result._thunk.random_bernoulli(p, 1, 0, stacklevel=2)
+    return result
+
+
+def dropout_mask(rate, size, dtype=np.float32):
+    """Mask that zeroes each element with probability rate and scales the
+    kept ones by 1 / (1 - rate), so that multiplying by it keeps the
+    expected value of the input"""
+    if not 0 <= rate < 1:
+        raise ValueError("rate must be in [0, 1)")
+    dtype = _float_dtype(dtype, "dropout_mask")
+    if not isinstance(size, tuple):
+        size = (size,)
+    result = ndarray(size, dtype=dtype)
+    result._thunk.random_bernoulli(
+        1.0 - rate, 1.0 / (1.0 - rate), 0, stacklevel=2
+    )
+    return result
+
+
+_MASK64 = (1 << 64) - 1
+
+
+# The splitmix64 finalizer, which spreads seeds and spawn indices over the
+# Philox keys so that nearby ones give unrelated streams
+def _mix(*values):
+    x = 0
+    for value in values:
+        x = (x + int(value) + 0x9E3779B97F4A7C15) & _MASK64
+        x = ((x ^ (x >> 30)) * 0xBF58476D1CE4E5B9) & _MASK64
+        x = ((x ^ (x >> 27)) * 0x94D049BB133111EB) & _MASK64
+        x ^= x >> 31
+    return x
+
+
+# Every draw of the RAND task makes up to this many values from one counter,
+# so the counters of two calls never share a draw if every call starts at a
+# multiple of it
+_VALUES_PER_COUNTER = 4
+
+
+def _shape_of(size):
+    if size is None:
+        return (1,)
+    return size if isinstance(size, tuple) else (size,)
+
+
+class Generator:
+    """Random generator with its own Philox key and counter, in the style of
+    numpy.random.Generator. Every call draws the counters after those of the
+    previous call, so the streams of generators with different seeds or
+    spawned from one another do not overlap and none of them touches the
+    global epoch that cunumeric.random.seed sets. Generated values are the
+    same for every partitioning of the arrays."""
+
+    def __init__(self, seed=None, *, _key=None):
+        if _key is None:
+            if seed is None:
+                seed = np.random.SeedSequence().entropy
+            _key = _mix(seed)
+        self._key = _key
+        self._base = 0
+        self._spawned = 0
+
+    def __repr__(self):
+        return f"Generator(key={self._key & 0xFFFFFFFF:#010x})"
+
+    def _stream(self, count):
+        stream = (self._key & 0xFFFFFFFF, self._base)
+        chunks = -(-count // _VALUES_PER_COUNTER)
+        self._base = (self._base + chunks * _VALUES_PER_COUNTER) & _MASK64
+        return stream
+
+    def _sample(self, size, dtype, fill):
+        result = ndarray(_shape_of(size), dtype=np.dtype(dtype))
+        fill(result._thunk, self._stream(result.size))
+        return result[0].item() if size is None else result
+
+    def spawn(self, n_children):
+        """Independent generators whose keys are derived from this one's"""
+        children = []
+        for _ in range(n_children):
+            self._spawned += 1
+            children.append(Generator(_key=_mix(self._key, self._spawned)))
+        return children
+
+    def random(self, size=None, dtype=np.float64):
+        dtype = _float_dtype(dtype, "Generator.random")
+        return self._sample(
+            size,
+            dtype,
+            lambda thunk, stream: thunk.random_uniform(
+                stacklevel=3, stream=stream
+            ),
+        )
+
+    def uniform(self, low=0.0, high=1.0, size=None, dtype=np.float64):
+        if low >= high:
+            raise ValueError(
+                "'high' bound must be strictly greater than 'low'"
+            )
+        dtype = _float_dtype(dtype, "Generator.uniform")
+        return self._sample(
+            size,
+            dtype,
+            lambda thunk, stream: thunk.random_uniform(
+                stacklevel=3, low=low, high=high, stream=stream
+            ),
+        )
+
+    def standard_normal(self, size=None, dtype=np.float64):
+        dtype = _float_dtype(dtype, "Generator.standard_normal")
+        return self._sample(
+            size,
+            dtype,
+            lambda thunk, stream: thunk.random_normal(
+                stacklevel=3, stream=stream
+            ),
+        )
+
+    def normal(self, loc=0.0, scale=1.0, size=None):
+        if scale < 0:
+            raise ValueError("scale < 0")
+        result = self.standard_normal(size)
+        return result * scale + loc
+
+    def integers(
+        self, low, high=None, size=None, dtype=np.int64, endpoint=False
+    ):
+        if high is None:
+            low, high = 0, low
+        if endpoint:
+            high = high + 1
+        if low >= high:
+            raise ValueError("low >= high")
+        dtype = np.dtype(dtype)
+        if dtype.kind not in ("i", "u"):
+            raise TypeError(
+                "cunumeric.random.Generator.integers must be given an "
+                "integer dtype"
+            )
+        return self._sample(
+            size,
+            dtype,
+            lambda thunk, stream: thunk.random_integer(
+                low=low, high=high, stacklevel=3, stream=stream
+            ),
+        )
+
+    def permutation(self, x):
+        if isinstance(x, (int, np.integer)):
+            if x < 0:
+                raise ValueError("negative dimensions are not allowed")
+            result = ndarray((int(x),), dtype=np.dtype(np.int64))
+            # The bijection maps the indices themselves, so every call takes
+            # a key of its own rather than a range of counters
+            key, base = self._stream(_VALUES_PER_COUNTER)
+            stream = (_mix(key, base) & 0xFFFFFFFF, 0)
+            result._thunk.random_permutation(stacklevel=2, stream=stream)
+            return result
+        x = ndarray.convert_to_cunumeric_ndarray(x)
+        if x.ndim == 0:
+            raise IndexError("x must be an integer or at least 1-dimensional")
+        return _take_rows(x, self.permutation(x.shape[0]))
+
+    def shuffle(self, x):
+        if not isinstance(x, ndarray):
+            raise TypeError(
+                "cunumeric.random.Generator.shuffle needs an ndarray"
+            )
+        if x.ndim == 0:
+            raise TypeError("shuffle needs an array of at least one dimension")
+        x[:] = _take_rows(x, self.permutation(x.shape[0]))
+
+    def _distribution(self, gen_code, params, size, dtype):
+        args = [np.array(param, type(param)) for param in params]
+        return self._sample(
+            size,
+            dtype,
+            lambda thunk, stream: thunk.random_distribution(
+                gen_code, args, stacklevel=3, stream=stream
+            ),
+        )
+
+    def exponential(self, scale=1.0, size=None):
+        if scale < 0:
+            raise ValueError("scale < 0")
+        return self._distribution(
+            RandGenCode.EXPONENTIAL, [float(scale)], size, np.float64
+        )
+
+    def gamma(self, shape, scale=1.0, size=None):
+        if shape < 0:
+            raise ValueError("shape < 0")
+        if scale < 0:
+            raise ValueError("scale < 0")
+        return self._distribution(
+            RandGenCode.GAMMA, [float(shape), float(scale)], size, np.float64
+        )
+
+    def beta(self, a, b, size=None):
+        if a <= 0:
+            raise ValueError("a <= 0")
+        if b <= 0:
+            raise ValueError("b <= 0")
+        return self._distribution(
+            RandGenCode.BETA, [float(a), float(b)], size, np.float64
+        )
+
+    def poisson(self, lam=1.0, size=None):
+        if lam < 0:
+            raise ValueError("lam < 0")
+        return self._distribution(
+            RandGenCode.POISSON, [float(lam)], size, np.int64
+        )
+
+    def binomial(self, n, p, size=None):
+        if n < 0:
+            raise ValueError("n < 0")
+        if not 0 <= p <= 1:
+            raise ValueError("p < 0, p > 1 or p is NaN")
+        return self._distribution(
+            RandGenCode.BINOMIAL, [int(n), float(p)], size, np.int64
+        )
+
+    def bernoulli(self, p=0.5, size=None, dtype=bool):
+        if not 0 <= p <= 1:
+            raise ValueError("p < 0, p > 1 or p is NaN")
+        return self._sample(
+            size,
+            dtype,
+            lambda thunk, stream: thunk.random_bernoulli(
+                p, 1, 0, stacklevel=3, stream=stream
+            ),
+        )
+
+
+def default_rng(seed=None):
+    if isinstance(seed, Generator):
+        return seed
+    return Generator(seed)
@@ -16,8 +16,12 @@
 from __future__ import absolute_import, division, print_function
 
 import inspect
+import json
+import os
 import struct
 import sys
+import tempfile
+import weakref
 from functools import reduce
 
 import numpy as np
@@ -26,12 +30,27 @@ import legate.core.types as ty
 from legate.core import LEGATE_MAX_DIM, AffineTransform, Rect, legion
 from legate.core.runtime import RegionField
 
+from .calibration import calibrate, load_calibration
 from .config import *  # noqa F403
 from .deferred import DeferredArray
 from .eager import EagerArray
+from .fusion import (
+    ElementWindow,
+    FusionWindow,
+    LaunchWindow,
+    ProductWindow,
+    StoreRecycler,
+)
 from .lazy import LazyArray
 from .thunk import NumPyThunk
-from .utils import calculate_volume, get_arg_dtype
+from .utils import (
+    calculate_volume,
+    get_arg_dtype,
+    get_binned_sum_dtype,
+    get_logsumexp_dtype,
+    get_norm_dtype,
+    get_welford_dtype,
+)
 
 
 class Callsite(object):
@@ -70,6 +89,14 @@ class Callsite(object):
         )
 
 
+# The most stores of scalar arguments that are kept for reuse
+_MAX_SCALAR_ARGS = 256
+
+# How many times the eager volume an array computed only from eager arrays
+# can have and still stay eager. Arrays near the boundary then keep the
+# kind of their inputs instead of migrating every time their size crosses it.
+_EAGER_HYSTERESIS = 2
+
 _supported_dtypes = {
     np.bool_: ty.bool_,
     np.int8: ty.int8,
@@ -94,15 +121,32 @@ _supported_dtypes = {
 class Runtime(object):
     __slots__ = [
         "callsite_summaries",
+        "complex_3m",
         "current_random_epoch",
         "destroyed",
+        "deterministic",
+        "elements",
+        "fast_math",
+        "fast_random",
+        "fusion",
+        "half_matmul_output",
+        "launches",
         "legate_context",
         "legate_runtime",
         "max_eager_volume",
+        "min_cholesky_matrix_size",
+        "memory_report",
+        "min_cholesky_tile_size",
         "num_gpus",
         "num_procs",
+        "operation_callsites",
+        "pin_host_memory",
         "preload_cudalibs",
+        "products",
+        "recycler",
+        "roofline",
         "shadow_debug",
+        "stream_chunk_size",
         "test_mode",
     ]
 
@@ -111,6 +155,8 @@ class Runtime(object):
         self.legate_runtime = get_legate_runtime()
         self.current_random_epoch = 0
         self.destroyed = False
+        # Stores of the scalar arguments of tasks, by type and value
+        self._scalar_args = dict()
 
         self.max_eager_volume = self.legate_context.get_tunable(
             CuNumericTunable.MAX_EAGER_VOLUME,
@@ -124,6 +170,14 @@ class Runtime(object):
             CuNumericTunable.NUM_GPUS,
             ty.int32,
         )
+        self.min_cholesky_tile_size = self.legate_context.get_tunable(
+            CuNumericTunable.MIN_CHOLESKY_TILE_SIZE,
+            ty.int32,
+        )
+        self.min_cholesky_matrix_size = self.legate_context.get_tunable(
+            CuNumericTunable.MIN_CHOLESKY_MATRIX_SIZE,
+            ty.int32,
+        )
 
         # Make sure that our CuNumericLib object knows about us so it can
         # destroy us
@@ -132,6 +186,37 @@ class Runtime(object):
         self._parse_command_args()
         if self.num_gpus > 0 and self.preload_cudalibs:
             self._load_cudalibs()
+        self._apply_calibration()
+
+    # Replaces the eager volume that the mapper derives from the chunk sizes
+    # with the one measured on this machine. The measurement is taken when
+    # asked for with -cunumeric:calibrate or CUNUMERIC_CALIBRATE=1 and is
+    # kept for later runs, unless the chunk sizes are set explicitly.
+    def _apply_calibration(self):
+        try:
+            # Prune it out so the application does not see it
+            sys.argv.remove("-cunumeric:calibrate")
+            measure = True
+        except ValueError:
+            measure = os.environ.get("CUNUMERIC_CALIBRATE", "0") != "0"
+        if self.test_mode or self.shadow_debug:
+            return
+        if measure:
+            calibration = calibrate(self)
+        elif any(
+            var in os.environ
+            for var in (
+                "CUNUMERIC_EAGER_FRACTION",
+                "CUNUMERIC_MIN_CPU_CHUNK",
+                "CUNUMERIC_MIN_GPU_CHUNK",
+                "CUNUMERIC_MIN_OMP_CHUNK",
+            )
+        ):
+            return
+        else:
+            calibration = load_calibration(self)
+        if calibration is not None and "max_eager_volume" in calibration:
+            self.max_eager_volume = int(calibration["max_eager_volume"])
 
     def _register_dtypes(self):
         type_system = self.legate_context.type_system
@@ -163,6 +248,124 @@ class Runtime(object):
             self.preload_cudalibs = True
         except ValueError:
             self.preload_cudalibs = False
+        try:
+            # Prune it out so the application does not see it
+            sys.argv.remove("-cunumeric:fusion")
+            self.fusion = FusionWindow(self)
+        except ValueError:
+            self.fusion = None
+        # Tasks that write fresh arrays are held back and submitted in runs,
+        # and the ones whose results are never read are dropped
+        try:
+            # Prune it out so the application does not see it
+            sys.argv.remove("-cunumeric:launch-window")
+            launch_window = True
+        except ValueError:
+            launch_window = (
+                int(os.environ.get("CUNUMERIC_LAUNCH_WINDOW", "0")) > 0
+            )
+        self.launches = LaunchWindow(self) if launch_window else None
+        # The stores of temporaries that die are kept for the next ones of
+        # the same shape and type
+        try:
+            # Prune it out so the application does not see it
+            sys.argv.remove("-cunumeric:recycle-stores")
+            recycle_stores = True
+        except ValueError:
+            recycle_stores = (
+                int(os.environ.get("CUNUMERIC_RECYCLE_STORES", "0")) > 0
+            )
+        self.recycler = StoreRecycler(self) if recycle_stores else None
+        # The task bodies of a build with CUNUMERIC_ROOFLINE=1 are measured
+        # and their totals are written to this file when the program ends,
+        # together with the operations that each callsite issued
+        try:
+            # Prune it out so the application does not see it
+            sys.argv.remove("-cunumeric:roofline")
+            self.roofline = "cunumeric_roofline.json"
+        except ValueError:
+            self.roofline = os.environ.get("CUNUMERIC_ROOFLINE")
+        # The peak memory of each task is recorded for memory_report, which
+        # the mapper and the tasks read from the environment
+        self.memory_report = (
+            int(os.environ.get("CUNUMERIC_MEMORY_REPORT", "0")) > 0
+        )
+        # The operations that each callsite issued, which the roofline and
+        # the memory report tie the tasks back to
+        self.operation_callsites = (
+            dict()
+            if self.roofline is not None or self.memory_report
+            else None
+        )
+        # Floating point sums come out with the same bits however the work
+        # is partitioned, at some cost in performance
+        try:
+            # Prune it out so the application does not see it
+            sys.argv.remove("-cunumeric:deterministic")
+            self.deterministic = True
+        except ValueError:
+            self.deterministic = (
+                os.environ.get("CUNUMERIC_DETERMINISTIC", "0") != "0"
+            )
+        # Transcendental functions of float32 arrays trade a few ULPs for
+        # speed unless a call asks otherwise, see src/cunumeric/fast_math.h
+        try:
+            # Prune it out so the application does not see it
+            sys.argv.remove("-cunumeric:fast-math")
+            self.fast_math = True
+        except ValueError:
+            self.fast_math = os.environ.get("CUNUMERIC_FAST_MATH", "0") != "0"
+        # Float16 matrix products are written in half precision directly
+        # instead of through a float32 temporary. They still accumulate in
+        # float32 inside each GEMM, but partial products of a partitioned
+        # inner dimension are summed in half precision.
+        try:
+            # Prune it out so the application does not see it
+            sys.argv.remove("-cunumeric:half-matmul-output")
+            self.half_matmul_output = True
+        except ValueError:
+            self.half_matmul_output = (
+                os.environ.get("CUNUMERIC_HALF_MATMUL_OUTPUT", "0") != "0"
+            )
+        # Complex contractions that are GEMMs use the 3M method, which does
+        # three real products instead of four and is a little less accurate
+        try:
+            # Prune it out so the application does not see it
+            sys.argv.remove("-cunumeric:complex-3m")
+            self.complex_3m = True
+        except ValueError:
+            self.complex_3m = (
+                os.environ.get("CUNUMERIC_COMPLEX_3M", "0") != "0"
+            )
+        # Random arrays come from generators that are seeded per block of
+        # points, which are faster but only give the same values for the same
+        # partitioning
+        try:
+            # Prune it out so the application does not see it
+            sys.argv.remove("-cunumeric:fast-random")
+            self.fast_random = True
+        except ValueError:
+            self.fast_random = (
+                os.environ.get("CUNUMERIC_FAST_RANDOM", "0") != "0"
+            )
+        # NumPy arrays that are attached to are page-locked so that copies
+        # to the GPUs don't stage through pageable memory
+        try:
+            # Prune it out so the application does not see it
+            sys.argv.remove("-cunumeric:pin-host-memory")
+            self.pin_host_memory = True
+        except ValueError:
+            self.pin_host_memory = (
+                os.environ.get("CUNUMERIC_PIN_HOST_MEMORY", "0") != "0"
+            )
+        # Element-wise operations and reductions of arrays larger than this
+        # many bytes are issued one block at a time, which lets arrays that
+        # don't fit in GPU memory stream through it
+        self.stream_chunk_size = (
+            int(os.environ.get("CUNUMERIC_STREAM_CHUNK_SIZE", "0")) << 20
+        )
+        self.products = ProductWindow()
+        self.elements = ElementWindow(self)
 
     def _load_cudalibs(self):
         task = self.legate_context.create_task(
@@ -189,15 +392,84 @@ class Runtime(object):
             code = type_system[value_dtype].code
             dtype = type_system.add_type(arg_dtype, arg_dtype.itemsize, code)
 
-            for redop in CuNumericRedopCode:
+            for redop in (
+                CuNumericRedopCode.ARGMAX,
+                CuNumericRedopCode.ARGMIN,
+            ):
                 redop_id = self.legate_context.get_reduction_op_id(
                     redop.value * legion.MAX_TYPE_NUMBER + code
                 )
                 dtype.register_reduction_op(redop, redop_id)
         return arg_dtype
 
+    def get_variance_dtype(self, value_dtype):
+        welford_dtype = get_welford_dtype(value_dtype)
+        type_system = self.legate_context.type_system
+        if welford_dtype not in type_system:
+            # Like Argval<T>, Welford<T> gets T's type code
+            code = type_system[value_dtype].code
+            dtype = type_system.add_type(
+                welford_dtype, welford_dtype.itemsize, code
+            )
+            redop = CuNumericRedopCode.VARIANCE
+            redop_id = self.legate_context.get_reduction_op_id(
+                redop.value * legion.MAX_TYPE_NUMBER + code
+            )
+            dtype.register_reduction_op(redop, redop_id)
+        return welford_dtype
+
+    def get_binned_sum_dtype(self, value_dtype):
+        binned_dtype = get_binned_sum_dtype(value_dtype)
+        type_system = self.legate_context.type_system
+        if binned_dtype not in type_system:
+            code = type_system[value_dtype].code
+            dtype = type_system.add_type(
+                binned_dtype, binned_dtype.itemsize, code
+            )
+            redop = CuNumericRedopCode.BINNED_SUM
+            redop_id = self.legate_context.get_reduction_op_id(
+                redop.value * legion.MAX_TYPE_NUMBER + code
+            )
+            dtype.register_reduction_op(redop, redop_id)
+        return binned_dtype
+
+    def get_norm_dtype(self, value_dtype):
+        norm_dtype = get_norm_dtype(value_dtype)
+        type_system = self.legate_context.type_system
+        if norm_dtype not in type_system:
+            code = type_system[value_dtype].code
+            dtype = type_system.add_type(norm_dtype, norm_dtype.itemsize, code)
+            redop = CuNumericRedopCode.NORM
+            redop_id = self.legate_context.get_reduction_op_id(
+                redop.value * legion.MAX_TYPE_NUMBER + code
+            )
+            dtype.register_reduction_op(redop, redop_id)
+        return norm_dtype
+
+    def get_logsumexp_dtype(self, value_dtype):
+        lse_dtype = get_logsumexp_dtype(value_dtype)
+        type_system = self.legate_context.type_system
+        if lse_dtype not in type_system:
+            code = type_system[value_dtype].code
+            dtype = type_system.add_type(lse_dtype, lse_dtype.itemsize, code)
+            redop = CuNumericRedopCode.LOGSUMEXP
+            redop_id = self.legate_context.get_reduction_op_id(
+                redop.value * legion.MAX_TYPE_NUMBER + code
+            )
+            dtype.register_reduction_op(redop, redop_id)
+        return lse_dtype
+
     def destroy(self):
         assert not self.destroyed
+        if self.fusion is not None:
+            self.fusion.flush()
+        if self.launches is not None:
+            self.launches.flush()
+        if self.recycler is not None:
+            self.recycler.clear()
+        self._scalar_args.clear()
+        if self.roofline is not None:
+            self._dump_roofline()
         if self.num_gpus > 0:
             self._unload_cudalibs()
         if self.callsite_summaries is not None:
@@ -238,6 +510,79 @@ class Runtime(object):
             self.callsite_summaries = None
         self.destroyed = True
 
+    def _dump_roofline(self):
+        # All tasks have to finish for their bodies to be counted
+        self.legate_runtime.issue_execution_fence(block=True)
+        path = self.roofline
+        if not cunumeric_lib.shared_object.cunumeric_roofline_dump(
+            path.encode()
+        ):
+            print(
+                "cuNumeric was not built with CUNUMERIC_ROOFLINE=1 or cannot "
+                "write to " + path + ", so no roofline is recorded"
+            )
+            return
+        with open(path, "r") as f:
+            report = json.load(f)
+        op_codes = {
+            "binary_op": BinaryOpCode,
+            "scalar_unary_red": UnaryRedCode,
+            "unary_op": UnaryOpCode,
+            "unary_red": UnaryRedCode,
+        }
+        for task in report["tasks"]:
+            if task["task"] in op_codes:
+                task["op"] = op_codes[task["task"]](task["op_code"]).name
+            seconds = task["seconds"]
+            task["GB/s"] = task["bytes"] / seconds / 1e9 if seconds else 0.0
+            task["GFLOP/s"] = task["flops"] / seconds / 1e9 if seconds else 0.0
+        report["callsites"] = self._operation_callsites()
+        with open(path, "w") as f:
+            json.dump(report, f, indent=2)
+
+    def _operation_callsites(self):
+        return [
+            {
+                "function": callsite.funcname,
+                "file": callsite.filename,
+                "line": callsite.lineno,
+                "operations": dict(operations),
+            }
+            for callsite, operations in sorted(
+                self.operation_callsites.items(),
+                key=lambda site: (site[0].filename, site[0].lineno),
+            )
+        ]
+
+    def get_memory_report(self):
+        if not self.memory_report:
+            raise RuntimeError(
+                "Set CUNUMERIC_MEMORY_REPORT=1 to record the memory of tasks"
+            )
+        # The temporaries of a task are only known once it has run
+        self.legate_runtime.issue_execution_fence(block=True)
+        with tempfile.TemporaryDirectory() as directory:
+            path = os.path.join(directory, "memory.json")
+            if not cunumeric_lib.shared_object.cunumeric_memory_report(
+                path.encode()
+            ):
+                raise RuntimeError("cuNumeric cannot write its memory report")
+            with open(path, "r") as f:
+                report = json.load(f)
+        for task in report["tasks"]:
+            try:
+                task["task"] = CuNumericOpCode(task["task_id"]).name.lower()
+            except ValueError:
+                task["task"] = str(task["task_id"])
+        report["tasks"].sort(
+            key=lambda task: max(
+                [task["temporaries"]] + list(task["instances"].values())
+            ),
+            reverse=True,
+        )
+        report["callsites"] = self._operation_callsites()
+        return report
+
     def create_callsite(self, stacklevel):
         assert stacklevel > 0
         stack = inspect.stack()
@@ -251,12 +596,23 @@ class Runtime(object):
             caller_frame[5],
         )
 
-    def profile_callsite(self, stacklevel, accelerated, callsite=None):
-        if self.callsite_summaries is None:
+    def profile_callsite(
+        self, stacklevel, accelerated, callsite=None, operation=None
+    ):
+        if (
+            self.callsite_summaries is None
+            and self.operation_callsites is None
+        ):
             return
         if callsite is None:
             callsite = self.create_callsite(stacklevel + 1)
         assert isinstance(callsite, Callsite)
+        # Tie the tasks that are measured back to the callsites
+        if self.operation_callsites is not None and operation is not None:
+            operations = self.operation_callsites.setdefault(callsite, dict())
+            operations[operation] = operations.get(operation, 0) + 1
+        if self.callsite_summaries is None:
+            return
         # Record the callsite if we haven't done so already
         if callsite in self.callsite_summaries:
             counts = self.callsite_summaries[callsite]
@@ -281,12 +637,35 @@ class Runtime(object):
                 optimize_scalar=True,
             )
             result = DeferredArray(self, store, dtype=dtype)
+            if self.is_host_scalar_type(dtype):
+                result._scalar_value = np.frombuffer(
+                    data, dtype=dtype, count=1
+                )[0]
             if self.shadow_debug:
                 result.shadow = EagerArray(self, np.array(array))
         else:
             result = future
         return result
 
+    # The store that passes a one-element array to a task as an input. The
+    # stores are only ever read, so the same one serves every task that gets
+    # the same value, like the bounds of a clip in a loop, instead of making
+    # a new future for each launch.
+    def get_scalar_arg(self, numpy_array):
+        key = (numpy_array.dtype.str, numpy_array.tobytes())
+        store = self._scalar_args.get(key)
+        if store is None:
+            if len(self._scalar_args) >= _MAX_SCALAR_ARGS:
+                self._scalar_args.clear()
+            store = self.create_scalar(
+                numpy_array.data,
+                numpy_array.dtype,
+                shape=(1,),
+                wrap=True,
+            ).base
+            self._scalar_args[key] = store
+        return store
+
     def set_next_random_epoch(self, epoch):
         self.current_random_epoch = epoch
 
@@ -295,6 +674,15 @@ class Runtime(object):
         # self.current_random_epoch += 1
         return result
 
+    @staticmethod
+    def is_host_scalar_type(dtype):
+        # Types that tasks can receive as scalar arguments
+        dtype = np.dtype(dtype)
+        return dtype.kind in ("b", "i", "u") or dtype in (
+            np.float32,
+            np.float64,
+        )
+
     def is_supported_type(self, dtype):
         return np.dtype(dtype) in self.legate_context.type_system
 
@@ -442,6 +830,35 @@ class Runtime(object):
         else:
             return key
 
+    @staticmethod
+    def compute_view_permutation(array):
+        # Views that permute the dimensions of their parent, like transposes,
+        # are affine views of the parent once the dimensions are put back in
+        # the order of decreasing strides. Added dimensions stay where they
+        # are. Returns None if the dimensions are already in that order.
+        strides = array.strides
+        if any(stride < 0 for stride in strides):
+            return None
+        moving = [dim for dim in range(array.ndim) if strides[dim] != 0]
+        ordered = sorted(moving, key=lambda dim: -strides[dim])
+        if ordered == moving:
+            return None
+        axes = list(range(array.ndim))
+        for (pos, dim) in zip(moving, ordered):
+            axes[pos] = dim
+        return tuple(axes)
+
+    def _pin_host_memory(self, array):
+        ptr = array.ctypes.data
+        lib = cunumeric_lib.shared_object
+        if lib.cunumeric_pin_host_memory(ptr, array.nbytes):
+            # The memory has to be unregistered before NumPy frees it, but
+            # there's nothing to do once the process is shutting down
+            finalizer = weakref.finalize(
+                array, lib.cunumeric_unpin_host_memory, ptr
+            )
+            finalizer.atexit = False
+
     def find_or_create_array_thunk(
         self, array, stacklevel, share=False, defer=False
     ):
@@ -455,6 +872,26 @@ class Runtime(object):
         if array.base is not None and isinstance(array.base, np.ndarray):
             key = self.compute_parent_child_mapping(array)
             if key is None:
+                axes = self.compute_view_permutation(array)
+                if axes is not None:
+                    thunk = self.find_or_create_array_thunk(
+                        array.transpose(axes),
+                        stacklevel=(stacklevel + 1),
+                        share=share,
+                        defer=defer,
+                    )
+                    # Undo the permutation with views of the attached thunk,
+                    # where dimension i of the thunk is dimension order[i]
+                    # of the array
+                    order = list(axes)
+                    for dim in range(array.ndim):
+                        src = order.index(dim)
+                        if src != dim:
+                            thunk = thunk.swapaxes(
+                                dim, src, stacklevel=(stacklevel + 1)
+                            )
+                            order[dim], order[src] = order[src], order[dim]
+                    return thunk
                 # This base array wasn't made with a view
                 if not share:
                     return self.find_or_create_array_thunk(
@@ -506,6 +943,8 @@ class Runtime(object):
                     shape=array.shape,
                     optimize_scalar=False,
                 )
+                if self.pin_host_memory and self.num_gpus > 0:
+                    self._pin_host_memory(array)
                 store.attach_external_allocation(
                     self.legate_context,
                     array.data,
@@ -524,6 +963,10 @@ class Runtime(object):
             assert not defer
             # Make this into an eager evaluated thunk
             result = EagerArray(self, array)
+            # The application can still see a shared array, so it must not
+            # be handed over to Legion when this migrates
+            if share:
+                result.record_escape()
         return result
 
     def create_empty_thunk(self, shape, dtype, inputs=None):
@@ -531,12 +974,19 @@ class Runtime(object):
         if type(shape) == int:
             shape = (shape,)
         if self.is_supported_type(dtype) and not (
-            self.is_eager_shape(shape) and self.are_all_eager_inputs(inputs)
+            self.is_eager_shape(shape, stay_eager=bool(inputs))
+            and self.are_all_eager_inputs(inputs)
         ):
-            store = self.legate_context.create_store(
-                dtype, shape=shape, optimize_scalar=True
-            )
+            store = None
+            if self.recycler is not None:
+                store = self.recycler.take(shape, np.dtype(dtype))
+            if store is None:
+                store = self.legate_context.create_store(
+                    dtype, shape=shape, optimize_scalar=True
+                )
             result = DeferredArray(self, store, dtype=dtype)
+            result._fresh = True
+            result._owns_store = True
             # If we're doing shadow debug make an EagerArray shadow
             if self.shadow_debug:
                 result.shadow = EagerArray(
@@ -552,7 +1002,7 @@ class Runtime(object):
         store = self.legate_context.create_store(dtype)
         return DeferredArray(self, store, dtype=dtype)
 
-    def is_eager_shape(self, shape):
+    def is_eager_shape(self, shape, stay_eager=False):
         volume = calculate_volume(shape)
         # Empty arrays are ALWAYS eager
         if volume == 0:
@@ -564,7 +1014,10 @@ class Runtime(object):
             return True
         if len(shape) == 0:
             return self.max_eager_volume > 0
-        # See if the volume is large enough
+        # See if the volume is large enough. Arrays computed from eager
+        # arrays get some slack so they don't force their inputs to migrate.
+        if stay_eager:
+            return volume <= self.max_eager_volume * _EAGER_HYSTERESIS
         return volume <= self.max_eager_volume
 
     @staticmethod
@@ -591,6 +1044,9 @@ class Runtime(object):
 
     def to_eager_array(self, array, stacklevel):
         if self.is_eager_array(array):
+            # A migrated array only has its values in the deferred one
+            if array.deferred is not None:
+                return self.to_eager_array(array.deferred, stacklevel + 1)
             return array
         elif self.is_deferred_array(array):
             return EagerArray(self, array.__numpy_array__())
@@ -0,0 +1,187 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+
+from .array import ndarray
+
+
+def _spmm_dtype(*dtypes):
+    dtype = np.result_type(*dtypes)
+    if dtype.kind not in ("f", "c") or dtype == np.float16:
+        dtype = np.dtype(np.float64)
+    return dtype
+
+
+class csr_matrix(object):
+    """
+    Sparse matrix in the compressed sparse row (CSR) format, with the same
+    layout as ``scipy.sparse.csr_matrix``: the column indices and values of
+    the nonzeros of row ``i`` are ``indices[indptr[i]:indptr[i + 1]]`` and
+    ``data[indptr[i]:indptr[i + 1]]``. The three arrays are cuNumeric
+    arrays, so the matrix never has to be densified to be multiplied with
+    dense vectors and matrices. This class is a cuNumeric extension.
+
+    Parameters
+    ----------
+    arg : array_like or tuple
+        Either a dense two-dimensional array, or a tuple
+        ``(data, indices, indptr)``.
+    shape : tuple of ints, optional
+        Shape of the matrix, which is inferred from the indices when it is
+        not given.
+    dtype : data-type, optional
+        Type of the values. Integer and half precision values are stored as
+        float64, as products are only computed in single and double
+        precision.
+    """
+
+    def __init__(self, arg, shape=None, dtype=None):
+        if isinstance(arg, tuple):
+            if len(arg) != 3:
+                raise ValueError(
+                    "csr_matrix takes a tuple (data, indices, indptr)"
+                )
+            data, indices, indptr = arg
+            # The row pointers stay on the host as well, where they decide
+            # how the rows are split among the processors
+            host_indptr = np.asarray(indptr, dtype=np.int64)
+            if host_indptr.ndim != 1 or host_indptr.size == 0:
+                raise ValueError("indptr must be a non-empty 1-D array")
+            if shape is None:
+                host_indices = np.asarray(indices)
+                num_cols = int(host_indices.max()) + 1 if len(indices) else 0
+                shape = (host_indptr.size - 1, num_cols)
+        else:
+            dense = np.asarray(arg)
+            if dense.ndim != 2:
+                raise ValueError("csr_matrix needs a two-dimensional array")
+            rows, indices = np.nonzero(dense)
+            data = dense[rows, indices]
+            counts = np.bincount(rows, minlength=dense.shape[0])
+            host_indptr = np.concatenate(([0], np.cumsum(counts)))
+            host_indptr = host_indptr.astype(np.int64)
+            if shape is None:
+                shape = dense.shape
+
+        shape = tuple(int(extent) for extent in shape)
+        if len(shape) != 2:
+            raise ValueError("csr_matrix must be two-dimensional")
+        if host_indptr.size != shape[0] + 1:
+            raise ValueError(
+                f"indptr has {host_indptr.size} entries for {shape[0]} rows"
+            )
+
+        data = ndarray.convert_to_cunumeric_ndarray(data)
+        indices = ndarray.convert_to_cunumeric_ndarray(indices)
+        if data.ndim != 1 or indices.ndim != 1:
+            raise ValueError("data and indices must be 1-D arrays")
+        if data.shape != indices.shape or data.size != host_indptr[-1]:
+            raise ValueError(
+                f"{host_indptr[-1]} nonzeros given {data.size} values and "
+                f"{indices.size} indices"
+            )
+
+        dtype = _spmm_dtype(data.dtype if dtype is None else dtype)
+        self.shape = shape
+        self.data = data if data.dtype == dtype else data.astype(dtype)
+        self.indices = (
+            indices if indices.dtype == np.int64 else indices.astype(np.int64)
+        )
+        self.indptr = ndarray.convert_to_cunumeric_ndarray(host_indptr)
+        self._host_indptr = host_indptr
+
+    @property
+    def dtype(self):
+        return self.data.dtype
+
+    @property
+    def ndim(self):
+        return 2
+
+    @property
+    def nnz(self):
+        return self.data.size
+
+    def dot(self, other, out=None, stacklevel=1):
+        """
+        Multiply the matrix with a dense vector or matrix.
+
+        Parameters
+        ----------
+        other : array_like
+            Dense array of shape ``(N,)`` or ``(N, K)`` for a matrix of
+            shape ``(M, N)``.
+        out : ndarray, optional
+            Array of shape ``(M,)`` or ``(M, K)`` for the result.
+
+        Returns
+        -------
+        output : ndarray
+            The product, of shape ``(M,)`` or ``(M, K)``.
+        """
+        rhs = ndarray.convert_to_cunumeric_ndarray(other)
+        if rhs.ndim not in (1, 2):
+            raise ValueError(
+                "csr_matrix can only be multiplied with 1-D or 2-D arrays"
+            )
+        if rhs.shape[0] != self.shape[1]:
+            raise ValueError(
+                f"shapes {self.shape} and {rhs.shape} not aligned"
+            )
+
+        dtype = _spmm_dtype(self.dtype, rhs.dtype)
+        vals = self.data if self.dtype == dtype else self.data.astype(dtype)
+        if rhs.dtype != dtype:
+            rhs = rhs.astype(dtype)
+
+        result = ndarray(
+            shape=(self.shape[0],) + rhs.shape[1:],
+            dtype=dtype,
+            stacklevel=stacklevel + 1,
+            inputs=(vals, rhs),
+        )
+        if result.size > 0:
+            result._thunk.spmm(
+                self.indptr._thunk,
+                self.indices._thunk,
+                vals._thunk,
+                rhs._thunk,
+                self._host_indptr,
+                stacklevel=(stacklevel + 1),
+            )
+        if out is None:
+            return result
+        out[...] = result
+        return out
+
+    def __matmul__(self, other):
+        return self.dot(other, stacklevel=2)
+
+    def toarray(self):
+        """
+        Return the dense version of the matrix.
+        """
+        dense = np.zeros(self.shape, dtype=self.dtype)
+        counts = np.diff(self._host_indptr)
+        rows = np.repeat(np.arange(self.shape[0]), counts)
+        dense[rows, np.asarray(self.indices)] = np.asarray(self.data)
+        return ndarray.convert_to_cunumeric_ndarray(dense)
+
+    def __repr__(self):
+        return (
+            f"<{self.shape[0]}x{self.shape[1]} cuNumeric csr_matrix of type "
+            f"{self.dtype} with {self.nnz} stored elements>"
+        )
@@ -80,6 +80,24 @@ class NumPyThunk(object):
         """
         pass
 
+    @property
+    def exclusive(self):
+        """Return whether nothing but the one ndarray wrapping this thunk
+        can see its storage
+
+        :meta private:
+        """
+        return False
+
+    @property
+    def value_known(self):
+        """Return whether the value of this scalar thunk can be read without
+        waiting on the tasks that produce it
+
+        :meta private:
+        """
+        return False
+
     def imag(self, stacklevel):
         """Return a thunk for the imaginary part of this complex array
 
@@ -130,6 +148,14 @@ class NumPyThunk(object):
         """
         raise NotImplementedError("Implement in derived classes")
 
+    def scatter_reduce(self, key, value, op, stacklevel):
+        """Fold the value into the points of the thunk that the index arrays
+        in the key select with the NumPy ufunc named op, as ufunc.at does
+
+        :meta private:
+        """
+        raise NotImplementedError("Implement in derived classes")
+
     def reshape(self, newshape, order, stacklevel):
         """Reshape the array using the same backing storage if possible
 
@@ -165,6 +191,22 @@ class NumPyThunk(object):
         """
         raise NotImplementedError("Implement in derived classes")
 
+    def load_npy(self, path, offset, stacklevel):
+        """Read this thunk from the data of an .npy file, which starts at the
+        offset
+
+        :meta private:
+        """
+        raise NotImplementedError("Implement in derived classes")
+
+    def save_npy(self, path, offset, stacklevel):
+        """Write this thunk to the data of an .npy file, which starts at the
+        offset
+
+        :meta private:
+        """
+        raise NotImplementedError("Implement in derived classes")
+
     def dot(self, rhs1, rhs2, stacklevel):
         """Perform a dot operation on our thunk
 
@@ -172,6 +214,94 @@ class NumPyThunk(object):
         """
         raise NotImplementedError("Implement in derived classes")
 
+    def spmm(self, pos, crd, vals, rhs, indptr, stacklevel):
+        """Multiply the CSR matrix with row pointers pos, column indices crd
+        and values vals with rhs into our thunk. indptr is a host copy of
+        the row pointers
+
+        :meta private:
+        """
+        raise NotImplementedError("Implement in derived classes")
+
+    def quantize(self, scales, values, bits, stacklevel):
+        """Compress the rows of values into our thunk as blocks of codes
+        with bits bits each, writing the scale of every block into scales
+
+        :meta private:
+        """
+        raise NotImplementedError("Implement in derived classes")
+
+    def dequantize(self, codes, scales, bits, stacklevel):
+        """Decompress the block-quantized rows of codes and scales into our
+        thunk
+
+        :meta private:
+        """
+        raise NotImplementedError("Implement in derived classes")
+
+    def quantized_matvec(self, codes, scales, rhs, bits, stacklevel):
+        """Multiply the block-quantized matrix of codes and scales with the
+        vector rhs into our thunk
+
+        :meta private:
+        """
+        raise NotImplementedError("Implement in derived classes")
+
+    def fft(self, rhs, axes, kind, inverse, scale, stacklevel):
+        """Transform rhs along the axes into our thunk, with the transform
+        type kind, and multiply the result with scale
+
+        :meta private:
+        """
+        raise NotImplementedError("Implement in derived classes")
+
+    def batched_matmul(self, rhs1, rhs2, scale, bias, activation, stacklevel):
+        """Perform a matrix product of two stacks of matrices on our thunk,
+        optionally followed by a scale, a bias and an activation
+
+        :meta private:
+        """
+        raise NotImplementedError("Implement in derived classes")
+
+    def solve(self, a, b, stacklevel):
+        """Solve the linear system a x = b into our thunk
+
+        :meta private:
+        """
+        raise NotImplementedError("Implement in derived classes")
+
+    def cholesky_solve(self, factor, b, stacklevel):
+        """Solve the linear system factor factor^H x = b into our thunk,
+        where factor is lower triangular
+
+        :meta private:
+        """
+        raise NotImplementedError("Implement in derived classes")
+
+    def batched_solve(self, a, stacklevel, b=None, cholesky=False):
+        """Solve the stack of linear systems a[i] x[i] = b[i] into our
+        thunk, or invert the matrices of a when b is None
+
+        :meta private:
+        """
+        raise NotImplementedError("Implement in derived classes")
+
+    def qr(self, a, q, stacklevel):
+        """Compute the R factor of the reduced QR decomposition of a into
+        our thunk, and its Q factor into q unless q is None
+
+        :meta private:
+        """
+        raise NotImplementedError("Implement in derived classes")
+
+    def svd(self, a, u, vh, stacklevel):
+        """Compute the singular values of a into our thunk, and its reduced
+        singular vectors into u and vh unless they are None
+
+        :meta private:
+        """
+        raise NotImplementedError("Implement in derived classes")
+
     def transpose(self, rhs, axes, stacklevel):
         """Perform a transpose operation on our thunk
 
@@ -195,6 +325,14 @@ class NumPyThunk(object):
         """
         raise NotImplementedError("Implement in derived classes")
 
+    def putmask(self, mask, values, stacklevel):
+        """Replace our values with those of values where mask is set,
+        leaving the others untouched
+
+        :meta private:
+        """
+        raise NotImplementedError("Implement in derived classes")
+
     def choose(
         self,
         *args,
@@ -223,6 +361,14 @@ class NumPyThunk(object):
         """
         raise NotImplementedError("Implement in derived classes")
 
+    def concatenate(self, sources, axis, stacklevel):
+        """Fill our thunk with the sources laid out one after another
+        along the axis
+
+        :meta private:
+        """
+        raise NotImplementedError("Implement in derived classes")
+
     def tile(self, rhs, reps, stacklevel):
         """Tile our thunk onto the target
 
@@ -230,6 +376,60 @@ class NumPyThunk(object):
         """
         raise NotImplementedError("Implement in derived classes")
 
+    def kron(self, rhs1, rhs2, stacklevel):
+        """Kronecker product of the two sources, which have as many
+        dimensions as our thunk
+
+        :meta private:
+        """
+        raise NotImplementedError("Implement in derived classes")
+
+    def repeat(self, rhs, repeats, axis, stacklevel):
+        """Repeat every element of the source repeats times along the axis
+
+        :meta private:
+        """
+        raise NotImplementedError("Implement in derived classes")
+
+    def pad(self, rhs, pad_width, mode, constant_value, stacklevel):
+        """Pad the source on both sides along every axis
+
+        :meta private:
+        """
+        raise NotImplementedError("Implement in derived classes")
+
+    def stencil(self, rhs, offsets, coefficients, stacklevel):
+        """Update the interior of the source with the weighted sum of the
+        neighbors at the offsets, copying the rest of it
+
+        :meta private:
+        """
+        raise NotImplementedError("Implement in derived classes")
+
+    def polyval(self, rhs, coefficients, stacklevel):
+        """Evaluate the polynomial with the coefficients, highest power
+        first, at every point of the source
+
+        :meta private:
+        """
+        raise NotImplementedError("Implement in derived classes")
+
+    def interp(self, x, xp, fp, left, right, stacklevel):
+        """Interpolate the piecewise linear function with the values fp at
+        the sorted breakpoints xp at the points of x
+
+        :meta private:
+        """
+        raise NotImplementedError("Implement in derived classes")
+
+    def rolling(self, rhs, op, axis, window, stacklevel):
+        """Reduce the window of the source that ends at every point along
+        the axis, clipped to the start of the array
+
+        :meta private:
+        """
+        raise NotImplementedError("Implement in derived classes")
+
     def bincount(self, rhs, stacklevel, weights=None):
         """Compute the bincount for the array
 
@@ -237,6 +437,55 @@ class NumPyThunk(object):
         """
         raise NotImplementedError("Implement in derived classes")
 
+    def histogram(self, rhs, edges, uniform, stacklevel, weights=None):
+        """Compute the histogram of the array over sorted bin edges
+
+        :meta private:
+        """
+        raise NotImplementedError("Implement in derived classes")
+
+    def segment_reduce(self, labels, values, op, stacklevel, counts=None):
+        """Fold every row of values into the row of the array that its label
+        picks, optionally counting the rows of every label
+
+        :meta private:
+        """
+        raise NotImplementedError("Implement in derived classes")
+
+    def kmeans_assign(
+        self,
+        points,
+        centroids,
+        stacklevel,
+        sums=None,
+        counts=None,
+        inertia=None,
+    ):
+        """Label every row of points with the index of its nearest row of
+        centroids, optionally summing up the clusters in the same pass
+
+        :meta private:
+        """
+        raise NotImplementedError("Implement in derived classes")
+
+    def lstm_gates(self, c, tanh_c, gates, pre, stacklevel, c_prev=None):
+        """Compute the hidden state of an LSTM step, along with its cell
+        state, the tanh of that and the activated gates, in one pass
+
+        :meta private:
+        """
+        raise NotImplementedError("Implement in derived classes")
+
+    def lstm_gates_backward(
+        self, gates, tanh_c, dh, stacklevel, dc=None, c_prev=None, dc_prev=None
+    ):
+        """Compute the gradients of the pre-activations and previous cell
+        state of an LSTM step in one pass
+
+        :meta private:
+        """
+        raise NotImplementedError("Implement in derived classes")
+
     def nonzero(self, stacklevel):
         """Return a tuple of thunks for the non-zero indices in each "
         "dimension
@@ -245,34 +494,110 @@ class NumPyThunk(object):
         """
         raise NotImplementedError("Implement in derived classes")
 
-    def sort(self, rhs, stacklevel):
-        """Sort the array
+    def argwhere(self, stacklevel):
+        """Return a thunk for the indices of the non-zero elements, one row
+        per element
 
         :meta private:
         """
         raise NotImplementedError("Implement in derived classes")
 
-    def random_uniform(self, low, high, stacklevel):
-        """Fill this array with a random uniform distribution
+    def unique(self, stacklevel):
+        """Return thunks for the distinct values and the number of times
+        each of them occurs, in no particular order
 
         :meta private:
         """
         raise NotImplementedError("Implement in derived classes")
 
-    def random_normal(self, stacklevel):
+    def topk(self, k, axis, largest, stacklevel):
+        """Return thunks for the values and indices of the k largest (or
+        smallest) elements along an axis, best first
+
+        :meta private:
+        """
+        raise NotImplementedError("Implement in derived classes")
+
+    def sort(self, rhs, argsort, stacklevel):
+        """Fill this array with rhs sorted along its last dimension, or with
+        the indices that sort it when argsort is True
+
+        :meta private:
+        """
+        raise NotImplementedError("Implement in derived classes")
+
+    def searchsorted(self, rhs, v, side, stacklevel):
+        """Fill this array with the indices at which the values in v would be
+        inserted into the sorted 1-D array rhs to keep it sorted
+
+        :meta private:
+        """
+        raise NotImplementedError("Implement in derived classes")
+
+    def scan(self, rhs, op, axis, stacklevel):
+        """Fill this array with the inclusive scan of rhs along an axis with
+        the SUM, PROD, MAX or MIN reduction
+
+        :meta private:
+        """
+        raise NotImplementedError("Implement in derived classes")
+
+    def random_uniform(self, low, high, stacklevel, stream=None):
+        """Fill this array with a random uniform distribution. Like the other
+        random methods, it draws from the (key, base) pair of a generator
+        when given a stream and from the global epoch otherwise.
+
+        :meta private:
+        """
+        raise NotImplementedError("Implement in derived classes")
+
+    def random_normal(self, stacklevel, stream=None):
         """Fill this array with a random normal distribution
 
         :meta private:
         """
         raise NotImplementedError("Implement in derived classes")
 
-    def random_integer(self, low, high, stacklevel):
+    def random_integer(self, low, high, stacklevel, stream=None):
         """Fill this array with a random integer distribution
 
         :meta private:
         """
         raise NotImplementedError("Implement in derived classes")
 
+    def random_permutation(self, stacklevel, stream=None):
+        """Fill this 1-D array with a random permutation of its indices
+
+        :meta private:
+        """
+        raise NotImplementedError("Implement in derived classes")
+
+    def random_bernoulli(
+        self, p, on_value, off_value, stacklevel, stream=None
+    ):
+        """Fill this array with on_value where a draw with probability p
+        succeeds and with off_value everywhere else
+
+        :meta private:
+        """
+        raise NotImplementedError("Implement in derived classes")
+
+    def random_distribution(self, gen_code, args, stacklevel, stream=None):
+        """Fill this array with draws from the distribution of the given
+        RandGenCode, whose parameters are the scalars in args
+
+        :meta private:
+        """
+        raise NotImplementedError("Implement in derived classes")
+
+    def multi_dot(self, vectors, pairs, stacklevel):
+        """Compute the inner products of pairs of the given vectors in one
+        pass and return a tuple with one thunk per pair
+
+        :meta private:
+        """
+        raise NotImplementedError("Implement in derived classes")
+
     def unary_op(self, op, op_type, rhs, where, args, stacklevel):
         """Perform a unary operation and put the result in the dst
         array
@@ -291,6 +616,14 @@ class NumPyThunk(object):
         """
         raise NotImplementedError("Implement in derived classes")
 
+    def multi_reduction(self, ops, out_shape, axes, keepdims, stacklevel):
+        """Perform several unary reductions of this array in one pass and
+        return a tuple with one thunk per reduction
+
+        :meta private:
+        """
+        raise NotImplementedError("Implement in derived classes")
+
     def binary_op(self, op, rhs1, rhs2, where, args, stacklevel):
         """Perform a binary operation with src and put the result in the
         dst array
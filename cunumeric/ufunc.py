@@ -14,6 +14,10 @@
 #
 
 # Define ufuns for binary operations
+import numpy as np
+
+from .array import ndarray
+from .config import UnaryRedCode
 from .module import (
     add as _add,
     amax as _max,
@@ -42,6 +46,42 @@ class ufunc(object):
     ):
         raise NotImplementedError("reduce ufunc")
 
+    # Unbuffered in-place reduction into the points of a that the index
+    # arrays select, so that repeated indices accumulate
+    @staticmethod
+    def at_impl(a, indices, b, op):
+        if not isinstance(a, ndarray):
+            raise TypeError(f"{op}.at needs a cunumeric.ndarray to update")
+        b = ndarray.convert_to_cunumeric_ndarray(b)
+        if b.dtype != a.dtype:
+            temp = ndarray(b.shape, dtype=a.dtype, inputs=(b,))
+            temp._thunk.convert(b._thunk, stacklevel=3)
+            b = temp
+        if not isinstance(indices, tuple):
+            indices = (indices,)
+        key = a._convert_key(indices)
+        a._thunk.scatter_reduce(key, b._thunk, op, stacklevel=3)
+
+    @staticmethod
+    def accumulate_impl(a, op, axis, dtype, out):
+        a = ndarray.convert_to_cunumeric_ndarray(a)
+        if dtype is None and op in (UnaryRedCode.SUM, UnaryRedCode.PROD):
+            dtype = a.dtype
+        return a._scan(op, axis, dtype, out, stacklevel=3)
+
+    # The operands are viewed with unit dimensions appended to the first and
+    # prepended to the second, so the elementwise task reads both through
+    # broadcast stores instead of tiled copies
+    @staticmethod
+    def outer_impl(func, a, b, out, where):
+        a = ndarray.convert_to_cunumeric_ndarray(a)
+        b = ndarray.convert_to_cunumeric_ndarray(b)
+        a, b = (
+            a[(Ellipsis,) + (np.newaxis,) * b.ndim],
+            b[(np.newaxis,) * a.ndim + (Ellipsis,)],
+        )
+        return func(a, b, out=out, where=where, stacklevel=3)
+
 
 # ufunc-add class
 class add(ufunc):
@@ -49,9 +89,36 @@ class add(ufunc):
         return _add(a, b, out=out, where=where, stacklevel=2)
 
     @staticmethod
-    def reduce(a, axis=0, dtype=None, out=None, keepdims=False):
+    def outer(a, b, out=None, where=True):
+        return ufunc.outer_impl(_add, a, b, out, where)
+
+    @staticmethod
+    def at(a, indices, b):
+        ufunc.at_impl(a, indices, b, "add")
+
+    @staticmethod
+    def accumulate(a, axis=0, dtype=None, out=None):
+        return ufunc.accumulate_impl(a, UnaryRedCode.SUM, axis, dtype, out)
+
+    @staticmethod
+    def reduce(
+        a,
+        axis=0,
+        dtype=None,
+        out=None,
+        keepdims=False,
+        initial=None,
+        where=True,
+    ):
         return _sum(
-            a, axis=axis, dtype=dtype, out=out, keepdims=keepdims, stacklevel=2
+            a,
+            axis=axis,
+            dtype=dtype,
+            out=out,
+            keepdims=keepdims,
+            initial=initial,
+            where=where,
+            stacklevel=2,
         )
 
 
@@ -61,9 +128,32 @@ class multiply(ufunc):
         return _mul(a, b, out=out, where=where, stacklevel=2)
 
     @staticmethod
-    def reduce(a, axis=0, dtype=None, out=None, keepdims=False):
+    def outer(a, b, out=None, where=True):
+        return ufunc.outer_impl(_mul, a, b, out, where)
+
+    @staticmethod
+    def accumulate(a, axis=0, dtype=None, out=None):
+        return ufunc.accumulate_impl(a, UnaryRedCode.PROD, axis, dtype, out)
+
+    @staticmethod
+    def reduce(
+        a,
+        axis=0,
+        dtype=None,
+        out=None,
+        keepdims=False,
+        initial=None,
+        where=True,
+    ):
         return _prod(
-            a, axis=axis, dtype=dtype, out=out, keepdims=keepdims, stacklevel=2
+            a,
+            axis=axis,
+            dtype=dtype,
+            out=out,
+            keepdims=keepdims,
+            initial=initial,
+            where=where,
+            stacklevel=2,
         )
 
 
@@ -72,6 +162,10 @@ class true_divide(ufunc):
     def __new__(cls, a, b, out=None, where=True):
         return _tdiv(a, b, out=out, where=where, stacklevel=2)
 
+    @staticmethod
+    def outer(a, b, out=None, where=True):
+        return ufunc.outer_impl(_tdiv, a, b, out, where)
+
 
 # ufunc-maximum class
 class maximum(ufunc):
@@ -79,9 +173,37 @@ class maximum(ufunc):
         return _max2(a, b, out=out, where=where, stacklevel=2)
 
     @staticmethod
-    def reduce(a, axis=0, dtype=None, out=None, keepdims=False):
+    def outer(a, b, out=None, where=True):
+        return ufunc.outer_impl(_max2, a, b, out, where)
+
+    @staticmethod
+    def at(a, indices, b):
+        ufunc.at_impl(a, indices, b, "maximum")
+
+    @staticmethod
+    def accumulate(a, axis=0, dtype=None, out=None):
+        return ufunc.accumulate_impl(a, UnaryRedCode.MAX, axis, dtype, out)
+
+    @staticmethod
+    def reduce(
+        a,
+        axis=0,
+        dtype=None,
+        out=None,
+        keepdims=False,
+        initial=None,
+        where=True,
+    ):
         assert dtype is None
-        return _max(a, axis=axis, out=out, keepdims=keepdims, stacklevel=2)
+        return _max(
+            a,
+            axis=axis,
+            out=out,
+            keepdims=keepdims,
+            initial=initial,
+            where=where,
+            stacklevel=2,
+        )
 
 
 # ufunc-minimum class
@@ -90,9 +212,33 @@ class minimum(ufunc):
         return _min2(a, b, out=out, where=where, stacklevel=2)
 
     @staticmethod
-    def reduce(a, axis=0, dtype=None, out=None, keepdims=False):
+    def outer(a, b, out=None, where=True):
+        return ufunc.outer_impl(_min2, a, b, out, where)
+
+    @staticmethod
+    def accumulate(a, axis=0, dtype=None, out=None):
+        return ufunc.accumulate_impl(a, UnaryRedCode.MIN, axis, dtype, out)
+
+    @staticmethod
+    def reduce(
+        a,
+        axis=0,
+        dtype=None,
+        out=None,
+        keepdims=False,
+        initial=None,
+        where=True,
+    ):
         assert dtype is None
-        return _min(a, axis=axis, out=out, keepdims=keepdims, stacklevel=2)
+        return _min(
+            a,
+            axis=axis,
+            out=out,
+            keepdims=keepdims,
+            initial=initial,
+            where=where,
+            stacklevel=2,
+        )
 
 
 # ufunc-mod class
@@ -100,38 +246,66 @@ class mod(ufunc):
     def __new__(cls, a, b, out=None, where=True):
         return _mod(a, b, out=out, where=where, stacklevel=2)
 
+    @staticmethod
+    def outer(a, b, out=None, where=True):
+        return ufunc.outer_impl(_mod, a, b, out, where)
+
 
 # ufunc-greater class
 class greater(ufunc):
     def __new__(cls, a, b, out=None, where=True):
         return _gt(a, b, out=out, where=where, stacklevel=2)
 
+    @staticmethod
+    def outer(a, b, out=None, where=True):
+        return ufunc.outer_impl(_gt, a, b, out, where)
+
 
 # ufunc-greater_equal class
 class greater_equal(ufunc):
     def __new__(cls, a, b, out=None, where=True):
         return _geq(a, b, out=out, where=where, stacklevel=2)
 
+    @staticmethod
+    def outer(a, b, out=None, where=True):
+        return ufunc.outer_impl(_geq, a, b, out, where)
+
 
 # ufunc-less class
 class less(ufunc):
     def __new__(cls, a, b, out=None, where=True):
         return _lt(a, b, out=out, where=where, stacklevel=2)
 
+    @staticmethod
+    def outer(a, b, out=None, where=True):
+        return ufunc.outer_impl(_lt, a, b, out, where)
+
 
 # ufunc-less_equal class
 class less_equal(ufunc):
     def __new__(cls, a, b, out=None, where=True):
         return _leq(a, b, out=out, where=where, stacklevel=2)
 
+    @staticmethod
+    def outer(a, b, out=None, where=True):
+        return ufunc.outer_impl(_leq, a, b, out, where)
+
 
 # ufunc-equal class
 class equal(ufunc):
     def __new__(cls, a, b, out=None, where=True):
         return _eq(a, b, out=out, where=where, stacklevel=2)
 
+    @staticmethod
+    def outer(a, b, out=None, where=True):
+        return ufunc.outer_impl(_eq, a, b, out, where)
+
 
 # ufunc-not_equal class
 class not_equal(ufunc):
     def __new__(cls, a, b, out=None, where=True):
         return _neq(a, b, out=out, where=where, stacklevel=2)
+
+    @staticmethod
+    def outer(a, b, out=None, where=True):
+        return ufunc.outer_impl(_neq, a, b, out, where)
@@ -15,6 +15,7 @@
 
 import functools
 import inspect
+import math
 import warnings
 
 import numpy as np
@@ -111,3 +112,66 @@ def get_arg_dtype(dtype):
 
 def get_arg_value_dtype(dtype):
     return dtype.fields["arg_value"][0].type
+
+
+def get_welford_dtype(dtype):
+    return np.dtype(
+        [("count", np.int64), ("mean", dtype), ("m2", dtype)],
+        align=True,
+    )
+
+
+def get_norm_dtype(dtype):
+    return np.dtype(
+        [("count", np.int64), ("scale", dtype), ("ssq", dtype)],
+        align=True,
+    )
+
+
+def get_logsumexp_dtype(dtype):
+    return np.dtype(
+        [("count", np.int64), ("max", dtype), ("sum", dtype)],
+        align=True,
+    )
+
+
+# Match these to BinnedSum in arg.h
+_BINNED_SUM_NUM_BINS = 3
+_BINNED_SUM_BIN_WIDTH = 30
+_BINNED_SUM_EXPONENT_BIAS = 1110
+
+
+def get_binned_sum_dtype(dtype):
+    return np.dtype(
+        [
+            ("top", np.int64),
+            ("bins", np.int64, (_BINNED_SUM_NUM_BINS,)),
+            ("special", dtype),
+        ],
+        align=True,
+    )
+
+
+# Splits a value into its bins the same way as the constructor of BinnedSum
+def get_binned_sum_state(value):
+    value = float(value)
+    empty = (0,) * _BINNED_SUM_NUM_BINS
+    if value == 0:
+        return (0, empty, 0)
+    if not math.isfinite(value):
+        return (0, empty, value)
+    _, exponent = math.frexp(value)
+    top = (exponent - 1 + _BINNED_SUM_EXPONENT_BIAS) // _BINNED_SUM_BIN_WIDTH
+    bottom = top - _BINNED_SUM_NUM_BINS + 1
+    rest = math.ldexp(
+        value, _BINNED_SUM_EXPONENT_BIAS - bottom * _BINNED_SUM_BIN_WIDTH
+    )
+    bins = []
+    for idx in range(_BINNED_SUM_NUM_BINS):
+        scale = math.ldexp(
+            1.0, (_BINNED_SUM_NUM_BINS - 1 - idx) * _BINNED_SUM_BIN_WIDTH
+        )
+        digit = math.trunc(rest / scale)
+        bins.append(digit)
+        rest -= digit * scale
+    return (top, tuple(bins), 0)
@@ -17,16 +17,41 @@
 
 from __future__ import print_function
 
+import json
 import math
+import os
 import sys
 
 if sys.version_info > (3, 0):
     from functools import reduce
 
 
-# A helper method for benchmarking applications
+# The rank of this process when the application is launched on several
+# nodes, so that only one of them writes the measurements out
+def _launch_rank():
+    for var in ("OMPI_COMM_WORLD_RANK", "PMI_RANK", "SLURM_PROCID"):
+        if var in os.environ:
+            return int(os.environ[var])
+    return 0
+
+
+# A helper method for benchmarking applications. When the application is run
+# by scaling.py, CUNUMERIC_BENCHMARK_WARMUP runs are made and dropped before
+# the samples are taken, and the samples are written as JSON to the file in
+# CUNUMERIC_BENCHMARK_OUTPUT.
 def run_benchmark(f, samples, name, args):
-    if samples > 1:
+    warmup = int(os.environ.get("CUNUMERIC_BENCHMARK_WARMUP", "0"))
+    output = os.environ.get("CUNUMERIC_BENCHMARK_OUTPUT")
+    for _ in range(warmup):
+        f(*args)
+    if output is not None:
+        results = [f(*args) for s in range(samples)]
+        if _launch_rank() == 0:
+            with open(output, "w") as out:
+                json.dump(
+                    {"name": name, "warmup": warmup, "samples": results}, out
+                )
+    elif samples > 1:
         results = [f(*args) for s in range(samples)]
         # Remove the largest and the smallest ones
         if samples >= 3:
@@ -20,6 +20,7 @@ from __future__ import print_function
 import argparse
 import datetime
 
+import numpy
 from benchmark import run_benchmark
 
 import cunumeric as np
@@ -72,6 +73,30 @@ def generate_2D(N, corners):
     return A, b
 
 
+def generate_2D_sparse(N, corners):
+    print(
+        "Generating %dx%d sparse 2-D adjacency system %s corners..."
+        % (N ** 2, N ** 2, "with" if corners else "without")
+    )
+    # The same diagonals as in generate_2D, built straight into the CSR
+    # format so that the dense matrix never exists
+    size = N ** 2
+    offsets = {1, N}
+    if corners:
+        offsets |= {N - 1, N + 1}
+    offsets = sorted(offsets | {0} | {-k for k in offsets})
+    rows = numpy.repeat(numpy.arange(size), len(offsets))
+    cols = rows + numpy.tile(offsets, size)
+    valid = (cols >= 0) & (cols < size)
+    rows, cols = rows[valid], cols[valid]
+    data = numpy.where(rows == cols, 8.0 if corners else 4.0, -1.0)
+    counts = numpy.bincount(rows, minlength=size)
+    indptr = numpy.concatenate(([0], numpy.cumsum(counts)))
+    A = np.sparse.csr_matrix((data, cols, indptr), shape=(size, size))
+    b = np.random.rand(size)
+    return A, b
+
+
 def solve(A, b, conv_iters, max_iters, verbose):
     print("Solving system...")
     x = np.zeros(A.shape[1])
@@ -108,11 +133,17 @@ def solve(A, b, conv_iters, max_iters, verbose):
     return x
 
 
-def precondition(A, N, corners):
+def precondition(A, N, corners, sparse):
     if corners:
         d = 8 * (N ** 2)
     else:
         d = 4 * (N ** 2)
+    if sparse:
+        diagonal = numpy.arange(N ** 2 + 1)
+        return np.sparse.csr_matrix(
+            (numpy.full(N ** 2, 1.0 / d), diagonal[:-1], diagonal),
+            shape=(N ** 2, N ** 2),
+        )
     M = np.diag(np.full(N ** 2, 1.0 / d))
     return M
 
@@ -134,18 +165,18 @@ def preconditioned_solve(A, M, b, conv_iters, max_iters, verbose):
         alpha = rzold / (p.dot(Ap))
         x = x + alpha * p
         r = r - alpha * Ap
-        rznew = r.dot(r)
+        z = M.dot(r)
+        # Both inner products of the new residual come out of one pass
+        rrnew, rznew = np.dots((r, r), (r, z))
         # We only do the convergence test every conv_iters or on the
         # last iteration
         if (i % conv_iters == 0 or i == (max_iters - 1)) and np.sqrt(
-            rznew
+            rrnew
         ) < 1e-10:
             converged = i
             break
         if verbose:
-            print("Residual: " + str(rznew))
-        z = M.dot(r)
-        rznew = r.dot(z)
+            print("Residual: " + str(rrnew))
         beta = rznew / rzold
         p = z + beta * p
         rzold = rznew
@@ -173,12 +204,16 @@ def run_cg(
     perform_check,
     timing,
     verbose,
+    sparse,
 ):
     start = datetime.datetime.now()
     # A, b = generate_random(N)
-    A, b = generate_2D(N, corners)
+    if sparse:
+        A, b = generate_2D_sparse(N, corners)
+    else:
+        A, b = generate_2D(N, corners)
     if preconditioner:
-        M = precondition(A, N, corners)
+        M = precondition(A, N, corners, sparse)
         x = preconditioned_solve(A, M, b, conv_iters, max_iters, verbose)
     else:
         x = solve(A, b, conv_iters, max_iters, verbose)
@@ -239,6 +274,13 @@ if __name__ == "__main__":
         dest="N",
         help="number of elements in one dimension",
     )
+    parser.add_argument(
+        "-s",
+        "--sparse",
+        dest="sparse",
+        action="store_true",
+        help="store the system in a sparse CSR matrix",
+    )
     parser.add_argument(
         "-t",
         "--time",
@@ -277,5 +319,6 @@ if __name__ == "__main__":
             args.check,
             args.timing,
             args.verbose,
+            args.sparse,
         ),
     )
@@ -76,7 +76,18 @@ def find_centroids(centroids, data, labels, pairwise_distances, zero_point, C):
     return distance_sum
 
 
-def run_kmeans(C, D, T, I, N, S, benchmarking):  # noqa: E741
+def assign_and_update(centroids, data, C):
+    # The fused assignment finds the nearest centroids and sums up the
+    # clusters in one pass, without the pairwise distance matrix
+    labels, sums, counts, distance_sum = np.kmeans_assign(
+        data, centroids, return_sums=True
+    )
+    counts = np.maximum(counts, np.ones((1,), dtype=counts.dtype))
+    centroids[:] = sums / counts[:, np.newaxis]
+    return labels, distance_sum
+
+
+def run_kmeans(C, D, T, I, N, S, benchmarking, unfused):  # noqa: E741
     print("Running kmeans...")
     print("Number of data points: " + str(N))
     print("Number of dimensions: " + str(D))
@@ -85,7 +96,8 @@ def run_kmeans(C, D, T, I, N, S, benchmarking):  # noqa: E741
     start = datetime.datetime.now()
     data, centroids = initialize(N, D, C, T)
 
-    data_dots = np.square(np.linalg.norm(data, ord=2, axis=1))
+    if unfused:
+        data_dots = np.square(np.linalg.norm(data, ord=2, axis=1))
     zero_point = np.zeros((1, data.shape[1]), dtype=data.dtype)
 
     labels = None
@@ -94,13 +106,18 @@ def run_kmeans(C, D, T, I, N, S, benchmarking):  # noqa: E741
     # We run for max iterations or until we converge
     # We only test convergence every S iterations
     while iteration < I:
-        pairwise_distances = calculate_distances(data, centroids, data_dots)
+        if unfused:
+            pairwise_distances = calculate_distances(
+                data, centroids, data_dots
+            )
 
-        new_labels = relabel(pairwise_distances)
+            new_labels = relabel(pairwise_distances)
 
-        distance_sum = find_centroids(
-            centroids, data, new_labels, pairwise_distances, zero_point, C
-        )
+            distance_sum = find_centroids(
+                centroids, data, new_labels, pairwise_distances, zero_point, C
+            )
+        else:
+            new_labels, distance_sum = assign_and_update(centroids, data, C)
 
         if iteration > 0 and iteration % S == 0:
             changes = np.not_equal(labels, new_labels)
@@ -196,6 +213,13 @@ if __name__ == "__main__":
         help="number of times to benchmark this application"
         " (default 1 - normal execution)",
     )
+    parser.add_argument(
+        "-u",
+        "--unfused",
+        action="store_true",
+        help="compute the pairwise distance matrix instead of using the"
+        " fused assignment",
+    )
     args = parser.parse_args()
     if args.P == 16:
         run_benchmark(
@@ -210,6 +234,7 @@ if __name__ == "__main__":
                 args.N * 1000,
                 args.S,
                 args.benchmark > 1,
+                args.unfused,
             ),
         )
     elif args.P == 32:
@@ -225,6 +250,7 @@ if __name__ == "__main__":
                 args.N * 1000,
                 args.S,
                 args.benchmark > 1,
+                args.unfused,
             ),
         )
     elif args.P == 64:
@@ -240,6 +266,7 @@ if __name__ == "__main__":
                 args.N * 1000,
                 args.S,
                 args.benchmark > 1,
+                args.unfused,
             ),
         )
     else:
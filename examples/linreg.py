@@ -60,14 +60,56 @@ def linear_regression(
     return weights
 
 
-def run_linear_regression(N, F, T, I, S, B):  # noqa: E741
+def least_squares(T, features, target, add_intercept=False):
+    if add_intercept:
+        intercept = np.ones((features.shape[0], 1), dtype=T)
+        features = np.hstack((intercept, features))
+
+    # The R factor of the features with the target appended holds both the
+    # R factor of the features and Q^T @ target in its last column, so the
+    # weights come from a small triangular system without ever forming Q.
+    # Unlike the normal equations, this doesn't square the condition number.
+    num_features = features.shape[1]
+    augmented = np.hstack((features, target.reshape(-1, 1)))
+    r = np.linalg.qr(augmented, mode="r")
+    weights = np.linalg.solve(
+        r[:num_features, :num_features], r[:num_features, num_features]
+    )
+
+    error = np.dot(features, weights) - target
+    print("Error of least squares: " + str(np.sum(np.power(error, 2))))
+    return weights
+
+
+def normal_equations(T, features, target, add_intercept=False):
+    if add_intercept:
+        intercept = np.ones((features.shape[0], 1), dtype=T)
+        features = np.hstack((intercept, features))
+
+    # The Gram matrix of the features is symmetric, so only one triangle of
+    # it is computed
+    gram = features.T.dot(features)
+    weights = np.linalg.solve(gram, target.dot(features))
+
+    error = np.dot(features, weights) - target
+    print("Error of normal equations: " + str(np.sum(np.power(error, 2))))
+    return weights
+
+
+def run_linear_regression(N, F, T, I, S, B, solver):  # noqa: E741
     print("Running linear regression...")
     print("Number of data points: " + str(N) + "K")
     print("Number of features: " + str(F))
-    print("Number of iterations: " + str(I))
+    if solver == "gd":
+        print("Number of iterations: " + str(I))
     start = datetime.datetime.now()
     features, target = initialize(N * 1000, F, T)
-    weights = linear_regression(T, features, target, I, 1e-5, S, B)
+    if solver == "gd":
+        weights = linear_regression(T, features, target, I, 1e-5, S, B)
+    elif solver == "normal":
+        weights = normal_equations(T, features, target, B)
+    else:
+        weights = least_squares(T, features, target, B)
     # Check the weights for NaNs to synchronize before stopping timing
     assert not math.isnan(np.sum(weights))
     stop = datetime.datetime.now()
@@ -126,6 +168,14 @@ if __name__ == "__main__":
         dest="S",
         help="number of iterations between sampling the log likelihood",
     )
+    parser.add_argument(
+        "--solver",
+        choices=["gd", "qr", "normal"],
+        default="gd",
+        dest="solver",
+        help="fit by gradient descent, or exactly through a QR "
+        "decomposition or the normal equations (not for 16-bit precision)",
+    )
     parser.add_argument(
         "--benchmark",
         type=int,
@@ -140,21 +190,21 @@ if __name__ == "__main__":
             run_linear_regression,
             args.benchmark,
             "LINREG(H)",
-            (args.N, args.F, np.float16, args.I, args.S, args.B),
+            (args.N, args.F, np.float16, args.I, args.S, args.B, args.solver),
         )
     elif args.P == 32:
         run_benchmark(
             run_linear_regression,
             args.benchmark,
             "LINREG(S)",
-            (args.N, args.F, np.float32, args.I, args.S, args.B),
+            (args.N, args.F, np.float32, args.I, args.S, args.B, args.solver),
         )
     elif args.P == 64:
         run_benchmark(
             run_linear_regression,
             args.benchmark,
             "LINREG(D)",
-            (args.N, args.F, np.float64, args.I, args.S, args.B),
+            (args.N, args.F, np.float64, args.I, args.S, args.B, args.solver),
         )
     else:
         raise TypeError("Precision must be one of 16, 32, or 64")
@@ -26,7 +26,9 @@ from benchmark import run_benchmark
 import cunumeric as np
 
 
-def run_lstm(batch_size, hidden_size, sentence_length, word_size, timing):
+def run_lstm(
+    batch_size, hidden_size, sentence_length, word_size, timing, unfused
+):
     start = datetime.datetime.now()
 
     WLSTM = np.random.randn(
@@ -51,24 +53,42 @@ def run_lstm(batch_size, hidden_size, sentence_length, word_size, timing):
     dh0 = np.zeros((1, d))
 
     for t in reversed(range(n)):
-        tanhCt = Ct[t]
-        dIFOGf[t, :, 2 * d : 3 * d] = tanhCt * dHout[t]
-        # backprop tanh non-linearity first then continue backprop
-        dC[t] += (1 - tanhCt ** 2) * (IFOGf[t, :, 2 * d : 3 * d] * dHout[t])
-
-        if t > 0:
-            dIFOGf[t, :, d : 2 * d] = C[t - 1] * dC[t]
-            dC[t - 1] += IFOGf[t, :, d : 2 * d] * dC[t]
-
-        dIFOGf[t, :, :d] = IFOGf[t, :, 3 * d :] * dC[t]
-        dIFOGf[t, :, 3 * d :] = IFOGf[t, :, :d] * dC[t]
-
-        # backprop activation functions
-        dIFOG[t, :, 3 * d :] = (1 - IFOGf[t, :, 3 * d :] ** 2) * dIFOGf[
-            t, :, 3 * d :
-        ]
-        y = IFOGf[t, :, : 3 * d]
-        dIFOG[t, :, : 3 * d] = (y * (1.0 - y)) * dIFOGf[t, :, : 3 * d]
+        if not unfused:
+            # backprop the gates and their non-linearities in one pass
+            if t > 0:
+                np.lstm_gates_backward(
+                    IFOGf[t],
+                    Ct[t],
+                    dHout[t],
+                    dc=dC[t],
+                    c_prev=C[t - 1],
+                    out=(dIFOG[t], dC[t - 1]),
+                )
+            else:
+                np.lstm_gates_backward(
+                    IFOGf[t], Ct[t], dHout[t], dc=dC[t], out=(dIFOG[t],)
+                )
+        else:
+            tanhCt = Ct[t]
+            dIFOGf[t, :, 2 * d : 3 * d] = tanhCt * dHout[t]
+            # backprop tanh non-linearity first then continue backprop
+            dC[t] += (1 - tanhCt ** 2) * (
+                IFOGf[t, :, 2 * d : 3 * d] * dHout[t]
+            )
+
+            if t > 0:
+                dIFOGf[t, :, d : 2 * d] = C[t - 1] * dC[t]
+                dC[t - 1] += IFOGf[t, :, d : 2 * d] * dC[t]
+
+            dIFOGf[t, :, :d] = IFOGf[t, :, 3 * d :] * dC[t]
+            dIFOGf[t, :, 3 * d :] = IFOGf[t, :, :d] * dC[t]
+
+            # backprop activation functions
+            dIFOG[t, :, 3 * d :] = (1 - IFOGf[t, :, 3 * d :] ** 2) * dIFOGf[
+                t, :, 3 * d :
+            ]
+            y = IFOGf[t, :, : 3 * d]
+            dIFOG[t, :, : 3 * d] = (y * (1.0 - y)) * dIFOGf[t, :, : 3 * d]
 
         # backprop matrix multiply
         dHin[t] = dIFOG[t].dot(WLSTM.transpose())
@@ -117,6 +137,13 @@ if __name__ == "__main__":
         action="store_true",
         help="perform timing",
     )
+    parser.add_argument(
+        "-u",
+        "--unfused",
+        action="store_true",
+        help="compute the gates with separate element-wise operations instead"
+        " of the fused gate kernels",
+    )
     parser.add_argument(
         "--benchmark",
         type=int,
@@ -130,5 +157,12 @@ if __name__ == "__main__":
         run_lstm,
         args.benchmark,
         "LSTM Backward",
-        (args.batch, args.hidden, args.sentence, args.word, args.timing),
+        (
+            args.batch,
+            args.hidden,
+            args.sentence,
+            args.word,
+            args.timing,
+            args.unfused,
+        ),
     )
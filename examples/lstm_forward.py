@@ -26,7 +26,9 @@ from benchmark import run_benchmark
 import cunumeric as np
 
 
-def run_lstm(batch_size, hidden_size, sentence_length, word_size, timing):
+def run_lstm(
+    batch_size, hidden_size, sentence_length, word_size, timing, unfused
+):
     start = datetime.datetime.now()
 
     X = np.random.randn(sentence_length, batch_size, hidden_size)
@@ -57,6 +59,14 @@ def run_lstm(batch_size, hidden_size, sentence_length, word_size, timing):
         Hin[t, :, word_size:] = prev
         # compute all gate activations. dots:
         IFOG[t] = Hin[t].dot(WLSTM)
+        if not unfused:
+            # non-linearities and the new states in one pass
+            np.lstm_gates(
+                IFOG[t],
+                C[t - 1] if t > 0 else None,
+                out=(Hout[t], C[t], Ct[t], IFOGf[t]),
+            )
+            continue
         # non-linearities
         IFOGf[t, :, : 3 * d] = 1.0 / (
             1.0 + np.exp(-IFOG[t, :, : 3 * d])
@@ -107,6 +117,13 @@ if __name__ == "__main__":
         action="store_true",
         help="perform timing",
     )
+    parser.add_argument(
+        "-u",
+        "--unfused",
+        action="store_true",
+        help="compute the gates with separate element-wise operations instead"
+        " of the fused gate kernels",
+    )
     parser.add_argument(
         "--benchmark",
         type=int,
@@ -120,5 +137,12 @@ if __name__ == "__main__":
         run_lstm,
         args.benchmark,
         "LSTM Forward",
-        (args.batch, args.hidden, args.sentence, args.word, args.timing),
+        (
+            args.batch,
+            args.hidden,
+            args.sentence,
+            args.word,
+            args.timing,
+            args.unfused,
+        ),
     )
@@ -30,15 +30,20 @@ def run_richardson_lucy(shape, filter_shape, num_iter, warmup, timing):
     psf = np.random.rand(*filter_shape).astype(float_type)
     im_deconv = np.full(image.shape, 0.5, dtype=float_type)
     psf_mirror = np.flip(psf)
+    # Reusing the same buffers keeps their tiles resident across iterations
+    conv = np.empty_like(image)
+    relative_blur = np.empty_like(image)
+    correction = np.empty_like(image)
 
     start = time()
 
     for idx in range(num_iter + warmup):
         if idx == warmup:
             start = time()
-        conv = np.convolve(im_deconv, psf, mode="same")
-        relative_blur = image / conv
-        im_deconv *= np.convolve(relative_blur, psf_mirror, mode="same")
+        np.convolve(im_deconv, psf, mode="same", out=conv)
+        np.divide(image, conv, out=relative_blur)
+        np.convolve(relative_blur, psf_mirror, mode="same", out=correction)
+        im_deconv *= correction
 
     stop = time()
     total = (stop - start) / 1000.0
@@ -0,0 +1,316 @@
+#!/usr/bin/env python
+
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+# Runs the example applications over a sweep of node counts, processor counts
+# and problem sizes and writes the timings, throughput and parallel efficiency
+# of each point as CSV or JSON, e.g.
+#
+#   scaling.py --app gemm --sizes 4096,8192 --gpus 1,2,4,8 --output gemm.csv
+#
+# With --mode weak the sizes are those of the smallest processor count, and
+# grow with the processor count so that the work per processor stays the same.
+
+from __future__ import print_function
+
+import argparse
+import csv
+import json
+import math
+import os
+import subprocess
+import sys
+
+
+class App(object):
+    def __init__(self, script, iter_flag, work, unit, weak_exponent, flags=()):
+        self.script = script
+        # The flag of the app for its iteration count, if it has one
+        self.iter_flag = iter_flag
+        # The work that one run of a problem size does, for the throughput
+        self.work = work
+        self.unit = unit
+        # The work of a problem size grows with the size to this power
+        self.weak_exponent = weak_exponent
+        self.flags = list(flags)
+
+
+apps = {
+    "black_scholes": App(
+        "black_scholes.py", None, lambda n, i: n * 1e3, "options/s", 1
+    ),
+    # The dense system of size n has n**2 unknowns
+    "cg": App("cg.py", "-m", lambda n, i: n ** 4 * i, "MAC/s", 4),
+    "gemm": App("gemm.py", "-i", lambda n, i: 2 * n ** 3 * i, "FLOP/s", 3),
+    "kmeans": App("kmeans.py", "-m", lambda n, i: n * i, "points/s", 1),
+    "stencil": App("stencil.py", "-i", lambda n, i: n ** 2 * i, "cells/s", 2),
+}
+
+
+def find_driver(legate_dir):
+    if legate_dir is None:
+        legate_dir = os.environ.get("LEGATE_DIR")
+    if legate_dir is None:
+        config = os.path.join(
+            os.path.dirname(os.path.realpath(__file__)),
+            os.pardir,
+            ".legate.core.json",
+        )
+        if os.path.exists(config):
+            with open(config, "r") as f:
+                legate_dir = json.load(f)
+    if legate_dir is None or not os.path.exists(legate_dir):
+        raise Exception(
+            "You need to provide a Legate installation directory using "
+            "'--legate' or LEGATE_DIR"
+        )
+    return os.path.join(legate_dir, "bin", "legate")
+
+
+def weak_size(size, procs, base_procs, exponent):
+    return int(round(size * (procs / base_procs) ** (1.0 / exponent)))
+
+
+def run_point(args, driver, app, nodes, procs, size, index):
+    # The file is written by the first rank, which may run on another node
+    output = os.path.join(
+        os.path.realpath(args.scratch),
+        "scaling_%d_%d.json" % (os.getpid(), index),
+    )
+    cmd = [driver, "--" + args.kind + "s", str(procs)]
+    if nodes > 1:
+        cmd += ["--nodes", str(nodes), "--launcher", args.launcher]
+    script = os.path.join(
+        os.path.dirname(os.path.realpath(__file__)), app.script
+    )
+    cmd += [script, "-n", str(size), "-b", str(args.samples)]
+    if app.iter_flag is not None and args.iters is not None:
+        cmd += [app.iter_flag, str(args.iters)]
+    cmd += app.flags + args.app_args
+    env = dict(os.environ)
+    env["CUNUMERIC_BENCHMARK_WARMUP"] = str(args.warmup)
+    env["CUNUMERIC_BENCHMARK_OUTPUT"] = output
+    if args.verbose:
+        print(" ".join(cmd))
+    stdout = None if args.verbose else subprocess.DEVNULL
+    subprocess.run(cmd, env=env, stdout=stdout, check=True)
+    with open(output, "r") as f:
+        samples = json.load(f)["samples"]
+    os.remove(output)
+    return samples
+
+
+def add_efficiency(rows, mode):
+    # Points are compared with the one on the fewest processors in their
+    # series, which is the points of one size, or base size for weak scaling
+    series = {}
+    for row in rows:
+        series.setdefault(row["series"], []).append(row)
+    for points in series.values():
+        base = min(points, key=lambda row: row["procs"])
+        for row in points:
+            if mode == "strong":
+                row["efficiency"] = (base["mean_ms"] * base["procs"]) / (
+                    row["mean_ms"] * row["procs"]
+                )
+            else:
+                row["efficiency"] = base["mean_ms"] / row["mean_ms"]
+
+
+def write_rows(rows, path):
+    fields = [
+        "app",
+        "mode",
+        "nodes",
+        "procs_per_node",
+        "procs",
+        "size",
+        "warmup",
+        "samples",
+        "mean_ms",
+        "min_ms",
+        "stddev_ms",
+        "throughput",
+        "unit",
+        "efficiency",
+    ]
+    if path.endswith(".json"):
+        with open(path, "w") as f:
+            json.dump(
+                [{k: row[k] for k in fields} for row in rows], f, indent=2
+            )
+    else:
+        with open(path, "w", newline="") as f:
+            writer = csv.DictWriter(
+                f, fieldnames=fields, extrasaction="ignore"
+            )
+            writer.writeheader()
+            writer.writerows(rows)
+
+
+def run_scaling(args):
+    driver = find_driver(args.legate)
+    app = apps[args.app]
+    iters = 1 if args.iters is None else args.iters
+    base_procs = min(args.nodes) * min(args.procs)
+
+    rows = []
+    for nodes in args.nodes:
+        for procs_per_node in args.procs:
+            procs = nodes * procs_per_node
+            for base_size in args.sizes:
+                if args.mode == "weak":
+                    size = weak_size(
+                        base_size, procs, base_procs, app.weak_exponent
+                    )
+                else:
+                    size = base_size
+                samples = run_point(
+                    args, driver, app, nodes, procs_per_node, size, len(rows)
+                )
+                mean = sum(samples) / len(samples)
+                stddev = math.sqrt(
+                    sum((x - mean) ** 2 for x in samples) / len(samples)
+                )
+                row = {
+                    "app": args.app,
+                    "mode": args.mode,
+                    "nodes": nodes,
+                    "procs_per_node": procs_per_node,
+                    "procs": procs,
+                    "size": size,
+                    "series": base_size,
+                    "warmup": args.warmup,
+                    "samples": len(samples),
+                    "mean_ms": mean,
+                    "min_ms": min(samples),
+                    "stddev_ms": stddev,
+                    "throughput": app.work(size, iters) / (mean / 1e3),
+                    "unit": app.unit,
+                }
+                rows.append(row)
+                print(
+                    "%s nodes=%d %ss=%d size=%d: %.3f ms, %.4g %s"
+                    % (
+                        args.app,
+                        nodes,
+                        args.kind,
+                        procs_per_node,
+                        size,
+                        mean,
+                        row["throughput"],
+                        app.unit,
+                    )
+                )
+    add_efficiency(rows, args.mode)
+    write_rows(rows, args.output)
+    return rows
+
+
+def int_list(value):
+    return [int(x) for x in value.split(",")]
+
+
+def driver():
+    parser = argparse.ArgumentParser(
+        description="Measure the scaling of the example applications"
+    )
+    parser.add_argument(
+        "--app", choices=sorted(apps.keys()), required=True, dest="app"
+    )
+    parser.add_argument(
+        "--mode",
+        choices=["strong", "weak"],
+        default="strong",
+        dest="mode",
+        help="keep the problem size fixed or grow it with the processors",
+    )
+    parser.add_argument(
+        "--sizes",
+        type=int_list,
+        required=True,
+        dest="sizes",
+        help="comma separated problem sizes passed to the app with -n",
+    )
+    parser.add_argument(
+        "--kind",
+        choices=["cpu", "gpu", "omp"],
+        default="gpu",
+        dest="kind",
+        help="kind of processor that the counts of --procs are of",
+    )
+    parser.add_argument(
+        "--procs",
+        type=int_list,
+        default=[1],
+        dest="procs",
+        help="comma separated processor counts per node",
+    )
+    parser.add_argument(
+        "--nodes",
+        type=int_list,
+        default=[1],
+        dest="nodes",
+        help="comma separated node counts",
+    )
+    parser.add_argument(
+        "--launcher",
+        default="mpirun",
+        dest="launcher",
+        help="launcher used by legate for more than one node",
+    )
+    parser.add_argument(
+        "--iters",
+        type=int,
+        default=None,
+        dest="iters",
+        help="iteration count of the app, where it has one",
+    )
+    parser.add_argument(
+        "--warmup",
+        type=int,
+        default=1,
+        dest="warmup",
+        help="runs made and dropped before the samples of each point",
+    )
+    parser.add_argument(
+        "--samples",
+        type=int,
+        default=3,
+        dest="samples",
+        help="measured runs of each point",
+    )
+    parser.add_argument(
+        "--output",
+        default="scaling.csv",
+        dest="output",
+        help="file the results are written to, as JSON if it ends in .json",
+    )
+    parser.add_argument(
+        "--scratch",
+        default=".",
+        dest="scratch",
+        help="directory, visible to all nodes, for the samples of each run",
+    )
+    parser.add_argument("--legate", default=None, dest="legate")
+    parser.add_argument("-v", "--verbose", action="store_true", dest="verbose")
+    args, app_args = parser.parse_known_args()
+    args.app_args = app_args
+    run_scaling(args)
+
+
+if __name__ == "__main__":
+    sys.exit(driver())
@@ -52,10 +52,27 @@ def run(grid, I, N):  # noqa: E741
     return total / (N ** 2)
 
 
-def run_stencil(N, I, timing):  # noqa: E741
+def run_native(grid, I, N):  # noqa: E741
+    print("Running Jacobi stencil with the native stencil task...")
+    offsets = ((0, 0), (-1, 0), (0, 1), (0, -1), (1, 0))
+    coefficients = (0.2,) * len(offsets)
+    # The stencil copies the boundary, so the two grids can be swapped
+    # after every iteration without touching their tiles
+    work = np.empty_like(grid)
+    for i in range(I):
+        np.stencil(grid, offsets, coefficients, out=work)
+        grid, work = work, grid
+    total = np.sum(grid[1:-1, 1:-1])
+    return total / (N ** 2)
+
+
+def run_stencil(N, I, timing, native):  # noqa: E741
     start = datetime.datetime.now()
     grid = initialize(N)
-    average = run(grid, I, N)
+    if native:
+        average = run_native(grid, I, N)
+    else:
+        average = run(grid, I, N)
     # This will sync the timing because we will need to wait for the result
     assert not math.isnan(average)
     stop = datetime.datetime.now()
@@ -92,6 +109,13 @@ if __name__ == "__main__":
         action="store_true",
         help="perform timing",
     )
+    parser.add_argument(
+        "-s",
+        "--native",
+        dest="native",
+        action="store_true",
+        help="use the native stencil task instead of slices",
+    )
     parser.add_argument(
         "-b",
         "--benchmark",
@@ -103,5 +127,8 @@ if __name__ == "__main__":
     )
     args = parser.parse_args()
     run_benchmark(
-        run_stencil, args.benchmark, "Stencil", (args.N, args.I, args.timing)
+        run_stencil,
+        args.benchmark,
+        "Stencil",
+        (args.N, args.I, args.timing, args.native),
     )
@@ -77,6 +77,7 @@ if args.recurse:
         version="0.1",
         packages=[
             "cunumeric",
+            "cunumeric.fft",
             "cunumeric.linalg",
             "cunumeric.random",
         ],
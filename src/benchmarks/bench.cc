@@ -0,0 +1,309 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cmath>
+
+#include "benchmarks/bench.h"
+#include "mappers/default_mapper.h"
+
+#ifdef LEGATE_USE_CUDA
+#include <cuda_runtime.h>
+#endif
+
+namespace cunumeric {
+namespace bench {
+
+using namespace Legion;
+
+enum BenchTaskIDs {
+  TOP_LEVEL_TASK_ID = 1,
+  CPU_TIMING_TASK_ID,
+  OMP_TIMING_TASK_ID,
+  GPU_TIMING_TASK_ID,
+};
+
+// Arrays that are not dense get this many extra elements in their last dimension
+constexpr coord_t STRIDED_PADDING = 3;
+
+struct TimingArgs {
+  int32_t kernel;
+  int32_t reps;
+  Domain rect;
+};
+
+// The sustained bandwidth (GB/s) and arithmetic throughput (GFLOP/s) of the processors a
+// variant runs on. Zero means unknown, in which case no fraction of the peak is reported.
+struct Peaks {
+  double bandwidth{0};
+  double flops{0};
+};
+
+static Peaks peaks[3];
+static Context top_level_ctx;
+static Runtime* top_level_runtime;
+
+std::vector<Kernel>& kernels()
+{
+  static std::vector<Kernel> all_kernels;
+  return all_kernels;
+}
+
+static const char* kind_name(VariantKind kind)
+{
+  switch (kind) {
+    case VariantKind::CPU: return "cpu";
+    case VariantKind::OMP: return "omp";
+    case VariantKind::GPU: return "gpu";
+  }
+  return "";
+}
+
+static TaskID timing_task_id(VariantKind kind)
+{
+  switch (kind) {
+    case VariantKind::CPU: return CPU_TIMING_TASK_ID;
+    case VariantKind::OMP: return OMP_TIMING_TASK_ID;
+    case VariantKind::GPU: return GPU_TIMING_TASK_ID;
+  }
+  return CPU_TIMING_TASK_ID;
+}
+
+// The default mapper lays instances out in Fortran order, but the bodies only take their dense
+// paths on the row-major instances the Legate mapper creates
+class BenchMapper : public Mapping::DefaultMapper {
+ public:
+  BenchMapper(Mapping::MapperRuntime* rt, Machine machine, Processor local)
+    : DefaultMapper(rt, machine, local, "cunumeric_bench_mapper")
+  {
+  }
+
+ protected:
+  virtual void default_policy_select_constraints(Mapping::MapperContext ctx,
+                                                 LayoutConstraintSet& constraints,
+                                                 Memory target_memory,
+                                                 const RegionRequirement& req) override
+  {
+    DefaultMapper::default_policy_select_constraints(ctx, constraints, target_memory, req);
+    std::vector<DimensionKind> ordering;
+    for (int32_t dim = req.region.get_dim() - 1; dim >= 0; --dim)
+      ordering.push_back(static_cast<DimensionKind>(LEGION_DIM_X + dim));
+    ordering.push_back(LEGION_DIM_F);
+    constraints.ordering_constraint = OrderingConstraint(ordering, false /*contiguous*/);
+  }
+};
+
+static double timing_task(const Task* task,
+                          const std::vector<PhysicalRegion>& regions,
+                          Context ctx,
+                          Runtime* runtime)
+{
+  const auto& args = *static_cast<const TimingArgs*>(task->args);
+  return kernels()[args.kernel].timer(regions, args.rect, args.reps);
+}
+
+// Splits the volume into a close to cubic shape of the kernel's dimension
+static Domain make_rect(int32_t dim, int64_t volume)
+{
+  const auto extent = std::max<coord_t>(1, std::llround(std::pow(volume, 1.0 / dim)));
+  DomainPoint lo, hi;
+  lo.dim = hi.dim = dim;
+  coord_t rest = volume;
+  for (int32_t idx = 0; idx < dim - 1; ++idx) {
+    lo[idx] = 0;
+    hi[idx] = extent - 1;
+    rest /= extent;
+  }
+  lo[dim - 1] = 0;
+  hi[dim - 1] = std::max<coord_t>(1, rest) - 1;
+  return Domain(lo, hi);
+}
+
+static LogicalRegion create_operand(const Operand& operand, const Domain& bounds)
+{
+  auto ctx     = top_level_ctx;
+  auto runtime = top_level_runtime;
+
+  auto is     = runtime->create_index_space(ctx, bounds);
+  auto fs     = runtime->create_field_space(ctx);
+  auto fields = runtime->create_field_allocator(ctx, fs);
+  fields.allocate_field(operand.elem_size, BENCH_FID);
+  auto region = runtime->create_logical_region(ctx, is, fs);
+  if (!operand.fill.empty())
+    runtime->fill_field(
+      ctx, region, region, BENCH_FID, operand.fill.data(), operand.fill.size());
+  return region;
+}
+
+static void destroy_operand(LogicalRegion region)
+{
+  auto ctx     = top_level_ctx;
+  auto runtime = top_level_runtime;
+  runtime->destroy_logical_region(ctx, region);
+  runtime->destroy_field_space(ctx, region.get_field_space());
+  runtime->destroy_index_space(ctx, region.get_index_space());
+}
+
+static void run_kernel(benchmark::State& state, int32_t index, bool dense)
+{
+  const auto& kernel = kernels()[index];
+
+  TimingArgs args;
+  args.kernel = index;
+  args.rect   = make_rect(kernel.dim, state.range(0));
+
+  // Keep each timing task long enough for the timer to be accurate
+  const auto volume = static_cast<int64_t>(args.rect.get_volume());
+  args.reps         = static_cast<int32_t>(std::clamp<int64_t>((1 << 26) / volume, 1, 100));
+
+  auto bounds = args.rect;
+  if (!dense) {
+    DomainPoint hi = bounds.hi();
+    hi[kernel.dim - 1] += STRIDED_PADDING;
+    bounds = Domain(bounds.lo(), hi);
+  }
+
+  TaskLauncher launcher(timing_task_id(kernel.kind), TaskArgument(&args, sizeof(args)));
+  std::vector<LogicalRegion> regions;
+  for (const auto& operand : kernel.operands) {
+    if (operand.privilege == LEGION_REDUCE) {
+      auto region = create_operand(operand, Domain(Rect<1>(0, 0)));
+      launcher.add_region_requirement(
+        RegionRequirement(region, operand.redop, LEGION_EXCLUSIVE, region));
+      regions.push_back(region);
+    } else {
+      auto region = create_operand(operand, bounds);
+      launcher.add_region_requirement(
+        RegionRequirement(region, operand.privilege, LEGION_EXCLUSIVE, region));
+      regions.push_back(region);
+    }
+    launcher.region_requirements.back().add_field(BENCH_FID);
+  }
+
+  double total = 0;
+  for (auto _ : state) {
+    auto seconds = top_level_runtime->execute_task(top_level_ctx, launcher).get_result<double>();
+    state.SetIterationTime(seconds);
+    total += seconds;
+  }
+  for (auto region : regions) destroy_operand(region);
+
+  const auto seconds = total / state.iterations();
+  const auto gbps    = kernel.bytes_per_element * volume / seconds / 1e9;
+  const auto gflops  = kernel.flops_per_element * volume / seconds / 1e9;
+  const auto& peak   = peaks[static_cast<int32_t>(kernel.kind)];
+  state.counters["GB/s"]    = gbps;
+  state.counters["GFLOP/s"] = gflops;
+  if (peak.bandwidth > 0) state.counters["%peak_bw"] = 100 * gbps / peak.bandwidth;
+  if (peak.flops > 0) state.counters["%peak_flops"] = 100 * gflops / peak.flops;
+}
+
+static void parse_peaks(int argc, char** argv)
+{
+#ifdef LEGATE_USE_CUDA
+  // Without a flag the GPU is measured against the bandwidth of its memory bus
+  cudaDeviceProp prop;
+  if (cudaGetDeviceProperties(&prop, 0) == cudaSuccess)
+    peaks[static_cast<int32_t>(VariantKind::GPU)].bandwidth =
+      2.0 * prop.memoryClockRate * 1e3 * (prop.memoryBusWidth / 8) / 1e9;
+#endif
+  for (int idx = 0; idx < argc - 1; ++idx) {
+    for (auto kind : {VariantKind::CPU, VariantKind::OMP, VariantKind::GPU}) {
+      auto& peak         = peaks[static_cast<int32_t>(kind)];
+      const auto bw_flag = std::string("-bench:") + kind_name(kind) + "-bw";
+      const auto fp_flag = std::string("-bench:") + kind_name(kind) + "-gflops";
+      if (bw_flag == argv[idx]) peak.bandwidth = atof(argv[idx + 1]);
+      if (fp_flag == argv[idx]) peak.flops = atof(argv[idx + 1]);
+    }
+  }
+}
+
+static void top_level_task(const Task* task,
+                           const std::vector<PhysicalRegion>& regions,
+                           Context ctx,
+                           Runtime* runtime)
+{
+  top_level_ctx     = ctx;
+  top_level_runtime = runtime;
+
+  const auto& input = Runtime::get_input_args();
+  std::vector<char*> argv(input.argv, input.argv + input.argc);
+  int argc = input.argc;
+  parse_peaks(argc, argv.data());
+  benchmark::Initialize(&argc, argv.data());
+
+  auto has_procs = [](Processor::Kind kind) {
+    return Machine::ProcessorQuery(Machine::get_machine()).only_kind(kind).count() > 0;
+  };
+  const bool has_omp = has_procs(Processor::OMP_PROC);
+  const bool has_gpu = has_procs(Processor::TOC_PROC);
+
+  const auto& all_kernels = kernels();
+  for (int32_t index = 0; index < static_cast<int32_t>(all_kernels.size()); ++index) {
+    const auto& kernel = all_kernels[index];
+    if (kernel.kind == VariantKind::OMP && !has_omp) continue;
+    if (kernel.kind == VariantKind::GPU && !has_gpu) continue;
+    for (bool dense : {true, false}) {
+      // One-dimensional arrays have no stride to pad
+      if (!dense && kernel.dim == 1) continue;
+      auto name = kernel.name + "/" + kind_name(kernel.kind) + (dense ? "/dense" : "/strided");
+      benchmark::RegisterBenchmark(name.c_str(), run_kernel, index, dense)
+        ->RangeMultiplier(8)
+        ->Range(1 << 12, 1 << 24)
+        ->UseManualTime()
+        ->Unit(benchmark::kMicrosecond);
+    }
+  }
+  benchmark::RunSpecifiedBenchmarks();
+}
+
+static void register_timing_task(TaskID task_id, Processor::Kind kind, const char* name)
+{
+  TaskVariantRegistrar registrar(task_id, name);
+  registrar.add_constraint(ProcessorConstraint(kind));
+  registrar.set_leaf(true);
+  Runtime::preregister_task_variant<double, timing_task>(registrar, name);
+}
+
+static void register_mapper(Machine machine,
+                            Runtime* runtime,
+                            const std::set<Processor>& local_procs)
+{
+  for (auto proc : local_procs)
+    runtime->replace_default_mapper(
+      new BenchMapper(runtime->get_mapper_runtime(), machine, proc), proc);
+}
+
+}  // namespace bench
+}  // namespace cunumeric
+
+int main(int argc, char** argv)
+{
+  using namespace cunumeric::bench;
+
+  Legion::Runtime::set_top_level_task_id(TOP_LEVEL_TASK_ID);
+  {
+    Legion::TaskVariantRegistrar registrar(TOP_LEVEL_TASK_ID, "top_level");
+    registrar.add_constraint(Legion::ProcessorConstraint(Legion::Processor::LOC_PROC));
+    Legion::Runtime::preregister_task_variant<top_level_task>(registrar, "top_level");
+  }
+  register_timing_task(CPU_TIMING_TASK_ID, Legion::Processor::LOC_PROC, "time_cpu");
+  register_timing_task(OMP_TIMING_TASK_ID, Legion::Processor::OMP_PROC, "time_omp");
+  register_timing_task(GPU_TIMING_TASK_ID, Legion::Processor::TOC_PROC, "time_gpu");
+  Legion::Runtime::add_registration_callback(register_mapper);
+  return Legion::Runtime::start(argc, argv);
+}
@@ -0,0 +1,121 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "cunumeric/cunumeric.h"
+
+namespace cunumeric {
+namespace bench {
+
+// Every operand of a kernel is a region with this single field
+constexpr Legion::FieldID BENCH_FID = 100;
+
+struct Operand {
+  size_t elem_size;
+  Legion::PrivilegeMode privilege;
+  // Reduction operands are one-element regions folded into with this operator
+  Legion::ReductionOpID redop{0};
+  // Inputs are filled with this value so that the kernels see well-behaved numbers
+  std::vector<char> fill;
+};
+
+// Runs the body of a kernel on the mapped operands reps times and returns the seconds
+// one run took
+using TimerFn = double (*)(const std::vector<Legion::PhysicalRegion>& regions,
+                           const Legion::Domain& rect,
+                           int32_t reps);
+
+struct Kernel {
+  std::string name;
+  VariantKind kind;
+  int32_t dim;
+  std::vector<Operand> operands;
+  // The traffic and arithmetic of one element, used to report GB/s and GFLOP/s
+  double bytes_per_element;
+  double flops_per_element;
+  TimerFn timer;
+};
+
+std::vector<Kernel>& kernels();
+
+template <typename VAL>
+Operand input()
+{
+  Operand operand{sizeof(VAL), LEGION_READ_ONLY, 0, std::vector<char>(sizeof(VAL))};
+  const VAL one{1};
+  memcpy(operand.fill.data(), &one, sizeof(VAL));
+  return operand;
+}
+
+template <typename VAL>
+Operand output()
+{
+  return Operand{sizeof(VAL), LEGION_WRITE_DISCARD, 0, {}};
+}
+
+template <typename LG_OP>
+Operand reduction()
+{
+  using VAL = typename LG_OP::LHS;
+  Operand operand{sizeof(VAL), LEGION_REDUCE, LG_OP::REDOP_ID, std::vector<char>(sizeof(VAL))};
+  const VAL identity = LG_OP::identity;
+  memcpy(operand.fill.data(), &identity, sizeof(VAL));
+  return operand;
+}
+
+template <VariantKind KIND>
+struct Timer {
+  template <typename Body>
+  double operator()(int32_t reps, Body&& body) const
+  {
+    // The first run pays for the page faults and is left out
+    body();
+    auto start = std::chrono::steady_clock::now();
+    for (int32_t rep = 0; rep < reps; ++rep) body();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(stop - start).count() / reps;
+  }
+};
+
+// The dimensions every kernel is swept over
+constexpr int BENCH_MAX_DIM = 3;
+
+// Registers a kernel for each of the dimensions up to BENCH_MAX_DIM
+template <template <int> class KERNEL, int DIM = 1>
+void register_dims(const std::string& name,
+                   VariantKind kind,
+                   double bytes_per_element,
+                   double flops_per_element)
+{
+  kernels().push_back(Kernel{name + "/" + std::to_string(DIM) + "d",
+                             kind,
+                             DIM,
+                             KERNEL<DIM>::operands(),
+                             bytes_per_element,
+                             flops_per_element,
+                             KERNEL<DIM>::time});
+  if constexpr (DIM < BENCH_MAX_DIM)
+    register_dims<KERNEL, DIM + 1>(name, kind, bytes_per_element, flops_per_element);
+}
+
+}  // namespace bench
+}  // namespace cunumeric
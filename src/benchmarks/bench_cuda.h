@@ -0,0 +1,50 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "benchmarks/bench.h"
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+namespace bench {
+
+// GPU bodies only enqueue their kernels, so they are timed with events on the stream they
+// launch on
+template <>
+struct Timer<VariantKind::GPU> {
+  template <typename Body>
+  double operator()(int32_t reps, Body&& body) const
+  {
+    auto stream = get_cached_stream();
+    cudaEvent_t start, stop;
+    CHECK_CUDA(cudaEventCreate(&start));
+    CHECK_CUDA(cudaEventCreate(&stop));
+    body();
+    CHECK_CUDA(cudaEventRecord(start, stream));
+    for (int32_t rep = 0; rep < reps; ++rep) body();
+    CHECK_CUDA(cudaEventRecord(stop, stream));
+    CHECK_CUDA(cudaEventSynchronize(stop));
+    float elapsed_ms = 0;
+    CHECK_CUDA(cudaEventElapsedTime(&elapsed_ms, start, stop));
+    CHECK_CUDA(cudaEventDestroy(start));
+    CHECK_CUDA(cudaEventDestroy(stop));
+    return elapsed_ms / 1e3 / reps;
+  }
+};
+
+}  // namespace bench
+}  // namespace cunumeric
@@ -0,0 +1,85 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "benchmarks/bench.h"
+#include "cunumeric/binary/binary_op_util.h"
+#include "cunumeric/pitches.h"
+
+namespace cunumeric {
+namespace bench {
+
+using namespace Legion;
+using namespace legate;
+
+template <VariantKind KIND, BinaryOpCode OP_CODE, LegateTypeCode CODE>
+struct BinaryOpKernel {
+  using OP  = BinaryOp<OP_CODE, CODE>;
+  using ARG = legate_type_of<CODE>;
+  using RES = std::result_of_t<OP(ARG, ARG)>;
+
+  template <int DIM>
+  struct Body {
+    static std::vector<Operand> operands()
+    {
+      return {output<RES>(), input<ARG>(), input<ARG>()};
+    }
+
+    static double time(const std::vector<PhysicalRegion>& regions,
+                       const Domain& domain,
+                       int32_t reps)
+    {
+      const Rect<DIM> rect = domain;
+      AccessorWO<RES, DIM> out(regions[0], BENCH_FID);
+      AccessorRO<ARG, DIM> in1(regions[1], BENCH_FID);
+      AccessorRO<ARG, DIM> in2(regions[2], BENCH_FID);
+
+      Pitches<DIM - 1> pitches;
+      pitches.flatten(rect);
+      bool dense = out.accessor.is_dense_row_major(rect) &&
+                   in1.accessor.is_dense_row_major(rect) && in2.accessor.is_dense_row_major(rect);
+
+      OP func{std::vector<Store>{}};
+      return Timer<KIND>{}(reps, [&]() {
+        BinaryOpImplBody<KIND, OP_CODE, CODE, DIM>()(func, out, in1, in2, pitches, rect, dense);
+      });
+    }
+  };
+
+  static void record(const std::string& name)
+  {
+    register_dims<Body>(name, KIND, 2 * sizeof(ARG) + sizeof(RES), 1);
+  }
+};
+
+template <VariantKind KIND>
+void register_binary_op()
+{
+  BinaryOpKernel<KIND, BinaryOpCode::ADD, LegateTypeCode::INT32_LT>::record("binary_op/add/int32");
+  BinaryOpKernel<KIND, BinaryOpCode::ADD, LegateTypeCode::INT64_LT>::record("binary_op/add/int64");
+  BinaryOpKernel<KIND, BinaryOpCode::ADD, LegateTypeCode::FLOAT_LT>::record(
+    "binary_op/add/float32");
+  BinaryOpKernel<KIND, BinaryOpCode::ADD, LegateTypeCode::DOUBLE_LT>::record(
+    "binary_op/add/float64");
+  BinaryOpKernel<KIND, BinaryOpCode::MULTIPLY, LegateTypeCode::FLOAT_LT>::record(
+    "binary_op/multiply/float32");
+  BinaryOpKernel<KIND, BinaryOpCode::MULTIPLY, LegateTypeCode::DOUBLE_LT>::record(
+    "binary_op/multiply/float64");
+}
+
+}  // namespace bench
+}  // namespace cunumeric
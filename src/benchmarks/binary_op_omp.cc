@@ -0,0 +1,33 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/binary/binary_op_omp.cc"
+
+#include "benchmarks/binary_op.h"
+
+namespace cunumeric {
+namespace bench {
+
+namespace  // unnamed
+{
+static void __attribute__((constructor)) register_benchmarks(void)
+{
+  register_binary_op<VariantKind::OMP>();
+}
+}  // namespace
+
+}  // namespace bench
+}  // namespace cunumeric
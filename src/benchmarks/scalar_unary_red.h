@@ -0,0 +1,74 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "benchmarks/bench.h"
+#include "cunumeric/pitches.h"
+#include "cunumeric/unary/unary_red_util.h"
+
+namespace cunumeric {
+namespace bench {
+
+using namespace Legion;
+using namespace legate;
+
+template <VariantKind KIND, UnaryRedCode OP_CODE, LegateTypeCode CODE>
+struct ScalarUnaryRedKernel {
+  using OP    = UnaryRedOp<OP_CODE, CODE>;
+  using LG_OP = typename OP::OP;
+  using VAL   = legate_type_of<CODE>;
+
+  template <int DIM>
+  struct Body {
+    static std::vector<Operand> operands() { return {reduction<LG_OP>(), input<VAL>()}; }
+
+    static double time(const std::vector<PhysicalRegion>& regions,
+                       const Domain& domain,
+                       int32_t reps)
+    {
+      const Rect<DIM> rect = domain;
+      AccessorRD<LG_OP, true, 1> out(regions[0], BENCH_FID, LG_OP::REDOP_ID);
+      AccessorRO<VAL, DIM> in(regions[1], BENCH_FID);
+
+      Pitches<DIM - 1> pitches;
+      pitches.flatten(rect);
+      bool dense = in.accessor.is_dense_row_major(rect);
+
+      return Timer<KIND>{}(reps, [&]() {
+        ScalarUnaryRedImplBody<KIND, OP_CODE, CODE, DIM>()(OP{}, out, in, rect, pitches, dense);
+      });
+    }
+  };
+
+  static void record(const std::string& name) { register_dims<Body>(name, KIND, sizeof(VAL), 1); }
+};
+
+template <VariantKind KIND>
+void register_scalar_unary_red()
+{
+  ScalarUnaryRedKernel<KIND, UnaryRedCode::SUM, LegateTypeCode::INT64_LT>::record(
+    "scalar_unary_red/sum/int64");
+  ScalarUnaryRedKernel<KIND, UnaryRedCode::SUM, LegateTypeCode::FLOAT_LT>::record(
+    "scalar_unary_red/sum/float32");
+  ScalarUnaryRedKernel<KIND, UnaryRedCode::SUM, LegateTypeCode::DOUBLE_LT>::record(
+    "scalar_unary_red/sum/float64");
+  ScalarUnaryRedKernel<KIND, UnaryRedCode::MAX, LegateTypeCode::DOUBLE_LT>::record(
+    "scalar_unary_red/max/float64");
+}
+
+}  // namespace bench
+}  // namespace cunumeric
@@ -0,0 +1,78 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "benchmarks/bench.h"
+#include "cunumeric/pitches.h"
+#include "cunumeric/unary/unary_op_util.h"
+
+namespace cunumeric {
+namespace bench {
+
+using namespace Legion;
+using namespace legate;
+
+template <VariantKind KIND, UnaryOpCode OP_CODE, LegateTypeCode CODE>
+struct UnaryOpKernel {
+  using OP  = UnaryOp<OP_CODE, CODE>;
+  using ARG = typename OP::T;
+  using RES = std::result_of_t<OP(ARG)>;
+
+  template <int DIM>
+  struct Body {
+    static std::vector<Operand> operands() { return {output<RES>(), input<ARG>()}; }
+
+    static double time(const std::vector<PhysicalRegion>& regions,
+                       const Domain& domain,
+                       int32_t reps)
+    {
+      const Rect<DIM> rect = domain;
+      AccessorWO<RES, DIM> out(regions[0], BENCH_FID);
+      AccessorRO<ARG, DIM> in(regions[1], BENCH_FID);
+
+      Pitches<DIM - 1> pitches;
+      pitches.flatten(rect);
+      bool dense = out.accessor.is_dense_row_major(rect) && in.accessor.is_dense_row_major(rect);
+
+      OP func{std::vector<Store>{}};
+      return Timer<KIND>{}(reps, [&]() {
+        UnaryOpImplBody<KIND, OP_CODE, CODE, DIM>()(func, out, in, pitches, rect, dense);
+      });
+    }
+  };
+
+  static void record(const std::string& name)
+  {
+    register_dims<Body>(name, KIND, sizeof(ARG) + sizeof(RES), 1);
+  }
+};
+
+template <VariantKind KIND>
+void register_unary_op()
+{
+  UnaryOpKernel<KIND, UnaryOpCode::SQRT, LegateTypeCode::FLOAT_LT>::record("unary_op/sqrt/float32");
+  UnaryOpKernel<KIND, UnaryOpCode::SQRT, LegateTypeCode::DOUBLE_LT>::record(
+    "unary_op/sqrt/float64");
+  UnaryOpKernel<KIND, UnaryOpCode::EXP, LegateTypeCode::FLOAT_LT>::record("unary_op/exp/float32");
+  UnaryOpKernel<KIND, UnaryOpCode::EXP, LegateTypeCode::DOUBLE_LT>::record("unary_op/exp/float64");
+  UnaryOpKernel<KIND, UnaryOpCode::ERF, LegateTypeCode::FLOAT_LT>::record("unary_op/erf/float32");
+  UnaryOpKernel<KIND, UnaryOpCode::SIGMOID, LegateTypeCode::FLOAT_LT>::record(
+    "unary_op/sigmoid/float32");
+}
+
+}  // namespace bench
+}  // namespace cunumeric
@@ -16,69 +16,154 @@
 # List all the application source files that need OpenMP separately
 # since we have to add the -fopenmp flag to  CC_FLAGS for them
 GEN_CPU_SRC += cunumeric/ternary/where.cc               \
+							 cunumeric/ternary/fma.cc                 \
 							 cunumeric/binary/binary_op.cc            \
 							 cunumeric/binary/binary_red.cc           \
 							 cunumeric/unary/scalar_unary_red.cc      \
 							 cunumeric/unary/unary_op.cc              \
 							 cunumeric/unary/unary_red.cc             \
 							 cunumeric/unary/convert.cc               \
+							 cunumeric/unary/polyval.cc               \
 							 cunumeric/nullary/arange.cc              \
 							 cunumeric/nullary/eye.cc                 \
 							 cunumeric/nullary/fill.cc                \
                                                          cunumeric/index/choose.cc                \
+							 cunumeric/index/compress.cc              \
+							 cunumeric/index/place.cc                 \
+							 cunumeric/index/gather.cc                \
+							 cunumeric/index/scatter.cc               \
 							 cunumeric/item/read.cc                   \
 							 cunumeric/item/write.cc                  \
 							 cunumeric/matrix/contract.cc             \
 							 cunumeric/matrix/diag.cc                 \
 							 cunumeric/matrix/gemm.cc                 \
+							 cunumeric/matrix/geqrf.cc                \
+							 cunumeric/matrix/gesvd.cc                \
+							 cunumeric/matrix/getrf.cc                \
+							 cunumeric/matrix/getrs.cc                \
+							 cunumeric/matrix/laswp.cc                \
 							 cunumeric/matrix/matmul.cc               \
+							 cunumeric/matrix/batched_matmul.cc       \
+							 cunumeric/matrix/batched_solve.cc        \
 							 cunumeric/matrix/matvecmul.cc            \
 							 cunumeric/matrix/dot.cc                  \
+							 cunumeric/matrix/multi_dot.cc            \
 							 cunumeric/matrix/potrf.cc                \
 							 cunumeric/matrix/syrk.cc                 \
+							 cunumeric/matrix/gram.cc                 \
+							 cunumeric/matrix/spmm.cc                 \
+							 cunumeric/matrix/quantize.cc             \
+							 cunumeric/matrix/quantized_matvec.cc     \
 							 cunumeric/matrix/tile.cc                 \
+							 cunumeric/matrix/kron.cc                 \
+							 cunumeric/matrix/repeat.cc               \
 							 cunumeric/matrix/transpose.cc            \
+							 cunumeric/matrix/permute_copy.cc         \
 							 cunumeric/matrix/trilu.cc                \
 							 cunumeric/matrix/trsm.cc                 \
 							 cunumeric/matrix/util.cc                 \
 							 cunumeric/random/rand.cc                 \
 							 cunumeric/search/nonzero.cc              \
+							 cunumeric/search/topk.cc                 \
+							 cunumeric/search/sort.cc                 \
+							 cunumeric/search/bucket.cc               \
+							 cunumeric/search/searchsorted.cc         \
+							 cunumeric/search/interp.cc               \
+							 cunumeric/scan/scan.cc                   \
 							 cunumeric/stat/bincount.cc               \
+							 cunumeric/stat/histogram.cc              \
+							 cunumeric/stat/kmeans_assign.cc          \
+							 cunumeric/stat/segment_reduce.cc         \
+							 cunumeric/set/unique.cc                  \
 							 cunumeric/convolution/convolve.cc        \
+							 cunumeric/stencil/stencil.cc             \
+							 cunumeric/stencil/rolling.cc             \
+							 cunumeric/fft/fft.cc                     \
 							 cunumeric/transform/flip.cc              \
+							 cunumeric/transform/pad.cc               \
+							 cunumeric/transform/reshape.cc           \
+							 cunumeric/fused/fused_op.cc              \
+							 cunumeric/fused/lstm_gates.cc            \
+							 cunumeric/io/load_npy.cc                 \
+							 cunumeric/io/save_npy.cc                 \
+							 cunumeric/annotate.cc                    \
 							 cunumeric/arg.cc                         \
+							 cunumeric/cpu_caches.cc                  \
+							 cunumeric/huge_pages.cc                  \
+							 cunumeric/memory_report.cc               \
+							 cunumeric/roofline.cc                    \
 							 cunumeric/mapper.cc
 
 ifeq ($(strip $(USE_OPENMP)),1)
 GEN_CPU_SRC += cunumeric/ternary/where_omp.cc          \
+							 cunumeric/ternary/fma_omp.cc            \
 							 cunumeric/binary/binary_op_omp.cc       \
 							 cunumeric/binary/binary_red_omp.cc      \
 							 cunumeric/unary/unary_op_omp.cc         \
 							 cunumeric/unary/scalar_unary_red_omp.cc \
 							 cunumeric/unary/unary_red_omp.cc        \
 							 cunumeric/unary/convert_omp.cc          \
+							 cunumeric/unary/polyval_omp.cc          \
 							 cunumeric/nullary/arange_omp.cc         \
 							 cunumeric/nullary/eye_omp.cc            \
 							 cunumeric/nullary/fill_omp.cc           \
                                                          cunumeric/index/choose_omp.cc           \
+							 cunumeric/index/compress_omp.cc         \
+							 cunumeric/index/place_omp.cc            \
+							 cunumeric/index/gather_omp.cc           \
+							 cunumeric/index/scatter_omp.cc          \
 							 cunumeric/matrix/contract_omp.cc        \
 							 cunumeric/matrix/diag_omp.cc            \
 							 cunumeric/matrix/gemm_omp.cc            \
+							 cunumeric/matrix/geqrf_omp.cc           \
+							 cunumeric/matrix/gesvd_omp.cc           \
+							 cunumeric/matrix/getrf_omp.cc           \
+							 cunumeric/matrix/getrs_omp.cc           \
+							 cunumeric/matrix/laswp_omp.cc           \
 							 cunumeric/matrix/matmul_omp.cc          \
+							 cunumeric/matrix/batched_matmul_omp.cc  \
+							 cunumeric/matrix/batched_solve_omp.cc   \
 							 cunumeric/matrix/matvecmul_omp.cc       \
 							 cunumeric/matrix/dot_omp.cc             \
+							 cunumeric/matrix/multi_dot_omp.cc       \
 							 cunumeric/matrix/potrf_omp.cc           \
 							 cunumeric/matrix/syrk_omp.cc            \
+							 cunumeric/matrix/gram_omp.cc            \
+							 cunumeric/matrix/spmm_omp.cc            \
+							 cunumeric/matrix/quantize_omp.cc        \
+							 cunumeric/matrix/quantized_matvec_omp.cc \
 							 cunumeric/matrix/tile_omp.cc            \
+							 cunumeric/matrix/kron_omp.cc            \
+							 cunumeric/matrix/repeat_omp.cc          \
 							 cunumeric/matrix/transpose_omp.cc       \
+							 cunumeric/matrix/permute_copy_omp.cc    \
 							 cunumeric/matrix/trilu_omp.cc           \
 							 cunumeric/matrix/trsm_omp.cc            \
 							 cunumeric/matrix/util_omp.cc            \
 							 cunumeric/random/rand_omp.cc            \
 							 cunumeric/search/nonzero_omp.cc         \
+							 cunumeric/search/topk_omp.cc            \
+							 cunumeric/search/sort_omp.cc            \
+							 cunumeric/search/bucket_omp.cc          \
+							 cunumeric/search/searchsorted_omp.cc    \
+							 cunumeric/search/interp_omp.cc          \
+							 cunumeric/scan/scan_omp.cc              \
 							 cunumeric/stat/bincount_omp.cc          \
+							 cunumeric/stat/histogram_omp.cc         \
+							 cunumeric/stat/kmeans_assign_omp.cc     \
+							 cunumeric/stat/segment_reduce_omp.cc    \
+							 cunumeric/set/unique_omp.cc             \
 							 cunumeric/convolution/convolve_omp.cc   \
-							 cunumeric/transform/flip_omp.cc
+							 cunumeric/stencil/stencil_omp.cc        \
+							 cunumeric/stencil/rolling_omp.cc        \
+							 cunumeric/fft/fft_omp.cc                \
+							 cunumeric/transform/flip_omp.cc         \
+							 cunumeric/transform/pad_omp.cc          \
+							 cunumeric/transform/reshape_omp.cc      \
+							 cunumeric/fused/fused_op_omp.cc         \
+							 cunumeric/fused/lstm_gates_omp.cc       \
+							 cunumeric/io/load_npy_omp.cc            \
+							 cunumeric/io/save_npy_omp.cc
 endif
 
 GEN_CPU_SRC += cunumeric/cunumeric.cc # This must always be the last file!
@@ -86,34 +171,73 @@ GEN_CPU_SRC += cunumeric/cunumeric.cc # This must always be the last file!
                                       # only after all task variants are recorded
 
 GEN_GPU_SRC += cunumeric/ternary/where.cu               \
+							 cunumeric/ternary/fma.cu                 \
 							 cunumeric/binary/binary_op.cu            \
 							 cunumeric/binary/binary_red.cu           \
 							 cunumeric/unary/scalar_unary_red.cu      \
 							 cunumeric/unary/unary_red.cu             \
 							 cunumeric/unary/unary_op.cu              \
 							 cunumeric/unary/convert.cu               \
+							 cunumeric/unary/polyval.cu               \
 							 cunumeric/nullary/arange.cu              \
 							 cunumeric/nullary/eye.cu                 \
 							 cunumeric/nullary/fill.cu                \
 							 cunumeric/item/read.cu                   \
 							 cunumeric/item/write.cu                  \
                                                          cunumeric/index/choose.cu                \
+							 cunumeric/index/compress.cu              \
+							 cunumeric/index/place.cu                 \
+							 cunumeric/index/gather.cu                \
+							 cunumeric/index/scatter.cu               \
 							 cunumeric/matrix/contract.cu             \
 							 cunumeric/matrix/diag.cu                 \
 							 cunumeric/matrix/gemm.cu                 \
+							 cunumeric/matrix/geqrf.cu                \
+							 cunumeric/matrix/gesvd.cu                \
+							 cunumeric/matrix/getrf.cu                \
+							 cunumeric/matrix/getrs.cu                \
+							 cunumeric/matrix/laswp.cu                \
 							 cunumeric/matrix/matmul.cu               \
+							 cunumeric/matrix/batched_matmul.cu       \
+							 cunumeric/matrix/batched_solve.cu        \
 							 cunumeric/matrix/matvecmul.cu            \
 							 cunumeric/matrix/dot.cu                  \
+							 cunumeric/matrix/multi_dot.cu            \
 							 cunumeric/matrix/potrf.cu                \
 							 cunumeric/matrix/syrk.cu                 \
+							 cunumeric/matrix/gram.cu                 \
+							 cunumeric/matrix/spmm.cu                 \
+							 cunumeric/matrix/quantize.cu             \
+							 cunumeric/matrix/quantized_matvec.cu     \
 							 cunumeric/matrix/tile.cu                 \
+							 cunumeric/matrix/kron.cu                 \
+							 cunumeric/matrix/repeat.cu               \
 							 cunumeric/matrix/transpose.cu            \
+							 cunumeric/matrix/permute_copy.cu         \
 							 cunumeric/matrix/trilu.cu                \
 							 cunumeric/matrix/trsm.cu                 \
 							 cunumeric/random/rand.cu                 \
 							 cunumeric/search/nonzero.cu              \
+							 cunumeric/search/topk.cu                 \
+							 cunumeric/search/sort.cu                 \
+							 cunumeric/search/bucket.cu               \
+							 cunumeric/search/searchsorted.cu         \
+							 cunumeric/search/interp.cu               \
+							 cunumeric/scan/scan.cu                   \
 							 cunumeric/stat/bincount.cu               \
+							 cunumeric/stat/histogram.cu              \
+							 cunumeric/stat/kmeans_assign.cu          \
+							 cunumeric/stat/segment_reduce.cu         \
+							 cunumeric/set/unique.cu                  \
 							 cunumeric/convolution/convolve.cu	  \
+							 cunumeric/stencil/stencil.cu             \
+							 cunumeric/stencil/rolling.cu             \
+							 cunumeric/fft/fft.cu                     \
 							 cunumeric/transform/flip.cu              \
+							 cunumeric/transform/pad.cu               \
+							 cunumeric/transform/reshape.cu           \
+							 cunumeric/fused/fused_op.cu              \
+							 cunumeric/fused/lstm_gates.cu            \
 							 cunumeric/cudalibs.cu                    \
+							 cunumeric/launch_config.cu               \
 							 cunumeric/cunumeric.cu
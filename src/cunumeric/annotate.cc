@@ -0,0 +1,205 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/annotate.h"
+#include "cunumeric/binary/binary_op_util.h"
+#include "cunumeric/unary/unary_op_util.h"
+#include "cunumeric/unary/unary_red_util.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef LEGATE_USE_CUDA
+#include <nvtx3/nvToolsExt.h>
+#endif
+#ifdef CUNUMERIC_USE_ITT
+#include <ittnotify.h>
+#endif
+
+namespace cunumeric {
+
+using namespace legate;
+
+bool annotations_enabled()
+{
+  static const bool enabled = [] {
+    const char* value = getenv("CUNUMERIC_ANNOTATE");
+    return value != nullptr && atoi(value) > 0;
+  }();
+  return enabled;
+}
+
+const char* op_name(BinaryOpCode op_code)
+{
+  switch (op_code) {
+    case BinaryOpCode::ADD: return "ADD";
+    case BinaryOpCode::DIVIDE: return "DIVIDE";
+    case BinaryOpCode::EQUAL: return "EQUAL";
+    case BinaryOpCode::FLOOR_DIVIDE: return "FLOOR_DIVIDE";
+    case BinaryOpCode::GREATER: return "GREATER";
+    case BinaryOpCode::GREATER_EQUAL: return "GREATER_EQUAL";
+    case BinaryOpCode::LESS: return "LESS";
+    case BinaryOpCode::LESS_EQUAL: return "LESS_EQUAL";
+    case BinaryOpCode::LOGICAL_AND: return "LOGICAL_AND";
+    case BinaryOpCode::LOGICAL_OR: return "LOGICAL_OR";
+    case BinaryOpCode::LOGICAL_XOR: return "LOGICAL_XOR";
+    case BinaryOpCode::MAXIMUM: return "MAXIMUM";
+    case BinaryOpCode::MINIMUM: return "MINIMUM";
+    case BinaryOpCode::MOD: return "MOD";
+    case BinaryOpCode::MULTIPLY: return "MULTIPLY";
+    case BinaryOpCode::NOT_EQUAL: return "NOT_EQUAL";
+    case BinaryOpCode::POWER: return "POWER";
+    case BinaryOpCode::SUBTRACT: return "SUBTRACT";
+    case BinaryOpCode::ALLCLOSE: return "ALLCLOSE";
+    case BinaryOpCode::SOFTMAX: return "SOFTMAX";
+    case BinaryOpCode::MUL_CONJ: return "MUL_CONJ";
+  }
+  return "UNKNOWN";
+}
+
+const char* op_name(UnaryOpCode op_code)
+{
+  switch (op_code) {
+    case UnaryOpCode::ABSOLUTE: return "ABSOLUTE";
+    case UnaryOpCode::ARCCOS: return "ARCCOS";
+    case UnaryOpCode::ARCSIN: return "ARCSIN";
+    case UnaryOpCode::ARCTAN: return "ARCTAN";
+    case UnaryOpCode::CEIL: return "CEIL";
+    case UnaryOpCode::CLIP: return "CLIP";
+    case UnaryOpCode::COPY: return "COPY";
+    case UnaryOpCode::COS: return "COS";
+    case UnaryOpCode::EXP: return "EXP";
+    case UnaryOpCode::EXP2: return "EXP2";
+    case UnaryOpCode::FLOOR: return "FLOOR";
+    case UnaryOpCode::INVERT: return "INVERT";
+    case UnaryOpCode::ISINF: return "ISINF";
+    case UnaryOpCode::ISNAN: return "ISNAN";
+    case UnaryOpCode::LOG: return "LOG";
+    case UnaryOpCode::LOG10: return "LOG10";
+    case UnaryOpCode::LOGICAL_NOT: return "LOGICAL_NOT";
+    case UnaryOpCode::NEGATIVE: return "NEGATIVE";
+    case UnaryOpCode::RINT: return "RINT";
+    case UnaryOpCode::SIGN: return "SIGN";
+    case UnaryOpCode::SIN: return "SIN";
+    case UnaryOpCode::SQRT: return "SQRT";
+    case UnaryOpCode::TAN: return "TAN";
+    case UnaryOpCode::TANH: return "TANH";
+    case UnaryOpCode::CONJ: return "CONJ";
+    case UnaryOpCode::REAL: return "REAL";
+    case UnaryOpCode::IMAG: return "IMAG";
+    case UnaryOpCode::GETARG: return "GETARG";
+    case UnaryOpCode::GETVAR: return "GETVAR";
+    case UnaryOpCode::GETSUM: return "GETSUM";
+    case UnaryOpCode::GETNORM: return "GETNORM";
+    case UnaryOpCode::ERF: return "ERF";
+    case UnaryOpCode::EXPM1: return "EXPM1";
+    case UnaryOpCode::LOG1P: return "LOG1P";
+    case UnaryOpCode::SIGMOID: return "SIGMOID";
+    case UnaryOpCode::SOFTPLUS: return "SOFTPLUS";
+    case UnaryOpCode::GETLSE: return "GETLSE";
+    case UnaryOpCode::ABS2: return "ABS2";
+  }
+  return "UNKNOWN";
+}
+
+const char* op_name(UnaryRedCode op_code)
+{
+  switch (op_code) {
+    case UnaryRedCode::ALL: return "ALL";
+    case UnaryRedCode::ANY: return "ANY";
+    case UnaryRedCode::MAX: return "MAX";
+    case UnaryRedCode::MIN: return "MIN";
+    case UnaryRedCode::PROD: return "PROD";
+    case UnaryRedCode::SUM: return "SUM";
+    case UnaryRedCode::ARGMAX: return "ARGMAX";
+    case UnaryRedCode::ARGMIN: return "ARGMIN";
+    case UnaryRedCode::CONTAINS: return "CONTAINS";
+    case UnaryRedCode::COUNT_NONZERO: return "COUNT_NONZERO";
+    case UnaryRedCode::SUM_SQUARES: return "SUM_SQUARES";
+    case UnaryRedCode::VARIANCE: return "VARIANCE";
+    case UnaryRedCode::NANARGMAX: return "NANARGMAX";
+    case UnaryRedCode::NANARGMIN: return "NANARGMIN";
+    case UnaryRedCode::NANCOUNT: return "NANCOUNT";
+    case UnaryRedCode::NANMAX: return "NANMAX";
+    case UnaryRedCode::NANMIN: return "NANMIN";
+    case UnaryRedCode::NANPROD: return "NANPROD";
+    case UnaryRedCode::NANSUM: return "NANSUM";
+    case UnaryRedCode::BINNED_SUM: return "BINNED_SUM";
+    case UnaryRedCode::NORM1: return "NORM1";
+    case UnaryRedCode::NORM2: return "NORM2";
+    case UnaryRedCode::NORMINF: return "NORMINF";
+    case UnaryRedCode::NORMNEGINF: return "NORMNEGINF";
+    case UnaryRedCode::LOGSUMEXP: return "LOGSUMEXP";
+  }
+  return "UNKNOWN";
+}
+
+const char* type_name(LegateTypeCode code)
+{
+  switch (code) {
+    case LegateTypeCode::BOOL_LT: return "bool";
+    case LegateTypeCode::INT8_LT: return "int8";
+    case LegateTypeCode::INT16_LT: return "int16";
+    case LegateTypeCode::INT32_LT: return "int32";
+    case LegateTypeCode::INT64_LT: return "int64";
+    case LegateTypeCode::UINT8_LT: return "uint8";
+    case LegateTypeCode::UINT16_LT: return "uint16";
+    case LegateTypeCode::UINT32_LT: return "uint32";
+    case LegateTypeCode::UINT64_LT: return "uint64";
+    case LegateTypeCode::HALF_LT: return "float16";
+    case LegateTypeCode::FLOAT_LT: return "float32";
+    case LegateTypeCode::DOUBLE_LT: return "float64";
+    case LegateTypeCode::COMPLEX64_LT: return "complex64";
+    case LegateTypeCode::COMPLEX128_LT: return "complex128";
+    default: break;
+  }
+  return "unknown";
+}
+
+#ifdef CUNUMERIC_USE_ITT
+static __itt_domain* itt_domain()
+{
+  static __itt_domain* domain = __itt_domain_create("cunumeric");
+  return domain;
+}
+#endif
+
+void AnnotatedRange::push(
+  const char* task, const char* op, LegateTypeCode code, int32_t dim, size_t volume)
+{
+  char name[128];
+  snprintf(name, sizeof(name), "%s<%s,%s,%d>[%zu]", task, op, type_name(code), dim, volume);
+#ifdef LEGATE_USE_CUDA
+  nvtxRangePushA(name);
+#endif
+#ifdef CUNUMERIC_USE_ITT
+  // String handles are interned by ITT, so the same name always gets the same handle
+  __itt_task_begin(itt_domain(), __itt_null, __itt_null, __itt_string_handle_create(name));
+#endif
+  active_ = true;
+}
+
+void AnnotatedRange::pop()
+{
+#ifdef CUNUMERIC_USE_ITT
+  __itt_task_end(itt_domain());
+#endif
+#ifdef LEGATE_USE_CUDA
+  nvtxRangePop();
+#endif
+}
+
+}  // namespace cunumeric
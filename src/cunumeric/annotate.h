@@ -0,0 +1,61 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "cunumeric/cunumeric.h"
+
+namespace cunumeric {
+
+enum class BinaryOpCode : int;
+enum class UnaryOpCode : int;
+enum class UnaryRedCode : int;
+
+// Whether CUNUMERIC_ANNOTATE asks for the task bodies to be marked in profiler timelines
+bool annotations_enabled();
+
+const char* op_name(BinaryOpCode op_code);
+const char* op_name(UnaryOpCode op_code);
+const char* op_name(UnaryRedCode op_code);
+const char* type_name(legate::LegateTypeCode code);
+
+// Marks the lifetime of a dispatched task body as a range named after the op, the element
+// type, the dimension and the volume, e.g. binary_op<ADD,float64,2>[65536]. The range is an
+// NVTX range in CUDA builds, so nsys also shows it on the kernels launched inside, and an
+// ITT task in builds with CUNUMERIC_USE_ITT for VTune.
+class AnnotatedRange {
+ public:
+  template <typename OP_CODE>
+  AnnotatedRange(
+    const char* task, OP_CODE op_code, legate::LegateTypeCode code, int32_t dim, size_t volume)
+  {
+    if (annotations_enabled()) push(task, op_name(op_code), code, dim, volume);
+  }
+  ~AnnotatedRange()
+  {
+    if (active_) pop();
+  }
+
+ private:
+  void push(
+    const char* task, const char* op, legate::LegateTypeCode code, int32_t dim, size_t volume);
+  void pop();
+
+ private:
+  bool active_{false};
+};
+
+}  // namespace cunumeric
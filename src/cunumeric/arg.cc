@@ -46,6 +46,19 @@ DEFINE_IDENTITIES(uint32_t)
 DEFINE_IDENTITIES(uint64_t)
 DEFINE_IDENTITIES(complex<float>)
 
+template <>
+const Welford<float> VarianceReduction<float>::identity = Welford<float>();
+template <>
+const Welford<double> VarianceReduction<double>::identity = Welford<double>();
+template <>
+const BinnedSum<float> BinnedSumReduction<float>::identity = BinnedSum<float>();
+template <>
+const BinnedSum<double> BinnedSumReduction<double>::identity = BinnedSum<double>();
+template <>
+const ScaledSquares<float> NormReduction<float>::identity = ScaledSquares<float>();
+template <>
+const ScaledSquares<double> NormReduction<double>::identity = ScaledSquares<double>();
+
 #define _REGISTER_REDOP(ID, TYPE) Runtime::register_reduction_op<TYPE>(ID);
 
 #define REGISTER_REDOPS(OP)                                                                        \
@@ -69,6 +82,25 @@ void register_cpu_reduction_operators(legate::LibraryContext& context)
 {
   REGISTER_REDOPS(ArgmaxReduction);
   REGISTER_REDOPS(ArgminReduction);
+  // Variances are only computed in floating point
+  _REGISTER_REDOP(context.get_reduction_op_id(VarianceReduction<float>::REDOP_ID),
+                  VarianceReduction<float>)
+  _REGISTER_REDOP(context.get_reduction_op_id(VarianceReduction<double>::REDOP_ID),
+                  VarianceReduction<double>)
+  // So are the reproducible sums
+  _REGISTER_REDOP(context.get_reduction_op_id(BinnedSumReduction<float>::REDOP_ID),
+                  BinnedSumReduction<float>)
+  _REGISTER_REDOP(context.get_reduction_op_id(BinnedSumReduction<double>::REDOP_ID),
+                  BinnedSumReduction<double>)
+  // And the 2-norms
+  _REGISTER_REDOP(context.get_reduction_op_id(NormReduction<float>::REDOP_ID), NormReduction<float>)
+  _REGISTER_REDOP(context.get_reduction_op_id(NormReduction<double>::REDOP_ID),
+                  NormReduction<double>)
+  // And the logs of sums of exponentials
+  _REGISTER_REDOP(context.get_reduction_op_id(LogSumExpReduction<float>::REDOP_ID),
+                  LogSumExpReduction<float>)
+  _REGISTER_REDOP(context.get_reduction_op_id(LogSumExpReduction<double>::REDOP_ID),
+                  LogSumExpReduction<double>)
 }
 
 }  // namespace cunumeric
@@ -16,6 +16,10 @@
 
 #pragma once
 
+#include <cmath>
+#include <cstring>
+#include <limits>
+
 #include "legate.h"
 
 #include "cunumeric/cunumeric_c.h"
@@ -99,6 +103,365 @@ class ArgminReduction {
   }
 };
 
+namespace detail {
+
+// Maps 32-bit values to unsigned words that compare the same way as the values
+template <typename T>
+struct OrderedBits;
+
+template <>
+struct OrderedBits<float> {
+  __CUDA_HD__ inline static uint32_t encode(float value)
+  {
+    // Negative and positive zeros compare equal, so they get the same bits
+    if (value == 0.f) value = 0.f;
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+  }
+  __CUDA_HD__ inline static float decode(uint32_t bits)
+  {
+    bits = (bits & 0x80000000u) ? bits ^ 0x80000000u : ~bits;
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+};
+
+template <>
+struct OrderedBits<int32_t> {
+  __CUDA_HD__ inline static uint32_t encode(int32_t value)
+  {
+    return static_cast<uint32_t>(value) ^ 0x80000000u;
+  }
+  __CUDA_HD__ inline static int32_t decode(uint32_t bits)
+  {
+    return static_cast<int32_t>(bits ^ 0x80000000u);
+  }
+};
+
+template <typename T, bool MAX>
+struct PackedArgvalBase {
+  static constexpr bool valid = true;
+
+  // Indices must leave the all-ones lower half to the identity
+  static constexpr int64_t MAX_INDEX = static_cast<int64_t>(UINT32_MAX) - 1;
+  static constexpr uint64_t identity = MAX ? 0 : ~0ULL;
+
+  __CUDA_HD__ inline static uint64_t pack(const Argval<T>& value)
+  {
+    uint32_t bits;
+    // NaNs win the reduction, as in NumPy
+    if (value.arg_value != value.arg_value)
+      bits = MAX ? ~0u : 0u;
+    else
+      bits = OrderedBits<T>::encode(value.arg_value);
+    // The index is complemented for argmax so that smaller indices still win ties
+    const uint32_t index = static_cast<uint32_t>(value.arg);
+    return (static_cast<uint64_t>(bits) << 32) | (MAX ? ~index : index);
+  }
+  __CUDA_HD__ inline static Argval<T> unpack(uint64_t packed)
+  {
+    const uint32_t index = static_cast<uint32_t>(packed);
+    return Argval<T>(MAX ? ~index : index, OrderedBits<T>::decode(packed >> 32));
+  }
+  __CUDA_HD__ inline static void fold(uint64_t& lhs, uint64_t rhs)
+  {
+    if (MAX ? rhs > lhs : rhs < lhs) lhs = rhs;
+  }
+#ifdef __CUDACC__
+  __device__ inline static void atomic_fold(uint64_t* lhs, uint64_t rhs)
+  {
+    auto ptr = reinterpret_cast<unsigned long long*>(lhs);
+    if (MAX)
+      atomicMax(ptr, static_cast<unsigned long long>(rhs));
+    else
+      atomicMin(ptr, static_cast<unsigned long long>(rhs));
+  }
+#endif
+};
+
+}  // namespace detail
+
+// Argvals of 32-bit values packed into single 64-bit words, with the value in the upper
+// half and the index in the lower one, such that the arg reduction of a set of Argvals
+// is the plain max or min of their words. This lets the GPU fold them with one atomicMax
+// or atomicMin instead of locking the 16-byte struct. Ties go to the smallest index.
+template <typename REDOP>
+struct PackedArgval {
+  static constexpr bool valid = false;
+};
+
+template <>
+struct PackedArgval<ArgmaxReduction<float>> : detail::PackedArgvalBase<float, true> {};
+template <>
+struct PackedArgval<ArgminReduction<float>> : detail::PackedArgvalBase<float, false> {};
+template <>
+struct PackedArgval<ArgmaxReduction<int32_t>> : detail::PackedArgvalBase<int32_t, true> {};
+template <>
+struct PackedArgval<ArgminReduction<int32_t>> : detail::PackedArgvalBase<int32_t, false> {};
+
+// Running count, mean and sum of squared deviations from the mean of a set of values.
+// Two of them merge into the statistics of the union of their sets, so the variance
+// can be computed in a single pass without the cancellation of E[x^2] - E[x]^2.
+template <typename T>
+class Welford {
+ public:
+  __CUDA_HD__
+  Welford();
+  __CUDA_HD__
+  Welford(T value);
+  __CUDA_HD__
+  Welford(int64_t count, T mean, T m2);
+  __CUDA_HD__
+  Welford(const Welford& other);
+
+ public:
+  template <bool EXCLUSIVE>
+  __CUDA_HD__ inline void apply(const Welford<T>& rhs);
+
+ public:
+  __CUDA_HD__ Welford& operator=(const Welford& other)
+  {
+    count = other.count;
+    mean  = other.mean;
+    m2    = other.m2;
+    return *this;
+  }
+  constexpr bool operator!=(const Welford& other) const
+  {
+    return count != other.count || mean != other.mean || m2 != other.m2;
+  }
+
+ public:
+  int64_t count;
+  T mean;
+  T m2;
+};
+
+template <typename T>
+class VarianceReduction {
+ public:
+  using LHS = Welford<T>;
+  using RHS = Welford<T>;
+
+  static const Welford<T> identity;
+  static const int32_t REDOP_ID =
+    CUNUMERIC_VARIANCE_REDOP * MAX_TYPE_NUMBER + legate::legate_type_code_of<T>;
+
+  template <bool EXCLUSIVE>
+  __CUDA_HD__ inline static void apply(LHS& lhs, RHS rhs)
+  {
+    lhs.template apply<EXCLUSIVE>(rhs);
+  }
+  template <bool EXCLUSIVE>
+  __CUDA_HD__ inline static void fold(RHS& rhs1, RHS rhs2)
+  {
+    rhs1.template apply<EXCLUSIVE>(rhs2);
+  }
+};
+
+// Sum whose bits do not depend on the order in which the values are added. Values are
+// cut along fixed bin boundaries, BIN_WIDTH bits apart, into integer multiples of the
+// bins they span, and the accumulator keeps the exact integer sums of the NUM_BINS bins
+// up to the highest one reached so far. Since a value is always cut the same way and
+// integer additions associate, merging accumulators in any order gives the same state,
+// and the bins that fall out of range as larger values come in drop the same digits.
+// This leaves at least (NUM_BINS - 1) * BIN_WIDTH bits below the largest value.
+template <typename T>
+class BinnedSum {
+ public:
+  static constexpr int32_t NUM_BINS  = 3;
+  static constexpr int32_t BIN_WIDTH = 30;
+  // Puts the bins of all finite values above zero, which is left to the empty sum
+  // and keeps -1 free for the lock
+  static constexpr int32_t EXPONENT_BIAS = 1110;
+
+ public:
+  __CUDA_HD__
+  BinnedSum();
+  __CUDA_HD__
+  BinnedSum(T value);
+  __CUDA_HD__
+  BinnedSum(const BinnedSum& other);
+
+ public:
+  template <bool EXCLUSIVE>
+  __CUDA_HD__ inline void apply(const BinnedSum<T>& rhs);
+  // Rounds the sum to the nearest value of type T
+  __CUDA_HD__ inline T value() const;
+
+ public:
+  __CUDA_HD__ BinnedSum& operator=(const BinnedSum& other)
+  {
+    top = other.top;
+    for (int32_t idx = 0; idx < NUM_BINS; ++idx) bins[idx] = other.bins[idx];
+    special = other.special;
+    return *this;
+  }
+  constexpr bool operator!=(const BinnedSum& other) const
+  {
+    if (top != other.top || special != other.special) return true;
+    for (int32_t idx = 0; idx < NUM_BINS; ++idx)
+      if (bins[idx] != other.bins[idx]) return true;
+    return false;
+  }
+
+ public:
+  // Highest bin reached, or zero for the empty sum
+  int64_t top;
+  // bins[idx] holds the sum of bin top - idx
+  int64_t bins[NUM_BINS];
+  // Sum of the infinities and NaNs, which have no bins
+  T special;
+};
+
+template <typename T>
+class BinnedSumReduction {
+ public:
+  using LHS = BinnedSum<T>;
+  using RHS = BinnedSum<T>;
+
+  static const BinnedSum<T> identity;
+  static const int32_t REDOP_ID =
+    CUNUMERIC_BINNED_SUM_REDOP * MAX_TYPE_NUMBER + legate::legate_type_code_of<T>;
+
+  template <bool EXCLUSIVE>
+  __CUDA_HD__ inline static void apply(LHS& lhs, RHS rhs)
+  {
+    lhs.template apply<EXCLUSIVE>(rhs);
+  }
+  template <bool EXCLUSIVE>
+  __CUDA_HD__ inline static void fold(RHS& rhs1, RHS rhs2)
+  {
+    rhs1.template apply<EXCLUSIVE>(rhs2);
+  }
+};
+
+// Sum of squares of a set of values kept as scale^2 * ssq, where scale is the
+// largest magnitude seen so far, the way LAPACK's nrm2 does. The squares are taken
+// relative to the scale, so the 2-norm scale * sqrt(ssq) neither overflows nor
+// underflows unless the norm itself does.
+template <typename T>
+class ScaledSquares {
+ public:
+  __CUDA_HD__
+  ScaledSquares();
+  __CUDA_HD__
+  ScaledSquares(T value);
+  __CUDA_HD__
+  ScaledSquares(int64_t count, T scale, T ssq);
+  __CUDA_HD__
+  ScaledSquares(const ScaledSquares& other);
+
+ public:
+  template <bool EXCLUSIVE>
+  __CUDA_HD__ inline void apply(const ScaledSquares<T>& rhs);
+
+ public:
+  __CUDA_HD__ ScaledSquares& operator=(const ScaledSquares& other)
+  {
+    count = other.count;
+    scale = other.scale;
+    ssq   = other.ssq;
+    return *this;
+  }
+  constexpr bool operator!=(const ScaledSquares& other) const
+  {
+    return count != other.count || scale != other.scale || ssq != other.ssq;
+  }
+
+ public:
+  // Only used to lock the accumulator, like the count of Welford
+  int64_t count;
+  T scale;
+  T ssq;
+};
+
+template <typename T>
+class NormReduction {
+ public:
+  using LHS = ScaledSquares<T>;
+  using RHS = ScaledSquares<T>;
+
+  static const ScaledSquares<T> identity;
+  static const int32_t REDOP_ID =
+    CUNUMERIC_NORM_REDOP * MAX_TYPE_NUMBER + legate::legate_type_code_of<T>;
+
+  template <bool EXCLUSIVE>
+  __CUDA_HD__ inline static void apply(LHS& lhs, RHS rhs)
+  {
+    lhs.template apply<EXCLUSIVE>(rhs);
+  }
+  template <bool EXCLUSIVE>
+  __CUDA_HD__ inline static void fold(RHS& rhs1, RHS rhs2)
+  {
+    rhs1.template apply<EXCLUSIVE>(rhs2);
+  }
+};
+
+// Running maximum of a set of values and sum of their exponentials relative to it, as in
+// the online softmax. Two of them merge by rescaling the sum of whichever side has the
+// smaller maximum, so the log of the sum of exponentials max + log(sum) takes a single
+// pass and does not overflow.
+template <typename T>
+class LogSumExp {
+ public:
+  __CUDA_HD__
+  LogSumExp();
+  __CUDA_HD__
+  LogSumExp(T value);
+  __CUDA_HD__
+  LogSumExp(int64_t count, T max, T sum);
+  __CUDA_HD__
+  LogSumExp(const LogSumExp& other);
+
+ public:
+  template <bool EXCLUSIVE>
+  __CUDA_HD__ inline void apply(const LogSumExp<T>& rhs);
+
+ public:
+  __CUDA_HD__ LogSumExp& operator=(const LogSumExp& other)
+  {
+    count = other.count;
+    max   = other.max;
+    sum   = other.sum;
+    return *this;
+  }
+  constexpr bool operator!=(const LogSumExp& other) const
+  {
+    return count != other.count || max != other.max || sum != other.sum;
+  }
+
+ public:
+  // Only used to lock the accumulator, like the count of Welford
+  int64_t count;
+  T max;
+  T sum;
+};
+
+template <typename T>
+class LogSumExpReduction {
+ public:
+  using LHS = LogSumExp<T>;
+  using RHS = LogSumExp<T>;
+
+  static const LogSumExp<T> identity;
+  static const int32_t REDOP_ID =
+    CUNUMERIC_LOGSUMEXP_REDOP * MAX_TYPE_NUMBER + legate::legate_type_code_of<T>;
+
+  template <bool EXCLUSIVE>
+  __CUDA_HD__ inline static void apply(LHS& lhs, RHS rhs)
+  {
+    lhs.template apply<EXCLUSIVE>(rhs);
+  }
+  template <bool EXCLUSIVE>
+  __CUDA_HD__ inline static void fold(RHS& rhs1, RHS rhs2)
+  {
+    rhs1.template apply<EXCLUSIVE>(rhs2);
+  }
+};
+
 }  // namespace cunumeric
 
 #include "arg.inl"
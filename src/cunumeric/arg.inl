@@ -112,6 +112,406 @@ __CUDA_HD__ inline void Argval<T>::apply(const Argval<T>& rhs)
   }
 }
 
+template <typename T>
+__CUDA_HD__ Welford<T>::Welford() : count(0), mean(0), m2(0)
+{
+}
+
+template <typename T>
+__CUDA_HD__ Welford<T>::Welford(T v) : count(1), mean(v), m2(0)
+{
+}
+
+template <typename T>
+__CUDA_HD__ Welford<T>::Welford(int64_t c, T u, T s) : count(c), mean(u), m2(s)
+{
+}
+
+template <typename T>
+__CUDA_HD__ Welford<T>::Welford(const Welford& other)
+  : count(other.count), mean(other.mean), m2(other.m2)
+{
+}
+
+namespace detail {
+
+// Chan et al.'s pairwise update, which reduces to Welford's when rhs holds a single value
+template <typename T>
+__CUDA_HD__ inline void merge_welford(int64_t& count, T& mean, T& m2, const Welford<T>& rhs)
+{
+  if (rhs.count == 0) return;
+  if (count == 0) {
+    count = rhs.count;
+    mean  = rhs.mean;
+    m2    = rhs.m2;
+    return;
+  }
+  const int64_t total = count + rhs.count;
+  const T delta       = rhs.mean - mean;
+  const T weight      = static_cast<T>(rhs.count) / static_cast<T>(total);
+  mean += delta * weight;
+  m2 += rhs.m2 + delta * delta * static_cast<T>(count) * weight;
+  count = total;
+}
+
+}  // namespace detail
+
+template <typename T>
+template <bool EXCLUSIVE>
+__CUDA_HD__ inline void Welford<T>::apply(const Welford<T>& rhs)
+{
+  if (EXCLUSIVE) {
+    detail::merge_welford(count, mean, m2, rhs);
+  } else {
+    // Handle conflicts here the same way as Argval does: the count
+    // is locked by swapping in -1, which can never be a valid count
+#ifdef __CUDA_ARCH__
+    const unsigned long long guard = (unsigned long long)-1LL;
+    unsigned long long* ptr        = (unsigned long long*)&count;
+    union {
+      long long as_signed;
+      unsigned long long as_unsigned;
+    } next, current;
+    next.as_signed = *ptr;
+    do {
+      current.as_signed = next.as_signed;
+      next.as_unsigned  = atomicCAS(ptr, current.as_unsigned, guard);
+    } while ((next.as_signed != current.as_signed) || (next.as_signed == -1LL));
+    // Memory fence to prevent the compiler from hoisting the loads
+    __threadfence();
+    int64_t locked_count = next.as_signed;
+    detail::merge_welford(locked_count, mean, m2, rhs);
+    // Memory fence to make sure the new mean and m2 are visible before the unlock
+    __threadfence();
+    next.as_signed = locked_count;
+    atomicCAS(ptr, guard, next.as_unsigned);
+#else
+    volatile long long* ptr = (volatile long long*)&count;
+    long long next          = *ptr;
+    long long current;
+    do {
+      current = next;
+      next    = __sync_val_compare_and_swap(ptr, current, -1);
+    } while ((next != current) || (next == -1));
+    // Memory fence to prevent the compiler from hoisting the loads
+    __sync_synchronize();
+    int64_t locked_count = next;
+    detail::merge_welford(locked_count, mean, m2, rhs);
+    // Memory fence to make sure the new mean and m2 are visible before the unlock
+    __sync_synchronize();
+    __sync_val_compare_and_swap(ptr, -1, locked_count);
+#endif
+  }
+}
+
+template <typename T>
+__CUDA_HD__ BinnedSum<T>::BinnedSum() : top(0), bins{0}, special(0)
+{
+}
+
+template <typename T>
+__CUDA_HD__ BinnedSum<T>::BinnedSum(T v) : top(0), bins{0}, special(0)
+{
+  const double value = static_cast<double>(v);
+  if (value == 0) return;
+  if (value - value != 0) {
+    // Infinities and NaNs
+    special = v;
+    return;
+  }
+  int32_t exponent;
+  frexp(value, &exponent);
+  top = (exponent - 1 + EXPONENT_BIAS) / BIN_WIDTH;
+  // Scaling by a power of two is exact, and the scaled value is below 2^(NUM_BINS * BIN_WIDTH)
+  const int64_t bottom = top - NUM_BINS + 1;
+  double rest          = ldexp(value, static_cast<int32_t>(EXPONENT_BIAS - bottom * BIN_WIDTH));
+  for (int32_t idx = 0; idx < NUM_BINS; ++idx) {
+    const double scale = ldexp(1.0, (NUM_BINS - 1 - idx) * BIN_WIDTH);
+    const double digit = trunc(rest / scale);
+    bins[idx]          = static_cast<int64_t>(digit);
+    rest -= digit * scale;
+  }
+}
+
+template <typename T>
+__CUDA_HD__ BinnedSum<T>::BinnedSum(const BinnedSum& other) : top(other.top), special(other.special)
+{
+  for (int32_t idx = 0; idx < NUM_BINS; ++idx) bins[idx] = other.bins[idx];
+}
+
+namespace detail {
+
+template <typename T>
+__CUDA_HD__ inline void merge_binned_sum(int64_t& top,
+                                         int64_t* bins,
+                                         T& special,
+                                         const BinnedSum<T>& rhs)
+{
+  constexpr int32_t NUM_BINS = BinnedSum<T>::NUM_BINS;
+  special += rhs.special;
+  if (rhs.top == 0) return;
+  if (top < rhs.top) {
+    // Move up to the higher bins of rhs and drop those that fall out of range
+    const int64_t shift = rhs.top - top;
+    for (int32_t idx = NUM_BINS - 1; idx >= 0; --idx)
+      bins[idx] = idx >= shift ? bins[idx - shift] : 0;
+    top = rhs.top;
+  }
+  const int64_t shift = top - rhs.top;
+  for (int32_t idx = 0; idx + shift < NUM_BINS; ++idx) bins[idx + shift] += rhs.bins[idx];
+}
+
+}  // namespace detail
+
+template <typename T>
+template <bool EXCLUSIVE>
+__CUDA_HD__ inline void BinnedSum<T>::apply(const BinnedSum<T>& rhs)
+{
+  if (EXCLUSIVE) {
+    detail::merge_binned_sum(top, bins, special, rhs);
+  } else {
+    // Lock the top bin by swapping in -1, like Welford does with its count
+#ifdef __CUDA_ARCH__
+    const unsigned long long guard = (unsigned long long)-1LL;
+    unsigned long long* ptr        = (unsigned long long*)&top;
+    union {
+      long long as_signed;
+      unsigned long long as_unsigned;
+    } next, current;
+    next.as_signed = *ptr;
+    do {
+      current.as_signed = next.as_signed;
+      next.as_unsigned  = atomicCAS(ptr, current.as_unsigned, guard);
+    } while ((next.as_signed != current.as_signed) || (next.as_signed == -1LL));
+    // Memory fence to prevent the compiler from hoisting the loads
+    __threadfence();
+    int64_t locked_top = next.as_signed;
+    detail::merge_binned_sum(locked_top, bins, special, rhs);
+    // Memory fence to make sure the new bins are visible before the unlock
+    __threadfence();
+    next.as_signed = locked_top;
+    atomicCAS(ptr, guard, next.as_unsigned);
+#else
+    volatile long long* ptr = (volatile long long*)&top;
+    long long next          = *ptr;
+    long long current;
+    do {
+      current = next;
+      next    = __sync_val_compare_and_swap(ptr, current, -1);
+    } while ((next != current) || (next == -1));
+    // Memory fence to prevent the compiler from hoisting the loads
+    __sync_synchronize();
+    int64_t locked_top = next;
+    detail::merge_binned_sum(locked_top, bins, special, rhs);
+    // Memory fence to make sure the new bins are visible before the unlock
+    __sync_synchronize();
+    __sync_val_compare_and_swap(ptr, -1, locked_top);
+#endif
+  }
+}
+
+template <typename T>
+__CUDA_HD__ inline T BinnedSum<T>::value() const
+{
+  if (special != 0) return special;
+  // The state is the same whatever the order of the additions, and so is its rounding
+  double total = 0;
+  for (int32_t idx = NUM_BINS - 1; idx >= 0; --idx)
+    total += ldexp(static_cast<double>(bins[idx]),
+                   static_cast<int32_t>((top - idx) * BIN_WIDTH - EXPONENT_BIAS));
+  return static_cast<T>(total);
+}
+
+template <typename T>
+__CUDA_HD__ ScaledSquares<T>::ScaledSquares() : count(0), scale(0), ssq(0)
+{
+}
+
+template <typename T>
+__CUDA_HD__ ScaledSquares<T>::ScaledSquares(T v)
+  : count(1), scale(v < T(0) ? -v : v), ssq(v != T(0) ? 1 : 0)
+{
+}
+
+template <typename T>
+__CUDA_HD__ ScaledSquares<T>::ScaledSquares(int64_t c, T s, T q) : count(c), scale(s), ssq(q)
+{
+}
+
+template <typename T>
+__CUDA_HD__ ScaledSquares<T>::ScaledSquares(const ScaledSquares& other)
+  : count(other.count), scale(other.scale), ssq(other.ssq)
+{
+}
+
+namespace detail {
+
+// Rescales the squares of whichever side has the smaller scale. Equal scales are added
+// directly, so that infinities do not turn into NaNs, and NaNs end up in ssq either way.
+template <typename T>
+__CUDA_HD__ inline void merge_scaled_squares(int64_t& count,
+                                             T& scale,
+                                             T& ssq,
+                                             const ScaledSquares<T>& rhs)
+{
+  if (rhs.count == 0) return;
+  count += rhs.count;
+  if (rhs.scale > scale) {
+    const T ratio = scale / rhs.scale;
+    ssq           = rhs.ssq + ssq * ratio * ratio;
+    scale         = rhs.scale;
+  } else if (rhs.scale == scale) {
+    ssq += rhs.ssq;
+  } else {
+    const T ratio = rhs.scale / scale;
+    ssq += rhs.ssq * ratio * ratio;
+  }
+}
+
+}  // namespace detail
+
+template <typename T>
+template <bool EXCLUSIVE>
+__CUDA_HD__ inline void ScaledSquares<T>::apply(const ScaledSquares<T>& rhs)
+{
+  if (EXCLUSIVE) {
+    detail::merge_scaled_squares(count, scale, ssq, rhs);
+  } else {
+    // Lock the count by swapping in -1, like Welford does
+#ifdef __CUDA_ARCH__
+    const unsigned long long guard = (unsigned long long)-1LL;
+    unsigned long long* ptr        = (unsigned long long*)&count;
+    union {
+      long long as_signed;
+      unsigned long long as_unsigned;
+    } next, current;
+    next.as_signed = *ptr;
+    do {
+      current.as_signed = next.as_signed;
+      next.as_unsigned  = atomicCAS(ptr, current.as_unsigned, guard);
+    } while ((next.as_signed != current.as_signed) || (next.as_signed == -1LL));
+    // Memory fence to prevent the compiler from hoisting the loads
+    __threadfence();
+    int64_t locked_count = next.as_signed;
+    detail::merge_scaled_squares(locked_count, scale, ssq, rhs);
+    // Memory fence to make sure the new scale and ssq are visible before the unlock
+    __threadfence();
+    next.as_signed = locked_count;
+    atomicCAS(ptr, guard, next.as_unsigned);
+#else
+    volatile long long* ptr = (volatile long long*)&count;
+    long long next          = *ptr;
+    long long current;
+    do {
+      current = next;
+      next    = __sync_val_compare_and_swap(ptr, current, -1);
+    } while ((next != current) || (next == -1));
+    // Memory fence to prevent the compiler from hoisting the loads
+    __sync_synchronize();
+    int64_t locked_count = next;
+    detail::merge_scaled_squares(locked_count, scale, ssq, rhs);
+    // Memory fence to make sure the new scale and ssq are visible before the unlock
+    __sync_synchronize();
+    __sync_val_compare_and_swap(ptr, -1, locked_count);
+#endif
+  }
+}
+
+template <typename T>
+__CUDA_HD__ LogSumExp<T>::LogSumExp()
+  : count(0), max(-std::numeric_limits<T>::infinity()), sum(0)
+{
+}
+
+template <typename T>
+__CUDA_HD__ LogSumExp<T>::LogSumExp(T v) : count(1), max(v), sum(1)
+{
+}
+
+template <typename T>
+__CUDA_HD__ LogSumExp<T>::LogSumExp(int64_t c, T m, T s) : count(c), max(m), sum(s)
+{
+}
+
+template <typename T>
+__CUDA_HD__ LogSumExp<T>::LogSumExp(const LogSumExp& other)
+  : count(other.count), max(other.max), sum(other.sum)
+{
+}
+
+namespace detail {
+
+// Rescales the sum of whichever side has the smaller maximum. Equal maxima are added
+// directly, so that infinite maxima do not turn into NaNs, and NaNs end up in the sum
+// either way.
+template <typename T>
+__CUDA_HD__ inline void merge_log_sum_exp(int64_t& count,
+                                          T& max,
+                                          T& sum,
+                                          const LogSumExp<T>& rhs)
+{
+  using std::exp;
+  if (rhs.count == 0) return;
+  count += rhs.count;
+  if (rhs.max > max) {
+    sum = rhs.sum + sum * exp(max - rhs.max);
+    max = rhs.max;
+  } else if (rhs.max == max) {
+    sum += rhs.sum;
+  } else {
+    sum += rhs.sum * exp(rhs.max - max);
+  }
+}
+
+}  // namespace detail
+
+template <typename T>
+template <bool EXCLUSIVE>
+__CUDA_HD__ inline void LogSumExp<T>::apply(const LogSumExp<T>& rhs)
+{
+  if (EXCLUSIVE) {
+    detail::merge_log_sum_exp(count, max, sum, rhs);
+  } else {
+    // Lock the count by swapping in -1, like Welford does
+#ifdef __CUDA_ARCH__
+    const unsigned long long guard = (unsigned long long)-1LL;
+    unsigned long long* ptr        = (unsigned long long*)&count;
+    union {
+      long long as_signed;
+      unsigned long long as_unsigned;
+    } next, current;
+    next.as_signed = *ptr;
+    do {
+      current.as_signed = next.as_signed;
+      next.as_unsigned  = atomicCAS(ptr, current.as_unsigned, guard);
+    } while ((next.as_signed != current.as_signed) || (next.as_signed == -1LL));
+    // Memory fence to prevent the compiler from hoisting the loads
+    __threadfence();
+    int64_t locked_count = next.as_signed;
+    detail::merge_log_sum_exp(locked_count, max, sum, rhs);
+    // Memory fence to make sure the new max and sum are visible before the unlock
+    __threadfence();
+    next.as_signed = locked_count;
+    atomicCAS(ptr, guard, next.as_unsigned);
+#else
+    volatile long long* ptr = (volatile long long*)&count;
+    long long next          = *ptr;
+    long long current;
+    do {
+      current = next;
+      next    = __sync_val_compare_and_swap(ptr, current, -1);
+    } while ((next != current) || (next == -1));
+    // Memory fence to prevent the compiler from hoisting the loads
+    __sync_synchronize();
+    int64_t locked_count = next;
+    detail::merge_log_sum_exp(locked_count, max, sum, rhs);
+    // Memory fence to make sure the new max and sum are visible before the unlock
+    __sync_synchronize();
+    __sync_val_compare_and_swap(ptr, -1, locked_count);
+#endif
+  }
+}
+
 #define DECLARE_ARGMAX_IDENTITY(TYPE) \
   template <>                         \
   const Argval<TYPE> ArgmaxReduction<TYPE>::identity;
@@ -142,4 +542,21 @@ DECLARE_IDENTITIES(complex<float>)
 #undef DECLARE_ARGMIN_IDENTITY
 #undef DECLARE_ARGMAX_IDENTITY
 
+template <>
+const Welford<float> VarianceReduction<float>::identity;
+template <>
+const Welford<double> VarianceReduction<double>::identity;
+template <>
+const BinnedSum<float> BinnedSumReduction<float>::identity;
+template <>
+const BinnedSum<double> BinnedSumReduction<double>::identity;
+template <>
+const ScaledSquares<float> NormReduction<float>::identity;
+template <>
+const ScaledSquares<double> NormReduction<double>::identity;
+template <>
+const LogSumExp<float> LogSumExpReduction<float>::identity;
+template <>
+const LogSumExp<double> LogSumExpReduction<double>::identity;
+
 }  // namespace cunumeric
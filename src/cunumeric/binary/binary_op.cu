@@ -23,23 +23,135 @@ namespace cunumeric {
 
 using namespace Legion;
 
-template <typename Function, typename RES, typename ARG>
+template <int VEC, typename Function, typename RES, typename ARG1, typename ARG2>
 static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
-  dense_kernel(size_t volume, Function func, RES* out, const ARG* in1, const ARG* in2)
+  dense_kernel(size_t volume, Function func, RES* out, const ARG1* in1, const ARG2* in2)
 {
-  const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
-  if (idx >= volume) return;
-  out[idx] = func(in1[idx], in2[idx]);
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x * VEC;
+  for (size_t offset = (blockIdx.x * blockDim.x + threadIdx.x) * VEC; offset < volume;
+       offset += stride) {
+    if (offset + VEC <= volume) {
+      const auto x = load_vector<VEC>(in1 + offset);
+      const auto y = load_vector<VEC>(in2 + offset);
+      VectorPack<RES, VEC> z;
+#pragma unroll
+      for (int k = 0; k < VEC; ++k) z[k] = func(x[k], y[k]);
+      store_vector<VEC>(out + offset, z);
+    } else {
+      for (size_t idx = offset; idx < volume; ++idx) out[idx] = func(in1[idx], in2[idx]);
+    }
+  }
+}
+
+template <typename Function,
+          typename WriteAcc,
+          typename ReadAcc1,
+          typename ReadAcc2,
+          typename Pitches,
+          typename Rect>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  generic_kernel(size_t volume,
+                 Function func,
+                 WriteAcc out,
+                 ReadAcc1 in1,
+                 ReadAcc2 in2,
+                 Pitches pitches,
+                 Rect rect)
+{
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x;
+  for (size_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < volume; idx += stride) {
+    auto point = pitches.unflatten(idx, rect.lo);
+    out[point] = func(in1[point], in2[point]);
+  }
+}
+
+template <typename Function, typename VAL>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  dense_inplace_kernel(size_t volume, Function func, VAL* out, const VAL* in2)
+{
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x;
+  for (size_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < volume; idx += stride) {
+    out[idx] = func(out[idx], in2[idx]);
+  }
+}
+
+template <typename Function,
+          typename ReadWriteAcc,
+          typename ReadAcc,
+          typename Pitches,
+          typename Rect>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM) generic_inplace_kernel(
+  size_t volume, Function func, ReadWriteAcc out, ReadAcc in2, Pitches pitches, Rect rect)
+{
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x;
+  for (size_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < volume; idx += stride) {
+    auto point = pitches.unflatten(idx, rect.lo);
+    out[point] = func(out[point], in2[point]);
+  }
+}
+
+template <int VEC, typename Function, typename RES, typename ARG>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  dense_scalar_kernel(size_t volume, Function func, RES* out, const ARG* in)
+{
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x * VEC;
+  for (size_t offset = (blockIdx.x * blockDim.x + threadIdx.x) * VEC; offset < volume;
+       offset += stride) {
+    if (offset + VEC <= volume) {
+      const auto x = load_vector<VEC>(in + offset);
+      VectorPack<RES, VEC> y;
+#pragma unroll
+      for (int k = 0; k < VEC; ++k) y[k] = func(x[k]);
+      store_vector<VEC>(out + offset, y);
+    } else {
+      for (size_t idx = offset; idx < volume; ++idx) out[idx] = func(in[idx]);
+    }
+  }
 }
 
 template <typename Function, typename WriteAcc, typename ReadAcc, typename Pitches, typename Rect>
-static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM) generic_kernel(
-  size_t volume, Function func, WriteAcc out, ReadAcc in1, ReadAcc in2, Pitches pitches, Rect rect)
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM) generic_scalar_kernel(
+  size_t volume, Function func, WriteAcc out, ReadAcc in, Pitches pitches, Rect rect)
 {
-  const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
-  if (idx >= volume) return;
-  auto point = pitches.unflatten(idx, rect.lo);
-  out[point] = func(in1[point], in2[point]);
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x;
+  for (size_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < volume; idx += stride) {
+    auto point = pitches.unflatten(idx, rect.lo);
+    out[point] = func(in[point]);
+  }
+}
+
+template <typename Function, typename RES, typename ARG1, typename ARG2>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  dense_masked_kernel(size_t volume, Function func, RES* out, const bool* mask, ARG1 in1, ARG2 in2)
+{
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x;
+  for (size_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < volume; idx += stride) {
+    if (mask[idx]) out[idx] = func(in1[idx], in2[idx]);
+  }
+}
+
+template <typename Function,
+          typename ReadWriteAcc,
+          typename MaskAcc,
+          typename In1,
+          typename In2,
+          typename Pitches,
+          typename Rect>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  generic_masked_kernel(size_t volume,
+                        Function func,
+                        ReadWriteAcc out,
+                        MaskAcc mask,
+                        In1 in1,
+                        In2 in2,
+                        Pitches pitches,
+                        Rect rect)
+{
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x;
+  for (size_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < volume; idx += stride) {
+    auto point = pitches.unflatten(idx, rect.lo);
+    if (mask[point]) out[point] = func(in1[point], in2[point]);
+  }
 }
 
 template <BinaryOpCode OP_CODE, LegateTypeCode CODE, int DIM>
@@ -48,23 +160,145 @@ struct BinaryOpImplBody<VariantKind::GPU, OP_CODE, CODE, DIM> {
   using ARG = legate_type_of<CODE>;
   using RES = std::result_of_t<OP(ARG, ARG)>;
 
-  void operator()(OP func,
+  template <typename Function, typename ARG1, typename ARG2>
+  void operator()(Function func,
                   AccessorWO<RES, DIM> out,
-                  AccessorRO<ARG, DIM> in1,
+                  AccessorRO<ARG1, DIM> in1,
+                  AccessorRO<ARG2, DIM> in2,
+                  const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& rect,
+                  bool dense) const
+  {
+    auto stream = get_cached_stream();
+
+    size_t volume       = rect.volume();
+    const size_t blocks = grid_stride_blocks<1>(volume);
+    if (dense) {
+      auto outptr       = out.ptr(rect);
+      auto in1ptr       = in1.ptr(rect);
+      auto in2ptr       = in2.ptr(rect);
+      constexpr int VEC = vector_width<RES, ARG1, ARG2>();
+      if (is_vector_aligned<VEC>(outptr, in1ptr, in2ptr))
+        dense_kernel<VEC><<<grid_stride_blocks<VEC>(volume), THREADS_PER_BLOCK, 0, stream>>>(
+          volume, func, outptr, in1ptr, in2ptr);
+      else
+        dense_kernel<1><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+          volume, func, outptr, in1ptr, in2ptr);
+    } else {
+      FastPitches<DIM - 1> fast_pitches;
+      fast_pitches.flatten(rect);
+      generic_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+        volume, func, out, in1, in2, fast_pitches, rect);
+    }
+  }
+
+  void operator()(OP func,
+                  AccessorRW<RES, DIM> out,
                   AccessorRO<ARG, DIM> in2,
                   const Pitches<DIM - 1>& pitches,
                   const Rect<DIM>& rect,
                   bool dense) const
   {
+    auto stream = get_cached_stream();
+
     size_t volume       = rect.volume();
-    const size_t blocks = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+    const size_t blocks = grid_stride_blocks<1>(volume);
     if (dense) {
       auto outptr = out.ptr(rect);
-      auto in1ptr = in1.ptr(rect);
       auto in2ptr = in2.ptr(rect);
-      dense_kernel<<<blocks, THREADS_PER_BLOCK>>>(volume, func, outptr, in1ptr, in2ptr);
+      dense_inplace_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(volume, func, outptr, in2ptr);
+    } else {
+      FastPitches<DIM - 1> fast_pitches;
+      fast_pitches.flatten(rect);
+      generic_inplace_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+        volume, func, out, in2, fast_pitches, rect);
+    }
+  }
+
+  template <typename Function>
+  void operator()(Function func,
+                  AccessorWO<RES, DIM> out,
+                  AccessorRO<ARG, DIM> in,
+                  const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& rect,
+                  bool dense) const
+  {
+    auto stream = get_cached_stream();
+
+    size_t volume       = rect.volume();
+    const size_t blocks = grid_stride_blocks<1>(volume);
+    if (dense) {
+      auto outptr       = out.ptr(rect);
+      auto inptr        = in.ptr(rect);
+      constexpr int VEC = vector_width<RES, ARG>();
+      if (is_vector_aligned<VEC>(outptr, inptr))
+        dense_scalar_kernel<VEC><<<grid_stride_blocks<VEC>(volume), THREADS_PER_BLOCK, 0, stream>>>(
+          volume, func, outptr, inptr);
+      else
+        dense_scalar_kernel<1><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+          volume, func, outptr, inptr);
+    } else {
+      FastPitches<DIM - 1> fast_pitches;
+      fast_pitches.flatten(rect);
+      generic_scalar_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+        volume, func, out, in, fast_pitches, rect);
+    }
+  }
+
+  template <typename Function>
+  void operator()(Function func,
+                  AccessorRW<RES, DIM> out,
+                  const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& rect,
+                  bool dense) const
+  {
+    auto stream = get_cached_stream();
+
+    size_t volume       = rect.volume();
+    const size_t blocks = grid_stride_blocks<1>(volume);
+    if (dense) {
+      auto outptr       = out.ptr(rect);
+      constexpr int VEC = vector_width<RES>();
+      if (is_vector_aligned<VEC>(outptr))
+        dense_scalar_kernel<VEC><<<grid_stride_blocks<VEC>(volume), THREADS_PER_BLOCK, 0, stream>>>(
+          volume, func, outptr, outptr);
+      else
+        dense_scalar_kernel<1><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+          volume, func, outptr, outptr);
+    } else {
+      FastPitches<DIM - 1> fast_pitches;
+      fast_pitches.flatten(rect);
+      generic_scalar_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+        volume, func, out, out, fast_pitches, rect);
+    }
+  }
+
+  template <typename Function, typename In1, typename In2>
+  void operator()(Function func,
+                  AccessorRW<RES, DIM> out,
+                  AccessorRO<bool, DIM> mask,
+                  const In1& in1,
+                  const In2& in2,
+                  const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& rect,
+                  bool dense) const
+  {
+    auto stream = get_cached_stream();
+
+    size_t volume       = rect.volume();
+    const size_t blocks = grid_stride_blocks<1>(volume);
+    if (dense) {
+      auto outptr  = out.ptr(rect);
+      auto maskptr = mask.ptr(rect);
+      auto in1ptr  = masked_dense_operand(in1, rect);
+      auto in2ptr  = masked_dense_operand(in2, rect);
+      dense_masked_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+        volume, func, outptr, maskptr, in1ptr, in2ptr);
     } else {
-      generic_kernel<<<blocks, THREADS_PER_BLOCK>>>(volume, func, out, in1, in2, pitches, rect);
+      FastPitches<DIM - 1> fast_pitches;
+      fast_pitches.flatten(rect);
+      generic_masked_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+        volume, func, out, mask, in1, in2, fast_pitches, rect);
     }
   }
 };
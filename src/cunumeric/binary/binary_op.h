@@ -26,6 +26,14 @@ struct BinaryOpArgs {
   const Array& in2;
   const Array& out;
   BinaryOpCode op_code;
+  // When true, out aliases in1 and gets updated in place
+  bool inplace;
+  // 1 or 2 when that operand is the scalar below instead of an array, or 0
+  int32_t scalar_operand;
+  const legate::Scalar& scalar;
+  // When set, only the elements where the mask is true are written and the rest of out
+  // keeps its values
+  const Array* mask;
   std::vector<legate::Store> args;
 };
 
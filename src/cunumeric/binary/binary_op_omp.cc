@@ -17,6 +17,9 @@
 #include "cunumeric/binary/binary_op.h"
 #include "cunumeric/binary/binary_op_template.inl"
 
+#include "cunumeric/huge_pages.h"
+#include "cunumeric/simd.h"
+
 namespace cunumeric {
 
 using namespace Legion;
@@ -28,10 +31,11 @@ struct BinaryOpImplBody<VariantKind::OMP, OP_CODE, CODE, DIM> {
   using ARG = legate_type_of<CODE>;
   using RES = std::result_of_t<OP(ARG, ARG)>;
 
-  void operator()(OP func,
+  template <typename Function, typename ARG1, typename ARG2>
+  void operator()(Function func,
                   AccessorWO<RES, DIM> out,
-                  AccessorRO<ARG, DIM> in1,
-                  AccessorRO<ARG, DIM> in2,
+                  AccessorRO<ARG1, DIM> in1,
+                  AccessorRO<ARG2, DIM> in2,
                   const Pitches<DIM - 1>& pitches,
                   const Rect<DIM>& rect,
                   bool dense) const
@@ -41,8 +45,11 @@ struct BinaryOpImplBody<VariantKind::OMP, OP_CODE, CODE, DIM> {
       auto outptr = out.ptr(rect);
       auto in1ptr = in1.ptr(rect);
       auto in2ptr = in2.ptr(rect);
-#pragma omp parallel for schedule(static)
-      for (size_t idx = 0; idx < volume; ++idx) outptr[idx] = func(in1ptr[idx], in2ptr[idx]);
+      advise_huge_pages(outptr, volume * sizeof(RES));
+      with_fast_math(func, [&](auto op) {
+        simd::parallel_for_each(
+          volume, [=](size_t idx) { outptr[idx] = op(in1ptr[idx], in2ptr[idx]); });
+      });
     } else {
 #pragma omp parallel for schedule(static)
       for (size_t idx = 0; idx < volume; ++idx) {
@@ -51,6 +58,105 @@ struct BinaryOpImplBody<VariantKind::OMP, OP_CODE, CODE, DIM> {
       }
     }
   }
+
+  void operator()(OP func,
+                  AccessorRW<RES, DIM> out,
+                  AccessorRO<ARG, DIM> in2,
+                  const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& rect,
+                  bool dense) const
+  {
+    const size_t volume = rect.volume();
+    if (dense) {
+      auto outptr = out.ptr(rect);
+      auto in2ptr = in2.ptr(rect);
+      with_fast_math(func, [&](auto op) {
+        simd::parallel_for_each(
+          volume, [=](size_t idx) { outptr[idx] = op(outptr[idx], in2ptr[idx]); });
+      });
+    } else {
+#pragma omp parallel for schedule(static)
+      for (size_t idx = 0; idx < volume; ++idx) {
+        auto p = pitches.unflatten(idx, rect.lo);
+        out[p] = func(out[p], in2[p]);
+      }
+    }
+  }
+
+  template <typename Function>
+  void operator()(Function func,
+                  AccessorWO<RES, DIM> out,
+                  AccessorRO<ARG, DIM> in,
+                  const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& rect,
+                  bool dense) const
+  {
+    const size_t volume = rect.volume();
+    if (dense) {
+      auto outptr = out.ptr(rect);
+      auto inptr  = in.ptr(rect);
+      advise_huge_pages(outptr, volume * sizeof(RES));
+      with_fast_math(func, [&](auto op) {
+        simd::parallel_for_each(volume, [=](size_t idx) { outptr[idx] = op(inptr[idx]); });
+      });
+    } else {
+#pragma omp parallel for schedule(static)
+      for (size_t idx = 0; idx < volume; ++idx) {
+        auto p = pitches.unflatten(idx, rect.lo);
+        out[p] = func(in[p]);
+      }
+    }
+  }
+
+  template <typename Function>
+  void operator()(Function func,
+                  AccessorRW<RES, DIM> out,
+                  const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& rect,
+                  bool dense) const
+  {
+    const size_t volume = rect.volume();
+    if (dense) {
+      auto outptr = out.ptr(rect);
+      with_fast_math(func, [&](auto op) {
+        simd::parallel_for_each(volume, [=](size_t idx) { outptr[idx] = op(outptr[idx]); });
+      });
+    } else {
+#pragma omp parallel for schedule(static)
+      for (size_t idx = 0; idx < volume; ++idx) {
+        auto p = pitches.unflatten(idx, rect.lo);
+        out[p] = func(out[p]);
+      }
+    }
+  }
+
+  template <typename Function, typename In1, typename In2>
+  void operator()(Function func,
+                  AccessorRW<RES, DIM> out,
+                  AccessorRO<bool, DIM> mask,
+                  const In1& in1,
+                  const In2& in2,
+                  const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& rect,
+                  bool dense) const
+  {
+    const size_t volume = rect.volume();
+    if (dense) {
+      auto outptr  = out.ptr(rect);
+      auto maskptr = mask.ptr(rect);
+      auto in1ptr  = masked_dense_operand(in1, rect);
+      auto in2ptr  = masked_dense_operand(in2, rect);
+#pragma omp parallel for schedule(static)
+      for (size_t idx = 0; idx < volume; ++idx)
+        if (maskptr[idx]) outptr[idx] = func(in1ptr[idx], in2ptr[idx]);
+    } else {
+#pragma omp parallel for schedule(static)
+      for (size_t idx = 0; idx < volume; ++idx) {
+        auto p = pitches.unflatten(idx, rect.lo);
+        if (mask[p]) out[p] = func(in1[p], in2[p]);
+      }
+    }
+  }
 };
 
 /*static*/ void BinaryOpTask::omp_variant(TaskContext& context)
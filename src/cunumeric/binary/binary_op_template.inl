@@ -15,7 +15,9 @@
  */
 
 #include "cunumeric/binary/binary_op_util.h"
+#include "cunumeric/annotate.h"
 #include "cunumeric/pitches.h"
+#include "cunumeric/roofline.h"
 
 namespace cunumeric {
 
@@ -25,6 +27,44 @@ using namespace legate;
 template <VariantKind KIND, BinaryOpCode OP_CODE, LegateTypeCode CODE, int DIM>
 struct BinaryOpImplBody;
 
+// An operand of a masked op that is passed by value, indexed like the array it stands in for
+template <typename VAL>
+struct BinaryOpMaskedScalar {
+  __CUDA_HD__ VAL operator[](size_t idx) const { return value; }
+  template <int DIM>
+  __CUDA_HD__ VAL operator[](const Point<DIM>& point) const
+  {
+    return value;
+  }
+  VAL value;
+};
+
+// The dense loops of masked ops index array operands through raw pointers
+template <typename ACC, int DIM>
+auto masked_dense_operand(const ACC& in, const Rect<DIM>& rect)
+{
+  return in.ptr(rect);
+}
+
+template <typename VAL, int DIM>
+BinaryOpMaskedScalar<VAL> masked_dense_operand(const BinaryOpMaskedScalar<VAL>& in,
+                                               const Rect<DIM>& rect)
+{
+  return in;
+}
+
+template <typename ACC, int DIM>
+bool masked_is_dense(const ACC& in, const Rect<DIM>& rect)
+{
+  return in.accessor.is_dense_row_major(rect);
+}
+
+template <typename VAL, int DIM>
+bool masked_is_dense(const BinaryOpMaskedScalar<VAL>& in, const Rect<DIM>& rect)
+{
+  return true;
+}
+
 template <VariantKind KIND, BinaryOpCode OP_CODE>
 struct BinaryOpImpl {
   template <LegateTypeCode CODE,
@@ -43,6 +83,27 @@ struct BinaryOpImpl {
 
     if (volume == 0) return;
 
+    CUNUMERIC_ROOFLINE_SAMPLE(
+      "binary_op", OP_CODE, KIND, volume * (2 * sizeof(ARG) + sizeof(RES)), volume);
+
+    // Masked ops on operands of different types go through the promotion below
+    if (args.mask != nullptr && args.in1.code() == args.in2.code()) {
+      masked<CODE, DIM>(args, pitches, rect);
+      return;
+    }
+    if (args.inplace) {
+      inplace<CODE, DIM>(args, pitches, rect);
+      return;
+    }
+    if (args.scalar_operand != 0) {
+      with_scalar<CODE, DIM>(args, pitches, rect);
+      return;
+    }
+    if (args.in1.code() != args.in2.code()) {
+      mixed<CODE, DIM>(args, pitches, rect);
+      return;
+    }
+
     auto out = args.out.write_accessor<RES, DIM>(rect);
     auto in1 = args.in1.read_accessor<ARG, DIM>(rect);
     auto in2 = args.in2.read_accessor<ARG, DIM>(rect);
@@ -60,6 +121,223 @@ struct BinaryOpImpl {
     BinaryOpImplBody<KIND, OP_CODE, CODE, DIM>()(func, out, in1, in2, pitches, rect, dense);
   }
 
+  template <LegateTypeCode CODE, int DIM>
+  void inplace(BinaryOpArgs& args, const Pitches<DIM - 1>& pitches, const Rect<DIM>& rect) const
+  {
+    using OP  = BinaryOp<OP_CODE, CODE>;
+    using ARG = legate_type_of<CODE>;
+    using RES = std::result_of_t<OP(ARG, ARG)>;
+
+    // The output can only alias the first input when they have the same type
+    if constexpr (std::is_same<RES, ARG>::value) {
+      auto out = args.out.read_write_accessor<RES, DIM>(rect);
+
+      OP func{args.args};
+      if (args.scalar_operand == 2) {
+#ifndef LEGION_BOUNDS_CHECKS
+        bool dense = out.accessor.is_dense_row_major(rect);
+#else
+        bool dense = false;
+#endif
+        with_scalar_rhs(func, args.scalar.value<ARG>(), [&](auto bound) {
+          BinaryOpImplBody<KIND, OP_CODE, CODE, DIM>()(bound, out, pitches, rect, dense);
+        });
+        return;
+      }
+
+      auto in2 = args.in2.read_accessor<ARG, DIM>(rect);
+
+#ifndef LEGION_BOUNDS_CHECKS
+      // Check to see if this is dense or not
+      bool dense = out.accessor.is_dense_row_major(rect) && in2.accessor.is_dense_row_major(rect);
+#else
+      // No dense execution if we're doing bounds checks
+      bool dense = false;
+#endif
+
+      BinaryOpImplBody<KIND, OP_CODE, CODE, DIM>()(func, out, in2, pitches, rect, dense);
+    } else
+      assert(false);
+  }
+
+  template <LegateTypeCode CODE, int DIM>
+  void with_scalar(BinaryOpArgs& args, const Pitches<DIM - 1>& pitches, const Rect<DIM>& rect) const
+  {
+    using OP  = BinaryOp<OP_CODE, CODE>;
+    using ARG = legate_type_of<CODE>;
+    using RES = std::result_of_t<OP(ARG, ARG)>;
+
+    // The array operand always comes first regardless of its position in the op
+    auto out = args.out.write_accessor<RES, DIM>(rect);
+    auto in  = args.in1.read_accessor<ARG, DIM>(rect);
+
+#ifndef LEGION_BOUNDS_CHECKS
+    // Check to see if this is dense or not
+    bool dense = out.accessor.is_dense_row_major(rect) && in.accessor.is_dense_row_major(rect);
+#else
+    // No dense execution if we're doing bounds checks
+    bool dense = false;
+#endif
+
+    OP func{args.args};
+    auto scalar = args.scalar.value<ARG>();
+    if (args.scalar_operand == 1) {
+      BinaryOpScalarLHS<OP, ARG> bound{func, scalar};
+      BinaryOpImplBody<KIND, OP_CODE, CODE, DIM>()(bound, out, in, pitches, rect, dense);
+    } else {
+      with_scalar_rhs(func, scalar, [&](auto bound) {
+        BinaryOpImplBody<KIND, OP_CODE, CODE, DIM>()(bound, out, in, pitches, rect, dense);
+      });
+    }
+  }
+
+  template <LegateTypeCode CODE, int DIM>
+  void masked(BinaryOpArgs& args, const Pitches<DIM - 1>& pitches, const Rect<DIM>& rect) const
+  {
+    using OP  = BinaryOp<OP_CODE, CODE>;
+    using ARG = legate_type_of<CODE>;
+
+    // In place, the first operand is the input that aliases the output
+    OP func{args.args};
+    auto in1 = args.in1.read_accessor<ARG, DIM>(rect);
+    if (args.scalar_operand == 0) {
+      auto in2 = args.in2.read_accessor<ARG, DIM>(rect);
+      masked_body<CODE, DIM>(args, func, in1, in2, pitches, rect);
+      return;
+    }
+    // The array operand always comes first regardless of its position in the op
+    BinaryOpMaskedScalar<ARG> scalar{args.scalar.value<ARG>()};
+    if (args.scalar_operand == 1)
+      masked_body<CODE, DIM>(args, func, scalar, in1, pitches, rect);
+    else
+      masked_body<CODE, DIM>(args, func, in1, scalar, pitches, rect);
+  }
+
+  template <LegateTypeCode CODE, int DIM, typename Function, typename In1, typename In2>
+  void masked_body(BinaryOpArgs& args,
+                   Function func,
+                   const In1& in1,
+                   const In2& in2,
+                   const Pitches<DIM - 1>& pitches,
+                   const Rect<DIM>& rect) const
+  {
+    using OP  = BinaryOp<OP_CODE, CODE>;
+    using ARG = legate_type_of<CODE>;
+    using RES = std::result_of_t<OP(ARG, ARG)>;
+
+    // Elements where the mask is not set are neither computed nor written
+    auto out  = args.out.read_write_accessor<RES, DIM>(rect);
+    auto mask = args.mask->read_accessor<bool, DIM>(rect);
+
+#ifndef LEGION_BOUNDS_CHECKS
+    // Check to see if this is dense or not
+    bool dense = out.accessor.is_dense_row_major(rect) && mask.accessor.is_dense_row_major(rect) &&
+                 masked_is_dense(in1, rect) && masked_is_dense(in2, rect);
+#else
+    // No dense execution if we're doing bounds checks
+    bool dense = false;
+#endif
+
+    BinaryOpImplBody<KIND, OP_CODE, CODE, DIM>()(func, out, mask, in1, in2, pitches, rect, dense);
+  }
+
+  template <LegateTypeCode CODE, int DIM>
+  void mixed(BinaryOpArgs& args, const Pitches<DIM - 1>& pitches, const Rect<DIM>& rect) const
+  {
+    // The other operand is already in the type the op is evaluated in
+    auto src_code = args.in1.code() != CODE ? args.in1.code() : args.in2.code();
+    switch (src_code) {
+      case LegateTypeCode::INT32_LT:
+        promoted<LegateTypeCode::INT32_LT, CODE, DIM>(args, pitches, rect);
+        return;
+      case LegateTypeCode::INT64_LT:
+        promoted<LegateTypeCode::INT64_LT, CODE, DIM>(args, pitches, rect);
+        return;
+      case LegateTypeCode::FLOAT_LT:
+        promoted<LegateTypeCode::FLOAT_LT, CODE, DIM>(args, pitches, rect);
+        return;
+      case LegateTypeCode::UINT8_LT:
+        promoted<LegateTypeCode::UINT8_LT, CODE, DIM>(args, pitches, rect);
+        return;
+      case LegateTypeCode::UINT16_LT:
+        promoted<LegateTypeCode::UINT16_LT, CODE, DIM>(args, pitches, rect);
+        return;
+      default: break;
+    }
+    assert(false);
+  }
+
+  template <LegateTypeCode SRC_CODE, LegateTypeCode CODE, int DIM>
+  void promoted(BinaryOpArgs& args, const Pitches<DIM - 1>& pitches, const Rect<DIM>& rect) const
+  {
+    if constexpr (BinaryOpPromotion<SRC_CODE, CODE>::value) {
+      using OP      = BinaryOp<OP_CODE, CODE>;
+      using ARG     = legate_type_of<CODE>;
+      using SRC     = legate_type_of<SRC_CODE>;
+      using RES     = std::result_of_t<OP(ARG, ARG)>;
+      using CONVERT = ConvertOp<CODE, SRC_CODE>;
+
+      OP func{args.args};
+      if (args.mask != nullptr) {
+        if (args.in1.code() == SRC_CODE) {
+          BinaryOpConvertLHS<OP, CONVERT> converted{func, CONVERT{}};
+          masked_body<CODE, DIM>(args,
+                                 converted,
+                                 args.in1.read_accessor<SRC, DIM>(rect),
+                                 args.in2.read_accessor<ARG, DIM>(rect),
+                                 pitches,
+                                 rect);
+        } else {
+          BinaryOpConvertRHS<OP, CONVERT> converted{func, CONVERT{}};
+          masked_body<CODE, DIM>(args,
+                                 converted,
+                                 args.in1.read_accessor<ARG, DIM>(rect),
+                                 args.in2.read_accessor<SRC, DIM>(rect),
+                                 pitches,
+                                 rect);
+        }
+        return;
+      }
+
+      auto out = args.out.write_accessor<RES, DIM>(rect);
+
+      if (args.in1.code() == SRC_CODE) {
+        auto in1 = args.in1.read_accessor<SRC, DIM>(rect);
+        auto in2 = args.in2.read_accessor<ARG, DIM>(rect);
+
+#ifndef LEGION_BOUNDS_CHECKS
+        // Check to see if this is dense or not
+        bool dense = out.accessor.is_dense_row_major(rect) &&
+                     in1.accessor.is_dense_row_major(rect) && in2.accessor.is_dense_row_major(rect);
+#else
+        // No dense execution if we're doing bounds checks
+        bool dense = false;
+#endif
+
+        BinaryOpConvertLHS<OP, CONVERT> converted{func, CONVERT{}};
+        BinaryOpImplBody<KIND, OP_CODE, CODE, DIM>()(
+          converted, out, in1, in2, pitches, rect, dense);
+      } else {
+        auto in1 = args.in1.read_accessor<ARG, DIM>(rect);
+        auto in2 = args.in2.read_accessor<SRC, DIM>(rect);
+
+#ifndef LEGION_BOUNDS_CHECKS
+        // Check to see if this is dense or not
+        bool dense = out.accessor.is_dense_row_major(rect) &&
+                     in1.accessor.is_dense_row_major(rect) && in2.accessor.is_dense_row_major(rect);
+#else
+        // No dense execution if we're doing bounds checks
+        bool dense = false;
+#endif
+
+        BinaryOpConvertRHS<OP, CONVERT> converted{func, CONVERT{}};
+        BinaryOpImplBody<KIND, OP_CODE, CODE, DIM>()(
+          converted, out, in1, in2, pitches, rect, dense);
+      }
+    } else
+      assert(false);
+  }
+
   template <LegateTypeCode CODE,
             int DIM,
             std::enable_if_t<!BinaryOp<OP_CODE, CODE>::valid>* = nullptr>
@@ -74,8 +352,10 @@ struct BinaryOpDispatch {
   template <BinaryOpCode OP_CODE>
   void operator()(BinaryOpArgs& args) const
   {
-    auto dim = std::max(1, args.out.dim());
-    double_dispatch(dim, args.in1.code(), BinaryOpImpl<KIND, OP_CODE>{}, args);
+    auto dim  = std::max(1, args.out.dim());
+    auto code = binary_op_code(args.in1.code(), args.in2.code());
+    AnnotatedRange range("binary_op", OP_CODE, code, dim, args.out.domain().get_volume());
+    cunumeric::double_dispatch(dim, code, BinaryOpImpl<KIND, OP_CODE>{}, args);
   }
 };
 
@@ -86,11 +366,30 @@ static void binary_op_template(TaskContext& context)
   auto& outputs = context.outputs();
   auto& scalars = context.scalars();
 
+  auto inplace        = scalars[1].value<bool>();
+  auto scalar_operand = scalars[2].value<int32_t>();
+  auto masked         = scalars[3].value<bool>();
+  // A scalar operand is passed by value, so there is only one input array
+  size_t num_arrays = scalar_operand != 0 ? 1 : 2;
+
+  // The mask follows the operands, and then the output itself unless the op is in place,
+  // both of which are read by the task as well
+  const Array* mask  = masked ? &inputs[num_arrays] : nullptr;
+  size_t first_extra = num_arrays + (masked ? (inplace ? 1 : 2) : 0);
+
   std::vector<Store> extra_args;
-  for (size_t idx = 2; idx < inputs.size(); ++idx) extra_args.push_back(std::move(inputs[idx]));
+  for (size_t idx = first_extra; idx < inputs.size(); ++idx)
+    extra_args.push_back(std::move(inputs[idx]));
 
-  BinaryOpArgs args{
-    inputs[0], inputs[1], outputs[0], scalars[0].value<BinaryOpCode>(), std::move(extra_args)};
+  BinaryOpArgs args{inputs[0],
+                    inputs[num_arrays - 1],
+                    outputs[0],
+                    scalars[0].value<BinaryOpCode>(),
+                    inplace,
+                    scalar_operand,
+                    scalars[scalar_operand != 0 ? 4 : 0],
+                    mask,
+                    std::move(extra_args)};
   op_dispatch(args.op_code, BinaryOpDispatch<KIND>{}, args);
 }
 
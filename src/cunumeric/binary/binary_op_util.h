@@ -17,6 +17,9 @@
 #pragma once
 
 #include "cunumeric/cunumeric.h"
+#include "cunumeric/divmod.h"
+#include "cunumeric/fast_math.h"
+#include "cunumeric/unary/convert_util.h"
 
 namespace cunumeric {
 
@@ -41,6 +44,8 @@ enum class BinaryOpCode : int {
   POWER,
   SUBTRACT,
   ALLCLOSE,
+  SOFTMAX,
+  MUL_CONJ,
 };
 
 template <typename Functor, typename... Fnargs>
@@ -83,6 +88,10 @@ constexpr decltype(auto) op_dispatch(BinaryOpCode op_code, Functor f, Fnargs&&..
       return f.template operator()<BinaryOpCode::POWER>(std::forward<Fnargs>(args)...);
     case BinaryOpCode::SUBTRACT:
       return f.template operator()<BinaryOpCode::SUBTRACT>(std::forward<Fnargs>(args)...);
+    case BinaryOpCode::SOFTMAX:
+      return f.template operator()<BinaryOpCode::SOFTMAX>(std::forward<Fnargs>(args)...);
+    case BinaryOpCode::MUL_CONJ:
+      return f.template operator()<BinaryOpCode::MUL_CONJ>(std::forward<Fnargs>(args)...);
     default: break;
   }
   assert(false);
@@ -132,7 +141,22 @@ struct BinaryOp<BinaryOpCode::FLOOR_DIVIDE, CODE> {
   using T                     = legate::legate_type_of<CODE>;
   static constexpr bool valid = true;
   BinaryOp(const std::vector<legate::Store>& args) {}
-  constexpr T operator()(const T& a, const T& b) const { return floor(a / b); }
+  // Integers round towards negative infinity like NumPy, not towards zero like C++
+  template <typename _T = T, std::enable_if_t<std::is_integral<_T>::value>* = nullptr>
+  constexpr _T operator()(const _T& a, const _T& b) const
+  {
+    if constexpr (std::is_signed<_T>::value) {
+      const _T q = a / b;
+      return (a % b != 0) & ((a < 0) != (b < 0)) ? q - 1 : q;
+    } else
+      return a / b;
+  }
+
+  template <typename _T = T, std::enable_if_t<!std::is_integral<_T>::value>* = nullptr>
+  constexpr _T operator()(const _T& a, const _T& b) const
+  {
+    return floor(a / b);
+  }
 };
 
 template <>
@@ -263,10 +287,15 @@ struct BinaryOp<BinaryOpCode::MOD, CODE> {
   using T                     = legate::legate_type_of<CODE>;
   static constexpr bool valid = true;
   BinaryOp(const std::vector<legate::Store>& args) {}
+  // Integer remainders take the sign of the divisor like NumPy, not of the dividend like C++
   template <typename _T = T, std::enable_if_t<std::is_integral<_T>::value>* = nullptr>
   constexpr _T operator()(const _T& a, const _T& b) const
   {
-    return a % b;
+    if constexpr (std::is_signed<_T>::value) {
+      const _T r = a % b;
+      return (r != 0) & ((r < 0) != (b < 0)) ? r + b : r;
+    } else
+      return a % b;
   }
 
   template <typename _T = T, std::enable_if_t<!std::is_integral<_T>::value>* = nullptr>
@@ -298,10 +327,26 @@ struct BinaryOp<BinaryOpCode::MOD, legate::LegateTypeCode::COMPLEX128_LT> {
   BinaryOp(const std::vector<legate::Store>& args) {}
 };
 
+// Complex products are computed from the real and imaginary parts, as NumPy does, which
+// skips the recovery of infinite and NaN parts that the complex operator makes and leaves
+// loops that vectorize
 template <legate::LegateTypeCode CODE>
-struct BinaryOp<BinaryOpCode::MULTIPLY, CODE> : std::multiplies<legate::legate_type_of<CODE>> {
+struct BinaryOp<BinaryOpCode::MULTIPLY, CODE> {
+  using T                     = legate::legate_type_of<CODE>;
   static constexpr bool valid = true;
   BinaryOp(const std::vector<legate::Store>& args) {}
+
+  template <typename _T = T, std::enable_if_t<!legate::is_complex<_T>::value>* = nullptr>
+  constexpr _T operator()(const _T& a, const _T& b) const
+  {
+    return a * b;
+  }
+
+  template <typename _T = T, std::enable_if_t<legate::is_complex<_T>::value>* = nullptr>
+  constexpr _T operator()(const _T& a, const _T& b) const
+  {
+    return _T{a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real()};
+  }
 };
 
 template <legate::LegateTypeCode CODE>
@@ -312,13 +357,27 @@ struct BinaryOp<BinaryOpCode::NOT_EQUAL, CODE> : std::not_equal_to<legate::legat
 
 template <legate::LegateTypeCode CODE>
 struct BinaryOp<BinaryOpCode::POWER, CODE> {
-  using VAL                   = legate::legate_type_of<CODE>;
-  static constexpr bool valid = true;
-  BinaryOp(const std::vector<legate::Store>& args) {}
+  using VAL                       = legate::legate_type_of<CODE>;
+  static constexpr bool valid     = true;
+  static constexpr bool FAST_MATH = std::is_same<VAL, float>::value;
+
+  struct FastOp {
+    __CUDA_HD__ float operator()(const float& a, const float& b) const
+    {
+      return fast_math::pow(a, b);
+    }
+  };
+
+  BinaryOp(const std::vector<legate::Store>& args) : fast(FAST_MATH && use_fast_math(args)) {}
+
   constexpr VAL operator()(const VAL& a, const VAL& b) const
   {
+    if constexpr (FAST_MATH)
+      if (fast) return FastOp{}(a, b);
     return std::pow(static_cast<double>(a), static_cast<double>(b));
   }
+
+  bool fast;
 };
 
 template <>
@@ -371,6 +430,9 @@ struct BinaryOp<BinaryOpCode::ALLCLOSE, CODE> {
     atol_ = args[1].scalar<double>();
   }
 
+  // The binary reductions pass the tolerances by value
+  BinaryOp(double rtol, double atol) : rtol_(rtol), atol_(atol) {}
+
   template <typename T = VAL, std::enable_if_t<!legate::is_complex<T>::value>* = nullptr>
   constexpr bool operator()(const T& a, const T& b) const
   {
@@ -389,4 +451,272 @@ struct BinaryOp<BinaryOpCode::ALLCLOSE, CODE> {
   double atol_{0};
 };
 
+// Exponential of the difference of the operands, which turns logits into their softmax
+// given their logsumexp along the same axis, in one pass and without temporaries
+template <legate::LegateTypeCode CODE>
+struct BinaryOp<BinaryOpCode::SOFTMAX, CODE> {
+  using VAL                   = legate::legate_type_of<CODE>;
+  static constexpr bool valid = CODE == legate::LegateTypeCode::FLOAT_LT ||
+                                CODE == legate::LegateTypeCode::DOUBLE_LT;
+
+  BinaryOp(const std::vector<legate::Store>& args) {}
+
+  constexpr VAL operator()(const VAL& a, const VAL& b) const
+  {
+    using std::exp;
+    return exp(a - b);
+  }
+};
+
+// The product of the first operand with the conjugate of the second, the cross term of
+// correlations and interferograms, without materializing the conjugate
+template <legate::LegateTypeCode CODE>
+struct BinaryOp<BinaryOpCode::MUL_CONJ, CODE> {
+  using T                     = legate::legate_type_of<CODE>;
+  static constexpr bool valid = legate::is_complex<T>::value;
+
+  BinaryOp(const std::vector<legate::Store>& args) {}
+
+  constexpr T operator()(const T& a, const T& b) const
+  {
+    return T{a.real() * b.real() + a.imag() * b.imag(), a.imag() * b.real() - a.real() * b.imag()};
+  }
+};
+
+// Wrappers that bind one operand of a binary op to a scalar, which stays
+// in a register for the whole loop instead of being loaded per element
+template <typename OP, typename ARG>
+struct BinaryOpScalarLHS {
+  constexpr decltype(auto) operator()(const ARG& x) const { return func(scalar, x); }
+
+  OP func;
+  ARG scalar;
+};
+
+template <typename OP, typename ARG>
+struct BinaryOpScalarRHS {
+  constexpr decltype(auto) operator()(const ARG& x) const { return func(x, scalar); }
+
+  OP func;
+  ARG scalar;
+};
+
+// The bound scalar carries over to the fast-math variant of the op, see fast_math.h
+template <typename OP, typename ARG, typename Body>
+void with_fast_math(const BinaryOpScalarLHS<OP, ARG>& bound, Body&& body)
+{
+  with_fast_math(bound.func, [&](auto func) {
+    body(BinaryOpScalarLHS<decltype(func), ARG>{func, bound.scalar});
+  });
+}
+
+template <typename OP, typename ARG, typename Body>
+void with_fast_math(const BinaryOpScalarRHS<OP, ARG>& bound, Body&& body)
+{
+  with_fast_math(bound.func, [&](auto func) {
+    body(BinaryOpScalarRHS<decltype(func), ARG>{func, bound.scalar});
+  });
+}
+
+// x ** N for a small integer N, multiplied out instead of going through pow. Single
+// precision multiplies in double like the general op so that the results agree
+template <int N, typename VAL>
+struct BinaryOpIntegerPower {
+  using WORK = std::conditional_t<std::is_same<VAL, float>::value, double, VAL>;
+
+  constexpr VAL operator()(const VAL& x) const
+  {
+    const WORK base = x;
+    WORK result     = base;
+    for (int i = 1; i < N; ++i) result *= base;
+    return static_cast<VAL>(result);
+  }
+};
+
+// Floor division and modulo of integers by a positive scalar, with the precomputed
+// multiplier of divmod.h instead of a hardware divide per element. Negative dividends
+// are flipped to ~a, which is non-negative, as floor(a / d) == ~(~a / d)
+template <BinaryOpCode OP_CODE, typename VAL>
+struct BinaryOpScalarDivisor {
+  // FastDivmod is exact for dividends and divisors below 2^31
+  using DIVMOD = std::conditional_t<sizeof(VAL) < 4 || std::is_same<VAL, int32_t>::value,
+                                    FastDivmod,
+                                    FastDivmodU64>;
+
+  BinaryOpScalarDivisor(VAL d) : divmod(d), divisor(d) {}
+
+  __CUDA_HD__ VAL operator()(const VAL& a) const
+  {
+    VAL sign = 0;
+    if constexpr (std::is_signed<VAL>::value) sign = a < 0 ? VAL{-1} : VAL{0};
+    const VAL q = divide(a ^ sign) ^ sign;
+    if constexpr (OP_CODE == BinaryOpCode::FLOOR_DIVIDE)
+      return q;
+    else
+      return a - q * divisor;
+  }
+
+  __CUDA_HD__ VAL divide(VAL a) const
+  {
+    if constexpr (std::is_same<DIVMOD, FastDivmod>::value) {
+      int quotient, remainder;
+      divmod(quotient, remainder, static_cast<int>(a));
+      return static_cast<VAL>(quotient);
+    } else
+      return static_cast<VAL>(divmod.divide(static_cast<uint64_t>(a)));
+  }
+
+  DIVMOD divmod;
+  VAL divisor;
+};
+
+// Binds the scalar right operand of an op and calls the body with the result. Some values
+// allow a cheaper form of the op, which is picked here once per task rather than per element
+template <BinaryOpCode OP_CODE, legate::LegateTypeCode CODE, typename ARG, typename Body>
+void with_scalar_rhs(const BinaryOp<OP_CODE, CODE>& func, const ARG& scalar, Body&& body)
+{
+  using VAL               = legate::legate_type_of<CODE>;
+  constexpr bool POWER    = OP_CODE == BinaryOpCode::POWER;
+  constexpr bool DIVISION = OP_CODE == BinaryOpCode::FLOOR_DIVIDE || OP_CODE == BinaryOpCode::MOD;
+  constexpr bool INTEGER  = std::is_integral<VAL>::value && !std::is_same<VAL, bool>::value;
+  if constexpr (POWER && (INTEGER || std::is_floating_point<VAL>::value)) {
+    if (scalar == VAL{2}) {
+      body(BinaryOpIntegerPower<2, VAL>{});
+      return;
+    }
+    if (scalar == VAL{3}) {
+      body(BinaryOpIntegerPower<3, VAL>{});
+      return;
+    }
+    if (scalar == VAL{4}) {
+      body(BinaryOpIntegerPower<4, VAL>{});
+      return;
+    }
+  }
+  // The multiplier of unsigned 64-bit dividends can overflow, so those keep the divide
+  if constexpr (DIVISION && INTEGER && !std::is_same<VAL, uint64_t>::value) {
+    if (scalar > 0) {
+      body(BinaryOpScalarDivisor<OP_CODE, VAL>{scalar});
+      return;
+    }
+  }
+  body(BinaryOpScalarRHS<BinaryOp<OP_CODE, CODE>, ARG>{func, scalar});
+}
+
+// Operand type pairs for which the narrower operand is converted to the wider
+// one as it is loaded, instead of through a separate CONVERT into a temporary.
+// Match these to _binary_op_promotions in array.py
+template <legate::LegateTypeCode SRC_CODE, legate::LegateTypeCode CODE>
+struct BinaryOpPromotion : std::false_type {
+};
+
+template <>
+struct BinaryOpPromotion<legate::LegateTypeCode::INT32_LT, legate::LegateTypeCode::INT64_LT>
+  : std::true_type {
+};
+
+template <>
+struct BinaryOpPromotion<legate::LegateTypeCode::INT32_LT, legate::LegateTypeCode::DOUBLE_LT>
+  : std::true_type {
+};
+
+template <>
+struct BinaryOpPromotion<legate::LegateTypeCode::INT64_LT, legate::LegateTypeCode::DOUBLE_LT>
+  : std::true_type {
+};
+
+template <>
+struct BinaryOpPromotion<legate::LegateTypeCode::FLOAT_LT, legate::LegateTypeCode::DOUBLE_LT>
+  : std::true_type {
+};
+
+template <>
+struct BinaryOpPromotion<legate::LegateTypeCode::UINT8_LT, legate::LegateTypeCode::INT32_LT>
+  : std::true_type {
+};
+
+template <>
+struct BinaryOpPromotion<legate::LegateTypeCode::UINT8_LT, legate::LegateTypeCode::INT64_LT>
+  : std::true_type {
+};
+
+template <>
+struct BinaryOpPromotion<legate::LegateTypeCode::UINT8_LT, legate::LegateTypeCode::FLOAT_LT>
+  : std::true_type {
+};
+
+template <>
+struct BinaryOpPromotion<legate::LegateTypeCode::UINT8_LT, legate::LegateTypeCode::DOUBLE_LT>
+  : std::true_type {
+};
+
+template <>
+struct BinaryOpPromotion<legate::LegateTypeCode::UINT16_LT, legate::LegateTypeCode::INT32_LT>
+  : std::true_type {
+};
+
+template <>
+struct BinaryOpPromotion<legate::LegateTypeCode::UINT16_LT, legate::LegateTypeCode::INT64_LT>
+  : std::true_type {
+};
+
+template <>
+struct BinaryOpPromotion<legate::LegateTypeCode::UINT16_LT, legate::LegateTypeCode::FLOAT_LT>
+  : std::true_type {
+};
+
+template <>
+struct BinaryOpPromotion<legate::LegateTypeCode::UINT16_LT, legate::LegateTypeCode::DOUBLE_LT>
+  : std::true_type {
+};
+
+// Returns the type in which a binary op on operands of the given types is evaluated
+constexpr legate::LegateTypeCode binary_op_code(legate::LegateTypeCode code1,
+                                                legate::LegateTypeCode code2)
+{
+  switch (code1) {
+    case legate::LegateTypeCode::INT32_LT:
+      if (code2 == legate::LegateTypeCode::INT64_LT || code2 == legate::LegateTypeCode::DOUBLE_LT)
+        return code2;
+      break;
+    case legate::LegateTypeCode::INT64_LT:
+    case legate::LegateTypeCode::FLOAT_LT:
+      if (code2 == legate::LegateTypeCode::DOUBLE_LT) return code2;
+      break;
+    // Narrow unsigned operands, like the pixels of images, widen to the other operand
+    case legate::LegateTypeCode::UINT8_LT:
+    case legate::LegateTypeCode::UINT16_LT:
+      if (code2 == legate::LegateTypeCode::INT32_LT || code2 == legate::LegateTypeCode::INT64_LT ||
+          code2 == legate::LegateTypeCode::FLOAT_LT || code2 == legate::LegateTypeCode::DOUBLE_LT)
+        return code2;
+      break;
+    default: break;
+  }
+  return code1;
+}
+
+template <typename OP, typename CONVERT>
+struct BinaryOpConvertLHS {
+  template <typename SRC, typename ARG>
+  constexpr decltype(auto) operator()(const SRC& x, const ARG& y) const
+  {
+    return func(convert(x), y);
+  }
+
+  OP func;
+  CONVERT convert;
+};
+
+template <typename OP, typename CONVERT>
+struct BinaryOpConvertRHS {
+  template <typename ARG, typename SRC>
+  constexpr decltype(auto) operator()(const ARG& x, const SRC& y) const
+  {
+    return func(x, convert(y));
+  }
+
+  OP func;
+  CONVERT convert;
+};
+
 }  // namespace cunumeric
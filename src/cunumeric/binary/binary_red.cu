@@ -23,29 +23,52 @@ namespace cunumeric {
 
 using namespace Legion;
 
-template <typename Function, typename RES, typename ARG>
-static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
-  dense_kernel(size_t volume, Function func, RES out, const ARG* in1, const ARG* in2)
+// Number of elements each thread compares between two polls of the mismatch flag
+#define MISMATCH_POLL_INTERVAL 8
+
+// The threads compare the elements in grid-stride loops that stop once any thread has
+// raised the mismatch flag, which leaves the rest of the elements unread
+template <typename Function, typename ARG>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM) dense_kernel(
+  size_t volume, Function func, volatile int32_t* mismatch, const ARG* in1, const ARG* in2)
 {
-  const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
-  if (idx >= volume) return;
-  if (!func(in1[idx], in2[idx])) out <<= false;
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x;
+  uint32_t polls      = 0;
+  for (size_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < volume; idx += stride) {
+    if (polls++ % MISMATCH_POLL_INTERVAL == 0 && *mismatch) return;
+    if (!func(in1[idx], in2[idx])) {
+      *mismatch = 1;
+      return;
+    }
+  }
 }
 
-template <typename Function, typename RES, typename ReadAcc, typename Pitches, typename Rect>
-static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM) generic_kernel(
-  size_t volume, Function func, RES out, ReadAcc in1, ReadAcc in2, Pitches pitches, Rect rect)
+template <typename Function, typename ReadAcc, typename Pitches, typename Rect>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  generic_kernel(size_t volume,
+                 Function func,
+                 volatile int32_t* mismatch,
+                 ReadAcc in1,
+                 ReadAcc in2,
+                 Pitches pitches,
+                 Rect rect)
 {
-  const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
-  if (idx >= volume) return;
-  auto point = pitches.unflatten(idx, rect.lo);
-  if (!func(in1[point], in2[point])) out <<= false;
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x;
+  uint32_t polls      = 0;
+  for (size_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < volume; idx += stride) {
+    if (polls++ % MISMATCH_POLL_INTERVAL == 0 && *mismatch) return;
+    auto point = pitches.unflatten(idx, rect.lo);
+    if (!func(in1[point], in2[point])) {
+      *mismatch = 1;
+      return;
+    }
+  }
 }
 
-template <typename Buffer, typename RedAcc>
-static __global__ void __launch_bounds__(1, 1) copy_kernel(Buffer result, RedAcc out)
+template <typename RedAcc>
+static __global__ void __launch_bounds__(1, 1) copy_kernel(const int32_t* mismatch, RedAcc out)
 {
-  out.reduce(0, result.read());
+  out.reduce(0, *mismatch == 0);
 }
 
 template <BinaryOpCode OP_CODE, LegateTypeCode CODE, int DIM>
@@ -62,22 +85,25 @@ struct BinaryRedImplBody<VariantKind::GPU, OP_CODE, CODE, DIM> {
                   const Rect<DIM>& rect,
                   bool dense) const
   {
-    size_t volume       = rect.volume();
-    const size_t blocks = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
-    DeferredReduction<ProdReduction<bool>> result;
-    cudaStream_t stream;
-    cudaStreamCreate(&stream);
-    if (dense) {
-      auto in1ptr = in1.ptr(rect);
-      auto in2ptr = in2.ptr(rect);
-      dense_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(volume, func, result, in1ptr, in2ptr);
-    } else {
-      generic_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
-        volume, func, result, in1, in2, pitches, rect);
+    size_t volume = rect.volume();
+    const size_t blocks = std::min<size_t>((volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK,
+                                           get_max_reduction_ctas());
+    auto stream   = get_cached_stream();
+    auto mismatch = create_buffer<int32_t>(1, Memory::Kind::GPU_FB_MEM);
+    CHECK_CUDA(cudaMemsetAsync(mismatch.ptr(0), 0, sizeof(int32_t), stream));
+    if (volume > 0) {
+      if (dense) {
+        auto in1ptr = in1.ptr(rect);
+        auto in2ptr = in2.ptr(rect);
+        dense_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+          volume, func, mismatch.ptr(0), in1ptr, in2ptr);
+      } else {
+        generic_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+          volume, func, mismatch.ptr(0), in1, in2, pitches, rect);
+      }
     }
 
-    copy_kernel<<<1, 1, 0, stream>>>(result, out);
-    cudaStreamDestroy(stream);
+    copy_kernel<<<1, 1, 0, stream>>>(mismatch.ptr(0), out);
   }
 };
 
@@ -27,8 +27,15 @@ struct BinaryRedArgs {
   const Array& in2;
   BinaryOpCode op_code;
   std::vector<legate::Store> args;
+  // The tolerances of ALLCLOSE
+  double rtol{0};
+  double atol{0};
 };
 
+// Number of elements that the OpenMP threads compare at a time, between which they check
+// whether any of them has found a mismatch yet
+constexpr size_t BINARY_RED_CHUNK_SIZE = 1 << 14;
+
 class BinaryRedTask : public CuNumericTask<BinaryRedTask> {
  public:
   static const int TASK_ID = CUNUMERIC_BINARY_RED;
@@ -17,6 +17,8 @@
 #include "cunumeric/binary/binary_red.h"
 #include "cunumeric/binary/binary_red_template.inl"
 
+#include <atomic>
+
 namespace cunumeric {
 
 using namespace Legion;
@@ -36,23 +38,33 @@ struct BinaryRedImplBody<VariantKind::OMP, OP_CODE, CODE, DIM> {
                   const Rect<DIM>& rect,
                   bool dense) const
   {
-    size_t volume = rect.volume();
-    bool result   = true;
-    if (dense) {
-      auto in1ptr = in1.ptr(rect);
-      auto in2ptr = in2.ptr(rect);
-#pragma omp parallel for schedule(static)
-      for (size_t idx = 0; idx < volume; ++idx)
-        if (!func(in1ptr[idx], in2ptr[idx])) result = false;
-    } else {
-#pragma omp parallel for schedule(static)
-      for (size_t idx = 0; idx < volume; ++idx) {
-        auto point = pitches.unflatten(idx, rect.lo);
-        if (!func(in1[point], in2[point])) result = false;
+    const size_t volume     = rect.volume();
+    const size_t num_chunks = (volume + BINARY_RED_CHUNK_SIZE - 1) / BINARY_RED_CHUNK_SIZE;
+    // The threads give up on the chunks they have left once any of them finds a mismatch
+    std::atomic<bool> mismatch{false};
+    auto compare = [&](size_t lo, size_t hi) {
+      if (dense) {
+        auto in1ptr = in1.ptr(rect);
+        auto in2ptr = in2.ptr(rect);
+        for (size_t idx = lo; idx < hi; ++idx)
+          if (!func(in1ptr[idx], in2ptr[idx])) return false;
+      } else {
+        for (size_t idx = lo; idx < hi; ++idx) {
+          auto point = pitches.unflatten(idx, rect.lo);
+          if (!func(in1[point], in2[point])) return false;
+        }
       }
+      return true;
+    };
+#pragma omp parallel for schedule(dynamic)
+    for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
+      if (mismatch.load(std::memory_order_relaxed)) continue;
+      const size_t lo = chunk * BINARY_RED_CHUNK_SIZE;
+      const size_t hi = std::min(volume, lo + BINARY_RED_CHUNK_SIZE);
+      if (!compare(lo, hi)) mismatch.store(true, std::memory_order_relaxed);
     }
 
-    out.reduce(0, result);
+    out.reduce(0, !mismatch.load());
   }
 };
 
@@ -15,6 +15,7 @@
  */
 
 #include "cunumeric/binary/binary_op_util.h"
+#include "cunumeric/annotate.h"
 #include "cunumeric/pitches.h"
 
 namespace cunumeric {
@@ -25,6 +26,15 @@ using namespace legate;
 template <VariantKind KIND, BinaryOpCode OP_CODE, LegateTypeCode CODE, int DIM>
 struct BinaryRedImplBody;
 
+template <BinaryOpCode OP_CODE, LegateTypeCode CODE>
+static BinaryOp<OP_CODE, CODE> make_binary_red_op(const BinaryRedArgs& args)
+{
+  if constexpr (OP_CODE == BinaryOpCode::ALLCLOSE)
+    return BinaryOp<OP_CODE, CODE>(args.rtol, args.atol);
+  else
+    return BinaryOp<OP_CODE, CODE>(args.args);
+}
+
 template <VariantKind KIND, BinaryOpCode OP_CODE>
 struct BinaryRedImpl {
   template <LegateTypeCode CODE,
@@ -52,7 +62,7 @@ struct BinaryRedImpl {
     bool dense = false;
 #endif
 
-    OP func(args.args);
+    auto func = make_binary_red_op<OP_CODE, CODE>(args);
     BinaryRedImplBody<KIND, OP_CODE, CODE, DIM>()(func, out, in1, in2, pitches, rect, dense);
   }
 
@@ -71,7 +81,9 @@ struct BinaryRedDispatch {
   void operator()(BinaryRedArgs& args) const
   {
     auto dim = std::max(1, std::max(args.in1.dim(), args.in2.dim()));
-    double_dispatch(dim, args.in1.code(), BinaryRedImpl<KIND, OP_CODE>{}, args);
+    AnnotatedRange range(
+      "binary_red", OP_CODE, args.in1.code(), dim, args.in1.domain().get_volume());
+    cunumeric::double_dispatch(dim, args.in1.code(), BinaryRedImpl<KIND, OP_CODE>{}, args);
   }
 };
 
@@ -89,6 +101,10 @@ static void binary_red_template(TaskContext& context)
                      inputs[1],
                      scalars[0].value<BinaryOpCode>(),
                      std::move(extra_args)};
+  if (args.op_code == BinaryOpCode::ALLCLOSE) {
+    args.rtol = scalars[1].value<double>();
+    args.atol = scalars[2].value<double>();
+  }
   reduce_op_dispatch(args.op_code, BinaryRedDispatch<KIND>{}, args);
 }
 
@@ -17,6 +17,7 @@
 #include "cunumeric/divmod.h"
 #include "cunumeric/convolution/convolve.h"
 #include "cunumeric/convolution/convolve_template.inl"
+#include "cunumeric/convolution/convolve_cpu.h"
 
 namespace cunumeric {
 
@@ -75,180 +76,273 @@ struct ConvolveImplBody<VariantKind::CPU, CODE, DIM> {
 };
 #endif
 
-template <LegateTypeCode CODE, int DIM>
-struct ConvolveImplBody<VariantKind::CPU, CODE, DIM> {
-  using VAL = legate_type_of<CODE>;
-
-  void operator()(AccessorWO<VAL, DIM> out,
-                  AccessorRO<VAL, DIM> filter,
-                  AccessorRO<VAL, DIM> in,
-                  const Rect<DIM>& root_rect,
-                  const Rect<DIM>& subrect,
-                  const Rect<DIM>& filter_rect) const
-  {
-    const Point<DIM> zero = Point<DIM>::ZEROES();
-    const Point<DIM> one  = Point<DIM>::ONES();
-    Point<DIM> extents    = filter_rect.hi - filter_rect.lo + one;
-    Point<DIM> centers;
-    for (int d = 0; d < DIM; d++) centers[d] = extents[d] / 2;
+// Convolves a subrect with tiles of the output and the filter that are blocked
+// for the L2 and L1 caches
+template <typename VAL, int DIM>
+static void tiled_convolution(AccessorWO<VAL, DIM> out,
+                              AccessorRO<VAL, DIM> filter,
+                              AccessorRO<VAL, DIM> in,
+                              const Rect<DIM>& root_rect,
+                              const Rect<DIM>& subrect,
+                              const Rect<DIM>& filter_rect,
+                              const size_t line_size,
+                              const size_t l1_cache_size,
+                              const size_t l2_cache_size)
+{
+  const Point<DIM> zero = Point<DIM>::ZEROES();
+  const Point<DIM> one  = Point<DIM>::ONES();
+  Point<DIM> extents    = filter_rect.hi - filter_rect.lo + one;
+  Point<DIM> centers;
+  for (int d = 0; d < DIM; d++) centers[d] = extents[d] / 2;
 
-    // Compute the tiles for the L2 cache
-    Point<DIM> l2_output_tile, l2_filter_tile;
-    const Point<DIM> output_bounds = subrect.hi - subrect.lo + one;
-    // Try to fit the output in 1/4 of the L2 cache and
-    // and the input and filter in the other 3/4
-    compute_output_tile<VAL, DIM>(l2_output_tile,
-                                  output_bounds,
-                                  CACHE_LINE_SIZE / sizeof(VAL),
-                                  L2_CACHE_SIZE / sizeof(VAL) / 4);
-    const Point<DIM> filter_bounds = filter_rect.hi - filter_rect.lo + one;
-    compute_filter_tile<VAL, DIM>(
-      l2_filter_tile, filter_bounds, l2_output_tile, 3 * L2_CACHE_SIZE / 4);
-    unsigned total_l2_filters = 1;
-    for (int d = 0; d < DIM; d++)
-      total_l2_filters *= ((extents[d] + l2_filter_tile[d] - 1) / l2_filter_tile[d]);
-    unsigned total_l2_outputs = 1;
-    for (int d = 0; d < DIM; d++)
-      total_l2_outputs *= ((output_bounds[d] + l2_output_tile[d] - 1) / l2_output_tile[d]);
+  // Compute the tiles for the L2 cache
+  Point<DIM> l2_output_tile, l2_filter_tile;
+  const Point<DIM> output_bounds = subrect.hi - subrect.lo + one;
+  // Try to fit the output in 1/4 of the L2 cache and
+  // and the input and filter in the other 3/4
+  compute_output_tile<VAL, DIM>(
+    l2_output_tile, output_bounds, line_size / sizeof(VAL), l2_cache_size / sizeof(VAL) / 4);
+  const Point<DIM> filter_bounds = filter_rect.hi - filter_rect.lo + one;
+  compute_filter_tile<VAL, DIM>(
+    l2_filter_tile, filter_bounds, l2_output_tile, 3 * l2_cache_size / 4);
+  unsigned total_l2_filters = 1;
+  for (int d = 0; d < DIM; d++)
+    total_l2_filters *= ((extents[d] + l2_filter_tile[d] - 1) / l2_filter_tile[d]);
+  unsigned total_l2_outputs = 1;
+  for (int d = 0; d < DIM; d++)
+    total_l2_outputs *= ((output_bounds[d] + l2_output_tile[d] - 1) / l2_output_tile[d]);
 
-    // Compute the tiles for the L1 cache
-    Point<DIM> l1_output_tile, l1_filter_tile;
-    // Try to fit the output in the 1/4 of the L1 cache and
-    // the filter and input in the other 3/4 of the L1 cache
-    compute_output_tile<VAL, DIM>(l1_output_tile,
-                                  output_bounds,
-                                  CACHE_LINE_SIZE / sizeof(VAL),
-                                  L1_CACHE_SIZE / sizeof(VAL) / 4);
-    compute_filter_tile<VAL, DIM>(
-      l1_filter_tile, filter_bounds, l1_output_tile, 3 * L1_CACHE_SIZE / 4);
-    unsigned total_l1_filters = 1;
-    for (int d = 0; d < DIM; d++)
-      total_l1_filters *= ((l2_filter_tile[d] + l1_filter_tile[d] - 1) / l1_filter_tile[d]);
-    unsigned total_l1_outputs = 1;
-    for (int d = 0; d < DIM; d++)
-      total_l1_outputs *= ((l2_output_tile[d] + l1_output_tile[d] - 1) / l1_output_tile[d]);
+  // Compute the tiles for the L1 cache
+  Point<DIM> l1_output_tile, l1_filter_tile;
+  // Try to fit the output in the 1/4 of the L1 cache and
+  // the filter and input in the other 3/4 of the L1 cache
+  compute_output_tile<VAL, DIM>(
+    l1_output_tile, output_bounds, line_size / sizeof(VAL), l1_cache_size / sizeof(VAL) / 4);
+  compute_filter_tile<VAL, DIM>(
+    l1_filter_tile, filter_bounds, l1_output_tile, 3 * l1_cache_size / 4);
+  unsigned total_l1_filters = 1;
+  for (int d = 0; d < DIM; d++)
+    total_l1_filters *= ((l2_filter_tile[d] + l1_filter_tile[d] - 1) / l1_filter_tile[d]);
+  unsigned total_l1_outputs = 1;
+  for (int d = 0; d < DIM; d++)
+    total_l1_outputs *= ((l2_output_tile[d] + l1_output_tile[d] - 1) / l1_output_tile[d]);
 
-    // Zero out the output data since we're going to be doing sum accumulations
-    Point<DIM> output         = subrect.lo;
-    const size_t total_points = subrect.volume();
-    for (size_t p = 0; p < total_points; p++) {
-      out[output] = VAL{0};
-      for (int d = DIM - 1; d >= 0; d--) {
-        output[d]++;
-        if (subrect.hi[d] < output[d])
-          output[d] = subrect.lo[d];
-        else
-          break;
-      }
+  // Zero out the output data since we're going to be doing sum accumulations
+  Point<DIM> output         = subrect.lo;
+  const size_t total_points = subrect.volume();
+  for (size_t p = 0; p < total_points; p++) {
+    out[output] = VAL{0};
+    for (int d = DIM - 1; d >= 0; d--) {
+      output[d]++;
+      if (subrect.hi[d] < output[d])
+        output[d] = subrect.lo[d];
+      else
+        break;
     }
+  }
 
-    // Iterate over the L2 filter tiles
-    Point<DIM> l2_filter = filter_rect.lo;
-    for (unsigned l2_fidx = 0; l2_fidx < total_l2_filters; l2_fidx++) {
-      Rect<DIM> l2_filter_rect(l2_filter, l2_filter + l2_filter_tile - one);
-      unsigned local_l1_filters = total_l1_filters;
-      // Make sure we don't overflow our boundaries
-      if (!filter_rect.contains(l2_filter_rect)) {
-        l2_filter_rect   = filter_rect.intersection(l2_filter_rect);
-        local_l1_filters = 1;
+  // Iterate over the L2 filter tiles
+  Point<DIM> l2_filter = filter_rect.lo;
+  for (unsigned l2_fidx = 0; l2_fidx < total_l2_filters; l2_fidx++) {
+    Rect<DIM> l2_filter_rect(l2_filter, l2_filter + l2_filter_tile - one);
+    unsigned local_l1_filters = total_l1_filters;
+    // Make sure we don't overflow our boundaries
+    if (!filter_rect.contains(l2_filter_rect)) {
+      l2_filter_rect   = filter_rect.intersection(l2_filter_rect);
+      local_l1_filters = 1;
+      for (int d = 0; d < DIM; d++)
+        local_l1_filters *=
+          ((l2_filter_rect.hi[d] - l2_filter_rect.lo[d] + l1_filter_tile[d]) / l1_filter_tile[d]);
+    }
+    // Now iterate the tiles for the L2 outputs
+    Point<DIM> l2_output = subrect.lo;
+    for (unsigned l2_outidx = 0; l2_outidx < total_l2_outputs; l2_outidx++) {
+      Rect<DIM> l2_output_rect(l2_output, l2_output + l2_output_tile - one);
+      unsigned local_l1_outputs = total_l1_outputs;
+      if (!subrect.contains(l2_output_rect)) {
+        l2_output_rect   = subrect.intersection(l2_output_rect);
+        local_l1_outputs = 1;
         for (int d = 0; d < DIM; d++)
-          local_l1_filters *=
-            ((l2_filter_rect.hi[d] - l2_filter_rect.lo[d] + l1_filter_tile[d]) / l1_filter_tile[d]);
+          local_l1_outputs *= ((l2_output_rect.hi[d] - l2_output_rect.lo[d] + l1_output_tile[d]) /
+                               l1_output_tile[d]);
       }
-      // Now iterate the tiles for the L2 outputs
-      Point<DIM> l2_output = subrect.lo;
-      for (unsigned l2_outidx = 0; l2_outidx < total_l2_outputs; l2_outidx++) {
-        Rect<DIM> l2_output_rect(l2_output, l2_output + l2_output_tile - one);
-        unsigned local_l1_outputs = total_l1_outputs;
-        if (!subrect.contains(l2_output_rect)) {
-          l2_output_rect   = subrect.intersection(l2_output_rect);
-          local_l1_outputs = 1;
-          for (int d = 0; d < DIM; d++)
-            local_l1_outputs *= ((l2_output_rect.hi[d] - l2_output_rect.lo[d] + l1_output_tile[d]) /
-                                 l1_output_tile[d]);
-        }
-        // Do a quick check here to see if all the inputs are contained for
-        // this particular tile
-        Rect<DIM> l2_input_rect(l2_output_rect.lo + extents - l2_filter_rect.hi - one - centers,
-                                l2_output_rect.hi + extents - l2_filter_rect.lo - one - centers);
-        const bool input_contained = root_rect.contains(l2_input_rect);
-        // Iterate the L1 output tiles this output rect
-        Point<DIM> l1_output = l2_output;
-        for (unsigned l1_outidx = 0; l1_outidx < local_l1_outputs; l1_outidx++) {
-          Rect<DIM> l1_output_rect(l1_output, l1_output + l1_output_tile - one);
-          l1_output_rect = l2_output_rect.intersection(l1_output_rect);
-          // Iterate the L1 filters for this L1 output rect
-          Point<DIM> l1_filter = l2_filter;
-          for (unsigned l1_fidx = 0; l1_fidx < local_l1_filters; l1_fidx++) {
-            Rect<DIM> l1_filter_rect(l1_filter, l1_filter + l1_filter_tile - one);
-            l1_filter_rect                  = l2_filter_rect.intersection(l1_filter_rect);
-            const unsigned l1_filter_points = l1_filter_rect.volume();
-            // Now we can iterate all the points in the output volume and
-            // compute the their partial accumulations to the output value
-            const unsigned l1_output_points = l1_output_rect.volume();
-            output                          = l1_output_rect.lo;
-            for (unsigned pidx = 0; pidx < l1_output_points; pidx++) {
-              VAL acc{0};
-              Point<DIM> filter_point = l1_filter_rect.lo;
-              for (unsigned fidx = 0; fidx < l1_filter_points; fidx++) {
-                Point<DIM> input = output + extents - filter_point - one - centers;
-                if (input_contained || root_rect.contains(input))
-                  acc += in[input] * filter[filter_point];
-                // Step to the next filter point
-                for (int d = DIM - 1; d >= 0; d--) {
-                  filter_point[d]++;
-                  if (l1_filter_rect.hi[d] < filter_point[d])
-                    filter_point[d] = l1_filter_rect.lo[d];
-                  else
-                    break;
-                }
-              }
-              out[output] += acc;
-              // Step to the next output point
+      // Do a quick check here to see if all the inputs are contained for
+      // this particular tile
+      Rect<DIM> l2_input_rect(l2_output_rect.lo + extents - l2_filter_rect.hi - one - centers,
+                              l2_output_rect.hi + extents - l2_filter_rect.lo - one - centers);
+      const bool input_contained = root_rect.contains(l2_input_rect);
+      // Iterate the L1 output tiles this output rect
+      Point<DIM> l1_output = l2_output;
+      for (unsigned l1_outidx = 0; l1_outidx < local_l1_outputs; l1_outidx++) {
+        Rect<DIM> l1_output_rect(l1_output, l1_output + l1_output_tile - one);
+        l1_output_rect = l2_output_rect.intersection(l1_output_rect);
+        // Iterate the L1 filters for this L1 output rect
+        Point<DIM> l1_filter = l2_filter;
+        for (unsigned l1_fidx = 0; l1_fidx < local_l1_filters; l1_fidx++) {
+          Rect<DIM> l1_filter_rect(l1_filter, l1_filter + l1_filter_tile - one);
+          l1_filter_rect                  = l2_filter_rect.intersection(l1_filter_rect);
+          const unsigned l1_filter_points = l1_filter_rect.volume();
+          // Now we can iterate all the points in the output volume and
+          // compute the their partial accumulations to the output value
+          const unsigned l1_output_points = l1_output_rect.volume();
+          output                          = l1_output_rect.lo;
+          for (unsigned pidx = 0; pidx < l1_output_points; pidx++) {
+            VAL acc{0};
+            Point<DIM> filter_point = l1_filter_rect.lo;
+            for (unsigned fidx = 0; fidx < l1_filter_points; fidx++) {
+              Point<DIM> input = output + extents - filter_point - one - centers;
+              if (input_contained || root_rect.contains(input))
+                acc += in[input] * filter[filter_point];
+              // Step to the next filter point
               for (int d = DIM - 1; d >= 0; d--) {
-                output[d]++;
-                if (l1_output_rect.hi[d] < output[d])
-                  output[d] = l1_output_rect.lo[d];
+                filter_point[d]++;
+                if (l1_filter_rect.hi[d] < filter_point[d])
+                  filter_point[d] = l1_filter_rect.lo[d];
                 else
                   break;
               }
             }
-            // Step to the next L1 filter
+            out[output] += acc;
+            // Step to the next output point
             for (int d = DIM - 1; d >= 0; d--) {
-              l1_filter[d] += l1_filter_tile[d];
-              if (l2_filter_rect.hi[d] < l1_filter[d])
-                l1_filter[d] = l2_filter_rect.lo[d];
+              output[d]++;
+              if (l1_output_rect.hi[d] < output[d])
+                output[d] = l1_output_rect.lo[d];
               else
                 break;
             }
           }
-          // Step to the next L1 output tile
+          // Step to the next L1 filter
           for (int d = DIM - 1; d >= 0; d--) {
-            l1_output[d] += l1_output_tile[d];
-            if (l2_output_rect.hi[d] < l1_output[d])
-              l1_output[d] = l2_output_rect.lo[d];
+            l1_filter[d] += l1_filter_tile[d];
+            if (l2_filter_rect.hi[d] < l1_filter[d])
+              l1_filter[d] = l2_filter_rect.lo[d];
             else
               break;
           }
         }
-        // Step to the next output tile
+        // Step to the next L1 output tile
         for (int d = DIM - 1; d >= 0; d--) {
-          l2_output[d] += l2_output_tile[d];
-          if (subrect.hi[d] < l2_output[d])
-            l2_output[d] = subrect.lo[d];
+          l1_output[d] += l1_output_tile[d];
+          if (l2_output_rect.hi[d] < l1_output[d])
+            l1_output[d] = l2_output_rect.lo[d];
           else
             break;
         }
       }
-      // Step to the next l2 filter
+      // Step to the next output tile
       for (int d = DIM - 1; d >= 0; d--) {
-        l2_filter[d] += l2_filter_tile[d];
-        if (filter_rect.hi[d] < l2_filter[d])
-          l2_filter[d] = filter_rect.lo[d];
+        l2_output[d] += l2_output_tile[d];
+        if (subrect.hi[d] < l2_output[d])
+          l2_output[d] = subrect.lo[d];
         else
           break;
       }
     }
+    // Step to the next l2 filter
+    for (int d = DIM - 1; d >= 0; d--) {
+      l2_filter[d] += l2_filter_tile[d];
+      if (filter_rect.hi[d] < l2_filter[d])
+        l2_filter[d] = filter_rect.lo[d];
+      else
+        break;
+    }
+  }
+}
+
+template <LegateTypeCode CODE, int DIM>
+struct ConvolveImplBody<VariantKind::CPU, CODE, DIM> {
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(AccessorWO<VAL, DIM> out,
+                  AccessorRO<VAL, DIM> filter,
+                  AccessorRO<VAL, DIM> in,
+                  const Rect<DIM>& root_rect,
+                  const Rect<DIM>& subrect,
+                  const Rect<DIM>& filter_rect) const
+  {
+    // Large filters are cheaper to apply in the frequency domain, like on the GPU, and
+    // separable ones one dimension at a time
+    if constexpr (CODE == FLOAT_LT || CODE == DOUBLE_LT) {
+      if (fast_convolution<VariantKind::CPU, VAL, DIM>(
+            out, filter, in, root_rect, subrect, filter_rect))
+        return;
+    }
+
+    const auto& caches         = get_cpu_caches();
+    const size_t line_size     = tiling_cache_size(caches.line_size);
+    const size_t l1_cache_size = tiling_cache_size(caches.l1_size);
+    const size_t l2_cache_size = tiling_cache_size(caches.l2_size);
+    const size_t l3_cache_size = tiling_cache_size(caches.l3_size);
+    if (l3_cache_size <= l2_cache_size) {
+      tiled_convolution<VAL, DIM>(
+        out, filter, in, root_rect, subrect, filter_rect, line_size, l1_cache_size, l2_cache_size);
+      return;
+    }
+
+    // Every L2 filter tile sweeps over all the L2 output tiles, so block the output
+    // for the share of the L3 cache of this core as well to keep those sweeps out of
+    // memory. Like the other levels, 1/4 of the cache goes to the output.
+    const Point<DIM> one           = Point<DIM>::ONES();
+    const Point<DIM> output_bounds = subrect.hi - subrect.lo + one;
+    Point<DIM> l3_output_tile;
+    compute_output_tile<VAL, DIM>(
+      l3_output_tile, output_bounds, line_size / sizeof(VAL), l3_cache_size / sizeof(VAL) / 4);
+    size_t total_l3_outputs = 1;
+    for (int d = 0; d < DIM; d++)
+      total_l3_outputs *= ((output_bounds[d] + l3_output_tile[d] - 1) / l3_output_tile[d]);
+
+    Point<DIM> l3_output = subrect.lo;
+    for (size_t l3_outidx = 0; l3_outidx < total_l3_outputs; l3_outidx++) {
+      Rect<DIM> l3_output_rect(l3_output, l3_output + l3_output_tile - one);
+      l3_output_rect = subrect.intersection(l3_output_rect);
+      tiled_convolution<VAL, DIM>(out,
+                                  filter,
+                                  in,
+                                  root_rect,
+                                  l3_output_rect,
+                                  filter_rect,
+                                  line_size,
+                                  l1_cache_size,
+                                  l2_cache_size);
+      // Step to the next L3 output tile
+      for (int d = DIM - 1; d >= 0; d--) {
+        l3_output[d] += l3_output_tile[d];
+        if (subrect.hi[d] < l3_output[d])
+          l3_output[d] = subrect.lo[d];
+        else
+          break;
+      }
+    }
+  }
+};
+
+template <LegateTypeCode CODE, int DIM>
+struct StridedConvolveImplBody<VariantKind::CPU, CODE, DIM> {
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(AccessorWO<VAL, DIM> out,
+                  AccessorRO<VAL, DIM> filter,
+                  AccessorRO<VAL, DIM> in,
+                  const Rect<DIM>& input_rect,
+                  const Rect<DIM>& subrect,
+                  const Rect<DIM>& filter_rect,
+                  const StridedConvolution<DIM>& strided) const
+  {
+    Pitches<DIM - 1> output_pitches;
+    const size_t output_volume = output_pitches.flatten(subrect);
+    Pitches<DIM - 1> filter_pitches;
+    const size_t filter_volume = filter_pitches.flatten(filter_rect);
+    for (size_t idx = 0; idx < output_volume; idx++) {
+      const auto output = output_pitches.unflatten(idx, subrect.lo);
+      VAL acc{0};
+      for (size_t f = 0; f < filter_volume; f++) {
+        const auto filter_point = filter_pitches.unflatten(f, filter_rect.lo);
+        const auto input        = strided.input(output, filter_point);
+        if (input_rect.contains(input)) acc += in[input] * filter[filter_point];
+      }
+      out[output] = acc;
+    }
   }
 };
 
@@ -18,6 +18,9 @@
 #include "cunumeric/cuda_help.h"
 #include "cunumeric/convolution/convolve.h"
 #include "cunumeric/convolution/convolve_template.inl"
+#include "cunumeric/convolution/convolve_separable.h"
+
+#include <memory>
 
 namespace cunumeric {
 
@@ -48,6 +51,18 @@ using namespace legate;
 // that threadblocks walking through memory together can hopefully
 // hit in the L2 more often than not when loading data
 
+// The type that the kernels accumulate in. Products of half precision values are summed
+// in single precision, as half precision sums run out of bits after a few thousand terms.
+template <typename VAL>
+struct ConvolutionAccumulator {
+  using type = VAL;
+};
+
+template <>
+struct ConvolutionAccumulator<__half> {
+  using type = float;
+};
+
 template <int DIM>
 struct ConvolutionInitArgs {
  public:
@@ -127,6 +142,7 @@ __global__ static void __launch_bounds__(CONVOLUTION_THREADS, 1)
   extern __shared__ uint8_t buffer[];
   // Technically this is illegal C++, but there's no other way to do it
   VAL* sharedmem = (VAL*)buffer;
+  using ACC      = typename ConvolutionAccumulator<VAL>::type;
   Point<DIM, unsigned> thread_offset;
   int offset = threadIdx.x;
 #pragma unroll
@@ -161,9 +177,9 @@ __global__ static void __launch_bounds__(CONVOLUTION_THREADS, 1)
       }
       if (!output_contained) continue;
       // Initialize our point data
-      VAL acc[POINTS];
+      ACC acc[POINTS];
 #pragma unroll
-      for (int p = 0; p < POINTS; p++) acc[p] = VAL{0};
+      for (int p = 0; p < POINTS; p++) acc[p] = ACC{0};
       // Iterate over the l1 filter tiles
       Point<DIM, unsigned> l1_filter_offset = zero;
       for (unsigned l1_fidx = 0; l1_fidx < args.total_l1_filters; l1_fidx++) {
@@ -218,12 +234,12 @@ __global__ static void __launch_bounds__(CONVOLUTION_THREADS, 1)
           if (args.shared_input_bound) {
             for (unsigned fidx = 0; fidx < args.l1_filter_points; fidx++) {
               // Use shared memory broadcasting functionality to avoid bank conflicts
-              const VAL filter_value = sharedmem[fidx];
+              const ACC filter_value = sharedmem[fidx];
               unsigned point_offset  = input_offset;
 #pragma unroll
               for (int p = 0; p < POINTS; p++) {
                 if (args.shared_input_bound <= point_offset) break;
-                acc[p] = acc[p] + filter_value * sharedmem[point_offset];
+                acc[p] = acc[p] + filter_value * static_cast<ACC>(sharedmem[point_offset]);
                 point_offset += args.uniform_input_stride;
               }
 // Step to the next filter point and update the input stride
@@ -242,11 +258,11 @@ __global__ static void __launch_bounds__(CONVOLUTION_THREADS, 1)
           } else {
             for (unsigned fidx = 0; fidx < args.l1_filter_points; fidx++) {
               // Use shared memory broadcasting functionality to avoid bank conflicts
-              const VAL filter_value = sharedmem[fidx];
+              const ACC filter_value = sharedmem[fidx];
               unsigned point_offset  = input_offset;
 #pragma unroll
               for (int p = 0; p < POINTS; p++) {
-                acc[p] = acc[p] + filter_value * sharedmem[point_offset];
+                acc[p] = acc[p] + filter_value * static_cast<ACC>(sharedmem[point_offset]);
                 point_offset += args.uniform_input_stride;
               }
 // Step to the next filter point and update the input stride
@@ -279,12 +295,12 @@ __global__ static void __launch_bounds__(CONVOLUTION_THREADS, 1)
           if (args.shared_input_bound) {
             for (unsigned fidx = 0; fidx < args.l1_filter_points; fidx++) {
               // Use shared memory broadcasting functionality to avoid bank conflicts
-              const VAL filter_value = sharedmem[fidx];
+              const ACC filter_value = sharedmem[fidx];
 #pragma unroll
               for (int p = 0; p < POINTS; p++) {
                 unsigned point_offset = point_offsets[p] - filter_offset;
                 if (args.shared_input_bound <= point_offset) continue;
-                acc[p] = acc[p] + filter_value * sharedmem[point_offset];
+                acc[p] = acc[p] + filter_value * static_cast<ACC>(sharedmem[point_offset]);
               }
 // Step to the next filter point
 #pragma unroll
@@ -302,11 +318,11 @@ __global__ static void __launch_bounds__(CONVOLUTION_THREADS, 1)
           } else {
             for (unsigned fidx = 0; fidx < args.l1_filter_points; fidx++) {
               // Use shared memory broadcasting functionality to avoid bank conflicts
-              const VAL filter_value = sharedmem[fidx];
+              const ACC filter_value = sharedmem[fidx];
 #pragma unroll
               for (int p = 0; p < POINTS; p++) {
                 unsigned point_offset = point_offsets[p] - filter_offset;
-                acc[p]                = acc[p] + filter_value * sharedmem[point_offset];
+                acc[p] = acc[p] + filter_value * static_cast<ACC>(sharedmem[point_offset]);
               }
 // Step to the next filter point
 #pragma unroll
@@ -345,7 +361,7 @@ __global__ static void __launch_bounds__(CONVOLUTION_THREADS, 1)
             VAL* ptr = out.ptr(output + args.point_offsets[p]);
             // Make sure we don't pollute the L2 cache
             VAL value = load_streaming<VAL>(ptr);
-            store_streaming<VAL>(ptr, value + acc[p]);
+            store_streaming<VAL>(ptr, static_cast<VAL>(static_cast<ACC>(value) + acc[p]));
             index += blockDim.x;
           }
         } else {
@@ -354,7 +370,7 @@ __global__ static void __launch_bounds__(CONVOLUTION_THREADS, 1)
             VAL* ptr = out.ptr(output + args.point_offsets[p]);
             // Make sure we don't pollute the L2 cache
             VAL value = load_streaming<VAL>(ptr);
-            store_streaming<VAL>(ptr, value + acc[p]);
+            store_streaming<VAL>(ptr, static_cast<VAL>(static_cast<ACC>(value) + acc[p]));
           }
         }
       } else {
@@ -369,7 +385,7 @@ __global__ static void __launch_bounds__(CONVOLUTION_THREADS, 1)
             VAL* ptr = out.ptr(point);
             // Make sure we don't pollute the L2 cache
             VAL value = load_streaming<VAL>(ptr);
-            store_streaming<VAL>(ptr, value + acc[p]);
+            store_streaming<VAL>(ptr, static_cast<VAL>(static_cast<ACC>(value) + acc[p]));
             index += blockDim.x;
           }
         } else {
@@ -380,7 +396,7 @@ __global__ static void __launch_bounds__(CONVOLUTION_THREADS, 1)
             VAL* ptr = out.ptr(point);
             // Make sure we don't pollute the L2 cache
             VAL value = load_streaming<VAL>(ptr);
-            store_streaming<VAL>(ptr, value + acc[p]);
+            store_streaming<VAL>(ptr, static_cast<VAL>(static_cast<ACC>(value) + acc[p]));
           }
         }
       }
@@ -425,6 +441,7 @@ __global__ static void __launch_bounds__(512, 2)
   extern __shared__ uint8_t buffer[];
   // Technically this illegal C++, but there's no other way to do it
   VAL* input = (VAL*)buffer;
+  using ACC  = typename ConvolutionAccumulator<VAL>::type;
   // Compute the origin point of the block
   size_t offset          = blockIdx.x;
   Point<DIM> block_point = subrect.lo;
@@ -477,7 +494,7 @@ __global__ static void __launch_bounds__(512, 2)
     if (!subrect.contains(out_point)) continue;
 #pragma unroll
     for (int d = 0; d < DIM; d++) f_coords[d] = 0;
-    VAL acc{0};
+    ACC acc{0};
     for (unsigned idx = 0; idx < args.filter_volume; idx++) {
 #pragma unroll
       for (int d = 0; d < DIM; d++)
@@ -489,7 +506,7 @@ __global__ static void __launch_bounds__(512, 2)
           offset += (tile_point[d] + f_coords[d]) * args.input_pitches[d].divisor;
 #pragma unroll
         for (int d = 0; d < DIM; d++) filter_point[d] = args.filter_extents[d] - f_coords[d] - 1;
-        acc = acc + input[offset] * filter[filter_point];
+        acc = acc + static_cast<ACC>(input[offset]) * static_cast<ACC>(filter[filter_point]);
       }
 // Step the filter coordinates
 #pragma unroll
@@ -501,7 +518,7 @@ __global__ static void __launch_bounds__(512, 2)
           break;
       }
     }
-    store_streaming(out.ptr(out_point), acc);
+    store_streaming(out.ptr(out_point), static_cast<VAL>(acc));
   }
 }
 
@@ -521,6 +538,7 @@ __global__ static void __launch_bounds__(1024, 1)
   extern __shared__ uint8_t buffer[];
   // Technically this illegal C++, but there's no other way to do it
   VAL* input = (VAL*)buffer;
+  using ACC  = typename ConvolutionAccumulator<VAL>::type;
   // Compute the origin point of the block
   size_t offset          = blockIdx.x;
   Point<DIM> block_point = subrect.lo;
@@ -573,7 +591,7 @@ __global__ static void __launch_bounds__(1024, 1)
     if (!subrect.contains(out_point)) continue;
 #pragma unroll
     for (int d = 0; d < DIM; d++) f_coords[d] = 0;
-    VAL acc{0};
+    ACC acc{0};
     for (unsigned idx = 0; idx < args.filter_volume; idx++) {
 #pragma unroll
       for (int d = 0; d < DIM; d++)
@@ -585,7 +603,7 @@ __global__ static void __launch_bounds__(1024, 1)
           offset += (tile_point[d] + f_coords[d]) * args.input_pitches[d].divisor;
 #pragma unroll
         for (int d = 0; d < DIM; d++) filter_point[d] = args.filter_extents[d] - f_coords[d] - 1;
-        acc = acc + input[offset] * filter[filter_point];
+        acc = acc + static_cast<ACC>(input[offset]) * static_cast<ACC>(filter[filter_point]);
       }
 // Step the filter coordinates
 #pragma unroll
@@ -597,7 +615,7 @@ __global__ static void __launch_bounds__(1024, 1)
           break;
       }
     }
-    store_streaming(out.ptr(out_point), acc);
+    store_streaming(out.ptr(out_point), static_cast<VAL>(acc));
   }
 }
 
@@ -615,6 +633,8 @@ __host__ static inline void launch_small_tile_kernel(AccessorWO<VAL, DIM> out,
                                                      unsigned smem_size,
                                                      size_t max_smem_size)
 {
+  auto stream = get_cached_stream();
+
   // Make the tile as big as possible so that it fits in shared memory
   // Try to keep it rectangular to minimize surface-to-volume ratio
   // and improve the reuse of data
@@ -658,18 +678,18 @@ __host__ static inline void launch_small_tile_kernel(AccessorWO<VAL, DIM> out,
   assert((input_pitch * sizeof(VAL)) == smem_size);
   if (halved) {
     if (tile_pitch < 512)
-      convolution_small_tile1<VAL, DIM>
-        <<<blocks, tile_pitch, smem_size>>>(out, filter, in, root_rect, subrect, filter_rect, args);
+      convolution_small_tile1<VAL, DIM><<<blocks, tile_pitch, smem_size, stream>>>(
+        out, filter, in, root_rect, subrect, filter_rect, args);
     else
-      convolution_small_tile1<VAL, DIM>
-        <<<blocks, 512, smem_size>>>(out, filter, in, root_rect, subrect, filter_rect, args);
+      convolution_small_tile1<VAL, DIM><<<blocks, 512, smem_size, stream>>>(
+        out, filter, in, root_rect, subrect, filter_rect, args);
   } else {
     if (tile_pitch < 1024)
-      convolution_small_tile2<VAL, DIM>
-        <<<blocks, tile_pitch, smem_size>>>(out, filter, in, root_rect, subrect, filter_rect, args);
+      convolution_small_tile2<VAL, DIM><<<blocks, tile_pitch, smem_size, stream>>>(
+        out, filter, in, root_rect, subrect, filter_rect, args);
     else
-      convolution_small_tile2<VAL, DIM>
-        <<<blocks, 1024, smem_size>>>(out, filter, in, root_rect, subrect, filter_rect, args);
+      convolution_small_tile2<VAL, DIM><<<blocks, 1024, smem_size, stream>>>(
+        out, filter, in, root_rect, subrect, filter_rect, args);
   }
 }
 
@@ -684,6 +704,8 @@ struct ConvolveImplBody<VariantKind::GPU, CODE, DIM> {
                            const Rect<DIM>& subrect,
                            const Rect<DIM>& filter_rect) const
   {
+    auto stream = get_cached_stream();
+
     constexpr int THREADVALS = THREAD_OUTPUTS(VAL);
     // Get the maximum amount of shared memory per threadblock
     int device;
@@ -776,7 +798,7 @@ struct ConvolveImplBody<VariantKind::GPU, CODE, DIM> {
       }
       if (out_dense) {
         size_t bytes = sizeof(VAL) * out_pitch;
-        CHECK_CUDA(cudaMemsetAsync(out_ptr, 0, bytes));
+        CHECK_CUDA(cudaMemsetAsync(out_ptr, 0, bytes, stream));
       } else {
         out_pitch = 1;
         ConvolutionInitArgs<DIM> args;
@@ -785,7 +807,8 @@ struct ConvolveImplBody<VariantKind::GPU, CODE, DIM> {
           out_pitch *= (subrect.hi[d] - subrect.lo[d] + 1);
         }
         size_t blocks = (out_pitch + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
-        convolution_init<VAL, DIM><<<blocks, THREADS_PER_BLOCK>>>(out, subrect.lo, args, out_pitch);
+        convolution_init<VAL, DIM><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+          out, subrect.lo, args, out_pitch);
       }
       // Figure out the shape of the L1 output tile based on the number of
       // points that we can fit into registers
@@ -1022,18 +1045,18 @@ struct ConvolveImplBody<VariantKind::GPU, CODE, DIM> {
           const Point<DIM> l2_input_stop = subrect.lo + l2_output_tile - one + Point<DIM>(extents) -
                                            l2_filter_rect.lo - one - Point<DIM>(centers);
           convolution_large_tile<VAL, DIM, THREADVALS>
-            <<<properties.multiProcessorCount, CONVOLUTION_THREADS, dynamic_smem>>>(out,
-                                                                                    filter,
-                                                                                    in,
-                                                                                    root_rect,
-                                                                                    subrect,
-                                                                                    l2_filter_rect,
-                                                                                    l2_input_start,
-                                                                                    l2_input_stop,
-                                                                                    l1_input_start,
-                                                                                    zero,
-                                                                                    one,
-                                                                                    args);
+            <<<properties.multiProcessorCount, CONVOLUTION_THREADS, dynamic_smem, stream>>>(out,
+                                                                                            filter,
+                                                                                            in,
+                                                                                            root_rect,
+                                                                                            subrect,
+                                                                                            l2_filter_rect,
+                                                                                            l2_input_start,
+                                                                                            l2_input_stop,
+                                                                                            l1_input_start,
+                                                                                            zero,
+                                                                                            one,
+                                                                                            args);
           // Step to the next filter
           for (int d = DIM - 1; d >= 0; d--) {
             l2_filter_lo[d] += l2_filter_tile[d];
@@ -1051,18 +1074,18 @@ struct ConvolveImplBody<VariantKind::GPU, CODE, DIM> {
         const Point<DIM> l2_input_stop  = subrect.lo + l2_output_tile - one + Point<DIM>(extents) -
                                          filter_rect.lo - one - Point<DIM>(centers);
         convolution_large_tile<VAL, DIM, THREADVALS>
-          <<<properties.multiProcessorCount, CONVOLUTION_THREADS, dynamic_smem>>>(out,
-                                                                                  filter,
-                                                                                  in,
-                                                                                  root_rect,
-                                                                                  subrect,
-                                                                                  filter_rect,
-                                                                                  l2_input_start,
-                                                                                  l2_input_stop,
-                                                                                  l1_input_start,
-                                                                                  zero,
-                                                                                  one,
-                                                                                  args);
+          <<<properties.multiProcessorCount, CONVOLUTION_THREADS, dynamic_smem, stream>>>(out,
+                                                                                          filter,
+                                                                                          in,
+                                                                                          root_rect,
+                                                                                          subrect,
+                                                                                          filter_rect,
+                                                                                          l2_input_start,
+                                                                                          l2_input_stop,
+                                                                                          l1_input_start,
+                                                                                          zero,
+                                                                                          one,
+                                                                                          args);
       }
     }
   }
@@ -1122,161 +1145,296 @@ __global__ static void __launch_bounds__(THREADS_PER_BLOCK, 4)
   accessor[accessor_lo + point] = scaling * buffer[buffer_offset];
 }
 
+template <int DIM>
+struct SeparablePassArgs {
+  // The output of the pass
+  CopyPitches<DIM> pitches;
+  Point<DIM> lo;
+  // The dense input of the pass
+  FFTPitches<DIM> strides;
+  Point<DIM> src_lo;
+  coord_t src_hi;
+  // The dimension that the pass convolves and its factor
+  int dim;
+  coord_t extent;
+  coord_t shift;
+};
+
+template <typename VAL, int DIM, bool LAST>
+__global__ static void __launch_bounds__(THREADS_PER_BLOCK, 4)
+  separable_pass(const VAL* src,
+                 VAL* dst,
+                 const AccessorWO<VAL, DIM> out,
+                 const VAL* factor,
+                 const SeparablePassArgs<DIM> args,
+                 const size_t volume)
+{
+  const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx >= volume) return;
+  size_t offset = idx;
+  Point<DIM> point;
+  for (int d = 0; d < DIM; d++) point[d] = args.lo[d] + args.pitches[d].divmod(offset, offset);
+  size_t base = 0;
+  for (int d = 0; d < DIM; d++)
+    if (d != args.dim) base += (point[d] - args.src_lo[d]) * args.strides[d];
+  // Point k of the factor applies to the input at point + shift - k
+  const coord_t first  = point[args.dim] + args.shift;
+  const coord_t lo     = max(coord_t(0), first - args.src_hi);
+  const coord_t hi     = min(args.extent - 1, first - args.src_lo[args.dim]);
+  const coord_t stride = args.strides[args.dim];
+  const VAL* src_first = src + base + (first - args.src_lo[args.dim]) * stride;
+  VAL acc{0};
+  for (coord_t k = lo; k <= hi; k++) acc += src_first[-k * stride] * factor[k];
+  if (LAST)
+    out[point] = acc;
+  else
+    dst[idx] = acc;
+}
+
 template <typename VAL>
 __global__ static void __launch_bounds__(THREADS_PER_BLOCK, 4)
-  complex_multiply(complex<VAL>* inout, complex<VAL>* in, const size_t volume)
+  complex_multiply(complex<VAL>* inout,
+                   complex<VAL>* in,
+                   const size_t volume,
+                   const FastDivmodU64 period)
 {
   size_t offset = blockIdx.x * blockDim.x + threadIdx.x;
   if (offset >= volume) return;
-  inout[offset] *= in[offset];
+  // The filter transform repeats every period elements of a batch of signal transforms
+  uint64_t remainder;
+  period.divmod(remainder, offset);
+  inout[offset] *= in[remainder];
 }
 
-template <typename VAL, int DIM>
-__host__ static inline size_t create_forward_plan(cufftHandle plan, const Point<DIM>& size)
-{
-  // should always call specialized templates
-  assert(false);
-  return 0;
-}
+// The transforms that take the signal and filter to the frequency domain and the result
+// back. Real values go through real-to-complex transforms, whose outputs need room for
+// PADDING more values along the last dimension, and complex values through
+// complex-to-complex ones.
+template <typename VAL>
+struct CuFFTConvolutionTypes;
 
 template <>
-__host__ inline size_t create_forward_plan<float, 1>(cufftHandle plan, const Point<1>& size)
-{
-  size_t workarea = 0;
-  CHECK_CUFFT(cufftMakePlan1d(plan, size[0], CUFFT_R2C, 1 /*batch*/, &workarea));
-  return workarea;
-}
+struct CuFFTConvolutionTypes<float> {
+  using REAL                          = float;
+  static constexpr cufftType FORWARD  = CUFFT_R2C;
+  static constexpr cufftType BACKWARD = CUFFT_C2R;
+  static constexpr int PADDING        = 2;
+};
 
 template <>
-__host__ inline size_t create_forward_plan<double, 1>(cufftHandle plan, const Point<1>& size)
-{
-  size_t workarea = 0;
-  CHECK_CUFFT(cufftMakePlan1d(plan, size[0], CUFFT_D2Z, 1 /*batch*/, &workarea));
-  return workarea;
-}
+struct CuFFTConvolutionTypes<double> {
+  using REAL                          = double;
+  static constexpr cufftType FORWARD  = CUFFT_D2Z;
+  static constexpr cufftType BACKWARD = CUFFT_Z2D;
+  static constexpr int PADDING        = 2;
+};
 
 template <>
-__host__ inline size_t create_forward_plan<float, 2>(cufftHandle plan, const Point<2>& size)
-{
-  size_t workarea = 0;
-  CHECK_CUFFT(cufftMakePlan2d(plan, size[0], size[1], CUFFT_R2C, &workarea));
-  return workarea;
-}
+struct CuFFTConvolutionTypes<complex<float>> {
+  using REAL                          = float;
+  static constexpr cufftType FORWARD  = CUFFT_C2C;
+  static constexpr cufftType BACKWARD = CUFFT_C2C;
+  static constexpr int PADDING        = 0;
+};
 
 template <>
-__host__ inline size_t create_forward_plan<double, 2>(cufftHandle plan, const Point<2>& size)
-{
-  size_t workarea = 0;
-  CHECK_CUFFT(cufftMakePlan2d(plan, size[0], size[1], CUFFT_D2Z, &workarea));
-  return workarea;
-}
+struct CuFFTConvolutionTypes<complex<double>> {
+  using REAL                          = double;
+  static constexpr cufftType FORWARD  = CUFFT_Z2Z;
+  static constexpr cufftType BACKWARD = CUFFT_Z2Z;
+  static constexpr int PADDING        = 0;
+};
 
-template <>
-__host__ inline size_t create_forward_plan<float, 3>(cufftHandle plan, const Point<3>& size)
+template <typename VAL>
+__host__ static inline void cufft_execute_forward(cufftHandle plan, VAL* idata, VAL* odata)
 {
-  size_t workarea = 0;
-  CHECK_CUFFT(cufftMakePlan3d(plan, size[0], size[1], size[2], CUFFT_R2C, &workarea));
-  return workarea;
+  assert(false);  // should never be called
 }
 
 template <>
-__host__ inline size_t create_forward_plan<double, 3>(cufftHandle plan, const Point<3>& size)
-{
-  size_t workarea = 0;
-  CHECK_CUFFT(cufftMakePlan3d(plan, size[0], size[1], size[2], CUFFT_D2Z, &workarea));
-  return workarea;
-}
-
-template <typename VAL, int DIM>
-__host__ static inline size_t create_backward_plan(cufftHandle plan, const Point<DIM>& size)
+__host__ inline void cufft_execute_forward<float>(cufftHandle plan, float* idata, float* odata)
 {
-  // should always call specialized templates
-  assert(false);
-  return 0;
+  CHECK_CUFFT(cufftExecR2C(plan, (cufftReal*)idata, (cufftComplex*)odata));
 }
 
 template <>
-__host__ inline size_t create_backward_plan<float, 1>(cufftHandle plan, const Point<1>& size)
+__host__ inline void cufft_execute_forward<double>(cufftHandle plan, double* idata, double* odata)
 {
-  size_t workarea = 0;
-  CHECK_CUFFT(cufftMakePlan1d(plan, size[0], CUFFT_C2R, 1 /*batch*/, &workarea));
-  return workarea;
+  CHECK_CUFFT(cufftExecD2Z(plan, (cufftDoubleReal*)idata, (cufftDoubleComplex*)odata));
 }
 
 template <>
-__host__ inline size_t create_backward_plan<double, 1>(cufftHandle plan, const Point<1>& size)
+__host__ inline void cufft_execute_forward<complex<float>>(cufftHandle plan,
+                                                           complex<float>* idata,
+                                                           complex<float>* odata)
 {
-  size_t workarea = 0;
-  CHECK_CUFFT(cufftMakePlan1d(plan, size[0], CUFFT_Z2D, 1 /*batch*/, &workarea));
-  return workarea;
+  CHECK_CUFFT(cufftExecC2C(plan, (cufftComplex*)idata, (cufftComplex*)odata, CUFFT_FORWARD));
 }
 
 template <>
-__host__ inline size_t create_backward_plan<float, 2>(cufftHandle plan, const Point<2>& size)
+__host__ inline void cufft_execute_forward<complex<double>>(cufftHandle plan,
+                                                            complex<double>* idata,
+                                                            complex<double>* odata)
 {
-  size_t workarea = 0;
-  CHECK_CUFFT(cufftMakePlan2d(plan, size[0], size[1], CUFFT_C2R, &workarea));
-  return workarea;
+  CHECK_CUFFT(
+    cufftExecZ2Z(plan, (cufftDoubleComplex*)idata, (cufftDoubleComplex*)odata, CUFFT_FORWARD));
 }
 
-template <>
-__host__ inline size_t create_backward_plan<double, 2>(cufftHandle plan, const Point<2>& size)
+template <typename VAL>
+__host__ static inline void cufft_execute_backward(cufftHandle plan, VAL* idata, VAL* odata)
 {
-  size_t workarea = 0;
-  CHECK_CUFFT(cufftMakePlan2d(plan, size[0], size[1], CUFFT_Z2D, &workarea));
-  return workarea;
+  assert(false);  // should never be called
 }
 
 template <>
-__host__ inline size_t create_backward_plan<float, 3>(cufftHandle plan, const Point<3>& size)
+__host__ inline void cufft_execute_backward<float>(cufftHandle plan, float* idata, float* odata)
 {
-  size_t workarea = 0;
-  CHECK_CUFFT(cufftMakePlan3d(plan, size[0], size[1], size[2], CUFFT_C2R, &workarea));
-  return workarea;
+  CHECK_CUFFT(cufftExecC2R(plan, (cufftComplex*)idata, (cufftReal*)odata));
 }
 
 template <>
-__host__ inline size_t create_backward_plan<double, 3>(cufftHandle plan, const Point<3>& size)
-{
-  size_t workarea = 0;
-  CHECK_CUFFT(cufftMakePlan3d(plan, size[0], size[1], size[2], CUFFT_Z2D, &workarea));
-  return workarea;
-}
-
-template <typename VAL>
-__host__ static inline void cufft_execute_forward(cufftHandle plan, VAL* idata, VAL* odata)
+__host__ inline void cufft_execute_backward<double>(cufftHandle plan, double* idata, double* odata)
 {
-  assert(false);  // should never be called
+  CHECK_CUFFT(cufftExecZ2D(plan, (cufftDoubleComplex*)idata, (cufftDoubleReal*)odata));
 }
 
 template <>
-__host__ inline void cufft_execute_forward<float>(cufftHandle plan, float* idata, float* odata)
+__host__ inline void cufft_execute_backward<complex<float>>(cufftHandle plan,
+                                                            complex<float>* idata,
+                                                            complex<float>* odata)
 {
-  CHECK_CUFFT(cufftExecR2C(plan, (cufftReal*)idata, (cufftComplex*)odata));
+  CHECK_CUFFT(cufftExecC2C(plan, (cufftComplex*)idata, (cufftComplex*)odata, CUFFT_INVERSE));
 }
 
 template <>
-__host__ inline void cufft_execute_forward<double>(cufftHandle plan, double* idata, double* odata)
+__host__ inline void cufft_execute_backward<complex<double>>(cufftHandle plan,
+                                                             complex<double>* idata,
+                                                             complex<double>* odata)
 {
-  CHECK_CUFFT(cufftExecD2Z(plan, (cufftDoubleReal*)idata, (cufftDoubleComplex*)odata));
+  CHECK_CUFFT(
+    cufftExecZ2Z(plan, (cufftDoubleComplex*)idata, (cufftDoubleComplex*)odata, CUFFT_INVERSE));
 }
 
-template <typename VAL>
-__host__ static inline void cufft_execute_backward(cufftHandle plan, VAL* idata, VAL* odata)
+// Convolves a subrect with a separable filter in one pass per dimension, each of which
+// goes through a dense buffer of the bounds of its output
+template <typename VAL, int DIM>
+__host__ static void separable_convolution(AccessorWO<VAL, DIM> out,
+                                           AccessorRO<VAL, DIM> in,
+                                           const Rect<DIM>& root_rect,
+                                           const Rect<DIM>& subrect,
+                                           const SeparableFilter<VAL, DIM>& filter,
+                                           cudaStream_t stream)
 {
-  assert(false);  // should never be called
+  const Point<DIM> zero       = Point<DIM>::ZEROES();
+  const Point<DIM> one        = Point<DIM>::ONES();
+  auto src_rect               = filter.input_bounds(root_rect, subrect);
+  const Point<DIM> src_bounds = src_rect.hi - src_rect.lo + one;
+  DeferredBuffer<VAL, DIM> input_buffer(
+    Rect<DIM>(zero, src_bounds - one), Memory::GPU_FB_MEM, nullptr /*initial*/, 128 /*alignment*/);
+  record_temporary(Rect<DIM>(zero, src_bounds - one).volume() * sizeof(VAL));
+  CopyPitches<DIM> copy_pitches;
+  size_t pitch = 1;
+  for (int d = DIM - 1; d >= 0; d--) {
+    copy_pitches[d] = FastDivmodU64(pitch);
+    pitch *= src_bounds[d];
+  }
+  size_t blocks = (pitch + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+  copy_into_buffer<VAL, DIM><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+    in, input_buffer, src_rect.lo, copy_pitches, pitch);
+  const VAL* src = input_buffer.ptr(zero);
+  std::unique_ptr<ScratchBuffer<VAL>> src_buffer;
+
+  for (int dim = 0; dim < DIM; dim++) {
+    const auto dst_rect = SeparableFilter<VAL, DIM>::pass_bounds(src_rect, subrect, dim);
+    SeparablePassArgs<DIM> args;
+    size_t volume = 1;
+    size_t stride = 1;
+    for (int d = DIM - 1; d >= 0; d--) {
+      args.pitches[d] = FastDivmodU64(volume);
+      volume *= dst_rect.hi[d] - dst_rect.lo[d] + 1;
+      args.strides[d] = stride;
+      stride *= src_rect.hi[d] - src_rect.lo[d] + 1;
+    }
+    args.lo     = dst_rect.lo;
+    args.src_lo = src_rect.lo;
+    args.src_hi = src_rect.hi[dim];
+    args.dim    = dim;
+    args.extent = filter.extent(dim);
+    args.shift  = filter.extent(dim) - 1 - filter.center(dim);
+
+    ScratchBuffer<VAL> factor(args.extent);
+    CHECK_CUDA(cudaMemcpyAsync(factor.ptr(0),
+                               filter.factor(dim),
+                               args.extent * sizeof(VAL),
+                               cudaMemcpyHostToDevice,
+                               stream));
+    blocks = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+    if (dim == DIM - 1) {
+      separable_pass<VAL, DIM, true><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+        src, nullptr, out, factor.ptr(0), args, volume);
+    } else {
+      // The previous pass is done with its input once this one is issued
+      auto dst = std::make_unique<ScratchBuffer<VAL>>(volume);
+      separable_pass<VAL, DIM, false><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+        src, dst->ptr(0), out, factor.ptr(0), args, volume);
+      src        = dst->ptr(0);
+      src_rect   = dst_rect;
+      src_buffer = std::move(dst);
+    }
+  }
 }
 
-template <>
-__host__ inline void cufft_execute_backward<float>(cufftHandle plan, float* idata, float* odata)
+// Reads a filter back into a dense row-major vector on the host
+template <typename VAL, int DIM>
+__host__ static std::vector<VAL> read_filter(AccessorRO<VAL, DIM> filter,
+                                             const Rect<DIM>& filter_rect,
+                                             cudaStream_t stream)
 {
-  CHECK_CUFFT(cufftExecC2R(plan, (cufftComplex*)idata, (cufftReal*)odata));
+  const Point<DIM> zero          = Point<DIM>::ZEROES();
+  const Point<DIM> filter_bounds = filter_rect.hi - filter_rect.lo + Point<DIM>::ONES();
+  DeferredBuffer<VAL, DIM> filter_buffer(Rect<DIM>(zero, filter_bounds - Point<DIM>::ONES()),
+                                         Memory::GPU_FB_MEM,
+                                         nullptr /*initial*/,
+                                         128 /*alignment*/);
+  record_temporary(Rect<DIM>(zero, filter_bounds - Point<DIM>::ONES()).volume() * sizeof(VAL));
+  CopyPitches<DIM> copy_pitches;
+  size_t pitch = 1;
+  for (int d = DIM - 1; d >= 0; d--) {
+    copy_pitches[d] = FastDivmodU64(pitch);
+    pitch *= filter_bounds[d];
+  }
+  const size_t blocks = (pitch + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+  copy_into_buffer<VAL, DIM><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+    filter, filter_buffer, filter_rect.lo, copy_pitches, pitch);
+  std::vector<VAL> values(pitch);
+  CHECK_CUDA(cudaMemcpyAsync(
+    values.data(), filter_buffer.ptr(zero), pitch * sizeof(VAL), cudaMemcpyDeviceToHost, stream));
+  CHECK_CUDA(cudaStreamSynchronize(stream));
+  return values;
 }
 
-template <>
-__host__ inline void cufft_execute_backward<double>(cufftHandle plan, double* idata, double* odata)
+// The key of the cached transform of a filter, which depends on its values as well as
+// the shape and type of the transforms
+template <typename VAL, int DIM>
+__host__ static std::vector<char> filter_spectrum_key(const std::vector<VAL>& values,
+                                                      const Point<DIM>& filter_bounds,
+                                                      const Point<DIM>& kernelsize,
+                                                      int batch_dims)
 {
-  CHECK_CUFFT(cufftExecZ2D(plan, (cufftDoubleComplex*)idata, (cufftDoubleReal*)odata));
+  std::vector<char> key;
+  auto append = [&](const void* data, size_t size) {
+    const char* bytes = static_cast<const char*>(data);
+    key.insert(key.end(), bytes, bytes + size);
+  };
+  const cufftType type = CuFFTConvolutionTypes<VAL>::FORWARD;
+  append(&type, sizeof(type));
+  append(&batch_dims, sizeof(batch_dims));
+  for (int d = 0; d < DIM; d++) {
+    const coord_t extents[2] = {filter_bounds[d], kernelsize[d]};
+    append(extents, sizeof(extents));
+  }
+  append(values.data(), values.size() * sizeof(VAL));
+  return key;
 }
 
 template <typename VAL, int DIM>
@@ -1353,28 +1511,33 @@ __host__ static inline void cufft_convolution(AccessorWO<VAL, DIM> out,
                                        smem_size,
                                        max_smem_size);
   } else {
-    // cufft plans are awful things that call cudaMalloc/cudaFree which
-    // completely destroys asynchronous execution so we need to cache
-    // these plans to avoid calling it as often as possible
-    constexpr size_t MAX_PLANS = 4;
-    struct cufftPlan {
-     public:
-      cufftPlan(void) : fftshape(Point<DIM>::ZEROES()) {}
-
-     public:
-      cufftHandle forward;
-      cufftHandle backward;
-      Point<DIM> fftshape;
-      size_t workarea_size;
-      unsigned lru_index;
-    };
-    static cufftPlan cufft_plan_cache[LEGION_MAX_NUM_PROCS][MAX_PLANS];
+    auto stream = get_cached_stream();
+    // Separable real filters are the cheapest to apply one dimension at a time. Telling them
+    // apart takes a look at the filter on the host, which is only worth the
+    // synchronization for filters too large to go through shared memory.
+    // Repeated convolutions with the same filter can reuse its transform when the GPU
+    // keeps buffers across tasks, which also takes the filter values for the key
+    std::vector<VAL> filter_values;
+    if constexpr (DIM > 1 && std::is_floating_point<VAL>::value) {
+      const Point<DIM> filter_bounds = filter_rect.hi - filter_rect.lo + Point<DIM>::ONES();
+      // Filters that only spread along one dimension gain nothing from being factored
+      int spread_dims = 0;
+      for (int d = 0; d < DIM; d++)
+        if (filter_bounds[d] > 1) spread_dims++;
+      if (spread_dims > 1) {
+        filter_values = read_filter(filter, filter_rect, stream);
+        const SeparableFilter<VAL, DIM> separable(filter_values.data(), filter_bounds);
+        if (separable.separable()) {
+          separable_convolution<VAL, DIM>(out, in, root_rect, subrect, separable, stream);
+          return;
+        }
+      }
+    }
     // Instead of doing the large tile case, we can instead do this
     // by transforming both the input and the filter to the frequency
     // domain using an FFT, perform the convolution with a point-wise
     // multiplication, and then transform the result back to the spatial domain
-    cudaStream_t stream;
-    CHECK_CUDA(cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking));
+
     // First compute how big our temporary allocation needs to be
     // We'll need two of them to store the zero-padded data for the inputs
     const Point<DIM> zero = Point<DIM>::ZEROES();
@@ -1387,17 +1550,27 @@ __host__ static inline void cufft_convolution(AccessorWO<VAL, DIM> out,
     Rect<DIM> input_bounds         = root_rect.intersection(offset_bounds);
     const Point<DIM> signal_bounds = input_bounds.hi - input_bounds.lo + one;
     const Point<DIM> filter_bounds = filter_rect.hi - filter_rect.lo + one;
-    Point<DIM> fftsize             = signal_bounds + filter_bounds;
+    // Leading dimensions along which the filter has a single point hold independent
+    // signals, which go through one batched transform over the remaining dimensions
+    int batch_dims = 0;
+    while ((batch_dims < (DIM - 1)) && (filter_bounds[batch_dims] == 1)) batch_dims++;
+    Point<DIM> fftsize = signal_bounds + filter_bounds;
     for (int d = 0; d < DIM; d++) {
+      if (d < batch_dims) {
+        fftsize[d] = signal_bounds[d];
+        continue;
+      }
       // Technically we can shrink this by one and still be sound but we'll
       // only do that if it will make the number even
       if ((fftsize[d] % 2) == 1) fftsize[d]--;
     }
     // Cufft needs the last dimension to have fftsize/2+1 complex elements for
-    // the temporary buffer
+    // the temporary buffer of real transforms
     // Since we know fftsize is even, we just need to add two to it for the output
+    using Types           = CuFFTConvolutionTypes<VAL>;
+    using REAL            = typename Types::REAL;
     Point<DIM> buffersize = fftsize;
-    buffersize[DIM - 1] += 2;
+    buffersize[DIM - 1] += Types::PADDING;
     size_t buffervolume = 1;
     for (int d = 0; d < DIM; d++) buffervolume *= buffersize[d];
     // Zero pad and copy in the input data
@@ -1405,6 +1578,7 @@ __host__ static inline void cufft_convolution(AccessorWO<VAL, DIM> out,
                                            Memory::GPU_FB_MEM,
                                            nullptr /*initial*/,
                                            128 /*alignment*/);
+    record_temporary(buffervolume * sizeof(VAL));
     VAL* signal_ptr = signal_buffer.ptr(zero);
     CHECK_CUDA(cudaMemsetAsync(signal_ptr, 0, buffervolume * sizeof(VAL), stream));
     // Check to see if the input pointer is dense and we can do this with a CUDA memcpy
@@ -1419,96 +1593,70 @@ __host__ static inline void cufft_convolution(AccessorWO<VAL, DIM> out,
     size_t blocks = (pitch + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
     copy_into_buffer<VAL, DIM><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
       in, signal_buffer, input_bounds.lo, copy_pitches, pitch);
-    // Zero pad and copy in the filter data
+    // The filter is the same for every batch entry, so it is only transformed once
+    Point<DIM> kernelsize = fftsize;
+    size_t kernelvolume   = buffervolume;
+    for (int d = 0; d < batch_dims; d++) {
+      kernelsize[d] = 1;
+      kernelvolume /= buffersize[d];
+    }
+    VAL* spectrum_ptr = nullptr;
+    bool filled       = false;
+    if (use_cached_buffers()) {
+      if (filter_values.empty()) filter_values = read_filter(filter, filter_rect, stream);
+      const auto key = filter_spectrum_key(filter_values, filter_bounds, kernelsize, batch_dims);
+      spectrum_ptr =
+        static_cast<VAL*>(get_cached_buffer(key, kernelvolume * sizeof(VAL), filled));
+    }
+    // The filter buffer also takes the output of the inverse transform
     DeferredBuffer<VAL, DIM> filter_buffer(Rect<DIM>(zero, buffersize - one),
                                            Memory::GPU_FB_MEM,
                                            nullptr /*initial*/,
                                            128 /*alignment*/);
+    record_temporary(buffervolume * sizeof(VAL));
     VAL* filter_ptr = filter_buffer.ptr(zero);
-    CHECK_CUDA(cudaMemsetAsync(filter_ptr, 0, buffervolume * sizeof(VAL), stream));
-    const VAL* filt_ptr = filter.ptr(filter_rect, strides);
-    pitch               = 1;
-    for (int d = DIM - 1; d >= 0; d--) {
-      copy_pitches[d] = FastDivmodU64(pitch);
-      pitch *= filter_bounds[d];
-    }
-    blocks = (pitch + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
-    copy_into_buffer<VAL, DIM><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
-      filter, filter_buffer, filter_rect.lo, copy_pitches, pitch);
-    // Check to see if the plan is already in the cache
-    int plan_index = -1;
-    // Some hackiness until Legion can support stateless runtime caches
-    const unsigned proc_idx = Processor::get_executing_processor().id & (LEGION_MAX_NUM_PROCS - 1);
-    for (unsigned idx = 0; idx < MAX_PLANS; idx++) {
-      if (fftsize != cufft_plan_cache[proc_idx][idx].fftshape) continue;
-      plan_index = idx;
-      break;
-    }
-    if (plan_index < 0) {
-      // If we didn't find it, then we'll need to allocate an index for it,
-      // see if there are any unused ones, otherwise fine the one that was
-      // least recently-used
-      for (unsigned idx = 0; idx < MAX_PLANS; idx++) {
-        if (zero == cufft_plan_cache[proc_idx][idx].fftshape) {
-          // Previously uninitialized plan so we can use it
-          plan_index = idx;
-          // Set the lru_index
-          cufft_plan_cache[proc_idx][idx].lru_index = idx;
-          break;
-        } else if (cufft_plan_cache[proc_idx][idx].lru_index == (MAX_PLANS - 1)) {
-          // Destroy the resources associated with the previous plan
-          cufftPlan& plan = cufft_plan_cache[proc_idx][idx];
-          CHECK_CUFFT(cufftDestroy(plan.forward));
-          CHECK_CUFFT(cufftDestroy(plan.backward));
-          plan_index = idx;
-          break;
-        }
+    // Plans are cached per GPU, as creating them calls cudaMalloc and cudaFree, which
+    // completely destroys asynchronous execution
+    const CuFFTPlanParams signal_params(Types::FORWARD, fftsize, batch_dims);
+    const CuFFTPlanParams kernel_params(Types::FORWARD, kernelsize, batch_dims);
+    const CuFFTPlanParams backward_params(Types::BACKWARD, fftsize, batch_dims);
+    // FFT the input data
+    cufft_execute_forward<VAL>(get_cufft_plan(signal_params), signal_ptr, signal_ptr);
+    if (!filled) {
+      // Zero pad and copy in the filter data
+      CHECK_CUDA(cudaMemsetAsync(filter_ptr, 0, kernelvolume * sizeof(VAL), stream));
+      pitch = 1;
+      for (int d = DIM - 1; d >= 0; d--) {
+        copy_pitches[d] = FastDivmodU64(pitch);
+        pitch *= filter_bounds[d];
+      }
+      blocks = (pitch + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+      copy_into_buffer<VAL, DIM><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+        filter, filter_buffer, filter_rect.lo, copy_pitches, pitch);
+      // FFT the filter data
+      cufft_execute_forward<VAL>(get_cufft_plan(kernel_params), filter_ptr, filter_ptr);
+      if (spectrum_ptr != nullptr) {
+        CHECK_CUDA(cudaMemcpyAsync(spectrum_ptr,
+                                   filter_ptr,
+                                   kernelvolume * sizeof(VAL),
+                                   cudaMemcpyDeviceToDevice,
+                                   stream));
+        fill_cached_buffer(spectrum_ptr);
       }
-      assert(plan_index >= 0);
-      // Create the plans for going in both directions
-      cufftPlan& plan = cufft_plan_cache[proc_idx][plan_index];
-      plan.fftshape   = fftsize;
-      CHECK_CUFFT(cufftCreate(&plan.forward));
-      CHECK_CUFFT(cufftSetAutoAllocation(plan.forward, 0 /*we'll do the allocation*/));
-      CHECK_CUFFT(cufftSetStream(plan.forward, stream));
-      plan.workarea_size = create_forward_plan<VAL, DIM>(plan.forward, fftsize);
-      CHECK_CUFFT(cufftCreate(&plan.backward));
-      CHECK_CUFFT(cufftSetAutoAllocation(plan.backward, 0 /*we'll do the allocation*/));
-      size_t backward_size = create_backward_plan<VAL, DIM>(plan.backward, fftsize);
-      if (plan.workarea_size < backward_size) plan.workarea_size = backward_size;
-    }
-    assert(plan_index >= 0);
-    cufftPlan& plan = cufft_plan_cache[proc_idx][plan_index];
-    // Set the stream and working area for the plans
-    CHECK_CUFFT(cufftSetStream(plan.forward, stream));
-    CHECK_CUFFT(cufftSetStream(plan.backward, stream));
-    // Create the plan and allocate a temporary buffer for it if it needs one
-    DeferredBuffer<uint8_t, 1> workarea_buffer;
-    if (plan.workarea_size > 0) {
-      const Point<1> zero1d(0);
-      workarea_buffer =
-        DeferredBuffer<uint8_t, 1>(Rect<1>(zero1d, Point<1>(plan.workarea_size - 1)),
-                                   Memory::GPU_FB_MEM,
-                                   nullptr /*initial*/,
-                                   128 /*alignment*/);
-      void* workarea = workarea_buffer.ptr(zero1d);
-      CHECK_CUFFT(cufftSetWorkArea(plan.forward, workarea));
-      CHECK_CUFFT(cufftSetWorkArea(plan.backward, workarea));
     }
-    // FFT the input data
-    cufft_execute_forward<VAL>(plan.forward, signal_ptr, signal_ptr);
-    // FFT the filter data
-    cufft_execute_forward<VAL>(plan.forward, filter_ptr, filter_ptr);
+    VAL* kernel_ptr = nullptr == spectrum_ptr ? filter_ptr : spectrum_ptr;
     // Perform the pointwise multiplcation
     {
-      size_t volume = (buffervolume / 2);
+      size_t volume = buffervolume * sizeof(VAL) / sizeof(complex<REAL>);
+      size_t period = kernelvolume * sizeof(VAL) / sizeof(complex<REAL>);
       blocks        = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
-      complex_multiply<VAL><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
-        (complex<VAL>*)signal_ptr, (complex<VAL>*)filter_ptr, volume);
+      complex_multiply<REAL><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+        (complex<REAL>*)signal_ptr, (complex<REAL>*)kernel_ptr, volume, FastDivmodU64(period));
     }
     // Inverse FFT for the ouptut
     // Allow this out-of-place for better performance
-    cufft_execute_backward<VAL>(plan.backward, signal_ptr, filter_ptr);
+    auto backward_plan = get_cufft_plan(backward_params);
+    cufft_execute_backward<VAL>(backward_plan, signal_ptr, filter_ptr);
     // Copy the result data out of the temporary buffer and scale
     // because CUFFT inverse does not perform the scale for us
     pitch = 1;
@@ -1517,7 +1665,10 @@ __host__ static inline void cufft_convolution(AccessorWO<VAL, DIM> out,
       fft_pitches[d] = pitch;
       pitch *= fftsize[d];
     }
-    const VAL scaling_factor = VAL(1) / pitch;
+    // Only the transformed dimensions count towards the scale
+    size_t transform_volume = 1;
+    for (int d = batch_dims; d < DIM; d++) transform_volume *= fftsize[d];
+    const VAL scaling_factor = VAL(REAL(1) / transform_volume);
     Point<DIM> buffer_offset;
     for (int d = 0; d < DIM; d++)
       buffer_offset[d] =
@@ -1546,17 +1697,6 @@ __host__ static inline void cufft_convolution(AccessorWO<VAL, DIM> out,
     printf("\n");
     free(buffer);
 #endif
-    // Bump the lru_index of any plans that were less than our lru_index
-    // and then set our lru_index back to zero
-    if (plan.lru_index > 0) {
-      for (unsigned idx = 0; idx < MAX_PLANS; idx++) {
-        cufftPlan& other = cufft_plan_cache[proc_idx][idx];
-        if (other.lru_index < plan.lru_index) other.lru_index++;
-      }
-      plan.lru_index = 0;
-    }
-    // Clean up our resources, DeferredBuffers are cleaned up by Legion
-    CHECK_CUDA(cudaStreamDestroy(stream));
   }
 }
 
@@ -1652,6 +1792,158 @@ struct ConvolveImplBody<VariantKind::GPU, DOUBLE_LT, 3> {
   }
 };
 
+template <>
+struct ConvolveImplBody<VariantKind::GPU, COMPLEX64_LT, 1> {
+  using VAL = legate_type_of<COMPLEX64_LT>;
+
+  __host__ void operator()(AccessorWO<VAL, 1> out,
+                           AccessorRO<VAL, 1> filter,
+                           AccessorRO<VAL, 1> in,
+                           const Rect<1>& root_rect,
+                           const Rect<1>& subrect,
+                           const Rect<1>& filter_rect) const
+  {
+    cufft_convolution<VAL, 1>(out, filter, in, root_rect, subrect, filter_rect);
+  }
+};
+
+template <>
+struct ConvolveImplBody<VariantKind::GPU, COMPLEX64_LT, 2> {
+  using VAL = legate_type_of<COMPLEX64_LT>;
+
+  __host__ void operator()(AccessorWO<VAL, 2> out,
+                           AccessorRO<VAL, 2> filter,
+                           AccessorRO<VAL, 2> in,
+                           const Rect<2>& root_rect,
+                           const Rect<2>& subrect,
+                           const Rect<2>& filter_rect) const
+  {
+    cufft_convolution<VAL, 2>(out, filter, in, root_rect, subrect, filter_rect);
+  }
+};
+
+template <>
+struct ConvolveImplBody<VariantKind::GPU, COMPLEX64_LT, 3> {
+  using VAL = legate_type_of<COMPLEX64_LT>;
+
+  __host__ void operator()(AccessorWO<VAL, 3> out,
+                           AccessorRO<VAL, 3> filter,
+                           AccessorRO<VAL, 3> in,
+                           const Rect<3>& root_rect,
+                           const Rect<3>& subrect,
+                           const Rect<3>& filter_rect) const
+  {
+    cufft_convolution<VAL, 3>(out, filter, in, root_rect, subrect, filter_rect);
+  }
+};
+
+template <>
+struct ConvolveImplBody<VariantKind::GPU, COMPLEX128_LT, 1> {
+  using VAL = legate_type_of<COMPLEX128_LT>;
+
+  __host__ void operator()(AccessorWO<VAL, 1> out,
+                           AccessorRO<VAL, 1> filter,
+                           AccessorRO<VAL, 1> in,
+                           const Rect<1>& root_rect,
+                           const Rect<1>& subrect,
+                           const Rect<1>& filter_rect) const
+  {
+    cufft_convolution<VAL, 1>(out, filter, in, root_rect, subrect, filter_rect);
+  }
+};
+
+template <>
+struct ConvolveImplBody<VariantKind::GPU, COMPLEX128_LT, 2> {
+  using VAL = legate_type_of<COMPLEX128_LT>;
+
+  __host__ void operator()(AccessorWO<VAL, 2> out,
+                           AccessorRO<VAL, 2> filter,
+                           AccessorRO<VAL, 2> in,
+                           const Rect<2>& root_rect,
+                           const Rect<2>& subrect,
+                           const Rect<2>& filter_rect) const
+  {
+    cufft_convolution<VAL, 2>(out, filter, in, root_rect, subrect, filter_rect);
+  }
+};
+
+template <>
+struct ConvolveImplBody<VariantKind::GPU, COMPLEX128_LT, 3> {
+  using VAL = legate_type_of<COMPLEX128_LT>;
+
+  __host__ void operator()(AccessorWO<VAL, 3> out,
+                           AccessorRO<VAL, 3> filter,
+                           AccessorRO<VAL, 3> in,
+                           const Rect<3>& root_rect,
+                           const Rect<3>& subrect,
+                           const Rect<3>& filter_rect) const
+  {
+    cufft_convolution<VAL, 3>(out, filter, in, root_rect, subrect, filter_rect);
+  }
+};
+
+// One thread per output point, as strided and dilated filters share too few input
+// points between neighboring outputs for a shared memory tile to pay off
+template <typename VAL, int DIM>
+__global__ static void __launch_bounds__(THREADS_PER_BLOCK, 4)
+  strided_convolution(const AccessorWO<VAL, DIM> out,
+                      const AccessorRO<VAL, DIM> filter,
+                      const AccessorRO<VAL, DIM> in,
+                      const Rect<DIM> input_rect,
+                      const Point<DIM> output_lo,
+                      const Point<DIM> filter_lo,
+                      const Pitches<DIM - 1> output_pitches,
+                      const Pitches<DIM - 1> filter_pitches,
+                      const size_t output_volume,
+                      const size_t filter_volume,
+                      const StridedConvolution<DIM> strided)
+{
+  using ACC        = typename ConvolutionAccumulator<VAL>::type;
+  const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx >= output_volume) return;
+  const auto output = output_pitches.unflatten(idx, output_lo);
+  ACC acc{0};
+  for (size_t f = 0; f < filter_volume; f++) {
+    const auto filter_point = filter_pitches.unflatten(f, filter_lo);
+    const auto input        = strided.input(output, filter_point);
+    if (input_rect.contains(input))
+      acc = acc + static_cast<ACC>(in[input]) * static_cast<ACC>(filter[filter_point]);
+  }
+  out[output] = static_cast<VAL>(acc);
+}
+
+template <LegateTypeCode CODE, int DIM>
+struct StridedConvolveImplBody<VariantKind::GPU, CODE, DIM> {
+  using VAL = legate_type_of<CODE>;
+
+  __host__ void operator()(AccessorWO<VAL, DIM> out,
+                           AccessorRO<VAL, DIM> filter,
+                           AccessorRO<VAL, DIM> in,
+                           const Rect<DIM>& input_rect,
+                           const Rect<DIM>& subrect,
+                           const Rect<DIM>& filter_rect,
+                           const StridedConvolution<DIM>& strided) const
+  {
+    auto stream = get_cached_stream();
+    Pitches<DIM - 1> output_pitches;
+    const size_t output_volume = output_pitches.flatten(subrect);
+    Pitches<DIM - 1> filter_pitches;
+    const size_t filter_volume = filter_pitches.flatten(filter_rect);
+    const size_t blocks        = (output_volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+    strided_convolution<VAL, DIM><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(out,
+                                                                            filter,
+                                                                            in,
+                                                                            input_rect,
+                                                                            subrect.lo,
+                                                                            filter_rect.lo,
+                                                                            output_pitches,
+                                                                            filter_pitches,
+                                                                            output_volume,
+                                                                            filter_volume,
+                                                                            strided);
+  }
+};
+
 /*static*/ void ConvolveTask::gpu_variant(TaskContext& context)
 {
   convolve_template<VariantKind::GPU>(context);
@@ -17,23 +17,31 @@
 #pragma once
 
 #include "cunumeric/cunumeric.h"
-
-// We'll make some assumptions here about cache size
-// that should hold up against most CPUs out there today
-// Most L1 caches are 32-48KB so we'll go with the lower bound
-#define L1_CACHE_SIZE 32768
-// Most L2 caches are at least 256KB
-#define L2_CACHE_SIZE 262144
-// Most caches have 64B lines
-#define CACHE_LINE_SIZE 64
+#include "cunumeric/cpu_caches.h"
 
 namespace cunumeric {
 
+// The tilers of the CPU variants need cache sizes that are powers of two,
+// so the detected ones are rounded down to the nearest one
+static inline size_t tiling_cache_size(size_t size)
+{
+  if (0 == size) return 0;
+  size_t result = 1;
+  while (2 * result <= size) result *= 2;
+  return result;
+}
+
 struct ConvolveArgs {
   Array out;
   Array filter;
   std::vector<Array> inputs;
   Legion::Domain root_domain;
+  // Output points are stride input points apart and filter points dilation input points
+  // apart. The offset moves output points onto the input when the two are different
+  // slices of the arrays.
+  Legion::DomainPoint stride;
+  Legion::DomainPoint dilation;
+  Legion::DomainPoint offset;
 };
 
 class ConvolveTask : public CuNumericTask<ConvolveTask> {
@@ -0,0 +1,272 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "cunumeric/convolution/convolve_separable.h"
+#include "cunumeric/fft/fft_cpu.h"
+
+#include <cmath>
+
+namespace cunumeric {
+
+// Direct convolution spends a multiply-add per point of the output and the filter, while
+// convolving through the frequency domain spends about this many per point and level of
+// the padded transforms, counting the three transforms and the copies around them
+static constexpr double FFT_CONVOLUTION_COST = 8.0;
+
+template <int DIM>
+static double direct_convolution_cost(const Legion::Rect<DIM>& subrect,
+                                      const Legion::Rect<DIM>& filter_rect)
+{
+  return static_cast<double>(subrect.volume()) * filter_rect.volume();
+}
+
+// The padded shape that the FFT convolution of a subrect transforms, along with the part
+// of the input that it reads. Linear convolutions of the input and filter must not wrap
+// around, so each extent covers both of them, rounded up to the next power of two, which
+// the transforms of fft_cpu.h handle the fastest. Leading dimensions along which the
+// filter has a single point hold independent signals and are not transformed, so the
+// transforms of the filter, which only cover the other dimensions, apply to all of them.
+template <int DIM>
+struct FFTConvolutionShape {
+  FFTConvolutionShape(const Legion::Rect<DIM>& root_rect,
+                      const Legion::Rect<DIM>& subrect,
+                      const Legion::Rect<DIM>& filter_rect)
+  {
+    Legion::Rect<DIM> offset_bounds;
+    for (int d = 0; d < DIM; d++) {
+      extents[d]          = filter_rect.hi[d] - filter_rect.lo[d] + 1;
+      centers[d]          = extents[d] / 2;
+      offset_bounds.lo[d] = subrect.lo[d] - centers[d];
+      offset_bounds.hi[d] = subrect.hi[d] + extents[d] - 1 - centers[d];
+    }
+    input_bounds = root_rect.intersection(offset_bounds);
+    batch_dims   = 0;
+    while (batch_dims < DIM - 1 && extents[batch_dims] == 1) batch_dims++;
+    volume        = 1;
+    kernel_volume = 1;
+    for (int d = 0; d < DIM; d++) {
+      const coord_t needed = input_bounds.hi[d] - input_bounds.lo[d] + extents[d];
+      if (d < batch_dims)
+        size[d] = needed;
+      else {
+        size[d] = 1;
+        while (size[d] < needed) size[d] <<= 1;
+        kernel_volume *= size[d];
+      }
+      volume *= size[d];
+    }
+  }
+
+  // The multiply-adds of the transforms, to weigh against the other algorithms
+  double cost() const
+  {
+    return FFT_CONVOLUTION_COST * volume * std::log2(static_cast<double>(kernel_volume));
+  }
+
+  // The offset of a point of the padded shape in its row-major buffer
+  size_t offset(const Legion::Point<DIM>& point) const
+  {
+    size_t offset = 0;
+    for (int d = 0; d < DIM; d++) offset = offset * size[d] + point[d];
+    return offset;
+  }
+
+  Legion::Point<DIM> extents;
+  Legion::Point<DIM> centers;
+  Legion::Point<DIM> size;
+  Legion::Rect<DIM> input_bounds;
+  // The number of leading dimensions that are not transformed
+  int batch_dims;
+  size_t volume;
+  // The volume of the transforms of the filter, which is also that of each transform of
+  // the input
+  size_t kernel_volume;
+};
+
+// Convolves a subrect by transforming the zero-padded input and filter to the frequency
+// domain, multiplying them point-wise and transforming the product back, which takes
+// O(N log N) time instead of the O(N K) of the direct convolution. This mirrors the cuFFT
+// path of the GPU variant and is shared by the CPU and OpenMP variants.
+template <VariantKind KIND, typename VAL, int DIM>
+static void fft_convolution(const legate::AccessorWO<VAL, DIM>& out,
+                            const legate::AccessorRO<VAL, DIM>& filter,
+                            const legate::AccessorRO<VAL, DIM>& in,
+                            const Legion::Rect<DIM>& subrect,
+                            const Legion::Rect<DIM>& filter_rect,
+                            const FFTConvolutionShape<DIM>& shape)
+{
+  using C    = std::complex<VAL>;
+  using Loop = FFTLoop<KIND, VAL>;
+
+  assert(filter_rect.lo == Legion::Point<DIM>::ZEROES());
+  const Legion::Rect<DIM> fft_rect(Legion::Point<DIM>::ZEROES(),
+                                   shape.size - Legion::Point<DIM>::ONES());
+  Legion::Rect<DIM> kernel_rect = fft_rect;
+  for (int d = 0; d < shape.batch_dims; d++) kernel_rect.hi[d] = 0;
+  auto signal_buffer = create_buffer<C>(shape.volume, Loop::MEMORY);
+  auto filter_buffer = create_buffer<C>(shape.kernel_volume, Loop::MEMORY);
+  auto signal        = signal_buffer.ptr(0);
+  auto kernel        = filter_buffer.ptr(0);
+
+  // Zero pad and copy in the input and filter data
+  Loop{}(shape.volume, 0, [&](size_t idx, C*) { signal[idx] = C(0); });
+  Loop{}(shape.kernel_volume, 0, [&](size_t idx, C*) { kernel[idx] = C(0); });
+  Pitches<DIM - 1> input_pitches;
+  const size_t input_volume = input_pitches.flatten(shape.input_bounds);
+  Loop{}(input_volume, 0, [&](size_t idx, C*) {
+    const auto point = input_pitches.unflatten(idx, shape.input_bounds.lo);
+    signal[shape.offset(point - shape.input_bounds.lo)] = C(in[point], 0);
+  });
+  Pitches<DIM - 1> filter_pitches;
+  const size_t filter_volume = filter_pitches.flatten(filter_rect);
+  Loop{}(filter_volume, 0, [&](size_t idx, C*) {
+    const auto point            = filter_pitches.unflatten(idx, filter_rect.lo);
+    kernel[shape.offset(point)] = C(filter[point], 0);
+  });
+
+  // Multiply the transforms and bring the product back. The batch dimensions are the
+  // outermost ones, so the filter transform repeats every kernel_volume elements.
+  for (int32_t axis = shape.batch_dims; axis < DIM; axis++) {
+    fft_axis<KIND, VAL, DIM>(signal, fft_rect, axis, false /*inverse*/);
+    fft_axis<KIND, VAL, DIM>(kernel, kernel_rect, axis, false /*inverse*/);
+  }
+  Loop{}(shape.volume, 0, [&](size_t idx, C*) {
+    const C a   = signal[idx];
+    const C b   = kernel[idx % shape.kernel_volume];
+    signal[idx] = C(a.real() * b.real() - a.imag() * b.imag(),
+                    a.real() * b.imag() + a.imag() * b.real());
+  });
+  for (int32_t axis = shape.batch_dims; axis < DIM; axis++)
+    fft_axis<KIND, VAL, DIM>(signal, fft_rect, axis, true /*inverse*/);
+
+  // Copy the result out and scale it, as the inverse transforms are not normalized.
+  // Output point o gathers in[o + extents - 1 - centers - f] * filter[f], which is the
+  // point of the linear convolution at o - input_bounds.lo + extents - 1 - centers.
+  const VAL scale = VAL(1) / static_cast<VAL>(shape.kernel_volume);
+  const Legion::Point<DIM> shift =
+    shape.extents - Legion::Point<DIM>::ONES() - shape.centers - shape.input_bounds.lo;
+  Pitches<DIM - 1> output_pitches;
+  const size_t output_volume = output_pitches.flatten(subrect);
+  Loop{}(output_volume, 0, [&](size_t idx, C*) {
+    const auto point = output_pitches.unflatten(idx, subrect.lo);
+    out[point]       = signal[shape.offset(point + shift)].real() * scale;
+  });
+}
+
+// Reads a filter into a dense row-major vector
+template <typename VAL, int DIM>
+static std::vector<VAL> read_filter(const legate::AccessorRO<VAL, DIM>& filter,
+                                    const Legion::Rect<DIM>& filter_rect)
+{
+  Pitches<DIM - 1> pitches;
+  std::vector<VAL> values(pitches.flatten(filter_rect));
+  for (size_t idx = 0; idx < values.size(); idx++)
+    values[idx] = filter[pitches.unflatten(idx, filter_rect.lo)];
+  return values;
+}
+
+// Convolves a subrect with a separable filter in one pass per dimension, each of which
+// goes through a dense buffer of the bounds of its output
+template <VariantKind KIND, typename VAL, int DIM>
+static void separable_convolution(const legate::AccessorWO<VAL, DIM>& out,
+                                  const legate::AccessorRO<VAL, DIM>& in,
+                                  const Legion::Rect<DIM>& root_rect,
+                                  const Legion::Rect<DIM>& subrect,
+                                  const SeparableFilter<VAL, DIM>& filter)
+{
+  using C    = std::complex<VAL>;
+  using Loop = FFTLoop<KIND, VAL>;
+
+  auto src_rect = filter.input_bounds(root_rect, subrect);
+  Pitches<DIM - 1> src_pitches;
+  const size_t src_volume = src_pitches.flatten(src_rect);
+  auto src_buffer         = create_buffer<VAL>(src_volume, Loop::MEMORY);
+  VAL* input              = src_buffer.ptr(0);
+  Loop{}(src_volume, 0, [&](size_t idx, C*) {
+    input[idx] = in[src_pitches.unflatten(idx, src_rect.lo)];
+  });
+  const VAL* src = input;
+
+  for (int32_t dim = 0; dim < DIM; dim++) {
+    size_t strides[DIM];
+    size_t stride = 1;
+    for (int d = DIM - 1; d >= 0; d--) {
+      strides[d] = stride;
+      stride *= src_rect.hi[d] - src_rect.lo[d] + 1;
+    }
+    const auto dst_rect = SeparableFilter<VAL, DIM>::pass_bounds(src_rect, subrect, dim);
+    Pitches<DIM - 1> dst_pitches;
+    const size_t dst_volume = dst_pitches.flatten(dst_rect);
+    const bool last         = dim == DIM - 1;
+    auto dst_buffer         = create_buffer<VAL>(last ? 1 : dst_volume, Loop::MEMORY);
+    VAL* dst                = dst_buffer.ptr(0);
+
+    const VAL* factor    = filter.factor(dim);
+    const coord_t extent = filter.extent(dim);
+    const coord_t shift  = extent - 1 - filter.center(dim);
+    Loop{}(dst_volume, 0, [&](size_t idx, C*) {
+      const auto point = dst_pitches.unflatten(idx, dst_rect.lo);
+      size_t base      = 0;
+      for (int d = 0; d < DIM; d++)
+        if (d != dim) base += (point[d] - src_rect.lo[d]) * strides[d];
+      // Point k of the factor applies to the input at point + shift - k, so only
+      // take the points that fall into the input
+      const coord_t first = point[dim] + shift;
+      const coord_t lo    = std::max<coord_t>(0, first - src_rect.hi[dim]);
+      const coord_t hi    = std::min<coord_t>(extent - 1, first - src_rect.lo[dim]);
+      VAL acc{0};
+      for (coord_t k = lo; k <= hi; k++)
+        acc += src[base + (first - k - src_rect.lo[dim]) * strides[dim]] * factor[k];
+      if (last)
+        out[point] = acc;
+      else
+        dst[idx] = acc;
+    });
+    src      = dst;
+    src_rect = dst_rect;
+  }
+}
+
+// Convolves a subrect with the factors of a separable filter or through the frequency
+// domain, whichever takes the least work, unless the direct loops take less than both.
+// Returns whether it did.
+template <VariantKind KIND, typename VAL, int DIM>
+static bool fast_convolution(const legate::AccessorWO<VAL, DIM>& out,
+                             const legate::AccessorRO<VAL, DIM>& filter,
+                             const legate::AccessorRO<VAL, DIM>& in,
+                             const Legion::Rect<DIM>& root_rect,
+                             const Legion::Rect<DIM>& subrect,
+                             const Legion::Rect<DIM>& filter_rect)
+{
+  const FFTConvolutionShape<DIM> shape(root_rect, subrect, filter_rect);
+  const double direct = direct_convolution_cost(subrect, filter_rect);
+  const double fft    = shape.cost();
+  if (DIM > 1) {
+    const auto values = read_filter(filter, filter_rect);
+    const SeparableFilter<VAL, DIM> separable(values.data(), shape.extents);
+    if (separable.separable() && separable.cost(root_rect, subrect) < std::min(direct, fft)) {
+      separable_convolution<KIND, VAL, DIM>(out, in, root_rect, subrect, separable);
+      return true;
+    }
+  }
+  if (fft >= direct) return false;
+  fft_convolution<KIND, VAL, DIM>(out, filter, in, subrect, filter_rect, shape);
+  return true;
+}
+
+}  // namespace cunumeric
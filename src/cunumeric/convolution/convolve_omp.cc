@@ -17,6 +17,9 @@
 #include "cunumeric/divmod.h"
 #include "cunumeric/convolution/convolve.h"
 #include "cunumeric/convolution/convolve_template.inl"
+#include "cunumeric/convolution/convolve_cpu.h"
+#include "cunumeric/fft/fft_omp.h"
+#include "cunumeric/omp_help.h"
 
 #include <omp.h>
 
@@ -36,24 +39,35 @@ struct ConvolveImplBody<VariantKind::OMP, CODE, DIM> {
                   const Rect<DIM>& subrect,
                   const Rect<DIM>& filter_rect) const
   {
+    // Large filters are cheaper to apply in the frequency domain, like on the GPU, and
+    // separable ones one dimension at a time
+    if constexpr (CODE == FLOAT_LT || CODE == DOUBLE_LT) {
+      if (fast_convolution<VariantKind::OMP, VAL, DIM>(
+            out, filter, in, root_rect, subrect, filter_rect))
+        return;
+    }
+
     const Point<DIM> zero = Point<DIM>::ZEROES();
     const Point<DIM> one  = Point<DIM>::ONES();
     Point<DIM> extents    = filter_rect.hi - filter_rect.lo + one;
     Point<DIM> centers;
     for (int d = 0; d < DIM; d++) centers[d] = extents[d] / 2;
 
+    const auto& caches         = get_cpu_caches();
+    const size_t line_size     = tiling_cache_size(caches.line_size);
+    const size_t l1_cache_size = tiling_cache_size(caches.l1_size);
+    const size_t l2_cache_size = tiling_cache_size(caches.l2_size);
+
     // Compute the tiles for the L2 cache
     Point<DIM> l2_output_tile, l2_filter_tile;
     const Point<DIM> output_bounds = subrect.hi - subrect.lo + one;
     // Try to fit the output in 1/4 of the L2 cache and
     // and the input and filter in the other 3/4
-    compute_output_tile<VAL, DIM>(l2_output_tile,
-                                  output_bounds,
-                                  CACHE_LINE_SIZE / sizeof(VAL),
-                                  L2_CACHE_SIZE / sizeof(VAL) / 4);
+    compute_output_tile<VAL, DIM>(
+      l2_output_tile, output_bounds, line_size / sizeof(VAL), l2_cache_size / sizeof(VAL) / 4);
     const Point<DIM> filter_bounds = filter_rect.hi - filter_rect.lo + one;
     compute_filter_tile<VAL, DIM>(
-      l2_filter_tile, filter_bounds, l2_output_tile, 3 * L2_CACHE_SIZE / 4);
+      l2_filter_tile, filter_bounds, l2_output_tile, 3 * l2_cache_size / 4);
     unsigned total_l2_filters = 1;
     for (int d = 0; d < DIM; d++)
       total_l2_filters *= ((extents[d] + l2_filter_tile[d] - 1) / l2_filter_tile[d]);
@@ -68,12 +82,10 @@ struct ConvolveImplBody<VariantKind::OMP, CODE, DIM> {
     Point<DIM> l1_output_tile, l1_filter_tile;
     // Try to fit the output in the 1/4 of the L1 cache and
     // the filter and input in the other 3/4 of the L1 cache
-    compute_output_tile<VAL, DIM>(l1_output_tile,
-                                  output_bounds,
-                                  CACHE_LINE_SIZE / sizeof(VAL),
-                                  L1_CACHE_SIZE / sizeof(VAL) / 4);
+    compute_output_tile<VAL, DIM>(
+      l1_output_tile, output_bounds, line_size / sizeof(VAL), l1_cache_size / sizeof(VAL) / 4);
     compute_filter_tile<VAL, DIM>(
-      l1_filter_tile, filter_bounds, l1_output_tile, 3 * L1_CACHE_SIZE / 4);
+      l1_filter_tile, filter_bounds, l1_output_tile, 3 * l1_cache_size / 4);
     unsigned total_l1_filters = 1;
     for (int d = 0; d < DIM; d++)
       total_l1_filters *= ((l2_filter_tile[d] + l1_filter_tile[d] - 1) / l1_filter_tile[d]);
@@ -121,9 +133,9 @@ struct ConvolveImplBody<VariantKind::OMP, CODE, DIM> {
           local_l1_filters *=
             ((l2_filter_rect.hi[d] - l2_filter_rect.lo[d] + l1_filter_tile[d]) / l1_filter_tile[d]);
       }
-// Now iterate the tiles for the L2 outputs
-#pragma omp parallel for  // schedule(dynamic) // Turn this on when Realm is fixed
-      for (unsigned l2_outidx = 0; l2_outidx < total_l2_outputs; l2_outidx++) {
+      // Now iterate the tiles for the L2 outputs. The ones on the boundary cover fewer
+      // points, so the threads take them one at a time.
+      parallel_for_dynamic(total_l2_outputs, [&](size_t l2_outidx) {
         Point<DIM> l2_output = subrect.lo;
         size_t offset        = l2_outidx;
         for (int d = 0; d < DIM; d++)
@@ -202,7 +214,7 @@ struct ConvolveImplBody<VariantKind::OMP, CODE, DIM> {
         }
         // No need to step to the next output tile, we're
         // doing that with the divmod above
-      }
+      });
       // Step to the next l2 filter
       for (int d = DIM - 1; d >= 0; d--) {
         l2_filter[d] += l2_filter_tile[d];
@@ -215,6 +227,36 @@ struct ConvolveImplBody<VariantKind::OMP, CODE, DIM> {
   }
 };
 
+template <LegateTypeCode CODE, int DIM>
+struct StridedConvolveImplBody<VariantKind::OMP, CODE, DIM> {
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(AccessorWO<VAL, DIM> out,
+                  AccessorRO<VAL, DIM> filter,
+                  AccessorRO<VAL, DIM> in,
+                  const Rect<DIM>& input_rect,
+                  const Rect<DIM>& subrect,
+                  const Rect<DIM>& filter_rect,
+                  const StridedConvolution<DIM>& strided) const
+  {
+    Pitches<DIM - 1> output_pitches;
+    const size_t output_volume = output_pitches.flatten(subrect);
+    Pitches<DIM - 1> filter_pitches;
+    const size_t filter_volume = filter_pitches.flatten(filter_rect);
+    #pragma omp parallel for schedule(static)
+    for (size_t idx = 0; idx < output_volume; idx++) {
+      const auto output = output_pitches.unflatten(idx, subrect.lo);
+      VAL acc{0};
+      for (size_t f = 0; f < filter_volume; f++) {
+        const auto filter_point = filter_pitches.unflatten(f, filter_rect.lo);
+        const auto input        = strided.input(output, filter_point);
+        if (input_rect.contains(input)) acc += in[input] * filter[filter_point];
+      }
+      out[output] = acc;
+    }
+  }
+};
+
 /*static*/ void ConvolveTask::omp_variant(TaskContext& context)
 {
   convolve_template<VariantKind::OMP>(context);
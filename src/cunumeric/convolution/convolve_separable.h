@@ -0,0 +1,130 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "legion.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace cunumeric {
+
+// The factors of a filter that is the outer product of one vector per dimension, such as
+// most Gaussian blurs, along with the bounds of the passes that convolve with them one
+// dimension at a time. That takes a multiply-add per output and point of each factor,
+// instead of one per point of the whole filter.
+//
+// The passes go over the dimensions in order. The first one reads the part of the input
+// that the subrect depends on, and each pass shrinks the dimension it convolves to the
+// range of the subrect, so the last one produces the subrect itself.
+template <typename VAL, int DIM>
+class SeparableFilter {
+ public:
+  // Factors the dense row-major values of a filter, which the direct convolution loops
+  // apply to the input at an offset of extents - 1 - centers
+  SeparableFilter(const VAL* values, const Legion::Point<DIM>& extents)
+    : extents_(extents), separable_(false)
+  {
+    for (int d = 0; d < DIM; d++) centers_[d] = extents[d] / 2;
+    separable_ = DIM > 1 && factor(values);
+  }
+
+  bool separable() const { return separable_; }
+  const VAL* factor(int dim) const { return factors_[dim].data(); }
+  coord_t extent(int dim) const { return extents_[dim]; }
+  coord_t center(int dim) const { return centers_[dim]; }
+
+  // The part of the input that the convolution of the subrect reads
+  Legion::Rect<DIM> input_bounds(const Legion::Rect<DIM>& root_rect,
+                                 const Legion::Rect<DIM>& subrect) const
+  {
+    Legion::Rect<DIM> offset_bounds;
+    for (int d = 0; d < DIM; d++) {
+      offset_bounds.lo[d] = subrect.lo[d] - centers_[d];
+      offset_bounds.hi[d] = subrect.hi[d] + extents_[d] - 1 - centers_[d];
+    }
+    return root_rect.intersection(offset_bounds);
+  }
+
+  // The bounds of the output of the pass over a dimension
+  static Legion::Rect<DIM> pass_bounds(const Legion::Rect<DIM>& input_bounds,
+                                       const Legion::Rect<DIM>& subrect,
+                                       int dim)
+  {
+    Legion::Rect<DIM> bounds = input_bounds;
+    for (int d = 0; d <= dim; d++) {
+      bounds.lo[d] = subrect.lo[d];
+      bounds.hi[d] = subrect.hi[d];
+    }
+    return bounds;
+  }
+
+  // The multiply-adds of the passes, to weigh against the other algorithms
+  double cost(const Legion::Rect<DIM>& root_rect, const Legion::Rect<DIM>& subrect) const
+  {
+    const auto bounds = input_bounds(root_rect, subrect);
+    double cost       = 0;
+    for (int d = 0; d < DIM; d++)
+      cost += static_cast<double>(pass_bounds(bounds, subrect, d).volume()) * extents_[d];
+    return cost;
+  }
+
+ private:
+  // The factor of a dimension is the line of the filter through its largest value along
+  // that dimension, and all but the first are normalized by that value. The filter is
+  // separable when the products of the factors reproduce every value of it to within a
+  // few rounding errors of the largest one.
+  bool factor(const VAL* values)
+  {
+    size_t pitches[DIM];
+    size_t volume = 1;
+    for (int d = DIM - 1; d >= 0; d--) {
+      pitches[d] = volume;
+      volume *= extents_[d];
+    }
+    size_t pivot = 0;
+    for (size_t idx = 1; idx < volume; idx++)
+      if (std::abs(values[idx]) > std::abs(values[pivot])) pivot = idx;
+    const VAL largest = values[pivot];
+    if (largest == VAL(0)) return false;
+
+    for (int d = 0; d < DIM; d++) {
+      const size_t base = pivot - (pivot / pitches[d] % extents_[d]) * pitches[d];
+      factors_[d].resize(extents_[d]);
+      for (coord_t k = 0; k < extents_[d]; k++) {
+        const VAL value = values[base + k * pitches[d]];
+        factors_[d][k]  = d == 0 ? value : value / largest;
+      }
+    }
+
+    const VAL tolerance = 16 * std::numeric_limits<VAL>::epsilon() * std::abs(largest);
+    for (size_t idx = 0; idx < volume; idx++) {
+      VAL product = 1;
+      for (int d = 0; d < DIM; d++) product *= factors_[d][idx / pitches[d] % extents_[d]];
+      if (std::abs(product - values[idx]) > tolerance) return false;
+    }
+    return true;
+  }
+
+  Legion::Point<DIM> extents_;
+  Legion::Point<DIM> centers_;
+  bool separable_;
+  std::vector<VAL> factors_[DIM];
+};
+
+}  // namespace cunumeric
@@ -25,6 +25,52 @@ using namespace legate;
 template <VariantKind KIND, LegateTypeCode CODE, int DIM>
 struct ConvolveImplBody;
 
+// Maps the points of a strided or dilated convolution onto the input: output point p
+// gathers input point p * stride + shift - f * dilation for every filter point f, where
+// the shift centers the dilated filter the same way as in a plain convolution
+template <int DIM>
+struct StridedConvolution {
+  StridedConvolution(const DomainPoint& stride_,
+                     const DomainPoint& dilation_,
+                     const DomainPoint& offset,
+                     const Rect<DIM>& filter_rect)
+  {
+    for (int d = 0; d < DIM; d++) {
+      stride[d]            = stride_[d];
+      dilation[d]          = dilation_[d];
+      const coord_t extent = (filter_rect.hi[d] - filter_rect.lo[d]) * dilation[d] + 1;
+      shift[d]             = offset[d] + extent - 1 - extent / 2;
+    }
+  }
+
+  __CUDA_HD__
+  inline Point<DIM> input(const Point<DIM>& output, const Point<DIM>& filter) const
+  {
+    Point<DIM> point;
+    for (int d = 0; d < DIM; d++)
+      point[d] = output[d] * stride[d] + shift[d] - filter[d] * dilation[d];
+    return point;
+  }
+
+  Point<DIM> stride;
+  Point<DIM> dilation;
+  Point<DIM> shift;
+};
+
+// Direct convolution of strided and dilated filters, which touch too few input
+// points for the tiled and FFT algorithms to pay off. Input points outside of
+// input_rect are taken as zeros.
+template <VariantKind KIND, LegateTypeCode CODE, int DIM>
+struct StridedConvolveImplBody;
+
+template <int DIM>
+static bool is_strided_convolution(const ConvolveArgs& args)
+{
+  for (int d = 0; d < DIM; d++)
+    if (args.stride[d] != 1 || args.dilation[d] != 1 || args.offset[d] != 0) return true;
+  return false;
+}
+
 template <VariantKind KIND>
 struct ConvolveImpl {
   template <LegateTypeCode CODE, int DIM, std::enable_if_t<(DIM <= 3)>* = nullptr>
@@ -36,7 +82,9 @@ struct ConvolveImpl {
 
     if (subrect.empty()) return;
 
-    auto input_subrect = subrect;
+    // The main tile matches the output tile, except when each task of a strided
+    // convolution gets its own slices of the arrays
+    auto input_subrect = args.inputs[0].shape<DIM>();
     for (auto idx = 1; idx < args.inputs.size(); ++idx) {
       auto image_subrect = args.inputs[idx].shape<DIM>();
       input_subrect      = input_subrect.union_bbox(image_subrect);
@@ -47,6 +95,13 @@ struct ConvolveImpl {
     // This is valid only because we colocate all shifted images with the main tile
     auto input = args.inputs[0].read_accessor<VAL, DIM>(input_subrect);
 
+    if (is_strided_convolution<DIM>(args)) {
+      StridedConvolution<DIM> strided(args.stride, args.dilation, args.offset, filter_rect);
+      StridedConvolveImplBody<KIND, CODE, DIM>()(
+        out, filter, input, input_subrect, subrect, filter_rect, strided);
+      return;
+    }
+
     Rect<DIM> root_rect(args.root_domain);
     ConvolveImplBody<KIND, CODE, DIM>()(out, filter, input, root_rect, subrect, filter_rect);
   }
@@ -76,8 +131,11 @@ static void convolve_template(TaskContext& context)
     args.root_domain.rect_data[dim]             = 0;
     args.root_domain.rect_data[dim + shape.dim] = shape[dim] - 1;
   }
+  args.stride   = context.scalars()[1].value<DomainPoint>();
+  args.dilation = context.scalars()[2].value<DomainPoint>();
+  args.offset   = context.scalars()[3].value<DomainPoint>();
 
-  double_dispatch(args.out.dim(), args.out.code(), ConvolveImpl<KIND>{}, args);
+  cunumeric::double_dispatch(args.out.dim(), args.out.code(), ConvolveImpl<KIND>{}, args);
 }
 
 template <typename VAL, int DIM>
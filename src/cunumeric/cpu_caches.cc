@@ -0,0 +1,130 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/cpu_caches.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <string>
+
+namespace cunumeric {
+
+size_t parse_size(const char* value)
+{
+  char* suffix      = nullptr;
+  const size_t size = strtoull(value, &suffix, 10);
+  switch (*suffix) {
+    case 'k':
+    case 'K': return size << 10;
+    case 'm':
+    case 'M': return size << 20;
+    case 'g':
+    case 'G': return size << 30;
+    default: return size;
+  }
+}
+
+static bool read_line(const std::string& path, char* line, size_t length)
+{
+  FILE* file = fopen(path.c_str(), "r");
+  if (nullptr == file) return false;
+  const bool success = fgets(line, length, file) != nullptr;
+  fclose(file);
+  return success;
+}
+
+// Counts the CPUs of lists like 0-7,64-71
+static size_t count_cpus(const char* list)
+{
+  size_t count = 0;
+  for (char* end = nullptr;; list = end + 1) {
+    const long first = strtol(list, &end, 10);
+    if (end == list) break;
+    long last = first;
+    if ('-' == *end) last = strtol(end + 1, &end, 10);
+    count += last - first + 1;
+    if (*end != ',') break;
+  }
+  return count > 0 ? count : 1;
+}
+
+// Reads the data and unified caches of the first CPU from sysfs
+static void read_sysfs(CPUCaches& caches)
+{
+  char line[256];
+  for (int index = 0;; ++index) {
+    const std::string dir = "/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(index);
+    if (!read_line(dir + "/level", line, sizeof(line))) break;
+    const int level = atoi(line);
+    if (!read_line(dir + "/type", line, sizeof(line)) || strncmp(line, "Instruction", 11) == 0)
+      continue;
+    if (!read_line(dir + "/size", line, sizeof(line))) continue;
+    size_t size = parse_size(line);
+    if (3 == level && read_line(dir + "/shared_cpu_list", line, sizeof(line)))
+      size /= count_cpus(line);
+    if (1 == level) {
+      caches.l1_size = size;
+      if (read_line(dir + "/coherency_line_size", line, sizeof(line)))
+        caches.line_size = parse_size(line);
+    } else if (2 == level)
+      caches.l2_size = size;
+    else if (3 == level)
+      caches.l3_size = size;
+  }
+}
+
+static void read_sysconf(CPUCaches& caches)
+{
+#ifdef _SC_LEVEL1_DCACHE_SIZE
+  auto query = [](int name, size_t& size) {
+    const long value = sysconf(name);
+    if (0 == size && value > 0) size = value;
+  };
+  query(_SC_LEVEL1_DCACHE_SIZE, caches.l1_size);
+  query(_SC_LEVEL1_DCACHE_LINESIZE, caches.line_size);
+  query(_SC_LEVEL2_CACHE_SIZE, caches.l2_size);
+  // sysconf doesn't say how many cores share the last level cache
+#endif
+}
+
+static void apply_override(const char* name, size_t& size)
+{
+  const char* value = getenv(name);
+  if (value != nullptr) size = parse_size(value);
+}
+
+const CPUCaches& get_cpu_caches()
+{
+  static const CPUCaches caches = []() {
+    CPUCaches caches{0, 0, 0, 0};
+    read_sysfs(caches);
+    read_sysconf(caches);
+    if (0 == caches.l1_size) caches.l1_size = 32 << 10;
+    if (0 == caches.l2_size) caches.l2_size = 256 << 10;
+    if (0 == caches.line_size) caches.line_size = 64;
+    apply_override("CUNUMERIC_L1_CACHE_SIZE", caches.l1_size);
+    apply_override("CUNUMERIC_L2_CACHE_SIZE", caches.l2_size);
+    apply_override("CUNUMERIC_L3_CACHE_SIZE", caches.l3_size);
+    apply_override("CUNUMERIC_CACHE_LINE_SIZE", caches.line_size);
+    return caches;
+  }();
+  return caches;
+}
+
+}  // namespace cunumeric
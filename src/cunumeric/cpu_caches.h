@@ -0,0 +1,42 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+namespace cunumeric {
+
+// The data caches of the cores that tasks run on, in bytes. The last level cache is
+// usually shared by a group of cores, so l3_size is the share of a single core.
+struct CPUCaches {
+  size_t l1_size;
+  size_t l2_size;
+  size_t l3_size;
+  size_t line_size;
+};
+
+// Return the caches of this machine, which are read from sysfs, or sysconf where sysfs
+// doesn't have them, the first time this is called. CUNUMERIC_L1_CACHE_SIZE,
+// CUNUMERIC_L2_CACHE_SIZE, CUNUMERIC_L3_CACHE_SIZE and CUNUMERIC_CACHE_LINE_SIZE override
+// them with a number of bytes, optionally followed by K or M. Levels that can be found
+// neither way are assumed to be 32KB, 256KB and absent, with 64B lines.
+const CPUCaches& get_cpu_caches();
+
+// Parses the sizes given in the environment, like 32768, 48K, 32M or 2G
+size_t parse_size(const char* value);
+
+}  // namespace cunumeric
@@ -19,13 +19,17 @@
 #include "legate.h"
 #include <cublas_v2.h>
 #include <cusolverDn.h>
+#include <cusparse.h>
 #include <cuda_runtime.h>
 #include <cufft.h>
 #include <cutensor.h>
 
+#include <vector>
+
 #define THREADS_PER_BLOCK 128
 #define MIN_CTAS_PER_SM 4
 #define MAX_REDUCTION_CTAS 1024
+#define GRID_STRIDE_CTAS_PER_SM 16
 #define COOPERATIVE_THREADS 256
 #define COOPERATIVE_CTAS_PER_SM 4
 
@@ -53,6 +57,12 @@
     check_cusolver(result, __FILE__, __LINE__); \
   } while (false)
 
+#define CHECK_CUSPARSE(expr)                    \
+  do {                                          \
+    cusparseStatus_t result = (expr);           \
+    check_cusparse(result, __FILE__, __LINE__); \
+  } while (false)
+
 #define CHECK_CUTENSOR(expr)                    \
   do {                                          \
     cutensorStatus_t result = (expr);           \
@@ -70,11 +80,171 @@ namespace cunumeric {
 
 // Defined in cudalibs.cu
 
-// Return a cached stream for the current GPU
+// Return the stream that the current task issues its work to. Every GPU keeps a small pool
+// of streams, with their own library handles, and successive tasks take turns on them.
 cudaStream_t get_cached_stream();
 cublasHandle_t get_cublas();
 cusolverDnHandle_t get_cusolver();
+cusparseHandle_t get_cusparse();
 cutensorHandle_t* get_cutensor();
+// Return a device workspace of at least the given number of bytes for cuBLAS, cuSOLVER,
+// cuSPARSE, cuTENSOR and cuFFT calls. The workspace is cached per stream and only grows, so
+// it must only be used by work issued to the stream returned by get_cached_stream.
+void* get_workspace(size_t size);
+
+// Describes a cuFFT plan by the arguments of cufftMakePlanMany64. Plans with empty
+// embeddings use the basic data layout.
+struct CuFFTPlanParams {
+  // Transforms of the given size with the basic data layout, batched over the leading
+  // batch_dims dimensions of the size
+  template <int DIM>
+  CuFFTPlanParams(cufftType type, const Legion::Point<DIM>& size, int batch_dims = 0)
+    : CuFFTPlanParams(type, DIM - batch_dims)
+  {
+    static_assert(DIM <= MAX_RANK, "cuFFT only supports transforms of up to three dimensions");
+    assert(batch_dims < DIM);
+    for (int dim = 0; dim < batch_dims; ++dim) batch *= size[dim];
+    for (int dim = batch_dims; dim < DIM; ++dim) n[dim - batch_dims] = size[dim];
+  }
+  // A batch of one-dimensional transforms with the advanced data layout
+  CuFFTPlanParams(cufftType type,
+                  long long size,
+                  long long in_length,
+                  long long in_stride,
+                  long long in_dist,
+                  long long out_length,
+                  long long out_stride,
+                  long long out_dist,
+                  long long batch);
+
+  bool operator==(const CuFFTPlanParams& other) const;
+
+  static constexpr int MAX_RANK = 3;
+  cufftType type;
+  int rank;
+  long long n[MAX_RANK];
+  long long inembed[MAX_RANK];
+  long long istride;
+  long long idist;
+  long long onembed[MAX_RANK];
+  long long ostride;
+  long long odist;
+  long long batch;
+
+ private:
+  CuFFTPlanParams(cufftType type, int rank);
+};
+// Return a cuFFT plan that is set up to run on the stream returned by get_cached_stream
+// with its work area in the workspace of that stream. Plans are expensive to create, as
+// that calls cudaMalloc and cudaFree, so every GPU keeps the least recently used ones, up
+// to CUNUMERIC_CUFFT_PLAN_CACHE_SIZE of them. The plans remain owned by the cache and are
+// only good until the next call to get_cufft_plan or get_workspace, which may replace the
+// workspace, so each plan should be fetched right before the transforms that use it.
+cufftHandle get_cufft_plan(const CuFFTPlanParams& params);
+// Whether the GPU keeps device buffers across tasks, which it does for up to
+// CUNUMERIC_GPU_BUFFER_CACHE_SIZE of them and is off by default
+bool use_cached_buffers();
+// Return the cached device buffer of the given size for the key, which must cover
+// everything the contents of the buffer are derived from, so that tasks can reuse data
+// like the transforms of convolution filters. Sets filled to whether an earlier task has
+// filled the buffer, in which case work on the stream of get_cached_stream can read it.
+// Otherwise the caller fills it on that stream and then calls fill_cached_buffer. Returns
+// nullptr when caching is off. The buffer is only good until the next call, which may
+// evict it.
+void* get_cached_buffer(const std::vector<char>& key, size_t size, bool& filled);
+void fill_cached_buffer(void* buffer);
+// Return a device scratch buffer of at least the given number of bytes for work issued to
+// the stream returned by get_cached_stream, and give it back with release_scratch once all
+// that work is issued. Every GPU keeps a pool of power-of-two sized blocks, so tasks reuse
+// the blocks of earlier ones instead of allocating their temporaries on every call. Up to
+// CUNUMERIC_GPU_SCRATCH_POOL_SIZE MiB of free blocks are kept, and the pool reports its
+// usage at shutdown when CUNUMERIC_GPU_SCRATCH_STATS is set.
+void* acquire_scratch(size_t size);
+void release_scratch(void* buffer);
+// Whether the GPU captures the launches of tasks into CUDA graphs, which it does for up
+// to CUNUMERIC_GPU_GRAPH_CACHE_SIZE of them and is off by default. See launch_captured.
+bool use_cuda_graphs();
+// Launch the graph captured for the key on the stream returned by get_cached_stream and
+// return true, or return false if there is none
+bool replay_cuda_graph(const std::vector<char>& key);
+// End the capture that is under way on the stream returned by get_cached_stream, keep the
+// graph for the key and launch it
+void capture_cuda_graph(const std::vector<char>& key);
+// Return the number of CTAs to launch for a grid-stride kernel that would
+// need the given number of blocks to cover its range in a single pass.
+// This is sized to the SM count of the current GPU and the occupancy target
+// in CUNUMERIC_GPU_CTAS_PER_SM, or in the launch configuration otherwise.
+size_t get_grid_stride_ctas(size_t blocks);
+
+// The launch parameters that are picked per GPU model rather than fixed at compile time.
+// The thread counts stay compile-time constants as the kernels use them in their launch
+// bounds and shared memory sizes.
+struct LaunchConfig {
+  // The number of CTAs per SM that grid-stride kernels aim to keep resident
+  size_t grid_stride_ctas_per_sm;
+  // The largest number of CTAs a reduction spreads its input over
+  size_t max_reduction_ctas;
+};
+// Defined in launch_config.cu
+// Return the launch configuration of the current GPU model. It is read from
+// CUNUMERIC_LAUNCH_CONFIG_FILE (~/.cache/cunumeric/launch_config.txt by default), and a run
+// with CUNUMERIC_TUNE_LAUNCH=1 measures and stores it for models that have no entry yet.
+// Without an entry this is GRID_STRIDE_CTAS_PER_SM and MAX_REDUCTION_CTAS.
+const LaunchConfig& get_launch_config();
+size_t get_max_reduction_ctas();
+
+// A scratch buffer of count elements that goes back to the pool when it goes out of scope.
+// Only work issued to the stream before then may use it.
+template <typename T>
+class ScratchBuffer {
+ public:
+  explicit ScratchBuffer(size_t count)
+    : ptr_(static_cast<T*>(acquire_scratch(count * sizeof(T))))
+  {
+  }
+  ~ScratchBuffer() { release_scratch(ptr_); }
+
+ private:
+  ScratchBuffer(const ScratchBuffer& rhs) = delete;
+  ScratchBuffer& operator=(const ScratchBuffer& rhs) = delete;
+
+ public:
+  T* ptr(size_t idx) const { return ptr_ + idx; }
+
+ private:
+  T* ptr_;
+};
+
+// Appends the bytes of values that are passed to kernels by value, which reach the device
+// as those same bytes, to a key
+template <typename... ARGS>
+void append_key(std::vector<char>& key, const ARGS&... args)
+{
+  auto append = [&](const auto& arg) {
+    auto bytes = reinterpret_cast<const char*>(&arg);
+    key.insert(key.end(), bytes, bytes + sizeof(arg));
+  };
+  (append(args), ...);
+}
+
+// Issue the launches of launch() to the stream returned by get_cached_stream, or replay
+// them from a CUDA graph when graphs are on. At the rate of the small tasks of iterative
+// solvers, the host side of issuing several launches costs more than running them, while
+// a graph of any length is issued with a single launch. A graph replays the exact kernel
+// arguments it was captured with, so the key must cover all of them, including the
+// kernels, and launch() must not synchronize with the stream.
+template <typename LAUNCH>
+void launch_captured(const std::vector<char>& key, LAUNCH&& launch)
+{
+  if (!use_cuda_graphs()) {
+    launch();
+    return;
+  }
+  if (replay_cuda_graph(key)) return;
+  CHECK_CUDA(cudaStreamBeginCapture(get_cached_stream(), cudaStreamCaptureModeThreadLocal));
+  launch();
+  capture_cuda_graph(key);
+}
 
 __host__ inline void check_cuda(cudaError_t error, const char* file, int line)
 {
@@ -125,6 +295,19 @@ __host__ inline void check_cusolver(cusolverStatus_t status, const char* file, i
   }
 }
 
+__host__ inline void check_cusparse(cusparseStatus_t status, const char* file, int line)
+{
+  if (status != CUSPARSE_STATUS_SUCCESS) {
+    fprintf(stderr,
+            "Internal cuSPARSE failure with error %s (%d) in file %s at line %d\n",
+            cusparseGetErrorString(status),
+            status,
+            file,
+            line);
+    exit(status);
+  }
+}
+
 __host__ inline void check_cutensor(cutensorStatus_t result, const char* file, int line)
 {
   if (result != CUTENSOR_STATUS_SUCCESS) {
@@ -152,6 +335,40 @@ __device__ __forceinline__ T shuffle(unsigned mask, T var, int laneMask, int wid
   return var;
 }
 
+// Exchanges values between the lanes of a warp, falling back to the word-by-word shuffle
+// for accumulators without a native one (e.g. complex numbers or Welford)
+template <typename T>
+__device__ __forceinline__ T warp_shuffle_xor(T value, int laneMask)
+{
+  if constexpr (std::is_arithmetic<T>::value || std::is_same<T, __half>::value)
+    return __shfl_xor_sync(0xffffffff, value, laneMask, 32);
+  else
+    return shuffle(0xffffffff, value, laneMask, 32);
+}
+
+// Reduces the values of all threads in the block, leaving the result in thread 0.
+// Every thread in the thread block must participate in the exchange to get correct results.
+template <typename REDUCTION, typename T>
+__device__ __forceinline__ T block_reduce(T value)
+{
+  __shared__ alignas(T) uint8_t shmem[THREADS_PER_BLOCK / 32 * sizeof(T)];
+  T* trampoline = reinterpret_cast<T*>(shmem);
+  // Reduce across the warp
+  const int laneid = threadIdx.x & 0x1f;
+  const int warpid = threadIdx.x >> 5;
+  for (int i = 16; i >= 1; i /= 2) {
+    const T shuffle_value = warp_shuffle_xor(value, i);
+    REDUCTION::template fold<true /*exclusive*/>(value, shuffle_value);
+  }
+  // Write warp values into shared memory
+  if ((laneid == 0) && (warpid > 0)) trampoline[warpid] = value;
+  __syncthreads();
+  if (threadIdx.x == 0)
+    for (int i = 1; i < (THREADS_PER_BLOCK / 32); i++)
+      REDUCTION::template fold<true /*exclusive*/>(value, trampoline[i]);
+  return value;
+}
+
 // Overload for complex
 // TBD: if compiler optimizes out the shuffle function we defined, we could make it the default
 // version
@@ -183,27 +400,45 @@ __device__ __forceinline__ void reduce_output(Legion::DeferredReduction<REDUCTIO
 template <typename T, typename REDUCTION>
 __device__ __forceinline__ void reduce_output(Legion::DeferredReduction<REDUCTION> result, T value)
 {
-  __shared__ T trampoline[THREADS_PER_BLOCK / 32];
-  // Reduce across the warp
-  const int laneid = threadIdx.x & 0x1f;
-  const int warpid = threadIdx.x >> 5;
-  for (int i = 16; i >= 1; i /= 2) {
-    const T shuffle_value = __shfl_xor_sync(0xffffffff, value, i, 32);
-    REDUCTION::template fold<true /*exclusive*/>(value, shuffle_value);
-  }
-  // Write warp values into shared memory
-  if ((laneid == 0) && (warpid > 0)) trampoline[warpid] = value;
-  __syncthreads();
+  value = block_reduce<REDUCTION>(value);
   // Output reduction
   if (threadIdx.x == 0) {
-    for (int i = 1; i < (THREADS_PER_BLOCK / 32); i++)
-      REDUCTION::template fold<true /*exclusive*/>(value, trampoline[i]);
     result <<= value;
     // Make sure the result is visible externally
     __threadfence_system();
   }
 }
 
+// Stream compactions give every block a tile of COMPACTION_TILE_ITEMS rounds of
+// THREADS_PER_BLOCK consecutive points, so that only one count per tile has to be
+// scanned between the pass that counts and the pass that writes
+static constexpr size_t COMPACTION_TILE_ITEMS = 8;
+static constexpr size_t COMPACTION_TILE       = COMPACTION_TILE_ITEMS * THREADS_PER_BLOCK;
+
+// Ranks the threads of the block whose flag is set in the order of their indices and
+// sets total to the number of them. Stream compactions call it once per round of points
+// to find where every selected point goes. Every thread in the thread block must call it.
+__device__ __forceinline__ int block_exclusive_rank(bool flag, int& total)
+{
+  __shared__ int warp_counts[THREADS_PER_BLOCK / 32];
+  const int laneid      = threadIdx.x & 0x1f;
+  const int warpid      = threadIdx.x >> 5;
+  const unsigned ballot = __ballot_sync(0xffffffff, flag);
+  if (laneid == 0) warp_counts[warpid] = __popc(ballot);
+  __syncthreads();
+
+  int rank = __popc(ballot & ((1u << laneid) - 1));
+  total    = 0;
+  for (int warp = 0; warp < THREADS_PER_BLOCK / 32; ++warp) {
+    const int count = warp_counts[warp];
+    if (warp < warpid) rank += count;
+    total += count;
+  }
+  // The counts must be read by all warps before the next call overwrites them
+  __syncthreads();
+  return rank;
+}
+
 __device__ __forceinline__ void reduce_bool(Legion::DeferredValue<bool> result, int value)
 {
   __shared__ int trampoline[THREADS_PER_BLOCK / 32];
@@ -516,4 +751,51 @@ __device__ __forceinline__ void store_streaming<double>(double* ptr, double valu
   asm volatile("st.global.cs.f64 [%0], %1;" : : "l"(ptr), "d"(value) : "memory");
 }
 
+// Packs of consecutive elements that dense kernels load and store with a
+// single (up to) 16-byte memory instruction
+template <typename T, int N>
+struct alignas(sizeof(T) * N) VectorPack {
+  __device__ __forceinline__ T& operator[](int idx) { return values[idx]; }
+  __device__ __forceinline__ const T& operator[](int idx) const { return values[idx]; }
+  T values[N];
+};
+
+// The number of elements per pack such that a pack of the widest type is 16 bytes
+template <typename... Ts>
+constexpr int vector_width()
+{
+  size_t widest = 1;
+  for (size_t size : {sizeof(Ts)...}) widest = size > widest ? size : widest;
+  return widest >= 16 ? 1 : static_cast<int>(16 / widest);
+}
+
+template <int VEC, typename... Ts>
+__host__ inline bool is_vector_aligned(const Ts*... ptrs)
+{
+  return ((reinterpret_cast<uintptr_t>(ptrs) % (sizeof(Ts) * VEC) == 0) && ...);
+}
+
+template <int VEC, typename T>
+__device__ __forceinline__ VectorPack<T, VEC> load_vector(const T* ptr)
+{
+  return *reinterpret_cast<const VectorPack<T, VEC>*>(ptr);
+}
+
+template <int VEC, typename T>
+__device__ __forceinline__ void store_vector(T* ptr, const VectorPack<T, VEC>& pack)
+{
+  *reinterpret_cast<VectorPack<T, VEC>*>(ptr) = pack;
+}
+
+// Each thread of a vectorized dense kernel handles VEC elements at a time, and
+// the thread that reaches the end of the array also takes the elements that
+// do not fill a whole pack. Element-wise kernels stride over the range with a
+// grid sized by get_grid_stride_ctas.
+template <int VEC>
+__host__ inline size_t grid_stride_blocks(size_t volume)
+{
+  const size_t threads = (volume + VEC - 1) / VEC;
+  return get_grid_stride_ctas((threads + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK);
+}
+
 }  // namespace cunumeric
@@ -19,6 +19,7 @@
 #include "cudalibs.h"
 #include "cuda_help.h"
 
+#include <algorithm>
 #include <mutex>
 #include <stdio.h>
 
@@ -26,10 +27,114 @@ namespace cunumeric {
 
 using namespace Legion;
 
+// The number of streams that the tasks of a GPU are spread over, unless
+// CUNUMERIC_GPU_STREAMS says otherwise
+static constexpr int32_t DEFAULT_NUM_STREAMS = 4;
+// The number of cuFFT plans that each GPU keeps, unless CUNUMERIC_CUFFT_PLAN_CACHE_SIZE
+// says otherwise
+static constexpr int32_t DEFAULT_CUFFT_PLAN_CACHE_SIZE = 16;
+// The number of device buffers that each GPU keeps across tasks, unless
+// CUNUMERIC_GPU_BUFFER_CACHE_SIZE says otherwise
+static constexpr int32_t DEFAULT_GPU_BUFFER_CACHE_SIZE = 0;
+// The number of MiB of free scratch blocks that each GPU keeps, unless
+// CUNUMERIC_GPU_SCRATCH_POOL_SIZE says otherwise
+static constexpr int32_t DEFAULT_GPU_SCRATCH_POOL_SIZE = 256;
+// The number of captured CUDA graphs that each GPU keeps, unless
+// CUNUMERIC_GPU_GRAPH_CACHE_SIZE says otherwise. Capturing is off by default.
+static constexpr int32_t DEFAULT_GPU_GRAPH_CACHE_SIZE = 0;
+// The smallest block of the scratch pool. Requests are rounded up to powers of two from
+// here, so that the tasks that run over tiles of similar sizes share their blocks.
+static constexpr size_t MIN_SCRATCH_BLOCK_SIZE = 256;
+
+CuFFTPlanParams::CuFFTPlanParams(cufftType type, int rank)
+  : type(type), rank(rank), istride(1), idist(1), ostride(1), odist(1), batch(1)
+{
+  for (int dim = 0; dim < MAX_RANK; ++dim) {
+    n[dim]       = 0;
+    inembed[dim] = 0;
+    onembed[dim] = 0;
+  }
+}
+
+CuFFTPlanParams::CuFFTPlanParams(cufftType type,
+                                 long long size,
+                                 long long in_length,
+                                 long long in_stride,
+                                 long long in_dist,
+                                 long long out_length,
+                                 long long out_stride,
+                                 long long out_dist,
+                                 long long batch)
+  : CuFFTPlanParams(type, 1)
+{
+  n[0]        = size;
+  inembed[0]  = in_length;
+  istride     = in_stride;
+  idist       = in_dist;
+  onembed[0]  = out_length;
+  ostride     = out_stride;
+  odist       = out_dist;
+  this->batch = batch;
+}
+
+bool CuFFTPlanParams::operator==(const CuFFTPlanParams& other) const
+{
+  if (type != other.type || rank != other.rank) return false;
+  for (int dim = 0; dim < MAX_RANK; ++dim)
+    if (n[dim] != other.n[dim] || inembed[dim] != other.inembed[dim] ||
+        onembed[dim] != other.onembed[dim])
+      return false;
+  return istride == other.istride && idist == other.idist && ostride == other.ostride &&
+         odist == other.odist && batch == other.batch;
+}
+
 CUDALibraries::CUDALibraries()
-  : finalized_(false), cublas_(nullptr), cusolver_(nullptr), cutensor_(nullptr)
+  : finalized_(false),
+    current_(0),
+    current_task_(Realm::Event::NO_EVENT),
+    cutensor_(nullptr),
+    num_sms_(0),
+    cufft_clock_(0),
+    cufft_hits_(0),
+    cufft_misses_(0),
+    cufft_evictions_(0),
+    cached_buffer_clock_(0),
+    scratch_bytes_(0),
+    scratch_bytes_in_use_(0),
+    scratch_peak_bytes_(0),
+    scratch_peak_bytes_in_use_(0),
+    scratch_hits_(0),
+    scratch_misses_(0),
+    scratch_evictions_(0),
+    cuda_graph_clock_(0),
+    cuda_graph_hits_(0),
+    cuda_graph_misses_(0),
+    cuda_graph_evictions_(0)
 {
-  CHECK_CUDA(cudaStreamCreateWithFlags(&stream_, cudaStreamNonBlocking));
+  const char* value = getenv("CUNUMERIC_GPU_STREAMS");
+  const int32_t num_streams = nullptr == value ? DEFAULT_NUM_STREAMS : std::max(1, atoi(value));
+  value                     = getenv("CUNUMERIC_CUFFT_PLAN_CACHE_SIZE");
+  cufft_plan_capacity_ =
+    nullptr == value ? DEFAULT_CUFFT_PLAN_CACHE_SIZE : std::max(1, atoi(value));
+  value = getenv("CUNUMERIC_GPU_BUFFER_CACHE_SIZE");
+  cached_buffer_capacity_ =
+    nullptr == value ? DEFAULT_GPU_BUFFER_CACHE_SIZE : std::max(0, atoi(value));
+  value = getenv("CUNUMERIC_GPU_SCRATCH_POOL_SIZE");
+  const int32_t scratch_mib =
+    nullptr == value ? DEFAULT_GPU_SCRATCH_POOL_SIZE : std::max(0, atoi(value));
+  scratch_capacity_ = static_cast<size_t>(scratch_mib) << 20;
+  value             = getenv("CUNUMERIC_GPU_GRAPH_CACHE_SIZE");
+  cuda_graph_capacity_ =
+    nullptr == value ? DEFAULT_GPU_GRAPH_CACHE_SIZE : std::max(0, atoi(value));
+  contexts_.resize(num_streams);
+  for (auto& context : contexts_) {
+    CHECK_CUDA(cudaStreamCreateWithFlags(&context.stream, cudaStreamNonBlocking));
+    context.cublas         = nullptr;
+    context.cusolver       = nullptr;
+    context.cusparse       = nullptr;
+    context.workspace      = nullptr;
+    context.workspace_size = 0;
+  }
 }
 
 CUDALibraries::~CUDALibraries() { finalize(); }
@@ -37,23 +142,26 @@ CUDALibraries::~CUDALibraries() { finalize(); }
 void CUDALibraries::finalize()
 {
   if (finalized_) return;
-  if (cublas_ != nullptr) finalize_cublas();
-  if (cusolver_ != nullptr) finalize_cusolver();
+  // The plans may still be in use by work queued on the streams
+  if (!cufft_plans_.empty()) finalize_cufft();
+  if (!cached_buffers_.empty()) finalize_cached_buffers();
+  if (!cuda_graphs_.empty()) finalize_cuda_graphs();
+  if (!scratch_blocks_.empty()) finalize_scratch();
+  for (auto& context : contexts_) finalize_context(context);
   if (cutensor_ != nullptr) finalize_cutensor();
-  cudaStreamDestroy(stream_);
   finalized_ = true;
 }
 
-void CUDALibraries::finalize_cublas()
-{
-  CHECK_CUBLAS(cublasDestroy(cublas_));
-  cublas_ = nullptr;
-}
-
-void CUDALibraries::finalize_cusolver()
+void CUDALibraries::finalize_context(StreamContext& context)
 {
-  CHECK_CUSOLVER(cusolverDnDestroy(cusolver_));
-  cusolver_ = nullptr;
+  if (context.cublas != nullptr) CHECK_CUBLAS(cublasDestroy(context.cublas));
+  if (context.cusolver != nullptr) CHECK_CUSOLVER(cusolverDnDestroy(context.cusolver));
+  if (context.cusparse != nullptr) CHECK_CUSPARSE(cusparseDestroy(context.cusparse));
+  if (context.workspace != nullptr) finalize_workspace(context);
+  cudaStreamDestroy(context.stream);
+  context.cublas   = nullptr;
+  context.cusolver = nullptr;
+  context.cusparse = nullptr;
 }
 
 void CUDALibraries::finalize_cutensor()
@@ -62,27 +170,124 @@ void CUDALibraries::finalize_cutensor()
   cutensor_ = nullptr;
 }
 
-cudaStream_t CUDALibraries::get_cached_stream() { return stream_; }
+void CUDALibraries::finalize_cufft()
+{
+  synchronize_streams();
+  size_t max_workarea_size = 0;
+  for (auto& plan : cufft_plans_) {
+    max_workarea_size = std::max(max_workarea_size, plan.workarea_size);
+    CHECK_CUFFT(cufftDestroy(plan.handle));
+  }
+  cufft_plans_.clear();
+  if (getenv("CUNUMERIC_CUFFT_PLAN_CACHE_STATS") != nullptr)
+    fprintf(stderr,
+            "cuFFT plan cache: %zu hits, %zu misses, %zu evictions, "
+            "largest work area of the last plans %zu bytes\n",
+            cufft_hits_,
+            cufft_misses_,
+            cufft_evictions_,
+            max_workarea_size);
+}
+
+void CUDALibraries::finalize_cached_buffers()
+{
+  synchronize_streams();
+  for (auto& buffer : cached_buffers_) {
+    CHECK_CUDA(cudaEventDestroy(buffer.ready));
+    CHECK_CUDA(cudaFree(buffer.ptr));
+  }
+  cached_buffers_.clear();
+}
+
+void CUDALibraries::finalize_scratch()
+{
+  synchronize_streams();
+  for (auto& block : scratch_blocks_) {
+    CHECK_CUDA(cudaEventDestroy(block.released));
+    CHECK_CUDA(cudaFree(block.ptr));
+  }
+  scratch_blocks_.clear();
+  if (getenv("CUNUMERIC_GPU_SCRATCH_STATS") != nullptr)
+    fprintf(stderr,
+            "GPU scratch pool: %zu hits, %zu misses, %zu evictions, "
+            "at most %zu bytes held and %zu bytes in use\n",
+            scratch_hits_,
+            scratch_misses_,
+            scratch_evictions_,
+            scratch_peak_bytes_,
+            scratch_peak_bytes_in_use_);
+}
+
+void CUDALibraries::finalize_cuda_graphs()
+{
+  synchronize_streams();
+  for (auto& graph : cuda_graphs_) CHECK_CUDA(cudaGraphExecDestroy(graph.exec));
+  cuda_graphs_.clear();
+  if (getenv("CUNUMERIC_GPU_GRAPH_STATS") != nullptr)
+    fprintf(stderr,
+            "CUDA graph cache: %zu hits, %zu misses, %zu evictions\n",
+            cuda_graph_hits_,
+            cuda_graph_misses_,
+            cuda_graph_evictions_);
+}
+
+void CUDALibraries::synchronize_streams()
+{
+  for (auto& context : contexts_) CHECK_CUDA(cudaStreamSynchronize(context.stream));
+}
+
+void CUDALibraries::finalize_workspace(StreamContext& context)
+{
+  CHECK_CUDA(cudaStreamSynchronize(context.stream));
+  CHECK_CUDA(cudaFree(context.workspace));
+  context.workspace      = nullptr;
+  context.workspace_size = 0;
+}
+
+CUDALibraries::StreamContext& CUDALibraries::current_context()
+{
+  // Every task moves on to the next stream of the pool, so the small kernels of point
+  // tasks that are independent of each other, like the tile updates of a Cholesky step,
+  // overlap on the GPU instead of queuing up on the same stream. All calls made by the
+  // same task get the same stream and handles, as the task is known by its finish event.
+  auto task = Processor::get_current_finish_event();
+  if (task != current_task_) {
+    current_task_ = task;
+    current_      = (current_ + 1) % contexts_.size();
+  }
+  return contexts_[current_];
+}
+
+cudaStream_t CUDALibraries::get_cached_stream() { return current_context().stream; }
 
 cublasHandle_t CUDALibraries::get_cublas()
 {
-  if (nullptr == cublas_) {
-    CHECK_CUBLAS(cublasCreate(&cublas_));
+  auto& context = current_context();
+  if (nullptr == context.cublas) {
+    CHECK_CUBLAS(cublasCreate(&context.cublas));
     const char* disable_tensor_cores = getenv("CUNUMERIC_DISABLE_TENSOR_CORES");
     if (nullptr == disable_tensor_cores) {
       // No request to disable tensor cores so turn them on
-      cublasStatus_t status = cublasSetMathMode(cublas_, CUBLAS_TENSOR_OP_MATH);
+      cublasStatus_t status = cublasSetMathMode(context.cublas, CUBLAS_TENSOR_OP_MATH);
       if (status != CUBLAS_STATUS_SUCCESS)
         fprintf(stderr, "WARNING: cuBLAS does not support Tensor cores!");
     }
   }
-  return cublas_;
+  return context.cublas;
 }
 
 cusolverDnHandle_t CUDALibraries::get_cusolver()
 {
-  if (nullptr == cusolver_) CHECK_CUSOLVER(cusolverDnCreate(&cusolver_));
-  return cusolver_;
+  auto& context = current_context();
+  if (nullptr == context.cusolver) CHECK_CUSOLVER(cusolverDnCreate(&context.cusolver));
+  return context.cusolver;
+}
+
+cusparseHandle_t CUDALibraries::get_cusparse()
+{
+  auto& context = current_context();
+  if (nullptr == context.cusparse) CHECK_CUSPARSE(cusparseCreate(&context.cusparse));
+  return context.cusparse;
 }
 
 cutensorHandle_t* CUDALibraries::get_cutensor()
@@ -94,6 +299,246 @@ cutensorHandle_t* CUDALibraries::get_cutensor()
   return cutensor_;
 }
 
+int32_t CUDALibraries::get_num_sms()
+{
+  if (0 == num_sms_) {
+    int device;
+    CHECK_CUDA(cudaGetDevice(&device));
+    CHECK_CUDA(cudaDeviceGetAttribute(&num_sms_, cudaDevAttrMultiProcessorCount, device));
+  }
+  return num_sms_;
+}
+
+void* CUDALibraries::get_workspace(size_t size)
+{
+  auto& context = current_context();
+  if (size > context.workspace_size) {
+    // Grow geometrically so that a run of slightly bigger requests
+    // doesn't reallocate the workspace every time
+    const size_t new_size = std::max(size, 2 * context.workspace_size);
+    // Work still queued on the stream may be using the old workspace
+    if (context.workspace != nullptr) finalize_workspace(context);
+    CHECK_CUDA(cudaMalloc(&context.workspace, new_size));
+    context.workspace_size = new_size;
+  }
+  return context.workspace;
+}
+
+cufftHandle CUDALibraries::get_cufft_plan(const CuFFTPlanParams& params)
+{
+  auto finder = std::find_if(cufft_plans_.begin(),
+                             cufft_plans_.end(),
+                             [&](const CuFFTPlan& plan) { return plan.params == params; });
+  if (finder != cufft_plans_.end())
+    ++cufft_hits_;
+  else {
+    ++cufft_misses_;
+    if (cufft_plans_.size() >= cufft_plan_capacity_) {
+      finder = std::min_element(
+        cufft_plans_.begin(), cufft_plans_.end(), [](const CuFFTPlan& a, const CuFFTPlan& b) {
+          return a.last_use < b.last_use;
+        });
+      // Any stream of the pool may still have transforms of the plan queued up
+      synchronize_streams();
+      CHECK_CUFFT(cufftDestroy(finder->handle));
+      cufft_plans_.erase(finder);
+      ++cufft_evictions_;
+    }
+    // Take empty embeddings to mean the basic data layout
+    auto embedding = [&](const long long* embed) {
+      return 0 == embed[0] ? nullptr : const_cast<long long*>(embed);
+    };
+    CuFFTPlan plan{params, 0, 0, 0};
+    CHECK_CUFFT(cufftCreate(&plan.handle));
+    CHECK_CUFFT(cufftSetAutoAllocation(plan.handle, 0 /*we'll do the allocation*/));
+    CHECK_CUFFT(cufftMakePlanMany64(plan.handle,
+                                    params.rank,
+                                    const_cast<long long*>(params.n),
+                                    embedding(params.inembed),
+                                    params.istride,
+                                    params.idist,
+                                    embedding(params.onembed),
+                                    params.ostride,
+                                    params.odist,
+                                    params.type,
+                                    params.batch,
+                                    &plan.workarea_size));
+    finder = cufft_plans_.insert(cufft_plans_.end(), plan);
+  }
+  finder->last_use = ++cufft_clock_;
+
+  auto& context = current_context();
+  CHECK_CUFFT(cufftSetStream(finder->handle, context.stream));
+  if (finder->workarea_size > 0)
+    CHECK_CUFFT(cufftSetWorkArea(finder->handle, get_workspace(finder->workarea_size)));
+  return finder->handle;
+}
+
+bool CUDALibraries::use_cached_buffers() const { return cached_buffer_capacity_ > 0; }
+
+void* CUDALibraries::get_cached_buffer(const std::vector<char>& key, size_t size, bool& filled)
+{
+  if (!use_cached_buffers()) return nullptr;
+  auto& context = current_context();
+  auto finder   = std::find_if(
+    cached_buffers_.begin(), cached_buffers_.end(), [&](const CachedBuffer& buffer) {
+      return buffer.size == size && buffer.key == key;
+    });
+  if (finder == cached_buffers_.end()) {
+    if (cached_buffers_.size() >= cached_buffer_capacity_) {
+      finder = std::min_element(
+        cached_buffers_.begin(),
+        cached_buffers_.end(),
+        [](const CachedBuffer& a, const CachedBuffer& b) { return a.last_use < b.last_use; });
+      // Any stream of the pool may still have work queued up that reads the buffer
+      synchronize_streams();
+      CHECK_CUDA(cudaEventDestroy(finder->ready));
+      CHECK_CUDA(cudaFree(finder->ptr));
+      cached_buffers_.erase(finder);
+    }
+    CachedBuffer buffer{key, nullptr, size, nullptr, false, 0};
+    CHECK_CUDA(cudaMalloc(&buffer.ptr, size));
+    CHECK_CUDA(cudaEventCreateWithFlags(&buffer.ready, cudaEventDisableTiming));
+    finder = cached_buffers_.insert(cached_buffers_.end(), buffer);
+  } else if (finder->filled)
+    CHECK_CUDA(cudaStreamWaitEvent(context.stream, finder->ready, 0));
+  finder->last_use = ++cached_buffer_clock_;
+  filled           = finder->filled;
+  return finder->ptr;
+}
+
+void CUDALibraries::fill_cached_buffer(void* ptr)
+{
+  auto finder = std::find_if(cached_buffers_.begin(),
+                             cached_buffers_.end(),
+                             [&](const CachedBuffer& buffer) { return buffer.ptr == ptr; });
+  assert(finder != cached_buffers_.end());
+  CHECK_CUDA(cudaEventRecord(finder->ready, current_context().stream));
+  finder->filled = true;
+}
+
+void* CUDALibraries::acquire_scratch(size_t size)
+{
+  if (0 == size) return nullptr;
+  size_t block_size = MIN_SCRATCH_BLOCK_SIZE;
+  while (block_size < size) block_size *= 2;
+
+  auto& context = current_context();
+  auto finder   = std::find_if(
+    scratch_blocks_.begin(), scratch_blocks_.end(), [&](const ScratchBlock& block) {
+      return !block.in_use && block.size == block_size;
+    });
+  if (finder != scratch_blocks_.end()) {
+    ++scratch_hits_;
+    // The work of the task that released the block is ordered before this one on its
+    // own stream, but not on any other
+    if (finder->stream != context.stream)
+      CHECK_CUDA(cudaStreamWaitEvent(context.stream, finder->released, 0));
+  } else {
+    ++scratch_misses_;
+    trim_scratch(block_size);
+    ScratchBlock block{nullptr, block_size, nullptr, context.stream, false};
+    CHECK_CUDA(cudaMalloc(&block.ptr, block_size));
+    CHECK_CUDA(cudaEventCreateWithFlags(&block.released, cudaEventDisableTiming));
+    finder = scratch_blocks_.insert(scratch_blocks_.end(), block);
+    scratch_bytes_ += block_size;
+    scratch_peak_bytes_ = std::max(scratch_peak_bytes_, scratch_bytes_);
+  }
+  finder->in_use = true;
+  record_temporary(block_size);
+  scratch_bytes_in_use_ += block_size;
+  scratch_peak_bytes_in_use_ = std::max(scratch_peak_bytes_in_use_, scratch_bytes_in_use_);
+  return finder->ptr;
+}
+
+void CUDALibraries::release_scratch(void* ptr)
+{
+  if (nullptr == ptr) return;
+  auto finder = std::find_if(scratch_blocks_.begin(),
+                             scratch_blocks_.end(),
+                             [&](const ScratchBlock& block) { return block.ptr == ptr; });
+  assert(finder != scratch_blocks_.end() && finder->in_use);
+  auto& context = current_context();
+  CHECK_CUDA(cudaEventRecord(finder->released, context.stream));
+  finder->stream = context.stream;
+  finder->in_use = false;
+  release_temporary(finder->size);
+  scratch_bytes_in_use_ -= finder->size;
+}
+
+void CUDALibraries::trim_scratch(size_t size)
+{
+  // Free the blocks that are not in use, largest first, until the new block fits. Blocks
+  // in use are never taken back, so the pool may exceed its capacity while tasks need it.
+  while (scratch_bytes_ + size > scratch_capacity_) {
+    auto victim = scratch_blocks_.end();
+    for (auto it = scratch_blocks_.begin(); it != scratch_blocks_.end(); ++it)
+      if (!it->in_use && (victim == scratch_blocks_.end() || it->size > victim->size))
+        victim = it;
+    if (victim == scratch_blocks_.end()) break;
+    CHECK_CUDA(cudaEventSynchronize(victim->released));
+    CHECK_CUDA(cudaEventDestroy(victim->released));
+    CHECK_CUDA(cudaFree(victim->ptr));
+    scratch_bytes_ -= victim->size;
+    scratch_blocks_.erase(victim);
+    ++scratch_evictions_;
+  }
+}
+
+bool CUDALibraries::use_cuda_graphs() const { return cuda_graph_capacity_ > 0; }
+
+bool CUDALibraries::replay_cuda_graph(const std::vector<char>& key)
+{
+  auto finder = std::find_if(cuda_graphs_.begin(),
+                             cuda_graphs_.end(),
+                             [&](const CapturedGraph& graph) { return graph.key == key; });
+  if (finder == cuda_graphs_.end()) {
+    ++cuda_graph_misses_;
+    return false;
+  }
+  ++cuda_graph_hits_;
+  finder->last_use = ++cuda_graph_clock_;
+  CHECK_CUDA(cudaGraphLaunch(finder->exec, current_context().stream));
+  return true;
+}
+
+void CUDALibraries::capture_cuda_graph(const std::vector<char>& key)
+{
+  auto& context = current_context();
+  cudaGraph_t graph;
+  CHECK_CUDA(cudaStreamEndCapture(context.stream, &graph));
+  if (cuda_graphs_.size() >= cuda_graph_capacity_) {
+    auto finder = std::min_element(
+      cuda_graphs_.begin(), cuda_graphs_.end(), [](const CapturedGraph& a, const CapturedGraph& b) {
+        return a.last_use < b.last_use;
+      });
+    // Any stream of the pool may still have a replay of the graph queued up
+    synchronize_streams();
+    CHECK_CUDA(cudaGraphExecDestroy(finder->exec));
+    cuda_graphs_.erase(finder);
+    ++cuda_graph_evictions_;
+  }
+  CapturedGraph captured{key, nullptr, ++cuda_graph_clock_};
+  CHECK_CUDA(cudaGraphInstantiate(&captured.exec, graph, nullptr, nullptr, 0));
+  CHECK_CUDA(cudaGraphDestroy(graph));
+  cuda_graphs_.push_back(std::move(captured));
+  // Capturing only recorded the launches, so the task still has to run them
+  CHECK_CUDA(cudaGraphLaunch(cuda_graphs_.back().exec, context.stream));
+}
+
+void CUDALibraries::load()
+{
+  for (size_t idx = 0; idx < contexts_.size(); ++idx) {
+    get_cublas();
+    get_cusolver();
+    get_cusparse();
+    current_ = (current_ + 1) % contexts_.size();
+  }
+  get_cutensor();
+  // Resolve the launch configuration up front, as tuning cannot run inside a graph capture
+  get_launch_config();
+}
+
 static CUDALibraries& get_cuda_libraries(Processor proc)
 {
   if (proc.kind() != Processor::TOC_PROC) {
@@ -133,6 +578,13 @@ cusolverDnContext* get_cusolver()
   return lib.get_cusolver();
 }
 
+cusparseContext* get_cusparse()
+{
+  const auto proc = Processor::get_executing_processor();
+  auto& lib       = get_cuda_libraries(proc);
+  return lib.get_cusparse();
+}
+
 cutensorHandle_t* get_cutensor()
 {
   const auto proc = Processor::get_executing_processor();
@@ -140,6 +592,92 @@ cutensorHandle_t* get_cutensor()
   return lib.get_cutensor();
 }
 
+void* get_workspace(size_t size)
+{
+  const auto proc = Processor::get_executing_processor();
+  auto& lib       = get_cuda_libraries(proc);
+  return lib.get_workspace(size);
+}
+
+cufftHandle get_cufft_plan(const CuFFTPlanParams& params)
+{
+  const auto proc = Processor::get_executing_processor();
+  auto& lib       = get_cuda_libraries(proc);
+  return lib.get_cufft_plan(params);
+}
+
+bool use_cached_buffers()
+{
+  const auto proc = Processor::get_executing_processor();
+  auto& lib       = get_cuda_libraries(proc);
+  return lib.use_cached_buffers();
+}
+
+void* get_cached_buffer(const std::vector<char>& key, size_t size, bool& filled)
+{
+  const auto proc = Processor::get_executing_processor();
+  auto& lib       = get_cuda_libraries(proc);
+  return lib.get_cached_buffer(key, size, filled);
+}
+
+void fill_cached_buffer(void* buffer)
+{
+  const auto proc = Processor::get_executing_processor();
+  auto& lib       = get_cuda_libraries(proc);
+  lib.fill_cached_buffer(buffer);
+}
+
+void* acquire_scratch(size_t size)
+{
+  const auto proc = Processor::get_executing_processor();
+  auto& lib       = get_cuda_libraries(proc);
+  return lib.acquire_scratch(size);
+}
+
+void release_scratch(void* buffer)
+{
+  const auto proc = Processor::get_executing_processor();
+  auto& lib       = get_cuda_libraries(proc);
+  lib.release_scratch(buffer);
+}
+
+bool use_cuda_graphs()
+{
+  const auto proc = Processor::get_executing_processor();
+  auto& lib       = get_cuda_libraries(proc);
+  return lib.use_cuda_graphs();
+}
+
+bool replay_cuda_graph(const std::vector<char>& key)
+{
+  const auto proc = Processor::get_executing_processor();
+  auto& lib       = get_cuda_libraries(proc);
+  return lib.replay_cuda_graph(key);
+}
+
+void capture_cuda_graph(const std::vector<char>& key)
+{
+  const auto proc = Processor::get_executing_processor();
+  auto& lib       = get_cuda_libraries(proc);
+  lib.capture_cuda_graph(key);
+}
+
+size_t get_grid_stride_ctas(size_t blocks)
+{
+  // The number of CTAs per SM that grid-stride kernels aim to keep resident, if overridden
+  static const size_t override_ctas_per_sm = []() -> size_t {
+    const char* value = getenv("CUNUMERIC_GPU_CTAS_PER_SM");
+    if (nullptr == value) return 0;
+    return std::max(1, atoi(value));
+  }();
+  const size_t ctas_per_sm =
+    override_ctas_per_sm > 0 ? override_ctas_per_sm : get_launch_config().grid_stride_ctas_per_sm;
+  const auto proc       = Processor::get_executing_processor();
+  auto& lib             = get_cuda_libraries(proc);
+  const size_t max_ctas = ctas_per_sm * lib.get_num_sms();
+  return std::max<size_t>(1, std::min(blocks, max_ctas));
+}
+
 class LoadCUDALibsTask : public CuNumericTask<LoadCUDALibsTask> {
  public:
   static const int TASK_ID = CUNUMERIC_LOAD_CUDALIBS;
@@ -149,9 +687,7 @@ class LoadCUDALibsTask : public CuNumericTask<LoadCUDALibsTask> {
   {
     const auto proc = Processor::get_executing_processor();
     auto& lib       = get_cuda_libraries(proc);
-    lib.get_cublas();
-    lib.get_cusolver();
-    lib.get_cutensor();
+    lib.load();
   }
 };
 
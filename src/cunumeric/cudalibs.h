@@ -16,10 +16,15 @@
 
 #pragma once
 
+#include "cunumeric/cuda_help.h"
+
 #include <cublas_v2.h>
 #include <cusolverDn.h>
+#include <cusparse.h>
 #include <cutensor.h>
 
+#include <vector>
+
 namespace cunumeric {
 
 struct CUDALibraries {
@@ -37,19 +42,109 @@ struct CUDALibraries {
   cudaStream_t get_cached_stream();
   cublasHandle_t get_cublas();
   cusolverDnHandle_t get_cusolver();
+  cusparseHandle_t get_cusparse();
   cutensorHandle_t* get_cutensor();
+  int32_t get_num_sms();
+  void* get_workspace(size_t size);
+  cufftHandle get_cufft_plan(const CuFFTPlanParams& params);
+  bool use_cached_buffers() const;
+  void* get_cached_buffer(const std::vector<char>& key, size_t size, bool& filled);
+  void fill_cached_buffer(void* buffer);
+  void* acquire_scratch(size_t size);
+  void release_scratch(void* buffer);
+  bool use_cuda_graphs() const;
+  bool replay_cuda_graph(const std::vector<char>& key);
+  void capture_cuda_graph(const std::vector<char>& key);
+  // Create the library handles of every stream of the pool upfront
+  void load();
 
  private:
-  void finalize_cublas();
-  void finalize_cusolver();
+  // A stream of the pool along with the library handles and the workspace that only
+  // work issued to that stream uses
+  struct StreamContext {
+    cudaStream_t stream;
+    cublasContext* cublas;
+    cusolverDnContext* cusolver;
+    cusparseContext* cusparse;
+    void* workspace;
+    size_t workspace_size;
+  };
+  // A cached cuFFT plan. Plans don't allocate work areas of their own, but take the
+  // workspace of the stream they run on.
+  struct CuFFTPlan {
+    CuFFTPlanParams params;
+    cufftHandle handle;
+    size_t workarea_size;
+    uint64_t last_use;
+  };
+  // A device buffer that outlives the task that filled it. The event marks when the
+  // stream that filled it was done, as later tasks may use any stream of the pool.
+  struct CachedBuffer {
+    std::vector<char> key;
+    void* ptr;
+    size_t size;
+    cudaEvent_t ready;
+    bool filled;
+    uint64_t last_use;
+  };
+  // A block of the scratch pool. The event marks when the stream of the task that released
+  // the block was done with it, as the next task to take it may run on another stream.
+  struct ScratchBlock {
+    void* ptr;
+    size_t size;
+    cudaEvent_t released;
+    cudaStream_t stream;
+    bool in_use;
+  };
+  // A CUDA graph captured from the launches of a task. Later tasks whose launches have
+  // the same key replay it with a single launch.
+  struct CapturedGraph {
+    std::vector<char> key;
+    cudaGraphExec_t exec;
+    uint64_t last_use;
+  };
+  StreamContext& current_context();
+  void finalize_context(StreamContext& context);
+  void finalize_workspace(StreamContext& context);
   void finalize_cutensor();
+  void finalize_cufft();
+  void finalize_cached_buffers();
+  void finalize_scratch();
+  void trim_scratch(size_t size);
+  void finalize_cuda_graphs();
+  void synchronize_streams();
 
  private:
   bool finalized_;
-  cudaStream_t stream_;
-  cublasContext* cublas_;
-  cusolverDnContext* cusolver_;
+  std::vector<StreamContext> contexts_;
+  size_t current_;
+  Realm::Event current_task_;
   cutensorHandle_t* cutensor_;
+  int32_t num_sms_;
+  std::vector<CuFFTPlan> cufft_plans_;
+  size_t cufft_plan_capacity_;
+  uint64_t cufft_clock_;
+  size_t cufft_hits_;
+  size_t cufft_misses_;
+  size_t cufft_evictions_;
+  std::vector<CachedBuffer> cached_buffers_;
+  size_t cached_buffer_capacity_;
+  uint64_t cached_buffer_clock_;
+  std::vector<ScratchBlock> scratch_blocks_;
+  size_t scratch_capacity_;
+  size_t scratch_bytes_;
+  size_t scratch_bytes_in_use_;
+  size_t scratch_peak_bytes_;
+  size_t scratch_peak_bytes_in_use_;
+  size_t scratch_hits_;
+  size_t scratch_misses_;
+  size_t scratch_evictions_;
+  std::vector<CapturedGraph> cuda_graphs_;
+  size_t cuda_graph_capacity_;
+  uint64_t cuda_graph_clock_;
+  size_t cuda_graph_hits_;
+  size_t cuda_graph_misses_;
+  size_t cuda_graph_evictions_;
 };
 
 }  // namespace cunumeric
@@ -33,6 +33,8 @@ static const char* const cunumeric_library_name = "cunumeric";
 
 #ifdef LEGATE_USE_CUDA
 extern void register_gpu_reduction_operators(LibraryContext& context);
+extern bool pin_host_memory(void* ptr, size_t size);
+extern void unpin_host_memory(void* ptr);
 #else
 extern void register_cpu_reduction_operators(LibraryContext& context);
 #endif
@@ -48,6 +50,7 @@ void registration_callback(Machine machine,
   LibraryContext context(runtime, cunumeric_library_name, config);
 
   CuNumeric::get_registrar().register_all_tasks(runtime, context);
+  set_memory_report_task_base(context.get_task_id(0));
 
   // Register our special reduction functions
 #ifdef LEGATE_USE_CUDA
@@ -74,4 +77,20 @@ void cunumeric_perform_registration(void)
   // that this call back is invoked everywhere across all nodes
   Runtime::perform_registration_callback(cunumeric::registration_callback, true /*global*/);
 }
+
+int cunumeric_pin_host_memory(uint64_t ptr, size_t size)
+{
+#ifdef LEGATE_USE_CUDA
+  return cunumeric::pin_host_memory(reinterpret_cast<void*>(ptr), size);
+#else
+  return 0;
+#endif
+}
+
+void cunumeric_unpin_host_memory(uint64_t ptr)
+{
+#ifdef LEGATE_USE_CUDA
+  cunumeric::unpin_host_memory(reinterpret_cast<void*>(ptr));
+#endif
+}
 }
@@ -68,6 +68,42 @@ void register_gpu_reduction_operators(legate::LibraryContext& context)
 {
   REGISTER_REDOPS(ArgmaxReduction);
   REGISTER_REDOPS(ArgminReduction);
+  // Variances are only computed in floating point
+  _REGISTER_REDOP(context.get_reduction_op_id(VarianceReduction<float>::REDOP_ID),
+                  VarianceReduction<float>)
+  _REGISTER_REDOP(context.get_reduction_op_id(VarianceReduction<double>::REDOP_ID),
+                  VarianceReduction<double>)
+  // So are the reproducible sums
+  _REGISTER_REDOP(context.get_reduction_op_id(BinnedSumReduction<float>::REDOP_ID),
+                  BinnedSumReduction<float>)
+  _REGISTER_REDOP(context.get_reduction_op_id(BinnedSumReduction<double>::REDOP_ID),
+                  BinnedSumReduction<double>)
+  // And the 2-norms
+  _REGISTER_REDOP(context.get_reduction_op_id(NormReduction<float>::REDOP_ID), NormReduction<float>)
+  _REGISTER_REDOP(context.get_reduction_op_id(NormReduction<double>::REDOP_ID),
+                  NormReduction<double>)
+  // And the logs of sums of exponentials
+  _REGISTER_REDOP(context.get_reduction_op_id(LogSumExpReduction<float>::REDOP_ID),
+                  LogSumExpReduction<float>)
+  _REGISTER_REDOP(context.get_reduction_op_id(LogSumExpReduction<double>::REDOP_ID),
+                  LogSumExpReduction<double>)
+}
+
+bool pin_host_memory(void* ptr, size_t size)
+{
+  // Memory that is already registered, e.g. through another view of the
+  // same buffer, stays with whoever registered it
+  if (cudaHostRegister(ptr, size, cudaHostRegisterPortable) != cudaSuccess) {
+    // Clear the error so that the next CUDA call does not report it
+    cudaGetLastError();
+    return false;
+  }
+  return true;
+}
+
+void unpin_host_memory(void* ptr)
+{
+  if (cudaHostUnregister(ptr) != cudaSuccess) cudaGetLastError();
 }
 
 }  // namespace cunumeric
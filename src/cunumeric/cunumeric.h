@@ -18,6 +18,8 @@
 
 #include "legate.h"
 #include "cunumeric/cunumeric_c.h"
+#include "cunumeric/dispatch.h"
+#include "cunumeric/memory_report.h"
 
 namespace cunumeric {
 
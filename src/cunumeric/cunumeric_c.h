@@ -24,34 +24,74 @@
 enum CuNumericOpCode {
   _CUNUMERIC_OP_CODE_BASE = 0,
   CUNUMERIC_ARANGE,
+  CUNUMERIC_BATCHED_MATMUL,
+  CUNUMERIC_BATCHED_SOLVE,
   CUNUMERIC_BINARY_OP,
   CUNUMERIC_BINARY_RED,
   CUNUMERIC_BINCOUNT,
+  CUNUMERIC_BUCKET,
   CUNUMERIC_CHOOSE,
+  CUNUMERIC_COMPRESS,
   CUNUMERIC_CONTRACT,
   CUNUMERIC_CONVERT,
   CUNUMERIC_CONVOLVE,
   CUNUMERIC_DIAG,
   CUNUMERIC_DOT,
   CUNUMERIC_EYE,
+  CUNUMERIC_FFT,
   CUNUMERIC_FILL,
   CUNUMERIC_FLIP,
+  CUNUMERIC_FMA,
+  CUNUMERIC_FUSED_OP,
+  CUNUMERIC_GATHER,
   CUNUMERIC_GEMM,
+  CUNUMERIC_GEQRF,
+  CUNUMERIC_GESVD,
+  CUNUMERIC_GETRF,
+  CUNUMERIC_GETRS,
+  CUNUMERIC_GRAM,
+  CUNUMERIC_HISTOGRAM,
+  CUNUMERIC_INTERP,
+  CUNUMERIC_KMEANS_ASSIGN,
+  CUNUMERIC_KRON,
+  CUNUMERIC_LASWP,
   CUNUMERIC_LOAD_CUDALIBS,
+  CUNUMERIC_LOAD_NPY,
+  CUNUMERIC_LSTM_GATES,
   CUNUMERIC_MATMUL,
   CUNUMERIC_MATVECMUL,
+  CUNUMERIC_MULTI_DOT,
   CUNUMERIC_NONZERO,
+  CUNUMERIC_PAD,
+  CUNUMERIC_PERMUTE_COPY,
+  CUNUMERIC_PLACE,
+  CUNUMERIC_POLYVAL,
   CUNUMERIC_POTRF,
+  CUNUMERIC_QUANTIZE,
+  CUNUMERIC_QUANTIZED_MATVEC,
   CUNUMERIC_RAND,
   CUNUMERIC_READ,
+  CUNUMERIC_REPEAT,
+  CUNUMERIC_RESHAPE,
+  CUNUMERIC_ROLLING,
+  CUNUMERIC_SAVE_NPY,
   CUNUMERIC_SCALAR_UNARY_RED,
+  CUNUMERIC_SCAN,
+  CUNUMERIC_SCATTER,
+  CUNUMERIC_SEARCHSORTED,
+  CUNUMERIC_SEGMENT_REDUCE,
+  CUNUMERIC_SORT,
+  CUNUMERIC_SPMM,
+  CUNUMERIC_STENCIL,
   CUNUMERIC_SYRK,
   CUNUMERIC_TILE,
+  CUNUMERIC_TOPK,
   CUNUMERIC_TRANSPOSE_COPY_2D,
   CUNUMERIC_TRILU,
   CUNUMERIC_TRSM,
   CUNUMERIC_UNARY_OP,
   CUNUMERIC_UNARY_RED,
+  CUNUMERIC_UNIQUE,
   CUNUMERIC_UNLOAD_CUDALIBS,
   CUNUMERIC_WHERE,
   CUNUMERIC_WRITE,
@@ -59,15 +99,21 @@ enum CuNumericOpCode {
 
 // Match these to CuNumericRedopCode in config.py
 enum CuNumericRedopID {
-  CUNUMERIC_ARGMAX_REDOP = 1,
-  CUNUMERIC_ARGMIN_REDOP = 2,
+  CUNUMERIC_ARGMAX_REDOP     = 1,
+  CUNUMERIC_ARGMIN_REDOP     = 2,
+  CUNUMERIC_VARIANCE_REDOP   = 3,
+  CUNUMERIC_BINNED_SUM_REDOP = 4,
+  CUNUMERIC_NORM_REDOP       = 5,
+  CUNUMERIC_LOGSUMEXP_REDOP  = 6,
 };
 
 // Match these to CuNumericTunable in config.py
 enum CuNumericTunable {
-  CUNUMERIC_TUNABLE_NUM_GPUS         = 1,
-  CUNUMERIC_TUNABLE_NUM_PROCS        = 2,
-  CUNUMERIC_TUNABLE_MAX_EAGER_VOLUME = 3,
+  CUNUMERIC_TUNABLE_NUM_GPUS                 = 1,
+  CUNUMERIC_TUNABLE_NUM_PROCS                = 2,
+  CUNUMERIC_TUNABLE_MAX_EAGER_VOLUME         = 3,
+  CUNUMERIC_TUNABLE_MIN_CHOLESKY_TILE_SIZE   = 4,
+  CUNUMERIC_TUNABLE_MIN_CHOLESKY_MATRIX_SIZE = 5,
 };
 
 enum CuNumericBounds {
@@ -81,6 +127,16 @@ extern "C" {
 #endif
 
 void cunumeric_perform_registration();
+// Page-locks host memory so that copies between it and the GPUs run at full
+// speed, returning whether this call registered it
+int cunumeric_pin_host_memory(uint64_t ptr, size_t size);
+void cunumeric_unpin_host_memory(uint64_t ptr);
+// Writes the totals of the task bodies measured by a CUNUMERIC_ROOFLINE build to the file
+// as JSON, returning zero when they are not measured or the file can't be written
+int cunumeric_roofline_dump(const char* path);
+// Writes the peak instance and temporary memory of each task to the file as JSON when
+// CUNUMERIC_MEMORY_REPORT is set, returning zero when it is not or the file can't be written
+int cunumeric_memory_report(const char* path);
 
 #ifdef __cplusplus
 }
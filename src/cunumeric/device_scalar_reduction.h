@@ -0,0 +1,131 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+namespace detail {
+
+// How many elements a thread folds between two polls of the short-circuit flag
+static constexpr size_t SHORT_CIRCUIT_POLL_ITERS = 16;
+
+template <typename REDOP, bool SHORT_CIRCUIT, typename LHS, typename Output, typename Loader>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  scalar_reduction_kernel(size_t volume,
+                          Output out,
+                          Loader load,
+                          LHS identity,
+                          LHS absorbing,
+                          size_t iters,
+                          LHS* partials,
+                          unsigned int* ticket,
+                          volatile unsigned int* done)
+{
+  auto value = identity;
+  for (size_t idx = 0; idx < iters; idx++) {
+    // Once any thread has reached the absorbing value the rest of the input cannot
+    // change the result, so the remaining threads stop scanning
+    if constexpr (SHORT_CIRCUIT) {
+      if (idx % SHORT_CIRCUIT_POLL_ITERS == 0 && *done) break;
+    }
+    const size_t offset = (idx * gridDim.x + blockIdx.x) * blockDim.x + threadIdx.x;
+    if (offset < volume) REDOP::template fold<true>(value, load(offset));
+    if constexpr (SHORT_CIRCUIT) {
+      if (value == absorbing) {
+        *done = 1;
+        break;
+      }
+    }
+  }
+  value = block_reduce<REDOP>(value);
+
+  // Publish the partial of this block and count it in; the block that comes in last
+  // has all partials visible and finishes the reduction
+  __shared__ bool last_block;
+  if (threadIdx.x == 0) {
+    partials[blockIdx.x] = value;
+    __threadfence();
+    last_block = atomicAdd(ticket, 1) == gridDim.x - 1;
+  }
+  __syncthreads();
+  if (!last_block) return;
+
+  value = identity;
+  for (size_t idx = threadIdx.x; idx < gridDim.x; idx += blockDim.x)
+    REDOP::template fold<true>(value, partials[idx]);
+  value = block_reduce<REDOP>(value);
+  if (threadIdx.x == 0) out.reduce(0, value);
+}
+
+template <typename REDOP, bool SHORT_CIRCUIT, typename LHS, typename Output, typename Loader>
+void launch_scalar_reduction(
+  Output out, size_t volume, Loader load, LHS identity, LHS absorbing, cudaStream_t stream)
+{
+  if (volume == 0) return;
+
+  const size_t blocks   = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+  const size_t num_ctas = std::min<size_t>(blocks, get_max_reduction_ctas());
+  const size_t iters    = (blocks + num_ctas - 1) / num_ctas;
+
+  // The first word is the ticket of the last block and the second the short-circuit flag
+  ScratchBuffer<LHS> partials(num_ctas);
+  ScratchBuffer<unsigned int> counters(2);
+  auto ticket = counters.ptr(0);
+  auto done   = counters.ptr(1);
+
+  auto kernel = scalar_reduction_kernel<REDOP, SHORT_CIRCUIT, LHS, Output, Loader>;
+  std::vector<char> key;
+  append_key(key, kernel, volume, out, load, identity, absorbing, partials.ptr(0), ticket);
+  launch_captured(key, [&]() {
+    CHECK_CUDA(cudaMemsetAsync(ticket, 0, 2 * sizeof(unsigned int), stream));
+    kernel<<<num_ctas, THREADS_PER_BLOCK, 0, stream>>>(
+      volume, out, load, identity, absorbing, iters, partials.ptr(0), ticket, done);
+  });
+}
+
+}  // namespace detail
+
+// Reduces load(0), ..., load(volume - 1) with REDOP and folds the result into element 0
+// of out, which only needs a reduce(point, value) method. Each block reduces its share
+// with warp shuffles and the last block to finish folds the per-block partials, so the
+// whole reduction takes a single kernel launch.
+template <typename REDOP, typename LHS, typename Output, typename Loader>
+void device_scalar_reduction(Output out,
+                             size_t volume,
+                             Loader load,
+                             LHS identity,
+                             cudaStream_t stream)
+{
+  detail::launch_scalar_reduction<REDOP, false>(out, volume, load, identity, identity, stream);
+}
+
+// Same as device_scalar_reduction for reductions with an absorbing value, such as true for
+// a logical or. Threads stop reading the input as soon as any of them reaches it.
+template <typename REDOP, typename LHS, typename Output, typename Loader>
+void device_short_circuit_reduction(Output out,
+                                    size_t volume,
+                                    Loader load,
+                                    LHS identity,
+                                    LHS absorbing,
+                                    cudaStream_t stream)
+{
+  detail::launch_scalar_reduction<REDOP, true>(out, volume, load, identity, absorbing, stream);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,187 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#pragma once
+
+#include <cstdio>
+#include <utility>
+
+#include "legate.h"
+
+// Builds can restrict the element types and dimensions the task templates are
+// instantiated for, which shrinks the library and the time it takes to load.
+// Defining CUNUMERIC_MAX_DIM caps the dimension, and defining
+// CUNUMERIC_RESTRICT_TYPES keeps only the types whose CUNUMERIC_TYPE_<NAME>
+// macro is defined (e.g. CUNUMERIC_TYPE_DOUBLE). The task templates must
+// dispatch through the functions below for this to take effect.
+#ifndef CUNUMERIC_MAX_DIM
+#define CUNUMERIC_MAX_DIM LEGATE_MAX_DIM
+#endif
+
+namespace cunumeric {
+
+constexpr bool is_instantiated_type(legate::LegateTypeCode code)
+{
+#ifndef CUNUMERIC_RESTRICT_TYPES
+  return true;
+#else
+  switch (code) {
+#ifdef CUNUMERIC_TYPE_BOOL
+    case legate::LegateTypeCode::BOOL_LT:
+#endif
+#ifdef CUNUMERIC_TYPE_INT8
+    case legate::LegateTypeCode::INT8_LT:
+#endif
+#ifdef CUNUMERIC_TYPE_INT16
+    case legate::LegateTypeCode::INT16_LT:
+#endif
+#ifdef CUNUMERIC_TYPE_INT32
+    case legate::LegateTypeCode::INT32_LT:
+#endif
+#ifdef CUNUMERIC_TYPE_INT64
+    case legate::LegateTypeCode::INT64_LT:
+#endif
+#ifdef CUNUMERIC_TYPE_UINT8
+    case legate::LegateTypeCode::UINT8_LT:
+#endif
+#ifdef CUNUMERIC_TYPE_UINT16
+    case legate::LegateTypeCode::UINT16_LT:
+#endif
+#ifdef CUNUMERIC_TYPE_UINT32
+    case legate::LegateTypeCode::UINT32_LT:
+#endif
+#ifdef CUNUMERIC_TYPE_UINT64
+    case legate::LegateTypeCode::UINT64_LT:
+#endif
+#ifdef CUNUMERIC_TYPE_HALF
+    case legate::LegateTypeCode::HALF_LT:
+#endif
+#ifdef CUNUMERIC_TYPE_FLOAT
+    case legate::LegateTypeCode::FLOAT_LT:
+#endif
+#ifdef CUNUMERIC_TYPE_DOUBLE
+    case legate::LegateTypeCode::DOUBLE_LT:
+#endif
+#ifdef CUNUMERIC_TYPE_COMPLEX64
+    case legate::LegateTypeCode::COMPLEX64_LT:
+#endif
+#ifdef CUNUMERIC_TYPE_COMPLEX128
+    case legate::LegateTypeCode::COMPLEX128_LT:
+#endif
+      return true;
+    default: break;
+  }
+  return false;
+#endif
+}
+
+constexpr bool is_instantiated_dim(int dim) { return dim <= CUNUMERIC_MAX_DIM; }
+
+namespace detail {
+
+[[noreturn]] inline void missing_instantiation(const char* what, int32_t value)
+{
+  fprintf(stderr,
+          "cuNumeric was built without support for %s %d, rebuild it with that "
+          "%s enabled to run this operation\n",
+          what,
+          value,
+          what);
+  LEGATE_ABORT;
+}
+
+// Wrappers that only instantiate the wrapped functor for the enabled
+// combinations and abort on the others
+template <typename Functor>
+struct TypeDimDispatch {
+  template <legate::LegateTypeCode CODE, int DIM, typename... Fnargs>
+  auto operator()(Fnargs&&... args)
+    -> decltype(std::declval<Functor&>().template operator()<CODE, DIM>(
+      std::forward<Fnargs>(args)...))
+  {
+    if constexpr (!is_instantiated_type(CODE))
+      missing_instantiation("type code", static_cast<int32_t>(CODE));
+    else if constexpr (!is_instantiated_dim(DIM))
+      missing_instantiation("dimension", DIM);
+    else
+      return f.template operator()<CODE, DIM>(std::forward<Fnargs>(args)...);
+  }
+  Functor f;
+};
+
+template <typename Functor>
+struct DimDimDispatch {
+  template <int DIM1, int DIM2, typename... Fnargs>
+  auto operator()(Fnargs&&... args)
+    -> decltype(std::declval<Functor&>().template operator()<DIM1, DIM2>(
+      std::forward<Fnargs>(args)...))
+  {
+    if constexpr (!is_instantiated_dim(DIM1))
+      missing_instantiation("dimension", DIM1);
+    else if constexpr (!is_instantiated_dim(DIM2))
+      missing_instantiation("dimension", DIM2);
+    else
+      return f.template operator()<DIM1, DIM2>(std::forward<Fnargs>(args)...);
+  }
+  Functor f;
+};
+
+template <typename Functor>
+struct TypeDispatch {
+  template <legate::LegateTypeCode CODE, typename... Fnargs>
+  auto operator()(Fnargs&&... args)
+    -> decltype(std::declval<Functor&>().template operator()<CODE>(
+      std::forward<Fnargs>(args)...))
+  {
+    if constexpr (!is_instantiated_type(CODE))
+      missing_instantiation("type code", static_cast<int32_t>(CODE));
+    else
+      return f.template operator()<CODE>(std::forward<Fnargs>(args)...);
+  }
+  Functor f;
+};
+
+}  // namespace detail
+
+// These shadow the dispatch functions of legate.core and must be called with
+// their namespace, as argument dependent lookup would otherwise also find the
+// unrestricted ones
+template <typename Functor, typename... Fnargs>
+constexpr decltype(auto) double_dispatch(int dim,
+                                         legate::LegateTypeCode code,
+                                         Functor f,
+                                         Fnargs&&... args)
+{
+  return legate::double_dispatch(
+    dim, code, detail::TypeDimDispatch<Functor>{f}, std::forward<Fnargs>(args)...);
+}
+
+template <typename Functor, typename... Fnargs>
+constexpr decltype(auto) double_dispatch(int dim1, int dim2, Functor f, Fnargs&&... args)
+{
+  return legate::double_dispatch(
+    dim1, dim2, detail::DimDimDispatch<Functor>{f}, std::forward<Fnargs>(args)...);
+}
+
+template <typename Functor, typename... Fnargs>
+constexpr decltype(auto) type_dispatch(legate::LegateTypeCode code, Functor f, Fnargs&&... args)
+{
+  return legate::type_dispatch(
+    code, detail::TypeDispatch<Functor>{f}, std::forward<Fnargs>(args)...);
+}
+
+}  // namespace cunumeric
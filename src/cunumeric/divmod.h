@@ -426,9 +426,14 @@ struct FastDivmodU64 {
     uint64_t x = dividend;
     if (multiplier) { x = __umul64hi(dividend + round_up, multiplier); }
     quotient = (x >> shift_right);
+#elif defined(__SIZEOF_INT128__)
+    uint64_t x = dividend;
+    if (multiplier) {
+      x = static_cast<uint64_t>(
+        (static_cast<unsigned __int128>(dividend + round_up) * multiplier) >> 64);
+    }
+    quotient = (x >> shift_right);
 #else
-    // TODO - use proper 'fast' division here also. No reason why x86-code
-    // shouldn't be optimized.
     quotient = dividend / divisor;
 #endif
 
@@ -439,7 +444,7 @@ struct FastDivmodU64 {
   __CUDA_HD__
   inline uint64_t modulus(uint64_t quotient, uint64_t dividend) const
   {
-    return uint32_t(dividend - quotient * divisor);
+    return dividend - quotient * divisor;
   }
 
   /// Returns the quotient of floor(dividend / divisor) and computes the
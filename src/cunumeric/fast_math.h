@@ -0,0 +1,299 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "legate.h"
+
+// Single precision transcendental functions that give up a few ULPs for speed. Element-wise
+// ops use them for float32 when asked to, either per call or with CUNUMERIC_FAST_MATH.
+//
+// On the GPU these are the hardware intrinsics. On the CPU they are branch-free polynomials
+// in the style of Cephes that the simd loops vectorize, which libm calls never do. The
+// largest errors measured against double precision are
+//
+//   exp   1.1 ULP on the CPU, 2 + 1.2 * |x| ULP with __expf
+//   log   0.9 ULP on the CPU, 2^-21.41 absolute with __logf for x in [0.5, 2]
+//   sin   1.5 ULP on the CPU for |x| < pi, 2^-21.41 absolute with __sinf for |x| < pi
+//   cos   1.6 ULP on the CPU for |x| < pi, 2^-21.19 absolute with __cosf for |x| < pi
+//   tanh  1.4 ULP on the CPU, 2^-10.99 relative with the tanh.approx instruction of sm_75+
+//   power that of exp(y * log(x)), up to 2 ULP per unit of |y * log(x)| in both variants
+//
+// For larger |x| the error of sin and cos stays under 2^-23 absolute up to 10^6 on the CPU;
+// beyond that the argument reduction runs out of bits. Over- and underflow saturate to
+// infinity and zero, and NaNs and infinities come out as with the precise functions.
+
+namespace cunumeric {
+
+// Whether the op was asked to use its fast-math variant, which the element-wise tasks
+// pass as a boolean in their first extra argument
+inline bool use_fast_math(const std::vector<legate::Store>& args)
+{
+  return !args.empty() && args[0].scalar<bool>();
+}
+
+namespace fast_math {
+
+__CUDA_HD__ inline float from_bits(int32_t bits)
+{
+  float value;
+  memcpy(&value, &bits, sizeof(float));
+  return value;
+}
+
+__CUDA_HD__ inline int32_t to_bits(float value)
+{
+  int32_t bits;
+  memcpy(&bits, &value, sizeof(float));
+  return bits;
+}
+
+// The CPU functions pick between values with masks rather than conditionals and combine
+// conditions with bitwise operators, as GCC won't if-convert floating point comparisons
+// under its default -ftrapping-math and the loops would not vectorize
+__CUDA_HD__ inline float select(bool condition, float a, float b)
+{
+  const int32_t mask = -static_cast<int32_t>(condition);
+  return from_bits((to_bits(a) & mask) | (to_bits(b) & ~mask));
+}
+
+__CUDA_HD__ inline float flip_sign(bool condition, float x)
+{
+  return from_bits(to_bits(x) ^ (static_cast<int32_t>(condition) << 31));
+}
+
+// Rounds to the nearest integer for |x| < 2^22, which unlike roundf vectorizes everywhere
+__CUDA_HD__ inline float round_nearest(float x)
+{
+  constexpr float SHIFT = 12582912.f;  // 1.5 * 2^23
+  return (x + SHIFT) - SHIFT;
+}
+
+// exp(x) = 2^n * exp(r) with |r| <= ln(2) / 2, after Cephes' expf
+__CUDA_HD__ inline float exp(float x)
+{
+#ifdef __CUDA_ARCH__
+  return __expf(x);
+#else
+  constexpr float LOG2E = 1.44269504088896341f;
+  // ln(2) in two parts, the first of which has few enough bits to make n * LN2_HI exact
+  constexpr float LN2_HI = 0.693359375f;
+  constexpr float LN2_LO = -2.12194440e-4f;
+  float n                = round_nearest(x * LOG2E);
+  // Keep 2^n representable in the two factors below, which also maps NaN to the bottom
+  n             = select(n > -150.f, n, -150.f);
+  n             = select(n < 128.f, n, 128.f);
+  const float r = (x - n * LN2_HI) - n * LN2_LO;
+  float p       = 1.9875691500e-4f;
+  p             = p * r + 1.3981999507e-3f;
+  p             = p * r + 8.3334519073e-3f;
+  p             = p * r + 4.1665795894e-2f;
+  p             = p * r + 1.6666665459e-1f;
+  p             = p * r + 5.0000001201e-1f;
+  p             = p * r * r + r + 1.0f;
+  // 2^n is split in two factors so that the subnormal results need no exponent below the
+  // normal ones
+  const int32_t e    = static_cast<int32_t>(n);
+  const float scale1 = from_bits(((e >> 1) + 127) << 23);
+  const float scale0 = from_bits(((e - (e >> 1)) + 127) << 23);
+  float result       = p * scale0 * scale1;
+  result             = select(x > 88.7228394f, std::numeric_limits<float>::infinity(), result);
+  result             = select(x < -103.972084f, 0.f, result);
+  return select(x != x, x, result);
+#endif
+}
+
+// log(x) = e * ln(2) + log(m) with m in [sqrt(1/2), sqrt(2)), after Cephes' logf
+__CUDA_HD__ inline float log(float x)
+{
+#ifdef __CUDA_ARCH__
+  return __logf(x);
+#else
+  // Subnormal inputs are brought into the normal range first
+  const bool subnormal = x < std::numeric_limits<float>::min();
+  const int32_t bits   = to_bits(select(subnormal, x * 16777216.f, x));
+  // Take m from [0.5, 1) and move the ones below sqrt(1/2) up an octave
+  const float half = from_bits((bits & 0x807fffff) | 0x3f000000);
+  const bool small = half < 0.707106781186547524f;
+  const int32_t e  = ((bits >> 23) & 0xff) - 126 - 24 * subnormal - small;
+  const float z    = select(small, half + half, half) - 1.0f;
+  const float fe   = static_cast<float>(e);
+  const float zz   = z * z;
+  float y          = 7.0376836292e-2f;
+  y                = y * z - 1.1514610310e-1f;
+  y                = y * z + 1.1676998740e-1f;
+  y                = y * z - 1.2420140846e-1f;
+  y                = y * z + 1.4249322787e-1f;
+  y                = y * z - 1.6668057665e-1f;
+  y                = y * z + 2.0000714765e-1f;
+  y                = y * z - 2.4999993993e-1f;
+  y                = y * z + 3.3333331174e-1f;
+  y                = y * z * zz;
+  y += fe * -2.12194440e-4f;
+  y += -0.5f * zz;
+  float result = z + y + fe * 0.693359375f;
+  result       = select(x == 0.f, -std::numeric_limits<float>::infinity(), result);
+  result       = select(x == std::numeric_limits<float>::infinity(), x, result);
+  return select((x < 0.f) | (x != x), std::numeric_limits<float>::quiet_NaN(), result);
+#endif
+}
+
+// sin and cos reduce x by the nearest multiple q of pi/2 and evaluate the polynomials of
+// Cephes' sinf and cosf over [-pi/4, pi/4], whose roles and signs depend on q mod 4
+__CUDA_HD__ inline float reduce_quadrant(float x, int32_t& quadrant)
+{
+  constexpr float TWO_OVER_PI = 0.636619772367581343f;
+  // pi/2 in three parts, the first two of which have few enough bits to be multiplied
+  // by q exactly
+  constexpr float PIO2_1 = 1.5703125f;
+  constexpr float PIO2_2 = 4.837512969970703125e-4f;
+  constexpr float PIO2_3 = 7.54978995489188216e-8f;
+  float q                = round_nearest(x * TWO_OVER_PI);
+  // Beyond this the reduction is meaningless anyway, and NaN goes to the bottom
+  q        = select(q > -4194304.f, q, -4194304.f);
+  q        = select(q < 4194304.f, q, 4194304.f);
+  quadrant = static_cast<int32_t>(q);
+  return ((x - q * PIO2_1) - q * PIO2_2) - q * PIO2_3;
+}
+
+__CUDA_HD__ inline float sin_poly(float r)
+{
+  const float z = r * r;
+  float p       = -1.9515295891e-4f;
+  p             = p * z + 8.3321608736e-3f;
+  p             = p * z - 1.6666654611e-1f;
+  return r + r * z * p;
+}
+
+__CUDA_HD__ inline float cos_poly(float r)
+{
+  const float z = r * r;
+  float p       = 2.443315711809948e-5f;
+  p             = p * z - 1.388731625493765e-3f;
+  p             = p * z + 4.166664568298827e-2f;
+  return 1.0f - 0.5f * z + z * z * p;
+}
+
+__CUDA_HD__ inline float sin(float x)
+{
+#ifdef __CUDA_ARCH__
+  return __sinf(x);
+#else
+  int32_t quadrant;
+  const float r = reduce_quadrant(x, quadrant);
+  float result  = select(quadrant & 1, cos_poly(r), sin_poly(r));
+  result        = flip_sign(quadrant & 2, result);
+  // Infinities and NaNs give NaN
+  return select(x - x == 0.f, result, std::numeric_limits<float>::quiet_NaN());
+#endif
+}
+
+__CUDA_HD__ inline float cos(float x)
+{
+#ifdef __CUDA_ARCH__
+  return __cosf(x);
+#else
+  int32_t quadrant;
+  const float r = reduce_quadrant(x, quadrant);
+  float result  = select(quadrant & 1, sin_poly(r), cos_poly(r));
+  result        = flip_sign((quadrant + 1) & 2, result);
+  // Infinities and NaNs give NaN
+  return select(x - x == 0.f, result, std::numeric_limits<float>::quiet_NaN());
+#endif
+}
+
+// tanh is Cephes' odd polynomial below 0.625 and 1 - 2 / (exp(2|x|) + 1) above it
+__CUDA_HD__ inline float tanh(float x)
+{
+#if defined(__CUDA_ARCH__) && __CUDA_ARCH__ >= 750
+  float result;
+  asm("tanh.approx.f32 %0, %1;" : "=f"(result) : "f"(x));
+  return result;
+#elif defined(__CUDA_ARCH__)
+  return ::tanhf(x);
+#else
+  const float a = from_bits(to_bits(x) & 0x7fffffff);
+  const float z = x * x;
+  float p       = -5.70498872745e-3f;
+  p             = p * z + 2.06390887954e-2f;
+  p             = p * z - 5.37397155531e-2f;
+  p             = p * z + 1.33314422036e-1f;
+  p             = p * z - 3.33332819422e-1f;
+  const float small  = p * z * x + x;
+  const float large  = flip_sign(x < 0.f, 1.0f - 2.0f / (exp(a + a) + 1.0f));
+  const float result = select(a < 0.625f, small, large);
+  return select(x != x, x, result);
+#endif
+}
+
+// pow(x, y) = exp(y * log(|x|)), with the sign and the special cases of powf patched in
+__CUDA_HD__ inline float pow(float x, float y)
+{
+#ifdef __CUDA_ARCH__
+  return x > 0.f ? __powf(x, y) : ::powf(x, y);
+#else
+  constexpr float INF = std::numeric_limits<float>::infinity();
+  constexpr float NaN = std::numeric_limits<float>::quiet_NaN();
+  constexpr float BIG = 4194304.f;  // 2^22, above which every float is an even integer
+  const float a       = from_bits(to_bits(x) & 0x7fffffff);
+  float result        = exp(y * log(a));
+  // Zero and infinite bases
+  result = select(a == 0.f, select(y < 0.f, INF, 0.f), result);
+  result = select(a == INF, select(y < 0.f, 0.f, INF), result);
+  // Negative bases only have real powers for integer exponents, where odd ones flip the sign
+  const bool large   = !((y > -BIG) & (y < BIG));
+  const bool integer = large | (round_nearest(y) == y);
+  const float half   = y * 0.5f;
+  const bool odd     = !large & integer & (round_nearest(half) != half);
+  result             = flip_sign((to_bits(x) < 0) & odd, result);
+  result             = select(((x < 0.f) & !integer) | (x != x) | (y != y), NaN, result);
+  return select((y == 0.f) | (x == 1.f), 1.f, result);
+#endif
+}
+
+}  // namespace fast_math
+
+// Ops with a fast-math variant say so with FAST_MATH, keep whether it was asked for in fast,
+// and have their fast variant as the stateless functor FastOp
+template <typename OP, typename = void>
+struct has_fast_math : std::false_type {
+};
+
+template <typename OP>
+struct has_fast_math<OP, std::void_t<decltype(OP::FAST_MATH)>>
+  : std::integral_constant<bool, OP::FAST_MATH> {
+};
+
+// Calls the body with the fast-math variant of the op when it is asked for and with the op
+// itself otherwise. Dense loops on the CPU go through this so that they pick the variant
+// once and can vectorize, rather than branching on every element.
+template <typename OP, typename Body>
+void with_fast_math(const OP& op, Body&& body)
+{
+  if constexpr (has_fast_math<OP>::value)
+    if (op.fast) {
+      body(typename OP::FastOp{});
+      return;
+    }
+  body(op);
+}
+
+}  // namespace cunumeric
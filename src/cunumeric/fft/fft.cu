@@ -0,0 +1,250 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/fft/fft.h"
+#include "cunumeric/fft/fft_template.inl"
+
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+// The cuFFT transform that goes between two types of elements
+template <typename IN, typename OUT>
+struct CuFFTExec;
+
+template <>
+struct CuFFTExec<cufftComplex, cufftComplex> {
+  static constexpr cufftType TYPE = CUFFT_C2C;
+  static void execute(cufftHandle plan, cufftComplex* in, cufftComplex* out, int direction)
+  {
+    CHECK_CUFFT(cufftExecC2C(plan, in, out, direction));
+  }
+};
+
+template <>
+struct CuFFTExec<cufftDoubleComplex, cufftDoubleComplex> {
+  static constexpr cufftType TYPE = CUFFT_Z2Z;
+  static void execute(cufftHandle plan,
+                      cufftDoubleComplex* in,
+                      cufftDoubleComplex* out,
+                      int direction)
+  {
+    CHECK_CUFFT(cufftExecZ2Z(plan, in, out, direction));
+  }
+};
+
+template <>
+struct CuFFTExec<cufftReal, cufftComplex> {
+  static constexpr cufftType TYPE = CUFFT_R2C;
+  static void execute(cufftHandle plan, cufftReal* in, cufftComplex* out, int)
+  {
+    CHECK_CUFFT(cufftExecR2C(plan, in, out));
+  }
+};
+
+template <>
+struct CuFFTExec<cufftDoubleReal, cufftDoubleComplex> {
+  static constexpr cufftType TYPE = CUFFT_D2Z;
+  static void execute(cufftHandle plan, cufftDoubleReal* in, cufftDoubleComplex* out, int)
+  {
+    CHECK_CUFFT(cufftExecD2Z(plan, in, out));
+  }
+};
+
+template <>
+struct CuFFTExec<cufftComplex, cufftReal> {
+  static constexpr cufftType TYPE = CUFFT_C2R;
+  static void execute(cufftHandle plan, cufftComplex* in, cufftReal* out, int)
+  {
+    CHECK_CUFFT(cufftExecC2R(plan, in, out));
+  }
+};
+
+template <>
+struct CuFFTExec<cufftDoubleComplex, cufftDoubleReal> {
+  static constexpr cufftType TYPE = CUFFT_Z2D;
+  static void execute(cufftHandle plan, cufftDoubleComplex* in, cufftDoubleReal* out, int)
+  {
+    CHECK_CUFFT(cufftExecZ2D(plan, in, out));
+  }
+};
+
+// Element types of cuFFT in each precision
+template <typename T>
+struct CuFFTTypes;
+
+template <>
+struct CuFFTTypes<float> {
+  using REAL    = cufftReal;
+  using COMPLEX = cufftComplex;
+};
+
+template <>
+struct CuFFTTypes<double> {
+  using REAL    = cufftDoubleReal;
+  using COMPLEX = cufftDoubleComplex;
+};
+
+template <typename DST, typename ACC, int DIM>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  gather_kernel(size_t volume, DST* dst, ACC src, Pitches<DIM - 1> pitches, Point<DIM> lo)
+{
+  const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx >= volume) return;
+  dst[idx] = src[pitches.unflatten(idx, lo)];
+}
+
+template <typename ACC, typename SRC, typename T, int DIM>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  scatter_kernel(
+    size_t volume, ACC dst, const SRC* src, T scale, Pitches<DIM - 1> pitches, Point<DIM> lo)
+{
+  const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx >= volume) return;
+  dst[pitches.unflatten(idx, lo)] = src[idx] * scale;
+}
+
+// Transforms the lines along one axis of a dense row-major buffer with a batched plan.
+// The lengths of the lines on either side differ for real transforms, which are n on the
+// real side and n / 2 + 1 on the complex side. Lines along the last axis are contiguous
+// and go to a single call, and the lines of any other axis are strided and go to one call
+// per index of the axes before it. The plan runs on the stream of the task.
+template <typename IN, typename OUT>
+static void cufft_lines(IN* in,
+                        OUT* out,
+                        long long n,
+                        long long in_length,
+                        long long out_length,
+                        size_t inner,
+                        size_t outer,
+                        bool inverse)
+{
+  const bool contiguous = inner == 1;
+  long long batch       = contiguous ? outer : inner;
+  long long stride      = contiguous ? 1 : inner;
+  long long in_dist     = contiguous ? in_length : 1;
+  long long out_dist    = contiguous ? out_length : 1;
+  const size_t calls    = contiguous ? 1 : outer;
+
+  auto plan = get_cufft_plan(CuFFTPlanParams(CuFFTExec<IN, OUT>::TYPE,
+                                             n,
+                                             in_length,
+                                             stride,
+                                             in_dist,
+                                             out_length,
+                                             stride,
+                                             out_dist,
+                                             batch));
+
+  const int direction = inverse ? CUFFT_INVERSE : CUFFT_FORWARD;
+  for (size_t call = 0; call < calls; ++call)
+    CuFFTExec<IN, OUT>::execute(
+      plan, in + call * in_length * inner, out + call * out_length * inner, direction);
+}
+
+template <int DIM>
+static void lines_of(const Rect<DIM>& rect, int32_t axis, size_t& inner, size_t& outer)
+{
+  inner = 1;
+  outer = 1;
+  for (int32_t dim = 0; dim < axis; ++dim) outer *= rect.hi[dim] - rect.lo[dim] + 1;
+  for (int32_t dim = axis + 1; dim < DIM; ++dim) inner *= rect.hi[dim] - rect.lo[dim] + 1;
+}
+
+template <FFTType TYPE, LegateTypeCode CODE, int DIM>
+struct FFTImplBody<VariantKind::GPU, TYPE, CODE, DIM> {
+  using IN      = typename FFTTypes<TYPE, CODE>::IN;
+  using OUT     = typename FFTTypes<TYPE, CODE>::OUT;
+  using T       = typename FFTTypes<TYPE, CODE>::REAL;
+  using REAL    = typename CuFFTTypes<T>::REAL;
+  using COMPLEX = typename CuFFTTypes<T>::COMPLEX;
+
+  void operator()(const AccessorWO<OUT, DIM>& out,
+                  const AccessorRO<IN, DIM>& in,
+                  const Rect<DIM>& out_rect,
+                  const Rect<DIM>& in_rect,
+                  Span<const int32_t> axes,
+                  bool inverse,
+                  double scale) const
+  {
+    auto stream = get_cached_stream();
+
+    // Like on the CPU, the transform runs on a dense buffer in the shape of the complex
+    // side, and the real side of a real transform gets a dense buffer of its own
+    const auto& rect = TYPE == FFTType::C2R ? in_rect : out_rect;
+    Pitches<DIM - 1> pitches;
+    const size_t volume = pitches.flatten(rect);
+    ScratchBuffer<complex<T>> buffer(volume);
+    auto work = reinterpret_cast<COMPLEX*>(buffer.ptr(0));
+
+    const auto& real_rect = TYPE == FFTType::C2R ? out_rect : in_rect;
+    Pitches<DIM - 1> real_pitches;
+    const size_t real_volume = TYPE == FFTType::C2C ? 0 : real_pitches.flatten(real_rect);
+    ScratchBuffer<T> real_buffer(real_volume);
+    auto real = reinterpret_cast<REAL*>(real_buffer.ptr(0));
+
+    const int32_t last = axes[axes.size() - 1];
+    size_t inner, outer;
+    lines_of(rect, last, inner, outer);
+    const long long n           = real_rect.hi[last] - real_rect.lo[last] + 1;
+    const long long half_length = rect.hi[last] - rect.lo[last] + 1;
+
+    if constexpr (TYPE == FFTType::R2C) {
+      const size_t blocks = (real_volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+      gather_kernel<T, AccessorRO<IN, DIM>, DIM><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+        real_volume, real_buffer.ptr(0), in, real_pitches, real_rect.lo);
+      cufft_lines(real, work, n, n, half_length, inner, outer, inverse);
+    } else {
+      const size_t blocks = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+      gather_kernel<complex<T>, AccessorRO<IN, DIM>, DIM>
+        <<<blocks, THREADS_PER_BLOCK, 0, stream>>>(volume, buffer.ptr(0), in, pitches, rect.lo);
+    }
+
+    for (size_t idx = 0; idx < axes.size(); ++idx) {
+      const int32_t axis = axes[idx];
+      if (TYPE != FFTType::C2C && axis == last) continue;
+      const long long length = rect.hi[axis] - rect.lo[axis] + 1;
+      if (length == 1) continue;
+      size_t axis_inner, axis_outer;
+      lines_of(rect, axis, axis_inner, axis_outer);
+      cufft_lines(work, work, length, length, length, axis_inner, axis_outer, inverse);
+    }
+
+    const T factor = static_cast<T>(scale);
+    if constexpr (TYPE == FFTType::C2R) {
+      // cuFFT only reads the first n / 2 + 1 coefficients and overwrites them
+      cufft_lines(work, real, n, half_length, n, inner, outer, inverse);
+      const size_t blocks = (real_volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+      scatter_kernel<AccessorWO<OUT, DIM>, T, T, DIM><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+        real_volume, out, real_buffer.ptr(0), factor, real_pitches, real_rect.lo);
+    } else {
+      const size_t blocks = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+      scatter_kernel<AccessorWO<OUT, DIM>, complex<T>, T, DIM>
+        <<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+          volume, out, buffer.ptr(0), factor, pitches, rect.lo);
+    }
+  }
+};
+
+/*static*/ void FFTTask::gpu_variant(TaskContext& context)
+{
+  fft_template<VariantKind::GPU>(context);
+}
+
+}  // namespace cunumeric
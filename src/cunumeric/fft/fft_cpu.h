@@ -0,0 +1,261 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "cunumeric/fft/fft_util.h"
+#include "cunumeric/pitches.h"
+
+#include <cmath>
+#include <complex>
+#include <vector>
+
+namespace cunumeric {
+
+// A one-dimensional transform of n points. Powers of two are transformed with an
+// iterative radix-2 Cooley-Tukey algorithm. Any other size is turned into a cyclic
+// convolution with a chirp on the next power of two that holds 2 n - 1 points
+// (Bluestein's algorithm), so that every size takes O(n log n) time.
+template <typename T>
+class FFTPlan1D {
+ public:
+  using C = std::complex<T>;
+
+  FFTPlan1D(size_t n, bool inverse) : n_(n), inverse_(inverse), size_(1)
+  {
+    while (size_ < n_) size_ <<= 1;
+    if (size_ != n_)
+      while (size_ < 2 * n_ - 1) size_ <<= 1;
+
+    twiddles_.resize(size_ / 2);
+    for (size_t k = 0; k < size_ / 2; ++k)
+      twiddles_[k] = unit(-static_cast<double>(k) / static_cast<double>(size_));
+    if (size_ == n_) return;
+
+    // The angles are reduced modulo a full turn before they are scaled, which keeps the
+    // chirp accurate for large n
+    const double sign = inverse_ ? 1.0 : -1.0;
+    chirp_.resize(n_);
+    for (size_t k = 0; k < n_; ++k)
+      chirp_[k] = unit(sign * static_cast<double>(k * k % (2 * n_)) / static_cast<double>(2 * n_));
+
+    // The transform of the filter of the convolution, with the normalization of the
+    // inverse transform folded in
+    kernel_.assign(size_, C(0));
+    kernel_[0] = std::conj(chirp_[0]);
+    for (size_t k = 1; k < n_; ++k) kernel_[k] = kernel_[size_ - k] = std::conj(chirp_[k]);
+    radix2(kernel_.data(), false);
+    const T norm = T(1) / static_cast<T>(size_);
+    for (auto& value : kernel_) value *= norm;
+  }
+
+  // Number of complex values of scratch space that execute needs
+  size_t scratch_size() const { return size_ == n_ ? 0 : size_; }
+
+  // Transforms the n contiguous values at data in place. The inverse is not normalized.
+  void execute(C* data, C* scratch) const
+  {
+    if (size_ == n_) {
+      radix2(data, inverse_);
+      return;
+    }
+    for (size_t k = 0; k < n_; ++k) scratch[k] = mul(data[k], chirp_[k]);
+    for (size_t k = n_; k < size_; ++k) scratch[k] = C(0);
+    radix2(scratch, false);
+    for (size_t k = 0; k < size_; ++k) scratch[k] = mul(scratch[k], kernel_[k]);
+    radix2(scratch, true);
+    for (size_t k = 0; k < n_; ++k) data[k] = mul(scratch[k], chirp_[k]);
+  }
+
+ private:
+  static C unit(double turns)
+  {
+    const double angle = 2.0 * M_PI * turns;
+    return C(static_cast<T>(std::cos(angle)), static_cast<T>(std::sin(angle)));
+  }
+
+  // The operator of std::complex checks for infinities, which keeps it from vectorizing
+  static C mul(const C& a, const C& b)
+  {
+    return C(a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real());
+  }
+
+  void radix2(C* data, bool inverse) const
+  {
+    for (size_t i = 1, j = 0; i < size_; ++i) {
+      size_t bit = size_ >> 1;
+      for (; j & bit; bit >>= 1) j ^= bit;
+      j ^= bit;
+      if (i < j) std::swap(data[i], data[j]);
+    }
+    for (size_t len = 2; len <= size_; len <<= 1) {
+      const size_t half = len / 2;
+      const size_t step = size_ / len;
+      for (size_t i = 0; i < size_; i += len)
+        for (size_t j = 0; j < half; ++j) {
+          const C& twiddle = twiddles_[j * step];
+          const C u        = data[i + j];
+          const C v = mul(data[i + j + half], inverse ? std::conj(twiddle) : twiddle);
+          data[i + j]        = u + v;
+          data[i + j + half] = u - v;
+        }
+    }
+  }
+
+  size_t n_;
+  bool inverse_;
+  size_t size_;
+  std::vector<C> twiddles_;
+  std::vector<C> chirp_;
+  std::vector<C> kernel_;
+};
+
+// The lines along one axis of a dense row-major buffer. The values of a line are
+// inner apart and consecutive lines of the same outer index are adjacent.
+template <int DIM>
+struct FFTLines {
+  FFTLines(const Legion::Rect<DIM>& rect, int32_t axis) : inner(1), outer(1)
+  {
+    length = rect.hi[axis] - rect.lo[axis] + 1;
+    for (int32_t dim = 0; dim < axis; ++dim) outer *= rect.hi[dim] - rect.lo[dim] + 1;
+    for (int32_t dim = axis + 1; dim < DIM; ++dim) inner *= rect.hi[dim] - rect.lo[dim] + 1;
+  }
+
+  size_t count() const { return outer * inner; }
+  size_t offset(size_t line) const { return line / inner * length * inner + line % inner; }
+
+  size_t length;
+  size_t inner;
+  size_t outer;
+};
+
+// Hands out the items of a loop to the threads of a variant, each of which gets its own
+// scratch space of the given number of complex values. The OpenMP variant specializes
+// this for its threads.
+template <VariantKind KIND, typename T>
+struct FFTLoop;
+
+template <typename T>
+struct FFTLoop<VariantKind::CPU, T> {
+  static constexpr Legion::Memory::Kind MEMORY = Legion::Memory::Kind::SYSTEM_MEM;
+
+  template <typename Kernel>
+  void operator()(size_t items, size_t scratch_size, Kernel&& kernel) const
+  {
+    std::vector<std::complex<T>> scratch(scratch_size);
+    for (size_t item = 0; item < items; ++item) kernel(item, scratch.data());
+  }
+};
+
+// Transforms all the lines of a dense buffer along an axis
+template <VariantKind KIND, typename T, int DIM>
+static void fft_axis(std::complex<T>* work,
+                     const Legion::Rect<DIM>& rect,
+                     int32_t axis,
+                     bool inverse)
+{
+  FFTLines<DIM> lines(rect, axis);
+  if (lines.length == 1) return;
+
+  const FFTPlan1D<T> plan(lines.length, inverse);
+  const size_t length = lines.length;
+  FFTLoop<KIND, T>{}(
+    lines.count(), length + plan.scratch_size(), [&](size_t line, std::complex<T>* scratch) {
+      auto data = work + lines.offset(line);
+      for (size_t k = 0; k < length; ++k) scratch[k] = data[k * lines.inner];
+      plan.execute(scratch, scratch + length);
+      for (size_t k = 0; k < length; ++k) data[k * lines.inner] = scratch[k];
+    });
+}
+
+// Multi-dimensional transforms on the CPU, shared by the CPU and OpenMP variants. The
+// transform runs on a dense buffer in the shape of the complex side, one axis at a time.
+// A real-to-complex transform turns the lines along its last axis into their first n / 2
+// + 1 coefficients before the complex axes, and a complex-to-real one rebuilds the other
+// half from the Hermitian symmetry after them.
+template <VariantKind KIND, FFTType TYPE, legate::LegateTypeCode CODE, int DIM>
+static void cpu_fft(
+  const legate::AccessorWO<typename FFTTypes<TYPE, CODE>::OUT, DIM>& out,
+  const legate::AccessorRO<typename FFTTypes<TYPE, CODE>::IN, DIM>& in,
+  const Legion::Rect<DIM>& out_rect,
+  const Legion::Rect<DIM>& in_rect,
+  legate::Span<const int32_t> axes,
+  bool inverse,
+  double scale)
+{
+  using T    = typename FFTTypes<TYPE, CODE>::REAL;
+  using OUT  = typename FFTTypes<TYPE, CODE>::OUT;
+  using C    = std::complex<T>;
+  using Loop = FFTLoop<KIND, T>;
+
+  const auto& rect = TYPE == FFTType::C2R ? in_rect : out_rect;
+  Pitches<DIM - 1> pitches;
+  const size_t volume = pitches.flatten(rect);
+  auto buffer         = create_buffer<C>(volume, Loop::MEMORY);
+  auto work           = buffer.ptr(0);
+
+  const int32_t last = axes[axes.size() - 1];
+  if constexpr (TYPE == FFTType::R2C) {
+    Pitches<DIM - 1> in_pitches;
+    in_pitches.flatten(in_rect);
+    FFTLines<DIM> in_lines(in_rect, last);
+    FFTLines<DIM> lines(rect, last);
+    const size_t n = in_lines.length;
+    const FFTPlan1D<T> plan(n, inverse);
+    Loop{}(lines.count(), n + plan.scratch_size(), [&](size_t line, C* scratch) {
+      const size_t in_offset = in_lines.offset(line);
+      for (size_t k = 0; k < n; ++k)
+        scratch[k] = C(in[in_pitches.unflatten(in_offset + k * in_lines.inner, in_rect.lo)], 0);
+      plan.execute(scratch, scratch + n);
+      auto data = work + lines.offset(line);
+      for (size_t k = 0; k < lines.length; ++k) data[k * lines.inner] = scratch[k];
+    });
+  } else
+    Loop{}(volume, 0, [&](size_t idx, C*) {
+      const auto value = in[pitches.unflatten(idx, rect.lo)];
+      work[idx]        = C(value.real(), value.imag());
+    });
+
+  for (size_t idx = 0; idx < axes.size(); ++idx)
+    if (TYPE == FFTType::C2C || axes[idx] != last)
+      fft_axis<KIND, T, DIM>(work, rect, axes[idx], inverse);
+
+  const T factor = static_cast<T>(scale);
+  if constexpr (TYPE == FFTType::C2R) {
+    Pitches<DIM - 1> out_pitches;
+    out_pitches.flatten(out_rect);
+    FFTLines<DIM> out_lines(out_rect, last);
+    FFTLines<DIM> lines(rect, last);
+    const size_t n = out_lines.length;
+    const FFTPlan1D<T> plan(n, inverse);
+    Loop{}(lines.count(), n + plan.scratch_size(), [&](size_t line, C* scratch) {
+      auto data = work + lines.offset(line);
+      for (size_t k = 0; k < lines.length; ++k) scratch[k] = data[k * lines.inner];
+      for (size_t k = lines.length; k < n; ++k) scratch[k] = std::conj(scratch[n - k]);
+      plan.execute(scratch, scratch + n);
+      const size_t out_offset = out_lines.offset(line);
+      for (size_t k = 0; k < n; ++k)
+        out[out_pitches.unflatten(out_offset + k * out_lines.inner, out_rect.lo)] =
+          scratch[k].real() * factor;
+    });
+  } else
+    Loop{}(volume, 0, [&](size_t idx, C*) {
+      const C value                        = work[idx] * factor;
+      out[pitches.unflatten(idx, rect.lo)] = OUT(value.real(), value.imag());
+    });
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,48 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/fft/fft.h"
+#include "cunumeric/fft/fft_template.inl"
+#include "cunumeric/fft/fft_omp.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <FFTType TYPE, LegateTypeCode CODE, int DIM>
+struct FFTImplBody<VariantKind::OMP, TYPE, CODE, DIM> {
+  using IN  = typename FFTTypes<TYPE, CODE>::IN;
+  using OUT = typename FFTTypes<TYPE, CODE>::OUT;
+
+  void operator()(const AccessorWO<OUT, DIM>& out,
+                  const AccessorRO<IN, DIM>& in,
+                  const Rect<DIM>& out_rect,
+                  const Rect<DIM>& in_rect,
+                  Span<const int32_t> axes,
+                  bool inverse,
+                  double scale) const
+  {
+    cpu_fft<VariantKind::OMP, TYPE, CODE, DIM>(out, in, out_rect, in_rect, axes, inverse, scale);
+  }
+};
+
+/*static*/ void FFTTask::omp_variant(TaskContext& context)
+{
+  fft_template<VariantKind::OMP>(context);
+}
+
+}  // namespace cunumeric
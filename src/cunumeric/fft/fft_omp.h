@@ -0,0 +1,42 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "cunumeric/fft/fft_cpu.h"
+
+#include <omp.h>
+
+namespace cunumeric {
+
+// The loops of the OpenMP variants split their items statically over the threads
+template <typename T>
+struct FFTLoop<VariantKind::OMP, T> {
+  static constexpr Legion::Memory::Kind MEMORY = Legion::Memory::Kind::SOCKET_MEM;
+
+  template <typename Kernel>
+  void operator()(size_t items, size_t scratch_size, Kernel&& kernel) const
+  {
+#pragma omp parallel
+    {
+      std::vector<std::complex<T>> scratch(scratch_size);
+#pragma omp for schedule(static)
+      for (size_t item = 0; item < items; ++item) kernel(item, scratch.data());
+    }
+  }
+};
+
+}  // namespace cunumeric
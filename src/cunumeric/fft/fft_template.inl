@@ -0,0 +1,83 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/pitches.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+// Every point transforms whole lines along the axes, so the subrectangles of the input
+// and the output only differ in the extent of the last axis of a real transform, which
+// holds n real values on one side and n / 2 + 1 complex ones on the other
+template <VariantKind KIND, FFTType TYPE, LegateTypeCode CODE, int DIM>
+struct FFTImplBody;
+
+template <FFTType TYPE, VariantKind KIND>
+struct FFTImpl {
+  template <LegateTypeCode CODE, int DIM, std::enable_if_t<FFTTypes<TYPE, CODE>::valid>* = nullptr>
+  void operator()(FFTArgs& args) const
+  {
+    using IN  = typename FFTTypes<TYPE, CODE>::IN;
+    using OUT = typename FFTTypes<TYPE, CODE>::OUT;
+
+    const auto out_rect = args.out.shape<DIM>();
+    const auto in_rect  = args.in.shape<DIM>();
+    if (out_rect.empty() || in_rect.empty()) return;
+
+    auto out = args.out.write_accessor<OUT, DIM>(out_rect);
+    auto in  = args.in.read_accessor<IN, DIM>(in_rect);
+
+    FFTImplBody<KIND, TYPE, CODE, DIM>{}(
+      out, in, out_rect, in_rect, args.axes, args.inverse, args.scale);
+  }
+
+  template <LegateTypeCode CODE,
+            int DIM,
+            std::enable_if_t<!FFTTypes<TYPE, CODE>::valid>* = nullptr>
+  void operator()(FFTArgs& args) const
+  {
+    assert(false);
+  }
+};
+
+template <VariantKind KIND>
+struct FFTDispatch {
+  template <FFTType TYPE>
+  void operator()(FFTArgs& args) const
+  {
+    cunumeric::double_dispatch(args.in.dim(), args.in.code(), FFTImpl<TYPE, KIND>{}, args);
+  }
+};
+
+template <VariantKind KIND>
+static void fft_template(TaskContext& context)
+{
+  auto& inputs  = context.inputs();
+  auto& outputs = context.outputs();
+  auto& scalars = context.scalars();
+
+  FFTArgs args{outputs[0],
+               inputs[0],
+               scalars[0].value<FFTType>(),
+               scalars[1].value<bool>(),
+               scalars[2].values<int32_t>(),
+               scalars[3].value<double>()};
+  fft_dispatch(args.type, FFTDispatch<KIND>{}, args);
+}
+
+}  // namespace cunumeric
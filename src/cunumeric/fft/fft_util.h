@@ -0,0 +1,97 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "cunumeric/cunumeric.h"
+
+namespace cunumeric {
+
+// Match these to FFTType in config.py
+enum class FFTType : int32_t {
+  C2C = 1,
+  R2C = 2,
+  C2R = 3,
+};
+
+template <typename Functor, typename... Fnargs>
+constexpr decltype(auto) fft_dispatch(FFTType type, Functor f, Fnargs&&... args)
+{
+  switch (type) {
+    case FFTType::C2C: return f.template operator()<FFTType::C2C>(std::forward<Fnargs>(args)...);
+    case FFTType::R2C: return f.template operator()<FFTType::R2C>(std::forward<Fnargs>(args)...);
+    case FFTType::C2R: return f.template operator()<FFTType::C2R>(std::forward<Fnargs>(args)...);
+  }
+  assert(false);
+  return f.template operator()<FFTType::C2C>(std::forward<Fnargs>(args)...);
+}
+
+// Maps the type of a transform and the type code of its input to the element types of
+// the input and the output and to the precision the transform is computed in
+template <FFTType TYPE, legate::LegateTypeCode CODE>
+struct FFTTypes {
+  static constexpr bool valid = false;
+};
+
+template <>
+struct FFTTypes<FFTType::C2C, legate::LegateTypeCode::COMPLEX64_LT> {
+  static constexpr bool valid = true;
+  using IN                    = complex<float>;
+  using OUT                   = complex<float>;
+  using REAL                  = float;
+};
+
+template <>
+struct FFTTypes<FFTType::C2C, legate::LegateTypeCode::COMPLEX128_LT> {
+  static constexpr bool valid = true;
+  using IN                    = complex<double>;
+  using OUT                   = complex<double>;
+  using REAL                  = double;
+};
+
+template <>
+struct FFTTypes<FFTType::R2C, legate::LegateTypeCode::FLOAT_LT> {
+  static constexpr bool valid = true;
+  using IN                    = float;
+  using OUT                   = complex<float>;
+  using REAL                  = float;
+};
+
+template <>
+struct FFTTypes<FFTType::R2C, legate::LegateTypeCode::DOUBLE_LT> {
+  static constexpr bool valid = true;
+  using IN                    = double;
+  using OUT                   = complex<double>;
+  using REAL                  = double;
+};
+
+template <>
+struct FFTTypes<FFTType::C2R, legate::LegateTypeCode::COMPLEX64_LT> {
+  static constexpr bool valid = true;
+  using IN                    = complex<float>;
+  using OUT                   = float;
+  using REAL                  = float;
+};
+
+template <>
+struct FFTTypes<FFTType::C2R, legate::LegateTypeCode::COMPLEX128_LT> {
+  static constexpr bool valid = true;
+  using IN                    = complex<double>;
+  using OUT                   = double;
+  using REAL                  = double;
+};
+
+}  // namespace cunumeric
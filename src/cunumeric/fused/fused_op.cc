@@ -0,0 +1,59 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/fused/fused_op.h"
+#include "cunumeric/fused/fused_op_template.inl"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <LegateTypeCode CODE, int DIM>
+struct FusedOpImplBody<VariantKind::CPU, CODE, DIM> {
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(const FusedProgram<CODE>& program,
+                  const std::vector<AccessorWO<VAL, DIM>>& out,
+                  const std::vector<AccessorRO<VAL, DIM>>& in,
+                  const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& rect,
+                  bool dense) const
+  {
+    const size_t volume = rect.volume();
+    for (size_t start = 0; start < volume; start += FUSED_TILE_SIZE)
+      fused_op_tile<CODE, DIM>(program,
+                               out,
+                               in,
+                               pitches,
+                               rect,
+                               dense,
+                               start,
+                               std::min(FUSED_TILE_SIZE, volume - start));
+  }
+};
+
+/*static*/ void FusedOpTask::cpu_variant(TaskContext& context)
+{
+  fused_op_template<VariantKind::CPU>(context);
+}
+
+namespace  // unnamed
+{
+static void __attribute__((constructor)) register_tasks(void) { FusedOpTask::register_variants(); }
+}  // namespace
+
+}  // namespace cunumeric
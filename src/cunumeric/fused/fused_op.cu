@@ -0,0 +1,110 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/fused/fused_op.h"
+#include "cunumeric/fused/fused_op_template.inl"
+
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+
+template <typename Program, typename VAL, typename Pitches, typename Rect>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  dense_kernel(size_t volume,
+               Program program,
+               FusedArray<VAL*, FUSED_MAX_OUTPUTS> out,
+               FusedArray<const VAL*, FUSED_MAX_INPUTS> in,
+               Pitches pitches,
+               Rect rect)
+{
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x;
+  for (size_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < volume; idx += stride) {
+    // Only ranges need the coordinates of the element
+    auto point = program.has_generators ? pitches.unflatten(idx, rect.lo) : rect.lo;
+    VAL regs[FUSED_MAX_REGISTERS];
+    for (int32_t i = 0; i < program.num_inputs; ++i) regs[i] = in[i][idx];
+    program.evaluate(regs, point);
+    for (int32_t j = 0; j < program.num_outputs; ++j) out[j][idx] = regs[program.outputs[j]];
+  }
+}
+
+template <typename Program,
+          typename VAL,
+          typename WriteAcc,
+          typename ReadAcc,
+          typename Pitches,
+          typename Rect>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  generic_kernel(size_t volume,
+                 Program program,
+                 FusedArray<WriteAcc, FUSED_MAX_OUTPUTS> out,
+                 FusedArray<ReadAcc, FUSED_MAX_INPUTS> in,
+                 Pitches pitches,
+                 Rect rect)
+{
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x;
+  for (size_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < volume; idx += stride) {
+    auto point = pitches.unflatten(idx, rect.lo);
+    VAL regs[FUSED_MAX_REGISTERS];
+    for (int32_t i = 0; i < program.num_inputs; ++i) regs[i] = in[i][point];
+    program.evaluate(regs, point);
+    for (int32_t j = 0; j < program.num_outputs; ++j) out[j][point] = regs[program.outputs[j]];
+  }
+}
+
+template <LegateTypeCode CODE, int DIM>
+struct FusedOpImplBody<VariantKind::GPU, CODE, DIM> {
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(const FusedProgram<CODE>& program,
+                  const std::vector<AccessorWO<VAL, DIM>>& out,
+                  const std::vector<AccessorRO<VAL, DIM>>& in,
+                  const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& rect,
+                  bool dense) const
+  {
+    auto stream = get_cached_stream();
+
+    size_t volume       = rect.volume();
+    const size_t blocks = grid_stride_blocks<1>(volume);
+    FastPitches<DIM - 1> fast_pitches;
+    fast_pitches.flatten(rect);
+    if (dense) {
+      FusedArray<VAL*, FUSED_MAX_OUTPUTS> outptrs;
+      FusedArray<const VAL*, FUSED_MAX_INPUTS> inptrs;
+      for (size_t j = 0; j < out.size(); ++j) outptrs[j] = out[j].ptr(rect);
+      for (size_t i = 0; i < in.size(); ++i) inptrs[i] = in[i].ptr(rect);
+      dense_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+        volume, program, outptrs, inptrs, fast_pitches, rect);
+    } else {
+      FusedArray<AccessorWO<VAL, DIM>, FUSED_MAX_OUTPUTS> outaccs;
+      FusedArray<AccessorRO<VAL, DIM>, FUSED_MAX_INPUTS> inaccs;
+      for (size_t j = 0; j < out.size(); ++j) outaccs[j] = out[j];
+      for (size_t i = 0; i < in.size(); ++i) inaccs[i] = in[i];
+      generic_kernel<FusedProgram<CODE>, VAL><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+        volume, program, outaccs, inaccs, fast_pitches, rect);
+    }
+  }
+};
+
+/*static*/ void FusedOpTask::gpu_variant(TaskContext& context)
+{
+  fused_op_template<VariantKind::GPU>(context);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,126 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/fused/fused_op_util.h"
+#include "cunumeric/pitches.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <VariantKind KIND, LegateTypeCode CODE, int DIM>
+struct FusedOpImplBody;
+
+// Evaluates the program on the tile of n elements starting at start, which is
+// shared between the CPU and OpenMP variants
+template <LegateTypeCode CODE, int DIM>
+static inline void fused_op_tile(const FusedProgram<CODE>& program,
+                                 const std::vector<AccessorWO<legate_type_of<CODE>, DIM>>& out,
+                                 const std::vector<AccessorRO<legate_type_of<CODE>, DIM>>& in,
+                                 const Pitches<DIM - 1>& pitches,
+                                 const Rect<DIM>& rect,
+                                 bool dense,
+                                 size_t start,
+                                 size_t n)
+{
+  using VAL = legate_type_of<CODE>;
+
+  VAL gathered[FUSED_MAX_INPUTS][FUSED_TILE_SIZE];
+  VAL scratch[FUSED_MAX_INSTRUCTIONS][FUSED_TILE_SIZE];
+  const VAL* operands[FUSED_MAX_REGISTERS];
+  Point<DIM> points[FUSED_TILE_SIZE];
+
+  const int32_t num_inputs = program.num_inputs;
+  if (dense) {
+    for (int32_t i = 0; i < num_inputs; ++i) operands[i] = in[i].ptr(rect) + start;
+  } else {
+    for (int32_t i = 0; i < num_inputs; ++i) {
+      for (size_t k = 0; k < n; ++k) gathered[i][k] = in[i][pitches.unflatten(start + k, rect.lo)];
+      operands[i] = gathered[i];
+    }
+  }
+
+  if (program.has_generators)
+    for (size_t k = 0; k < n; ++k) points[k] = pitches.unflatten(start + k, rect.lo);
+
+  program.evaluate_tile(operands, scratch, points, n);
+
+  for (int32_t j = 0; j < program.num_outputs; ++j) {
+    const VAL* result = operands[program.outputs[j]];
+    if (dense) {
+      auto outptr = out[j].ptr(rect) + start;
+      for (size_t k = 0; k < n; ++k) outptr[k] = result[k];
+    } else {
+      for (size_t k = 0; k < n; ++k) out[j][pitches.unflatten(start + k, rect.lo)] = result[k];
+    }
+  }
+}
+
+template <VariantKind KIND>
+struct FusedOpImpl {
+  template <LegateTypeCode CODE, int DIM>
+  void operator()(FusedOpArgs& args) const
+  {
+    using VAL = legate_type_of<CODE>;
+
+    auto rect = args.outputs[0].shape<DIM>();
+
+    Pitches<DIM - 1> pitches;
+    size_t volume = pitches.flatten(rect);
+
+    if (volume == 0) return;
+
+    FusedProgram<CODE> program(args.code,
+                               args.results,
+                               args.constants.values<VAL>(),
+                               static_cast<int32_t>(args.inputs.size()),
+                               DIM);
+    assert(program.num_outputs == static_cast<int32_t>(args.outputs.size()));
+
+    std::vector<AccessorWO<VAL, DIM>> out;
+    std::vector<AccessorRO<VAL, DIM>> in;
+    for (auto& output : args.outputs) out.push_back(output.write_accessor<VAL, DIM>(rect));
+    for (auto& input : args.inputs) in.push_back(input.read_accessor<VAL, DIM>(rect));
+
+#ifndef LEGION_BOUNDS_CHECKS
+    // Check to see if this is dense or not
+    bool dense = true;
+    for (auto& acc : out) dense = dense && acc.accessor.is_dense_row_major(rect);
+    for (auto& acc : in) dense = dense && acc.accessor.is_dense_row_major(rect);
+#else
+    // No dense execution if we're doing bounds checks
+    bool dense = false;
+#endif
+
+    FusedOpImplBody<KIND, CODE, DIM>()(program, out, in, pitches, rect, dense);
+  }
+};
+
+template <VariantKind KIND>
+static void fused_op_template(TaskContext& context)
+{
+  auto& inputs  = context.inputs();
+  auto& outputs = context.outputs();
+  auto& scalars = context.scalars();
+
+  FusedOpArgs args{
+    inputs, outputs, scalars[0].values<int32_t>(), scalars[1].values<int32_t>(), scalars[2]};
+  auto dim = std::max(1, args.outputs[0].dim());
+  cunumeric::double_dispatch(dim, args.outputs[0].code(), FusedOpImpl<KIND>{}, args);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,462 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "cunumeric/cunumeric.h"
+#include "cunumeric/unary/unary_op_util.h"
+#include "cunumeric/binary/binary_op_util.h"
+
+namespace cunumeric {
+
+// Match these to the limits in fusion.py
+constexpr int32_t FUSED_MAX_INPUTS       = 8;
+constexpr int32_t FUSED_MAX_OUTPUTS      = 8;
+constexpr int32_t FUSED_MAX_INSTRUCTIONS = 16;
+constexpr int32_t FUSED_MAX_REGISTERS    = FUSED_MAX_INPUTS + FUSED_MAX_INSTRUCTIONS;
+// Number of elements the CPU variants evaluate per instruction at a time
+constexpr size_t FUSED_TILE_SIZE = 64;
+
+// Match these to FusedOpKind in config.py
+enum class FusedOpKind : int32_t {
+  UNARY  = 0,
+  BINARY = 1,
+  ARANGE = 2,
+};
+
+// Each instruction is encoded as a tuple of four integers: (kind, op code, src1, src2).
+// Registers [0, num_inputs) hold the task inputs and instruction i writes register
+// num_inputs + i, so a program is always in SSA form. An ARANGE instruction reads no
+// registers: its op code is the dimension whose coordinate it takes and src1 is the
+// index of its start and step in the constants.
+struct FusedInstruction {
+  int32_t kind;
+  int32_t op_code;
+  int32_t src1;
+  int32_t src2;
+};
+
+namespace detail {
+
+template <UnaryOpCode OP_CODE, legate::LegateTypeCode CODE>
+struct UnaryPreservesType
+  : std::is_same<std::result_of_t<UnaryOp<OP_CODE, CODE>(legate::legate_type_of<CODE>)>,
+                 legate::legate_type_of<CODE>> {
+};
+
+template <BinaryOpCode OP_CODE, legate::LegateTypeCode CODE>
+struct BinaryPreservesType
+  : std::is_same<std::result_of_t<BinaryOp<OP_CODE, CODE>(legate::legate_type_of<CODE>,
+                                                           legate::legate_type_of<CODE>)>,
+                 legate::legate_type_of<CODE>> {
+};
+
+}  // namespace detail
+
+// An operator can be fused only when it takes no extra arguments and maps
+// values of type CODE back to the same type, as every register in a fused
+// program has the same type
+template <UnaryOpCode OP_CODE,
+          legate::LegateTypeCode CODE,
+          bool VALID = UnaryOp<OP_CODE, CODE>::valid>
+struct FusibleUnaryOp : std::false_type {
+};
+
+template <UnaryOpCode OP_CODE, legate::LegateTypeCode CODE>
+struct FusibleUnaryOp<OP_CODE, CODE, true>
+  : std::conjunction<
+      std::integral_constant<bool, OP_CODE != UnaryOpCode::CLIP>,
+      std::is_same<typename UnaryOp<OP_CODE, CODE>::T, legate::legate_type_of<CODE>>,
+      detail::UnaryPreservesType<OP_CODE, CODE>> {
+};
+
+template <BinaryOpCode OP_CODE,
+          legate::LegateTypeCode CODE,
+          bool VALID = BinaryOp<OP_CODE, CODE>::valid>
+struct FusibleBinaryOp : std::false_type {
+};
+
+template <BinaryOpCode OP_CODE, legate::LegateTypeCode CODE>
+struct FusibleBinaryOp<OP_CODE, CODE, true>
+  : std::conjunction<std::integral_constant<bool, OP_CODE != BinaryOpCode::ALLCLOSE>,
+                     detail::BinaryPreservesType<OP_CODE, CODE>> {
+};
+
+// The operator functors can only be constructed on the host, so a fused program
+// carries one instance of every fusible functor for its type in a table that
+// gets copied to the device along with the program
+template <UnaryOpCode OP_CODE,
+          legate::LegateTypeCode CODE,
+          bool FUSIBLE = FusibleUnaryOp<OP_CODE, CODE>::value>
+struct FusedUnaryEntry {
+  FusedUnaryEntry(const std::vector<legate::Store>& args) {}
+};
+
+template <UnaryOpCode OP_CODE, legate::LegateTypeCode CODE>
+struct FusedUnaryEntry<OP_CODE, CODE, true> {
+  FusedUnaryEntry(const std::vector<legate::Store>& args) : op(args) {}
+  UnaryOp<OP_CODE, CODE> op;
+};
+
+template <BinaryOpCode OP_CODE,
+          legate::LegateTypeCode CODE,
+          bool FUSIBLE = FusibleBinaryOp<OP_CODE, CODE>::value>
+struct FusedBinaryEntry {
+  FusedBinaryEntry(const std::vector<legate::Store>& args) {}
+};
+
+template <BinaryOpCode OP_CODE, legate::LegateTypeCode CODE>
+struct FusedBinaryEntry<OP_CODE, CODE, true> {
+  FusedBinaryEntry(const std::vector<legate::Store>& args) : op(args) {}
+  BinaryOp<OP_CODE, CODE> op;
+};
+
+template <legate::LegateTypeCode CODE, typename SEQ>
+struct FusedUnaryTableBase;
+
+template <legate::LegateTypeCode CODE, int32_t... OP_CODES>
+struct FusedUnaryTableBase<CODE, std::integer_sequence<int32_t, OP_CODES...>>
+  : FusedUnaryEntry<static_cast<UnaryOpCode>(OP_CODES + 1), CODE>... {
+  FusedUnaryTableBase(const std::vector<legate::Store>& args)
+    : FusedUnaryEntry<static_cast<UnaryOpCode>(OP_CODES + 1), CODE>(args)...
+  {
+  }
+};
+
+template <legate::LegateTypeCode CODE, typename SEQ>
+struct FusedBinaryTableBase;
+
+template <legate::LegateTypeCode CODE, int32_t... OP_CODES>
+struct FusedBinaryTableBase<CODE, std::integer_sequence<int32_t, OP_CODES...>>
+  : FusedBinaryEntry<static_cast<BinaryOpCode>(OP_CODES + 1), CODE>... {
+  FusedBinaryTableBase(const std::vector<legate::Store>& args)
+    : FusedBinaryEntry<static_cast<BinaryOpCode>(OP_CODES + 1), CODE>(args)...
+  {
+  }
+};
+
+// The tables cover every op code up to the last one in each enum, so they must be
+// extended whenever a new op code is appended
+template <legate::LegateTypeCode CODE>
+using FusedUnaryTable = FusedUnaryTableBase<
+  CODE,
+  std::make_integer_sequence<int32_t, static_cast<int32_t>(UnaryOpCode::ABS2)>>;
+
+template <legate::LegateTypeCode CODE>
+using FusedBinaryTable = FusedBinaryTableBase<
+  CODE,
+  std::make_integer_sequence<int32_t, static_cast<int32_t>(BinaryOpCode::MUL_CONJ)>>;
+
+template <legate::LegateTypeCode CODE>
+struct FusedUnaryStep {
+  using VAL = legate::legate_type_of<CODE>;
+
+  template <UnaryOpCode OP_CODE, std::enable_if_t<FusibleUnaryOp<OP_CODE, CODE>::value>* = nullptr>
+  __CUDA_HD__ VAL operator()(const FusedUnaryTable<CODE>& table, const VAL& x) const
+  {
+    return static_cast<const FusedUnaryEntry<OP_CODE, CODE>&>(table).op(x);
+  }
+
+  template <UnaryOpCode OP_CODE, std::enable_if_t<!FusibleUnaryOp<OP_CODE, CODE>::value>* = nullptr>
+  __CUDA_HD__ VAL operator()(const FusedUnaryTable<CODE>& table, const VAL& x) const
+  {
+    // Programs are validated before they run, so this is unreachable
+    return x;
+  }
+};
+
+template <legate::LegateTypeCode CODE>
+struct FusedBinaryStep {
+  using VAL = legate::legate_type_of<CODE>;
+
+  template <BinaryOpCode OP_CODE,
+            std::enable_if_t<FusibleBinaryOp<OP_CODE, CODE>::value>* = nullptr>
+  __CUDA_HD__ VAL operator()(const FusedBinaryTable<CODE>& table,
+                             const VAL& x,
+                             const VAL& y) const
+  {
+    return static_cast<const FusedBinaryEntry<OP_CODE, CODE>&>(table).op(x, y);
+  }
+
+  template <BinaryOpCode OP_CODE,
+            std::enable_if_t<!FusibleBinaryOp<OP_CODE, CODE>::value>* = nullptr>
+  __CUDA_HD__ VAL operator()(const FusedBinaryTable<CODE>& table,
+                             const VAL& x,
+                             const VAL& y) const
+  {
+    // Programs are validated before they run, so this is unreachable
+    return x;
+  }
+};
+
+// Tile-at-a-time versions of the steps above for the CPU variants. These dispatch
+// on the op code once per tile and leave the inner loops to the vectorizer.
+template <legate::LegateTypeCode CODE>
+struct FusedUnaryTileStep {
+  using VAL = legate::legate_type_of<CODE>;
+
+  template <UnaryOpCode OP_CODE, std::enable_if_t<FusibleUnaryOp<OP_CODE, CODE>::value>* = nullptr>
+  void operator()(const FusedUnaryTable<CODE>& table, VAL* dst, const VAL* src, size_t n) const
+  {
+    const auto& op = static_cast<const FusedUnaryEntry<OP_CODE, CODE>&>(table).op;
+    for (size_t idx = 0; idx < n; ++idx) dst[idx] = op(src[idx]);
+  }
+
+  template <UnaryOpCode OP_CODE, std::enable_if_t<!FusibleUnaryOp<OP_CODE, CODE>::value>* = nullptr>
+  void operator()(const FusedUnaryTable<CODE>& table, VAL* dst, const VAL* src, size_t n) const
+  {
+    assert(false);
+  }
+};
+
+template <legate::LegateTypeCode CODE>
+struct FusedBinaryTileStep {
+  using VAL = legate::legate_type_of<CODE>;
+
+  template <BinaryOpCode OP_CODE,
+            std::enable_if_t<FusibleBinaryOp<OP_CODE, CODE>::value>* = nullptr>
+  void operator()(
+    const FusedBinaryTable<CODE>& table, VAL* dst, const VAL* src1, const VAL* src2, size_t n) const
+  {
+    const auto& op = static_cast<const FusedBinaryEntry<OP_CODE, CODE>&>(table).op;
+    for (size_t idx = 0; idx < n; ++idx) dst[idx] = op(src1[idx], src2[idx]);
+  }
+
+  template <BinaryOpCode OP_CODE,
+            std::enable_if_t<!FusibleBinaryOp<OP_CODE, CODE>::value>* = nullptr>
+  void operator()(
+    const FusedBinaryTable<CODE>& table, VAL* dst, const VAL* src1, const VAL* src2, size_t n) const
+  {
+    assert(false);
+  }
+};
+
+template <legate::LegateTypeCode CODE>
+struct FusibleUnaryCheck {
+  template <UnaryOpCode OP_CODE>
+  bool operator()() const
+  {
+    return FusibleUnaryOp<OP_CODE, CODE>::value;
+  }
+};
+
+template <legate::LegateTypeCode CODE>
+struct FusibleBinaryCheck {
+  template <BinaryOpCode OP_CODE>
+  bool operator()() const
+  {
+    return FusibleBinaryOp<OP_CODE, CODE>::value;
+  }
+};
+
+template <legate::LegateTypeCode CODE>
+class FusedProgram {
+ public:
+  using VAL = legate::legate_type_of<CODE>;
+
+ public:
+  FusedProgram(legate::Span<const int32_t> code,
+               legate::Span<const int32_t> results,
+               legate::Span<const VAL> constants,
+               int32_t num_inputs,
+               int32_t dim)
+    : num_inputs(num_inputs), has_generators(false), unary_ops_(no_args()), binary_ops_(no_args())
+  {
+    assert(code.size() % 4 == 0);
+    num_instructions = static_cast<int32_t>(code.size() / 4);
+    num_outputs      = static_cast<int32_t>(results.size());
+    assert(0 < num_instructions && num_instructions <= FUSED_MAX_INSTRUCTIONS);
+    assert(0 < num_outputs && num_outputs <= FUSED_MAX_OUTPUTS);
+    assert(num_inputs <= FUSED_MAX_INPUTS);
+    assert(constants.size() % 2 == 0 && constants.size() <= 2 * FUSED_MAX_INSTRUCTIONS);
+    for (size_t idx = 0; idx < constants.size(); ++idx) this->constants[idx] = constants[idx];
+
+    for (int32_t idx = 0; idx < num_instructions; ++idx) {
+      auto& inst = instructions[idx];
+      inst.kind  = code[4 * idx];
+      inst.op_code = code[4 * idx + 1];
+      inst.src1    = code[4 * idx + 2];
+      inst.src2    = code[4 * idx + 3];
+
+      const int32_t dst = num_inputs + idx;
+      bool fusible      = inst.src1 < dst && inst.src2 < dst;
+      if (static_cast<FusedOpKind>(inst.kind) == FusedOpKind::ARANGE) {
+        fusible        = 0 <= inst.op_code && inst.op_code < dim && 0 <= inst.src1 &&
+                  2 * static_cast<size_t>(inst.src1) < constants.size();
+        has_generators = true;
+      } else if (static_cast<FusedOpKind>(inst.kind) == FusedOpKind::UNARY)
+        fusible = fusible && op_dispatch(static_cast<UnaryOpCode>(inst.op_code),
+                                         FusibleUnaryCheck<CODE>{});
+      else
+        fusible = fusible && op_dispatch(static_cast<BinaryOpCode>(inst.op_code),
+                                         FusibleBinaryCheck<CODE>{});
+      if (!fusible) {
+        fprintf(stderr,
+                "Instruction %d of a fused program is not fusible for type code %d\n",
+                idx,
+                static_cast<int32_t>(CODE));
+        LEGATE_ABORT;
+      }
+    }
+    for (int32_t idx = 0; idx < num_outputs; ++idx) {
+      assert(results[idx] < num_inputs + num_instructions);
+      outputs[idx] = results[idx];
+    }
+  }
+
+ public:
+  // Evaluates the program on the element at point. regs must have room for
+  // num_inputs + num_instructions values with the inputs already loaded.
+  template <int DIM>
+  __CUDA_HD__ void evaluate(VAL* regs, const Legion::Point<DIM>& point) const
+  {
+    for (int32_t idx = 0; idx < num_instructions; ++idx) {
+      const auto& inst = instructions[idx];
+      auto& dst        = regs[num_inputs + idx];
+      if (static_cast<FusedOpKind>(inst.kind) == FusedOpKind::ARANGE)
+        dst = static_cast<VAL>(point[inst.op_code]) * constants[2 * inst.src1 + 1] +
+              constants[2 * inst.src1];
+      else if (static_cast<FusedOpKind>(inst.kind) == FusedOpKind::UNARY)
+        dst = op_dispatch(static_cast<UnaryOpCode>(inst.op_code),
+                          FusedUnaryStep<CODE>{},
+                          unary_ops_,
+                          regs[inst.src1]);
+      else
+        dst = op_dispatch(static_cast<BinaryOpCode>(inst.op_code),
+                          FusedBinaryStep<CODE>{},
+                          binary_ops_,
+                          regs[inst.src1],
+                          regs[inst.src2]);
+    }
+  }
+
+  // Evaluates the program on a tile of n <= FUSED_TILE_SIZE elements. The first
+  // num_inputs entries in operands must point to the inputs for the tile, and
+  // the rest are set to point to the scratch space in the order of instructions.
+  // points holds the coordinates of the elements and is only read by ranges.
+  template <int DIM>
+  void evaluate_tile(const VAL** operands,
+                     VAL (*scratch)[FUSED_TILE_SIZE],
+                     const Legion::Point<DIM>* points,
+                     size_t n) const
+  {
+    for (int32_t idx = 0; idx < num_instructions; ++idx) {
+      const auto& inst = instructions[idx];
+      auto dst         = scratch[idx];
+      if (static_cast<FusedOpKind>(inst.kind) == FusedOpKind::ARANGE) {
+        const VAL start = constants[2 * inst.src1];
+        const VAL step  = constants[2 * inst.src1 + 1];
+        for (size_t k = 0; k < n; ++k)
+          dst[k] = static_cast<VAL>(points[k][inst.op_code]) * step + start;
+      } else if (static_cast<FusedOpKind>(inst.kind) == FusedOpKind::UNARY)
+        op_dispatch(static_cast<UnaryOpCode>(inst.op_code),
+                    FusedUnaryTileStep<CODE>{},
+                    unary_ops_,
+                    dst,
+                    operands[inst.src1],
+                    n);
+      else
+        op_dispatch(static_cast<BinaryOpCode>(inst.op_code),
+                    FusedBinaryTileStep<CODE>{},
+                    binary_ops_,
+                    dst,
+                    operands[inst.src1],
+                    operands[inst.src2],
+                    n);
+      operands[num_inputs + idx] = dst;
+    }
+  }
+
+ public:
+  int32_t num_inputs;
+  int32_t num_instructions;
+  int32_t num_outputs;
+  FusedInstruction instructions[FUSED_MAX_INSTRUCTIONS];
+  int32_t outputs[FUSED_MAX_OUTPUTS];
+  // The start and step of every range in the program
+  VAL constants[2 * FUSED_MAX_INSTRUCTIONS];
+  bool has_generators;
+
+ private:
+  static const std::vector<legate::Store>& no_args()
+  {
+    static const std::vector<legate::Store> args;
+    return args;
+  }
+
+ private:
+  FusedUnaryTable<CODE> unary_ops_;
+  FusedBinaryTable<CODE> binary_ops_;
+};
+
+// A fixed-size array that can be passed by value to GPU kernels
+template <typename T, int32_t N>
+struct FusedArray {
+  __CUDA_HD__ T& operator[](int32_t idx) { return values[idx]; }
+  __CUDA_HD__ const T& operator[](int32_t idx) const { return values[idx]; }
+  T values[N];
+};
+
+// The program of an element-wise expression of the inputs of a task, which the task
+// evaluates in place of reading a single input that would hold the value of the expression
+struct FusedExpr {
+  const std::vector<legate::Store>& inputs;
+  legate::Span<const int32_t> code;
+  legate::Span<const int32_t> results;
+  const legate::Scalar& constants;
+
+  template <legate::LegateTypeCode CODE>
+  FusedProgram<CODE> program(int32_t dim) const
+  {
+    return FusedProgram<CODE>(code,
+                              results,
+                              constants.values<legate::legate_type_of<CODE>>(),
+                              static_cast<int32_t>(inputs.size()),
+                              dim);
+  }
+};
+
+// Reads the values of a fused expression with a single result like an accessor of the
+// array that would hold them, evaluating the program on the inputs at every point read
+template <legate::LegateTypeCode CODE, int DIM>
+class FusedReader {
+ public:
+  using VAL = legate::legate_type_of<CODE>;
+
+ public:
+  FusedReader(const FusedExpr& expr, const Legion::Rect<DIM>& rect)
+    : program(expr.program<CODE>(DIM))
+  {
+    assert(program.num_outputs == 1);
+    for (int32_t idx = 0; idx < program.num_inputs; ++idx)
+      in[idx] = expr.inputs[idx].read_accessor<VAL, DIM>(rect);
+  }
+
+ public:
+  __CUDA_HD__ VAL operator[](const Legion::Point<DIM>& point) const
+  {
+    VAL regs[FUSED_MAX_REGISTERS];
+    for (int32_t idx = 0; idx < program.num_inputs; ++idx) regs[idx] = in[idx][point];
+    program.evaluate(regs, point);
+    return regs[program.outputs[0]];
+  }
+
+ public:
+  FusedProgram<CODE> program;
+  FusedArray<legate::AccessorRO<VAL, DIM>, FUSED_MAX_INPUTS> in;
+};
+
+}  // namespace cunumeric
@@ -0,0 +1,53 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/fused/lstm_gates.h"
+#include "cunumeric/fused/lstm_gates_template.inl"
+
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+
+template <typename OP>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  lstm_gates_kernel(size_t volume, OP op, Pitches<1> pitches, Point<2> lo)
+{
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x;
+  for (size_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < volume; idx += stride)
+    op(pitches.unflatten(idx, lo));
+}
+
+template <>
+struct LSTMGatesImplBody<VariantKind::GPU> {
+  template <typename OP>
+  void operator()(const OP& op, const Rect<2>& rect) const
+  {
+    auto stream = get_cached_stream();
+    Pitches<1> pitches;
+    const size_t volume = pitches.flatten(rect);
+    const size_t blocks = grid_stride_blocks<1>(volume);
+    lstm_gates_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(volume, op, pitches, rect.lo);
+  }
+};
+
+/*static*/ void LSTMGatesTask::gpu_variant(TaskContext& context)
+{
+  lstm_gates_template<VariantKind::GPU>(context);
+}
+
+}  // namespace cunumeric
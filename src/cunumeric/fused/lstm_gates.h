@@ -0,0 +1,54 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "cunumeric/cunumeric.h"
+
+namespace cunumeric {
+
+struct LSTMGatesArgs {
+  bool backward;
+  // The forward task takes the pre-activations of the input, forget, output and cell
+  // gates, which are the four column blocks of a (b, 4 * d) matmul output, and the
+  // previous cell state when has_prev is set. It writes the new hidden state, the new cell
+  // state, its tanh and the activated gates.
+  //
+  // The backward task takes the activated gates, the tanh of the cell state, the gradient
+  // of the hidden state, the gradient of the cell state when has_dc is set and the
+  // previous cell state when has_prev is set. It writes the gradient of the
+  // pre-activations and, when has_prev is set, that of the previous cell state.
+  bool has_prev;
+  bool has_dc;
+  const std::vector<Array>& inputs;
+  const std::vector<Array>& outputs;
+};
+
+class LSTMGatesTask : public CuNumericTask<LSTMGatesTask> {
+ public:
+  static const int TASK_ID = CUNUMERIC_LSTM_GATES;
+
+ public:
+  static void cpu_variant(legate::TaskContext& context);
+#ifdef LEGATE_USE_OPENMP
+  static void omp_variant(legate::TaskContext& context);
+#endif
+#ifdef LEGATE_USE_CUDA
+  static void gpu_variant(legate::TaskContext& context);
+#endif
+};
+
+}  // namespace cunumeric
@@ -0,0 +1,42 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/fused/lstm_gates.h"
+#include "cunumeric/fused/lstm_gates_template.inl"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <>
+struct LSTMGatesImplBody<VariantKind::OMP> {
+  template <typename OP>
+  void operator()(const OP& op, const Rect<2>& rect) const
+  {
+    Pitches<1> pitches;
+    const size_t volume = pitches.flatten(rect);
+#pragma omp parallel for schedule(static)
+    for (size_t idx = 0; idx < volume; ++idx) op(pitches.unflatten(idx, rect.lo));
+  }
+};
+
+/*static*/ void LSTMGatesTask::omp_variant(TaskContext& context)
+{
+  lstm_gates_template<VariantKind::OMP>(context);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,190 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cmath>
+
+#include "cunumeric/pitches.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <VariantKind KIND>
+struct LSTMGatesImplBody;
+
+template <typename VAL>
+__CUDA_HD__ inline VAL lstm_sigmoid(VAL x)
+{
+  using std::exp;
+  return VAL{1} / (VAL{1} + exp(-x));
+}
+
+// Each point of the (b, d) cell state computes the four gates of its column from the
+// columns j, d + j, 2 * d + j and 3 * d + j of the pre-activations, so that every task
+// needs whole rows and nothing else
+template <typename VAL>
+struct LSTMGatesForward {
+  __CUDA_HD__ void operator()(const Point<2>& p) const
+  {
+    using std::tanh;
+    const Point<2> i_at(p[0], gate_lo + p[1] - cell_lo);
+    const Point<2> f_at(p[0], i_at[1] + d);
+    const Point<2> o_at(p[0], i_at[1] + 2 * d);
+    const Point<2> g_at(p[0], i_at[1] + 3 * d);
+    const VAL i = lstm_sigmoid(pre[i_at]);
+    const VAL f = lstm_sigmoid(pre[f_at]);
+    const VAL o = lstm_sigmoid(pre[o_at]);
+    const VAL g = tanh(pre[g_at]);
+    VAL cell    = i * g;
+    if (has_prev) cell += f * c_prev[p];
+    const VAL t = tanh(cell);
+    h[p]        = o * t;
+    c[p]        = cell;
+    tanh_c[p]   = t;
+    gates[i_at] = i;
+    gates[f_at] = f;
+    gates[o_at] = o;
+    gates[g_at] = g;
+  }
+
+  AccessorRO<VAL, 2> pre;
+  AccessorRO<VAL, 2> c_prev;
+  AccessorWO<VAL, 2> h;
+  AccessorWO<VAL, 2> c;
+  AccessorWO<VAL, 2> tanh_c;
+  AccessorWO<VAL, 2> gates;
+  coord_t d;
+  coord_t cell_lo;
+  coord_t gate_lo;
+  bool has_prev;
+};
+
+// The gradients of one column of the gates, with the derivatives of the sigmoids and
+// tanhs taken from their saved outputs
+template <typename VAL>
+struct LSTMGatesBackward {
+  __CUDA_HD__ void operator()(const Point<2>& p) const
+  {
+    const Point<2> i_at(p[0], gate_lo + p[1] - cell_lo);
+    const Point<2> f_at(p[0], i_at[1] + d);
+    const Point<2> o_at(p[0], i_at[1] + 2 * d);
+    const Point<2> g_at(p[0], i_at[1] + 3 * d);
+    const VAL i    = gates[i_at];
+    const VAL f    = gates[f_at];
+    const VAL o    = gates[o_at];
+    const VAL g    = gates[g_at];
+    const VAL t    = tanh_c[p];
+    const VAL grad = dh[p];
+    // The gradient of the cell state, from this step's hidden state and the next step
+    VAL cell = (VAL{1} - t * t) * o * grad;
+    if (has_dc) cell += dc[p];
+    const VAL prev = has_prev ? c_prev[p] : VAL{0};
+    dpre[i_at]     = g * cell * i * (VAL{1} - i);
+    dpre[f_at]     = prev * cell * f * (VAL{1} - f);
+    dpre[o_at]     = t * grad * o * (VAL{1} - o);
+    dpre[g_at]     = i * cell * (VAL{1} - g * g);
+    if (has_prev) dc_prev[p] = f * cell;
+  }
+
+  AccessorRO<VAL, 2> gates;
+  AccessorRO<VAL, 2> tanh_c;
+  AccessorRO<VAL, 2> dh;
+  AccessorRO<VAL, 2> dc;
+  AccessorRO<VAL, 2> c_prev;
+  AccessorWO<VAL, 2> dpre;
+  AccessorWO<VAL, 2> dc_prev;
+  coord_t d;
+  coord_t cell_lo;
+  coord_t gate_lo;
+  bool has_prev;
+  bool has_dc;
+};
+
+template <VariantKind KIND>
+struct LSTMGatesImpl {
+  template <LegateTypeCode CODE,
+            std::enable_if_t<CODE == LegateTypeCode::FLOAT_LT ||
+                             CODE == LegateTypeCode::DOUBLE_LT>* = nullptr>
+  void operator()(LSTMGatesArgs& args) const
+  {
+    using VAL = legate_type_of<CODE>;
+
+    auto& inputs  = args.inputs;
+    auto& outputs = args.outputs;
+    // The rows of the cell state and the gates line up, as every task gets whole rows
+    auto rect   = args.backward ? inputs[1].shape<2>() : outputs[0].shape<2>();
+    auto g_rect = args.backward ? inputs[0].shape<2>() : outputs[3].shape<2>();
+    if (rect.empty()) return;
+
+    const coord_t d = rect.hi[1] - rect.lo[1] + 1;
+    if (!args.backward) {
+      LSTMGatesForward<VAL> op;
+      op.pre = inputs[0].read_accessor<VAL, 2>(g_rect);
+      if (args.has_prev) op.c_prev = inputs[1].read_accessor<VAL, 2>(rect);
+      op.h        = outputs[0].write_accessor<VAL, 2>(rect);
+      op.c        = outputs[1].write_accessor<VAL, 2>(rect);
+      op.tanh_c   = outputs[2].write_accessor<VAL, 2>(rect);
+      op.gates    = outputs[3].write_accessor<VAL, 2>(g_rect);
+      op.d        = d;
+      op.cell_lo  = rect.lo[1];
+      op.gate_lo  = g_rect.lo[1];
+      op.has_prev = args.has_prev;
+      LSTMGatesImplBody<KIND>()(op, rect);
+    } else {
+      LSTMGatesBackward<VAL> op;
+      op.gates  = inputs[0].read_accessor<VAL, 2>(g_rect);
+      op.tanh_c = inputs[1].read_accessor<VAL, 2>(rect);
+      op.dh     = inputs[2].read_accessor<VAL, 2>(rect);
+
+      size_t next = 3;
+      if (args.has_dc) op.dc = inputs[next++].read_accessor<VAL, 2>(rect);
+      if (args.has_prev) {
+        op.c_prev  = inputs[next].read_accessor<VAL, 2>(rect);
+        op.dc_prev = outputs[1].write_accessor<VAL, 2>(rect);
+      }
+      op.dpre     = outputs[0].write_accessor<VAL, 2>(g_rect);
+      op.d        = d;
+      op.cell_lo  = rect.lo[1];
+      op.gate_lo  = g_rect.lo[1];
+      op.has_prev = args.has_prev;
+      op.has_dc   = args.has_dc;
+      LSTMGatesImplBody<KIND>()(op, rect);
+    }
+  }
+
+  template <LegateTypeCode CODE,
+            std::enable_if_t<CODE != LegateTypeCode::FLOAT_LT &&
+                             CODE != LegateTypeCode::DOUBLE_LT>* = nullptr>
+  void operator()(LSTMGatesArgs& args) const
+  {
+    assert(false);
+  }
+};
+
+template <VariantKind KIND>
+static void lstm_gates_template(TaskContext& context)
+{
+  auto& scalars = context.scalars();
+  LSTMGatesArgs args{scalars[0].value<bool>(),
+                     scalars[1].value<bool>(),
+                     scalars[2].value<bool>(),
+                     context.inputs(),
+                     context.outputs()};
+  cunumeric::type_dispatch(args.inputs[0].code(), LSTMGatesImpl<KIND>{}, args);
+}
+
+}  // namespace cunumeric
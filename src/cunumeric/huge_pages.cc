@@ -0,0 +1,50 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/huge_pages.h"
+#include "cunumeric/cpu_caches.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+
+namespace cunumeric {
+
+static size_t huge_page_threshold()
+{
+  static const size_t threshold = []() -> size_t {
+    const char* value = getenv("CUNUMERIC_HUGE_PAGE_THRESHOLD");
+    return value != nullptr ? parse_size(value) : 0;
+  }();
+  return threshold;
+}
+
+void advise_huge_pages(const void* ptr, size_t bytes)
+{
+#ifdef MADV_HUGEPAGE
+  const size_t threshold = huge_page_threshold();
+  if (0 == threshold || bytes < threshold) return;
+  constexpr uintptr_t HUGE_PAGE_SIZE = 2 << 20;
+  const uintptr_t begin              = reinterpret_cast<uintptr_t>(ptr);
+  const uintptr_t lo                 = (begin + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+  const uintptr_t hi                 = (begin + bytes) & ~(HUGE_PAGE_SIZE - 1);
+  // The advice is only a hint, so a kernel without transparent huge pages is not an error
+  if (lo < hi) madvise(reinterpret_cast<void*>(lo), hi - lo, MADV_HUGEPAGE);
+#endif
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,32 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#pragma once
+
+#include <stddef.h>
+
+namespace cunumeric {
+
+// Asks the kernel to back the pages of [ptr, ptr + bytes) with transparent huge pages when
+// the range is at least CUNUMERIC_HUGE_PAGE_THRESHOLD bytes, given as a number optionally
+// followed by K, M or G. Without the variable nothing is advised. Only the 2MB pages that
+// lie entirely in the range are advised, since an instance shares the others with its
+// neighbours in the memory. Tasks call this before their threads first write an output,
+// so that the pages each thread touches first are faulted in as huge pages on its socket.
+void advise_huge_pages(const void* ptr, size_t bytes);
+
+}  // namespace cunumeric
@@ -22,11 +22,21 @@ namespace cunumeric {
 
 using namespace Legion;
 
-template <typename VAL, int DIM>
+// Up to this many choices are passed to the kernels by value, and more through a table
+// in device memory
+constexpr size_t MAX_INLINE_CHOICES = 8;
+
+template <typename T>
+struct InlineChoices {
+  __device__ const T& operator[](int64_t idx) const { return choices[idx]; }
+  T choices[MAX_INLINE_CHOICES];
+};
+
+template <typename VAL, int DIM, typename CHOICES>
 __global__ static void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
   choose_kernel(const AccessorWO<VAL, DIM> out,
                 const AccessorRO<int64_t, DIM> index_arr,
-                const DeferredBuffer<AccessorRO<VAL, DIM>, 1> choices,
+                const CHOICES choices,
                 const Rect<DIM> rect,
                 const Pitches<DIM - 1> pitches,
                 int volume)
@@ -38,15 +48,34 @@ __global__ static void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
 }
 
 // dense version
-template <typename VAL>
-__global__ static void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM) choose_kernel_dense(
-  VAL* outptr, const int64_t* indexptr, DeferredBuffer<const VAL*, 1> choices, int volume)
+template <typename VAL, typename CHOICES>
+__global__ static void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  choose_kernel_dense(VAL* outptr, const int64_t* indexptr, const CHOICES choices, int volume)
 {
   const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
   if (idx >= volume) return;
   outptr[idx] = choices[indexptr[idx]][idx];
 }
 
+// Calls launch with the choices either inline or as a pointer to a table in device memory
+template <typename T, typename LAUNCH>
+static void with_choices(const std::vector<T>& choices, cudaStream_t stream, LAUNCH&& launch)
+{
+  if (choices.size() <= MAX_INLINE_CHOICES) {
+    InlineChoices<T> table;
+    for (size_t idx = 0; idx < choices.size(); ++idx) table.choices[idx] = choices[idx];
+    launch(table);
+  } else {
+    ScratchBuffer<T> table(choices.size());
+    CHECK_CUDA(cudaMemcpyAsync(table.ptr(0),
+                               choices.data(),
+                               choices.size() * sizeof(T),
+                               cudaMemcpyHostToDevice,
+                               stream));
+    launch(static_cast<const T*>(table.ptr(0)));
+  }
+}
+
 template <LegateTypeCode CODE, int DIM>
 struct ChooseImplBody<VariantKind::GPU, CODE, DIM> {
   using VAL = legate_type_of<CODE>;
@@ -58,22 +87,25 @@ struct ChooseImplBody<VariantKind::GPU, CODE, DIM> {
                   const Pitches<DIM - 1>& pitches,
                   bool dense) const
   {
+    auto stream = get_cached_stream();
+
     const size_t volume = rect.volume();
     const size_t blocks = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
 
     if (dense) {
-      DeferredBuffer<const VAL*, 1> ch_arr(Memory::Kind::Z_COPY_MEM,
-                                           Rect<1>(0, choices.size() - 1));
-      for (uint32_t idx = 0; idx < choices.size(); ++idx) ch_arr[idx] = choices[idx].ptr(rect);
+      std::vector<const VAL*> ch_ptrs(choices.size());
+      for (uint32_t idx = 0; idx < choices.size(); ++idx) ch_ptrs[idx] = choices[idx].ptr(rect);
       VAL* outptr             = out.ptr(rect);
       const int64_t* indexptr = index_arr.ptr(rect);
-      choose_kernel_dense<VAL><<<blocks, THREADS_PER_BLOCK>>>(outptr, indexptr, ch_arr, volume);
+      with_choices(ch_ptrs, stream, [&](auto ch_arr) {
+        choose_kernel_dense<VAL><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+          outptr, indexptr, ch_arr, volume);
+      });
     } else {
-      DeferredBuffer<AccessorRO<VAL, DIM>, 1> ch_arr(Memory::Kind::Z_COPY_MEM,
-                                                     Rect<1>(0, choices.size() - 1));
-      for (uint32_t idx = 0; idx < choices.size(); ++idx) ch_arr[idx] = choices[idx];
-      choose_kernel<VAL, DIM>
-        <<<blocks, THREADS_PER_BLOCK>>>(out, index_arr, ch_arr, rect, pitches, volume);
+      with_choices(choices, stream, [&](auto ch_arr) {
+        choose_kernel<VAL, DIM>
+          <<<blocks, THREADS_PER_BLOCK, 0, stream>>>(out, index_arr, ch_arr, rect, pitches, volume);
+      });
     }
   }
 };
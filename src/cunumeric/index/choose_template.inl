@@ -62,7 +62,7 @@ template <VariantKind KIND>
 static void choose_template(TaskContext& context)
 {
   ChooseArgs args{context.outputs()[0], context.inputs()};
-  double_dispatch(args.inputs[0].dim(), args.inputs[0].code(), ChooseImpl<KIND>{}, args);
+  cunumeric::double_dispatch(args.inputs[0].dim(), args.inputs[0].code(), ChooseImpl<KIND>{}, args);
 }
 
 }  // namespace cunumeric
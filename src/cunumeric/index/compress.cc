@@ -0,0 +1,63 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/index/compress.h"
+#include "cunumeric/index/compress_template.inl"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <LegateTypeCode CODE, int DIM>
+struct CompressImplBody<VariantKind::CPU, CODE, DIM> {
+  using VAL = legate_type_of<CODE>;
+
+  size_t operator()(const AccessorRO<VAL, DIM>& in,
+                    const AccessorRO<bool, DIM>& mask,
+                    const Pitches<DIM - 1>& pitches,
+                    const Rect<DIM>& rect,
+                    const size_t volume,
+                    Buffer<VAL>& result)
+  {
+    int64_t size = 0;
+
+    for (size_t idx = 0; idx < volume; ++idx) size += mask[pitches.unflatten(idx, rect.lo)];
+
+    result = create_buffer<VAL>(size, Memory::Kind::SYSTEM_MEM);
+
+    int64_t out_idx = 0;
+    for (size_t idx = 0; idx < volume; ++idx) {
+      auto point = pitches.unflatten(idx, rect.lo);
+      if (mask[point]) result[out_idx++] = in[point];
+    }
+    assert(size == out_idx);
+
+    return size;
+  }
+};
+
+/*static*/ void CompressTask::cpu_variant(TaskContext& context)
+{
+  compress_template<VariantKind::CPU>(context);
+}
+
+namespace  // unnamed
+{
+static void __attribute__((constructor)) register_tasks(void) { CompressTask::register_variants(); }
+}  // namespace
+
+}  // namespace cunumeric
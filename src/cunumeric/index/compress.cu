@@ -0,0 +1,118 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/index/compress.h"
+#include "cunumeric/index/compress_template.inl"
+
+#include <thrust/scan.h>
+#include <thrust/execution_policy.h>
+
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+
+template <typename Pitches, typename Point, int32_t DIM>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  count_mask_kernel(
+    size_t volume, AccessorRO<bool, DIM> mask, Pitches pitches, Point origin, int64_t* counts)
+{
+  const size_t start = blockIdx.x * COMPACTION_TILE;
+  int64_t value      = 0;
+  for (size_t idx = 0; idx < COMPACTION_TILE_ITEMS; idx++) {
+    const size_t offset = start + idx * THREADS_PER_BLOCK + threadIdx.x;
+    if (offset < volume) value += mask[pitches.unflatten(offset, origin)];
+  }
+  // Every thread in the thread block must participate in the exchange to get correct results
+  value = block_reduce<SumReduction<int64_t>>(value);
+  if (threadIdx.x == 0) counts[blockIdx.x] = value;
+}
+
+template <typename Pitches, typename Point, typename VAL, int32_t DIM>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  compress_kernel(size_t volume,
+                  AccessorRO<VAL, DIM> in,
+                  AccessorRO<bool, DIM> mask,
+                  Pitches pitches,
+                  Point origin,
+                  const int64_t* offsets,
+                  VAL* result)
+{
+  const size_t start = blockIdx.x * COMPACTION_TILE;
+  int64_t next       = offsets[blockIdx.x];
+  for (size_t idx = 0; idx < COMPACTION_TILE_ITEMS; idx++) {
+    const size_t offset = start + idx * THREADS_PER_BLOCK + threadIdx.x;
+    Point point;
+    bool selected = false;
+    if (offset < volume) {
+      point    = pitches.unflatten(offset, origin);
+      selected = mask[point];
+    }
+    int total;
+    const int rank = block_exclusive_rank(selected, total);
+    if (selected) result[next + rank] = in[point];
+    next += total;
+  }
+}
+
+template <LegateTypeCode CODE, int32_t DIM>
+struct CompressImplBody<VariantKind::GPU, CODE, DIM> {
+  using VAL = legate_type_of<CODE>;
+
+  size_t operator()(const AccessorRO<VAL, DIM>& in,
+                    const AccessorRO<bool, DIM>& mask,
+                    const Pitches<DIM - 1>& pitches,
+                    const Rect<DIM>& rect,
+                    const size_t volume,
+                    Buffer<VAL>& result)
+  {
+    auto stream = get_cached_stream();
+
+    FastPitches<DIM - 1> fast_pitches;
+    fast_pitches.flatten(rect);
+
+    // The counts of the tiles are scanned into their offsets, whose extra last entry
+    // is the total
+    const size_t tiles = (volume + COMPACTION_TILE - 1) / COMPACTION_TILE;
+    ScratchBuffer<int64_t> offsets(tiles + 1);
+    auto p_offsets = offsets.ptr(0);
+    CHECK_CUDA(cudaMemsetAsync(p_offsets + tiles, 0, sizeof(int64_t), stream));
+    count_mask_kernel<<<tiles, THREADS_PER_BLOCK, 0, stream>>>(
+      volume, mask, fast_pitches, rect.lo, p_offsets);
+    thrust::exclusive_scan(
+      thrust::cuda::par.on(stream), p_offsets, p_offsets + tiles + 1, p_offsets);
+
+    int64_t size = 0;
+    CHECK_CUDA(cudaMemcpyAsync(
+      &size, p_offsets + tiles, sizeof(int64_t), cudaMemcpyDeviceToHost, stream));
+    CHECK_CUDA(cudaStreamSynchronize(stream));
+
+    result = create_buffer<VAL>(size, Memory::Kind::GPU_FB_MEM);
+    if (size > 0)
+      compress_kernel<<<tiles, THREADS_PER_BLOCK, 0, stream>>>(
+        volume, in, mask, fast_pitches, rect.lo, p_offsets, result.ptr(0));
+
+    return size;
+  }
+};
+
+/*static*/ void CompressTask::gpu_variant(TaskContext& context)
+{
+  compress_template<VariantKind::GPU>(context);
+}
+
+}  // namespace cunumeric
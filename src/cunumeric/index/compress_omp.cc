@@ -0,0 +1,96 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/index/compress.h"
+#include "cunumeric/index/compress_template.inl"
+
+#include <omp.h>
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <LegateTypeCode CODE, int DIM>
+struct CompressImplBody<VariantKind::OMP, CODE, DIM> {
+  using VAL = legate_type_of<CODE>;
+
+  // Counts of different chunks live on different cache lines so that the threads do not
+  // keep stealing them from each other while they count
+  struct alignas(64) ChunkCount {
+    int64_t value;
+  };
+
+  size_t operator()(const AccessorRO<VAL, DIM>& in,
+                    const AccessorRO<bool, DIM>& mask,
+                    const Pitches<DIM - 1>& pitches,
+                    const Rect<DIM>& rect,
+                    const size_t volume,
+                    Buffer<VAL>& result)
+  {
+    // Same chunking as the nonzero task: both passes visit the chunks in the same way,
+    // so every chunk writes exactly what it counted
+    const size_t num_chunks = std::min<size_t>(omp_get_max_threads(), volume);
+    const size_t chunk_size = (volume + num_chunks - 1) / num_chunks;
+
+    auto counts = create_buffer<ChunkCount>(num_chunks, Memory::Kind::SYSTEM_MEM);
+#pragma omp parallel
+    {
+      const size_t tid     = omp_get_thread_num();
+      const size_t threads = omp_get_num_threads();
+      for (size_t chunk = tid; chunk < num_chunks; chunk += threads) {
+        const size_t end = std::min(volume, (chunk + 1) * chunk_size);
+        int64_t count    = 0;
+        for (size_t idx = chunk * chunk_size; idx < end; ++idx)
+          count += mask[pitches.unflatten(idx, rect.lo)];
+        counts[chunk].value = count;
+      }
+    }
+
+    int64_t size = 0;
+    for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
+      const int64_t count = counts[chunk].value;
+      counts[chunk].value = size;
+      size += count;
+    }
+
+    result = create_buffer<VAL>(size, Memory::Kind::SYSTEM_MEM);
+    if (size == 0) return size;
+
+#pragma omp parallel
+    {
+      const size_t tid     = omp_get_thread_num();
+      const size_t threads = omp_get_num_threads();
+      for (size_t chunk = tid; chunk < num_chunks; chunk += threads) {
+        const size_t end = std::min(volume, (chunk + 1) * chunk_size);
+        int64_t out_idx  = counts[chunk].value;
+        for (size_t idx = chunk * chunk_size; idx < end; ++idx) {
+          auto point = pitches.unflatten(idx, rect.lo);
+          if (mask[point]) result[out_idx++] = in[point];
+        }
+      }
+    }
+
+    return size;
+  }
+};
+
+/*static*/ void CompressTask::omp_variant(TaskContext& context)
+{
+  compress_template<VariantKind::OMP>(context);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,62 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/pitches.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <VariantKind KIND, LegateTypeCode CODE, int DIM>
+struct CompressImplBody;
+
+template <VariantKind KIND>
+struct CompressImpl {
+  template <LegateTypeCode CODE, int DIM>
+  void operator()(CompressArgs& args) const
+  {
+    using VAL = legate_type_of<CODE>;
+
+    auto rect = args.input.shape<DIM>();
+
+    Pitches<DIM - 1> pitches;
+    size_t volume = pitches.flatten(rect);
+
+    if (volume == 0) {
+      auto empty = create_buffer<VAL>(0);
+      args.output.return_data(empty, 0);
+      return;
+    }
+
+    auto in   = args.input.read_accessor<VAL, DIM>(rect);
+    auto mask = args.mask.read_accessor<bool, DIM>(rect);
+    Buffer<VAL> result;
+    auto size = CompressImplBody<KIND, CODE, DIM>()(in, mask, pitches, rect, volume, result);
+
+    args.output.return_data(result, size);
+  }
+};
+
+template <VariantKind KIND>
+static void compress_template(TaskContext& context)
+{
+  auto& inputs = context.inputs();
+  CompressArgs args{inputs[0], inputs[1], context.outputs()[0]};
+  cunumeric::double_dispatch(args.input.dim(), args.input.code(), CompressImpl<KIND>{}, args);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,51 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/index/gather.h"
+#include "cunumeric/index/gather_template.inl"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <typename VAL, int32_t IDX_DIM, int32_t SRC_DIM>
+struct GatherImplBody<VariantKind::CPU, VAL, IDX_DIM, SRC_DIM> {
+  void operator()(const AccessorWO<VAL, IDX_DIM>& out,
+                  const AccessorRO<VAL, SRC_DIM>& src,
+                  const IndexPoints<IDX_DIM, SRC_DIM>& points,
+                  const Pitches<IDX_DIM - 1>& pitches,
+                  const Rect<IDX_DIM>& rect,
+                  const size_t volume) const
+  {
+    for (size_t idx = 0; idx < volume; ++idx) {
+      auto point = pitches.unflatten(idx, rect.lo);
+      out[point] = src[points(point)];
+    }
+  }
+};
+
+/*static*/ void GatherTask::cpu_variant(TaskContext& context)
+{
+  gather_template<VariantKind::CPU>(context);
+}
+
+namespace  // unnamed
+{
+static void __attribute__((constructor)) register_tasks(void) { GatherTask::register_variants(); }
+}  // namespace
+
+}  // namespace cunumeric
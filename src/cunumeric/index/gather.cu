@@ -0,0 +1,62 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/index/gather.h"
+#include "cunumeric/index/gather_template.inl"
+
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+
+template <typename VAL, int32_t IDX_DIM, int32_t SRC_DIM>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  gather_kernel(size_t volume,
+                AccessorWO<VAL, IDX_DIM> out,
+                AccessorRO<VAL, SRC_DIM> src,
+                IndexPoints<IDX_DIM, SRC_DIM> points,
+                Pitches<IDX_DIM - 1> pitches,
+                Point<IDX_DIM> origin)
+{
+  const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx >= volume) return;
+  auto point = pitches.unflatten(idx, origin);
+  out[point] = src[points(point)];
+}
+
+template <typename VAL, int32_t IDX_DIM, int32_t SRC_DIM>
+struct GatherImplBody<VariantKind::GPU, VAL, IDX_DIM, SRC_DIM> {
+  void operator()(const AccessorWO<VAL, IDX_DIM>& out,
+                  const AccessorRO<VAL, SRC_DIM>& src,
+                  const IndexPoints<IDX_DIM, SRC_DIM>& points,
+                  const Pitches<IDX_DIM - 1>& pitches,
+                  const Rect<IDX_DIM>& rect,
+                  const size_t volume) const
+  {
+    auto stream         = get_cached_stream();
+    const size_t blocks = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+    gather_kernel<VAL, IDX_DIM, SRC_DIM><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+      volume, out, src, points, pitches, rect.lo);
+  }
+};
+
+/*static*/ void GatherTask::gpu_variant(TaskContext& context)
+{
+  gather_template<VariantKind::GPU>(context);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,46 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "cunumeric/cunumeric.h"
+
+namespace cunumeric {
+
+struct GatherArgs {
+  const Array& out;
+  // The source array followed by one index array per dimension of the source
+  const std::vector<Array>& inputs;
+};
+
+// Reads the elements of the source at the points that the index arrays select, one
+// int64 index array per dimension of the source. The source is broadcast to every
+// point task and the index arrays are aligned with the output.
+class GatherTask : public CuNumericTask<GatherTask> {
+ public:
+  static const int TASK_ID = CUNUMERIC_GATHER;
+
+ public:
+  static void cpu_variant(legate::TaskContext& context);
+#ifdef LEGATE_USE_OPENMP
+  static void omp_variant(legate::TaskContext& context);
+#endif
+#ifdef LEGATE_USE_CUDA
+  static void gpu_variant(legate::TaskContext& context);
+#endif
+};
+
+}  // namespace cunumeric
@@ -0,0 +1,68 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/index/index_util.h"
+#include "cunumeric/pitches.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <VariantKind KIND, typename VAL, int32_t IDX_DIM, int32_t SRC_DIM>
+struct GatherImplBody;
+
+template <VariantKind KIND, typename VAL>
+struct GatherImpl {
+  template <int32_t IDX_DIM, int32_t SRC_DIM>
+  void operator()(GatherArgs& args) const
+  {
+    auto rect = args.out.shape<IDX_DIM>();
+
+    Pitches<IDX_DIM - 1> pitches;
+    size_t volume = pitches.flatten(rect);
+
+    if (volume == 0) return;
+
+    auto& source  = args.inputs[0];
+    auto src_rect = source.shape<SRC_DIM>();
+
+    auto out = args.out.write_accessor<VAL, IDX_DIM>(rect);
+    auto src = source.read_accessor<VAL, SRC_DIM>(src_rect);
+    IndexPoints<IDX_DIM, SRC_DIM> points(args.inputs, 1, rect, src_rect);
+
+    GatherImplBody<KIND, VAL, IDX_DIM, SRC_DIM>{}(out, src, points, pitches, rect, volume);
+  }
+};
+
+template <VariantKind KIND>
+struct GatherDispatch {
+  template <LegateTypeCode CODE>
+  void operator()(GatherArgs& args) const
+  {
+    using VAL = legate_type_of<CODE>;
+    cunumeric::double_dispatch(args.out.dim(), args.inputs[0].dim(), GatherImpl<KIND, VAL>{}, args);
+  }
+};
+
+template <VariantKind KIND>
+static void gather_template(TaskContext& context)
+{
+  GatherArgs args{context.outputs()[0], context.inputs()};
+  cunumeric::type_dispatch(args.out.code(), GatherDispatch<KIND>{}, args);
+}
+
+}  // namespace cunumeric
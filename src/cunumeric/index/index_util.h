@@ -0,0 +1,54 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "cunumeric/cunumeric.h"
+
+namespace cunumeric {
+
+// The points of an array of SRC_DIM dimensions that SRC_DIM int64 index arrays of
+// IDX_DIM dimensions select, with negative indices counted from the end of each
+// dimension as in NumPy
+template <int32_t IDX_DIM, int32_t SRC_DIM>
+struct IndexPoints {
+  IndexPoints(const std::vector<Array>& stores,
+              size_t first,
+              const Legion::Rect<IDX_DIM>& rect,
+              const Legion::Rect<SRC_DIM>& src_rect)
+    : lo(src_rect.lo), extents(src_rect.hi - src_rect.lo + Legion::Point<SRC_DIM>::ONES())
+  {
+    for (int32_t dim = 0; dim < SRC_DIM; ++dim)
+      indices[dim] = stores[first + dim].read_accessor<int64_t, IDX_DIM>(rect);
+  }
+
+  __CUDA_HD__ Legion::Point<SRC_DIM> operator()(const Legion::Point<IDX_DIM>& point) const
+  {
+    Legion::Point<SRC_DIM> result;
+    for (int32_t dim = 0; dim < SRC_DIM; ++dim) {
+      int64_t index = indices[dim][point];
+      if (index < 0) index += extents[dim];
+      result[dim] = lo[dim] + index;
+    }
+    return result;
+  }
+
+  legate::AccessorRO<int64_t, IDX_DIM> indices[SRC_DIM];
+  Legion::Point<SRC_DIM> lo;
+  Legion::Point<SRC_DIM> extents;
+};
+
+}  // namespace cunumeric
@@ -0,0 +1,64 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/index/place.h"
+#include "cunumeric/index/place_template.inl"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <LegateTypeCode CODE, int DIM>
+struct PlaceImplBody<VariantKind::CPU, CODE, DIM> {
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(const AccessorRW<VAL, DIM>& out,
+                  const AccessorRO<bool, DIM>& mask,
+                  const AccessorRO<VAL, 1>& values,
+                  const coord_t values_lo,
+                  const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& rect,
+                  const size_t volume,
+                  const bool broadcast) const
+  {
+    if (broadcast) {
+      const VAL value = values[values_lo];
+      for (size_t idx = 0; idx < volume; ++idx) {
+        auto point = pitches.unflatten(idx, rect.lo);
+        if (mask[point]) out[point] = value;
+      }
+    } else {
+      coord_t next = values_lo;
+      for (size_t idx = 0; idx < volume; ++idx) {
+        auto point = pitches.unflatten(idx, rect.lo);
+        if (mask[point]) out[point] = values[next++];
+      }
+    }
+  }
+};
+
+/*static*/ void PlaceTask::cpu_variant(TaskContext& context)
+{
+  place_template<VariantKind::CPU>(context);
+}
+
+namespace  // unnamed
+{
+static void __attribute__((constructor)) register_tasks(void) { PlaceTask::register_variants(); }
+}  // namespace
+
+}  // namespace cunumeric
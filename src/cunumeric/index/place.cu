@@ -0,0 +1,131 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/index/place.h"
+#include "cunumeric/index/place_template.inl"
+
+#include <thrust/scan.h>
+#include <thrust/execution_policy.h>
+
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+
+template <typename Pitches, typename Point, typename VAL, int32_t DIM>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  place_scalar_kernel(size_t volume,
+                      AccessorRW<VAL, DIM> out,
+                      AccessorRO<bool, DIM> mask,
+                      AccessorRO<VAL, 1> values,
+                      coord_t values_lo,
+                      Pitches pitches,
+                      Point origin)
+{
+  const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx >= volume) return;
+  auto point = pitches.unflatten(idx, origin);
+  if (mask[point]) out[point] = values[values_lo];
+}
+
+template <typename Pitches, typename Point, int32_t DIM>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  count_mask_kernel(
+    size_t volume, AccessorRO<bool, DIM> mask, Pitches pitches, Point origin, int64_t* counts)
+{
+  const size_t start = blockIdx.x * COMPACTION_TILE;
+  int64_t value      = 0;
+  for (size_t idx = 0; idx < COMPACTION_TILE_ITEMS; idx++) {
+    const size_t offset = start + idx * THREADS_PER_BLOCK + threadIdx.x;
+    if (offset < volume) value += mask[pitches.unflatten(offset, origin)];
+  }
+  // Every thread in the thread block must participate in the exchange to get correct results
+  value = block_reduce<SumReduction<int64_t>>(value);
+  if (threadIdx.x == 0) counts[blockIdx.x] = value;
+}
+
+template <typename Pitches, typename Point, typename VAL, int32_t DIM>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  place_kernel(size_t volume,
+               AccessorRW<VAL, DIM> out,
+               AccessorRO<bool, DIM> mask,
+               AccessorRO<VAL, 1> values,
+               coord_t values_lo,
+               Pitches pitches,
+               Point origin,
+               const int64_t* offsets)
+{
+  const size_t start = blockIdx.x * COMPACTION_TILE;
+  int64_t next       = values_lo + offsets[blockIdx.x];
+  for (size_t idx = 0; idx < COMPACTION_TILE_ITEMS; idx++) {
+    const size_t offset = start + idx * THREADS_PER_BLOCK + threadIdx.x;
+    Point point;
+    bool selected = false;
+    if (offset < volume) {
+      point    = pitches.unflatten(offset, origin);
+      selected = mask[point];
+    }
+    int total;
+    const int rank = block_exclusive_rank(selected, total);
+    if (selected) out[point] = values[next + rank];
+    next += total;
+  }
+}
+
+template <LegateTypeCode CODE, int32_t DIM>
+struct PlaceImplBody<VariantKind::GPU, CODE, DIM> {
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(const AccessorRW<VAL, DIM>& out,
+                  const AccessorRO<bool, DIM>& mask,
+                  const AccessorRO<VAL, 1>& values,
+                  const coord_t values_lo,
+                  const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& rect,
+                  const size_t volume,
+                  const bool broadcast) const
+  {
+    auto stream = get_cached_stream();
+
+    FastPitches<DIM - 1> fast_pitches;
+    fast_pitches.flatten(rect);
+
+    if (broadcast) {
+      const size_t blocks = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+      place_scalar_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+        volume, out, mask, values, values_lo, fast_pitches, rect.lo);
+      return;
+    }
+
+    // The points of every tile take the values after those of the tiles before it
+    const size_t tiles = (volume + COMPACTION_TILE - 1) / COMPACTION_TILE;
+    ScratchBuffer<int64_t> offsets(tiles);
+    auto p_offsets = offsets.ptr(0);
+    count_mask_kernel<<<tiles, THREADS_PER_BLOCK, 0, stream>>>(
+      volume, mask, fast_pitches, rect.lo, p_offsets);
+    thrust::exclusive_scan(thrust::cuda::par.on(stream), p_offsets, p_offsets + tiles, p_offsets);
+    place_kernel<<<tiles, THREADS_PER_BLOCK, 0, stream>>>(
+      volume, out, mask, values, values_lo, fast_pitches, rect.lo, p_offsets);
+  }
+};
+
+/*static*/ void PlaceTask::gpu_variant(TaskContext& context)
+{
+  place_template<VariantKind::GPU>(context);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,101 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/index/place.h"
+#include "cunumeric/index/place_template.inl"
+
+#include <omp.h>
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <LegateTypeCode CODE, int DIM>
+struct PlaceImplBody<VariantKind::OMP, CODE, DIM> {
+  using VAL = legate_type_of<CODE>;
+
+  struct alignas(64) ChunkCount {
+    int64_t value;
+  };
+
+  void operator()(const AccessorRW<VAL, DIM>& out,
+                  const AccessorRO<bool, DIM>& mask,
+                  const AccessorRO<VAL, 1>& values,
+                  const coord_t values_lo,
+                  const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& rect,
+                  const size_t volume,
+                  const bool broadcast) const
+  {
+    if (broadcast) {
+      const VAL value = values[values_lo];
+#pragma omp parallel for schedule(static)
+      for (size_t idx = 0; idx < volume; ++idx) {
+        auto point = pitches.unflatten(idx, rect.lo);
+        if (mask[point]) out[point] = value;
+      }
+      return;
+    }
+
+    // Every chunk takes the values after those of the chunks before it, which the
+    // first pass counts
+    const size_t num_chunks = std::min<size_t>(omp_get_max_threads(), volume);
+    const size_t chunk_size = (volume + num_chunks - 1) / num_chunks;
+
+    auto counts = create_buffer<ChunkCount>(num_chunks, Memory::Kind::SYSTEM_MEM);
+#pragma omp parallel
+    {
+      const size_t tid     = omp_get_thread_num();
+      const size_t threads = omp_get_num_threads();
+      for (size_t chunk = tid; chunk < num_chunks; chunk += threads) {
+        const size_t end = std::min(volume, (chunk + 1) * chunk_size);
+        int64_t count    = 0;
+        for (size_t idx = chunk * chunk_size; idx < end; ++idx)
+          count += mask[pitches.unflatten(idx, rect.lo)];
+        counts[chunk].value = count;
+      }
+    }
+
+    int64_t offset = values_lo;
+    for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
+      const int64_t count = counts[chunk].value;
+      counts[chunk].value = offset;
+      offset += count;
+    }
+
+#pragma omp parallel
+    {
+      const size_t tid     = omp_get_thread_num();
+      const size_t threads = omp_get_num_threads();
+      for (size_t chunk = tid; chunk < num_chunks; chunk += threads) {
+        const size_t end = std::min(volume, (chunk + 1) * chunk_size);
+        coord_t next     = counts[chunk].value;
+        for (size_t idx = chunk * chunk_size; idx < end; ++idx) {
+          auto point = pitches.unflatten(idx, rect.lo);
+          if (mask[point]) out[point] = values[next++];
+        }
+      }
+    }
+  }
+};
+
+/*static*/ void PlaceTask::omp_variant(TaskContext& context)
+{
+  place_template<VariantKind::OMP>(context);
+}
+
+}  // namespace cunumeric
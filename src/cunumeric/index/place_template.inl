@@ -0,0 +1,60 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/pitches.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <VariantKind KIND, LegateTypeCode CODE, int DIM>
+struct PlaceImplBody;
+
+template <VariantKind KIND>
+struct PlaceImpl {
+  template <LegateTypeCode CODE, int DIM>
+  void operator()(PlaceArgs& args) const
+  {
+    using VAL = legate_type_of<CODE>;
+
+    auto rect = args.out.shape<DIM>();
+
+    Pitches<DIM - 1> pitches;
+    size_t volume = pitches.flatten(rect);
+
+    if (volume == 0) return;
+
+    auto out         = args.out.read_write_accessor<VAL, DIM>(rect);
+    auto mask        = args.mask.read_accessor<bool, DIM>(rect);
+    auto values_rect = args.values.shape<1>();
+    auto values      = args.values.read_accessor<VAL, 1>(values_rect);
+
+    PlaceImplBody<KIND, CODE, DIM>()(
+      out, mask, values, values_rect.lo[0], pitches, rect, volume, args.broadcast);
+  }
+};
+
+template <VariantKind KIND>
+static void place_template(TaskContext& context)
+{
+  auto& inputs = context.inputs();
+  // The output is also the first input, which gives the task read-write access to it
+  PlaceArgs args{context.outputs()[0], inputs[1], inputs[2], context.scalars()[0].value<bool>()};
+  cunumeric::double_dispatch(args.out.dim(), args.out.code(), PlaceImpl<KIND>{}, args);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,65 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/index/scatter.h"
+#include "cunumeric/index/scatter_template.inl"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <typename VAL, int32_t IDX_DIM, int32_t SRC_DIM>
+struct ScatterImplBody<VariantKind::CPU, VAL, IDX_DIM, SRC_DIM> {
+  void operator()(const AccessorWO<VAL, SRC_DIM>& target,
+                  const AccessorRO<VAL, IDX_DIM>& values,
+                  const IndexPoints<IDX_DIM, SRC_DIM>& points,
+                  const Pitches<IDX_DIM - 1>& pitches,
+                  const Rect<IDX_DIM>& rect,
+                  const size_t volume) const
+  {
+    for (size_t idx = 0; idx < volume; ++idx) {
+      auto point            = pitches.unflatten(idx, rect.lo);
+      target[points(point)] = values[point];
+    }
+  }
+
+  template <typename REDOP>
+  void operator()(const AccessorRD<REDOP, true, SRC_DIM>& target,
+                  const AccessorRO<VAL, IDX_DIM>& values,
+                  const IndexPoints<IDX_DIM, SRC_DIM>& points,
+                  const Pitches<IDX_DIM - 1>& pitches,
+                  const Rect<IDX_DIM>& rect,
+                  const size_t volume) const
+  {
+    for (size_t idx = 0; idx < volume; ++idx) {
+      auto point = pitches.unflatten(idx, rect.lo);
+      target.reduce(points(point), values[point]);
+    }
+  }
+};
+
+/*static*/ void ScatterTask::cpu_variant(TaskContext& context)
+{
+  scatter_template<VariantKind::CPU>(context);
+}
+
+namespace  // unnamed
+{
+static void __attribute__((constructor)) register_tasks(void) { ScatterTask::register_variants(); }
+}  // namespace
+
+}  // namespace cunumeric
@@ -0,0 +1,68 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/index/scatter.h"
+#include "cunumeric/index/scatter_template.inl"
+
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+
+// Repeated indices race in an assignment, so any one of their values ends up in the
+// target, which NumPy leaves unspecified as well
+template <typename Target, typename VAL, int32_t IDX_DIM, int32_t SRC_DIM>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  scatter_kernel(size_t volume,
+                 Target target,
+                 AccessorRO<VAL, IDX_DIM> values,
+                 IndexPoints<IDX_DIM, SRC_DIM> points,
+                 Pitches<IDX_DIM - 1> pitches,
+                 Point<IDX_DIM> origin)
+{
+  const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx >= volume) return;
+  auto point = pitches.unflatten(idx, origin);
+  if constexpr (std::is_same<Target, AccessorWO<VAL, SRC_DIM>>::value)
+    target[points(point)] = values[point];
+  else
+    target.reduce(points(point), values[point]);
+}
+
+template <typename VAL, int32_t IDX_DIM, int32_t SRC_DIM>
+struct ScatterImplBody<VariantKind::GPU, VAL, IDX_DIM, SRC_DIM> {
+  template <typename Target>
+  void operator()(const Target& target,
+                  const AccessorRO<VAL, IDX_DIM>& values,
+                  const IndexPoints<IDX_DIM, SRC_DIM>& points,
+                  const Pitches<IDX_DIM - 1>& pitches,
+                  const Rect<IDX_DIM>& rect,
+                  const size_t volume) const
+  {
+    auto stream         = get_cached_stream();
+    const size_t blocks = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+    scatter_kernel<Target, VAL, IDX_DIM, SRC_DIM><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+      volume, target, values, points, pitches, rect.lo);
+  }
+};
+
+/*static*/ void ScatterTask::gpu_variant(TaskContext& context)
+{
+  scatter_template<VariantKind::GPU>(context);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,49 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "cunumeric/cunumeric.h"
+
+namespace cunumeric {
+
+struct ScatterArgs {
+  const Array& target;
+  // One index array per dimension of the target followed by the values
+  const std::vector<Array>& inputs;
+  // A Legion reduction operator kind, or -1 to overwrite the target
+  int32_t redop;
+};
+
+// Writes the values into the points of the target that the index arrays select, one
+// int64 index array per dimension of the target. The values are either assigned, in a
+// single point task, or folded in with the sum or max of np.add.at and np.maximum.at by
+// any number of point tasks.
+class ScatterTask : public CuNumericTask<ScatterTask> {
+ public:
+  static const int TASK_ID = CUNUMERIC_SCATTER;
+
+ public:
+  static void cpu_variant(legate::TaskContext& context);
+#ifdef LEGATE_USE_OPENMP
+  static void omp_variant(legate::TaskContext& context);
+#endif
+#ifdef LEGATE_USE_CUDA
+  static void gpu_variant(legate::TaskContext& context);
+#endif
+};
+
+}  // namespace cunumeric
@@ -0,0 +1,63 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/index/scatter.h"
+#include "cunumeric/index/scatter_template.inl"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <typename VAL, int32_t IDX_DIM, int32_t SRC_DIM>
+struct ScatterImplBody<VariantKind::OMP, VAL, IDX_DIM, SRC_DIM> {
+  // Assignments keep the serial order, in which the last of repeated indices wins as
+  // it does in NumPy
+  void operator()(const AccessorWO<VAL, SRC_DIM>& target,
+                  const AccessorRO<VAL, IDX_DIM>& values,
+                  const IndexPoints<IDX_DIM, SRC_DIM>& points,
+                  const Pitches<IDX_DIM - 1>& pitches,
+                  const Rect<IDX_DIM>& rect,
+                  const size_t volume) const
+  {
+    for (size_t idx = 0; idx < volume; ++idx) {
+      auto point            = pitches.unflatten(idx, rect.lo);
+      target[points(point)] = values[point];
+    }
+  }
+
+  template <typename REDOP>
+  void operator()(const AccessorRD<REDOP, false, SRC_DIM>& target,
+                  const AccessorRO<VAL, IDX_DIM>& values,
+                  const IndexPoints<IDX_DIM, SRC_DIM>& points,
+                  const Pitches<IDX_DIM - 1>& pitches,
+                  const Rect<IDX_DIM>& rect,
+                  const size_t volume) const
+  {
+#pragma omp parallel for schedule(static)
+    for (size_t idx = 0; idx < volume; ++idx) {
+      auto point = pitches.unflatten(idx, rect.lo);
+      target.reduce(points(point), values[point]);
+    }
+  }
+};
+
+/*static*/ void ScatterTask::omp_variant(TaskContext& context)
+{
+  scatter_template<VariantKind::OMP>(context);
+}
+
+}  // namespace cunumeric
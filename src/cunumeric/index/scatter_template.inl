@@ -0,0 +1,95 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/index/index_util.h"
+#include "cunumeric/pitches.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <VariantKind KIND, typename VAL, int32_t IDX_DIM, int32_t SRC_DIM>
+struct ScatterImplBody;
+
+template <VariantKind KIND, LegateTypeCode CODE>
+struct ScatterImpl {
+  using VAL = legate_type_of<CODE>;
+
+  // Complex numbers have no maximum, and only reduce through the sum
+  static constexpr bool reducible =
+    legate::is_integral<CODE>::value || legate::is_floating_point<CODE>::value;
+
+  template <int32_t IDX_DIM, int32_t SRC_DIM>
+  void operator()(ScatterArgs& args) const
+  {
+    const size_t num_indices = args.inputs.size() - 1;
+    auto rect                = args.inputs[num_indices].shape<IDX_DIM>();
+
+    Pitches<IDX_DIM - 1> pitches;
+    size_t volume = pitches.flatten(rect);
+
+    if (volume == 0) return;
+
+    auto target_rect = args.target.shape<SRC_DIM>();
+    auto values      = args.inputs[num_indices].read_accessor<VAL, IDX_DIM>(rect);
+    IndexPoints<IDX_DIM, SRC_DIM> points(args.inputs, 0, rect, target_rect);
+
+    ScatterImplBody<KIND, VAL, IDX_DIM, SRC_DIM> body;
+    if (args.redop < 0) {
+      auto target = args.target.write_accessor<VAL, SRC_DIM>(target_rect);
+      body(target, values, points, pitches, rect, volume);
+      return;
+    }
+    if constexpr (reducible) {
+      // The CPU variant is the only one that folds without atomics
+      constexpr bool EXCLUSIVE = KIND == VariantKind::CPU;
+      if (args.redop == LEGION_REDOP_KIND_SUM) {
+        auto target =
+          args.target.reduce_accessor<SumReduction<VAL>, EXCLUSIVE, SRC_DIM>(target_rect);
+        body(target, values, points, pitches, rect, volume);
+        return;
+      } else if (args.redop == LEGION_REDOP_KIND_MAX) {
+        auto target =
+          args.target.reduce_accessor<MaxReduction<VAL>, EXCLUSIVE, SRC_DIM>(target_rect);
+        body(target, values, points, pitches, rect, volume);
+        return;
+      }
+    }
+    assert(false);
+  }
+};
+
+template <VariantKind KIND>
+struct ScatterDispatch {
+  template <LegateTypeCode CODE>
+  void operator()(ScatterArgs& args) const
+  {
+    auto& values = args.inputs.back();
+    cunumeric::double_dispatch(values.dim(), args.target.dim(), ScatterImpl<KIND, CODE>{}, args);
+  }
+};
+
+template <VariantKind KIND>
+static void scatter_template(TaskContext& context)
+{
+  auto redop   = context.scalars()[0].value<int32_t>();
+  auto& target = redop < 0 ? context.outputs()[0] : context.reductions()[0];
+  ScatterArgs args{target, context.inputs(), redop};
+  cunumeric::type_dispatch(args.target.code(), ScatterDispatch<KIND>{}, args);
+}
+
+}  // namespace cunumeric
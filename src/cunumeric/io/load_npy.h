@@ -0,0 +1,36 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#pragma once
+
+#include "cunumeric/io/npy_util.h"
+
+namespace cunumeric {
+
+// Reads the tile of the output of every point task from the data of an .npy file
+class LoadNpyTask : public CuNumericTask<LoadNpyTask> {
+ public:
+  static const int TASK_ID = CUNUMERIC_LOAD_NPY;
+
+ public:
+  static void cpu_variant(legate::TaskContext& context);
+#ifdef LEGATE_USE_OPENMP
+  static void omp_variant(legate::TaskContext& context);
+#endif
+};
+
+}  // namespace cunumeric
@@ -0,0 +1,79 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/pitches.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <VariantKind KIND, LegateTypeCode CODE, int DIM>
+struct LoadNpyImplBody;
+
+// Reads the row-th innermost row of the tile through the buffer, which holds a row
+template <typename VAL, int DIM>
+inline void load_npy_row(int fd,
+                         const AccessorWO<VAL, DIM>& out,
+                         const Pitches<DIM - 1>& pitches,
+                         const Rect<DIM>& rect,
+                         const NpyArgs& args,
+                         size_t row,
+                         VAL* buffer)
+{
+  const size_t length = rect.hi[DIM - 1] - rect.lo[DIM - 1] + 1;
+  auto p              = pitches.unflatten(row * length, rect.lo);
+  read_npy(fd, buffer, length * sizeof(VAL), npy_position(p, args.shape, sizeof(VAL), args.offset));
+  for (size_t k = 0; k < length; ++k, ++p[DIM - 1]) out[p] = buffer[k];
+}
+
+template <VariantKind KIND>
+struct LoadNpyImpl {
+  template <LegateTypeCode CODE, int DIM>
+  void operator()(NpyArgs& args) const
+  {
+    using VAL = legate_type_of<CODE>;
+
+    auto rect = args.array.shape<DIM>();
+
+    Pitches<DIM - 1> pitches;
+    size_t volume = pitches.flatten(rect);
+
+    if (volume == 0) return;
+
+    auto out = args.array.write_accessor<VAL, DIM>(rect);
+
+    int fd = open_npy(args.path, O_RDONLY);
+    LoadNpyImplBody<KIND, CODE, DIM>()(fd, out, pitches, rect, args);
+    close(fd);
+  }
+};
+
+template <VariantKind KIND>
+static void load_npy_template(TaskContext& context)
+{
+  auto& outputs = context.outputs();
+  auto& scalars = context.scalars();
+
+  NpyArgs args{outputs[0],
+               npy_path(scalars[0].values<uint8_t>()),
+               scalars[1].values<int64_t>(),
+               scalars[2].value<int64_t>()};
+  cunumeric::double_dispatch(args.array.dim(), args.array.code(), LoadNpyImpl<KIND>{}, args);
+}
+
+}  // namespace cunumeric
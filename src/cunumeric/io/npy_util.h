@@ -0,0 +1,106 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#pragma once
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <string>
+
+#include "cunumeric/cunumeric.h"
+
+namespace cunumeric {
+
+// Every point task of a save or load reads or writes the rows of its own tile
+// of the data of an .npy file, whose header the Python side handles
+
+struct NpyArgs {
+  const Array& array;
+  std::string path;
+  legate::Span<const int64_t> shape;
+  int64_t offset;
+};
+
+// The path of the file is passed as its bytes
+inline std::string npy_path(legate::Span<const uint8_t> bytes)
+{
+  std::string path;
+  path.reserve(bytes.size());
+  for (size_t idx = 0; idx < bytes.size(); ++idx) path.push_back(static_cast<char>(bytes[idx]));
+  return path;
+}
+
+// The position in the file of the element at the point of a C order array
+template <int DIM>
+inline int64_t npy_position(const Legion::Point<DIM>& point,
+                            legate::Span<const int64_t> shape,
+                            size_t itemsize,
+                            int64_t offset)
+{
+  int64_t index = 0;
+  for (int32_t dim = 0; dim < DIM; ++dim) index = index * shape[dim] + point[dim];
+  return offset + index * static_cast<int64_t>(itemsize);
+}
+
+inline int open_npy(const std::string& path, int flags)
+{
+  int fd = open(path.c_str(), flags);
+  if (fd < 0) {
+    fprintf(stderr, "Failed to open %s: %s\n", path.c_str(), strerror(errno));
+    LEGATE_ABORT;
+  }
+  return fd;
+}
+
+inline void write_npy(int fd, const void* buffer, size_t size, int64_t position)
+{
+  auto bytes = static_cast<const char*>(buffer);
+  while (size > 0) {
+    ssize_t written = pwrite(fd, bytes, size, position);
+    if (written < 0 && errno == EINTR) continue;
+    if (written < 0) {
+      fprintf(stderr, "Failed to write an .npy file: %s\n", strerror(errno));
+      LEGATE_ABORT;
+    }
+    bytes += written;
+    size -= written;
+    position += written;
+  }
+}
+
+inline void read_npy(int fd, void* buffer, size_t size, int64_t position)
+{
+  auto bytes = static_cast<char*>(buffer);
+  while (size > 0) {
+    ssize_t count = pread(fd, bytes, size, position);
+    if (count < 0 && errno == EINTR) continue;
+    if (count <= 0) {
+      fprintf(stderr,
+              "Failed to read an .npy file: %s\n",
+              count < 0 ? strerror(errno) : "the file is too short");
+      LEGATE_ABORT;
+    }
+    bytes += count;
+    size -= count;
+    position += count;
+  }
+}
+
+}  // namespace cunumeric
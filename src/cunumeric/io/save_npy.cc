@@ -0,0 +1,56 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include <memory>
+
+#include "cunumeric/io/save_npy.h"
+#include "cunumeric/io/save_npy_template.inl"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <LegateTypeCode CODE, int32_t DIM>
+struct SaveNpyImplBody<VariantKind::CPU, CODE, DIM> {
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(int fd,
+                  AccessorRO<VAL, DIM> in,
+                  const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& rect,
+                  const NpyArgs& args) const
+  {
+    const size_t length = rect.hi[DIM - 1] - rect.lo[DIM - 1] + 1;
+    const size_t rows   = rect.volume() / length;
+    std::unique_ptr<VAL[]> buffer(new VAL[length]);
+    for (size_t row = 0; row < rows; ++row)
+      save_npy_row(fd, in, pitches, rect, args, row, buffer.get());
+  }
+};
+
+/*static*/ void SaveNpyTask::cpu_variant(TaskContext& context)
+{
+  save_npy_template<VariantKind::CPU>(context);
+}
+
+namespace  // unnamed
+{
+static void __attribute__((constructor)) register_tasks(void) { SaveNpyTask::register_variants(); }
+}  // namespace
+
+}  // namespace cunumeric
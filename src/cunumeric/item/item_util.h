@@ -0,0 +1,35 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#pragma once
+
+#include "cunumeric/cunumeric.h"
+
+namespace cunumeric {
+
+// Single elements copied by one READ or WRITE launch, which must match
+// _MAX_BATCHED_ELEMENTS in fusion.py
+constexpr size_t MAX_BATCHED_ELEMENTS = 64;
+
+// Pointers to the elements of a batch, passed by value to the kernel that copies them
+template <typename VAL>
+struct ElementBatch {
+  VAL* dst[MAX_BATCHED_ELEMENTS];
+  const VAL* src[MAX_BATCHED_ELEMENTS];
+};
+
+}  // namespace cunumeric
@@ -24,7 +24,11 @@ using namespace legate;
 
 template <typename VAL>
 struct ReadImplBody<VariantKind::CPU, VAL> {
-  void operator()(AccessorWO<VAL, 1> out, AccessorRO<VAL, 1> in) const { out[0] = in[0]; }
+  void operator()(const std::vector<AccessorWO<VAL, 1>>& out,
+                  const std::vector<AccessorRO<VAL, 1>>& in) const
+  {
+    for (size_t idx = 0; idx < in.size(); ++idx) out[idx][0] = in[idx][0];
+  }
 };
 
 /*static*/ void ReadTask::cpu_variant(TaskContext& context)
@@ -16,26 +16,34 @@
 
 #include "cunumeric/item/read.h"
 #include "cunumeric/item/read_template.inl"
+#include "cunumeric/cuda_help.h"
 
 namespace cunumeric {
 
 using namespace Legion;
 
 template <typename VAL>
-static __global__ void __launch_bounds__(1, 1)
-  read_value(const AccessorWO<VAL, 1> out, const AccessorRO<VAL, 1> in)
+static __global__ void __launch_bounds__(MAX_BATCHED_ELEMENTS, 1)
+  read_values(const ElementBatch<VAL> batch, const size_t count)
 {
-  out[0] = in[0];
+  const size_t idx = threadIdx.x;
+  if (idx < count) *batch.dst[idx] = *batch.src[idx];
 }
 
 template <typename VAL>
 struct ReadImplBody<VariantKind::GPU, VAL> {
-  void operator()(AccessorWO<VAL, 1> out, AccessorRO<VAL, 1> in) const
+  void operator()(const std::vector<AccessorWO<VAL, 1>>& out,
+                  const std::vector<AccessorRO<VAL, 1>>& in) const
   {
-    cudaStream_t stream;
-    cudaStreamCreate(&stream);
-
-    read_value<VAL><<<1, 1, 0, stream>>>(out, in);
+    auto stream = get_cached_stream();
+
+    ElementBatch<VAL> batch;
+    const size_t count = in.size();
+    for (size_t idx = 0; idx < count; ++idx) {
+      batch.dst[idx] = out[idx].ptr(0);
+      batch.src[idx] = in[idx].ptr(0);
+    }
+    read_values<VAL><<<1, count, 0, stream>>>(batch, count);
   }
 };
 
@@ -16,10 +16,12 @@
 
 #pragma once
 
-#include "cunumeric/cunumeric.h"
+#include "cunumeric/item/item_util.h"
 
 namespace cunumeric {
 
+// Copies the single element of every input into the output at the same position, so a
+// batch of up to MAX_BATCHED_ELEMENTS scalar reads takes one launch
 class ReadTask : public CuNumericTask<ReadTask> {
  public:
   static const int TASK_ID = CUNUMERIC_READ;
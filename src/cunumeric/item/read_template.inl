@@ -25,11 +25,16 @@ struct ReadImplBody;
 template <VariantKind KIND>
 struct ReadImpl {
   template <LegateTypeCode CODE>
-  void operator()(const Array& out_arr, const Array& in_arr) const
+  void operator()(std::vector<Array>& outputs, std::vector<Array>& inputs) const
   {
     using VAL = legate_type_of<CODE>;
-    auto out  = out_arr.write_accessor<VAL, 1>();
-    auto in   = in_arr.read_accessor<VAL, 1>();
+
+    std::vector<AccessorWO<VAL, 1>> out;
+    std::vector<AccessorRO<VAL, 1>> in;
+    for (size_t idx = 0; idx < inputs.size(); ++idx) {
+      out.push_back(outputs[idx].write_accessor<VAL, 1>());
+      in.push_back(inputs[idx].read_accessor<VAL, 1>());
+    }
     ReadImplBody<KIND, VAL>()(out, in);
   }
 };
@@ -37,9 +42,10 @@ struct ReadImpl {
 template <VariantKind KIND>
 static void read_template(TaskContext& context)
 {
-  auto& out = context.outputs()[0];
-  auto& in  = context.inputs()[0];
-  type_dispatch(in.code(), ReadImpl<KIND>{}, out, in);
+  auto& outputs = context.outputs();
+  auto& inputs  = context.inputs();
+  assert(inputs.size() == outputs.size() && inputs.size() <= MAX_BATCHED_ELEMENTS);
+  cunumeric::type_dispatch(inputs[0].code(), ReadImpl<KIND>{}, outputs, inputs);
 }
 
 }  // namespace cunumeric
@@ -24,9 +24,10 @@ using namespace legate;
 
 template <typename VAL>
 struct WriteImplBody<VariantKind::CPU, VAL> {
-  void operator()(AccessorWO<VAL, 1> out, const AccessorRO<VAL, 1>& value) const
+  void operator()(const std::vector<AccessorWO<VAL, 1>>& out,
+                  const std::vector<AccessorRO<VAL, 1>>& value) const
   {
-    out[0] = value[0];
+    for (size_t idx = 0; idx < out.size(); ++idx) out[idx][0] = value[idx][0];
   }
 };
 
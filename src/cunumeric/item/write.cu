@@ -16,23 +16,34 @@
 
 #include "cunumeric/item/write.h"
 #include "cunumeric/item/write_template.inl"
+#include "cunumeric/cuda_help.h"
 
 namespace cunumeric {
 
 using namespace Legion;
 
 template <typename VAL>
-static __global__ void __launch_bounds__(1, 1)
-  write_value(const AccessorWO<VAL, 1> out, const AccessorRO<VAL, 1> value)
+static __global__ void __launch_bounds__(MAX_BATCHED_ELEMENTS, 1)
+  write_values(const ElementBatch<VAL> batch, const size_t count)
 {
-  out[0] = value[0];
+  const size_t idx = threadIdx.x;
+  if (idx < count) *batch.dst[idx] = *batch.src[idx];
 }
 
 template <typename VAL>
 struct WriteImplBody<VariantKind::GPU, VAL> {
-  void operator()(const AccessorWO<VAL, 1>& out, const AccessorRO<VAL, 1>& value) const
+  void operator()(const std::vector<AccessorWO<VAL, 1>>& out,
+                  const std::vector<AccessorRO<VAL, 1>>& value) const
   {
-    write_value<VAL><<<1, 1>>>(out, value);
+    auto stream = get_cached_stream();
+
+    ElementBatch<VAL> batch;
+    const size_t count = out.size();
+    for (size_t idx = 0; idx < count; ++idx) {
+      batch.dst[idx] = out[idx].ptr(0);
+      batch.src[idx] = value[idx].ptr(0);
+    }
+    write_values<VAL><<<1, count, 0, stream>>>(batch, count);
   }
 };
 
@@ -16,10 +16,12 @@
 
 #pragma once
 
-#include "cunumeric/cunumeric.h"
+#include "cunumeric/item/item_util.h"
 
 namespace cunumeric {
 
+// Writes the single value of every input into the element that the output at the same
+// position views, so a batch of up to MAX_BATCHED_ELEMENTS scalar writes takes one launch
 class WriteTask : public CuNumericTask<WriteTask> {
  public:
   static const int TASK_ID = CUNUMERIC_WRITE;
@@ -25,11 +25,16 @@ struct WriteImplBody;
 template <VariantKind KIND>
 struct WriteImpl {
   template <LegateTypeCode CODE>
-  void operator()(Array& out_arr, Array& in_arr) const
+  void operator()(std::vector<Array>& outputs, std::vector<Array>& inputs) const
   {
     using VAL = legate_type_of<CODE>;
-    auto out  = out_arr.write_accessor<VAL, 1>();
-    auto in   = in_arr.read_accessor<VAL, 1>();
+
+    std::vector<AccessorWO<VAL, 1>> out;
+    std::vector<AccessorRO<VAL, 1>> in;
+    for (size_t idx = 0; idx < outputs.size(); ++idx) {
+      out.push_back(outputs[idx].write_accessor<VAL, 1>());
+      in.push_back(inputs[idx].read_accessor<VAL, 1>());
+    }
     WriteImplBody<KIND, VAL>()(out, in);
   }
 };
@@ -37,9 +42,10 @@ struct WriteImpl {
 template <VariantKind KIND>
 static void write_template(TaskContext& context)
 {
-  auto& in  = context.inputs()[0];
-  auto& out = context.outputs()[0];
-  type_dispatch(out.code(), WriteImpl<KIND>{}, out, in);
+  auto& inputs  = context.inputs();
+  auto& outputs = context.outputs();
+  assert(inputs.size() == outputs.size() && outputs.size() <= MAX_BATCHED_ELEMENTS);
+  cunumeric::type_dispatch(outputs[0].code(), WriteImpl<KIND>{}, outputs, inputs);
 }
 
 }  // namespace cunumeric
@@ -0,0 +1,222 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric.h"
+#include "cuda_help.h"
+
+#include <sys/stat.h>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+
+namespace cunumeric {
+
+using namespace Legion;
+
+namespace {
+
+constexpr size_t CTAS_PER_SM_CANDIDATES[]        = {2, 4, 8, 16, 32};
+constexpr size_t MAX_REDUCTION_CTAS_CANDIDATES[] = {256, 512, 1024, 2048, 4096};
+
+// The number of elements the tuning kernels run over, large enough to reach steady state
+constexpr size_t TUNING_VOLUME = 1 << 23;
+constexpr int32_t TUNING_REPS  = 10;
+
+// A grid-stride axpy standing in for the element-wise kernels
+__global__ static void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  axpy_kernel(size_t volume, float alpha, const float* x, float* y)
+{
+  for (size_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < volume;
+       idx += gridDim.x * blockDim.x)
+    y[idx] += alpha * x[idx];
+}
+
+// A grid-stride sum standing in for the reductions, with one atomic per CTA
+__global__ static void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  sum_kernel(size_t volume, const float* x, float* out)
+{
+  float value = 0.f;
+  for (size_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < volume;
+       idx += gridDim.x * blockDim.x)
+    value += x[idx];
+  value = block_reduce<Legion::SumReduction<float>>(value);
+  if (threadIdx.x == 0) atomicAdd(out, value);
+}
+
+// Return the seconds one launch of the given closure takes on the stream
+template <typename Launch>
+float time_launches(cudaStream_t stream, Launch&& launch)
+{
+  cudaEvent_t start, stop;
+  CHECK_CUDA(cudaEventCreate(&start));
+  CHECK_CUDA(cudaEventCreate(&stop));
+  launch();
+  CHECK_CUDA(cudaEventRecord(start, stream));
+  for (int32_t rep = 0; rep < TUNING_REPS; ++rep) launch();
+  CHECK_CUDA(cudaEventRecord(stop, stream));
+  CHECK_CUDA(cudaEventSynchronize(stop));
+  float ms = 0.f;
+  CHECK_CUDA(cudaEventElapsedTime(&ms, start, stop));
+  CHECK_CUDA(cudaEventDestroy(start));
+  CHECK_CUDA(cudaEventDestroy(stop));
+  return ms / TUNING_REPS;
+}
+
+LaunchConfig measure_launch_config(int num_sms)
+{
+  LaunchConfig config{GRID_STRIDE_CTAS_PER_SM, MAX_REDUCTION_CTAS};
+  float* buffer = nullptr;
+  // Tuning is best effort, so a device without the room keeps the defaults
+  if (cudaMalloc(&buffer, (2 * TUNING_VOLUME + 1) * sizeof(float)) != cudaSuccess) {
+    cudaGetLastError();
+    return config;
+  }
+  float* x      = buffer;
+  float* y      = buffer + TUNING_VOLUME;
+  float* out    = buffer + 2 * TUNING_VOLUME;
+  auto stream   = get_cached_stream();
+  auto blocks   = (TUNING_VOLUME + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+  CHECK_CUDA(cudaMemsetAsync(buffer, 0, (2 * TUNING_VOLUME + 1) * sizeof(float), stream));
+
+  float best = std::numeric_limits<float>::max();
+  for (auto ctas_per_sm : CTAS_PER_SM_CANDIDATES) {
+    const size_t num_ctas = std::min<size_t>(blocks, ctas_per_sm * num_sms);
+    float time            = time_launches(stream, [&]() {
+      axpy_kernel<<<num_ctas, THREADS_PER_BLOCK, 0, stream>>>(TUNING_VOLUME, 2.f, x, y);
+    });
+    if (time < best) {
+      best                           = time;
+      config.grid_stride_ctas_per_sm = ctas_per_sm;
+    }
+  }
+
+  best = std::numeric_limits<float>::max();
+  for (auto max_ctas : MAX_REDUCTION_CTAS_CANDIDATES) {
+    const size_t num_ctas = std::min<size_t>(blocks, max_ctas);
+    float time            = time_launches(stream, [&]() {
+      sum_kernel<<<num_ctas, THREADS_PER_BLOCK, 0, stream>>>(TUNING_VOLUME, x, out);
+    });
+    if (time < best) {
+      best                      = time;
+      config.max_reduction_ctas = max_ctas;
+    }
+  }
+
+  CHECK_CUDA(cudaStreamSynchronize(stream));
+  CHECK_CUDA(cudaFree(buffer));
+  return config;
+}
+
+std::string launch_config_path()
+{
+  const char* path = getenv("CUNUMERIC_LAUNCH_CONFIG_FILE");
+  if (path != nullptr) return path;
+  const char* home = getenv("HOME");
+  if (home == nullptr) return "";
+  return std::string(home) + "/.cache/cunumeric/launch_config.txt";
+}
+
+// Each line of the file is "<model>;<ctas per SM>;<max reduction CTAs>"
+std::map<std::string, LaunchConfig> load_launch_configs(const std::string& path)
+{
+  std::map<std::string, LaunchConfig> configs;
+  std::ifstream in(path);
+  std::string line;
+  while (std::getline(in, line)) {
+    auto last = line.rfind(';');
+    if (last == std::string::npos || last == 0) continue;
+    auto first = line.rfind(';', last - 1);
+    if (first == std::string::npos || first == 0) continue;
+    LaunchConfig config;
+    std::istringstream fields(line.substr(first + 1));
+    char separator;
+    if (!(fields >> config.grid_stride_ctas_per_sm >> separator >> config.max_reduction_ctas))
+      continue;
+    if (config.grid_stride_ctas_per_sm == 0 || config.max_reduction_ctas == 0) continue;
+    configs[line.substr(0, first)] = config;
+  }
+  return configs;
+}
+
+void store_launch_config(const std::string& path,
+                         const std::string& model,
+                         const LaunchConfig& config)
+{
+  // Make the default directory if it is missing, one level at a time
+  auto slash = path.rfind('/');
+  if (slash != std::string::npos && slash > 0) {
+    auto parent = path.rfind('/', slash - 1);
+    if (parent != std::string::npos && parent > 0) mkdir(path.substr(0, parent).c_str(), 0755);
+    mkdir(path.substr(0, slash).c_str(), 0755);
+  }
+  // The entry is appended, and a later entry for the same model wins when loading
+  std::ofstream out(path, std::ios::app);
+  if (!out) {
+    fprintf(stderr, "cuNumeric: cannot write the launch configuration to %s\n", path.c_str());
+    return;
+  }
+  out << model << ";" << config.grid_stride_ctas_per_sm << ";" << config.max_reduction_ctas
+      << "\n";
+}
+
+}  // namespace
+
+const LaunchConfig& get_launch_config()
+{
+  static std::mutex lock;
+  // The configurations by model as read from the file, and the one of each device
+  static std::map<std::string, LaunchConfig> configs;
+  static std::map<int, LaunchConfig> devices;
+  static bool loaded = false;
+  static const bool tune = []() {
+    const char* value = getenv("CUNUMERIC_TUNE_LAUNCH");
+    return value != nullptr && atoi(value) > 0;
+  }();
+
+  int device;
+  CHECK_CUDA(cudaGetDevice(&device));
+  std::lock_guard<std::mutex> guard(lock);
+  auto finder = devices.find(device);
+  if (finder != devices.end()) return finder->second;
+
+  cudaDeviceProp props;
+  CHECK_CUDA(cudaGetDeviceProperties(&props, device));
+  const std::string model =
+    std::string(props.name) + " sm_" + std::to_string(props.major) + std::to_string(props.minor);
+  const std::string path = launch_config_path();
+  if (!loaded) {
+    if (!path.empty()) configs = load_launch_configs(path);
+    loaded = true;
+  }
+
+  auto model_finder = configs.find(model);
+  if (model_finder == configs.end()) {
+    LaunchConfig config{GRID_STRIDE_CTAS_PER_SM, MAX_REDUCTION_CTAS};
+    if (tune) {
+      config = measure_launch_config(props.multiProcessorCount);
+      if (!path.empty()) store_launch_config(path, model, config);
+    }
+    model_finder = configs.emplace(model, config).first;
+  }
+  return devices.emplace(device, model_finder->second).first->second;
+}
+
+size_t get_max_reduction_ctas() { return get_launch_config().max_reduction_ctas; }
+
+}  // namespace cunumeric
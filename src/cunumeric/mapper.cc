@@ -16,6 +16,9 @@
 
 #include "cunumeric/mapper.h"
 
+#include <algorithm>
+#include <map>
+
 using namespace legate;
 using namespace legate::mapping;
 
@@ -26,13 +29,221 @@ CuNumericMapper::CuNumericMapper(Legion::Runtime* rt, Legion::Machine m, const L
     min_gpu_chunk(extract_env("CUNUMERIC_MIN_GPU_CHUNK", 1 << 20, 2)),
     min_cpu_chunk(extract_env("CUNUMERIC_MIN_CPU_CHUNK", 1 << 14, 2)),
     min_omp_chunk(extract_env("CUNUMERIC_MIN_OMP_CHUNK", 1 << 17, 2)),
-    eager_fraction(extract_env("CUNUMERIC_EAGER_FRACTION", 16, 1))
+    eager_fraction(extract_env("CUNUMERIC_EAGER_FRACTION", 16, 1)),
+    min_cholesky_tile_size(extract_env("CUNUMERIC_MIN_CHOLESKY_TILE_SIZE", 2048, 2)),
+    min_gpu_cholesky_size(extract_env("CUNUMERIC_MIN_GPU_CHOLESKY_SIZE", 16384, 2)),
+    min_cpu_cholesky_size(extract_env("CUNUMERIC_MIN_CPU_CHOLESKY_SIZE", 8192, 2)),
+    min_gpu_task_volume(extract_env("CUNUMERIC_MIN_GPU_TASK_VOLUME", 1 << 13, 1)),
+    min_omp_task_volume(extract_env("CUNUMERIC_MIN_OMP_TASK_VOLUME", 1 << 11, 1)),
+    coexecute(extract_env("CUNUMERIC_COEXECUTE", 0, 0)),
+    framebuffer_budget(0)
+{
+  // GPU tasks that would take more than this percentage of a framebuffer map their
+  // stores to zero-copy memory instead, which is slower than failing to map only when
+  // the task would have succeeded
+  const int32_t spill_percent = extract_env("CUNUMERIC_GPU_SPILL_PERCENT", 0, 0);
+  if (spill_percent > 0) {
+    Legion::Machine::MemoryQuery framebuffers(m);
+    framebuffers.local_address_space().only_kind(Legion::Memory::GPU_FB_MEM);
+    for (auto& framebuffer : framebuffers)
+      framebuffer_budget =
+        std::max(framebuffer_budget, framebuffer.capacity() / 100 * spill_percent);
+  }
+
+  std::vector<Legion::Machine::MemoryMemoryAffinity> affinities;
+  m.get_mem_mem_affinity(affinities, Legion::Memory::NO_MEMORY, Legion::Memory::NO_MEMORY);
+  for (auto& affinity : affinities)
+    if (affinity.m1.kind() == Legion::Memory::GPU_FB_MEM &&
+        affinity.m2.kind() == Legion::Memory::GPU_FB_MEM)
+      peer_bandwidth[std::make_pair(affinity.m1, affinity.m2)] = affinity.bandwidth;
+}
+
+namespace  // unnamed
+{
+
+// Tasks that do a constant amount of work per element they touch. Below a few thousand
+// elements such tasks finish on a CPU before a GPU would have launched them, and they
+// are cheap enough that moving their data between memories doesn't outweigh that.
+bool is_light_task(int64_t task_id)
+{
+  switch (task_id) {
+    case CUNUMERIC_ARANGE:
+    case CUNUMERIC_BINARY_OP:
+    case CUNUMERIC_BINARY_RED:
+    case CUNUMERIC_CHOOSE:
+    case CUNUMERIC_CONVERT:
+    case CUNUMERIC_DIAG:
+    case CUNUMERIC_EYE:
+    case CUNUMERIC_FILL:
+    case CUNUMERIC_FLIP:
+    case CUNUMERIC_FUSED_OP:
+    case CUNUMERIC_PAD:
+    case CUNUMERIC_READ:
+    case CUNUMERIC_REPEAT:
+    case CUNUMERIC_RESHAPE:
+    case CUNUMERIC_SCALAR_UNARY_RED:
+    case CUNUMERIC_TILE:
+    case CUNUMERIC_TRILU:
+    case CUNUMERIC_UNARY_OP:
+    case CUNUMERIC_UNARY_RED:
+    case CUNUMERIC_WHERE: return true;
+    default: break;
+  }
+  return false;
+}
+
+// Element-wise tasks whose points can run on GPUs and OpenMP processors side by side, as
+// every point only touches its own tile and all of them have an OpenMP variant
+bool can_coexecute(int64_t task_id)
+{
+  switch (task_id) {
+    case CUNUMERIC_BINARY_OP:
+    case CUNUMERIC_CONVERT:
+    case CUNUMERIC_FILL:
+    case CUNUMERIC_FUSED_OP:
+    case CUNUMERIC_SCALAR_UNARY_RED:
+    case CUNUMERIC_UNARY_OP:
+    case CUNUMERIC_WHERE: return true;
+    default: break;
+  }
+  return false;
+}
+
+// The number of elements in the biggest store of the task, where futures count as a
+// single element, or -1 when an unbound output leaves it unknown
+int64_t max_store_volume(const Task& task)
+{
+  int64_t volume = 1;
+  for (auto* stores : {&task.inputs(), &task.outputs(), &task.reductions()})
+    for (auto& store : *stores) {
+      if (store.unbound()) return -1;
+      if (store.is_future()) continue;
+      volume = std::max<int64_t>(volume, store.domain().get_volume());
+    }
+  return volume;
+}
+
+// Tasks on the critical path of a tiled factorization jump ahead of the trailing updates
+// that are ready on the same processor, which then fill the gaps between them. POTRF and
+// GETRF always are on it, while TRSM, SYRK and GEMM are also used for trailing updates
+// and so get a hint in their last scalar from the launch.
+constexpr Legion::TaskPriority CRITICAL_PATH_PRIORITY = 1;
+
+Legion::TaskPriority task_priority(const Task& task)
+{
+  switch (task.task_id()) {
+    case CUNUMERIC_GETRF:
+    case CUNUMERIC_POTRF: {
+      return CRITICAL_PATH_PRIORITY;
+    }
+    case CUNUMERIC_GEMM:
+    case CUNUMERIC_SYRK:
+    case CUNUMERIC_TRSM: {
+      auto critical = task.scalars().back().value<bool>();
+      return critical ? CRITICAL_PATH_PRIORITY : 0;
+    }
+    default: break;
+  }
+  return 0;
+}
+
+}  // namespace
+
+void CuNumericMapper::map_task(const Legion::Mapping::MapperContext ctx,
+                               const Legion::Task& task,
+                               const MapTaskInput& input,
+                               MapTaskOutput& output)
 {
+  BaseMapper::map_task(ctx, task, input, output);
+  Task legate_task(&task, context, runtime, ctx);
+  output.task_priority = task_priority(legate_task);
+  // The copies into the instances of a task on the critical path are queued ahead of
+  // the ones that feed trailing updates, so the tiles of the next panel arrive while the
+  // processors are still busy with the updates of the current one
+  output.copy_fill_priority = output.task_priority;
+
+  if (memory_report_enabled()) {
+    std::map<Legion::Memory::Kind, size_t> bytes;
+    for (auto& instances : output.chosen_instances)
+      for (auto& instance : instances)
+        bytes[instance.get_location().kind()] += instance.get_instance_size();
+    record_instances(task.task_id, bytes);
+  }
+}
+
+void CuNumericMapper::slice_task(const Legion::Mapping::MapperContext ctx,
+                                 const Legion::Task& task,
+                                 const SliceTaskInput& input,
+                                 SliceTaskOutput& output)
+{
+  const size_t num_points = input.domain.get_volume();
+  const bool on_gpus      = task.target_proc.kind() == Legion::Processor::TOC_PROC;
+  if (!coexecute || !on_gpus || local_omps.empty() || !can_coexecute(task.task_id) ||
+      num_points <= local_gpus.size()) {
+    BaseMapper::slice_task(ctx, task, input, output);
+    return;
+  }
+
+  // The points of the launch are handed out in runs to the GPUs and then the OpenMP
+  // processors of the node, each getting a share of them that grows with its chunk size.
+  // The chunk sizes stand for the throughput of a processor on memory bound tasks, so
+  // the sockets stream their part of the tiles from host memory while the GPUs do the rest.
+  std::vector<std::pair<Legion::Processor, int64_t>> shares;
+  for (auto& gpu : local_gpus) shares.emplace_back(gpu, min_gpu_chunk);
+  for (auto& omp : local_omps) shares.emplace_back(omp, min_omp_chunk);
+  int64_t total = 0;
+  for (auto& share : shares) total += share.second;
+
+  // A point goes to the processor whose share covers its middle
+  size_t proc  = 0;
+  int64_t last = shares[proc].second;
+  int64_t idx  = 0;
+  for (Legion::Domain::DomainPointIterator itr(input.domain); itr; itr++, idx++) {
+    while ((2 * idx + 1) * total > 2 * last * static_cast<int64_t>(num_points))
+      last += shares[++proc].second;
+    Legion::Domain point(itr.p, itr.p);
+    output.slices.push_back(TaskSlice(point, shares[proc].first, false, false));
+  }
+}
+
+void CuNumericMapper::select_task_sources(const Legion::Mapping::MapperContext ctx,
+                                          const Legion::Task& task,
+                                          const SelectTaskSrcInput& input,
+                                          SelectTaskSrcOutput& output)
+{
+  BaseMapper::select_task_sources(ctx, task, input, output);
+  const auto target = input.target.get_location();
+  if (target.kind() != Legion::Memory::GPU_FB_MEM || peer_bandwidth.empty()) return;
+
+  // A store that every point of a launch reads whole, like a bias vector or the centroids
+  // of k-means, is copied to the GPUs of a node one after the other. Once the first copy
+  // is issued, the others read that framebuffer over NVLink instead of the same data
+  // coming again from host memory or another node. The replicas stay valid until the
+  // store is written, so later iterations find them in place.
+  auto bandwidth = [&](const Legion::Mapping::PhysicalInstance& source) -> uint32_t {
+    auto finder = peer_bandwidth.find(std::make_pair(source.get_location(), target));
+    return finder != peer_bandwidth.end() ? finder->second : 0;
+  };
+  auto& ranking = output.chosen_ranking;
+  std::stable_sort(ranking.begin(), ranking.end(), [&](const auto& lhs, const auto& rhs) {
+    return bandwidth(lhs) > bandwidth(rhs);
+  });
 }
 
 TaskTarget CuNumericMapper::task_target(const Task& task, const std::vector<TaskTarget>& options)
 {
-  return *options.begin();
+  // The options come in the order of preference, so anything but a small light task
+  // gets the fastest processor there is
+  if (options.size() == 1 || !is_light_task(task.task_id())) return options.front();
+  const int64_t volume = max_store_volume(task);
+  if (volume < 0 || volume >= min_gpu_task_volume) return options.front();
+
+  auto has_option = [&](TaskTarget target) {
+    return std::find(options.begin(), options.end(), target) != options.end();
+  };
+  if (volume >= min_omp_task_volume && has_option(TaskTarget::OMP)) return TaskTarget::OMP;
+  if (has_option(TaskTarget::CPU)) return TaskTarget::CPU;
+  return options.front();
 }
 
 Scalar CuNumericMapper::tunable_value(TunableID tunable_id)
@@ -54,7 +265,8 @@ Scalar CuNumericMapper::tunable_value(TunableID tunable_id)
     }
     case CUNUMERIC_TUNABLE_MAX_EAGER_VOLUME: {
       int32_t eager_volume = 0;
-      // TODO: make these profile guided
+      // The Python runtime replaces this with the volume it measured once the
+      // machine is calibrated (see cunumeric/calibration.py)
       if (eager_fraction > 0) {
         if (!local_gpus.empty())
           eager_volume = min_gpu_chunk / eager_fraction;
@@ -65,23 +277,178 @@ Scalar CuNumericMapper::tunable_value(TunableID tunable_id)
       }
       return Scalar(eager_volume);
     }
+    case CUNUMERIC_TUNABLE_MIN_CHOLESKY_TILE_SIZE: {
+      return Scalar(min_cholesky_tile_size);
+    }
+    case CUNUMERIC_TUNABLE_MIN_CHOLESKY_MATRIX_SIZE: {
+      // Matrices up to this extent are factored by a single POTRF task. A GPU keeps
+      // a much bigger matrix in its framebuffer than the tiled launches are worth.
+      if (!local_gpus.empty())
+        return Scalar(min_gpu_cholesky_size);
+      else
+        return Scalar(min_cpu_cholesky_size);
+    }
     default: break;
   }
   LEGATE_ABORT;  // unknown tunable value
 }
 
+namespace  // unnamed
+{
+
+// Maps the stores from begin to end to the target one by one. Futures are not
+// mapped to instances, so they are left alone.
+void add_default_mappings(std::vector<StoreMapping>& mappings,
+                          const std::vector<Store>& stores,
+                          StoreTarget target,
+                          size_t begin = 0,
+                          size_t end   = SIZE_MAX)
+{
+  for (size_t idx = begin; idx < std::min(end, stores.size()); ++idx)
+    if (!stores[idx].is_future())
+      mappings.push_back(StoreMapping::default_mapping(stores[idx], target));
+}
+
+std::vector<StoreMapping> default_mappings(const Task& task, StoreTarget target)
+{
+  std::vector<StoreMapping> mappings;
+  add_default_mappings(mappings, task.inputs(), target);
+  add_default_mappings(mappings, task.outputs(), target);
+  add_default_mappings(mappings, task.reductions(), target);
+  return mappings;
+}
+
+// The output of the task shares a single instance with the input it is updated through
+std::vector<StoreMapping> aliased_output_mappings(const Task& task,
+                                                  StoreTarget target,
+                                                  bool remap,
+                                                  size_t alias)
+{
+  std::vector<StoreMapping> mappings;
+  auto& inputs = task.inputs();
+  mappings.push_back(StoreMapping::default_mapping(task.outputs()[0], target));
+  mappings.back().stores.push_back(inputs[alias]);
+  if (remap) {
+    add_default_mappings(mappings, inputs, target, 0, alias);
+    add_default_mappings(mappings, inputs, target, alias + 1);
+  }
+  return mappings;
+}
+
+// A rough count of the bytes the instances of the task take, at eight bytes per element,
+// as the mapper doesn't see the types of the stores
+size_t estimated_footprint(const Task& task)
+{
+  size_t footprint = 0;
+  for (auto* stores : {&task.inputs(), &task.outputs(), &task.reductions()})
+    for (auto& store : *stores)
+      if (!store.is_future() && !store.unbound()) footprint += store.domain().get_volume() * 8;
+  return footprint;
+}
+
+StoreTarget store_target(const Task& task,
+                         const std::vector<StoreTarget>& options,
+                         size_t framebuffer_budget)
+{
+  // A GPU task that doesn't fit in the part of the framebuffer it may take reads and
+  // writes its stores in pinned host memory over the bus rather than failing to map
+  if (task.target() == TaskTarget::GPU && framebuffer_budget > 0 &&
+      estimated_footprint(task) > framebuffer_budget) {
+    auto finder = std::find(options.begin(), options.end(), StoreTarget::ZCMEM);
+    if (finder != options.end()) return *finder;
+  }
+  // An OpenMP processor drives the cores of one socket, so the instances of its tasks
+  // go to the memory of that socket when there is one. Anywhere else, half of the
+  // threads of a memory bound kernel would read through the other socket.
+  if (task.target() == TaskTarget::OMP) {
+    auto finder = std::find(options.begin(), options.end(), StoreTarget::SOCKETMEM);
+    if (finder != options.end()) return *finder;
+  }
+  return options.front();
+}
+
+}  // namespace
+
 std::vector<StoreMapping> CuNumericMapper::store_mappings(
   const mapping::Task& task, const std::vector<mapping::StoreTarget>& options)
 {
+  const auto target = store_target(task, options, framebuffer_budget);
+  // Set when the stores of the task must not end up in the memory Legate would pick
+  const bool remap = target != options.front();
+
   switch (task.task_id()) {
+    case CUNUMERIC_BINARY_OP: {
+      // In-place binary ops read and write the same store, which must
+      // be mapped to a single instance. Masked ones read the output
+      // through the input after the operands and the mask.
+      auto inplace = task.scalars()[1].value<bool>();
+      auto masked  = task.scalars()[3].value<bool>();
+      if (inplace)
+        return aliased_output_mappings(task, target, remap, 0);
+      else if (masked) {
+        size_t num_arrays = task.scalars()[2].value<int32_t>() != 0 ? 1 : 2;
+        return aliased_output_mappings(task, target, remap, num_arrays + 1);
+      } else
+        return remap ? default_mappings(task, target) : std::vector<StoreMapping>{};
+    }
+    case CUNUMERIC_UNARY_OP: {
+      // Masked unary ops read the output through the input after the mask,
+      // or through the operand when they are in place
+      auto masked  = task.scalars()[1].value<bool>();
+      auto inplace = task.scalars()[2].value<bool>();
+      if (masked)
+        return aliased_output_mappings(task, target, remap, inplace ? 0 : 2);
+      else
+        return remap ? default_mappings(task, target) : std::vector<StoreMapping>{};
+    }
+    case CUNUMERIC_WHERE: {
+      // In-place updates get the output as their last input as well
+      auto inplace = task.scalars()[2].value<bool>();
+      if (inplace)
+        return aliased_output_mappings(task, target, remap, task.inputs().size() - 1);
+      else
+        return remap ? default_mappings(task, target) : std::vector<StoreMapping>{};
+    }
     case CUNUMERIC_CONVOLVE: {
+      // The tile of the input and the shifted tiles that make up its halo share one
+      // instance. Left non-exact, later tasks on the same tiles find that instance again
+      // whether they read the store or write it, so only the ghost parts of the halo are
+      // copied in once the tile is resident.
       std::vector<StoreMapping> mappings;
       auto& inputs = task.inputs();
-      mappings.push_back(StoreMapping::default_mapping(inputs[0], options.front()));
-      mappings.push_back(StoreMapping::default_mapping(inputs[1], options.front()));
+      mappings.push_back(StoreMapping::default_mapping(inputs[0], target));
+      mappings.push_back(StoreMapping::default_mapping(inputs[1], target));
       auto& input_mapping = mappings.back();
       for (uint32_t idx = 2; idx < inputs.size(); ++idx)
         input_mapping.stores.push_back(inputs[idx]);
+      if (remap) add_default_mappings(mappings, task.outputs(), target);
+      return std::move(mappings);
+    }
+    case CUNUMERIC_ROLLING:
+    case CUNUMERIC_STENCIL: {
+      // Same as for convolutions, the input tile comes first here. Iterations that
+      // alternate between two arrays keep finding the instances of both, so only the
+      // ghost parts of the halos move between them.
+      std::vector<StoreMapping> mappings;
+      auto& inputs = task.inputs();
+      mappings.push_back(StoreMapping::default_mapping(inputs[0], target));
+      auto& input_mapping = mappings.back();
+      for (uint32_t idx = 1; idx < inputs.size(); ++idx)
+        input_mapping.stores.push_back(inputs[idx]);
+      if (remap) add_default_mappings(mappings, task.outputs(), target);
+      return std::move(mappings);
+    }
+    case CUNUMERIC_MATMUL:
+    case CUNUMERIC_MATVECMUL: {
+      // The partial sums of a product are folded through reduction instances that cover
+      // exactly the tile of the output, so the partials of the same shape that come back
+      // at every iteration of a solver ask for the same instance each time
+      std::vector<StoreMapping> mappings;
+      for (auto& reduction : task.reductions()) {
+        mappings.push_back(StoreMapping::default_mapping(reduction, target));
+        mappings.back().policy.exact = true;
+      }
+      if (remap) add_default_mappings(mappings, task.inputs(), target);
       return std::move(mappings);
     }
     case CUNUMERIC_TRANSPOSE_COPY_2D: {
@@ -89,34 +456,73 @@ std::vector<StoreMapping> CuNumericMapper::store_mappings(
       if (!logical) {
         std::vector<StoreMapping> mappings;
         auto& outputs = task.outputs();
-        mappings.push_back(StoreMapping::default_mapping(outputs[0], options.front()));
+        mappings.push_back(StoreMapping::default_mapping(outputs[0], target));
         mappings.back().policy.ordering.fortran_order();
         mappings.back().policy.exact = true;
+        if (remap) add_default_mappings(mappings, task.inputs(), target);
         return std::move(mappings);
       } else
-        return {};
+        return remap ? default_mappings(task, target) : std::vector<StoreMapping>{};
+    }
+    case CUNUMERIC_POTRF: {
+      // A POTRF on a whole matrix works on the row major copy of its input
+      auto row_major = task.scalars()[0].value<bool>();
+      std::vector<StoreMapping> mappings;
+      auto& outputs = task.outputs();
+      mappings.push_back(StoreMapping::default_mapping(outputs[0], target));
+      if (row_major)
+        mappings.back().policy.ordering.c_order();
+      else
+        mappings.back().policy.ordering.fortran_order();
+      mappings.back().policy.exact = true;
+      mappings.back().stores.push_back(task.inputs()[0]);
+      return std::move(mappings);
     }
-    case CUNUMERIC_POTRF:
     case CUNUMERIC_TRSM:
     case CUNUMERIC_SYRK:
     case CUNUMERIC_GEMM: {
+      // These tasks take tiles in either order and flip their transpose flags to match,
+      // so the tiles are mapped in the order the task was launched with (its second to
+      // last scalar) and only get re-laid out if they are held in the other one
+      auto& scalars  = task.scalars();
+      auto row_major = scalars[scalars.size() - 2].value<bool>();
+      std::vector<StoreMapping> mappings;
+      auto map_exact = [&](const std::vector<Store>& stores) {
+        for (auto& store : stores) {
+          mappings.push_back(StoreMapping::default_mapping(store, target));
+          if (row_major)
+            mappings.back().policy.ordering.c_order();
+          else
+            mappings.back().policy.ordering.fortran_order();
+          mappings.back().policy.exact = true;
+        }
+      };
+      map_exact(task.inputs());
+      map_exact(task.outputs());
+      return std::move(mappings);
+    }
+    case CUNUMERIC_GEQRF:
+    case CUNUMERIC_GESVD:
+    case CUNUMERIC_GETRF:
+    case CUNUMERIC_GETRS:
+    case CUNUMERIC_LASWP: {
       std::vector<StoreMapping> mappings;
       auto& inputs  = task.inputs();
       auto& outputs = task.outputs();
       for (auto& input : inputs) {
-        mappings.push_back(StoreMapping::default_mapping(input, options.front()));
+        mappings.push_back(StoreMapping::default_mapping(input, target));
         mappings.back().policy.ordering.fortran_order();
         mappings.back().policy.exact = true;
       }
       for (auto& output : outputs) {
-        mappings.push_back(StoreMapping::default_mapping(output, options.front()));
+        mappings.push_back(StoreMapping::default_mapping(output, target));
         mappings.back().policy.ordering.fortran_order();
         mappings.back().policy.exact = true;
       }
       return std::move(mappings);
     }
     default: {
-      return {};
+      return remap ? default_mappings(task, target) : std::vector<StoreMapping>{};
     }
   }
   assert(false);
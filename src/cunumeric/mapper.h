@@ -16,6 +16,9 @@
 
 #pragma once
 
+#include <map>
+#include <utility>
+
 #include "cunumeric/cunumeric.h"
 
 #include "core/mapping/base_mapper.h"
@@ -44,11 +47,36 @@ class CuNumericMapper : public legate::mapping::BaseMapper {
     const std::vector<legate::mapping::StoreTarget>& options) override;
   virtual legate::Scalar tunable_value(legate::TunableID tunable_id) override;
 
+  // Legion mapping functions
+ public:
+  virtual void map_task(const Legion::Mapping::MapperContext ctx,
+                        const Legion::Task& task,
+                        const MapTaskInput& input,
+                        MapTaskOutput& output) override;
+  virtual void slice_task(const Legion::Mapping::MapperContext ctx,
+                          const Legion::Task& task,
+                          const SliceTaskInput& input,
+                          SliceTaskOutput& output) override;
+  virtual void select_task_sources(const Legion::Mapping::MapperContext ctx,
+                                   const Legion::Task& task,
+                                   const SelectTaskSrcInput& input,
+                                   SelectTaskSrcOutput& output) override;
+
  private:
   const int32_t min_gpu_chunk;
   const int32_t min_cpu_chunk;
   const int32_t min_omp_chunk;
   const int32_t eager_fraction;
+  const int32_t min_cholesky_tile_size;
+  const int32_t min_gpu_cholesky_size;
+  const int32_t min_cpu_cholesky_size;
+  const int32_t min_gpu_task_volume;
+  const int32_t min_omp_task_volume;
+  const int32_t coexecute;
+  // The bytes of framebuffer a single GPU task may map, or 0 for as much as it needs
+  size_t framebuffer_budget;
+  // The bandwidth between the framebuffers of this node that can copy to each other
+  std::map<std::pair<Legion::Memory, Legion::Memory>, uint32_t> peer_bandwidth;
 };
 
 }  // namespace cunumeric
@@ -0,0 +1,154 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/matrix/batched_matmul.h"
+#include "cunumeric/matrix/batched_matmul_template.inl"
+#include "cunumeric/matrix/util.h"
+
+#include <cblas.h>
+#ifdef LEGATE_USE_OPENMP
+#include <omp.h>
+#endif
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <typename VAL>
+static void batched_gemm(size_t batches,
+                         size_t m,
+                         size_t n,
+                         size_t k,
+                         VAL* lhs,
+                         const VAL* rhs1,
+                         const VAL* rhs2,
+                         size_t lhs_batch_stride,
+                         size_t rhs1_batch_stride,
+                         size_t rhs2_batch_stride,
+                         size_t lhs_stride,
+                         size_t rhs1_stride,
+                         size_t rhs2_stride,
+                         bool rhs1_transposed,
+                         bool rhs2_transposed,
+                         const MatMulEpilogue<VAL>& epilogue)
+{
+  for (size_t batch = 0; batch < batches; ++batch) {
+    auto out = lhs + batch * lhs_batch_stride;
+    gemm(m,
+         n,
+         k,
+         out,
+         rhs1 + batch * rhs1_batch_stride,
+         rhs2 + batch * rhs2_batch_stride,
+         lhs_stride,
+         rhs1_stride,
+         rhs2_stride,
+         rhs1_transposed,
+         rhs2_transposed);
+    // The product is still in cache at this point
+    apply_epilogue(out, m, n, lhs_stride, epilogue);
+  }
+}
+
+template <>
+struct BatchedMatMulImplBody<VariantKind::CPU, LegateTypeCode::FLOAT_LT> {
+  template <typename... Args>
+  void operator()(Args&&... args)
+  {
+    batched_gemm<float>(std::forward<Args>(args)...);
+  }
+};
+
+template <>
+struct BatchedMatMulImplBody<VariantKind::CPU, LegateTypeCode::DOUBLE_LT> {
+  template <typename... Args>
+  void operator()(Args&&... args)
+  {
+    batched_gemm<double>(std::forward<Args>(args)...);
+  }
+};
+
+template <>
+struct BatchedMatMulImplBody<VariantKind::CPU, LegateTypeCode::HALF_LT> {
+  void operator()(size_t batches,
+                  size_t m,
+                  size_t n,
+                  size_t k,
+                  float* lhs,
+                  const __half* rhs1,
+                  const __half* rhs2,
+                  size_t lhs_batch_stride,
+                  size_t rhs1_batch_stride,
+                  size_t rhs2_batch_stride,
+                  size_t lhs_stride,
+                  size_t rhs1_stride,
+                  size_t rhs2_stride,
+                  bool rhs1_transposed,
+                  bool rhs2_transposed,
+                  const MatMulEpilogue<float>& epilogue)
+  {
+    auto rhs1_copy = allocate_buffer(m * k);
+    auto rhs2_copy = allocate_buffer(k * n);
+
+    for (size_t batch = 0; batch < batches; ++batch) {
+      auto rhs1_batch = rhs1 + batch * rhs1_batch_stride;
+      auto rhs2_batch = rhs2 + batch * rhs2_batch_stride;
+
+      if (rhs1_transposed)
+        half_matrix_to_float(rhs1_copy, rhs1_batch, k, m, rhs1_stride);
+      else
+        half_matrix_to_float(rhs1_copy, rhs1_batch, m, k, rhs1_stride);
+
+      if (rhs2_transposed)
+        half_matrix_to_float(rhs2_copy, rhs2_batch, n, k, rhs2_stride);
+      else
+        half_matrix_to_float(rhs2_copy, rhs2_batch, k, n, rhs2_stride);
+
+      auto out = lhs + batch * lhs_batch_stride;
+      gemm(m,
+           n,
+           k,
+           out,
+           rhs1_copy,
+           rhs2_copy,
+           lhs_stride,
+           rhs1_transposed ? m : k,
+           rhs2_transposed ? k : n,
+           rhs1_transposed,
+           rhs2_transposed);
+      apply_epilogue(out, m, n, lhs_stride, epilogue);
+    }
+  }
+};
+
+/*static*/ void BatchedMatMulTask::cpu_variant(TaskContext& context)
+{
+#ifdef LEGATE_USE_OPENMP
+  BlasThreads blas_threads(1);
+#endif
+  batched_matmul_template<VariantKind::CPU>(context);
+}
+
+namespace  // unnamed
+{
+static void __attribute__((constructor)) register_tasks(void)
+{
+  BatchedMatMulTask::register_variants();
+}
+}  // namespace
+
+}  // namespace cunumeric
@@ -0,0 +1,231 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/matrix/batched_matmul.h"
+#include "cunumeric/matrix/batched_matmul_template.inl"
+
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+
+template <typename OP, typename ACC>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  epilogue_kernel(
+    size_t volume, size_t m, size_t n, ACC* out, size_t batch_stride, size_t stride, OP op)
+{
+  const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx >= volume) return;
+  const size_t col   = idx % n;
+  const size_t row   = (idx / n) % m;
+  const size_t batch = idx / (m * n);
+  auto value         = out + batch * batch_stride + row * stride + col;
+  *value             = op(*value, col);
+}
+
+template <typename ACC>
+struct DeviceMatMulEpilogue {
+  template <UnaryOpCode OP_CODE,
+            std::enable_if_t<FusibleUnaryOp<OP_CODE, legate_type_code_of<ACC>>::value>* = nullptr>
+  void operator()(size_t batches,
+                  size_t m,
+                  size_t n,
+                  ACC* out,
+                  size_t batch_stride,
+                  size_t stride,
+                  const MatMulEpilogue<ACC>& epilogue,
+                  cudaStream_t stream) const
+  {
+    const size_t volume = batches * m * n;
+    const size_t blocks = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+    MatMulEpilogueOp<OP_CODE, ACC> op(epilogue);
+    epilogue_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+      volume, m, n, out, batch_stride, stride, op);
+  }
+
+  template <UnaryOpCode OP_CODE,
+            std::enable_if_t<!FusibleUnaryOp<OP_CODE, legate_type_code_of<ACC>>::value>* = nullptr>
+  void operator()(size_t batches,
+                  size_t m,
+                  size_t n,
+                  ACC* out,
+                  size_t batch_stride,
+                  size_t stride,
+                  const MatMulEpilogue<ACC>& epilogue,
+                  cudaStream_t stream) const
+  {
+    assert(false);
+  }
+};
+
+// cuBLAS has no epilogue for most of the activations, so the scale, the bias and the
+// activation are applied in a single element-wise pass over the products of a batch
+template <typename ACC>
+static void apply_device_epilogue(size_t batches,
+                                  size_t m,
+                                  size_t n,
+                                  ACC* out,
+                                  size_t batch_stride,
+                                  size_t stride,
+                                  const MatMulEpilogue<ACC>& epilogue,
+                                  cudaStream_t stream)
+{
+  if (!epilogue.enabled) return;
+  op_dispatch(epilogue.activation,
+              DeviceMatMulEpilogue<ACC>{},
+              batches,
+              m,
+              n,
+              out,
+              batch_stride,
+              stride,
+              epilogue,
+              stream);
+}
+
+// Runs the whole batch as a single strided-batched product. The operands are swapped for
+// the same reason as in the matmul task: cuBLAS sees our row-major matrices as their
+// column-major transposes, so computing NxM = NxK * KxM gives the row-major MxN result.
+template <typename VAL>
+static void batched_gemm_ex(size_t batches,
+                            size_t m,
+                            size_t n,
+                            size_t k,
+                            float* lhs,
+                            const VAL* rhs1,
+                            const VAL* rhs2,
+                            size_t lhs_batch_stride,
+                            size_t rhs1_batch_stride,
+                            size_t rhs2_batch_stride,
+                            size_t lhs_stride,
+                            size_t rhs1_stride,
+                            size_t rhs2_stride,
+                            bool rhs1_transposed,
+                            bool rhs2_transposed,
+                            const MatMulEpilogue<float>& epilogue,
+                            cudaDataType_t type)
+{
+  auto cublas_handle = get_cublas();
+  // Update the stream because the CUDA hijack can't see inside cuBLAS
+  auto task_stream = get_cached_stream();
+  CHECK_CUBLAS(cublasSetStream(cublas_handle, task_stream));
+
+  const float alpha = 1.f;
+  const float beta  = 0.f;
+
+  CHECK_CUBLAS(cublasGemmStridedBatchedEx(cublas_handle,
+                                          rhs2_transposed ? CUBLAS_OP_T : CUBLAS_OP_N,
+                                          rhs1_transposed ? CUBLAS_OP_T : CUBLAS_OP_N,
+                                          n,
+                                          m,
+                                          k,
+                                          &alpha,
+                                          rhs2,
+                                          type,
+                                          rhs2_stride,
+                                          rhs2_batch_stride,
+                                          rhs1,
+                                          type,
+                                          rhs1_stride,
+                                          rhs1_batch_stride,
+                                          &beta,
+                                          lhs,
+                                          CUDA_R_32F,
+                                          lhs_stride,
+                                          lhs_batch_stride,
+                                          batches,
+                                          CUBLAS_COMPUTE_32F,
+                                          CUBLAS_GEMM_DEFAULT));
+
+  apply_device_epilogue(batches, m, n, lhs, lhs_batch_stride, lhs_stride, epilogue, task_stream);
+}
+
+template <>
+struct BatchedMatMulImplBody<VariantKind::GPU, LegateTypeCode::FLOAT_LT> {
+  template <typename... Args>
+  void operator()(Args&&... args)
+  {
+    batched_gemm_ex<float>(std::forward<Args>(args)..., CUDA_R_32F);
+  }
+};
+
+template <>
+struct BatchedMatMulImplBody<VariantKind::GPU, LegateTypeCode::DOUBLE_LT> {
+  void operator()(size_t batches,
+                  size_t m,
+                  size_t n,
+                  size_t k,
+                  double* lhs,
+                  const double* rhs1,
+                  const double* rhs2,
+                  size_t lhs_batch_stride,
+                  size_t rhs1_batch_stride,
+                  size_t rhs2_batch_stride,
+                  size_t lhs_stride,
+                  size_t rhs1_stride,
+                  size_t rhs2_stride,
+                  bool rhs1_transposed,
+                  bool rhs2_transposed,
+                  const MatMulEpilogue<double>& epilogue)
+  {
+    auto cublas_handle = get_cublas();
+    // Update the stream because the CUDA hijack can't see inside cuBLAS
+    auto task_stream = get_cached_stream();
+    CHECK_CUBLAS(cublasSetStream(cublas_handle, task_stream));
+
+    const double alpha = 1.f;
+    const double beta  = 0.f;
+
+    CHECK_CUBLAS(cublasDgemmStridedBatched(cublas_handle,
+                                           rhs2_transposed ? CUBLAS_OP_T : CUBLAS_OP_N,
+                                           rhs1_transposed ? CUBLAS_OP_T : CUBLAS_OP_N,
+                                           n,
+                                           m,
+                                           k,
+                                           &alpha,
+                                           rhs2,
+                                           rhs2_stride,
+                                           rhs2_batch_stride,
+                                           rhs1,
+                                           rhs1_stride,
+                                           rhs1_batch_stride,
+                                           &beta,
+                                           lhs,
+                                           lhs_stride,
+                                           lhs_batch_stride,
+                                           batches));
+
+    apply_device_epilogue(batches, m, n, lhs, lhs_batch_stride, lhs_stride, epilogue, task_stream);
+  }
+};
+
+template <>
+struct BatchedMatMulImplBody<VariantKind::GPU, LegateTypeCode::HALF_LT> {
+  template <typename... Args>
+  void operator()(Args&&... args)
+  {
+    // Half precision inputs accumulate into a single precision output
+    batched_gemm_ex<__half>(std::forward<Args>(args)..., CUDA_R_16F);
+  }
+};
+
+/*static*/ void BatchedMatMulTask::gpu_variant(TaskContext& context)
+{
+  batched_matmul_template<VariantKind::GPU>(context);
+}
+
+}  // namespace cunumeric
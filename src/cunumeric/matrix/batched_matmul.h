@@ -0,0 +1,52 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "cunumeric/cunumeric.h"
+#include "cunumeric/unary/unary_op_util.h"
+
+namespace cunumeric {
+
+struct BatchedMatMulArgs {
+  const Array& lhs;
+  const Array& rhs1;
+  const Array& rhs2;
+  const Array* bias;
+  double scale;
+  UnaryOpCode activation;
+};
+
+// Multiplies stacks of matrices, lhs[..., m, n] = rhs1[..., m, k] @ rhs2[..., k, n], where a
+// single matrix is a stack of one. The stores are never partitioned along the last two
+// dimensions except for the rows of a single matrix, so every point task computes whole
+// products and writes them directly without a reduction. The products can optionally go
+// through a scale, a bias and an activation before they are stored.
+class BatchedMatMulTask : public CuNumericTask<BatchedMatMulTask> {
+ public:
+  static const int TASK_ID = CUNUMERIC_BATCHED_MATMUL;
+
+ public:
+  static void cpu_variant(legate::TaskContext& context);
+#ifdef LEGATE_USE_OPENMP
+  static void omp_variant(legate::TaskContext& context);
+#endif
+#ifdef LEGATE_USE_CUDA
+  static void gpu_variant(legate::TaskContext& context);
+#endif
+};
+
+}  // namespace cunumeric
@@ -0,0 +1,217 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/matrix/batched_matmul.h"
+#include "cunumeric/matrix/batched_matmul_template.inl"
+#include "cunumeric/matrix/util.h"
+#include "cunumeric/matrix/util_omp.h"
+
+#include <cblas.h>
+#include <omp.h>
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+// When there are at least as many matrices as threads, each thread runs whole products
+// with a single-threaded BLAS, which beats splitting every small product across all
+// threads. Otherwise the products run one after another and BLAS threads each of them.
+static inline bool batch_parallel(size_t batches)
+{
+  const size_t threads = omp_get_max_threads();
+  return threads >= 2 && batches >= threads;
+}
+
+static inline int32_t blas_threads_of(bool parallel)
+{
+  return parallel ? 1 : omp_get_max_threads();
+}
+
+// Same as apply_epilogue, with the rows of the matrix split across the threads
+template <typename ACC>
+struct OmpMatMulEpilogue {
+  template <UnaryOpCode OP_CODE,
+            std::enable_if_t<FusibleUnaryOp<OP_CODE, legate_type_code_of<ACC>>::value>* = nullptr>
+  void operator()(
+    ACC* out, size_t m, size_t n, size_t stride, const MatMulEpilogue<ACC>& epilogue) const
+  {
+    MatMulEpilogueOp<OP_CODE, ACC> op(epilogue);
+#pragma omp parallel for schedule(static)
+    for (size_t row = 0; row < m; ++row) {
+      auto values = out + row * stride;
+      for (size_t col = 0; col < n; ++col) values[col] = op(values[col], col);
+    }
+  }
+
+  template <UnaryOpCode OP_CODE,
+            std::enable_if_t<!FusibleUnaryOp<OP_CODE, legate_type_code_of<ACC>>::value>* = nullptr>
+  void operator()(
+    ACC* out, size_t m, size_t n, size_t stride, const MatMulEpilogue<ACC>& epilogue) const
+  {
+    assert(false);
+  }
+};
+
+template <typename ACC>
+static void apply_epilogue_omp(
+  ACC* out, size_t m, size_t n, size_t stride, const MatMulEpilogue<ACC>& epilogue)
+{
+  if (epilogue.enabled)
+    op_dispatch(epilogue.activation, OmpMatMulEpilogue<ACC>{}, out, m, n, stride, epilogue);
+}
+
+template <typename VAL>
+static void batched_gemm(size_t batches,
+                         size_t m,
+                         size_t n,
+                         size_t k,
+                         VAL* lhs,
+                         const VAL* rhs1,
+                         const VAL* rhs2,
+                         size_t lhs_batch_stride,
+                         size_t rhs1_batch_stride,
+                         size_t rhs2_batch_stride,
+                         size_t lhs_stride,
+                         size_t rhs1_stride,
+                         size_t rhs2_stride,
+                         bool rhs1_transposed,
+                         bool rhs2_transposed,
+                         const MatMulEpilogue<VAL>& epilogue)
+{
+  auto product = [&](size_t batch) {
+    gemm(m,
+         n,
+         k,
+         lhs + batch * lhs_batch_stride,
+         rhs1 + batch * rhs1_batch_stride,
+         rhs2 + batch * rhs2_batch_stride,
+         lhs_stride,
+         rhs1_stride,
+         rhs2_stride,
+         rhs1_transposed,
+         rhs2_transposed);
+  };
+
+  const bool parallel = batch_parallel(batches);
+  BlasThreads blas_threads(blas_threads_of(parallel));
+  if (parallel) {
+#pragma omp parallel for schedule(static)
+    for (size_t batch = 0; batch < batches; ++batch) {
+      product(batch);
+      apply_epilogue(lhs + batch * lhs_batch_stride, m, n, lhs_stride, epilogue);
+    }
+  } else
+    for (size_t batch = 0; batch < batches; ++batch) {
+      product(batch);
+      apply_epilogue_omp(lhs + batch * lhs_batch_stride, m, n, lhs_stride, epilogue);
+    }
+}
+
+template <>
+struct BatchedMatMulImplBody<VariantKind::OMP, LegateTypeCode::FLOAT_LT> {
+  template <typename... Args>
+  void operator()(Args&&... args)
+  {
+    batched_gemm<float>(std::forward<Args>(args)...);
+  }
+};
+
+template <>
+struct BatchedMatMulImplBody<VariantKind::OMP, LegateTypeCode::DOUBLE_LT> {
+  template <typename... Args>
+  void operator()(Args&&... args)
+  {
+    batched_gemm<double>(std::forward<Args>(args)...);
+  }
+};
+
+template <>
+struct BatchedMatMulImplBody<VariantKind::OMP, LegateTypeCode::HALF_LT> {
+  void operator()(size_t batches,
+                  size_t m,
+                  size_t n,
+                  size_t k,
+                  float* lhs,
+                  const __half* rhs1,
+                  const __half* rhs2,
+                  size_t lhs_batch_stride,
+                  size_t rhs1_batch_stride,
+                  size_t rhs2_batch_stride,
+                  size_t lhs_stride,
+                  size_t rhs1_stride,
+                  size_t rhs2_stride,
+                  bool rhs1_transposed,
+                  bool rhs2_transposed,
+                  const MatMulEpilogue<float>& epilogue)
+  {
+    const bool parallel = batch_parallel(batches);
+    const size_t copies = parallel ? omp_get_max_threads() : 1;
+    BlasThreads blas_threads(blas_threads_of(parallel));
+
+    // Each thread converts its operands into its own slice of the buffers
+    auto rhs1_copies = allocate_buffer(copies * m * k);
+    auto rhs2_copies = allocate_buffer(copies * k * n);
+
+    auto product = [&](size_t batch, size_t slice, auto convert) {
+      auto rhs1_copy  = rhs1_copies + slice * m * k;
+      auto rhs2_copy  = rhs2_copies + slice * k * n;
+      auto rhs1_batch = rhs1 + batch * rhs1_batch_stride;
+      auto rhs2_batch = rhs2 + batch * rhs2_batch_stride;
+
+      if (rhs1_transposed)
+        convert(rhs1_copy, rhs1_batch, k, m, rhs1_stride);
+      else
+        convert(rhs1_copy, rhs1_batch, m, k, rhs1_stride);
+
+      if (rhs2_transposed)
+        convert(rhs2_copy, rhs2_batch, n, k, rhs2_stride);
+      else
+        convert(rhs2_copy, rhs2_batch, k, n, rhs2_stride);
+
+      gemm(m,
+           n,
+           k,
+           lhs + batch * lhs_batch_stride,
+           rhs1_copy,
+           rhs2_copy,
+           lhs_stride,
+           rhs1_transposed ? m : k,
+           rhs2_transposed ? k : n,
+           rhs1_transposed,
+           rhs2_transposed);
+    };
+
+    if (parallel) {
+#pragma omp parallel for schedule(static)
+      for (size_t batch = 0; batch < batches; ++batch) {
+        product(batch, omp_get_thread_num(), half_matrix_to_float);
+        apply_epilogue(lhs + batch * lhs_batch_stride, m, n, lhs_stride, epilogue);
+      }
+    } else
+      for (size_t batch = 0; batch < batches; ++batch) {
+        product(batch, 0, half_matrix_to_float_omp);
+        apply_epilogue_omp(lhs + batch * lhs_batch_stride, m, n, lhs_stride, epilogue);
+      }
+  }
+};
+
+/*static*/ void BatchedMatMulTask::omp_variant(TaskContext& context)
+{
+  batched_matmul_template<VariantKind::OMP>(context);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,242 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/matrix/matmul.h"
+#include "cunumeric/fused/fused_op_util.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+// Applied to every product before it is stored: out = activation(scale * out + bias), with the
+// bias broadcast along the rows. The activation can be any unary op that could also be fused,
+// and is COPY when there is none.
+template <typename ACC>
+struct MatMulEpilogue {
+  bool enabled{false};
+  ACC scale{1};
+  const ACC* bias{nullptr};
+  size_t bias_stride{0};
+  UnaryOpCode activation{UnaryOpCode::COPY};
+};
+
+template <UnaryOpCode OP_CODE, typename ACC>
+struct MatMulEpilogueOp {
+  using OP = UnaryOp<OP_CODE, legate_type_code_of<ACC>>;
+
+  MatMulEpilogueOp(const MatMulEpilogue<ACC>& epilogue)
+    : scale(epilogue.scale),
+      bias(epilogue.bias),
+      bias_stride(epilogue.bias_stride),
+      op(std::vector<Store>())
+  {
+  }
+
+  __CUDA_HD__ ACC operator()(ACC value, size_t col) const
+  {
+    value = value * scale;
+    if (bias != nullptr) value = value + bias[col * bias_stride];
+    return op(value);
+  }
+
+  ACC scale;
+  const ACC* bias;
+  size_t bias_stride;
+  OP op;
+};
+
+// Applies the epilogue to an m x n matrix on the host, right after it was computed
+template <typename ACC>
+struct HostMatMulEpilogue {
+  template <UnaryOpCode OP_CODE,
+            std::enable_if_t<FusibleUnaryOp<OP_CODE, legate_type_code_of<ACC>>::value>* = nullptr>
+  void operator()(
+    ACC* out, size_t m, size_t n, size_t stride, const MatMulEpilogue<ACC>& epilogue) const
+  {
+    MatMulEpilogueOp<OP_CODE, ACC> op(epilogue);
+    for (size_t row = 0; row < m; ++row) {
+      auto values = out + row * stride;
+      for (size_t col = 0; col < n; ++col) values[col] = op(values[col], col);
+    }
+  }
+
+  template <UnaryOpCode OP_CODE,
+            std::enable_if_t<!FusibleUnaryOp<OP_CODE, legate_type_code_of<ACC>>::value>* = nullptr>
+  void operator()(
+    ACC* out, size_t m, size_t n, size_t stride, const MatMulEpilogue<ACC>& epilogue) const
+  {
+    assert(false);
+  }
+};
+
+template <typename ACC>
+void apply_epilogue(
+  ACC* out, size_t m, size_t n, size_t stride, const MatMulEpilogue<ACC>& epilogue)
+{
+  if (epilogue.enabled)
+    op_dispatch(epilogue.activation, HostMatMulEpilogue<ACC>{}, out, m, n, stride, epilogue);
+}
+
+template <VariantKind KIND, LegateTypeCode CODE>
+struct BatchedMatMulImplBody;
+
+// The epilogue is floating point, so 8-bit integer products only go through the matmul task
+template <LegateTypeCode CODE>
+constexpr bool support_batched_matmul = support_matmul<CODE>::value &&
+                                        CODE != LegateTypeCode::INT8_LT &&
+                                        CODE != LegateTypeCode::UINT8_LT;
+
+template <VariantKind KIND>
+struct BatchedMatMulImpl {
+  template <LegateTypeCode CODE,
+            int DIM,
+            std::enable_if_t<(DIM >= 2) && support_batched_matmul<CODE>>* = nullptr>
+  void operator()(BatchedMatMulArgs& args) const
+  {
+    using VAL = legate_type_of<CODE>;
+    using ACC = typename support_matmul<CODE>::ACC_TYPE;
+
+    auto lhs_shape  = args.lhs.shape<DIM>();
+    auto rhs1_shape = args.rhs1.shape<DIM>();
+    auto rhs2_shape = args.rhs2.shape<DIM>();
+
+    if (lhs_shape.empty()) return;
+
+    const auto m = lhs_shape.hi[DIM - 2] - lhs_shape.lo[DIM - 2] + 1;
+    const auto n = lhs_shape.hi[DIM - 1] - lhs_shape.lo[DIM - 1] + 1;
+    const auto k = rhs1_shape.hi[DIM - 1] - rhs1_shape.lo[DIM - 1] + 1;
+
+    size_t lhs_strides[DIM];
+    size_t rhs1_strides[DIM];
+    size_t rhs2_strides[DIM];
+
+    auto lhs  = args.lhs.write_accessor<ACC, DIM>(lhs_shape).ptr(lhs_shape, lhs_strides);
+    auto rhs1 = args.rhs1.read_accessor<VAL, DIM>(rhs1_shape).ptr(rhs1_shape, rhs1_strides);
+    auto rhs2 = args.rhs2.read_accessor<VAL, DIM>(rhs2_shape).ptr(rhs2_shape, rhs2_strides);
+
+    auto rhs1_stride     = std::max(rhs1_strides[DIM - 2], rhs1_strides[DIM - 1]);
+    auto rhs2_stride     = std::max(rhs2_strides[DIM - 2], rhs2_strides[DIM - 1]);
+    auto rhs1_transposed = (rhs1_strides[DIM - 2] != rhs1_strides[DIM - 1])
+                             ? (rhs1_strides[DIM - 1] == rhs1_stride)
+                             : (rhs1_stride != k);
+    auto rhs2_transposed = (rhs2_strides[DIM - 2] != rhs2_strides[DIM - 1])
+                             ? (rhs2_strides[DIM - 1] == rhs2_stride)
+                             : (rhs2_stride != n);
+
+    MatMulEpilogue<ACC> epilogue;
+    epilogue.scale      = args.scale;
+    epilogue.activation = args.activation;
+    if (args.bias != nullptr) {
+      // The bias is a vector of n elements that every point task sees whole
+      auto bias_shape = args.bias->shape<1>();
+      auto bias       = args.bias->read_accessor<ACC, 1>(bias_shape);
+      epilogue.bias   = bias.ptr(bias_shape, &epilogue.bias_stride);
+    }
+    epilogue.enabled = epilogue.scale != ACC{1} || epilogue.bias != nullptr ||
+                       epilogue.activation != UnaryOpCode::COPY;
+
+    // A single matrix is a batch of one
+    if constexpr (DIM == 2) {
+      BatchedMatMulImplBody<KIND, CODE>()(1,
+                                          m,
+                                          n,
+                                          k,
+                                          lhs,
+                                          rhs1,
+                                          rhs2,
+                                          0,
+                                          0,
+                                          0,
+                                          lhs_strides[0],
+                                          rhs1_stride,
+                                          rhs2_stride,
+                                          rhs1_transposed,
+                                          rhs2_transposed,
+                                          epilogue);
+      return;
+    }
+
+    // The innermost batch dimension goes to the body as a single strided batch and
+    // any batch dimensions outside of it are walked here
+    constexpr int BATCH_DIM = std::max(DIM - 3, 0);
+    const size_t batches    = lhs_shape.hi[BATCH_DIM] - lhs_shape.lo[BATCH_DIM] + 1;
+
+    size_t runs = 1;
+    for (int32_t dim = 0; dim < BATCH_DIM; ++dim)
+      runs *= lhs_shape.hi[dim] - lhs_shape.lo[dim] + 1;
+
+    for (size_t run = 0; run < runs; ++run) {
+      size_t lhs_offset  = 0;
+      size_t rhs1_offset = 0;
+      size_t rhs2_offset = 0;
+      size_t remainder   = run;
+      for (int32_t dim = BATCH_DIM - 1; dim >= 0; --dim) {
+        const size_t extent = lhs_shape.hi[dim] - lhs_shape.lo[dim] + 1;
+        const size_t coord  = remainder % extent;
+        remainder /= extent;
+        lhs_offset += coord * lhs_strides[dim];
+        rhs1_offset += coord * rhs1_strides[dim];
+        rhs2_offset += coord * rhs2_strides[dim];
+      }
+
+      BatchedMatMulImplBody<KIND, CODE>()(batches,
+                                          m,
+                                          n,
+                                          k,
+                                          lhs + lhs_offset,
+                                          rhs1 + rhs1_offset,
+                                          rhs2 + rhs2_offset,
+                                          lhs_strides[BATCH_DIM],
+                                          rhs1_strides[BATCH_DIM],
+                                          rhs2_strides[BATCH_DIM],
+                                          lhs_strides[DIM - 2],
+                                          rhs1_stride,
+                                          rhs2_stride,
+                                          rhs1_transposed,
+                                          rhs2_transposed,
+                                          epilogue);
+    }
+  }
+
+  template <LegateTypeCode CODE,
+            int DIM,
+            std::enable_if_t<!((DIM >= 2) && support_batched_matmul<CODE>)>* = nullptr>
+  void operator()(BatchedMatMulArgs& args) const
+  {
+    assert(false);
+  }
+};
+
+template <VariantKind KIND>
+static void batched_matmul_template(TaskContext& context)
+{
+  auto& inputs  = context.inputs();
+  auto& outputs = context.outputs();
+  auto& scalars = context.scalars();
+
+  BatchedMatMulArgs args{outputs[0],
+                         inputs[0],
+                         inputs[1],
+                         inputs.size() > 2 ? &inputs[2] : nullptr,
+                         scalars[0].value<double>(),
+                         scalars[1].value<UnaryOpCode>()};
+  // Note that we can't dispatch on the lhs's type,
+  // as the lhs can have a different type than the rhs'
+  cunumeric::double_dispatch(args.rhs1.dim(), args.rhs1.code(), BatchedMatMulImpl<KIND>{}, args);
+}
+
+}  // namespace cunumeric
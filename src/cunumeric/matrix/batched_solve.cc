@@ -0,0 +1,47 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/matrix/batched_solve.h"
+#include "cunumeric/matrix/batched_solve_template.inl"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <>
+struct BatchedSolveImplBody<VariantKind::CPU> {
+  template <typename OP>
+  void operator()(const OP& op, coord_t volume) const
+  {
+    for (coord_t i = 0; i < volume; ++i) op(i);
+  }
+};
+
+/*static*/ void BatchedSolveTask::cpu_variant(TaskContext& context)
+{
+  batched_solve_template<VariantKind::CPU>(context);
+}
+
+namespace  // unnamed
+{
+static void __attribute__((constructor)) register_tasks(void)
+{
+  BatchedSolveTask::register_variants();
+}
+}  // namespace
+
+}  // namespace cunumeric
@@ -0,0 +1,52 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/matrix/batched_solve.h"
+#include "cunumeric/matrix/batched_solve_template.inl"
+
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+
+// One thread per system, whose buffers spill to local memory for the larger sizes
+template <typename OP>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  batched_solve_kernel(size_t volume, OP op)
+{
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x;
+  for (size_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < volume; idx += stride)
+    op(idx);
+}
+
+template <>
+struct BatchedSolveImplBody<VariantKind::GPU> {
+  template <typename OP>
+  void operator()(const OP& op, coord_t volume) const
+  {
+    auto stream         = get_cached_stream();
+    const size_t blocks = grid_stride_blocks<1>(volume);
+    batched_solve_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(volume, op);
+  }
+};
+
+/*static*/ void BatchedSolveTask::gpu_variant(TaskContext& context)
+{
+  batched_solve_template<VariantKind::GPU>(context);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,50 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "cunumeric/cunumeric.h"
+
+namespace cunumeric {
+
+struct BatchedSolveArgs {
+  const Array& x;
+  const Array& a;
+  // Null for an inverse, which solves against the identity
+  const Array* b;
+  bool cholesky;
+};
+
+// Solves stacks of small systems, x[i] = a[i]^-1 @ b[i] for (batch, n, n) matrices and
+// (batch, n, k) right-hand sides, by LU with partial pivoting or, for Hermitian
+// positive-definite ones, by Cholesky. The stores are only partitioned along the batch, and
+// every system is factored and solved by a single thread in its own small buffers, which
+// suits the many tiny systems that would otherwise take a task each.
+class BatchedSolveTask : public CuNumericTask<BatchedSolveTask> {
+ public:
+  static const int TASK_ID = CUNUMERIC_BATCHED_SOLVE;
+
+ public:
+  static void cpu_variant(legate::TaskContext& context);
+#ifdef LEGATE_USE_OPENMP
+  static void omp_variant(legate::TaskContext& context);
+#endif
+#ifdef LEGATE_USE_CUDA
+  static void gpu_variant(legate::TaskContext& context);
+#endif
+};
+
+}  // namespace cunumeric
@@ -0,0 +1,182 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cmath>
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+// The largest systems the task solves, which still fit the buffers of a single thread
+constexpr coord_t BATCHED_SOLVE_MAX_N = 32;
+
+template <VariantKind KIND>
+struct BatchedSolveImplBody;
+
+// Factors and solves system i of the tile. The buffers are sized by MAX_N at compile time,
+// so that the loops over them can be unrolled and the smallest systems stay in registers.
+template <typename VAL, int32_t MAX_N>
+struct BatchedSolver {
+  __CUDA_HD__ void operator()(coord_t i) const
+  {
+    using std::abs;
+    using std::sqrt;
+
+    VAL lu[MAX_N][MAX_N];
+    int32_t perm[MAX_N];
+    VAL y[MAX_N];
+
+    for (coord_t r = 0; r < n; ++r) {
+      perm[r] = r;
+      for (coord_t c = 0; c < n; ++c) lu[r][c] = a[a_lo + Point<3>(i, r, c)];
+    }
+
+    if (cholesky) {
+      // Only the lower triangle is read, like LAPACK's potrf with uplo L
+      for (coord_t j = 0; j < n; ++j) {
+        VAL diag = lu[j][j];
+        for (coord_t p = 0; p < j; ++p) diag -= lu[j][p] * lu[j][p];
+        diag     = sqrt(diag);
+        lu[j][j] = diag;
+        for (coord_t r = j + 1; r < n; ++r) {
+          VAL value = lu[r][j];
+          for (coord_t p = 0; p < j; ++p) value -= lu[r][p] * lu[j][p];
+          lu[r][j] = value / diag;
+        }
+      }
+    } else {
+      for (coord_t j = 0; j < n; ++j) {
+        coord_t pivot = j;
+        for (coord_t r = j + 1; r < n; ++r)
+          if (abs(lu[r][j]) > abs(lu[pivot][j])) pivot = r;
+        if (pivot != j) {
+          for (coord_t c = 0; c < n; ++c) {
+            const VAL tmp = lu[j][c];
+            lu[j][c]      = lu[pivot][c];
+            lu[pivot][c]  = tmp;
+          }
+          const int32_t tmp = perm[j];
+          perm[j]           = perm[pivot];
+          perm[pivot]       = tmp;
+        }
+        // A singular system leaves infinities and NaNs in the solution, as the
+        // unbatched solve does
+        for (coord_t r = j + 1; r < n; ++r) {
+          const VAL factor = lu[r][j] / lu[j][j];
+          lu[r][j]         = factor;
+          for (coord_t c = j + 1; c < n; ++c) lu[r][c] -= factor * lu[j][c];
+        }
+      }
+    }
+
+    for (coord_t col = 0; col < k; ++col) {
+      for (coord_t r = 0; r < n; ++r)
+        y[r] = inverse ? VAL(perm[r] == col ? 1 : 0) : b[b_lo + Point<3>(i, perm[r], col)];
+      // Forward substitution with L, which has a unit diagonal for LU
+      for (coord_t r = 0; r < n; ++r) {
+        VAL value = y[r];
+        for (coord_t p = 0; p < r; ++p) value -= lu[r][p] * y[p];
+        y[r] = cholesky ? value / lu[r][r] : value;
+      }
+      // Backward substitution with U, which is the transpose of L for Cholesky
+      for (coord_t r = n - 1; r >= 0; --r) {
+        VAL value = y[r];
+        for (coord_t p = r + 1; p < n; ++p) value -= (cholesky ? lu[p][r] : lu[r][p]) * y[p];
+        y[r] = value / lu[r][r];
+      }
+      for (coord_t r = 0; r < n; ++r) x[x_lo + Point<3>(i, r, col)] = y[r];
+    }
+  }
+
+  AccessorWO<VAL, 3> x;
+  AccessorRO<VAL, 3> a;
+  AccessorRO<VAL, 3> b;
+  Point<3> x_lo;
+  Point<3> a_lo;
+  Point<3> b_lo;
+  coord_t n;
+  coord_t k;
+  bool inverse;
+  bool cholesky;
+};
+
+template <VariantKind KIND>
+struct BatchedSolveImpl {
+  template <typename VAL, int32_t MAX_N>
+  void solve(const BatchedSolveArgs& args, const Rect<3>& rect, const Rect<3>& a_rect) const
+  {
+    BatchedSolver<VAL, MAX_N> solver;
+    solver.x    = args.x.write_accessor<VAL, 3>(rect);
+    solver.a    = args.a.read_accessor<VAL, 3>(a_rect);
+    solver.x_lo = rect.lo;
+    solver.a_lo = a_rect.lo;
+    if (args.b != nullptr) {
+      auto b_rect = args.b->shape<3>();
+      solver.b    = args.b->read_accessor<VAL, 3>(b_rect);
+      solver.b_lo = b_rect.lo;
+    }
+    solver.n        = a_rect.hi[2] - a_rect.lo[2] + 1;
+    solver.k        = rect.hi[2] - rect.lo[2] + 1;
+    solver.inverse  = args.b == nullptr;
+    solver.cholesky = args.cholesky;
+    BatchedSolveImplBody<KIND>()(solver, rect.hi[0] - rect.lo[0] + 1);
+  }
+
+  template <LegateTypeCode CODE,
+            std::enable_if_t<CODE == LegateTypeCode::FLOAT_LT ||
+                             CODE == LegateTypeCode::DOUBLE_LT>* = nullptr>
+  void operator()(BatchedSolveArgs& args) const
+  {
+    using VAL = legate_type_of<CODE>;
+
+    auto rect   = args.x.shape<3>();
+    auto a_rect = args.a.shape<3>();
+    if (rect.empty()) return;
+
+    const coord_t n = a_rect.hi[2] - a_rect.lo[2] + 1;
+    assert(n <= BATCHED_SOLVE_MAX_N);
+    if (n <= 4)
+      solve<VAL, 4>(args, rect, a_rect);
+    else if (n <= 8)
+      solve<VAL, 8>(args, rect, a_rect);
+    else if (n <= 16)
+      solve<VAL, 16>(args, rect, a_rect);
+    else
+      solve<VAL, BATCHED_SOLVE_MAX_N>(args, rect, a_rect);
+  }
+
+  template <LegateTypeCode CODE,
+            std::enable_if_t<CODE != LegateTypeCode::FLOAT_LT &&
+                             CODE != LegateTypeCode::DOUBLE_LT>* = nullptr>
+  void operator()(BatchedSolveArgs& args) const
+  {
+    assert(false);
+  }
+};
+
+template <VariantKind KIND>
+static void batched_solve_template(TaskContext& context)
+{
+  auto& inputs = context.inputs();
+  BatchedSolveArgs args{context.outputs()[0],
+                        inputs[0],
+                        inputs.size() > 1 ? &inputs[1] : nullptr,
+                        context.scalars()[0].value<bool>()};
+  cunumeric::type_dispatch(args.a.code(), BatchedSolveImpl<KIND>{}, args);
+}
+
+}  // namespace cunumeric
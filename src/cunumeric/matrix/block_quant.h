@@ -0,0 +1,84 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <cmath>
+
+#include "legate.h"
+
+namespace cunumeric {
+
+// Block-quantized arrays keep their rows in blocks of this many elements, each block
+// stored as signed integer codes of 8 or 4 bits and one float scale. The codes are
+// symmetric around zero, so a block is decoded as code * scale, and two 4-bit codes
+// share a byte with the even element in the low nibble.
+constexpr int64_t QUANT_BLOCK = 64;
+
+__CUDA_HD__ inline int32_t quant_max_code(int32_t bits) { return bits == 8 ? 127 : 7; }
+
+// The offset of the codes of a block in its row
+__CUDA_HD__ inline int64_t quant_code_offset(int64_t block, int32_t bits)
+{
+  return block * QUANT_BLOCK * bits / 8;
+}
+
+__CUDA_HD__ inline int32_t quant_get_code(const int8_t* codes, int64_t idx, int32_t bits)
+{
+  if (bits == 8) return codes[idx];
+  const int32_t byte = codes[idx / 2];
+  // Shifting the nibble to the top of the byte and back extends its sign
+  return static_cast<int8_t>(((idx & 1) ? byte : (byte << 4)) & 0xF0) >> 4;
+}
+
+// Encodes the count elements of one block, which are followed by zero codes up to the
+// size of a block
+template <typename VAL>
+__CUDA_HD__ inline void quant_encode_block(
+  const VAL* in, int64_t stride, int64_t count, int32_t bits, int8_t* codes, float* scale)
+{
+  VAL amax = 0;
+  for (int64_t idx = 0; idx < count; ++idx) {
+    const VAL value = in[idx * stride] < 0 ? -in[idx * stride] : in[idx * stride];
+    if (value > amax) amax = value;
+  }
+  const int32_t max_code  = quant_max_code(bits);
+  const float block_scale = static_cast<float>(amax / max_code);
+  const VAL inverse       = block_scale > 0 ? static_cast<VAL>(1.f / block_scale) : VAL{0};
+  *scale                  = block_scale;
+
+  auto encode = [&](int64_t idx) -> int32_t {
+    if (idx >= count) return 0;
+    auto code = static_cast<int32_t>(nearbyint(in[idx * stride] * inverse));
+    return code > max_code ? max_code : (code < -max_code ? -max_code : code);
+  };
+  if (bits == 8)
+    for (int64_t idx = 0; idx < QUANT_BLOCK; ++idx) codes[idx] = encode(idx);
+  else
+    for (int64_t idx = 0; idx < QUANT_BLOCK; idx += 2)
+      codes[idx / 2] = static_cast<int8_t>((encode(idx) & 0xF) | (encode(idx + 1) << 4));
+}
+
+template <typename VAL>
+__CUDA_HD__ inline void quant_decode_block(
+  const int8_t* codes, float scale, int64_t count, int32_t bits, VAL* out, int64_t stride)
+{
+  const VAL block_scale = static_cast<VAL>(scale);
+  for (int64_t idx = 0; idx < count; ++idx)
+    out[idx * stride] = block_scale * static_cast<VAL>(quant_get_code(codes, idx, bits));
+}
+
+}  // namespace cunumeric
@@ -23,6 +23,51 @@ namespace cunumeric {
 
 using namespace Legion;
 
+// Finding a contraction plan and sizing its workspace costs more than the contraction
+// itself for mid-sized tensors, so the plans are cached per GPU, keyed by everything
+// that went into them, and evicted in least-recently-used order
+constexpr size_t MAX_CONTRACTION_PLANS = 8;
+
+struct ContractionKey {
+ public:
+  bool operator==(const ContractionKey& other) const
+  {
+    if (type != other.type) return false;
+    for (int32_t idx = 0; idx < 3; ++idx) {
+      if (ndim[idx] != other.ndim[idx] || alignment[idx] != other.alignment[idx]) return false;
+      for (size_t dim = 0; dim < ndim[idx]; ++dim)
+        if (shape[idx][dim] != other.shape[idx][dim] ||
+            strides[idx][dim] != other.strides[idx][dim] ||
+            modes[idx][dim] != other.modes[idx][dim])
+          return false;
+    }
+    return true;
+  }
+
+ public:
+  cudaDataType_t type;
+  // Indexed by lhs, rhs1 and rhs2
+  size_t ndim[3];
+  int64_t shape[3][LEGION_MAX_DIM];
+  int64_t strides[3][LEGION_MAX_DIM];
+  int32_t modes[3][LEGION_MAX_DIM];
+  uint32_t alignment[3];
+};
+
+struct ContractionPlan {
+ public:
+  ContractionPlan(void) : valid(false) {}
+
+ public:
+  bool valid;
+  ContractionKey key;
+  cutensorContractionPlan_t plan;
+  uint64_t work_size;
+  unsigned lru_index;
+};
+
+static ContractionPlan contraction_plan_cache[LEGION_MAX_NUM_PROCS][MAX_CONTRACTION_PLANS];
+
 template <cudaDataType_t DATA_TYPE_CODE, cutensorComputeType_t COMPUTE_TYPE_CODE, typename T>
 __host__ void contract(T* lhs_data,
                        size_t lhs_ndim,
@@ -62,40 +107,97 @@ __host__ void contract(T* lhs_data,
   CHECK_CUTENSOR(cutensorGetAlignmentRequirement(handle, lhs_data, &lhs_desc, &lhs_req));
   CHECK_CUTENSOR(cutensorGetAlignmentRequirement(handle, rhs1_data, &rhs1_desc, &rhs1_req));
   CHECK_CUTENSOR(cutensorGetAlignmentRequirement(handle, rhs2_data, &rhs2_desc, &rhs2_req));
-  cutensorContractionDescriptor_t desc;
-  CHECK_CUTENSOR(cutensorInitContractionDescriptor(handle,
-                                                   &desc,
-                                                   &rhs1_desc,
-                                                   rhs1_modes,
-                                                   rhs1_req,
-                                                   &rhs2_desc,
-                                                   rhs2_modes,
-                                                   rhs2_req,
-                                                   &lhs_desc,
-                                                   lhs_modes,
-                                                   lhs_req,
-                                                   &lhs_desc,
-                                                   lhs_modes,
-                                                   lhs_req,
-                                                   COMPUTE_TYPE_CODE));
-  cutensorContractionFind_t find;
-  CHECK_CUTENSOR(cutensorInitContractionFind(handle, &find, CUTENSOR_ALGO_DEFAULT));
-
-  // Allocate intermediate storage
-  uint64_t work_size = 0;
-  CHECK_CUTENSOR(cutensorContractionGetWorkspace(
-    handle, &desc, &find, CUTENSOR_WORKSPACE_RECOMMENDED, &work_size));
-  DeferredBuffer<uint8_t, 1> work_buf(Rect<1>(Point<1>(0), Point<1>(work_size - 1)),
-                                      Memory::GPU_FB_MEM);
-  void* work = work_buf.ptr(Point<1>(0));
+
+  ContractionKey key;
+  key.type                    = DATA_TYPE_CODE;
+  const size_t ndim[3]        = {lhs_ndim, rhs1_ndim, rhs2_ndim};
+  const int64_t* shape[3]     = {lhs_shape, rhs1_shape, rhs2_shape};
+  const int64_t* strides[3]   = {lhs_strides, rhs1_strides, rhs2_strides};
+  const int32_t* modes[3]     = {lhs_modes, rhs1_modes, rhs2_modes};
+  const uint32_t alignment[3] = {lhs_req, rhs1_req, rhs2_req};
+  for (int32_t idx = 0; idx < 3; ++idx) {
+    key.ndim[idx]      = ndim[idx];
+    key.alignment[idx] = alignment[idx];
+    for (size_t dim = 0; dim < ndim[idx]; ++dim) {
+      key.shape[idx][dim]   = shape[idx][dim];
+      key.strides[idx][dim] = strides[idx][dim];
+      key.modes[idx][dim]   = modes[idx][dim];
+    }
+  }
+
+  // Check to see if the plan is already in the cache
+  // Some hackiness until Legion can support stateless runtime caches
+  const unsigned proc_idx = Processor::get_executing_processor().id & (LEGION_MAX_NUM_PROCS - 1);
+  auto cache              = contraction_plan_cache[proc_idx];
+  int plan_index          = -1;
+  for (unsigned idx = 0; idx < MAX_CONTRACTION_PLANS; idx++) {
+    if (!cache[idx].valid || !(cache[idx].key == key)) continue;
+    plan_index = idx;
+    break;
+  }
+  if (plan_index < 0) {
+    // If we didn't find it, then we'll take an unused entry, or otherwise the one that
+    // was least recently-used
+    for (unsigned idx = 0; idx < MAX_CONTRACTION_PLANS; idx++) {
+      if (!cache[idx].valid) {
+        plan_index           = idx;
+        cache[idx].lru_index = idx;
+        break;
+      } else if (cache[idx].lru_index == (MAX_CONTRACTION_PLANS - 1)) {
+        plan_index = idx;
+        break;
+      }
+    }
+    assert(plan_index >= 0);
+
+    ContractionPlan& entry = cache[plan_index];
+    cutensorContractionDescriptor_t desc;
+    CHECK_CUTENSOR(cutensorInitContractionDescriptor(handle,
+                                                     &desc,
+                                                     &rhs1_desc,
+                                                     rhs1_modes,
+                                                     rhs1_req,
+                                                     &rhs2_desc,
+                                                     rhs2_modes,
+                                                     rhs2_req,
+                                                     &lhs_desc,
+                                                     lhs_modes,
+                                                     lhs_req,
+                                                     &lhs_desc,
+                                                     lhs_modes,
+                                                     lhs_req,
+                                                     COMPUTE_TYPE_CODE));
+    cutensorContractionFind_t find;
+    CHECK_CUTENSOR(cutensorInitContractionFind(handle, &find, CUTENSOR_ALGO_DEFAULT));
+
+    entry.work_size = 0;
+    CHECK_CUTENSOR(cutensorContractionGetWorkspace(
+      handle, &desc, &find, CUTENSOR_WORKSPACE_RECOMMENDED, &entry.work_size));
+    CHECK_CUTENSOR(
+      cutensorInitContractionPlan(handle, &entry.plan, &desc, &find, entry.work_size));
+    entry.key   = key;
+    entry.valid = true;
+  }
+  ContractionPlan& entry = cache[plan_index];
+
+  // Bump the lru_index of any plans that were less than our lru_index
+  // and then set our lru_index back to zero
+  if (entry.lru_index > 0) {
+    for (unsigned idx = 0; idx < MAX_CONTRACTION_PLANS; idx++) {
+      ContractionPlan& other = cache[idx];
+      if (other.lru_index < entry.lru_index) other.lru_index++;
+    }
+    entry.lru_index = 0;
+  }
+
+  // The intermediate storage comes from the workspace that the GPU keeps around
+  void* work = entry.work_size > 0 ? get_workspace(entry.work_size) : nullptr;
 
   // Execute contraction
-  cutensorContractionPlan_t plan;
-  CHECK_CUTENSOR(cutensorInitContractionPlan(handle, &plan, &desc, &find, work_size));
   const T alpha = 1.0;
   const T beta  = 0.0;
   CHECK_CUTENSOR(cutensorContraction(handle,
-                                     &plan,
+                                     &entry.plan,
                                      &alpha,
                                      rhs1_data,
                                      rhs2_data,
@@ -103,10 +205,180 @@ __host__ void contract(T* lhs_data,
                                      lhs_data,
                                      lhs_data,
                                      work,
-                                     work_size,
+                                     entry.work_size,
                                      task_stream));
 }
 
+// Runs a GEMM-shaped contraction as a single strided-batched product. As in the matmul
+// tasks, cuBLAS sees our row-major matrices as their column-major transposes, so the
+// operands are swapped to get the row-major result.
+template <typename VAL, typename GemmStridedBatched>
+static void contract_gemm(GemmStridedBatched gemm,
+                          const ContractGemmPlan& plan,
+                          VAL* lhs,
+                          const VAL* rhs1,
+                          const VAL* rhs2)
+{
+  auto cublas_handle = get_cublas();
+  // Update the stream because the CUDA hijack can't see inside cuBLAS
+  auto task_stream = get_cached_stream();
+  CHECK_CUBLAS(cublasSetStream(cublas_handle, task_stream));
+
+  const VAL alpha = 1.0;
+  const VAL beta  = 0.0;
+
+  CHECK_CUBLAS(gemm(cublas_handle,
+                    plan.rhs2_transposed ? CUBLAS_OP_T : CUBLAS_OP_N,
+                    plan.rhs1_transposed ? CUBLAS_OP_T : CUBLAS_OP_N,
+                    plan.n,
+                    plan.m,
+                    plan.k,
+                    &alpha,
+                    rhs2,
+                    plan.rhs2_stride,
+                    plan.rhs2_batch_stride,
+                    rhs1,
+                    plan.rhs1_stride,
+                    plan.rhs1_batch_stride,
+                    &beta,
+                    lhs,
+                    plan.lhs_stride,
+                    plan.lhs_batch_stride,
+                    plan.batches));
+}
+
+template <typename VAL, typename GemmStridedBatched, typename CTOR>
+static void contract_complex_gemm(GemmStridedBatched gemm,
+                                  const ContractGemmPlan& plan,
+                                  VAL* lhs,
+                                  const VAL* rhs1,
+                                  const VAL* rhs2,
+                                  CTOR ctor)
+{
+  auto cublas_handle = get_cublas();
+  // Update the stream because the CUDA hijack can't see inside cuBLAS
+  auto task_stream = get_cached_stream();
+  CHECK_CUBLAS(cublasSetStream(cublas_handle, task_stream));
+
+  const VAL alpha = ctor(1.0, 0.0);
+  const VAL beta  = ctor(0.0, 0.0);
+
+  CHECK_CUBLAS(gemm(cublas_handle,
+                    plan.rhs2_transposed ? CUBLAS_OP_T : CUBLAS_OP_N,
+                    plan.rhs1_transposed ? CUBLAS_OP_T : CUBLAS_OP_N,
+                    plan.n,
+                    plan.m,
+                    plan.k,
+                    &alpha,
+                    rhs2,
+                    plan.rhs2_stride,
+                    plan.rhs2_batch_stride,
+                    rhs1,
+                    plan.rhs1_stride,
+                    plan.rhs1_batch_stride,
+                    &beta,
+                    lhs,
+                    plan.lhs_stride,
+                    plan.lhs_batch_stride,
+                    plan.batches));
+}
+
+// cuBLAS has no strided-batched 3M product in double precision, so the batches are
+// issued one at a time
+static cublasStatus_t zgemm3m_strided_batched(cublasHandle_t handle,
+                                              cublasOperation_t transa,
+                                              cublasOperation_t transb,
+                                              int m,
+                                              int n,
+                                              int k,
+                                              const cuDoubleComplex* alpha,
+                                              const cuDoubleComplex* a,
+                                              int lda,
+                                              long long int stride_a,
+                                              const cuDoubleComplex* b,
+                                              int ldb,
+                                              long long int stride_b,
+                                              const cuDoubleComplex* beta,
+                                              cuDoubleComplex* c,
+                                              int ldc,
+                                              long long int stride_c,
+                                              int batches)
+{
+  for (int batch = 0; batch < batches; ++batch) {
+    auto status = cublasZgemm3m(handle,
+                                transa,
+                                transb,
+                                m,
+                                n,
+                                k,
+                                alpha,
+                                a + batch * stride_a,
+                                lda,
+                                b + batch * stride_b,
+                                ldb,
+                                beta,
+                                c + batch * stride_c,
+                                ldc);
+    if (status != CUBLAS_STATUS_SUCCESS) return status;
+  }
+  return CUBLAS_STATUS_SUCCESS;
+}
+
+template <>
+struct ContractGemmBody<VariantKind::GPU, LegateTypeCode::FLOAT_LT> {
+  void operator()(const ContractGemmPlan& plan, float* lhs, const float* rhs1, const float* rhs2)
+  {
+    contract_gemm(cublasSgemmStridedBatched, plan, lhs, rhs1, rhs2);
+  }
+};
+
+template <>
+struct ContractGemmBody<VariantKind::GPU, LegateTypeCode::DOUBLE_LT> {
+  void operator()(const ContractGemmPlan& plan,
+                  double* lhs,
+                  const double* rhs1,
+                  const double* rhs2)
+  {
+    contract_gemm(cublasDgemmStridedBatched, plan, lhs, rhs1, rhs2);
+  }
+};
+
+template <>
+struct ContractGemmBody<VariantKind::GPU, LegateTypeCode::COMPLEX64_LT> {
+  void operator()(const ContractGemmPlan& plan,
+                  complex<float>* lhs_,
+                  const complex<float>* rhs1_,
+                  const complex<float>* rhs2_)
+  {
+    auto lhs  = reinterpret_cast<cuComplex*>(lhs_);
+    auto rhs1 = reinterpret_cast<const cuComplex*>(rhs1_);
+    auto rhs2 = reinterpret_cast<const cuComplex*>(rhs2_);
+
+    if (plan.gemm_3m)
+      contract_complex_gemm(cublasCgemm3mStridedBatched, plan, lhs, rhs1, rhs2, make_float2);
+    else
+      contract_complex_gemm(cublasCgemmStridedBatched, plan, lhs, rhs1, rhs2, make_float2);
+  }
+};
+
+template <>
+struct ContractGemmBody<VariantKind::GPU, LegateTypeCode::COMPLEX128_LT> {
+  void operator()(const ContractGemmPlan& plan,
+                  complex<double>* lhs_,
+                  const complex<double>* rhs1_,
+                  const complex<double>* rhs2_)
+  {
+    auto lhs  = reinterpret_cast<cuDoubleComplex*>(lhs_);
+    auto rhs1 = reinterpret_cast<const cuDoubleComplex*>(rhs1_);
+    auto rhs2 = reinterpret_cast<const cuDoubleComplex*>(rhs2_);
+
+    if (plan.gemm_3m)
+      contract_complex_gemm(zgemm3m_strided_batched, plan, lhs, rhs1, rhs2, make_double2);
+    else
+      contract_complex_gemm(cublasZgemmStridedBatched, plan, lhs, rhs1, rhs2, make_double2);
+  }
+};
+
 template <>
 struct ContractImplBody<VariantKind::GPU, LegateTypeCode::FLOAT_LT> {
   void operator()(float* lhs_data,
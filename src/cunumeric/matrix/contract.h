@@ -27,6 +27,8 @@ struct ContractArgs {
   legate::Span<const bool> lhs_dim_mask;
   legate::Span<const bool> rhs1_dim_mask;
   legate::Span<const bool> rhs2_dim_mask;
+  // Complex GEMMs use the 3M method, with three real products instead of four
+  bool gemm_3m;
 };
 
 class ContractTask : public CuNumericTask<ContractTask> {
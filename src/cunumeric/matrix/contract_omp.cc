@@ -16,7 +16,9 @@
 
 #include "cunumeric/matrix/contract.h"
 #include "cunumeric/matrix/contract_template.inl"
+#include "cunumeric/matrix/util.h"
 
+#include <cblas.h>
 #include <tblis/tblis.h>
 #include <omp.h>
 
@@ -25,6 +27,95 @@ namespace cunumeric {
 using namespace Legion;
 using namespace tblis;
 
+template <typename VAL>
+static void contract_gemm(const ContractGemmPlan& plan, VAL* lhs, const VAL* rhs1, const VAL* rhs2)
+{
+  for (size_t batch = 0; batch < plan.batches; ++batch)
+    gemm(plan.m,
+         plan.n,
+         plan.k,
+         lhs + batch * plan.lhs_batch_stride,
+         rhs1 + batch * plan.rhs1_batch_stride,
+         rhs2 + batch * plan.rhs2_batch_stride,
+         plan.lhs_stride,
+         plan.rhs1_stride,
+         plan.rhs2_stride,
+         plan.rhs1_transposed,
+         plan.rhs2_transposed);
+}
+
+// The products shared with the matmul tasks are only real, so complex ones call BLAS here.
+// The 3M variants are the ones that OpenBLAS provides.
+template <typename VAL, typename Gemm>
+static void contract_complex_gemm(
+  Gemm gemm, const ContractGemmPlan& plan, VAL* lhs, const VAL* rhs1, const VAL* rhs2)
+{
+  const VAL alpha = 1.0;
+  const VAL beta  = 0.0;
+  for (size_t batch = 0; batch < plan.batches; ++batch)
+    gemm(CblasRowMajor,
+         plan.rhs1_transposed ? CblasTrans : CblasNoTrans,
+         plan.rhs2_transposed ? CblasTrans : CblasNoTrans,
+         plan.m,
+         plan.n,
+         plan.k,
+         &alpha,
+         rhs1 + batch * plan.rhs1_batch_stride,
+         plan.rhs1_stride,
+         rhs2 + batch * plan.rhs2_batch_stride,
+         plan.rhs2_stride,
+         &beta,
+         lhs + batch * plan.lhs_batch_stride,
+         plan.lhs_stride);
+}
+
+template <>
+struct ContractGemmBody<VariantKind::OMP, LegateTypeCode::FLOAT_LT> {
+  void operator()(const ContractGemmPlan& plan, float* lhs, const float* rhs1, const float* rhs2)
+  {
+    contract_gemm(plan, lhs, rhs1, rhs2);
+  }
+};
+
+template <>
+struct ContractGemmBody<VariantKind::OMP, LegateTypeCode::DOUBLE_LT> {
+  void operator()(const ContractGemmPlan& plan,
+                  double* lhs,
+                  const double* rhs1,
+                  const double* rhs2)
+  {
+    contract_gemm(plan, lhs, rhs1, rhs2);
+  }
+};
+
+template <>
+struct ContractGemmBody<VariantKind::OMP, LegateTypeCode::COMPLEX64_LT> {
+  void operator()(const ContractGemmPlan& plan,
+                  complex<float>* lhs,
+                  const complex<float>* rhs1,
+                  const complex<float>* rhs2)
+  {
+    if (plan.gemm_3m)
+      contract_complex_gemm(cblas_cgemm3m, plan, lhs, rhs1, rhs2);
+    else
+      contract_complex_gemm(cblas_cgemm, plan, lhs, rhs1, rhs2);
+  }
+};
+
+template <>
+struct ContractGemmBody<VariantKind::OMP, LegateTypeCode::COMPLEX128_LT> {
+  void operator()(const ContractGemmPlan& plan,
+                  complex<double>* lhs,
+                  const complex<double>* rhs1,
+                  const complex<double>* rhs2)
+  {
+    if (plan.gemm_3m)
+      contract_complex_gemm(cblas_zgemm3m, plan, lhs, rhs1, rhs2);
+    else
+      contract_complex_gemm(cblas_zgemm, plan, lhs, rhs1, rhs2);
+  }
+};
+
 template <>
 struct ContractImplBody<VariantKind::OMP, LegateTypeCode::FLOAT_LT> {
   void operator()(float* lhs_data,
@@ -177,6 +268,7 @@ struct ContractImplBody<VariantKind::OMP, LegateTypeCode::COMPLEX128_LT> {
   ss << omp_get_max_threads();
   std::string str = ss.str();
   setenv("TBLIS_NUM_THREADS", str.data(), false /*overwrite*/);
+  BlasThreads blas_threads(omp_get_max_threads());
   contract_template<VariantKind::OMP>(context);
 }
 
@@ -14,6 +14,9 @@
  *
  */
 
+#include <algorithm>
+#include <vector>
+
 #if 0  // debugging output
 #include "core/utilities/debug.h"
 #include <unistd.h>
@@ -43,6 +46,215 @@ template <>
 struct support_contract<LegateTypeCode::COMPLEX128_LT> : std::true_type {
 };
 
+template <VariantKind KIND, LegateTypeCode CODE>
+struct ContractGemmBody;
+
+// Contractions of these types can go to the row-major BLAS products of the matmul tasks
+template <LegateTypeCode CODE>
+struct support_contract_gemm : std::false_type {
+};
+template <>
+struct support_contract_gemm<LegateTypeCode::FLOAT_LT> : std::true_type {
+};
+template <>
+struct support_contract_gemm<LegateTypeCode::DOUBLE_LT> : std::true_type {
+};
+template <>
+struct support_contract_gemm<LegateTypeCode::COMPLEX64_LT> : std::true_type {
+};
+template <>
+struct support_contract_gemm<LegateTypeCode::COMPLEX128_LT> : std::true_type {
+};
+
+// A contraction that is a strided batch of row-major products lhs = rhs1 * rhs2. When
+// the operands are swapped, the product is computed as lhs^T = rhs2^T * rhs1^T so that
+// the output is row-major, and rhs1 and rhs2 below are the original rhs2 and rhs1.
+struct ContractGemmPlan {
+  bool swapped;
+  size_t batches;
+  size_t m;
+  size_t n;
+  size_t k;
+  size_t lhs_batch_stride;
+  size_t rhs1_batch_stride;
+  size_t rhs2_batch_stride;
+  size_t lhs_stride;
+  size_t rhs1_stride;
+  size_t rhs2_stride;
+  bool rhs1_transposed;
+  bool rhs2_transposed;
+  // Only used by complex products, see ContractArgs
+  bool gemm_3m;
+};
+
+struct ContractOperand {
+  size_t ndim;
+  const int64_t* shape;
+  const int64_t* strides;
+  const int32_t* modes;
+
+  int32_t find(int32_t mode) const
+  {
+    for (size_t idx = 0; idx < ndim; ++idx)
+      if (modes[idx] == mode) return idx;
+    return -1;
+  }
+};
+
+// Merges the modes of one group, in the order given, into a single mode of the operand.
+// This only works when every mode steps over exactly the extent of the next one.
+static bool merge_modes(const ContractOperand& operand,
+                        const std::vector<int32_t>& group,
+                        const std::vector<int64_t>& extents,
+                        size_t& extent,
+                        size_t& stride)
+{
+  extent = 1;
+  stride = 0;
+  for (size_t idx = 0; idx < group.size(); ++idx) {
+    auto dim = operand.find(group[idx]);
+    if (idx > 0 && operand.strides[dim] * extents[idx] != static_cast<int64_t>(stride))
+      return false;
+    extent *= extents[idx];
+    stride = operand.strides[dim];
+  }
+  return true;
+}
+
+// Checks that a rows x cols matrix is row-major or the transpose of a row-major matrix,
+// and picks its leading dimension. Strides of unit extents are irrelevant.
+static bool matrix_layout(
+  size_t rows, size_t cols, size_t row_stride, size_t col_stride, bool& transposed, size_t& ld)
+{
+  if ((cols == 1 || col_stride == 1) && (rows == 1 || row_stride >= cols)) {
+    transposed = false;
+    ld         = rows == 1 ? cols : row_stride;
+    return true;
+  }
+  if ((rows == 1 || row_stride == 1) && (cols == 1 || col_stride >= rows)) {
+    transposed = true;
+    ld         = cols == 1 ? rows : col_stride;
+    return true;
+  }
+  return false;
+}
+
+// Detects contractions that are a GEMM or a batched GEMM after permuting and merging
+// modes. Every mode must be shared by exactly the lhs and rhs1 (M), the lhs and rhs2 (N),
+// rhs1 and rhs2 (K), or all three (batch), and the modes of each group must merge into a
+// single strided mode in every operand that has them.
+static bool plan_contract_gemm(const ContractOperand& lhs,
+                               const ContractOperand& rhs1,
+                               const ContractOperand& rhs2,
+                               ContractGemmPlan& plan)
+{
+  enum { BATCH = 0, M = 1, N = 2, K = 3 };
+  std::vector<int32_t> groups[4];
+  std::vector<int64_t> extents[4];
+
+  const ContractOperand* operands[3] = {&lhs, &rhs1, &rhs2};
+  std::vector<int32_t> seen;
+  for (auto operand : operands)
+    for (size_t idx = 0; idx < operand->ndim; ++idx) {
+      auto mode = operand->modes[idx];
+      if (std::find(seen.begin(), seen.end(), mode) != seen.end()) continue;
+      seen.push_back(mode);
+
+      int32_t dims[3];
+      int64_t extent = -1;
+      for (int32_t op = 0; op < 3; ++op) {
+        dims[op] = operands[op]->find(mode);
+        if (dims[op] < 0) continue;
+        auto op_extent = operands[op]->shape[dims[op]];
+        if (extent >= 0 && op_extent != extent) return false;
+        extent = op_extent;
+      }
+      // Unit modes can be dropped from any operand
+      if (extent == 1) continue;
+
+      int32_t group;
+      if (dims[0] >= 0 && dims[1] >= 0 && dims[2] >= 0)
+        group = BATCH;
+      else if (dims[0] >= 0 && dims[1] >= 0)
+        group = M;
+      else if (dims[0] >= 0 && dims[2] >= 0)
+        group = N;
+      else if (dims[1] >= 0 && dims[2] >= 0)
+        group = K;
+      else
+        return false;
+      groups[group].push_back(mode);
+      extents[group].push_back(extent);
+    }
+
+  // Order the modes of every group from the outermost to the innermost in one operand
+  // that has them; the other operand has to agree for the modes to merge
+  const ContractOperand* reference[4] = {&lhs, &lhs, &lhs, &rhs1};
+  for (int32_t group = 0; group < 4; ++group) {
+    auto& modes  = groups[group];
+    auto operand = reference[group];
+    std::vector<size_t> order(modes.size());
+    for (size_t idx = 0; idx < order.size(); ++idx) order[idx] = idx;
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+      return operand->strides[operand->find(modes[a])] >
+             operand->strides[operand->find(modes[b])];
+    });
+    std::vector<int32_t> sorted_modes;
+    std::vector<int64_t> sorted_extents;
+    for (auto idx : order) {
+      sorted_modes.push_back(modes[idx]);
+      sorted_extents.push_back(extents[group][idx]);
+    }
+    modes          = sorted_modes;
+    extents[group] = sorted_extents;
+  }
+
+  size_t extent[4];
+  size_t lhs_strides[4]{0};
+  size_t rhs1_strides[4]{0};
+  size_t rhs2_strides[4]{0};
+  for (int32_t group : {BATCH, M, N}) {
+    if (!merge_modes(lhs, groups[group], extents[group], extent[group], lhs_strides[group]))
+      return false;
+  }
+  for (int32_t group : {BATCH, M, K}) {
+    if (!merge_modes(rhs1, groups[group], extents[group], extent[group], rhs1_strides[group]))
+      return false;
+  }
+  for (int32_t group : {BATCH, N, K}) {
+    if (!merge_modes(rhs2, groups[group], extents[group], extent[group], rhs2_strides[group]))
+      return false;
+  }
+
+  // The output has to be row-major, so a column-major one is computed as lhs^T
+  bool transposed;
+  if (!matrix_layout(
+        extent[M], extent[N], lhs_strides[M], lhs_strides[N], transposed, plan.lhs_stride))
+    return false;
+  plan.swapped = transposed;
+  if (plan.swapped)
+    matrix_layout(
+      extent[N], extent[M], lhs_strides[N], lhs_strides[M], transposed, plan.lhs_stride);
+  assert(!transposed);
+
+  const int32_t rows   = plan.swapped ? N : M;
+  const int32_t cols   = plan.swapped ? M : N;
+  const auto a_strides = plan.swapped ? rhs2_strides : rhs1_strides;
+  const auto b_strides = plan.swapped ? rhs1_strides : rhs2_strides;
+
+  plan.batches           = extent[BATCH];
+  plan.m                 = extent[rows];
+  plan.n                 = extent[cols];
+  plan.k                 = extent[K];
+  plan.lhs_batch_stride  = lhs_strides[BATCH];
+  plan.rhs1_batch_stride = a_strides[BATCH];
+  plan.rhs2_batch_stride = b_strides[BATCH];
+  return matrix_layout(
+           plan.m, plan.k, a_strides[rows], a_strides[K], plan.rhs1_transposed, plan.rhs1_stride) &&
+         matrix_layout(
+           plan.k, plan.n, b_strides[K], b_strides[cols], plan.rhs2_transposed, plan.rhs2_stride);
+}
+
 #if 0  // debugging output
 
 template <typename T>
@@ -167,6 +379,23 @@ struct ContractImpl {
     std::cout.flush();
 #endif
 
+    if constexpr (support_contract_gemm<CODE>::value) {
+      ContractOperand lhs{lhs_shape.size(), lhs_shape.data(), lhs_strides.data(), lhs_modes.data()};
+      ContractOperand rhs1{
+        rhs1_shape.size(), rhs1_shape.data(), rhs1_strides.data(), rhs1_modes.data()};
+      ContractOperand rhs2{
+        rhs2_shape.size(), rhs2_shape.data(), rhs2_strides.data(), rhs2_modes.data()};
+      ContractGemmPlan plan;
+      if (plan_contract_gemm(lhs, rhs1, rhs2, plan)) {
+        plan.gemm_3m = args.gemm_3m;
+        ContractGemmBody<KIND, CODE>()(plan,
+                                       lhs_data,
+                                       plan.swapped ? rhs2_data : rhs1_data,
+                                       plan.swapped ? rhs1_data : rhs2_data);
+        return;
+      }
+    }
+
     ContractImplBody<KIND, CODE>()(lhs_data,
                                    lhs_shape.size(),
                                    lhs_shape.data(),
@@ -214,7 +443,8 @@ static void contract_template(legate::TaskContext& context)
                     inputs[1],
                     scalars[0].values<const bool>(),
                     scalars[1].values<const bool>(),
-                    scalars[2].values<const bool>()};
+                    scalars[2].values<const bool>(),
+                    scalars[3].value<bool>()};
 
   auto dim  = args.lhs.dim();
   auto code = args.lhs.code();
@@ -229,7 +459,7 @@ static void contract_template(legate::TaskContext& context)
   assert(code == args.rhs2.code());
 #endif
 
-  double_dispatch(dim, code, ContractImpl<KIND>{}, args);
+  cunumeric::double_dispatch(dim, code, ContractImpl<KIND>{}, args);
 }
 
 }  // namespace cunumeric
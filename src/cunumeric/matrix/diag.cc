@@ -37,6 +37,17 @@ struct DiagImplBody<VariantKind::CPU, CODE> {
     }
   }
 
+  void operator()(const AccessorWO<VAL, 2>& out,
+                  const AccessorRO<VAL, 2>& in,
+                  const Rect<2>& rect) const
+  {
+    const VAL zero{};
+    for (coord_t i = rect.lo[0]; i <= rect.hi[0]; ++i) {
+      for (coord_t j = rect.lo[1]; j <= rect.hi[1]; ++j) out[Point<2>(i, j)] = zero;
+      if (rect.lo[1] <= i && i <= rect.hi[1]) out[Point<2>(i, i)] = in[Point<2>(i, i)];
+    }
+  }
+
   void operator()(const AccessorRD<SumReduction<VAL>, true, 2>& out,
                   const AccessorRO<VAL, 2>& in,
                   const Point<2>& start,
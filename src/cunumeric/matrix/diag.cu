@@ -17,6 +17,7 @@
 #include "cunumeric/matrix/diag.h"
 #include "cunumeric/matrix/diag_template.inl"
 #include "cunumeric/cuda_help.h"
+#include "cunumeric/pitches.h"
 
 namespace cunumeric {
 
@@ -35,6 +36,21 @@ __global__ static void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
   out[p] = in[p];
 }
 
+template <typename VAL>
+__global__ static void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  diag_construct(const AccessorWO<VAL, 2> out,
+                 const AccessorRO<VAL, 2> in,
+                 const size_t volume,
+                 const FastPitches<1> pitches,
+                 const Rect<2> rect)
+{
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x;
+  for (size_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < volume; idx += stride) {
+    auto p = pitches.unflatten(idx, rect.lo);
+    out[p] = p[0] == p[1] ? in[p] : VAL{};
+  }
+}
+
 template <typename VAL>
 __global__ static void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
   diag_extract(const AccessorRD<SumReduction<VAL>, true, 2> out,
@@ -58,8 +74,22 @@ struct DiagImplBody<VariantKind::GPU, CODE> {
                   const Point<2>& start,
                   size_t distance) const
   {
+    auto stream = get_cached_stream();
+
     const size_t blocks = (distance + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
-    diag_populate<VAL><<<blocks, THREADS_PER_BLOCK>>>(out, in, distance, start);
+    diag_populate<VAL><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(out, in, distance, start);
+  }
+
+  void operator()(const AccessorWO<VAL, 2>& out,
+                  const AccessorRO<VAL, 2>& in,
+                  const Rect<2>& rect) const
+  {
+    auto stream = get_cached_stream();
+
+    FastPitches<1> pitches;
+    const size_t volume = pitches.flatten(rect);
+    const size_t blocks = grid_stride_blocks<1>(volume);
+    diag_construct<VAL><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(out, in, volume, pitches, rect);
   }
 
   void operator()(const AccessorRD<SumReduction<VAL>, true, 2>& out,
@@ -67,8 +97,10 @@ struct DiagImplBody<VariantKind::GPU, CODE> {
                   const Point<2>& start,
                   size_t distance) const
   {
+    auto stream = get_cached_stream();
+
     const size_t blocks = (distance + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
-    diag_extract<VAL><<<blocks, THREADS_PER_BLOCK>>>(out, in, distance, start);
+    diag_extract<VAL><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(out, in, distance, start);
   }
 };
 
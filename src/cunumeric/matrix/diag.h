@@ -22,6 +22,8 @@ namespace cunumeric {
 
 struct DiagArgs {
   bool extract;
+  // Whether a constructed matrix gets zeros off the diagonal in the same pass
+  bool zero;
   const Array& matrix;
   const Array& diag;
 };
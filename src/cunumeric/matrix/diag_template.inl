@@ -31,6 +31,14 @@ struct DiagImpl {
 
     auto shape = args.matrix.shape<2>();
 
+    if (args.zero) {
+      if (shape.empty()) return;
+      auto in  = args.diag.read_accessor<VAL, 2>(shape);
+      auto out = args.matrix.write_accessor<VAL, 2>(shape);
+      DiagImplBody<KIND, CODE>()(out, in, shape);
+      return;
+    }
+
     // Solve for the start
     // y = x
     // x >= shape.lo[0]
@@ -70,10 +78,11 @@ template <VariantKind KIND>
 static void diag_template(TaskContext& context)
 {
   auto extract = context.scalars()[0].value<bool>();
+  auto zero    = context.scalars()[1].value<bool>();
   auto& matrix = extract ? context.inputs()[0] : context.outputs()[0];
-  auto& diag   = extract ? context.reductions()[0] : context.inputs()[1];
-  DiagArgs args{extract, matrix, diag};
-  type_dispatch(args.matrix.code(), DiagImpl<KIND>{}, args);
+  auto& diag   = extract ? context.reductions()[0] : context.inputs()[zero ? 0 : 1];
+  DiagArgs args{extract, zero, matrix, diag};
+  cunumeric::type_dispatch(args.matrix.code(), DiagImpl<KIND>{}, args);
 }
 
 }  // namespace cunumeric
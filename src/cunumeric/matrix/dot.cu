@@ -16,34 +16,25 @@
 
 #include "cunumeric/matrix/dot.h"
 #include "cunumeric/matrix/dot_template.inl"
-#include "cunumeric/cuda_help.h"
+#include "cunumeric/device_scalar_reduction.h"
 
 namespace cunumeric {
 
 using namespace Legion;
 
-template <typename Output, typename ReadAcc, typename Point, typename ACC>
-static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM) reduction_kernel(
-  size_t volume, Output out, ReadAcc rhs1, ReadAcc rhs2, Point origin, size_t iters, ACC identity)
-{
-  auto value = identity;
-  for (size_t idx = 0; idx < iters; idx++) {
-    const size_t offset = (idx * gridDim.x + blockIdx.x) * blockDim.x + threadIdx.x;
-    if (offset < volume) {
-      auto point = origin + offset;
-      SumReduction<ACC>::fold<true>(value,
-                                    static_cast<ACC>(rhs1[point]) * static_cast<ACC>(rhs2[point]));
-    }
+// Loads the product of the two operands at an offset, promoted to the accumulation type
+template <typename VAL, typename ACC>
+struct DotLoader {
+  __device__ inline ACC operator()(size_t offset) const
+  {
+    const auto point = origin + offset;
+    return static_cast<ACC>(rhs1[point]) * static_cast<ACC>(rhs2[point]);
   }
-  // Every thread in the thread block must participate in the exchange to get correct results
-  reduce_output(out, value);
-}
 
-template <typename Buffer, typename RedAcc>
-static __global__ void __launch_bounds__(1, 1) copy_kernel(Buffer result, RedAcc out)
-{
-  out.reduce(0, result.read());
-}
+  AccessorRO<VAL, 1> rhs1;
+  AccessorRO<VAL, 1> rhs2;
+  Point<1> origin;
+};
 
 template <LegateTypeCode CODE>
 struct DotImplBody<VariantKind::GPU, CODE> {
@@ -57,24 +48,11 @@ struct DotImplBody<VariantKind::GPU, CODE> {
                   const Rect<1>& rect,
                   bool dense)
   {
-    cudaStream_t stream;
-    cudaStreamCreate(&stream);
-
-    const auto volume   = rect.volume();
-    const size_t blocks = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
-    DeferredReduction<SumReduction<ACC>> result;
-    size_t shmem_size = THREADS_PER_BLOCK / 32 * sizeof(ACC);
-
-    if (blocks >= MAX_REDUCTION_CTAS) {
-      const size_t iters = (blocks + MAX_REDUCTION_CTAS - 1) / MAX_REDUCTION_CTAS;
-      reduction_kernel<<<MAX_REDUCTION_CTAS, THREADS_PER_BLOCK, shmem_size, stream>>>(
-        volume, result, rhs1, rhs2, rect.lo, iters, SumReduction<ACC>::identity);
-    } else
-      reduction_kernel<<<blocks, THREADS_PER_BLOCK, shmem_size, stream>>>(
-        volume, result, rhs1, rhs2, rect.lo, 1, SumReduction<ACC>::identity);
-
-    copy_kernel<<<1, 1, 0, stream>>>(result, out);
-    cudaStreamDestroy(stream);
+    device_scalar_reduction<SumReduction<ACC>>(out,
+                                                rect.volume(),
+                                                DotLoader<VAL, ACC>{rhs1, rhs2, rect.lo},
+                                                SumReduction<ACC>::identity,
+                                                get_cached_stream());
   }
 };
 
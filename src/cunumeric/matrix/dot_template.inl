@@ -68,7 +68,7 @@ static void dot_template(TaskContext& context)
 {
   auto& inputs = context.inputs();
   DotArgs args{context.reductions()[0], inputs[0], inputs[1]};
-  type_dispatch(args.rhs1.code(), DotImpl<KIND>{}, args);
+  cunumeric::type_dispatch(args.rhs1.code(), DotImpl<KIND>{}, args);
 }
 
 }  // namespace cunumeric
@@ -19,6 +19,8 @@ namespace cunumeric {
 using namespace Legion;
 using namespace legate;
 
+// Computes lhs -= op(rhs1) * op(rhs2) on column-major tiles, where each operand is
+// (conjugate) transposed when its flag is set
 template <VariantKind KIND, LegateTypeCode CODE>
 struct GemmImplBody;
 
@@ -41,7 +43,12 @@ struct support_gemm<LegateTypeCode::COMPLEX128_LT> : std::true_type {
 template <VariantKind KIND>
 struct GemmImpl {
   template <LegateTypeCode CODE, std::enable_if_t<support_gemm<CODE>::value>* = nullptr>
-  void operator()(Array& lhs_array, Array& rhs1_array, Array& rhs2_array) const
+  void operator()(Array& lhs_array,
+                  Array& rhs1_array,
+                  Array& rhs2_array,
+                  bool transpose_rhs1,
+                  bool transpose_rhs2,
+                  bool row_major) const
   {
     using VAL = legate_type_of<CODE>;
 
@@ -61,15 +68,26 @@ struct GemmImpl {
 
     auto m = static_cast<int32_t>(lhs_shape.hi[0] - lhs_shape.lo[0] + 1);
     auto n = static_cast<int32_t>(lhs_shape.hi[1] - lhs_shape.lo[1] + 1);
-    auto k = static_cast<int32_t>(rhs1_shape.hi[1] - rhs1_shape.lo[1] + 1);
-    assert(rhs2_shape.hi[0] - rhs2_shape.lo[0] + 1 == n);
-    assert(rhs2_shape.hi[1] - rhs2_shape.lo[1] + 1 == k);
-
-    GemmImplBody<KIND, CODE>()(lhs, rhs1, rhs2, m, n, k);
+    auto k = static_cast<int32_t>(rhs1_shape.hi[transpose_rhs1 ? 0 : 1] -
+                                  rhs1_shape.lo[transpose_rhs1 ? 0 : 1] + 1);
+    assert(rhs2_shape.hi[0] - rhs2_shape.lo[0] + 1 == (transpose_rhs2 ? n : k));
+    assert(rhs2_shape.hi[1] - rhs2_shape.lo[1] + 1 == (transpose_rhs2 ? k : n));
+
+    // A row-major tile is the transpose of a column-major one, so the same product is
+    // computed column-major as lhs^T -= op(rhs2)^T * op(rhs1)^T with the operands swapped
+    if (row_major)
+      GemmImplBody<KIND, CODE>()(lhs, rhs2, rhs1, n, m, k, transpose_rhs2, transpose_rhs1);
+    else
+      GemmImplBody<KIND, CODE>()(lhs, rhs1, rhs2, m, n, k, transpose_rhs1, transpose_rhs2);
   }
 
   template <LegateTypeCode CODE, std::enable_if_t<!support_gemm<CODE>::value>* = nullptr>
-  void operator()(Array& lhs_array, Array& rhs1_array, Array& rhs2_array) const
+  void operator()(Array& lhs_array,
+                  Array& rhs1_array,
+                  Array& rhs2_array,
+                  bool transpose_rhs1,
+                  bool transpose_rhs2,
+                  bool row_major) const
   {
     assert(false);
   }
@@ -85,7 +103,12 @@ static void gemm_template(TaskContext& context)
   auto& rhs1 = inputs[0];
   auto& rhs2 = inputs[1];
 
-  type_dispatch(lhs.code(), GemmImpl<KIND>{}, lhs, rhs1, rhs2);
+  auto transpose_rhs2 = context.scalars()[0].value<bool>();
+  auto transpose_rhs1 = context.scalars()[1].value<bool>();
+  auto row_major      = context.scalars()[2].value<bool>();
+
+  cunumeric::type_dispatch(
+    lhs.code(), GemmImpl<KIND>{}, lhs, rhs1, rhs2, transpose_rhs1, transpose_rhs2, row_major);
 }
 
 }  // namespace cunumeric
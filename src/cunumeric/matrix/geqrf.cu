@@ -0,0 +1,110 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/matrix/geqrf.h"
+#include "cunumeric/matrix/geqrf_template.inl"
+
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <typename VAL>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  extract_r_kernel(const VAL* array, VAL* r, int32_t m, int32_t n)
+{
+  const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx >= static_cast<size_t>(n) * n) return;
+  const int32_t row = idx % n;
+  const int32_t col = idx / n;
+  r[idx]            = row <= col ? array[row + static_cast<size_t>(col) * m] : VAL{0};
+}
+
+template <typename GeqrfBufferSize,
+          typename OrgqrBufferSize,
+          typename Geqrf,
+          typename Orgqr,
+          typename VAL>
+static inline void geqrf_template(GeqrfBufferSize geqrfBufferSize,
+                                  OrgqrBufferSize orgqrBufferSize,
+                                  Geqrf geqrf,
+                                  Orgqr orgqr,
+                                  VAL* array,
+                                  VAL* r,
+                                  int32_t m,
+                                  int32_t n)
+{
+  auto context = get_cusolver();
+  auto stream  = get_cached_stream();
+  CHECK_CUSOLVER(cusolverDnSetStream(context, stream));
+
+  // The workspace holds tau, the work array shared by both calls and the info word
+  int32_t geqrf_size;
+  int32_t orgqr_size;
+  CHECK_CUSOLVER(geqrfBufferSize(context, m, n, array, m, &geqrf_size));
+  CHECK_CUSOLVER(orgqrBufferSize(context, m, n, n, array, m, nullptr, &orgqr_size));
+  auto bufferSize = std::max(geqrf_size, orgqr_size);
+
+  auto tau    = static_cast<VAL*>(get_workspace((n + bufferSize) * sizeof(VAL) + sizeof(int32_t)));
+  auto buffer = tau + n;
+  auto info   = reinterpret_cast<int32_t*>(buffer + bufferSize);
+
+  CHECK_CUSOLVER(geqrf(context, m, n, array, m, tau, buffer, bufferSize, info));
+
+  const size_t blocks = (static_cast<size_t>(n) * n + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+  extract_r_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(array, r, m, n);
+
+  CHECK_CUSOLVER(orgqr(context, m, n, n, array, m, tau, buffer, bufferSize, info));
+}
+
+template <>
+struct GeqrfImplBody<VariantKind::GPU, LegateTypeCode::FLOAT_LT> {
+  void operator()(float* array, float* r, int32_t m, int32_t n)
+  {
+    geqrf_template(cusolverDnSgeqrf_bufferSize,
+                   cusolverDnSorgqr_bufferSize,
+                   cusolverDnSgeqrf,
+                   cusolverDnSorgqr,
+                   array,
+                   r,
+                   m,
+                   n);
+  }
+};
+
+template <>
+struct GeqrfImplBody<VariantKind::GPU, LegateTypeCode::DOUBLE_LT> {
+  void operator()(double* array, double* r, int32_t m, int32_t n)
+  {
+    geqrf_template(cusolverDnDgeqrf_bufferSize,
+                   cusolverDnDorgqr_bufferSize,
+                   cusolverDnDgeqrf,
+                   cusolverDnDorgqr,
+                   array,
+                   r,
+                   m,
+                   n);
+  }
+};
+
+/*static*/ void GeqrfTask::gpu_variant(TaskContext& context)
+{
+  geqrf_template<VariantKind::GPU>(context);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,78 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/matrix/geqrf.h"
+#include "cunumeric/matrix/geqrf_template.inl"
+#include "cunumeric/matrix/util.h"
+
+#include <cblas.h>
+#include <lapack.h>
+#include <omp.h>
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <typename Geqrf, typename Orgqr, typename VAL>
+static inline void geqrf_template(
+  Geqrf geqrf, Orgqr orgqr, VAL* array, VAL* r, int32_t m, int32_t n)
+{
+  int32_t info = 0;
+
+  // Query the workspace of both calls at once
+  VAL geqrf_size = 0;
+  VAL orgqr_size = 0;
+  int32_t lwork  = -1;
+  geqrf(&m, &n, array, &m, nullptr, &geqrf_size, &lwork, &info);
+  orgqr(&m, &n, &n, array, &m, nullptr, &orgqr_size, &lwork, &info);
+  lwork = static_cast<int32_t>(std::max(geqrf_size, orgqr_size));
+
+  auto tau  = create_buffer<VAL>(n, Memory::Kind::SOCKET_MEM);
+  auto work = create_buffer<VAL>(lwork, Memory::Kind::SOCKET_MEM);
+
+  geqrf(&m, &n, array, &m, tau.ptr(0), work.ptr(0), &lwork, &info);
+
+  for (int32_t col = 0; col < n; ++col)
+    for (int32_t row = 0; row < n; ++row)
+      r[row + col * n] = row <= col ? array[row + col * m] : VAL{0};
+
+  orgqr(&m, &n, &n, array, &m, tau.ptr(0), work.ptr(0), &lwork, &info);
+}
+
+template <>
+struct GeqrfImplBody<VariantKind::OMP, LegateTypeCode::FLOAT_LT> {
+  void operator()(float* array, float* r, int32_t m, int32_t n)
+  {
+    geqrf_template(sgeqrf_, sorgqr_, array, r, m, n);
+  }
+};
+
+template <>
+struct GeqrfImplBody<VariantKind::OMP, LegateTypeCode::DOUBLE_LT> {
+  void operator()(double* array, double* r, int32_t m, int32_t n)
+  {
+    geqrf_template(dgeqrf_, dorgqr_, array, r, m, n);
+  }
+};
+
+/*static*/ void GeqrfTask::omp_variant(TaskContext& context)
+{
+  BlasThreads blas_threads(omp_get_max_threads());
+  geqrf_template<VariantKind::OMP>(context);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,79 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <VariantKind KIND, LegateTypeCode CODE>
+struct GeqrfImplBody;
+
+template <LegateTypeCode CODE>
+struct support_geqrf : std::false_type {
+};
+template <>
+struct support_geqrf<LegateTypeCode::DOUBLE_LT> : std::true_type {
+};
+template <>
+struct support_geqrf<LegateTypeCode::FLOAT_LT> : std::true_type {
+};
+
+template <VariantKind KIND>
+struct GeqrfImpl {
+  template <LegateTypeCode CODE, std::enable_if_t<support_geqrf<CODE>::value>* = nullptr>
+  void operator()(Array& array, Array& r_array) const
+  {
+    using VAL = legate_type_of<CODE>;
+
+    auto shape   = array.shape<2>();
+    auto r_shape = r_array.shape<2>();
+
+    if (shape.empty()) return;
+
+    size_t strides[2];
+    size_t r_strides[2];
+
+    auto arr = array.write_accessor<VAL, 2>(shape).ptr(shape, strides);
+    auto r   = r_array.write_accessor<VAL, 2>(r_shape).ptr(r_shape, r_strides);
+    auto m   = static_cast<int32_t>(shape.hi[0] - shape.lo[0] + 1);
+    auto n   = static_cast<int32_t>(shape.hi[1] - shape.lo[1] + 1);
+    // Only tall blocks have an explicit Q of the same shape
+    assert(m >= n && n > 0);
+    assert(r_shape.volume() == static_cast<size_t>(n) * n);
+
+    GeqrfImplBody<KIND, CODE>()(arr, r, m, n);
+  }
+
+  template <LegateTypeCode CODE, std::enable_if_t<!support_geqrf<CODE>::value>* = nullptr>
+  void operator()(Array& array, Array& r_array) const
+  {
+    assert(false);
+  }
+};
+
+template <VariantKind KIND>
+static void geqrf_template(TaskContext& context)
+{
+  // The block is overwritten with its explicit Q factor and its R factor goes to the
+  // second output, with zeros below the diagonal
+  auto& outputs = context.outputs();
+  auto& array   = outputs[0];
+  auto& r       = outputs[1];
+  cunumeric::type_dispatch(array.code(), GeqrfImpl<KIND>{}, array, r);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,79 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/matrix/gesvd.h"
+#include "cunumeric/matrix/gesvd_template.inl"
+
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <typename GesvdBufferSize, typename Gesvd, typename VAL>
+static inline void gesvd_template(GesvdBufferSize gesvdBufferSize,
+                                  Gesvd gesvd,
+                                  const VAL* a,
+                                  VAL* u,
+                                  VAL* s,
+                                  VAL* vt,
+                                  int32_t m,
+                                  int32_t n)
+{
+  auto context = get_cusolver();
+  auto stream  = get_cached_stream();
+  CHECK_CUSOLVER(cusolverDnSetStream(context, stream));
+
+  int32_t bufferSize;
+  CHECK_CUSOLVER(gesvdBufferSize(context, m, n, &bufferSize));
+
+  // The workspace holds a copy of the matrix, which GESVD destroys, the work array, the
+  // superdiagonal of unconverged singular values and the info word
+  const size_t volume = static_cast<size_t>(m) * n;
+  auto copy           = static_cast<VAL*>(
+    get_workspace((volume + bufferSize + n) * sizeof(VAL) + sizeof(int32_t)));
+  auto buffer = copy + volume;
+  auto rwork  = buffer + bufferSize;
+  auto info   = reinterpret_cast<int32_t*>(rwork + n);
+
+  CHECK_CUDA(cudaMemcpyAsync(copy, a, volume * sizeof(VAL), cudaMemcpyDeviceToDevice, stream));
+  CHECK_CUSOLVER(
+    gesvd(context, 'S', 'S', m, n, copy, m, s, u, m, vt, n, buffer, bufferSize, rwork, info));
+}
+
+template <>
+struct GesvdImplBody<VariantKind::GPU, LegateTypeCode::FLOAT_LT> {
+  void operator()(const float* a, float* u, float* s, float* vt, int32_t m, int32_t n)
+  {
+    gesvd_template(cusolverDnSgesvd_bufferSize, cusolverDnSgesvd, a, u, s, vt, m, n);
+  }
+};
+
+template <>
+struct GesvdImplBody<VariantKind::GPU, LegateTypeCode::DOUBLE_LT> {
+  void operator()(const double* a, double* u, double* s, double* vt, int32_t m, int32_t n)
+  {
+    gesvd_template(cusolverDnDgesvd_bufferSize, cusolverDnDgesvd, a, u, s, vt, m, n);
+  }
+};
+
+/*static*/ void GesvdTask::gpu_variant(TaskContext& context)
+{
+  gesvd_template<VariantKind::GPU>(context);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,74 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/matrix/gesvd.h"
+#include "cunumeric/matrix/gesvd_template.inl"
+#include "cunumeric/matrix/util.h"
+
+#include <cblas.h>
+#include <lapack.h>
+#include <cstring>
+#include <omp.h>
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <typename Gesvd, typename VAL>
+static inline void gesvd_template(
+  Gesvd gesvd, const VAL* a, VAL* u, VAL* s, VAL* vt, int32_t m, int32_t n)
+{
+  // GESVD destroys its input, so it works on a copy of the matrix
+  auto copy = create_buffer<VAL>(static_cast<size_t>(m) * n, Memory::Kind::SOCKET_MEM);
+  std::memcpy(copy.ptr(0), a, static_cast<size_t>(m) * n * sizeof(VAL));
+
+  char jobu    = 'S';
+  char jobvt   = 'S';
+  int32_t info = 0;
+
+  VAL query     = 0;
+  int32_t lwork = -1;
+  gesvd(&jobu, &jobvt, &m, &n, copy.ptr(0), &m, s, u, &m, vt, &n, &query, &lwork, &info);
+  lwork = static_cast<int32_t>(query);
+
+  auto work = create_buffer<VAL>(lwork, Memory::Kind::SOCKET_MEM);
+  gesvd(&jobu, &jobvt, &m, &n, copy.ptr(0), &m, s, u, &m, vt, &n, work.ptr(0), &lwork, &info);
+}
+
+template <>
+struct GesvdImplBody<VariantKind::OMP, LegateTypeCode::FLOAT_LT> {
+  void operator()(const float* a, float* u, float* s, float* vt, int32_t m, int32_t n)
+  {
+    gesvd_template(sgesvd_, a, u, s, vt, m, n);
+  }
+};
+
+template <>
+struct GesvdImplBody<VariantKind::OMP, LegateTypeCode::DOUBLE_LT> {
+  void operator()(const double* a, double* u, double* s, double* vt, int32_t m, int32_t n)
+  {
+    gesvd_template(dgesvd_, a, u, s, vt, m, n);
+  }
+};
+
+/*static*/ void GesvdTask::omp_variant(TaskContext& context)
+{
+  BlasThreads blas_threads(omp_get_max_threads());
+  gesvd_template<VariantKind::OMP>(context);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,86 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <VariantKind KIND, LegateTypeCode CODE>
+struct GesvdImplBody;
+
+template <LegateTypeCode CODE>
+struct support_gesvd : std::false_type {
+};
+template <>
+struct support_gesvd<LegateTypeCode::DOUBLE_LT> : std::true_type {
+};
+template <>
+struct support_gesvd<LegateTypeCode::FLOAT_LT> : std::true_type {
+};
+
+template <VariantKind KIND>
+struct GesvdImpl {
+  template <LegateTypeCode CODE, std::enable_if_t<support_gesvd<CODE>::value>* = nullptr>
+  void operator()(Array& a_array, Array& u_array, Array& s_array, Array& vt_array) const
+  {
+    using VAL = legate_type_of<CODE>;
+
+    auto a_shape  = a_array.shape<2>();
+    auto u_shape  = u_array.shape<2>();
+    auto s_shape  = s_array.shape<1>();
+    auto vt_shape = vt_array.shape<2>();
+
+    if (a_shape.empty()) return;
+
+    size_t a_strides[2];
+    size_t u_strides[2];
+    size_t vt_strides[2];
+
+    auto a  = a_array.read_accessor<VAL, 2>(a_shape).ptr(a_shape, a_strides);
+    auto u  = u_array.write_accessor<VAL, 2>(u_shape).ptr(u_shape, u_strides);
+    auto s  = s_array.write_accessor<VAL, 1>(s_shape).ptr(s_shape);
+    auto vt = vt_array.write_accessor<VAL, 2>(vt_shape).ptr(vt_shape, vt_strides);
+    auto m  = static_cast<int32_t>(a_shape.hi[0] - a_shape.lo[0] + 1);
+    auto n  = static_cast<int32_t>(a_shape.hi[1] - a_shape.lo[1] + 1);
+    // This is the reduced SVD of a tall matrix, which is all cuSOLVER supports
+    assert(m >= n && n > 0);
+    assert(u_shape == a_shape);
+    assert(s_shape.volume() == static_cast<size_t>(n));
+    assert(vt_shape.volume() == static_cast<size_t>(n) * n);
+
+    GesvdImplBody<KIND, CODE>()(a, u, s, vt, m, n);
+  }
+
+  template <LegateTypeCode CODE, std::enable_if_t<!support_gesvd<CODE>::value>* = nullptr>
+  void operator()(Array& a_array, Array& u_array, Array& s_array, Array& vt_array) const
+  {
+    assert(false);
+  }
+};
+
+template <VariantKind KIND>
+static void gesvd_template(TaskContext& context)
+{
+  auto& outputs = context.outputs();
+  auto& a       = context.inputs()[0];
+  auto& u       = outputs[0];
+  auto& s       = outputs[1];
+  auto& vt      = outputs[2];
+  cunumeric::type_dispatch(a.code(), GesvdImpl<KIND>{}, a, u, s, vt);
+}
+
+}  // namespace cunumeric
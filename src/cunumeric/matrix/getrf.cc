@@ -0,0 +1,86 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/matrix/getrf.h"
+#include "cunumeric/matrix/getrf_template.inl"
+#include "cunumeric/matrix/util.h"
+
+#include <cblas.h>
+#include <lapack.h>
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <typename Getrf, typename VAL>
+static inline void getrf_template(
+  Getrf getrf, VAL* array, int32_t* pivots, int32_t m, int32_t n, int32_t offset)
+{
+  int32_t info = 0;
+  getrf(&m, &n, array, &m, pivots, &info);
+
+  // LAPACK numbers the pivots from 1 within the array, so shift them to the whole matrix
+  const auto num_pivots = std::min(m, n);
+  for (int32_t idx = 0; idx < num_pivots; ++idx) pivots[idx] += offset;
+}
+
+template <>
+struct GetrfImplBody<VariantKind::CPU, LegateTypeCode::FLOAT_LT> {
+  void operator()(float* array, int32_t* pivots, int32_t m, int32_t n, int32_t offset)
+  {
+    getrf_template(sgetrf_, array, pivots, m, n, offset);
+  }
+};
+
+template <>
+struct GetrfImplBody<VariantKind::CPU, LegateTypeCode::DOUBLE_LT> {
+  void operator()(double* array, int32_t* pivots, int32_t m, int32_t n, int32_t offset)
+  {
+    getrf_template(dgetrf_, array, pivots, m, n, offset);
+  }
+};
+
+template <>
+struct GetrfImplBody<VariantKind::CPU, LegateTypeCode::COMPLEX64_LT> {
+  void operator()(complex<float>* array, int32_t* pivots, int32_t m, int32_t n, int32_t offset)
+  {
+    getrf_template(cgetrf_, reinterpret_cast<__complex__ float*>(array), pivots, m, n, offset);
+  }
+};
+
+template <>
+struct GetrfImplBody<VariantKind::CPU, LegateTypeCode::COMPLEX128_LT> {
+  void operator()(complex<double>* array, int32_t* pivots, int32_t m, int32_t n, int32_t offset)
+  {
+    getrf_template(zgetrf_, reinterpret_cast<__complex__ double*>(array), pivots, m, n, offset);
+  }
+};
+
+/*static*/ void GetrfTask::cpu_variant(TaskContext& context)
+{
+#ifdef LEGATE_USE_OPENMP
+  BlasThreads blas_threads(1);
+#endif
+  getrf_template<VariantKind::CPU>(context);
+}
+
+namespace  // unnamed
+{
+static void __attribute__((constructor)) register_tasks(void) { GetrfTask::register_variants(); }
+}  // namespace
+
+}  // namespace cunumeric
@@ -0,0 +1,113 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/matrix/getrf.h"
+#include "cunumeric/matrix/getrf_template.inl"
+
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  offset_pivots_kernel(int32_t* pivots, int32_t num_pivots, int32_t offset)
+{
+  const int32_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx >= num_pivots) return;
+  pivots[idx] += offset;
+}
+
+template <typename GetrfBufferSize, typename Getrf, typename VAL>
+static inline void getrf_template(GetrfBufferSize getrfBufferSize,
+                                  Getrf getrf,
+                                  VAL* array,
+                                  int32_t* pivots,
+                                  int32_t m,
+                                  int32_t n,
+                                  int32_t offset)
+{
+  auto context = get_cusolver();
+  auto stream  = get_cached_stream();
+  CHECK_CUSOLVER(cusolverDnSetStream(context, stream));
+
+  int32_t bufferSize;
+  CHECK_CUSOLVER(getrfBufferSize(context, m, n, array, m, &bufferSize));
+
+  auto buffer = static_cast<VAL*>(get_workspace(bufferSize * sizeof(VAL) + sizeof(int32_t)));
+  auto info   = reinterpret_cast<int32_t*>(buffer + bufferSize);
+
+  CHECK_CUSOLVER(getrf(context, m, n, array, m, buffer, pivots, info));
+
+  // cuSOLVER numbers the pivots from 1 within the array, so shift them to the whole matrix
+  const auto num_pivots = std::min(m, n);
+  if (offset != 0) {
+    const size_t blocks = (num_pivots + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+    offset_pivots_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(pivots, num_pivots, offset);
+  }
+}
+
+template <>
+struct GetrfImplBody<VariantKind::GPU, LegateTypeCode::FLOAT_LT> {
+  void operator()(float* array, int32_t* pivots, int32_t m, int32_t n, int32_t offset)
+  {
+    getrf_template(cusolverDnSgetrf_bufferSize, cusolverDnSgetrf, array, pivots, m, n, offset);
+  }
+};
+
+template <>
+struct GetrfImplBody<VariantKind::GPU, LegateTypeCode::DOUBLE_LT> {
+  void operator()(double* array, int32_t* pivots, int32_t m, int32_t n, int32_t offset)
+  {
+    getrf_template(cusolverDnDgetrf_bufferSize, cusolverDnDgetrf, array, pivots, m, n, offset);
+  }
+};
+
+template <>
+struct GetrfImplBody<VariantKind::GPU, LegateTypeCode::COMPLEX64_LT> {
+  void operator()(complex<float>* array, int32_t* pivots, int32_t m, int32_t n, int32_t offset)
+  {
+    getrf_template(cusolverDnCgetrf_bufferSize,
+                   cusolverDnCgetrf,
+                   reinterpret_cast<cuComplex*>(array),
+                   pivots,
+                   m,
+                   n,
+                   offset);
+  }
+};
+
+template <>
+struct GetrfImplBody<VariantKind::GPU, LegateTypeCode::COMPLEX128_LT> {
+  void operator()(complex<double>* array, int32_t* pivots, int32_t m, int32_t n, int32_t offset)
+  {
+    getrf_template(cusolverDnZgetrf_bufferSize,
+                   cusolverDnZgetrf,
+                   reinterpret_cast<cuDoubleComplex*>(array),
+                   pivots,
+                   m,
+                   n,
+                   offset);
+  }
+};
+
+/*static*/ void GetrfTask::gpu_variant(TaskContext& context)
+{
+  getrf_template<VariantKind::GPU>(context);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,94 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/matrix/getrs.h"
+#include "cunumeric/matrix/getrs_template.inl"
+#include "cunumeric/matrix/util.h"
+
+#include <cblas.h>
+#include <lapack.h>
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <typename Getrs, typename VAL>
+static inline void getrs_template(
+  Getrs getrs, VAL* rhs, const VAL* lu, const int32_t* pivots, int32_t n, int32_t nrhs)
+{
+  char trans   = 'N';
+  int32_t info = 0;
+  getrs(&trans, &n, &nrhs, lu, &n, pivots, rhs, &n, &info);
+}
+
+template <>
+struct GetrsImplBody<VariantKind::CPU, LegateTypeCode::FLOAT_LT> {
+  void operator()(float* rhs, const float* lu, const int32_t* pivots, int32_t n, int32_t nrhs)
+  {
+    getrs_template(sgetrs_, rhs, lu, pivots, n, nrhs);
+  }
+};
+
+template <>
+struct GetrsImplBody<VariantKind::CPU, LegateTypeCode::DOUBLE_LT> {
+  void operator()(double* rhs, const double* lu, const int32_t* pivots, int32_t n, int32_t nrhs)
+  {
+    getrs_template(dgetrs_, rhs, lu, pivots, n, nrhs);
+  }
+};
+
+template <>
+struct GetrsImplBody<VariantKind::CPU, LegateTypeCode::COMPLEX64_LT> {
+  void operator()(
+    complex<float>* rhs_, const complex<float>* lu_, const int32_t* pivots, int32_t n, int32_t nrhs)
+  {
+    auto rhs = reinterpret_cast<__complex__ float*>(rhs_);
+    auto lu  = reinterpret_cast<const __complex__ float*>(lu_);
+
+    getrs_template(cgetrs_, rhs, lu, pivots, n, nrhs);
+  }
+};
+
+template <>
+struct GetrsImplBody<VariantKind::CPU, LegateTypeCode::COMPLEX128_LT> {
+  void operator()(complex<double>* rhs_,
+                  const complex<double>* lu_,
+                  const int32_t* pivots,
+                  int32_t n,
+                  int32_t nrhs)
+  {
+    auto rhs = reinterpret_cast<__complex__ double*>(rhs_);
+    auto lu  = reinterpret_cast<const __complex__ double*>(lu_);
+
+    getrs_template(zgetrs_, rhs, lu, pivots, n, nrhs);
+  }
+};
+
+/*static*/ void GetrsTask::cpu_variant(TaskContext& context)
+{
+#ifdef LEGATE_USE_OPENMP
+  BlasThreads blas_threads(1);
+#endif
+  getrs_template<VariantKind::CPU>(context);
+}
+
+namespace  // unnamed
+{
+static void __attribute__((constructor)) register_tasks(void) { GetrsTask::register_variants(); }
+}  // namespace
+
+}  // namespace cunumeric
@@ -0,0 +1,88 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/matrix/getrs.h"
+#include "cunumeric/matrix/getrs_template.inl"
+
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <typename Getrs, typename VAL>
+static inline void getrs_template(
+  Getrs getrs, VAL* rhs, const VAL* lu, const int32_t* pivots, int32_t n, int32_t nrhs)
+{
+  auto context = get_cusolver();
+  auto stream  = get_cached_stream();
+  CHECK_CUSOLVER(cusolverDnSetStream(context, stream));
+
+  auto info = static_cast<int32_t*>(get_workspace(sizeof(int32_t)));
+
+  CHECK_CUSOLVER(getrs(context, CUBLAS_OP_N, n, nrhs, lu, n, pivots, rhs, n, info));
+}
+
+template <>
+struct GetrsImplBody<VariantKind::GPU, LegateTypeCode::FLOAT_LT> {
+  void operator()(float* rhs, const float* lu, const int32_t* pivots, int32_t n, int32_t nrhs)
+  {
+    getrs_template(cusolverDnSgetrs, rhs, lu, pivots, n, nrhs);
+  }
+};
+
+template <>
+struct GetrsImplBody<VariantKind::GPU, LegateTypeCode::DOUBLE_LT> {
+  void operator()(double* rhs, const double* lu, const int32_t* pivots, int32_t n, int32_t nrhs)
+  {
+    getrs_template(cusolverDnDgetrs, rhs, lu, pivots, n, nrhs);
+  }
+};
+
+template <>
+struct GetrsImplBody<VariantKind::GPU, LegateTypeCode::COMPLEX64_LT> {
+  void operator()(
+    complex<float>* rhs_, const complex<float>* lu_, const int32_t* pivots, int32_t n, int32_t nrhs)
+  {
+    auto rhs = reinterpret_cast<cuComplex*>(rhs_);
+    auto lu  = reinterpret_cast<const cuComplex*>(lu_);
+
+    getrs_template(cusolverDnCgetrs, rhs, lu, pivots, n, nrhs);
+  }
+};
+
+template <>
+struct GetrsImplBody<VariantKind::GPU, LegateTypeCode::COMPLEX128_LT> {
+  void operator()(complex<double>* rhs_,
+                  const complex<double>* lu_,
+                  const int32_t* pivots,
+                  int32_t n,
+                  int32_t nrhs)
+  {
+    auto rhs = reinterpret_cast<cuDoubleComplex*>(rhs_);
+    auto lu  = reinterpret_cast<const cuDoubleComplex*>(lu_);
+
+    getrs_template(cusolverDnZgetrs, rhs, lu, pivots, n, nrhs);
+  }
+};
+
+/*static*/ void GetrsTask::gpu_variant(TaskContext& context)
+{
+  getrs_template<VariantKind::GPU>(context);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,88 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <VariantKind KIND, LegateTypeCode CODE>
+struct GetrsImplBody;
+
+template <LegateTypeCode CODE>
+struct support_getrs : std::false_type {
+};
+template <>
+struct support_getrs<LegateTypeCode::DOUBLE_LT> : std::true_type {
+};
+template <>
+struct support_getrs<LegateTypeCode::FLOAT_LT> : std::true_type {
+};
+template <>
+struct support_getrs<LegateTypeCode::COMPLEX64_LT> : std::true_type {
+};
+template <>
+struct support_getrs<LegateTypeCode::COMPLEX128_LT> : std::true_type {
+};
+
+template <VariantKind KIND>
+struct GetrsImpl {
+  template <LegateTypeCode CODE, std::enable_if_t<support_getrs<CODE>::value>* = nullptr>
+  void operator()(Array& rhs_array, Array& lu_array, Array& pivots_array) const
+  {
+    using VAL = legate_type_of<CODE>;
+
+    auto rhs_shape    = rhs_array.shape<2>();
+    auto lu_shape     = lu_array.shape<2>();
+    auto pivots_shape = pivots_array.shape<1>();
+
+    if (rhs_shape.empty()) return;
+
+    size_t rhs_strides[2];
+    size_t lu_strides[2];
+
+    auto rhs    = rhs_array.write_accessor<VAL, 2>(rhs_shape).ptr(rhs_shape, rhs_strides);
+    auto lu     = lu_array.read_accessor<VAL, 2>(lu_shape).ptr(lu_shape, lu_strides);
+    auto pivots = pivots_array.read_accessor<int32_t, 1>(pivots_shape).ptr(pivots_shape);
+
+    auto n    = static_cast<int32_t>(lu_shape.hi[0] - lu_shape.lo[0] + 1);
+    auto nrhs = static_cast<int32_t>(rhs_shape.hi[1] - rhs_shape.lo[1] + 1);
+    assert(n > 0 && nrhs > 0);
+    assert(rhs_shape.hi[0] - rhs_shape.lo[0] + 1 == n);
+
+    GetrsImplBody<KIND, CODE>()(rhs, lu, pivots, n, nrhs);
+  }
+
+  template <LegateTypeCode CODE, std::enable_if_t<!support_getrs<CODE>::value>* = nullptr>
+  void operator()(Array& rhs_array, Array& lu_array, Array& pivots_array) const
+  {
+    assert(false);
+  }
+};
+
+template <VariantKind KIND>
+static void getrs_template(TaskContext& context)
+{
+  auto& inputs = context.inputs();
+
+  auto& rhs    = context.outputs()[0];
+  auto& lu     = inputs[0];
+  auto& pivots = inputs[1];
+
+  cunumeric::type_dispatch(rhs.code(), GetrsImpl<KIND>{}, rhs, lu, pivots);
+}
+
+}  // namespace cunumeric
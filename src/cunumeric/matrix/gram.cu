@@ -0,0 +1,92 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/matrix/gram.h"
+#include "cunumeric/matrix/gram_template.inl"
+
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+// Copies the lower triangle of a row major matrix into its upper triangle
+template <typename VAL>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  mirror_lower_kernel(VAL* lhs, int32_t n, size_t stride)
+{
+  const size_t volume = static_cast<size_t>(n) * n;
+  for (size_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < volume;
+       idx += blockDim.x * gridDim.x) {
+    const size_t i = idx / n;
+    const size_t j = idx % n;
+    if (j > i) lhs[i * stride + j] = lhs[j * stride + i];
+  }
+}
+
+template <typename Syrk, typename VAL>
+static inline void gram_template(Syrk syrk,
+                                 VAL* lhs,
+                                 const VAL* rhs,
+                                 int32_t m,
+                                 int32_t n,
+                                 size_t lhs_stride,
+                                 size_t rhs_stride,
+                                 bool rhs_transposed)
+{
+  auto context = get_cublas();
+  auto stream  = get_cached_stream();
+  CHECK_CUBLAS(cublasSetStream(context, stream));
+
+  // cuBLAS is column major, so a row major block reads as its own transpose and the upper
+  // triangle in column major order is the lower one in row major order
+  auto uplo  = CUBLAS_FILL_MODE_UPPER;
+  auto trans = rhs_transposed ? CUBLAS_OP_T : CUBLAS_OP_N;
+  VAL alpha  = 1.0;
+  VAL beta   = 0.0;
+
+  CHECK_CUBLAS(syrk(context, uplo, trans, n, m, &alpha, rhs, rhs_stride, &beta, lhs, lhs_stride));
+
+  const size_t blocks = (static_cast<size_t>(n) * n + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+  mirror_lower_kernel<VAL>
+    <<<get_grid_stride_ctas(blocks), THREADS_PER_BLOCK, 0, stream>>>(lhs, n, lhs_stride);
+}
+
+template <>
+struct GramImplBody<VariantKind::GPU, LegateTypeCode::FLOAT_LT> {
+  template <typename... Args>
+  void operator()(Args&&... args)
+  {
+    gram_template(cublasSsyrk, std::forward<Args>(args)...);
+  }
+};
+
+template <>
+struct GramImplBody<VariantKind::GPU, LegateTypeCode::DOUBLE_LT> {
+  template <typename... Args>
+  void operator()(Args&&... args)
+  {
+    gram_template(cublasDsyrk, std::forward<Args>(args)...);
+  }
+};
+
+/*static*/ void GramTask::gpu_variant(TaskContext& context)
+{
+  gram_template<VariantKind::GPU>(context);
+}
+
+}  // namespace cunumeric
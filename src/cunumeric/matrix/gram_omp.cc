@@ -0,0 +1,73 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/matrix/gram.h"
+#include "cunumeric/matrix/gram_template.inl"
+#include "cunumeric/matrix/util.h"
+
+#include <cblas.h>
+#include <omp.h>
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <typename Syrk, typename VAL>
+static inline void gram_template(Syrk syrk,
+                                 VAL* lhs,
+                                 const VAL* rhs,
+                                 int32_t m,
+                                 int32_t n,
+                                 size_t lhs_stride,
+                                 size_t rhs_stride,
+                                 bool rhs_transposed)
+{
+  // A column major block reads as its own transpose in row major order
+  auto trans = rhs_transposed ? CblasNoTrans : CblasTrans;
+
+  syrk(CblasRowMajor, CblasLower, trans, n, m, 1.0, rhs, rhs_stride, 0.0, lhs, lhs_stride);
+
+#pragma omp parallel for schedule(static)
+  for (int32_t i = 1; i < n; ++i)
+    for (int32_t j = 0; j < i; ++j) lhs[j * lhs_stride + i] = lhs[i * lhs_stride + j];
+}
+
+template <>
+struct GramImplBody<VariantKind::OMP, LegateTypeCode::FLOAT_LT> {
+  template <typename... Args>
+  void operator()(Args&&... args)
+  {
+    gram_template(cblas_ssyrk, std::forward<Args>(args)...);
+  }
+};
+
+template <>
+struct GramImplBody<VariantKind::OMP, LegateTypeCode::DOUBLE_LT> {
+  template <typename... Args>
+  void operator()(Args&&... args)
+  {
+    gram_template(cblas_dsyrk, std::forward<Args>(args)...);
+  }
+};
+
+/*static*/ void GramTask::omp_variant(TaskContext& context)
+{
+  BlasThreads blas_threads(omp_get_max_threads());
+  gram_template<VariantKind::OMP>(context);
+}
+
+}  // namespace cunumeric
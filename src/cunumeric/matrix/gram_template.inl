@@ -0,0 +1,88 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <VariantKind KIND, LegateTypeCode CODE>
+struct GramImplBody;
+
+template <LegateTypeCode CODE>
+struct support_gram : std::false_type {
+};
+template <>
+struct support_gram<LegateTypeCode::DOUBLE_LT> : std::true_type {
+};
+template <>
+struct support_gram<LegateTypeCode::FLOAT_LT> : std::true_type {
+};
+
+// Every point task adds the Gram matrix X^T X of its row block X of the matrix to the
+// output, which is reduced across the blocks. The product is symmetric, so SYRK computes
+// its lower triangle in the row major sense and the upper triangle is mirrored from it.
+template <VariantKind KIND>
+struct GramImpl {
+  template <LegateTypeCode CODE, std::enable_if_t<support_gram<CODE>::value>* = nullptr>
+  void operator()(Array& lhs_array, Array& rhs_array) const
+  {
+    using VAL = legate_type_of<CODE>;
+
+    auto lhs_shape = lhs_array.shape<2>();
+    auto rhs_shape = rhs_array.shape<2>();
+
+    if (lhs_shape.empty() || rhs_shape.empty()) return;
+
+    size_t lhs_strides[2];
+    size_t rhs_strides[2];
+
+    auto lhs =
+      lhs_array.reduce_accessor<SumReduction<VAL>, true, 2>(lhs_shape).ptr(lhs_shape, lhs_strides);
+    auto rhs = rhs_array.read_accessor<VAL, 2>(rhs_shape).ptr(rhs_shape, rhs_strides);
+
+    auto m = static_cast<int32_t>(rhs_shape.hi[0] - rhs_shape.lo[0] + 1);
+    auto n = static_cast<int32_t>(rhs_shape.hi[1] - rhs_shape.lo[1] + 1);
+    assert(lhs_shape.hi[0] - lhs_shape.lo[0] + 1 == n);
+    assert(lhs_shape.hi[1] - lhs_shape.lo[1] + 1 == n);
+
+    auto lhs_stride     = std::max(lhs_strides[0], lhs_strides[1]);
+    auto rhs_stride     = std::max(rhs_strides[0], rhs_strides[1]);
+    auto rhs_transposed = (rhs_strides[0] != rhs_strides[1]) ? (rhs_strides[1] == rhs_stride)
+                                                             : (rhs_stride != n);
+
+    GramImplBody<KIND, CODE>()(lhs, rhs, m, n, lhs_stride, rhs_stride, rhs_transposed);
+  }
+
+  template <LegateTypeCode CODE, std::enable_if_t<!support_gram<CODE>::value>* = nullptr>
+  void operator()(Array& lhs_array, Array& rhs_array) const
+  {
+    assert(false);
+  }
+};
+
+template <VariantKind KIND>
+static void gram_template(TaskContext& context)
+{
+  auto& lhs = context.reductions()[0];
+  auto& rhs = context.inputs()[0];
+
+  cunumeric::type_dispatch(lhs.code(), GramImpl<KIND>{}, lhs, rhs);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,109 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <type_traits>
+
+#include <cblas.h>
+
+#include "cunumeric/matrix/util.h"
+
+namespace cunumeric {
+
+namespace detail {
+
+// Panel sizes of the blocked half precision product. A row panel of rhs1 and a column panel
+// of rhs2 are converted to float at a time, which keeps the scratch space bounded by the
+// panels instead of the whole operands.
+static constexpr size_t HALF_GEMM_ROWS  = 256;
+static constexpr size_t HALF_GEMM_DEPTH = 256;
+
+// Computes lhs = rhs1 * rhs2 on half precision operands with float32 accumulation. OUT is
+// either float or __half; a half output is accumulated in a float row panel first and
+// rounded once. The conversion functions are the sequential or OpenMP helpers from util.h.
+template <typename OUT, typename ToFloat, typename ToHalf>
+void blocked_half_gemm(size_t m,
+                       size_t n,
+                       size_t k,
+                       OUT* lhs,
+                       const __half* rhs1,
+                       const __half* rhs2,
+                       size_t lhs_stride,
+                       size_t rhs1_stride,
+                       size_t rhs2_stride,
+                       bool rhs1_transposed,
+                       bool rhs2_transposed,
+                       ToFloat to_float,
+                       ToHalf to_half)
+{
+  constexpr bool HALF_OUTPUT = std::is_same<OUT, __half>::value;
+
+  const size_t rows  = std::min(m, HALF_GEMM_ROWS);
+  const size_t depth = std::min(k, HALF_GEMM_DEPTH);
+
+  auto rhs1_panel = allocate_buffer(rows * depth);
+  auto rhs2_panel = allocate_buffer(depth * n);
+  auto lhs_panel  = HALF_OUTPUT ? allocate_buffer(rows * n) : nullptr;
+
+  for (size_t row = 0; row < m; row += rows) {
+    const size_t mb = std::min(rows, m - row);
+
+    float* out;
+    size_t out_stride;
+    if constexpr (HALF_OUTPUT) {
+      out        = lhs_panel;
+      out_stride = n;
+    } else {
+      out        = lhs + row * lhs_stride;
+      out_stride = lhs_stride;
+    }
+
+    for (size_t col = 0; col < k; col += depth) {
+      const size_t kb = std::min(depth, k - col);
+
+      if (rhs1_transposed)
+        to_float(rhs1_panel, rhs1 + col * rhs1_stride + row, kb, mb, rhs1_stride);
+      else
+        to_float(rhs1_panel, rhs1 + row * rhs1_stride + col, mb, kb, rhs1_stride);
+
+      if (rhs2_transposed)
+        to_float(rhs2_panel, rhs2 + col, n, kb, rhs2_stride);
+      else
+        to_float(rhs2_panel, rhs2 + col * rhs2_stride, kb, n, rhs2_stride);
+
+      cblas_sgemm(CblasRowMajor,
+                  rhs1_transposed ? CblasTrans : CblasNoTrans,
+                  rhs2_transposed ? CblasTrans : CblasNoTrans,
+                  mb,
+                  n,
+                  kb,
+                  1,
+                  rhs1_panel,
+                  rhs1_transposed ? mb : kb,
+                  rhs2_panel,
+                  rhs2_transposed ? kb : n,
+                  col == 0 ? 0 : 1,
+                  out,
+                  out_stride);
+    }
+
+    if constexpr (HALF_OUTPUT) to_half(lhs + row * lhs_stride, lhs_panel, mb, n, lhs_stride);
+  }
+}
+
+}  // namespace detail
+
+}  // namespace cunumeric
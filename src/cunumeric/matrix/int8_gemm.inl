@@ -0,0 +1,104 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <cstdint>
+
+#include "cunumeric/matrix/util.h"
+
+namespace cunumeric {
+
+namespace detail {
+
+// Panel sizes of the blocked 8-bit integer product. The panels are packed so that the rows
+// of rhs1 and the columns of rhs2 run contiguously along k, which lets the compiler turn the
+// inner dot products into widening multiply-adds (vpmaddwd, or vpdpbusd with VNNI).
+static constexpr size_t INT8_GEMM_ROWS  = 64;
+static constexpr size_t INT8_GEMM_DEPTH = 512;
+
+template <typename VAL>
+VAL* allocate_panel(size_t size)
+{
+  Legion::Rect<1> bounds(0, size - 1);
+  Legion::DeferredBuffer<VAL, 1> buffer(Legion::Memory::Kind::SYSTEM_MEM, bounds);
+  return buffer.ptr(0);
+}
+
+template <typename VAL>
+int32_t dot_int8(const VAL* a, const VAL* b, size_t k)
+{
+  int32_t acc = 0;
+  for (size_t p = 0; p < k; ++p) acc += static_cast<int32_t>(a[p]) * static_cast<int32_t>(b[p]);
+  return acc;
+}
+
+// Computes lhs = rhs1 * rhs2 on int8 or uint8 operands with int32 accumulation and output.
+// ForEach runs body(i) for every i below its count, either sequentially or across the
+// OpenMP threads.
+template <typename VAL, typename ForEach>
+void blocked_int8_gemm(size_t m,
+                       size_t n,
+                       size_t k,
+                       int32_t* lhs,
+                       const VAL* rhs1,
+                       const VAL* rhs2,
+                       size_t lhs_stride,
+                       size_t rhs1_stride,
+                       size_t rhs2_stride,
+                       bool rhs1_transposed,
+                       bool rhs2_transposed,
+                       ForEach for_each)
+{
+  const size_t rows  = std::min(m, INT8_GEMM_ROWS);
+  const size_t depth = std::min(k, INT8_GEMM_DEPTH);
+
+  auto rhs1_panel = allocate_panel<VAL>(m * depth);
+  auto rhs2_panel = allocate_panel<VAL>(n * depth);
+
+  for (size_t col = 0; col < k; col += depth) {
+    const size_t kb = std::min(depth, k - col);
+
+    for_each(m, [&](size_t i) {
+      for (size_t p = 0; p < kb; ++p)
+        rhs1_panel[i * kb + p] = rhs1_transposed ? rhs1[(col + p) * rhs1_stride + i]
+                                                 : rhs1[i * rhs1_stride + col + p];
+    });
+    for_each(n, [&](size_t j) {
+      for (size_t p = 0; p < kb; ++p)
+        rhs2_panel[j * kb + p] = rhs2_transposed ? rhs2[j * rhs2_stride + col + p]
+                                                 : rhs2[(col + p) * rhs2_stride + j];
+    });
+
+    // Each block of rows is multiplied against the whole rhs2 panel, which stays in cache
+    const size_t blocks = (m + rows - 1) / rows;
+    for_each(blocks, [&](size_t block) {
+      const size_t lo = block * rows;
+      const size_t hi = std::min(m, lo + rows);
+      for (size_t i = lo; i < hi; ++i) {
+        const VAL* a = rhs1_panel + i * kb;
+        int32_t* out = lhs + i * lhs_stride;
+        for (size_t j = 0; j < n; ++j) {
+          const int32_t acc = dot_int8(a, rhs2_panel + j * kb, kb);
+          out[j]            = col == 0 ? acc : out[j] + acc;
+        }
+      }
+    });
+  }
+}
+
+}  // namespace detail
+
+}  // namespace cunumeric
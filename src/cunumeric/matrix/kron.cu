@@ -0,0 +1,65 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/matrix/kron.h"
+#include "cunumeric/matrix/kron_template.inl"
+
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+
+template <typename VAL, int32_t DIM>
+__global__ static void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  kron_kernel(const AccessorWO<VAL, DIM> lhs,
+              const AccessorRO<VAL, DIM> rhs1,
+              const AccessorRO<VAL, DIM> rhs2,
+              const Rect<DIM> rect,
+              const Pitches<DIM - 1> pitches,
+              const size_t volume,
+              const Point<DIM> rhs2_strides)
+{
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x;
+  for (size_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < volume; idx += stride) {
+    const auto point = pitches.unflatten(idx, rect.lo);
+    lhs[point] =
+      rhs1[get_kron_point(point, rhs2_strides)] * rhs2[get_tile_point(point, rhs2_strides)];
+  }
+}
+
+template <typename VAL, int32_t DIM>
+struct KronImplBody<VariantKind::GPU, VAL, DIM> {
+  void operator()(const AccessorWO<VAL, DIM>& lhs,
+                  const AccessorRO<VAL, DIM>& rhs1,
+                  const AccessorRO<VAL, DIM>& rhs2,
+                  const Rect<DIM>& rect,
+                  const Pitches<DIM - 1>& pitches,
+                  size_t volume,
+                  const Point<DIM>& rhs2_strides) const
+  {
+    auto stream = get_cached_stream();
+    kron_kernel<VAL, DIM><<<grid_stride_blocks<1>(volume), THREADS_PER_BLOCK, 0, stream>>>(
+      lhs, rhs1, rhs2, rect, pitches, volume, rhs2_strides);
+  }
+};
+
+/*static*/ void KronTask::gpu_variant(TaskContext& context)
+{
+  kron_template<VariantKind::GPU>(context);
+}
+
+}  // namespace cunumeric
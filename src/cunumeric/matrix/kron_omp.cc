@@ -0,0 +1,49 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/matrix/kron.h"
+#include "cunumeric/matrix/kron_template.inl"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <typename VAL, int32_t DIM>
+struct KronImplBody<VariantKind::OMP, VAL, DIM> {
+  void operator()(const AccessorWO<VAL, DIM>& lhs,
+                  const AccessorRO<VAL, DIM>& rhs1,
+                  const AccessorRO<VAL, DIM>& rhs2,
+                  const Rect<DIM>& rect,
+                  const Pitches<DIM - 1>& pitches,
+                  size_t volume,
+                  const Point<DIM>& rhs2_strides) const
+  {
+#pragma omp parallel for schedule(static)
+    for (size_t idx = 0; idx < volume; ++idx) {
+      const auto point = pitches.unflatten(idx, rect.lo);
+      lhs[point] =
+        rhs1[get_kron_point(point, rhs2_strides)] * rhs2[get_tile_point(point, rhs2_strides)];
+    }
+  }
+};
+
+/*static*/ void KronTask::omp_variant(TaskContext& context)
+{
+  kron_template<VariantKind::OMP>(context);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,70 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/matrix/tile_template.inl"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+// The Kronecker product is made of blocks shaped like rhs2, one for every element of rhs1,
+// so an output point lies in the block of rhs1 at its quotient by the extents of rhs2 and
+// reads rhs2 at the remainder, which is the tile indexing of rhs2 over the output
+template <int32_t DIM>
+__CUDA_HD__ inline Point<DIM> get_kron_point(const Point<DIM>& point, const Point<DIM>& strides)
+{
+  Point<DIM> result;
+  for (int32_t dim = 0; dim < DIM; ++dim) result[dim] = point[dim] / strides[dim];
+  return result;
+}
+
+template <VariantKind KIND, typename VAL, int32_t DIM>
+struct KronImplBody;
+
+template <VariantKind KIND>
+struct KronImpl {
+  template <LegateTypeCode CODE, int32_t DIM>
+  void operator()(KronArgs& args) const
+  {
+    using VAL = legate_type_of<CODE>;
+
+    const auto rect = args.lhs.shape<DIM>();
+    Pitches<DIM - 1> pitches;
+    auto volume = pitches.flatten(rect);
+
+    if (volume == 0) return;
+
+    // Both operands go whole to every point task
+    const auto rhs2_rect    = args.rhs2.shape<DIM>();
+    Point<DIM> rhs2_strides = rhs2_rect.hi - rhs2_rect.lo + Point<DIM>::ONES();
+
+    auto lhs  = args.lhs.write_accessor<VAL, DIM>(rect);
+    auto rhs1 = args.rhs1.read_accessor<VAL, DIM>();
+    auto rhs2 = args.rhs2.read_accessor<VAL, DIM>();
+
+    KronImplBody<KIND, VAL, DIM>{}(lhs, rhs1, rhs2, rect, pitches, volume, rhs2_strides);
+  }
+};
+
+template <VariantKind KIND>
+static void kron_template(TaskContext& context)
+{
+  KronArgs args{context.outputs()[0], context.inputs()[0], context.inputs()[1]};
+  double_dispatch(args.lhs.dim(), args.lhs.code(), KronImpl<KIND>{}, args);
+}
+
+}  // namespace cunumeric
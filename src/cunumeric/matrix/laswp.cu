@@ -0,0 +1,75 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/matrix/laswp.h"
+#include "cunumeric/matrix/laswp_template.inl"
+
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <typename VAL>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  laswp_kernel(size_t num_cols,
+               AccessorRW<VAL, 2> array,
+               const int32_t* pivots,
+               Point<2> lo,
+               int32_t first,
+               int32_t num_pivots,
+               int32_t offset)
+{
+  const size_t idx_col = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx_col >= num_cols) return;
+  const coord_t col = lo[1] + idx_col;
+  for (int32_t idx = 0; idx < num_pivots; ++idx) {
+    const coord_t row   = first + idx;
+    const coord_t pivot = pivots[idx] - 1 - offset;
+    if (row == pivot) continue;
+    VAL tmp                     = array[Point<2>(row, col)];
+    array[Point<2>(row, col)]   = array[Point<2>(pivot, col)];
+    array[Point<2>(pivot, col)] = tmp;
+  }
+}
+
+template <LegateTypeCode CODE>
+struct LaswpImplBody<VariantKind::GPU, CODE> {
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(AccessorRW<VAL, 2> array,
+                  const int32_t* pivots,
+                  const Rect<2>& rect,
+                  int32_t first,
+                  int32_t num_pivots,
+                  int32_t offset) const
+  {
+    // One thread per column, as the interchanges within a column must happen in order
+    const size_t num_cols = rect.hi[1] - rect.lo[1] + 1;
+    const size_t blocks   = (num_cols + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+    auto stream           = get_cached_stream();
+    laswp_kernel<VAL><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+      num_cols, array, pivots, rect.lo, first, num_pivots, offset);
+  }
+};
+
+/*static*/ void LaswpTask::gpu_variant(TaskContext& context)
+{
+  laswp_template<VariantKind::GPU>(context);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,53 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/matrix/laswp.h"
+#include "cunumeric/matrix/laswp_template.inl"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <LegateTypeCode CODE>
+struct LaswpImplBody<VariantKind::OMP, CODE> {
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(AccessorRW<VAL, 2> array,
+                  const int32_t* pivots,
+                  const Rect<2>& rect,
+                  int32_t first,
+                  int32_t num_pivots,
+                  int32_t offset) const
+  {
+    // Columns are independent of each other, but the interchanges within a column
+    // must happen in order
+#pragma omp parallel for schedule(static)
+    for (coord_t col = rect.lo[1]; col <= rect.hi[1]; ++col)
+      for (int32_t idx = 0; idx < num_pivots; ++idx) {
+        const coord_t row   = first + idx;
+        const coord_t pivot = pivots[idx] - 1 - offset;
+        if (row != pivot) std::swap(array[Point<2>(row, col)], array[Point<2>(pivot, col)]);
+      }
+  }
+};
+
+/*static*/ void LaswpTask::omp_variant(TaskContext& context)
+{
+  laswp_template<VariantKind::OMP>(context);
+}
+
+}  // namespace cunumeric
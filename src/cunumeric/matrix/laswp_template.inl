@@ -0,0 +1,60 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <VariantKind KIND, LegateTypeCode CODE>
+struct LaswpImplBody;
+
+template <VariantKind KIND>
+struct LaswpImpl {
+  template <LegateTypeCode CODE>
+  void operator()(Array& array, Array& pivots_array, int32_t offset) const
+  {
+    using VAL = legate_type_of<CODE>;
+
+    auto rect         = array.shape<2>();
+    auto pivots_shape = pivots_array.shape<1>();
+
+    if (rect.empty() || pivots_shape.empty()) return;
+
+    auto arr    = array.read_write_accessor<VAL, 2>(rect);
+    auto pivots = pivots_array.read_accessor<int32_t, 1>(pivots_shape).ptr(pivots_shape);
+
+    auto first      = static_cast<int32_t>(pivots_shape.lo[0]);
+    auto num_pivots = static_cast<int32_t>(pivots_shape.volume());
+
+    LaswpImplBody<KIND, CODE>()(arr, pivots, rect, first, num_pivots, offset);
+  }
+};
+
+// Applies the row interchanges of a GETRF on one column panel to another column
+// block of the same rows, in the order the factorization made them. Row first + idx
+// of the array is swapped with row pivots[idx] - 1 - offset, as the pivots name rows
+// of the whole matrix, counting from 1, and the array starts at row offset.
+template <VariantKind KIND>
+static void laswp_template(TaskContext& context)
+{
+  auto& array  = context.outputs()[0];
+  auto& pivots = context.inputs()[1];
+  auto offset  = context.scalars()[0].value<int32_t>();
+  cunumeric::type_dispatch(array.code(), LaswpImpl<KIND>{}, array, pivots, offset);
+}
+
+}  // namespace cunumeric
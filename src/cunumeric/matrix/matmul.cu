@@ -114,10 +114,11 @@ struct MatMulImplBody<VariantKind::GPU, LegateTypeCode::DOUBLE_LT> {
 
 template <>
 struct MatMulImplBody<VariantKind::GPU, LegateTypeCode::HALF_LT> {
+  template <typename OUT>
   void operator()(size_t m,
                   size_t n,
                   size_t k,
-                  float* lhs,
+                  OUT* lhs,
                   const __half* rhs1,
                   const __half* rhs2,
                   size_t lhs_stride,
@@ -137,25 +138,196 @@ struct MatMulImplBody<VariantKind::GPU, LegateTypeCode::HALF_LT> {
     // cublas is dumb and doesn't support row-major, so reverse the matrix
     // order to help cublas think things are column-major
     // effectively we get NxM = NxK * KxM
-    // Use the extended sgemm interface so we can use tensor cores
-    // if they are available for this matrix shape and GPU
-    CHECK_CUBLAS(cublasSgemmEx(cublas_handle,
-                               rhs2_transposed ? CUBLAS_OP_T : CUBLAS_OP_N,
-                               rhs1_transposed ? CUBLAS_OP_T : CUBLAS_OP_N,
-                               n,
-                               m,
-                               k,
-                               &alpha,
-                               rhs2,
-                               CUDA_R_16F,
-                               rhs2_stride,
-                               rhs1,
-                               CUDA_R_16F,
-                               rhs1_stride,
-                               &beta,
-                               lhs,
-                               CUDA_R_32F,
-                               lhs_stride));
+    // The products always accumulate in float on tensor cores, and the output
+    // is rounded to half only when the caller asked for a half result
+    CHECK_CUBLAS(cublasGemmEx(cublas_handle,
+                              rhs2_transposed ? CUBLAS_OP_T : CUBLAS_OP_N,
+                              rhs1_transposed ? CUBLAS_OP_T : CUBLAS_OP_N,
+                              n,
+                              m,
+                              k,
+                              &alpha,
+                              rhs2,
+                              CUDA_R_16F,
+                              rhs2_stride,
+                              rhs1,
+                              CUDA_R_16F,
+                              rhs1_stride,
+                              &beta,
+                              lhs,
+                              std::is_same<OUT, __half>::value ? CUDA_R_16F : CUDA_R_32F,
+                              lhs_stride,
+                              CUBLAS_COMPUTE_32F,
+                              CUBLAS_GEMM_DEFAULT_TENSOR_OP));
+  }
+};
+
+// Tile of the fallback 8-bit integer product, for the operands cuBLAS can't take
+#define INT8_GEMM_TILE 16
+
+template <typename VAL>
+__global__ static void __launch_bounds__((INT8_GEMM_TILE * INT8_GEMM_TILE), MIN_CTAS_PER_SM)
+  int8_gemm_kernel(size_t m,
+                   size_t n,
+                   size_t k,
+                   int32_t* lhs,
+                   const VAL* rhs1,
+                   const VAL* rhs2,
+                   size_t lhs_stride,
+                   size_t rhs1_stride,
+                   size_t rhs2_stride,
+                   bool rhs1_transposed,
+                   bool rhs2_transposed)
+{
+  __shared__ int32_t rhs1_tile[INT8_GEMM_TILE][INT8_GEMM_TILE + 1];
+  __shared__ int32_t rhs2_tile[INT8_GEMM_TILE][INT8_GEMM_TILE + 1];
+
+  const size_t row = blockIdx.y * INT8_GEMM_TILE + threadIdx.y;
+  const size_t col = blockIdx.x * INT8_GEMM_TILE + threadIdx.x;
+
+  int32_t acc = 0;
+  for (size_t depth = 0; depth < k; depth += INT8_GEMM_TILE) {
+    const size_t p1 = depth + threadIdx.x;
+    const size_t p2 = depth + threadIdx.y;
+    rhs1_tile[threadIdx.y][threadIdx.x] =
+      (row < m && p1 < k)
+        ? rhs1[rhs1_transposed ? p1 * rhs1_stride + row : row * rhs1_stride + p1]
+        : 0;
+    rhs2_tile[threadIdx.y][threadIdx.x] =
+      (p2 < k && col < n)
+        ? rhs2[rhs2_transposed ? col * rhs2_stride + p2 : p2 * rhs2_stride + col]
+        : 0;
+    __syncthreads();
+#pragma unroll
+    for (int32_t p = 0; p < INT8_GEMM_TILE; ++p)
+      acc += rhs1_tile[threadIdx.y][p] * rhs2_tile[p][threadIdx.x];
+    __syncthreads();
+  }
+  if (row < m && col < n) lhs[row * lhs_stride + col] = acc;
+}
+
+template <typename VAL>
+static void int8_gemm(size_t m,
+                      size_t n,
+                      size_t k,
+                      int32_t* lhs,
+                      const VAL* rhs1,
+                      const VAL* rhs2,
+                      size_t lhs_stride,
+                      size_t rhs1_stride,
+                      size_t rhs2_stride,
+                      bool rhs1_transposed,
+                      bool rhs2_transposed)
+{
+  auto task_stream = get_cached_stream();
+
+  // cuBLAS multiplies signed 8-bit operands on the integer tensor cores when the leading
+  // dimensions and the pointers are multiples of four bytes; anything else goes to the kernel
+  const bool use_cublas = std::is_same<VAL, int8_t>::value && rhs1_stride % 4 == 0 &&
+                          rhs2_stride % 4 == 0 && lhs_stride % 4 == 0 &&
+                          reinterpret_cast<uintptr_t>(rhs1) % 4 == 0 &&
+                          reinterpret_cast<uintptr_t>(rhs2) % 4 == 0;
+  if (use_cublas) {
+    auto cublas_handle = get_cublas();
+    // Update the stream because the CUDA hijack can't see inside cuBLAS
+    CHECK_CUBLAS(cublasSetStream(cublas_handle, task_stream));
+
+    const int32_t alpha = 1;
+    const int32_t beta  = 0;
+
+    // Same column-major reversal as the floating point products: NxM = NxK * KxM
+    CHECK_CUBLAS(cublasGemmEx(cublas_handle,
+                              rhs2_transposed ? CUBLAS_OP_T : CUBLAS_OP_N,
+                              rhs1_transposed ? CUBLAS_OP_T : CUBLAS_OP_N,
+                              n,
+                              m,
+                              k,
+                              &alpha,
+                              rhs2,
+                              CUDA_R_8I,
+                              rhs2_stride,
+                              rhs1,
+                              CUDA_R_8I,
+                              rhs1_stride,
+                              &beta,
+                              lhs,
+                              CUDA_R_32I,
+                              lhs_stride,
+                              CUBLAS_COMPUTE_32I,
+                              CUBLAS_GEMM_DEFAULT_TENSOR_OP));
+    return;
+  }
+
+  const dim3 blocks((n + INT8_GEMM_TILE - 1) / INT8_GEMM_TILE,
+                    (m + INT8_GEMM_TILE - 1) / INT8_GEMM_TILE,
+                    1);
+  const dim3 threads(INT8_GEMM_TILE, INT8_GEMM_TILE, 1);
+  int8_gemm_kernel<VAL><<<blocks, threads, 0, task_stream>>>(m,
+                                                             n,
+                                                             k,
+                                                             lhs,
+                                                             rhs1,
+                                                             rhs2,
+                                                             lhs_stride,
+                                                             rhs1_stride,
+                                                             rhs2_stride,
+                                                             rhs1_transposed,
+                                                             rhs2_transposed);
+}
+
+template <>
+struct MatMulImplBody<VariantKind::GPU, LegateTypeCode::INT8_LT> {
+  void operator()(size_t m,
+                  size_t n,
+                  size_t k,
+                  int32_t* lhs,
+                  const int8_t* rhs1,
+                  const int8_t* rhs2,
+                  size_t lhs_stride,
+                  size_t rhs1_stride,
+                  size_t rhs2_stride,
+                  bool rhs1_transposed,
+                  bool rhs2_transposed)
+  {
+    int8_gemm(m,
+              n,
+              k,
+              lhs,
+              rhs1,
+              rhs2,
+              lhs_stride,
+              rhs1_stride,
+              rhs2_stride,
+              rhs1_transposed,
+              rhs2_transposed);
+  }
+};
+
+template <>
+struct MatMulImplBody<VariantKind::GPU, LegateTypeCode::UINT8_LT> {
+  void operator()(size_t m,
+                  size_t n,
+                  size_t k,
+                  int32_t* lhs,
+                  const uint8_t* rhs1,
+                  const uint8_t* rhs2,
+                  size_t lhs_stride,
+                  size_t rhs1_stride,
+                  size_t rhs2_stride,
+                  bool rhs1_transposed,
+                  bool rhs2_transposed)
+  {
+    int8_gemm(m,
+              n,
+              k,
+              lhs,
+              rhs1,
+              rhs2,
+              lhs_stride,
+              rhs1_stride,
+              rhs2_stride,
+              rhs1_transposed,
+              rhs2_transposed);
   }
 };
 
@@ -26,6 +26,32 @@ struct MatMulArgs {
   const Array& rhs2;
 };
 
+// Matrix products accumulate half precision inputs in single precision and 8-bit integer
+// inputs in 32-bit integers
+template <LegateTypeCode CODE>
+struct support_matmul : std::false_type {
+};
+template <>
+struct support_matmul<LegateTypeCode::DOUBLE_LT> : std::true_type {
+  using ACC_TYPE = double;
+};
+template <>
+struct support_matmul<LegateTypeCode::FLOAT_LT> : std::true_type {
+  using ACC_TYPE = float;
+};
+template <>
+struct support_matmul<LegateTypeCode::HALF_LT> : std::true_type {
+  using ACC_TYPE = float;
+};
+template <>
+struct support_matmul<LegateTypeCode::INT8_LT> : std::true_type {
+  using ACC_TYPE = int32_t;
+};
+template <>
+struct support_matmul<LegateTypeCode::UINT8_LT> : std::true_type {
+  using ACC_TYPE = int32_t;
+};
+
 class MatMulTask : public CuNumericTask<MatMulTask> {
  public:
   static const int TASK_ID = CUNUMERIC_MATMUL;
@@ -91,10 +91,11 @@ struct MatMulImplBody<VariantKind::OMP, LegateTypeCode::DOUBLE_LT> {
 
 template <>
 struct MatMulImplBody<VariantKind::OMP, LegateTypeCode::HALF_LT> {
+  template <typename OUT>
   void operator()(size_t m,
                   size_t n,
                   size_t k,
-                  float* lhs,
+                  OUT* lhs,
                   const __half* rhs1,
                   const __half* rhs2,
                   size_t lhs_stride,
@@ -103,39 +104,79 @@ struct MatMulImplBody<VariantKind::OMP, LegateTypeCode::HALF_LT> {
                   bool rhs1_transposed,
                   bool rhs2_transposed)
   {
-    auto rhs1_copy = allocate_buffer(m * k);
-    auto rhs2_copy = allocate_buffer(k * n);
-
-    if (rhs1_transposed)
-      half_matrix_to_float_omp(rhs1_copy, rhs1, k, m, rhs1_stride);
-    else
-      half_matrix_to_float_omp(rhs1_copy, rhs1, m, k, rhs1_stride);
+    half_gemm_omp(m,
+                  n,
+                  k,
+                  lhs,
+                  rhs1,
+                  rhs2,
+                  lhs_stride,
+                  rhs1_stride,
+                  rhs2_stride,
+                  rhs1_transposed,
+                  rhs2_transposed);
+  }
+};
 
-    if (rhs2_transposed)
-      half_matrix_to_float_omp(rhs2_copy, rhs2, n, k, rhs2_stride);
-    else
-      half_matrix_to_float_omp(rhs2_copy, rhs2, k, n, rhs2_stride);
+template <>
+struct MatMulImplBody<VariantKind::OMP, LegateTypeCode::INT8_LT> {
+  void operator()(size_t m,
+                  size_t n,
+                  size_t k,
+                  int32_t* lhs,
+                  const int8_t* rhs1,
+                  const int8_t* rhs2,
+                  size_t lhs_stride,
+                  size_t rhs1_stride,
+                  size_t rhs2_stride,
+                  bool rhs1_transposed,
+                  bool rhs2_transposed)
+  {
+    int8_gemm_omp(m,
+                  n,
+                  k,
+                  lhs,
+                  rhs1,
+                  rhs2,
+                  lhs_stride,
+                  rhs1_stride,
+                  rhs2_stride,
+                  rhs1_transposed,
+                  rhs2_transposed);
+  }
+};
 
-    cblas_sgemm(CblasRowMajor,
-                rhs1_transposed ? CblasTrans : CblasNoTrans,
-                rhs2_transposed ? CblasTrans : CblasNoTrans,
-                m,
-                n,
-                k,
-                1,
-                rhs1_copy,
-                rhs1_transposed ? m : k,
-                rhs2_copy,
-                rhs2_transposed ? k : n,
-                0,
-                lhs,
-                lhs_stride);
+template <>
+struct MatMulImplBody<VariantKind::OMP, LegateTypeCode::UINT8_LT> {
+  void operator()(size_t m,
+                  size_t n,
+                  size_t k,
+                  int32_t* lhs,
+                  const uint8_t* rhs1,
+                  const uint8_t* rhs2,
+                  size_t lhs_stride,
+                  size_t rhs1_stride,
+                  size_t rhs2_stride,
+                  bool rhs1_transposed,
+                  bool rhs2_transposed)
+  {
+    int8_gemm_omp(m,
+                  n,
+                  k,
+                  lhs,
+                  rhs1,
+                  rhs2,
+                  lhs_stride,
+                  rhs1_stride,
+                  rhs2_stride,
+                  rhs1_transposed,
+                  rhs2_transposed);
   }
 };
 
 /*static*/ void MatMulTask::omp_variant(TaskContext& context)
 {
-  openblas_set_num_threads(omp_get_max_threads());
+  BlasThreads blas_threads(omp_get_max_threads());
   matmul_template<VariantKind::OMP>(context);
 }
 
@@ -14,6 +14,8 @@
  *
  */
 
+#include "cunumeric/roofline.h"
+
 namespace cunumeric {
 
 using namespace Legion;
@@ -22,29 +24,25 @@ using namespace legate;
 template <VariantKind KIND, LegateTypeCode CODE>
 struct MatMulImplBody;
 
-template <LegateTypeCode CODE>
-struct support_matmul : std::false_type {
-};
-template <>
-struct support_matmul<LegateTypeCode::DOUBLE_LT> : std::true_type {
-  using ACC_TYPE = double;
-};
-template <>
-struct support_matmul<LegateTypeCode::FLOAT_LT> : std::true_type {
-  using ACC_TYPE = float;
-};
-template <>
-struct support_matmul<LegateTypeCode::HALF_LT> : std::true_type {
-  using ACC_TYPE = float;
-};
-
 template <VariantKind KIND>
 struct MatMulImpl {
   template <LegateTypeCode CODE, std::enable_if_t<support_matmul<CODE>::value>* = nullptr>
   void operator()(MatMulArgs& args) const
+  {
+    // Half precision products can write a half output directly, still accumulating in float
+    // inside the GEMM, instead of going through a float temporary
+    if constexpr (CODE == LegateTypeCode::HALF_LT)
+      if (args.lhs.code() == LegateTypeCode::HALF_LT) {
+        matmul<CODE, legate_type_of<CODE>>(args);
+        return;
+      }
+    matmul<CODE, typename support_matmul<CODE>::ACC_TYPE>(args);
+  }
+
+  template <LegateTypeCode CODE, typename ACC>
+  void matmul(MatMulArgs& args) const
   {
     using VAL = legate_type_of<CODE>;
-    using ACC = typename support_matmul<CODE>::ACC_TYPE;
 
     // Note that rhs1 and rhs2 may have different shapes. Here's why: rhs1 and rhs2 are promoted
     // on one of their dimensions, and in case that the promoted dimension is partitioned,
@@ -60,6 +58,12 @@ struct MatMulImpl {
     const auto k = shape.hi[1] - shape.lo[1] + 1;
     const auto n = shape.hi[2] - shape.lo[2] + 1;
 
+    CUNUMERIC_ROOFLINE_SAMPLE("matmul",
+                              0,
+                              KIND,
+                              (m * k + k * n) * sizeof(VAL) + m * n * sizeof(ACC),
+                              2.0 * m * n * k);
+
     size_t lhs_strides[3];
     size_t rhs1_strides[3];
     size_t rhs2_strides[3];
@@ -104,7 +108,7 @@ static void matmul_template(TaskContext& context)
   MatMulArgs args{reductions[0], inputs[0], inputs[1]};
   // Note that we can't dispatch on the lhs's type,
   // as the lhs can have a different type than the rhs'
-  type_dispatch(args.rhs1.code(), MatMulImpl<KIND>{}, args);
+  cunumeric::type_dispatch(args.rhs1.code(), MatMulImpl<KIND>{}, args);
 }
 
 }  // namespace cunumeric
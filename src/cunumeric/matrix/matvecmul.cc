@@ -84,7 +84,7 @@ struct MatVecMulImplBody<VariantKind::CPU, LegateTypeCode::HALF_LT> {
 /*static*/ void MatVecMulTask::cpu_variant(TaskContext& context)
 {
 #ifdef LEGATE_USE_OPENMP
-  openblas_set_num_threads(1);  // make sure this isn't overzealous
+  BlasThreads blas_threads(1);
 #endif
   matvecmul_template<VariantKind::CPU>(context);
 }
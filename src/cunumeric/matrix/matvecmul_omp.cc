@@ -82,7 +82,7 @@ struct MatVecMulImplBody<VariantKind::OMP, LegateTypeCode::HALF_LT> {
 
 /*static*/ void MatVecMulTask::omp_variant(TaskContext& context)
 {
-  openblas_set_num_threads(omp_get_max_threads());
+  BlasThreads blas_threads(omp_get_max_threads());
   matvecmul_template<VariantKind::OMP>(context);
 }
 
@@ -104,7 +104,7 @@ static void matvecmul_template(TaskContext& context)
   MatVecMulArgs args{scalars[0].value<bool>(), reductions[0], inputs[0], inputs[1]};
   // Note that we can't dispatch on the lhs's type,
   // as the lhs can have a different type than the rhs'
-  type_dispatch(args.rhs1.code(), MatVecMulImpl<KIND>{}, args);
+  cunumeric::type_dispatch(args.rhs1.code(), MatVecMulImpl<KIND>{}, args);
 }
 
 }  // namespace cunumeric
@@ -0,0 +1,72 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/matrix/multi_dot.h"
+#include "cunumeric/matrix/multi_dot_template.inl"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <LegateTypeCode CODE>
+struct MultiDotImplBody<VariantKind::CPU, CODE> {
+  using VAL = legate_type_of<CODE>;
+  using ACC = acc_type_of<VAL>;
+
+  void operator()(const MultiDotProducts<VAL, ACC>& products, const Rect<1>& rect, bool dense)
+  {
+    ACC sums[MAX_MULTI_DOTS];
+    ACC values[MAX_MULTI_DOT_OPERANDS];
+    for (int32_t dot = 0; dot < products.num_dots; ++dot)
+      sums[dot] = SumReduction<ACC>::identity;
+
+    if (dense) {
+      const VAL* ptrs[MAX_MULTI_DOT_OPERANDS];
+      for (int32_t idx = 0; idx < products.num_rhs; ++idx)
+        ptrs[idx] = products.rhs[idx].ptr(rect);
+      const size_t volume = rect.volume();
+      for (size_t idx = 0; idx < volume; ++idx) {
+        for (int32_t op = 0; op < products.num_rhs; ++op)
+          values[op] = static_cast<ACC>(ptrs[op][idx]);
+        products.fold(sums, values);
+      }
+    } else {
+      for (coord_t idx = rect.lo[0]; idx <= rect.hi[0]; ++idx) {
+        for (int32_t op = 0; op < products.num_rhs; ++op)
+          values[op] = static_cast<ACC>(products.rhs[op][idx]);
+        products.fold(sums, values);
+      }
+    }
+
+    for (int32_t dot = 0; dot < products.num_dots; ++dot) products.lhs[dot].reduce(0, sums[dot]);
+  }
+};
+
+/*static*/ void MultiDotTask::cpu_variant(TaskContext& context)
+{
+  multi_dot_template<VariantKind::CPU>(context);
+}
+
+namespace  // unnamed
+{
+static void __attribute__((constructor)) register_tasks(void)
+{
+  MultiDotTask::register_variants();
+}
+}  // namespace
+
+}  // namespace cunumeric
@@ -0,0 +1,110 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/matrix/multi_dot.h"
+#include "cunumeric/matrix/multi_dot_template.inl"
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+
+// Every thread folds its elements into one partial sum per product. The blocks publish
+// their partials and the block that comes in last folds them into the outputs, as in
+// device_scalar_reduction, so all of the products take a single kernel launch.
+template <typename VAL, typename ACC>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  multi_dot_kernel(size_t volume,
+                   MultiDotProducts<VAL, ACC> products,
+                   Point<1> origin,
+                   size_t iters,
+                   ACC* partials,
+                   unsigned int* ticket)
+{
+  ACC sums[MAX_MULTI_DOTS];
+  ACC values[MAX_MULTI_DOT_OPERANDS];
+  for (int32_t dot = 0; dot < products.num_dots; ++dot) sums[dot] = SumReduction<ACC>::identity;
+
+  for (size_t idx = 0; idx < iters; idx++) {
+    const size_t offset = (idx * gridDim.x + blockIdx.x) * blockDim.x + threadIdx.x;
+    if (offset < volume) {
+      const auto point = origin + offset;
+      for (int32_t op = 0; op < products.num_rhs; ++op)
+        values[op] = static_cast<ACC>(products.rhs[op][point]);
+      products.fold(sums, values);
+    }
+  }
+
+  for (int32_t dot = 0; dot < products.num_dots; ++dot) {
+    const auto value = block_reduce<SumReduction<ACC>>(sums[dot]);
+    if (threadIdx.x == 0) partials[dot * gridDim.x + blockIdx.x] = value;
+    // block_reduce stages the warp values in shared memory, which the next product reuses
+    __syncthreads();
+  }
+
+  __shared__ bool last_block;
+  if (threadIdx.x == 0) {
+    __threadfence();
+    last_block = atomicAdd(ticket, 1) == gridDim.x - 1;
+  }
+  __syncthreads();
+  if (!last_block) return;
+
+  for (int32_t dot = 0; dot < products.num_dots; ++dot) {
+    auto value = SumReduction<ACC>::identity;
+    for (size_t idx = threadIdx.x; idx < gridDim.x; idx += blockDim.x)
+      SumReduction<ACC>::template fold<true>(value, partials[dot * gridDim.x + idx]);
+    value = block_reduce<SumReduction<ACC>>(value);
+    if (threadIdx.x == 0) products.lhs[dot].reduce(0, value);
+    __syncthreads();
+  }
+}
+
+template <LegateTypeCode CODE>
+struct MultiDotImplBody<VariantKind::GPU, CODE> {
+  using VAL = legate_type_of<CODE>;
+  using ACC = acc_type_of<VAL>;
+
+  void operator()(const MultiDotProducts<VAL, ACC>& products, const Rect<1>& rect, bool dense)
+  {
+    const size_t volume = rect.volume();
+    if (volume == 0) return;
+
+    const size_t blocks   = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+    const size_t num_ctas = std::min<size_t>(blocks, get_max_reduction_ctas());
+    const size_t iters    = (blocks + num_ctas - 1) / num_ctas;
+
+    auto stream = get_cached_stream();
+    ScratchBuffer<ACC> partials(num_ctas * products.num_dots);
+    ScratchBuffer<unsigned int> ticket(1);
+
+    auto kernel = multi_dot_kernel<VAL, ACC>;
+    std::vector<char> key;
+    append_key(key, kernel, volume, products, rect.lo, partials.ptr(0), ticket.ptr(0));
+    launch_captured(key, [&]() {
+      CHECK_CUDA(cudaMemsetAsync(ticket.ptr(0), 0, sizeof(unsigned int), stream));
+      kernel<<<num_ctas, THREADS_PER_BLOCK, 0, stream>>>(
+        volume, products, rect.lo, iters, partials.ptr(0), ticket.ptr(0));
+    });
+  }
+};
+
+/*static*/ void MultiDotTask::gpu_variant(TaskContext& context)
+{
+  multi_dot_template<VariantKind::GPU>(context);
+}
+
+}  // namespace cunumeric
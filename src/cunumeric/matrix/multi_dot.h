@@ -0,0 +1,47 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "cunumeric/cunumeric.h"
+
+namespace cunumeric {
+
+// A launch computes at most this many inner products over at most this many vectors
+constexpr int32_t MAX_MULTI_DOTS         = 4;
+constexpr int32_t MAX_MULTI_DOT_OPERANDS = 2 * MAX_MULTI_DOTS;
+
+struct MultiDotArgs {
+  const std::vector<Array>& lhs;
+  const std::vector<Array>& rhs;
+  legate::Span<const int32_t> pairs;
+};
+
+class MultiDotTask : public CuNumericTask<MultiDotTask> {
+ public:
+  static const int TASK_ID = CUNUMERIC_MULTI_DOT;
+
+ public:
+  static void cpu_variant(legate::TaskContext& context);
+#ifdef LEGATE_USE_OPENMP
+  static void omp_variant(legate::TaskContext& context);
+#endif
+#ifdef LEGATE_USE_CUDA
+  static void gpu_variant(legate::TaskContext& context);
+#endif
+};
+
+}  // namespace cunumeric
@@ -0,0 +1,82 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/matrix/multi_dot.h"
+#include "cunumeric/matrix/multi_dot_template.inl"
+
+#include <omp.h>
+#include <alloca.h>
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <LegateTypeCode CODE>
+struct MultiDotImplBody<VariantKind::OMP, CODE> {
+  using VAL = legate_type_of<CODE>;
+  using ACC = acc_type_of<VAL>;
+
+  void operator()(const MultiDotProducts<VAL, ACC>& products, const Rect<1>& rect, bool dense)
+  {
+    const auto num_dots    = products.num_dots;
+    const auto num_rhs     = products.num_rhs;
+    const auto max_threads = omp_get_max_threads();
+    // Each thread folds into its own row of partial sums, one per product
+    auto locals = static_cast<ACC*>(alloca(max_threads * num_dots * sizeof(ACC)));
+    for (auto idx = 0; idx < max_threads * num_dots; ++idx)
+      locals[idx] = SumReduction<ACC>::identity;
+
+    if (dense) {
+      const VAL* ptrs[MAX_MULTI_DOT_OPERANDS];
+      for (int32_t idx = 0; idx < num_rhs; ++idx) ptrs[idx] = products.rhs[idx].ptr(rect);
+      const size_t volume = rect.volume();
+#pragma omp parallel
+      {
+        auto sums = locals + omp_get_thread_num() * num_dots;
+        ACC values[MAX_MULTI_DOT_OPERANDS];
+#pragma omp for schedule(static)
+        for (size_t idx = 0; idx < volume; ++idx) {
+          for (int32_t op = 0; op < num_rhs; ++op) values[op] = static_cast<ACC>(ptrs[op][idx]);
+          products.fold(sums, values);
+        }
+      }
+    } else {
+#pragma omp parallel
+      {
+        auto sums = locals + omp_get_thread_num() * num_dots;
+        ACC values[MAX_MULTI_DOT_OPERANDS];
+#pragma omp for schedule(static)
+        for (coord_t idx = rect.lo[0]; idx <= rect.hi[0]; ++idx) {
+          for (int32_t op = 0; op < num_rhs; ++op)
+            values[op] = static_cast<ACC>(products.rhs[op][idx]);
+          products.fold(sums, values);
+        }
+      }
+    }
+
+    for (auto thread = 0; thread < max_threads; ++thread)
+      for (int32_t dot = 0; dot < num_dots; ++dot)
+        products.lhs[dot].reduce(0, locals[thread * num_dots + dot]);
+  }
+};
+
+/*static*/ void MultiDotTask::omp_variant(TaskContext& context)
+{
+  multi_dot_template<VariantKind::OMP>(context);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,100 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Shares the accumulation types of the single dot product
+#include "cunumeric/matrix/dot.h"
+#include "cunumeric/matrix/dot_template.inl"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <VariantKind KIND, LegateTypeCode CODE>
+struct MultiDotImplBody;
+
+// The operands of a multi-dot launch, passed by value to the GPU kernel. Every product
+// names its two operands by their positions in rhs, so a vector shared by several
+// products is loaded once per element.
+template <typename VAL, typename ACC>
+struct MultiDotProducts {
+  AccessorRD<SumReduction<ACC>, true, 1> lhs[MAX_MULTI_DOTS];
+  AccessorRO<VAL, 1> rhs[MAX_MULTI_DOT_OPERANDS];
+  int32_t pairs[MAX_MULTI_DOTS][2];
+  int32_t num_dots;
+  int32_t num_rhs;
+
+  // Folds the products of the loaded operand values into one partial sum per product
+  __CUDA_HD__ inline void fold(ACC* sums, const ACC* values) const
+  {
+    for (int32_t dot = 0; dot < num_dots; ++dot)
+      SumReduction<ACC>::template fold<true>(sums[dot],
+                                             values[pairs[dot][0]] * values[pairs[dot][1]]);
+  }
+};
+
+template <VariantKind KIND>
+struct MultiDotImpl {
+  template <LegateTypeCode CODE>
+  void operator()(MultiDotArgs& args) const
+  {
+    using VAL = legate_type_of<CODE>;
+    using ACC = acc_type_of<VAL>;
+
+    const int32_t num_dots = args.lhs.size();
+    const int32_t num_rhs  = args.rhs.size();
+    assert(num_dots > 0 && num_dots <= MAX_MULTI_DOTS);
+    assert(num_rhs > 0 && num_rhs <= MAX_MULTI_DOT_OPERANDS);
+    assert(args.pairs.size() == 2 * num_dots);
+
+    auto rect = args.rhs[0].shape<1>();
+
+    MultiDotProducts<VAL, ACC> products;
+    products.num_dots = num_dots;
+    products.num_rhs  = num_rhs;
+    for (int32_t dot = 0; dot < num_dots; ++dot) {
+      products.lhs[dot]      = args.lhs[dot].reduce_accessor<SumReduction<ACC>, true, 1>();
+      products.pairs[dot][0] = args.pairs[2 * dot];
+      products.pairs[dot][1] = args.pairs[2 * dot + 1];
+    }
+
+#ifndef LEGION_BOUNDS_CHECKS
+    bool dense = true;
+#else
+    // No dense execution if we're doing bounds checks
+    bool dense = false;
+#endif
+    for (int32_t idx = 0; idx < num_rhs; ++idx) {
+      assert(args.rhs[idx].dim() == 1);
+      products.rhs[idx] = args.rhs[idx].read_accessor<VAL, 1>(rect);
+#ifndef LEGION_BOUNDS_CHECKS
+      dense = dense && products.rhs[idx].accessor.is_dense_row_major(rect);
+#endif
+    }
+
+    MultiDotImplBody<KIND, CODE>()(products, rect, dense);
+  }
+};
+
+template <VariantKind KIND>
+static void multi_dot_template(TaskContext& context)
+{
+  auto& scalars = context.scalars();
+  MultiDotArgs args{context.reductions(), context.inputs(), scalars[0].values<int32_t>()};
+  cunumeric::type_dispatch(args.rhs[0].code(), MultiDotImpl<KIND>{}, args);
+}
+
+}  // namespace cunumeric
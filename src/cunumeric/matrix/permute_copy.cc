@@ -0,0 +1,50 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/matrix/permute_copy.h"
+#include "cunumeric/matrix/permute_copy_template.inl"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <LegateTypeCode CODE, int DIM>
+struct PermuteCopyImplBody<VariantKind::CPU, CODE, DIM> {
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(VAL* out, const VAL* in, const PermuteCopyLayout<DIM>& layout) const
+  {
+    PermuteCopyBlocks<VAL, DIM> blocks(out, in, layout);
+    const size_t items = blocks.items();
+    for (size_t item = 0; item < items; ++item) blocks.copy(item);
+  }
+};
+
+/*static*/ void PermuteCopyTask::cpu_variant(TaskContext& context)
+{
+  permute_copy_template<VariantKind::CPU>(context);
+}
+
+namespace  // unnamed
+{
+static void __attribute__((constructor)) register_tasks(void)
+{
+  PermuteCopyTask::register_variants();
+}
+}  // namespace
+
+}  // namespace cunumeric
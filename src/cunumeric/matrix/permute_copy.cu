@@ -0,0 +1,124 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/matrix/permute_copy.h"
+#include "cunumeric/matrix/permute_copy_template.inl"
+
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+
+static constexpr coord_t PERMUTE_TILE_DIM   = 32;
+static constexpr coord_t PERMUTE_BLOCK_ROWS = 8;
+static constexpr size_t MAX_GRID_EXTENT     = 65535;
+
+// Each block moves 32x32 tiles of the two innermost axes through shared memory: the
+// threads read a tile in runs along the innermost axis of the source and write it back in
+// runs along the innermost axis of the target. The y and z dimensions of the grid stride
+// over the tiles of the target axis and over the batches.
+template <typename VAL, int DIM>
+__global__ static void __launch_bounds__(PERMUTE_TILE_DIM* PERMUTE_BLOCK_ROWS, MIN_CTAS_PER_SM)
+  permute_copy_tiles(VAL* out, const VAL* in, const PermuteCopyLayout<DIM> layout, coord_t tiles_b)
+{
+  __shared__ VAL tile[PERMUTE_TILE_DIM][PERMUTE_TILE_DIM + 1 /*avoid bank conflicts*/];
+
+  const auto a           = layout.in_axis;
+  const auto b           = layout.out_axis;
+  const coord_t extent_a = layout.extents[a];
+  const coord_t extent_b = layout.extents[b];
+  const coord_t lo_a     = blockIdx.x * PERMUTE_TILE_DIM;
+
+  for (size_t batch = blockIdx.z; batch < layout.batches; batch += gridDim.z) {
+    size_t in_offset, out_offset;
+    layout.batch_offsets(batch, in_offset, out_offset);
+
+    for (coord_t tile_b = blockIdx.y; tile_b < tiles_b; tile_b += gridDim.y) {
+      const coord_t lo_b = tile_b * PERMUTE_TILE_DIM;
+
+      const coord_t i = lo_a + threadIdx.x;
+      if (i < extent_a)
+        for (coord_t k = threadIdx.y; k < PERMUTE_TILE_DIM; k += PERMUTE_BLOCK_ROWS)
+          if (lo_b + k < extent_b)
+            tile[k][threadIdx.x] =
+              in[in_offset + i * layout.in_strides[a] + (lo_b + k) * layout.in_strides[b]];
+      // Make sure all the data is in shared memory
+      __syncthreads();
+
+      const coord_t j = lo_b + threadIdx.x;
+      if (j < extent_b)
+        for (coord_t k = threadIdx.y; k < PERMUTE_TILE_DIM; k += PERMUTE_BLOCK_ROWS)
+          if (lo_a + k < extent_a)
+            out[out_offset + (lo_a + k) * layout.out_strides[a] + j * layout.out_strides[b]] =
+              tile[threadIdx.x][k];
+      // The next tile reuses the shared memory
+      __syncthreads();
+    }
+  }
+}
+
+// Copies whole rows when both sides share the innermost axis
+template <typename VAL, int DIM>
+__global__ static void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  permute_copy_rows(VAL* out, const VAL* in, const PermuteCopyLayout<DIM> layout, size_t volume)
+{
+  const auto a            = layout.in_axis;
+  const size_t extent     = layout.extents[a];
+  const size_t in_stride  = layout.in_strides[a];
+  const size_t out_stride = layout.out_strides[a];
+  for (size_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < volume;
+       idx += blockDim.x * gridDim.x) {
+    const size_t i = idx % extent;
+    size_t in_offset, out_offset;
+    layout.batch_offsets(idx / extent, in_offset, out_offset);
+    out[out_offset + i * out_stride] = in[in_offset + i * in_stride];
+  }
+}
+
+template <LegateTypeCode CODE, int DIM>
+struct PermuteCopyImplBody<VariantKind::GPU, CODE, DIM> {
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(VAL* out, const VAL* in, const PermuteCopyLayout<DIM>& layout) const
+  {
+    auto stream = get_cached_stream();
+
+    if (layout.in_axis == layout.out_axis) {
+      const size_t volume = layout.batches * layout.extents[layout.in_axis];
+      permute_copy_rows<VAL, DIM>
+        <<<grid_stride_blocks<1>(volume), THREADS_PER_BLOCK, 0, stream>>>(out, in, layout, volume);
+      return;
+    }
+
+    const coord_t extent_a = layout.extents[layout.in_axis];
+    const coord_t extent_b = layout.extents[layout.out_axis];
+    const coord_t tiles_a  = (extent_a + PERMUTE_TILE_DIM - 1) / PERMUTE_TILE_DIM;
+    const coord_t tiles_b  = (extent_b + PERMUTE_TILE_DIM - 1) / PERMUTE_TILE_DIM;
+    const dim3 blocks(tiles_a,
+                      std::min<size_t>(tiles_b, MAX_GRID_EXTENT),
+                      std::min<size_t>(layout.batches, MAX_GRID_EXTENT));
+    const dim3 threads(PERMUTE_TILE_DIM, PERMUTE_BLOCK_ROWS, 1);
+    permute_copy_tiles<VAL, DIM><<<blocks, threads, 0, stream>>>(out, in, layout, tiles_b);
+  }
+};
+
+/*static*/ void PermuteCopyTask::gpu_variant(TaskContext& context)
+{
+  permute_copy_template<VariantKind::GPU>(context);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,156 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <limits>
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <VariantKind KIND, LegateTypeCode CODE, int DIM>
+struct PermuteCopyImplBody;
+
+// Describes a copy between two layouts of the same shape. The innermost axis of an
+// instance is the one with the smallest stride. A copy whose source and target have
+// different innermost axes, such as the one that materializes a transposed view, is
+// done in tiles of those two axes, so that both sides are read and written in runs.
+// The remaining axes index the batches of tiles.
+template <int DIM>
+struct PermuteCopyLayout {
+  int32_t in_axis;
+  int32_t out_axis;
+  coord_t extents[DIM];
+  size_t in_strides[DIM];
+  size_t out_strides[DIM];
+  size_t batches;
+
+  // Returns the offsets of the first element of a batch in the source and the target
+  __CUDA_HD__ inline void batch_offsets(size_t batch, size_t& in_offset, size_t& out_offset) const
+  {
+    in_offset  = 0;
+    out_offset = 0;
+    for (int32_t dim = DIM - 1; dim >= 0; --dim) {
+      if (dim == in_axis || dim == out_axis) continue;
+      const size_t coord = batch % extents[dim];
+      batch /= extents[dim];
+      in_offset += coord * in_strides[dim];
+      out_offset += coord * out_strides[dim];
+    }
+  }
+};
+
+// Returns the non-trivial axis with the smallest non-zero stride, or the fallback
+template <int DIM>
+static int32_t innermost_axis(const Rect<DIM>& rect, const size_t* strides, int32_t fallback)
+{
+  int32_t axis  = fallback;
+  size_t stride = std::numeric_limits<size_t>::max();
+  for (int32_t dim = 0; dim < DIM; ++dim)
+    if (rect.hi[dim] > rect.lo[dim] && strides[dim] > 0 && strides[dim] < stride) {
+      axis   = dim;
+      stride = strides[dim];
+    }
+  return axis;
+}
+
+// Blocked copies on the CPU, shared by the CPU and OpenMP variants. The work is split
+// into items: one batch of tiles along the innermost axis of the target each, or one
+// row of a batch when both sides share the innermost axis.
+template <typename VAL, int DIM>
+struct PermuteCopyBlocks {
+  // Tiles span this many elements along each of the two axes
+  static constexpr coord_t BF = 128 / sizeof(VAL);
+
+  PermuteCopyBlocks(VAL* out, const VAL* in, const PermuteCopyLayout<DIM>& layout)
+    : out(out), in(in), layout(layout)
+  {
+    const auto extent_b = layout.extents[layout.out_axis];
+    tiles_b             = layout.in_axis == layout.out_axis ? 1 : (extent_b + BF - 1) / BF;
+  }
+
+  size_t items() const { return layout.batches * tiles_b; }
+
+  void copy(size_t item) const
+  {
+    const auto a = layout.in_axis;
+    const auto b = layout.out_axis;
+
+    size_t in_offset, out_offset;
+    layout.batch_offsets(item / tiles_b, in_offset, out_offset);
+    auto dst = out + out_offset;
+    auto src = in + in_offset;
+
+    const coord_t extent_a = layout.extents[a];
+    const size_t in_a      = layout.in_strides[a];
+    const size_t out_a     = layout.out_strides[a];
+    if (a == b) {
+      for (coord_t i = 0; i < extent_a; ++i) dst[i * out_a] = src[i * in_a];
+      return;
+    }
+
+    const size_t in_b  = layout.in_strides[b];
+    const size_t out_b = layout.out_strides[b];
+    const coord_t lo_b = (item % tiles_b) * BF;
+    const coord_t hi_b = std::min(lo_b + BF, layout.extents[b]);
+    for (coord_t lo_a = 0; lo_a < extent_a; lo_a += BF) {
+      const coord_t hi_a = std::min(lo_a + BF, extent_a);
+      for (coord_t j = lo_b; j < hi_b; ++j)
+        for (coord_t i = lo_a; i < hi_a; ++i) dst[i * out_a + j * out_b] = src[i * in_a + j * in_b];
+    }
+  }
+
+  VAL* out;
+  const VAL* in;
+  const PermuteCopyLayout<DIM>& layout;
+  size_t tiles_b;
+};
+
+template <VariantKind KIND>
+struct PermuteCopyImpl {
+  template <LegateTypeCode CODE, int DIM>
+  void operator()(PermuteCopyArgs& args) const
+  {
+    using VAL = legate_type_of<CODE>;
+
+    const auto rect = args.out.shape<DIM>();
+    if (rect.empty()) return;
+
+    PermuteCopyLayout<DIM> layout;
+    auto out = args.out.write_accessor<VAL, DIM>(rect).ptr(rect, layout.out_strides);
+    auto in  = args.in.read_accessor<VAL, DIM>(rect).ptr(rect, layout.in_strides);
+
+    layout.out_axis = innermost_axis(rect, layout.out_strides, DIM - 1);
+    layout.in_axis  = innermost_axis(rect, layout.in_strides, layout.out_axis);
+    layout.batches  = 1;
+    for (int32_t dim = 0; dim < DIM; ++dim) {
+      layout.extents[dim] = rect.hi[dim] - rect.lo[dim] + 1;
+      if (dim != layout.in_axis && dim != layout.out_axis) layout.batches *= layout.extents[dim];
+    }
+
+    PermuteCopyImplBody<KIND, CODE, DIM>{}(out, in, layout);
+  }
+};
+
+template <VariantKind KIND>
+static void permute_copy_template(TaskContext& context)
+{
+  PermuteCopyArgs args{context.outputs()[0], context.inputs()[0]};
+  cunumeric::double_dispatch(args.out.dim(), args.out.code(), PermuteCopyImpl<KIND>{}, args);
+}
+
+}  // namespace cunumeric
@@ -16,6 +16,7 @@
 
 #include "cunumeric/matrix/potrf.h"
 #include "cunumeric/matrix/potrf_template.inl"
+#include "cunumeric/matrix/util.h"
 
 #include <cblas.h>
 #include <lapack.h>
@@ -26,44 +27,51 @@ using namespace Legion;
 using namespace legate;
 
 template <typename Potrf, typename VAL>
-static inline void potrf_template(Potrf potrf, VAL* array, int32_t m, int32_t n)
+static inline void potrf_template(
+  Potrf potrf, VAL* array, int32_t m, int32_t n, bool row_major, PotrfInfo failed)
 {
-  char uplo    = 'L';
+  char uplo    = row_major ? 'U' : 'L';
   int32_t info = 0;
   potrf(&uplo, &n, array, &m, &info);
-  assert(info == 0);
+  if (info > 0) failed.reduce(0, 1);
 }
 
 template <>
 struct PotrfImplBody<VariantKind::CPU, LegateTypeCode::FLOAT_LT> {
-  void operator()(float* array, int32_t m, int32_t n) { potrf_template(spotrf_, array, m, n); }
+  void operator()(float* array, int32_t m, int32_t n, bool row_major, PotrfInfo failed)
+  {
+    potrf_template(spotrf_, array, m, n, row_major, failed);
+  }
 };
 
 template <>
 struct PotrfImplBody<VariantKind::CPU, LegateTypeCode::DOUBLE_LT> {
-  void operator()(double* array, int32_t m, int32_t n) { potrf_template(dpotrf_, array, m, n); }
+  void operator()(double* array, int32_t m, int32_t n, bool row_major, PotrfInfo failed)
+  {
+    potrf_template(dpotrf_, array, m, n, row_major, failed);
+  }
 };
 
 template <>
 struct PotrfImplBody<VariantKind::CPU, LegateTypeCode::COMPLEX64_LT> {
-  void operator()(complex<float>* array, int32_t m, int32_t n)
+  void operator()(complex<float>* array, int32_t m, int32_t n, bool row_major, PotrfInfo failed)
   {
-    potrf_template(cpotrf_, reinterpret_cast<__complex__ float*>(array), m, n);
+    potrf_template(cpotrf_, reinterpret_cast<__complex__ float*>(array), m, n, row_major, failed);
   }
 };
 
 template <>
 struct PotrfImplBody<VariantKind::CPU, LegateTypeCode::COMPLEX128_LT> {
-  void operator()(complex<double>* array, int32_t m, int32_t n)
+  void operator()(complex<double>* array, int32_t m, int32_t n, bool row_major, PotrfInfo failed)
   {
-    potrf_template(zpotrf_, reinterpret_cast<__complex__ double*>(array), m, n);
+    potrf_template(zpotrf_, reinterpret_cast<__complex__ double*>(array), m, n, row_major, failed);
   }
 };
 
 /*static*/ void PotrfTask::cpu_variant(TaskContext& context)
 {
 #ifdef LEGATE_USE_OPENMP
-  openblas_set_num_threads(1);  // make sure this isn't overzealous
+  BlasThreads blas_threads(1);
 #endif
   potrf_template<VariantKind::CPU>(context);
 }
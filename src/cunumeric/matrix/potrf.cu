@@ -24,11 +24,22 @@ namespace cunumeric {
 using namespace Legion;
 using namespace legate;
 
+static __global__ void __launch_bounds__(1, 1)
+  check_info_kernel(const int32_t* info, PotrfInfo failed)
+{
+  if (*info > 0) failed.reduce(0, 1);
+}
+
 template <typename PotrfBufferSize, typename Potrf, typename VAL>
-static inline void potrf_template(
-  PotrfBufferSize potrfBufferSize, Potrf potrf, VAL* array, int32_t m, int32_t n)
+static inline void potrf_template(PotrfBufferSize potrfBufferSize,
+                                  Potrf potrf,
+                                  VAL* array,
+                                  int32_t m,
+                                  int32_t n,
+                                  bool row_major,
+                                  PotrfInfo failed)
 {
-  auto uplo = CUBLAS_FILL_MODE_LOWER;
+  auto uplo = row_major ? CUBLAS_FILL_MODE_UPPER : CUBLAS_FILL_MODE_LOWER;
 
   auto context = get_cusolver();
   auto stream  = get_cached_stream();
@@ -37,46 +48,58 @@ static inline void potrf_template(
   int32_t bufferSize;
   CHECK_CUSOLVER(potrfBufferSize(context, uplo, n, array, m, &bufferSize));
 
-  auto buffer = create_buffer<VAL>(bufferSize, Memory::Kind::GPU_FB_MEM);
-  auto info   = create_buffer<int32_t>(1, Memory::Kind::Z_COPY_MEM);
+  // The info word goes right after the cached workspace, which keeps it aligned for VAL
+  auto buffer = static_cast<VAL*>(get_workspace(bufferSize * sizeof(VAL) + sizeof(int32_t)));
+  auto info   = reinterpret_cast<int32_t*>(buffer + bufferSize);
 
-  CHECK_CUSOLVER(potrf(context, uplo, n, array, m, buffer.ptr(0), bufferSize, info.ptr(0)));
+  CHECK_CUSOLVER(potrf(context, uplo, n, array, m, buffer, bufferSize, info));
+
+  // Fold the status into the reduction on the device so the task doesn't wait
+  // for the factorization to finish
+  check_info_kernel<<<1, 1, 0, stream>>>(info, failed);
 }
 
 template <>
 struct PotrfImplBody<VariantKind::GPU, LegateTypeCode::FLOAT_LT> {
-  void operator()(float* array, int32_t m, int32_t n)
+  void operator()(float* array, int32_t m, int32_t n, bool row_major, PotrfInfo failed)
   {
-    potrf_template(cusolverDnSpotrf_bufferSize, cusolverDnSpotrf, array, m, n);
+    potrf_template(cusolverDnSpotrf_bufferSize, cusolverDnSpotrf, array, m, n, row_major, failed);
   }
 };
 
 template <>
 struct PotrfImplBody<VariantKind::GPU, LegateTypeCode::DOUBLE_LT> {
-  void operator()(double* array, int32_t m, int32_t n)
+  void operator()(double* array, int32_t m, int32_t n, bool row_major, PotrfInfo failed)
   {
-    potrf_template(cusolverDnDpotrf_bufferSize, cusolverDnDpotrf, array, m, n);
+    potrf_template(cusolverDnDpotrf_bufferSize, cusolverDnDpotrf, array, m, n, row_major, failed);
   }
 };
 
 template <>
 struct PotrfImplBody<VariantKind::GPU, LegateTypeCode::COMPLEX64_LT> {
-  void operator()(complex<float>* array, int32_t m, int32_t n)
+  void operator()(complex<float>* array, int32_t m, int32_t n, bool row_major, PotrfInfo failed)
   {
-    potrf_template(
-      cusolverDnCpotrf_bufferSize, cusolverDnCpotrf, reinterpret_cast<cuComplex*>(array), m, n);
+    potrf_template(cusolverDnCpotrf_bufferSize,
+                   cusolverDnCpotrf,
+                   reinterpret_cast<cuComplex*>(array),
+                   m,
+                   n,
+                   row_major,
+                   failed);
   }
 };
 
 template <>
 struct PotrfImplBody<VariantKind::GPU, LegateTypeCode::COMPLEX128_LT> {
-  void operator()(complex<double>* array, int32_t m, int32_t n)
+  void operator()(complex<double>* array, int32_t m, int32_t n, bool row_major, PotrfInfo failed)
   {
     potrf_template(cusolverDnZpotrf_bufferSize,
                    cusolverDnZpotrf,
                    reinterpret_cast<cuDoubleComplex*>(array),
                    m,
-                   n);
+                   n,
+                   row_major,
+                   failed);
   }
 };
 
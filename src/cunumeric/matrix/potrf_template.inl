@@ -19,6 +19,9 @@ namespace cunumeric {
 using namespace Legion;
 using namespace legate;
 
+// Set to a non-zero value when a tile is not positive definite
+using PotrfInfo = AccessorRD<MaxReduction<int32_t>, true, 1>;
+
 template <VariantKind KIND, LegateTypeCode CODE>
 struct PotrfImplBody;
 
@@ -41,7 +44,7 @@ struct support_potrf<LegateTypeCode::COMPLEX128_LT> : std::true_type {
 template <VariantKind KIND>
 struct PotrfImpl {
   template <LegateTypeCode CODE, std::enable_if_t<support_potrf<CODE>::value>* = nullptr>
-  void operator()(Array& array) const
+  void operator()(Array& array, bool row_major, Array& info) const
   {
     using VAL = legate_type_of<CODE>;
 
@@ -56,11 +59,13 @@ struct PotrfImpl {
     auto n   = static_cast<int32_t>(shape.hi[1] - shape.lo[1] + 1);
     assert(m > 0 && n > 0);
 
-    PotrfImplBody<KIND, CODE>()(arr, m, n);
+    auto failed = info.reduce_accessor<MaxReduction<int32_t>, true, 1>();
+
+    PotrfImplBody<KIND, CODE>()(arr, m, n, row_major, failed);
   }
 
   template <LegateTypeCode CODE, std::enable_if_t<!support_potrf<CODE>::value>* = nullptr>
-  void operator()(Array& array) const
+  void operator()(Array& array, bool row_major, Array& info) const
   {
     assert(false);
   }
@@ -70,7 +75,12 @@ template <VariantKind KIND>
 static void potrf_template(TaskContext& context)
 {
   auto& array = context.outputs()[0];
-  type_dispatch(array.code(), PotrfImpl<KIND>{}, array);
+  // When the array holds a whole matrix in row major order, its buffer read in column
+  // major order is the transpose, i.e. the conjugate, of the matrix. Factoring that
+  // buffer into an upper triangle leaves the lower Cholesky factor in row major order.
+  auto row_major = context.scalars()[0].value<bool>();
+  auto& info     = context.reductions()[0];
+  cunumeric::type_dispatch(array.code(), PotrfImpl<KIND>{}, array, row_major, info);
 }
 
 }  // namespace cunumeric
@@ -0,0 +1,134 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/matrix/quantize.h"
+#include "cunumeric/matrix/quantize_template.inl"
+
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+// The strides of the rows of the three stores and of the columns of the values
+struct QuantizeStrides {
+  size_t values_row;
+  size_t values_col;
+  size_t codes;
+  size_t scales;
+};
+
+// Every thread encodes or decodes one block of a row
+template <typename VAL>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  encode_kernel(const VAL* values,
+                int8_t* codes,
+                float* scales,
+                QuantizeStrides strides,
+                int64_t cols,
+                int64_t blocks,
+                int64_t volume,
+                int32_t bits)
+{
+  const int64_t idx = static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  if (idx >= volume) return;
+  const int64_t row   = idx / blocks;
+  const int64_t block = idx % blocks;
+  const int64_t col   = block * QUANT_BLOCK;
+  quant_encode_block(values + row * strides.values_row + col * strides.values_col,
+                     strides.values_col,
+                     MIN(QUANT_BLOCK, cols - col),
+                     bits,
+                     codes + row * strides.codes + quant_code_offset(block, bits),
+                     scales + row * strides.scales + block);
+}
+
+template <typename VAL>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  decode_kernel(VAL* values,
+                const int8_t* codes,
+                const float* scales,
+                QuantizeStrides strides,
+                int64_t cols,
+                int64_t blocks,
+                int64_t volume,
+                int32_t bits)
+{
+  const int64_t idx = static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  if (idx >= volume) return;
+  const int64_t row   = idx / blocks;
+  const int64_t block = idx % blocks;
+  const int64_t col   = block * QUANT_BLOCK;
+  quant_decode_block(codes + row * strides.codes + quant_code_offset(block, bits),
+                     scales[row * strides.scales + block],
+                     MIN(QUANT_BLOCK, cols - col),
+                     bits,
+                     values + row * strides.values_row + col * strides.values_col,
+                     strides.values_col);
+}
+
+template <LegateTypeCode CODE>
+struct QuantizeImplBody<VariantKind::GPU, CODE> {
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(const VAL* values,
+                  int8_t* codes,
+                  float* scales,
+                  const size_t values_strides[2],
+                  size_t codes_stride,
+                  size_t scales_stride,
+                  int64_t rows,
+                  int64_t cols,
+                  int64_t blocks,
+                  int32_t bits) const
+  {
+    auto stream          = get_cached_stream();
+    const int64_t volume = rows * blocks;
+    const QuantizeStrides strides{
+      values_strides[0], values_strides[1], codes_stride, scales_stride};
+    const size_t num_ctas = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+    encode_kernel<VAL><<<num_ctas, THREADS_PER_BLOCK, 0, stream>>>(
+      values, codes, scales, strides, cols, blocks, volume, bits);
+  }
+
+  void operator()(VAL* values,
+                  const int8_t* codes,
+                  const float* scales,
+                  const size_t values_strides[2],
+                  size_t codes_stride,
+                  size_t scales_stride,
+                  int64_t rows,
+                  int64_t cols,
+                  int64_t blocks,
+                  int32_t bits) const
+  {
+    auto stream          = get_cached_stream();
+    const int64_t volume = rows * blocks;
+    const QuantizeStrides strides{
+      values_strides[0], values_strides[1], codes_stride, scales_stride};
+    const size_t num_ctas = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+    decode_kernel<VAL><<<num_ctas, THREADS_PER_BLOCK, 0, stream>>>(
+      values, codes, scales, strides, cols, blocks, volume, bits);
+  }
+};
+
+/*static*/ void QuantizeTask::gpu_variant(TaskContext& context)
+{
+  quantize_template<VariantKind::GPU>(context);
+}
+
+}  // namespace cunumeric
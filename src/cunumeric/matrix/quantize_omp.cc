@@ -0,0 +1,87 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/matrix/quantize.h"
+#include "cunumeric/matrix/quantize_template.inl"
+
+#include <algorithm>
+
+#include <omp.h>
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <LegateTypeCode CODE>
+struct QuantizeImplBody<VariantKind::OMP, CODE> {
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(const VAL* values,
+                  int8_t* codes,
+                  float* scales,
+                  const size_t values_strides[2],
+                  size_t codes_stride,
+                  size_t scales_stride,
+                  int64_t rows,
+                  int64_t cols,
+                  int64_t blocks,
+                  int32_t bits) const
+  {
+#pragma omp parallel for collapse(2) schedule(static)
+    for (int64_t row = 0; row < rows; ++row)
+      for (int64_t block = 0; block < blocks; ++block) {
+        const int64_t col = block * QUANT_BLOCK;
+        quant_encode_block(values + row * values_strides[0] + col * values_strides[1],
+                           values_strides[1],
+                           std::min(QUANT_BLOCK, cols - col),
+                           bits,
+                           codes + row * codes_stride + quant_code_offset(block, bits),
+                           scales + row * scales_stride + block);
+      }
+  }
+
+  void operator()(VAL* values,
+                  const int8_t* codes,
+                  const float* scales,
+                  const size_t values_strides[2],
+                  size_t codes_stride,
+                  size_t scales_stride,
+                  int64_t rows,
+                  int64_t cols,
+                  int64_t blocks,
+                  int32_t bits) const
+  {
+#pragma omp parallel for collapse(2) schedule(static)
+    for (int64_t row = 0; row < rows; ++row)
+      for (int64_t block = 0; block < blocks; ++block) {
+        const int64_t col = block * QUANT_BLOCK;
+        quant_decode_block(codes + row * codes_stride + quant_code_offset(block, bits),
+                           scales[row * scales_stride + block],
+                           std::min(QUANT_BLOCK, cols - col),
+                           bits,
+                           values + row * values_strides[0] + col * values_strides[1],
+                           values_strides[1]);
+      }
+  }
+};
+
+/*static*/ void QuantizeTask::omp_variant(TaskContext& context)
+{
+  quantize_template<VariantKind::OMP>(context);
+}
+
+}  // namespace cunumeric
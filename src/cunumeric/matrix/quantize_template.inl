@@ -0,0 +1,106 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/matrix/block_quant.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <VariantKind KIND, LegateTypeCode CODE>
+struct QuantizeImplBody;
+
+template <LegateTypeCode CODE>
+struct support_quantize : std::false_type {
+};
+template <>
+struct support_quantize<LegateTypeCode::DOUBLE_LT> : std::true_type {
+};
+template <>
+struct support_quantize<LegateTypeCode::FLOAT_LT> : std::true_type {
+};
+
+template <VariantKind KIND>
+struct QuantizeImpl {
+  template <LegateTypeCode CODE, std::enable_if_t<support_quantize<CODE>::value>* = nullptr>
+  void operator()(QuantizeArgs& args) const
+  {
+    using VAL = legate_type_of<CODE>;
+
+    // Every task gets whole rows of the three stores
+    auto values_shape = args.values.shape<2>();
+    auto codes_shape  = args.codes.shape<2>();
+    auto scales_shape = args.scales.shape<2>();
+
+    if (values_shape.empty()) return;
+
+    size_t values_strides[2];
+    size_t codes_strides[2];
+    size_t scales_strides[2];
+
+    const int64_t rows   = values_shape.hi[0] - values_shape.lo[0] + 1;
+    const int64_t cols   = values_shape.hi[1] - values_shape.lo[1] + 1;
+    const int64_t blocks = scales_shape.hi[1] - scales_shape.lo[1] + 1;
+    assert(blocks == (cols + QUANT_BLOCK - 1) / QUANT_BLOCK);
+
+    auto body = [&](auto values, auto codes, auto scales) {
+      assert(codes_strides[1] == 1 && scales_strides[1] == 1);
+      QuantizeImplBody<KIND, CODE>()(values,
+                                     codes,
+                                     scales,
+                                     values_strides,
+                                     codes_strides[0],
+                                     scales_strides[0],
+                                     rows,
+                                     cols,
+                                     blocks,
+                                     args.bits);
+    };
+    if (args.decompress)
+      body(args.values.write_accessor<VAL, 2>(values_shape).ptr(values_shape, values_strides),
+           args.codes.read_accessor<int8_t, 2>(codes_shape).ptr(codes_shape, codes_strides),
+           args.scales.read_accessor<float, 2>(scales_shape).ptr(scales_shape, scales_strides));
+    else
+      body(args.values.read_accessor<VAL, 2>(values_shape).ptr(values_shape, values_strides),
+           args.codes.write_accessor<int8_t, 2>(codes_shape).ptr(codes_shape, codes_strides),
+           args.scales.write_accessor<float, 2>(scales_shape).ptr(scales_shape, scales_strides));
+  }
+
+  template <LegateTypeCode CODE, std::enable_if_t<!support_quantize<CODE>::value>* = nullptr>
+  void operator()(QuantizeArgs& args) const
+  {
+    assert(false);
+  }
+};
+
+template <VariantKind KIND>
+static void quantize_template(TaskContext& context)
+{
+  auto& scalars   = context.scalars();
+  auto bits       = scalars[0].value<int32_t>();
+  auto decompress = scalars[1].value<bool>();
+
+  auto& inputs  = context.inputs();
+  auto& outputs = context.outputs();
+  // The values are the input of a compression and the output of a decompression
+  QuantizeArgs args = decompress
+                        ? QuantizeArgs{outputs[0], inputs[0], inputs[1], bits, decompress}
+                        : QuantizeArgs{inputs[0], outputs[0], outputs[1], bits, decompress};
+  cunumeric::type_dispatch(args.values.code(), QuantizeImpl<KIND>{}, args);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,73 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/matrix/quantized_matvec.h"
+#include "cunumeric/matrix/quantized_matvec_template.inl"
+
+#include <algorithm>
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <LegateTypeCode CODE>
+struct QuantizedMatVecImplBody<VariantKind::CPU, CODE> {
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(VAL* lhs,
+                  const int8_t* codes,
+                  const float* scales,
+                  const VAL* rhs,
+                  size_t lhs_stride,
+                  size_t codes_stride,
+                  size_t scales_stride,
+                  int64_t rows,
+                  int64_t cols,
+                  int32_t bits) const
+  {
+    for (int64_t row = 0; row < rows; ++row) {
+      const int8_t* row_codes = codes + row * codes_stride;
+      const float* row_scales = scales + row * scales_stride;
+      VAL sum                 = 0;
+      // Every block is summed in its codes and scaled once
+      for (int64_t col = 0, block = 0; col < cols; col += QUANT_BLOCK, ++block) {
+        const int64_t count       = std::min(QUANT_BLOCK, cols - col);
+        const int8_t* block_codes = row_codes + quant_code_offset(block, bits);
+        VAL partial               = 0;
+        for (int64_t idx = 0; idx < count; ++idx)
+          partial += static_cast<VAL>(quant_get_code(block_codes, idx, bits)) * rhs[col + idx];
+        sum += static_cast<VAL>(row_scales[block]) * partial;
+      }
+      lhs[row * lhs_stride] = sum;
+    }
+  }
+};
+
+/*static*/ void QuantizedMatVecTask::cpu_variant(TaskContext& context)
+{
+  quantized_matvec_template<VariantKind::CPU>(context);
+}
+
+namespace  // unnamed
+{
+static void __attribute__((constructor)) register_tasks(void)
+{
+  QuantizedMatVecTask::register_variants();
+}
+}  // namespace
+
+}  // namespace cunumeric
@@ -0,0 +1,88 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/matrix/quantized_matvec.h"
+#include "cunumeric/matrix/quantized_matvec_template.inl"
+
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+constexpr int32_t QUANT_ROWS_PER_CTA = THREADS_PER_BLOCK / 32;
+
+// Every warp computes one row, its lanes reading consecutive codes so that the loads of
+// the row are coalesced, and every code is scaled on the fly
+template <typename VAL>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  quantized_matvec_kernel(VAL* lhs,
+                          const int8_t* codes,
+                          const float* scales,
+                          const VAL* rhs,
+                          size_t lhs_stride,
+                          size_t codes_stride,
+                          size_t scales_stride,
+                          int64_t rows,
+                          int64_t cols,
+                          int32_t bits)
+{
+  const int64_t row = static_cast<int64_t>(blockIdx.x) * QUANT_ROWS_PER_CTA + threadIdx.x / 32;
+  if (row >= rows) return;
+  const int32_t lane      = threadIdx.x % 32;
+  const int8_t* row_codes = codes + row * codes_stride;
+  const float* row_scales = scales + row * scales_stride;
+
+  VAL sum = 0;
+  for (int64_t col = lane; col < cols; col += 32) {
+    const int64_t block       = col / QUANT_BLOCK;
+    const int8_t* block_codes = row_codes + quant_code_offset(block, bits);
+    const auto code           = quant_get_code(block_codes, col - block * QUANT_BLOCK, bits);
+    sum += static_cast<VAL>(row_scales[block]) * static_cast<VAL>(code) * rhs[col];
+  }
+  for (int32_t offset = 16; offset > 0; offset /= 2) sum += warp_shuffle_xor(sum, offset);
+  if (lane == 0) lhs[row * lhs_stride] = sum;
+}
+
+template <LegateTypeCode CODE>
+struct QuantizedMatVecImplBody<VariantKind::GPU, CODE> {
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(VAL* lhs,
+                  const int8_t* codes,
+                  const float* scales,
+                  const VAL* rhs,
+                  size_t lhs_stride,
+                  size_t codes_stride,
+                  size_t scales_stride,
+                  int64_t rows,
+                  int64_t cols,
+                  int32_t bits) const
+  {
+    auto stream           = get_cached_stream();
+    const size_t num_ctas = (rows + QUANT_ROWS_PER_CTA - 1) / QUANT_ROWS_PER_CTA;
+    quantized_matvec_kernel<VAL><<<num_ctas, THREADS_PER_BLOCK, 0, stream>>>(
+      lhs, codes, scales, rhs, lhs_stride, codes_stride, scales_stride, rows, cols, bits);
+  }
+};
+
+/*static*/ void QuantizedMatVecTask::gpu_variant(TaskContext& context)
+{
+  quantized_matvec_template<VariantKind::GPU>(context);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,103 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/matrix/block_quant.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <VariantKind KIND, LegateTypeCode CODE>
+struct QuantizedMatVecImplBody;
+
+template <LegateTypeCode CODE>
+struct support_quantized_matvec : std::false_type {
+};
+template <>
+struct support_quantized_matvec<LegateTypeCode::DOUBLE_LT> : std::true_type {
+};
+template <>
+struct support_quantized_matvec<LegateTypeCode::FLOAT_LT> : std::true_type {
+};
+
+template <VariantKind KIND>
+struct QuantizedMatVecImpl {
+  template <LegateTypeCode CODE,
+            std::enable_if_t<support_quantized_matvec<CODE>::value>* = nullptr>
+  void operator()(QuantizedMatVecArgs& args) const
+  {
+    using VAL = legate_type_of<CODE>;
+
+    // Every task gets whole rows of the matrix and the whole vector, and the output is
+    // a column of those rows
+    auto lhs_shape    = args.lhs.shape<2>();
+    auto codes_shape  = args.codes.shape<2>();
+    auto scales_shape = args.scales.shape<2>();
+    auto rhs_shape    = args.rhs.shape<1>();
+
+    if (lhs_shape.empty()) return;
+
+    size_t lhs_strides[2];
+    size_t codes_strides[2];
+    size_t scales_strides[2];
+
+    const int64_t rows   = lhs_shape.hi[0] - lhs_shape.lo[0] + 1;
+    const int64_t cols   = rhs_shape.hi[0] - rhs_shape.lo[0] + 1;
+    const int64_t blocks = scales_shape.hi[1] - scales_shape.lo[1] + 1;
+    assert(blocks == (cols + QUANT_BLOCK - 1) / QUANT_BLOCK);
+
+    auto lhs    = args.lhs.write_accessor<VAL, 2>(lhs_shape).ptr(lhs_shape, lhs_strides);
+    auto codes  = args.codes.read_accessor<int8_t, 2>(codes_shape).ptr(codes_shape, codes_strides);
+    auto scales =
+      args.scales.read_accessor<float, 2>(scales_shape).ptr(scales_shape, scales_strides);
+    auto rhs    = args.rhs.read_accessor<VAL, 1>(rhs_shape).ptr(rhs_shape);
+    assert(codes_strides[1] == 1 && scales_strides[1] == 1);
+
+    QuantizedMatVecImplBody<KIND, CODE>()(lhs,
+                                          codes,
+                                          scales,
+                                          rhs,
+                                          lhs_strides[0],
+                                          codes_strides[0],
+                                          scales_strides[0],
+                                          rows,
+                                          cols,
+                                          args.bits);
+  }
+
+  template <LegateTypeCode CODE,
+            std::enable_if_t<!support_quantized_matvec<CODE>::value>* = nullptr>
+  void operator()(QuantizedMatVecArgs& args) const
+  {
+    assert(false);
+  }
+};
+
+template <VariantKind KIND>
+static void quantized_matvec_template(TaskContext& context)
+{
+  auto& inputs = context.inputs();
+
+  QuantizedMatVecArgs args{context.outputs()[0],
+                           inputs[0],
+                           inputs[1],
+                           inputs[2],
+                           context.scalars()[0].value<int32_t>()};
+  cunumeric::type_dispatch(args.lhs.code(), QuantizedMatVecImpl<KIND>{}, args);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,62 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/matrix/repeat.h"
+#include "cunumeric/matrix/repeat_template.inl"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <typename VAL, int DIM>
+struct RepeatImplBody<VariantKind::CPU, VAL, DIM> {
+  void operator()(const AccessorWO<VAL, DIM>& out,
+                  const AccessorRO<VAL, DIM>& in,
+                  const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& out_rect,
+                  const Rect<DIM>& in_rect,
+                  int32_t axis,
+                  int64_t repeats,
+                  int64_t phase,
+                  size_t volume,
+                  bool dense) const
+  {
+    if (dense) {
+      const size_t rows = volume / (out_rect.hi[DIM - 1] - out_rect.lo[DIM - 1] + 1);
+      for (size_t row = 0; row < rows; ++row)
+        repeat_dense_row(out, in, pitches, out_rect, in_rect, axis, repeats, phase, row);
+      return;
+    }
+    for (size_t idx = 0; idx < volume; ++idx) {
+      auto p = pitches.unflatten(idx, out_rect.lo);
+      out[p] = in[get_repeat_point(p, out_rect.lo, in_rect.lo, axis, repeats, phase)];
+    }
+  }
+};
+
+/*static*/ void RepeatTask::cpu_variant(TaskContext& context)
+{
+  repeat_template<VariantKind::CPU>(context);
+}
+
+namespace  // unnamed
+{
+static void __attribute__((constructor)) register_tasks(void) { RepeatTask::register_variants(); }
+}  // namespace
+
+}  // namespace cunumeric
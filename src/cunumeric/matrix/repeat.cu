@@ -0,0 +1,75 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/matrix/repeat.h"
+#include "cunumeric/matrix/repeat_template.inl"
+
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <typename VAL, int DIM>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  repeat_kernel(const size_t volume,
+                const AccessorWO<VAL, DIM> out,
+                const AccessorRO<VAL, DIM> in,
+                const FastPitches<DIM - 1> pitches,
+                const Point<DIM> out_lo,
+                const Point<DIM> in_lo,
+                const int32_t axis,
+                const int64_t repeats,
+                const int64_t phase)
+{
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x;
+  for (size_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < volume; idx += stride) {
+    auto p = pitches.unflatten(idx, out_lo);
+    out[p] = in[get_repeat_point(p, out_lo, in_lo, axis, repeats, phase)];
+  }
+}
+
+template <typename VAL, int DIM>
+struct RepeatImplBody<VariantKind::GPU, VAL, DIM> {
+  void operator()(const AccessorWO<VAL, DIM>& out,
+                  const AccessorRO<VAL, DIM>& in,
+                  const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& out_rect,
+                  const Rect<DIM>& in_rect,
+                  int32_t axis,
+                  int64_t repeats,
+                  int64_t phase,
+                  size_t volume,
+                  bool dense) const
+  {
+    auto stream = get_cached_stream();
+
+    FastPitches<DIM - 1> fast_pitches;
+    fast_pitches.flatten(out_rect);
+    const size_t blocks = grid_stride_blocks<1>(volume);
+    repeat_kernel<VAL, DIM><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+      volume, out, in, fast_pitches, out_rect.lo, in_rect.lo, axis, repeats, phase);
+  }
+};
+
+/*static*/ void RepeatTask::gpu_variant(TaskContext& context)
+{
+  repeat_template<VariantKind::GPU>(context);
+}
+
+}  // namespace cunumeric
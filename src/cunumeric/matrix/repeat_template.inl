@@ -0,0 +1,118 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/pitches.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <int DIM>
+__CUDA_HD__ inline Point<DIM> get_repeat_point(Point<DIM> point,
+                                               const Point<DIM>& out_lo,
+                                               const Point<DIM>& in_lo,
+                                               int32_t axis,
+                                               int64_t repeats,
+                                               int64_t phase)
+{
+  point[axis] = in_lo[axis] + (point[axis] - out_lo[axis] + phase) / repeats;
+  return point;
+}
+
+// Expands the row-th innermost row of dense stores. Rows across the repeated axis
+// are plain copies of an input row, while a repeated innermost axis writes every
+// input element as a run of repeats elements.
+template <typename VAL, int DIM>
+inline void repeat_dense_row(const AccessorWO<VAL, DIM>& out,
+                             const AccessorRO<VAL, DIM>& in,
+                             const Pitches<DIM - 1>& pitches,
+                             const Rect<DIM>& out_rect,
+                             const Rect<DIM>& in_rect,
+                             int32_t axis,
+                             int64_t repeats,
+                             int64_t phase,
+                             size_t row)
+{
+  const size_t length = out_rect.hi[DIM - 1] - out_rect.lo[DIM - 1] + 1;
+  const auto p        = pitches.unflatten(row * length, out_rect.lo);
+  auto outptr         = out.ptr(p);
+  if (axis != DIM - 1) {
+    auto inptr = in.ptr(get_repeat_point(p, out_rect.lo, in_rect.lo, axis, repeats, phase));
+    std::copy(inptr, inptr + length, outptr);
+    return;
+  }
+  auto q       = p;
+  q[DIM - 1]   = in_rect.lo[DIM - 1];
+  auto inptr   = in.ptr(q);
+  size_t done  = 0;
+  size_t count = std::min<size_t>(repeats - phase, length);
+  for (size_t idx = 0; done < length; ++idx) {
+    std::fill(outptr + done, outptr + done + count, inptr[idx]);
+    done += count;
+    count = std::min<size_t>(repeats, length - done);
+  }
+}
+
+template <VariantKind KIND, typename VAL, int DIM>
+struct RepeatImplBody;
+
+template <VariantKind KIND>
+struct RepeatImpl {
+  template <LegateTypeCode CODE, int DIM>
+  void operator()(RepeatArgs& args) const
+  {
+    using VAL = legate_type_of<CODE>;
+
+    const auto out_rect = args.out.shape<DIM>();
+
+    Pitches<DIM - 1> pitches;
+    size_t volume = pitches.flatten(out_rect);
+
+    if (volume == 0) return;
+
+    const auto in_rect = args.in.shape<DIM>();
+
+    auto out = args.out.write_accessor<VAL, DIM>(out_rect);
+    auto in  = args.in.read_accessor<VAL, DIM>(in_rect);
+
+#ifndef LEGION_BOUNDS_CHECKS
+    bool dense =
+      out.accessor.is_dense_row_major(out_rect) && in.accessor.is_dense_row_major(in_rect);
+#else
+    bool dense = false;
+#endif
+
+    RepeatImplBody<KIND, VAL, DIM>()(
+      out, in, pitches, out_rect, in_rect, args.axis, args.repeats, args.phase, volume, dense);
+  }
+};
+
+template <VariantKind KIND>
+static void repeat_template(TaskContext& context)
+{
+  auto& scalars = context.scalars();
+
+  RepeatArgs args{context.inputs()[0],
+                  context.outputs()[0],
+                  scalars[0].value<int32_t>(),
+                  scalars[1].value<int64_t>(),
+                  scalars[2].value<int64_t>()};
+  cunumeric::double_dispatch(args.out.dim(), args.out.code(), RepeatImpl<KIND>{}, args);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,64 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/matrix/spmm.h"
+#include "cunumeric/matrix/spmm_template.inl"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <LegateTypeCode CODE>
+struct SpmmImplBody<VariantKind::CPU, CODE> {
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(VAL* lhs,
+                  const int64_t* pos,
+                  const int64_t* crd,
+                  const VAL* vals,
+                  const VAL* rhs,
+                  int64_t m,
+                  int64_t n,
+                  int64_t k,
+                  int64_t nnz,
+                  size_t lhs_stride,
+                  size_t rhs_stride) const
+  {
+    const auto base = pos[0];
+    for (int64_t i = 0; i < m; ++i) {
+      auto out = lhs + i * lhs_stride;
+      for (int64_t j = 0; j < n; ++j) out[j] = VAL{0};
+      for (int64_t idx = pos[i] - base; idx < pos[i + 1] - base; ++idx) {
+        const auto val = vals[idx];
+        const auto in  = rhs + crd[idx] * rhs_stride;
+        for (int64_t j = 0; j < n; ++j) out[j] += val * in[j];
+      }
+    }
+  }
+};
+
+/*static*/ void SpmmTask::cpu_variant(TaskContext& context)
+{
+  spmm_template<VariantKind::CPU>(context);
+}
+
+namespace  // unnamed
+{
+static void __attribute__((constructor)) register_tasks(void) { SpmmTask::register_variants(); }
+}  // namespace
+
+}  // namespace cunumeric
@@ -0,0 +1,162 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/matrix/spmm.h"
+#include "cunumeric/matrix/spmm_template.inl"
+
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+// cuSPARSE wants the row offsets of a matrix to start at zero
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  rebase_offsets_kernel(int64_t* offsets, const int64_t* pos, int64_t count)
+{
+  const auto base = pos[0];
+  for (int64_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < count;
+       idx += blockDim.x * gridDim.x)
+    offsets[idx] = pos[idx] - base;
+}
+
+template <cudaDataType CUDA_TYPE, typename VAL>
+static inline void spmm_template(VAL* lhs,
+                                 const int64_t* pos,
+                                 const int64_t* crd,
+                                 const VAL* vals,
+                                 const VAL* rhs,
+                                 int64_t m,
+                                 int64_t n,
+                                 int64_t k,
+                                 int64_t nnz,
+                                 size_t lhs_stride,
+                                 size_t rhs_stride)
+{
+  auto stream = get_cached_stream();
+
+  // A block without nonzeros only has to clear its rows of the output
+  if (nnz == 0) {
+    CHECK_CUDA(cudaMemset2DAsync(lhs, lhs_stride * sizeof(VAL), 0, n * sizeof(VAL), m, stream));
+    return;
+  }
+
+  auto handle = get_cusparse();
+  CHECK_CUSPARSE(cusparseSetStream(handle, stream));
+
+  ScratchBuffer<int64_t> offsets(m + 1);
+  const size_t blocks = (m + 1 + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+  rebase_offsets_kernel<<<get_grid_stride_ctas(blocks), THREADS_PER_BLOCK, 0, stream>>>(
+    offsets.ptr(0), pos, m + 1);
+
+  cusparseSpMatDescr_t matrix;
+  CHECK_CUSPARSE(cusparseCreateCsr(&matrix,
+                                   m,
+                                   k,
+                                   nnz,
+                                   offsets.ptr(0),
+                                   const_cast<int64_t*>(crd),
+                                   const_cast<VAL*>(vals),
+                                   CUSPARSE_INDEX_64I,
+                                   CUSPARSE_INDEX_64I,
+                                   CUSPARSE_INDEX_BASE_ZERO,
+                                   CUDA_TYPE));
+
+  VAL alpha = VAL{1};
+  VAL beta  = VAL{0};
+  size_t buffer_size;
+  auto op = CUSPARSE_OPERATION_NON_TRANSPOSE;
+
+  if (n == 1 && lhs_stride == 1 && rhs_stride == 1) {
+    cusparseDnVecDescr_t x, y;
+    CHECK_CUSPARSE(cusparseCreateDnVec(&x, k, const_cast<VAL*>(rhs), CUDA_TYPE));
+    CHECK_CUSPARSE(cusparseCreateDnVec(&y, m, lhs, CUDA_TYPE));
+    CHECK_CUSPARSE(cusparseSpMV_bufferSize(
+      handle, op, &alpha, matrix, x, &beta, y, CUDA_TYPE, CUSPARSE_SPMV_ALG_DEFAULT, &buffer_size));
+    auto buffer = get_workspace(buffer_size);
+    CHECK_CUSPARSE(cusparseSpMV(
+      handle, op, &alpha, matrix, x, &beta, y, CUDA_TYPE, CUSPARSE_SPMV_ALG_DEFAULT, buffer));
+    CHECK_CUSPARSE(cusparseDestroyDnVec(x));
+    CHECK_CUSPARSE(cusparseDestroyDnVec(y));
+  } else {
+    cusparseDnMatDescr_t b, c;
+    CHECK_CUSPARSE(cusparseCreateDnMat(
+      &b, k, n, rhs_stride, const_cast<VAL*>(rhs), CUDA_TYPE, CUSPARSE_ORDER_ROW));
+    CHECK_CUSPARSE(cusparseCreateDnMat(&c, m, n, lhs_stride, lhs, CUDA_TYPE, CUSPARSE_ORDER_ROW));
+    CHECK_CUSPARSE(cusparseSpMM_bufferSize(handle,
+                                           op,
+                                           op,
+                                           &alpha,
+                                           matrix,
+                                           b,
+                                           &beta,
+                                           c,
+                                           CUDA_TYPE,
+                                           CUSPARSE_SPMM_ALG_DEFAULT,
+                                           &buffer_size));
+    auto buffer = get_workspace(buffer_size);
+    CHECK_CUSPARSE(cusparseSpMM(
+      handle, op, op, &alpha, matrix, b, &beta, c, CUDA_TYPE, CUSPARSE_SPMM_ALG_DEFAULT, buffer));
+    CHECK_CUSPARSE(cusparseDestroyDnMat(b));
+    CHECK_CUSPARSE(cusparseDestroyDnMat(c));
+  }
+
+  CHECK_CUSPARSE(cusparseDestroySpMat(matrix));
+}
+
+template <>
+struct SpmmImplBody<VariantKind::GPU, LegateTypeCode::FLOAT_LT> {
+  template <typename... Args>
+  void operator()(Args&&... args)
+  {
+    spmm_template<CUDA_R_32F>(std::forward<Args>(args)...);
+  }
+};
+
+template <>
+struct SpmmImplBody<VariantKind::GPU, LegateTypeCode::DOUBLE_LT> {
+  template <typename... Args>
+  void operator()(Args&&... args)
+  {
+    spmm_template<CUDA_R_64F>(std::forward<Args>(args)...);
+  }
+};
+
+template <>
+struct SpmmImplBody<VariantKind::GPU, LegateTypeCode::COMPLEX64_LT> {
+  template <typename... Args>
+  void operator()(Args&&... args)
+  {
+    spmm_template<CUDA_C_32F>(std::forward<Args>(args)...);
+  }
+};
+
+template <>
+struct SpmmImplBody<VariantKind::GPU, LegateTypeCode::COMPLEX128_LT> {
+  template <typename... Args>
+  void operator()(Args&&... args)
+  {
+    spmm_template<CUDA_C_64F>(std::forward<Args>(args)...);
+  }
+};
+
+/*static*/ void SpmmTask::gpu_variant(TaskContext& context)
+{
+  spmm_template<VariantKind::GPU>(context);
+}
+
+}  // namespace cunumeric
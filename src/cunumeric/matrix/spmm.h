@@ -0,0 +1,48 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "cunumeric/cunumeric.h"
+
+namespace cunumeric {
+
+struct SpmmArgs {
+  const Array& lhs;
+  const Array& pos;
+  const Array& crd;
+  const Array& vals;
+  const Array& rhs;
+};
+
+// Multiplies a block of rows of a CSR matrix with a dense matrix. The row pointers are
+// those of the rows of the block, so they start at the global position of its first
+// nonzero, and the column indices and values are the slices of the nonzeros of the block.
+class SpmmTask : public CuNumericTask<SpmmTask> {
+ public:
+  static const int TASK_ID = CUNUMERIC_SPMM;
+
+ public:
+  static void cpu_variant(legate::TaskContext& context);
+#ifdef LEGATE_USE_OPENMP
+  static void omp_variant(legate::TaskContext& context);
+#endif
+#ifdef LEGATE_USE_CUDA
+  static void gpu_variant(legate::TaskContext& context);
+#endif
+};
+
+}  // namespace cunumeric
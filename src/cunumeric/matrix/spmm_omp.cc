@@ -0,0 +1,62 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/matrix/spmm.h"
+#include "cunumeric/matrix/spmm_template.inl"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <LegateTypeCode CODE>
+struct SpmmImplBody<VariantKind::OMP, CODE> {
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(VAL* lhs,
+                  const int64_t* pos,
+                  const int64_t* crd,
+                  const VAL* vals,
+                  const VAL* rhs,
+                  int64_t m,
+                  int64_t n,
+                  int64_t k,
+                  int64_t nnz,
+                  size_t lhs_stride,
+                  size_t rhs_stride) const
+  {
+    const auto base = pos[0];
+    // The rows of graphs and meshes can hold very different numbers of nonzeros, so the
+    // threads pick up small chunks of rows as they go instead of equal shares
+#pragma omp parallel for schedule(dynamic, 64)
+    for (int64_t i = 0; i < m; ++i) {
+      auto out = lhs + i * lhs_stride;
+      for (int64_t j = 0; j < n; ++j) out[j] = VAL{0};
+      for (int64_t idx = pos[i] - base; idx < pos[i + 1] - base; ++idx) {
+        const auto val = vals[idx];
+        const auto in  = rhs + crd[idx] * rhs_stride;
+        for (int64_t j = 0; j < n; ++j) out[j] += val * in[j];
+      }
+    }
+  }
+};
+
+/*static*/ void SpmmTask::omp_variant(TaskContext& context)
+{
+  spmm_template<VariantKind::OMP>(context);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,100 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <VariantKind KIND, LegateTypeCode CODE>
+struct SpmmImplBody;
+
+template <LegateTypeCode CODE>
+struct support_spmm : std::false_type {
+};
+template <>
+struct support_spmm<LegateTypeCode::DOUBLE_LT> : std::true_type {
+};
+template <>
+struct support_spmm<LegateTypeCode::FLOAT_LT> : std::true_type {
+};
+template <>
+struct support_spmm<LegateTypeCode::COMPLEX64_LT> : std::true_type {
+};
+template <>
+struct support_spmm<LegateTypeCode::COMPLEX128_LT> : std::true_type {
+};
+
+template <VariantKind KIND>
+struct SpmmImpl {
+  template <LegateTypeCode CODE, std::enable_if_t<support_spmm<CODE>::value>* = nullptr>
+  void operator()(SpmmArgs& args) const
+  {
+    using VAL = legate_type_of<CODE>;
+
+    auto lhs_shape = args.lhs.shape<2>();
+    auto pos_shape = args.pos.shape<1>();
+    auto crd_shape = args.crd.shape<1>();
+    auto rhs_shape = args.rhs.shape<2>();
+
+    if (lhs_shape.empty()) return;
+
+    size_t lhs_strides[2];
+    size_t rhs_strides[2];
+
+    auto m   = lhs_shape.hi[0] - lhs_shape.lo[0] + 1;
+    auto n   = lhs_shape.hi[1] - lhs_shape.lo[1] + 1;
+    auto k   = rhs_shape.hi[0] - rhs_shape.lo[0] + 1;
+    auto nnz = static_cast<int64_t>(crd_shape.volume());
+    assert(pos_shape.volume() == static_cast<size_t>(m + 1));
+    assert(rhs_shape.hi[1] - rhs_shape.lo[1] + 1 == n);
+
+    auto lhs = args.lhs.write_accessor<VAL, 2>(lhs_shape).ptr(lhs_shape, lhs_strides);
+    auto pos = args.pos.read_accessor<int64_t, 1>(pos_shape).ptr(pos_shape);
+    auto rhs = args.rhs.read_accessor<VAL, 2>(rhs_shape).ptr(rhs_shape, rhs_strides);
+
+    const int64_t* crd = nullptr;
+    const VAL* vals    = nullptr;
+    if (nnz > 0) {
+      crd  = args.crd.read_accessor<int64_t, 1>(crd_shape).ptr(crd_shape);
+      vals = args.vals.read_accessor<VAL, 1>(crd_shape).ptr(crd_shape);
+    }
+
+    // The dense operands are row major, which a column vector promoted from a 1-D array
+    // trivially is
+    assert(n == 1 || (lhs_strides[1] == 1 && rhs_strides[1] == 1));
+
+    SpmmImplBody<KIND, CODE>()(
+      lhs, pos, crd, vals, rhs, m, n, k, nnz, lhs_strides[0], rhs_strides[0]);
+  }
+
+  template <LegateTypeCode CODE, std::enable_if_t<!support_spmm<CODE>::value>* = nullptr>
+  void operator()(SpmmArgs& args) const
+  {
+    assert(false);
+  }
+};
+
+template <VariantKind KIND>
+static void spmm_template(TaskContext& context)
+{
+  auto& inputs = context.inputs();
+
+  SpmmArgs args{context.outputs()[0], inputs[0], inputs[1], inputs[2], inputs[3]};
+  cunumeric::type_dispatch(args.lhs.code(), SpmmImpl<KIND>{}, args);
+}
+
+}  // namespace cunumeric
@@ -16,6 +16,7 @@
 
 #include "cunumeric/matrix/syrk.h"
 #include "cunumeric/matrix/syrk_template.inl"
+#include "cunumeric/matrix/util.h"
 
 #include <cblas.h>
 
@@ -25,33 +26,41 @@ using namespace Legion;
 using namespace legate;
 
 template <typename Syrk, typename VAL>
-static inline void syrk_template(Syrk syrk, VAL* lhs, const VAL* rhs, int32_t m, int32_t n)
+static inline void syrk_template(
+  Syrk syrk, VAL* lhs, const VAL* rhs, int32_t m, int32_t n, bool row_major)
 {
-  auto uplo  = CblasLower;
-  auto trans = CblasNoTrans;
+  // A row-major tile is the transpose of a column-major one, so the lower triangle of the
+  // row-major result is the upper triangle of rhs^H * rhs in column-major order
+  auto uplo  = row_major ? CblasUpper : CblasLower;
+  auto trans = row_major ? CblasConjTrans : CblasNoTrans;
+  auto lda   = row_major ? n : m;
 
-  syrk(CblasColMajor, uplo, trans, m, n, -1.0, rhs, m, 1.0, lhs, m);
+  syrk(CblasColMajor, uplo, trans, m, n, -1.0, rhs, lda, 1.0, lhs, m);
 }
 
 template <>
 struct SyrkImplBody<VariantKind::CPU, LegateTypeCode::FLOAT_LT> {
-  void operator()(float* lhs, const float* rhs, int32_t m, int32_t n)
+  void operator()(float* lhs, const float* rhs, int32_t m, int32_t n, bool row_major)
   {
-    syrk_template(cblas_ssyrk, lhs, rhs, m, n);
+    syrk_template(cblas_ssyrk, lhs, rhs, m, n, row_major);
   }
 };
 
 template <>
 struct SyrkImplBody<VariantKind::CPU, LegateTypeCode::DOUBLE_LT> {
-  void operator()(double* lhs, const double* rhs, int32_t m, int32_t n)
+  void operator()(double* lhs, const double* rhs, int32_t m, int32_t n, bool row_major)
   {
-    syrk_template(cblas_dsyrk, lhs, rhs, m, n);
+    syrk_template(cblas_dsyrk, lhs, rhs, m, n, row_major);
   }
 };
 
 template <>
 struct SyrkImplBody<VariantKind::CPU, LegateTypeCode::COMPLEX64_LT> {
-  void operator()(complex<float>* lhs_, const complex<float>* rhs_, int32_t m, int32_t n)
+  void operator()(complex<float>* lhs_,
+                  const complex<float>* rhs_,
+                  int32_t m,
+                  int32_t n,
+                  bool row_major)
   {
     auto lhs = reinterpret_cast<__complex__ float*>(lhs_);
     auto rhs = reinterpret_cast<const __complex__ float*>(rhs_);
@@ -60,26 +69,30 @@ struct SyrkImplBody<VariantKind::CPU, LegateTypeCode::COMPLEX64_LT> {
     //       as this task is used only for Cholesky factorization right now.
     //       (the complex64 version of syrk is csyrk)
     //       Will need to fix this once we start porting scipy.linalg
-    syrk_template(cblas_cherk, lhs, rhs, m, n);
+    syrk_template(cblas_cherk, lhs, rhs, m, n, row_major);
   }
 };
 
 template <>
 struct SyrkImplBody<VariantKind::CPU, LegateTypeCode::COMPLEX128_LT> {
-  void operator()(complex<double>* lhs_, const complex<double>* rhs_, int32_t m, int32_t n)
+  void operator()(complex<double>* lhs_,
+                  const complex<double>* rhs_,
+                  int32_t m,
+                  int32_t n,
+                  bool row_major)
   {
     auto lhs = reinterpret_cast<__complex__ double*>(lhs_);
     auto rhs = reinterpret_cast<const __complex__ double*>(rhs_);
 
     // TODO: the same problem here as in the complex64 case
-    syrk_template(cblas_zherk, lhs, rhs, m, n);
+    syrk_template(cblas_zherk, lhs, rhs, m, n, row_major);
   }
 };
 
 /*static*/ void SyrkTask::cpu_variant(TaskContext& context)
 {
 #ifdef LEGATE_USE_OPENMP
-  openblas_set_num_threads(1);  // make sure this isn't overzealous
+  BlasThreads blas_threads(1);
 #endif
   syrk_template<VariantKind::CPU>(context);
 }
@@ -25,58 +25,75 @@ using namespace Legion;
 using namespace legate;
 
 template <typename Syrk, typename VAL, typename CONS>
-static inline void syrk_template(
-  Syrk syrk, VAL* lhs, const VAL* rhs, int32_t m, int32_t n, CONS _fake_param_for_type_inference)
+static inline void syrk_template(Syrk syrk,
+                                 VAL* lhs,
+                                 const VAL* rhs,
+                                 int32_t m,
+                                 int32_t n,
+                                 bool row_major,
+                                 cublasOperation_t transposed,
+                                 CONS _fake_param_for_type_inference)
 {
   auto context = get_cublas();
   auto stream  = get_cached_stream();
   CHECK_CUBLAS(cublasSetStream(context, stream));
 
-  auto uplo  = CUBLAS_FILL_MODE_LOWER;
-  auto trans = CUBLAS_OP_N;
+  // A row-major tile is the transpose of a column-major one, so the lower triangle of the
+  // row-major result is the upper triangle of rhs^H * rhs in column-major order
+  auto uplo  = row_major ? CUBLAS_FILL_MODE_UPPER : CUBLAS_FILL_MODE_LOWER;
+  auto trans = row_major ? transposed : CUBLAS_OP_N;
+  auto lda   = row_major ? n : m;
   CONS alpha = -1.0;
   CONS beta  = 1.0;
 
-  syrk(context, uplo, trans, m, n, &alpha, rhs, m, &beta, lhs, m);
+  syrk(context, uplo, trans, m, n, &alpha, rhs, lda, &beta, lhs, m);
 }
 
 template <>
 struct SyrkImplBody<VariantKind::GPU, LegateTypeCode::FLOAT_LT> {
-  void operator()(float* lhs, const float* rhs, int32_t m, int32_t n)
+  void operator()(float* lhs, const float* rhs, int32_t m, int32_t n, bool row_major)
   {
-    syrk_template(cublasSsyrk, lhs, rhs, m, n, static_cast<float>(0));
+    syrk_template(cublasSsyrk, lhs, rhs, m, n, row_major, CUBLAS_OP_T, static_cast<float>(0));
   }
 };
 
 template <>
 struct SyrkImplBody<VariantKind::GPU, LegateTypeCode::DOUBLE_LT> {
-  void operator()(double* lhs, const double* rhs, int32_t m, int32_t n)
+  void operator()(double* lhs, const double* rhs, int32_t m, int32_t n, bool row_major)
   {
-    syrk_template(cublasDsyrk, lhs, rhs, m, n, static_cast<double>(0));
+    syrk_template(cublasDsyrk, lhs, rhs, m, n, row_major, CUBLAS_OP_T, static_cast<double>(0));
   }
 };
 
 template <>
 struct SyrkImplBody<VariantKind::GPU, LegateTypeCode::COMPLEX64_LT> {
-  void operator()(complex<float>* lhs_, const complex<float>* rhs_, int32_t m, int32_t n)
+  void operator()(complex<float>* lhs_,
+                  const complex<float>* rhs_,
+                  int32_t m,
+                  int32_t n,
+                  bool row_major)
   {
     auto lhs = reinterpret_cast<cuComplex*>(lhs_);
     auto rhs = reinterpret_cast<const cuComplex*>(rhs_);
 
-    syrk_template(cublasCherk, lhs, rhs, m, n, static_cast<float>(0));
+    syrk_template(cublasCherk, lhs, rhs, m, n, row_major, CUBLAS_OP_C, static_cast<float>(0));
   }
 };
 
 template <>
 struct SyrkImplBody<VariantKind::GPU, LegateTypeCode::COMPLEX128_LT> {
-  void operator()(complex<double>* lhs_, const complex<double>* rhs_, int32_t m, int32_t n)
+  void operator()(complex<double>* lhs_,
+                  const complex<double>* rhs_,
+                  int32_t m,
+                  int32_t n,
+                  bool row_major)
   {
     auto lhs = reinterpret_cast<cuDoubleComplex*>(lhs_);
     auto rhs = reinterpret_cast<const cuDoubleComplex*>(rhs_);
 
     // TODO: We're not actually calling syrk but calling hekr instead here,
     //       as this task is used only for Cholesky factorization.
-    syrk_template(cublasZherk, lhs, rhs, m, n, static_cast<double>(0));
+    syrk_template(cublasZherk, lhs, rhs, m, n, row_major, CUBLAS_OP_C, static_cast<double>(0));
   }
 };
 
@@ -41,7 +41,7 @@ struct support_syrk<LegateTypeCode::COMPLEX128_LT> : std::true_type {
 template <VariantKind KIND>
 struct SyrkImpl {
   template <LegateTypeCode CODE, std::enable_if_t<support_syrk<CODE>::value>* = nullptr>
-  void operator()(Array& lhs_array, Array& rhs_array) const
+  void operator()(Array& lhs_array, Array& rhs_array, bool row_major) const
   {
     using VAL = legate_type_of<CODE>;
 
@@ -60,11 +60,11 @@ struct SyrkImpl {
     auto n = static_cast<int32_t>(rhs_shape.hi[1] - rhs_shape.lo[1] + 1);
     assert(m > 0 && n > 0);
 
-    SyrkImplBody<KIND, CODE>()(lhs, rhs, m, n);
+    SyrkImplBody<KIND, CODE>()(lhs, rhs, m, n, row_major);
   }
 
   template <LegateTypeCode CODE, std::enable_if_t<!support_syrk<CODE>::value>* = nullptr>
-  void operator()(Array& lhs_array, Array& rhs_array) const
+  void operator()(Array& lhs_array, Array& rhs_array, bool row_major) const
   {
     assert(false);
   }
@@ -76,7 +76,9 @@ static void syrk_template(TaskContext& context)
   auto& lhs = context.outputs()[0];
   auto& rhs = context.inputs()[0];
 
-  type_dispatch(lhs.code(), SyrkImpl<KIND>{}, lhs, rhs);
+  auto row_major = context.scalars()[0].value<bool>();
+
+  cunumeric::type_dispatch(lhs.code(), SyrkImpl<KIND>{}, lhs, rhs, row_major);
 }
 
 }  // namespace cunumeric
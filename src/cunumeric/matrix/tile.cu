@@ -23,6 +23,10 @@ namespace cunumeric {
 
 using namespace Legion;
 
+// Up to this many rows of a dense output are tiled with device-to-device copies
+// instead of launching a kernel
+static constexpr size_t TILE_MAX_COPY_ROWS = 16;
+
 template <typename VAL, int32_t OUT_DIM, int32_t IN_DIM>
 __global__ static void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
   tile_kernel(const Rect<OUT_DIM> out_rect,
@@ -47,11 +51,25 @@ struct TileImplBody<VariantKind::GPU, VAL, OUT_DIM, IN_DIM> {
                   size_t out_volume,
                   const Point<IN_DIM>& in_strides,
                   const AccessorWO<VAL, OUT_DIM>& out,
-                  const AccessorRO<VAL, IN_DIM>& in) const
+                  const AccessorRO<VAL, IN_DIM>& in,
+                  bool dense) const
   {
+    auto stream = get_cached_stream();
+
+    const size_t rows = out_volume / (out_rect.hi[OUT_DIM - 1] - out_rect.lo[OUT_DIM - 1] + 1);
+    if (dense && rows <= TILE_MAX_COPY_ROWS) {
+      auto copy = [stream](VAL* dst, const VAL* src, size_t n) {
+        CHECK_CUDA(
+          cudaMemcpyAsync(dst, src, n * sizeof(VAL), cudaMemcpyDeviceToDevice, stream));
+      };
+      for (size_t row = 0; row < rows; ++row)
+        tile_dense_row(out_rect, out_pitches, row, in_strides, out, in, copy);
+      return;
+    }
+
     const size_t blocks = (out_volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
-    tile_kernel<VAL, OUT_DIM, IN_DIM>
-      <<<blocks, THREADS_PER_BLOCK>>>(out_rect, out_pitches, out_volume, in_strides, out, in);
+    tile_kernel<VAL, OUT_DIM, IN_DIM><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+      out_rect, out_pitches, out_volume, in_strides, out, in);
   }
 };
 
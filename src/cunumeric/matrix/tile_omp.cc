@@ -17,6 +17,8 @@
 #include "cunumeric/matrix/tile.h"
 #include "cunumeric/matrix/tile_template.inl"
 
+#include <cstring>
+
 namespace cunumeric {
 
 using namespace Legion;
@@ -29,8 +31,19 @@ struct TileImplBody<VariantKind::OMP, VAL, OUT_DIM, IN_DIM> {
                   size_t out_volume,
                   const Point<IN_DIM>& in_strides,
                   const AccessorWO<VAL, OUT_DIM>& out,
-                  const AccessorRO<VAL, IN_DIM>& in) const
+                  const AccessorRO<VAL, IN_DIM>& in,
+                  bool dense) const
   {
+    if (dense) {
+      auto copy = [](VAL* dst, const VAL* src, size_t n) {
+        std::memcpy(dst, src, n * sizeof(VAL));
+      };
+      const size_t rows = out_volume / (out_rect.hi[OUT_DIM - 1] - out_rect.lo[OUT_DIM - 1] + 1);
+#pragma omp parallel for schedule(static)
+      for (size_t row = 0; row < rows; ++row)
+        tile_dense_row(out_rect, out_pitches, row, in_strides, out, in, copy);
+      return;
+    }
 #pragma omp parallel for
     for (size_t out_idx = 0; out_idx < out_volume; ++out_idx) {
       const auto out_point = out_pitches.unflatten(out_idx, out_rect.lo);
@@ -31,6 +31,46 @@ __CUDA_HD__ inline Point<IN_DIM> get_tile_point(const Point<OUT_DIM>& point,
   return result;
 }
 
+// Writes length elements of a row that repeats the period elements at in, starting
+// at phase. Only the first period and a bit gets read from the input; the rest is
+// replicated from the output itself with copies that double in size each time.
+template <typename VAL, typename Copy>
+inline void tile_row(VAL* out, const VAL* in, size_t period, size_t phase, size_t length, Copy copy)
+{
+  const size_t first = std::min(period - phase, length);
+  copy(out, in + phase, first);
+  size_t done = first;
+  if (done < length) {
+    const size_t count = std::min(period, length - done);
+    copy(out + done, in, count);
+    done += count;
+  }
+  // Elements [first, done) now hold whole periods, so copying them keeps the phase
+  while (done < length) {
+    const size_t count = std::min(done - first, length - done);
+    copy(out + done, out + first, count);
+    done += count;
+  }
+}
+
+// Tiles the row-th innermost row of a dense output from a dense input
+template <typename VAL, int32_t OUT_DIM, int32_t IN_DIM, typename Copy>
+inline void tile_dense_row(const Rect<OUT_DIM>& out_rect,
+                           const Pitches<OUT_DIM - 1>& out_pitches,
+                           size_t row,
+                           const Point<IN_DIM>& in_strides,
+                           const AccessorWO<VAL, OUT_DIM>& out,
+                           const AccessorRO<VAL, IN_DIM>& in,
+                           Copy copy)
+{
+  const size_t length = out_rect.hi[OUT_DIM - 1] - out_rect.lo[OUT_DIM - 1] + 1;
+  const auto out_point = out_pitches.unflatten(row * length, out_rect.lo);
+  auto in_point        = get_tile_point(out_point, in_strides);
+  const size_t phase   = in_point[IN_DIM - 1];
+  in_point[IN_DIM - 1] = 0;
+  tile_row(out.ptr(out_point), in.ptr(in_point), in_strides[IN_DIM - 1], phase, length, copy);
+}
+
 template <VariantKind KIND, typename VAL, int32_t OUT_DIM, int32_t IN_DIM>
 struct TileImplBody;
 
@@ -51,8 +91,15 @@ struct TileImpl {
     auto out = args.out.write_accessor<VAL, OUT_DIM>();
     auto in  = args.in.read_accessor<VAL, IN_DIM>();
 
+#ifndef LEGION_BOUNDS_CHECKS
+    bool dense =
+      out.accessor.is_dense_row_major(out_rect) && in.accessor.is_dense_row_major(in_rect);
+#else
+    bool dense = false;
+#endif
+
     TileImplBody<KIND, VAL, OUT_DIM, IN_DIM>{}(
-      out_rect, out_pitches, out_volume, in_strides, out, in);
+      out_rect, out_pitches, out_volume, in_strides, out, in, dense);
   }
 
   template <int32_t OUT_DIM, int32_t IN_DIM, std::enable_if_t<!(IN_DIM <= OUT_DIM)>* = nullptr>
@@ -68,7 +115,7 @@ struct TileDispatch {
   void operator()(TileArgs& args) const
   {
     using VAL = legate_type_of<CODE>;
-    double_dispatch(args.out.dim(), args.in.dim(), TileImpl<KIND, VAL>{}, args);
+    cunumeric::double_dispatch(args.out.dim(), args.in.dim(), TileImpl<KIND, VAL>{}, args);
   }
 };
 
@@ -76,7 +123,7 @@ template <VariantKind KIND>
 static void tile_template(TaskContext& context)
 {
   TileArgs args{context.inputs()[0], context.outputs()[0]};
-  type_dispatch(args.in.code(), TileDispatch<KIND>{}, args);
+  cunumeric::type_dispatch(args.in.code(), TileDispatch<KIND>{}, args);
 }
 
 }  // namespace cunumeric
@@ -16,6 +16,8 @@
 
 #include "cunumeric/matrix/transpose.h"
 #include "cunumeric/matrix/transpose_template.inl"
+#include "cunumeric/matrix/transpose_blocks.h"
+#include "cunumeric/matrix/util.h"
 
 #ifdef LEGATE_USE_OPENMP
 #include "omp.h"
@@ -37,32 +39,16 @@ struct TransposeImplBody<VariantKind::CPU, CODE> {
                   const AccessorRO<VAL, 2>& in,
                   bool logical) const
   {
-    constexpr coord_t BF = 128 / sizeof(VAL);
-    if (logical)
-      for (auto i1 = in_rect.lo[0]; i1 <= in_rect.hi[0]; i1 += BF) {
-        for (auto j1 = in_rect.lo[1]; j1 <= in_rect.hi[1]; j1 += BF) {
-          const auto max_i2 = ((i1 + BF) <= in_rect.hi[0]) ? i1 + BF : in_rect.hi[0];
-          const auto max_j2 = ((j1 + BF) <= in_rect.hi[1]) ? j1 + BF : in_rect.hi[1];
-          for (auto i2 = i1; i2 <= max_i2; i2++)
-            for (auto j2 = j1; j2 <= max_j2; j2++) out[j2][i2] = in[i2][j2];
-        }
-      }
-    else
-      for (auto i1 = in_rect.lo[0]; i1 <= in_rect.hi[0]; i1 += BF) {
-        for (auto j1 = in_rect.lo[1]; j1 <= in_rect.hi[1]; j1 += BF) {
-          const auto max_i2 = ((i1 + BF) <= in_rect.hi[0]) ? i1 + BF : in_rect.hi[0];
-          const auto max_j2 = ((j1 + BF) <= in_rect.hi[1]) ? j1 + BF : in_rect.hi[1];
-          for (auto i2 = i1; i2 <= max_i2; i2++)
-            for (auto j2 = j1; j2 <= max_j2; j2++) out[i2][j2] = in[i2][j2];
-        }
-      }
+    const auto blocks  = make_transpose_blocks(out_rect, in_rect, out, in, logical);
+    const size_t items = blocks.items();
+    for (size_t item = 0; item < items; ++item) blocks.copy(item);
   }
 };
 
 /*static*/ void TransposeTask::cpu_variant(TaskContext& context)
 {
 #ifdef LEGATE_USE_OPENMP
-  openblas_set_num_threads(1);  // make sure this isn't overzealous
+  BlasThreads blas_threads(1);
 #endif
   transpose_template<VariantKind::CPU>(context);
 }
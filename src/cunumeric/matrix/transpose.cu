@@ -148,6 +148,8 @@ struct TransposeImplBody<VariantKind::GPU, CODE> {
                   const AccessorRO<VAL, 2>& in,
                   bool logical) const
   {
+    auto stream = get_cached_stream();
+
     const coord_t m = (in_rect.hi[0] - in_rect.lo[0]) + 1;
     const coord_t n = (in_rect.hi[1] - in_rect.lo[1]) + 1;
     const dim3 blocks((n + TILE_DIM - 1) / TILE_DIM, (m + TILE_DIM - 1) / TILE_DIM, 1);
@@ -155,10 +157,10 @@ struct TransposeImplBody<VariantKind::GPU, CODE> {
 
     if (logical)
       transpose_2d_logical<VAL>
-        <<<blocks, threads>>>(out, in, in_rect.lo, in_rect.hi, out_rect.lo, out_rect.hi);
+        <<<blocks, threads, 0, stream>>>(out, in, in_rect.lo, in_rect.hi, out_rect.lo, out_rect.hi);
     else
       transpose_2d_physical<VAL>
-        <<<blocks, threads>>>(out, in, in_rect.lo, in_rect.hi, out_rect.lo, out_rect.hi);
+        <<<blocks, threads, 0, stream>>>(out, in, in_rect.lo, in_rect.hi, out_rect.lo, out_rect.hi);
   }
 };
 
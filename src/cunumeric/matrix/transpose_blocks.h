@@ -0,0 +1,289 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "legate.h"
+#include "cunumeric/simd.h"
+
+#include <algorithm>
+#include <type_traits>
+#ifdef CUNUMERIC_SIMD_DISPATCH
+#include <immintrin.h>
+#endif
+
+namespace cunumeric {
+
+namespace detail {
+
+// Transposes a MB x MB block of a matrix whose rows are ls elements apart into one whose
+// rows are ld elements apart. Blocks of 4 and 8 byte elements are shuffled in registers
+// when the processor has AVX; element types are only moved, so any type of that size can
+// reuse the float and double shuffles.
+template <typename VAL>
+struct TransposeMicroKernel {
+  static constexpr coord_t MB = 8;
+
+  static void transpose(VAL* dst, size_t ld, const VAL* src, size_t ls, simd::Level)
+  {
+    for (coord_t j = 0; j < MB; ++j)
+      for (coord_t i = 0; i < MB; ++i) dst[j * ld + i] = src[i * ls + j];
+  }
+};
+
+#ifdef CUNUMERIC_SIMD_DISPATCH
+CUNUMERIC_TARGET_AVX2 inline void transpose_8x8_avx(float* dst,
+                                                    size_t ld,
+                                                    const float* src,
+                                                    size_t ls)
+{
+  __m256 r0 = _mm256_loadu_ps(src + 0 * ls);
+  __m256 r1 = _mm256_loadu_ps(src + 1 * ls);
+  __m256 r2 = _mm256_loadu_ps(src + 2 * ls);
+  __m256 r3 = _mm256_loadu_ps(src + 3 * ls);
+  __m256 r4 = _mm256_loadu_ps(src + 4 * ls);
+  __m256 r5 = _mm256_loadu_ps(src + 5 * ls);
+  __m256 r6 = _mm256_loadu_ps(src + 6 * ls);
+  __m256 r7 = _mm256_loadu_ps(src + 7 * ls);
+
+  // Interleave pairs of rows, then pairs of pairs within each 128-bit lane, and finally
+  // swap the lanes to bring the halves of each column together
+  const __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+  const __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+  const __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+  const __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+  const __m256 t4 = _mm256_unpacklo_ps(r4, r5);
+  const __m256 t5 = _mm256_unpackhi_ps(r4, r5);
+  const __m256 t6 = _mm256_unpacklo_ps(r6, r7);
+  const __m256 t7 = _mm256_unpackhi_ps(r6, r7);
+
+  const __m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+  const __m256 s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+  const __m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+  const __m256 s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+  const __m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+  const __m256 s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+  const __m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+  const __m256 s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+
+  r0 = _mm256_permute2f128_ps(s0, s4, 0x20);
+  r1 = _mm256_permute2f128_ps(s1, s5, 0x20);
+  r2 = _mm256_permute2f128_ps(s2, s6, 0x20);
+  r3 = _mm256_permute2f128_ps(s3, s7, 0x20);
+  r4 = _mm256_permute2f128_ps(s0, s4, 0x31);
+  r5 = _mm256_permute2f128_ps(s1, s5, 0x31);
+  r6 = _mm256_permute2f128_ps(s2, s6, 0x31);
+  r7 = _mm256_permute2f128_ps(s3, s7, 0x31);
+
+  _mm256_storeu_ps(dst + 0 * ld, r0);
+  _mm256_storeu_ps(dst + 1 * ld, r1);
+  _mm256_storeu_ps(dst + 2 * ld, r2);
+  _mm256_storeu_ps(dst + 3 * ld, r3);
+  _mm256_storeu_ps(dst + 4 * ld, r4);
+  _mm256_storeu_ps(dst + 5 * ld, r5);
+  _mm256_storeu_ps(dst + 6 * ld, r6);
+  _mm256_storeu_ps(dst + 7 * ld, r7);
+}
+
+CUNUMERIC_TARGET_AVX2 inline void transpose_4x4_avx(double* dst,
+                                                    size_t ld,
+                                                    const double* src,
+                                                    size_t ls)
+{
+  const __m256d r0 = _mm256_loadu_pd(src + 0 * ls);
+  const __m256d r1 = _mm256_loadu_pd(src + 1 * ls);
+  const __m256d r2 = _mm256_loadu_pd(src + 2 * ls);
+  const __m256d r3 = _mm256_loadu_pd(src + 3 * ls);
+
+  const __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+  const __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+  const __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+  const __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+
+  _mm256_storeu_pd(dst + 0 * ld, _mm256_permute2f128_pd(t0, t2, 0x20));
+  _mm256_storeu_pd(dst + 1 * ld, _mm256_permute2f128_pd(t1, t3, 0x20));
+  _mm256_storeu_pd(dst + 2 * ld, _mm256_permute2f128_pd(t0, t2, 0x31));
+  _mm256_storeu_pd(dst + 3 * ld, _mm256_permute2f128_pd(t1, t3, 0x31));
+}
+#endif
+
+template <typename VAL>
+struct TransposeMicroKernel4 {
+  static constexpr coord_t MB = 8;
+
+  static void transpose(VAL* dst, size_t ld, const VAL* src, size_t ls, simd::Level level)
+  {
+#ifdef CUNUMERIC_SIMD_DISPATCH
+    if (level != simd::Level::GENERIC) {
+      transpose_8x8_avx(reinterpret_cast<float*>(dst),
+                        ld,
+                        reinterpret_cast<const float*>(src),
+                        ls);
+      return;
+    }
+#endif
+    TransposeMicroKernel<VAL>::transpose(dst, ld, src, ls, level);
+  }
+};
+
+template <typename VAL>
+struct TransposeMicroKernel8 {
+  static constexpr coord_t MB = 8;
+
+  static void transpose(VAL* dst, size_t ld, const VAL* src, size_t ls, simd::Level level)
+  {
+#ifdef CUNUMERIC_SIMD_DISPATCH
+    if (level != simd::Level::GENERIC) {
+      // An 8 x 8 block is four 4 x 4 blocks, with the off-diagonal ones swapped
+      for (coord_t j = 0; j < MB; j += 4)
+        for (coord_t i = 0; i < MB; i += 4)
+          transpose_4x4_avx(reinterpret_cast<double*>(dst + j * ld + i),
+                            ld,
+                            reinterpret_cast<const double*>(src + i * ls + j),
+                            ls);
+      return;
+    }
+#endif
+    TransposeMicroKernel<VAL>::transpose(dst, ld, src, ls, level);
+  }
+};
+
+template <typename VAL>
+using transpose_micro_kernel_t =
+  std::conditional_t<sizeof(VAL) == 4,
+                     TransposeMicroKernel4<VAL>,
+                     std::conditional_t<sizeof(VAL) == 8,
+                                        TransposeMicroKernel8<VAL>,
+                                        TransposeMicroKernel<VAL>>>;
+
+}  // namespace detail
+
+// Blocked transposes on the CPU, shared by the CPU and OpenMP variants. Element (i, j) of
+// the source moves to the target offset i * out_i + j * out_j, which covers both logical
+// transposes and copies into an instance of the opposite layout. The matrix is split into
+// square tiles of TILE x TILE elements that fit in the L1 cache along with their target,
+// and each tile into MB x MB blocks that are transposed in registers. Tiles are numbered
+// along the contiguous axis of the target first, so that a static split of the items
+// gives each thread a band of the target that it alone writes.
+template <typename VAL>
+struct TransposeBlocks {
+  using MicroKernel = detail::transpose_micro_kernel_t<VAL>;
+
+  static constexpr coord_t MB   = MicroKernel::MB;
+  static constexpr coord_t TILE = sizeof(VAL) <= 2 ? 64 : (sizeof(VAL) <= 8 ? 32 : 16);
+
+  TransposeBlocks(VAL* out,
+                  size_t out_i,
+                  size_t out_j,
+                  const VAL* in,
+                  size_t in_i,
+                  size_t in_j,
+                  coord_t rows,
+                  coord_t cols)
+    : out(out),
+      out_i(out_i),
+      out_j(out_j),
+      in(in),
+      in_i(in_i),
+      in_j(in_j),
+      rows(rows),
+      cols(cols),
+      level(simd::level())
+  {
+    tiles_i = (rows + TILE - 1) / TILE;
+    tiles_j = (cols + TILE - 1) / TILE;
+  }
+
+  size_t items() const { return tiles_i * tiles_j; }
+
+  void copy(size_t item) const
+  {
+    // The target is contiguous along the rows of the source when out_i is the smaller step
+    coord_t tile_i, tile_j;
+    if (out_i <= out_j) {
+      tile_i = item % tiles_i;
+      tile_j = item / tiles_i;
+    } else {
+      tile_i = item / tiles_j;
+      tile_j = item % tiles_j;
+    }
+    const coord_t lo_i = tile_i * TILE;
+    const coord_t lo_j = tile_j * TILE;
+    const coord_t hi_i = std::min(lo_i + TILE, rows);
+    const coord_t hi_j = std::min(lo_j + TILE, cols);
+
+    if (in_j == 1 && out_i == 1)
+      transpose_tile(lo_i, hi_i, lo_j, hi_j);
+    else if (in_j == 1 && out_j == 1)
+      for (coord_t i = lo_i; i < hi_i; ++i)
+        std::copy(in + i * in_i + lo_j, in + i * in_i + hi_j, out + i * out_i + lo_j);
+    else
+      for (coord_t i = lo_i; i < hi_i; ++i)
+        for (coord_t j = lo_j; j < hi_j; ++j) out[i * out_i + j * out_j] = in[i * in_i + j * in_j];
+  }
+
+  // Transposes a tile of a row-major source into a column-major target
+  void transpose_tile(coord_t lo_i, coord_t hi_i, coord_t lo_j, coord_t hi_j) const
+  {
+    const coord_t full_i = lo_i + (hi_i - lo_i) / MB * MB;
+    const coord_t full_j = lo_j + (hi_j - lo_j) / MB * MB;
+    for (coord_t j = lo_j; j < full_j; j += MB)
+      for (coord_t i = lo_i; i < full_i; i += MB)
+        MicroKernel::transpose(out + j * out_j + i, out_j, in + i * in_i + j, in_i, level);
+
+    // The ragged edges of the tile are moved one element at a time
+    for (coord_t j = lo_j; j < hi_j; ++j) {
+      const coord_t from_i = j < full_j ? full_i : lo_i;
+      for (coord_t i = from_i; i < hi_i; ++i) out[j * out_j + i] = in[i * in_i + j];
+    }
+  }
+
+  VAL* out;
+  size_t out_i;
+  size_t out_j;
+  const VAL* in;
+  size_t in_i;
+  size_t in_j;
+  coord_t rows;
+  coord_t cols;
+  simd::Level level;
+  size_t tiles_i;
+  size_t tiles_j;
+};
+
+// Sets up the blocks of a transpose task. A logical transpose writes in[i][j] to
+// out[j][i] and a physical one to out[i][j] of a target with the opposite layout.
+template <typename VAL>
+TransposeBlocks<VAL> make_transpose_blocks(const Legion::Rect<2>& out_rect,
+                                           const Legion::Rect<2>& in_rect,
+                                           const legate::AccessorWO<VAL, 2>& out,
+                                           const legate::AccessorRO<VAL, 2>& in,
+                                           bool logical)
+{
+  size_t out_strides[2];
+  size_t in_strides[2];
+  auto out_ptr = out.ptr(out_rect, out_strides);
+  auto in_ptr  = in.ptr(in_rect, in_strides);
+
+  const coord_t rows = in_rect.hi[0] - in_rect.lo[0] + 1;
+  const coord_t cols = in_rect.hi[1] - in_rect.lo[1] + 1;
+  const size_t out_i = logical ? out_strides[1] : out_strides[0];
+  const size_t out_j = logical ? out_strides[0] : out_strides[1];
+  return TransposeBlocks<VAL>(
+  out_ptr, out_i, out_j, in_ptr, in_strides[0], in_strides[1], rows, cols);
+}
+
+}  // namespace cunumeric
@@ -54,7 +54,7 @@ static void transpose_template(TaskContext& context)
   auto logical = context.scalars()[0].value<bool>();
 
   TransposeArgs args{output, input, logical};
-  type_dispatch(input.code(), TransposeImpl<KIND>{}, args);
+  cunumeric::type_dispatch(input.code(), TransposeImpl<KIND>{}, args);
 }
 
 }  // namespace cunumeric
@@ -62,8 +62,11 @@ struct TriluImplBody<VariantKind::GPU, CODE, DIM, LOWER> {
                   size_t volume,
                   int32_t k) const
   {
+    auto stream = get_cached_stream();
+
     const size_t blocks = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
-    trilu_kernel<VAL, DIM, LOWER><<<blocks, THREADS_PER_BLOCK>>>(out, in, pitches, lo, volume, k);
+    trilu_kernel<VAL, DIM, LOWER><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+      out, in, pitches, lo, volume, k);
   }
 };
 
@@ -62,7 +62,7 @@ static void trilu_template(TaskContext& context)
   auto& input   = context.inputs()[0];
   auto& output  = context.outputs()[0];
   TriluArgs args{lower, k, output, input};
-  double_dispatch(args.output.dim(), args.output.code(), TriluImpl<KIND>{}, args);
+  cunumeric::double_dispatch(args.output.dim(), args.output.code(), TriluImpl<KIND>{}, args);
 }
 
 }  // namespace cunumeric
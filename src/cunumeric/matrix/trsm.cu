@@ -26,56 +26,64 @@ using namespace legate;
 
 template <typename Trsm, typename VAL>
 static inline void trsm_template(
-  Trsm trsm, VAL* lhs, const VAL* rhs, int32_t m, int32_t n, VAL alpha)
+  Trsm trsm, VAL* lhs, const VAL* rhs, int32_t m, int32_t n, const TrsmOptions& options, VAL alpha)
 {
   auto context = get_cublas();
   auto stream  = get_cached_stream();
   CHECK_CUBLAS(cublasSetStream(context, stream));
 
-  // TODO: We need to expose these parameters to the API later we port scipy.linalg
-  auto side   = CUBLAS_SIDE_RIGHT;
-  auto uplo   = CUBLAS_FILL_MODE_LOWER;
-  auto transa = CUBLAS_OP_C;
-  auto diag   = CUBLAS_DIAG_NON_UNIT;
+  auto side   = options.left ? CUBLAS_SIDE_LEFT : CUBLAS_SIDE_RIGHT;
+  auto uplo   = options.lower ? CUBLAS_FILL_MODE_LOWER : CUBLAS_FILL_MODE_UPPER;
+  auto transa = options.transpose ? CUBLAS_OP_C : CUBLAS_OP_N;
+  auto diag   = options.unit_diagonal ? CUBLAS_DIAG_UNIT : CUBLAS_DIAG_NON_UNIT;
+  auto lda    = options.left ? m : n;
 
-  trsm(context, side, uplo, transa, diag, m, n, &alpha, rhs, n, lhs, m);
+  trsm(context, side, uplo, transa, diag, m, n, &alpha, rhs, lda, lhs, m);
 }
 
 template <>
 struct TrsmImplBody<VariantKind::GPU, LegateTypeCode::FLOAT_LT> {
-  void operator()(float* lhs, const float* rhs, int32_t m, int32_t n)
+  void operator()(float* lhs, const float* rhs, int32_t m, int32_t n, const TrsmOptions& options)
   {
-    trsm_template(cublasStrsm, lhs, rhs, m, n, 1.0F);
+    trsm_template(cublasStrsm, lhs, rhs, m, n, options, 1.0F);
   }
 };
 
 template <>
 struct TrsmImplBody<VariantKind::GPU, LegateTypeCode::DOUBLE_LT> {
-  void operator()(double* lhs, const double* rhs, int32_t m, int32_t n)
+  void operator()(double* lhs, const double* rhs, int32_t m, int32_t n, const TrsmOptions& options)
   {
-    trsm_template(cublasDtrsm, lhs, rhs, m, n, 1.0);
+    trsm_template(cublasDtrsm, lhs, rhs, m, n, options, 1.0);
   }
 };
 
 template <>
 struct TrsmImplBody<VariantKind::GPU, LegateTypeCode::COMPLEX64_LT> {
-  void operator()(complex<float>* lhs_, const complex<float>* rhs_, int32_t m, int32_t n)
+  void operator()(complex<float>* lhs_,
+                  const complex<float>* rhs_,
+                  int32_t m,
+                  int32_t n,
+                  const TrsmOptions& options)
   {
     auto lhs = reinterpret_cast<cuComplex*>(lhs_);
     auto rhs = reinterpret_cast<const cuComplex*>(rhs_);
 
-    trsm_template(cublasCtrsm, lhs, rhs, m, n, make_float2(1.0, 0.0));
+    trsm_template(cublasCtrsm, lhs, rhs, m, n, options, make_float2(1.0, 0.0));
   }
 };
 
 template <>
 struct TrsmImplBody<VariantKind::GPU, LegateTypeCode::COMPLEX128_LT> {
-  void operator()(complex<double>* lhs_, const complex<double>* rhs_, int32_t m, int32_t n)
+  void operator()(complex<double>* lhs_,
+                  const complex<double>* rhs_,
+                  int32_t m,
+                  int32_t n,
+                  const TrsmOptions& options)
   {
     auto lhs = reinterpret_cast<cuDoubleComplex*>(lhs_);
     auto rhs = reinterpret_cast<const cuDoubleComplex*>(rhs_);
 
-    trsm_template(cublasZtrsm, lhs, rhs, m, n, make_double2(1.0, 0.0));
+    trsm_template(cublasZtrsm, lhs, rhs, m, n, options, make_double2(1.0, 0.0));
   }
 };
 
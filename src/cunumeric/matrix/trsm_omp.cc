@@ -16,6 +16,7 @@
 
 #include "cunumeric/matrix/trsm.h"
 #include "cunumeric/matrix/trsm_template.inl"
+#include "cunumeric/matrix/util.h"
 
 #include <cblas.h>
 #include <lapack.h>
@@ -27,70 +28,82 @@ using namespace Legion;
 using namespace legate;
 
 template <typename Trsm, typename VAL>
-static inline void trsm_template(Trsm trsm, VAL* lhs, const VAL* rhs, int32_t m, int32_t n)
+static inline void trsm_template(
+  Trsm trsm, VAL* lhs, const VAL* rhs, int32_t m, int32_t n, const TrsmOptions& options)
 {
-  auto side   = CblasRight;
-  auto uplo   = CblasLower;
-  auto transa = CblasTrans;
-  auto diag   = CblasNonUnit;
+  auto side   = options.left ? CblasLeft : CblasRight;
+  auto uplo   = options.lower ? CblasLower : CblasUpper;
+  auto transa = options.transpose ? CblasTrans : CblasNoTrans;
+  auto diag   = options.unit_diagonal ? CblasUnit : CblasNonUnit;
+  auto lda    = options.left ? m : n;
 
-  trsm(CblasColMajor, side, uplo, transa, diag, m, n, 1.0, rhs, n, lhs, m);
+  trsm(CblasColMajor, side, uplo, transa, diag, m, n, 1.0, rhs, lda, lhs, m);
 }
 
 template <typename Trsm, typename VAL>
-static inline void complex_trsm_template(Trsm trsm, VAL* lhs, const VAL* rhs, int32_t m, int32_t n)
+static inline void complex_trsm_template(
+  Trsm trsm, VAL* lhs, const VAL* rhs, int32_t m, int32_t n, const TrsmOptions& options)
 {
-  auto side   = CblasRight;
-  auto uplo   = CblasLower;
-  auto transa = CblasConjTrans;
-  auto diag   = CblasNonUnit;
+  auto side   = options.left ? CblasLeft : CblasRight;
+  auto uplo   = options.lower ? CblasLower : CblasUpper;
+  auto transa = options.transpose ? CblasConjTrans : CblasNoTrans;
+  auto diag   = options.unit_diagonal ? CblasUnit : CblasNonUnit;
+  auto lda    = options.left ? m : n;
 
   VAL alpha = 1.0;
 
-  trsm(CblasColMajor, side, uplo, transa, diag, m, n, &alpha, rhs, n, lhs, m);
+  trsm(CblasColMajor, side, uplo, transa, diag, m, n, &alpha, rhs, lda, lhs, m);
 }
 
 template <>
 struct TrsmImplBody<VariantKind::CPU, LegateTypeCode::FLOAT_LT> {
-  void operator()(float* lhs, const float* rhs, int32_t m, int32_t n)
+  void operator()(float* lhs, const float* rhs, int32_t m, int32_t n, const TrsmOptions& options)
   {
-    trsm_template(cblas_strsm, lhs, rhs, m, n);
+    trsm_template(cblas_strsm, lhs, rhs, m, n, options);
   }
 };
 
 template <>
 struct TrsmImplBody<VariantKind::CPU, LegateTypeCode::DOUBLE_LT> {
-  void operator()(double* lhs, const double* rhs, int32_t m, int32_t n)
+  void operator()(double* lhs, const double* rhs, int32_t m, int32_t n, const TrsmOptions& options)
   {
-    trsm_template(cblas_dtrsm, lhs, rhs, m, n);
+    trsm_template(cblas_dtrsm, lhs, rhs, m, n, options);
   }
 };
 
 template <>
 struct TrsmImplBody<VariantKind::CPU, LegateTypeCode::COMPLEX64_LT> {
-  void operator()(complex<float>* lhs_, const complex<float>* rhs_, int32_t m, int32_t n)
+  void operator()(complex<float>* lhs_,
+                  const complex<float>* rhs_,
+                  int32_t m,
+                  int32_t n,
+                  const TrsmOptions& options)
   {
     auto lhs = reinterpret_cast<__complex__ float*>(lhs_);
     auto rhs = reinterpret_cast<const __complex__ float*>(rhs_);
 
-    complex_trsm_template(cblas_ctrsm, lhs, rhs, m, n);
+    complex_trsm_template(cblas_ctrsm, lhs, rhs, m, n, options);
   }
 };
 
 template <>
 struct TrsmImplBody<VariantKind::CPU, LegateTypeCode::COMPLEX128_LT> {
-  void operator()(complex<double>* lhs_, const complex<double>* rhs_, int32_t m, int32_t n)
+  void operator()(complex<double>* lhs_,
+                  const complex<double>* rhs_,
+                  int32_t m,
+                  int32_t n,
+                  const TrsmOptions& options)
   {
     auto lhs = reinterpret_cast<__complex__ double*>(lhs_);
     auto rhs = reinterpret_cast<const __complex__ double*>(rhs_);
 
-    complex_trsm_template(cblas_ztrsm, lhs, rhs, m, n);
+    complex_trsm_template(cblas_ztrsm, lhs, rhs, m, n, options);
   }
 };
 
 /*static*/ void TrsmTask::omp_variant(TaskContext& context)
 {
-  openblas_set_num_threads(omp_get_max_threads());
+  BlasThreads blas_threads(omp_get_max_threads());
   trsm_template<VariantKind::CPU>(context);
 }
 
@@ -19,6 +19,18 @@ namespace cunumeric {
 using namespace Legion;
 using namespace legate;
 
+// Which triangular system a TRSM solves. The Cholesky decomposition uses a right-side
+// solve with the transpose of a lower triangular tile, while the LU decomposition needs
+// the other combinations. For complex types, transpose means the conjugate transpose.
+// The bodies assume column-major tiles; row_major says the tiles are laid out in C order.
+struct TrsmOptions {
+  bool left;
+  bool lower;
+  bool transpose;
+  bool unit_diagonal;
+  bool row_major;
+};
+
 template <VariantKind KIND, LegateTypeCode CODE>
 struct TrsmImplBody;
 
@@ -41,7 +53,7 @@ struct support_trsm<LegateTypeCode::COMPLEX128_LT> : std::true_type {
 template <VariantKind KIND>
 struct TrsmImpl {
   template <LegateTypeCode CODE, std::enable_if_t<support_trsm<CODE>::value>* = nullptr>
-  void operator()(Array& lhs_array, Array& rhs_array) const
+  void operator()(Array& lhs_array, Array& rhs_array, const TrsmOptions& options) const
   {
     using VAL = legate_type_of<CODE>;
 
@@ -60,11 +72,19 @@ struct TrsmImpl {
     auto n = static_cast<int32_t>(lhs_shape.hi[1] - lhs_shape.lo[1] + 1);
     assert(m > 0 && n > 0);
 
-    TrsmImplBody<KIND, CODE>()(lhs, rhs, m, n);
+    if (options.row_major) {
+      // A row-major tile is the transpose of a column-major one. Transposing op(A) X = B
+      // gives X^T op(A)^T = B^T, so the same solve is the column-major one on the other
+      // side with the other triangle of the (transposed) diagonal tile
+      TrsmOptions flipped{
+        !options.left, !options.lower, options.transpose, options.unit_diagonal, false};
+      TrsmImplBody<KIND, CODE>()(lhs, rhs, n, m, flipped);
+    } else
+      TrsmImplBody<KIND, CODE>()(lhs, rhs, m, n, options);
   }
 
   template <LegateTypeCode CODE, std::enable_if_t<!support_trsm<CODE>::value>* = nullptr>
-  void operator()(Array& lhs_array, Array& rhs_array) const
+  void operator()(Array& lhs_array, Array& rhs_array, const TrsmOptions& options) const
   {
     assert(false);
   }
@@ -76,7 +96,14 @@ static void trsm_template(TaskContext& context)
   auto& lhs = context.outputs()[0];
   auto& rhs = context.inputs()[0];
 
-  type_dispatch(lhs.code(), TrsmImpl<KIND>{}, lhs, rhs);
+  auto& scalars = context.scalars();
+  TrsmOptions options{scalars[0].value<bool>(),
+                      scalars[1].value<bool>(),
+                      scalars[2].value<bool>(),
+                      scalars[3].value<bool>(),
+                      scalars[4].value<bool>()};
+
+  cunumeric::type_dispatch(lhs.code(), TrsmImpl<KIND>{}, lhs, rhs, options);
 }
 
 }  // namespace cunumeric
@@ -16,11 +16,55 @@
 
 #include "legion.h"
 #include "cunumeric/matrix/util.h"
+#include "cunumeric/matrix/half_gemm.inl"
+#include "cunumeric/matrix/int8_gemm.inl"
+
+#include <condition_variable>
+#include <mutex>
 
 namespace cunumeric {
 
 using namespace Legion;
 
+namespace  // unnamed
+{
+
+std::mutex blas_mutex;
+std::condition_variable blas_released;
+// The number of threads BLAS is set to and the number of guards that hold it
+int32_t blas_threads = 0;
+int32_t blas_holders = 0;
+// Set while a task waits for another number of threads than the holders use, which keeps
+// new tasks from joining them so that the waiting one gets its turn
+bool blas_draining = false;
+
+}  // namespace
+
+BlasThreads::BlasThreads(int32_t num_threads)
+{
+  std::unique_lock<std::mutex> lock(blas_mutex);
+  while (blas_holders > 0 && (blas_threads != num_threads || blas_draining)) {
+    if (blas_threads != num_threads) blas_draining = true;
+    blas_released.wait(lock);
+  }
+  if (blas_threads != num_threads) {
+    openblas_set_num_threads(num_threads);
+    blas_threads = num_threads;
+  }
+  ++blas_holders;
+  // The tasks still waiting raise the flag again if they want another number
+  if (blas_draining) {
+    blas_draining = false;
+    blas_released.notify_all();
+  }
+}
+
+BlasThreads::~BlasThreads()
+{
+  std::lock_guard<std::mutex> lock(blas_mutex);
+  if (--blas_holders == 0) blas_released.notify_all();
+}
+
 float* allocate_buffer(size_t size)
 {
   Rect<1> bounds(0, size - 1);
@@ -51,4 +95,258 @@ void float_matrix_to_half(__half* out, const float* ptr, size_t m, size_t n, siz
     for (unsigned j = 0; j < n; j++) out[i * pitch + j] = ptr[i * n + j];
 }
 
+// A product with a single column is a matrix-vector product; gemv streams the matrix
+// once and skips the packing gemm does for its panels. The column is read with the
+// stride gemm would use for it and the result is written down the column of lhs.
+static void gemv_column(size_t m,
+                        size_t k,
+                        float* lhs,
+                        const float* rhs1,
+                        const float* rhs2,
+                        size_t lhs_stride,
+                        size_t rhs1_stride,
+                        size_t rhs2_stride,
+                        bool rhs1_transposed,
+                        bool rhs2_transposed)
+{
+  cblas_sgemv(CblasRowMajor,
+              rhs1_transposed ? CblasTrans : CblasNoTrans,
+              rhs1_transposed ? k : m,
+              rhs1_transposed ? m : k,
+              1,
+              rhs1,
+              rhs1_stride,
+              rhs2,
+              rhs2_transposed ? 1 : rhs2_stride,
+              0,
+              lhs,
+              lhs_stride);
+}
+
+static void gemv_column(size_t m,
+                        size_t k,
+                        double* lhs,
+                        const double* rhs1,
+                        const double* rhs2,
+                        size_t lhs_stride,
+                        size_t rhs1_stride,
+                        size_t rhs2_stride,
+                        bool rhs1_transposed,
+                        bool rhs2_transposed)
+{
+  cblas_dgemv(CblasRowMajor,
+              rhs1_transposed ? CblasTrans : CblasNoTrans,
+              rhs1_transposed ? k : m,
+              rhs1_transposed ? m : k,
+              1,
+              rhs1,
+              rhs1_stride,
+              rhs2,
+              rhs2_transposed ? 1 : rhs2_stride,
+              0,
+              lhs,
+              lhs_stride);
+}
+
+void gemm(size_t m,
+          size_t n,
+          size_t k,
+          float* lhs,
+          const float* rhs1,
+          const float* rhs2,
+          size_t lhs_stride,
+          size_t rhs1_stride,
+          size_t rhs2_stride,
+          bool rhs1_transposed,
+          bool rhs2_transposed)
+{
+  if (n == 1) {
+    gemv_column(m,
+                k,
+                lhs,
+                rhs1,
+                rhs2,
+                lhs_stride,
+                rhs1_stride,
+                rhs2_stride,
+                rhs1_transposed,
+                rhs2_transposed);
+    return;
+  }
+  cblas_sgemm(CblasRowMajor,
+              rhs1_transposed ? CblasTrans : CblasNoTrans,
+              rhs2_transposed ? CblasTrans : CblasNoTrans,
+              m,
+              n,
+              k,
+              1,
+              rhs1,
+              rhs1_stride,
+              rhs2,
+              rhs2_stride,
+              0,
+              lhs,
+              lhs_stride);
+}
+
+void gemm(size_t m,
+          size_t n,
+          size_t k,
+          double* lhs,
+          const double* rhs1,
+          const double* rhs2,
+          size_t lhs_stride,
+          size_t rhs1_stride,
+          size_t rhs2_stride,
+          bool rhs1_transposed,
+          bool rhs2_transposed)
+{
+  if (n == 1) {
+    gemv_column(m,
+                k,
+                lhs,
+                rhs1,
+                rhs2,
+                lhs_stride,
+                rhs1_stride,
+                rhs2_stride,
+                rhs1_transposed,
+                rhs2_transposed);
+    return;
+  }
+  cblas_dgemm(CblasRowMajor,
+              rhs1_transposed ? CblasTrans : CblasNoTrans,
+              rhs2_transposed ? CblasTrans : CblasNoTrans,
+              m,
+              n,
+              k,
+              1,
+              rhs1,
+              rhs1_stride,
+              rhs2,
+              rhs2_stride,
+              0,
+              lhs,
+              lhs_stride);
+}
+
+void half_gemm(size_t m,
+               size_t n,
+               size_t k,
+               float* lhs,
+               const __half* rhs1,
+               const __half* rhs2,
+               size_t lhs_stride,
+               size_t rhs1_stride,
+               size_t rhs2_stride,
+               bool rhs1_transposed,
+               bool rhs2_transposed)
+{
+  detail::blocked_half_gemm(m,
+                            n,
+                            k,
+                            lhs,
+                            rhs1,
+                            rhs2,
+                            lhs_stride,
+                            rhs1_stride,
+                            rhs2_stride,
+                            rhs1_transposed,
+                            rhs2_transposed,
+                            half_matrix_to_float,
+                            float_matrix_to_half);
+}
+
+void half_gemm(size_t m,
+               size_t n,
+               size_t k,
+               __half* lhs,
+               const __half* rhs1,
+               const __half* rhs2,
+               size_t lhs_stride,
+               size_t rhs1_stride,
+               size_t rhs2_stride,
+               bool rhs1_transposed,
+               bool rhs2_transposed)
+{
+  detail::blocked_half_gemm(m,
+                            n,
+                            k,
+                            lhs,
+                            rhs1,
+                            rhs2,
+                            lhs_stride,
+                            rhs1_stride,
+                            rhs2_stride,
+                            rhs1_transposed,
+                            rhs2_transposed,
+                            half_matrix_to_float,
+                            float_matrix_to_half);
+}
+
+namespace  // unnamed
+{
+
+struct SequentialForEach {
+  template <typename Body>
+  void operator()(size_t count, Body&& body) const
+  {
+    for (size_t idx = 0; idx < count; idx++) body(idx);
+  }
+};
+
+}  // namespace
+
+void int8_gemm(size_t m,
+               size_t n,
+               size_t k,
+               int32_t* lhs,
+               const int8_t* rhs1,
+               const int8_t* rhs2,
+               size_t lhs_stride,
+               size_t rhs1_stride,
+               size_t rhs2_stride,
+               bool rhs1_transposed,
+               bool rhs2_transposed)
+{
+  detail::blocked_int8_gemm(m,
+                            n,
+                            k,
+                            lhs,
+                            rhs1,
+                            rhs2,
+                            lhs_stride,
+                            rhs1_stride,
+                            rhs2_stride,
+                            rhs1_transposed,
+                            rhs2_transposed,
+                            SequentialForEach{});
+}
+
+void int8_gemm(size_t m,
+               size_t n,
+               size_t k,
+               int32_t* lhs,
+               const uint8_t* rhs1,
+               const uint8_t* rhs2,
+               size_t lhs_stride,
+               size_t rhs1_stride,
+               size_t rhs2_stride,
+               bool rhs1_transposed,
+               bool rhs2_transposed)
+{
+  detail::blocked_int8_gemm(m,
+                            n,
+                            k,
+                            lhs,
+                            rhs1,
+                            rhs2,
+                            lhs_stride,
+                            rhs1_stride,
+                            rhs2_stride,
+                            rhs1_transposed,
+                            rhs2_transposed,
+                            SequentialForEach{});
+}
+
 }  // namespace cunumeric
@@ -20,6 +20,20 @@
 
 namespace cunumeric {
 
+// Sets the number of threads of the BLAS calls made while the guard is alive. The setting
+// belongs to the whole process, so a task asking for another number than the tasks that
+// are in their BLAS calls waits for them to finish first, and tasks asking for the same
+// number run side by side.
+class BlasThreads {
+ public:
+  explicit BlasThreads(int32_t num_threads);
+  ~BlasThreads();
+
+ private:
+  BlasThreads(const BlasThreads&) = delete;
+  BlasThreads& operator=(const BlasThreads&) = delete;
+};
+
 float* allocate_buffer(size_t size);
 
 void half_vector_to_float(float* out, const __half* ptr, size_t n);
@@ -30,4 +44,82 @@ void half_matrix_to_float(float* out, const __half* ptr, size_t m, size_t n, siz
 
 void float_matrix_to_half(__half* out, const float* ptr, size_t m, size_t n, size_t pitch);
 
+// Row-major products lhs = rhs1 * rhs2 through BLAS, shared by the matmul and contraction
+// tasks. Either operand can be transposed.
+void gemm(size_t m,
+          size_t n,
+          size_t k,
+          float* lhs,
+          const float* rhs1,
+          const float* rhs2,
+          size_t lhs_stride,
+          size_t rhs1_stride,
+          size_t rhs2_stride,
+          bool rhs1_transposed,
+          bool rhs2_transposed);
+
+void gemm(size_t m,
+          size_t n,
+          size_t k,
+          double* lhs,
+          const double* rhs1,
+          const double* rhs2,
+          size_t lhs_stride,
+          size_t rhs1_stride,
+          size_t rhs2_stride,
+          bool rhs1_transposed,
+          bool rhs2_transposed);
+
+// Multiplies half precision matrices with float32 accumulation, converting the operands
+// to float one panel at a time. The result is written either in float or in half.
+void half_gemm(size_t m,
+               size_t n,
+               size_t k,
+               float* lhs,
+               const __half* rhs1,
+               const __half* rhs2,
+               size_t lhs_stride,
+               size_t rhs1_stride,
+               size_t rhs2_stride,
+               bool rhs1_transposed,
+               bool rhs2_transposed);
+
+void half_gemm(size_t m,
+               size_t n,
+               size_t k,
+               __half* lhs,
+               const __half* rhs1,
+               const __half* rhs2,
+               size_t lhs_stride,
+               size_t rhs1_stride,
+               size_t rhs2_stride,
+               bool rhs1_transposed,
+               bool rhs2_transposed);
+
+// Multiplies 8-bit integer matrices with int32 accumulation, packing the operands into panels
+// that run along the inner dimension so that the dot products vectorize.
+void int8_gemm(size_t m,
+               size_t n,
+               size_t k,
+               int32_t* lhs,
+               const int8_t* rhs1,
+               const int8_t* rhs2,
+               size_t lhs_stride,
+               size_t rhs1_stride,
+               size_t rhs2_stride,
+               bool rhs1_transposed,
+               bool rhs2_transposed);
+
+void int8_gemm(size_t m,
+               size_t n,
+               size_t k,
+               int32_t* lhs,
+               const uint8_t* rhs1,
+               const uint8_t* rhs2,
+               size_t lhs_stride,
+               size_t rhs1_stride,
+               size_t rhs2_stride,
+               bool rhs1_transposed,
+               bool rhs2_transposed);
+
 }  // namespace cunumeric
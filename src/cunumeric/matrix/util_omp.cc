@@ -15,7 +15,10 @@
  */
 
 #include "legion.h"
+#include "cunumeric/matrix/util.h"
 #include "cunumeric/matrix/util_omp.h"
+#include "cunumeric/matrix/half_gemm.inl"
+#include "cunumeric/matrix/int8_gemm.inl"
 
 namespace cunumeric {
 
@@ -34,4 +37,131 @@ void half_matrix_to_float_omp(float* out, const __half* ptr, size_t m, size_t n,
     for (size_t j = 0; j < n; j++) out[i * n + j] = ptr[i * pitch + j];
 }
 
+void float_matrix_to_half_omp(__half* out, const float* ptr, size_t m, size_t n, size_t pitch)
+{
+#pragma omp parallel for schedule(static)
+  for (size_t i = 0; i < m; i++)
+    for (size_t j = 0; j < n; j++) out[i * pitch + j] = ptr[i * n + j];
+}
+
+void half_gemm_omp(size_t m,
+                   size_t n,
+                   size_t k,
+                   float* lhs,
+                   const __half* rhs1,
+                   const __half* rhs2,
+                   size_t lhs_stride,
+                   size_t rhs1_stride,
+                   size_t rhs2_stride,
+                   bool rhs1_transposed,
+                   bool rhs2_transposed)
+{
+  detail::blocked_half_gemm(m,
+                            n,
+                            k,
+                            lhs,
+                            rhs1,
+                            rhs2,
+                            lhs_stride,
+                            rhs1_stride,
+                            rhs2_stride,
+                            rhs1_transposed,
+                            rhs2_transposed,
+                            half_matrix_to_float_omp,
+                            float_matrix_to_half_omp);
+}
+
+void half_gemm_omp(size_t m,
+                   size_t n,
+                   size_t k,
+                   __half* lhs,
+                   const __half* rhs1,
+                   const __half* rhs2,
+                   size_t lhs_stride,
+                   size_t rhs1_stride,
+                   size_t rhs2_stride,
+                   bool rhs1_transposed,
+                   bool rhs2_transposed)
+{
+  detail::blocked_half_gemm(m,
+                            n,
+                            k,
+                            lhs,
+                            rhs1,
+                            rhs2,
+                            lhs_stride,
+                            rhs1_stride,
+                            rhs2_stride,
+                            rhs1_transposed,
+                            rhs2_transposed,
+                            half_matrix_to_float_omp,
+                            float_matrix_to_half_omp);
+}
+
+namespace  // unnamed
+{
+
+struct OmpForEach {
+  template <typename Body>
+  void operator()(size_t count, Body&& body) const
+  {
+#pragma omp parallel for schedule(static)
+    for (size_t idx = 0; idx < count; idx++) body(idx);
+  }
+};
+
+}  // namespace
+
+void int8_gemm_omp(size_t m,
+                   size_t n,
+                   size_t k,
+                   int32_t* lhs,
+                   const int8_t* rhs1,
+                   const int8_t* rhs2,
+                   size_t lhs_stride,
+                   size_t rhs1_stride,
+                   size_t rhs2_stride,
+                   bool rhs1_transposed,
+                   bool rhs2_transposed)
+{
+  detail::blocked_int8_gemm(m,
+                            n,
+                            k,
+                            lhs,
+                            rhs1,
+                            rhs2,
+                            lhs_stride,
+                            rhs1_stride,
+                            rhs2_stride,
+                            rhs1_transposed,
+                            rhs2_transposed,
+                            OmpForEach{});
+}
+
+void int8_gemm_omp(size_t m,
+                   size_t n,
+                   size_t k,
+                   int32_t* lhs,
+                   const uint8_t* rhs1,
+                   const uint8_t* rhs2,
+                   size_t lhs_stride,
+                   size_t rhs1_stride,
+                   size_t rhs2_stride,
+                   bool rhs1_transposed,
+                   bool rhs2_transposed)
+{
+  detail::blocked_int8_gemm(m,
+                            n,
+                            k,
+                            lhs,
+                            rhs1,
+                            rhs2,
+                            lhs_stride,
+                            rhs1_stride,
+                            rhs2_stride,
+                            rhs1_transposed,
+                            rhs2_transposed,
+                            OmpForEach{});
+}
+
 }  // namespace cunumeric
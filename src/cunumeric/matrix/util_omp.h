@@ -24,4 +24,58 @@ void half_vector_to_float_omp(float* out, const __half* ptr, size_t n);
 
 void half_matrix_to_float_omp(float* out, const __half* ptr, size_t m, size_t n, size_t pitch);
 
+void float_matrix_to_half_omp(__half* out, const float* ptr, size_t m, size_t n, size_t pitch);
+
+// Multiplies half precision matrices with float32 accumulation, converting the operands
+// to float one panel at a time. The result is written either in float or in half.
+void half_gemm_omp(size_t m,
+                   size_t n,
+                   size_t k,
+                   float* lhs,
+                   const __half* rhs1,
+                   const __half* rhs2,
+                   size_t lhs_stride,
+                   size_t rhs1_stride,
+                   size_t rhs2_stride,
+                   bool rhs1_transposed,
+                   bool rhs2_transposed);
+
+void half_gemm_omp(size_t m,
+                   size_t n,
+                   size_t k,
+                   __half* lhs,
+                   const __half* rhs1,
+                   const __half* rhs2,
+                   size_t lhs_stride,
+                   size_t rhs1_stride,
+                   size_t rhs2_stride,
+                   bool rhs1_transposed,
+                   bool rhs2_transposed);
+
+// Multiplies 8-bit integer matrices with int32 accumulation, packing the operands into panels
+// that run along the inner dimension so that the dot products vectorize.
+void int8_gemm_omp(size_t m,
+                   size_t n,
+                   size_t k,
+                   int32_t* lhs,
+                   const int8_t* rhs1,
+                   const int8_t* rhs2,
+                   size_t lhs_stride,
+                   size_t rhs1_stride,
+                   size_t rhs2_stride,
+                   bool rhs1_transposed,
+                   bool rhs2_transposed);
+
+void int8_gemm_omp(size_t m,
+                   size_t n,
+                   size_t k,
+                   int32_t* lhs,
+                   const uint8_t* rhs1,
+                   const uint8_t* rhs2,
+                   size_t lhs_stride,
+                   size_t rhs1_stride,
+                   size_t rhs2_stride,
+                   bool rhs1_transposed,
+                   bool rhs2_transposed);
+
 }  // namespace cunumeric
@@ -0,0 +1,143 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/memory_report.h"
+
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+#include <string>
+
+namespace cunumeric {
+
+using namespace Legion;
+
+namespace {
+
+struct TaskMemory {
+  uint64_t launches{0};
+  // The most bytes of instances one launch was mapped to in each memory
+  std::map<Memory::Kind, size_t> peak_instance_bytes;
+  // The most bytes of temporaries one launch held at once
+  size_t peak_temporary_bytes{0};
+};
+
+std::mutex memory_mutex;
+std::map<TaskID, TaskMemory> task_memory;
+TaskID task_base = 0;
+
+// The temporaries held by the task that runs on this thread
+struct Temporaries {
+  Context context{nullptr};
+  size_t bytes{0};
+};
+thread_local Temporaries temporaries;
+
+std::string memory_kind_name(Memory::Kind kind)
+{
+  switch (kind) {
+    case Memory::Kind::SYSTEM_MEM: return "SYSTEM_MEM";
+    case Memory::Kind::SOCKET_MEM: return "SOCKET_MEM";
+    case Memory::Kind::Z_COPY_MEM: return "Z_COPY_MEM";
+    case Memory::Kind::GPU_FB_MEM: return "GPU_FB_MEM";
+    case Memory::Kind::GPU_MANAGED_MEM: return "GPU_MANAGED_MEM";
+    case Memory::Kind::REGDMA_MEM: return "REGDMA_MEM";
+    default: break;
+  }
+  return "MEMORY_" + std::to_string(static_cast<int>(kind));
+}
+
+bool dump_memory_report(const char* path)
+{
+  std::ofstream out(path);
+  if (!out) return false;
+
+  std::lock_guard<std::mutex> guard(memory_mutex);
+  out << "{\"tasks\": [";
+  bool first = true;
+  for (auto& [task_id, memory] : task_memory) {
+    if (!first) out << ", ";
+    first = false;
+    out << "{\"task_id\": " << task_id - task_base << ", \"launches\": " << memory.launches
+        << ", \"instances\": {";
+    bool first_kind = true;
+    for (auto& [kind, bytes] : memory.peak_instance_bytes) {
+      if (!first_kind) out << ", ";
+      first_kind = false;
+      out << "\"" << memory_kind_name(kind) << "\": " << bytes;
+    }
+    out << "}, \"temporaries\": " << memory.peak_temporary_bytes << "}";
+  }
+  out << "]}\n";
+  return true;
+}
+
+}  // namespace
+
+bool memory_report_enabled()
+{
+  static const bool enabled = []() {
+    const char* value = getenv("CUNUMERIC_MEMORY_REPORT");
+    return value != nullptr && atoi(value) > 0;
+  }();
+  return enabled;
+}
+
+void set_memory_report_task_base(TaskID base) { task_base = base; }
+
+void record_instances(TaskID task_id, const std::map<Memory::Kind, size_t>& bytes)
+{
+  std::lock_guard<std::mutex> guard(memory_mutex);
+  auto& memory = task_memory[task_id];
+  memory.launches += 1;
+  for (auto& [kind, size] : bytes) {
+    auto& peak = memory.peak_instance_bytes[kind];
+    peak       = std::max(peak, size);
+  }
+}
+
+void record_temporary(size_t bytes)
+{
+  if (!memory_report_enabled()) return;
+  auto context = Runtime::get_context();
+  // Only allocations made by tasks are counted
+  if (context == nullptr) return;
+  if (context != temporaries.context) temporaries = Temporaries{context, 0};
+  temporaries.bytes += bytes;
+
+  auto task_id = Runtime::get_runtime()->get_local_task(context)->task_id;
+  std::lock_guard<std::mutex> guard(memory_mutex);
+  auto& peak = task_memory[task_id].peak_temporary_bytes;
+  peak       = std::max(peak, temporaries.bytes);
+}
+
+void release_temporary(size_t bytes)
+{
+  if (!memory_report_enabled()) return;
+  if (Runtime::get_context() != temporaries.context) return;
+  temporaries.bytes -= std::min(bytes, temporaries.bytes);
+}
+
+}  // namespace cunumeric
+
+extern "C" {
+
+int cunumeric_memory_report(const char* path)
+{
+  if (!cunumeric::memory_report_enabled()) return 0;
+  return cunumeric::dump_memory_report(path);
+}
+}
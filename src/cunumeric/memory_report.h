@@ -0,0 +1,51 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <map>
+
+#include "legate.h"
+
+namespace cunumeric {
+
+// Whether CUNUMERIC_MEMORY_REPORT is set, in which case the peak memory of every task is
+// recorded for cunumeric_memory_report
+bool memory_report_enabled();
+
+// Task IDs are reported relative to the first one of the library
+void set_memory_report_task_base(Legion::TaskID base);
+
+// Called by the mapper with the bytes of the instances a task is mapped to in each memory
+void record_instances(Legion::TaskID task_id,
+                      const std::map<Legion::Memory::Kind, size_t>& bytes);
+
+// Called by the executing task when it allocates or gives back a temporary. Buffers live
+// until the task ends unless they are given back, so the peak of a task is the most it
+// held at once.
+void record_temporary(size_t bytes);
+void release_temporary(size_t bytes);
+
+// Task-local buffers are made through this rather than legate::create_buffer so that the
+// memory report sees them
+template <typename VAL>
+auto create_buffer(size_t size, Legion::Memory::Kind kind = Legion::Memory::Kind::NO_MEMKIND)
+{
+  record_temporary(size * sizeof(VAL));
+  return legate::create_buffer<VAL>(size, kind);
+}
+
+}  // namespace cunumeric
@@ -40,9 +40,12 @@ struct ArangeImplBody<VariantKind::GPU, VAL> {
                   const VAL start,
                   const VAL step) const
   {
+    auto stream = get_cached_stream();
+
     const auto distance = rect.hi[0] - rect.lo[0] + 1;
     const size_t blocks = (distance + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
-    arange_kernel<VAL><<<blocks, THREADS_PER_BLOCK>>>(out, rect.lo[0], start, step, distance);
+    arange_kernel<VAL><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+      out, rect.lo[0], start, step, distance);
   }
 };
 
@@ -50,7 +50,7 @@ static void arange_template(TaskContext& context)
 {
   auto& inputs = context.inputs();
   ArangeArgs args{context.outputs()[0], inputs[0], inputs[1], inputs[2]};
-  type_dispatch(args.out.code(), ArangeImpl<KIND>{}, args);
+  cunumeric::type_dispatch(args.out.code(), ArangeImpl<KIND>{}, args);
 }
 
 }  // namespace cunumeric
@@ -37,8 +37,10 @@ struct EyeImplBody<VariantKind::GPU, VAL> {
                   const Point<2>& start,
                   const coord_t distance) const
   {
+    auto stream = get_cached_stream();
+
     const size_t blocks = (distance + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
-    eye_kernel<VAL><<<blocks, THREADS_PER_BLOCK>>>(out, start, distance);
+    eye_kernel<VAL><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(out, start, distance);
   }
 };
 
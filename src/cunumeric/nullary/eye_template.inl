@@ -66,7 +66,7 @@ template <VariantKind KIND>
 static void eye_template(TaskContext& context)
 {
   EyeArgs args{context.outputs()[0], context.scalars()[0].value<int32_t>()};
-  type_dispatch(args.out.code(), EyeImpl<KIND>{}, args);
+  cunumeric::type_dispatch(args.out.code(), EyeImpl<KIND>{}, args);
 }
 
 }  // namespace cunumeric
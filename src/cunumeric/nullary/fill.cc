@@ -24,8 +24,9 @@ using namespace legate;
 
 template <typename VAL, int32_t DIM>
 struct FillImplBody<VariantKind::CPU, VAL, DIM> {
+  template <typename In>
   void operator()(AccessorWO<VAL, DIM> out,
-                  AccessorRO<VAL, 1> in,
+                  const In& in,
                   const Pitches<DIM - 1>& pitches,
                   const Rect<DIM>& rect,
                   bool dense) const
@@ -44,19 +44,22 @@ static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
 
 template <typename VAL, int32_t DIM>
 struct FillImplBody<VariantKind::GPU, VAL, DIM> {
+  template <typename In>
   void operator()(AccessorWO<VAL, DIM> out,
-                  AccessorRO<VAL, 1> in,
+                  const In& in,
                   const Pitches<DIM - 1>& pitches,
                   const Rect<DIM>& rect,
                   bool dense) const
   {
+    auto stream = get_cached_stream();
+
     size_t volume       = rect.volume();
     const size_t blocks = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
     if (dense) {
       auto outptr = out.ptr(rect);
-      dense_kernel<<<blocks, THREADS_PER_BLOCK>>>(volume, outptr, in);
+      dense_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(volume, outptr, in);
     } else {
-      generic_kernel<<<blocks, THREADS_PER_BLOCK>>>(volume, out, in, pitches, rect);
+      generic_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(volume, out, in, pitches, rect);
     }
   }
 };
@@ -22,7 +22,9 @@ namespace cunumeric {
 
 struct FillArgs {
   const Array& out;
-  const Array& fill_value;
+  // A fill value that is known at the launch is passed by value and has no array
+  const Array* fill_value;
+  const legate::Scalar* value;
   bool is_argval;
 };
 
@@ -29,8 +29,9 @@ struct Identity {
 
 template <typename VAL, int32_t DIM>
 struct FillImplBody<VariantKind::OMP, VAL, DIM> {
+  template <typename In>
   void operator()(AccessorWO<VAL, DIM> out,
-                  AccessorRO<VAL, 1> in,
+                  const In& in,
                   const Pitches<DIM - 1>& pitches,
                   const Rect<DIM>& rect,
                   bool dense) const
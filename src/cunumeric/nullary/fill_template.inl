@@ -25,6 +25,13 @@ using namespace legate;
 template <VariantKind KIND, typename VAL, int DIM>
 struct FillImplBody;
 
+// Reads like the accessor of a fill value that is stored in a future
+template <typename VAL>
+struct FillScalar {
+  __CUDA_HD__ VAL operator[](size_t idx) const { return value; }
+  VAL value;
+};
+
 template <VariantKind KIND>
 struct FillImpl {
   template <typename VAL, int DIM>
@@ -37,8 +44,7 @@ struct FillImpl {
 
     if (volume == 0) return;
 
-    auto out        = args.out.write_accessor<VAL, DIM>(rect);
-    auto fill_value = args.fill_value.read_accessor<VAL, 1>();
+    auto out = args.out.write_accessor<VAL, DIM>(rect);
 
 #ifndef LEGION_BOUNDS_CHECKS
     // Check to see if this is dense or not
@@ -47,7 +53,13 @@ struct FillImpl {
     // No dense execution if we're doing bounds checks
     bool dense = false;
 #endif
-    FillImplBody<KIND, VAL, DIM>{}(out, fill_value, pitches, rect, dense);
+    if (args.fill_value != nullptr) {
+      auto fill_value = args.fill_value->read_accessor<VAL, 1>();
+      FillImplBody<KIND, VAL, DIM>{}(out, fill_value, pitches, rect, dense);
+    } else {
+      FillScalar<VAL> fill_value{args.value->value<VAL>()};
+      FillImplBody<KIND, VAL, DIM>{}(out, fill_value, pitches, rect, dense);
+    }
   }
 
   template <LegateTypeCode CODE, int DIM>
@@ -66,8 +78,16 @@ struct FillImpl {
 template <VariantKind KIND>
 static void fill_template(TaskContext& context)
 {
-  FillArgs args{context.outputs()[0], context.inputs()[0], context.scalars()[0].value<bool>()};
-  double_dispatch(args.out.dim(), args.out.code(), FillImpl<KIND>{}, args);
+  auto& scalars  = context.scalars();
+  auto is_argval = scalars[0].value<bool>();
+  // The value is either the scalar after the flags or in the only input
+  auto by_value = scalars[1].value<bool>();
+
+  const Array* fill_value = by_value ? nullptr : &context.inputs()[0];
+  const Scalar* value     = by_value ? &scalars[2] : nullptr;
+
+  FillArgs args{context.outputs()[0], fill_value, value, is_argval};
+  cunumeric::double_dispatch(args.out.dim(), args.out.code(), FillImpl<KIND>{}, args);
 }
 
 }  // namespace cunumeric
@@ -0,0 +1,55 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#pragma once
+
+#include <omp.h>
+
+#include <algorithm>
+#include <atomic>
+
+namespace cunumeric {
+
+// Runs body(chunk) for every chunk in [0, num_chunks) on the threads of the OpenMP
+// processor. Each thread takes the next chunk off a shared counter as soon as it is done
+// with its last one, so the threads that drew cheap chunks keep going while the others
+// finish theirs. Realm's OpenMP runtime only implements static schedules, which is why
+// loops with irregular iterations use this instead of schedule(dynamic).
+template <typename BODY>
+void parallel_for_dynamic(size_t num_chunks, BODY&& body)
+{
+  std::atomic<size_t> next{0};
+#pragma omp parallel
+  {
+    for (size_t chunk = next++; chunk < num_chunks; chunk = next++) body(chunk);
+  }
+}
+
+// Loops over elements whose cost varies, such as ones that only write some of what they
+// read or that contend on atomics, are cut into a few chunks per thread to even out the
+// tail, but never into chunks so small that the shared counter shows up in the profile.
+// Loops over tiles hand out single tiles, as every tile is worth far more than a fetch.
+constexpr size_t DYNAMIC_CHUNKS_PER_THREAD = 8;
+constexpr size_t MIN_DYNAMIC_ELEMENT_CHUNK = 4096;
+
+inline size_t dynamic_chunk_size(size_t volume)
+{
+  const size_t num_chunks = omp_get_max_threads() * DYNAMIC_CHUNKS_PER_THREAD;
+  return std::max(MIN_DYNAMIC_ELEMENT_CHUNK, (volume + num_chunks - 1) / num_chunks);
+}
+
+}  // namespace cunumeric
@@ -18,6 +18,8 @@
 
 #include "legion.h"
 
+#include "cunumeric/divmod.h"
+
 namespace cunumeric {
 
 // This is a small helper class that will also work if we have zero-sized arrays
@@ -78,4 +80,44 @@ class Pitches<0> {
   }
 };
 
+// Same as Pitches, except that unflatten replaces the 64-bit integer divisions,
+// which are very slow on GPUs, with multiplications by magic numbers that are
+// precomputed once in flatten
+template <int DIM>
+class FastPitches {
+ public:
+  __CUDA_HD__
+  inline size_t flatten(const Legion::Rect<DIM + 1>& rect)
+  {
+    size_t pitch  = 1;
+    size_t volume = 1;
+    for (int d = DIM; d >= 0; --d) {
+      // Quick exit for empty rectangle dimensions
+      if (rect.lo[d] > rect.hi[d]) return 0;
+      const size_t diff = rect.hi[d] - rect.lo[d] + 1;
+      volume *= diff;
+      if (d > 0) {
+        pitch *= diff;
+        pitches[d - 1] = FastDivmodU64(pitch);
+      }
+    }
+    return volume;
+  }
+  __CUDA_HD__
+  inline Legion::Point<DIM + 1> unflatten(size_t index, const Legion::Point<DIM + 1>& lo) const
+  {
+    Legion::Point<DIM + 1> point = lo;
+    uint64_t remainder           = index;
+    for (int d = 0; d < DIM; d++) point[d] += pitches[d].divmod(remainder, remainder);
+    point[DIM] += remainder;
+    return point;
+  }
+
+ private:
+  FastDivmodU64 pitches[DIM];
+};
+// Specialization for the zero-sized case
+template <>
+class FastPitches<0> : public Pitches<0> {};
+
 }  // namespace cunumeric
@@ -16,7 +16,7 @@
 
 #pragma once
 
-// An implementation of DE Shaw's Philox 2x32 PRNG
+// Implementations of DE Shaw's Philox 2x32 and 4x32 PRNGs
 
 #ifndef __CUDAPREFIX__
 #ifdef __NVCC__
@@ -90,7 +90,7 @@ class Philox_2x32 {
 #ifdef __NVCC__
     return __umulhi(bits, n);
 #else
-    return (((u64)bits) * ((u64)bits)) >> 32;
+    return (((u64)bits) * ((u64)n)) >> 32;
 #endif
   }
 
@@ -110,17 +110,18 @@ class Philox_2x32 {
 
   // returns a float in the range [0.0, 1.0)
   __CUDAPREFIX__
-  static double rand_float(u32 key, u32 ctr_hi, u32 ctr_lo)
+  static float rand_float(u32 key, u32 ctr_hi, u32 ctr_lo)
   {
-    // need 32 random bits (we probably lose a bunch when this gets converted to float)
+    // need 24 random bits, as many as a float holds, so that the result is
+    // exact and the largest values do not round up to 1.0
     u32 bits = rand_raw(key, ctr_hi, ctr_lo);
 #if __cplusplus > 201402L
     // This syntax is only supported on >= c++17
-    const float scale = 0x1.p-32;  // 2^-32
+    const float scale = 0x1.p-24;  // 2^-24
 #else
-    const float scale = 0.00000000023283064365386962890625;
+    const float scale = 0.000000059604644775390625;
 #endif
-    return (bits * scale);
+    return ((bits >> 8) * scale);
   }
 
   // returns a double in the range [0.0, 1.0)
@@ -139,4 +140,86 @@ class Philox_2x32 {
   }
 };
 
+// The 4x32 variant turns a 128-bit counter into 128 random bits per call, which
+// makes four single precision values or two double precision ones
+template <int ROUNDS>
+class Philox_4x32 {
+ public:
+  typedef unsigned u32;
+  typedef unsigned long long u64;
+
+  static const u32 PHILOX_M4x32_0 = 0xD2511F53U;
+  static const u32 PHILOX_M4x32_1 = 0xCD9E8D57U;
+  static const u32 PHILOX_W32_0   = 0x9E3779B9U;
+  static const u32 PHILOX_W32_1   = 0xBB67AE85U;
+
+  struct Bits {
+    u32 words[4];
+
+    __CUDAPREFIX__
+    u64 dword(int idx) const { return (((u64)words[2 * idx + 1]) << 32) + words[2 * idx]; }
+  };
+
+  // The upper half of the counter selects one of many streams of draws for the
+  // same point, for the samplers that need more than one draw
+  __CUDAPREFIX__
+  static Bits rand_raw(u32 key, u64 counter, u64 stream = 0)
+  {
+    u32 ctr[4] = {(u32)counter, (u32)(counter >> 32), (u32)stream, (u32)(stream >> 32)};
+    u32 key_lo = key, key_hi = 0;
+#ifdef __NVCC__
+#pragma unroll
+#endif
+    for (int i = 0; i < ROUNDS; i++) {
+      u32 hi0, lo0, hi1, lo1;
+#ifdef __NVCC__
+      hi0 = __umulhi(ctr[0], PHILOX_M4x32_0);
+      hi1 = __umulhi(ctr[2], PHILOX_M4x32_1);
+#else
+      hi0 = (((u64)ctr[0]) * PHILOX_M4x32_0) >> 32;
+      hi1 = (((u64)ctr[2]) * PHILOX_M4x32_1) >> 32;
+#endif
+      lo0    = ctr[0] * PHILOX_M4x32_0;
+      lo1    = ctr[2] * PHILOX_M4x32_1;
+      ctr[0] = hi1 ^ ctr[1] ^ key_lo;
+      ctr[1] = lo1;
+      ctr[2] = hi0 ^ ctr[3] ^ key_hi;
+      ctr[3] = lo0;
+      key_lo += PHILOX_W32_0;
+      key_hi += PHILOX_W32_1;
+    }
+    return Bits{{ctr[0], ctr[1], ctr[2], ctr[3]}};
+  }
+
+  // returns an unsigned 32-bit integer in the range [0, n)
+  __CUDAPREFIX__
+  static u32 to_int(u32 bits, u32 n)
+  {
+#ifdef __NVCC__
+    return __umulhi(bits, n);
+#else
+    return (((u64)bits) * ((u64)n)) >> 32;
+#endif
+  }
+
+  // returns an unsigned 64-bit integer in the range [0, n)
+  __CUDAPREFIX__
+  static u64 to_long(u64 bits, u64 n)
+  {
+#ifdef __NVCC__
+    return __umul64hi(bits, n);
+#else
+    return Philox_2x32<ROUNDS>::mul64hi(bits, n);
+#endif
+  }
+
+  // returns a float in the range [0.0, 1.0) made of the top 24 bits
+  __CUDAPREFIX__
+  static float to_float(u32 bits) { return (bits >> 8) * 0x1.p-24f; }
+
+  // returns a double in the range [0.0, 1.0) made of the top 53 bits
+  __CUDAPREFIX__
+  static double to_double(u64 bits) { return (bits >> 11) * 0x1.p-53; }
+};
+
 }  // namespace cunumeric
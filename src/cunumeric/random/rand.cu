@@ -19,20 +19,26 @@
 
 #include "cunumeric/cuda_help.h"
 
+#include <curand_kernel.h>
+
 namespace cunumeric {
 
 using namespace Legion;
 
-template <typename WriteAcc, typename Rng, int32_t DIM>
-static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM) rand_kernel(
-  size_t volume, WriteAcc out, Rng rng, Point<DIM> strides, Pitches<DIM - 1> pitches, Point<DIM> lo)
+template <typename RNG, typename VAL, typename WriteAcc, int32_t DIM>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  rand_kernel(size_t chunks,
+              size_t volume,
+              WriteAcc out,
+              RNG rng,
+              Point<DIM> strides,
+              Pitches<DIM - 1> pitches,
+              Point<DIM> lo,
+              uint64_t base)
 {
-  const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
-  if (idx >= volume) return;
-  auto point    = pitches.unflatten(idx, lo);
-  size_t offset = 0;
-  for (size_t dim = 0; dim < DIM; ++dim) offset += point[dim] * strides[dim];
-  out[point] = rng(HI_BITS(offset), LO_BITS(offset));
+  const size_t chunk = blockIdx.x * blockDim.x + threadIdx.x;
+  if (chunk >= chunks) return;
+  rand_chunk<RNG, VAL>(out, rng, strides, pitches, lo, base, chunk, volume);
 }
 
 template <typename RNG, typename VAL, int32_t DIM>
@@ -41,11 +47,68 @@ struct RandImplBody<VariantKind::GPU, RNG, VAL, DIM> {
                   const RNG& rng,
                   const Point<DIM>& strides,
                   const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& rect,
+                  uint64_t base) const
+  {
+    auto stream = get_cached_stream();
+
+    // Every thread fills as many points as one draw of the generator makes
+    const size_t volume = rect.volume();
+    const size_t chunks = (volume + RNG::VALUES_PER_DRAW - 1) / RNG::VALUES_PER_DRAW;
+    const size_t blocks = (chunks + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+    rand_kernel<RNG, VAL><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+      chunks, volume, out, rng, strides, pitches, rect.lo, base);
+  }
+};
+
+// How many points every stream of the stream backend fills on the GPUs
+#define GPU_RAND_STREAM_BLOCK 256
+
+// Every thread fills one block of points from its own cuRAND XORWOW stream. Their
+// seeds are mixed from the block index, which makes them far cheaper to set up than
+// skipping ahead in one stream.
+template <typename RNG, typename VAL, typename WriteAcc, int32_t DIM>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  rand_stream_kernel(size_t streams,
+                     size_t volume,
+                     WriteAcc out,
+                     RNG rng,
+                     uint64_t tile_offset,
+                     Pitches<DIM - 1> pitches,
+                     Point<DIM> lo)
+{
+  using Bits           = typename RNG::RNG::Bits;
+  constexpr int VALUES = RNG::VALUES_PER_DRAW;
+  const size_t block   = blockIdx.x * blockDim.x + threadIdx.x;
+  if (block >= streams) return;
+  curandStateXORWOW_t state;
+  curand_init(stream_seed(rng.epoch, tile_offset, block), 0, 0, &state);
+  const size_t start = block * GPU_RAND_STREAM_BLOCK;
+  const size_t end   = min(volume, start + GPU_RAND_STREAM_BLOCK);
+  VAL values[VALUES];
+  for (size_t idx = start; idx < end; idx += VALUES) {
+    const Bits bits{{curand(&state), curand(&state), curand(&state), curand(&state)}};
+    rng.transform(bits, values);
+    for (int v = 0; v < VALUES && idx + v < end; ++v)
+      out[pitches.unflatten(idx + v, lo)] = values[v];
+  }
+}
+
+template <typename RNG, typename VAL, int32_t DIM>
+struct RandStreamImplBody<VariantKind::GPU, RNG, VAL, DIM> {
+  void operator()(AccessorWO<VAL, DIM> out,
+                  const RNG& rng,
+                  uint64_t tile_offset,
+                  const Pitches<DIM - 1>& pitches,
                   const Rect<DIM>& rect) const
   {
-    size_t volume       = rect.volume();
-    const size_t blocks = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
-    rand_kernel<<<blocks, THREADS_PER_BLOCK>>>(volume, out, rng, strides, pitches, rect.lo);
+    auto stream = get_cached_stream();
+
+    const size_t volume  = rect.volume();
+    const size_t streams = (volume + GPU_RAND_STREAM_BLOCK - 1) / GPU_RAND_STREAM_BLOCK;
+    const size_t blocks  = (streams + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+    rand_stream_kernel<RNG, VAL><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+      streams, volume, out, rng, tile_offset, pitches, rect.lo);
   }
 };
 
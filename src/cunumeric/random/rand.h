@@ -27,6 +27,10 @@ struct RandArgs {
   uint32_t epoch;
   Legion::DomainPoint strides;
   std::vector<legate::Store> args;
+  RandBackend backend;
+  // The first counter of the draws, which random generators advance past the
+  // counters of their earlier draws
+  uint64_t base;
 };
 
 class RandTask : public CuNumericTask<RandTask> {
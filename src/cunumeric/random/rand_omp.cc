@@ -28,16 +28,30 @@ struct RandImplBody<VariantKind::OMP, RNG, VAL, DIM> {
                   const RNG& rng,
                   const Point<DIM>& strides,
                   const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& rect,
+                  uint64_t base) const
+  {
+    const size_t volume = rect.volume();
+    const size_t chunks = (volume + RNG::VALUES_PER_DRAW - 1) / RNG::VALUES_PER_DRAW;
+#pragma omp parallel for schedule(static)
+    for (size_t chunk = 0; chunk < chunks; ++chunk)
+      rand_chunk<RNG, VAL>(out, rng, strides, pitches, rect.lo, base, chunk, volume);
+  }
+};
+
+template <typename RNG, typename VAL, int32_t DIM>
+struct RandStreamImplBody<VariantKind::OMP, RNG, VAL, DIM> {
+  void operator()(AccessorWO<VAL, DIM> out,
+                  const RNG& rng,
+                  uint64_t tile_offset,
+                  const Pitches<DIM - 1>& pitches,
                   const Rect<DIM>& rect) const
   {
-    size_t volume = rect.volume();
+    const size_t volume = rect.volume();
+    const size_t blocks = (volume + CPU_RAND_STREAM_BLOCK - 1) / CPU_RAND_STREAM_BLOCK;
 #pragma omp parallel for schedule(static)
-    for (size_t idx = 0; idx < volume; ++idx) {
-      const auto point = pitches.unflatten(idx, rect.lo);
-      size_t offset    = 0;
-      for (size_t dim = 0; dim < DIM; ++dim) offset += point[dim] * strides[dim];
-      out[point] = rng(HI_BITS(offset), LO_BITS(offset));
-    }
+    for (size_t block = 0; block < blocks; ++block)
+      rand_stream_block<RNG, VAL>(out, rng, tile_offset, pitches, rect.lo, block, volume);
   }
 };
 
@@ -25,6 +25,73 @@ using namespace legate;
 template <VariantKind KIND, typename RNG, typename VAL, int DIM>
 struct RandImplBody;
 
+// Fills the points of the chunk-th run of RNG::VALUES_PER_DRAW points of the flattened
+// rect. The value of a point only depends on its offset in the whole array, so the
+// results do not depend on the partitioning, and the points whose offsets fall in the
+// same draw share it. Generators shift the offsets by the base of the counters they
+// have not drawn yet, which is a multiple of every VALUES_PER_DRAW.
+template <typename RNG, typename VAL, int DIM, typename WriteAcc>
+__CUDAPREFIX__ inline void rand_chunk(const WriteAcc& out,
+                                      const RNG& rng,
+                                      const Point<DIM>& strides,
+                                      const Pitches<DIM - 1>& pitches,
+                                      const Point<DIM>& lo,
+                                      uint64_t base,
+                                      size_t chunk,
+                                      size_t volume)
+{
+  constexpr int VALUES = RNG::VALUES_PER_DRAW;
+  VAL values[VALUES];
+  uint64_t drawn   = static_cast<uint64_t>(-1);
+  const size_t end = (chunk + 1) * VALUES < volume ? (chunk + 1) * VALUES : volume;
+  for (size_t idx = chunk * VALUES; idx < end; ++idx) {
+    const auto point = pitches.unflatten(idx, lo);
+    uint64_t offset  = base;
+    for (int32_t dim = 0; dim < DIM; ++dim) offset += point[dim] * strides[dim];
+    if (offset / VALUES != drawn) {
+      drawn = offset / VALUES;
+      rng(drawn, values);
+    }
+    out[point] = values[offset % VALUES];
+  }
+}
+
+template <VariantKind KIND, typename RNG, typename VAL, int DIM>
+struct RandStreamImplBody;
+
+// How many points every stream of the stream backend fills on the CPUs
+static constexpr size_t CPU_RAND_STREAM_BLOCK = 4096;
+
+// Fills the block-th run of CPU_RAND_STREAM_BLOCK points of the flattened rect with
+// the values of its own xoshiro256** stream
+template <typename RNG, typename VAL, int DIM, typename WriteAcc>
+inline void rand_stream_block(const WriteAcc& out,
+                              const RNG& rng,
+                              uint64_t tile_offset,
+                              const Pitches<DIM - 1>& pitches,
+                              const Point<DIM>& lo,
+                              size_t block,
+                              size_t volume)
+{
+  using Bits           = typename RNG::RNG::Bits;
+  constexpr int VALUES = RNG::VALUES_PER_DRAW;
+  const size_t start   = block * CPU_RAND_STREAM_BLOCK;
+  const size_t end     = std::min(volume, start + CPU_RAND_STREAM_BLOCK);
+  Xoshiro256 stream(stream_seed(rng.epoch, tile_offset, block));
+  VAL values[VALUES];
+  for (size_t idx = start; idx < end; idx += VALUES) {
+    const uint64_t lo_bits = stream.next();
+    const uint64_t hi_bits = stream.next();
+    const Bits bits{{static_cast<uint32_t>(lo_bits),
+                     static_cast<uint32_t>(lo_bits >> 32),
+                     static_cast<uint32_t>(hi_bits),
+                     static_cast<uint32_t>(hi_bits >> 32)}};
+    rng.transform(bits, values);
+    for (int v = 0; v < VALUES && idx + v < end; ++v)
+      out[pitches.unflatten(idx + v, lo)] = values[v];
+  }
+}
+
 template <RandGenCode GEN_CODE, VariantKind KIND>
 struct RandImpl {
   template <LegateTypeCode CODE,
@@ -46,7 +113,15 @@ struct RandImpl {
     Point<DIM> strides(args.strides);
 
     RNG rng(args.epoch, args.args);
-    RandImplBody<KIND, RNG, VAL, DIM>{}(out, rng, strides, pitches, rect);
+    if constexpr (RNG::STREAMABLE) {
+      if (args.backend == RandBackend::STREAM) {
+        uint64_t tile_offset = args.base;
+        for (int32_t dim = 0; dim < DIM; ++dim) tile_offset += rect.lo[dim] * strides[dim];
+        RandStreamImplBody<KIND, RNG, VAL, DIM>{}(out, rng, tile_offset, pitches, rect);
+        return;
+      }
+    }
+    RandImplBody<KIND, RNG, VAL, DIM>{}(out, rng, strides, pitches, rect, args.base);
   }
 
   template <LegateTypeCode CODE,
@@ -63,7 +138,7 @@ struct RandDispatch {
   template <RandGenCode GEN_CODE>
   void operator()(RandArgs& args) const
   {
-    double_dispatch(args.out.dim(), args.out.code(), RandImpl<GEN_CODE, KIND>{}, args);
+    cunumeric::double_dispatch(args.out.dim(), args.out.code(), RandImpl<GEN_CODE, KIND>{}, args);
   }
 };
 
@@ -77,11 +152,13 @@ static void rand_template(TaskContext& context)
   auto gen_code = scalars[0].value<RandGenCode>();
   auto epoch    = scalars[1].value<uint32_t>();
   auto strides  = scalars[2].value<DomainPoint>();
+  auto backend  = scalars[3].value<RandBackend>();
+  auto base     = scalars[4].value<uint64_t>();
 
   std::vector<Store> extra_args;
   for (auto& input : inputs) extra_args.push_back(std::move(input));
 
-  RandArgs args{outputs[0], gen_code, epoch, strides, std::move(extra_args)};
+  RandArgs args{outputs[0], gen_code, epoch, strides, std::move(extra_args), backend, base};
   op_dispatch(args.gen_code, RandDispatch<KIND>{}, args);
 }
 
@@ -18,17 +18,34 @@
 
 #include "cunumeric/cunumeric.h"
 #include "cunumeric/random/philox.h"
+#include "cunumeric/random/samplers.h"
+#include "cunumeric/random/xoshiro.h"
 
-#define HI_BITS(x) ((unsigned)((x) >> 32))
-#define LO_BITS(x) ((unsigned)((x)&0x00000000FFFFFFFF))
+#include <cmath>
 
 namespace cunumeric {
 
 // Match these to RandGenCode in config.py
 enum class RandGenCode : int32_t {
-  UNIFORM = 1,
-  NORMAL  = 2,
-  INTEGER = 3,
+  UNIFORM     = 1,
+  NORMAL      = 2,
+  INTEGER     = 3,
+  PERMUTATION = 4,
+  EXPONENTIAL = 5,
+  GAMMA       = 6,
+  BETA        = 7,
+  POISSON     = 8,
+  BINOMIAL    = 9,
+  BERNOULLI   = 10,
+};
+
+// Match these to RandBackend in config.py. The Philox backend makes the same values
+// for every partitioning of the array. The stream backend runs cheaper generators
+// that are seeded per block of points, so its values are the same only as long as the
+// partitioning is.
+enum class RandBackend : int32_t {
+  PHILOX = 0,
+  STREAM = 1,
 };
 
 template <typename Functor, typename... Fnargs>
@@ -41,6 +58,20 @@ constexpr decltype(auto) op_dispatch(RandGenCode gen_code, Functor f, Fnargs&&..
       return f.template operator()<RandGenCode::NORMAL>(std::forward<Fnargs>(args)...);
     case RandGenCode::INTEGER:
       return f.template operator()<RandGenCode::INTEGER>(std::forward<Fnargs>(args)...);
+    case RandGenCode::PERMUTATION:
+      return f.template operator()<RandGenCode::PERMUTATION>(std::forward<Fnargs>(args)...);
+    case RandGenCode::EXPONENTIAL:
+      return f.template operator()<RandGenCode::EXPONENTIAL>(std::forward<Fnargs>(args)...);
+    case RandGenCode::GAMMA:
+      return f.template operator()<RandGenCode::GAMMA>(std::forward<Fnargs>(args)...);
+    case RandGenCode::BETA:
+      return f.template operator()<RandGenCode::BETA>(std::forward<Fnargs>(args)...);
+    case RandGenCode::POISSON:
+      return f.template operator()<RandGenCode::POISSON>(std::forward<Fnargs>(args)...);
+    case RandGenCode::BINOMIAL:
+      return f.template operator()<RandGenCode::BINOMIAL>(std::forward<Fnargs>(args)...);
+    case RandGenCode::BERNOULLI:
+      return f.template operator()<RandGenCode::BERNOULLI>(std::forward<Fnargs>(args)...);
   }
   assert(false);
   return f.template operator()<RandGenCode::UNIFORM>(std::forward<Fnargs>(args)...);
@@ -51,133 +82,105 @@ struct RandomGenerator {
   static constexpr bool valid = false;
 };
 
+// Half and single precision values are generated from 24 random bits, as many as
+// a float holds, and computed in single precision. Every draw of the generators
+// makes the values of VALUES_PER_DRAW consecutive offsets from one counter. The
+// transform methods make the same values out of 128 bits of any other source.
+template <legate::LegateTypeCode CODE>
+struct RandomFloatingPoint {
+  static constexpr bool valid = CODE == legate::LegateTypeCode::HALF_LT ||
+                                CODE == legate::LegateTypeCode::FLOAT_LT ||
+                                CODE == legate::LegateTypeCode::DOUBLE_LT;
+  using COMPUTE_TYPE =
+    std::conditional_t<CODE == legate::LegateTypeCode::DOUBLE_LT, double, float>;
+};
+
 template <legate::LegateTypeCode CODE>
 struct RandomGenerator<RandGenCode::UNIFORM, CODE> {
-  using RNG = Philox_2x32<10>;
+  using RNG = Philox_4x32<10>;
   using VAL = legate::legate_type_of<CODE>;
+  using FP  = typename RandomFloatingPoint<CODE>::COMPUTE_TYPE;
 
-  static constexpr bool valid = CODE == legate::LegateTypeCode::DOUBLE_LT;
+  static constexpr bool valid          = RandomFloatingPoint<CODE>::valid;
+  static constexpr int VALUES_PER_DRAW = std::is_same<FP, double>::value ? 2 : 4;
+  static constexpr bool STREAMABLE     = true;
 
   RandomGenerator(uint32_t ep, const std::vector<legate::Store>& args) : epoch(ep)
   {
     assert(args.size() == 2);
-    lo   = args[0].scalar<VAL>();
-    diff = args[1].scalar<VAL>() - lo;
+    lo   = static_cast<FP>(args[0].scalar<VAL>());
+    diff = static_cast<FP>(args[1].scalar<VAL>()) - lo;
   }
 
-  __CUDAPREFIX__ double operator()(uint32_t hi, uint32_t lo) const
+  __CUDAPREFIX__ void operator()(uint64_t counter, VAL* values) const
   {
-    return static_cast<VAL>(lo + RNG::rand_long(epoch, hi, lo, diff));
+    transform(RNG::rand_raw(epoch, counter), values);
+  }
+
+  __CUDAPREFIX__ void transform(const typename RNG::Bits& bits, VAL* values) const
+  {
+    for (int idx = 0; idx < VALUES_PER_DRAW; idx++) {
+      if constexpr (std::is_same<FP, double>::value)
+        values[idx] = static_cast<VAL>(lo + diff * RNG::to_double(bits.dword(idx)));
+      else
+        values[idx] = static_cast<VAL>(lo + diff * RNG::to_float(bits.words[idx]));
+    }
   };
 
   uint32_t epoch;
-  VAL lo;
-  VAL diff;
+  FP lo;
+  FP diff;
 };
 
 template <legate::LegateTypeCode CODE>
 struct RandomGenerator<RandGenCode::NORMAL, CODE> {
-  using RNG                   = Philox_2x32<10>;
-  static constexpr bool valid = CODE == legate::LegateTypeCode::DOUBLE_LT;
+  using RNG = Philox_4x32<10>;
+  using VAL = legate::legate_type_of<CODE>;
+  using FP  = typename RandomFloatingPoint<CODE>::COMPUTE_TYPE;
+
+  static constexpr bool valid          = RandomFloatingPoint<CODE>::valid;
+  static constexpr int VALUES_PER_DRAW = std::is_same<FP, double>::value ? 2 : 4;
+  static constexpr bool STREAMABLE     = true;
 
   RandomGenerator(uint32_t ep, const std::vector<legate::Store>& args) : epoch(ep) {}
 
-#ifndef __NVCC__
-  static inline double erfinv(double a)
-  {
-    double p, q, t, fa;
-    unsigned long long int l;
-
-    fa = fabs(a);
-    if (fa >= 1.0) {
-      l = 0xfff8000000000000ull;
-      memcpy(&t, &l, sizeof(double)); /* INDEFINITE */
-      if (fa == 1.0) { t = a * exp(1000.0); /* Infinity */ }
-    } else if (fa >= 0.9375) {
-      /* Based on: J.M. Blair, C.A. Edwards, J.H. Johnson: Rational Chebyshev
-         Approximations for the Inverse of the Error Function. Mathematics of
-         Computation, Vol. 30, No. 136 (Oct. 1976), pp. 827-830. Table 59
-       */
-      t = log1p(-fa);
-      t = 1.0 / sqrt(-t);
-      p = 2.7834010353747001060e-3;
-      p = p * t + 8.6030097526280260580e-1;
-      p = p * t + 2.1371214997265515515e+0;
-      p = p * t + 3.1598519601132090206e+0;
-      p = p * t + 3.5780402569085996758e+0;
-      p = p * t + 1.5335297523989890804e+0;
-      p = p * t + 3.4839207139657522572e-1;
-      p = p * t + 5.3644861147153648366e-2;
-      p = p * t + 4.3836709877126095665e-3;
-      p = p * t + 1.3858518113496718808e-4;
-      p = p * t + 1.1738352509991666680e-6;
-      q = t + 2.2859981272422905412e+0;
-      q = q * t + 4.3859045256449554654e+0;
-      q = q * t + 4.6632960348736635331e+0;
-      q = q * t + 3.9846608184671757296e+0;
-      q = q * t + 1.6068377709719017609e+0;
-      q = q * t + 3.5609087305900265560e-1;
-      q = q * t + 5.3963550303200816744e-2;
-      q = q * t + 4.3873424022706935023e-3;
-      q = q * t + 1.3858762165532246059e-4;
-      q = q * t + 1.1738313872397777529e-6;
-      t = p / (q * t);
-      if (a < 0.0) t = -t;
-    } else if (fa >= 0.75) {
-      /* Based on: J.M. Blair, C.A. Edwards, J.H. Johnson: Rational Chebyshev
-         Approximations for the Inverse of the Error Function. Mathematics of
-         Computation, Vol. 30, No. 136 (Oct. 1976), pp. 827-830. Table 39
-      */
-      t = a * a - .87890625;
-      p = .21489185007307062000e+0;
-      p = p * t - .64200071507209448655e+1;
-      p = p * t + .29631331505876308123e+2;
-      p = p * t - .47644367129787181803e+2;
-      p = p * t + .34810057749357500873e+2;
-      p = p * t - .12954198980646771502e+2;
-      p = p * t + .25349389220714893917e+1;
-      p = p * t - .24758242362823355486e+0;
-      p = p * t + .94897362808681080020e-2;
-      q = t - .12831383833953226499e+2;
-      q = q * t + .41409991778428888716e+2;
-      q = q * t - .53715373448862143349e+2;
-      q = q * t + .33880176779595142685e+2;
-      q = q * t - .11315360624238054876e+2;
-      q = q * t + .20369295047216351160e+1;
-      q = q * t - .18611650627372178511e+0;
-      q = q * t + .67544512778850945940e-2;
-      p = p / q;
-      t = a * p;
-    } else {
-      /* Based on: J.M. Blair, C.A. Edwards, J.H. Johnson: Rational Chebyshev
-         Approximations for the Inverse of the Error Function. Mathematics of
-         Computation, Vol. 30, No. 136 (Oct. 1976), pp. 827-830. Table 18
-      */
-      t = a * a - .5625;
-      p = -.23886240104308755900e+2;
-      p = p * t + .45560204272689128170e+3;
-      p = p * t - .22977467176607144887e+4;
-      p = p * t + .46631433533434331287e+4;
-      p = p * t - .43799652308386926161e+4;
-      p = p * t + .19007153590528134753e+4;
-      p = p * t - .30786872642313695280e+3;
-      q = t - .83288327901936570000e+2;
-      q = q * t + .92741319160935318800e+3;
-      q = q * t - .35088976383877264098e+4;
-      q = q * t + .59039348134843665626e+4;
-      q = q * t - .48481635430048872102e+4;
-      q = q * t + .18997769186453057810e+4;
-      q = q * t - .28386514725366621129e+3;
-      p = p / q;
-      t = a * p;
-    }
-    return t;
+  // The Box-Muller transform turns every pair of uniform draws (u, v) into the pair
+  // of independent normals r cos(2 pi v) and r sin(2 pi v) with r = sqrt(-2 log(u)).
+  // The draws of u take the centers of their bins, which keeps them away from 0.
+  __CUDAPREFIX__ void operator()(uint64_t counter, VAL* values) const
+  {
+    transform(RNG::rand_raw(epoch, counter), values);
   }
-#endif
 
-  __CUDAPREFIX__ double operator()(uint32_t hi, uint32_t lo) const
+  __CUDAPREFIX__ void transform(const typename RNG::Bits& bits, VAL* values) const
   {
-    return erfinv(2.0 * RNG::rand_double(epoch, hi, lo) - 1.0);
+    for (int idx = 0; idx < VALUES_PER_DRAW; idx += 2) {
+      FP u, v;
+      if constexpr (std::is_same<FP, double>::value) {
+        u = RNG::to_double(bits.dword(0)) + 0x1.p-54;
+        v = RNG::to_double(bits.dword(1));
+      } else {
+        u = RNG::to_float(bits.words[idx]) + 0x1.p-25f;
+        v = RNG::to_float(bits.words[idx + 1]);
+      }
+      FP radius, sine, cosine;
+#ifdef __NVCC__
+      if constexpr (std::is_same<FP, double>::value) {
+        radius = sqrt(-2.0 * log(u));
+        sincospi(2.0 * v, &sine, &cosine);
+      } else {
+        radius = sqrtf(-2.0f * __logf(u));
+        sincospif(2.0f * v, &sine, &cosine);
+      }
+#else
+      radius         = std::sqrt(FP(-2) * std::log(u));
+      const FP angle = FP(2 * M_PI) * v;
+      sine           = std::sin(angle);
+      cosine         = std::cos(angle);
+#endif
+      values[idx]     = static_cast<VAL>(radius * cosine);
+      values[idx + 1] = static_cast<VAL>(radius * sine);
+    }
   };
 
   uint32_t epoch;
@@ -185,26 +188,272 @@ struct RandomGenerator<RandGenCode::NORMAL, CODE> {
 
 template <legate::LegateTypeCode CODE>
 struct RandomGenerator<RandGenCode::INTEGER, CODE> {
-  using RNG = Philox_2x32<10>;
+  using RNG = Philox_4x32<10>;
   using VAL = legate::legate_type_of<CODE>;
 
-  static constexpr bool valid = legate::is_integral<CODE>::value;
+  static constexpr bool valid =
+    legate::is_integral<CODE>::value && CODE != legate::LegateTypeCode::BOOL_LT;
+  // Types of 32 bits or less take the cheaper 32-bit multiply on each word
+  static constexpr int VALUES_PER_DRAW = sizeof(VAL) <= sizeof(uint32_t) ? 4 : 2;
+  static constexpr bool STREAMABLE     = true;
 
   RandomGenerator(uint32_t ep, const std::vector<legate::Store>& args) : epoch(ep)
   {
     assert(args.size() == 2);
-    lo   = args[0].scalar<VAL>();
-    diff = args[1].scalar<VAL>() - lo;
+    // The bounds are moved to unsigned integers, whose arithmetic wraps around, so
+    // that the range of a signed type can be wider than its largest value
+    lo   = static_cast<uint64_t>(args[0].scalar<VAL>());
+    diff = static_cast<uint64_t>(args[1].scalar<VAL>()) - lo;
   }
 
-  __CUDAPREFIX__ double operator()(uint32_t hi_bits, uint32_t lo_bits) const
+  __CUDAPREFIX__ void operator()(uint64_t counter, VAL* values) const
   {
-    return static_cast<VAL>(lo + RNG::rand_long(epoch, hi_bits, lo_bits, diff));
+    transform(RNG::rand_raw(epoch, counter), values);
+  }
+
+  __CUDAPREFIX__ void transform(const typename RNG::Bits& bits, VAL* values) const
+  {
+    for (int idx = 0; idx < VALUES_PER_DRAW; idx++) {
+      if constexpr (VALUES_PER_DRAW == 4)
+        values[idx] = static_cast<VAL>(lo + RNG::to_int(bits.words[idx], diff));
+      else
+        values[idx] = static_cast<VAL>(lo + RNG::to_long(bits.dword(idx), diff));
+    }
   };
 
   uint32_t epoch;
-  VAL lo;
+  uint64_t lo;
   uint64_t diff;
 };
 
+// Random permutations of [0, n) are counter based as well. A Feistel network is a
+// bijection of the 2^(2 * half_bits) integers that cover n, and walking its cycles
+// until they come back into [0, n) turns it into a bijection of [0, n). Every point
+// thus computes its own value without any sort or communication.
+template <legate::LegateTypeCode CODE>
+struct RandomGenerator<RandGenCode::PERMUTATION, CODE> {
+  using VAL = legate::legate_type_of<CODE>;
+
+  static constexpr bool valid          = CODE == legate::LegateTypeCode::INT64_LT;
+  static constexpr int VALUES_PER_DRAW = 1;
+  // Permutations only make sense when every point knows its offset
+  static constexpr bool STREAMABLE = false;
+  static constexpr int ROUNDS      = 6;
+
+  RandomGenerator(uint32_t ep, const std::vector<legate::Store>& args) : epoch(ep)
+  {
+    assert(args.size() == 1);
+    n         = static_cast<uint64_t>(args[0].scalar<VAL>());
+    half_bits = 1;
+    while (half_bits < 32 && (uint64_t(1) << (2 * half_bits)) < n) half_bits++;
+    mask = (uint64_t(1) << half_bits) - 1;
+  }
+
+  __CUDAPREFIX__ void operator()(uint64_t counter, VAL* values) const
+  {
+    // At least a quarter of the network's range is in [0, n), so the walks are short
+    uint64_t x = counter;
+    do {
+      x = feistel(x);
+    } while (x >= n);
+    values[0] = static_cast<VAL>(x);
+  }
+
+  __CUDAPREFIX__ uint64_t feistel(uint64_t x) const
+  {
+    uint64_t left  = x >> half_bits;
+    uint64_t right = x & mask;
+    for (int round = 0; round < ROUNDS; round++) {
+      const uint64_t next = left ^ (stream_seed(epoch, round, right) & mask);
+      left                = right;
+      right               = next;
+    }
+    return (left << half_bits) | right;
+  }
+
+  uint32_t epoch;
+  uint64_t n;
+  uint64_t mask;
+  int half_bits;
+};
+
+template <legate::LegateTypeCode CODE>
+struct RandomGenerator<RandGenCode::EXPONENTIAL, CODE> {
+  using RNG = Philox_4x32<10>;
+  using VAL = legate::legate_type_of<CODE>;
+
+  static constexpr bool valid          = RandomFloatingPoint<CODE>::valid;
+  static constexpr int VALUES_PER_DRAW = 2;
+  static constexpr bool STREAMABLE     = true;
+
+  RandomGenerator(uint32_t ep, const std::vector<legate::Store>& args) : epoch(ep)
+  {
+    assert(args.size() == 1);
+    scale = args[0].scalar<double>();
+  }
+
+  __CUDAPREFIX__ void operator()(uint64_t counter, VAL* values) const
+  {
+    transform(RNG::rand_raw(epoch, counter), values);
+  }
+
+  // Inversion of the CDF, with the draws in the centers of their bins to stay off 0
+  __CUDAPREFIX__ void transform(const typename RNG::Bits& bits, VAL* values) const
+  {
+    for (int idx = 0; idx < VALUES_PER_DRAW; idx++)
+      values[idx] = static_cast<VAL>(-scale * log(RNG::to_double(bits.dword(idx)) + 0x1.p-54));
+  };
+
+  uint32_t epoch;
+  double scale;
+};
+
+// The distributions that take a variable number of draws per point are sampled from
+// the point's own sequence of draws, so they have no stream variant
+template <legate::LegateTypeCode CODE>
+struct RandomGenerator<RandGenCode::GAMMA, CODE> {
+  using VAL = legate::legate_type_of<CODE>;
+
+  static constexpr bool valid          = RandomFloatingPoint<CODE>::valid;
+  static constexpr int VALUES_PER_DRAW = 1;
+  static constexpr bool STREAMABLE     = false;
+
+  RandomGenerator(uint32_t ep, const std::vector<legate::Store>& args) : epoch(ep)
+  {
+    assert(args.size() == 2);
+    shape = args[0].scalar<double>();
+    scale = args[1].scalar<double>();
+  }
+
+  __CUDAPREFIX__ void operator()(uint64_t counter, VAL* values) const
+  {
+    PointDraws draws(epoch, counter);
+    values[0] = static_cast<VAL>(scale * sample_gamma(draws, shape));
+  }
+
+  uint32_t epoch;
+  double shape;
+  double scale;
+};
+
+// X / (X + Y) for X and Y gamma distributed with shapes a and b
+template <legate::LegateTypeCode CODE>
+struct RandomGenerator<RandGenCode::BETA, CODE> {
+  using VAL = legate::legate_type_of<CODE>;
+
+  static constexpr bool valid          = RandomFloatingPoint<CODE>::valid;
+  static constexpr int VALUES_PER_DRAW = 1;
+  static constexpr bool STREAMABLE     = false;
+
+  RandomGenerator(uint32_t ep, const std::vector<legate::Store>& args) : epoch(ep)
+  {
+    assert(args.size() == 2);
+    a = args[0].scalar<double>();
+    b = args[1].scalar<double>();
+  }
+
+  __CUDAPREFIX__ void operator()(uint64_t counter, VAL* values) const
+  {
+    PointDraws draws(epoch, counter);
+    const double x = sample_gamma(draws, a);
+    const double y = sample_gamma(draws, b);
+    values[0]      = static_cast<VAL>(x / (x + y));
+  }
+
+  uint32_t epoch;
+  double a;
+  double b;
+};
+
+template <legate::LegateTypeCode CODE>
+struct RandomGenerator<RandGenCode::POISSON, CODE> {
+  using VAL = legate::legate_type_of<CODE>;
+
+  static constexpr bool valid =
+    legate::is_integral<CODE>::value && CODE != legate::LegateTypeCode::BOOL_LT;
+  static constexpr int VALUES_PER_DRAW = 1;
+  static constexpr bool STREAMABLE     = false;
+
+  RandomGenerator(uint32_t ep, const std::vector<legate::Store>& args) : epoch(ep)
+  {
+    assert(args.size() == 1);
+    lam = args[0].scalar<double>();
+  }
+
+  __CUDAPREFIX__ void operator()(uint64_t counter, VAL* values) const
+  {
+    PointDraws draws(epoch, counter);
+    values[0] = static_cast<VAL>(sample_poisson(draws, lam));
+  }
+
+  uint32_t epoch;
+  double lam;
+};
+
+template <legate::LegateTypeCode CODE>
+struct RandomGenerator<RandGenCode::BINOMIAL, CODE> {
+  using VAL = legate::legate_type_of<CODE>;
+
+  static constexpr bool valid =
+    legate::is_integral<CODE>::value && CODE != legate::LegateTypeCode::BOOL_LT;
+  static constexpr int VALUES_PER_DRAW = 1;
+  static constexpr bool STREAMABLE     = false;
+
+  RandomGenerator(uint32_t ep, const std::vector<legate::Store>& args) : epoch(ep)
+  {
+    assert(args.size() == 2);
+    n = args[0].scalar<int64_t>();
+    p = args[1].scalar<double>();
+  }
+
+  __CUDAPREFIX__ void operator()(uint64_t counter, VAL* values) const
+  {
+    PointDraws draws(epoch, counter);
+    values[0] = static_cast<VAL>(sample_binomial(draws, n, p));
+  }
+
+  uint32_t epoch;
+  int64_t n;
+  double p;
+};
+
+// Every word of a draw is compared with p scaled to 32 bits and picks one of two values
+// of the output type, which makes boolean masks and the scaled masks of dropout in one
+// pass without a floating point temporary
+template <legate::LegateTypeCode CODE>
+struct RandomGenerator<RandGenCode::BERNOULLI, CODE> {
+  using RNG = Philox_4x32<10>;
+  using VAL = legate::legate_type_of<CODE>;
+
+  static constexpr bool valid =
+    legate::is_integral<CODE>::value || legate::is_floating_point<CODE>::value;
+  static constexpr int VALUES_PER_DRAW = 4;
+  static constexpr bool STREAMABLE     = true;
+
+  RandomGenerator(uint32_t ep, const std::vector<legate::Store>& args) : epoch(ep)
+  {
+    assert(args.size() == 3);
+    // A probability of one makes a threshold of 2^32, which every word is below
+    threshold = static_cast<uint64_t>(std::ldexp(args[0].scalar<double>(), 32));
+    on_value  = args[1].scalar<VAL>();
+    off_value = args[2].scalar<VAL>();
+  }
+
+  __CUDAPREFIX__ void operator()(uint64_t counter, VAL* values) const
+  {
+    transform(RNG::rand_raw(epoch, counter), values);
+  }
+
+  __CUDAPREFIX__ void transform(const typename RNG::Bits& bits, VAL* values) const
+  {
+    for (int idx = 0; idx < VALUES_PER_DRAW; idx++)
+      values[idx] = static_cast<uint64_t>(bits.words[idx]) < threshold ? on_value : off_value;
+  };
+
+  uint32_t epoch;
+  uint64_t threshold;
+  VAL on_value;
+  VAL off_value;
+};
+
 }  // namespace cunumeric
@@ -0,0 +1,203 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "cunumeric/random/philox.h"
+
+#include <cmath>
+
+namespace cunumeric {
+
+// The samplers of the distributions that take a variable number of uniform draws
+// per point. All of them compute in double precision and give up after a bounded
+// number of rejections, which none of their acceptance rates comes close to.
+
+static constexpr int MAX_SAMPLER_ATTEMPTS = 64;
+
+// A sequence of uniform draws for one point. They come from the Philox streams 1,
+// 2, ... of the point's counter, which the fixed-size draws in stream 0 never use,
+// so every point still gets the same values under any partitioning.
+class PointDraws {
+ public:
+  using RNG = Philox_4x32<10>;
+
+  __CUDAPREFIX__ PointDraws(uint32_t key, uint64_t counter)
+    : key_(key), counter_(counter), stream_(0), used_(2)
+  {
+  }
+
+  // returns a double in the open range (0.0, 1.0)
+  __CUDAPREFIX__ double uniform()
+  {
+    if (used_ == 2) {
+      bits_ = RNG::rand_raw(key_, counter_, ++stream_);
+      used_ = 0;
+    }
+    return RNG::to_double(bits_.dword(used_++)) + 0x1.p-54;
+  }
+
+  __CUDAPREFIX__ double normal()
+  {
+    const double radius = sqrt(-2.0 * log(uniform()));
+    return radius * cos(2.0 * M_PI * uniform());
+  }
+
+ private:
+  uint32_t key_;
+  uint64_t counter_;
+  uint64_t stream_;
+  int used_;
+  RNG::Bits bits_;
+};
+
+// Marsaglia and Tsang's method, with the boost u^(1/k) for shapes k below one
+__CUDAPREFIX__ inline double sample_gamma(PointDraws& draws, double shape)
+{
+  double boost = 1.0;
+  if (shape < 1.0) {
+    boost = pow(draws.uniform(), 1.0 / shape);
+    shape += 1.0;
+  }
+  const double d = shape - 1.0 / 3.0;
+  const double c = 1.0 / sqrt(9.0 * d);
+  double v       = 1.0;
+  for (int attempt = 0; attempt < MAX_SAMPLER_ATTEMPTS; attempt++) {
+    const double x = draws.normal();
+    v              = 1.0 + c * x;
+    if (v <= 0.0) continue;
+    v              = v * v * v;
+    const double u = draws.uniform();
+    if (u < 1.0 - 0.0331 * x * x * x * x) break;
+    if (log(u) < 0.5 * x * x + d * (1.0 - v + log(v))) break;
+  }
+  return boost * d * v;
+}
+
+// Inversion by sequential search for small means, followed by Hormann's PTRS
+// transformed rejection for the others
+__CUDAPREFIX__ inline int64_t sample_poisson(PointDraws& draws, double lam)
+{
+  if (lam <= 0.0) return 0;
+  if (lam < 10.0) {
+    const double u = draws.uniform();
+    double p       = exp(-lam);
+    double cdf     = p;
+    int64_t k      = 0;
+    while (cdf < u && k < 1000) {
+      k++;
+      p *= lam / k;
+      cdf += p;
+    }
+    return k;
+  }
+  const double slam     = sqrt(lam);
+  const double loglam   = log(lam);
+  const double b        = 0.931 + 2.53 * slam;
+  const double a        = -0.059 + 0.02483 * b;
+  const double invalpha = 1.1239 + 1.1328 / (b - 3.4);
+  const double vr       = 0.9277 - 3.6224 / (b - 2.0);
+  int64_t k             = static_cast<int64_t>(lam);
+  for (int attempt = 0; attempt < MAX_SAMPLER_ATTEMPTS; attempt++) {
+    const double u  = draws.uniform() - 0.5;
+    const double v  = draws.uniform();
+    const double us = 0.5 - fabs(u);
+    const double x  = floor((2.0 * a / us + b) * u + lam + 0.43);
+    if (us >= 0.07 && v <= vr) return static_cast<int64_t>(x);
+    if (x < 0.0 || (us < 0.013 && v > us)) continue;
+    if (log(v) + log(invalpha) - log(a / (us * us) + b) <= -lam + x * loglam - lgamma(x + 1.0))
+      return static_cast<int64_t>(x);
+  }
+  return k;
+}
+
+// The tail of Stirling's approximation of log(k!)
+__CUDAPREFIX__ inline double stirling_tail(double k)
+{
+  const double values[10] = {0.0810614667953272,
+                             0.0413406959554092,
+                             0.0276779256849983,
+                             0.02079067210376509,
+                             0.0166446911898211,
+                             0.0138761288230707,
+                             0.0118967099458917,
+                             0.0104112652619720,
+                             0.00925546218271273,
+                             0.00833056343336287};
+  if (k <= 9.0) return values[static_cast<int>(k)];
+  const double kp1sq = (k + 1.0) * (k + 1.0);
+  return (1.0 / 12 - (1.0 / 360 - 1.0 / 1260 / kp1sq) / kp1sq) / (k + 1.0);
+}
+
+// Inversion by sequential search for small means, followed by Hormann's BTRS
+// transformed rejection for the others. Both count the rarer outcome.
+__CUDAPREFIX__ inline int64_t sample_binomial_count(PointDraws& draws, int64_t n, double p)
+{
+  const double q = 1.0 - p;
+  if (n * p < 10.0) {
+    const double first = exp(n * log(q));
+    const double bound = fmin(static_cast<double>(n), n * p + 10.0 * sqrt(n * p * q + 1.0));
+    double u           = draws.uniform();
+    double px          = first;
+    int64_t k          = 0;
+    for (int attempt = 0; attempt < MAX_SAMPLER_ATTEMPTS && u > px;) {
+      k++;
+      if (k > bound) {
+        k  = 0;
+        px = first;
+        u  = draws.uniform();
+        attempt++;
+      } else {
+        u -= px;
+        px = ((n - k + 1) * p * px) / (k * q);
+      }
+    }
+    return k;
+  }
+  const double stddev = sqrt(n * p * q);
+  const double b      = 1.15 + 2.53 * stddev;
+  const double a      = -0.0873 + 0.0248 * b + 0.01 * p;
+  const double c      = n * p + 0.5;
+  const double vr     = 0.92 - 4.2 / b;
+  const double r      = p / q;
+  const double alpha  = (2.83 + 5.1 / b) * stddev;
+  const double m      = floor((n + 1) * p);
+  for (int attempt = 0; attempt < MAX_SAMPLER_ATTEMPTS; attempt++) {
+    const double u  = draws.uniform() - 0.5;
+    double v        = draws.uniform();
+    const double us = 0.5 - fabs(u);
+    const double k  = floor((2.0 * a / us + b) * u + c);
+    if (k < 0.0 || k > n) continue;
+    if (us >= 0.07 && v <= vr) return static_cast<int64_t>(k);
+    v                       = log(v * alpha / (a / (us * us) + b));
+    const double upperbound = (m + 0.5) * log((m + 1) / (r * (n - m + 1))) +
+                              (n + 1) * log((n - m + 1) / (n - k + 1)) +
+                              (k + 0.5) * log(r * (n - k + 1) / (k + 1)) + stirling_tail(m) +
+                              stirling_tail(n - m) - stirling_tail(k) - stirling_tail(n - k);
+    if (v <= upperbound) return static_cast<int64_t>(k);
+  }
+  return static_cast<int64_t>(m);
+}
+
+__CUDAPREFIX__ inline int64_t sample_binomial(PointDraws& draws, int64_t n, double p)
+{
+  if (n <= 0 || p <= 0.0) return 0;
+  if (p >= 1.0) return n;
+  if (p > 0.5) return n - sample_binomial_count(draws, n, 1.0 - p);
+  return sample_binomial_count(draws, n, p);
+}
+
+}  // namespace cunumeric
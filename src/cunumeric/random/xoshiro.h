@@ -0,0 +1,82 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+// Blackman and Vigna's xoshiro256** PRNG, along with the splitmix64 mixer that
+// seeds it
+
+#include <cstdint>
+
+#ifndef __CUDAPREFIX__
+#ifdef __NVCC__
+#define __CUDAPREFIX__ __device__ __forceinline__
+#else
+#define __CUDAPREFIX__
+#endif
+#endif
+
+namespace cunumeric {
+
+// The finalizer of splitmix64, which maps every 64-bit value to a well mixed one
+__CUDAPREFIX__
+static inline uint64_t mix64(uint64_t x)
+{
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+  return x ^ (x >> 31);
+}
+
+// The seed of the stream that fills one block of points of a tile, which depends
+// on the epoch, the offset of the tile in the whole array and the block index
+__CUDAPREFIX__
+static inline uint64_t stream_seed(unsigned epoch, uint64_t tile_offset, uint64_t block)
+{
+  const uint64_t golden = 0x9E3779B97F4A7C15ULL;
+  return mix64(mix64(epoch + golden * (tile_offset + 1)) + golden * (block + 1));
+}
+
+class Xoshiro256 {
+ public:
+  Xoshiro256(uint64_t seed)
+  {
+    // Consecutive splitmix64 outputs make a state that is never all zeros
+    for (int i = 0; i < 4; i++) {
+      seed += 0x9E3779B97F4A7C15ULL;
+      state[i] = mix64(seed);
+    }
+  }
+
+  inline uint64_t next()
+  {
+    const uint64_t result = rotl(state[1] * 5, 7) * 9;
+    const uint64_t t      = state[1] << 17;
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = rotl(state[3], 45);
+    return result;
+  }
+
+ private:
+  static inline uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+  uint64_t state[4];
+};
+
+}  // namespace cunumeric
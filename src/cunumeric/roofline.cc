@@ -0,0 +1,124 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/roofline.h"
+
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+#if defined(CUNUMERIC_ROOFLINE) && defined(LEGATE_USE_CUDA)
+#include <cuda_runtime.h>
+#endif
+
+namespace cunumeric {
+
+#ifdef CUNUMERIC_ROOFLINE
+
+#ifdef LEGATE_USE_CUDA
+extern cudaStream_t get_cached_stream();
+#endif
+
+namespace {
+
+struct RooflineTotals {
+  uint64_t count{0};
+  double bytes{0};
+  double flops{0};
+  double seconds{0};
+};
+
+using RooflineKey = std::tuple<std::string, int32_t, VariantKind>;
+
+std::mutex roofline_mutex;
+std::map<RooflineKey, RooflineTotals> roofline_totals;
+
+const char* variant_name(VariantKind kind)
+{
+  switch (kind) {
+    case VariantKind::CPU: return "cpu";
+    case VariantKind::OMP: return "omp";
+    case VariantKind::GPU: return "gpu";
+  }
+  return "unknown";
+}
+
+}  // namespace
+
+RooflineSample::RooflineSample(
+  const char* task, int32_t op_code, VariantKind kind, double bytes, double flops)
+  : task_(task),
+    op_code_(op_code),
+    kind_(kind),
+    bytes_(bytes),
+    flops_(flops),
+    start_(std::chrono::steady_clock::now())
+{
+}
+
+RooflineSample::~RooflineSample()
+{
+#ifdef LEGATE_USE_CUDA
+  if (kind_ == VariantKind::GPU) cudaStreamSynchronize(get_cached_stream());
+#endif
+  auto stop = std::chrono::steady_clock::now();
+
+  std::lock_guard<std::mutex> guard(roofline_mutex);
+  auto& totals = roofline_totals[RooflineKey(task_, op_code_, kind_)];
+  totals.count += 1;
+  totals.bytes += bytes_;
+  totals.flops += flops_;
+  totals.seconds += std::chrono::duration<double>(stop - start_).count();
+}
+
+static bool dump_roofline(const char* path)
+{
+  std::ofstream out(path);
+  if (!out) return false;
+
+  out.precision(15);
+
+  std::lock_guard<std::mutex> guard(roofline_mutex);
+  out << "{\"tasks\": [";
+  bool first = true;
+  for (auto& [key, totals] : roofline_totals) {
+    if (!first) out << ", ";
+    first = false;
+    out << "{\"task\": \"" << std::get<0>(key) << "\", \"op_code\": " << std::get<1>(key)
+        << ", \"variant\": \"" << variant_name(std::get<2>(key))
+        << "\", \"count\": " << totals.count << ", \"bytes\": " << totals.bytes
+        << ", \"flops\": " << totals.flops << ", \"seconds\": " << totals.seconds << "}";
+  }
+  out << "]}\n";
+  return true;
+}
+
+#endif
+
+}  // namespace cunumeric
+
+extern "C" {
+
+int cunumeric_roofline_dump(const char* path)
+{
+#ifdef CUNUMERIC_ROOFLINE
+  return cunumeric::dump_roofline(path);
+#else
+  return 0;
+#endif
+}
+}
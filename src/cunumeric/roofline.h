@@ -0,0 +1,57 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "cunumeric/cunumeric.h"
+
+#include <chrono>
+
+namespace cunumeric {
+
+#ifdef CUNUMERIC_ROOFLINE
+
+// Measures the wall time of a task body and adds it, together with the bytes the body moves
+// and the FLOPs it performs, to the totals of its task, op code and variant. GPU bodies are
+// waited on before the time is taken, which serializes them with the tasks that follow.
+class RooflineSample {
+ public:
+  RooflineSample(const char* task, int32_t op_code, VariantKind kind, double bytes, double flops);
+  ~RooflineSample();
+
+ private:
+  const char* task_;
+  int32_t op_code_;
+  VariantKind kind_;
+  double bytes_;
+  double flops_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+#define CUNUMERIC_ROOFLINE_SAMPLE(task, op_code, kind, bytes, flops) \
+  RooflineSample roofline_sample(task,                               \
+                                 static_cast<int32_t>(op_code),      \
+                                 kind,                               \
+                                 static_cast<double>(bytes),         \
+                                 static_cast<double>(flops))
+
+#else
+
+#define CUNUMERIC_ROOFLINE_SAMPLE(task, op_code, kind, bytes, flops)
+
+#endif
+
+}  // namespace cunumeric
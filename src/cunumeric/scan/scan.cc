@@ -0,0 +1,89 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/scan/scan.h"
+#include "cunumeric/scan/scan_template.inl"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <UnaryRedCode OP_CODE, LegateTypeCode CODE, int DIM>
+struct ScanImplBody<VariantKind::CPU, OP_CODE, CODE, DIM> {
+  using OP  = UnaryRedOp<OP_CODE, CODE>;
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(const AccessorWO<VAL, DIM>& out,
+                  const AccessorRO<VAL, DIM>& in,
+                  const AccessorWO<VAL, DIM>& totals,
+                  const bool has_totals,
+                  const coord_t totals_pos,
+                  const ScanRows<DIM>& rows)
+  {
+    for (size_t row = 0; row < rows.num_rows; ++row) {
+      auto point = rows.point(row, 0);
+      VAL value  = in[point];
+      out[point] = value;
+      for (size_t pos = 1; pos < rows.length; ++pos) {
+        point = rows.point(row, pos);
+        OP::template fold<true>(value, in[point]);
+        out[point] = value;
+      }
+      if (has_totals) {
+        point[rows.axis] = totals_pos;
+        totals[point]    = value;
+      }
+    }
+  }
+};
+
+template <UnaryRedCode OP_CODE, LegateTypeCode CODE, int DIM>
+struct ScanFixupImplBody<VariantKind::CPU, OP_CODE, CODE, DIM> {
+  using OP  = UnaryRedOp<OP_CODE, CODE>;
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(const AccessorRW<VAL, DIM>& out,
+                  const AccessorRO<VAL, DIM>& prefix,
+                  const coord_t prefix_pos,
+                  const int32_t axis,
+                  const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& rect,
+                  const size_t volume)
+  {
+    for (size_t idx = 0; idx < volume; ++idx) {
+      auto point         = pitches.unflatten(idx, rect.lo);
+      auto prefix_point  = point;
+      prefix_point[axis] = prefix_pos;
+      VAL value          = prefix[prefix_point];
+      OP::template fold<true>(value, out[point]);
+      out[point] = value;
+    }
+  }
+};
+
+/*static*/ void ScanTask::cpu_variant(TaskContext& context)
+{
+  scan_template<VariantKind::CPU>(context);
+}
+
+namespace  // unnamed
+{
+static void __attribute__((constructor)) register_tasks(void) { ScanTask::register_variants(); }
+}  // namespace
+
+}  // namespace cunumeric
@@ -0,0 +1,162 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/scan/scan.h"
+#include "cunumeric/scan/scan_template.inl"
+
+#include <thrust/scan.h>
+#include <thrust/execution_policy.h>
+#include <thrust/functional.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/transform_iterator.h>
+
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+
+// The elements are scanned in the order of the rows, one row after the other, so the
+// scan of every row is keyed by its index
+struct ScanRowKey {
+  __CUDA_HD__ inline size_t operator()(size_t idx) const { return idx / length; }
+
+  size_t length;
+};
+
+template <typename VAL, int32_t DIM>
+struct ScanLoad {
+  __CUDA_HD__ inline VAL operator()(size_t idx) const
+  {
+    return in[rows.point(idx / rows.length, idx % rows.length)];
+  }
+
+  AccessorRO<VAL, DIM> in;
+  ScanRows<DIM> rows;
+};
+
+template <typename OP, typename VAL>
+struct ScanFold {
+  __CUDA_HD__ inline VAL operator()(VAL lhs, const VAL& rhs) const
+  {
+    OP::template fold<true>(lhs, rhs);
+    return lhs;
+  }
+};
+
+template <typename VAL, int32_t DIM>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  scan_store_kernel(size_t volume,
+                    AccessorWO<VAL, DIM> out,
+                    AccessorWO<VAL, DIM> totals,
+                    bool has_totals,
+                    coord_t totals_pos,
+                    ScanRows<DIM> rows,
+                    const VAL* scanned)
+{
+  const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx >= volume) return;
+  const size_t pos = idx % rows.length;
+  auto point       = rows.point(idx / rows.length, pos);
+  out[point]       = scanned[idx];
+  if (has_totals && pos == rows.length - 1) {
+    point[rows.axis] = totals_pos;
+    totals[point]    = scanned[idx];
+  }
+}
+
+template <typename OP, typename VAL, int32_t DIM>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  scan_fixup_kernel(size_t volume,
+                    AccessorRW<VAL, DIM> out,
+                    AccessorRO<VAL, DIM> prefix,
+                    coord_t prefix_pos,
+                    int32_t axis,
+                    Pitches<DIM - 1> pitches,
+                    Point<DIM> lo)
+{
+  const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx >= volume) return;
+  auto point         = pitches.unflatten(idx, lo);
+  auto prefix_point  = point;
+  prefix_point[axis] = prefix_pos;
+  VAL value          = prefix[prefix_point];
+  OP::template fold<true>(value, out[point]);
+  out[point] = value;
+}
+
+template <UnaryRedCode OP_CODE, LegateTypeCode CODE, int DIM>
+struct ScanImplBody<VariantKind::GPU, OP_CODE, CODE, DIM> {
+  using OP  = UnaryRedOp<OP_CODE, CODE>;
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(const AccessorWO<VAL, DIM>& out,
+                  const AccessorRO<VAL, DIM>& in,
+                  const AccessorWO<VAL, DIM>& totals,
+                  const bool has_totals,
+                  const coord_t totals_pos,
+                  const ScanRows<DIM>& rows)
+  {
+    auto stream = get_cached_stream();
+
+    // All the rows are scanned by a single segmented scan into a dense buffer, which is
+    // then written back along the axis
+    const size_t volume = rows.num_rows * rows.length;
+    ScratchBuffer<VAL> scanned(volume);
+    auto indices        = thrust::counting_iterator<size_t>(0);
+    auto keys           = thrust::make_transform_iterator(indices, ScanRowKey{rows.length});
+    auto values         = thrust::make_transform_iterator(indices, ScanLoad<VAL, DIM>{in, rows});
+    thrust::inclusive_scan_by_key(thrust::cuda::par.on(stream),
+                                  keys,
+                                  keys + volume,
+                                  values,
+                                  scanned.ptr(0),
+                                  thrust::equal_to<size_t>(),
+                                  ScanFold<OP, VAL>{});
+
+    const size_t blocks = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+    scan_store_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+      volume, out, totals, has_totals, totals_pos, rows, scanned.ptr(0));
+  }
+};
+
+template <UnaryRedCode OP_CODE, LegateTypeCode CODE, int DIM>
+struct ScanFixupImplBody<VariantKind::GPU, OP_CODE, CODE, DIM> {
+  using OP  = UnaryRedOp<OP_CODE, CODE>;
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(const AccessorRW<VAL, DIM>& out,
+                  const AccessorRO<VAL, DIM>& prefix,
+                  const coord_t prefix_pos,
+                  const int32_t axis,
+                  const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& rect,
+                  const size_t volume)
+  {
+    auto stream         = get_cached_stream();
+    const size_t blocks = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+    scan_fixup_kernel<OP><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+      volume, out, prefix, prefix_pos, axis, pitches, rect.lo);
+  }
+};
+
+/*static*/ void ScanTask::gpu_variant(TaskContext& context)
+{
+  scan_template<VariantKind::GPU>(context);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,53 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#pragma once
+
+#include "cunumeric/cunumeric.h"
+#include "cunumeric/unary/unary_red_util.h"
+
+namespace cunumeric {
+
+// The task runs in two modes. The scan mode writes the inclusive scan of the input along
+// the axis into the output, and the last element of every row into the optional totals,
+// whose pieces have an extent of one along the axis. The fixup mode folds the prefix in
+// the input, also of extent one along the axis, into every element of its rows of the
+// output, which is the second input as well.
+struct ScanArgs {
+  const Array& input;
+  Array& output;
+  Array* totals;
+  int32_t axis;
+  UnaryRedCode op_code;
+  bool fixup;
+};
+
+class ScanTask : public CuNumericTask<ScanTask> {
+ public:
+  static const int TASK_ID = CUNUMERIC_SCAN;
+
+ public:
+  static void cpu_variant(legate::TaskContext& context);
+#ifdef LEGATE_USE_OPENMP
+  static void omp_variant(legate::TaskContext& context);
+#endif
+#ifdef LEGATE_USE_CUDA
+  static void gpu_variant(legate::TaskContext& context);
+#endif
+};
+
+}  // namespace cunumeric
@@ -0,0 +1,151 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/scan/scan.h"
+#include "cunumeric/scan/scan_template.inl"
+
+#include <omp.h>
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <UnaryRedCode OP_CODE, LegateTypeCode CODE, int DIM>
+struct ScanImplBody<VariantKind::OMP, OP_CODE, CODE, DIM> {
+  using OP  = UnaryRedOp<OP_CODE, CODE>;
+  using VAL = legate_type_of<CODE>;
+
+  // Scans the positions [lo, hi) of a row starting from the given value and returns the
+  // last element of the scan
+  static VAL scan_block(const AccessorWO<VAL, DIM>& out,
+                        const AccessorRO<VAL, DIM>& in,
+                        const ScanRows<DIM>& rows,
+                        size_t row,
+                        size_t lo,
+                        size_t hi,
+                        VAL value)
+  {
+    for (size_t pos = lo; pos < hi; ++pos) {
+      auto point = rows.point(row, pos);
+      OP::template fold<true>(value, in[point]);
+      out[point] = value;
+    }
+    return value;
+  }
+
+  void operator()(const AccessorWO<VAL, DIM>& out,
+                  const AccessorRO<VAL, DIM>& in,
+                  const AccessorWO<VAL, DIM>& totals,
+                  const bool has_totals,
+                  const coord_t totals_pos,
+                  const ScanRows<DIM>& rows)
+  {
+    const size_t num_threads = omp_get_max_threads();
+
+    // The rows are spread over the threads when there are enough of them
+    if (rows.num_rows >= num_threads) {
+#pragma omp parallel for schedule(static)
+      for (size_t row = 0; row < rows.num_rows; ++row) {
+        auto point       = rows.point(row, 0);
+        out[point]       = in[point];
+        const auto value = scan_block(out, in, rows, row, 1, rows.length, in[point]);
+        if (has_totals) {
+          point[rows.axis] = totals_pos;
+          totals[point]    = value;
+        }
+      }
+      return;
+    }
+
+    // Otherwise every row is cut into one block per thread. The blocks are scanned
+    // independently, the scan of their totals is taken sequentially, and every block but
+    // the first then folds in the total of the blocks before it.
+    const size_t num_blocks = std::min(num_threads, rows.length);
+    const size_t block_size = (rows.length + num_blocks - 1) / num_blocks;
+    std::vector<VAL> partials(num_blocks);
+    for (size_t row = 0; row < rows.num_rows; ++row) {
+#pragma omp parallel for schedule(static, 1)
+      for (size_t block = 0; block < num_blocks; ++block) {
+        const size_t lo = std::min(block * block_size, rows.length);
+        const size_t hi = std::min(lo + block_size, rows.length);
+        if (lo == hi) continue;
+        auto point      = rows.point(row, lo);
+        out[point]      = in[point];
+        partials[block] = scan_block(out, in, rows, row, lo + 1, hi, in[point]);
+      }
+
+      size_t last = 0;
+      for (size_t block = 1; block < num_blocks && block * block_size < rows.length; ++block) {
+        VAL value = partials[block - 1];
+        OP::template fold<true>(value, partials[block]);
+        partials[block] = value;
+        last            = block;
+      }
+
+#pragma omp parallel for schedule(static, 1)
+      for (size_t block = 1; block <= last; ++block) {
+        const size_t lo = block * block_size;
+        const size_t hi = std::min(lo + block_size, rows.length);
+        for (size_t pos = lo; pos < hi; ++pos) {
+          auto point = rows.point(row, pos);
+          VAL value  = partials[block - 1];
+          OP::template fold<true>(value, out[point]);
+          out[point] = value;
+        }
+      }
+
+      if (has_totals) {
+        auto point       = rows.point(row, 0);
+        point[rows.axis] = totals_pos;
+        totals[point]    = partials[last];
+      }
+    }
+  }
+};
+
+template <UnaryRedCode OP_CODE, LegateTypeCode CODE, int DIM>
+struct ScanFixupImplBody<VariantKind::OMP, OP_CODE, CODE, DIM> {
+  using OP  = UnaryRedOp<OP_CODE, CODE>;
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(const AccessorRW<VAL, DIM>& out,
+                  const AccessorRO<VAL, DIM>& prefix,
+                  const coord_t prefix_pos,
+                  const int32_t axis,
+                  const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& rect,
+                  const size_t volume)
+  {
+#pragma omp parallel for schedule(static)
+    for (size_t idx = 0; idx < volume; ++idx) {
+      auto point         = pitches.unflatten(idx, rect.lo);
+      auto prefix_point  = point;
+      prefix_point[axis] = prefix_pos;
+      VAL value          = prefix[prefix_point];
+      OP::template fold<true>(value, out[point]);
+      out[point] = value;
+    }
+  }
+};
+
+/*static*/ void ScanTask::omp_variant(TaskContext& context)
+{
+  scan_template<VariantKind::OMP>(context);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,143 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/pitches.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+// Scans are only defined for these reductions, on the types that the reductions support
+template <UnaryRedCode OP_CODE, LegateTypeCode CODE>
+struct ScanOp {
+  static constexpr bool valid =
+    UnaryRedOp<OP_CODE, CODE>::valid &&
+    (OP_CODE == UnaryRedCode::SUM || OP_CODE == UnaryRedCode::PROD ||
+     OP_CODE == UnaryRedCode::MAX || OP_CODE == UnaryRedCode::MIN);
+};
+
+// Enumerates the rows of a rect along the scan axis
+template <int DIM>
+struct ScanRows {
+  void initialize(const Rect<DIM>& rect, int32_t scan_axis)
+  {
+    axis              = scan_axis;
+    lo_               = rect.lo;
+    auto row_rect     = rect;
+    row_rect.hi[axis] = rect.lo[axis];
+    num_rows          = pitches_.flatten(row_rect);
+    length            = rect.hi[axis] - rect.lo[axis] + 1;
+  }
+
+  __CUDA_HD__ inline Point<DIM> point(size_t row, size_t pos) const
+  {
+    auto point = pitches_.unflatten(row, lo_);
+    point[axis] += pos;
+    return point;
+  }
+
+  size_t num_rows;
+  size_t length;
+  int32_t axis;
+  Pitches<DIM - 1> pitches_;
+  Point<DIM> lo_;
+};
+
+template <VariantKind KIND, UnaryRedCode OP_CODE, LegateTypeCode CODE, int DIM>
+struct ScanImplBody;
+
+template <VariantKind KIND, UnaryRedCode OP_CODE, LegateTypeCode CODE, int DIM>
+struct ScanFixupImplBody;
+
+template <VariantKind KIND, UnaryRedCode OP_CODE>
+struct ScanImpl {
+  template <LegateTypeCode CODE,
+            int DIM,
+            std::enable_if_t<ScanOp<OP_CODE, CODE>::valid>* = nullptr>
+  void operator()(ScanArgs& args) const
+  {
+    using VAL = legate_type_of<CODE>;
+
+    auto rect = args.output.shape<DIM>();
+
+    Pitches<DIM - 1> pitches;
+    size_t volume = pitches.flatten(rect);
+
+    if (volume == 0) return;
+
+    if (args.fixup) {
+      auto prefix_rect = args.input.shape<DIM>();
+      auto out         = args.output.read_write_accessor<VAL, DIM>(rect);
+      auto prefix      = args.input.read_accessor<VAL, DIM>(prefix_rect);
+      ScanFixupImplBody<KIND, OP_CODE, CODE, DIM>()(
+        out, prefix, prefix_rect.lo[args.axis], args.axis, pitches, rect, volume);
+      return;
+    }
+
+    ScanRows<DIM> rows;
+    rows.initialize(rect, args.axis);
+
+    auto out = args.output.write_accessor<VAL, DIM>(rect);
+    auto in  = args.input.read_accessor<VAL, DIM>(rect);
+    AccessorWO<VAL, DIM> totals;
+    coord_t totals_pos = 0;
+    if (args.totals != nullptr) {
+      auto totals_rect = args.totals->shape<DIM>();
+      totals           = args.totals->write_accessor<VAL, DIM>(totals_rect);
+      totals_pos       = totals_rect.lo[args.axis];
+    }
+    ScanImplBody<KIND, OP_CODE, CODE, DIM>()(
+      out, in, totals, args.totals != nullptr, totals_pos, rows);
+  }
+
+  template <LegateTypeCode CODE,
+            int DIM,
+            std::enable_if_t<!ScanOp<OP_CODE, CODE>::valid>* = nullptr>
+  void operator()(ScanArgs& args) const
+  {
+    assert(false);
+  }
+};
+
+template <VariantKind KIND>
+struct ScanDispatch {
+  template <UnaryRedCode OP_CODE>
+  void operator()(ScanArgs& args) const
+  {
+    return cunumeric::double_dispatch(
+      args.output.dim(), args.output.code(), ScanImpl<KIND, OP_CODE>{}, args);
+  }
+};
+
+template <VariantKind KIND>
+static void scan_template(TaskContext& context)
+{
+  auto& inputs  = context.inputs();
+  auto& outputs = context.outputs();
+  auto& scalars = context.scalars();
+
+  ScanArgs args{inputs[0],
+                outputs[0],
+                outputs.size() > 1 ? &outputs[1] : nullptr,
+                scalars[1].value<int32_t>(),
+                scalars[0].value<UnaryRedCode>(),
+                scalars[2].value<bool>()};
+  op_dispatch(args.op_code, ScanDispatch<KIND>{}, args);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,83 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/search/bucket.h"
+#include "cunumeric/search/bucket_template.inl"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <LegateTypeCode CODE>
+struct BucketImplBody<VariantKind::CPU, CODE> {
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(const AccessorRO<VAL, 1>& in,
+                  const Rect<1>& rect,
+                  const AccessorRO<VAL, 1>& splitters,
+                  const Rect<1>& splitter_rect,
+                  const AccessorRO<double, 1>& in_weights,
+                  const bool with_indices,
+                  const bool with_weights,
+                  std::vector<Buffer<VAL>>& values,
+                  std::vector<Buffer<int64_t>>& indices,
+                  std::vector<Buffer<double>>& weights,
+                  std::vector<size_t>& sizes)
+  {
+    const size_t volume        = rect.volume();
+    const size_t num_splitters = splitter_rect.volume();
+    const size_t num_buckets   = num_splitters + 1;
+
+    auto buckets = create_buffer<uint32_t>(volume, Memory::Kind::SYSTEM_MEM);
+    for (size_t idx = 0; idx < volume; ++idx) {
+      const auto bucket =
+        sorted_bound<false>(splitters, splitter_rect.lo[0], num_splitters, in[rect.lo[0] + idx]);
+      buckets[idx]      = bucket;
+      ++sizes[bucket];
+    }
+
+    for (size_t bucket = 0; bucket < num_buckets; ++bucket) {
+      values[bucket] = create_buffer<VAL>(sizes[bucket], Memory::Kind::SYSTEM_MEM);
+      if (with_indices)
+        indices[bucket] = create_buffer<int64_t>(sizes[bucket], Memory::Kind::SYSTEM_MEM);
+      if (with_weights)
+        weights[bucket] = create_buffer<double>(sizes[bucket], Memory::Kind::SYSTEM_MEM);
+    }
+
+    std::vector<size_t> next(num_buckets, 0);
+    for (size_t idx = 0; idx < volume; ++idx) {
+      const auto bucket   = buckets[idx];
+      const auto pos      = next[bucket]++;
+      values[bucket][pos] = in[rect.lo[0] + idx];
+      if (with_indices) indices[bucket][pos] = rect.lo[0] + idx;
+      if (with_weights) weights[bucket][pos] = in_weights[rect.lo[0] + idx];
+    }
+  }
+};
+
+/*static*/ void BucketTask::cpu_variant(TaskContext& context)
+{
+  bucket_template<VariantKind::CPU>(context);
+}
+
+namespace  // unnamed
+{
+static void __attribute__((constructor)) register_tasks(void) { BucketTask::register_variants(); }
+}  // namespace
+
+}  // namespace cunumeric
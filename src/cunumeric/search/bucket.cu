@@ -0,0 +1,150 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/search/bucket.h"
+#include "cunumeric/search/bucket_template.inl"
+
+#include <thrust/binary_search.h>
+#include <thrust/sort.h>
+#include <thrust/execution_policy.h>
+#include <thrust/iterator/counting_iterator.h>
+
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+
+template <typename VAL>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  bucket_id_kernel(size_t volume,
+                   AccessorRO<VAL, 1> in,
+                   coord_t lo,
+                   AccessorRO<VAL, 1> splitters,
+                   coord_t splitter_lo,
+                   size_t num_splitters,
+                   uint32_t* buckets,
+                   int64_t* positions)
+{
+  const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx >= volume) return;
+  buckets[idx]   = sorted_bound<false>(splitters, splitter_lo, num_splitters, in[lo + idx]);
+  positions[idx] = idx;
+}
+
+template <typename VAL>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  bucket_gather_kernel(size_t size,
+                       AccessorRO<VAL, 1> in,
+                       coord_t lo,
+                       AccessorRO<double, 1> in_weights,
+                       const int64_t* positions,
+                       VAL* values,
+                       int64_t* indices,
+                       double* weights)
+{
+  const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx >= size) return;
+  const int64_t index = lo + positions[idx];
+  values[idx]         = in[index];
+  if (indices != nullptr) indices[idx] = index;
+  if (weights != nullptr) weights[idx] = in_weights[index];
+}
+
+template <LegateTypeCode CODE>
+struct BucketImplBody<VariantKind::GPU, CODE> {
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(const AccessorRO<VAL, 1>& in,
+                  const Rect<1>& rect,
+                  const AccessorRO<VAL, 1>& splitters,
+                  const Rect<1>& splitter_rect,
+                  const AccessorRO<double, 1>& in_weights,
+                  const bool with_indices,
+                  const bool with_weights,
+                  std::vector<Buffer<VAL>>& values,
+                  std::vector<Buffer<int64_t>>& indices,
+                  std::vector<Buffer<double>>& weights,
+                  std::vector<size_t>& sizes)
+  {
+    auto stream = get_cached_stream();
+
+    const size_t volume        = rect.volume();
+    const size_t num_splitters = splitter_rect.volume();
+    const size_t num_buckets   = num_splitters + 1;
+
+    // The positions of the elements are sorted by bucket, which keeps them in order within
+    // every bucket, and the bounds of the buckets are then found by binary searches
+    ScratchBuffer<uint32_t> buckets(volume);
+    ScratchBuffer<int64_t> positions(volume);
+    ScratchBuffer<size_t> bounds(num_buckets + 1);
+    auto p_buckets = buckets.ptr(0);
+    auto p_bounds  = bounds.ptr(0);
+
+    const size_t blocks = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+    bucket_id_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(volume,
+                                                                in,
+                                                                rect.lo[0],
+                                                                splitters,
+                                                                splitter_rect.lo[0],
+                                                                num_splitters,
+                                                                p_buckets,
+                                                                positions.ptr(0));
+    thrust::stable_sort_by_key(
+      thrust::cuda::par.on(stream), p_buckets, p_buckets + volume, positions.ptr(0));
+    thrust::lower_bound(thrust::cuda::par.on(stream),
+                        p_buckets,
+                        p_buckets + volume,
+                        thrust::counting_iterator<uint32_t>(0),
+                        thrust::counting_iterator<uint32_t>(num_buckets + 1),
+                        p_bounds);
+
+    std::vector<size_t> offsets(num_buckets + 1);
+    CHECK_CUDA(cudaMemcpyAsync(offsets.data(),
+                               p_bounds,
+                               (num_buckets + 1) * sizeof(size_t),
+                               cudaMemcpyDeviceToHost,
+                               stream));
+    CHECK_CUDA(cudaStreamSynchronize(stream));
+
+    for (size_t bucket = 0; bucket < num_buckets; ++bucket) {
+      const size_t size = offsets[bucket + 1] - offsets[bucket];
+      sizes[bucket]     = size;
+      values[bucket]    = create_buffer<VAL>(size, Memory::Kind::GPU_FB_MEM);
+      if (with_indices) indices[bucket] = create_buffer<int64_t>(size, Memory::Kind::GPU_FB_MEM);
+      if (with_weights) weights[bucket] = create_buffer<double>(size, Memory::Kind::GPU_FB_MEM);
+      if (size == 0) continue;
+      const size_t bucket_blocks = (size + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+      bucket_gather_kernel<<<bucket_blocks, THREADS_PER_BLOCK, 0, stream>>>(
+        size,
+        in,
+        rect.lo[0],
+        in_weights,
+        positions.ptr(0) + offsets[bucket],
+        values[bucket].ptr(0),
+        with_indices ? indices[bucket].ptr(0) : nullptr,
+        with_weights ? weights[bucket].ptr(0) : nullptr);
+    }
+  }
+};
+
+/*static*/ void BucketTask::gpu_variant(TaskContext& context)
+{
+  bucket_template<VariantKind::GPU>(context);
+}
+
+}  // namespace cunumeric
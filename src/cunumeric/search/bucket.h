@@ -0,0 +1,51 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#pragma once
+
+#include "cunumeric/cunumeric.h"
+
+namespace cunumeric {
+
+struct BucketArgs {
+  const Array& input;
+  const Array& splitters;
+  const Array* weights;
+  std::vector<Array>& outputs;
+};
+
+// Scatters the elements of a 1-D array into the buckets that its sorted splitters delimit,
+// which is the exchange step of a sample sort. Bucket b receives the elements greater
+// than splitter b - 1 and no greater than splitter b in an unbound output of its own,
+// followed by their global indices in a second set of outputs when there are twice as
+// many outputs as buckets. An optional third input of float64 weights aligned with the
+// elements is carried along into one more set of outputs, after the indices if any.
+class BucketTask : public CuNumericTask<BucketTask> {
+ public:
+  static const int TASK_ID = CUNUMERIC_BUCKET;
+
+ public:
+  static void cpu_variant(legate::TaskContext& context);
+#ifdef LEGATE_USE_OPENMP
+  static void omp_variant(legate::TaskContext& context);
+#endif
+#ifdef LEGATE_USE_CUDA
+  static void gpu_variant(legate::TaskContext& context);
+#endif
+};
+
+}  // namespace cunumeric
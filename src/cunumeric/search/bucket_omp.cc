@@ -0,0 +1,101 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/search/bucket.h"
+#include "cunumeric/search/bucket_template.inl"
+
+#include <omp.h>
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <LegateTypeCode CODE>
+struct BucketImplBody<VariantKind::OMP, CODE> {
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(const AccessorRO<VAL, 1>& in,
+                  const Rect<1>& rect,
+                  const AccessorRO<VAL, 1>& splitters,
+                  const Rect<1>& splitter_rect,
+                  const AccessorRO<double, 1>& in_weights,
+                  const bool with_indices,
+                  const bool with_weights,
+                  std::vector<Buffer<VAL>>& values,
+                  std::vector<Buffer<int64_t>>& indices,
+                  std::vector<Buffer<double>>& weights,
+                  std::vector<size_t>& sizes)
+  {
+    const size_t volume        = rect.volume();
+    const size_t num_splitters = splitter_rect.volume();
+    const size_t num_buckets   = num_splitters + 1;
+    const size_t num_chunks    = std::min<size_t>(omp_get_max_threads(), volume);
+    const size_t chunk_size    = (volume + num_chunks - 1) / num_chunks;
+
+    // Every chunk counts its elements of each bucket, and the counts are then scanned into
+    // the offsets of the chunks within the buckets, which keeps the elements in order
+    auto buckets = create_buffer<uint32_t>(volume, Memory::Kind::SOCKET_MEM);
+    std::vector<size_t> offsets(num_chunks * num_buckets, 0);
+#pragma omp parallel for schedule(static, 1)
+    for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
+      const size_t lo = std::min(chunk * chunk_size, volume);
+      const size_t hi = std::min(lo + chunk_size, volume);
+      auto counts     = offsets.data() + chunk * num_buckets;
+      for (size_t idx = lo; idx < hi; ++idx) {
+        const auto bucket =
+          sorted_bound<false>(splitters, splitter_rect.lo[0], num_splitters, in[rect.lo[0] + idx]);
+        buckets[idx]      = bucket;
+        ++counts[bucket];
+      }
+    }
+
+    for (size_t bucket = 0; bucket < num_buckets; ++bucket) {
+      size_t total = 0;
+      for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
+        const size_t count                    = offsets[chunk * num_buckets + bucket];
+        offsets[chunk * num_buckets + bucket] = total;
+        total += count;
+      }
+      sizes[bucket]  = total;
+      values[bucket] = create_buffer<VAL>(total, Memory::Kind::SOCKET_MEM);
+      if (with_indices) indices[bucket] = create_buffer<int64_t>(total, Memory::Kind::SOCKET_MEM);
+      if (with_weights) weights[bucket] = create_buffer<double>(total, Memory::Kind::SOCKET_MEM);
+    }
+
+#pragma omp parallel for schedule(static, 1)
+    for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
+      const size_t lo = std::min(chunk * chunk_size, volume);
+      const size_t hi = std::min(lo + chunk_size, volume);
+      auto next       = offsets.data() + chunk * num_buckets;
+      for (size_t idx = lo; idx < hi; ++idx) {
+        const auto bucket   = buckets[idx];
+        const auto pos      = next[bucket]++;
+        values[bucket][pos] = in[rect.lo[0] + idx];
+        if (with_indices) indices[bucket][pos] = rect.lo[0] + idx;
+        if (with_weights) weights[bucket][pos] = in_weights[rect.lo[0] + idx];
+      }
+    }
+  }
+};
+
+/*static*/ void BucketTask::omp_variant(TaskContext& context)
+{
+  bucket_template<VariantKind::OMP>(context);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,99 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/search/sort_util.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <VariantKind KIND, LegateTypeCode CODE>
+struct BucketImplBody;
+
+template <VariantKind KIND>
+struct BucketImpl {
+  template <LegateTypeCode CODE,
+            std::enable_if_t<!is_complex<legate_type_of<CODE>>::value>* = nullptr>
+  void operator()(BucketArgs& args) const
+  {
+    using VAL = legate_type_of<CODE>;
+
+    auto rect           = args.input.shape<1>();
+    auto splitter_rect  = args.splitters.shape<1>();
+    const size_t volume = rect.volume();
+
+    const size_t num_buckets = splitter_rect.volume() + 1;
+    const bool with_weights  = args.weights != nullptr;
+    const bool with_indices  = args.outputs.size() == (2 + with_weights) * num_buckets;
+    assert(with_indices || args.outputs.size() == (1 + with_weights) * num_buckets);
+
+    std::vector<Buffer<VAL>> values(num_buckets);
+    std::vector<Buffer<int64_t>> indices(with_indices ? num_buckets : 0);
+    std::vector<Buffer<double>> weights(with_weights ? num_buckets : 0);
+    std::vector<size_t> sizes(num_buckets, 0);
+
+    if (volume == 0) {
+      for (auto& bucket : values) bucket = create_buffer<VAL>(0);
+      for (auto& bucket : indices) bucket = create_buffer<int64_t>(0);
+      for (auto& bucket : weights) bucket = create_buffer<double>(0);
+    } else {
+      auto in        = args.input.read_accessor<VAL, 1>(rect);
+      auto splitters = args.splitters.read_accessor<VAL, 1>(splitter_rect);
+      AccessorRO<double, 1> in_weights;
+      if (with_weights) in_weights = args.weights->read_accessor<double, 1>(rect);
+      BucketImplBody<KIND, CODE>()(in,
+                                   rect,
+                                   splitters,
+                                   splitter_rect,
+                                   in_weights,
+                                   with_indices,
+                                   with_weights,
+                                   values,
+                                   indices,
+                                   weights,
+                                   sizes);
+    }
+
+    const size_t weights_first = (1 + with_indices) * num_buckets;
+    for (size_t bucket = 0; bucket < num_buckets; ++bucket) {
+      args.outputs[bucket].return_data(values[bucket], sizes[bucket]);
+      if (with_indices)
+        args.outputs[num_buckets + bucket].return_data(indices[bucket], sizes[bucket]);
+      if (with_weights)
+        args.outputs[weights_first + bucket].return_data(weights[bucket], sizes[bucket]);
+    }
+  }
+
+  template <LegateTypeCode CODE,
+            std::enable_if_t<is_complex<legate_type_of<CODE>>::value>* = nullptr>
+  void operator()(BucketArgs& args) const
+  {
+    assert(false);
+  }
+};
+
+template <VariantKind KIND>
+static void bucket_template(TaskContext& context)
+{
+  auto& inputs = context.inputs();
+  BucketArgs args{
+    inputs[0], inputs[1], inputs.size() > 2 ? &inputs[2] : nullptr, context.outputs()};
+  cunumeric::type_dispatch(args.input.code(), BucketImpl<KIND>{}, args);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,66 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/search/interp.h"
+#include "cunumeric/search/interp_template.inl"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <int DIM>
+struct InterpImplBody<VariantKind::CPU, DIM> {
+  void operator()(AccessorWO<double, DIM> out,
+                  AccessorRO<double, DIM> x,
+                  AccessorRO<double, 1> xp,
+                  AccessorRO<double, 1> fp,
+                  const Rect<1>& table_rect,
+                  const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& rect,
+                  bool dense,
+                  const InterpArgs& args) const
+  {
+    std::vector<double> xs, fs;
+    const auto bounds   = load_interp_table(xp, fp, table_rect, args, xs, fs);
+    const coord_t size  = static_cast<coord_t>(xs.size());
+    const size_t volume = rect.volume();
+    if (dense) {
+      auto outptr = out.ptr(rect);
+      auto xptr   = x.ptr(rect);
+      for (size_t idx = 0; idx < volume; ++idx)
+        outptr[idx] = interp_point(xptr[idx], xs, fs, size, bounds);
+    } else {
+      for (size_t idx = 0; idx < volume; ++idx) {
+        auto p = pitches.unflatten(idx, rect.lo);
+        out[p] = interp_point(x[p], xs, fs, size, bounds);
+      }
+    }
+  }
+};
+
+/*static*/ void InterpTask::cpu_variant(TaskContext& context)
+{
+  interp_template<VariantKind::CPU>(context);
+}
+
+namespace  // unnamed
+{
+static void __attribute__((constructor)) register_tasks(void) { InterpTask::register_variants(); }
+}  // namespace
+
+}  // namespace cunumeric
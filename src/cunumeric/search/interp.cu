@@ -0,0 +1,139 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/search/interp.h"
+#include "cunumeric/search/interp_template.inl"
+
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+// Tables of up to this many breakpoints are staged in the shared memory of every thread
+// block, together with their values
+constexpr coord_t INTERP_MAX_SMEM_POINTS = 3072;
+
+// Every thread block copies the table into shared memory and checks a share of the
+// breakpoints for uniform spacing, so the points of the block search a table that is
+// on chip or find their interval in closed form
+template <typename ReadAcc, typename WriteAcc, typename Pitches, typename Rect>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  shared_interp_kernel(size_t volume,
+                       WriteAcc out,
+                       ReadAcc x,
+                       const InterpTable xp,
+                       const InterpTable fp,
+                       coord_t size,
+                       InterpBounds bounds,
+                       bool has_left,
+                       bool has_right,
+                       Pitches pitches,
+                       Rect rect)
+{
+  // Deal with compiler shared memory stupidity
+  extern __shared__ uint8_t buffer[];
+  double* xs = reinterpret_cast<double*>(buffer);
+  double* fs = xs + size;
+
+  for (coord_t idx = threadIdx.x; idx < size; idx += blockDim.x) {
+    xs[idx] = xp[idx];
+    fs[idx] = fp[idx];
+  }
+  __syncthreads();
+  bool uniform = true;
+  for (coord_t idx = threadIdx.x + 1; idx < size - 1; idx += blockDim.x)
+    uniform = uniform && uniform_breakpoint(xs, size, idx);
+  uniform = __syncthreads_and(uniform) && size > 1;
+
+  if (!has_left) bounds.left = fs[0];
+  if (!has_right) bounds.right = fs[size - 1];
+  bounds.inv_step = uniform ? (size - 1) / (xs[size - 1] - xs[0]) : 0.0;
+
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x;
+  for (size_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < volume; idx += stride) {
+    auto point = pitches.unflatten(idx, rect.lo);
+    out[point] = interp_point(x[point], xs, fs, size, bounds);
+  }
+}
+
+// Larger tables are binary searched where they are
+template <typename ReadAcc, typename WriteAcc, typename Pitches, typename Rect>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  global_interp_kernel(size_t volume,
+                       WriteAcc out,
+                       ReadAcc x,
+                       const InterpTable xp,
+                       const InterpTable fp,
+                       coord_t size,
+                       InterpBounds bounds,
+                       bool has_left,
+                       bool has_right,
+                       Pitches pitches,
+                       Rect rect)
+{
+  if (!has_left) bounds.left = fp[0];
+  if (!has_right) bounds.right = fp[size - 1];
+
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x;
+  for (size_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < volume; idx += stride) {
+    auto point = pitches.unflatten(idx, rect.lo);
+    out[point] = interp_point(x[point], xp, fp, size, bounds);
+  }
+}
+
+template <int DIM>
+struct InterpImplBody<VariantKind::GPU, DIM> {
+  void operator()(AccessorWO<double, DIM> out,
+                  AccessorRO<double, DIM> x,
+                  AccessorRO<double, 1> xp,
+                  AccessorRO<double, 1> fp,
+                  const Rect<1>& table_rect,
+                  const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& rect,
+                  bool dense,
+                  const InterpArgs& args) const
+  {
+    auto stream = get_cached_stream();
+
+    const coord_t size  = table_rect.volume();
+    const size_t volume = rect.volume();
+    const size_t blocks = grid_stride_blocks<1>(volume);
+    const InterpTable xs{xp, table_rect.lo[0]};
+    const InterpTable fs{fp, table_rect.lo[0]};
+    const InterpBounds bounds{args.left, args.right, 0.0};
+
+    FastPitches<DIM - 1> fast_pitches;
+    fast_pitches.flatten(rect);
+    if (size <= INTERP_MAX_SMEM_POINTS) {
+      const size_t smem = 2 * size * sizeof(double);
+      shared_interp_kernel<<<blocks, THREADS_PER_BLOCK, smem, stream>>>(
+        volume, out, x, xs, fs, size, bounds, args.has_left, args.has_right, fast_pitches, rect);
+    } else {
+      global_interp_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+        volume, out, x, xs, fs, size, bounds, args.has_left, args.has_right, fast_pitches, rect);
+    }
+  }
+};
+
+/*static*/ void InterpTask::gpu_variant(TaskContext& context)
+{
+  interp_template<VariantKind::GPU>(context);
+}
+
+}  // namespace cunumeric
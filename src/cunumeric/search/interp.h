@@ -0,0 +1,53 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#pragma once
+
+#include "cunumeric/cunumeric.h"
+
+namespace cunumeric {
+
+struct InterpArgs {
+  // The sorted breakpoints and the values at them
+  const Array& xp;
+  const Array& fp;
+  const Array& x;
+  const Array& out;
+  // The values below the first breakpoint and above the last one, which are the values
+  // at those breakpoints unless given
+  bool has_left;
+  double left;
+  bool has_right;
+  double right;
+};
+
+// Interpolates a piecewise linear function given by its values at sorted breakpoints
+class InterpTask : public CuNumericTask<InterpTask> {
+ public:
+  static const int TASK_ID = CUNUMERIC_INTERP;
+
+ public:
+  static void cpu_variant(legate::TaskContext& context);
+#ifdef LEGATE_USE_OPENMP
+  static void omp_variant(legate::TaskContext& context);
+#endif
+#ifdef LEGATE_USE_CUDA
+  static void gpu_variant(legate::TaskContext& context);
+#endif
+};
+
+}  // namespace cunumeric
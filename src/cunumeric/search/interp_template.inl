@@ -0,0 +1,168 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/pitches.h"
+
+#include <cmath>
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+// Breakpoints are uniform when each one is within a quarter of the average spacing of
+// where an even grid puts it. The interval of a point is then at most one off from the
+// one its offset from the first breakpoint gives, which takes a single correction
+// instead of a binary search.
+template <typename TABLE>
+__CUDA_HD__ inline bool uniform_breakpoint(const TABLE& xp, coord_t size, coord_t idx)
+{
+  const double step = (xp[size - 1] - xp[0]) / (size - 1);
+  return step > 0 && fabs(xp[idx] - (xp[0] + idx * step)) <= 0.25 * step;
+}
+
+// The values outside of the breakpoints and the spacing of uniform breakpoints, whose
+// reciprocal is zero when they are not uniform
+struct InterpBounds {
+  double left;
+  double right;
+  double inv_step;
+};
+
+template <typename TABLE>
+__CUDA_HD__ inline double interp_point(
+  double x, const TABLE& xp, const TABLE& fp, coord_t size, const InterpBounds& bounds)
+{
+  // NaNs fail both comparisons and come out as they are
+  if (!(x >= xp[0])) return x < xp[0] ? bounds.left : x;
+  if (x >= xp[size - 1]) return x == xp[size - 1] ? fp[size - 1] : bounds.right;
+
+  // The interval [xp[lo], xp[lo + 1]) that holds x
+  coord_t lo;
+  if (bounds.inv_step > 0) {
+    lo = static_cast<coord_t>((x - xp[0]) * bounds.inv_step);
+    if (lo > size - 2) lo = size - 2;
+    if (x < xp[lo])
+      --lo;
+    else if (x >= xp[lo + 1])
+      ++lo;
+  } else {
+    lo         = 0;
+    coord_t hi = size - 1;
+    while (hi - lo > 1) {
+      const coord_t mid = lo + (hi - lo) / 2;
+      if (xp[mid] <= x)
+        lo = mid;
+      else
+        hi = mid;
+    }
+  }
+  const double slope = (fp[lo + 1] - fp[lo]) / (xp[lo + 1] - xp[lo]);
+  return slope * (x - xp[lo]) + fp[lo];
+}
+
+// The breakpoints of a table that starts wherever its store does
+struct InterpTable {
+  __CUDA_HD__ inline double operator[](coord_t idx) const { return acc[lo + idx]; }
+
+  AccessorRO<double, 1> acc;
+  coord_t lo;
+};
+
+// The CPUs copy the table next to the points, where it stays in cache, and check the
+// spacing of the breakpoints once for the whole tile
+inline InterpBounds load_interp_table(const AccessorRO<double, 1>& xp,
+                                      const AccessorRO<double, 1>& fp,
+                                      const Rect<1>& table_rect,
+                                      const InterpArgs& args,
+                                      std::vector<double>& xs,
+                                      std::vector<double>& fs)
+{
+  const coord_t size = table_rect.volume();
+  xs.resize(size);
+  fs.resize(size);
+  for (coord_t idx = 0; idx < size; ++idx) {
+    xs[idx] = xp[table_rect.lo + idx];
+    fs[idx] = fp[table_rect.lo + idx];
+  }
+  bool uniform = size > 1;
+  for (coord_t idx = 1; uniform && idx < size - 1; ++idx)
+    uniform = uniform_breakpoint(xs, size, idx);
+  return InterpBounds{args.has_left ? args.left : fs[0],
+                      args.has_right ? args.right : fs[size - 1],
+                      uniform ? (size - 1) / (xs[size - 1] - xs[0]) : 0.0};
+}
+
+template <VariantKind KIND, int DIM>
+struct InterpImplBody;
+
+// The points, the breakpoints and their values are all cast to doubles first
+template <VariantKind KIND>
+struct InterpImpl {
+  template <LegateTypeCode CODE,
+            int DIM,
+            std::enable_if_t<CODE == LegateTypeCode::DOUBLE_LT>* = nullptr>
+  void operator()(InterpArgs& args) const
+  {
+    auto rect       = args.out.shape<DIM>();
+    auto table_rect = args.xp.shape<1>();
+
+    Pitches<DIM - 1> pitches;
+    size_t volume = pitches.flatten(rect);
+
+    if (volume == 0) return;
+
+    auto out = args.out.write_accessor<double, DIM>(rect);
+    auto x   = args.x.read_accessor<double, DIM>(rect);
+    auto xp  = args.xp.read_accessor<double, 1>(table_rect);
+    auto fp  = args.fp.read_accessor<double, 1>(table_rect);
+
+#ifndef LEGION_BOUNDS_CHECKS
+    bool dense = out.accessor.is_dense_row_major(rect) && x.accessor.is_dense_row_major(rect);
+#else
+    bool dense = false;
+#endif
+
+    InterpImplBody<KIND, DIM>()(out, x, xp, fp, table_rect, pitches, rect, dense, args);
+  }
+
+  template <LegateTypeCode CODE,
+            int DIM,
+            std::enable_if_t<CODE != LegateTypeCode::DOUBLE_LT>* = nullptr>
+  void operator()(InterpArgs& args) const
+  {
+    assert(false);
+  }
+};
+
+template <VariantKind KIND>
+static void interp_template(TaskContext& context)
+{
+  auto& inputs  = context.inputs();
+  auto& scalars = context.scalars();
+  InterpArgs args{inputs[0],
+                  inputs[1],
+                  inputs[2],
+                  context.outputs()[0],
+                  scalars[0].value<bool>(),
+                  scalars[1].value<double>(),
+                  scalars[2].value<bool>(),
+                  scalars[3].value<double>()};
+  cunumeric::double_dispatch(args.x.dim(), args.x.code(), InterpImpl<KIND>{}, args);
+}
+
+}  // namespace cunumeric
@@ -30,7 +30,8 @@ struct NonzeroImplBody<VariantKind::CPU, CODE, DIM> {
                     const Pitches<DIM - 1>& pitches,
                     const Rect<DIM>& rect,
                     const size_t volume,
-                    std::vector<Buffer<int64_t>>& results)
+                    std::vector<Buffer<int64_t>>& results,
+                    bool interleaved)
   {
     int64_t size = 0;
 
@@ -39,14 +40,14 @@ struct NonzeroImplBody<VariantKind::CPU, CODE, DIM> {
       size += in[point] != VAL(0);
     }
 
-    for (auto& result : results) result = create_buffer<int64_t>(size, Memory::Kind::SYSTEM_MEM);
+    auto output =
+      create_nonzero_output<DIM>(results, interleaved, size, Memory::Kind::SYSTEM_MEM);
 
     int64_t out_idx = 0;
     for (size_t idx = 0; idx < volume; ++idx) {
       auto point = pitches.unflatten(idx, rect.lo);
       if (in[point] == VAL(0)) continue;
-      for (int32_t dim = 0; dim < DIM; ++dim) results[dim][out_idx] = point[dim];
-      ++out_idx;
+      output.write(out_idx++, point);
     }
     assert(size == out_idx);
 
@@ -26,119 +26,103 @@ namespace cunumeric {
 
 using namespace Legion;
 
-template <typename Output, typename Pitches, typename Point, typename VAL, int32_t DIM>
+template <typename Pitches, typename Point, typename VAL, int32_t DIM>
 static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
-  count_nonzero_kernel(size_t volume,
-                       Output out,
-                       AccessorRO<VAL, DIM> in,
-                       Pitches pitches,
-                       Point origin,
-                       size_t iters,
-                       Buffer<int64_t> offsets)
+  count_nonzero_kernel(
+    size_t volume, AccessorRO<VAL, DIM> in, Pitches pitches, Point origin, int64_t* counts)
 {
-  int64_t value = 0;
-  for (size_t idx = 0; idx < iters; idx++) {
-    const size_t offset = (idx * gridDim.x + blockIdx.x) * blockDim.x + threadIdx.x;
-    if (offset < volume) {
-      auto point      = pitches.unflatten(offset, origin);
-      auto val        = static_cast<int64_t>(in[point] != VAL(0));
-      offsets[offset] = val;
-      SumReduction<int64_t>::fold<true>(value, val);
-    }
+  const size_t start = blockIdx.x * COMPACTION_TILE;
+  int64_t value      = 0;
+  for (size_t idx = 0; idx < COMPACTION_TILE_ITEMS; idx++) {
+    const size_t offset = start + idx * THREADS_PER_BLOCK + threadIdx.x;
+    if (offset < volume) value += in[pitches.unflatten(offset, origin)] != VAL(0);
   }
   // Every thread in the thread block must participate in the exchange to get correct results
-  reduce_output(out, value);
+  value = block_reduce<SumReduction<int64_t>>(value);
+  if (threadIdx.x == 0) counts[blockIdx.x] = value;
 }
 
+// Writes the coordinates of the nonzeros of the tile from its offset on. Ranking the
+// points of each round in the block keeps the results in row-major order without any
+// per-point offsets.
 template <typename Pitches, typename Point, typename VAL, int32_t DIM>
 static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
   nonzero_kernel(size_t volume,
                  AccessorRO<VAL, DIM> in,
                  Pitches pitches,
                  Point origin,
-                 Buffer<int64_t> offsets,
-                 Buffer<int64_t*> p_results)
+                 const int64_t* offsets,
+                 NonzeroOutput<DIM> output)
 {
-  const size_t tid = blockIdx.x * blockDim.x + threadIdx.x;
-  if (tid >= volume) return;
-
-  auto point = pitches.unflatten(tid, origin);
-  if (in[point] != VAL(0)) {
-    auto offset = offsets[tid];
-    for (int32_t dim = 0; dim < DIM; ++dim) p_results[dim][offset] = point[dim];
+  const size_t start = blockIdx.x * COMPACTION_TILE;
+  int64_t next       = offsets[blockIdx.x];
+  for (size_t idx = 0; idx < COMPACTION_TILE_ITEMS; idx++) {
+    const size_t offset = start + idx * THREADS_PER_BLOCK + threadIdx.x;
+    Point point;
+    bool nonzero = false;
+    if (offset < volume) {
+      point   = pitches.unflatten(offset, origin);
+      nonzero = in[point] != VAL(0);
+    }
+    int total;
+    const int rank = block_exclusive_rank(nonzero, total);
+    if (nonzero) output.write(next + rank, point);
+    next += total;
   }
 }
 
-static void exclusive_sum(int64_t* offsets, size_t volume, cudaStream_t stream)
-{
-  thrust::exclusive_scan(thrust::cuda::par.on(stream), offsets, offsets + volume, offsets);
-}
-
 template <LegateTypeCode CODE, int32_t DIM>
 struct NonzeroImplBody<VariantKind::GPU, CODE, DIM> {
   using VAL = legate_type_of<CODE>;
 
+  // Counts the nonzeros of every tile and scans the counts into the offsets of the
+  // tiles, whose extra last entry is the total
   int64_t compute_offsets(const AccessorRO<VAL, DIM>& in,
-                          const Pitches<DIM - 1>& pitches,
+                          const FastPitches<DIM - 1>& pitches,
                           const Rect<DIM>& rect,
                           const size_t volume,
-                          Buffer<int64_t>& offsets,
+                          const size_t tiles,
+                          const ScratchBuffer<int64_t>& offsets,
                           cudaStream_t stream)
   {
-    DeferredReduction<SumReduction<int64_t>> size;
-
-    const size_t blocks = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
-    size_t shmem_size   = THREADS_PER_BLOCK / 32 * sizeof(int64_t);
-
-    if (blocks >= MAX_REDUCTION_CTAS) {
-      const size_t iters = (blocks + MAX_REDUCTION_CTAS - 1) / MAX_REDUCTION_CTAS;
-      count_nonzero_kernel<<<MAX_REDUCTION_CTAS, THREADS_PER_BLOCK, shmem_size, stream>>>(
-        volume, size, in, pitches, rect.lo, iters, offsets);
-    } else
-      count_nonzero_kernel<<<blocks, THREADS_PER_BLOCK, shmem_size, stream>>>(
-        volume, size, in, pitches, rect.lo, 1, offsets);
-
-    cudaStreamSynchronize(stream);
-
     auto p_offsets = offsets.ptr(0);
+    CHECK_CUDA(cudaMemsetAsync(p_offsets + tiles, 0, sizeof(int64_t), stream));
+    count_nonzero_kernel<<<tiles, THREADS_PER_BLOCK, 0, stream>>>(
+      volume, in, pitches, rect.lo, p_offsets);
 
-    exclusive_sum(p_offsets, volume, stream);
-
-    return size.read();
-  }
+    thrust::exclusive_scan(
+      thrust::cuda::par.on(stream), p_offsets, p_offsets + tiles + 1, p_offsets);
 
-  void populate_nonzeros(const AccessorRO<VAL, DIM>& in,
-                         const Pitches<DIM - 1>& pitches,
-                         const Rect<DIM>& rect,
-                         const size_t volume,
-                         std::vector<Buffer<int64_t>>& results,
-                         Buffer<int64_t>& offsets,
-                         cudaStream_t stream)
-  {
-    auto ndims     = static_cast<int32_t>(results.size());
-    auto p_results = create_buffer<int64_t*>(ndims, Memory::Kind::Z_COPY_MEM);
-    for (int32_t dim = 0; dim < ndims; ++dim) p_results[dim] = results[dim].ptr(0);
-
-    const size_t blocks = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
-    nonzero_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
-      volume, in, pitches, rect.lo, offsets, p_results);
+    int64_t size = 0;
+    CHECK_CUDA(cudaMemcpyAsync(
+      &size, p_offsets + tiles, sizeof(int64_t), cudaMemcpyDeviceToHost, stream));
+    CHECK_CUDA(cudaStreamSynchronize(stream));
+    return size;
   }
 
   size_t operator()(const AccessorRO<VAL, DIM>& in,
                     const Pitches<DIM - 1>& pitches,
                     const Rect<DIM>& rect,
                     const size_t volume,
-                    std::vector<Buffer<int64_t>>& results)
+                    std::vector<Buffer<int64_t>>& results,
+                    bool interleaved)
   {
-    cudaStream_t stream;
-    cudaStreamCreate(&stream);
+    auto stream = get_cached_stream();
+
+    FastPitches<DIM - 1> fast_pitches;
+    fast_pitches.flatten(rect);
 
-    auto offsets = create_buffer<int64_t>(volume, Memory::Kind::GPU_FB_MEM);
-    auto size    = compute_offsets(in, pitches, rect, volume, offsets, stream);
+    const size_t tiles = (volume + COMPACTION_TILE - 1) / COMPACTION_TILE;
+    ScratchBuffer<int64_t> offsets(tiles + 1);
+    auto size = compute_offsets(in, fast_pitches, rect, volume, tiles, offsets, stream);
 
-    for (auto& result : results) result = create_buffer<int64_t>(size, Memory::Kind::GPU_FB_MEM);
+    // The pointers to the results travel with the kernel arguments
+    auto output =
+      create_nonzero_output<DIM>(results, interleaved, size, Memory::Kind::GPU_FB_MEM);
 
-    if (size > 0) populate_nonzeros(in, pitches, rect, volume, results, offsets, stream);
+    if (size > 0)
+      nonzero_kernel<<<tiles, THREADS_PER_BLOCK, 0, stream>>>(
+        volume, in, fast_pitches, rect.lo, offsets.ptr(0), output);
 
     return size;
   }
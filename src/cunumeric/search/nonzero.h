@@ -23,6 +23,9 @@ namespace cunumeric {
 struct NonzeroArgs {
   const Array& input;
   std::vector<Array>& results;
+  // The coordinates go to a single result as rows of an (N, DIM) array, as argwhere
+  // returns them, rather than to one result per dimension
+  bool interleaved;
 };
 
 class NonzeroTask : public CuNumericTask<NonzeroTask> {
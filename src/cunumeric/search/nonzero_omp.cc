@@ -16,6 +16,7 @@
 
 #include "cunumeric/search/nonzero.h"
 #include "cunumeric/search/nonzero_template.inl"
+#include "cunumeric/omp_help.h"
 
 #include <omp.h>
 
@@ -28,50 +29,56 @@ template <LegateTypeCode CODE, int32_t DIM>
 struct NonzeroImplBody<VariantKind::OMP, CODE, DIM> {
   using VAL = legate_type_of<CODE>;
 
+  // Counts of different chunks live on different cache lines so that the threads do not
+  // keep stealing them from each other while they count
+  struct alignas(64) ChunkCount {
+    int64_t value;
+  };
+
   size_t operator()(const AccessorRO<VAL, DIM>& in,
                     const Pitches<DIM - 1>& pitches,
                     const Rect<DIM>& rect,
                     const size_t volume,
-                    std::vector<Buffer<int64_t>>& results)
+                    std::vector<Buffer<int64_t>>& results,
+                    bool interleaved)
   {
-    const auto max_threads = omp_get_max_threads();
-
-    int64_t size     = 0;
-    int64_t* offsets = static_cast<int64_t*>(alloca(max_threads * sizeof(int64_t)));
+    // The flattened rect is cut into a few chunks per thread, which the threads take
+    // whenever they are done with their last one, as the second pass only writes the
+    // nonzeros and some chunks have many more of them than others. Both passes cut the
+    // rect the same way, so every chunk writes exactly what it counted.
+    const size_t chunk_size = dynamic_chunk_size(volume);
+    const size_t num_chunks = (volume + chunk_size - 1) / chunk_size;
 
-    {
-      int64_t* sizes = static_cast<int64_t*>(alloca(max_threads * sizeof(int64_t)));
-      for (auto idx = 0; idx < max_threads; ++idx) sizes[idx] = 0;
-#pragma omp parallel
-      {
-        const int tid = omp_get_thread_num();
-#pragma omp for schedule(static)
-        for (size_t idx = 0; idx < volume; ++idx) {
-          auto point = pitches.unflatten(idx, rect.lo);
-          sizes[tid] += in[point] != VAL(0);
-        }
-      }
+    auto counts = create_buffer<ChunkCount>(num_chunks, Memory::Kind::SYSTEM_MEM);
+    parallel_for_dynamic(num_chunks, [&](size_t chunk) {
+      const size_t end = std::min(volume, (chunk + 1) * chunk_size);
+      int64_t count    = 0;
+      for (size_t idx = chunk * chunk_size; idx < end; ++idx)
+        count += in[pitches.unflatten(idx, rect.lo)] != VAL(0);
+      counts[chunk].value = count;
+    });
 
-      for (auto idx = 0; idx < max_threads; ++idx) size += sizes[idx];
-
-      offsets[0] = 0;
-      for (auto idx = 1; idx < max_threads; ++idx) offsets[idx] = offsets[idx - 1] + sizes[idx - 1];
+    // Exclusive scan of the counts into the offsets of the chunks
+    int64_t size = 0;
+    for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
+      const int64_t count = counts[chunk].value;
+      counts[chunk].value = size;
+      size += count;
     }
 
-    for (auto& result : results) result = create_buffer<int64_t>(size, Memory::Kind::SYSTEM_MEM);
+    auto output =
+      create_nonzero_output<DIM>(results, interleaved, size, Memory::Kind::SYSTEM_MEM);
+    if (size == 0) return size;
 
-#pragma omp parallel
-    {
-      const int tid   = omp_get_thread_num();
-      int64_t out_idx = offsets[tid];
-#pragma omp for schedule(static)
-      for (size_t idx = 0; idx < volume; ++idx) {
+    parallel_for_dynamic(num_chunks, [&](size_t chunk) {
+      const size_t end = std::min(volume, (chunk + 1) * chunk_size);
+      int64_t out_idx  = counts[chunk].value;
+      for (size_t idx = chunk * chunk_size; idx < end; ++idx) {
         auto point = pitches.unflatten(idx, rect.lo);
         if (in[point] == VAL(0)) continue;
-        for (int32_t dim = 0; dim < DIM; ++dim) results[dim][out_idx] = point[dim];
-        ++out_idx;
+        output.write(out_idx++, point);
       }
-    }
+    });
 
     return size;
   }
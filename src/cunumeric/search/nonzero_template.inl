@@ -21,6 +21,42 @@ namespace cunumeric {
 using namespace Legion;
 using namespace legate;
 
+// Where the coordinates of the nonzeros go, either to one buffer per dimension or to every
+// DIM-th element of a single buffer, from the offset of each dimension on
+template <int32_t DIM>
+struct NonzeroOutput {
+  __CUDA_HD__ inline void write(int64_t idx, const Point<DIM>& point) const
+  {
+    for (int32_t dim = 0; dim < DIM; ++dim) coords[dim][idx * stride] = point[dim];
+  }
+
+  int64_t* coords[DIM];
+  int64_t stride;
+};
+
+// Creates the buffers for size nonzeros in the given kind of memory
+template <int32_t DIM>
+NonzeroOutput<DIM> create_nonzero_output(std::vector<Buffer<int64_t>>& results,
+                                         bool interleaved,
+                                         int64_t size,
+                                         Memory::Kind kind)
+{
+  NonzeroOutput<DIM> output;
+  if (interleaved) {
+    results[0]    = create_buffer<int64_t>(size * DIM, kind);
+    output.stride = DIM;
+    if (size > 0)
+      for (int32_t dim = 0; dim < DIM; ++dim) output.coords[dim] = results[0].ptr(0) + dim;
+  } else {
+    output.stride = 1;
+    for (int32_t dim = 0; dim < DIM; ++dim) {
+      results[dim] = create_buffer<int64_t>(size, kind);
+      if (size > 0) output.coords[dim] = results[dim].ptr(0);
+    }
+  }
+  return output;
+}
+
 template <VariantKind KIND, LegateTypeCode CODE, int32_t DIM>
 struct NonzeroImplBody;
 
@@ -43,18 +79,23 @@ struct NonzeroImpl {
     }
 
     auto in = args.input.read_accessor<VAL, DIM>(rect);
-    std::vector<Buffer<int64_t>> results(DIM);
-    auto size = NonzeroImplBody<KIND, CODE, DIM>()(in, pitches, rect, volume, results);
+    std::vector<Buffer<int64_t>> results(args.results.size());
+    auto size = NonzeroImplBody<KIND, CODE, DIM>()(
+      in, pitches, rect, volume, results, args.interleaved);
 
-    for (int32_t idx = 0; idx < DIM; ++idx) args.results[idx].return_data(results[idx], size);
+    if (args.interleaved)
+      args.results[0].return_data(results[0], size * DIM);
+    else
+      for (int32_t idx = 0; idx < DIM; ++idx) args.results[idx].return_data(results[idx], size);
   }
 };
 
 template <VariantKind KIND>
 static void nonzero_template(TaskContext& context)
 {
-  NonzeroArgs args{context.inputs()[0], context.outputs()};
-  double_dispatch(args.input.dim(), args.input.code(), NonzeroImpl<KIND>{}, args);
+  NonzeroArgs args{
+    context.inputs()[0], context.outputs(), context.scalars()[0].value<bool>()};
+  cunumeric::double_dispatch(args.input.dim(), args.input.code(), NonzeroImpl<KIND>{}, args);
 }
 
 }  // namespace cunumeric
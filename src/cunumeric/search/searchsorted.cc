@@ -0,0 +1,59 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/search/searchsorted.h"
+#include "cunumeric/search/searchsorted_template.inl"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <LegateTypeCode CODE, int32_t DIM, bool RIGHT>
+struct SearchSortedImplBody<VariantKind::CPU, CODE, DIM, RIGHT> {
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(const AccessorWO<int64_t, DIM>& out,
+                  const AccessorRO<VAL, DIM>& values,
+                  const AccessorRO<VAL, 1>& sorted,
+                  const Rect<1>& sorted_rect,
+                  const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& rect,
+                  const size_t volume)
+  {
+    const size_t size = sorted_rect.volume();
+    for (size_t idx = 0; idx < volume; ++idx) {
+      auto point = pitches.unflatten(idx, rect.lo);
+      out[point] = sorted_bound<RIGHT>(sorted, sorted_rect.lo[0], size, values[point]);
+    }
+  }
+};
+
+/*static*/ void SearchSortedTask::cpu_variant(TaskContext& context)
+{
+  searchsorted_template<VariantKind::CPU>(context);
+}
+
+namespace  // unnamed
+{
+static void __attribute__((constructor)) register_tasks(void)
+{
+  SearchSortedTask::register_variants();
+}
+}  // namespace
+
+}  // namespace cunumeric
@@ -0,0 +1,68 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/search/searchsorted.h"
+#include "cunumeric/search/searchsorted_template.inl"
+
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+
+template <bool RIGHT, typename VAL, int32_t DIM>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  searchsorted_kernel(size_t volume,
+                      AccessorWO<int64_t, DIM> out,
+                      AccessorRO<VAL, DIM> values,
+                      AccessorRO<VAL, 1> sorted,
+                      coord_t sorted_lo,
+                      size_t size,
+                      Pitches<DIM - 1> pitches,
+                      Point<DIM> lo)
+{
+  const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx >= volume) return;
+  auto point = pitches.unflatten(idx, lo);
+  out[point] = sorted_bound<RIGHT>(sorted, sorted_lo, size, values[point]);
+}
+
+template <LegateTypeCode CODE, int32_t DIM, bool RIGHT>
+struct SearchSortedImplBody<VariantKind::GPU, CODE, DIM, RIGHT> {
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(const AccessorWO<int64_t, DIM>& out,
+                  const AccessorRO<VAL, DIM>& values,
+                  const AccessorRO<VAL, 1>& sorted,
+                  const Rect<1>& sorted_rect,
+                  const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& rect,
+                  const size_t volume)
+  {
+    auto stream         = get_cached_stream();
+    const size_t blocks = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+    searchsorted_kernel<RIGHT><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+      volume, out, values, sorted, sorted_rect.lo[0], sorted_rect.volume(), pitches, rect.lo);
+  }
+};
+
+/*static*/ void SearchSortedTask::gpu_variant(TaskContext& context)
+{
+  searchsorted_template<VariantKind::GPU>(context);
+}
+
+}  // namespace cunumeric
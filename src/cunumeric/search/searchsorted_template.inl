@@ -0,0 +1,76 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/pitches.h"
+#include "cunumeric/search/sort_util.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <VariantKind KIND, LegateTypeCode CODE, int DIM, bool RIGHT>
+struct SearchSortedImplBody;
+
+template <VariantKind KIND>
+struct SearchSortedImpl {
+  template <LegateTypeCode CODE,
+            int DIM,
+            std::enable_if_t<!is_complex<legate_type_of<CODE>>::value>* = nullptr>
+  void operator()(SearchSortedArgs& args) const
+  {
+    using VAL = legate_type_of<CODE>;
+
+    auto rect        = args.values.shape<DIM>();
+    auto sorted_rect = args.sorted.shape<1>();
+
+    Pitches<DIM - 1> pitches;
+    size_t volume = pitches.flatten(rect);
+
+    if (volume == 0) return;
+
+    auto out    = args.output.write_accessor<int64_t, DIM>(rect);
+    auto values = args.values.read_accessor<VAL, DIM>(rect);
+    auto sorted = args.sorted.read_accessor<VAL, 1>(sorted_rect);
+
+    if (args.right)
+      SearchSortedImplBody<KIND, CODE, DIM, true>()(
+        out, values, sorted, sorted_rect, pitches, rect, volume);
+    else
+      SearchSortedImplBody<KIND, CODE, DIM, false>()(
+        out, values, sorted, sorted_rect, pitches, rect, volume);
+  }
+
+  template <LegateTypeCode CODE,
+            int DIM,
+            std::enable_if_t<is_complex<legate_type_of<CODE>>::value>* = nullptr>
+  void operator()(SearchSortedArgs& args) const
+  {
+    assert(false);
+  }
+};
+
+template <VariantKind KIND>
+static void searchsorted_template(TaskContext& context)
+{
+  auto& inputs = context.inputs();
+  SearchSortedArgs args{
+    inputs[0], inputs[1], context.outputs()[0], context.scalars()[0].value<bool>()};
+  cunumeric::double_dispatch(args.values.dim(), args.values.code(), SearchSortedImpl<KIND>{}, args);
+}
+
+}  // namespace cunumeric
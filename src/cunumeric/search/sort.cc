@@ -0,0 +1,50 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/search/sort.h"
+#include "cunumeric/search/sort_template.inl"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <LegateTypeCode CODE, int32_t DIM>
+struct SortImplBody<VariantKind::CPU, CODE, DIM> {
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(const SortRows<VAL, DIM>& rows, const size_t volume)
+  {
+    auto pairs = create_buffer<Argval<VAL>>(volume, Memory::Kind::SYSTEM_MEM);
+    auto ptr   = pairs.ptr(0);
+    for (size_t idx = 0; idx < volume; ++idx) ptr[idx] = rows.load(idx);
+    std::sort(ptr, ptr + volume, rows.less);
+    for (size_t idx = 0; idx < volume; ++idx) rows.store(idx, ptr[idx]);
+  }
+};
+
+/*static*/ void SortTask::cpu_variant(TaskContext& context)
+{
+  sort_template<VariantKind::CPU>(context);
+}
+
+namespace  // unnamed
+{
+static void __attribute__((constructor)) register_tasks(void) { SortTask::register_variants(); }
+}  // namespace
+
+}  // namespace cunumeric
@@ -0,0 +1,69 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/search/sort.h"
+#include "cunumeric/search/sort_template.inl"
+
+#include <thrust/sort.h>
+#include <thrust/execution_policy.h>
+
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+
+template <typename VAL, int32_t DIM>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  sort_load_kernel(size_t volume, SortRows<VAL, DIM> rows, Argval<VAL>* pairs)
+{
+  const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx >= volume) return;
+  pairs[idx] = rows.load(idx);
+}
+
+template <typename VAL, int32_t DIM>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  sort_store_kernel(size_t volume, SortRows<VAL, DIM> rows, const Argval<VAL>* pairs)
+{
+  const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx >= volume) return;
+  rows.store(idx, pairs[idx]);
+}
+
+template <LegateTypeCode CODE, int32_t DIM>
+struct SortImplBody<VariantKind::GPU, CODE, DIM> {
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(const SortRows<VAL, DIM>& rows, const size_t volume)
+  {
+    auto stream = get_cached_stream();
+
+    ScratchBuffer<Argval<VAL>> pairs(volume);
+    const size_t blocks = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+    sort_load_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(volume, rows, pairs.ptr(0));
+    thrust::sort(thrust::cuda::par.on(stream), pairs.ptr(0), pairs.ptr(0) + volume, rows.less);
+    sort_store_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(volume, rows, pairs.ptr(0));
+  }
+};
+
+/*static*/ void SortTask::gpu_variant(TaskContext& context)
+{
+  sort_template<VariantKind::GPU>(context);
+}
+
+}  // namespace cunumeric
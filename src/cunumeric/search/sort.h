@@ -0,0 +1,49 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#pragma once
+
+#include "cunumeric/cunumeric.h"
+
+namespace cunumeric {
+
+struct SortArgs {
+  const Array& input;
+  // The global indices of the input elements when it is a bucket of a sample sort,
+  // or a null pointer when the indices are the positions in the rows
+  const Array* indices;
+  Array& output;
+  bool argsort;
+};
+
+// Sorts every row of the last dimension of the input, whose pieces must hold whole rows,
+// into either the sorted values or the indices that sort them
+class SortTask : public CuNumericTask<SortTask> {
+ public:
+  static const int TASK_ID = CUNUMERIC_SORT;
+
+ public:
+  static void cpu_variant(legate::TaskContext& context);
+#ifdef LEGATE_USE_OPENMP
+  static void omp_variant(legate::TaskContext& context);
+#endif
+#ifdef LEGATE_USE_CUDA
+  static void gpu_variant(legate::TaskContext& context);
+#endif
+};
+
+}  // namespace cunumeric
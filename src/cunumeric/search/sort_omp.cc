@@ -0,0 +1,75 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/search/sort.h"
+#include "cunumeric/search/sort_template.inl"
+
+#include <omp.h>
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <LegateTypeCode CODE, int32_t DIM>
+struct SortImplBody<VariantKind::OMP, CODE, DIM> {
+  using VAL    = legate_type_of<CODE>;
+  using ARGVAL = Argval<VAL>;
+
+  void operator()(const SortRows<VAL, DIM>& rows, const size_t volume)
+  {
+    auto pairs   = create_buffer<ARGVAL>(volume, Memory::Kind::SOCKET_MEM);
+    auto scratch = create_buffer<ARGVAL>(volume, Memory::Kind::SOCKET_MEM);
+    auto src     = pairs.ptr(0);
+    auto dst     = scratch.ptr(0);
+
+    // Every thread sorts a chunk, then pairs of sorted runs of doubling width are merged
+    // in parallel until a single run is left
+    const size_t num_chunks = std::min<size_t>(omp_get_max_threads(), volume);
+    const size_t chunk_size = (volume + num_chunks - 1) / num_chunks;
+#pragma omp parallel for schedule(static)
+    for (size_t idx = 0; idx < volume; ++idx) src[idx] = rows.load(idx);
+#pragma omp parallel for schedule(static, 1)
+    for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
+      const size_t lo = std::min(chunk * chunk_size, volume);
+      const size_t hi = std::min(lo + chunk_size, volume);
+      std::sort(src + lo, src + hi, rows.less);
+    }
+
+    for (size_t width = chunk_size; width < volume; width *= 2) {
+      const size_t num_runs = (volume + 2 * width - 1) / (2 * width);
+#pragma omp parallel for schedule(static, 1)
+      for (size_t run = 0; run < num_runs; ++run) {
+        const size_t lo  = run * 2 * width;
+        const size_t mid = std::min(lo + width, volume);
+        const size_t hi  = std::min(mid + width, volume);
+        std::merge(src + lo, src + mid, src + mid, src + hi, dst + lo, rows.less);
+      }
+      std::swap(src, dst);
+    }
+
+#pragma omp parallel for schedule(static)
+    for (size_t idx = 0; idx < volume; ++idx) rows.store(idx, src[idx]);
+  }
+};
+
+/*static*/ void SortTask::omp_variant(TaskContext& context)
+{
+  sort_template<VariantKind::OMP>(context);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,113 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/pitches.h"
+#include "cunumeric/search/sort_util.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+// Loads the elements of a piece as (index, value) pairs in row-major order and stores
+// the sorted pairs back in the same order
+template <typename VAL, int DIM>
+struct SortRows {
+  __CUDA_HD__ inline Argval<VAL> load(size_t idx) const
+  {
+    auto point = pitches.unflatten(idx, lo);
+    return Argval<VAL>(has_indices ? indices[point] : static_cast<int64_t>(idx), in[point]);
+  }
+
+  __CUDA_HD__ inline void store(size_t idx, const Argval<VAL>& pair) const
+  {
+    auto point = pitches.unflatten(idx, lo);
+    if (!argsort)
+      values[point] = pair.arg_value;
+    else if (has_indices)
+      out_indices[point] = pair.arg;
+    else
+      out_indices[point] = lo[DIM - 1] + pair.arg % less.row_length;
+  }
+
+  AccessorRO<VAL, DIM> in;
+  AccessorRO<int64_t, DIM> indices;
+  AccessorWO<VAL, DIM> values;
+  AccessorWO<int64_t, DIM> out_indices;
+  Pitches<DIM - 1> pitches;
+  Point<DIM> lo;
+  SortLess<VAL> less;
+  bool has_indices;
+  bool argsort;
+};
+
+template <VariantKind KIND, LegateTypeCode CODE, int DIM>
+struct SortImplBody;
+
+template <VariantKind KIND>
+struct SortImpl {
+  template <LegateTypeCode CODE,
+            int DIM,
+            std::enable_if_t<!is_complex<legate_type_of<CODE>>::value>* = nullptr>
+  void operator()(SortArgs& args) const
+  {
+    using VAL = legate_type_of<CODE>;
+
+    auto rect = args.input.shape<DIM>();
+
+    SortRows<VAL, DIM> rows;
+    size_t volume = rows.pitches.flatten(rect);
+
+    if (volume == 0) return;
+
+    // The indices of a bucket are global, so its elements only ever form a single row
+    const int64_t row_length = rect.hi[DIM - 1] - rect.lo[DIM - 1] + 1;
+    rows.lo                  = rect.lo;
+    rows.in                  = args.input.read_accessor<VAL, DIM>(rect);
+    rows.has_indices         = args.indices != nullptr;
+    rows.argsort             = args.argsort;
+    rows.less                = SortLess<VAL>{rows.has_indices ? 0 : row_length};
+    if (rows.has_indices) rows.indices = args.indices->read_accessor<int64_t, DIM>(rect);
+    if (args.argsort)
+      rows.out_indices = args.output.write_accessor<int64_t, DIM>(rect);
+    else
+      rows.values = args.output.write_accessor<VAL, DIM>(rect);
+
+    SortImplBody<KIND, CODE, DIM>()(rows, volume);
+  }
+
+  template <LegateTypeCode CODE,
+            int DIM,
+            std::enable_if_t<is_complex<legate_type_of<CODE>>::value>* = nullptr>
+  void operator()(SortArgs& args) const
+  {
+    assert(false);
+  }
+};
+
+template <VariantKind KIND>
+static void sort_template(TaskContext& context)
+{
+  auto& inputs = context.inputs();
+  SortArgs args{inputs[0],
+                inputs.size() > 1 ? &inputs[1] : nullptr,
+                context.outputs()[0],
+                context.scalars()[0].value<bool>()};
+  cunumeric::double_dispatch(args.input.dim(), args.input.code(), SortImpl<KIND>{}, args);
+}
+
+}  // namespace cunumeric
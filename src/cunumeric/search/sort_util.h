@@ -0,0 +1,76 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "cunumeric/arg.h"
+
+namespace cunumeric {
+
+// Orders values the way NumPy sorts them, with NaNs after every other value
+template <typename VAL>
+__CUDA_HD__ inline bool sort_value_less(const VAL& a, const VAL& b)
+{
+  const bool a_nan = a != a;
+  const bool b_nan = b != b;
+  if (a_nan || b_nan) return !a_nan && b_nan;
+  return a < b;
+}
+
+// Orders (index, value) pairs by row, then by value, then by index. Breaking ties by
+// the index makes any sort of the pairs stable.
+template <typename VAL>
+struct SortLess {
+  __CUDA_HD__ inline bool operator()(const Argval<VAL>& a, const Argval<VAL>& b) const
+  {
+    if (row_length > 0) {
+      const int64_t a_row = a.arg / row_length;
+      const int64_t b_row = b.arg / row_length;
+      if (a_row != b_row) return a_row < b_row;
+    }
+    if (sort_value_less(a.arg_value, b.arg_value)) return true;
+    if (sort_value_less(b.arg_value, a.arg_value)) return false;
+    return a.arg < b.arg;
+  }
+
+  // Pairs are in the same row when their indices have the same quotient by the row
+  // length, and all pairs form a single row when the length is zero
+  int64_t row_length;
+};
+
+// Returns the number of the n sorted values starting at lo that come before value, which
+// counts the values equal to it as well when RIGHT is true
+template <bool RIGHT, typename VAL>
+__CUDA_HD__ inline size_t sorted_bound(const legate::AccessorRO<VAL, 1>& sorted,
+                                       Legion::coord_t lo,
+                                       size_t n,
+                                       const VAL& value)
+{
+  size_t first = 0;
+  while (n > 0) {
+    const size_t step = n / 2;
+    const VAL& probe  = sorted[lo + first + step];
+    const bool before = RIGHT ? !sort_value_less(value, probe) : sort_value_less(probe, value);
+    if (before) {
+      first += step + 1;
+      n -= step + 1;
+    } else
+      n = step;
+  }
+  return first;
+}
+
+}  // namespace cunumeric
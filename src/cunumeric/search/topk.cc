@@ -0,0 +1,92 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/search/topk.h"
+#include "cunumeric/search/topk_template.inl"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <LegateTypeCode CODE, int32_t DIM>
+struct TopkSelectImplBody<VariantKind::CPU, CODE, DIM> {
+  using VAL    = legate_type_of<CODE>;
+  using ARGVAL = Argval<VAL>;
+
+  size_t operator()(const AccessorRO<VAL, DIM>& in,
+                    const TopkRows<DIM>& rows,
+                    const Point<DIM>& strides,
+                    const size_t k,
+                    const detail::TopkBetter<VAL>& better,
+                    Buffer<ARGVAL>& result)
+  {
+    const size_t size = rows.num_rows * k;
+    result            = create_buffer<ARGVAL>(size, Memory::Kind::SYSTEM_MEM);
+    for (size_t row = 0; row < rows.num_rows; ++row)
+      topk_select_segment(in, rows, strides, k, 1, row, better, result.ptr(row * k));
+    return size;
+  }
+};
+
+template <LegateTypeCode CODE, int32_t DIM>
+struct TopkMergeImplBody<VariantKind::CPU, CODE, DIM> {
+  using VAL    = legate_type_of<CODE>;
+  using ARGVAL = Argval<VAL>;
+
+  void operator()(const AccessorRO<ARGVAL, 1>& candidates,
+                  const Rect<1>& in_rect,
+                  const AccessorWO<VAL, DIM>& values,
+                  const AccessorWO<int64_t, DIM>& indices,
+                  const TopkRows<DIM>& rows,
+                  const TopkLocator<DIM>& locator,
+                  const size_t k,
+                  const detail::TopkBetter<VAL>& better)
+  {
+    auto heaps = create_buffer<ARGVAL>(rows.num_rows * k, Memory::Kind::SYSTEM_MEM);
+    std::vector<size_t> sizes(rows.num_rows, 0);
+
+    for (coord_t idx = in_rect.lo[0]; idx <= in_rect.hi[0]; ++idx) {
+      const ARGVAL& candidate = candidates[idx];
+      if (candidate.arg < 0) continue;
+      const size_t row = locator.row(candidate.arg);
+      detail::topk_offer(heaps.ptr(row * k), sizes[row], k, candidate, better);
+    }
+
+    for (size_t row = 0; row < rows.num_rows; ++row) {
+      auto heap = heaps.ptr(row * k);
+      assert(sizes[row] == k);
+      std::sort(heap, heap + k, better);
+      for (size_t pos = 0; pos < k; ++pos) {
+        auto point     = rows.point(row, pos);
+        values[point]  = heap[pos].arg_value;
+        indices[point] = locator.index(heap[pos].arg);
+      }
+    }
+  }
+};
+
+/*static*/ void TopkTask::cpu_variant(TaskContext& context)
+{
+  topk_template<VariantKind::CPU>(context);
+}
+
+namespace  // unnamed
+{
+static void __attribute__((constructor)) register_tasks(void) { TopkTask::register_variants(); }
+}  // namespace
+
+}  // namespace cunumeric
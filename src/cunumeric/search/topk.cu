@@ -0,0 +1,181 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/search/topk.h"
+#include "cunumeric/search/topk_template.inl"
+
+#include <thrust/sort.h>
+#include <thrust/execution_policy.h>
+
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+
+// Number of heaps the selection aims to keep busy at once
+static const size_t TOPK_PARALLELISM = 1 << 16;
+
+template <typename VAL, int32_t DIM>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  topk_select_kernel(size_t num_items,
+                     AccessorRO<VAL, DIM> in,
+                     TopkRows<DIM> rows,
+                     Point<DIM> strides,
+                     size_t k,
+                     size_t num_segments,
+                     detail::TopkBetter<VAL> better,
+                     Argval<VAL>* result)
+{
+  const size_t item = blockIdx.x * blockDim.x + threadIdx.x;
+  if (item >= num_items) return;
+  topk_select_segment(in, rows, strides, k, num_segments, item, better, result + item * k);
+}
+
+// Sorts candidates by their output row and then best first, with empty slots last
+template <typename VAL, int32_t DIM>
+struct TopkMergeOrder {
+  __device__ inline size_t row(const Argval<VAL>& candidate) const
+  {
+    return candidate.arg < 0 ? SIZE_MAX : locator.row(candidate.arg);
+  }
+
+  __device__ inline bool operator()(const Argval<VAL>& a, const Argval<VAL>& b) const
+  {
+    const size_t a_row = row(a);
+    const size_t b_row = row(b);
+    if (a_row != b_row) return a_row < b_row;
+    return better(a, b);
+  }
+
+  TopkLocator<DIM> locator;
+  detail::TopkBetter<VAL> better;
+};
+
+template <typename VAL>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  topk_gather_kernel(size_t volume,
+                     AccessorRO<Argval<VAL>, 1> candidates,
+                     Point<1> origin,
+                     Argval<VAL>* sorted)
+{
+  const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx >= volume) return;
+  sorted[idx] = candidates[origin + idx];
+}
+
+template <typename VAL, int32_t DIM>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  topk_row_offsets_kernel(size_t volume,
+                          const Argval<VAL>* sorted,
+                          TopkMergeOrder<VAL, DIM> order,
+                          size_t* offsets)
+{
+  const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx >= volume || sorted[idx].arg < 0) return;
+  const size_t row = order.row(sorted[idx]);
+  if (idx == 0 || order.row(sorted[idx - 1]) != row) offsets[row] = idx;
+}
+
+template <typename VAL, int32_t DIM>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  topk_write_kernel(size_t volume,
+                    const Argval<VAL>* sorted,
+                    const size_t* offsets,
+                    AccessorWO<VAL, DIM> values,
+                    AccessorWO<int64_t, DIM> indices,
+                    TopkRows<DIM> rows,
+                    TopkLocator<DIM> locator,
+                    size_t k)
+{
+  const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx >= volume) return;
+  const size_t row      = idx / k;
+  const size_t pos      = idx % k;
+  const auto& candidate = sorted[offsets[row] + pos];
+  const auto point      = rows.point(row, pos);
+  values[point]         = candidate.arg_value;
+  indices[point]        = locator.index(candidate.arg);
+}
+
+template <LegateTypeCode CODE, int32_t DIM>
+struct TopkSelectImplBody<VariantKind::GPU, CODE, DIM> {
+  using VAL    = legate_type_of<CODE>;
+  using ARGVAL = Argval<VAL>;
+
+  size_t operator()(const AccessorRO<VAL, DIM>& in,
+                    const TopkRows<DIM>& rows,
+                    const Point<DIM>& strides,
+                    const size_t k,
+                    const detail::TopkBetter<VAL>& better,
+                    Buffer<ARGVAL>& result)
+  {
+    auto stream = get_cached_stream();
+
+    const size_t num_segments =
+      topk_num_segments(rows.num_rows, rows.length, k, TOPK_PARALLELISM);
+    const size_t num_items = rows.num_rows * num_segments;
+    const size_t size      = num_items * k;
+    result                 = create_buffer<ARGVAL>(size, Memory::Kind::GPU_FB_MEM);
+
+    const size_t blocks = (num_items + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+    topk_select_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+      num_items, in, rows, strides, k, num_segments, better, result.ptr(0));
+    return size;
+  }
+};
+
+template <LegateTypeCode CODE, int32_t DIM>
+struct TopkMergeImplBody<VariantKind::GPU, CODE, DIM> {
+  using VAL    = legate_type_of<CODE>;
+  using ARGVAL = Argval<VAL>;
+
+  void operator()(const AccessorRO<ARGVAL, 1>& candidates,
+                  const Rect<1>& in_rect,
+                  const AccessorWO<VAL, DIM>& values,
+                  const AccessorWO<int64_t, DIM>& indices,
+                  const TopkRows<DIM>& rows,
+                  const TopkLocator<DIM>& locator,
+                  const size_t k,
+                  const detail::TopkBetter<VAL>& better)
+  {
+    auto stream = get_cached_stream();
+
+    const size_t volume = in_rect.volume();
+    ScratchBuffer<ARGVAL> sorted(volume);
+    ScratchBuffer<size_t> offsets(rows.num_rows);
+    TopkMergeOrder<VAL, DIM> order{locator, better};
+
+    size_t blocks = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+    topk_gather_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+      volume, candidates, in_rect.lo, sorted.ptr(0));
+    thrust::sort(thrust::cuda::par.on(stream), sorted.ptr(0), sorted.ptr(0) + volume, order);
+    topk_row_offsets_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+      volume, sorted.ptr(0), order, offsets.ptr(0));
+
+    const size_t out_volume = rows.num_rows * k;
+    blocks                  = (out_volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+    topk_write_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+      out_volume, sorted.ptr(0), offsets.ptr(0), values, indices, rows, locator, k);
+  }
+};
+
+/*static*/ void TopkTask::gpu_variant(TaskContext& context)
+{
+  topk_template<VariantKind::GPU>(context);
+}
+
+}  // namespace cunumeric
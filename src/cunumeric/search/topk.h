@@ -0,0 +1,51 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "cunumeric/cunumeric.h"
+
+namespace cunumeric {
+
+// The task runs in two modes. With a single output it selects the k best elements of
+// every row of its input partition and returns them as (global index, value) candidates.
+// With two outputs it merges the candidates of all partitions into the values and
+// indices of the top-k elements.
+struct TopkArgs {
+  const Array& input;
+  std::vector<Array>& outputs;
+  int32_t k;
+  // Reduce along this axis, or over the whole array when it is negative
+  int32_t axis;
+  bool largest;
+  legate::Span<const int64_t> shape;
+};
+
+class TopkTask : public CuNumericTask<TopkTask> {
+ public:
+  static const int TASK_ID = CUNUMERIC_TOPK;
+
+ public:
+  static void cpu_variant(legate::TaskContext& context);
+#ifdef LEGATE_USE_OPENMP
+  static void omp_variant(legate::TaskContext& context);
+#endif
+#ifdef LEGATE_USE_CUDA
+  static void gpu_variant(legate::TaskContext& context);
+#endif
+};
+
+}  // namespace cunumeric
@@ -0,0 +1,308 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/arg.h"
+#include "cunumeric/pitches.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+namespace detail {
+
+// Orders candidates best first: by value with NaNs last, then by the smaller index
+template <typename VAL>
+struct TopkBetter {
+  __CUDA_HD__ inline bool operator()(const Argval<VAL>& a, const Argval<VAL>& b) const
+  {
+    const bool a_nan = a.arg_value != a.arg_value;
+    const bool b_nan = b.arg_value != b.arg_value;
+    if (a_nan != b_nan) return b_nan;
+    if (!a_nan && a.arg_value != b.arg_value)
+      return largest ? b.arg_value < a.arg_value : a.arg_value < b.arg_value;
+    return a.arg < b.arg;
+  }
+
+  bool largest;
+};
+
+// Offers a value to a heap of at most k elements that keeps its worst element at the root
+template <typename T, typename BETTER>
+__CUDA_HD__ inline void topk_offer(T* heap, size_t& size, size_t k, const T& value, BETTER better)
+{
+  size_t idx;
+  if (size < k) {
+    // Sift the new element up from the bottom
+    idx = size++;
+    while (idx > 0) {
+      const size_t parent = (idx - 1) / 2;
+      if (!better(heap[parent], value)) break;
+      heap[idx] = heap[parent];
+      idx       = parent;
+    }
+  } else if (better(value, heap[0])) {
+    // Replace the worst element and sift the new one down
+    idx = 0;
+    while (true) {
+      const size_t left  = 2 * idx + 1;
+      const size_t right = left + 1;
+      if (left >= size) break;
+      size_t worst = left;
+      if (right < size && better(heap[left], heap[right])) worst = right;
+      if (!better(value, heap[worst])) break;
+      heap[idx] = heap[worst];
+      idx       = worst;
+    }
+  } else
+    return;
+  heap[idx] = value;
+}
+
+}  // namespace detail
+
+// Enumerates the rows of a rect along an axis, or the whole rect as a single row
+// when the axis is negative
+template <int DIM>
+struct TopkRows {
+  void initialize(const Rect<DIM>& rect, int32_t axis)
+  {
+    axis_ = axis;
+    lo_   = rect.lo;
+    if (axis < 0) {
+      num_rows = 1;
+      length   = pitches_.flatten(rect);
+    } else {
+      auto row_rect     = rect;
+      row_rect.hi[axis] = rect.lo[axis];
+      num_rows          = pitches_.flatten(row_rect);
+      length            = rect.hi[axis] - rect.lo[axis] + 1;
+    }
+  }
+
+  __CUDA_HD__ inline Point<DIM> point(size_t row, size_t pos) const
+  {
+    if (axis_ < 0) return pitches_.unflatten(pos, lo_);
+    auto point = pitches_.unflatten(row, lo_);
+    point[axis_] += pos;
+    return point;
+  }
+
+  size_t num_rows;
+  size_t length;
+  Pitches<DIM - 1> pitches_;
+  Point<DIM> lo_;
+  int32_t axis_;
+};
+
+// Maps the global row-major index of an element to the row it belongs to in the output
+// and to its index within that row
+template <int DIM>
+struct TopkLocator {
+  void initialize(legate::Span<const int64_t> shape, int32_t axis)
+  {
+    axis_ = axis;
+    if (axis < 0) return;
+    assert(shape.size() == DIM);
+    coord_t stride     = 1;
+    coord_t row_stride = 1;
+    for (int32_t dim = DIM - 1; dim >= 0; --dim) {
+      shape_[dim]       = shape[dim];
+      strides_[dim]     = stride;
+      row_strides_[dim] = dim == axis ? 0 : row_stride;
+      stride *= shape[dim];
+      if (dim != axis) row_stride *= shape[dim];
+    }
+  }
+
+  __CUDA_HD__ inline size_t row(int64_t index) const
+  {
+    if (axis_ < 0) return 0;
+    size_t row = 0;
+    for (int32_t dim = 0; dim < DIM; ++dim)
+      row += (index / strides_[dim]) % shape_[dim] * row_strides_[dim];
+    return row;
+  }
+
+  __CUDA_HD__ inline int64_t index(int64_t index) const
+  {
+    return axis_ < 0 ? index : (index / strides_[axis_]) % shape_[axis_];
+  }
+
+  Point<DIM> shape_;
+  Point<DIM> strides_;
+  Point<DIM> row_strides_;
+  int32_t axis_;
+};
+
+template <int DIM>
+Point<DIM> topk_strides(legate::Span<const int64_t> shape)
+{
+  assert(shape.size() == DIM);
+  Point<DIM> strides;
+  coord_t stride = 1;
+  for (int32_t dim = DIM - 1; dim >= 0; --dim) {
+    strides[dim] = stride;
+    stride *= shape[dim];
+  }
+  return strides;
+}
+
+// Splits each row into segments with a heap each, so that a few long rows still spread
+// over all the available threads
+inline size_t topk_num_segments(size_t num_rows, size_t length, size_t k, size_t parallelism)
+{
+  if (num_rows >= parallelism) return 1;
+  const size_t segments = (parallelism + num_rows - 1) / num_rows;
+  // Segments much shorter than k would only add candidates to merge
+  return std::max<size_t>(std::min(segments, length / (4 * k)), 1);
+}
+
+// Selects the best k elements of one segment of a row into heap. Segments shorter than
+// k leave empty slots marked with a negative index, which the merge skips.
+template <typename VAL, int DIM>
+__CUDA_HD__ inline void topk_select_segment(const AccessorRO<VAL, DIM>& in,
+                                            const TopkRows<DIM>& rows,
+                                            const Point<DIM>& strides,
+                                            size_t k,
+                                            size_t num_segments,
+                                            size_t item,
+                                            const detail::TopkBetter<VAL>& better,
+                                            Argval<VAL>* heap)
+{
+  const size_t row     = item / num_segments;
+  const size_t segment = item % num_segments;
+  const size_t lo      = segment * rows.length / num_segments;
+  const size_t hi      = (segment + 1) * rows.length / num_segments;
+
+  size_t size = 0;
+  for (size_t pos = lo; pos < hi; ++pos) {
+    const auto point = rows.point(row, pos);
+    int64_t index    = 0;
+    for (int32_t dim = 0; dim < DIM; ++dim) index += point[dim] * strides[dim];
+    detail::topk_offer(heap, size, k, Argval<VAL>(index, in[point]), better);
+  }
+  for (; size < k; ++size) heap[size] = Argval<VAL>(-1, VAL{});
+}
+
+template <VariantKind KIND, LegateTypeCode CODE, int DIM>
+struct TopkSelectImplBody;
+
+template <VariantKind KIND, LegateTypeCode CODE, int DIM>
+struct TopkMergeImplBody;
+
+template <VariantKind KIND>
+struct TopkSelectImpl {
+  template <LegateTypeCode CODE,
+            int DIM,
+            std::enable_if_t<!is_complex<legate_type_of<CODE>>::value>* = nullptr>
+  void operator()(TopkArgs& args) const
+  {
+    using VAL    = legate_type_of<CODE>;
+    using ARGVAL = Argval<VAL>;
+
+    auto& result = args.outputs[0];
+    auto rect    = args.input.shape<DIM>();
+
+    if (rect.empty()) {
+      auto empty = create_buffer<ARGVAL>(0);
+      result.return_data(empty, 0);
+      return;
+    }
+
+    TopkRows<DIM> rows;
+    rows.initialize(rect, args.axis);
+
+    auto in = args.input.read_accessor<VAL, DIM>(rect);
+    Buffer<ARGVAL> candidates;
+    auto size = TopkSelectImplBody<KIND, CODE, DIM>()(in,
+                                                      rows,
+                                                      topk_strides<DIM>(args.shape),
+                                                      std::min<size_t>(args.k, rows.length),
+                                                      detail::TopkBetter<VAL>{args.largest},
+                                                      candidates);
+    result.return_data(candidates, size);
+  }
+
+  template <LegateTypeCode CODE,
+            int DIM,
+            std::enable_if_t<is_complex<legate_type_of<CODE>>::value>* = nullptr>
+  void operator()(TopkArgs& args) const
+  {
+    assert(false);
+  }
+};
+
+template <VariantKind KIND>
+struct TopkMergeImpl {
+  template <LegateTypeCode CODE,
+            int DIM,
+            std::enable_if_t<!is_complex<legate_type_of<CODE>>::value>* = nullptr>
+  void operator()(TopkArgs& args) const
+  {
+    using VAL    = legate_type_of<CODE>;
+    using ARGVAL = Argval<VAL>;
+
+    auto in_rect  = args.input.shape<1>();
+    auto out_rect = args.outputs[0].shape<DIM>();
+
+    if (out_rect.empty()) return;
+
+    TopkRows<DIM> rows;
+    rows.initialize(out_rect, args.axis);
+    TopkLocator<DIM> locator;
+    locator.initialize(args.shape, args.axis);
+
+    auto candidates = args.input.read_accessor<ARGVAL, 1>(in_rect);
+    auto values     = args.outputs[0].write_accessor<VAL, DIM>(out_rect);
+    auto indices    = args.outputs[1].write_accessor<int64_t, DIM>(out_rect);
+    TopkMergeImplBody<KIND, CODE, DIM>()(candidates,
+                                         in_rect,
+                                         values,
+                                         indices,
+                                         rows,
+                                         locator,
+                                         static_cast<size_t>(args.k),
+                                         detail::TopkBetter<VAL>{args.largest});
+  }
+
+  template <LegateTypeCode CODE,
+            int DIM,
+            std::enable_if_t<is_complex<legate_type_of<CODE>>::value>* = nullptr>
+  void operator()(TopkArgs& args) const
+  {
+    assert(false);
+  }
+};
+
+template <VariantKind KIND>
+static void topk_template(TaskContext& context)
+{
+  auto& scalars = context.scalars();
+  TopkArgs args{context.inputs()[0],
+                context.outputs(),
+                scalars[0].value<int32_t>(),
+                scalars[1].value<int32_t>(),
+                scalars[2].value<bool>(),
+                scalars[3].values<int64_t>()};
+  if (args.outputs.size() == 1)
+    cunumeric::double_dispatch(args.input.dim(), args.input.code(), TopkSelectImpl<KIND>{}, args);
+  else
+    cunumeric::double_dispatch(
+      args.outputs[0].dim(), args.outputs[0].code(), TopkMergeImpl<KIND>{}, args);
+}
+
+}  // namespace cunumeric
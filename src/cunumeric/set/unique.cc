@@ -0,0 +1,60 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/set/unique.h"
+#include "cunumeric/set/unique_template.inl"
+
+#include <unordered_map>
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <LegateTypeCode CODE, int DIM>
+struct UniqueImplBody<VariantKind::CPU, CODE, DIM> {
+  using VAL = legate_type_of<CODE>;
+
+  template <typename Count>
+  size_t operator()(const AccessorRO<VAL, DIM>& in,
+                    const Count& count,
+                    const Pitches<DIM - 1>& pitches,
+                    const Rect<DIM>& rect,
+                    const size_t volume,
+                    Buffer<VAL>& values,
+                    Buffer<int64_t>& counts) const
+  {
+    std::unordered_map<uint64_t, int64_t> table;
+    for (size_t idx = 0; idx < volume; ++idx) {
+      auto point = pitches.unflatten(idx, rect.lo);
+      table[unique_key(in[point])] += count(point);
+    }
+    return write_unique_table<VAL>(table, values, counts);
+  }
+};
+
+/*static*/ void UniqueTask::cpu_variant(TaskContext& context)
+{
+  unique_template<VariantKind::CPU>(context);
+}
+
+namespace  // unnamed
+{
+static void __attribute__((constructor)) register_tasks(void) { UniqueTask::register_variants(); }
+}  // namespace
+
+}  // namespace cunumeric
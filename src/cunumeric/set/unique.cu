@@ -0,0 +1,197 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/set/unique.h"
+#include "cunumeric/set/unique_template.inl"
+
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+
+// Slots of the tables hold this pattern until a key takes them. Keys narrower than 64 bits
+// never match it, and 64-bit values that do are counted on the side.
+static constexpr unsigned long long EMPTY_SLOT = ~0ULL;
+
+// Each block first aggregates into a table of its own in shared memory, where a key probes
+// a few slots before it goes to the global table directly
+static constexpr int SHARED_SLOTS  = 1024;
+static constexpr int SHARED_PROBES = 8;
+
+struct GlobalTable {
+  unsigned long long* keys;
+  unsigned long long* counts;
+  size_t capacity;
+  // Whether the key that looks like an empty slot occurred, its count, the number of
+  // occupied slots and the next free entry of the compacted output
+  unsigned long long* meta;
+};
+
+static __device__ __forceinline__ void insert_global(const GlobalTable& table,
+                                                     unsigned long long key,
+                                                     int64_t count)
+{
+  if (key == EMPTY_SLOT) {
+    table.meta[0] = 1;
+    atomicAdd(table.meta + 1, static_cast<unsigned long long>(count));
+    return;
+  }
+  size_t slot = unique_hash(key) % table.capacity;
+  while (true) {
+    const auto prev = atomicCAS(table.keys + slot, EMPTY_SLOT, key);
+    if (prev == EMPTY_SLOT || prev == key) {
+      atomicAdd(table.counts + slot, static_cast<unsigned long long>(count));
+      return;
+    }
+    slot = slot + 1 == table.capacity ? 0 : slot + 1;
+  }
+}
+
+template <typename VAL, typename Count, typename Pitches, typename Point, int DIM>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  insert_kernel(size_t volume,
+                AccessorRO<VAL, DIM> in,
+                Count count,
+                Pitches pitches,
+                Point origin,
+                GlobalTable table)
+{
+  __shared__ unsigned long long keys[SHARED_SLOTS];
+  __shared__ unsigned long long counts[SHARED_SLOTS];
+  for (int slot = threadIdx.x; slot < SHARED_SLOTS; slot += blockDim.x) {
+    keys[slot]   = EMPTY_SLOT;
+    counts[slot] = 0;
+  }
+  __syncthreads();
+
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x;
+  for (size_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < volume; idx += stride) {
+    auto point                   = pitches.unflatten(idx, origin);
+    const unsigned long long key = unique_key(in[point]);
+    const int64_t value          = count(point);
+    bool inserted                = false;
+    if (key != EMPTY_SLOT) {
+      int slot = unique_hash(key) % SHARED_SLOTS;
+      for (int probe = 0; probe < SHARED_PROBES; ++probe) {
+        const auto prev = atomicCAS(keys + slot, EMPTY_SLOT, key);
+        if (prev == EMPTY_SLOT || prev == key) {
+          atomicAdd(counts + slot, static_cast<unsigned long long>(value));
+          inserted = true;
+          break;
+        }
+        slot = (slot + 1) % SHARED_SLOTS;
+      }
+    }
+    if (!inserted) insert_global(table, key, value);
+  }
+  __syncthreads();
+
+  for (int slot = threadIdx.x; slot < SHARED_SLOTS; slot += blockDim.x)
+    if (keys[slot] != EMPTY_SLOT) insert_global(table, keys[slot], counts[slot]);
+}
+
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  count_slots_kernel(GlobalTable table)
+{
+  int64_t occupied    = 0;
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x;
+  for (size_t slot = blockIdx.x * blockDim.x + threadIdx.x; slot < table.capacity; slot += stride)
+    occupied += table.keys[slot] != EMPTY_SLOT;
+  // Every thread in the thread block must participate in the exchange to get correct results
+  occupied = block_reduce<SumReduction<int64_t>>(occupied);
+  if (threadIdx.x == 0 && occupied > 0)
+    atomicAdd(table.meta + 2, static_cast<unsigned long long>(occupied));
+}
+
+template <typename VAL>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  compact_kernel(GlobalTable table, VAL* values, int64_t* counts)
+{
+  const size_t start  = blockIdx.x * blockDim.x + threadIdx.x;
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x;
+  if (start == 0 && table.meta[0] != 0) {
+    const auto idx = atomicAdd(table.meta + 3, 1ULL);
+    values[idx]    = unique_value<VAL>(EMPTY_SLOT);
+    counts[idx]    = static_cast<int64_t>(table.meta[1]);
+  }
+  for (size_t slot = start; slot < table.capacity; slot += stride) {
+    const auto key = table.keys[slot];
+    if (key == EMPTY_SLOT) continue;
+    const auto idx = atomicAdd(table.meta + 3, 1ULL);
+    values[idx]    = unique_value<VAL>(key);
+    counts[idx]    = static_cast<int64_t>(table.counts[slot]);
+  }
+}
+
+template <LegateTypeCode CODE, int DIM>
+struct UniqueImplBody<VariantKind::GPU, CODE, DIM> {
+  using VAL = legate_type_of<CODE>;
+
+  template <typename Count>
+  size_t operator()(const AccessorRO<VAL, DIM>& in,
+                    const Count& count,
+                    const Pitches<DIM - 1>& pitches,
+                    const Rect<DIM>& rect,
+                    const size_t volume,
+                    Buffer<VAL>& values,
+                    Buffer<int64_t>& counts) const
+  {
+    auto stream = get_cached_stream();
+
+    FastPitches<DIM - 1> fast_pitches;
+    fast_pitches.flatten(rect);
+
+    // All elements may be distinct, so the open-addressing table has room for every one
+    // of them at a load factor of two thirds
+    const size_t capacity = volume + volume / 2 + 1;
+
+    ScratchBuffer<unsigned long long> keys(capacity);
+    ScratchBuffer<unsigned long long> slot_counts(capacity);
+    ScratchBuffer<unsigned long long> meta(4);
+    CHECK_CUDA(cudaMemsetAsync(keys.ptr(0), 0xFF, capacity * sizeof(unsigned long long), stream));
+    CHECK_CUDA(
+      cudaMemsetAsync(slot_counts.ptr(0), 0, capacity * sizeof(unsigned long long), stream));
+    CHECK_CUDA(cudaMemsetAsync(meta.ptr(0), 0, 4 * sizeof(unsigned long long), stream));
+    GlobalTable table{keys.ptr(0), slot_counts.ptr(0), capacity, meta.ptr(0)};
+
+    insert_kernel<<<grid_stride_blocks<1>(volume), THREADS_PER_BLOCK, 0, stream>>>(
+      volume, in, count, fast_pitches, rect.lo, table);
+    const size_t slot_blocks = grid_stride_blocks<1>(capacity);
+    count_slots_kernel<<<slot_blocks, THREADS_PER_BLOCK, 0, stream>>>(table);
+
+    unsigned long long sizes[3];
+    CHECK_CUDA(cudaMemcpyAsync(sizes, meta.ptr(0), sizeof(sizes), cudaMemcpyDeviceToHost, stream));
+    CHECK_CUDA(cudaStreamSynchronize(stream));
+    const size_t size = sizes[2] + sizes[0];
+
+    values = create_buffer<VAL>(size, Memory::Kind::GPU_FB_MEM);
+    counts = create_buffer<int64_t>(size, Memory::Kind::GPU_FB_MEM);
+    if (size > 0)
+      compact_kernel<<<slot_blocks, THREADS_PER_BLOCK, 0, stream>>>(
+        table, values.ptr(0), counts.ptr(0));
+
+    return size;
+  }
+};
+
+/*static*/ void UniqueTask::gpu_variant(TaskContext& context)
+{
+  unique_template<VariantKind::GPU>(context);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,48 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#pragma once
+
+#include "cunumeric/cunumeric.h"
+
+namespace cunumeric {
+
+struct UniqueArgs {
+  const Array& input;
+  // Per-element counts to sum instead of counting every element once, or null
+  const Array* counts;
+  Array& values;
+  Array& value_counts;
+};
+
+// Aggregates the elements of the input by value into hash tables, returning each distinct
+// value once in no particular order together with the number of times it occurs
+class UniqueTask : public CuNumericTask<UniqueTask> {
+ public:
+  static const int TASK_ID = CUNUMERIC_UNIQUE;
+
+ public:
+  static void cpu_variant(legate::TaskContext& context);
+#ifdef LEGATE_USE_OPENMP
+  static void omp_variant(legate::TaskContext& context);
+#endif
+#ifdef LEGATE_USE_CUDA
+  static void gpu_variant(legate::TaskContext& context);
+#endif
+};
+
+}  // namespace cunumeric
@@ -0,0 +1,73 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/set/unique.h"
+#include "cunumeric/set/unique_template.inl"
+
+#include <omp.h>
+#include <unordered_map>
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <LegateTypeCode CODE, int DIM>
+struct UniqueImplBody<VariantKind::OMP, CODE, DIM> {
+  using VAL = legate_type_of<CODE>;
+
+  // The tables of different threads live on different cache lines so that inserting into
+  // one does not keep stealing the others
+  struct alignas(64) ThreadTable {
+    std::unordered_map<uint64_t, int64_t> entries;
+  };
+
+  template <typename Count>
+  size_t operator()(const AccessorRO<VAL, DIM>& in,
+                    const Count& count,
+                    const Pitches<DIM - 1>& pitches,
+                    const Rect<DIM>& rect,
+                    const size_t volume,
+                    Buffer<VAL>& values,
+                    Buffer<int64_t>& counts) const
+  {
+    std::vector<ThreadTable> tables(omp_get_max_threads());
+#pragma omp parallel
+    {
+      auto& table = tables[omp_get_thread_num()].entries;
+#pragma omp for schedule(static)
+      for (size_t idx = 0; idx < volume; ++idx) {
+        auto point = pitches.unflatten(idx, rect.lo);
+        table[unique_key(in[point])] += count(point);
+      }
+    }
+
+    // Every thread table holds at most the distinct values of the input, which are few
+    // when aggregating pays off, so they are merged serially
+    auto& merged = tables[0].entries;
+    for (size_t tid = 1; tid < tables.size(); ++tid)
+      for (auto& entry : tables[tid].entries) merged[entry.first] += entry.second;
+    return write_unique_table<VAL>(merged, values, counts);
+  }
+};
+
+/*static*/ void UniqueTask::omp_variant(TaskContext& context)
+{
+  unique_template<VariantKind::OMP>(context);
+}
+
+}  // namespace cunumeric
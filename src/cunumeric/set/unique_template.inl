@@ -0,0 +1,100 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/set/unique_util.h"
+#include "cunumeric/pitches.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <VariantKind KIND, LegateTypeCode CODE, int DIM>
+struct UniqueImplBody;
+
+// Copies a table built on the host into the buffers of the values and their counts
+template <typename VAL, typename Table>
+size_t write_unique_table(const Table& table, Buffer<VAL>& values, Buffer<int64_t>& counts)
+{
+  const size_t size = table.size();
+  values            = create_buffer<VAL>(size, Memory::Kind::SYSTEM_MEM);
+  counts            = create_buffer<int64_t>(size, Memory::Kind::SYSTEM_MEM);
+  size_t idx        = 0;
+  for (auto& entry : table) {
+    values[idx]   = unique_value<VAL>(entry.first);
+    counts[idx++] = entry.second;
+  }
+  return size;
+}
+
+template <VariantKind KIND>
+struct UniqueImpl {
+  template <LegateTypeCode CODE, int DIM, std::enable_if_t<UniqueKey<CODE>::valid>* = nullptr>
+  void operator()(UniqueArgs& args) const
+  {
+    using VAL = legate_type_of<CODE>;
+
+    auto rect = args.input.shape<DIM>();
+
+    Pitches<DIM - 1> pitches;
+    size_t volume = pitches.flatten(rect);
+
+    if (volume == 0) {
+      auto empty_values = create_buffer<VAL>(0);
+      auto empty_counts = create_buffer<int64_t>(0);
+      args.values.return_data(empty_values, 0);
+      args.value_counts.return_data(empty_counts, 0);
+      return;
+    }
+
+    auto in = args.input.read_accessor<VAL, DIM>(rect);
+    Buffer<VAL> values;
+    Buffer<int64_t> counts;
+    size_t size;
+    if (args.counts != nullptr) {
+      UniqueInputCount<DIM> count{args.counts->read_accessor<int64_t, DIM>(rect)};
+      size = UniqueImplBody<KIND, CODE, DIM>()(in, count, pitches, rect, volume, values, counts);
+    } else
+      size = UniqueImplBody<KIND, CODE, DIM>()(
+        in, UniqueUnitCount<DIM>{}, pitches, rect, volume, values, counts);
+
+    args.values.return_data(values, size);
+    args.value_counts.return_data(counts, size);
+  }
+
+  template <LegateTypeCode CODE, int DIM, std::enable_if_t<!UniqueKey<CODE>::valid>* = nullptr>
+  void operator()(UniqueArgs& args) const
+  {
+    assert(false);
+  }
+};
+
+template <VariantKind KIND>
+static void unique_template(TaskContext& context)
+{
+  auto& inputs  = context.inputs();
+  auto& outputs = context.outputs();
+  auto& scalars = context.scalars();
+
+  // Merging partial tables passes their counts as a second input
+  auto with_counts = scalars[0].value<bool>();
+  UniqueArgs args{inputs[0], with_counts ? &inputs[1] : nullptr, outputs[0], outputs[1]};
+  auto dim = std::max(1, args.input.dim());
+  cunumeric::double_dispatch(dim, args.input.code(), UniqueImpl<KIND>{}, args);
+}
+
+}  // namespace cunumeric
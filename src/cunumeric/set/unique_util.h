@@ -0,0 +1,84 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#pragma once
+
+#include "cunumeric/cunumeric.h"
+
+#include <math.h>
+#include <string.h>
+
+namespace cunumeric {
+
+// Values are aggregated by their bit patterns, zero-extended to 64 bits. Complex values and
+// half-precision floats are left to the sort-based path.
+template <LegateTypeCode CODE>
+struct UniqueKey {
+  using VAL                   = legate_type_of<CODE>;
+  static constexpr bool valid = sizeof(VAL) <= sizeof(uint64_t) &&
+                                (std::is_integral<VAL>::value ||
+                                 std::is_floating_point<VAL>::value);
+};
+
+// All NaNs share one pattern and negative zero takes that of zero, so that values that
+// compare equal also have equal keys
+template <typename VAL>
+__CUDA_HD__ inline uint64_t unique_key(VAL value)
+{
+  if constexpr (std::is_floating_point<VAL>::value) {
+    if (value != value)
+      value = static_cast<VAL>(NAN);
+    else if (value == static_cast<VAL>(0))
+      value = static_cast<VAL>(0);
+  }
+  uint64_t key = 0;
+  memcpy(&key, &value, sizeof(VAL));
+  return key;
+}
+
+template <typename VAL>
+__CUDA_HD__ inline VAL unique_value(uint64_t key)
+{
+  VAL value;
+  memcpy(&value, &key, sizeof(VAL));
+  return value;
+}
+
+// The finalizer of splitmix64, which spreads keys that only differ in a few bits
+__CUDA_HD__ inline uint64_t unique_hash(uint64_t key)
+{
+  key ^= key >> 30;
+  key *= 0xbf58476d1ce4e5b9ULL;
+  key ^= key >> 27;
+  key *= 0x94d049bb133111ebULL;
+  key ^= key >> 31;
+  return key;
+}
+
+// Every element of the input counts once, unless it comes with a count of its own
+template <int DIM>
+struct UniqueUnitCount {
+  __CUDA_HD__ int64_t operator()(const Legion::Point<DIM>& point) const { return 1; }
+};
+
+template <int DIM>
+struct UniqueInputCount {
+  __CUDA_HD__ int64_t operator()(const Legion::Point<DIM>& point) const { return counts[point]; }
+  legate::AccessorRO<int64_t, DIM> counts;
+};
+
+}  // namespace cunumeric
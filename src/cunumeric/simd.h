@@ -0,0 +1,231 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Dense element-wise loops on the CPU are compiled once per instruction set
+// and the widest one the processor supports gets picked at run time, so a
+// single build can use AVX-512 where it is available without requiring it
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(__CUDACC__)
+#define CUNUMERIC_SIMD_DISPATCH
+#define CUNUMERIC_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define CUNUMERIC_TARGET_AVX512 __attribute__((target("avx512f,avx512dq,avx512bw,avx512vl,fma")))
+// Every processor with AVX2 also has the F16C half conversions
+#define CUNUMERIC_TARGET_F16C __attribute__((target("avx2,f16c")))
+#define CUNUMERIC_TARGET_AVX512_F16C __attribute__((target("avx512f,avx2,f16c")))
+#include <immintrin.h>
+#endif
+
+// The build passes -fopenmp-simd, so this takes effect even in files that
+// are not compiled with OpenMP
+#define CUNUMERIC_SIMD_LOOP _Pragma("omp simd")
+
+namespace cunumeric {
+namespace simd {
+
+enum class Level : int32_t {
+  GENERIC = 0,  // whatever the build targets, e.g. SSE2 or NEON
+  AVX2    = 1,
+  AVX512  = 2,
+};
+
+inline Level detect_level()
+{
+#ifdef CUNUMERIC_SIMD_DISPATCH
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") &&
+      __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vl"))
+    return Level::AVX512;
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return Level::AVX2;
+#endif
+  return Level::GENERIC;
+}
+
+inline Level level()
+{
+  static const Level detected = detect_level();
+  return detected;
+}
+
+namespace detail {
+
+// The kernel is a callable taking the index of an element. It gets inlined
+// into each of the loops below and vectorized for the loop's target.
+template <typename Kernel>
+inline void loop(const Kernel& kernel, size_t lo, size_t hi)
+{
+CUNUMERIC_SIMD_LOOP
+  for (size_t idx = lo; idx < hi; ++idx) kernel(idx);
+}
+
+#ifdef CUNUMERIC_SIMD_DISPATCH
+template <typename Kernel>
+CUNUMERIC_TARGET_AVX2 void loop_avx2(const Kernel& kernel, size_t lo, size_t hi)
+{
+CUNUMERIC_SIMD_LOOP
+  for (size_t idx = lo; idx < hi; ++idx) kernel(idx);
+}
+
+template <typename Kernel>
+CUNUMERIC_TARGET_AVX512 void loop_avx512(const Kernel& kernel, size_t lo, size_t hi)
+{
+CUNUMERIC_SIMD_LOOP
+  for (size_t idx = lo; idx < hi; ++idx) kernel(idx);
+}
+#endif
+
+template <typename Kernel>
+inline void dispatch(Level level, const Kernel& kernel, size_t lo, size_t hi)
+{
+#ifdef CUNUMERIC_SIMD_DISPATCH
+  switch (level) {
+    case Level::AVX512: loop_avx512(kernel, lo, hi); return;
+    case Level::AVX2: loop_avx2(kernel, lo, hi); return;
+    default: break;
+  }
+#endif
+  loop(kernel, lo, hi);
+}
+
+#ifdef CUNUMERIC_SIMD_DISPATCH
+// Both directions round to nearest even, like the scalar conversions
+constexpr int HALF_ROUNDING = _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC;
+
+CUNUMERIC_TARGET_F16C inline void half_to_float_f16c(float* out, const uint16_t* in, size_t n)
+{
+  size_t idx = 0;
+  for (; idx + 8 <= n; idx += 8)
+    _mm256_storeu_ps(out + idx,
+                     _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + idx))));
+  for (; idx < n; ++idx) out[idx] = _cvtsh_ss(in[idx]);
+}
+
+CUNUMERIC_TARGET_AVX512_F16C inline void half_to_float_avx512(float* out,
+                                                              const uint16_t* in,
+                                                              size_t n)
+{
+  size_t idx = 0;
+  for (; idx + 16 <= n; idx += 16)
+    _mm512_storeu_ps(
+      out + idx, _mm512_cvtph_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + idx))));
+  for (; idx < n; ++idx) out[idx] = _cvtsh_ss(in[idx]);
+}
+
+CUNUMERIC_TARGET_F16C inline void float_to_half_f16c(uint16_t* out, const float* in, size_t n)
+{
+  size_t idx = 0;
+  for (; idx + 8 <= n; idx += 8)
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + idx),
+                     _mm256_cvtps_ph(_mm256_loadu_ps(in + idx), HALF_ROUNDING));
+  for (; idx < n; ++idx) out[idx] = _cvtss_sh(in[idx], HALF_ROUNDING);
+}
+
+CUNUMERIC_TARGET_AVX512_F16C inline void float_to_half_avx512(uint16_t* out,
+                                                              const float* in,
+                                                              size_t n)
+{
+  size_t idx = 0;
+  for (; idx + 16 <= n; idx += 16)
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + idx),
+                        _mm512_cvtps_ph(_mm512_loadu_ps(in + idx), HALF_ROUNDING));
+  for (; idx < n; ++idx) out[idx] = _cvtss_sh(in[idx], HALF_ROUNDING);
+}
+#endif
+
+}  // namespace detail
+
+// Whether half_to_float and float_to_half below can be used on this processor
+inline bool has_half_conversions() { return level() != Level::GENERIC; }
+
+// Converts n half values, given by their bits, to floats. Only valid when
+// has_half_conversions() is true.
+inline void half_to_float(float* out, const uint16_t* in, size_t n)
+{
+#ifdef CUNUMERIC_SIMD_DISPATCH
+  if (level() == Level::AVX512)
+    detail::half_to_float_avx512(out, in, n);
+  else
+    detail::half_to_float_f16c(out, in, n);
+#else
+  assert(false);
+#endif
+}
+
+// Converts n floats to the bits of half values. Only valid when
+// has_half_conversions() is true.
+inline void float_to_half(uint16_t* out, const float* in, size_t n)
+{
+#ifdef CUNUMERIC_SIMD_DISPATCH
+  if (level() == Level::AVX512)
+    detail::float_to_half_avx512(out, in, n);
+  else
+    detail::float_to_half_f16c(out, in, n);
+#else
+  assert(false);
+#endif
+}
+
+// Applies the kernel to every index in [0, volume)
+template <typename Kernel>
+void for_each(size_t volume, const Kernel& kernel)
+{
+  detail::dispatch(level(), kernel, 0, volume);
+}
+
+// Splits [0, volume) statically across OpenMP threads and calls body(lo, hi)
+// on the range of each thread
+template <typename Body>
+void parallel_for_ranges(size_t volume, const Body& body)
+{
+#ifdef _OPENMP
+  // Chunks are multiples of 64 elements so that each vector loop starts aligned
+  // whenever the arrays are
+  constexpr size_t GRAIN = 64;
+  const size_t num_chunks = (volume + GRAIN - 1) / GRAIN;
+#pragma omp parallel
+  {
+    const size_t num_threads = omp_get_num_threads();
+    const size_t tid         = omp_get_thread_num();
+    const size_t chunk_lo    = num_chunks * tid / num_threads;
+    const size_t chunk_hi    = num_chunks * (tid + 1) / num_threads;
+    const size_t lo          = std::min(volume, chunk_lo * GRAIN);
+    const size_t hi          = std::min(volume, chunk_hi * GRAIN);
+    body(lo, hi);
+  }
+#else
+  body(0, volume);
+#endif
+}
+
+// Same as for_each, but splits the range statically across OpenMP threads
+template <typename Kernel>
+void parallel_for_each(size_t volume, const Kernel& kernel)
+{
+  const Level lvl = level();
+  parallel_for_ranges(volume,
+                      [&](size_t lo, size_t hi) { detail::dispatch(lvl, kernel, lo, hi); });
+}
+
+}  // namespace simd
+}  // namespace cunumeric
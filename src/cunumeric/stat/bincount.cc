@@ -29,25 +29,28 @@ struct BincountImplBody<VariantKind::CPU, CODE> {
   void operator()(AccessorRD<SumReduction<int64_t>, true, 1> lhs,
                   const AccessorRO<VAL, 1>& rhs,
                   const Rect<1>& rect,
-                  const Rect<1>& lhs_rect) const
+                  const Rect<1>& lhs_rect,
+                  const int64_t offset) const
   {
     for (size_t idx = rect.lo[0]; idx <= rect.hi[0]; ++idx) {
-      auto value = rhs[idx];
+      auto value = rhs[idx] - offset;
       assert(lhs_rect.contains(value));
       lhs.reduce(value, 1);
     }
   }
 
+  template <typename WT>
   void operator()(AccessorRD<SumReduction<double>, true, 1> lhs,
                   const AccessorRO<VAL, 1>& rhs,
-                  const AccessorRO<double, 1>& weights,
+                  const AccessorRO<WT, 1>& weights,
                   const Rect<1>& rect,
-                  const Rect<1>& lhs_rect) const
+                  const Rect<1>& lhs_rect,
+                  const int64_t offset) const
   {
     for (size_t idx = rect.lo[0]; idx <= rect.hi[0]; ++idx) {
-      auto value = rhs[idx];
+      auto value = rhs[idx] - offset;
       assert(lhs_rect.contains(value));
-      lhs.reduce(value, weights[idx]);
+      lhs.reduce(value, static_cast<double>(weights[idx]));
     }
   }
 };
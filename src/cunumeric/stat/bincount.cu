@@ -28,6 +28,7 @@ static __device__ inline void _bincount(int32_t* bins,
                                         AccessorRO<VAL, 1> rhs,
                                         const size_t volume,
                                         const size_t num_bins,
+                                        const int64_t offset,
                                         Point<1> origin)
 {
   // Initialize the bins to 0
@@ -41,7 +42,7 @@ static __device__ inline void _bincount(int32_t* bins,
   const size_t stride = gridDim.x * blockDim.x;
   while (offset < volume) {
     const auto x   = origin[0] + offset;
-    const auto bin = rhs[x];
+    const auto bin = rhs[x] - offset;
     assert(bin < num_bins);
     SumReduction<int32_t>::fold<false>(bins[bin], 1);
     // Now get the next offset
@@ -51,12 +52,26 @@ static __device__ inline void _bincount(int32_t* bins,
   __syncthreads();
 }
 
-template <typename VAL>
-static __device__ inline void _weighted_bincount(double* bins,
+// Weights are summed in shared memory at their own type, with native fp32 atomics for
+// float32 weights, except that integer weights are widened so that the sums of a CTA
+// cannot overflow
+template <typename WT>
+struct SharedBin {
+  using type = WT;
+};
+
+template <>
+struct SharedBin<int32_t> {
+  using type = int64_t;
+};
+
+template <typename VAL, typename WT, typename BIN>
+static __device__ inline void _weighted_bincount(BIN* bins,
                                                  AccessorRO<VAL, 1> rhs,
-                                                 AccessorRO<double, 1> weights,
+                                                 AccessorRO<WT, 1> weights,
                                                  const size_t volume,
                                                  const size_t num_bins,
+                                                 const int64_t offset,
                                                  Point<1> origin)
 {
   // Initialize the bins to 0
@@ -70,9 +85,9 @@ static __device__ inline void _weighted_bincount(double* bins,
   const size_t stride = gridDim.x * blockDim.x;
   while (offset < volume) {
     const auto x   = origin[0] + offset;
-    const auto bin = rhs[x];
+    const auto bin = rhs[x] - offset;
     assert(bin < num_bins);
-    SumReduction<double>::fold<false>(bins[bin], weights[x]);
+    SumReduction<BIN>::fold<false>(bins[bin], static_cast<BIN>(weights[x]));
     // Now get the next offset
     offset += stride;
   }
@@ -86,11 +101,12 @@ static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
                      AccessorRO<VAL, 1> rhs,
                      const size_t volume,
                      const size_t num_bins,
+                     const int64_t offset,
                      Point<1> origin)
 {
   extern __shared__ char array[];
   auto bins = reinterpret_cast<int32_t*>(array);
-  _bincount(bins, rhs, volume, num_bins, origin);
+  _bincount(bins, rhs, volume, num_bins, offset, origin);
   // Now do the atomics out to global memory
   for (int32_t bin = threadIdx.x; bin < num_bins; bin += blockDim.x) {
     const auto count = bins[bin];
@@ -104,11 +120,12 @@ static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
                      AccessorRO<VAL, 1> rhs,
                      const size_t volume,
                      const size_t num_bins,
+                     const int64_t offset,
                      Point<1> origin)
 {
   extern __shared__ char array[];
   auto bins = reinterpret_cast<int32_t*>(array);
-  _bincount(bins, rhs, volume, num_bins, origin);
+  _bincount(bins, rhs, volume, num_bins, offset, origin);
   // Now do the atomics out to global memory
   for (int32_t bin = threadIdx.x; bin < num_bins; bin += blockDim.x) {
     const auto count = bins[bin];
@@ -116,44 +133,113 @@ static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
   }
 }
 
-template <typename VAL>
+template <typename VAL, typename WT>
 static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
   weighted_bincount_kernel_rd(AccessorRD<SumReduction<double>, false, 1> lhs,
                               AccessorRO<VAL, 1> rhs,
-                              AccessorRO<double, 1> weights,
+                              AccessorRO<WT, 1> weights,
                               const size_t volume,
                               const size_t num_bins,
+                              const int64_t offset,
                               Point<1> origin)
 {
   extern __shared__ char array[];
-  auto bins = reinterpret_cast<double*>(array);
-  _weighted_bincount(bins, rhs, weights, volume, num_bins, origin);
+  auto bins = reinterpret_cast<typename SharedBin<WT>::type*>(array);
+  _weighted_bincount(bins, rhs, weights, volume, num_bins, offset, origin);
   // Now do the atomics out to global memory
   for (int32_t bin = threadIdx.x; bin < num_bins; bin += blockDim.x) {
-    const auto weight = bins[bin];
+    const auto weight = static_cast<double>(bins[bin]);
     lhs.reduce(bin, weight);
   }
 }
 
-template <typename VAL>
+template <typename VAL, typename WT>
 static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
   weighted_bincount_kernel_rw(AccessorRW<double, 1> lhs,
                               AccessorRO<VAL, 1> rhs,
-                              AccessorRO<double, 1> weights,
+                              AccessorRO<WT, 1> weights,
                               const size_t volume,
                               const size_t num_bins,
+                              const int64_t offset,
                               Point<1> origin)
 {
   extern __shared__ char array[];
-  auto bins = reinterpret_cast<double*>(array);
-  _weighted_bincount(bins, rhs, weights, volume, num_bins, origin);
+  auto bins = reinterpret_cast<typename SharedBin<WT>::type*>(array);
+  _weighted_bincount(bins, rhs, weights, volume, num_bins, offset, origin);
   // Now do the atomics out to global memory
   for (int32_t bin = threadIdx.x; bin < num_bins; bin += blockDim.x) {
-    const auto weight = bins[bin];
+    const auto weight = static_cast<double>(bins[bin]);
     SumReduction<double>::fold<false>(lhs[bin], weight);
   }
 }
 
+struct UnitWeight {
+  __device__ int64_t operator()(coord_t) const { return 1; }
+};
+
+template <typename WT>
+struct Weights {
+  __device__ double operator()(coord_t x) const { return static_cast<double>(weights[x]); }
+  AccessorRO<WT, 1> weights;
+};
+
+template <typename REDOP>
+static __device__ inline void bincount_update(const AccessorRD<REDOP, false, 1>& lhs,
+                                              coord_t bin,
+                                              typename REDOP::RHS value)
+{
+  lhs.reduce(bin, value);
+}
+
+template <typename BIN>
+static __device__ inline void bincount_update(const AccessorRW<BIN, 1>& lhs,
+                                              coord_t bin,
+                                              BIN value)
+{
+  SumReduction<BIN>::fold<false>(lhs[bin], value);
+}
+
+// Bin ranges too large for shared memory are counted straight into the output with
+// one global atomic per element
+template <typename LHS, typename VAL, typename WEIGHT>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  bincount_global_kernel(LHS lhs,
+                         AccessorRO<VAL, 1> rhs,
+                         WEIGHT weight,
+                         const size_t volume,
+                         const int64_t offset,
+                         Point<1> origin)
+{
+  const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx >= volume) return;
+  const auto x   = origin[0] + idx;
+  const auto bin = rhs[x] - offset;
+  bincount_update(lhs, bin, weight(x));
+}
+
+template <typename LHS, typename VAL, typename WEIGHT>
+static void launch_global_bincount(const LHS& lhs,
+                                   const AccessorRO<VAL, 1>& rhs,
+                                   WEIGHT weight,
+                                   const Rect<1>& rect,
+                                   const int64_t offset,
+                                   cudaStream_t stream)
+{
+  const size_t volume = rect.volume();
+  const size_t blocks = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+  bincount_global_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+    lhs, rhs, weight, volume, offset, rect.lo);
+}
+
+static bool fits_in_shared_memory(size_t bin_size)
+{
+  int device;
+  CHECK_CUDA(cudaGetDevice(&device));
+  int max_shared = 0;
+  CHECK_CUDA(cudaDeviceGetAttribute(&max_shared, cudaDevAttrMaxSharedMemoryPerBlock, device));
+  return bin_size <= static_cast<size_t>(max_shared);
+}
+
 template <LegateTypeCode CODE>
 struct BincountImplBody<VariantKind::GPU, CODE> {
   using VAL = legate_type_of<CODE>;
@@ -161,75 +247,105 @@ struct BincountImplBody<VariantKind::GPU, CODE> {
   void operator()(AccessorRD<SumReduction<int64_t>, false, 1> lhs,
                   const AccessorRO<VAL, 1>& rhs,
                   const Rect<1>& rect,
-                  const Rect<1>& lhs_rect) const
+                  const Rect<1>& lhs_rect,
+                  const int64_t offset) const
   {
+    auto stream = get_cached_stream();
+
     const auto volume   = rect.volume();
     const auto num_bins = lhs_rect.volume();
     const auto bin_size = num_bins * sizeof(int32_t);
+    if (!fits_in_shared_memory(bin_size)) {
+      launch_global_bincount(lhs, rhs, UnitWeight{}, rect, offset, stream);
+      return;
+    }
 
     int32_t num_ctas = 0;
     cudaOccupancyMaxActiveBlocksPerMultiprocessor(
       &num_ctas, bincount_kernel_rd<VAL>, THREADS_PER_BLOCK, bin_size);
     assert(num_ctas > 0);
     // Launch a kernel with this number of CTAs
-    bincount_kernel_rd<VAL>
-      <<<num_ctas, THREADS_PER_BLOCK, bin_size>>>(lhs, rhs, volume, num_bins, rect.lo);
+    bincount_kernel_rd<VAL><<<num_ctas, THREADS_PER_BLOCK, bin_size, stream>>>(
+      lhs, rhs, volume, num_bins, offset, rect.lo);
   }
 
   void operator()(const AccessorRW<int64_t, 1>& lhs,
                   const AccessorRO<VAL, 1>& rhs,
                   const Rect<1>& rect,
-                  const Rect<1>& lhs_rect) const
+                  const Rect<1>& lhs_rect,
+                  const int64_t offset) const
   {
+    auto stream = get_cached_stream();
+
     const auto volume   = rect.volume();
     const auto num_bins = lhs_rect.volume();
     const auto bin_size = num_bins * sizeof(int32_t);
+    if (!fits_in_shared_memory(bin_size)) {
+      launch_global_bincount(lhs, rhs, UnitWeight{}, rect, offset, stream);
+      return;
+    }
 
     int32_t num_ctas = 0;
     cudaOccupancyMaxActiveBlocksPerMultiprocessor(
       &num_ctas, bincount_kernel_rw<VAL>, THREADS_PER_BLOCK, bin_size);
     assert(num_ctas > 0);
     // Launch a kernel with this number of CTAs
-    bincount_kernel_rw<VAL>
-      <<<num_ctas, THREADS_PER_BLOCK, bin_size>>>(lhs, rhs, volume, num_bins, rect.lo);
+    bincount_kernel_rw<VAL><<<num_ctas, THREADS_PER_BLOCK, bin_size, stream>>>(
+      lhs, rhs, volume, num_bins, offset, rect.lo);
   }
 
+  template <typename WT>
   void operator()(AccessorRD<SumReduction<double>, false, 1> lhs,
                   const AccessorRO<VAL, 1>& rhs,
-                  const AccessorRO<double, 1>& weights,
+                  const AccessorRO<WT, 1>& weights,
                   const Rect<1>& rect,
-                  const Rect<1>& lhs_rect) const
+                  const Rect<1>& lhs_rect,
+                  const int64_t offset) const
   {
+    auto stream = get_cached_stream();
+
     const auto volume   = rect.volume();
     const auto num_bins = lhs_rect.volume();
-    const auto bin_size = num_bins * sizeof(double);
+    const auto bin_size = num_bins * sizeof(typename SharedBin<WT>::type);
+    if (!fits_in_shared_memory(bin_size)) {
+      launch_global_bincount(lhs, rhs, Weights<WT>{weights}, rect, offset, stream);
+      return;
+    }
 
     int32_t num_ctas = 0;
     cudaOccupancyMaxActiveBlocksPerMultiprocessor(
-      &num_ctas, weighted_bincount_kernel_rd<VAL>, THREADS_PER_BLOCK, bin_size);
+      &num_ctas, weighted_bincount_kernel_rd<VAL, WT>, THREADS_PER_BLOCK, bin_size);
     assert(num_ctas > 0);
     // Launch a kernel with this number of CTAs
-    weighted_bincount_kernel_rd<VAL>
-      <<<num_ctas, THREADS_PER_BLOCK, bin_size>>>(lhs, rhs, weights, volume, num_bins, rect.lo);
+    weighted_bincount_kernel_rd<VAL, WT><<<num_ctas, THREADS_PER_BLOCK, bin_size, stream>>>(
+      lhs, rhs, weights, volume, num_bins, offset, rect.lo);
   }
 
+  template <typename WT>
   void operator()(const AccessorRW<double, 1>& lhs,
                   const AccessorRO<VAL, 1>& rhs,
-                  const AccessorRO<double, 1>& weights,
+                  const AccessorRO<WT, 1>& weights,
                   const Rect<1>& rect,
-                  const Rect<1>& lhs_rect) const
+                  const Rect<1>& lhs_rect,
+                  const int64_t offset) const
   {
+    auto stream = get_cached_stream();
+
     const auto volume   = rect.volume();
     const auto num_bins = lhs_rect.volume();
-    const auto bin_size = num_bins * sizeof(double);
+    const auto bin_size = num_bins * sizeof(typename SharedBin<WT>::type);
+    if (!fits_in_shared_memory(bin_size)) {
+      launch_global_bincount(lhs, rhs, Weights<WT>{weights}, rect, offset, stream);
+      return;
+    }
 
     int32_t num_ctas = 0;
     cudaOccupancyMaxActiveBlocksPerMultiprocessor(
-      &num_ctas, weighted_bincount_kernel_rw<VAL>, THREADS_PER_BLOCK, bin_size);
+      &num_ctas, weighted_bincount_kernel_rw<VAL, WT>, THREADS_PER_BLOCK, bin_size);
     assert(num_ctas > 0);
     // Launch a kernel with this number of CTAs
-    weighted_bincount_kernel_rw<VAL>
-      <<<num_ctas, THREADS_PER_BLOCK, bin_size>>>(lhs, rhs, weights, volume, num_bins, rect.lo);
+    weighted_bincount_kernel_rw<VAL, WT><<<num_ctas, THREADS_PER_BLOCK, bin_size, stream>>>(
+      lhs, rhs, weights, volume, num_bins, offset, rect.lo);
   }
 };
 
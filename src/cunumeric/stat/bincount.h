@@ -24,6 +24,9 @@ struct BincountArgs {
   const Array& lhs;
   const Array& rhs;
   const Array& weights;
+  // Bin of the first element of lhs, which covers only a range of the bins
+  // when the output is partitioned rather than broadcast
+  int64_t offset;
 };
 
 class BincountTask : public CuNumericTask<BincountTask> {
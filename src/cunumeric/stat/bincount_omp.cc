@@ -16,6 +16,7 @@
 
 #include "cunumeric/stat/bincount.h"
 #include "cunumeric/stat/bincount_template.inl"
+#include "cunumeric/omp_help.h"
 
 #include <omp.h>
 
@@ -28,63 +29,92 @@ template <LegateTypeCode CODE>
 struct BincountImplBody<VariantKind::OMP, CODE> {
   using VAL = legate_type_of<CODE>;
 
-  std::vector<std::vector<int64_t>> _bincount(const AccessorRO<VAL, 1>& rhs,
-                                              const Rect<1>& rect,
-                                              const Rect<1>& lhs_rect) const
+  // Privatizing the bins costs one copy per thread to initialize and fold back, so once
+  // that outweighs the input all threads count into a single copy with atomics instead
+  static bool use_private_bins(const Rect<1>& rect, const Rect<1>& lhs_rect)
+  {
+    return lhs_rect.volume() * omp_get_max_threads() <= rect.volume();
+  }
+
+  template <typename BIN, typename WEIGHT>
+  std::vector<std::vector<BIN>> _count_bins(const AccessorRO<VAL, 1>& rhs,
+                                            WEIGHT&& weight,
+                                            const Rect<1>& rect,
+                                            const Rect<1>& lhs_rect,
+                                            const int64_t offset) const
   {
-    const int max_threads   = omp_get_max_threads();
     const size_t lhs_volume = lhs_rect.volume();
-    std::vector<std::vector<int64_t>> all_local_bins(max_threads);
-    for (auto& local_bins : all_local_bins) {
-      auto init  = SumReduction<int64_t>::identity;
-      local_bins = std::vector<int64_t>(lhs_volume, init);
+    const auto init         = SumReduction<BIN>::identity;
+    if (!use_private_bins(rect, lhs_rect)) {
+      std::vector<std::vector<BIN>> shared_bins(1, std::vector<BIN>(lhs_volume, init));
+      auto& bins = shared_bins.front();
+      // Threads whose elements fall into the hot bins wait on the atomics much longer
+      // than the others, so they take the elements a chunk at a time
+      const size_t volume     = rect.volume();
+      const size_t chunk_size = dynamic_chunk_size(volume);
+      const size_t num_chunks = (volume + chunk_size - 1) / chunk_size;
+      parallel_for_dynamic(num_chunks, [&](size_t chunk) {
+        const size_t lo = rect.lo[0] + chunk * chunk_size;
+        const size_t hi = std::min<size_t>(lo + chunk_size - 1, rect.hi[0]);
+        for (size_t idx = lo; idx <= hi; ++idx) {
+          auto value = rhs[idx] - offset;
+          assert(lhs_rect.contains(value));
+          const BIN update = weight(idx);
+#pragma omp atomic update
+          bins[value] += update;
+        }
+      });
+      return shared_bins;
     }
+
+    const int max_threads = omp_get_max_threads();
+    std::vector<std::vector<BIN>> all_local_bins(max_threads);
+    for (auto& local_bins : all_local_bins) local_bins = std::vector<BIN>(lhs_volume, init);
 #pragma omp parallel
     {
-      auto tid                         = omp_get_thread_num();
-      std::vector<int64_t>& local_bins = all_local_bins[tid];
+      auto tid                     = omp_get_thread_num();
+      std::vector<BIN>& local_bins = all_local_bins[tid];
 #pragma omp for schedule(static)
       for (size_t idx = rect.lo[0]; idx <= rect.hi[0]; ++idx) {
-        auto value = rhs[idx];
+        auto value = rhs[idx] - offset;
         assert(lhs_rect.contains(value));
-        SumReduction<int64_t>::fold<true>(local_bins[value], 1);
+        SumReduction<BIN>::template fold<true>(local_bins[value], weight(idx));
       }
     }
-    return std::move(all_local_bins);
+    return all_local_bins;
+  }
+
+  std::vector<std::vector<int64_t>> _bincount(const AccessorRO<VAL, 1>& rhs,
+                                              const Rect<1>& rect,
+                                              const Rect<1>& lhs_rect,
+                                              const int64_t offset) const
+  {
+    return _count_bins<int64_t>(
+      rhs, [](size_t) { return int64_t{1}; }, rect, lhs_rect, offset);
   }
 
+  template <typename WT>
   std::vector<std::vector<double>> _bincount(const AccessorRO<VAL, 1>& rhs,
-                                             const AccessorRO<double, 1>& weights,
+                                             const AccessorRO<WT, 1>& weights,
                                              const Rect<1>& rect,
-                                             const Rect<1>& lhs_rect) const
+                                             const Rect<1>& lhs_rect,
+                                             const int64_t offset) const
   {
-    const int max_threads   = omp_get_max_threads();
-    const size_t lhs_volume = lhs_rect.volume();
-    std::vector<std::vector<double>> all_local_bins(max_threads);
-    for (auto& local_bins : all_local_bins) {
-      auto init  = SumReduction<double>::identity;
-      local_bins = std::vector<double>(lhs_volume, init);
-    }
-#pragma omp parallel
-    {
-      auto tid                        = omp_get_thread_num();
-      std::vector<double>& local_bins = all_local_bins[tid];
-#pragma omp for schedule(static)
-      for (size_t idx = rect.lo[0]; idx <= rect.hi[0]; ++idx) {
-        auto value = rhs[idx];
-        assert(lhs_rect.contains(value));
-        SumReduction<double>::fold<true>(local_bins[value], weights[idx]);
-      }
-    }
-    return std::move(all_local_bins);
+    return _count_bins<double>(
+      rhs,
+      [&weights](size_t idx) { return static_cast<double>(weights[idx]); },
+      rect,
+      lhs_rect,
+      offset);
   }
 
   void operator()(AccessorRD<SumReduction<int64_t>, true, 1> lhs,
                   const AccessorRO<VAL, 1>& rhs,
                   const Rect<1>& rect,
-                  const Rect<1>& lhs_rect) const
+                  const Rect<1>& lhs_rect,
+                  const int64_t offset) const
   {
-    auto all_local_bins = _bincount(rhs, rect, lhs_rect);
+    auto all_local_bins = _bincount(rhs, rect, lhs_rect, offset);
     for (auto& local_bins : all_local_bins)
       for (size_t bin_num = 0; bin_num < local_bins.size(); ++bin_num)
         lhs.reduce(bin_num, local_bins[bin_num]);
@@ -93,33 +123,38 @@ struct BincountImplBody<VariantKind::OMP, CODE> {
   void operator()(const AccessorRW<int64_t, 1>& lhs,
                   const AccessorRO<VAL, 1>& rhs,
                   const Rect<1>& rect,
-                  const Rect<1>& lhs_rect) const
+                  const Rect<1>& lhs_rect,
+                  const int64_t offset) const
   {
-    auto all_local_bins = _bincount(rhs, rect, lhs_rect);
+    auto all_local_bins = _bincount(rhs, rect, lhs_rect, offset);
     for (auto& local_bins : all_local_bins)
       for (size_t bin_num = 0; bin_num < local_bins.size(); ++bin_num)
         lhs[bin_num] += local_bins[bin_num];
   }
 
+  template <typename WT>
   void operator()(AccessorRD<SumReduction<double>, true, 1> lhs,
                   const AccessorRO<VAL, 1>& rhs,
-                  const AccessorRO<double, 1>& weights,
+                  const AccessorRO<WT, 1>& weights,
                   const Rect<1>& rect,
-                  const Rect<1>& lhs_rect) const
+                  const Rect<1>& lhs_rect,
+                  const int64_t offset) const
   {
-    auto all_local_bins = _bincount(rhs, weights, rect, lhs_rect);
+    auto all_local_bins = _bincount(rhs, weights, rect, lhs_rect, offset);
     for (auto& local_bins : all_local_bins)
       for (size_t bin_num = 0; bin_num < local_bins.size(); ++bin_num)
         lhs.reduce(bin_num, local_bins[bin_num]);
   }
 
+  template <typename WT>
   void operator()(const AccessorRW<double, 1>& lhs,
                   const AccessorRO<VAL, 1>& rhs,
-                  const AccessorRO<double, 1>& weights,
+                  const AccessorRO<WT, 1>& weights,
                   const Rect<1>& rect,
-                  const Rect<1>& lhs_rect) const
+                  const Rect<1>& lhs_rect,
+                  const int64_t offset) const
   {
-    auto all_local_bins = _bincount(rhs, weights, rect, lhs_rect);
+    auto all_local_bins = _bincount(rhs, weights, rect, lhs_rect, offset);
     for (auto& local_bins : all_local_bins)
       for (size_t bin_num = 0; bin_num < local_bins.size(); ++bin_num)
         lhs[bin_num] += local_bins[bin_num];
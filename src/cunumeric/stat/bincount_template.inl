@@ -22,6 +22,39 @@ using namespace legate;
 template <VariantKind KIND, LegateTypeCode CODE>
 struct BincountImplBody;
 
+// Weights are summed at their own type into float64 bins, so that float32 and integer
+// weights need no conversion pass
+template <LegateTypeCode CODE>
+struct BincountWeight {
+  static constexpr bool valid =
+    CODE == LegateTypeCode::FLOAT_LT || CODE == LegateTypeCode::DOUBLE_LT ||
+    CODE == LegateTypeCode::INT32_LT || CODE == LegateTypeCode::INT64_LT;
+};
+
+template <VariantKind KIND, LegateTypeCode CODE>
+struct WeightedBincountImpl {
+  template <LegateTypeCode WEIGHT_CODE,
+            std::enable_if_t<BincountWeight<WEIGHT_CODE>::valid>* = nullptr>
+  void operator()(BincountArgs& args, const Rect<1>& rect, const Rect<1>& lhs_rect) const
+  {
+    using VAL = legate_type_of<CODE>;
+    using WT  = legate_type_of<WEIGHT_CODE>;
+
+    auto rhs     = args.rhs.read_accessor<VAL, 1>(rect);
+    auto weights = args.weights.read_accessor<WT, 1>(rect);
+    auto lhs =
+      args.lhs.reduce_accessor<SumReduction<double>, KIND != VariantKind::GPU, 1>(lhs_rect);
+    BincountImplBody<KIND, CODE>()(lhs, rhs, weights, rect, lhs_rect, args.offset);
+  }
+
+  template <LegateTypeCode WEIGHT_CODE,
+            std::enable_if_t<!BincountWeight<WEIGHT_CODE>::valid>* = nullptr>
+  void operator()(BincountArgs& args, const Rect<1>& rect, const Rect<1>& lhs_rect) const
+  {
+    assert(false);
+  }
+};
+
 template <VariantKind KIND>
 struct BincountImpl {
   template <LegateTypeCode CODE, std::enable_if_t<is_integral<CODE>::value>* = nullptr>
@@ -33,16 +66,14 @@ struct BincountImpl {
     auto lhs_rect = args.lhs.shape<1>();
     if (rect.empty()) return;
 
-    auto rhs = args.rhs.read_accessor<VAL, 1>(rect);
     if (args.weights.dim() == 1) {
-      auto weights = args.weights.read_accessor<double, 1>(rect);
-      auto lhs =
-        args.lhs.reduce_accessor<SumReduction<double>, KIND != VariantKind::GPU, 1>(lhs_rect);
-      BincountImplBody<KIND, CODE>()(lhs, rhs, weights, rect, lhs_rect);
+      cunumeric::type_dispatch(
+        args.weights.code(), WeightedBincountImpl<KIND, CODE>{}, args, rect, lhs_rect);
     } else {
+      auto rhs = args.rhs.read_accessor<VAL, 1>(rect);
       auto lhs =
         args.lhs.reduce_accessor<SumReduction<int64_t>, KIND != VariantKind::GPU, 1>(lhs_rect);
-      BincountImplBody<KIND, CODE>()(lhs, rhs, rect, lhs_rect);
+      BincountImplBody<KIND, CODE>()(lhs, rhs, rect, lhs_rect, args.offset);
     }
   }
 
@@ -58,8 +89,10 @@ static void bincount_template(TaskContext& context)
 {
   auto& inputs     = context.inputs();
   auto& reductions = context.reductions();
-  BincountArgs args{reductions[0], inputs[0], inputs[1]};
-  type_dispatch(args.rhs.code(), BincountImpl<KIND>{}, args);
+  auto& scalars    = context.scalars();
+  BincountArgs args{
+    reductions[0], inputs[0], inputs[1], scalars.empty() ? 0 : scalars[0].value<int64_t>()};
+  cunumeric::type_dispatch(args.rhs.code(), BincountImpl<KIND>{}, args);
 }
 
 }  // namespace cunumeric
@@ -0,0 +1,71 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/stat/histogram.h"
+#include "cunumeric/stat/histogram_template.inl"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <LegateTypeCode CODE>
+struct HistogramImplBody<VariantKind::CPU, CODE> {
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(AccessorRD<SumReduction<int64_t>, true, 1> lhs,
+                  const AccessorRO<VAL, 1>& rhs,
+                  const double* edges,
+                  const Rect<1>& rect,
+                  const size_t num_bins,
+                  const bool uniform) const
+  {
+    for (size_t idx = rect.lo[0]; idx <= rect.hi[0]; ++idx) {
+      const auto bin = histogram_bin(edges, num_bins, uniform, static_cast<double>(rhs[idx]));
+      if (bin >= 0) lhs.reduce(bin, 1);
+    }
+  }
+
+  void operator()(AccessorRD<SumReduction<double>, true, 1> lhs,
+                  const AccessorRO<VAL, 1>& rhs,
+                  const AccessorRO<double, 1>& weights,
+                  const double* edges,
+                  const Rect<1>& rect,
+                  const size_t num_bins,
+                  const bool uniform) const
+  {
+    for (size_t idx = rect.lo[0]; idx <= rect.hi[0]; ++idx) {
+      const auto bin = histogram_bin(edges, num_bins, uniform, static_cast<double>(rhs[idx]));
+      if (bin >= 0) lhs.reduce(bin, weights[idx]);
+    }
+  }
+};
+
+/*static*/ void HistogramTask::cpu_variant(TaskContext& context)
+{
+  histogram_template<VariantKind::CPU>(context);
+}
+
+namespace  // unnamed
+{
+static void __attribute__((constructor)) register_tasks(void)
+{
+  HistogramTask::register_variants();
+}
+}  // namespace
+
+}  // namespace cunumeric
@@ -0,0 +1,152 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/stat/histogram.h"
+#include "cunumeric/stat/histogram_template.inl"
+
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+
+struct UnitWeight {
+  __device__ int64_t operator()(coord_t) const { return 1; }
+};
+
+struct Weights {
+  __device__ double operator()(coord_t x) const { return weights[x]; }
+  AccessorRO<double, 1> weights;
+};
+
+// The edges are staged in shared memory whenever they fit, followed by privatized bins
+// when those fit as well. Privatized counts are 32 bit so that their atomics are native.
+template <bool PRIVATE, typename BIN, typename REDOP, typename VAL, typename WEIGHT>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  histogram_kernel(AccessorRD<REDOP, false, 1> lhs,
+                   AccessorRO<VAL, 1> rhs,
+                   WEIGHT weight,
+                   const double* edges,
+                   const size_t num_bins,
+                   const bool uniform,
+                   const bool shared_edges,
+                   const size_t volume,
+                   Point<1> origin)
+{
+  extern __shared__ double array[];
+  if (shared_edges) {
+    for (size_t idx = threadIdx.x; idx <= num_bins; idx += blockDim.x) array[idx] = edges[idx];
+    edges = array;
+  }
+  BIN* bins = reinterpret_cast<BIN*>(array + num_bins + 1);
+  if (PRIVATE)
+    for (size_t bin = threadIdx.x; bin < num_bins; bin += blockDim.x) bins[bin] = 0;
+  __syncthreads();
+
+  size_t offset       = blockIdx.x * blockDim.x + threadIdx.x;
+  const size_t stride = gridDim.x * blockDim.x;
+  for (; offset < volume; offset += stride) {
+    const auto x   = origin[0] + offset;
+    const auto bin = histogram_bin(edges, num_bins, uniform, static_cast<double>(rhs[x]));
+    if (bin < 0) continue;
+    if (PRIVATE)
+      SumReduction<BIN>::fold<false>(bins[bin], weight(x));
+    else
+      lhs.reduce(bin, weight(x));
+  }
+
+  if (!PRIVATE) return;
+  __syncthreads();
+  for (size_t bin = threadIdx.x; bin < num_bins; bin += blockDim.x) {
+    const auto value = bins[bin];
+    if (value != 0) lhs.reduce(bin, value);
+  }
+}
+
+template <typename BIN, typename REDOP, typename VAL, typename WEIGHT>
+static void launch_histogram(const AccessorRD<REDOP, false, 1>& lhs,
+                             const AccessorRO<VAL, 1>& rhs,
+                             WEIGHT weight,
+                             const double* edges,
+                             const Rect<1>& rect,
+                             const size_t num_bins,
+                             const bool uniform)
+{
+  auto stream = get_cached_stream();
+
+  int device;
+  CHECK_CUDA(cudaGetDevice(&device));
+  int max_shared = 0;
+  CHECK_CUDA(cudaDeviceGetAttribute(&max_shared, cudaDevAttrMaxSharedMemoryPerBlock, device));
+  int num_sms = 0;
+  CHECK_CUDA(cudaDeviceGetAttribute(&num_sms, cudaDevAttrMultiProcessorCount, device));
+
+  const size_t volume     = rect.volume();
+  const size_t edges_size = (num_bins + 1) * sizeof(double);
+  const size_t bins_size  = num_bins * sizeof(BIN);
+  const bool shared_edges = edges_size <= static_cast<size_t>(max_shared);
+  const bool privatized   = edges_size + bins_size <= static_cast<size_t>(max_shared);
+  const size_t shared     = privatized ? edges_size + bins_size : shared_edges ? edges_size : 0;
+
+  auto launch = [&](auto kernel) {
+    int32_t ctas_per_sm = 0;
+    CHECK_CUDA(cudaOccupancyMaxActiveBlocksPerMultiprocessor(
+      &ctas_per_sm, kernel, THREADS_PER_BLOCK, shared));
+    assert(ctas_per_sm > 0);
+    const size_t blocks   = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+    const size_t num_ctas = std::min<size_t>(blocks, ctas_per_sm * num_sms);
+    kernel<<<num_ctas, THREADS_PER_BLOCK, shared, stream>>>(
+      lhs, rhs, weight, edges, num_bins, uniform, shared_edges, volume, rect.lo);
+  };
+  if (privatized)
+    launch(histogram_kernel<true, BIN, REDOP, VAL, WEIGHT>);
+  else
+    launch(histogram_kernel<false, BIN, REDOP, VAL, WEIGHT>);
+}
+
+template <LegateTypeCode CODE>
+struct HistogramImplBody<VariantKind::GPU, CODE> {
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(AccessorRD<SumReduction<int64_t>, false, 1> lhs,
+                  const AccessorRO<VAL, 1>& rhs,
+                  const double* edges,
+                  const Rect<1>& rect,
+                  const size_t num_bins,
+                  const bool uniform) const
+  {
+    launch_histogram<int32_t>(lhs, rhs, UnitWeight{}, edges, rect, num_bins, uniform);
+  }
+
+  void operator()(AccessorRD<SumReduction<double>, false, 1> lhs,
+                  const AccessorRO<VAL, 1>& rhs,
+                  const AccessorRO<double, 1>& weights,
+                  const double* edges,
+                  const Rect<1>& rect,
+                  const size_t num_bins,
+                  const bool uniform) const
+  {
+    launch_histogram<double>(lhs, rhs, Weights{weights}, edges, rect, num_bins, uniform);
+  }
+};
+
+/*static*/ void HistogramTask::gpu_variant(TaskContext& context)
+{
+  histogram_template<VariantKind::GPU>(context);
+}
+
+}  // namespace cunumeric
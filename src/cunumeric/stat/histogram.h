@@ -0,0 +1,50 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#pragma once
+
+#include "cunumeric/cunumeric.h"
+
+namespace cunumeric {
+
+struct HistogramArgs {
+  const Array& lhs;
+  const Array& rhs;
+  const Array& edges;
+  const Array& weights;
+  bool uniform;
+};
+
+// Counts the elements of a 1-D array, or sums their weights, into the bins that sorted
+// float64 edges delimit. Uniform bins find the bin of an element in closed form and
+// arbitrary ones with a binary search over the edges. Elements outside of the edges
+// are dropped and, as in NumPy, the last bin includes its upper edge.
+class HistogramTask : public CuNumericTask<HistogramTask> {
+ public:
+  static const int TASK_ID = CUNUMERIC_HISTOGRAM;
+
+ public:
+  static void cpu_variant(legate::TaskContext& context);
+#ifdef LEGATE_USE_OPENMP
+  static void omp_variant(legate::TaskContext& context);
+#endif
+#ifdef LEGATE_USE_CUDA
+  static void gpu_variant(legate::TaskContext& context);
+#endif
+};
+
+}  // namespace cunumeric
@@ -0,0 +1,96 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/stat/histogram.h"
+#include "cunumeric/stat/histogram_template.inl"
+
+#include <omp.h>
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <LegateTypeCode CODE>
+struct HistogramImplBody<VariantKind::OMP, CODE> {
+  using VAL = legate_type_of<CODE>;
+
+  // Every thread counts into bins of its own unless initializing and folding those copies
+  // would cost more than the input, in which case the threads share a single copy
+  template <typename BIN, typename LHS, typename WEIGHT>
+  void _histogram(LHS& lhs,
+                  const AccessorRO<VAL, 1>& rhs,
+                  WEIGHT&& weight,
+                  const double* edges,
+                  const Rect<1>& rect,
+                  const size_t num_bins,
+                  const bool uniform) const
+  {
+    const auto init       = SumReduction<BIN>::identity;
+    const bool privatized = num_bins * omp_get_max_threads() <= rect.volume();
+    const int num_copies  = privatized ? omp_get_max_threads() : 1;
+    std::vector<std::vector<BIN>> all_bins(num_copies, std::vector<BIN>(num_bins, init));
+#pragma omp parallel
+    {
+      auto& bins = all_bins[privatized ? omp_get_thread_num() : 0];
+#pragma omp for schedule(static)
+      for (size_t idx = rect.lo[0]; idx <= rect.hi[0]; ++idx) {
+        const auto bin = histogram_bin(edges, num_bins, uniform, static_cast<double>(rhs[idx]));
+        if (bin < 0) continue;
+        const BIN update = weight(idx);
+        if (privatized)
+          bins[bin] += update;
+        else {
+#pragma omp atomic update
+          bins[bin] += update;
+        }
+      }
+    }
+    for (auto& bins : all_bins)
+      for (size_t bin = 0; bin < num_bins; ++bin) lhs.reduce(bin, bins[bin]);
+  }
+
+  void operator()(AccessorRD<SumReduction<int64_t>, true, 1> lhs,
+                  const AccessorRO<VAL, 1>& rhs,
+                  const double* edges,
+                  const Rect<1>& rect,
+                  const size_t num_bins,
+                  const bool uniform) const
+  {
+    _histogram<int64_t>(
+      lhs, rhs, [](size_t) { return int64_t{1}; }, edges, rect, num_bins, uniform);
+  }
+
+  void operator()(AccessorRD<SumReduction<double>, true, 1> lhs,
+                  const AccessorRO<VAL, 1>& rhs,
+                  const AccessorRO<double, 1>& weights,
+                  const double* edges,
+                  const Rect<1>& rect,
+                  const size_t num_bins,
+                  const bool uniform) const
+  {
+    _histogram<double>(
+      lhs, rhs, [&weights](size_t idx) { return weights[idx]; }, edges, rect, num_bins, uniform);
+  }
+};
+
+/*static*/ void HistogramTask::omp_variant(TaskContext& context)
+{
+  histogram_template<VariantKind::OMP>(context);
+}
+
+}  // namespace cunumeric
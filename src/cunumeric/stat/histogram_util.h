@@ -0,0 +1,60 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#pragma once
+
+#include "cunumeric/cunumeric.h"
+
+namespace cunumeric {
+
+// Bin of a value among the num_bins bins that the num_bins + 1 sorted edges delimit, or -1
+// when the value falls outside of them. For uniform bins the closed-form index can be off
+// by one after rounding, and is corrected against the edges that NumPy compares with.
+__CUDA_HD__ inline int64_t histogram_bin(const double* edges,
+                                         size_t num_bins,
+                                         bool uniform,
+                                         double value)
+{
+  const double first = edges[0];
+  const double last  = edges[num_bins];
+  if (!(value >= first && value <= last)) return -1;
+
+  const int64_t last_bin = num_bins - 1;
+  if (uniform) {
+    int64_t bin = static_cast<int64_t>((value - first) * (num_bins / (last - first)));
+    if (bin > last_bin) bin = last_bin;
+    if (bin > 0 && value < edges[bin])
+      --bin;
+    else if (bin < last_bin && value >= edges[bin + 1])
+      ++bin;
+    return bin;
+  }
+
+  // The first bin whose upper edge is greater than the value
+  int64_t lo = 0;
+  int64_t hi = last_bin;
+  while (lo < hi) {
+    const int64_t mid = lo + (hi - lo) / 2;
+    if (edges[mid + 1] <= value)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+}  // namespace cunumeric
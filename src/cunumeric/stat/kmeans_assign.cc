@@ -0,0 +1,89 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/stat/kmeans_assign.h"
+#include "cunumeric/stat/kmeans_assign_template.inl"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <LegateTypeCode CODE>
+struct KMeansAssignImplBody<VariantKind::CPU, CODE> {
+  using VAL = legate_type_of<CODE>;
+
+  template <typename ASSIGN>
+  void assign(const AccessorWO<int64_t, 2>& labels,
+              const AccessorRO<VAL, 2>& points,
+              const AccessorRO<VAL, 2>& centroids,
+              const Rect<2>& rect,
+              const Rect<2>& c_rect,
+              ASSIGN&& on_assign) const
+  {
+    const coord_t k = c_rect.hi[0] - c_rect.lo[0] + 1;
+    const coord_t d = rect.hi[1] - rect.lo[1] + 1;
+    auto packed     = pack_centroids(centroids, c_rect);
+    auto centroid   = [&](coord_t c, coord_t j) { return packed[c * d + j]; };
+    for (coord_t i = rect.lo[0]; i <= rect.hi[0]; ++i) {
+      auto point       = [&](coord_t j) { return points[Point<2>(i, rect.lo[1] + j)]; };
+      VAL distance     = 0;
+      const auto label = nearest_centroid(point, centroid, k, d, distance);
+      labels[Point<2>(i, 0)] = label;
+      on_assign(label, point, distance);
+    }
+  }
+
+  void operator()(const AccessorWO<int64_t, 2>& labels,
+                  const AccessorRO<VAL, 2>& points,
+                  const AccessorRO<VAL, 2>& centroids,
+                  const Rect<2>& rect,
+                  const Rect<2>& c_rect) const
+  {
+    assign(labels, points, centroids, rect, c_rect, [](auto...) {});
+  }
+
+  void operator()(const AccessorWO<int64_t, 2>& labels,
+                  const AccessorRO<VAL, 2>& points,
+                  const AccessorRO<VAL, 2>& centroids,
+                  AccessorRD<SumReduction<double>, true, 2> sums,
+                  AccessorRD<SumReduction<int64_t>, true, 1> counts,
+                  AccessorRD<SumReduction<double>, true, 1> inertia,
+                  const Rect<2>& rect,
+                  const Rect<2>& c_rect) const
+  {
+    KMeansPartials partials(c_rect.hi[0] - c_rect.lo[0] + 1, rect.hi[1] - rect.lo[1] + 1);
+    assign(labels, points, centroids, rect, c_rect, [&](auto label, auto& point, VAL distance) {
+      partials.add(label, point, distance);
+    });
+    partials.fold(sums, counts, inertia);
+  }
+};
+
+/*static*/ void KMeansAssignTask::cpu_variant(TaskContext& context)
+{
+  kmeans_assign_template<VariantKind::CPU>(context);
+}
+
+namespace  // unnamed
+{
+static void __attribute__((constructor)) register_tasks(void)
+{
+  KMeansAssignTask::register_variants();
+}
+}  // namespace
+
+}  // namespace cunumeric
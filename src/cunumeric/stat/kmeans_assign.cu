@@ -0,0 +1,174 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/stat/kmeans_assign.h"
+#include "cunumeric/stat/kmeans_assign_template.inl"
+
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+
+using SumsRD    = AccessorRD<SumReduction<double>, false, 2>;
+using CountsRD  = AccessorRD<SumReduction<int64_t>, false, 1>;
+using InertiaRD = AccessorRD<SumReduction<double>, false, 1>;
+
+// Every thread streams through its points and keeps the distance to the nearest centroid
+// so far in registers. When SHARED is set, the centroids and the per-cluster sums of the
+// block live in shared memory, so that the sums only take one global atomic per element
+// and block, and otherwise both go through global memory.
+template <typename VAL, bool SHARED, bool PARTIALS>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  kmeans_assign_kernel(AccessorWO<int64_t, 2> labels,
+                       AccessorRO<VAL, 2> points,
+                       AccessorRO<VAL, 2> centroids,
+                       SumsRD sums,
+                       CountsRD counts,
+                       InertiaRD inertia,
+                       const size_t volume,
+                       const coord_t k,
+                       const coord_t d,
+                       Point<2> origin,
+                       Point<2> c_origin)
+{
+  // The 8-byte sums and counts come first so that everything stays aligned
+  extern __shared__ __align__(8) char array[];
+  auto shared_sums      = reinterpret_cast<double*>(array);
+  auto shared_counts    = reinterpret_cast<int64_t*>(shared_sums + (PARTIALS ? k * d : 0));
+  auto shared_centroids = reinterpret_cast<VAL*>(shared_counts + (PARTIALS ? k : 0));
+  if constexpr (SHARED) {
+    for (coord_t idx = threadIdx.x; idx < k * d; idx += blockDim.x) {
+      shared_centroids[idx] = centroids[c_origin + Point<2>(idx / d, idx % d)];
+      if constexpr (PARTIALS) shared_sums[idx] = 0;
+    }
+    if constexpr (PARTIALS)
+      for (coord_t c = threadIdx.x; c < k; c += blockDim.x) shared_counts[c] = 0;
+    __syncthreads();
+  }
+  auto centroid = [&](coord_t c, coord_t j) {
+    if constexpr (SHARED)
+      return shared_centroids[c * d + j];
+    else
+      return centroids[c_origin + Point<2>(c, j)];
+  };
+
+  double total        = 0;
+  const size_t stride = gridDim.x * blockDim.x;
+  for (size_t offset = blockIdx.x * blockDim.x + threadIdx.x; offset < volume;
+       offset += stride) {
+    const coord_t row = origin[0] + offset;
+    auto point        = [&](coord_t j) { return points[Point<2>(row, origin[1] + j)]; };
+    VAL distance      = 0;
+    const auto label  = nearest_centroid(point, centroid, k, d, distance);
+    labels[Point<2>(row, 0)] = label;
+    if constexpr (PARTIALS) {
+      total += distance;
+      for (coord_t j = 0; j < d; ++j) {
+        const auto coordinate = static_cast<double>(point(j));
+        if constexpr (SHARED)
+          SumReduction<double>::fold<false>(shared_sums[label * d + j], coordinate);
+        else
+          sums.reduce(Point<2>(label, j), coordinate);
+      }
+      if constexpr (SHARED)
+        SumReduction<int64_t>::fold<false>(shared_counts[label], int64_t{1});
+      else
+        counts.reduce(label, int64_t{1});
+    }
+  }
+  if constexpr (PARTIALS) {
+    // Every thread of the block has to take part in the reduction of the inertia
+    total = block_reduce<SumReduction<double>>(total);
+    if (threadIdx.x == 0) inertia.reduce(0, total);
+    if constexpr (SHARED) {
+      __syncthreads();
+      for (coord_t idx = threadIdx.x; idx < k * d; idx += blockDim.x)
+        if (shared_counts[idx / d] > 0) sums.reduce(Point<2>(idx / d, idx % d), shared_sums[idx]);
+      for (coord_t c = threadIdx.x; c < k; c += blockDim.x)
+        if (shared_counts[c] > 0) counts.reduce(c, shared_counts[c]);
+    }
+  }
+}
+
+static size_t max_shared_memory()
+{
+  int device;
+  CHECK_CUDA(cudaGetDevice(&device));
+  int max_shared = 0;
+  CHECK_CUDA(cudaDeviceGetAttribute(&max_shared, cudaDevAttrMaxSharedMemoryPerBlock, device));
+  return max_shared;
+}
+
+template <LegateTypeCode CODE>
+struct KMeansAssignImplBody<VariantKind::GPU, CODE> {
+  using VAL = legate_type_of<CODE>;
+
+  template <bool PARTIALS>
+  void launch(const AccessorWO<int64_t, 2>& labels,
+              const AccessorRO<VAL, 2>& points,
+              const AccessorRO<VAL, 2>& centroids,
+              const SumsRD& sums,
+              const CountsRD& counts,
+              const InertiaRD& inertia,
+              const Rect<2>& rect,
+              const Rect<2>& c_rect) const
+  {
+    auto stream = get_cached_stream();
+
+    const size_t volume = rect.hi[0] - rect.lo[0] + 1;
+    const coord_t k     = c_rect.hi[0] - c_rect.lo[0] + 1;
+    const coord_t d     = rect.hi[1] - rect.lo[1] + 1;
+    const size_t blocks = grid_stride_blocks<1>(volume);
+
+    size_t shared = k * d * sizeof(VAL);
+    if (PARTIALS) shared += k * d * sizeof(double) + k * sizeof(int64_t);
+    if (shared <= max_shared_memory())
+      kmeans_assign_kernel<VAL, true, PARTIALS><<<blocks, THREADS_PER_BLOCK, shared, stream>>>(
+        labels, points, centroids, sums, counts, inertia, volume, k, d, rect.lo, c_rect.lo);
+    else
+      kmeans_assign_kernel<VAL, false, PARTIALS><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+        labels, points, centroids, sums, counts, inertia, volume, k, d, rect.lo, c_rect.lo);
+  }
+
+  void operator()(const AccessorWO<int64_t, 2>& labels,
+                  const AccessorRO<VAL, 2>& points,
+                  const AccessorRO<VAL, 2>& centroids,
+                  const Rect<2>& rect,
+                  const Rect<2>& c_rect) const
+  {
+    launch<false>(labels, points, centroids, {}, {}, {}, rect, c_rect);
+  }
+
+  void operator()(const AccessorWO<int64_t, 2>& labels,
+                  const AccessorRO<VAL, 2>& points,
+                  const AccessorRO<VAL, 2>& centroids,
+                  const SumsRD& sums,
+                  const CountsRD& counts,
+                  const InertiaRD& inertia,
+                  const Rect<2>& rect,
+                  const Rect<2>& c_rect) const
+  {
+    launch<true>(labels, points, centroids, sums, counts, inertia, rect, c_rect);
+  }
+};
+
+/*static*/ void KMeansAssignTask::gpu_variant(TaskContext& context)
+{
+  kmeans_assign_template<VariantKind::GPU>(context);
+}
+
+}  // namespace cunumeric
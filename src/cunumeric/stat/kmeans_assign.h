@@ -0,0 +1,48 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "cunumeric/cunumeric.h"
+
+namespace cunumeric {
+
+struct KMeansAssignArgs {
+  // The labels are promoted to the shape of the points, with a single column
+  const Array& labels;
+  const Array& points;
+  const Array& centroids;
+  // Empty unless the per-cluster sums are requested, in which case they are the sums of
+  // the coordinates of the points of each cluster, their counts and the sum of the
+  // squared distances of all points to their centroids
+  std::vector<Array>& partials;
+};
+
+class KMeansAssignTask : public CuNumericTask<KMeansAssignTask> {
+ public:
+  static const int TASK_ID = CUNUMERIC_KMEANS_ASSIGN;
+
+ public:
+  static void cpu_variant(legate::TaskContext& context);
+#ifdef LEGATE_USE_OPENMP
+  static void omp_variant(legate::TaskContext& context);
+#endif
+#ifdef LEGATE_USE_CUDA
+  static void gpu_variant(legate::TaskContext& context);
+#endif
+};
+
+}  // namespace cunumeric
@@ -0,0 +1,88 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/stat/kmeans_assign.h"
+#include "cunumeric/stat/kmeans_assign_template.inl"
+
+#include <omp.h>
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <LegateTypeCode CODE>
+struct KMeansAssignImplBody<VariantKind::OMP, CODE> {
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(const AccessorWO<int64_t, 2>& labels,
+                  const AccessorRO<VAL, 2>& points,
+                  const AccessorRO<VAL, 2>& centroids,
+                  const Rect<2>& rect,
+                  const Rect<2>& c_rect) const
+  {
+    const coord_t k = c_rect.hi[0] - c_rect.lo[0] + 1;
+    const coord_t d = rect.hi[1] - rect.lo[1] + 1;
+    auto packed     = pack_centroids(centroids, c_rect);
+    auto centroid   = [&](coord_t c, coord_t j) { return packed[c * d + j]; };
+#pragma omp parallel for schedule(static)
+    for (coord_t i = rect.lo[0]; i <= rect.hi[0]; ++i) {
+      auto point             = [&](coord_t j) { return points[Point<2>(i, rect.lo[1] + j)]; };
+      VAL distance           = 0;
+      labels[Point<2>(i, 0)] = nearest_centroid(point, centroid, k, d, distance);
+    }
+  }
+
+  void operator()(const AccessorWO<int64_t, 2>& labels,
+                  const AccessorRO<VAL, 2>& points,
+                  const AccessorRO<VAL, 2>& centroids,
+                  AccessorRD<SumReduction<double>, true, 2> sums,
+                  AccessorRD<SumReduction<int64_t>, true, 1> counts,
+                  AccessorRD<SumReduction<double>, true, 1> inertia,
+                  const Rect<2>& rect,
+                  const Rect<2>& c_rect) const
+  {
+    const coord_t k = c_rect.hi[0] - c_rect.lo[0] + 1;
+    const coord_t d = rect.hi[1] - rect.lo[1] + 1;
+    auto packed     = pack_centroids(centroids, c_rect);
+    auto centroid   = [&](coord_t c, coord_t j) { return packed[c * d + j]; };
+
+    // Every thread sums up the clusters of its own points, which are folded into the
+    // outputs one thread at a time
+    const int max_threads = omp_get_max_threads();
+    std::vector<KMeansPartials> all_partials(max_threads, KMeansPartials(k, d));
+#pragma omp parallel
+    {
+      auto& partials = all_partials[omp_get_thread_num()];
+#pragma omp for schedule(static)
+      for (coord_t i = rect.lo[0]; i <= rect.hi[0]; ++i) {
+        auto point       = [&](coord_t j) { return points[Point<2>(i, rect.lo[1] + j)]; };
+        VAL distance     = 0;
+        const auto label = nearest_centroid(point, centroid, k, d, distance);
+        labels[Point<2>(i, 0)] = label;
+        partials.add(label, point, distance);
+      }
+    }
+    for (auto& partials : all_partials) partials.fold(sums, counts, inertia);
+  }
+};
+
+/*static*/ void KMeansAssignTask::omp_variant(TaskContext& context)
+{
+  kmeans_assign_template<VariantKind::OMP>(context);
+}
+
+}  // namespace cunumeric
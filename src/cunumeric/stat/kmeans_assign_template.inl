@@ -0,0 +1,144 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <VariantKind KIND, LegateTypeCode CODE>
+struct KMeansAssignImplBody;
+
+// The centroid closest to the point of the d coordinates point(0), ..., point(d - 1)
+// among the k centroids of the coordinates centroid(c, 0), ..., centroid(c, d - 1),
+// which also leaves the squared distance to it in distance. Like argmin, ties go to the
+// lower index and a NaN distance wins over all others.
+template <typename VAL, typename POINT, typename CENTROID>
+__CUDA_HD__ inline int64_t nearest_centroid(
+  const POINT& point, const CENTROID& centroid, coord_t k, coord_t d, VAL& distance)
+{
+  int64_t nearest = 0;
+  for (coord_t c = 0; c < k; ++c) {
+    VAL squared{0};
+    for (coord_t j = 0; j < d; ++j) {
+      const VAL diff = point(j) - centroid(c, j);
+      squared += diff * diff;
+    }
+    if (c == 0 || (distance == distance && (squared < distance || squared != squared))) {
+      nearest  = c;
+      distance = squared;
+    }
+  }
+  return nearest;
+}
+
+// Copies the centroids into a dense buffer, which is small enough to stay in cache while
+// the points stream by
+template <typename VAL>
+std::vector<VAL> pack_centroids(const AccessorRO<VAL, 2>& centroids, const Rect<2>& c_rect)
+{
+  std::vector<VAL> packed;
+  packed.reserve(c_rect.volume());
+  for (PointInRectIterator<2> it(c_rect); it.valid(); ++it) packed.push_back(centroids[*it]);
+  return packed;
+}
+
+// The per-cluster sums of the points one thread has assigned, which are folded into the
+// outputs once at the end rather than once per point
+struct KMeansPartials {
+  KMeansPartials(coord_t k, coord_t d) : d(d), sums(k * d, 0.0), counts(k, 0), inertia(0.0) {}
+
+  template <typename POINT>
+  void add(int64_t cluster, const POINT& point, double distance)
+  {
+    double* sum = sums.data() + cluster * d;
+    for (coord_t j = 0; j < d; ++j) sum[j] += static_cast<double>(point(j));
+    ++counts[cluster];
+    inertia += distance;
+  }
+
+  template <typename SUMS, typename COUNTS, typename INERTIA>
+  void fold(const SUMS& out_sums, const COUNTS& out_counts, const INERTIA& out_inertia) const
+  {
+    for (coord_t c = 0; c < static_cast<coord_t>(counts.size()); ++c) {
+      if (counts[c] == 0) continue;
+      for (coord_t j = 0; j < d; ++j) out_sums.reduce(Point<2>(c, j), sums[c * d + j]);
+      out_counts.reduce(c, counts[c]);
+    }
+    out_inertia.reduce(0, inertia);
+  }
+
+  coord_t d;
+  std::vector<double> sums;
+  std::vector<int64_t> counts;
+  double inertia;
+};
+
+template <VariantKind KIND>
+struct KMeansAssignImpl {
+  template <LegateTypeCode CODE,
+            std::enable_if_t<CODE == LegateTypeCode::FLOAT_LT ||
+                             CODE == LegateTypeCode::DOUBLE_LT>* = nullptr>
+  void operator()(KMeansAssignArgs& args) const
+  {
+    using VAL = legate_type_of<CODE>;
+
+    auto rect   = args.points.shape<2>();
+    auto c_rect = args.centroids.shape<2>();
+    if (rect.empty() || c_rect.empty()) return;
+
+    auto labels    = args.labels.write_accessor<int64_t, 2>(args.labels.shape<2>());
+    auto points    = args.points.read_accessor<VAL, 2>(rect);
+    auto centroids = args.centroids.read_accessor<VAL, 2>(c_rect);
+
+    if (args.partials.empty()) {
+      KMeansAssignImplBody<KIND, CODE>()(labels, points, centroids, rect, c_rect);
+      return;
+    }
+
+    auto& sums_array = args.partials[0];
+    auto sums =
+      sums_array.reduce_accessor<SumReduction<double>, KIND != VariantKind::GPU, 2>(
+        sums_array.shape<2>());
+    auto& counts_array = args.partials[1];
+    auto counts =
+      counts_array.reduce_accessor<SumReduction<int64_t>, KIND != VariantKind::GPU, 1>(
+        counts_array.shape<1>());
+    auto inertia =
+      args.partials[2].reduce_accessor<SumReduction<double>, KIND != VariantKind::GPU, 1>();
+    KMeansAssignImplBody<KIND, CODE>()(
+      labels, points, centroids, sums, counts, inertia, rect, c_rect);
+  }
+
+  template <LegateTypeCode CODE,
+            std::enable_if_t<CODE != LegateTypeCode::FLOAT_LT &&
+                             CODE != LegateTypeCode::DOUBLE_LT>* = nullptr>
+  void operator()(KMeansAssignArgs& args) const
+  {
+    assert(false);
+  }
+};
+
+template <VariantKind KIND>
+static void kmeans_assign_template(TaskContext& context)
+{
+  auto& inputs  = context.inputs();
+  auto& outputs = context.outputs();
+  KMeansAssignArgs args{outputs[0], inputs[0], inputs[1], context.reductions()};
+  cunumeric::type_dispatch(args.points.code(), KMeansAssignImpl<KIND>{}, args);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,62 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/stat/segment_reduce.h"
+#include "cunumeric/stat/segment_reduce_template.inl"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <UnaryRedCode OP_CODE, LegateTypeCode CODE>
+struct SegmentReduceImplBody<VariantKind::CPU, OP_CODE, CODE> {
+  using OP  = UnaryRedOp<OP_CODE, CODE>;
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(AccessorRD<typename OP::OP, true, 2> lhs,
+                  AccessorRD<SumReduction<int64_t>, true, 2> counts,
+                  const AccessorRO<int64_t, 2>& labels,
+                  const AccessorRO<VAL, 2>& values,
+                  const Rect<2>& rect,
+                  const Rect<2>& lhs_rect,
+                  const SegmentLayout& layout) const
+  {
+    for (coord_t row = rect.lo[0]; row <= rect.hi[0]; ++row) {
+      const coord_t segment = labels[Point<2>(row, layout.label_col)] - layout.offset;
+      assert(segment >= lhs_rect.lo[0] && segment <= lhs_rect.hi[0]);
+      const coord_t shift = lhs_rect.lo[1] - rect.lo[1];
+      for (coord_t col = rect.lo[1]; col <= rect.hi[1]; ++col)
+        lhs.reduce(Point<2>(segment, col + shift), values[Point<2>(row, col)]);
+      if (layout.with_counts) counts.reduce(Point<2>(segment, layout.count_col), 1);
+    }
+  }
+};
+
+/*static*/ void SegmentReduceTask::cpu_variant(TaskContext& context)
+{
+  segment_reduce_template<VariantKind::CPU>(context);
+}
+
+namespace  // unnamed
+{
+static void __attribute__((constructor)) register_tasks(void)
+{
+  SegmentReduceTask::register_variants();
+}
+}  // namespace
+
+}  // namespace cunumeric
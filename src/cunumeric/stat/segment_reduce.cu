@@ -0,0 +1,163 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/stat/segment_reduce.h"
+#include "cunumeric/stat/segment_reduce_template.inl"
+
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+
+// Every CTA folds its share of the values into privatized bins in shared memory, which
+// start out as the identity, and then folds the bins that it touched out to the output.
+// The counts are kept as 32-bit integers behind the bins, as they are native atomics.
+template <typename OP, typename VAL>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  segment_reduce_shared_kernel(AccessorRD<typename OP::OP, false, 2> lhs,
+                               AccessorRD<SumReduction<int64_t>, false, 2> counts,
+                               AccessorRO<int64_t, 2> labels,
+                               AccessorRO<VAL, 2> values,
+                               const size_t volume,
+                               const size_t width,
+                               const size_t num_segments,
+                               const size_t counts_offset,
+                               const Point<2> origin,
+                               const Point<2> lhs_origin,
+                               const SegmentLayout layout)
+{
+  extern __shared__ char array[];
+  auto bins           = reinterpret_cast<VAL*>(array);
+  auto bin_counts     = reinterpret_cast<int32_t*>(array + counts_offset);
+  const auto identity = OP::OP::identity;
+  for (size_t bin = threadIdx.x; bin < num_segments * width; bin += blockDim.x)
+    bins[bin] = identity;
+  if (layout.with_counts)
+    for (size_t bin = threadIdx.x; bin < num_segments; bin += blockDim.x) bin_counts[bin] = 0;
+  __syncthreads();
+
+  const coord_t first = lhs_origin[0] + layout.offset;
+  const size_t stride = gridDim.x * blockDim.x;
+  for (size_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < volume; idx += stride) {
+    const coord_t row = origin[0] + idx / width;
+    const coord_t col = idx % width;
+    const coord_t bin = labels[Point<2>(row, layout.label_col)] - first;
+    assert(bin >= 0 && bin < static_cast<coord_t>(num_segments));
+    OP::OP::template fold<false>(bins[bin * width + col], values[Point<2>(row, origin[1] + col)]);
+    if (layout.with_counts && col == 0) SumReduction<int32_t>::fold<false>(bin_counts[bin], 1);
+  }
+  __syncthreads();
+
+  for (size_t bin = threadIdx.x; bin < num_segments * width; bin += blockDim.x) {
+    const VAL value = bins[bin];
+    if (value != identity)
+      lhs.reduce(Point<2>(lhs_origin[0] + bin / width, lhs_origin[1] + bin % width), value);
+  }
+  if (layout.with_counts)
+    for (size_t bin = threadIdx.x; bin < num_segments; bin += blockDim.x) {
+      const auto count = bin_counts[bin];
+      if (count > 0) counts.reduce(Point<2>(lhs_origin[0] + bin, layout.count_col), count);
+    }
+}
+
+// Segments too many for shared memory are folded straight into the output with one
+// global atomic per value
+template <typename OP, typename VAL>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  segment_reduce_global_kernel(AccessorRD<typename OP::OP, false, 2> lhs,
+                               AccessorRD<SumReduction<int64_t>, false, 2> counts,
+                               AccessorRO<int64_t, 2> labels,
+                               AccessorRO<VAL, 2> values,
+                               const size_t volume,
+                               const size_t width,
+                               const Point<2> origin,
+                               const Point<2> lhs_origin,
+                               const SegmentLayout layout)
+{
+  const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx >= volume) return;
+  const coord_t row     = origin[0] + idx / width;
+  const coord_t col     = idx % width;
+  const coord_t segment = labels[Point<2>(row, layout.label_col)] - layout.offset;
+  lhs.reduce(Point<2>(segment, lhs_origin[1] + col), values[Point<2>(row, origin[1] + col)]);
+  if (layout.with_counts && col == 0) counts.reduce(Point<2>(segment, layout.count_col), 1);
+}
+
+static bool fits_in_shared_memory(size_t bin_size)
+{
+  int device;
+  CHECK_CUDA(cudaGetDevice(&device));
+  int max_shared = 0;
+  CHECK_CUDA(cudaDeviceGetAttribute(&max_shared, cudaDevAttrMaxSharedMemoryPerBlock, device));
+  return bin_size <= static_cast<size_t>(max_shared);
+}
+
+template <UnaryRedCode OP_CODE, LegateTypeCode CODE>
+struct SegmentReduceImplBody<VariantKind::GPU, OP_CODE, CODE> {
+  using OP  = UnaryRedOp<OP_CODE, CODE>;
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(AccessorRD<typename OP::OP, false, 2> lhs,
+                  AccessorRD<SumReduction<int64_t>, false, 2> counts,
+                  const AccessorRO<int64_t, 2>& labels,
+                  const AccessorRO<VAL, 2>& values,
+                  const Rect<2>& rect,
+                  const Rect<2>& lhs_rect,
+                  const SegmentLayout& layout) const
+  {
+    auto stream = get_cached_stream();
+
+    const size_t volume       = rect.volume();
+    const size_t width        = rect.hi[1] - rect.lo[1] + 1;
+    const size_t num_segments = lhs_rect.hi[0] - lhs_rect.lo[0] + 1;
+    // The counts follow the bins at the next 8-byte boundary
+    const size_t counts_offset = (num_segments * width * sizeof(VAL) + 7) / 8 * 8;
+    const size_t bin_size =
+      counts_offset + (layout.with_counts ? num_segments * sizeof(int32_t) : 0);
+    if (!fits_in_shared_memory(bin_size)) {
+      const size_t blocks = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+      segment_reduce_global_kernel<OP, VAL><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+        lhs, counts, labels, values, volume, width, rect.lo, lhs_rect.lo, layout);
+      return;
+    }
+
+    int32_t num_ctas = 0;
+    cudaOccupancyMaxActiveBlocksPerMultiprocessor(
+      &num_ctas, segment_reduce_shared_kernel<OP, VAL>, THREADS_PER_BLOCK, bin_size);
+    assert(num_ctas > 0);
+    // Launch a kernel with this number of CTAs
+    segment_reduce_shared_kernel<OP, VAL><<<num_ctas, THREADS_PER_BLOCK, bin_size, stream>>>(
+      lhs,
+      counts,
+      labels,
+      values,
+      volume,
+      width,
+      num_segments,
+      counts_offset,
+      rect.lo,
+      lhs_rect.lo,
+      layout);
+  }
+};
+
+/*static*/ void SegmentReduceTask::gpu_variant(TaskContext& context)
+{
+  segment_reduce_template<VariantKind::GPU>(context);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,55 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "cunumeric/cunumeric.h"
+#include "cunumeric/unary/unary_red_util.h"
+
+namespace cunumeric {
+
+struct SegmentReduceArgs {
+  // The (k, d) rows of the segments, which cover only a range of the labels when the
+  // output is partitioned rather than broadcast
+  const Array& lhs;
+  // The number of rows of each segment as a (k, 1) array, if requested
+  const Array* counts;
+  // The labels are promoted to the shape of the values, with a single column
+  const Array& labels;
+  const Array& values;
+  UnaryRedCode op_code;
+  // Label of the first row of lhs
+  int64_t offset;
+};
+
+// Folds every row of the (n, d) values into the row of the output that its label picks,
+// which is np.add.at(out, labels, values) and its counterparts for the other reductions.
+// A second reduction output, if any, gets the number of rows of every label.
+class SegmentReduceTask : public CuNumericTask<SegmentReduceTask> {
+ public:
+  static const int TASK_ID = CUNUMERIC_SEGMENT_REDUCE;
+
+ public:
+  static void cpu_variant(legate::TaskContext& context);
+#ifdef LEGATE_USE_OPENMP
+  static void omp_variant(legate::TaskContext& context);
+#endif
+#ifdef LEGATE_USE_CUDA
+  static void gpu_variant(legate::TaskContext& context);
+#endif
+};
+
+}  // namespace cunumeric
@@ -0,0 +1,126 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/stat/segment_reduce.h"
+#include "cunumeric/stat/segment_reduce_template.inl"
+#include "cunumeric/omp_help.h"
+
+#include <omp.h>
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <UnaryRedCode OP_CODE, LegateTypeCode CODE>
+struct SegmentReduceImplBody<VariantKind::OMP, OP_CODE, CODE> {
+  using OP  = UnaryRedOp<OP_CODE, CODE>;
+  using VAL = legate_type_of<CODE>;
+
+  // The bins of every thread and their counts
+  struct Bins {
+    Bins(size_t num_segments, size_t width, bool with_counts)
+      : values(num_segments * width, OP::OP::identity),
+        counts(with_counts ? num_segments : 0, 0)
+    {
+    }
+    std::vector<VAL> values;
+    std::vector<int64_t> counts;
+  };
+
+  // As with bincount, privatizing the bins costs one copy per thread to initialize and fold
+  // back, so once that outweighs the input all threads fold into a single copy with atomics
+  static bool use_private_bins(const Rect<2>& rect, const Rect<2>& lhs_rect)
+  {
+    return lhs_rect.volume() * omp_get_max_threads() <= rect.volume();
+  }
+
+  std::vector<Bins> _fold_rows(const AccessorRO<int64_t, 2>& labels,
+                               const AccessorRO<VAL, 2>& values,
+                               const Rect<2>& rect,
+                               const Rect<2>& lhs_rect,
+                               const SegmentLayout& layout) const
+  {
+    const size_t num_segments = lhs_rect.hi[0] - lhs_rect.lo[0] + 1;
+    const size_t width        = rect.hi[1] - rect.lo[1] + 1;
+    const coord_t first       = lhs_rect.lo[0] + layout.offset;
+
+    if (!use_private_bins(rect, lhs_rect)) {
+      std::vector<Bins> shared_bins(1, Bins(num_segments, width, layout.with_counts));
+      auto& bins              = shared_bins.front();
+      const size_t volume     = rect.hi[0] - rect.lo[0] + 1;
+      const size_t chunk_size = dynamic_chunk_size(volume);
+      const size_t num_chunks = (volume + chunk_size - 1) / chunk_size;
+      parallel_for_dynamic(num_chunks, [&](size_t chunk) {
+        const coord_t lo = rect.lo[0] + chunk * chunk_size;
+        const coord_t hi = std::min<coord_t>(lo + chunk_size - 1, rect.hi[0]);
+        for (coord_t row = lo; row <= hi; ++row) {
+          const coord_t bin = labels[Point<2>(row, layout.label_col)] - first;
+          assert(bin >= 0 && bin < static_cast<coord_t>(num_segments));
+          VAL* out = bins.values.data() + bin * width;
+          for (coord_t col = rect.lo[1]; col <= rect.hi[1]; ++col)
+            OP::OP::template fold<false>(out[col - rect.lo[1]], values[Point<2>(row, col)]);
+          if (layout.with_counts) SumReduction<int64_t>::fold<false>(bins.counts[bin], 1);
+        }
+      });
+      return shared_bins;
+    }
+
+    const int max_threads = omp_get_max_threads();
+    std::vector<Bins> all_local_bins(max_threads, Bins(num_segments, width, layout.with_counts));
+#pragma omp parallel
+    {
+      auto& local_bins = all_local_bins[omp_get_thread_num()];
+#pragma omp for schedule(static)
+      for (coord_t row = rect.lo[0]; row <= rect.hi[0]; ++row) {
+        const coord_t bin = labels[Point<2>(row, layout.label_col)] - first;
+        assert(bin >= 0 && bin < static_cast<coord_t>(num_segments));
+        VAL* out = local_bins.values.data() + bin * width;
+        for (coord_t col = rect.lo[1]; col <= rect.hi[1]; ++col)
+          OP::OP::template fold<true>(out[col - rect.lo[1]], values[Point<2>(row, col)]);
+        if (layout.with_counts) ++local_bins.counts[bin];
+      }
+    }
+    return all_local_bins;
+  }
+
+  void operator()(AccessorRD<typename OP::OP, true, 2> lhs,
+                  AccessorRD<SumReduction<int64_t>, true, 2> counts,
+                  const AccessorRO<int64_t, 2>& labels,
+                  const AccessorRO<VAL, 2>& values,
+                  const Rect<2>& rect,
+                  const Rect<2>& lhs_rect,
+                  const SegmentLayout& layout) const
+  {
+    const size_t width = rect.hi[1] - rect.lo[1] + 1;
+    auto all_bins      = _fold_rows(labels, values, rect, lhs_rect, layout);
+    for (auto& bins : all_bins) {
+      for (size_t idx = 0; idx < bins.values.size(); ++idx)
+        lhs.reduce(Point<2>(lhs_rect.lo[0] + idx / width, lhs_rect.lo[1] + idx % width),
+                   bins.values[idx]);
+      for (size_t bin = 0; bin < bins.counts.size(); ++bin)
+        if (bins.counts[bin] > 0)
+          counts.reduce(Point<2>(lhs_rect.lo[0] + bin, layout.count_col), bins.counts[bin]);
+    }
+  }
+};
+
+/*static*/ void SegmentReduceTask::omp_variant(TaskContext& context)
+{
+  segment_reduce_template<VariantKind::OMP>(context);
+}
+
+}  // namespace cunumeric
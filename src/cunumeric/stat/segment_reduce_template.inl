@@ -0,0 +1,108 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <VariantKind KIND, UnaryRedCode OP_CODE, LegateTypeCode CODE>
+struct SegmentReduceImplBody;
+
+// Only the reductions that fold the values as they are apply to segments, and the
+// variants update bins of booleans and complex numbers with no atomics
+template <UnaryRedCode OP_CODE, LegateTypeCode CODE>
+struct SegmentRedOp {
+  static constexpr bool valid =
+    (OP_CODE == UnaryRedCode::SUM || OP_CODE == UnaryRedCode::PROD ||
+     OP_CODE == UnaryRedCode::MAX || OP_CODE == UnaryRedCode::MIN) &&
+    CODE != LegateTypeCode::BOOL_LT && !is_complex<legate_type_of<CODE>>::value &&
+    UnaryRedOp<OP_CODE, CODE>::valid;
+};
+
+// Where the rows of the values go: the label of row i is labels(i, label_col), its
+// segment is the row of lhs at the label minus offset, and its count goes to column
+// count_col of the counts, if any
+struct SegmentLayout {
+  coord_t label_col;
+  coord_t count_col;
+  int64_t offset;
+  bool with_counts;
+};
+
+template <VariantKind KIND, UnaryRedCode OP_CODE>
+struct SegmentReduceImpl {
+  template <LegateTypeCode CODE, std::enable_if_t<SegmentRedOp<OP_CODE, CODE>::valid>* = nullptr>
+  void operator()(SegmentReduceArgs& args) const
+  {
+    using OP  = UnaryRedOp<OP_CODE, CODE>;
+    using VAL = legate_type_of<CODE>;
+
+    auto rect        = args.values.shape<2>();
+    auto lhs_rect    = args.lhs.shape<2>();
+    auto labels_rect = args.labels.shape<2>();
+    if (rect.empty()) return;
+
+    auto labels = args.labels.read_accessor<int64_t, 2>(labels_rect);
+    auto values = args.values.read_accessor<VAL, 2>(rect);
+    auto lhs = args.lhs.reduce_accessor<typename OP::OP, KIND != VariantKind::GPU, 2>(lhs_rect);
+
+    SegmentLayout layout{labels_rect.lo[1], 0, args.offset, args.counts != nullptr};
+    AccessorRD<SumReduction<int64_t>, KIND != VariantKind::GPU, 2> counts;
+    if (layout.with_counts) {
+      auto counts_rect = args.counts->shape<2>();
+      layout.count_col = counts_rect.lo[1];
+      counts =
+        args.counts->reduce_accessor<SumReduction<int64_t>, KIND != VariantKind::GPU, 2>(
+          counts_rect);
+    }
+    SegmentReduceImplBody<KIND, OP_CODE, CODE>()(
+      lhs, counts, labels, values, rect, lhs_rect, layout);
+  }
+
+  template <LegateTypeCode CODE,
+            std::enable_if_t<!SegmentRedOp<OP_CODE, CODE>::valid>* = nullptr>
+  void operator()(SegmentReduceArgs& args) const
+  {
+    assert(false);
+  }
+};
+
+template <VariantKind KIND>
+struct SegmentReduceDispatch {
+  template <UnaryRedCode OP_CODE>
+  void operator()(SegmentReduceArgs& args) const
+  {
+    cunumeric::type_dispatch(args.values.code(), SegmentReduceImpl<KIND, OP_CODE>{}, args);
+  }
+};
+
+template <VariantKind KIND>
+static void segment_reduce_template(TaskContext& context)
+{
+  auto& inputs     = context.inputs();
+  auto& reductions = context.reductions();
+  auto& scalars    = context.scalars();
+  SegmentReduceArgs args{reductions[0],
+                         reductions.size() > 1 ? &reductions[1] : nullptr,
+                         inputs[0],
+                         inputs[1],
+                         scalars[0].value<UnaryRedCode>(),
+                         scalars[1].value<int64_t>()};
+  op_dispatch(args.op_code, SegmentReduceDispatch<KIND>{}, args);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,74 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/stencil/rolling.h"
+#include "cunumeric/stencil/rolling_template.inl"
+
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <typename OP, typename VAL, int DIM>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  rolling_suffix_kernel(AccessorRO<VAL, DIM> in, VAL* suffixes, const RollingGeometry<DIM> geom)
+{
+  const size_t task = blockIdx.x * blockDim.x + threadIdx.x;
+  if (task >= geom.tasks()) return;
+  rolling_suffixes<OP>(in, suffixes, geom, task);
+}
+
+template <typename OP, typename VAL, int DIM>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  rolling_block_kernel(AccessorWO<VAL, DIM> out,
+                       AccessorRO<VAL, DIM> in,
+                       const VAL* suffixes,
+                       const RollingGeometry<DIM> geom)
+{
+  const size_t task = blockIdx.x * blockDim.x + threadIdx.x;
+  if (task >= geom.tasks()) return;
+  rolling_block<OP>(out, in, suffixes, geom, task);
+}
+
+template <typename OP, int DIM>
+struct RollingImplBody<VariantKind::GPU, OP, DIM> {
+  using VAL = typename OP::VAL;
+
+  void operator()(AccessorWO<VAL, DIM> out,
+                  AccessorRO<VAL, DIM> in,
+                  const RollingGeometry<DIM>& geom) const
+  {
+    auto stream = get_cached_stream();
+
+    // Every thread takes one block of one line in both passes
+    auto buffer         = create_buffer<VAL>(geom.lines * geom.length, Memory::Kind::GPU_FB_MEM);
+    const size_t blocks = (geom.tasks() + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+    rolling_suffix_kernel<OP, VAL, DIM>
+      <<<blocks, THREADS_PER_BLOCK, 0, stream>>>(in, buffer.ptr(0), geom);
+    rolling_block_kernel<OP, VAL, DIM>
+      <<<blocks, THREADS_PER_BLOCK, 0, stream>>>(out, in, buffer.ptr(0), geom);
+  }
+};
+
+/*static*/ void RollingTask::gpu_variant(TaskContext& context)
+{
+  rolling_template<VariantKind::GPU>(context);
+}
+
+}  // namespace cunumeric
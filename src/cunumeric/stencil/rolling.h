@@ -0,0 +1,55 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#pragma once
+
+#include "cunumeric/cunumeric.h"
+
+namespace cunumeric {
+
+// Match these to RollingOpCode in config.py
+enum class RollingOpCode : int32_t {
+  SUM  = 0,
+  MEAN = 1,
+  MIN  = 2,
+  MAX  = 3,
+};
+
+struct RollingArgs {
+  const Array& out;
+  // The tile of the input followed by the shifted tile that makes up its halo
+  const std::vector<Array>& inputs;
+  RollingOpCode op_code;
+  int32_t axis;
+  int64_t window;
+};
+
+class RollingTask : public CuNumericTask<RollingTask> {
+ public:
+  static const int TASK_ID = CUNUMERIC_ROLLING;
+
+ public:
+  static void cpu_variant(legate::TaskContext& context);
+#ifdef LEGATE_USE_OPENMP
+  static void omp_variant(legate::TaskContext& context);
+#endif
+#ifdef LEGATE_USE_CUDA
+  static void gpu_variant(legate::TaskContext& context);
+#endif
+};
+
+}  // namespace cunumeric
@@ -0,0 +1,53 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/stencil/rolling.h"
+#include "cunumeric/stencil/rolling_template.inl"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <typename OP, int DIM>
+struct RollingImplBody<VariantKind::OMP, OP, DIM> {
+  using VAL = typename OP::VAL;
+
+  void operator()(AccessorWO<VAL, DIM> out,
+                  AccessorRO<VAL, DIM> in,
+                  const RollingGeometry<DIM>& geom) const
+  {
+    auto buffer    = create_buffer<VAL>(geom.lines * geom.length, Memory::Kind::SOCKET_MEM);
+    VAL* suffixes  = buffer.ptr(0);
+    const auto num = geom.tasks();
+#pragma omp parallel
+    {
+#pragma omp for schedule(static)
+      for (size_t task = 0; task < num; ++task) rolling_suffixes<OP>(in, suffixes, geom, task);
+      // The implicit barrier of the loop above orders the passes
+#pragma omp for schedule(static)
+      for (size_t task = 0; task < num; ++task) rolling_block<OP>(out, in, suffixes, geom, task);
+    }
+  }
+};
+
+/*static*/ void RollingTask::omp_variant(TaskContext& context)
+{
+  rolling_template<VariantKind::OMP>(context);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,234 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/pitches.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <RollingOpCode OP_CODE, LegateTypeCode CODE>
+struct RollingOp {
+  using VAL = legate_type_of<CODE>;
+
+  static constexpr bool valid =
+    OP_CODE == RollingOpCode::SUM
+      ? CODE != LegateTypeCode::BOOL_LT
+      : OP_CODE == RollingOpCode::MEAN
+          ? CODE == LegateTypeCode::HALF_LT || CODE == LegateTypeCode::FLOAT_LT ||
+              CODE == LegateTypeCode::DOUBLE_LT || is_complex<VAL>::value
+          : !is_complex<VAL>::value;
+
+  __CUDA_HD__ static inline VAL combine(const VAL& a, const VAL& b)
+  {
+    if constexpr (OP_CODE == RollingOpCode::MIN)
+      return b < a ? b : a;
+    else if constexpr (OP_CODE == RollingOpCode::MAX)
+      return a < b ? b : a;
+    else
+      return a + b;
+  }
+
+  // The points near the start of the array reduce the shorter windows that fit there
+  __CUDA_HD__ static inline VAL finish(const VAL& acc, coord_t count)
+  {
+    if constexpr (OP_CODE == RollingOpCode::MEAN)
+      return acc / static_cast<VAL>(static_cast<double>(count));
+    else
+      return acc;
+  }
+};
+
+// Every point of the output reduces the window of the input that ends at that point along
+// the axis. The windows are computed van Herk/Gil-Werman style: the axis is cut into
+// blocks of one window each, aligned with the start of the array, and every window is the
+// suffix of the block it starts in combined with the prefix of the block it ends in. That
+// takes three applications of the operator per point whatever the window, and the sums
+// never subtract, so they lose no more precision than those of the windows themselves.
+// The tasks of the first pass write the suffixes of a block of one line into a buffer,
+// and those of the second walk the prefixes of a block and write its points.
+template <int DIM>
+struct RollingGeometry {
+  RollingGeometry(const Rect<DIM>& subrect_, int32_t axis_, int64_t window_)
+    : subrect(subrect_), axis(axis_), window(window_)
+  {
+    lo     = subrect.lo[axis];
+    hi     = subrect.hi[axis];
+    first  = std::max<coord_t>(0, lo - window + 1);
+    length = hi - first + 1;
+    blocks = hi / window - first / window + 1;
+
+    Rect<DIM> line_rect = subrect;
+    line_rect.lo[axis]  = 0;
+    line_rect.hi[axis]  = 0;
+    lines               = line_pitches.flatten(line_rect);
+    line_lo             = line_rect.lo;
+  }
+
+  // The tasks of both passes, one for every block of every line
+  __CUDA_HD__ inline size_t tasks() const { return lines * blocks; }
+
+  __CUDA_HD__ inline Point<DIM> point(size_t line, coord_t x) const
+  {
+    auto point  = line_pitches.unflatten(line, line_lo);
+    point[axis] = x;
+    return point;
+  }
+
+  Rect<DIM> subrect;
+  int32_t axis;
+  coord_t window;
+  coord_t lo, hi;
+  // The first point of the input that the windows of the tile read
+  coord_t first;
+  coord_t length;
+  coord_t blocks;
+  size_t lines;
+  Pitches<DIM - 1> line_pitches;
+  Point<DIM> line_lo;
+};
+
+template <typename OP, int DIM, typename VAL, typename ReadAcc>
+__CUDA_HD__ inline void rolling_suffixes(const ReadAcc& in,
+                                         VAL* suffixes,
+                                         const RollingGeometry<DIM>& geom,
+                                         size_t task)
+{
+  const size_t line   = task / geom.blocks;
+  const coord_t block = geom.first / geom.window + static_cast<coord_t>(task % geom.blocks);
+  const coord_t start = block * geom.window > geom.first ? block * geom.window : geom.first;
+  const coord_t end   = block * geom.window + geom.window - 1;
+  const coord_t last  = end < geom.hi ? end : geom.hi;
+  VAL* suffix         = suffixes + line * geom.length;
+  VAL acc             = in[geom.point(line, last)];
+
+  suffix[last - geom.first] = acc;
+  for (coord_t x = last - 1; x >= start; --x) {
+    acc                    = OP::combine(in[geom.point(line, x)], acc);
+    suffix[x - geom.first] = acc;
+  }
+}
+
+template <typename OP, int DIM, typename VAL, typename WriteAcc, typename ReadAcc>
+__CUDA_HD__ inline void rolling_block(const WriteAcc& out,
+                                      const ReadAcc& in,
+                                      const VAL* suffixes,
+                                      const RollingGeometry<DIM>& geom,
+                                      size_t task)
+{
+  const size_t line   = task / geom.blocks;
+  const coord_t block = geom.first / geom.window + static_cast<coord_t>(task % geom.blocks);
+  const coord_t start = block * geom.window;
+  // The block that holds the first point read has no points of the tile unless it
+  // starts the array
+  if (start < geom.first) return;
+  const coord_t end    = start + geom.window - 1;
+  const coord_t last   = end < geom.hi ? end : geom.hi;
+  const VAL* suffix    = suffixes + line * geom.length;
+  const coord_t window = geom.window;
+  VAL acc              = in[geom.point(line, start)];
+  for (coord_t x = start; x <= last; ++x) {
+    if (x > start) acc = OP::combine(acc, in[geom.point(line, x)]);
+    if (x < geom.lo) continue;
+    // Windows that begin in the previous block take its suffix from their first point
+    const coord_t begin = x - window + 1;
+    const VAL value =
+      block > 0 && begin < start ? OP::combine(suffix[begin - geom.first], acc) : acc;
+    out[geom.point(line, x)] = OP::finish(value, x + 1 < window ? x + 1 : window);
+  }
+}
+
+template <VariantKind KIND, typename OP, int DIM>
+struct RollingImplBody;
+
+template <VariantKind KIND>
+struct RollingImpl {
+  template <RollingOpCode OP_CODE,
+            LegateTypeCode CODE,
+            int DIM,
+            std::enable_if_t<RollingOp<OP_CODE, CODE>::valid>* = nullptr>
+  void operator()(RollingArgs& args) const
+  {
+    using OP     = RollingOp<OP_CODE, CODE>;
+    using VAL    = legate_type_of<CODE>;
+    auto subrect = args.out.shape<DIM>();
+
+    if (subrect.empty()) return;
+
+    // The tile and its halo share one instance, which covers the union of the tiles
+    auto input_rect = args.inputs[0].shape<DIM>();
+    for (uint32_t idx = 1; idx < args.inputs.size(); ++idx)
+      input_rect = input_rect.union_bbox(args.inputs[idx].shape<DIM>());
+
+    auto out = args.out.write_accessor<VAL, DIM>(subrect);
+    auto in  = args.inputs[0].read_accessor<VAL, DIM>(input_rect);
+
+    RollingGeometry<DIM> geom(subrect, args.axis, args.window);
+    RollingImplBody<KIND, OP, DIM>()(out, in, geom);
+  }
+
+  template <RollingOpCode OP_CODE,
+            LegateTypeCode CODE,
+            int DIM,
+            std::enable_if_t<!RollingOp<OP_CODE, CODE>::valid>* = nullptr>
+  void operator()(RollingArgs& args) const
+  {
+    assert(false);
+  }
+};
+
+template <VariantKind KIND, RollingOpCode OP_CODE>
+struct RollingDispatch {
+  template <LegateTypeCode CODE, int DIM>
+  void operator()(RollingArgs& args) const
+  {
+    RollingImpl<KIND>{}.template operator()<OP_CODE, CODE, DIM>(args);
+  }
+};
+
+template <VariantKind KIND>
+static void rolling_template(TaskContext& context)
+{
+  auto& inputs  = context.inputs();
+  auto& outputs = context.outputs();
+  auto& scalars = context.scalars();
+
+  RollingArgs args{outputs[0],
+                   inputs,
+                   scalars[0].value<RollingOpCode>(),
+                   scalars[1].value<int32_t>(),
+                   scalars[2].value<int64_t>()};
+  auto dim  = args.out.dim();
+  auto code = args.out.code();
+  switch (args.op_code) {
+    case RollingOpCode::SUM:
+      cunumeric::double_dispatch(dim, code, RollingDispatch<KIND, RollingOpCode::SUM>{}, args);
+      break;
+    case RollingOpCode::MEAN:
+      cunumeric::double_dispatch(dim, code, RollingDispatch<KIND, RollingOpCode::MEAN>{}, args);
+      break;
+    case RollingOpCode::MIN:
+      cunumeric::double_dispatch(dim, code, RollingDispatch<KIND, RollingOpCode::MIN>{}, args);
+      break;
+    case RollingOpCode::MAX:
+      cunumeric::double_dispatch(dim, code, RollingDispatch<KIND, RollingOpCode::MAX>{}, args);
+      break;
+  }
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,134 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/stencil/stencil.h"
+#include "cunumeric/stencil/stencil_template.inl"
+
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+// Output tile of a thread block of the tiled kernel, one point per thread
+constexpr int32_t STENCIL_TILE_X = 32;
+constexpr int32_t STENCIL_TILE_Y = 8;
+// Static shared memory limit of a thread block, which the tiles of small halos fit in
+constexpr size_t STENCIL_MAX_SMEM = 48 << 10;
+
+template <typename VAL, int DIM>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  stencil_kernel(const size_t volume,
+                 AccessorWO<VAL, DIM> out,
+                 AccessorRO<VAL, DIM> in,
+                 const StencilTable<VAL, DIM> table,
+                 const Pitches<DIM - 1> pitches,
+                 const Point<DIM> lo)
+{
+  const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx >= volume) return;
+  auto point = pitches.unflatten(idx, lo);
+  out[point] = table(in, point);
+}
+
+// Every thread block first stages its output tile and the halo around it in shared
+// memory, so each input point is loaded from global memory once per block rather than
+// once for every point of the stencil that reads it
+template <typename VAL>
+static __global__ void __launch_bounds__(STENCIL_TILE_X * STENCIL_TILE_Y, MIN_CTAS_PER_SM)
+  tiled_stencil_kernel(AccessorWO<VAL, 2> out,
+                       AccessorRO<VAL, 2> in,
+                       const StencilTable<VAL, 2> table,
+                       const Rect<2> subrect,
+                       const Rect<2> input_rect)
+{
+  // Deal with compiler shared memory stupidity
+  extern __shared__ uint8_t buffer[];
+  VAL* tile = reinterpret_cast<VAL*>(buffer);
+
+  const coord_t width  = STENCIL_TILE_X + table.halo_lo[1] + table.halo_hi[1];
+  const coord_t height = STENCIL_TILE_Y + table.halo_lo[0] + table.halo_hi[0];
+  const coord_t y0     = subrect.lo[0] + blockIdx.y * STENCIL_TILE_Y - table.halo_lo[0];
+  const coord_t x0     = subrect.lo[1] + blockIdx.x * STENCIL_TILE_X - table.halo_lo[1];
+
+  const coord_t tid = threadIdx.y * STENCIL_TILE_X + threadIdx.x;
+  for (coord_t idx = tid; idx < width * height; idx += STENCIL_TILE_X * STENCIL_TILE_Y) {
+    const Point<2> point(y0 + idx / width, x0 + idx % width);
+    // The points beyond the instance lie outside of the array, where only the
+    // points that are not updated would read them
+    if (input_rect.contains(point)) tile[idx] = in[point];
+  }
+  __syncthreads();
+
+  const coord_t y = threadIdx.y + table.halo_lo[0];
+  const coord_t x = threadIdx.x + table.halo_lo[1];
+  const Point<2> point(y0 + y, x0 + x);
+  if (!subrect.contains(point)) return;
+  const VAL* center = tile + y * width + x;
+  if (!table.interior.contains(point)) {
+    out[point] = *center;
+    return;
+  }
+  VAL acc = table.coefficients[0] * center[table.offsets[0][0] * width + table.offsets[0][1]];
+  for (int32_t k = 1; k < table.num_points; k++)
+    acc += table.coefficients[k] * center[table.offsets[k][0] * width + table.offsets[k][1]];
+  out[point] = acc;
+}
+
+template <LegateTypeCode CODE, int DIM>
+struct StencilImplBody<VariantKind::GPU, CODE, DIM> {
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(AccessorWO<VAL, DIM> out,
+                  AccessorRO<VAL, DIM> in,
+                  const StencilTable<VAL, DIM>& table,
+                  const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& subrect,
+                  const Rect<DIM>& input_rect,
+                  bool dense) const
+  {
+    auto stream = get_cached_stream();
+
+    if constexpr (DIM == 2) {
+      const size_t width  = STENCIL_TILE_X + table.halo_lo[1] + table.halo_hi[1];
+      const size_t height = STENCIL_TILE_Y + table.halo_lo[0] + table.halo_hi[0];
+      const size_t smem   = width * height * sizeof(VAL);
+      if (smem <= STENCIL_MAX_SMEM) {
+        const size_t rows = subrect.hi[0] - subrect.lo[0] + 1;
+        const size_t cols = subrect.hi[1] - subrect.lo[1] + 1;
+        const dim3 blocks((cols + STENCIL_TILE_X - 1) / STENCIL_TILE_X,
+                          (rows + STENCIL_TILE_Y - 1) / STENCIL_TILE_Y);
+        const dim3 threads(STENCIL_TILE_X, STENCIL_TILE_Y);
+        tiled_stencil_kernel<VAL>
+          <<<blocks, threads, smem, stream>>>(out, in, table, subrect, input_rect);
+        return;
+      }
+    }
+
+    const size_t volume = subrect.volume();
+    const size_t blocks = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+    stencil_kernel<VAL, DIM>
+      <<<blocks, THREADS_PER_BLOCK, 0, stream>>>(volume, out, in, table, pitches, subrect.lo);
+  }
+};
+
+/*static*/ void StencilTask::gpu_variant(TaskContext& context)
+{
+  stencil_template<VariantKind::GPU>(context);
+}
+
+}  // namespace cunumeric
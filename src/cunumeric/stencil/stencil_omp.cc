@@ -0,0 +1,48 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/stencil/stencil.h"
+#include "cunumeric/stencil/stencil_template.inl"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <LegateTypeCode CODE, int DIM>
+struct StencilImplBody<VariantKind::OMP, CODE, DIM> {
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(AccessorWO<VAL, DIM> out,
+                  AccessorRO<VAL, DIM> in,
+                  const StencilTable<VAL, DIM>& table,
+                  const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& subrect,
+                  const Rect<DIM>& input_rect,
+                  bool dense) const
+  {
+    const size_t rows = subrect.volume() / (subrect.hi[DIM - 1] - subrect.lo[DIM - 1] + 1);
+#pragma omp parallel for schedule(static)
+    for (size_t row = 0; row < rows; ++row) stencil_row(out, in, table, pitches, subrect, row);
+  }
+};
+
+/*static*/ void StencilTask::omp_variant(TaskContext& context)
+{
+  stencil_template<VariantKind::OMP>(context);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,167 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "cunumeric/pitches.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+// The points of a stencil as offsets from the point they update, with their coefficients.
+// Only the points of the interior, whose neighbors all fall inside of the array, are
+// updated; the others keep the value they have in the input.
+template <typename VAL, int DIM>
+struct StencilTable {
+  StencilTable(legate::Span<const int64_t> offsets_,
+               legate::Span<const VAL> coefficients_,
+               const Rect<DIM>& root_rect)
+    : num_points(static_cast<int32_t>(coefficients_.size())), interior(root_rect)
+  {
+    assert(num_points <= MAX_STENCIL_POINTS);
+    assert(offsets_.size() == static_cast<size_t>(num_points) * DIM);
+    for (int d = 0; d < DIM; d++) {
+      halo_lo[d] = 0;
+      halo_hi[d] = 0;
+    }
+    for (int32_t k = 0; k < num_points; k++) {
+      for (int d = 0; d < DIM; d++) {
+        offsets[k][d] = offsets_[k * DIM + d];
+        halo_lo[d]    = std::max<coord_t>(halo_lo[d], -offsets[k][d]);
+        halo_hi[d]    = std::max<coord_t>(halo_hi[d], offsets[k][d]);
+      }
+      coefficients[k] = coefficients_[k];
+    }
+    interior.lo += halo_lo;
+    interior.hi -= halo_hi;
+  }
+
+  // Only valid for points of the interior
+  template <typename ACC>
+  __CUDA_HD__ inline VAL sum(const ACC& in, const Point<DIM>& point) const
+  {
+    VAL acc = coefficients[0] * in[point + offsets[0]];
+    for (int32_t k = 1; k < num_points; k++) acc += coefficients[k] * in[point + offsets[k]];
+    return acc;
+  }
+
+  template <typename ACC>
+  __CUDA_HD__ inline VAL operator()(const ACC& in, const Point<DIM>& point) const
+  {
+    return interior.contains(point) ? sum(in, point) : in[point];
+  }
+
+  int32_t num_points;
+  Point<DIM> offsets[MAX_STENCIL_POINTS];
+  VAL coefficients[MAX_STENCIL_POINTS];
+  // How far the stencil reaches below and above the points it updates
+  Point<DIM> halo_lo;
+  Point<DIM> halo_hi;
+  Rect<DIM> interior;
+};
+
+template <VariantKind KIND, LegateTypeCode CODE, int DIM>
+struct StencilImplBody;
+
+// Updates the row-th innermost row of the tile. Rows on the boundary of one of the outer
+// dimensions are copied whole, and the others only at the ends that lie on the boundary.
+template <typename VAL, int DIM>
+inline void stencil_row(const AccessorWO<VAL, DIM>& out,
+                        const AccessorRO<VAL, DIM>& in,
+                        const StencilTable<VAL, DIM>& table,
+                        const Pitches<DIM - 1>& pitches,
+                        const Rect<DIM>& subrect,
+                        size_t row)
+{
+  const coord_t lo = subrect.lo[DIM - 1];
+  const coord_t hi = subrect.hi[DIM - 1];
+  auto point       = pitches.unflatten(row * (hi - lo + 1), subrect.lo);
+
+  bool inside = true;
+  for (int d = 0; d < DIM - 1; d++)
+    inside = inside && table.interior.lo[d] <= point[d] && point[d] <= table.interior.hi[d];
+  const coord_t first = inside ? std::max(lo, table.interior.lo[DIM - 1]) : hi + 1;
+  const coord_t last  = inside ? std::min(hi, table.interior.hi[DIM - 1]) : hi;
+
+  for (coord_t x = lo; x < std::min(first, hi + 1); ++x) {
+    point[DIM - 1] = x;
+    out[point]     = in[point];
+  }
+  for (coord_t x = first; x <= last; ++x) {
+    point[DIM - 1] = x;
+    out[point]     = table.sum(in, point);
+  }
+  for (coord_t x = std::max(first, last + 1); x <= hi; ++x) {
+    point[DIM - 1] = x;
+    out[point]     = in[point];
+  }
+}
+
+template <VariantKind KIND>
+struct StencilImpl {
+  template <LegateTypeCode CODE, int DIM>
+  void operator()(StencilArgs& args) const
+  {
+    using VAL    = legate_type_of<CODE>;
+    auto subrect = args.out.shape<DIM>();
+
+    Pitches<DIM - 1> pitches;
+    size_t volume = pitches.flatten(subrect);
+
+    if (volume == 0) return;
+
+    // The tile and its halo share one instance, which covers the union of the tiles
+    auto input_rect = args.inputs[0].shape<DIM>();
+    for (uint32_t idx = 1; idx < args.inputs.size(); ++idx)
+      input_rect = input_rect.union_bbox(args.inputs[idx].shape<DIM>());
+
+    auto out = args.out.write_accessor<VAL, DIM>(subrect);
+    auto in  = args.inputs[0].read_accessor<VAL, DIM>(input_rect);
+
+    Rect<DIM> root_rect;
+    for (int d = 0; d < DIM; d++) {
+      root_rect.lo[d] = 0;
+      root_rect.hi[d] = args.shape[d] - 1;
+    }
+    StencilTable<VAL, DIM> table(args.offsets, args.coefficients.values<VAL>(), root_rect);
+
+#ifndef LEGION_BOUNDS_CHECKS
+    bool dense =
+      out.accessor.is_dense_row_major(subrect) && in.accessor.is_dense_row_major(input_rect);
+#else
+    bool dense = false;
+#endif
+
+    StencilImplBody<KIND, CODE, DIM>()(out, in, table, pitches, subrect, input_rect, dense);
+  }
+};
+
+template <VariantKind KIND>
+static void stencil_template(TaskContext& context)
+{
+  auto& inputs  = context.inputs();
+  auto& outputs = context.outputs();
+  auto& scalars = context.scalars();
+
+  StencilArgs args{outputs[0],
+                   inputs,
+                   scalars[0].value<DomainPoint>(),
+                   scalars[1].values<int64_t>(),
+                   scalars[2]};
+  cunumeric::double_dispatch(args.out.dim(), args.out.code(), StencilImpl<KIND>{}, args);
+}
+
+}  // namespace cunumeric
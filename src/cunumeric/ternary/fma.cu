@@ -0,0 +1,151 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include "cunumeric/ternary/fma.h"
+#include "cunumeric/ternary/fma_template.inl"
+
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+
+// Stands in for the coefficient array when the coefficient is a scalar,
+// so the kernels below serve both cases
+template <typename VAL>
+struct ScalarCoefficient {
+  template <typename INDEX>
+  __device__ inline VAL operator[](const INDEX&) const
+  {
+    return value;
+  }
+
+  VAL value;
+};
+
+template <int VEC, typename VAL, typename Coefficient>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  dense_kernel(size_t volume, VAL* out, Coefficient a, const VAL* x, const VAL* y)
+{
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x * VEC;
+  for (size_t offset = (blockIdx.x * blockDim.x + threadIdx.x) * VEC; offset < volume;
+       offset += stride) {
+    if (offset + VEC <= volume) {
+      const auto xs = load_vector<VEC>(x + offset);
+      const auto ys = load_vector<VEC>(y + offset);
+      VectorPack<VAL, VEC> zs;
+#pragma unroll
+      for (int k = 0; k < VEC; ++k) zs[k] = fused_multiply_add<VAL>(a[offset + k], xs[k], ys[k]);
+      store_vector<VEC>(out + offset, zs);
+    } else {
+      for (size_t idx = offset; idx < volume; ++idx)
+        out[idx] = fused_multiply_add<VAL>(a[idx], x[idx], y[idx]);
+    }
+  }
+}
+
+template <typename WriteAcc,
+          typename Coefficient,
+          typename ReadAcc,
+          typename Pitches,
+          typename Rect>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM) generic_kernel(
+  size_t volume, WriteAcc out, Coefficient a, ReadAcc x, ReadAcc y, Pitches pitches, Rect rect)
+{
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x;
+  for (size_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < volume; idx += stride) {
+    auto point = pitches.unflatten(idx, rect.lo);
+    out[point] = fused_multiply_add(a[point], x[point], y[point]);
+  }
+}
+
+template <LegateTypeCode CODE, int DIM>
+struct FmaImplBody<VariantKind::GPU, CODE, DIM> {
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(AccessorRO<VAL, DIM> a,
+                  AccessorWO<VAL, DIM> out,
+                  AccessorRO<VAL, DIM> x,
+                  AccessorRO<VAL, DIM> y,
+                  const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& rect,
+                  bool dense) const
+  {
+    if (dense)
+      launch_dense(a.ptr(rect), out, x, y, rect);
+    else
+      launch_generic(a, out, x, y, rect);
+  }
+
+  void operator()(VAL a,
+                  AccessorWO<VAL, DIM> out,
+                  AccessorRO<VAL, DIM> x,
+                  AccessorRO<VAL, DIM> y,
+                  const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& rect,
+                  bool dense) const
+  {
+    ScalarCoefficient<VAL> coefficient{a};
+    if (dense)
+      launch_dense(coefficient, out, x, y, rect);
+    else
+      launch_generic(coefficient, out, x, y, rect);
+  }
+
+  template <typename Coefficient>
+  void launch_dense(Coefficient a,
+                    const AccessorWO<VAL, DIM>& out,
+                    const AccessorRO<VAL, DIM>& x,
+                    const AccessorRO<VAL, DIM>& y,
+                    const Rect<DIM>& rect) const
+  {
+    auto stream = get_cached_stream();
+
+    const size_t volume = rect.volume();
+    auto outptr         = out.ptr(rect);
+    auto xptr           = x.ptr(rect);
+    auto yptr           = y.ptr(rect);
+    constexpr int VEC   = vector_width<VAL>();
+    if (is_vector_aligned<VEC>(outptr, xptr, yptr))
+      dense_kernel<VEC><<<grid_stride_blocks<VEC>(volume), THREADS_PER_BLOCK, 0, stream>>>(
+        volume, outptr, a, xptr, yptr);
+    else
+      dense_kernel<1><<<grid_stride_blocks<1>(volume), THREADS_PER_BLOCK, 0, stream>>>(
+        volume, outptr, a, xptr, yptr);
+  }
+
+  template <typename Coefficient>
+  void launch_generic(Coefficient a,
+                      const AccessorWO<VAL, DIM>& out,
+                      const AccessorRO<VAL, DIM>& x,
+                      const AccessorRO<VAL, DIM>& y,
+                      const Rect<DIM>& rect) const
+  {
+    auto stream = get_cached_stream();
+
+    const size_t volume = rect.volume();
+    FastPitches<DIM - 1> fast_pitches;
+    fast_pitches.flatten(rect);
+    generic_kernel<<<grid_stride_blocks<1>(volume), THREADS_PER_BLOCK, 0, stream>>>(
+      volume, out, a, x, y, fast_pitches, rect);
+  }
+};
+
+/*static*/ void FmaTask::gpu_variant(TaskContext& context)
+{
+  fma_template<VariantKind::GPU>(context);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,86 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include "cunumeric/ternary/fma.h"
+#include "cunumeric/ternary/fma_template.inl"
+
+#include "cunumeric/simd.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <LegateTypeCode CODE, int DIM>
+struct FmaImplBody<VariantKind::OMP, CODE, DIM> {
+  using VAL = legate_type_of<CODE>;
+
+  void operator()(AccessorRO<VAL, DIM> a,
+                  AccessorWO<VAL, DIM> out,
+                  AccessorRO<VAL, DIM> x,
+                  AccessorRO<VAL, DIM> y,
+                  const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& rect,
+                  bool dense) const
+  {
+    const size_t volume = rect.volume();
+    if (dense) {
+      auto outptr = out.ptr(rect);
+      auto aptr   = a.ptr(rect);
+      auto xptr   = x.ptr(rect);
+      auto yptr   = y.ptr(rect);
+      simd::parallel_for_each(volume, [=](size_t idx) {
+        outptr[idx] = fused_multiply_add(aptr[idx], xptr[idx], yptr[idx]);
+      });
+    } else {
+#pragma omp parallel for schedule(static)
+      for (size_t idx = 0; idx < volume; ++idx) {
+        auto point = pitches.unflatten(idx, rect.lo);
+        out[point] = fused_multiply_add(a[point], x[point], y[point]);
+      }
+    }
+  }
+
+  void operator()(VAL a,
+                  AccessorWO<VAL, DIM> out,
+                  AccessorRO<VAL, DIM> x,
+                  AccessorRO<VAL, DIM> y,
+                  const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& rect,
+                  bool dense) const
+  {
+    const size_t volume = rect.volume();
+    if (dense) {
+      auto outptr = out.ptr(rect);
+      auto xptr   = x.ptr(rect);
+      auto yptr   = y.ptr(rect);
+      simd::parallel_for_each(
+        volume, [=](size_t idx) { outptr[idx] = fused_multiply_add(a, xptr[idx], yptr[idx]); });
+    } else {
+#pragma omp parallel for schedule(static)
+      for (size_t idx = 0; idx < volume; ++idx) {
+        auto point = pitches.unflatten(idx, rect.lo);
+        out[point] = fused_multiply_add(a, x[point], y[point]);
+      }
+    }
+  }
+};
+
+/*static*/ void FmaTask::omp_variant(TaskContext& context)
+{
+  fma_template<VariantKind::OMP>(context);
+}
+
+}  // namespace cunumeric
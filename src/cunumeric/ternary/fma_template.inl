@@ -0,0 +1,123 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <cmath>
+
+#include "cunumeric/pitches.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <VariantKind KIND, LegateTypeCode CODE, int DIM>
+struct FmaImplBody;
+
+template <LegateTypeCode CODE>
+struct support_fma : std::false_type {
+};
+template <>
+struct support_fma<LegateTypeCode::DOUBLE_LT> : std::true_type {
+};
+template <>
+struct support_fma<LegateTypeCode::FLOAT_LT> : std::true_type {
+};
+
+// Computes a * x + y with a single rounding, which both CPUs and GPUs
+// execute as one instruction
+template <typename VAL>
+__CUDA_HD__ inline VAL fused_multiply_add(const VAL& a, const VAL& x, const VAL& y)
+{
+#ifdef __CUDA_ARCH__
+  return fma(a, x, y);
+#else
+  return std::fma(a, x, y);
+#endif
+}
+
+template <VariantKind KIND>
+struct FmaImpl {
+  template <LegateTypeCode CODE, int DIM, std::enable_if_t<support_fma<CODE>::value>* = nullptr>
+  void operator()(FmaArgs& args) const
+  {
+    using VAL = legate_type_of<CODE>;
+
+    auto rect = args.out.shape<DIM>();
+
+    Pitches<DIM - 1> pitches;
+    size_t volume = pitches.flatten(rect);
+
+    if (volume == 0) return;
+
+    auto out = args.out.write_accessor<VAL, DIM>(rect);
+    auto x   = args.x.read_accessor<VAL, DIM>(rect);
+    auto y   = args.y.read_accessor<VAL, DIM>(rect);
+
+    if (args.scalar_coefficient) {
+#ifndef LEGION_BOUNDS_CHECKS
+      // Check to see if this is dense or not
+      bool dense = out.accessor.is_dense_row_major(rect) && x.accessor.is_dense_row_major(rect) &&
+                   y.accessor.is_dense_row_major(rect);
+#else
+      // No dense execution if we're doing bounds checks
+      bool dense = false;
+#endif
+
+      auto a = args.coefficient.value<VAL>();
+      FmaImplBody<KIND, CODE, DIM>()(a, out, x, y, pitches, rect, dense);
+    } else {
+      auto a = args.a.read_accessor<VAL, DIM>(rect);
+
+#ifndef LEGION_BOUNDS_CHECKS
+      // Check to see if this is dense or not
+      bool dense = out.accessor.is_dense_row_major(rect) && a.accessor.is_dense_row_major(rect) &&
+                   x.accessor.is_dense_row_major(rect) && y.accessor.is_dense_row_major(rect);
+#else
+      // No dense execution if we're doing bounds checks
+      bool dense = false;
+#endif
+
+      FmaImplBody<KIND, CODE, DIM>()(a, out, x, y, pitches, rect, dense);
+    }
+  }
+
+  template <LegateTypeCode CODE, int DIM, std::enable_if_t<!support_fma<CODE>::value>* = nullptr>
+  void operator()(FmaArgs& args) const
+  {
+    assert(false);
+  }
+};
+
+template <VariantKind KIND>
+static void fma_template(TaskContext& context)
+{
+  auto& inputs  = context.inputs();
+  auto& scalars = context.scalars();
+
+  // A scalar coefficient is passed by value, so only x and y are arrays
+  auto scalar_coefficient = scalars[0].value<bool>();
+  size_t offset           = scalar_coefficient ? 0 : 1;
+
+  FmaArgs args{context.outputs()[0],
+               inputs[0],
+               inputs[offset],
+               inputs[offset + 1],
+               scalar_coefficient,
+               scalars[scalar_coefficient ? 1 : 0]};
+  auto dim = std::max(1, args.out.dim());
+  cunumeric::double_dispatch(dim, args.out.code(), FmaImpl<KIND>{}, args);
+}
+
+}  // namespace cunumeric
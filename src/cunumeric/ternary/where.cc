@@ -26,21 +26,21 @@ template <LegateTypeCode CODE, int DIM>
 struct WhereImplBody<VariantKind::CPU, CODE, DIM> {
   using VAL = legate_type_of<CODE>;
 
+  template <typename In1, typename In2>
   void operator()(AccessorWO<VAL, DIM> out,
                   AccessorRO<bool, DIM> mask,
-                  AccessorRO<VAL, DIM> in1,
-                  AccessorRO<VAL, DIM> in2,
+                  const In1& in1,
+                  const In2& in2,
                   const Pitches<DIM - 1>& pitches,
                   const Rect<DIM>& rect,
                   bool dense) const
   {
     const size_t volume = rect.volume();
     if (dense) {
-      size_t volume = rect.volume();
-      auto outptr   = out.ptr(rect);
-      auto maskptr  = mask.ptr(rect);
-      auto in1ptr   = in1.ptr(rect);
-      auto in2ptr   = in2.ptr(rect);
+      auto outptr  = out.ptr(rect);
+      auto maskptr = mask.ptr(rect);
+      auto in1ptr  = where_dense_operand(in1, rect);
+      auto in2ptr  = where_dense_operand(in2, rect);
       for (size_t idx = 0; idx < volume; ++idx)
         outptr[idx] = maskptr[idx] ? in1ptr[idx] : in2ptr[idx];
     } else {
@@ -50,6 +50,29 @@ struct WhereImplBody<VariantKind::CPU, CODE, DIM> {
       }
     }
   }
+
+  template <typename In1>
+  void operator()(AccessorRW<VAL, DIM> out,
+                  AccessorRO<bool, DIM> mask,
+                  const In1& in1,
+                  const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& rect,
+                  bool dense) const
+  {
+    const size_t volume = rect.volume();
+    if (dense) {
+      auto outptr  = out.ptr(rect);
+      auto maskptr = mask.ptr(rect);
+      auto in1ptr  = where_dense_operand(in1, rect);
+      for (size_t idx = 0; idx < volume; ++idx)
+        if (maskptr[idx]) outptr[idx] = in1ptr[idx];
+    } else {
+      for (size_t idx = 0; idx < volume; ++idx) {
+        auto point = pitches.unflatten(idx, rect.lo);
+        if (mask[point]) out[point] = in1[point];
+      }
+    }
+  }
 };
 
 /*static*/ void WhereTask::cpu_variant(TaskContext& context)
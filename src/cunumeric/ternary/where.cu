@@ -23,48 +23,170 @@ namespace cunumeric {
 
 using namespace Legion;
 
-template <typename VAL>
+// Vector loads of a branch, where a scalar branch fills the whole pack
+template <int VEC, typename VAL>
+static __device__ __forceinline__ VectorPack<VAL, VEC> load_branch(const VAL* in, size_t offset)
+{
+  return load_vector<VEC>(in + offset);
+}
+
+template <int VEC, typename VAL>
+static __device__ __forceinline__ VectorPack<VAL, VEC> load_branch(const WhereScalar<VAL>& in,
+                                                                   size_t offset)
+{
+  VectorPack<VAL, VEC> pack;
+#pragma unroll
+  for (int k = 0; k < VEC; ++k) pack[k] = in.value;
+  return pack;
+}
+
+template <int VEC, typename VAL>
+static bool branch_aligned(const VAL* in)
+{
+  return is_vector_aligned<VEC>(in);
+}
+
+template <int VEC, typename VAL>
+static bool branch_aligned(const WhereScalar<VAL>& in)
+{
+  return true;
+}
+
+template <int VEC, typename VAL, typename In1, typename In2>
 static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
-  dense_kernel(size_t volume, VAL* out, const bool* mask, const VAL* in1, const VAL* in2)
+  dense_kernel(size_t volume, VAL* out, const bool* mask, In1 in1, In2 in2)
 {
-  const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
-  if (idx >= volume) return;
-  out[idx] = mask[idx] ? in1[idx] : in2[idx];
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x * VEC;
+  for (size_t offset = (blockIdx.x * blockDim.x + threadIdx.x) * VEC; offset < volume;
+       offset += stride) {
+    if (offset + VEC <= volume) {
+      const auto m = load_vector<VEC>(mask + offset);
+      const auto x = load_branch<VEC>(in1, offset);
+      const auto y = load_branch<VEC>(in2, offset);
+      VectorPack<VAL, VEC> z;
+#pragma unroll
+      for (int k = 0; k < VEC; ++k) z[k] = m[k] ? x[k] : y[k];
+      store_vector<VEC>(out + offset, z);
+    } else {
+      for (size_t idx = offset; idx < volume; ++idx) out[idx] = mask[idx] ? in1[idx] : in2[idx];
+    }
+  }
 }
 
-template <typename WriteAcc, typename MaskAcc, typename ReadAcc, typename Pitches, typename Rect>
+template <typename WriteAcc,
+          typename MaskAcc,
+          typename In1,
+          typename In2,
+          typename Pitches,
+          typename Rect>
 static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM) generic_kernel(
-  size_t volume, WriteAcc out, MaskAcc mask, ReadAcc in1, ReadAcc in2, Pitches pitches, Rect rect)
+  size_t volume, WriteAcc out, MaskAcc mask, In1 in1, In2 in2, Pitches pitches, Rect rect)
+{
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x;
+  for (size_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < volume; idx += stride) {
+    auto point = pitches.unflatten(idx, rect.lo);
+    out[point] = mask[point] ? in1[point] : in2[point];
+  }
+}
+
+// The mask is read a pack at a time and only the selected values are stored
+template <int VEC, typename VAL, typename In1>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  dense_inplace_kernel(size_t volume, VAL* out, const bool* mask, In1 in1)
 {
-  const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
-  if (idx >= volume) return;
-  auto point = pitches.unflatten(idx, rect.lo);
-  out[point] = mask[point] ? in1[point] : in2[point];
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x * VEC;
+  for (size_t offset = (blockIdx.x * blockDim.x + threadIdx.x) * VEC; offset < volume;
+       offset += stride) {
+    if (offset + VEC <= volume) {
+      const auto m = load_vector<VEC>(mask + offset);
+#pragma unroll
+      for (int k = 0; k < VEC; ++k)
+        if (m[k]) out[offset + k] = in1[offset + k];
+    } else {
+      for (size_t idx = offset; idx < volume; ++idx)
+        if (mask[idx]) out[idx] = in1[idx];
+    }
+  }
+}
+
+template <typename RWAcc, typename MaskAcc, typename In1, typename Pitches, typename Rect>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM) generic_inplace_kernel(
+  size_t volume, RWAcc out, MaskAcc mask, In1 in1, Pitches pitches, Rect rect)
+{
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x;
+  for (size_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < volume; idx += stride) {
+    auto point = pitches.unflatten(idx, rect.lo);
+    if (mask[point]) out[point] = in1[point];
+  }
 }
 
 template <LegateTypeCode CODE, int DIM>
 struct WhereImplBody<VariantKind::GPU, CODE, DIM> {
   using VAL = legate_type_of<CODE>;
 
+  template <typename In1, typename In2>
   void operator()(AccessorWO<VAL, DIM> out,
                   AccessorRO<bool, DIM> mask,
-                  AccessorRO<VAL, DIM> in1,
-                  AccessorRO<VAL, DIM> in2,
+                  const In1& in1,
+                  const In2& in2,
+                  const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& rect,
+                  bool dense) const
+  {
+    auto stream = get_cached_stream();
+
+    const size_t volume = rect.volume();
+    const size_t blocks = grid_stride_blocks<1>(volume);
+    if (dense) {
+      auto outptr       = out.ptr(rect);
+      auto maskptr      = mask.ptr(rect);
+      auto in1ptr       = where_dense_operand(in1, rect);
+      auto in2ptr       = where_dense_operand(in2, rect);
+      constexpr int VEC = vector_width<VAL, bool>();
+      if (is_vector_aligned<VEC>(outptr, maskptr) && branch_aligned<VEC>(in1ptr) &&
+          branch_aligned<VEC>(in2ptr))
+        dense_kernel<VEC><<<grid_stride_blocks<VEC>(volume), THREADS_PER_BLOCK, 0, stream>>>(
+          volume, outptr, maskptr, in1ptr, in2ptr);
+      else
+        dense_kernel<1><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+          volume, outptr, maskptr, in1ptr, in2ptr);
+    } else {
+      FastPitches<DIM - 1> fast_pitches;
+      fast_pitches.flatten(rect);
+      generic_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+        volume, out, mask, in1, in2, fast_pitches, rect);
+    }
+  }
+
+  template <typename In1>
+  void operator()(AccessorRW<VAL, DIM> out,
+                  AccessorRO<bool, DIM> mask,
+                  const In1& in1,
                   const Pitches<DIM - 1>& pitches,
                   const Rect<DIM>& rect,
                   bool dense) const
   {
+    auto stream = get_cached_stream();
+
     const size_t volume = rect.volume();
-    const size_t blocks = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+    const size_t blocks = grid_stride_blocks<1>(volume);
     if (dense) {
-      size_t volume = rect.volume();
-      auto outptr   = out.ptr(rect);
-      auto maskptr  = mask.ptr(rect);
-      auto in1ptr   = in1.ptr(rect);
-      auto in2ptr   = in2.ptr(rect);
-      dense_kernel<<<blocks, THREADS_PER_BLOCK>>>(volume, outptr, maskptr, in1ptr, in2ptr);
+      auto outptr       = out.ptr(rect);
+      auto maskptr      = mask.ptr(rect);
+      auto in1ptr       = where_dense_operand(in1, rect);
+      constexpr int VEC = vector_width<bool>();
+      if (is_vector_aligned<VEC>(maskptr))
+        dense_inplace_kernel<VEC>
+          <<<grid_stride_blocks<VEC>(volume), THREADS_PER_BLOCK, 0, stream>>>(
+            volume, outptr, maskptr, in1ptr);
+      else
+        dense_inplace_kernel<1><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+          volume, outptr, maskptr, in1ptr);
     } else {
-      generic_kernel<<<blocks, THREADS_PER_BLOCK>>>(volume, out, mask, in1, in2, pitches, rect);
+      FastPitches<DIM - 1> fast_pitches;
+      fast_pitches.flatten(rect);
+      generic_inplace_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+        volume, out, mask, in1, fast_pitches, rect);
     }
   }
 };
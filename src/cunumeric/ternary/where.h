@@ -23,8 +23,13 @@ namespace cunumeric {
 struct WhereArgs {
   const Array& out;
   const Array& mask;
-  const Array& in1;
-  const Array& in2;
+  // A branch that is a scalar is passed by value and has no array
+  const Array* in1;
+  const Array* in2;
+  const legate::Scalar* value1;
+  const legate::Scalar* value2;
+  // When true, out is only updated where the mask is set and there is no second branch
+  bool inplace;
 };
 
 class WhereTask : public CuNumericTask<WhereTask> {
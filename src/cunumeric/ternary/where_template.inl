@@ -24,6 +24,43 @@ using namespace legate;
 template <VariantKind KIND, LegateTypeCode CODE, int DIM>
 struct WhereImplBody;
 
+// A branch that is a single value, indexed like the array it stands in for
+template <typename VAL>
+struct WhereScalar {
+  __CUDA_HD__ VAL operator[](size_t idx) const { return value; }
+  template <int DIM>
+  __CUDA_HD__ VAL operator[](const Point<DIM>& point) const
+  {
+    return value;
+  }
+  VAL value;
+};
+
+// The dense loops index array branches through raw pointers and scalars directly
+template <typename VAL, int DIM>
+const VAL* where_dense_operand(const AccessorRO<VAL, DIM>& in, const Rect<DIM>& rect)
+{
+  return in.ptr(rect);
+}
+
+template <typename VAL, int DIM>
+WhereScalar<VAL> where_dense_operand(const WhereScalar<VAL>& in, const Rect<DIM>& rect)
+{
+  return in;
+}
+
+template <typename VAL, int DIM>
+bool where_is_dense(const AccessorRO<VAL, DIM>& in, const Rect<DIM>& rect)
+{
+  return in.accessor.is_dense_row_major(rect);
+}
+
+template <typename VAL, int DIM>
+bool where_is_dense(const WhereScalar<VAL>& in, const Rect<DIM>& rect)
+{
+  return true;
+}
+
 template <VariantKind KIND>
 struct WhereImpl {
   template <LegateTypeCode CODE, int DIM>
@@ -38,15 +75,58 @@ struct WhereImpl {
 
     if (volume == 0) return;
 
-    auto out  = args.out.write_accessor<VAL, DIM>(rect);
     auto mask = args.mask.read_accessor<bool, DIM>(rect);
-    auto in1  = args.in1.read_accessor<VAL, DIM>(rect);
-    auto in2  = args.in2.read_accessor<VAL, DIM>(rect);
+    if (args.in1 != nullptr)
+      with_first<CODE>(args, mask, args.in1->read_accessor<VAL, DIM>(rect), pitches, rect);
+    else
+      with_first<CODE>(args, mask, WhereScalar<VAL>{args.value1->value<VAL>()}, pitches, rect);
+  }
+
+  template <LegateTypeCode CODE, int DIM, typename In1>
+  void with_first(WhereArgs& args,
+                  const AccessorRO<bool, DIM>& mask,
+                  const In1& in1,
+                  const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& rect) const
+  {
+    using VAL = legate_type_of<CODE>;
+
+    if (args.inplace) {
+      // Values where the mask is not set are neither read nor written
+      auto out = args.out.read_write_accessor<VAL, DIM>(rect);
+#ifndef LEGION_BOUNDS_CHECKS
+      bool dense = out.accessor.is_dense_row_major(rect) &&
+                   mask.accessor.is_dense_row_major(rect) && where_is_dense(in1, rect);
+#else
+      bool dense = false;
+#endif
+      WhereImplBody<KIND, CODE, DIM>()(out, mask, in1, pitches, rect, dense);
+      return;
+    }
+
+    if (args.in2 != nullptr)
+      with_second<CODE>(args, mask, in1, args.in2->read_accessor<VAL, DIM>(rect), pitches, rect);
+    else
+      with_second<CODE>(
+        args, mask, in1, WhereScalar<VAL>{args.value2->value<VAL>()}, pitches, rect);
+  }
+
+  template <LegateTypeCode CODE, int DIM, typename In1, typename In2>
+  void with_second(WhereArgs& args,
+                   const AccessorRO<bool, DIM>& mask,
+                   const In1& in1,
+                   const In2& in2,
+                   const Pitches<DIM - 1>& pitches,
+                   const Rect<DIM>& rect) const
+  {
+    using VAL = legate_type_of<CODE>;
+
+    auto out = args.out.write_accessor<VAL, DIM>(rect);
 
 #ifndef LEGION_BOUNDS_CHECKS
     // Check to see if this is dense or not
-    bool dense = out.accessor.is_dense_row_major(rect) && in1.accessor.is_dense_row_major(rect) &&
-                 in2.accessor.is_dense_row_major(rect) && mask.accessor.is_dense_row_major(rect);
+    bool dense = out.accessor.is_dense_row_major(rect) && mask.accessor.is_dense_row_major(rect) &&
+                 where_is_dense(in1, rect) && where_is_dense(in2, rect);
 #else
     // No dense execution if we're doing bounds checks
     bool dense = false;
@@ -59,10 +139,25 @@ struct WhereImpl {
 template <VariantKind KIND>
 static void where_template(TaskContext& context)
 {
-  auto& inputs = context.inputs();
-  WhereArgs args{context.outputs()[0], inputs[0], inputs[1], inputs[2]};
+  auto& inputs  = context.inputs();
+  auto& scalars = context.scalars();
+
+  // Scalar branches are passed by value after the flags and take no input
+  auto scalar1 = scalars[0].value<bool>();
+  auto scalar2 = scalars[1].value<bool>();
+  auto inplace = scalars[2].value<bool>();
+
+  size_t next_input  = 1;
+  size_t next_scalar = 3;
+  const Array* in1   = scalar1 ? nullptr : &inputs[next_input++];
+  const Scalar* val1 = scalar1 ? &scalars[next_scalar++] : nullptr;
+  // An in-place update gets the output as its last input, which is not read through
+  const Array* in2   = (scalar2 || inplace) ? nullptr : &inputs[next_input++];
+  const Scalar* val2 = scalar2 ? &scalars[next_scalar++] : nullptr;
+
+  WhereArgs args{context.outputs()[0], inputs[0], in1, in2, val1, val2, inplace};
   auto dim = std::max(1, args.out.dim());
-  double_dispatch(dim, args.out.code(), WhereImpl<KIND>{}, args);
+  cunumeric::double_dispatch(dim, args.out.code(), WhereImpl<KIND>{}, args);
 }
 
 }  // namespace cunumeric
@@ -30,9 +30,15 @@ struct FlipImplBody<VariantKind::CPU, CODE, DIM> {
                   AccessorRO<VAL, DIM> in,
                   const Pitches<DIM - 1>& pitches,
                   const Rect<DIM>& rect,
-                  legate::Span<const int32_t> axes) const
+                  legate::Span<const int32_t> axes,
+                  bool dense) const
 
   {
+    if (dense) {
+      const size_t rows = rect.volume() / (rect.hi[DIM - 1] - rect.lo[DIM - 1] + 1);
+      for (size_t row = 0; row < rows; ++row) flip_dense_row(out, in, pitches, rect, axes, row);
+      return;
+    }
     for (PointInRectIterator<DIM> itr(rect); itr.valid(); ++itr) {
       auto q = *itr;
       for (uint32_t idx = 0; idx < axes.size(); ++idx)
@@ -50,15 +50,19 @@ struct FlipImplBody<VariantKind::GPU, CODE, DIM> {
                   AccessorRO<VAL, DIM> in,
                   const Pitches<DIM - 1>& pitches,
                   const Rect<DIM>& rect,
-                  legate::Span<const int32_t> axes) const
+                  legate::Span<const int32_t> axes,
+                  bool dense) const
 
   {
+    auto stream = get_cached_stream();
+
     const size_t volume = rect.volume();
     const size_t blocks = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
     auto num_axes       = axes.size();
     DeferredBuffer<int32_t, 1> gpu_axes(Memory::Kind::Z_COPY_MEM, Rect<1>(0, num_axes - 1));
     for (uint32_t idx = 0; idx < num_axes; ++idx) gpu_axes[idx] = axes[idx];
-    flip_kernel<<<blocks, THREADS_PER_BLOCK>>>(volume, out, in, pitches, rect, gpu_axes, num_axes);
+    flip_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+      volume, out, in, pitches, rect, gpu_axes, num_axes);
   }
 };
 
@@ -30,10 +30,17 @@ struct FlipImplBody<VariantKind::OMP, CODE, DIM> {
                   AccessorRO<VAL, DIM> in,
                   const Pitches<DIM - 1>& pitches,
                   const Rect<DIM>& rect,
-                  legate::Span<const int32_t> axes) const
+                  legate::Span<const int32_t> axes,
+                  bool dense) const
 
   {
     const size_t volume = rect.volume();
+    if (dense) {
+      const size_t rows = volume / (rect.hi[DIM - 1] - rect.lo[DIM - 1] + 1);
+#pragma omp parallel for schedule(static)
+      for (size_t row = 0; row < rows; ++row) flip_dense_row(out, in, pitches, rect, axes, row);
+      return;
+    }
 #pragma omp parallel for schedule(static)
     for (size_t idx = 0; idx < volume; ++idx) {
       auto p = pitches.unflatten(idx, rect.lo);
@@ -24,6 +24,34 @@ using namespace legate;
 template <VariantKind KIND, LegateTypeCode CODE, int DIM>
 struct FlipImplBody;
 
+// Flips the row-th innermost row of dense stores with a single pass over the row,
+// which reads the input backwards when the innermost axis is flipped
+template <typename VAL, int DIM>
+inline void flip_dense_row(const AccessorWO<VAL, DIM>& out,
+                           const AccessorRO<VAL, DIM>& in,
+                           const Pitches<DIM - 1>& pitches,
+                           const Rect<DIM>& rect,
+                           legate::Span<const int32_t> axes,
+                           size_t row)
+{
+  const size_t length = rect.hi[DIM - 1] - rect.lo[DIM - 1] + 1;
+  const auto p        = pitches.unflatten(row * length, rect.lo);
+  auto q              = p;
+  bool reversed       = false;
+  for (uint32_t idx = 0; idx < axes.size(); ++idx) {
+    if (axes[idx] == DIM - 1)
+      reversed = true;
+    else
+      q[axes[idx]] = rect.hi[axes[idx]] - q[axes[idx]];
+  }
+  auto outptr = out.ptr(p);
+  auto inptr  = in.ptr(q);
+  if (reversed)
+    for (size_t k = 0; k < length; ++k) outptr[k] = inptr[length - 1 - k];
+  else
+    for (size_t k = 0; k < length; ++k) outptr[k] = inptr[k];
+}
+
 template <VariantKind KIND>
 struct FlipImpl {
   template <LegateTypeCode CODE, int DIM>
@@ -41,7 +69,13 @@ struct FlipImpl {
     auto out = args.out.write_accessor<VAL, DIM>(rect);
     auto in  = args.in.read_accessor<VAL, DIM>(rect);
 
-    FlipImplBody<KIND, CODE, DIM>()(out, in, pitches, rect, args.axes);
+#ifndef LEGION_BOUNDS_CHECKS
+    bool dense = out.accessor.is_dense_row_major(rect) && in.accessor.is_dense_row_major(rect);
+#else
+    bool dense = false;
+#endif
+
+    FlipImplBody<KIND, CODE, DIM>()(out, in, pitches, rect, args.axes, dense);
   }
 };
 
@@ -53,7 +87,7 @@ static void flip_template(TaskContext& context)
   auto& scalars = context.scalars();
 
   FlipArgs args{inputs[0], outputs[0], scalars[0].values<int32_t>()};
-  double_dispatch(args.in.dim(), args.in.code(), FlipImpl<KIND>{}, args);
+  cunumeric::double_dispatch(args.in.dim(), args.in.code(), FlipImpl<KIND>{}, args);
 }
 
 }  // namespace cunumeric
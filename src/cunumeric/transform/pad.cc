@@ -0,0 +1,64 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/transform/pad.h"
+#include "cunumeric/transform/pad_template.inl"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <typename VAL, int DIM>
+struct PadImplBody<VariantKind::CPU, VAL, DIM> {
+  void operator()(const AccessorWO<VAL, DIM>& out,
+                  const AccessorRO<VAL, DIM>& in,
+                  const AccessorRO<VAL, 1>& value,
+                  const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& out_rect,
+                  const Rect<DIM>& in_rect,
+                  const Point<DIM>& before,
+                  PadMode mode,
+                  size_t volume,
+                  bool dense) const
+  {
+    const VAL fill_value = value[0];
+    if (dense) {
+      const size_t rows = volume / (out_rect.hi[DIM - 1] - out_rect.lo[DIM - 1] + 1);
+      for (size_t row = 0; row < rows; ++row)
+        pad_dense_row(out, in, fill_value, pitches, out_rect, in_rect, before, mode, row);
+      return;
+    }
+    for (size_t idx = 0; idx < volume; ++idx) {
+      auto p = pitches.unflatten(idx, out_rect.lo);
+      auto q = p;
+      out[p] = get_pad_point(q, before, in_rect, mode) ? in[q] : fill_value;
+    }
+  }
+};
+
+/*static*/ void PadTask::cpu_variant(TaskContext& context)
+{
+  pad_template<VariantKind::CPU>(context);
+}
+
+namespace  // unnamed
+{
+static void __attribute__((constructor)) register_tasks(void) { PadTask::register_variants(); }
+}  // namespace
+
+}  // namespace cunumeric
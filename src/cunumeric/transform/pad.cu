@@ -0,0 +1,76 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/transform/pad.h"
+#include "cunumeric/transform/pad_template.inl"
+
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <typename VAL, int DIM>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  pad_kernel(const size_t volume,
+             const AccessorWO<VAL, DIM> out,
+             const AccessorRO<VAL, DIM> in,
+             const AccessorRO<VAL, 1> value,
+             const FastPitches<DIM - 1> pitches,
+             const Point<DIM> out_lo,
+             const Rect<DIM> in_rect,
+             const Point<DIM> before,
+             const PadMode mode)
+{
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x;
+  for (size_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < volume; idx += stride) {
+    auto p = pitches.unflatten(idx, out_lo);
+    auto q = p;
+    out[p] = get_pad_point(q, before, in_rect, mode) ? in[q] : value[0];
+  }
+}
+
+template <typename VAL, int DIM>
+struct PadImplBody<VariantKind::GPU, VAL, DIM> {
+  void operator()(const AccessorWO<VAL, DIM>& out,
+                  const AccessorRO<VAL, DIM>& in,
+                  const AccessorRO<VAL, 1>& value,
+                  const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& out_rect,
+                  const Rect<DIM>& in_rect,
+                  const Point<DIM>& before,
+                  PadMode mode,
+                  size_t volume,
+                  bool dense) const
+  {
+    auto stream = get_cached_stream();
+
+    FastPitches<DIM - 1> fast_pitches;
+    fast_pitches.flatten(out_rect);
+    const size_t blocks = grid_stride_blocks<1>(volume);
+    pad_kernel<VAL, DIM><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+      volume, out, in, value, fast_pitches, out_rect.lo, in_rect, before, mode);
+  }
+};
+
+/*static*/ void PadTask::gpu_variant(TaskContext& context)
+{
+  pad_template<VariantKind::GPU>(context);
+}
+
+}  // namespace cunumeric
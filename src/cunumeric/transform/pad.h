@@ -0,0 +1,56 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#pragma once
+
+#include "cunumeric/cunumeric.h"
+
+namespace cunumeric {
+
+// Match these to PadMode in config.py
+enum class PadMode : int32_t {
+  CONSTANT  = 0,
+  EDGE      = 1,
+  REFLECT   = 2,
+  SYMMETRIC = 3,
+  WRAP      = 4,
+};
+
+struct PadArgs {
+  const Array& in;
+  const Array& out;
+  const Array& value;
+  // How many elements are padded before the input along each axis
+  legate::Span<const int64_t> before;
+  PadMode mode;
+};
+
+class PadTask : public CuNumericTask<PadTask> {
+ public:
+  static const int TASK_ID = CUNUMERIC_PAD;
+
+ public:
+  static void cpu_variant(legate::TaskContext& context);
+#ifdef LEGATE_USE_OPENMP
+  static void omp_variant(legate::TaskContext& context);
+#endif
+#ifdef LEGATE_USE_CUDA
+  static void gpu_variant(legate::TaskContext& context);
+#endif
+};
+
+}  // namespace cunumeric
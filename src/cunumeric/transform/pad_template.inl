@@ -0,0 +1,170 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/pitches.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+// Maps a coordinate, given relative to the start of the input along an axis
+// with the given extent, onto the input. Returns false when the coordinate is
+// outside the input and the mode fills it with the constant value instead.
+__CUDA_HD__ inline bool pad_source(coord_t& idx, coord_t extent, PadMode mode)
+{
+  if (idx >= 0 && idx < extent) return true;
+  switch (mode) {
+    case PadMode::CONSTANT: {
+      return false;
+    }
+    case PadMode::EDGE: {
+      idx = idx < 0 ? 0 : extent - 1;
+      return true;
+    }
+    case PadMode::REFLECT: {
+      if (extent == 1) {
+        idx = 0;
+        return true;
+      }
+      const coord_t period = 2 * (extent - 1);
+      idx                  = (idx % period + period) % period;
+      if (idx >= extent) idx = period - idx;
+      return true;
+    }
+    case PadMode::SYMMETRIC: {
+      const coord_t period = 2 * extent;
+      idx                  = (idx % period + period) % period;
+      if (idx >= extent) idx = period - 1 - idx;
+      return true;
+    }
+    case PadMode::WRAP: {
+      idx = (idx % extent + extent) % extent;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Maps an output point onto the input point it takes its value from
+template <int DIM>
+__CUDA_HD__ inline bool get_pad_point(Point<DIM>& point,
+                                      const Point<DIM>& before,
+                                      const Rect<DIM>& in_rect,
+                                      PadMode mode)
+{
+  for (int32_t dim = 0; dim < DIM; ++dim) {
+    coord_t idx = point[dim] - before[dim] - in_rect.lo[dim];
+    if (!pad_source(idx, in_rect.hi[dim] - in_rect.lo[dim] + 1, mode)) return false;
+    point[dim] = in_rect.lo[dim] + idx;
+  }
+  return true;
+}
+
+// Pads the row-th innermost row of dense stores. The part of the row that
+// lies inside the input is copied in one go and only the elements on either
+// side of it go through the boundary mapping.
+template <typename VAL, int DIM>
+inline void pad_dense_row(const AccessorWO<VAL, DIM>& out,
+                          const AccessorRO<VAL, DIM>& in,
+                          const VAL& value,
+                          const Pitches<DIM - 1>& pitches,
+                          const Rect<DIM>& out_rect,
+                          const Rect<DIM>& in_rect,
+                          const Point<DIM>& before,
+                          PadMode mode,
+                          size_t row)
+{
+  const coord_t length = out_rect.hi[DIM - 1] - out_rect.lo[DIM - 1] + 1;
+  const coord_t extent = in_rect.hi[DIM - 1] - in_rect.lo[DIM - 1] + 1;
+  const auto p         = pitches.unflatten(row * length, out_rect.lo);
+  auto outptr          = out.ptr(p);
+
+  // Find the input row through its first element, which is always inside
+  auto q     = p;
+  q[DIM - 1] = before[DIM - 1] + in_rect.lo[DIM - 1];
+  if (!get_pad_point(q, before, in_rect, mode)) {
+    std::fill(outptr, outptr + length, value);
+    return;
+  }
+  auto inptr = in.ptr(q);
+
+  const coord_t start = p[DIM - 1] - before[DIM - 1] - in_rect.lo[DIM - 1];
+  const coord_t lo    = std::min(std::max<coord_t>(-start, 0), length);
+  const coord_t hi    = std::max(std::min(extent - start, length), lo);
+  auto boundary = [&](coord_t k) {
+    coord_t idx = start + k;
+    outptr[k]   = pad_source(idx, extent, mode) ? inptr[idx] : value;
+  };
+  for (coord_t k = 0; k < lo; ++k) boundary(k);
+  std::copy(inptr + start + lo, inptr + start + hi, outptr + lo);
+  for (coord_t k = hi; k < length; ++k) boundary(k);
+}
+
+template <VariantKind KIND, typename VAL, int DIM>
+struct PadImplBody;
+
+template <VariantKind KIND>
+struct PadImpl {
+  template <LegateTypeCode CODE, int DIM>
+  void operator()(PadArgs& args) const
+  {
+    using VAL = legate_type_of<CODE>;
+
+    const auto out_rect = args.out.shape<DIM>();
+
+    Pitches<DIM - 1> pitches;
+    size_t volume = pitches.flatten(out_rect);
+
+    if (volume == 0) return;
+
+    const auto in_rect = args.in.shape<DIM>();
+
+    Point<DIM> before;
+    for (int32_t dim = 0; dim < DIM; ++dim) before[dim] = args.before[dim];
+
+    auto out   = args.out.write_accessor<VAL, DIM>(out_rect);
+    auto in    = args.in.read_accessor<VAL, DIM>(in_rect);
+    auto value = args.value.read_accessor<VAL, 1>();
+
+#ifndef LEGION_BOUNDS_CHECKS
+    bool dense =
+      out.accessor.is_dense_row_major(out_rect) && in.accessor.is_dense_row_major(in_rect);
+#else
+    bool dense = false;
+#endif
+
+    PadImplBody<KIND, VAL, DIM>()(
+      out, in, value, pitches, out_rect, in_rect, before, args.mode, volume, dense);
+  }
+};
+
+template <VariantKind KIND>
+static void pad_template(TaskContext& context)
+{
+  auto& inputs  = context.inputs();
+  auto& scalars = context.scalars();
+
+  PadArgs args{inputs[0],
+               context.outputs()[0],
+               inputs[1],
+               scalars[0].values<int64_t>(),
+               static_cast<PadMode>(scalars[1].value<int32_t>())};
+  cunumeric::double_dispatch(args.out.dim(), args.out.code(), PadImpl<KIND>{}, args);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,84 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/transform/reshape.h"
+#include "cunumeric/transform/reshape_template.inl"
+
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <typename VAL, int32_t OUT_DIM, int32_t IN_DIM>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  reshape_kernel(const AccessorWO<VAL, OUT_DIM> out,
+                 const AccessorRO<VAL, IN_DIM> in,
+                 const FastPitches<OUT_DIM - 1> out_pitches,
+                 const Rect<OUT_DIM> out_rect,
+                 const FastPitches<IN_DIM - 1> in_pitches,
+                 const Rect<IN_DIM> in_rect,
+                 const int64_t offset,
+                 const size_t volume)
+{
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x;
+  for (size_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < volume; idx += stride)
+    out[out_pitches.unflatten(idx, out_rect.lo)] =
+      in[in_pitches.unflatten(idx + offset, in_rect.lo)];
+}
+
+template <typename VAL, int32_t OUT_DIM, int32_t IN_DIM>
+struct ReshapeImplBody<VariantKind::GPU, VAL, OUT_DIM, IN_DIM> {
+  void operator()(const AccessorWO<VAL, OUT_DIM>& out,
+                  const AccessorRO<VAL, IN_DIM>& in,
+                  const Pitches<OUT_DIM - 1>& out_pitches,
+                  const Rect<OUT_DIM>& out_rect,
+                  const Pitches<IN_DIM - 1>& in_pitches,
+                  const Rect<IN_DIM>& in_rect,
+                  int64_t offset,
+                  size_t volume,
+                  bool dense) const
+  {
+    auto stream = get_cached_stream();
+
+    // Both stores hold the elements in the same order, so this is a single copy
+    if (dense) {
+      CHECK_CUDA(cudaMemcpyAsync(out.ptr(out_rect),
+                                 in.ptr(in_rect) + offset,
+                                 volume * sizeof(VAL),
+                                 cudaMemcpyDeviceToDevice,
+                                 stream));
+      return;
+    }
+
+    FastPitches<OUT_DIM - 1> fast_out_pitches;
+    fast_out_pitches.flatten(out_rect);
+    FastPitches<IN_DIM - 1> fast_in_pitches;
+    fast_in_pitches.flatten(in_rect);
+    const size_t blocks = grid_stride_blocks<1>(volume);
+    reshape_kernel<VAL, OUT_DIM, IN_DIM><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+      out, in, fast_out_pitches, out_rect, fast_in_pitches, in_rect, offset, volume);
+  }
+};
+
+/*static*/ void ReshapeTask::gpu_variant(TaskContext& context)
+{
+  reshape_template<VariantKind::GPU>(context);
+}
+
+}  // namespace cunumeric
@@ -0,0 +1,57 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/transform/reshape.h"
+#include "cunumeric/transform/reshape_template.inl"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <typename VAL, int32_t OUT_DIM, int32_t IN_DIM>
+struct ReshapeImplBody<VariantKind::OMP, VAL, OUT_DIM, IN_DIM> {
+  void operator()(const AccessorWO<VAL, OUT_DIM>& out,
+                  const AccessorRO<VAL, IN_DIM>& in,
+                  const Pitches<OUT_DIM - 1>& out_pitches,
+                  const Rect<OUT_DIM>& out_rect,
+                  const Pitches<IN_DIM - 1>& in_pitches,
+                  const Rect<IN_DIM>& in_rect,
+                  int64_t offset,
+                  size_t volume,
+                  bool dense) const
+  {
+    if (dense) {
+      auto outptr = out.ptr(out_rect);
+      auto inptr  = in.ptr(in_rect) + offset;
+#pragma omp parallel for schedule(static)
+      for (size_t idx = 0; idx < volume; ++idx) outptr[idx] = inptr[idx];
+    } else {
+#pragma omp parallel for schedule(static)
+      for (size_t idx = 0; idx < volume; ++idx)
+        out[out_pitches.unflatten(idx, out_rect.lo)] =
+          in[in_pitches.unflatten(idx + offset, in_rect.lo)];
+    }
+  }
+};
+
+/*static*/ void ReshapeTask::omp_variant(TaskContext& context)
+{
+  reshape_template<VariantKind::OMP>(context);
+}
+
+}  // namespace cunumeric
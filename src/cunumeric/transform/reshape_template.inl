@@ -0,0 +1,78 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/pitches.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+template <VariantKind KIND, typename VAL, int32_t OUT_DIM, int32_t IN_DIM>
+struct ReshapeImplBody;
+
+template <VariantKind KIND, typename VAL>
+struct ReshapeImpl {
+  template <int32_t OUT_DIM, int32_t IN_DIM>
+  void operator()(ReshapeArgs& args) const
+  {
+    const auto out_rect = args.out.shape<OUT_DIM>();
+    Pitches<OUT_DIM - 1> out_pitches;
+    auto volume = out_pitches.flatten(out_rect);
+
+    if (volume == 0) return;
+
+    const auto in_rect = args.in.shape<IN_DIM>();
+    Pitches<IN_DIM - 1> in_pitches;
+    in_pitches.flatten(in_rect);
+
+    auto out = args.out.write_accessor<VAL, OUT_DIM>(out_rect);
+    auto in  = args.in.read_accessor<VAL, IN_DIM>(in_rect);
+
+#ifndef LEGION_BOUNDS_CHECKS
+    // Check to see if this is dense or not
+    bool dense =
+      out.accessor.is_dense_row_major(out_rect) && in.accessor.is_dense_row_major(in_rect);
+#else
+    // No dense execution if we're doing bounds checks
+    bool dense = false;
+#endif
+
+    ReshapeImplBody<KIND, VAL, OUT_DIM, IN_DIM>{}(
+      out, in, out_pitches, out_rect, in_pitches, in_rect, args.offset, volume, dense);
+  }
+};
+
+template <VariantKind KIND>
+struct ReshapeDispatch {
+  template <LegateTypeCode CODE>
+  void operator()(ReshapeArgs& args) const
+  {
+    using VAL = legate_type_of<CODE>;
+    cunumeric::double_dispatch(args.out.dim(), args.in.dim(), ReshapeImpl<KIND, VAL>{}, args);
+  }
+};
+
+template <VariantKind KIND>
+static void reshape_template(TaskContext& context)
+{
+  ReshapeArgs args{
+    context.inputs()[0], context.outputs()[0], context.scalars()[0].value<int64_t>()};
+  cunumeric::type_dispatch(args.in.code(), ReshapeDispatch<KIND>{}, args);
+}
+
+}  // namespace cunumeric
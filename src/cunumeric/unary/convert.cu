@@ -23,23 +23,79 @@ namespace cunumeric {
 
 using namespace Legion;
 
-template <typename Function, typename ARG, typename RES>
+template <int VEC, typename Function, typename ARG, typename RES>
+__device__ __forceinline__ void convert_pack(Function func,
+                                             const VectorPack<ARG, VEC>& x,
+                                             VectorPack<RES, VEC>& y)
+{
+#pragma unroll
+  for (int k = 0; k < VEC; ++k) y[k] = func(x[k]);
+}
+
+// Pairs of halves are converted from and to floats with one packed instruction
+template <int VEC, typename Function>
+__device__ __forceinline__ void convert_pack(Function func,
+                                             const VectorPack<__half, VEC>& x,
+                                             VectorPack<float, VEC>& y)
+{
+  if constexpr (VEC % 2 == 0) {
+#pragma unroll
+    for (int k = 0; k < VEC; k += 2) {
+      const float2 pair = __half22float2(__halves2half2(x[k], x[k + 1]));
+      y[k]              = pair.x;
+      y[k + 1]          = pair.y;
+    }
+  } else {
+#pragma unroll
+    for (int k = 0; k < VEC; ++k) y[k] = func(x[k]);
+  }
+}
+
+template <int VEC, typename Function>
+__device__ __forceinline__ void convert_pack(Function func,
+                                             const VectorPack<float, VEC>& x,
+                                             VectorPack<__half, VEC>& y)
+{
+  if constexpr (VEC % 2 == 0) {
+#pragma unroll
+    for (int k = 0; k < VEC; k += 2) {
+      const __half2 pair = __float22half2_rn(make_float2(x[k], x[k + 1]));
+      y[k]               = __low2half(pair);
+      y[k + 1]           = __high2half(pair);
+    }
+  } else {
+#pragma unroll
+    for (int k = 0; k < VEC; ++k) y[k] = func(x[k]);
+  }
+}
+
+template <int VEC, typename Function, typename ARG, typename RES>
 static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
   dense_kernel(size_t volume, Function func, RES* out, const ARG* in)
 {
-  const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
-  if (idx >= volume) return;
-  out[idx] = func(in[idx]);
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x * VEC;
+  for (size_t offset = (blockIdx.x * blockDim.x + threadIdx.x) * VEC; offset < volume;
+       offset += stride) {
+    if (offset + VEC <= volume) {
+      const auto x = load_vector<VEC>(in + offset);
+      VectorPack<RES, VEC> y;
+      convert_pack<VEC>(func, x, y);
+      store_vector<VEC>(out + offset, y);
+    } else {
+      for (size_t idx = offset; idx < volume; ++idx) out[idx] = func(in[idx]);
+    }
+  }
 }
 
 template <typename Function, typename ReadAcc, typename WriteAcc, typename Pitches, typename Rect>
 static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
   generic_kernel(size_t volume, Function func, WriteAcc out, ReadAcc in, Pitches pitches, Rect rect)
 {
-  const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
-  if (idx >= volume) return;
-  auto point = pitches.unflatten(idx, rect.lo);
-  out[point] = func(in[point]);
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x;
+  for (size_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < volume; idx += stride) {
+    auto point = pitches.unflatten(idx, rect.lo);
+    out[point] = func(in[point]);
+  }
 }
 
 template <LegateTypeCode DST_TYPE, LegateTypeCode SRC_TYPE, int DIM>
@@ -55,14 +111,24 @@ struct ConvertImplBody<VariantKind::GPU, DST_TYPE, SRC_TYPE, DIM> {
                   const Rect<DIM>& rect,
                   bool dense) const
   {
+    auto stream = get_cached_stream();
+
     const size_t volume = rect.volume();
-    const size_t blocks = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+    const size_t blocks = grid_stride_blocks<1>(volume);
     if (dense) {
-      auto outptr = out.ptr(rect);
-      auto inptr  = in.ptr(rect);
-      dense_kernel<<<blocks, THREADS_PER_BLOCK>>>(volume, func, outptr, inptr);
+      auto outptr       = out.ptr(rect);
+      auto inptr        = in.ptr(rect);
+      constexpr int VEC = vector_width<DST, SRC>();
+      if (is_vector_aligned<VEC>(outptr, inptr))
+        dense_kernel<VEC><<<grid_stride_blocks<VEC>(volume), THREADS_PER_BLOCK, 0, stream>>>(
+          volume, func, outptr, inptr);
+      else
+        dense_kernel<1><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(volume, func, outptr, inptr);
     } else {
-      generic_kernel<<<blocks, THREADS_PER_BLOCK>>>(volume, func, out, in, pitches, rect);
+      FastPitches<DIM - 1> fast_pitches;
+      fast_pitches.flatten(rect);
+      generic_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+        volume, func, out, in, fast_pitches, rect);
     }
   }
 };
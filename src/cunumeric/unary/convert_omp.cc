@@ -39,8 +39,9 @@ struct ConvertImplBody<VariantKind::OMP, DST_TYPE, SRC_TYPE, DIM> {
     if (dense) {
       auto outptr = out.ptr(rect);
       auto inptr  = in.ptr(rect);
-#pragma omp parallel for schedule(static)
-      for (size_t idx = 0; idx < volume; ++idx) outptr[idx] = func(inptr[idx]);
+      simd::parallel_for_ranges(volume, [&](size_t lo, size_t hi) {
+        convert_dense(func, outptr + lo, inptr + lo, hi - lo);
+      });
     } else {
 #pragma omp parallel for schedule(static)
       for (size_t idx = 0; idx < volume; ++idx) {
@@ -69,7 +69,7 @@ struct SourceTypeDispatch {
   void operator()(ConvertArgs& args) const
   {
     auto dim = std::max(1, args.out.dim());
-    double_dispatch(dim, args.out.code(), ConvertImpl<KIND, SRC_TYPE>{}, args);
+    cunumeric::double_dispatch(dim, args.out.code(), ConvertImpl<KIND, SRC_TYPE>{}, args);
   }
 };
 
@@ -77,7 +77,7 @@ template <VariantKind KIND>
 static void convert_template(TaskContext& context)
 {
   ConvertArgs args{context.outputs()[0], context.inputs()[0]};
-  type_dispatch(args.in.code(), SourceTypeDispatch<KIND>{}, args);
+  cunumeric::type_dispatch(args.in.code(), SourceTypeDispatch<KIND>{}, args);
 }
 
 }  // namespace cunumeric
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "cunumeric/cunumeric.h"
+#include "cunumeric/simd.h"
 
 namespace cunumeric {
 
@@ -65,4 +66,49 @@ struct ConvertOp<DST_TYPE, legate::LegateTypeCode::HALF_LT> {
   }
 };
 
+// Converts n elements of dense arrays on the CPU. Conversions between halves and
+// floats or doubles go through the hardware half conversions where the processor
+// has them, and every other pair runs the operator in a loop that gets vectorized
+// for the widest instruction set available.
+template <legate::LegateTypeCode DST_TYPE, legate::LegateTypeCode SRC_TYPE>
+void convert_dense(const ConvertOp<DST_TYPE, SRC_TYPE>& func,
+                   legate::legate_type_of<DST_TYPE>* out,
+                   const legate::legate_type_of<SRC_TYPE>* in,
+                   size_t n)
+{
+  using namespace legate;
+  static_assert(sizeof(__half) == sizeof(uint16_t));
+  constexpr bool FROM_HALF =
+    SRC_TYPE == LegateTypeCode::HALF_LT &&
+    (DST_TYPE == LegateTypeCode::FLOAT_LT || DST_TYPE == LegateTypeCode::DOUBLE_LT);
+  constexpr bool TO_HALF =
+    DST_TYPE == LegateTypeCode::HALF_LT && SRC_TYPE == LegateTypeCode::FLOAT_LT;
+
+  if constexpr (FROM_HALF) {
+    if (simd::has_half_conversions()) {
+      auto bits = reinterpret_cast<const uint16_t*>(in);
+      if constexpr (DST_TYPE == LegateTypeCode::FLOAT_LT)
+        simd::half_to_float(out, bits, n);
+      else {
+        // Widen through a small buffer of floats, which is exact
+        constexpr size_t CHUNK = 256;
+        float buffer[CHUNK];
+        for (size_t lo = 0; lo < n; lo += CHUNK) {
+          const size_t count = std::min(CHUNK, n - lo);
+          simd::half_to_float(buffer, bits + lo, count);
+          CUNUMERIC_SIMD_LOOP
+          for (size_t idx = 0; idx < count; ++idx) out[lo + idx] = buffer[idx];
+        }
+      }
+      return;
+    }
+  } else if constexpr (TO_HALF) {
+    if (simd::has_half_conversions()) {
+      simd::float_to_half(reinterpret_cast<uint16_t*>(out), in, n);
+      return;
+    }
+  }
+  simd::for_each(n, [&](size_t idx) { out[idx] = func(in[idx]); });
+}
+
 }  // namespace cunumeric
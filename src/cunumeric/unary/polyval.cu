@@ -0,0 +1,82 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/unary/polyval.h"
+#include "cunumeric/unary/polyval_template.inl"
+
+#include "cunumeric/cuda_help.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+
+template <typename VAL>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  dense_kernel(size_t volume, const Polynomial<VAL> poly, VAL* out, const VAL* in)
+{
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x;
+  for (size_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < volume; idx += stride)
+    out[idx] = poly(in[idx]);
+}
+
+template <typename VAL, typename ReadAcc, typename WriteAcc, typename Pitches, typename Rect>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  generic_kernel(size_t volume,
+                 const Polynomial<VAL> poly,
+                 WriteAcc out,
+                 ReadAcc in,
+                 Pitches pitches,
+                 Rect rect)
+{
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x;
+  for (size_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < volume; idx += stride) {
+    auto point = pitches.unflatten(idx, rect.lo);
+    out[point] = poly(in[point]);
+  }
+}
+
+template <typename VAL, int DIM>
+struct PolyvalImplBody<VariantKind::GPU, VAL, DIM> {
+  void operator()(const Polynomial<VAL>& poly,
+                  AccessorWO<VAL, DIM> out,
+                  AccessorRO<VAL, DIM> in,
+                  const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& rect,
+                  bool dense) const
+  {
+    auto stream = get_cached_stream();
+
+    const size_t volume = rect.volume();
+    const size_t blocks = grid_stride_blocks<1>(volume);
+    if (dense) {
+      dense_kernel<VAL><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+        volume, poly, out.ptr(rect), in.ptr(rect));
+    } else {
+      FastPitches<DIM - 1> fast_pitches;
+      fast_pitches.flatten(rect);
+      generic_kernel<VAL><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+        volume, poly, out, in, fast_pitches, rect);
+    }
+  }
+};
+
+/*static*/ void PolyvalTask::gpu_variant(TaskContext& context)
+{
+  polyval_template<VariantKind::GPU>(context);
+}
+
+}  // namespace cunumeric
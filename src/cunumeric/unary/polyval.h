@@ -0,0 +1,50 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#pragma once
+
+#include "cunumeric/cunumeric.h"
+
+namespace cunumeric {
+
+// Match this to _POLYVAL_MAX_COEFFICIENTS in module.py
+constexpr int32_t MAX_POLYVAL_COEFFICIENTS = 32;
+
+struct PolyvalArgs {
+  const Array& in;
+  const Array& out;
+  // The coefficients from the one of the highest power down to the constant term
+  const legate::Scalar& coefficients;
+};
+
+// Evaluates a polynomial at every element in one pass, rather than with a multiply and
+// an add task for every coefficient
+class PolyvalTask : public CuNumericTask<PolyvalTask> {
+ public:
+  static const int TASK_ID = CUNUMERIC_POLYVAL;
+
+ public:
+  static void cpu_variant(legate::TaskContext& context);
+#ifdef LEGATE_USE_OPENMP
+  static void omp_variant(legate::TaskContext& context);
+#endif
+#ifdef LEGATE_USE_CUDA
+  static void gpu_variant(legate::TaskContext& context);
+#endif
+};
+
+}  // namespace cunumeric
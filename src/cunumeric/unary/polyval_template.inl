@@ -0,0 +1,94 @@
+/* Copyright 2021 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "cunumeric/pitches.h"
+
+namespace cunumeric {
+
+using namespace Legion;
+using namespace legate;
+
+// The coefficients travel with the functor, so kernels hold them in registers and
+// evaluate the polynomial with Horner's rule
+template <typename VAL>
+struct Polynomial {
+  Polynomial(legate::Span<const VAL> coefficients_)
+    : num_coefficients(static_cast<int32_t>(coefficients_.size()))
+  {
+    assert(0 < num_coefficients && num_coefficients <= MAX_POLYVAL_COEFFICIENTS);
+    for (int32_t k = 0; k < num_coefficients; k++) coefficients[k] = coefficients_[k];
+  }
+
+  __CUDA_HD__ inline VAL operator()(const VAL& x) const
+  {
+    VAL acc = coefficients[0];
+    for (int32_t k = 1; k < num_coefficients; k++) acc = acc * x + coefficients[k];
+    return acc;
+  }
+
+  int32_t num_coefficients;
+  VAL coefficients[MAX_POLYVAL_COEFFICIENTS];
+};
+
+template <VariantKind KIND, typename VAL, int DIM>
+struct PolyvalImplBody;
+
+template <VariantKind KIND>
+struct PolyvalImpl {
+  template <LegateTypeCode CODE,
+            int DIM,
+            std::enable_if_t<CODE != LegateTypeCode::BOOL_LT>* = nullptr>
+  void operator()(PolyvalArgs& args) const
+  {
+    using VAL = legate_type_of<CODE>;
+    auto rect = args.out.shape<DIM>();
+
+    Pitches<DIM - 1> pitches;
+    size_t volume = pitches.flatten(rect);
+
+    if (volume == 0) return;
+
+    auto out = args.out.write_accessor<VAL, DIM>(rect);
+    auto in  = args.in.read_accessor<VAL, DIM>(rect);
+
+#ifndef LEGION_BOUNDS_CHECKS
+    bool dense = out.accessor.is_dense_row_major(rect) && in.accessor.is_dense_row_major(rect);
+#else
+    bool dense = false;
+#endif
+
+    Polynomial<VAL> poly(args.coefficients.values<VAL>());
+    PolyvalImplBody<KIND, VAL, DIM>()(poly, out, in, pitches, rect, dense);
+  }
+
+  template <LegateTypeCode CODE,
+            int DIM,
+            std::enable_if_t<CODE == LegateTypeCode::BOOL_LT>* = nullptr>
+  void operator()(PolyvalArgs& args) const
+  {
+    assert(false);
+  }
+};
+
+template <VariantKind KIND>
+static void polyval_template(TaskContext& context)
+{
+  PolyvalArgs args{context.inputs()[0], context.outputs()[0], context.scalars()[0]};
+  cunumeric::double_dispatch(args.in.dim(), args.in.code(), PolyvalImpl<KIND>{}, args);
+}
+
+}  // namespace cunumeric
@@ -37,17 +37,68 @@ struct ScalarUnaryRedImplBody<VariantKind::CPU, OP_CODE, CODE, DIM> {
   {
     auto result         = LG_OP::identity;
     const size_t volume = rect.volume();
+    UnaryRedInput<OP_CODE> convert{};
     if (dense) {
       auto inptr = in.ptr(rect);
-      for (size_t idx = 0; idx < volume; ++idx) OP::template fold<true>(result, inptr[idx]);
+      for (size_t idx = 0; idx < volume; ++idx)
+        OP::template fold<true>(result, convert(inptr[idx]));
     } else {
       for (size_t idx = 0; idx < volume; ++idx) {
         auto p = pitches.unflatten(idx, rect.lo);
-        OP::template fold<true>(result, in[p]);
+        OP::template fold<true>(result, convert(in[p]));
       }
     }
     out.reduce(0, result);
   }
+
+  // The input is a reader of a fused expression or one widening a narrow input
+  template <typename READER>
+  void operator()(OP func,
+                  AccessorRD<LG_OP, true, 1> out,
+                  const READER& in,
+                  const Rect<DIM>& rect,
+                  const Pitches<DIM - 1>& pitches) const
+  {
+    auto result         = LG_OP::identity;
+    const size_t volume = rect.volume();
+    UnaryRedInput<OP_CODE> convert{};
+    for (size_t idx = 0; idx < volume; ++idx) {
+      auto p = pitches.unflatten(idx, rect.lo);
+      OP::template fold<true>(result, convert(in[p]));
+    }
+    out.reduce(0, result);
+  }
+};
+
+template <UnaryRedCode OP_CODE1, UnaryRedCode OP_CODE2, LegateTypeCode CODE, int DIM>
+struct ScalarMultiRedImplBody<VariantKind::CPU, OP_CODE1, OP_CODE2, CODE, DIM> {
+  using OP     = MultiRedOp<OP_CODE1, OP_CODE2, CODE>;
+  using LG_OP1 = typename OP::OP1::OP;
+  using LG_OP2 = typename OP::OP2::OP;
+  using VAL    = legate_type_of<CODE>;
+
+  void operator()(AccessorRD<LG_OP1, true, 1> out1,
+                  AccessorRD<LG_OP2, true, 1> out2,
+                  AccessorRO<VAL, DIM> in,
+                  const Rect<DIM>& rect,
+                  const Pitches<DIM - 1>& pitches,
+                  bool dense) const
+  {
+    auto result         = OP::identity();
+    const size_t volume = rect.volume();
+    if (dense) {
+      auto inptr = in.ptr(rect);
+      for (size_t idx = 0; idx < volume; ++idx)
+        OP::template fold<true>(result, OP::convert(inptr[idx]));
+    } else {
+      for (size_t idx = 0; idx < volume; ++idx) {
+        auto p = pitches.unflatten(idx, rect.lo);
+        OP::template fold<true>(result, OP::convert(in[p]));
+      }
+    }
+    out1.reduce(0, result.first);
+    out2.reduce(0, result.second);
+  }
 };
 
 namespace detail {
@@ -59,18 +110,22 @@ void logical_operator(bool& result,
                       const Pitches<DIM - 1>& pitches,
                       bool dense)
 {
+  // The first element that differs from the identity decides the result
+  const bool identity = result;
   const size_t volume = rect.volume();
   if (dense) {
     auto inptr = in.ptr(rect);
     for (size_t idx = 0; idx < volume; ++idx) {
       bool tmp1 = detail::convert_to_bool(inptr[idx]);
       OP::template fold<true>(result, tmp1);
+      if (result != identity) break;
     }
   } else {
     for (size_t idx = 0; idx < volume; ++idx) {
       auto p    = pitches.unflatten(idx, rect.lo);
       bool tmp1 = detail::convert_to_bool(in[p]);
       OP::template fold<true>(result, tmp1);
+      if (result != identity) break;
     }
   }
 }
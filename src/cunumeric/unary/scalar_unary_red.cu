@@ -17,82 +17,91 @@
 #include "cunumeric/unary/scalar_unary_red.h"
 #include "cunumeric/unary/scalar_unary_red_template.inl"
 
-#include "cunumeric/cuda_help.h"
+#include "cunumeric/device_scalar_reduction.h"
 
 namespace cunumeric {
 
 using namespace Legion;
 
-template <typename Op,
-          typename Output,
-          typename ReadAcc,
-          typename Pitches,
-          typename Point,
-          typename VAL>
-static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
-  reduction_kernel(size_t volume,
-                   Op op,
-                   Output out,
-                   ReadAcc in,
-                   Pitches pitches,
-                   Point origin,
-                   size_t iters,
-                   VAL identity)
-{
-  auto value = identity;
-  for (size_t idx = 0; idx < iters; idx++) {
-    const size_t offset = (idx * gridDim.x + blockIdx.x) * blockDim.x + threadIdx.x;
-    if (offset < volume) {
-      auto point = pitches.unflatten(offset, origin);
-      Op::template fold<true>(value, in[point]);
-    }
+// Reads the element at a linearized offset of the rect and prepares it for the reduction.
+// The input is an accessor, a reader of a fused expression or one widening a narrow input.
+template <typename IN, int DIM, typename Convert>
+struct ScalarRedLoader {
+  __device__ inline decltype(auto) operator()(size_t offset) const
+  {
+    return convert(in[pitches.unflatten(offset, origin)]);
   }
-  // Every thread in the thread block must participate in the exchange to get correct results
-  reduce_output(out, value);
-}
 
-template <typename Output, typename ReadAcc, typename Pitches, typename Point, typename VAL>
-static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM) contains_kernel(
-  size_t volume, Output out, ReadAcc in, Pitches pitches, Point origin, size_t iters, VAL to_find)
+  IN in;
+  Pitches<DIM - 1> pitches;
+  Point<DIM> origin;
+  Convert convert;
+};
+
+template <typename IN, int DIM, typename Convert>
+ScalarRedLoader<IN, DIM, Convert> make_loader(const IN& in,
+                                              const Pitches<DIM - 1>& pitches,
+                                              const Rect<DIM>& rect,
+                                              Convert convert)
 {
-  bool value = false;
-  for (size_t idx = 0; idx < iters; idx++) {
-    const size_t offset = (idx * gridDim.x + blockIdx.x) * blockDim.x + threadIdx.x;
-    if (offset < volume) {
-      auto point = pitches.unflatten(offset, origin);
-      SumReduction<bool>::fold<true>(value, in[point] == to_find);
-    }
-  }
-  // Every thread in the thread block must participate in the exchange to get correct results
-  reduce_output(out, value);
+  return ScalarRedLoader<IN, DIM, Convert>{in, pitches, rect.lo, convert};
 }
 
-template <typename Output, typename Pitches, typename Point, typename VAL, int32_t DIM>
-static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM) count_nonzero_kernel(
-  size_t volume, Output out, AccessorRO<VAL, DIM> in, Pitches pitches, Point origin, size_t iters)
-{
-  uint64_t value = 0;
-  for (size_t idx = 0; idx < iters; idx++) {
-    const size_t offset = (idx * gridDim.x + blockIdx.x) * blockDim.x + threadIdx.x;
-    if (offset < volume) {
-      auto point = pitches.unflatten(offset, origin);
-      SumReduction<uint64_t>::fold<true>(value, in[point] != VAL(0));
-    }
+template <UnaryRedCode OP_CODE, typename LHS>
+struct ConvertTo {
+  template <typename VAL>
+  __device__ inline LHS operator()(const VAL& value) const
+  {
+    return UnaryRedInput<OP_CODE>{}(value);
   }
-  // Every thread in the thread block must participate in the exchange to get correct results
-  reduce_output(out, value);
-}
+};
 
-template <typename Buffer, typename RedAcc>
-static __global__ void __launch_bounds__(1, 1) copy_kernel(Buffer result, RedAcc out)
-{
-  out.reduce(0, result.read());
-}
+template <typename VAL>
+struct ContainsValue {
+  __device__ inline bool operator()(const VAL& value) const { return value == to_find; }
+  VAL to_find;
+};
+
+template <typename VAL>
+struct IsNonzero {
+  __device__ inline uint64_t operator()(const VAL& value) const { return value != VAL(0); }
+};
+
+struct ToBool {
+  template <typename VAL>
+  __device__ inline bool operator()(const VAL& value) const
+  {
+    return detail::convert_to_bool(value);
+  }
+};
+
+template <typename OP>
+struct MultiRedConvert {
+  template <typename VAL>
+  __device__ inline typename OP::ACC operator()(const VAL& value) const
+  {
+    return OP::convert(value);
+  }
+};
+
+// Splits the accumulators of a multi-reduction into its two outputs
+template <typename OP, typename Output1, typename Output2>
+struct MultiRedOutput {
+  __device__ inline void reduce(coord_t point, const typename OP::ACC& value) const
+  {
+    out1.reduce(point, value.first);
+    out2.reduce(point, value.second);
+  }
+
+  Output1 out1;
+  Output2 out2;
+};
 
 template <UnaryRedCode OP_CODE, LegateTypeCode CODE, int DIM>
 struct ScalarUnaryRedImplBody<VariantKind::GPU, OP_CODE, CODE, DIM> {
   using OP    = UnaryRedOp<OP_CODE, CODE>;
   using LG_OP = typename OP::OP;
+  using LHS   = typename LG_OP::RHS;
   using VAL   = legate_type_of<CODE>;
 
   void operator()(OP func,
@@ -102,24 +111,50 @@ struct ScalarUnaryRedImplBody<VariantKind::GPU, OP_CODE, CODE, DIM> {
                   const Pitches<DIM - 1>& pitches,
                   bool dense) const
   {
-    cudaStream_t stream;
-    cudaStreamCreate(&stream);
-
-    const size_t volume = rect.volume();
-    const size_t blocks = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
-    DeferredReduction<typename OP::OP> result;
-    size_t shmem_size = THREADS_PER_BLOCK / 32 * sizeof(VAL);
-
-    if (blocks >= MAX_REDUCTION_CTAS) {
-      const size_t iters = (blocks + MAX_REDUCTION_CTAS - 1) / MAX_REDUCTION_CTAS;
-      reduction_kernel<<<MAX_REDUCTION_CTAS, THREADS_PER_BLOCK, shmem_size, stream>>>(
-        volume, typename OP::OP{}, result, in, pitches, rect.lo, iters, LG_OP::identity);
-    } else
-      reduction_kernel<<<blocks, THREADS_PER_BLOCK, shmem_size, stream>>>(
-        volume, typename OP::OP{}, result, in, pitches, rect.lo, 1, LG_OP::identity);
-
-    copy_kernel<<<1, 1, 0, stream>>>(result, out);
-    cudaStreamDestroy(stream);
+    device_scalar_reduction<LG_OP>(out,
+                                   rect.volume(),
+                                   make_loader(in, pitches, rect, ConvertTo<OP_CODE, LHS>{}),
+                                   LG_OP::identity,
+                                   get_cached_stream());
+  }
+
+  // The input is a reader of a fused expression or one widening a narrow input
+  template <typename READER>
+  void operator()(OP func,
+                  AccessorRD<LG_OP, true, 1> out,
+                  const READER& in,
+                  const Rect<DIM>& rect,
+                  const Pitches<DIM - 1>& pitches) const
+  {
+    device_scalar_reduction<LG_OP>(out,
+                                   rect.volume(),
+                                   make_loader(in, pitches, rect, ConvertTo<OP_CODE, LHS>{}),
+                                   LG_OP::identity,
+                                   get_cached_stream());
+  }
+};
+
+template <UnaryRedCode OP_CODE1, UnaryRedCode OP_CODE2, LegateTypeCode CODE, int DIM>
+struct ScalarMultiRedImplBody<VariantKind::GPU, OP_CODE1, OP_CODE2, CODE, DIM> {
+  using OP     = MultiRedOp<OP_CODE1, OP_CODE2, CODE>;
+  using LG_OP1 = typename OP::OP1::OP;
+  using LG_OP2 = typename OP::OP2::OP;
+  using VAL    = legate_type_of<CODE>;
+  using OUT1   = AccessorRD<LG_OP1, true, 1>;
+  using OUT2   = AccessorRD<LG_OP2, true, 1>;
+
+  void operator()(OUT1 out1,
+                  OUT2 out2,
+                  AccessorRO<VAL, DIM> in,
+                  const Rect<DIM>& rect,
+                  const Pitches<DIM - 1>& pitches,
+                  bool dense) const
+  {
+    device_scalar_reduction<OP>(MultiRedOutput<OP, OUT1, OUT2>{out1, out2},
+                                rect.volume(),
+                                make_loader(in, pitches, rect, MultiRedConvert<OP>{}),
+                                OP::identity(),
+                                get_cached_stream());
   }
 };
 
@@ -136,51 +171,20 @@ struct ScalarUnaryRedImplBody<VariantKind::GPU, UnaryRedCode::CONTAINS, CODE, DI
                   const Pitches<DIM - 1>& pitches,
                   bool dense) const
   {
-    cudaStream_t stream;
-    cudaStreamCreate(&stream);
-
-    const auto to_find  = to_find_scalar.scalar<VAL>();
-    const size_t volume = rect.volume();
-    const size_t blocks = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
-    DeferredReduction<SumReduction<bool>> result;
-    size_t shmem_size = THREADS_PER_BLOCK / 32 * sizeof(bool);
-
-    if (blocks >= MAX_REDUCTION_CTAS) {
-      const size_t iters = (blocks + MAX_REDUCTION_CTAS - 1) / MAX_REDUCTION_CTAS;
-      contains_kernel<<<MAX_REDUCTION_CTAS, THREADS_PER_BLOCK, shmem_size, stream>>>(
-        volume, result, in, pitches, rect.lo, iters, to_find);
-    } else
-      contains_kernel<<<blocks, THREADS_PER_BLOCK, shmem_size, stream>>>(
-        volume, result, in, pitches, rect.lo, 1, to_find);
-
-    copy_kernel<<<1, 1, 0, stream>>>(result, out);
-    cudaStreamDestroy(stream);
+    const auto to_find = to_find_scalar.scalar<VAL>();
+    device_short_circuit_reduction<SumReduction<bool>>(
+      out,
+      rect.volume(),
+      make_loader(in, pitches, rect, ContainsValue<VAL>{to_find}),
+      SumReduction<bool>::identity,
+      true,
+      get_cached_stream());
   }
 };
 
 namespace detail {
 
-template <typename Op,
-          typename Output,
-          typename ReadAcc,
-          typename Pitches,
-          typename Point,
-          typename VAL>
-static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM) logical_kernel(
-  size_t volume, Output out, ReadAcc in, Pitches pitches, Point origin, size_t iters, VAL identity)
-{
-  auto value = identity;
-  for (size_t idx = 0; idx < iters; idx++) {
-    const size_t offset = (idx * gridDim.x + blockIdx.x) * blockDim.x + threadIdx.x;
-    if (offset < volume) {
-      auto point = pitches.unflatten(offset, origin);
-      Op::template fold<true>(value, convert_to_bool(in[point]));
-    }
-  }
-  // Every thread in the thread block must participate in the exchange to get correct results
-  reduce_output(out, value);
-}
-
+// The first element that differs from the identity decides the result
 template <typename OP, typename LG_OP, typename VAL, int DIM>
 void logical_operator_gpu(AccessorRD<LG_OP, true, 1> out,
                           AccessorRO<VAL, DIM> in,
@@ -188,24 +192,12 @@ void logical_operator_gpu(AccessorRD<LG_OP, true, 1> out,
                           const Pitches<DIM - 1>& pitches,
                           bool dense)
 {
-  cudaStream_t stream;
-  cudaStreamCreate(&stream);
-
-  const size_t volume = rect.volume();
-  const size_t blocks = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
-  DeferredReduction<OP> result;
-  size_t shmem_size = THREADS_PER_BLOCK / 32 * sizeof(bool);
-
-  if (blocks >= MAX_REDUCTION_CTAS) {
-    const size_t iters = (blocks + MAX_REDUCTION_CTAS - 1) / MAX_REDUCTION_CTAS;
-    logical_kernel<OP><<<MAX_REDUCTION_CTAS, THREADS_PER_BLOCK, shmem_size, stream>>>(
-      volume, result, in, pitches, rect.lo, iters, LG_OP::identity);
-  } else
-    logical_kernel<OP><<<blocks, THREADS_PER_BLOCK, shmem_size, stream>>>(
-      volume, result, in, pitches, rect.lo, 1, LG_OP::identity);
-
-  copy_kernel<<<1, 1, 0, stream>>>(result, out);
-  cudaStreamDestroy(stream);
+  device_short_circuit_reduction<OP>(out,
+                                     rect.volume(),
+                                     make_loader(in, pitches, rect, ToBool{}),
+                                     LG_OP::identity,
+                                     !LG_OP::identity,
+                                     get_cached_stream());
 }
 
 }  // namespace detail
@@ -256,24 +248,12 @@ struct ScalarUnaryRedImplBody<VariantKind::GPU, UnaryRedCode::COUNT_NONZERO, COD
                   const Pitches<DIM - 1>& pitches,
                   bool dense) const
   {
-    cudaStream_t stream;
-    cudaStreamCreate(&stream);
-
-    const size_t volume = rect.volume();
-    const size_t blocks = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
-    DeferredReduction<SumReduction<uint64_t>> result;
-    size_t shmem_size = THREADS_PER_BLOCK / 32 * sizeof(uint64_t);
-
-    if (blocks >= MAX_REDUCTION_CTAS) {
-      const size_t iters = (blocks + MAX_REDUCTION_CTAS - 1) / MAX_REDUCTION_CTAS;
-      count_nonzero_kernel<<<MAX_REDUCTION_CTAS, THREADS_PER_BLOCK, shmem_size, stream>>>(
-        volume, result, in, pitches, rect.lo, iters);
-    } else
-      count_nonzero_kernel<<<blocks, THREADS_PER_BLOCK, shmem_size, stream>>>(
-        volume, result, in, pitches, rect.lo, 1);
-
-    copy_kernel<<<1, 1, 0, stream>>>(result, out);
-    cudaStreamDestroy(stream);
+    device_scalar_reduction<SumReduction<uint64_t>>(
+      out,
+      rect.volume(),
+      make_loader(in, pitches, rect, IsNonzero<VAL>{}),
+      SumReduction<uint64_t>::identity,
+      get_cached_stream());
   }
 };
 
@@ -21,11 +21,24 @@
 
 namespace cunumeric {
 
+struct FusedExpr;
+
 struct ScalarUnaryRedArgs {
   const Array& out;
   const Array& in;
   UnaryRedCode op_code;
   std::vector<legate::Store> args;
+  // An element-wise expression of the inputs folded in place of in, if any
+  const FusedExpr* expr{nullptr};
+};
+
+// Two reductions folded in one sweep, each producing its own scalar
+struct ScalarMultiRedArgs {
+  const Array& out1;
+  const Array& out2;
+  const Array& in;
+  UnaryRedCode op_code1;
+  UnaryRedCode op_code2;
 };
 
 // Unary reduction task that produces scalar results
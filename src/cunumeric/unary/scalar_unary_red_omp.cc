@@ -40,15 +40,18 @@ struct ScalarUnaryRedImplBody<VariantKind::OMP, OP_CODE, CODE, DIM> {
     auto result            = LG_OP::identity;
     const size_t volume    = rect.volume();
     const auto max_threads = omp_get_max_threads();
-    auto locals            = static_cast<VAL*>(alloca(max_threads * sizeof(VAL)));
+    using ACC              = typename LG_OP::RHS;
+    auto locals            = static_cast<ACC*>(alloca(max_threads * sizeof(ACC)));
     for (auto idx = 0; idx < max_threads; ++idx) locals[idx] = LG_OP::identity;
+    UnaryRedInput<OP_CODE> convert{};
     if (dense) {
       auto inptr = in.ptr(rect);
 #pragma omp parallel
       {
         const int tid = omp_get_thread_num();
 #pragma omp for schedule(static)
-        for (size_t idx = 0; idx < volume; ++idx) OP::template fold<true>(locals[tid], inptr[idx]);
+        for (size_t idx = 0; idx < volume; ++idx)
+          OP::template fold<true>(locals[tid], convert(inptr[idx]));
       }
     } else {
 #pragma omp parallel
@@ -57,34 +60,61 @@ struct ScalarUnaryRedImplBody<VariantKind::OMP, OP_CODE, CODE, DIM> {
 #pragma omp for schedule(static)
         for (size_t idx = 0; idx < volume; ++idx) {
           auto p = pitches.unflatten(idx, rect.lo);
-          OP::template fold<true>(locals[tid], in[p]);
+          OP::template fold<true>(locals[tid], convert(in[p]));
         }
       }
     }
 
     for (auto idx = 0; idx < max_threads; ++idx) out.reduce(0, locals[idx]);
   }
+
+  // The input is a reader of a fused expression or one widening a narrow input
+  template <typename READER>
+  void operator()(OP func,
+                  AccessorRD<LG_OP, true, 1> out,
+                  const READER& in,
+                  const Rect<DIM>& rect,
+                  const Pitches<DIM - 1>& pitches) const
+  {
+    const size_t volume    = rect.volume();
+    const auto max_threads = omp_get_max_threads();
+    using ACC              = typename LG_OP::RHS;
+    auto locals            = static_cast<ACC*>(alloca(max_threads * sizeof(ACC)));
+    for (auto idx = 0; idx < max_threads; ++idx) locals[idx] = LG_OP::identity;
+    UnaryRedInput<OP_CODE> convert{};
+#pragma omp parallel
+    {
+      const int tid = omp_get_thread_num();
+#pragma omp for schedule(static)
+      for (size_t idx = 0; idx < volume; ++idx) {
+        auto p = pitches.unflatten(idx, rect.lo);
+        OP::template fold<true>(locals[tid], convert(in[p]));
+      }
+    }
+
+    for (auto idx = 0; idx < max_threads; ++idx) out.reduce(0, locals[idx]);
+  }
 };
 
-template <LegateTypeCode CODE, int DIM>
-struct ScalarUnaryRedImplBody<VariantKind::OMP, UnaryRedCode::CONTAINS, CODE, DIM> {
-  using OP    = UnaryRedOp<UnaryRedCode::SUM, LegateTypeCode::BOOL_LT>;
-  using LG_OP = typename OP::OP;
-  using VAL   = legate_type_of<CODE>;
+template <UnaryRedCode OP_CODE1, UnaryRedCode OP_CODE2, LegateTypeCode CODE, int DIM>
+struct ScalarMultiRedImplBody<VariantKind::OMP, OP_CODE1, OP_CODE2, CODE, DIM> {
+  using OP     = MultiRedOp<OP_CODE1, OP_CODE2, CODE>;
+  using LG_OP1 = typename OP::OP1::OP;
+  using LG_OP2 = typename OP::OP2::OP;
+  using VAL    = legate_type_of<CODE>;
+  using ACC    = typename OP::ACC;
 
-  void operator()(AccessorRD<LG_OP, true, 1> out,
+  void operator()(AccessorRD<LG_OP1, true, 1> out1,
+                  AccessorRD<LG_OP2, true, 1> out2,
                   AccessorRO<VAL, DIM> in,
-                  const Store& to_find_scalar,
                   const Rect<DIM>& rect,
                   const Pitches<DIM - 1>& pitches,
                   bool dense) const
   {
-    auto result            = LG_OP::identity;
-    const auto to_find     = to_find_scalar.scalar<VAL>();
     const size_t volume    = rect.volume();
     const auto max_threads = omp_get_max_threads();
-    auto locals            = static_cast<bool*>(alloca(max_threads * sizeof(VAL)));
-    for (auto idx = 0; idx < max_threads; ++idx) locals[idx] = false;
+    auto locals            = static_cast<ACC*>(alloca(max_threads * sizeof(ACC)));
+    for (auto idx = 0; idx < max_threads; ++idx) locals[idx] = OP::identity();
     if (dense) {
       auto inptr = in.ptr(rect);
 #pragma omp parallel
@@ -92,7 +122,7 @@ struct ScalarUnaryRedImplBody<VariantKind::OMP, UnaryRedCode::CONTAINS, CODE, DI
         const int tid = omp_get_thread_num();
 #pragma omp for schedule(static)
         for (size_t idx = 0; idx < volume; ++idx)
-          if (inptr[idx] == to_find) locals[tid] = true;
+          OP::template fold<true>(locals[tid], OP::convert(inptr[idx]));
       }
     } else {
 #pragma omp parallel
@@ -100,55 +130,105 @@ struct ScalarUnaryRedImplBody<VariantKind::OMP, UnaryRedCode::CONTAINS, CODE, DI
         const int tid = omp_get_thread_num();
 #pragma omp for schedule(static)
         for (size_t idx = 0; idx < volume; ++idx) {
-          auto point = pitches.unflatten(idx, rect.lo);
-          if (in[point] == to_find) locals[tid] = true;
+          auto p = pitches.unflatten(idx, rect.lo);
+          OP::template fold<true>(locals[tid], OP::convert(in[p]));
         }
       }
     }
 
-    for (auto idx = 0; idx < max_threads; ++idx) out.reduce(0, locals[idx]);
+    for (auto idx = 0; idx < max_threads; ++idx) {
+      out1.reduce(0, locals[idx].first);
+      out2.reduce(0, locals[idx].second);
+    }
   }
 };
 
 namespace detail {
 
-template <typename OP, typename LG_OP, typename VAL, int DIM>
+// Elements each thread scans between two checks of whether another thread found a hit
+static constexpr size_t SHORT_CIRCUIT_CHUNK = 1 << 14;
+
+// Returns whether hit(idx) holds for any idx in [0, volume). Threads claim chunks of the
+// range dynamically and stop claiming them once any thread has found a hit, so an early
+// hit ends the scan almost immediately.
+template <typename Hit>
+bool find_any_omp(size_t volume, Hit hit)
+{
+  const size_t num_chunks = (volume + SHORT_CIRCUIT_CHUNK - 1) / SHORT_CIRCUIT_CHUNK;
+  bool found              = false;
+#pragma omp parallel for schedule(dynamic, 1)
+  for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
+    bool done;
+#pragma omp atomic read
+    done = found;
+    if (done) continue;
+    const size_t lo = chunk * SHORT_CIRCUIT_CHUNK;
+    const size_t hi = std::min(volume, lo + SHORT_CIRCUIT_CHUNK);
+    for (size_t idx = lo; idx < hi; ++idx)
+      if (hit(idx)) {
+#pragma omp atomic write
+        found = true;
+        break;
+      }
+  }
+  return found;
+}
+
+// The first element that differs from the identity decides the result
+template <typename LG_OP, typename VAL, int DIM>
 void logical_operator_omp(AccessorRO<VAL, DIM> in,
                           AccessorRD<LG_OP, true, 1> out,
                           const Rect<DIM>& rect,
                           const Pitches<DIM - 1>& pitches,
                           bool dense)
 {
-  const size_t volume    = rect.volume();
-  const auto max_threads = omp_get_max_threads();
-  auto locals            = static_cast<bool*>(alloca(max_threads * sizeof(bool)));
-  for (auto idx = 0; idx < max_threads; ++idx) locals[idx] = LG_OP::identity;
+  const bool absorbing = !LG_OP::identity;
+  const size_t volume  = rect.volume();
+  bool found;
   if (dense) {
     auto inptr = in.ptr(rect);
-#pragma omp parallel
-    {
-      const int tid = omp_get_thread_num();
-#pragma omp for schedule(static)
-      for (size_t idx = 0; idx < volume; ++idx)
-        OP::template fold<true>(locals[tid], convert_to_bool(inptr[idx]));
-    }
+    found      = find_any_omp(
+      volume, [&](size_t idx) { return convert_to_bool(inptr[idx]) == absorbing; });
   } else {
-#pragma omp parallel
-    {
-      const int tid = omp_get_thread_num();
-#pragma omp for schedule(static)
-      for (size_t idx = 0; idx < volume; ++idx) {
-        auto p = pitches.unflatten(idx, rect.lo);
-        OP::template fold<true>(locals[tid], convert_to_bool(in[p]));
-      }
-    }
+    found = find_any_omp(volume, [&](size_t idx) {
+      auto p = pitches.unflatten(idx, rect.lo);
+      return convert_to_bool(in[p]) == absorbing;
+    });
   }
-
-  for (auto idx = 0; idx < max_threads; ++idx) out.reduce(0, locals[idx]);
+  out.reduce(0, found ? absorbing : LG_OP::identity);
 }
 
 }  // namespace detail
 
+template <LegateTypeCode CODE, int DIM>
+struct ScalarUnaryRedImplBody<VariantKind::OMP, UnaryRedCode::CONTAINS, CODE, DIM> {
+  using OP    = UnaryRedOp<UnaryRedCode::SUM, LegateTypeCode::BOOL_LT>;
+  using LG_OP = typename OP::OP;
+  using VAL   = legate_type_of<CODE>;
+
+  void operator()(AccessorRD<LG_OP, true, 1> out,
+                  AccessorRO<VAL, DIM> in,
+                  const Store& to_find_scalar,
+                  const Rect<DIM>& rect,
+                  const Pitches<DIM - 1>& pitches,
+                  bool dense) const
+  {
+    const auto to_find  = to_find_scalar.scalar<VAL>();
+    const size_t volume = rect.volume();
+    bool found;
+    if (dense) {
+      auto inptr = in.ptr(rect);
+      found = detail::find_any_omp(volume, [&](size_t idx) { return inptr[idx] == to_find; });
+    } else {
+      found = detail::find_any_omp(volume, [&](size_t idx) {
+        auto point = pitches.unflatten(idx, rect.lo);
+        return in[point] == to_find;
+      });
+    }
+    out.reduce(0, found);
+  }
+};
+
 template <LegateTypeCode CODE, int DIM>
 struct ScalarUnaryRedImplBody<VariantKind::OMP, UnaryRedCode::ALL, CODE, DIM> {
   using OP    = UnaryRedOp<UnaryRedCode::PROD, LegateTypeCode::BOOL_LT>;
@@ -162,7 +242,7 @@ struct ScalarUnaryRedImplBody<VariantKind::OMP, UnaryRedCode::ALL, CODE, DIM> {
                   bool dense) const
 
   {
-    detail::logical_operator_omp<OP, LG_OP>(in, out, rect, pitches, dense);
+    detail::logical_operator_omp<LG_OP>(in, out, rect, pitches, dense);
   }
 };
 
@@ -179,7 +259,7 @@ struct ScalarUnaryRedImplBody<VariantKind::OMP, UnaryRedCode::ANY, CODE, DIM> {
                   bool dense) const
 
   {
-    detail::logical_operator_omp<OP, LG_OP>(in, out, rect, pitches, dense);
+    detail::logical_operator_omp<LG_OP>(in, out, rect, pitches, dense);
   }
 };
 
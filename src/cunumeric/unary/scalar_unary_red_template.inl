@@ -15,7 +15,10 @@
  */
 
 #include "cunumeric/unary/unary_red_util.h"
+#include "cunumeric/annotate.h"
+#include "cunumeric/fused/fused_op_util.h"
 #include "cunumeric/pitches.h"
+#include "cunumeric/roofline.h"
 
 namespace cunumeric {
 
@@ -25,6 +28,13 @@ using namespace legate;
 template <VariantKind KIND, UnaryRedCode OP_CODE, LegateTypeCode CODE, int DIM>
 struct ScalarUnaryRedImplBody;
 
+template <VariantKind KIND,
+          UnaryRedCode OP_CODE1,
+          UnaryRedCode OP_CODE2,
+          LegateTypeCode CODE,
+          int DIM>
+struct ScalarMultiRedImplBody;
+
 template <VariantKind KIND, UnaryRedCode OP_CODE>
 struct ScalarUnaryRedImpl {
   template <LegateTypeCode CODE,
@@ -41,8 +51,27 @@ struct ScalarUnaryRedImpl {
     Pitches<DIM - 1> pitches;
     size_t volume = pitches.flatten(rect);
 
+    CUNUMERIC_ROOFLINE_SAMPLE("scalar_unary_red", OP_CODE, KIND, volume * sizeof(VAL), volume);
+
     auto out = args.out.reduce_accessor<LG_OP, true, 1>();
-    auto in  = args.in.read_accessor<VAL, DIM>(rect);
+
+    if (args.expr != nullptr) {
+      FusedReader<CODE, DIM> in(*args.expr, rect);
+      ScalarUnaryRedImplBody<KIND, OP_CODE, CODE, DIM>()(OP{}, out, in, rect, pitches);
+      return;
+    }
+
+    if (args.in.code() != CODE) {
+      if constexpr (unary_red_widens(OP_CODE))
+        with_widening_reader<CODE>(args.in, rect, [&](const auto& in) {
+          ScalarUnaryRedImplBody<KIND, OP_CODE, CODE, DIM>()(OP{}, out, in, rect, pitches);
+        });
+      else
+        assert(false);
+      return;
+    }
+
+    auto in = args.in.read_accessor<VAL, DIM>(rect);
 
 #ifndef LEGION_BOUNDS_CHECKS
     // Check to see if this is dense or not
@@ -187,7 +216,10 @@ struct ScalarUnaryRedDispatch {
   template <UnaryRedCode OP_CODE, std::enable_if_t<!is_arg_reduce<OP_CODE>::value>* = nullptr>
   void operator()(ScalarUnaryRedArgs& args) const
   {
-    double_dispatch(args.in.dim(), args.in.code(), ScalarUnaryRedImpl<KIND, OP_CODE>{}, args);
+    auto code = unary_red_code(OP_CODE, args.in.code(), args.out.code());
+    AnnotatedRange range(
+      "scalar_unary_red", OP_CODE, code, args.in.dim(), args.in.domain().get_volume());
+    cunumeric::double_dispatch(args.in.dim(), code, ScalarUnaryRedImpl<KIND, OP_CODE>{}, args);
   }
   template <UnaryRedCode OP_CODE, std::enable_if_t<is_arg_reduce<OP_CODE>::value>* = nullptr>
   void operator()(ScalarUnaryRedArgs& args) const
@@ -196,22 +228,95 @@ struct ScalarUnaryRedDispatch {
   }
 };
 
+template <VariantKind KIND, UnaryRedCode OP_CODE1, UnaryRedCode OP_CODE2>
+struct ScalarMultiRedImpl {
+  template <LegateTypeCode CODE,
+            int DIM,
+            std::enable_if_t<MultiRedOp<OP_CODE1, OP_CODE2, CODE>::valid>* = nullptr>
+  void operator()(ScalarMultiRedArgs& args) const
+  {
+    using OP     = MultiRedOp<OP_CODE1, OP_CODE2, CODE>;
+    using LG_OP1 = typename OP::OP1::OP;
+    using LG_OP2 = typename OP::OP2::OP;
+    using VAL    = legate_type_of<CODE>;
+
+    auto rect = args.in.shape<DIM>();
+
+    Pitches<DIM - 1> pitches;
+    size_t volume = pitches.flatten(rect);
+
+    auto out1 = args.out1.reduce_accessor<LG_OP1, true, 1>();
+    auto out2 = args.out2.reduce_accessor<LG_OP2, true, 1>();
+    auto in   = args.in.read_accessor<VAL, DIM>(rect);
+
+#ifndef LEGION_BOUNDS_CHECKS
+    // Check to see if this is dense or not
+    bool dense = in.accessor.is_dense_row_major(rect);
+#else
+    // No dense execution if we're doing bounds checks
+    bool dense = false;
+#endif
+
+    ScalarMultiRedImplBody<KIND, OP_CODE1, OP_CODE2, CODE, DIM>()(
+      out1, out2, in, rect, pitches, dense);
+  }
+
+  template <LegateTypeCode CODE,
+            int DIM,
+            std::enable_if_t<!MultiRedOp<OP_CODE1, OP_CODE2, CODE>::valid>* = nullptr>
+  void operator()(ScalarMultiRedArgs& args) const
+  {
+    assert(false);
+  }
+};
+
+template <VariantKind KIND>
+struct ScalarMultiRedDispatch {
+  template <UnaryRedCode OP_CODE1, UnaryRedCode OP_CODE2>
+  void operator()(ScalarMultiRedArgs& args) const
+  {
+    cunumeric::double_dispatch(
+      args.in.dim(), args.in.code(), ScalarMultiRedImpl<KIND, OP_CODE1, OP_CODE2>{}, args);
+  }
+};
+
 template <VariantKind KIND>
 static void scalar_unary_red_template(TaskContext& context)
 {
   auto& inputs  = context.inputs();
   auto& scalars = context.scalars();
 
+  // Multiple reduction outputs request the multi-reduction mode,
+  // in which case the first scalar holds one op code per output
+  auto& reductions = context.reductions();
+  if (reductions.size() > 1) {
+    auto op_codes = scalars[0].values<int32_t>();
+    ScalarMultiRedArgs args{reductions[0],
+                            reductions[1],
+                            inputs[0],
+                            static_cast<UnaryRedCode>(op_codes[0]),
+                            static_cast<UnaryRedCode>(op_codes[1])};
+    multi_op_dispatch(args.op_code1, args.op_code2, ScalarMultiRedDispatch<KIND>{}, args);
+    return;
+  }
+
+  // A program in the remaining scalars is an element-wise expression of all the inputs that
+  // gets folded in place of a single input
+  if (scalars.size() > 1) {
+    FusedExpr expr{
+      inputs, scalars[1].values<int32_t>(), scalars[2].values<int32_t>(), scalars[3]};
+    ScalarUnaryRedArgs args{
+      context.reductions()[0], inputs[0], scalars[0].value<UnaryRedCode>(), {}, &expr};
+    op_dispatch(args.op_code, ScalarUnaryRedDispatch<KIND>{}, args);
+    return;
+  }
+
   std::vector<Store> extra_args;
   for (size_t idx = 1; idx < inputs.size(); ++idx) extra_args.push_back(std::move(inputs[idx]));
 
   ScalarUnaryRedArgs args{
     context.reductions()[0], inputs[0], scalars[0].value<UnaryRedCode>(), std::move(extra_args)};
-  if (args.op_code == UnaryRedCode::COUNT_NONZERO)
-    double_dispatch(
-      args.in.dim(), args.in.code(), ScalarUnaryRedImpl<KIND, UnaryRedCode::COUNT_NONZERO>{}, args);
-  else
-    op_dispatch(args.op_code, ScalarUnaryRedDispatch<KIND>{}, args);
+  op_dispatch(args.op_code, ScalarUnaryRedDispatch<KIND>{}, args);
 }
 
 }  // namespace cunumeric
@@ -17,6 +17,8 @@
 #include "cunumeric/unary/unary_op.h"
 #include "cunumeric/unary/unary_op_template.inl"
 
+#include "cunumeric/simd.h"
+
 namespace cunumeric {
 
 using namespace Legion;
@@ -39,7 +41,9 @@ struct UnaryOpImplBody<VariantKind::CPU, OP_CODE, CODE, DIM> {
     if (dense) {
       auto outptr = out.ptr(rect);
       auto inptr  = in.ptr(rect);
-      for (size_t idx = 0; idx < volume; ++idx) outptr[idx] = func(inptr[idx]);
+      with_fast_math(func, [&](auto op) {
+        simd::for_each(volume, [=](size_t idx) { outptr[idx] = op(inptr[idx]); });
+      });
     } else {
       for (size_t idx = 0; idx < volume; ++idx) {
         auto p = pitches.unflatten(idx, rect.lo);
@@ -47,6 +51,29 @@ struct UnaryOpImplBody<VariantKind::CPU, OP_CODE, CODE, DIM> {
       }
     }
   }
+
+  void operator()(OP func,
+                  AccessorRW<RES, DIM> out,
+                  AccessorRO<bool, DIM> mask,
+                  AccessorRO<ARG, DIM> in,
+                  const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& rect,
+                  bool dense) const
+  {
+    const size_t volume = rect.volume();
+    if (dense) {
+      auto outptr  = out.ptr(rect);
+      auto maskptr = mask.ptr(rect);
+      auto inptr   = in.ptr(rect);
+      for (size_t idx = 0; idx < volume; ++idx)
+        if (maskptr[idx]) outptr[idx] = func(inptr[idx]);
+    } else {
+      for (size_t idx = 0; idx < volume; ++idx) {
+        auto p = pitches.unflatten(idx, rect.lo);
+        if (mask[p]) out[p] = func(in[p]);
+      }
+    }
+  }
 };
 
 /*static*/ void UnaryOpTask::cpu_variant(TaskContext& context)
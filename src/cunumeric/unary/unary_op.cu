@@ -23,23 +23,66 @@ namespace cunumeric {
 
 using namespace Legion;
 
-template <typename Function, typename ARG, typename RES>
+template <int VEC, typename Function, typename ARG, typename RES>
 static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
   dense_kernel(size_t volume, Function func, RES* out, const ARG* in)
 {
-  const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
-  if (idx >= volume) return;
-  out[idx] = func(in[idx]);
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x * VEC;
+  for (size_t offset = (blockIdx.x * blockDim.x + threadIdx.x) * VEC; offset < volume;
+       offset += stride) {
+    if (offset + VEC <= volume) {
+      const auto x = load_vector<VEC>(in + offset);
+      VectorPack<RES, VEC> y;
+#pragma unroll
+      for (int k = 0; k < VEC; ++k) y[k] = func(x[k]);
+      store_vector<VEC>(out + offset, y);
+    } else {
+      for (size_t idx = offset; idx < volume; ++idx) out[idx] = func(in[idx]);
+    }
+  }
 }
 
 template <typename Function, typename ReadAcc, typename WriteAcc, typename Pitches, typename Rect>
 static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
   generic_kernel(size_t volume, Function func, WriteAcc out, ReadAcc in, Pitches pitches, Rect rect)
 {
-  const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
-  if (idx >= volume) return;
-  auto point = pitches.unflatten(idx, rect.lo);
-  out[point] = func(in[point]);
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x;
+  for (size_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < volume; idx += stride) {
+    auto point = pitches.unflatten(idx, rect.lo);
+    out[point] = func(in[point]);
+  }
+}
+
+template <typename Function, typename ARG, typename RES>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  dense_masked_kernel(size_t volume, Function func, RES* out, const bool* mask, const ARG* in)
+{
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x;
+  for (size_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < volume; idx += stride) {
+    if (mask[idx]) out[idx] = func(in[idx]);
+  }
+}
+
+template <typename Function,
+          typename ReadAcc,
+          typename MaskAcc,
+          typename ReadWriteAcc,
+          typename Pitches,
+          typename Rect>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  generic_masked_kernel(size_t volume,
+                        Function func,
+                        ReadWriteAcc out,
+                        MaskAcc mask,
+                        ReadAcc in,
+                        Pitches pitches,
+                        Rect rect)
+{
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x;
+  for (size_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < volume; idx += stride) {
+    auto point = pitches.unflatten(idx, rect.lo);
+    if (mask[point]) out[point] = func(in[point]);
+  }
 }
 
 template <UnaryOpCode OP_CODE, LegateTypeCode CODE, int DIM>
@@ -55,14 +98,50 @@ struct UnaryOpImplBody<VariantKind::GPU, OP_CODE, CODE, DIM> {
                   const Rect<DIM>& rect,
                   bool dense) const
   {
+    auto stream = get_cached_stream();
+
+    const size_t volume = rect.volume();
+    const size_t blocks = grid_stride_blocks<1>(volume);
+    if (dense) {
+      auto outptr       = out.ptr(rect);
+      auto inptr        = in.ptr(rect);
+      constexpr int VEC = vector_width<RES, ARG>();
+      if (is_vector_aligned<VEC>(outptr, inptr))
+        dense_kernel<VEC><<<grid_stride_blocks<VEC>(volume), THREADS_PER_BLOCK, 0, stream>>>(
+          volume, func, outptr, inptr);
+      else
+        dense_kernel<1><<<blocks, THREADS_PER_BLOCK, 0, stream>>>(volume, func, outptr, inptr);
+    } else {
+      FastPitches<DIM - 1> fast_pitches;
+      fast_pitches.flatten(rect);
+      generic_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+        volume, func, out, in, fast_pitches, rect);
+    }
+  }
+
+  void operator()(OP func,
+                  AccessorRW<RES, DIM> out,
+                  AccessorRO<bool, DIM> mask,
+                  AccessorRO<ARG, DIM> in,
+                  const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& rect,
+                  bool dense) const
+  {
+    auto stream = get_cached_stream();
+
     const size_t volume = rect.volume();
-    const size_t blocks = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+    const size_t blocks = grid_stride_blocks<1>(volume);
     if (dense) {
-      auto outptr = out.ptr(rect);
-      auto inptr  = in.ptr(rect);
-      dense_kernel<<<blocks, THREADS_PER_BLOCK>>>(volume, func, outptr, inptr);
+      auto outptr  = out.ptr(rect);
+      auto maskptr = mask.ptr(rect);
+      auto inptr   = in.ptr(rect);
+      dense_masked_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+        volume, func, outptr, maskptr, inptr);
     } else {
-      generic_kernel<<<blocks, THREADS_PER_BLOCK>>>(volume, func, out, in, pitches, rect);
+      FastPitches<DIM - 1> fast_pitches;
+      fast_pitches.flatten(rect);
+      generic_masked_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+        volume, func, out, mask, in, fast_pitches, rect);
     }
   }
 };
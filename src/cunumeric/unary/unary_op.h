@@ -25,6 +25,9 @@ struct UnaryOpArgs {
   const Array& in;
   const Array& out;
   UnaryOpCode op_code;
+  // When set, only the elements where the mask is true are written and the rest of out
+  // keeps its values
+  const Array* mask;
   std::vector<legate::Store> args;
 };
 
@@ -17,6 +17,9 @@
 #include "cunumeric/unary/unary_op.h"
 #include "cunumeric/unary/unary_op_template.inl"
 
+#include "cunumeric/huge_pages.h"
+#include "cunumeric/simd.h"
+
 namespace cunumeric {
 
 using namespace Legion;
@@ -39,8 +42,10 @@ struct UnaryOpImplBody<VariantKind::OMP, OP_CODE, CODE, DIM> {
     if (dense) {
       auto outptr = out.ptr(rect);
       auto inptr  = in.ptr(rect);
-#pragma omp parallel for schedule(static)
-      for (size_t idx = 0; idx < volume; ++idx) outptr[idx] = func(inptr[idx]);
+      advise_huge_pages(outptr, volume * sizeof(RES));
+      with_fast_math(func, [&](auto op) {
+        simd::parallel_for_each(volume, [=](size_t idx) { outptr[idx] = op(inptr[idx]); });
+      });
     } else {
 #pragma omp parallel for schedule(static)
       for (size_t idx = 0; idx < volume; ++idx) {
@@ -49,6 +54,31 @@ struct UnaryOpImplBody<VariantKind::OMP, OP_CODE, CODE, DIM> {
       }
     }
   }
+
+  void operator()(OP func,
+                  AccessorRW<RES, DIM> out,
+                  AccessorRO<bool, DIM> mask,
+                  AccessorRO<ARG, DIM> in,
+                  const Pitches<DIM - 1>& pitches,
+                  const Rect<DIM>& rect,
+                  bool dense) const
+  {
+    const size_t volume = rect.volume();
+    if (dense) {
+      auto outptr  = out.ptr(rect);
+      auto maskptr = mask.ptr(rect);
+      auto inptr   = in.ptr(rect);
+#pragma omp parallel for schedule(static)
+      for (size_t idx = 0; idx < volume; ++idx)
+        if (maskptr[idx]) outptr[idx] = func(inptr[idx]);
+    } else {
+#pragma omp parallel for schedule(static)
+      for (size_t idx = 0; idx < volume; ++idx) {
+        auto p = pitches.unflatten(idx, rect.lo);
+        if (mask[p]) out[p] = func(in[p]);
+      }
+    }
+  }
 };
 
 /*static*/ void UnaryOpTask::omp_variant(TaskContext& context)
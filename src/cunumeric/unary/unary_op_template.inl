@@ -14,7 +14,9 @@
  *
  */
 
+#include "cunumeric/annotate.h"
 #include "cunumeric/pitches.h"
+#include "cunumeric/roofline.h"
 
 namespace cunumeric {
 
@@ -42,6 +44,29 @@ struct UnaryOpImpl {
 
     if (volume == 0) return;
 
+    CUNUMERIC_ROOFLINE_SAMPLE(
+      "unary_op", OP_CODE, KIND, volume * (sizeof(ARG) + sizeof(RES)), volume);
+
+    OP func{args.args};
+    if (args.mask != nullptr) {
+      // Elements where the mask is not set are neither computed nor written
+      auto out  = args.out.read_write_accessor<RES, DIM>(rect);
+      auto mask = args.mask->read_accessor<bool, DIM>(rect);
+      auto in   = args.in.read_accessor<ARG, DIM>(rect);
+
+#ifndef LEGION_BOUNDS_CHECKS
+      // Check to see if this is dense or not
+      bool dense = out.accessor.is_dense_row_major(rect) &&
+                   mask.accessor.is_dense_row_major(rect) && in.accessor.is_dense_row_major(rect);
+#else
+      // No dense execution if we're doing bounds checks
+      bool dense = false;
+#endif
+
+      UnaryOpImplBody<KIND, OP_CODE, CODE, DIM>()(func, out, mask, in, pitches, rect, dense);
+      return;
+    }
+
     auto out = args.out.write_accessor<RES, DIM>(rect);
     auto in  = args.in.read_accessor<ARG, DIM>(rect);
 
@@ -53,7 +78,6 @@ struct UnaryOpImpl {
     bool dense = false;
 #endif
 
-    OP func{args.args};
     UnaryOpImplBody<KIND, OP_CODE, CODE, DIM>()(func, out, in, pitches, rect, dense);
   }
 
@@ -72,7 +96,8 @@ struct UnaryOpDispatch {
   void operator()(UnaryOpArgs& args) const
   {
     auto dim = std::max(args.in.dim(), 1);
-    double_dispatch(dim, args.in.code(), UnaryOpImpl<KIND, OP_CODE>{}, args);
+    AnnotatedRange range("unary_op", OP_CODE, args.in.code(), dim, args.out.domain().get_volume());
+    cunumeric::double_dispatch(dim, args.in.code(), UnaryOpImpl<KIND, OP_CODE>{}, args);
   }
 };
 
@@ -83,10 +108,19 @@ static void unary_op_template(TaskContext& context)
   auto& outputs = context.outputs();
   auto& scalars = context.scalars();
 
+  // The mask follows the operand, and then the output itself unless the op is in place,
+  // both of which are read by the task as well
+  auto masked        = scalars[1].value<bool>();
+  auto inplace       = scalars[2].value<bool>();
+  const Array* mask  = masked ? &inputs[1] : nullptr;
+  size_t first_extra = masked ? (inplace ? 2 : 3) : 1;
+
   std::vector<Store> extra_args;
-  for (size_t idx = 1; idx < inputs.size(); ++idx) extra_args.push_back(std::move(inputs[idx]));
+  for (size_t idx = first_extra; idx < inputs.size(); ++idx)
+    extra_args.push_back(std::move(inputs[idx]));
 
-  UnaryOpArgs args{inputs[0], outputs[0], scalars[0].value<UnaryOpCode>(), std::move(extra_args)};
+  UnaryOpArgs args{
+    inputs[0], outputs[0], scalars[0].value<UnaryOpCode>(), mask, std::move(extra_args)};
   op_dispatch(args.op_code, UnaryOpDispatch<KIND>{}, args);
 }
 
@@ -18,6 +18,7 @@
 
 #include "cunumeric/cunumeric.h"
 #include "cunumeric/arg.h"
+#include "cunumeric/fast_math.h"
 
 #include <math.h>
 #include <complex>
@@ -53,7 +54,17 @@ enum class UnaryOpCode : int {
   CONJ,
   REAL,
   IMAG,
-  GETARG
+  GETARG,
+  GETVAR,
+  GETSUM,
+  GETNORM,
+  ERF,
+  EXPM1,
+  LOG1P,
+  SIGMOID,
+  SOFTPLUS,
+  GETLSE,
+  ABS2,
 };
 
 template <typename Functor, typename... Fnargs>
@@ -116,6 +127,26 @@ constexpr decltype(auto) op_dispatch(UnaryOpCode op_code, Functor f, Fnargs&&...
       return f.template operator()<UnaryOpCode::IMAG>(std::forward<Fnargs>(args)...);
     case UnaryOpCode::GETARG:
       return f.template operator()<UnaryOpCode::GETARG>(std::forward<Fnargs>(args)...);
+    case UnaryOpCode::GETVAR:
+      return f.template operator()<UnaryOpCode::GETVAR>(std::forward<Fnargs>(args)...);
+    case UnaryOpCode::GETSUM:
+      return f.template operator()<UnaryOpCode::GETSUM>(std::forward<Fnargs>(args)...);
+    case UnaryOpCode::GETNORM:
+      return f.template operator()<UnaryOpCode::GETNORM>(std::forward<Fnargs>(args)...);
+    case UnaryOpCode::ERF:
+      return f.template operator()<UnaryOpCode::ERF>(std::forward<Fnargs>(args)...);
+    case UnaryOpCode::EXPM1:
+      return f.template operator()<UnaryOpCode::EXPM1>(std::forward<Fnargs>(args)...);
+    case UnaryOpCode::LOG1P:
+      return f.template operator()<UnaryOpCode::LOG1P>(std::forward<Fnargs>(args)...);
+    case UnaryOpCode::SIGMOID:
+      return f.template operator()<UnaryOpCode::SIGMOID>(std::forward<Fnargs>(args)...);
+    case UnaryOpCode::SOFTPLUS:
+      return f.template operator()<UnaryOpCode::SOFTPLUS>(std::forward<Fnargs>(args)...);
+    case UnaryOpCode::GETLSE:
+      return f.template operator()<UnaryOpCode::GETLSE>(std::forward<Fnargs>(args)...);
+    case UnaryOpCode::ABS2:
+      return f.template operator()<UnaryOpCode::ABS2>(std::forward<Fnargs>(args)...);
   }
   assert(false);
   return f.template operator()<UnaryOpCode::ABSOLUTE>(std::forward<Fnargs>(args)...);
@@ -246,30 +277,48 @@ struct UnaryOp<UnaryOpCode::COPY, CODE> {
 
 template <legate::LegateTypeCode CODE>
 struct UnaryOp<UnaryOpCode::COS, CODE> {
-  static constexpr bool valid = true;
-  using T                     = legate::legate_type_of<CODE>;
+  static constexpr bool valid     = true;
+  using T                         = legate::legate_type_of<CODE>;
+  static constexpr bool FAST_MATH = std::is_same<T, float>::value;
 
-  UnaryOp(const std::vector<legate::Store>& args) {}
+  struct FastOp {
+    __CUDA_HD__ float operator()(const float& x) const { return fast_math::cos(x); }
+  };
+
+  UnaryOp(const std::vector<legate::Store>& args) : fast(FAST_MATH && use_fast_math(args)) {}
 
   constexpr decltype(auto) operator()(const T& x) const
   {
+    if constexpr (FAST_MATH)
+      if (fast) return FastOp{}(x);
     using std::cos;
     return cos(x);
   }
+
+  bool fast;
 };
 
 template <legate::LegateTypeCode CODE>
 struct UnaryOp<UnaryOpCode::EXP, CODE> {
-  static constexpr bool valid = true;
-  using T                     = legate::legate_type_of<CODE>;
+  static constexpr bool valid     = true;
+  using T                         = legate::legate_type_of<CODE>;
+  static constexpr bool FAST_MATH = std::is_same<T, float>::value;
 
-  UnaryOp(const std::vector<legate::Store>& args) {}
+  struct FastOp {
+    __CUDA_HD__ float operator()(const float& x) const { return fast_math::exp(x); }
+  };
+
+  UnaryOp(const std::vector<legate::Store>& args) : fast(FAST_MATH && use_fast_math(args)) {}
 
   constexpr decltype(auto) operator()(const T& x) const
   {
+    if constexpr (FAST_MATH)
+      if (fast) return FastOp{}(x);
     using std::exp;
     return exp(x);
   }
+
+  bool fast;
 };
 
 template <legate::LegateTypeCode CODE>
@@ -410,16 +459,25 @@ struct UnaryOp<UnaryOpCode::ISNAN, legate::LegateTypeCode::HALF_LT> {
 
 template <legate::LegateTypeCode CODE>
 struct UnaryOp<UnaryOpCode::LOG, CODE> {
-  static constexpr bool valid = true;
-  using T                     = legate::legate_type_of<CODE>;
+  static constexpr bool valid     = true;
+  using T                         = legate::legate_type_of<CODE>;
+  static constexpr bool FAST_MATH = std::is_same<T, float>::value;
 
-  UnaryOp(const std::vector<legate::Store>& args) {}
+  struct FastOp {
+    __CUDA_HD__ float operator()(const float& x) const { return fast_math::log(x); }
+  };
+
+  UnaryOp(const std::vector<legate::Store>& args) : fast(FAST_MATH && use_fast_math(args)) {}
 
   constexpr decltype(auto) operator()(const T& x) const
   {
+    if constexpr (FAST_MATH)
+      if (fast) return FastOp{}(x);
     using std::log;
     return log(x);
   }
+
+  bool fast;
 };
 
 template <legate::LegateTypeCode CODE>
@@ -572,16 +630,25 @@ struct UnaryOp<UnaryOpCode::SIGN, legate::LegateTypeCode::HALF_LT> {
 
 template <legate::LegateTypeCode CODE>
 struct UnaryOp<UnaryOpCode::SIN, CODE> {
-  static constexpr bool valid = true;
-  using T                     = legate::legate_type_of<CODE>;
+  static constexpr bool valid     = true;
+  using T                         = legate::legate_type_of<CODE>;
+  static constexpr bool FAST_MATH = std::is_same<T, float>::value;
 
-  UnaryOp(const std::vector<legate::Store>& args) {}
+  struct FastOp {
+    __CUDA_HD__ float operator()(const float& x) const { return fast_math::sin(x); }
+  };
+
+  UnaryOp(const std::vector<legate::Store>& args) : fast(FAST_MATH && use_fast_math(args)) {}
 
   constexpr decltype(auto) operator()(const T& x) const
   {
+    if constexpr (FAST_MATH)
+      if (fast) return FastOp{}(x);
     using std::sin;
     return sin(x);
   }
+
+  bool fast;
 };
 
 template <legate::LegateTypeCode CODE>
@@ -614,16 +681,25 @@ struct UnaryOp<UnaryOpCode::TAN, CODE> {
 
 template <legate::LegateTypeCode CODE>
 struct UnaryOp<UnaryOpCode::TANH, CODE> {
-  static constexpr bool valid = true;
-  using T                     = legate::legate_type_of<CODE>;
+  static constexpr bool valid     = true;
+  using T                         = legate::legate_type_of<CODE>;
+  static constexpr bool FAST_MATH = std::is_same<T, float>::value;
 
-  UnaryOp(const std::vector<legate::Store>& args) {}
+  struct FastOp {
+    __CUDA_HD__ float operator()(const float& x) const { return fast_math::tanh(x); }
+  };
+
+  UnaryOp(const std::vector<legate::Store>& args) : fast(FAST_MATH && use_fast_math(args)) {}
 
   constexpr decltype(auto) operator()(const T& x) const
   {
+    if constexpr (FAST_MATH)
+      if (fast) return FastOp{}(x);
     using std::tanh;
     return tanh(x);
   }
+
+  bool fast;
 };
 
 template <legate::LegateTypeCode CODE>
@@ -666,4 +742,199 @@ struct UnaryOp<UnaryOpCode::GETARG, CODE> {
   constexpr decltype(auto) operator()(const T& x) const { return x.arg; }
 };
 
+// Finalizes a Welford accumulator into the variance with ddof delta degrees of freedom
+template <legate::LegateTypeCode CODE>
+struct UnaryOp<UnaryOpCode::GETVAR, CODE> {
+  using VAL                   = legate::legate_type_of<CODE>;
+  using T                     = Welford<VAL>;
+  static constexpr bool valid = CODE == legate::LegateTypeCode::FLOAT_LT ||
+                                CODE == legate::LegateTypeCode::DOUBLE_LT;
+
+  UnaryOp(const std::vector<legate::Store>& args)
+  {
+    assert(args.size() == 1);
+    ddof = args[0].scalar<int64_t>();
+  }
+
+  constexpr VAL operator()(const T& x) const
+  {
+    // Like NumPy, divide by zero when ddof leaves no degrees of freedom
+    const int64_t dof = x.count > ddof ? x.count - ddof : 0;
+    return x.m2 / static_cast<VAL>(dof);
+  }
+
+  int64_t ddof;
+};
+
+template <legate::LegateTypeCode CODE>
+struct UnaryOp<UnaryOpCode::GETSUM, CODE> {
+  using VAL                   = legate::legate_type_of<CODE>;
+  using T                     = BinnedSum<VAL>;
+  static constexpr bool valid = CODE == legate::LegateTypeCode::FLOAT_LT ||
+                                CODE == legate::LegateTypeCode::DOUBLE_LT;
+
+  UnaryOp(const std::vector<legate::Store>& args) {}
+
+  constexpr VAL operator()(const T& x) const { return x.value(); }
+};
+
+// Finalizes a scaled sum of squares into the 2-norm, which is zero for an empty one
+template <legate::LegateTypeCode CODE>
+struct UnaryOp<UnaryOpCode::GETNORM, CODE> {
+  using VAL                   = legate::legate_type_of<CODE>;
+  using T                     = ScaledSquares<VAL>;
+  static constexpr bool valid = CODE == legate::LegateTypeCode::FLOAT_LT ||
+                                CODE == legate::LegateTypeCode::DOUBLE_LT;
+
+  UnaryOp(const std::vector<legate::Store>& args) {}
+
+  constexpr VAL operator()(const T& x) const
+  {
+    using std::sqrt;
+    return x.scale * sqrt(x.ssq);
+  }
+};
+
+// The real functions below evaluate half precision in single precision, as there are no
+// native versions of them, and everything else that is not floating point in double
+template <typename T>
+using RealCompute = std::conditional_t<
+  std::is_same<T, __half>::value,
+  float,
+  std::conditional_t<std::is_floating_point<T>::value, T, double>>;
+
+template <typename T>
+using RealResult = std::conditional_t<std::is_same<T, __half>::value, __half, RealCompute<T>>;
+
+template <legate::LegateTypeCode CODE>
+struct UnaryOp<UnaryOpCode::ERF, CODE> {
+  using T                     = legate::legate_type_of<CODE>;
+  static constexpr bool valid = !legate::is_complex<T>::value;
+
+  UnaryOp(const std::vector<legate::Store>& args) {}
+
+  constexpr RealResult<T> operator()(const T& x) const
+  {
+    using std::erf;
+    return static_cast<RealResult<T>>(erf(static_cast<RealCompute<T>>(x)));
+  }
+};
+
+template <legate::LegateTypeCode CODE>
+struct UnaryOp<UnaryOpCode::EXPM1, CODE> {
+  using T                     = legate::legate_type_of<CODE>;
+  static constexpr bool valid = !legate::is_complex<T>::value;
+
+  UnaryOp(const std::vector<legate::Store>& args) {}
+
+  constexpr RealResult<T> operator()(const T& x) const
+  {
+    using std::expm1;
+    return static_cast<RealResult<T>>(expm1(static_cast<RealCompute<T>>(x)));
+  }
+};
+
+template <legate::LegateTypeCode CODE>
+struct UnaryOp<UnaryOpCode::LOG1P, CODE> {
+  using T                     = legate::legate_type_of<CODE>;
+  static constexpr bool valid = !legate::is_complex<T>::value;
+
+  UnaryOp(const std::vector<legate::Store>& args) {}
+
+  constexpr RealResult<T> operator()(const T& x) const
+  {
+    using std::log1p;
+    return static_cast<RealResult<T>>(log1p(static_cast<RealCompute<T>>(x)));
+  }
+};
+
+// 1 / (1 + exp(-x)), which saturates to 0 and 1 without overflowing into a NaN
+template <legate::LegateTypeCode CODE>
+struct UnaryOp<UnaryOpCode::SIGMOID, CODE> {
+  using T                         = legate::legate_type_of<CODE>;
+  static constexpr bool valid     = !legate::is_complex<T>::value;
+  static constexpr bool FAST_MATH = std::is_same<T, float>::value;
+
+  struct FastOp {
+    __CUDA_HD__ float operator()(const float& x) const
+    {
+      return 1.f / (1.f + fast_math::exp(-x));
+    }
+  };
+
+  UnaryOp(const std::vector<legate::Store>& args) : fast(FAST_MATH && use_fast_math(args)) {}
+
+  constexpr RealResult<T> operator()(const T& x) const
+  {
+    if constexpr (FAST_MATH)
+      if (fast) return FastOp{}(x);
+    using C = RealCompute<T>;
+    using std::exp;
+    return static_cast<RealResult<T>>(C{1} / (C{1} + exp(-static_cast<C>(x))));
+  }
+
+  bool fast;
+};
+
+// log(1 + exp(x)) as max(x, 0) + log1p(exp(-|x|)), which neither overflows for large x
+// nor loses the small values for very negative ones
+template <legate::LegateTypeCode CODE>
+struct UnaryOp<UnaryOpCode::SOFTPLUS, CODE> {
+  using T                     = legate::legate_type_of<CODE>;
+  static constexpr bool valid = !legate::is_complex<T>::value;
+
+  UnaryOp(const std::vector<legate::Store>& args) {}
+
+  constexpr RealResult<T> operator()(const T& x) const
+  {
+    using C      = RealCompute<T>;
+    const C y    = static_cast<C>(x);
+    const C zero = 0;
+    using std::exp;
+    using std::fabs;
+    using std::log1p;
+    return static_cast<RealResult<T>>((y > zero ? y : zero) + log1p(exp(-fabs(y))));
+  }
+};
+
+// Finalizes a LogSumExp accumulator into the log of the sum of exponentials, which is
+// -inf for an empty one
+template <legate::LegateTypeCode CODE>
+struct UnaryOp<UnaryOpCode::GETLSE, CODE> {
+  using VAL                   = legate::legate_type_of<CODE>;
+  using T                     = LogSumExp<VAL>;
+  static constexpr bool valid = CODE == legate::LegateTypeCode::FLOAT_LT ||
+                                CODE == legate::LegateTypeCode::DOUBLE_LT;
+
+  UnaryOp(const std::vector<legate::Store>& args) {}
+
+  constexpr VAL operator()(const T& x) const
+  {
+    using std::log;
+    return x.max + log(x.sum);
+  }
+};
+
+// The squared magnitude, which for complex values needs neither the square root nor the
+// scaling against overflow of the absolute value
+template <legate::LegateTypeCode CODE>
+struct UnaryOp<UnaryOpCode::ABS2, CODE> {
+  using T                     = legate::legate_type_of<CODE>;
+  static constexpr bool valid = CODE != legate::LegateTypeCode::BOOL_LT;
+
+  UnaryOp(const std::vector<legate::Store>& args) {}
+
+  template <typename _T = T, std::enable_if_t<legate::is_complex<_T>::value>* = nullptr>
+  constexpr decltype(auto) operator()(const _T& x) const
+  {
+    return x.real() * x.real() + x.imag() * x.imag();
+  }
+
+  template <typename _T = T, std::enable_if_t<!legate::is_complex<_T>::value>* = nullptr>
+  constexpr _T operator()(const _T& x) const
+  {
+    return x * x;
+  }
+};
+
 }  // namespace cunumeric
@@ -27,17 +27,21 @@ struct UnaryRedImplBody<VariantKind::CPU, OP_CODE, CODE, DIM> {
   using OP    = UnaryRedOp<OP_CODE, CODE>;
   using LG_OP = typename OP::OP;
   using VAL   = legate_type_of<CODE>;
+  using INPUT = UnaryRedInput<OP_CODE>;
 
+  // The input is an accessor, a reader of a fused expression or one widening a narrow input
+  template <typename RHS>
   void operator()(AccessorRD<LG_OP, true, DIM> lhs,
-                  AccessorRO<VAL, DIM> rhs,
+                  const RHS& rhs,
                   const Rect<DIM>& rect,
                   const Pitches<DIM - 1>& pitches,
                   int collapsed_dim,
+                  uint32_t collapsed_mask,
                   size_t volume) const
   {
     for (size_t idx = 0; idx < volume; ++idx) {
       auto point = pitches.unflatten(idx, rect.lo);
-      lhs.reduce(point, rhs[point]);
+      lhs.reduce(point, INPUT{}(rhs[point]));
     }
   }
 
@@ -46,11 +50,12 @@ struct UnaryRedImplBody<VariantKind::CPU, OP_CODE, CODE, DIM> {
                   const Rect<DIM>& rect,
                   const Pitches<DIM - 1>& pitches,
                   int collapsed_dim,
+                  uint32_t collapsed_mask,
                   size_t volume) const
   {
     for (size_t idx = 0; idx < volume; ++idx) {
       auto point = pitches.unflatten(idx, rect.lo);
-      OP::template fold<true>(lhs[point], rhs[point]);
+      OP::template fold<true>(lhs[point], INPUT{}(rhs[point]));
     }
   }
 };
@@ -61,17 +66,19 @@ struct ArgRedImplBody<VariantKind::CPU, OP_CODE, CODE, DIM> {
   using LG_OP = typename OP::OP;
   using RHS   = legate_type_of<CODE>;
   using LHS   = Argval<RHS>;
+  using INPUT = UnaryRedInput<OP_CODE>;
 
   void operator()(AccessorRD<LG_OP, true, DIM> lhs,
                   AccessorRO<RHS, DIM> rhs,
                   const Rect<DIM>& rect,
                   const Pitches<DIM - 1>& pitches,
                   int collapsed_dim,
+                  uint32_t collapsed_mask,
                   size_t volume) const
   {
     for (size_t idx = 0; idx < volume; ++idx) {
       auto point = pitches.unflatten(idx, rect.lo);
-      lhs.reduce(point, LHS(point[collapsed_dim], rhs[point]));
+      lhs.reduce(point, LHS(point[collapsed_dim], INPUT{}(rhs[point])));
     }
   }
 
@@ -80,11 +87,37 @@ struct ArgRedImplBody<VariantKind::CPU, OP_CODE, CODE, DIM> {
                   const Rect<DIM>& rect,
                   const Pitches<DIM - 1>& pitches,
                   int collapsed_dim,
+                  uint32_t collapsed_mask,
+                  size_t volume) const
+  {
+    for (size_t idx = 0; idx < volume; ++idx) {
+      auto point = pitches.unflatten(idx, rect.lo);
+      OP::template fold<true>(lhs[point], LHS(point[collapsed_dim], INPUT{}(rhs[point])));
+    }
+  }
+};
+
+template <UnaryRedCode OP_CODE1, UnaryRedCode OP_CODE2, LegateTypeCode CODE, int DIM>
+struct UnaryMultiRedImplBody<VariantKind::CPU, OP_CODE1, OP_CODE2, CODE, DIM> {
+  using OP     = MultiRedOp<OP_CODE1, OP_CODE2, CODE>;
+  using LG_OP1 = typename OP::OP1::OP;
+  using LG_OP2 = typename OP::OP2::OP;
+  using VAL    = legate_type_of<CODE>;
+
+  void operator()(AccessorRD<LG_OP1, true, DIM> lhs1,
+                  AccessorRD<LG_OP2, true, DIM> lhs2,
+                  AccessorRO<VAL, DIM> rhs,
+                  const Rect<DIM>& rect,
+                  const Pitches<DIM - 1>& pitches,
+                  int collapsed_dim,
+                  uint32_t collapsed_mask,
                   size_t volume) const
   {
     for (size_t idx = 0; idx < volume; ++idx) {
       auto point = pitches.unflatten(idx, rect.lo);
-      OP::template fold<true>(lhs[point], LHS(point[collapsed_dim], rhs[point]));
+      auto value = OP::convert(rhs[point]);
+      lhs1.reduce(point, value.first);
+      lhs2.reduce(point, value.second);
     }
   }
 };
@@ -19,6 +19,10 @@
 
 #include "cunumeric/cuda_help.h"
 
+#include <cub/device/device_segmented_reduce.cuh>
+#include <cub/iterator/counting_input_iterator.cuh>
+#include <cub/iterator/transform_input_iterator.cuh>
+
 namespace cunumeric {
 
 using namespace Legion;
@@ -106,9 +110,12 @@ struct ThreadBlock {
 // volume exceeds the maximum number of CTAs.
 template <int32_t DIM>
 struct ThreadBlocks {
-  void initialize(const Rect<DIM>& domain, int32_t collapsed_dim)
+  // Threads walk along collapsed_dim, while the other dimensions in collapsed_mask are
+  // laid out like those being kept and their partial results meet in the output
+  void initialize(const Rect<DIM>& domain, int32_t collapsed_dim, uint32_t collapsed_mask)
   {
-    collapsed_dim_ = collapsed_dim;
+    collapsed_dim_  = collapsed_dim;
+    collapsed_mask_ = collapsed_mask;
     block_.initialize(domain, collapsed_dim);
 
     for (int32_t idx = 0; idx < DIM; ++idx) {
@@ -167,12 +174,19 @@ struct ThreadBlocks {
     point[collapsed_dim_] += collapsed_dim_stride_;
   }
 
+  __host__ __device__ inline bool is_collapsed(int32_t dim) const
+  {
+    return collapsed_mask_ & (1u << dim);
+  }
+
   constexpr size_t num_blocks() const { return num_blocks_; }
   constexpr size_t num_threads() const { return block_.num_threads_; }
 
   // List of dimensions, from the outermost one to the innermost
   int32_t dim_order_[DIM];
   int32_t collapsed_dim_;
+  // All dimensions being collapsed, including collapsed_dim_
+  uint32_t collapsed_mask_;
   coord_t collapsed_dim_stride_;
   // Shape of each thread block
   ThreadBlock<DIM> block_;
@@ -203,10 +217,11 @@ std::ostream& operator<<(std::ostream& os, const ThreadBlocks<DIM>& blocks)
   return os;
 }
 
-template <typename REDOP, typename CTOR, typename LHS, typename RHS, int32_t DIM>
+// The input is an accessor, a reader of a fused expression or one widening a narrow input
+template <typename REDOP, typename CTOR, typename LHS, typename IN, int32_t DIM>
 static __device__ __forceinline__ Point<DIM> local_reduce(CTOR ctor,
                                                           LHS& result,
-                                                          AccessorRO<RHS, DIM> in,
+                                                          const IN& in,
                                                           LHS identity,
                                                           const ThreadBlocks<DIM>& blocks,
                                                           const Rect<DIM>& domain,
@@ -233,9 +248,12 @@ static __device__ __forceinline__ Point<DIM> local_reduce(CTOR ctor,
     // the same x value in which case they're all going to conflict
     // so instead we do a warp-level reduction so just one thread ends
     // up doing the full atomic
+    // Points that differ only in collapsed dimensions reduce into the same output
     coord_t bucket = 0;
-    for (int32_t dim = DIM - 2; dim >= 0; --dim)
+    for (int32_t dim = DIM - 2; dim >= 0; --dim) {
+      if (blocks.is_collapsed(dim)) continue;
       bucket = bucket * (domain.hi[dim] - domain.lo[dim] + 1) + point[dim] - domain.lo[dim];
+    }
 
     const uint32_t same_mask = __match_any_sync(0xffffffff, bucket);
     int32_t laneid;
@@ -284,47 +302,329 @@ static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
                      int32_t collapsed_dim)
 {
   auto result = identity;
-  auto point  = local_reduce<REDOP, CTOR, LHS, RHS, DIM>(
+  auto point  = local_reduce<REDOP, CTOR, LHS, AccessorRO<RHS, DIM>, DIM>(
     CTOR{}, result, in, identity, blocks, domain, collapsed_dim);
   if (result != identity) REDOP::template fold<false>(out[point], result);
 }
 
-template <typename REDOP, typename CTOR, typename LHS, typename RHS, int32_t DIM>
+template <typename REDOP, typename CTOR, typename LHS, typename IN, int32_t DIM>
 static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
   reduce_with_rd_acc(AccessorRD<REDOP, false, DIM> out,
-                     AccessorRO<RHS, DIM> in,
+                     IN in,
                      LHS identity,
                      ThreadBlocks<DIM> blocks,
                      Rect<DIM> domain,
                      int32_t collapsed_dim)
 {
   auto result = identity;
-  auto point  = local_reduce<REDOP, CTOR, LHS, RHS, DIM>(
+  auto point  = local_reduce<REDOP, CTOR, LHS, IN, DIM>(
     CTOR{}, result, in, identity, blocks, domain, collapsed_dim);
   if (result != identity) out.reduce(point, result);
 }
 
+template <typename OP, typename RHS, int32_t DIM>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  multi_reduce_with_rd_acc(AccessorRD<typename OP::OP1::OP, false, DIM> out1,
+                           AccessorRD<typename OP::OP2::OP, false, DIM> out2,
+                           AccessorRO<RHS, DIM> in,
+                           typename OP::ACC identity,
+                           ThreadBlocks<DIM> blocks,
+                           Rect<DIM> domain,
+                           int32_t collapsed_dim)
+{
+  using CTOR  = MultiRedConstructor<OP, DIM>;
+  auto result = identity;
+  auto point  = local_reduce<OP, CTOR, typename OP::ACC, AccessorRO<RHS, DIM>, DIM>(
+    CTOR{}, result, in, identity, blocks, domain, collapsed_dim);
+  if (result.first != identity.first) out1.reduce(point, result.first);
+  if (result.second != identity.second) out2.reduce(point, result.second);
+}
+
+// Arg reduction over 32-bit values that folds packed Argvals (see PackedArgval). The lanes
+// of a warp whose points meet in the same output first combine their words with shuffles,
+// then one of them commits the result with a single atomic on the scratch word of that
+// output, which is indexed like the points of the output in row-major order.
+template <typename PACKED, typename CTOR, typename RHS, int32_t DIM>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  packed_arg_reduce(uint64_t* out,
+                    AccessorRO<RHS, DIM> in,
+                    ThreadBlocks<DIM> blocks,
+                    Rect<DIM> domain,
+                    int32_t collapsed_dim)
+{
+  const uint32_t warp_mask = __activemask();
+
+  Point<DIM> point  = blocks.point(blockIdx.x, threadIdx.x, domain.lo);
+  const bool active = domain.contains(point);
+
+  uint64_t result = PACKED::identity;
+  coord_t bucket  = -1;
+  if (active) {
+    bucket = 0;
+    for (int32_t dim = 0; dim < DIM; ++dim) {
+      if (dim == collapsed_dim) continue;
+      bucket = bucket * (domain.hi[dim] - domain.lo[dim] + 1) + point[dim] - domain.lo[dim];
+    }
+    CTOR ctor{};
+    while (point[collapsed_dim] <= domain.hi[collapsed_dim]) {
+      PACKED::fold(result, PACKED::pack(ctor(point, in[point], collapsed_dim)));
+      blocks.next_point(point);
+    }
+  }
+
+#if __CUDA_ARCH__ >= 700
+  const uint32_t same_mask = __match_any_sync(warp_mask, bucket);
+  for (int32_t lane = 0; lane < warpSize; ++lane) {
+    if (!(warp_mask & (1u << lane))) continue;
+    const uint64_t other = __shfl_sync(warp_mask, result, lane);
+    if (same_mask & (1u << lane)) PACKED::fold(result, other);
+  }
+  // Only the lowest lane of each group commits
+  const int32_t laneid = threadIdx.x % warpSize;
+  if (__ffs(same_mask) - 1 != laneid) return;
+#endif
+
+  if (active && result != PACKED::identity) PACKED::atomic_fold(out + bucket, result);
+}
+
+template <typename PACKED, typename REDOP, int32_t DIM>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  unpack_arg_reduce(AccessorRD<REDOP, false, DIM> out,
+                    const uint64_t* packed,
+                    size_t volume,
+                    Pitches<DIM - 1> pitches,
+                    Point<DIM> lo)
+{
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x;
+  for (size_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < volume; idx += stride) {
+    if (packed[idx] == PACKED::identity) continue;
+    out.reduce(pitches.unflatten(idx, lo), PACKED::unpack(packed[idx]));
+  }
+}
+
+// Reductions of the innermost dimension alone, like the row sums of a softmax, fold every
+// row with a group of THREADS_PER_ROW threads, a warp for short rows and a whole block for
+// long ones, instead of spreading the rows over the ThreadBlocks tiling. A group walks its
+// row from the front with coalesced loads, in packs of VEC elements when the input is a
+// dense array, and then combines the partial results of its threads in shared memory.
+
+// Rows at most this long are reduced by a warp each
+static constexpr coord_t WARP_ROW_LENGTH = 1024;
+// Rows at least this long over a dense input go to CUB's segmented reduction
+static constexpr coord_t CUB_ROW_LENGTH = 1 << 16;
+
+template <typename REDOP,
+          typename CTOR,
+          typename LHS,
+          typename IN,
+          typename VAL,
+          int32_t DIM,
+          int32_t THREADS_PER_ROW,
+          int32_t VEC>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  reduce_rows(AccessorRD<REDOP, false, DIM> out,
+              IN in,
+              const VAL* dense,
+              LHS identity,
+              size_t rows,
+              coord_t row_length,
+              Pitches<DIM - 1> row_pitches,
+              Point<DIM> lo)
+{
+  constexpr size_t GROUPS = THREADS_PER_BLOCK / THREADS_PER_ROW;
+  const int32_t lane      = threadIdx.x % THREADS_PER_ROW;
+  const size_t group      = threadIdx.x / THREADS_PER_ROW;
+
+  __shared__ uint8_t shmem[THREADS_PER_BLOCK * sizeof(LHS)];
+  LHS* partials = reinterpret_cast<LHS*>(shmem);
+
+  CTOR ctor{};
+  // Every thread of the block takes the same trips so that the groups can synchronize
+  for (size_t base = blockIdx.x * GROUPS; base < rows; base += gridDim.x * GROUPS) {
+    const size_t row = base + group;
+    auto result      = identity;
+    Point<DIM> point = lo;
+    if (row < rows) {
+      point = row_pitches.unflatten(row * row_length, lo);
+      if (dense != nullptr) {
+        const VAL* values = dense + row * row_length;
+        for (coord_t col = lane * VEC; col < row_length; col += THREADS_PER_ROW * VEC) {
+          auto pack = load_vector<VEC>(values + col);
+#pragma unroll
+          for (int32_t idx = 0; idx < VEC; ++idx)
+            REDOP::template fold<true>(result, ctor(point, pack[idx], DIM - 1));
+        }
+      } else {
+        auto p = point;
+        for (coord_t col = lane; col < row_length; col += THREADS_PER_ROW) {
+          p[DIM - 1] = point[DIM - 1] + col;
+          REDOP::template fold<true>(result, ctor(p, in[p], DIM - 1));
+        }
+      }
+    }
+
+    partials[threadIdx.x] = result;
+    for (int32_t offset = THREADS_PER_ROW / 2; offset > 0; offset /= 2) {
+      if constexpr (THREADS_PER_ROW == WARP_SIZE)
+        __syncwarp();
+      else
+        __syncthreads();
+      if (lane < offset)
+        REDOP::template fold<true>(partials[threadIdx.x], partials[threadIdx.x + offset]);
+    }
+    if (lane == 0 && row < rows && partials[threadIdx.x] != identity)
+      out.reduce(point, partials[threadIdx.x]);
+    // The partials are overwritten by the next trip
+    __syncthreads();
+  }
+}
+
+template <typename REDOP, typename LHS, int32_t DIM>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, MIN_CTAS_PER_SM)
+  fold_row_results(AccessorRD<REDOP, false, DIM> out,
+                   const LHS* results,
+                   LHS identity,
+                   size_t rows,
+                   coord_t row_length,
+                   Pitches<DIM - 1> row_pitches,
+                   Point<DIM> lo)
+{
+  const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x;
+  for (size_t row = blockIdx.x * blockDim.x + threadIdx.x; row < rows; row += stride) {
+    if (results[row] == identity) continue;
+    out.reduce(row_pitches.unflatten(row * row_length, lo), results[row]);
+  }
+}
+
+template <typename CTOR, typename LHS, int32_t DIM>
+struct RowValue {
+  template <typename VAL>
+  __device__ __forceinline__ LHS operator()(const VAL& value) const
+  {
+    return CTOR{}(Point<DIM>::ZEROES(), value, DIM - 1);
+  }
+};
+
+struct RowOffset {
+  __device__ __forceinline__ coord_t operator()(coord_t row) const { return row * row_length; }
+  coord_t row_length;
+};
+
+template <typename REDOP, typename LHS>
+struct RowFold {
+  __device__ __forceinline__ LHS operator()(LHS lhs, const LHS& rhs) const
+  {
+    REDOP::template fold<true>(lhs, rhs);
+    return lhs;
+  }
+};
+
+// Picks a segmented kernel for a reduction of the innermost dimension of rect when there are
+// enough rows to keep the GPU busy with one group each, or returns false to leave it to the
+// ThreadBlocks tiling, which also spreads a few long rows over many CTAs
+template <typename REDOP, typename CTOR, typename LHS, typename VAL, typename IN, int32_t DIM>
+static bool reduce_innermost(AccessorRD<REDOP, false, DIM> lhs,
+                             const IN& rhs,
+                             const Rect<DIM>& rect,
+                             uint32_t collapsed_mask,
+                             cudaStream_t stream)
+{
+  if (collapsed_mask != (1u << (DIM - 1))) return false;
+
+  // Rows shorter than a warp pack better into the ThreadBlocks tiling
+  const coord_t row_length = rect.hi[DIM - 1] - rect.lo[DIM - 1] + 1;
+  if (row_length < WARP_SIZE) return false;
+
+  Pitches<DIM - 1> row_pitches;
+  const size_t rows     = row_pitches.flatten(rect) / row_length;
+  const size_t max_ctas = get_max_reduction_ctas();
+  const bool warp_rows  = row_length <= WARP_ROW_LENGTH;
+  const size_t groups   = warp_rows ? THREADS_PER_BLOCK / WARP_SIZE : 1;
+  if (rows < groups * max_ctas) return false;
+
+  constexpr int32_t VEC = vector_width<VAL>();
+  const VAL* dense      = nullptr;
+  if constexpr (std::is_same<IN, AccessorRO<VAL, DIM>>::value)
+    if (rhs.accessor.is_dense_row_major(rect)) dense = rhs.ptr(rect.lo);
+
+  if (dense != nullptr && row_length >= CUB_ROW_LENGTH) {
+    cub::TransformInputIterator<LHS, RowValue<CTOR, LHS, DIM>, const VAL*> values(dense, {});
+    cub::TransformInputIterator<coord_t, RowOffset, cub::CountingInputIterator<coord_t>> offsets(
+      cub::CountingInputIterator<coord_t>(0), RowOffset{row_length});
+    ScratchBuffer<LHS> results(rows);
+    size_t temp_bytes = 0;
+    CHECK_CUDA(cub::DeviceSegmentedReduce::Reduce(nullptr,
+                                                  temp_bytes,
+                                                  values,
+                                                  results.ptr(0),
+                                                  static_cast<int32_t>(rows),
+                                                  offsets,
+                                                  offsets + 1,
+                                                  RowFold<REDOP, LHS>{},
+                                                  REDOP::identity,
+                                                  stream));
+    ScratchBuffer<uint8_t> temp(temp_bytes);
+    CHECK_CUDA(cub::DeviceSegmentedReduce::Reduce(temp.ptr(0),
+                                                  temp_bytes,
+                                                  values,
+                                                  results.ptr(0),
+                                                  static_cast<int32_t>(rows),
+                                                  offsets,
+                                                  offsets + 1,
+                                                  RowFold<REDOP, LHS>{},
+                                                  REDOP::identity,
+                                                  stream));
+    fold_row_results<REDOP, LHS, DIM>
+      <<<grid_stride_blocks<1>(rows), THREADS_PER_BLOCK, 0, stream>>>(
+        lhs, results.ptr(0), REDOP::identity, rows, row_length, row_pitches, rect.lo);
+    return true;
+  }
+
+  // Packs need every row to start on a pack boundary
+  if (dense != nullptr && !(row_length % VEC == 0 && is_vector_aligned<VEC>(dense)))
+    dense = nullptr;
+
+  const size_t blocks = get_grid_stride_ctas((rows + groups - 1) / groups);
+  if (warp_rows)
+    reduce_rows<REDOP, CTOR, LHS, IN, VAL, DIM, WARP_SIZE, VEC>
+      <<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+        lhs, rhs, dense, REDOP::identity, rows, row_length, row_pitches, rect.lo);
+  else
+    reduce_rows<REDOP, CTOR, LHS, IN, VAL, DIM, THREADS_PER_BLOCK, VEC>
+      <<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+        lhs, rhs, dense, REDOP::identity, rows, row_length, row_pitches, rect.lo);
+  return true;
+}
+
 template <UnaryRedCode OP_CODE, LegateTypeCode CODE, int DIM>
 struct UnaryRedImplBody<VariantKind::GPU, OP_CODE, CODE, DIM> {
   using OP    = UnaryRedOp<OP_CODE, CODE>;
   using LG_OP = typename OP::OP;
   using VAL   = legate_type_of<CODE>;
-  using CTOR  = ValueConstructor<VAL, DIM>;
+  using LHS   = typename LG_OP::RHS;
+  using CTOR  = ValueConstructor<OP_CODE, LHS, DIM>;
 
+  // The input is an accessor, a reader of a fused expression or one widening a narrow input
+  template <typename RHS>
   void operator()(AccessorRD<LG_OP, false, DIM> lhs,
-                  AccessorRO<VAL, DIM> rhs,
+                  const RHS& rhs,
                   const Rect<DIM>& rect,
                   const Pitches<DIM - 1>& pitches,
                   int collapsed_dim,
+                  uint32_t collapsed_mask,
                   size_t volume) const
   {
-    auto Kernel = reduce_with_rd_acc<LG_OP, CTOR, VAL, VAL, DIM>;
+    auto stream = get_cached_stream();
+
+    if (reduce_innermost<LG_OP, CTOR, LHS, VAL>(lhs, rhs, rect, collapsed_mask, stream)) return;
+
+    auto Kernel = reduce_with_rd_acc<LG_OP, CTOR, LHS, RHS, DIM>;
 
     ThreadBlocks<DIM> blocks;
-    blocks.initialize(rect, collapsed_dim);
+    blocks.initialize(rect, collapsed_dim, collapsed_mask);
 
     blocks.compute_maximum_concurrency(reinterpret_cast<const void*>(Kernel));
-    Kernel<<<blocks.num_blocks(), blocks.num_threads()>>>(
+    Kernel<<<blocks.num_blocks(), blocks.num_threads(), 0, stream>>>(
       lhs, rhs, LG_OP::identity, blocks, rect, collapsed_dim);
   }
 
@@ -333,15 +633,18 @@ struct UnaryRedImplBody<VariantKind::GPU, OP_CODE, CODE, DIM> {
                   const Rect<DIM>& rect,
                   const Pitches<DIM - 1>& pitches,
                   int collapsed_dim,
+                  uint32_t collapsed_mask,
                   size_t volume) const
   {
+    auto stream = get_cached_stream();
+
     auto Kernel = reduce_with_rw_acc<LG_OP, CTOR, VAL, VAL, DIM>;
 
     ThreadBlocks<DIM> blocks;
-    blocks.initialize(rect, collapsed_dim);
+    blocks.initialize(rect, collapsed_dim, collapsed_mask);
 
     blocks.compute_maximum_concurrency(reinterpret_cast<const void*>(Kernel));
-    Kernel<<<blocks.num_blocks(), blocks.num_threads()>>>(
+    Kernel<<<blocks.num_blocks(), blocks.num_threads(), 0, stream>>>(
       lhs, rhs, LG_OP::identity, blocks, rect, collapsed_dim);
   }
 };
@@ -352,22 +655,32 @@ struct ArgRedImplBody<VariantKind::GPU, OP_CODE, CODE, DIM> {
   using LG_OP = typename OP::OP;
   using RHS   = legate_type_of<CODE>;
   using LHS   = Argval<RHS>;
-  using CTOR  = ArgvalConstructor<RHS, DIM>;
+  using CTOR  = ArgvalConstructor<OP_CODE, RHS, DIM>;
 
   void operator()(AccessorRD<LG_OP, false, DIM> lhs,
                   AccessorRO<RHS, DIM> rhs,
                   const Rect<DIM>& rect,
                   const Pitches<DIM - 1>& pitches,
                   int collapsed_dim,
+                  uint32_t collapsed_mask,
                   size_t volume) const
   {
-    auto Kernel = reduce_with_rd_acc<LG_OP, CTOR, LHS, RHS, DIM>;
+    if constexpr (PackedArgval<LG_OP>::valid) {
+      if (rect.hi[collapsed_dim] <= PackedArgval<LG_OP>::MAX_INDEX) {
+        packed_reduce(lhs, rhs, rect, collapsed_dim, collapsed_mask);
+        return;
+      }
+    }
+
+    auto stream = get_cached_stream();
+
+    auto Kernel = reduce_with_rd_acc<LG_OP, CTOR, LHS, AccessorRO<RHS, DIM>, DIM>;
 
     ThreadBlocks<DIM> blocks;
-    blocks.initialize(rect, collapsed_dim);
+    blocks.initialize(rect, collapsed_dim, collapsed_mask);
 
     blocks.compute_maximum_concurrency(reinterpret_cast<const void*>(Kernel));
-    Kernel<<<blocks.num_blocks(), blocks.num_threads()>>>(
+    Kernel<<<blocks.num_blocks(), blocks.num_threads(), 0, stream>>>(
       lhs, rhs, LG_OP::identity, blocks, rect, collapsed_dim);
   }
 
@@ -376,17 +689,84 @@ struct ArgRedImplBody<VariantKind::GPU, OP_CODE, CODE, DIM> {
                   const Rect<DIM>& rect,
                   const Pitches<DIM - 1>& pitches,
                   int collapsed_dim,
+                  uint32_t collapsed_mask,
                   size_t volume) const
   {
+    auto stream = get_cached_stream();
+
     auto Kernel = reduce_with_rw_acc<LG_OP, CTOR, LHS, RHS, DIM>;
 
     ThreadBlocks<DIM> blocks;
-    blocks.initialize(rect, collapsed_dim);
+    blocks.initialize(rect, collapsed_dim, collapsed_mask);
 
     blocks.compute_maximum_concurrency(reinterpret_cast<const void*>(Kernel));
-    Kernel<<<blocks.num_blocks(), blocks.num_threads()>>>(
+    Kernel<<<blocks.num_blocks(), blocks.num_threads(), 0, stream>>>(
       lhs, rhs, LG_OP::identity, blocks, rect, collapsed_dim);
   }
+
+  void packed_reduce(AccessorRD<LG_OP, false, DIM> lhs,
+                     AccessorRO<RHS, DIM> rhs,
+                     const Rect<DIM>& rect,
+                     int collapsed_dim,
+                     uint32_t collapsed_mask) const
+  {
+    using PACKED = PackedArgval<LG_OP>;
+
+    auto stream = get_cached_stream();
+
+    // One scratch word per output, i.e. per point with the collapsed coordinate pinned
+    auto out_rect              = rect;
+    out_rect.hi[collapsed_dim] = rect.lo[collapsed_dim];
+    Pitches<DIM - 1> out_pitches;
+    const size_t out_volume = out_pitches.flatten(out_rect);
+
+    // The identities are either all zeros or all ones
+    ScratchBuffer<uint64_t> packed(out_volume);
+    CHECK_CUDA(cudaMemsetAsync(
+      packed.ptr(0), PACKED::identity == 0 ? 0 : 0xFF, out_volume * sizeof(uint64_t), stream));
+
+    auto Kernel = packed_arg_reduce<PACKED, CTOR, RHS, DIM>;
+
+    ThreadBlocks<DIM> blocks;
+    blocks.initialize(rect, collapsed_dim, collapsed_mask);
+
+    blocks.compute_maximum_concurrency(reinterpret_cast<const void*>(Kernel));
+    Kernel<<<blocks.num_blocks(), blocks.num_threads(), 0, stream>>>(
+      packed.ptr(0), rhs, blocks, rect, collapsed_dim);
+
+    unpack_arg_reduce<PACKED, LG_OP, DIM>
+      <<<grid_stride_blocks<1>(out_volume), THREADS_PER_BLOCK, 0, stream>>>(
+        lhs, packed.ptr(0), out_volume, out_pitches, out_rect.lo);
+  }
+};
+
+template <UnaryRedCode OP_CODE1, UnaryRedCode OP_CODE2, LegateTypeCode CODE, int DIM>
+struct UnaryMultiRedImplBody<VariantKind::GPU, OP_CODE1, OP_CODE2, CODE, DIM> {
+  using OP     = MultiRedOp<OP_CODE1, OP_CODE2, CODE>;
+  using LG_OP1 = typename OP::OP1::OP;
+  using LG_OP2 = typename OP::OP2::OP;
+  using VAL    = legate_type_of<CODE>;
+
+  void operator()(AccessorRD<LG_OP1, false, DIM> lhs1,
+                  AccessorRD<LG_OP2, false, DIM> lhs2,
+                  AccessorRO<VAL, DIM> rhs,
+                  const Rect<DIM>& rect,
+                  const Pitches<DIM - 1>& pitches,
+                  int collapsed_dim,
+                  uint32_t collapsed_mask,
+                  size_t volume) const
+  {
+    auto stream = get_cached_stream();
+
+    auto Kernel = multi_reduce_with_rd_acc<OP, VAL, DIM>;
+
+    ThreadBlocks<DIM> blocks;
+    blocks.initialize(rect, collapsed_dim, collapsed_mask);
+
+    blocks.compute_maximum_concurrency(reinterpret_cast<const void*>(Kernel));
+    Kernel<<<blocks.num_blocks(), blocks.num_threads(), 0, stream>>>(
+      lhs1, lhs2, rhs, OP::identity(), blocks, rect, collapsed_dim);
+  }
 };
 
 /*static*/ void UnaryRedTask::gpu_variant(TaskContext& context)
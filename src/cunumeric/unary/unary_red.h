@@ -21,11 +21,26 @@
 
 namespace cunumeric {
 
+// The output of a region reduction is broadcast along every dimension in collapsed_dims
+struct FusedExpr;
+
 struct UnaryRedArgs {
   const Array& lhs;
   const Array& rhs;
-  int32_t collapsed_dim;
+  legate::Span<const int32_t> collapsed_dims;
   UnaryRedCode op_code;
+  // An element-wise expression of the inputs folded in place of rhs, if any
+  const FusedExpr* expr{nullptr};
+};
+
+// Two reductions folded in one sweep, each producing its own region
+struct UnaryMultiRedArgs {
+  const Array& lhs1;
+  const Array& lhs2;
+  const Array& rhs;
+  legate::Span<const int32_t> collapsed_dims;
+  UnaryRedCode op_code1;
+  UnaryRedCode op_code2;
 };
 
 class UnaryRedTask : public CuNumericTask<UnaryRedTask> {
@@ -17,6 +17,8 @@
 #include "cunumeric/unary/unary_red.h"
 #include "cunumeric/unary/unary_red_template.inl"
 
+#include <omp.h>
+
 namespace cunumeric {
 
 using namespace Legion;
@@ -30,10 +32,13 @@ struct Split {
 template <int DIM>
 class Splitter {
  public:
-  Split split(const Legion::Rect<DIM>& rect, int must_be_inner)
+  // Only dimensions outside inner_mask are split across threads, so that the threads
+  // never reduce into the same output element
+  Split split(const Legion::Rect<DIM>& rect, uint32_t inner_mask)
   {
+    outer_dim_ = -1;
     for (int dim = 0; dim < DIM; ++dim)
-      if (dim != must_be_inner) {
+      if (!(inner_mask & (1u << dim))) {
         outer_dim_ = dim;
         break;
       }
@@ -75,27 +80,131 @@ class Splitter {
   size_t pitches_[DIM];
 };
 
+// Private partials must not cost more than this fraction of the input of a thread
+static constexpr size_t PRIVATE_PARTIALS_RATIO = 8;
+
+// When the output is small next to the input, as in reductions along the leading axis,
+// splitting only the kept dimensions leaves most threads idle. Each thread then reduces
+// a contiguous chunk of the input into a private copy of the output instead, and the
+// copies are merged pairwise in log2(threads) rounds before they reach the output.
+template <int DIM>
+class PrivatePartials {
+ public:
+  // Returns whether the private partials pay off for this reduction
+  bool initialize(const Legion::Rect<DIM>& rect,
+                  uint32_t collapsed_mask,
+                  size_t outer,
+                  size_t volume)
+  {
+    max_threads_ = omp_get_max_threads();
+    if (max_threads_ < 2 || outer >= static_cast<size_t>(max_threads_)) return false;
+
+    out_rect_ = rect;
+    for (int dim = 0; dim < DIM; ++dim)
+      if (collapsed_mask & (1u << dim)) out_rect_.hi[dim] = rect.lo[dim];
+    out_volume_     = out_pitches_.flatten(out_rect_);
+    collapsed_mask_ = collapsed_mask;
+
+    return out_volume_ * max_threads_ * PRIVATE_PARTIALS_RATIO <= volume;
+  }
+
+  template <typename REDOP, typename LHS, typename Load, typename Commit>
+  void reduce(const Legion::Rect<DIM>& rect,
+              const Pitches<DIM - 1>& pitches,
+              size_t volume,
+              LHS identity,
+              Load&& load,
+              Commit&& commit) const
+  {
+    std::vector<std::vector<LHS>> partials(max_threads_);
+#pragma omp parallel
+    {
+      const int tid         = omp_get_thread_num();
+      const int num_threads = omp_get_num_threads();
+      auto& partial         = partials[tid];
+      partial.assign(out_volume_, identity);
+      // Chunks are contiguous and in order, so the arg reductions still see the lower
+      // indices first when they break ties
+#pragma omp for schedule(static)
+      for (size_t idx = 0; idx < volume; ++idx) {
+        auto point = pitches.unflatten(idx, rect.lo);
+        REDOP::template fold<true>(partial[out_index(point)], load(point));
+      }
+      for (int stride = 1; stride < num_threads; stride *= 2) {
+        if (tid % (2 * stride) == 0 && tid + stride < num_threads) {
+          auto& other = partials[tid + stride];
+          for (size_t idx = 0; idx < out_volume_; ++idx)
+            REDOP::template fold<true>(partial[idx], other[idx]);
+        }
+#pragma omp barrier
+      }
+    }
+
+    auto& result = partials[0];
+#pragma omp parallel for schedule(static)
+    for (size_t idx = 0; idx < out_volume_; ++idx)
+      commit(out_pitches_.unflatten(idx, out_rect_.lo), result[idx]);
+  }
+
+ private:
+  // Row-major position of the output that a point reduces into
+  inline size_t out_index(const Legion::Point<DIM>& point) const
+  {
+    size_t index = 0;
+    for (int dim = 0; dim < DIM; ++dim) {
+      if (collapsed_mask_ & (1u << dim)) continue;
+      const size_t extent = out_rect_.hi[dim] - out_rect_.lo[dim] + 1;
+      index               = index * extent + point[dim] - out_rect_.lo[dim];
+    }
+    return index;
+  }
+
+ private:
+  int max_threads_;
+  uint32_t collapsed_mask_;
+  Legion::Rect<DIM> out_rect_;
+  Pitches<DIM - 1> out_pitches_;
+  size_t out_volume_;
+};
+
 template <UnaryRedCode OP_CODE, LegateTypeCode CODE, int DIM>
 struct UnaryRedImplBody<VariantKind::OMP, OP_CODE, CODE, DIM> {
   using OP    = UnaryRedOp<OP_CODE, CODE>;
   using LG_OP = typename OP::OP;
   using VAL   = legate_type_of<CODE>;
+  using LHS   = typename LG_OP::RHS;
+  using INPUT = UnaryRedInput<OP_CODE>;
 
+  // The input is an accessor, a reader of a fused expression or one widening a narrow input
+  template <typename RHS>
   void operator()(AccessorRD<LG_OP, true, DIM> lhs,
-                  AccessorRO<VAL, DIM> rhs,
+                  const RHS& rhs,
                   const Rect<DIM>& rect,
                   const Pitches<DIM - 1>& pitches,
                   int collapsed_dim,
+                  uint32_t collapsed_mask,
                   size_t volume) const
   {
     Splitter<DIM> splitter;
-    auto split = splitter.split(rect, collapsed_dim);
+    auto split = splitter.split(rect, collapsed_mask);
+
+    PrivatePartials<DIM> partials;
+    if (partials.initialize(rect, collapsed_mask, split.outer, volume)) {
+      partials.template reduce<LG_OP>(
+        rect,
+        pitches,
+        volume,
+        LG_OP::identity,
+        [&](const Point<DIM>& point) { return INPUT{}(rhs[point]); },
+        [&](const Point<DIM>& point, const LHS& value) { lhs.reduce(point, value); });
+      return;
+    }
 
 #pragma omp parallel for schedule(static)
     for (size_t o_idx = 0; o_idx < split.outer; ++o_idx)
       for (size_t i_idx = 0; i_idx < split.inner; ++i_idx) {
         auto point = splitter.combine(o_idx, i_idx, rect.lo);
-        lhs.reduce(point, rhs[point]);
+        lhs.reduce(point, INPUT{}(rhs[point]));
       }
   }
 
@@ -104,16 +213,31 @@ struct UnaryRedImplBody<VariantKind::OMP, OP_CODE, CODE, DIM> {
                   const Rect<DIM>& rect,
                   const Pitches<DIM - 1>& pitches,
                   int collapsed_dim,
+                  uint32_t collapsed_mask,
                   size_t volume) const
   {
     Splitter<DIM> splitter;
-    auto split = splitter.split(rect, collapsed_dim);
+    auto split = splitter.split(rect, collapsed_mask);
+
+    PrivatePartials<DIM> partials;
+    if (partials.initialize(rect, collapsed_mask, split.outer, volume)) {
+      partials.template reduce<LG_OP>(
+        rect,
+        pitches,
+        volume,
+        LG_OP::identity,
+        [&](const Point<DIM>& point) { return INPUT{}(rhs[point]); },
+        [&](const Point<DIM>& point, const LHS& value) {
+          OP::template fold<true>(lhs[point], value);
+        });
+      return;
+    }
 
 #pragma omp parallel for schedule(static)
     for (size_t o_idx = 0; o_idx < split.outer; ++o_idx)
       for (size_t i_idx = 0; i_idx < split.inner; ++i_idx) {
         auto point = splitter.combine(o_idx, i_idx, rect.lo);
-        OP::template fold<true>(lhs[point], rhs[point]);
+        OP::template fold<true>(lhs[point], INPUT{}(rhs[point]));
       }
   }
 };
@@ -124,22 +248,38 @@ struct ArgRedImplBody<VariantKind::OMP, OP_CODE, CODE, DIM> {
   using LG_OP  = typename OP::OP;
   using VAL    = legate_type_of<CODE>;
   using ARGVAL = Argval<VAL>;
+  using INPUT  = UnaryRedInput<OP_CODE>;
 
   void operator()(AccessorRD<LG_OP, true, DIM> lhs,
                   AccessorRO<VAL, DIM> rhs,
                   const Rect<DIM>& rect,
                   const Pitches<DIM - 1>& pitches,
                   int collapsed_dim,
+                  uint32_t collapsed_mask,
                   size_t volume) const
   {
     Splitter<DIM> splitter;
-    auto split = splitter.split(rect, collapsed_dim);
+    auto split = splitter.split(rect, collapsed_mask);
+
+    PrivatePartials<DIM> partials;
+    if (partials.initialize(rect, collapsed_mask, split.outer, volume)) {
+      partials.template reduce<LG_OP>(
+        rect,
+        pitches,
+        volume,
+        LG_OP::identity,
+        [&](const Point<DIM>& point) {
+          return ARGVAL(point[collapsed_dim], INPUT{}(rhs[point]));
+        },
+        [&](const Point<DIM>& point, const ARGVAL& value) { lhs.reduce(point, value); });
+      return;
+    }
 
 #pragma omp parallel for schedule(static)
     for (size_t o_idx = 0; o_idx < split.outer; ++o_idx)
       for (size_t i_idx = 0; i_idx < split.inner; ++i_idx) {
         auto point = splitter.combine(o_idx, i_idx, rect.lo);
-        lhs.reduce(point, ARGVAL(point[collapsed_dim], rhs[point]));
+        lhs.reduce(point, ARGVAL(point[collapsed_dim], INPUT{}(rhs[point])));
       }
   }
 
@@ -148,16 +288,78 @@ struct ArgRedImplBody<VariantKind::OMP, OP_CODE, CODE, DIM> {
                   const Rect<DIM>& rect,
                   const Pitches<DIM - 1>& pitches,
                   int collapsed_dim,
+                  uint32_t collapsed_mask,
+                  size_t volume) const
+  {
+    Splitter<DIM> splitter;
+    auto split = splitter.split(rect, collapsed_mask);
+
+    PrivatePartials<DIM> partials;
+    if (partials.initialize(rect, collapsed_mask, split.outer, volume)) {
+      partials.template reduce<LG_OP>(
+        rect,
+        pitches,
+        volume,
+        LG_OP::identity,
+        [&](const Point<DIM>& point) {
+          return ARGVAL(point[collapsed_dim], INPUT{}(rhs[point]));
+        },
+        [&](const Point<DIM>& point, const ARGVAL& value) {
+          OP::template fold<true>(lhs[point], value);
+        });
+      return;
+    }
+
+#pragma omp parallel for schedule(static)
+    for (size_t o_idx = 0; o_idx < split.outer; ++o_idx)
+      for (size_t i_idx = 0; i_idx < split.inner; ++i_idx) {
+        auto point = splitter.combine(o_idx, i_idx, rect.lo);
+        OP::template fold<true>(lhs[point], ARGVAL(point[collapsed_dim], INPUT{}(rhs[point])));
+      }
+  }
+};
+
+template <UnaryRedCode OP_CODE1, UnaryRedCode OP_CODE2, LegateTypeCode CODE, int DIM>
+struct UnaryMultiRedImplBody<VariantKind::OMP, OP_CODE1, OP_CODE2, CODE, DIM> {
+  using OP     = MultiRedOp<OP_CODE1, OP_CODE2, CODE>;
+  using LG_OP1 = typename OP::OP1::OP;
+  using LG_OP2 = typename OP::OP2::OP;
+  using VAL    = legate_type_of<CODE>;
+
+  void operator()(AccessorRD<LG_OP1, true, DIM> lhs1,
+                  AccessorRD<LG_OP2, true, DIM> lhs2,
+                  AccessorRO<VAL, DIM> rhs,
+                  const Rect<DIM>& rect,
+                  const Pitches<DIM - 1>& pitches,
+                  int collapsed_dim,
+                  uint32_t collapsed_mask,
                   size_t volume) const
   {
     Splitter<DIM> splitter;
-    auto split = splitter.split(rect, collapsed_dim);
+    auto split = splitter.split(rect, collapsed_mask);
+
+    PrivatePartials<DIM> partials;
+    if (partials.initialize(rect, collapsed_mask, split.outer, volume)) {
+      partials.template reduce<OP>(
+        rect,
+        pitches,
+        volume,
+        OP::identity(),
+        [&](const Point<DIM>& point) { return OP::convert(rhs[point]); },
+        [&](const Point<DIM>& point, const typename OP::ACC& value) {
+          lhs1.reduce(point, value.first);
+          lhs2.reduce(point, value.second);
+        });
+      return;
+    }
 
 #pragma omp parallel for schedule(static)
     for (size_t o_idx = 0; o_idx < split.outer; ++o_idx)
       for (size_t i_idx = 0; i_idx < split.inner; ++i_idx) {
         auto point = splitter.combine(o_idx, i_idx, rect.lo);
-        OP::template fold<true>(lhs[point], ARGVAL(point[collapsed_dim], rhs[point]));
+        auto value = OP::convert(rhs[point]);
+        lhs1.reduce(point, value.first);
+        lhs2.reduce(point, value.second);
       }
   }
 };
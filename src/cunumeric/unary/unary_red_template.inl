@@ -15,8 +15,11 @@
  */
 
 #include "cunumeric/unary/unary_red_util.h"
+#include "cunumeric/annotate.h"
 #include "cunumeric/arg.h"
+#include "cunumeric/fused/fused_op_util.h"
 #include "cunumeric/pitches.h"
+#include "cunumeric/roofline.h"
 
 namespace cunumeric {
 
@@ -29,6 +32,31 @@ struct UnaryRedImplBody;
 template <VariantKind KIND, UnaryRedCode OP_CODE, LegateTypeCode CODE, int DIM>
 struct ArgRedImplBody;
 
+template <VariantKind KIND,
+          UnaryRedCode OP_CODE1,
+          UnaryRedCode OP_CODE2,
+          LegateTypeCode CODE,
+          int DIM>
+struct UnaryMultiRedImplBody;
+
+// The variants walk along the longest of the collapsed dimensions and treat the others
+// like the dimensions that are kept, as the output is broadcast along all of them
+template <int DIM>
+static int32_t longest_collapsed_dim(const Rect<DIM>& rect, Span<const int32_t> collapsed_dims)
+{
+  int32_t longest = collapsed_dims[0];
+  for (auto dim : collapsed_dims)
+    if (rect.hi[dim] - rect.lo[dim] > rect.hi[longest] - rect.lo[longest]) longest = dim;
+  return longest;
+}
+
+static uint32_t collapsed_dims_mask(Span<const int32_t> collapsed_dims)
+{
+  uint32_t mask = 0;
+  for (auto dim : collapsed_dims) mask |= 1u << dim;
+  return mask;
+}
+
 template <VariantKind KIND, UnaryRedCode OP_CODE>
 struct UnaryRedImpl {
   template <LegateTypeCode CODE,
@@ -45,11 +73,29 @@ struct UnaryRedImpl {
 
     if (volume == 0) return;
 
-    auto rhs = args.rhs.read_accessor<VAL, DIM>(rect);
+    CUNUMERIC_ROOFLINE_SAMPLE("unary_red", OP_CODE, KIND, volume * sizeof(VAL), volume);
+
+    auto collapsed_dim = longest_collapsed_dim(rect, args.collapsed_dims);
+    auto mask          = collapsed_dims_mask(args.collapsed_dims);
 
     auto lhs = args.lhs.reduce_accessor<typename OP::OP, KIND != VariantKind::GPU, DIM>(rect);
-    UnaryRedImplBody<KIND, OP_CODE, CODE, DIM>()(
-      lhs, rhs, rect, pitches, args.collapsed_dim, volume);
+    if (args.expr != nullptr) {
+      FusedReader<CODE, DIM> rhs(*args.expr, rect);
+      UnaryRedImplBody<KIND, OP_CODE, CODE, DIM>()(
+        lhs, rhs, rect, pitches, collapsed_dim, mask, volume);
+    } else if (args.rhs.code() != CODE) {
+      if constexpr (unary_red_widens(OP_CODE))
+        with_widening_reader<CODE>(args.rhs, rect, [&](const auto& rhs) {
+          UnaryRedImplBody<KIND, OP_CODE, CODE, DIM>()(
+            lhs, rhs, rect, pitches, collapsed_dim, mask, volume);
+        });
+      else
+        assert(false);
+    } else {
+      auto rhs = args.rhs.read_accessor<VAL, DIM>(rect);
+      UnaryRedImplBody<KIND, OP_CODE, CODE, DIM>()(
+        lhs, rhs, rect, pitches, collapsed_dim, mask, volume);
+    }
   }
 
   template <LegateTypeCode CODE,
@@ -80,8 +126,14 @@ struct ArgRedImpl {
 
     auto rhs = args.rhs.read_accessor<VAL, DIM>(rect);
 
+    // Arg reductions only ever collapse a single dimension
+    assert(args.collapsed_dims.size() == 1);
+    auto collapsed_dim = args.collapsed_dims[0];
+    auto mask          = collapsed_dims_mask(args.collapsed_dims);
+
     auto lhs = args.lhs.reduce_accessor<typename OP::OP, KIND != VariantKind::GPU, DIM>(rect);
-    ArgRedImplBody<KIND, OP_CODE, CODE, DIM>()(lhs, rhs, rect, pitches, args.collapsed_dim, volume);
+    ArgRedImplBody<KIND, OP_CODE, CODE, DIM>()(
+      lhs, rhs, rect, pitches, collapsed_dim, mask, volume);
   }
 
   template <LegateTypeCode CODE,
@@ -93,17 +145,71 @@ struct ArgRedImpl {
   }
 };
 
+template <VariantKind KIND, UnaryRedCode OP_CODE1, UnaryRedCode OP_CODE2>
+struct UnaryMultiRedImpl {
+  template <LegateTypeCode CODE,
+            int DIM,
+            std::enable_if_t<(DIM > 1) && MultiRedOp<OP_CODE1, OP_CODE2, CODE>::valid>* = nullptr>
+  void operator()(UnaryMultiRedArgs& args) const
+  {
+    using OP  = MultiRedOp<OP_CODE1, OP_CODE2, CODE>;
+    using VAL = legate_type_of<CODE>;
+
+    Pitches<DIM - 1> pitches;
+    auto rect   = args.rhs.shape<DIM>();
+    auto volume = pitches.flatten(rect);
+
+    if (volume == 0) return;
+
+    auto rhs = args.rhs.read_accessor<VAL, DIM>(rect);
+
+    auto collapsed_dim = longest_collapsed_dim(rect, args.collapsed_dims);
+    auto mask          = collapsed_dims_mask(args.collapsed_dims);
+
+    auto lhs1 =
+      args.lhs1.reduce_accessor<typename OP::OP1::OP, KIND != VariantKind::GPU, DIM>(rect);
+    auto lhs2 =
+      args.lhs2.reduce_accessor<typename OP::OP2::OP, KIND != VariantKind::GPU, DIM>(rect);
+    UnaryMultiRedImplBody<KIND, OP_CODE1, OP_CODE2, CODE, DIM>()(
+      lhs1, lhs2, rhs, rect, pitches, collapsed_dim, mask, volume);
+  }
+
+  template <LegateTypeCode CODE,
+            int DIM,
+            std::enable_if_t<DIM <= 1 || !MultiRedOp<OP_CODE1, OP_CODE2, CODE>::valid>* = nullptr>
+  void operator()(UnaryMultiRedArgs& args) const
+  {
+    assert(false);
+  }
+};
+
+template <VariantKind KIND>
+struct UnaryMultiRedDispatch {
+  template <UnaryRedCode OP_CODE1, UnaryRedCode OP_CODE2>
+  void operator()(UnaryMultiRedArgs& args) const
+  {
+    return cunumeric::double_dispatch(
+      args.rhs.dim(), args.rhs.code(), UnaryMultiRedImpl<KIND, OP_CODE1, OP_CODE2>{}, args);
+  }
+};
+
 template <VariantKind KIND>
 struct UnaryRedDispatch {
   template <UnaryRedCode OP_CODE, std::enable_if_t<!is_arg_reduce<OP_CODE>::value>* = nullptr>
   void operator()(UnaryRedArgs& args) const
   {
-    return double_dispatch(args.rhs.dim(), args.rhs.code(), UnaryRedImpl<KIND, OP_CODE>{}, args);
+    auto code = unary_red_code(OP_CODE, args.rhs.code(), args.lhs.code());
+    AnnotatedRange range(
+      "unary_red", OP_CODE, code, args.rhs.dim(), args.rhs.domain().get_volume());
+    return cunumeric::double_dispatch(args.rhs.dim(), code, UnaryRedImpl<KIND, OP_CODE>{}, args);
   }
   template <UnaryRedCode OP_CODE, std::enable_if_t<is_arg_reduce<OP_CODE>::value>* = nullptr>
   void operator()(UnaryRedArgs& args) const
   {
-    return double_dispatch(args.rhs.dim(), args.rhs.code(), ArgRedImpl<KIND, OP_CODE>{}, args);
+    AnnotatedRange range(
+      "unary_red", OP_CODE, args.rhs.code(), args.rhs.dim(), args.rhs.domain().get_volume());
+    return cunumeric::double_dispatch(
+      args.rhs.dim(), args.rhs.code(), ArgRedImpl<KIND, OP_CODE>{}, args);
   }
 };
 
@@ -114,8 +220,32 @@ static void unary_red_template(TaskContext& context)
   auto& reductions = context.reductions();
   auto& scalars    = context.scalars();
 
+  // Multiple reduction outputs request the multi-reduction mode,
+  // in which case the second scalar holds one op code per output
+  if (reductions.size() > 1) {
+    auto op_codes = scalars[1].values<int32_t>();
+    UnaryMultiRedArgs args{reductions[0],
+                           reductions[1],
+                           inputs[0],
+                           scalars[0].values<int32_t>(),
+                           static_cast<UnaryRedCode>(op_codes[0]),
+                           static_cast<UnaryRedCode>(op_codes[1])};
+    multi_op_dispatch(args.op_code1, args.op_code2, UnaryMultiRedDispatch<KIND>{}, args);
+    return;
+  }
+
   UnaryRedArgs args{
-    reductions[0], inputs[0], scalars[0].value<int32_t>(), scalars[1].value<UnaryRedCode>()};
+    reductions[0], inputs[0], scalars[0].values<int32_t>(), scalars[1].value<UnaryRedCode>()};
+
+  // A program in the remaining scalars is an element-wise expression of all the inputs that
+  // gets folded in place of a single input
+  if (scalars.size() > 2) {
+    FusedExpr expr{
+      inputs, scalars[2].values<int32_t>(), scalars[3].values<int32_t>(), scalars[4]};
+    args.expr = &expr;
+    op_dispatch(args.op_code, UnaryRedDispatch<KIND>{}, args);
+    return;
+  }
   op_dispatch(args.op_code, UnaryRedDispatch<KIND>{}, args);
 }
 
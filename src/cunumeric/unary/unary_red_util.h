@@ -33,6 +33,21 @@ enum class UnaryRedCode : int {
   ARGMIN        = 8,
   CONTAINS      = 9,
   COUNT_NONZERO = 10,
+  SUM_SQUARES   = 11,
+  VARIANCE      = 12,
+  NANARGMAX     = 13,
+  NANARGMIN     = 14,
+  NANCOUNT      = 15,
+  NANMAX        = 16,
+  NANMIN        = 17,
+  NANPROD       = 18,
+  NANSUM        = 19,
+  BINNED_SUM    = 20,
+  NORM1         = 21,
+  NORM2         = 22,
+  NORMINF       = 23,
+  NORMNEGINF    = 24,
+  LOGSUMEXP     = 25,
 };
 
 template <UnaryRedCode OP_CODE>
@@ -44,6 +59,12 @@ struct is_arg_reduce<UnaryRedCode::ARGMAX> : std::true_type {
 template <>
 struct is_arg_reduce<UnaryRedCode::ARGMIN> : std::true_type {
 };
+template <>
+struct is_arg_reduce<UnaryRedCode::NANARGMAX> : std::true_type {
+};
+template <>
+struct is_arg_reduce<UnaryRedCode::NANARGMIN> : std::true_type {
+};
 
 template <typename Functor, typename... Fnargs>
 constexpr decltype(auto) op_dispatch(UnaryRedCode op_code, Functor f, Fnargs&&... args)
@@ -67,29 +88,210 @@ constexpr decltype(auto) op_dispatch(UnaryRedCode op_code, Functor f, Fnargs&&..
       return f.template operator()<UnaryRedCode::ARGMIN>(std::forward<Fnargs>(args)...);
     case UnaryRedCode::CONTAINS:
       return f.template operator()<UnaryRedCode::CONTAINS>(std::forward<Fnargs>(args)...);
+    case UnaryRedCode::COUNT_NONZERO:
+      return f.template operator()<UnaryRedCode::COUNT_NONZERO>(std::forward<Fnargs>(args)...);
+    case UnaryRedCode::SUM_SQUARES:
+      return f.template operator()<UnaryRedCode::SUM_SQUARES>(std::forward<Fnargs>(args)...);
+    case UnaryRedCode::VARIANCE:
+      return f.template operator()<UnaryRedCode::VARIANCE>(std::forward<Fnargs>(args)...);
+    case UnaryRedCode::NANARGMAX:
+      return f.template operator()<UnaryRedCode::NANARGMAX>(std::forward<Fnargs>(args)...);
+    case UnaryRedCode::NANARGMIN:
+      return f.template operator()<UnaryRedCode::NANARGMIN>(std::forward<Fnargs>(args)...);
+    case UnaryRedCode::NANMAX:
+      return f.template operator()<UnaryRedCode::NANMAX>(std::forward<Fnargs>(args)...);
+    case UnaryRedCode::NANMIN:
+      return f.template operator()<UnaryRedCode::NANMIN>(std::forward<Fnargs>(args)...);
+    case UnaryRedCode::NANPROD:
+      return f.template operator()<UnaryRedCode::NANPROD>(std::forward<Fnargs>(args)...);
+    case UnaryRedCode::NANSUM:
+      return f.template operator()<UnaryRedCode::NANSUM>(std::forward<Fnargs>(args)...);
+    case UnaryRedCode::BINNED_SUM:
+      return f.template operator()<UnaryRedCode::BINNED_SUM>(std::forward<Fnargs>(args)...);
+    case UnaryRedCode::NORM1:
+      return f.template operator()<UnaryRedCode::NORM1>(std::forward<Fnargs>(args)...);
+    case UnaryRedCode::NORM2:
+      return f.template operator()<UnaryRedCode::NORM2>(std::forward<Fnargs>(args)...);
+    case UnaryRedCode::NORMINF:
+      return f.template operator()<UnaryRedCode::NORMINF>(std::forward<Fnargs>(args)...);
+    case UnaryRedCode::NORMNEGINF:
+      return f.template operator()<UnaryRedCode::NORMNEGINF>(std::forward<Fnargs>(args)...);
+    case UnaryRedCode::LOGSUMEXP:
+      return f.template operator()<UnaryRedCode::LOGSUMEXP>(std::forward<Fnargs>(args)...);
     default: break;
   }
   assert(false);
   return f.template operator()<UnaryRedCode::MAX>(std::forward<Fnargs>(args)...);
 }
 
-template <typename T, int32_t DIM>
+// Only these pairs of reductions can be folded together in the multi-reduction mode
+template <typename Functor, typename... Fnargs>
+constexpr decltype(auto) multi_op_dispatch(UnaryRedCode op_code1,
+                                           UnaryRedCode op_code2,
+                                           Functor f,
+                                           Fnargs&&... args)
+{
+  if (op_code1 == UnaryRedCode::MIN && op_code2 == UnaryRedCode::MAX)
+    return f.template operator()<UnaryRedCode::MIN, UnaryRedCode::MAX>(
+      std::forward<Fnargs>(args)...);
+  if (op_code1 == UnaryRedCode::SUM && op_code2 == UnaryRedCode::SUM_SQUARES)
+    return f.template operator()<UnaryRedCode::SUM, UnaryRedCode::SUM_SQUARES>(
+      std::forward<Fnargs>(args)...);
+  if (op_code1 == UnaryRedCode::NANSUM && op_code2 == UnaryRedCode::NANCOUNT)
+    return f.template operator()<UnaryRedCode::NANSUM, UnaryRedCode::NANCOUNT>(
+      std::forward<Fnargs>(args)...);
+  assert(false);
+  return f.template operator()<UnaryRedCode::MIN, UnaryRedCode::MAX>(
+    std::forward<Fnargs>(args)...);
+}
+
+// Maps an input element to the value that gets folded into a reduction
+template <UnaryRedCode OP_CODE>
+struct UnaryRedInput {
+  template <typename T>
+  __CUDA_HD__ inline constexpr T operator()(const T& value) const
+  {
+    return value;
+  }
+};
+
+template <>
+struct UnaryRedInput<UnaryRedCode::SUM_SQUARES> {
+  template <typename T>
+  __CUDA_HD__ inline constexpr T operator()(const T& value) const
+  {
+    return value * value;
+  }
+};
+
+// NaN-skipping reductions turn NaN inputs into the identity of the reduction they
+// perform on the other inputs, so that the NaNs leave the result unchanged
+template <typename T>
+__CUDA_HD__ inline constexpr bool is_nan(const T& value)
+{
+  return value != value;
+}
+
+template <>
+struct UnaryRedInput<UnaryRedCode::NANSUM> {
+  template <typename T>
+  __CUDA_HD__ inline constexpr T operator()(const T& value) const
+  {
+    return is_nan(value) ? T(0) : value;
+  }
+};
+
+template <>
+struct UnaryRedInput<UnaryRedCode::NANPROD> {
+  template <typename T>
+  __CUDA_HD__ inline constexpr T operator()(const T& value) const
+  {
+    return is_nan(value) ? T(1) : value;
+  }
+};
+
+template <>
+struct UnaryRedInput<UnaryRedCode::NANMAX> {
+  template <typename T>
+  __CUDA_HD__ inline constexpr T operator()(const T& value) const
+  {
+    return is_nan(value) ? T(-INFINITY) : value;
+  }
+};
+
+template <>
+struct UnaryRedInput<UnaryRedCode::NANMIN> {
+  template <typename T>
+  __CUDA_HD__ inline constexpr T operator()(const T& value) const
+  {
+    return is_nan(value) ? T(INFINITY) : value;
+  }
+};
+
+template <>
+struct UnaryRedInput<UnaryRedCode::NANARGMAX> : public UnaryRedInput<UnaryRedCode::NANMAX> {
+};
+
+template <>
+struct UnaryRedInput<UnaryRedCode::NANARGMIN> : public UnaryRedInput<UnaryRedCode::NANMIN> {
+};
+
+// The 1- and infinity norms reduce the magnitudes of the inputs. The 2-norm needs no
+// conversion here, as its accumulator takes the magnitude of a value itself.
+template <typename T>
+__CUDA_HD__ inline constexpr T magnitude(const T& value)
+{
+  return value < T(0) ? -value : value;
+}
+
+template <>
+struct UnaryRedInput<UnaryRedCode::NORM1> {
+  template <typename T>
+  __CUDA_HD__ inline constexpr T operator()(const T& value) const
+  {
+    return magnitude(value);
+  }
+};
+
+template <>
+struct UnaryRedInput<UnaryRedCode::NORMINF> : public UnaryRedInput<UnaryRedCode::NORM1> {
+};
+
+template <>
+struct UnaryRedInput<UnaryRedCode::NORMNEGINF> : public UnaryRedInput<UnaryRedCode::NORM1> {
+};
+
+// Counts the inputs that are not NaN, which is the divisor of a NaN-skipping mean
+template <>
+struct UnaryRedInput<UnaryRedCode::NANCOUNT> {
+  template <typename T>
+  __CUDA_HD__ inline constexpr T operator()(const T& value) const
+  {
+    return is_nan(value) ? T(0) : T(1);
+  }
+};
+
+// Counts the inputs that are not zero, converting them to the counter in the kernel so
+// that the inputs of any type, booleans included, are read as they are
+template <>
+struct UnaryRedInput<UnaryRedCode::COUNT_NONZERO> {
+  template <typename T>
+  __CUDA_HD__ inline constexpr uint64_t operator()(const T& value) const
+  {
+    return value != T(0) ? 1 : 0;
+  }
+};
+
+
+template <UnaryRedCode OP_CODE, typename T, int32_t DIM>
 struct ValueConstructor {
   __CUDA_HD__ inline constexpr T operator()(const Legion::Point<DIM>&,
                                             const T& value,
                                             int32_t) const
   {
-    return value;
+    return UnaryRedInput<OP_CODE>{}(value);
   }
 };
 
+// Counts take the input in its own type, which differs from that of the counter
 template <typename T, int32_t DIM>
+struct ValueConstructor<UnaryRedCode::COUNT_NONZERO, T, DIM> {
+  template <typename VAL>
+  __CUDA_HD__ inline constexpr T operator()(const Legion::Point<DIM>&,
+                                            const VAL& value,
+                                            int32_t) const
+  {
+    return UnaryRedInput<UnaryRedCode::COUNT_NONZERO>{}(value);
+  }
+};
+
+template <UnaryRedCode OP_CODE, typename T, int32_t DIM>
 struct ArgvalConstructor {
   __CUDA_HD__ inline constexpr Argval<T> operator()(const Legion::Point<DIM>& point,
                                                     const T& value,
                                                     int32_t collapsed_dim) const
   {
-    return Argval<T>(point[collapsed_dim], value);
+    return Argval<T>(point[collapsed_dim], UnaryRedInput<OP_CODE>{}(value));
   }
 };
 
@@ -202,6 +404,51 @@ struct UnaryRedOp<UnaryRedCode::SUM, TYPE_CODE> {
   }
 };
 
+// Sums of squares fold the squares of the input elements that UnaryRedInput computes
+template <legate::LegateTypeCode TYPE_CODE>
+struct UnaryRedOp<UnaryRedCode::SUM_SQUARES, TYPE_CODE> {
+  static constexpr bool valid = true;
+
+  using VAL = legate::legate_type_of<TYPE_CODE>;
+  using OP  = Legion::SumReduction<VAL>;
+
+  template <bool EXCLUSIVE>
+  __CUDA_HD__ static void fold(VAL& rhs1, VAL rhs2)
+  {
+    OP::template fold<EXCLUSIVE>(rhs1, rhs2);
+  }
+};
+
+template <>
+struct UnaryRedOp<UnaryRedCode::SUM_SQUARES, legate::LegateTypeCode::BOOL_LT> {
+  static constexpr bool valid = false;
+};
+
+template <>
+struct UnaryRedOp<UnaryRedCode::SUM_SQUARES, legate::LegateTypeCode::COMPLEX64_LT> {
+  static constexpr bool valid = false;
+};
+
+template <>
+struct UnaryRedOp<UnaryRedCode::SUM_SQUARES, legate::LegateTypeCode::COMPLEX128_LT> {
+  static constexpr bool valid = false;
+};
+
+// Counts of the non-zero inputs of any type are summed in 64-bit unsigned integers
+template <legate::LegateTypeCode TYPE_CODE>
+struct UnaryRedOp<UnaryRedCode::COUNT_NONZERO, TYPE_CODE> {
+  static constexpr bool valid = true;
+
+  using VAL = uint64_t;
+  using OP  = Legion::SumReduction<VAL>;
+
+  template <bool EXCLUSIVE>
+  __CUDA_HD__ static void fold(VAL& rhs1, VAL rhs2)
+  {
+    OP::template fold<EXCLUSIVE>(rhs1, rhs2);
+  }
+};
+
 template <legate::LegateTypeCode TYPE_CODE>
 struct UnaryRedOp<UnaryRedCode::ARGMAX, TYPE_CODE> {
   static constexpr bool valid = true;
@@ -240,4 +487,322 @@ struct UnaryRedOp<UnaryRedCode::ARGMIN, legate::LegateTypeCode::COMPLEX128_LT> {
   static constexpr bool valid = false;
 };
 
+// Input values convert implicitly to single-value Welford accumulators, so the
+// variance goes through the same code paths as reductions on plain values
+template <legate::LegateTypeCode TYPE_CODE>
+struct UnaryRedOp<UnaryRedCode::VARIANCE, TYPE_CODE> {
+  static constexpr bool valid = false;
+};
+
+template <>
+struct UnaryRedOp<UnaryRedCode::VARIANCE, legate::LegateTypeCode::FLOAT_LT> {
+  static constexpr bool valid = true;
+
+  using VAL = Welford<float>;
+  using OP  = VarianceReduction<float>;
+
+  template <bool EXCLUSIVE>
+  __CUDA_HD__ static void fold(VAL& rhs1, VAL rhs2)
+  {
+    OP::template fold<EXCLUSIVE>(rhs1, rhs2);
+  }
+};
+
+template <>
+struct UnaryRedOp<UnaryRedCode::VARIANCE, legate::LegateTypeCode::DOUBLE_LT> {
+  static constexpr bool valid = true;
+
+  using VAL = Welford<double>;
+  using OP  = VarianceReduction<double>;
+
+  template <bool EXCLUSIVE>
+  __CUDA_HD__ static void fold(VAL& rhs1, VAL rhs2)
+  {
+    OP::template fold<EXCLUSIVE>(rhs1, rhs2);
+  }
+};
+
+// Reproducible sums work the same way, with values converting to single-value binned sums
+template <legate::LegateTypeCode TYPE_CODE>
+struct UnaryRedOp<UnaryRedCode::BINNED_SUM, TYPE_CODE> {
+  static constexpr bool valid = false;
+};
+
+template <>
+struct UnaryRedOp<UnaryRedCode::BINNED_SUM, legate::LegateTypeCode::FLOAT_LT> {
+  static constexpr bool valid = true;
+
+  using VAL = BinnedSum<float>;
+  using OP  = BinnedSumReduction<float>;
+
+  template <bool EXCLUSIVE>
+  __CUDA_HD__ static void fold(VAL& rhs1, VAL rhs2)
+  {
+    OP::template fold<EXCLUSIVE>(rhs1, rhs2);
+  }
+};
+
+template <>
+struct UnaryRedOp<UnaryRedCode::BINNED_SUM, legate::LegateTypeCode::DOUBLE_LT> {
+  static constexpr bool valid = true;
+
+  using VAL = BinnedSum<double>;
+  using OP  = BinnedSumReduction<double>;
+
+  template <bool EXCLUSIVE>
+  __CUDA_HD__ static void fold(VAL& rhs1, VAL rhs2)
+  {
+    OP::template fold<EXCLUSIVE>(rhs1, rhs2);
+  }
+};
+
+// NaN-skipping reductions perform their underlying reduction on inputs that went
+// through UnaryRedInput. They only exist for floating point types, as NaNs cannot
+// appear in the others.
+template <UnaryRedCode BASE_CODE, legate::LegateTypeCode TYPE_CODE>
+struct NanUnaryRedOp : public UnaryRedOp<BASE_CODE, TYPE_CODE> {
+  static constexpr bool valid = TYPE_CODE == legate::LegateTypeCode::HALF_LT ||
+                                TYPE_CODE == legate::LegateTypeCode::FLOAT_LT ||
+                                TYPE_CODE == legate::LegateTypeCode::DOUBLE_LT;
+};
+
+template <legate::LegateTypeCode TYPE_CODE>
+struct UnaryRedOp<UnaryRedCode::NANARGMAX, TYPE_CODE>
+  : public NanUnaryRedOp<UnaryRedCode::ARGMAX, TYPE_CODE> {
+};
+
+template <legate::LegateTypeCode TYPE_CODE>
+struct UnaryRedOp<UnaryRedCode::NANARGMIN, TYPE_CODE>
+  : public NanUnaryRedOp<UnaryRedCode::ARGMIN, TYPE_CODE> {
+};
+
+template <legate::LegateTypeCode TYPE_CODE>
+struct UnaryRedOp<UnaryRedCode::NANCOUNT, TYPE_CODE>
+  : public NanUnaryRedOp<UnaryRedCode::SUM, TYPE_CODE> {
+};
+
+template <legate::LegateTypeCode TYPE_CODE>
+struct UnaryRedOp<UnaryRedCode::NANMAX, TYPE_CODE>
+  : public NanUnaryRedOp<UnaryRedCode::MAX, TYPE_CODE> {
+};
+
+template <legate::LegateTypeCode TYPE_CODE>
+struct UnaryRedOp<UnaryRedCode::NANMIN, TYPE_CODE>
+  : public NanUnaryRedOp<UnaryRedCode::MIN, TYPE_CODE> {
+};
+
+template <legate::LegateTypeCode TYPE_CODE>
+struct UnaryRedOp<UnaryRedCode::NANPROD, TYPE_CODE>
+  : public NanUnaryRedOp<UnaryRedCode::PROD, TYPE_CODE> {
+};
+
+template <legate::LegateTypeCode TYPE_CODE>
+struct UnaryRedOp<UnaryRedCode::NANSUM, TYPE_CODE>
+  : public NanUnaryRedOp<UnaryRedCode::SUM, TYPE_CODE> {
+};
+
+// Norms exist for the same floating point types as the NaN-skipping reductions.
+// The 1- and infinity norms perform plain reductions on the magnitudes of the
+// inputs, and the 2-norm works like the variance, with the inputs converting to
+// single-value scaled sums of squares.
+template <legate::LegateTypeCode TYPE_CODE>
+struct UnaryRedOp<UnaryRedCode::NORM1, TYPE_CODE>
+  : public NanUnaryRedOp<UnaryRedCode::SUM, TYPE_CODE> {
+};
+
+template <legate::LegateTypeCode TYPE_CODE>
+struct UnaryRedOp<UnaryRedCode::NORMINF, TYPE_CODE>
+  : public NanUnaryRedOp<UnaryRedCode::MAX, TYPE_CODE> {
+};
+
+template <legate::LegateTypeCode TYPE_CODE>
+struct UnaryRedOp<UnaryRedCode::NORMNEGINF, TYPE_CODE>
+  : public NanUnaryRedOp<UnaryRedCode::MIN, TYPE_CODE> {
+};
+
+template <legate::LegateTypeCode TYPE_CODE>
+struct UnaryRedOp<UnaryRedCode::NORM2, TYPE_CODE> {
+  static constexpr bool valid = false;
+};
+
+template <>
+struct UnaryRedOp<UnaryRedCode::NORM2, legate::LegateTypeCode::FLOAT_LT> {
+  static constexpr bool valid = true;
+
+  using VAL = ScaledSquares<float>;
+  using OP  = NormReduction<float>;
+
+  template <bool EXCLUSIVE>
+  __CUDA_HD__ static void fold(VAL& rhs1, VAL rhs2)
+  {
+    OP::template fold<EXCLUSIVE>(rhs1, rhs2);
+  }
+};
+
+template <>
+struct UnaryRedOp<UnaryRedCode::NORM2, legate::LegateTypeCode::DOUBLE_LT> {
+  static constexpr bool valid = true;
+
+  using VAL = ScaledSquares<double>;
+  using OP  = NormReduction<double>;
+
+  template <bool EXCLUSIVE>
+  __CUDA_HD__ static void fold(VAL& rhs1, VAL rhs2)
+  {
+    OP::template fold<EXCLUSIVE>(rhs1, rhs2);
+  }
+};
+
+// Input values convert implicitly to single-value LogSumExp accumulators, like they do
+// for the variance, and the result is finalized with GETLSE
+template <legate::LegateTypeCode TYPE_CODE>
+struct UnaryRedOp<UnaryRedCode::LOGSUMEXP, TYPE_CODE> {
+  static constexpr bool valid = false;
+};
+
+template <>
+struct UnaryRedOp<UnaryRedCode::LOGSUMEXP, legate::LegateTypeCode::FLOAT_LT> {
+  static constexpr bool valid = true;
+
+  using VAL = LogSumExp<float>;
+  using OP  = LogSumExpReduction<float>;
+
+  template <bool EXCLUSIVE>
+  __CUDA_HD__ static void fold(VAL& rhs1, VAL rhs2)
+  {
+    OP::template fold<EXCLUSIVE>(rhs1, rhs2);
+  }
+};
+
+template <>
+struct UnaryRedOp<UnaryRedCode::LOGSUMEXP, legate::LegateTypeCode::DOUBLE_LT> {
+  static constexpr bool valid = true;
+
+  using VAL = LogSumExp<double>;
+  using OP  = LogSumExpReduction<double>;
+
+  template <bool EXCLUSIVE>
+  __CUDA_HD__ static void fold(VAL& rhs1, VAL rhs2)
+  {
+    OP::template fold<EXCLUSIVE>(rhs1, rhs2);
+  }
+};
+
+// Sums and products of narrow unsigned inputs, like the 8- and 16-bit pixels of images,
+// accumulate in the wider type of the output by widening the values as they are read,
+// instead of reading a copy that a CONVERT materialized first. Match these to
+// _unary_red_widenings in array.py
+constexpr bool unary_red_widens(UnaryRedCode op_code)
+{
+  return op_code == UnaryRedCode::SUM || op_code == UnaryRedCode::PROD;
+}
+
+constexpr bool unary_red_widens_to(legate::LegateTypeCode out_code)
+{
+  switch (out_code) {
+    case legate::LegateTypeCode::INT32_LT:
+    case legate::LegateTypeCode::INT64_LT:
+    case legate::LegateTypeCode::UINT32_LT:
+    case legate::LegateTypeCode::UINT64_LT:
+    case legate::LegateTypeCode::FLOAT_LT:
+    case legate::LegateTypeCode::DOUBLE_LT: return true;
+    default: break;
+  }
+  return false;
+}
+
+constexpr bool unary_red_widens(UnaryRedCode op_code,
+                                legate::LegateTypeCode in_code,
+                                legate::LegateTypeCode out_code)
+{
+  return unary_red_widens(op_code) &&
+         (in_code == legate::LegateTypeCode::UINT8_LT ||
+          in_code == legate::LegateTypeCode::UINT16_LT) &&
+         unary_red_widens_to(out_code);
+}
+
+// Returns the type in which a reduction of an input of the given type is performed
+constexpr legate::LegateTypeCode unary_red_code(UnaryRedCode op_code,
+                                                legate::LegateTypeCode in_code,
+                                                legate::LegateTypeCode out_code)
+{
+  return unary_red_widens(op_code, in_code, out_code) ? out_code : in_code;
+}
+
+// Reads a narrow input like an accessor of the type that the reduction accumulates in
+template <legate::LegateTypeCode SRC_CODE, legate::LegateTypeCode CODE, int DIM>
+struct WideningReader {
+  using SRC = legate::legate_type_of<SRC_CODE>;
+  using VAL = legate::legate_type_of<CODE>;
+
+  __CUDA_HD__ VAL operator[](const Legion::Point<DIM>& point) const
+  {
+    return static_cast<VAL>(in[point]);
+  }
+
+  legate::AccessorRO<SRC, DIM> in;
+};
+
+// Calls the functor with a reader that widens the values of the narrow input to CODE
+template <legate::LegateTypeCode CODE, int DIM, typename Functor>
+void with_widening_reader(const legate::Store& in, const Legion::Rect<DIM>& rect, Functor&& func)
+{
+  if constexpr (unary_red_widens_to(CODE)) {
+    switch (in.code()) {
+      case legate::LegateTypeCode::UINT8_LT:
+        func(WideningReader<legate::LegateTypeCode::UINT8_LT, CODE, DIM>{
+          in.read_accessor<uint8_t, DIM>(rect)});
+        return;
+      case legate::LegateTypeCode::UINT16_LT:
+        func(WideningReader<legate::LegateTypeCode::UINT16_LT, CODE, DIM>{
+          in.read_accessor<uint16_t, DIM>(rect)});
+        return;
+      default: break;
+    }
+  }
+  assert(false);
+}
+
+// A pair of reductions folded in one sweep over the input. The partial results
+// travel together in an accumulator and are only split when written to the
+// outputs, each of which is reduced with its own Legion reduction operator.
+template <UnaryRedCode OP_CODE1, UnaryRedCode OP_CODE2, legate::LegateTypeCode TYPE_CODE>
+struct MultiRedOp {
+  using OP1 = UnaryRedOp<OP_CODE1, TYPE_CODE>;
+  using OP2 = UnaryRedOp<OP_CODE2, TYPE_CODE>;
+
+  static constexpr bool valid = OP1::valid && OP2::valid;
+
+  using VAL = legate::legate_type_of<TYPE_CODE>;
+
+  struct ACC {
+    typename OP1::VAL first;
+    typename OP2::VAL second;
+  };
+
+  static ACC identity() { return ACC{OP1::OP::identity, OP2::OP::identity}; }
+
+  __CUDA_HD__ static ACC convert(const VAL& value)
+  {
+    return ACC{UnaryRedInput<OP_CODE1>{}(value), UnaryRedInput<OP_CODE2>{}(value)};
+  }
+
+  template <bool EXCLUSIVE>
+  __CUDA_HD__ static void fold(ACC& rhs1, ACC rhs2)
+  {
+    OP1::template fold<EXCLUSIVE>(rhs1.first, rhs2.first);
+    OP2::template fold<EXCLUSIVE>(rhs1.second, rhs2.second);
+  }
+};
+
+template <typename OP, int32_t DIM>
+struct MultiRedConstructor {
+  __CUDA_HD__ inline typename OP::ACC operator()(const Legion::Point<DIM>&,
+                                                 const typename OP::VAL& value,
+                                                 int32_t) const
+  {
+    return OP::convert(value);
+  }
+};
+
 }  // namespace cunumeric
@@ -0,0 +1,72 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+
+import cunumeric as num
+
+
+def test_gather():
+    np.random.seed(5)
+    a = np.random.random((40, 30))
+    rows = np.random.randint(-40, 40, size=(6, 7))
+    cols = np.random.randint(0, 30, size=(7,))
+    b = num.array(a)
+    assert np.array_equal(b[num.array(rows), num.array(cols)], a[rows, cols])
+
+    c = np.arange(2 * 3 * 4).reshape((2, 3, 4))
+    d = num.array(c)
+    index = ([1, 0, 1], [2, 2, 0], [3, 1, 0])
+    key = tuple(num.array(i) for i in index)
+    assert np.array_equal(d[key], c[index])
+
+
+def test_scatter():
+    np.random.seed(6)
+    a = np.zeros((20, 10))
+    # Repeated indices would race on GPUs
+    flat = np.random.permutation(200)[:50]
+    rows, cols = flat // 10, flat % 10
+    values = np.arange(50, dtype=np.float64)
+
+    b = num.array(a)
+    b[num.array(rows), num.array(cols)] = num.array(values)
+    a[rows, cols] = values
+    assert np.array_equal(b, a)
+
+
+def test_add_at():
+    np.random.seed(7)
+    rows = np.random.randint(0, 20, size=500)
+    cols = np.random.randint(0, 10, size=500)
+    values = np.random.random(500)
+
+    a = np.ones((20, 10))
+    b = num.array(a)
+    np.add.at(a, (rows, cols), values)
+    num.add.at(b, (num.array(rows), num.array(cols)), num.array(values))
+    assert np.allclose(b, a)
+
+    c = np.zeros(20, dtype=np.int64)
+    d = num.array(c)
+    np.maximum.at(c, rows, cols)
+    num.maximum.at(d, num.array(rows), num.array(cols))
+    assert np.array_equal(d, c)
+
+
+if __name__ == "__main__":
+    test_gather()
+    test_scatter()
+    test_add_at()
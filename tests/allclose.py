@@ -0,0 +1,57 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+
+import numpy as np
+
+import cunumeric as num
+
+
+def test_allclose():
+    npa = np.random.rand(100000)
+    a = num.array(npa)
+    b = num.array(npa + 1e-9)
+    assert num.allclose(a, b)
+    assert not num.allclose(a, b, rtol=0.0, atol=1e-12)
+
+    # Mismatches anywhere in the arrays, which stop the comparison early
+    for index in (0, 50000, 99999):
+        npb = npa.copy()
+        npb[index] += 1.0
+        assert not num.allclose(a, num.array(npb))
+        assert num.allclose(a, num.array(npb), atol=2.0)
+
+    # Non-contiguous views
+    npm = np.random.rand(300, 300)
+    m = num.array(npm)
+    assert num.allclose(m[::2, 1:], npm[::2, 1:])
+    npn = npm.copy()
+    npn[298, 299] = -1.0
+    assert not num.allclose(m[::2, 1:], npn[::2, 1:])
+
+
+def test_array_equal():
+    npa = np.arange(100000)
+    a = num.array(npa)
+    assert num.array_equal(a, num.array(npa))
+    for index in (0, 77777, 99999):
+        npb = npa.copy()
+        npb[index] = -1
+        assert not num.array_equal(a, num.array(npb))
+
+
+if __name__ == "__main__":
+    test_allclose()
+    test_array_equal()
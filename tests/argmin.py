@@ -28,6 +28,19 @@ def test():
     assert np.array_equal(num.argmax(a, axis=0), np.argmax(anp, axis=0))
     assert np.array_equal(num.argmax(a, axis=1), np.argmax(anp, axis=1))
 
+    # Single precision and 32-bit integers, with many ties that must resolve
+    # to the first occurrence like in NumPy
+    for dtype in (np.float32, np.int32):
+        bnp = np.random.randint(-3, 3, size=(64, 257)).astype(dtype)
+        b = num.array(bnp)
+        for axis in (0, 1):
+            assert np.array_equal(
+                num.argmin(b, axis=axis), np.argmin(bnp, axis=axis)
+            )
+            assert np.array_equal(
+                num.argmax(b, axis=axis), np.argmax(bnp, axis=axis)
+            )
+
     return
 
 
@@ -0,0 +1,62 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+
+import cunumeric as num
+
+
+def test():
+    # Lengths that leave a tail after the vector loops
+    for n in (1, 7, 8, 17, 1001):
+        npf = (np.random.rand(n) - 0.5) * 1000.0
+        npf = npf.astype(np.float32)
+        for src, dst in (
+            (np.float32, np.float16),
+            (np.float16, np.float32),
+            (np.float16, np.float64),
+            (np.float64, np.float16),
+            (np.float16, np.int32),
+            (np.int64, np.float32),
+        ):
+            npa = npf.astype(src)
+            a = num.array(npa)
+            assert np.array_equal(a.astype(dst), npa.astype(dst))
+
+    # Values that round differently or do not fit in a half
+    npa = np.array(
+        [0.0, -0.0, 65504.0, 65520.0, 1e-8, 2049.0, 2051.0, np.inf, -np.inf],
+        dtype=np.float32,
+    )
+    a = num.array(npa)
+    assert np.array_equal(a.astype(np.float16), npa.astype(np.float16))
+    b = num.array(npa.astype(np.float16))
+    assert np.array_equal(b.astype(np.float32), npa.astype(np.float16))
+
+    npn = np.array([np.nan], dtype=np.float32)
+    assert np.isnan(num.array(npn).astype(np.float16)[0])
+
+    # Views are not dense
+    npm = np.random.rand(20, 30).astype(np.float32)
+    m = num.array(npm)
+    assert np.array_equal(
+        m[2:18, 5:25].astype(np.float16), npm[2:18, 5:25].astype(np.float16)
+    )
+
+    return
+
+
+if __name__ == "__main__":
+    test()
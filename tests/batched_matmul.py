@@ -0,0 +1,63 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+
+import cunumeric as num
+
+
+def check(a_shape, b_shape, dtype=np.float64):
+    np.random.seed(42)
+    a_np = np.random.randn(*a_shape).astype(dtype)
+    b_np = np.random.randn(*b_shape).astype(dtype)
+
+    a_num = num.array(a_np)
+    b_num = num.array(b_np)
+
+    out_np = np.matmul(a_np, b_np)
+    out_num = num.matmul(a_num, b_num)
+    assert out_np.shape == out_num.shape
+
+    rtol = 1e-2 if dtype == np.float16 else 1e-5
+    assert np.allclose(out_np, out_num, rtol=rtol, atol=rtol)
+    assert np.allclose(a_np @ b_np, a_num @ b_num, rtol=rtol, atol=rtol)
+
+
+def test():
+    # Enough matrices to split the batch across processors
+    check((64, 17, 9), (64, 9, 13))
+    check((64, 17, 9), (64, 9, 13), np.float32)
+    check((64, 17, 9), (64, 9, 13), np.float16)
+    # Several batch dimensions with broadcasting between them
+    check((4, 1, 8, 5), (6, 5, 7))
+    check((3, 4, 8, 5), (5, 7))
+    # Vectors on either side
+    check((9,), (32, 9, 6))
+    check((32, 6, 9), (9,))
+    # Transposed operands
+    a = np.random.randn(32, 9, 12)
+    b = np.random.randn(32, 7, 9)
+    out_np = np.matmul(a.transpose(0, 2, 1), b.transpose(0, 2, 1))
+    out_num = num.matmul(
+        num.array(a).transpose(0, 2, 1), num.array(b).transpose(0, 2, 1)
+    )
+    assert np.allclose(out_np, out_num)
+    # Many small independent matrix-vector products
+    check((256, 6, 6), (256, 6, 1))
+    check((256, 6, 6), (256, 6, 1), np.float32)
+
+
+if __name__ == "__main__":
+    test()
@@ -0,0 +1,57 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+
+import cunumeric as num
+
+
+def test():
+    npa = np.random.rand(100)
+    npb = np.random.rand(100)
+
+    a = num.array(npa)
+    b = num.array(npb)
+
+    a += b
+    npa += npb
+    assert np.allclose(a, npa)
+
+    a *= 2.0
+    npa *= 2.0
+    assert np.allclose(a, npa)
+
+    a -= a
+    npa -= npa
+    assert np.allclose(a, npa)
+
+    npx = np.random.rand(10, 10)
+    x = num.array(npx)
+    x[2:5] /= x[5:8]
+    npx[2:5] /= npx[5:8]
+    assert np.allclose(x, npx)
+
+    # The output type differs from the input, so this cannot be in place
+    npi = np.arange(10, dtype=np.int64)
+    i = num.array(npi)
+    f = num.zeros(10)
+    num.add(i, 1, out=f)
+    assert np.allclose(f, npi + 1)
+
+    return
+
+
+if __name__ == "__main__":
+    test()
@@ -0,0 +1,69 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+
+import numpy as np
+
+import cunumeric as num
+
+
+def test():
+    npi32 = np.arange(1, 1001, dtype=np.int32)
+    npi64 = np.arange(1000, 0, -1, dtype=np.int64)
+    npf32 = np.random.rand(1000).astype(np.float32)
+    npf64 = np.random.rand(1000)
+
+    i32 = num.array(npi32)
+    i64 = num.array(npi64)
+    f32 = num.array(npf32)
+    f64 = num.array(npf64)
+
+    # Promotions in either operand position
+    assert np.array_equal(i32 + i64, npi32 + npi64)
+    assert np.array_equal(i64 - i32, npi64 - npi32)
+    assert np.allclose(i32 * f64, npi32 * npf64)
+    assert np.allclose(f64 / i64, npf64 / npi64)
+    assert np.allclose(f32 * f64, npf32 * npf64)
+    assert np.allclose(f64 - f32, npf64 - npf32)
+    assert np.array_equal(i32 < f64, npi32 < npf64)
+    assert np.array_equal(f32 >= f64, npf32 >= npf64)
+
+    # Non-contiguous operands
+    assert np.allclose(i32[::2] + f64[1::2], npi32[::2] + npf64[1::2])
+
+    # Pairs without an in-task promotion still go through a conversion
+    assert np.allclose(i32 + f32, npi32 + npf32)
+
+    # Narrow unsigned operands, like the pixels of images
+    npu8 = np.random.randint(0, 256, size=1000).astype(np.uint8)
+    npu16 = np.random.randint(0, 65536, size=1000).astype(np.uint16)
+    u8 = num.array(npu8)
+    u16 = num.array(npu16)
+    assert np.array_equal(u8 + i32, npu8 + npi32)
+    assert np.array_equal(i64 - u16, npi64 - npu16)
+    assert np.allclose(u16 * f32, npu16 * npf32)
+    assert np.allclose(f64 / (u8 + f32), npf64 / (npu8 + npf32))
+    assert np.array_equal(u16 > f64, npu16 > npf64)
+
+    # In-place update with a narrower right-hand side
+    f64 += i32
+    npf64 += npi32
+    assert np.allclose(f64, npf64)
+
+    return
+
+
+if __name__ == "__main__":
+    test()
@@ -0,0 +1,107 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+
+import cunumeric as num
+
+
+def test():
+    npa = np.random.rand(1000)
+    a = num.array(npa)
+
+    assert np.allclose(a * 0.5 + 1, npa * 0.5 + 1)
+    assert np.allclose(2.0 - a, 2.0 - npa)
+    assert np.allclose(3.0 / (a + 1), 3.0 / (npa + 1))
+    assert np.allclose(a ** 2, npa ** 2)
+    assert np.array_equal(a > 0.5, npa > 0.5)
+    assert np.array_equal(0.5 >= a, 0.5 >= npa)
+
+    npi = np.arange(1000, dtype=np.int32)
+    i = num.array(npi)
+    assert np.array_equal(i % 7, npi % 7)
+    assert np.array_equal(100 // (i + 1), 100 // (npi + 1))
+
+    # In-place updates with a scalar operand
+    a *= 2.0
+    npa *= 2.0
+    assert np.allclose(a, npa)
+    i += 3
+    npi += 3
+    assert np.array_equal(i, npi)
+
+    # Scalars that are results of reductions
+    s = a.sum()
+    assert np.allclose(a - s, npa - npa.sum())
+
+    return
+
+
+def test_scalar_fast_paths():
+    # Small integer exponents and positive integer divisors take cheaper
+    # forms of the op, which must agree with NumPy including for negative
+    # dividends
+    npa = np.random.rand(1000) * 4 - 2
+    a = num.array(npa)
+    for exponent in (2, 3, 4, 5):
+        assert np.allclose(a ** exponent, npa ** exponent)
+        assert np.allclose(
+            a.astype(np.float32) ** exponent,
+            npa.astype(np.float32) ** exponent,
+        )
+
+    for dtype in (np.int8, np.int16, np.int32, np.int64, np.uint32):
+        npi = np.arange(-500, 500).astype(dtype)
+        i = num.array(npi)
+        assert np.array_equal(i ** 3, npi ** 3)
+        for divisor in (1, 3, 7, 64, 100):
+            d = dtype(divisor)
+            assert np.array_equal(i // d, npi // d)
+            assert np.array_equal(i % d, npi % d)
+        # Negative divisors and array divisors keep the general op
+        if np.issubdtype(dtype, np.signedinteger):
+            d = dtype(-7)
+            assert np.array_equal(i // d, npi // d)
+            assert np.array_equal(i % d, npi % d)
+            npj = np.where(npi == 0, 1, npi)
+            j = num.array(npj)
+            assert np.array_equal(i // j[::-1], npi // npj[::-1])
+            assert np.array_equal(i % j[::-1], npi % npj[::-1])
+
+    return
+
+
+def test_reduction_results():
+    # Arithmetic on the results of reductions stays deferred and must only
+    # produce the right value once Python asks for it
+    npa = np.random.rand(1000)
+    a = num.array(npa)
+
+    s = a.sum()
+    m = a.max()
+    r = (s - m) / 2.0 + s * m
+    npr = (npa.sum() - npa.max()) / 2.0 + npa.sum() * npa.max()
+    assert np.allclose(r, npr)
+    assert np.allclose(num.sqrt(s), np.sqrt(npa.sum()))
+    assert bool(s > m) == bool(npa.sum() > npa.max())
+    assert np.allclose(float(r), float(npr))
+
+    return
+
+
+if __name__ == "__main__":
+    test()
+    test_scalar_fast_paths()
+    test_reduction_results()
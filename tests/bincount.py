@@ -38,5 +38,45 @@ def test(n):
     return
 
 
+def test_weight_types(n):
+    v_num = num.random.randint(0, 9, size=n, dtype=np.int64)
+    v_np = v_num.__array__()
+    for dtype in [np.float32, np.int32, np.int64, np.int8]:
+        print(dtype)
+        w_num = (num.random.randn(n) * 100).astype(dtype)
+        w_np = w_num.__array__()
+
+        out_np = np.bincount(v_np, weights=w_np)
+        out_num = num.bincount(v_num, weights=w_num)
+        assert out_num.dtype == out_np.dtype
+        assert num.allclose(out_np, out_num, rtol=1e-4)
+
+    return
+
+
+def test_large_bins(n):
+    # Enough bins for the output to be partitioned across the processors
+    num_bins = 1 << 21
+    for dtype, high in [(np.int64, num_bins), (np.int16, 1 << 15)]:
+        print(dtype)
+        v_num = num.random.randint(0, high, size=n, dtype=dtype)
+        w_num = num.random.randn(n)
+
+        v_np = v_num.__array__()
+        w_np = w_num.__array__()
+
+        out_np = np.bincount(v_np, minlength=num_bins)
+        out_num = num.bincount(v_num, minlength=num_bins)
+        assert num.array_equal(out_np, out_num)
+
+        out_np = np.bincount(v_np, weights=w_np, minlength=num_bins)
+        out_num = num.bincount(v_num, weights=w_num, minlength=num_bins)
+        assert num.allclose(out_np, out_num)
+
+    return
+
+
 if __name__ == "__main__":
     test(8000)
+    test_weight_types(8000)
+    test_large_bins(100000)
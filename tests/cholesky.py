@@ -16,6 +16,7 @@
 import numpy as np
 
 import cunumeric as num
+from cunumeric.runtime import runtime
 
 
 def test_diagonal():
@@ -46,8 +47,78 @@ def test_complex(n):
     assert num.allclose(c, c_np)
 
 
+def test_single_task(n):
+    # Test mode always tiles the matrix, so turn it off to factor the
+    # matrix with a single POTRF task
+    test_mode = runtime.test_mode
+    min_size = runtime.min_cholesky_matrix_size
+    runtime.test_mode = False
+    runtime.min_cholesky_matrix_size = n
+    try:
+        test_real(n)
+        test_complex(n)
+    finally:
+        runtime.test_mode = test_mode
+        runtime.min_cholesky_matrix_size = min_size
+
+
+def test_info(n):
+    a = num.random.rand(n, n)
+    b = a + a.T + num.eye(n) * n
+    info = num.ones((), dtype=np.int32)
+    num.linalg.cholesky(b, info=info)
+    assert int(info) == 0
+
+    # Not positive definite
+    info = num.zeros((), dtype=np.int64)
+    num.linalg.cholesky(-b, info=info)
+    assert int(info) != 0
+
+
+def test_solve(n):
+    a = num.random.rand(n, n)
+    b = a + a.T + num.eye(n) * n
+    rhs = num.random.rand(n, 3)
+    x_np = np.linalg.solve(b.__array__(), rhs.__array__())
+    assert num.allclose(num.linalg.cholesky_solve(b, rhs), x_np)
+
+    # Factored in single precision and refined to double precision
+    x = num.linalg.cholesky_solve(b, rhs[:, 0], factor_dtype=np.float32)
+    assert x.dtype == np.float64
+    assert num.allclose(x, x_np[:, 0], rtol=1e-12, atol=1e-12)
+
+
+def test_cho_solve(n):
+    a = num.random.rand(n, n)
+    b = a + a.T + num.eye(n) * n
+    c = num.linalg.cholesky(b)
+    b_np = b.__array__()
+    for rhs in (num.random.rand(n), num.random.rand(n, 5)):
+        x = num.linalg.cho_solve(c, rhs)
+        assert num.allclose(x, np.linalg.solve(b_np, rhs.__array__()))
+
+
+def test_triangular(n):
+    a = num.random.rand(n, n)
+    b = a + a.T + num.eye(n) * n
+    c = num.linalg.cholesky(b)
+    # Solving against the factor doesn't need its upper triangle cleared
+    rhs = num.random.rand(n)
+    c_np = np.linalg.cholesky(b.__array__())
+    x = num.linalg.solve(c, rhs)
+    assert num.allclose(x, np.linalg.solve(c_np, rhs.__array__()))
+    # Anything else sees zeros above the diagonal
+    assert num.allclose(c, c_np)
+    assert num.allclose(c.T @ x, c_np.T @ x.__array__())
+
+
 if __name__ == "__main__":
     test_diagonal()
     for size in [8, 9, 255, 512]:
         test_real(size)
         test_complex(size)
+        test_single_task(size)
+        test_info(size)
+        test_solve(size)
+        test_cho_solve(size)
+        test_triangular(size)
@@ -38,6 +38,33 @@ def test():
         assert num.array_equal(x_np.real, x_num.real)
         assert num.array_equal(x_np.imag, x_num.imag)
 
+        # Squared magnitudes and products with a conjugate
+        z_np = (np.random.rand(100) + 1j * np.random.rand(100)).astype(ty)
+        w_np = (np.random.rand(100) + 1j * np.random.rand(100)).astype(ty)
+        z_num = num.array(z_np)
+        w_num = num.array(w_np)
+
+        abs2 = num.abs2(z_num)
+        assert abs2.dtype == np.abs(z_np).dtype
+        assert np.allclose(abs2, np.abs(z_np) ** 2, rtol=1e-5)
+        assert np.allclose(num.mul_conj(z_num, w_num), z_np * np.conj(w_np))
+        assert np.allclose(z_num * w_num, z_np * w_np)
+
+        # Complex matrix products, which go to a GEMM
+        a_np = (np.random.rand(8, 5) + 1j * np.random.rand(8, 5)).astype(ty)
+        b_np = (np.random.rand(5, 6) + 1j * np.random.rand(5, 6)).astype(ty)
+        assert np.allclose(
+            num.einsum("ik,kj->ij", num.array(a_np), num.array(b_np)),
+            np.einsum("ik,kj->ij", a_np, b_np),
+            rtol=1e-4,
+        )
+
+    # Real inputs
+    r_np = np.random.rand(100)
+    r_num = num.array(r_np)
+    assert np.allclose(num.abs2(r_num), r_np * r_np)
+    assert np.allclose(num.mul_conj(r_num, r_num), r_np * r_np)
+
 
 if __name__ == "__main__":
     test()
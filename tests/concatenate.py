@@ -0,0 +1,70 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+
+import cunumeric as num
+
+
+def test():
+    npa = np.random.rand(10, 20)
+    npb = np.random.rand(5, 20)
+    npc = np.random.rand(10, 3)
+    a = num.array(npa)
+    b = num.array(npb)
+    c = num.array(npc)
+
+    assert np.array_equal(
+        num.concatenate((a, b, a)), np.concatenate((npa, npb, npa))
+    )
+    assert np.array_equal(
+        num.concatenate((a, c), axis=1), np.concatenate((npa, npc), axis=1)
+    )
+    assert np.array_equal(
+        num.concatenate((a, c), axis=-1), np.concatenate((npa, npc), axis=-1)
+    )
+    assert np.array_equal(
+        num.concatenate((a, b), axis=None), np.concatenate((npa, npb), None)
+    )
+
+    # Views, empty arrays and single elements
+    assert np.array_equal(
+        num.concatenate((a[2:7, 5:], b[:0, 5:], b[1:, 5:])),
+        np.concatenate((npa[2:7, 5:], npb[:0, 5:], npb[1:, 5:])),
+    )
+    assert np.array_equal(
+        num.concatenate((num.array([1.0]), num.arange(4.0))),
+        np.concatenate((np.array([1.0]), np.arange(4.0))),
+    )
+
+    # Mixed types are promoted
+    npi = np.arange(20).reshape(1, 20)
+    i = num.array(npi)
+    assert np.array_equal(num.concatenate((i, a)), np.concatenate((npi, npa)))
+
+    # The result does not alias the inputs
+    d = num.concatenate((a, b))
+    d[0, 0] = -1.0
+    assert np.array_equal(a, npa)
+
+    out = num.zeros((15, 20))
+    num.concatenate((a, b), out=out)
+    assert np.array_equal(out, np.concatenate((npa, npb)))
+
+    return
+
+
+if __name__ == "__main__":
+    test()
@@ -60,7 +60,179 @@ def test_3d():
     assert num.allclose(out, out_np)
 
 
+def test_2d_large_filter():
+    # Big enough for the filter to be applied in the frequency domain
+    a = num.random.rand(256, 256)
+    v = num.random.rand(31, 31)
+
+    anp = a.__array__()
+    vnp = v.__array__()
+
+    out = num.convolve(a, v, mode="same")
+    out_np = sig.convolve(anp, vnp, mode="same")
+
+    assert num.allclose(out, out_np)
+
+
+def test_2d_separable_filter():
+    # A Gaussian blur factors into one filter per dimension
+    a = num.random.rand(128, 128)
+    g = np.exp(-np.linspace(-2, 2, 15) ** 2)
+    v = num.array(np.outer(g, g))
+
+    anp = a.__array__()
+    vnp = v.__array__()
+
+    out = num.convolve(a, v, mode="same")
+    out_np = sig.convolve(anp, vnp, mode="same")
+
+    assert num.allclose(out, out_np)
+
+
+def test_2d_complex():
+    anp = np.random.rand(64, 64) + 1j * np.random.rand(64, 64)
+    vnp = np.random.rand(17, 17) + 1j * np.random.rand(17, 17)
+
+    a = num.array(anp)
+    v = num.array(vnp)
+
+    out = num.convolve(a, v, mode="same")
+    out_np = sig.convolve(anp, vnp, mode="same")
+
+    assert num.allclose(out, out_np)
+
+
+def test_2d_int():
+    # Integer convolutions stay exact
+    anp = np.random.randint(-10, 10, size=(32, 32))
+    vnp = np.random.randint(-10, 10, size=(5, 5))
+
+    a = num.array(anp)
+    v = num.array(vnp)
+
+    out = num.convolve(a, v, mode="same")
+    out_np = sig.convolve(anp, vnp, mode="same")
+
+    assert num.array_equal(out, out_np)
+
+
+def test_batched_1d():
+    # Each row is convolved with the same filter
+    anp = np.random.rand(64, 100)
+    vnp = np.random.rand(9)
+
+    a = num.array(anp)
+    v = num.array(vnp)
+
+    out = num.convolve(a, v, mode="same")
+    out_np = np.stack([np.convolve(row, vnp, mode="same") for row in anp])
+
+    assert num.allclose(out, out_np)
+
+
+def test_batched_2d():
+    anp = np.random.rand(8, 32, 32)
+    vnp = np.random.rand(5, 3)
+
+    a = num.array(anp)
+    v = num.array(vnp)
+
+    out = num.convolve(a, v, mode="same")
+    out_np = sig.convolve(anp, vnp[np.newaxis], mode="same")
+
+    assert num.allclose(out, out_np)
+
+
+def test_out():
+    # Iterations alternate between two preallocated buffers
+    anp = np.random.rand(64, 64)
+    vnp = np.random.rand(5, 5)
+
+    a = num.array(anp)
+    v = num.array(vnp)
+    b = num.empty_like(a)
+
+    result = num.convolve(a, v, mode="same", out=b)
+    num.convolve(b, v, mode="same", out=a)
+    out_np = sig.convolve(
+        sig.convolve(anp, vnp, mode="same"), vnp, mode="same"
+    )
+
+    assert result is b
+    assert num.allclose(a, out_np)
+
+
+def _dilate(v, dilation):
+    shape = tuple((extent - 1) * dilation + 1 for extent in v.shape)
+    result = np.zeros(shape, dtype=v.dtype)
+    result[(slice(None, None, dilation),) * v.ndim] = v
+    return result
+
+
+def test_2d_dilated():
+    a = num.random.rand(20, 20)
+    v = num.random.rand(3, 4)
+
+    anp = a.__array__()
+    vnp = v.__array__()
+
+    out = num.convolve(a, v, mode="same", dilation=2)
+    out_np = sig.convolve(anp, _dilate(vnp, 2), mode="same")
+
+    assert num.allclose(out, out_np)
+
+
+def test_2d_strided():
+    a = num.random.rand(21, 20)
+    v = num.random.rand(3, 5)
+
+    anp = a.__array__()
+    vnp = v.__array__()
+
+    out = num.convolve(a, v, mode="same", stride=2, dilation=(1, 2))
+    dilated = np.zeros((3, 9), dtype=vnp.dtype)
+    dilated[:, ::2] = vnp
+    out_np = sig.convolve(anp, dilated, mode="same")[::2, ::2]
+
+    assert out.shape == (11, 10)
+    assert num.allclose(out, out_np)
+
+
+def test_correlate():
+    a = num.random.rand(100)
+    v = num.random.rand(6)
+
+    anp = a.__array__()
+    vnp = v.__array__()
+
+    out = num.correlate(a, v, mode="same")
+    out_np = np.correlate(anp, vnp, mode="same")
+
+    assert num.allclose(out, out_np)
+
+    a = num.random.rand(12, 12) + 1j * num.random.rand(12, 12)
+    v = num.random.rand(3, 4) + 1j * num.random.rand(3, 4)
+
+    anp = a.__array__()
+    vnp = v.__array__()
+
+    out = num.correlate(a, v, mode="same")
+    out_np = sig.correlate(anp, vnp, mode="same")
+
+    assert num.allclose(out, out_np)
+
+
 if __name__ == "__main__":
     test_1d()
     test_2d()
     test_3d()
+    test_2d_large_filter()
+    test_2d_separable_filter()
+    test_2d_complex()
+    test_2d_int()
+    test_batched_1d()
+    test_batched_2d()
+    test_out()
+    test_2d_dilated()
+    test_2d_strided()
+    test_correlate()
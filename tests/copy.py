@@ -32,5 +32,28 @@ def test():
     return
 
 
+def test_temporaries():
+    anp = np.arange(12).reshape(3, 4)
+    a = num.array(anp)
+
+    b = (a + 1).copy()
+    b[0, 0] = -1
+    assert np.array_equal(a, anp)
+    assert b[0, 0] == -1
+    assert np.array_equal(b[1:], anp[1:] + 1)
+
+    # Copies of arrays that are still visible elsewhere stay copies
+    t = a + 1
+    v = t[1:]
+    c = t.copy()
+    c[1, 0] = -1
+    assert v[0, 0] == anp[1, 0] + 1
+
+    d = (a + 1)[1:].copy()
+    d[0, 0] = -1
+    assert np.array_equal(a, anp)
+
+
 if __name__ == "__main__":
     test()
+    test_temporaries()
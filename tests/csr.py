@@ -0,0 +1,63 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+
+import cunumeric as num
+
+
+def test():
+    np.random.seed(42)
+    dense = np.random.rand(300, 200)
+    dense[dense < 0.9] = 0.0
+    # Rows of very different lengths, including empty ones
+    dense[:20] = np.random.rand(20, 200)
+    dense[100:150] = 0.0
+    a = num.sparse.csr_matrix(dense)
+    assert a.shape == dense.shape
+    assert a.nnz == np.count_nonzero(dense)
+    assert np.array_equal(a.toarray(), dense)
+
+    xnp = np.random.rand(200)
+    x = num.array(xnp)
+    assert np.allclose(a.dot(x), dense.dot(xnp))
+    assert np.allclose(a @ x, dense @ xnp)
+    assert np.allclose(num.dot(a, x), dense.dot(xnp))
+
+    bnp = np.random.rand(200, 7)
+    b = num.array(bnp)
+    assert np.allclose(a.dot(b), dense.dot(bnp))
+    out = num.zeros((300, 7))
+    num.matmul(a, b, out=out)
+    assert np.allclose(out, dense @ bnp)
+
+    # The same matrix from its CSR arrays, multiplied with an integer vector
+    indptr = np.concatenate(([0], np.cumsum(np.count_nonzero(dense, 1))))
+    rows, cols = np.nonzero(dense)
+    c = num.sparse.csr_matrix(
+        (dense[rows, cols], cols, indptr), shape=dense.shape
+    )
+    inp = np.arange(200)
+    assert np.allclose(c.dot(num.array(inp)), dense.dot(inp))
+
+    # Composes with dense operations
+    y = 2.0 * a.dot(x) + 1.0
+    assert np.allclose(y, 2.0 * dense.dot(xnp) + 1.0)
+
+    return
+
+
+if __name__ == "__main__":
+    test()
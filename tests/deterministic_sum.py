@@ -0,0 +1,52 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+
+import cunumeric as num
+from cunumeric.runtime import runtime
+
+
+def test():
+    saved = runtime.deterministic
+    runtime.deterministic = True
+
+    np.random.seed(7)
+    # Large enough not to be handled eagerly by NumPy
+    rows = max(1000, 2 * runtime.max_eager_volume // 33 + 1)
+    for dtype in (np.float32, np.float64):
+        anp = (np.random.randn(rows, 33) * 1e4).astype(dtype)
+        a = num.array(anp)
+
+        total = num.sum(a)
+        assert np.allclose(total, np.sum(anp.astype(np.float64)), rtol=1e-5)
+        # The bits do not depend on the order of the values
+        perm = np.random.permutation(anp.size)
+        shuffled = num.array(anp.reshape(-1)[perm])
+        assert num.sum(shuffled).tobytes() == total.tobytes()
+
+        for axis in (0, 1):
+            assert np.allclose(
+                num.sum(a, axis=axis), np.sum(anp, axis=axis), rtol=1e-5
+            )
+        assert np.allclose(
+            num.sum(a, initial=5), np.sum(anp, initial=5), rtol=1e-5
+        )
+
+    runtime.deterministic = saved
+
+
+if __name__ == "__main__":
+    test()
@@ -76,5 +76,23 @@ def test():
     return
 
 
+def test_construct():
+    # Matrices large enough to have pieces away from the diagonal
+    for k in (0, 3, -5, 250):
+        vn = np.random.rand(300)
+        v = num.array(vn)
+        m = num.diag(v, k=k)
+        assert np.array_equal(m, np.diag(vn, k=k))
+
+    for k in (0, 7, -7):
+        e = num.eye(200, 150, k=k)
+        assert np.array_equal(e, np.eye(200, 150, k=k))
+        e[0, 0] = 5.0
+        en = np.eye(200, 150, k=k)
+        en[0, 0] = 5.0
+        assert np.array_equal(e, en)
+
+
 if __name__ == "__main__":
     test()
+    test_construct()
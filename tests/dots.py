@@ -0,0 +1,55 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+
+import cunumeric as num
+
+
+def test():
+    np.random.seed(42)
+    rnp = np.random.randn(1000)
+    pnp = np.random.randn(1000)
+    qnp = np.random.randn(1000)
+    r = num.array(rnp)
+    p = num.array(pnp)
+    q = num.array(qnp)
+
+    rr, pq = num.dots((r, r), (p, q))
+    assert np.allclose(rr, rnp.dot(rnp))
+    assert np.allclose(pq, pnp.dot(qnp))
+
+    # More pairs than a single launch computes, sharing vectors across them
+    pairs = [(r, p), (p, q), (q, r), (r, r), (p, p), (q, q)]
+    expected = [(rnp, pnp), (pnp, qnp), (qnp, rnp)]
+    expected += [(rnp, rnp), (pnp, pnp), (qnp, qnp)]
+    for (out, (a, b)) in zip(num.dots(*pairs), expected):
+        assert np.allclose(out, a.dot(b))
+
+    # Mixed types promote to a common type
+    inp = np.arange(1000)
+    (out,) = num.dots((num.array(inp), r))
+    assert np.allclose(out, inp.dot(rnp))
+
+    hnp = rnp.astype(np.float16)
+    h = num.array(hnp)
+    (out,) = num.dots((h, h))
+    assert np.allclose(out, hnp.dot(hnp), rtol=1e-2)
+
+    return
+
+
+if __name__ == "__main__":
+    test()
@@ -227,5 +227,26 @@ def test():
         )
 
 
+def test_plans():
+    # A chain whose cost depends heavily on the order of the contractions
+    expr = "ab,bc,cd,d->a"
+    np_inputs = [
+        np.random.rand(40, 200),
+        np.random.rand(200, 5),
+        np.random.rand(5, 300),
+        np.random.rand(300),
+    ]
+    cn_inputs = [cn.array(x) for x in np_inputs]
+    np_res = np.einsum(expr, *np_inputs)
+    # Repeated expressions reuse their plan
+    for _ in range(3):
+        assert np.allclose(np_res, cn.einsum(expr, *cn_inputs))
+    for optimize in (True, "greedy", ["einsum_path", (0, 1), (0, 1), (0, 1)]):
+        assert np.allclose(
+            np_res, cn.einsum(expr, *cn_inputs, optimize=optimize)
+        )
+
+
 if __name__ == "__main__":
     test()
+    test_plans()
@@ -38,5 +38,34 @@ def test():
     return
 
 
+def test_structured():
+    n = 100
+    anp = np.random.rand(n, n)
+    vnp = np.random.rand(n)
+    a = num.array(anp)
+    v = num.array(vnp)
+
+    # Sums and products with identities and diagonal matrices only touch
+    # the diagonal of the other operand
+    assert np.allclose(a + 0.5 * num.eye(n), anp + 0.5 * np.eye(n))
+    assert np.allclose(a - num.eye(n, k=1), anp - np.eye(n, k=1))
+    assert np.allclose(num.diag(v) + a, np.diag(vnp) + anp)
+    b = a.copy()
+    b += 2.0 * num.eye(n)
+    assert np.allclose(b, anp + 2.0 * np.eye(n))
+
+    assert np.allclose(num.diag(v) @ a, np.diag(vnp) @ anp)
+    assert np.allclose(a @ num.diag(v), anp @ np.diag(vnp))
+    assert np.allclose(num.diag(v) @ v, vnp * vnp)
+    assert np.allclose((3.0 * num.eye(n)) @ a, 3.0 * anp)
+
+    # The matrices are still written out when read directly
+    d = num.diag(v)
+    v[0] = -1.0
+    assert np.array_equal(d, np.diag(vnp))
+    assert np.array_equal(2.0 * num.eye(n, k=-1), 2.0 * np.eye(n, k=-1))
+
+
 if __name__ == "__main__":
     test()
+    test_structured()
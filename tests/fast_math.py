@@ -0,0 +1,69 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+
+import cunumeric as num
+from cunumeric.runtime import runtime
+
+
+def check(fn, anp, *args):
+    a = num.array(anp)
+    expected = getattr(np, fn)(anp.astype(np.float64), *args)
+    # The fast variants are only good to a few ULPs, or 2^-21 absolute
+    # for sin and cos on the GPU
+    for fast_math in (True, False):
+        out = getattr(num, fn)(a, *args, fast_math=fast_math)
+        assert out.dtype == np.float32
+        assert np.allclose(out, expected, rtol=1e-5, atol=1e-6)
+    # Without the keyword the runtime default applies
+    out = getattr(num, fn)(a, *args)
+    assert np.allclose(out, expected, rtol=1e-5, atol=1e-6)
+
+
+def test():
+    saved = runtime.fast_math
+
+    np.random.seed(11)
+    # Large enough not to be handled eagerly by NumPy
+    size = max(1000, 2 * runtime.max_eager_volume + 1)
+    x = np.random.uniform(-3, 3, size).astype(np.float32)
+    positive = np.random.uniform(0.01, 10, size).astype(np.float32)
+    for enabled in (True, False):
+        runtime.fast_math = enabled
+        for fn in ("exp", "sin", "cos", "tanh"):
+            check(fn, x)
+        check("log", positive)
+        check("power", positive, np.float32(1.7))
+
+    # Special values come out as with the precise functions
+    specials = np.array([0, -0.0, np.inf, -np.inf, np.nan], dtype=np.float32)
+    specials = np.tile(specials, size // specials.size + 1)
+    for fn in ("exp", "log", "sin", "cos", "tanh"):
+        with np.errstate(all="ignore"):
+            expected = getattr(np, fn)(specials)
+        out = getattr(num, fn)(num.array(specials), fast_math=True)
+        assert np.array_equal(out, expected, equal_nan=True)
+
+    # Double precision ignores the request
+    xd = x.astype(np.float64)
+    out = num.exp(num.array(xd), fast_math=True)
+    assert np.allclose(out, np.exp(xd), rtol=1e-14)
+
+    runtime.fast_math = saved
+
+
+if __name__ == "__main__":
+    test()
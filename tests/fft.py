@@ -0,0 +1,83 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+
+import cunumeric as num
+
+
+def test_1d():
+    np.random.seed(42)
+    # A power of two and sizes that need the chirp transform
+    for n in (64, 100, 127):
+        a = np.random.rand(n) + 1j * np.random.rand(n)
+        b = num.array(a)
+        assert np.allclose(num.fft.fft(b), np.fft.fft(a))
+        assert np.allclose(num.fft.ifft(b), np.fft.ifft(a))
+        assert np.allclose(num.fft.fft(b, n=n // 2), np.fft.fft(a, n=n // 2))
+        assert np.allclose(num.fft.fft(b, n=2 * n), np.fft.fft(a, n=2 * n))
+        for norm in ("backward", "ortho", "forward"):
+            assert np.allclose(
+                num.fft.ifft(b, norm=norm), np.fft.ifft(a, norm=norm)
+            )
+
+        r = a.real
+        assert np.allclose(num.fft.rfft(num.array(r)), np.fft.rfft(r))
+        c = np.fft.rfft(r)
+        assert np.allclose(num.fft.irfft(num.array(c)), np.fft.irfft(c))
+        assert np.allclose(
+            num.fft.irfft(num.array(c), n=n), np.fft.irfft(c, n=n)
+        )
+
+
+def test_nd():
+    np.random.seed(42)
+    a = np.random.rand(12, 17, 8) + 1j * np.random.rand(12, 17, 8)
+    b = num.array(a)
+    # All the axes, which takes two steps, and batches of lines
+    assert np.allclose(num.fft.fftn(b), np.fft.fftn(a))
+    assert np.allclose(num.fft.ifftn(b), np.fft.ifftn(a))
+    assert np.allclose(num.fft.fft2(b), np.fft.fft2(a))
+    assert np.allclose(num.fft.fft(b, axis=1), np.fft.fft(a, axis=1))
+    assert np.allclose(
+        num.fft.fftn(b, axes=(2, 0)), np.fft.fftn(a, axes=(2, 0))
+    )
+    assert np.allclose(
+        num.fft.fftn(b, s=(6, 20), axes=(0, 1)),
+        np.fft.fftn(a, s=(6, 20), axes=(0, 1)),
+    )
+
+    r = a.real
+    assert np.allclose(num.fft.rfftn(num.array(r)), np.fft.rfftn(r))
+    assert np.allclose(num.fft.rfft2(num.array(r)), np.fft.rfft2(r))
+    c = np.fft.rfftn(r)
+    assert np.allclose(
+        num.fft.irfftn(num.array(c), s=r.shape), np.fft.irfftn(c, s=r.shape)
+    )
+    c = np.fft.rfft2(r, axes=(0, 1))
+    assert np.allclose(
+        num.fft.irfft2(num.array(c), axes=(0, 1)),
+        np.fft.irfft2(c, axes=(0, 1)),
+    )
+
+    # Single precision stays in single precision
+    f = num.array(r.astype(np.float32))
+    assert num.fft.rfftn(f).dtype == np.complex64
+    assert np.allclose(num.fft.rfftn(f), np.fft.rfftn(r), rtol=1e-4, atol=1e-2)
+
+
+if __name__ == "__main__":
+    test_1d()
+    test_nd()
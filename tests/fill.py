@@ -37,5 +37,58 @@ def test():
     return
 
 
+def test_constant():
+    xnp = np.random.randn(8, 6)
+    x = num.array(xnp)
+
+    # Constants as operands of element-wise operations and reductions
+    assert np.array_equal(x + num.ones((8, 6)), xnp + np.ones((8, 6)))
+    assert np.array_equal(
+        num.full((8, 6), 2.5) * x, np.full((8, 6), 2.5) * xnp
+    )
+    assert num.max(num.full((8, 6), -3.0)) == -3.0
+    assert np.array_equal(num.full((8, 6), 7).min(axis=0), np.full(6, 7))
+    assert num.count_nonzero(num.zeros((8, 6))) == 0
+    assert np.array_equal(
+        num.count_nonzero(num.ones((8, 6)), axis=1), np.full(8, 6)
+    )
+    assert bool(num.all(num.ones((8, 6))))
+
+    # Writes into a constant see the value everywhere else
+    a = num.zeros((8, 6))
+    a[2:4, 1] = 5.0
+    anp = np.zeros((8, 6))
+    anp[2:4, 1] = 5.0
+    assert np.array_equal(a, anp)
+
+    b = num.ones(10, dtype=np.int32)
+    b += num.arange(10, dtype=np.int32)
+    assert np.array_equal(b, np.arange(1, 11, dtype=np.int32))
+
+
+def test_by_value():
+    # Fill values of every type, passed by value or through a future
+    for dtype in (np.bool_, np.int8, np.uint32, np.int64, np.float32):
+        a = num.arange(24).reshape(4, 6).astype(dtype)
+        a.fill(1)
+        assert np.array_equal(a, np.ones((4, 6), dtype=dtype))
+    c = num.zeros((4, 6), dtype=np.complex64)
+    c.fill(1 - 2j)
+    assert np.array_equal(c, np.full((4, 6), 1 - 2j, dtype=np.complex64))
+
+    # Scalars tiled or repeated over an array
+    x = num.array(3.5)
+    assert np.array_equal(num.tile(x, (3, 4)), np.full((3, 4), 3.5))
+    assert np.array_equal(num.repeat(x, 5), np.full(5, 3.5))
+
+    # The same bounds in every iteration reuse their stores
+    ynp = np.random.randn(100)
+    y = num.array(ynp)
+    for _ in range(3):
+        assert np.array_equal(num.clip(y, -0.5, 0.5), np.clip(ynp, -0.5, 0.5))
+
+
 if __name__ == "__main__":
     test()
+    test_constant()
+    test_by_value()
@@ -43,5 +43,21 @@ def test():
     assert num.array_equal(b, bnp)
 
 
+def test_blocks():
+    # Extents that do not split evenly across the processors
+    for shape in ((1,), (997,), (3, 701), (101, 7)):
+        anp = np.random.random(shape)
+        a = num.array(anp)
+        for axis in (None, 0, -1):
+            assert num.array_equal(num.flip(a, axis=axis), np.flip(anp, axis))
+
+    # Views of other arrays are flipped too
+    anp = np.random.random((50, 60))
+    a = num.array(anp)
+    assert num.array_equal(num.flip(a[5:45, 3:], 1), np.flip(anp[5:45, 3:], 1))
+    assert num.array_equal(num.flip(a.T, 0), np.flip(anp.T, 0))
+
+
 if __name__ == "__main__":
     test()
+    test_blocks()
@@ -0,0 +1,69 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+
+import numpy as np
+
+import cunumeric as num
+
+
+def test():
+    npx = np.random.rand(1000)
+    npy = np.random.rand(1000)
+    npw = np.random.rand(1000)
+    x = num.array(npx)
+    y = num.array(npy)
+    w = num.array(npw)
+
+    # AXPY with a scalar coefficient on either side
+    assert np.allclose(2.5 * x + y, 2.5 * npx + npy)
+    assert np.allclose(y + x * 0.5, npy + npx * 0.5)
+
+    # Element-wise coefficients
+    assert np.allclose(x * y + w, npx * npy + npw)
+
+    # Broadcast coefficients
+    npm = np.random.rand(10, 100)
+    m = num.array(npm)
+    assert np.allclose(m * x[:100] + m, npm * npx[:100] + npm)
+
+    # In-place update of the addend
+    y += 3.0 * x
+    npy += 3.0 * npx
+    assert np.allclose(y, npy)
+
+    # The product is still valid when it is read later
+    t = x * w
+    z = t + y
+    assert np.allclose(z, npx * npw + npy)
+    assert np.allclose(t, npx * npw)
+
+    # Writing over a factor must not change a product that is still used
+    t = x * w
+    x += t
+    assert np.allclose(t, npx * npw)
+    npx += npx * npw
+    assert np.allclose(x, npx)
+
+    # Single precision
+    npf = np.random.rand(1000).astype(np.float32)
+    f = num.array(npf)
+    assert np.allclose(f * f + f, npf * npf + npf, rtol=1e-5)
+
+    return
+
+
+if __name__ == "__main__":
+    test()
@@ -0,0 +1,66 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+
+import cunumeric as num
+
+
+def check(a_shape, b_shape, dtype=np.float64, **kwargs):
+    np.random.seed(13)
+    a_np = np.random.randn(*a_shape).astype(dtype)
+    b_np = np.random.randn(*b_shape).astype(dtype)
+    n = b_shape[-1] if len(b_shape) > 1 else 1
+    bias_np = np.random.randn(n).astype(dtype)
+
+    out_np = kwargs.get("scale", 1.0) * np.matmul(a_np, b_np) + bias_np
+    activation = kwargs.get("activation")
+    if activation is not None:
+        out_np = getattr(np, activation)(out_np)
+
+    out_num = num.fused_matmul(
+        num.array(a_np), num.array(b_np), bias=num.array(bias_np), **kwargs
+    )
+    assert out_np.shape == out_num.shape
+
+    rtol = 1e-2 if dtype == np.float16 else 1e-5
+    assert np.allclose(out_np, out_num, rtol=rtol, atol=rtol)
+
+
+def test():
+    # A linear layer followed by the activations of the LSTM example
+    check((300, 40), (40, 70), activation="tanh")
+    check((300, 40), (40, 70), np.float32, scale=0.5, activation="exp")
+    check((300, 40), (40, 70), np.float16, activation="tanh")
+    check((300, 40), (40, 70), scale=2.0)
+    # Stacked matrices and vectors
+    check((16, 33, 12), (16, 12, 9), activation="sin")
+    check((12,), (16, 12, 9), np.float32, activation="absolute")
+    # An empty inner dimension leaves the bias only
+    check((5, 0), (0, 4), activation="tanh")
+
+    a = num.ones((3, 4))
+    b = num.ones((4, 5))
+    out = num.fused_matmul(a, b, activation=num.negative)
+    assert np.array_equal(out, -4 * np.ones((3, 5)))
+    try:
+        num.fused_matmul(a, b, activation="isnan")
+        assert False
+    except ValueError:
+        pass
+
+
+if __name__ == "__main__":
+    test()
@@ -0,0 +1,151 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import sys
+
+import numpy as np
+
+# Fusion is opt-in, so turn it on before the runtime gets initialized
+sys.argv.append("-cunumeric:fusion")
+
+import cunumeric as num  # noqa E402
+
+
+def test():
+    npa = np.random.rand(1000)
+    npb = np.random.rand(1000)
+    npc = np.random.rand(1000)
+
+    a = num.array(npa)
+    b = num.array(npb)
+    c = num.array(npc)
+
+    # A chain of element-wise operations with a single live result
+    d = num.sqrt(a * b + c) - num.exp(-a)
+    assert np.allclose(d, np.sqrt(npa * npb + npc) - np.exp(-npa))
+
+    # Intermediate results that are still alive must be written back
+    e = a + b
+    f = e * c
+    g = num.sin(f) / e
+    assert np.allclose(g, np.sin((npa + npb) * npc) / (npa + npb))
+    assert np.allclose(f, (npa + npb) * npc)
+    assert np.allclose(e, npa + npb)
+
+    # The special functions fuse like the other unary operators
+    s = num.sigmoid(a - b) * num.log1p(c) + num.softplus(num.expm1(a))
+    nps = 1.0 / (1.0 + np.exp(npb - npa)) * np.log1p(npc) + np.logaddexp(
+        0, np.expm1(npa)
+    )
+    assert np.allclose(s, nps)
+
+    # Scalars get broadcast into the fused task
+    h = 2.0 * a + 1.0
+    assert np.allclose(h, 2.0 * npa + 1.0)
+
+    # Chains longer than a single window
+    x = a
+    npx = npa
+    for _ in range(40):
+        x = x * 0.5 + b
+        npx = npx * 0.5 + npb
+    assert np.allclose(x, npx)
+
+    # In-place updates end the window
+    y = a * b
+    y += c
+    assert np.allclose(y, npa * npb + npc)
+
+    # Operations on mixed types are not fused but must still work
+    ia = num.arange(1000)
+    npia = np.arange(1000)
+    z = ia * a + ia
+    assert np.allclose(z, npia * npa + npia)
+
+    # Shapes that differ between operations
+    npm = np.random.rand(10, 100)
+    m = num.array(npm)
+    w = m * m + num.reshape(a, (10, 100))
+    assert np.allclose(w, npm * npm + np.reshape(npa, (10, 100)))
+
+    return
+
+
+def test_arange():
+    npa = np.random.rand(1000)
+    a = num.array(npa)
+
+    # Ranges are computed inside the consumers
+    x = a * num.arange(1000.0) + num.arange(5.0, 1005.0)
+    assert np.allclose(x, npa * np.arange(1000.0) + np.arange(5.0, 1005.0))
+    y = num.sin(num.arange(0.0, 10.0, 0.01))
+    assert np.allclose(y, np.sin(np.arange(0.0, 10.0, 0.01)))
+
+    # A range broadcast along the last dimension
+    npm = np.random.rand(10, 100)
+    m = num.array(npm)
+    w = m - num.arange(100.0, 0.0, -1.0)
+    assert np.allclose(w, npm - np.arange(100.0, 0.0, -1.0))
+
+    # Ranges that are read directly get written out
+    r = num.arange(7, 107, 3)
+    z = r + r
+    assert np.array_equal(r, np.arange(7, 107, 3))
+    assert np.array_equal(z, 2 * np.arange(7, 107, 3))
+    assert np.array_equal(r[5:10], np.arange(7, 107, 3)[5:10])
+
+    return
+
+
+def test_map_reduce():
+    npa = np.random.rand(1000)
+    npb = np.random.rand(1000)
+    a = num.array(npa)
+    b = num.array(npb)
+
+    # Reductions evaluate the pending expressions as they read the leaves
+    assert np.allclose(num.sum(a * b), np.sum(npa * npb))
+    assert np.allclose(num.max(num.abs(a - b)), np.max(np.abs(npa - npb)))
+    assert np.allclose(num.sum(a * a), np.sum(npa * npa))
+    assert np.allclose(num.mean((a - b) * (a - b)), np.mean((npa - npb) ** 2))
+
+    # The expression is still computed for anyone who reads it later
+    c = a * b + 1.0
+    assert np.allclose(num.sum(c), np.sum(npa * npb + 1.0))
+    assert np.allclose(c, npa * npb + 1.0)
+
+    # Reductions along axes
+    npm = np.random.rand(10, 100)
+    npn = np.random.rand(10, 100)
+    m = num.array(npm)
+    n = num.array(npn)
+    assert np.allclose(num.sum(m * n, axis=1), np.sum(npm * npn, axis=1))
+    assert np.allclose(num.max(m - n, axis=0), np.max(npm - npn, axis=0))
+
+    # Reductions into a leaf of the pending expression
+    out = num.array(npm[:, 0])
+    npout = npm[:, 0].copy()
+    d = m * out.reshape(10, 1)
+    num.sum(d, axis=1, out=out)
+    np.sum(npm * npout.reshape(10, 1), axis=1, out=npout)
+    assert np.allclose(out, npout)
+
+    return
+
+
+if __name__ == "__main__":
+    test()
+    test_arange()
+    test_map_reduce()
@@ -13,6 +13,8 @@
 # limitations under the License.
 #
 
+import numpy as np
+
 import cunumeric as num
 
 
@@ -25,5 +27,25 @@ def test():
     return
 
 
+def test_batched_reads():
+    a_np = np.random.rand(300)
+    a_num = num.array(a_np)
+
+    # More reads than a single batch holds, of two different types
+    values = [a_num[i] for i in range(len(a_np))]
+    counts = [a_num.astype(np.int64)[i] for i in range(3)]
+    # Writing an element must not change the values read before
+    a_num[5] = -1.0
+    after = a_num[5]
+    for (i, value) in enumerate(values):
+        assert value == a_np[i]
+    for (i, count) in enumerate(counts):
+        assert count == int(a_np[i])
+    assert after == -1.0
+
+    return
+
+
 if __name__ == "__main__":
     test()
+    test_batched_reads()
@@ -0,0 +1,73 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+
+import cunumeric as num
+
+
+def test_uniform(n):
+    for dtype in [np.float64, np.float32, np.int32]:
+        print(dtype)
+        a_num = (num.random.randn(n) * 10).astype(dtype)
+        w_num = num.random.rand(n)
+
+        a_np = a_num.__array__()
+        w_np = w_num.__array__()
+
+        for bins in [1, 10, 1000]:
+            hist_np, edges_np = np.histogram(a_np, bins=bins)
+            hist_num, edges_num = num.histogram(a_num, bins=bins)
+            assert num.array_equal(hist_np, hist_num)
+            assert num.allclose(edges_np, edges_num)
+
+        hist_np, _ = np.histogram(a_np, 7, range=(-5, 5), weights=w_np)
+        hist_num, _ = num.histogram(a_num, 7, range=(-5, 5), weights=w_num)
+        assert num.allclose(hist_np, hist_num)
+
+        hist_np, _ = np.histogram(a_np, bins=20, density=True)
+        hist_num, _ = num.histogram(a_num, bins=20, density=True)
+        assert num.allclose(hist_np, hist_num)
+
+    return
+
+
+def test_edges(n):
+    a_num = num.random.randn(n)
+    w_num = num.random.rand(n)
+
+    a_np = a_num.__array__()
+    w_np = w_num.__array__()
+
+    # Includes values on the edges, which belong to the bin above them
+    # except for the last edge
+    a_np[:5] = [-1.0, 0.0, 0.5, 2.0, -7.0]
+    a_num[:5] = a_np[:5]
+    edges = np.array([-2.0, -1.0, 0.0, 0.5, 2.0])
+
+    hist_np, _ = np.histogram(a_np, bins=edges)
+    hist_num, _ = num.histogram(a_num, bins=edges)
+    assert num.array_equal(hist_np, hist_num)
+
+    hist_np, _ = np.histogram(a_np, bins=edges, weights=w_np)
+    hist_num, _ = num.histogram(a_num, bins=num.array(edges), weights=w_num)
+    assert num.allclose(hist_np, hist_num)
+
+    return
+
+
+if __name__ == "__main__":
+    test_uniform(10000)
+    test_edges(10000)
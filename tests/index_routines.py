@@ -95,5 +95,24 @@ def test():
     return
 
 
+def test_many_choices():
+    # More choices than the GPU kernels take by value
+    for num_choices in [8, 9, 20]:
+        np_choices = [np.full((10, 10), idx) for idx in range(num_choices)]
+        num_choices_ = [num.array(c) for c in np_choices]
+        np_a = np.arange(100).reshape((10, 10)) % num_choices
+        num_a = num.array(np_a)
+        assert np.array_equal(
+            np.choose(np_a, np_choices), num.choose(num_a, num_choices_)
+        )
+        # Transposed arrays take the kernel for non-dense arrays
+        assert np.array_equal(
+            np.choose(np_a.T, np_choices), num.choose(num_a.T, num_choices_)
+        )
+
+    return
+
+
 if __name__ == "__main__":
     test()
+    test_many_choices()
@@ -0,0 +1,44 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+
+import cunumeric as num
+
+
+def test_int8_matmul():
+    np.random.seed(0)
+    for dtype in (np.int8, np.uint8):
+        info = np.iinfo(dtype)
+        a = np.random.randint(info.min, info.max, (37, 300)).astype(dtype)
+        b = np.random.randint(info.min, info.max, (300, 20)).astype(dtype)
+        expected = np.dot(a.astype(np.int32), b.astype(np.int32))
+
+        # An int32 output keeps the accumulators whole
+        out = num.zeros((37, 20), dtype=np.int32)
+        num.matmul(num.array(a), num.array(b), out=out)
+        assert np.array_equal(out, expected)
+
+        # Transposed operands take the same path
+        out = num.zeros((20, 37), dtype=np.int32)
+        num.matmul(num.array(b).T, num.array(a).T, out=out)
+        assert np.array_equal(out, expected.T)
+
+        # An 8-bit output wraps around like NumPy's does
+        assert np.array_equal(num.matmul(a, b), np.matmul(a, b))
+
+
+if __name__ == "__main__":
+    test_int8_matmul()
@@ -0,0 +1,69 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+import numpy as np
+
+import cunumeric as num
+
+
+def distances(points, centroids):
+    diffs = points[:, np.newaxis, :] - centroids
+    return np.sum(diffs * diffs, axis=2, dtype=np.float64)
+
+
+# The distances may round differently from NumPy's, so nearly tied
+# centroids may go either way and the labels are checked by their distances
+def check(points, centroids, labels, sums=None, counts=None, inertia=None):
+    dist = distances(points, centroids)
+    labels = np.asarray(labels)
+    nearest = dist[np.arange(labels.size), labels]
+    assert np.allclose(nearest, np.min(dist, axis=1), rtol=1e-5)
+    if sums is None:
+        return
+    k = centroids.shape[0]
+    sums_np = np.zeros(centroids.shape)
+    np.add.at(sums_np, labels, points)
+    assert num.allclose(sums_np, sums)
+    assert num.array_equal(np.bincount(labels, minlength=k), counts)
+    assert np.isclose(np.sum(nearest), float(inertia), rtol=1e-4)
+
+
+def test(n):
+    for dtype in [np.float64, np.float32]:
+        for (d, k) in [(1, 1), (2, 10), (7, 3), (16, 300)]:
+            print(dtype, d, k)
+            points_np = np.random.rand(n, d).astype(dtype)
+            centroids_np = np.random.rand(k, d).astype(dtype)
+            points_num = num.array(points_np)
+            centroids_num = num.array(centroids_np)
+
+            labels = num.kmeans_assign(points_num, centroids_num)
+            check(points_np, centroids_np, labels)
+
+            result = num.kmeans_assign(
+                points_num, centroids_num, return_sums=True
+            )
+            check(points_np, centroids_np, *result)
+
+    # Integer points are assigned in float64, and ties go to the lower index
+    points = np.arange(20).reshape(10, 2)
+    centroids = np.array([[0, 0], [10, 10], [20, 20], [0, 0]])
+    labels = num.kmeans_assign(num.array(points), num.array(centroids))
+    assert num.array_equal(labels, np.argmin(distances(points, centroids), 1))
+
+    return
+
+
+if __name__ == "__main__":
+    test(10000)
@@ -0,0 +1,61 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+
+import cunumeric as num
+
+
+def test_kron():
+    np.random.seed(42)
+    for a_shape, b_shape in [
+        ((3,), (4,)),
+        ((2, 3), (4, 5)),
+        ((3, 1, 2), (2, 4, 3)),
+        ((5,), (2, 3)),
+        ((2, 3, 2), (7,)),
+    ]:
+        a_np = np.random.random(a_shape)
+        b_np = np.random.random(b_shape)
+        a_num = num.array(a_np)
+        b_num = num.array(b_np)
+        assert np.allclose(np.kron(a_np, b_np), num.kron(a_num, b_num))
+
+    a_np = np.arange(6, dtype=np.int32).reshape(2, 3)
+    b_np = np.random.random((3, 2))
+    assert np.allclose(
+        np.kron(a_np, b_np), num.kron(num.array(a_np), num.array(b_np))
+    )
+    assert np.allclose(np.kron(2.0, b_np), num.kron(2.0, num.array(b_np)))
+
+
+def test_outer():
+    np.random.seed(42)
+    a_np = np.random.random(37)
+    b_np = np.random.random((3, 5))
+    a_num = num.array(a_np)
+    b_num = num.array(b_np)
+    assert np.allclose(np.outer(a_np, b_np), num.outer(a_num, b_num))
+
+    out_np = np.empty((37, 15))
+    out_num = num.array(out_np)
+    np.outer(a_np, b_np, out=out_np)
+    num.outer(a_num, b_num, out=out_num)
+    assert np.allclose(out_np, out_num)
+
+
+if __name__ == "__main__":
+    test_kron()
+    test_outer()
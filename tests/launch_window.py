@@ -0,0 +1,66 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import sys
+
+import numpy as np
+
+# The launch window is opt-in, so turn it on before the runtime gets
+# initialized
+sys.argv.append("-cunumeric:launch-window")
+
+import cunumeric as num  # noqa E402
+
+
+def test():
+    npa = np.random.rand(1000)
+    npb = np.random.rand(1000)
+    a = num.array(npa)
+    b = num.array(npb)
+
+    # Independent temporaries are held back until they are read
+    x = a + 1.0
+    y = b * 2.0
+    d = num.sqrt(x) - num.exp(y)
+    e = num.sin(x) + num.cos(y)
+    assert np.allclose(d, np.sqrt(npa + 1.0) - np.exp(npb * 2.0))
+    assert np.allclose(e, np.sin(npa + 1.0) + np.cos(npb * 2.0))
+
+    # Results that die before anyone reads them are never computed
+    for _ in range(40):
+        t = x * y
+        del t
+    assert np.allclose(x * y, (npa + 1.0) * (npb * 2.0))
+
+    # Writing to an operand of a held task lets the task run first
+    z = x - 1.0
+    w = num.tanh(z)
+    z += 1.0
+    assert np.allclose(w, np.tanh(npa))
+    assert np.allclose(z, npa + 1.0)
+
+    # Views of a held result see its values
+    v = x * 3.0
+    assert np.allclose(v[10:20], (npa[10:20] + 1.0) * 3.0)
+
+    # Conversions are held back like the other element-wise operations
+    f = (x * 4.0).astype(np.float32)
+    assert np.allclose(f, ((npa + 1.0) * 4.0).astype(np.float32))
+
+    return
+
+
+if __name__ == "__main__":
+    test()
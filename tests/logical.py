@@ -67,6 +67,18 @@ def test():
     assert num.equal(num.all(num.nan), np.all(np.nan))
     assert num.equal(num.any(num.nan), np.any(np.nan))
 
+    # Large inputs where the answer is decided by the first, the last or no
+    # element at all
+    big = np.zeros(1 << 20, dtype=np.float32)
+    for idx in (0, big.size - 1, None):
+        if idx is not None:
+            big[idx] = np.nan
+        cbig = num.array(big)
+        assert bool(num.isnan(cbig).any()) == bool(np.isnan(big).any())
+        assert bool(num.isnan(cbig).all()) == bool(np.isnan(big).all())
+        assert bool(num.all(cbig == 0)) == bool(np.all(big == 0))
+        big[:] = 0
+
     return
 
 
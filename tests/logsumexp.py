@@ -0,0 +1,68 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+import numpy as np
+
+import cunumeric as num
+
+
+def logsumexp_np(a, axis=None, keepdims=False):
+    shift = np.amax(a, axis=axis, keepdims=True)
+    shift = np.where(np.isfinite(shift), shift, 0)
+    result = np.log(np.sum(np.exp(a - shift), axis=axis, keepdims=True))
+    result += shift
+    return result if keepdims else np.squeeze(result, axis=axis)
+
+
+def test():
+    np.random.seed(42)
+    for dtype in (np.float32, np.float64):
+        a = np.random.randn(17, 9, 5).astype(dtype)
+        b = num.array(a)
+        assert np.allclose(num.logsumexp(b), logsumexp_np(a), rtol=1e-5)
+        for axis in (0, 1, 2, -1, (0, 2)):
+            for keepdims in (False, True):
+                out = num.logsumexp(b, axis=axis, keepdims=keepdims)
+                ref = logsumexp_np(a, axis=axis, keepdims=keepdims)
+                assert out.shape == ref.shape
+                assert np.allclose(out, ref, rtol=1e-5)
+
+        # Values whose exponentials overflow on their own
+        big = a * 100 + 1000
+        assert np.all(np.isfinite(num.logsumexp(num.array(big), axis=1)))
+        assert np.allclose(
+            num.logsumexp(num.array(big), axis=1),
+            logsumexp_np(big, axis=1),
+            rtol=1e-5,
+        )
+
+        for axis in (0, 1, -1):
+            s = num.softmax(b, axis=axis)
+            ref = np.exp(a - logsumexp_np(a, axis=axis, keepdims=True))
+            assert s.dtype == a.dtype
+            assert np.allclose(s, ref, rtol=1e-5, atol=1e-6)
+            assert np.allclose(s.sum(axis=axis), 1, rtol=1e-5)
+
+    # Infinities and integer inputs
+    c = np.array([[-np.inf, -np.inf], [np.inf, 1.0], [0.0, -np.inf]])
+    out = num.logsumexp(num.array(c), axis=1)
+    assert np.array_equal(out, [-np.inf, np.inf, 0.0])
+    d = np.arange(12).reshape(3, 4)
+    out = num.logsumexp(num.array(d), axis=0)
+    assert out.dtype == np.float64
+    assert np.allclose(out, logsumexp_np(d.astype(np.float64), axis=0))
+
+
+if __name__ == "__main__":
+    test()
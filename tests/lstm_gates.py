@@ -0,0 +1,106 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+import numpy as np
+
+import cunumeric as num
+
+
+def sigmoid(x):
+    return 1.0 / (1.0 + np.exp(-x))
+
+
+def forward_np(ifog, c_prev):
+    d = ifog.shape[1] // 4
+    gates = np.concatenate(
+        [sigmoid(ifog[:, : 3 * d]), np.tanh(ifog[:, 3 * d :])], axis=1
+    )
+    c = gates[:, :d] * gates[:, 3 * d :]
+    if c_prev is not None:
+        c += gates[:, d : 2 * d] * c_prev
+    tanh_c = np.tanh(c)
+    return gates[:, 2 * d : 3 * d] * tanh_c, c, tanh_c, gates
+
+
+def backward_np(gates, tanh_c, dh, dc, c_prev):
+    d = dh.shape[1]
+    i, f, o, g = (gates[:, k * d : (k + 1) * d] for k in range(4))
+    dcell = (1 - tanh_c ** 2) * o * dh
+    if dc is not None:
+        dcell += dc
+    prev = 0 if c_prev is None else c_prev
+    difog = np.concatenate(
+        [
+            g * dcell * i * (1 - i),
+            prev * dcell * f * (1 - f),
+            tanh_c * dh * o * (1 - o),
+            i * dcell * (1 - g ** 2),
+        ],
+        axis=1,
+    )
+    return difog, None if c_prev is None else f * dcell
+
+
+def test():
+    np.random.seed(7)
+    b, d = 13, 6
+    for dtype in (np.float32, np.float64):
+        rtol = 1e-5 if dtype == np.float32 else 1e-12
+        ifog = (np.random.randn(b, 4 * d) * 3).astype(dtype)
+        c_prev = np.random.randn(b, d).astype(dtype)
+        dh = np.random.randn(b, d).astype(dtype)
+        dc = np.random.randn(b, d).astype(dtype)
+
+        for prev in (None, c_prev):
+            out = num.lstm_gates(
+                num.array(ifog), None if prev is None else num.array(prev)
+            )
+            for (x, y) in zip(out, forward_np(ifog, prev)):
+                assert x.dtype == dtype
+                assert np.allclose(x, y, rtol=rtol, atol=rtol)
+
+            gates, tanh_c = np.asarray(out[3]), np.asarray(out[2])
+            for grad in (None, dc):
+                difog, dc_prev = num.lstm_gates_backward(
+                    num.array(gates),
+                    num.array(tanh_c),
+                    num.array(dh),
+                    dc=None if grad is None else num.array(grad),
+                    c_prev=None if prev is None else num.array(prev),
+                )
+                ref, ref_prev = backward_np(gates, tanh_c, dh, grad, prev)
+                assert np.allclose(difog, ref, rtol=rtol, atol=rtol)
+                if prev is None:
+                    assert dc_prev is None
+                else:
+                    assert np.allclose(dc_prev, ref_prev, rtol=rtol, atol=rtol)
+
+    # The results can be written into slices of larger arrays
+    n = 3
+    ifog = np.random.randn(n, b, 4 * d)
+    H, C, Ct, G = (num.zeros((n, b, w)) for w in (d, d, d, 4 * d))
+    c_np = None
+    for t in range(n):
+        num.lstm_gates(
+            num.array(ifog[t]),
+            C[t - 1] if t > 0 else None,
+            out=(H[t], C[t], Ct[t], G[t]),
+        )
+        h_np, c_np, _, _ = forward_np(ifog[t], c_np)
+        assert np.allclose(H[t], h_np)
+        assert np.allclose(C[t], c_np)
+
+
+if __name__ == "__main__":
+    test()
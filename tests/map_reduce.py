@@ -35,5 +35,23 @@ def test():
     return
 
 
+def test_products():
+    npx = np.random.rand(100, 10)
+    npy = np.random.rand(100, 10)
+    x = num.array(npx)
+    y = num.array(npy)
+
+    # Products are folded by the reductions that consume them
+    assert np.allclose(num.sum(x * y), np.sum(npx * npy))
+    assert np.allclose(num.sum(x * y, axis=0), np.sum(npx * npy, axis=0))
+    assert np.allclose(num.max(x * y, axis=1), np.max(npx * npy, axis=1))
+
+    # A product that is read again after the reduction
+    z = x * y
+    assert np.allclose(num.sum(z), np.sum(npx * npy))
+    assert np.allclose(z, npx * npy)
+
+
 if __name__ == "__main__":
     test()
+    test_products()
@@ -38,5 +38,33 @@ def test():
     return
 
 
+def test_compress():
+    np.random.seed(3)
+    for shape in ((1000,), (37, 53), (7, 11, 13)):
+        a = np.random.random(shape)
+        mask = a > 0.6
+        b = num.array(a)
+        assert np.array_equal(b[num.array(mask)], a[mask])
+        assert b[num.array(np.zeros(shape, dtype=bool))].size == 0
+
+
+def test_place():
+    np.random.seed(4)
+    for shape in ((1000,), (37, 53), (7, 11, 13)):
+        a = np.random.random(shape)
+        mask = a > 0.6
+        b = num.array(a)
+        b[num.array(mask)] = -1.0
+        a[mask] = -1.0
+        assert np.array_equal(b, a)
+
+        values = np.arange(np.count_nonzero(a < 0.3), dtype=np.float64)
+        b[num.array(a < 0.3)] = num.array(values)
+        a[a < 0.3] = values
+        assert np.array_equal(b, a)
+
+
 if __name__ == "__main__":
     test()
+    test_compress()
+    test_place()
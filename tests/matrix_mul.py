@@ -16,6 +16,7 @@
 import numpy as np
 
 import cunumeric as num
+from cunumeric.runtime import runtime
 
 
 def test(ty):
@@ -86,8 +87,36 @@ def test(ty):
 
     assert np.allclose(C, Cn, rtol=rtol)
 
+    # A tall matrix against a few vectors, plain and transposed
+    An = np.random.randn(1000, 20).astype(ty)
+    Bn = np.random.randn(20, 8).astype(ty)
+    atol = 1e-1 if ty == np.float16 else 1e-08
+    for A, B, Cn in (
+        (num.array(An), num.array(Bn), An.dot(Bn)),
+        (num.array(An.T).T, num.array(Bn.T).T, An.dot(Bn)),
+    ):
+        C = A.dot(B)
+        assert np.allclose(C, Cn, rtol=rtol, atol=atol)
+
+    # Gram matrices of a tall matrix and of its column major copy
+    Xn = np.random.randn(500, 12).astype(ty)
+    Gn = Xn.T.dot(Xn)
+    for X in (num.array(Xn), num.array(Xn.T).T):
+        assert np.allclose(X.T.dot(X), Gn, rtol=rtol, atol=atol)
+        assert np.allclose(X.T @ X, Gn, rtol=rtol, atol=atol)
+        assert np.allclose(X.swapaxes(0, 1).dot(X), Gn, rtol=rtol, atol=atol)
+
+
+def test_half_output():
+    # Write float16 products directly instead of through a float32 temporary
+    saved = runtime.half_matmul_output
+    runtime.half_matmul_output = True
+    test(np.float16)
+    runtime.half_matmul_output = saved
+
 
 if __name__ == "__main__":
     test(np.float16)
+    test_half_output()
     test(np.float32)
     test(np.float64)
@@ -0,0 +1,80 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+
+import numpy as np
+
+import cunumeric as num
+
+
+def test_matrix_power(n):
+    # Scaled down so that the high powers stay representable
+    a = np.random.rand(n, n) / n
+    for power in [0, 1, 2, 3, 7, 8, 13]:
+        assert num.allclose(
+            num.linalg.matrix_power(num.array(a), power),
+            np.linalg.matrix_power(a, power),
+        )
+
+    a += np.eye(n)
+    assert num.allclose(
+        num.linalg.matrix_power(num.array(a), -3),
+        np.linalg.matrix_power(a, -3),
+    )
+
+    a = np.random.randint(0, 3, size=(n, n))
+    assert num.array_equal(
+        num.linalg.matrix_power(num.array(a), 5),
+        np.linalg.matrix_power(a, 5),
+    )
+
+
+def test_stacked(batch, n):
+    a = np.random.rand(batch, n, n) / n
+    for power in [0, 2, 5]:
+        assert num.allclose(
+            num.linalg.matrix_power(num.array(a), power),
+            np.linalg.matrix_power(a, power),
+        )
+
+
+def test_expm(n):
+    # The exponential of a symmetric matrix follows from its eigenvalues
+    for scale in [1e-3, 0.1, 1.0, 10.0]:
+        a = np.random.rand(n, n)
+        a = (a + a.T) * (scale / n)
+        w, v = np.linalg.eigh(a)
+        expected = (v * np.exp(w)) @ v.T
+        assert num.allclose(num.linalg.expm(num.array(a)), expected)
+
+    # A nilpotent matrix has a finite series
+    a = np.triu(np.random.rand(n, n), k=1)
+    expected = np.eye(n)
+    term = np.eye(n)
+    for k in range(1, n):
+        term = term @ a / k
+        expected += term
+    assert num.allclose(num.linalg.expm(num.array(a)), expected)
+
+
+def test():
+    for n in [1, 3, 8, 17, 64]:
+        test_matrix_power(n)
+        test_expm(n)
+    test_stacked(4, 5)
+
+
+if __name__ == "__main__":
+    test()
@@ -50,6 +50,20 @@ def test(ty):
 
     assert np.allclose(C, Cn)
 
+    # A tall matrix is split along its rows for the transposed product
+    An = np.random.randn(1000, 37).astype(ty)
+    Bn = np.random.randn(1000).astype(ty)
+    Cn = An.astype(np.float64).T.dot(Bn.astype(np.float64))
+
+    A = num.array(An)
+    B = num.array(Bn)
+    C = A.T.dot(B)
+
+    if ty == np.float16:
+        assert np.allclose(C, Cn, rtol=1e-2, atol=0.5)
+    else:
+        assert np.allclose(C, Cn, rtol=1e-4)
+
     An = np.random.randn(3).astype(ty)
     Bn = np.random.randn(7, 3).astype(ty)
     Cn = An.dot(Bn.transpose())
@@ -0,0 +1,49 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+
+import os
+import tempfile
+
+import numpy as np
+
+# Stream in blocks of a MiB so that the arrays below take several blocks
+os.environ.setdefault("CUNUMERIC_STREAM_CHUNK_SIZE", "1")
+
+import cunumeric as num  # noqa: E402
+
+
+def test():
+    anp = np.random.rand(1024, 513)
+    with tempfile.TemporaryDirectory() as root:
+        filename = os.path.join(root, "data.bin")
+        anp.tofile(filename)
+
+        a = num.memmap(filename, dtype=np.float64, mode="r", shape=anp.shape)
+        assert np.array_equal(a, anp)
+        assert np.allclose(a.sum(), anp.sum())
+        assert np.allclose(a.max(), anp.max())
+        assert np.allclose(num.exp(a) * 2.0, np.exp(anp) * 2.0)
+        assert bool((a >= 0).all())
+
+        b = num.memmap(filename, dtype=np.float64, mode="r+", shape=anp.shape)
+        b *= 2.0
+        assert np.allclose(b, anp * 2.0)
+
+    return
+
+
+if __name__ == "__main__":
+    test()
@@ -0,0 +1,49 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import os
+
+# The tasks read this when they first run, so it has to be set before them
+os.environ["CUNUMERIC_MEMORY_REPORT"] = "1"
+
+import numpy as np  # noqa E402
+
+import cunumeric as num  # noqa E402
+from cunumeric.runtime import runtime  # noqa E402
+
+
+def test():
+    # Large enough not to be handled eagerly by NumPy
+    size = 2 * runtime.max_eager_volume + 1
+    a = num.ones(size)
+    b = num.ones(size)
+    c = a + b
+    assert np.array_equal(c, np.full(size, 2.0))
+    num.nonzero(c)
+
+    report = num.memory_report()
+    tasks = {task["task"]: task for task in report["tasks"]}
+    assert tasks["binary_op"]["launches"] > 0
+    # The result and both operands are mapped by every launch
+    assert max(tasks["binary_op"]["instances"].values()) >= 3 * 8
+    assert tasks["nonzero"]["temporaries"] > 0
+    assert any(
+        "binary_op" in callsite["operations"]
+        for callsite in report["callsites"]
+    )
+
+
+if __name__ == "__main__":
+    test()
@@ -0,0 +1,46 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+
+from itertools import combinations
+
+import numpy as np
+
+import cunumeric as num
+
+
+def test():
+    np.random.seed(42)
+    anp = np.random.random((4, 5, 6, 7))
+    a = num.array(anp)
+
+    for naxes in (2, 3):
+        for axes in combinations(range(anp.ndim), naxes):
+            assert np.allclose(a.sum(axis=axes), anp.sum(axis=axes))
+            assert np.allclose(
+                num.prod(a, axis=axes, keepdims=True),
+                np.prod(anp, axis=axes, keepdims=True),
+            )
+            assert np.array_equal(a.max(axis=axes), anp.max(axis=axes))
+            assert np.array_equal(a.ptp(axis=axes), anp.ptp(axis=axes))
+
+    assert np.allclose(a.sum(axis=(-1, 0)), anp.sum(axis=(-1, 0)))
+    assert np.allclose(a.var(axis=(1, 3)), anp.var(axis=(1, 3)))
+
+    return
+
+
+if __name__ == "__main__":
+    test()
@@ -0,0 +1,53 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+
+import cunumeric as num
+
+
+def test():
+    anp = np.random.randn(40, 50)
+    a = num.array(anp)
+
+    assert np.allclose(a.var(), anp.var())
+    assert np.allclose(a.std(), anp.std())
+    assert np.allclose(a.var(ddof=1), anp.var(ddof=1))
+    for axis in (0, 1):
+        assert np.allclose(a.var(axis=axis), anp.var(axis=axis))
+        assert np.allclose(
+            num.std(a, axis=axis, keepdims=True),
+            np.std(anp, axis=axis, keepdims=True),
+        )
+        assert np.allclose(a.ptp(axis=axis), anp.ptp(axis=axis))
+    assert np.allclose(num.ptp(a), np.ptp(anp))
+
+    inp = np.random.randint(-100, 100, size=(30, 20))
+    i = num.array(inp)
+    assert np.allclose(num.var(i), np.var(inp))
+    assert np.allclose(num.var(i, axis=1), np.var(inp, axis=1))
+    assert np.array_equal(num.ptp(i), np.ptp(inp))
+    assert np.array_equal(num.ptp(i, axis=0), np.ptp(inp, axis=0))
+
+    cnp = np.random.randn(10, 20) + 1j * np.random.randn(10, 20)
+    c = num.array(cnp)
+    assert np.allclose(c.var(), cnp.var())
+    assert np.allclose(c.var(axis=0), cnp.var(axis=0))
+
+    return
+
+
+if __name__ == "__main__":
+    test()
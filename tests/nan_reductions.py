@@ -0,0 +1,69 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+
+import cunumeric as num
+
+
+def test():
+    np.random.seed(42)
+    anp = np.random.rand(8, 9)
+    anp[np.random.rand(8, 9) < 0.3] = np.nan
+    # Keep at least one number in every row and column so that the arg
+    # reductions are well defined
+    anp[np.arange(8), np.arange(8)] = np.arange(8, dtype=np.float64)
+    a = num.array(anp)
+
+    for axis in (None, 0, 1):
+        assert np.allclose(num.nansum(a, axis=axis), np.nansum(anp, axis=axis))
+        assert np.allclose(
+            num.nanprod(a, axis=axis), np.nanprod(anp, axis=axis)
+        )
+        assert np.allclose(num.nanmax(a, axis=axis), np.nanmax(anp, axis=axis))
+        assert np.allclose(num.nanmin(a, axis=axis), np.nanmin(anp, axis=axis))
+        assert np.allclose(
+            num.nanmean(a, axis=axis), np.nanmean(anp, axis=axis)
+        )
+
+    for axis in (0, 1):
+        assert np.array_equal(
+            num.nanargmax(a, axis=axis), np.nanargmax(anp, axis=axis)
+        )
+        assert np.array_equal(
+            num.nanargmin(a, axis=axis), np.nanargmin(anp, axis=axis)
+        )
+
+    assert np.allclose(
+        num.nansum(a, axis=0, keepdims=True),
+        np.nansum(anp, axis=0, keepdims=True),
+    )
+
+    # Integer inputs cannot hold NaNs and behave like the plain reductions
+    inp = np.arange(1, 13).reshape(3, 4)
+    i = num.array(inp)
+    assert np.array_equal(num.nansum(i, axis=1), np.nansum(inp, axis=1))
+    assert np.array_equal(num.nanmax(i), np.nanmax(inp))
+
+    # Half precision is accumulated in single precision
+    hnp = anp.astype(np.float16)
+    h = num.array(hnp)
+    assert np.allclose(
+        num.nanmean(h, axis=0), np.nanmean(hnp, axis=0), rtol=1e-2
+    )
+
+
+if __name__ == "__main__":
+    test()
@@ -23,6 +23,53 @@ def assert_equal(numarr, nparr):
         assert np.array_equal(resultnp, resultnum)
 
 
+def test_count_axis():
+    x_np = np.array(
+        [
+            [[0, 1], [1, 1], [7, 0], [1, 0], [0, 1]],
+            [[3, 0], [0, 3], [0, 0], [2, 2], [0, 19]],
+        ]
+    )
+    for a_np in [x_np, x_np.astype("?"), x_np * 0.5, x_np * (1 + 1j)]:
+        a = num.array(a_np)
+        for axis in [0, 1, 2, -1, (0, 2), (0, 1, 2)]:
+            assert np.array_equal(
+                num.count_nonzero(a, axis=axis),
+                np.count_nonzero(a_np, axis=axis),
+            )
+        assert np.array_equal(
+            num.count_nonzero(a, axis=1, keepdims=True),
+            np.count_nonzero(a_np, axis=1, keepdims=True),
+        )
+
+    x_np = np.concatenate((x_np,) * 2000, axis=1)
+    x = num.array(x_np)
+    for axis in [0, 1, 2]:
+        assert np.array_equal(
+            num.count_nonzero(x, axis=axis),
+            np.count_nonzero(x_np, axis=axis),
+        )
+
+
+def test_argwhere():
+    assert np.array_equal(num.argwhere(0), np.argwhere(0))
+    assert np.array_equal(num.argwhere(1), np.argwhere(1))
+    assert np.array_equal(num.argwhere([]), np.argwhere([]))
+    assert np.array_equal(num.argwhere(num.eye(3)), np.argwhere(np.eye(3)))
+
+    for shape in [(100,), (10, 10), (4, 5, 6)]:
+        x_np = np.random.randn(*shape)
+        x_np[x_np < 0.5] = 0
+        result = np.array(num.argwhere(num.array(x_np)))
+        assert result.shape == (np.count_nonzero(x_np), len(shape))
+        # The tiles of a multi-dimensional array are not laid out in
+        # row-major order, so the rows are only compared once sorted
+        result = result[np.lexsort(result.T[::-1])]
+        assert np.array_equal(result, np.argwhere(x_np))
+
+    assert num.argwhere(num.zeros((3, 4))).shape == (0, 2)
+
+
 def test():
     assert num.count_nonzero(num.array([])) == 0
     assert num.count_nonzero(num.array([], dtype="?")) == 0
@@ -108,6 +155,9 @@ def test():
     # np_nonzero = np.nonzero(x_np)
     # assert_equal(lg_nonzero, np_nonzero)
 
+    test_count_axis()
+    test_argwhere()
+
     return
 
 
@@ -35,17 +35,84 @@ def test():
     assert np.allclose(np.linalg.norm(anp, ord=2), num.linalg.norm(a, ord=2))
     # assert(np.allclose(np.linalg.norm(anp, ord=-2), num.linalg.norm(a, ord=-2))) # noqa E501
 
-    # bnp = np.random.randn(4,5)
-    # b = num.array(bnp)
-    # assert(np.allclose(np.linalg.norm(bnp, 'fro'), num.linalg.norm(b, 'fro'))) # noqa E501
+    bnp = np.random.randn(4, 5)
+    b = num.array(bnp)
+    assert np.allclose(np.linalg.norm(bnp, "fro"), num.linalg.norm(b, "fro"))
     # assert(np.allclose(np.linalg.norm(bnp, 'nuc'), num.linalg.norm(b, 'nuc'))) # noqa E501
-    # assert(np.allclose(np.linalg.norm(bnp, np.inf), num.linalg.norm(b, num.inf))) # noqa E501
-    # assert(np.allclose(np.linalg.norm(bnp, -np.inf), num.linalg.norm(b, -num.inf))) # noqa E501
-    # assert(np.allclose(np.linalg.norm(bnp, 1), num.linalg.norm(b, 1)))
-    # assert(np.allclose(np.linalg.norm(bnp, -1), num.linalg.norm(b, -1)))
+    assert np.allclose(
+        np.linalg.norm(bnp, np.inf), num.linalg.norm(b, num.inf)
+    )
+    assert np.allclose(
+        np.linalg.norm(bnp, -np.inf), num.linalg.norm(b, -num.inf)
+    )
+    assert np.allclose(np.linalg.norm(bnp, 1), num.linalg.norm(b, 1))
+    assert np.allclose(np.linalg.norm(bnp, -1), num.linalg.norm(b, -1))
 
     return
 
 
+def test_fused():
+    for dtype in (np.float32, np.float64):
+        anp = np.random.randn(6, 7).astype(dtype)
+        a = num.array(anp)
+        for ord in (None, 1, 2, np.inf, -np.inf):
+            for axis in (0, 1, -1):
+                assert np.allclose(
+                    np.linalg.norm(anp, ord=ord, axis=axis),
+                    num.linalg.norm(a, ord=ord, axis=axis),
+                    rtol=1e-4,
+                )
+        assert np.allclose(np.linalg.norm(anp), num.linalg.norm(a), rtol=1e-4)
+        assert np.allclose(
+            np.linalg.norm(anp, keepdims=True),
+            num.linalg.norm(a, keepdims=True),
+            rtol=1e-4,
+        )
+        for ord in ("fro", 1, -1, np.inf, -np.inf):
+            assert np.allclose(
+                np.linalg.norm(anp, ord=ord),
+                num.linalg.norm(a, ord=ord),
+                rtol=1e-4,
+            )
+            assert np.allclose(
+                np.linalg.norm(anp, ord=ord, axis=(1, 0), keepdims=True),
+                num.linalg.norm(a, ord=ord, axis=(1, 0), keepdims=True),
+                rtol=1e-4,
+            )
+
+    # The squares of these overflow, but their norms do not
+    a = num.array([3e200, -4e200, 0.0])
+    assert np.allclose(num.linalg.norm(a), 5e200)
+    a = num.array([3e-200, -4e-200])
+    assert np.allclose(num.linalg.norm(a), 5e-200)
+    a = num.array([1.0, np.inf, 2.0])
+    assert num.linalg.norm(a) == np.inf
+
+    # Integers are converted to floating point first
+    anp = np.arange(-5, 7)
+    a = num.array(anp)
+    assert np.allclose(np.linalg.norm(anp), num.linalg.norm(a))
+    assert np.allclose(np.linalg.norm(anp, ord=1), num.linalg.norm(a, ord=1))
+
+
+def test_cdist():
+    xnp = np.random.randn(20, 5)
+    cnp = np.random.randn(7, 5)
+    x = num.array(xnp)
+    c = num.array(cnp)
+
+    diff = xnp[:, np.newaxis, :] - cnp[np.newaxis, :, :]
+    expected = np.square(diff).sum(axis=2)
+    assert np.allclose(expected, num.linalg.cdist(x, c, metric="sqeuclidean"))
+    assert np.allclose(np.sqrt(expected), num.linalg.cdist(x, c))
+
+    # The distance of a row to itself is clamped at zero
+    d = num.linalg.cdist(x, x)
+    assert np.all(np.asarray(d) >= 0)
+    assert np.allclose(np.diag(d), 0, atol=1e-6)
+
+
 if __name__ == "__main__":
     test()
+    test_fused()
+    test_cdist()
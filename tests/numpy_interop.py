@@ -27,5 +27,15 @@ def test():
     return
 
 
+def test_permuted_views():
+    anp = np.random.rand(6, 5, 4)
+    for view in (anp.T, anp.transpose(1, 0, 2), anp[:, 1:4].swapaxes(0, 2)):
+        assert np.array_equal(num.asarray(view), view)
+        assert np.allclose(num.exp(view), np.exp(view))
+
+    return
+
+
 if __name__ == "__main__":
     test()
+    test_permuted_views()
@@ -0,0 +1,59 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+
+import cunumeric as num
+
+
+def test_modes():
+    anp = np.arange(5 * 4 * 3, dtype=np.float64).reshape(5, 4, 3)
+    a = num.array(anp)
+
+    for mode in ["constant", "edge", "reflect", "symmetric", "wrap"]:
+        for pad_width in [1, (2, 3), ((0, 1), (3, 0), (2, 2)), 7]:
+            bnp = np.pad(anp, pad_width, mode=mode)
+            b = num.pad(a, pad_width, mode=mode)
+            assert np.array_equal(b, bnp)
+
+
+def test_constant():
+    anp = np.arange(6 * 5, dtype=np.int32).reshape(6, 5)
+    a = num.array(anp)
+
+    assert np.array_equal(
+        num.pad(a, 2, constant_values=-7),
+        np.pad(anp, 2, constant_values=-7),
+    )
+    assert np.array_equal(
+        num.pad(a[1:5, ::2], (1, 4)), np.pad(anp[1:5, ::2], (1, 4))
+    )
+    assert np.array_equal(
+        num.pad(num.array([3]), 2, constant_values=1),
+        np.pad(np.array([3]), 2, constant_values=1),
+    )
+
+
+def test_single_element():
+    for mode in ["edge", "reflect", "symmetric", "wrap"]:
+        bnp = np.pad(np.ones((1, 1)), 3, mode=mode)
+        b = num.pad(num.ones((1, 1)), 3, mode=mode)
+        assert np.array_equal(b, bnp)
+
+
+if __name__ == "__main__":
+    test_modes()
+    test_constant()
+    test_single_element()
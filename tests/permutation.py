@@ -0,0 +1,61 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+
+import cunumeric as num
+
+
+def test_permutation():
+    for n in (1, 7, 1000, 65537):
+        p = num.random.permutation(n)
+        assert p.dtype == np.int64
+        assert np.array_equal(np.sort(p.__array__()), np.arange(n))
+
+    a = num.arange(20) * 3
+    p = num.random.permutation(a)
+    assert np.array_equal(np.sort(p.__array__()), a.__array__())
+
+    b = num.arange(24).reshape((6, 4))
+    p = num.random.permutation(b).__array__()
+    assert np.array_equal(p[np.argsort(p[:, 0])], b.__array__())
+
+
+def test_shuffle():
+    a = num.arange(1000)
+    num.random.shuffle(a)
+    anp = a.__array__()
+    assert not np.array_equal(anp, np.arange(1000))
+    assert np.array_equal(np.sort(anp), np.arange(1000))
+
+
+def test_choice():
+    a = num.random.choice(10, size=(5, 4))
+    assert a.shape == (5, 4)
+    assert num.all(a >= 0) and num.all(a < 10)
+
+    b = num.random.choice(100, size=100, replace=False)
+    assert np.array_equal(np.sort(b.__array__()), np.arange(100))
+
+    pool = num.arange(50) * 2
+    c = num.random.choice(pool, size=30, replace=False).__array__()
+    assert len(np.unique(c)) == 30
+    assert np.all(c % 2 == 0)
+
+
+if __name__ == "__main__":
+    test_permutation()
+    test_shuffle()
+    test_choice()
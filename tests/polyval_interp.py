@@ -0,0 +1,52 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+
+import cunumeric as num
+
+
+def test_polyval():
+    np.random.seed(0)
+    x = np.random.rand(1000) * 2 - 1
+    for degree in (0, 1, 10, 40):
+        p = np.random.rand(degree + 1)
+        assert np.allclose(num.polyval(p, num.array(x)), np.polyval(p, x))
+
+    a = np.arange(-5, 5).reshape(2, 5)
+    assert np.array_equal(num.polyval([3, 0, 1], a), np.polyval([3, 0, 1], a))
+
+
+def test_interp():
+    np.random.seed(1)
+    x = np.random.rand(10000) * 12 - 1
+    uniform = np.linspace(0, 10, 101)
+    irregular = np.sort(np.random.rand(50)) * 10
+    for xp in (uniform, irregular, np.array([2.0])):
+        fp = np.sin(xp)
+        assert np.allclose(num.interp(x, xp, fp), np.interp(x, xp, fp))
+        assert np.allclose(
+            num.interp(x, xp, fp, left=-5, right=5),
+            np.interp(x, xp, fp, left=-5, right=5),
+        )
+    assert np.allclose(
+        num.interp(x, irregular, irregular ** 2, period=3),
+        np.interp(x, irregular, irregular ** 2, period=3),
+    )
+
+
+if __name__ == "__main__":
+    test_polyval()
+    test_interp()
@@ -0,0 +1,66 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+
+import cunumeric as num
+
+
+def test_qr(m, n, dtype):
+    a = np.random.rand(m, n).astype(dtype)
+    q, r = num.linalg.qr(num.array(a))
+    assert q.shape == (m, n) and r.shape == (n, n)
+    assert num.allclose(q.dot(r), a, rtol=1e-4, atol=1e-4)
+    assert num.allclose(q.T.dot(q), np.eye(n), atol=1e-4)
+    assert num.allclose(r, np.triu(r))
+
+    # R is unique up to the signs of its rows
+    expected = np.linalg.qr(a, mode="r")
+    r = num.linalg.qr(num.array(a), mode="r")
+    assert num.allclose(num.abs(r), np.abs(expected), rtol=1e-4, atol=1e-4)
+
+
+def test_svd(m, n, dtype):
+    a = np.random.rand(m, n).astype(dtype)
+    u, s, vh = num.linalg.svd(num.array(a), full_matrices=False)
+    k = min(m, n)
+    assert u.shape == (m, k) and s.shape == (k,) and vh.shape == (k, n)
+    assert num.allclose(s, np.linalg.svd(a, compute_uv=False), rtol=1e-4)
+    assert num.allclose((u * s).dot(vh), a, rtol=1e-4, atol=1e-4)
+
+    s = num.linalg.svd(num.array(a), compute_uv=False)
+    assert num.allclose(s, np.linalg.svd(a, compute_uv=False), rtol=1e-4)
+
+
+def test_integer():
+    a = np.random.randint(1, 10, size=(100, 4))
+    q, r = num.linalg.qr(num.array(a))
+    assert q.dtype == np.float64
+    assert num.allclose(q.dot(r), a)
+
+
+def test():
+    for m, n in [(1, 1), (10, 10), (1000, 3), (4096, 32)]:
+        test_qr(m, n, np.float32)
+        test_qr(m, n, np.float64)
+        test_svd(m, n, np.float32)
+        test_svd(m, n, np.float64)
+    # Wide matrices go through the transpose
+    test_svd(8, 200, np.float64)
+    test_integer()
+
+
+if __name__ == "__main__":
+    test()
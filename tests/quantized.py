@@ -0,0 +1,86 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+
+import cunumeric as num
+
+
+def check_error(a_np, decoded, bits):
+    # Every element is within half a scale of its block
+    max_code = 127 if bits == 8 else 7
+    rows = a_np.reshape(-1, a_np.shape[-1])
+    decoded = np.asarray(decoded).reshape(rows.shape)
+    for col in range(0, rows.shape[1], 64):
+        block = rows[:, col : col + 64]
+        bound = np.abs(block).max(axis=1, keepdims=True) / max_code / 2
+        error = np.abs(decoded[:, col : col + 64] - block)
+        assert np.all(error <= bound * (1 + 1e-5) + 1e-7)
+
+
+def test_roundtrip():
+    np.random.seed(42)
+    for shape in [(100,), (37, 200), (3, 5, 129), (16, 64)]:
+        a_np = np.random.randn(*shape).astype(np.float32)
+        for bits in (8, 4):
+            q = num.quantized_array(num.array(a_np), bits=bits)
+            decoded = q.toarray()
+            assert decoded.shape == a_np.shape
+            assert decoded.dtype == np.float32
+            check_error(a_np, decoded, bits)
+
+    # Blocks of zeros stay zero
+    q = num.quantized_array(num.zeros((4, 70)))
+    assert np.array_equal(q.toarray(), np.zeros((4, 70)))
+
+
+def test_size():
+    a = num.random.randn(256, 1024).astype(np.float32)
+    q8 = num.quantized_array(a, bits=8)
+    q4 = num.quantized_array(a, bits=4)
+    assert q8.nbytes == 256 * 1024 + 256 * 16 * 4
+    assert q4.nbytes == 256 * 512 + 256 * 16 * 4
+    assert q8.nbytes < a.nbytes / 3
+
+
+def test_matvec():
+    np.random.seed(42)
+    a_np = np.random.randn(300, 150)
+    x_np = np.random.randn(150)
+    for bits in (8, 4):
+        q = num.quantized_array(num.array(a_np), bits=bits)
+        decoded = np.asarray(q.toarray())
+        assert np.allclose(q.dot(num.array(x_np)), decoded.dot(x_np))
+        assert np.allclose(q @ num.array(x_np), decoded.dot(x_np))
+        assert np.allclose(num.dot(q, num.array(x_np)), decoded.dot(x_np))
+
+        b_np = np.random.randn(150, 3)
+        assert np.allclose(q.dot(num.array(b_np)), decoded.dot(b_np))
+
+
+def test_take():
+    np.random.seed(42)
+    table_np = np.random.randn(1000, 96).astype(np.float32)
+    q = num.quantized_array(num.array(table_np), bits=4)
+    decoded = np.asarray(q.toarray())
+    rows = np.array([3, 999, 0, 3, 512])
+    assert np.array_equal(q.take(num.array(rows)), decoded[rows])
+
+
+if __name__ == "__main__":
+    test_roundtrip()
+    test_size()
+    test_matvec()
+    test_take()
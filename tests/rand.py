@@ -0,0 +1,113 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+
+import cunumeric as num
+
+
+def test_uniform():
+    for dtype in (np.float16, np.float32, np.float64):
+        a = num.random.rand(100000, dtype=dtype)
+        assert a.dtype == dtype
+        assert num.all(a >= 0) and num.all(a < 1)
+        assert abs(float(a.astype(np.float64).mean()) - 0.5) < 0.01
+
+        b = num.random.uniform(-2, 3, size=(300, 300), dtype=dtype)
+        assert b.dtype == dtype
+        assert num.all(b >= -2) and num.all(b <= 3)
+
+
+def test_normal():
+    for dtype in (np.float16, np.float32, np.float64):
+        a = num.random.randn(100000, dtype=dtype).astype(np.float64)
+        assert num.all(num.isfinite(a))
+        assert abs(float(a.mean())) < 0.02
+        assert abs(float(a.std()) - 1.0) < 0.02
+
+
+def test_reproducible():
+    # Odd sizes leave draws that are only partly used at the tile boundaries
+    for dtype in (np.float32, np.float64):
+        num.random.seed(7)
+        a = num.random.rand(1001, 37, dtype=dtype)
+        num.random.seed(7)
+        b = num.random.rand(1001, 37, dtype=dtype)
+        assert num.array_equal(a, b)
+        assert not num.array_equal(a[:, 0], a[:, 1])
+
+
+def test_fast_random():
+    from cunumeric.runtime import runtime
+
+    runtime.fast_random = True
+    try:
+        a = num.random.rand(100000, dtype=np.float32)
+        assert num.all(a >= 0) and num.all(a < 1)
+        assert abs(float(a.astype(np.float64).mean()) - 0.5) < 0.01
+
+        b = num.random.randn(100000).astype(np.float64)
+        assert abs(float(b.mean())) < 0.02
+        assert abs(float(b.std()) - 1.0) < 0.02
+
+        c = num.random.randint(5, 10, size=10000, dtype=np.int32)
+        assert num.all(c >= 5) and num.all(c < 10)
+    finally:
+        runtime.fast_random = False
+
+
+def test_distributions():
+    def check(a, mean, var):
+        a = a.astype(np.float64)
+        assert abs(float(a.mean()) - mean) < 0.05 * max(1.0, mean)
+        assert abs(float(a.var()) - var) < 0.1 * max(1.0, var)
+
+    n = 100000
+    check(num.random.exponential(2.0, size=n), 2.0, 4.0)
+    check(num.random.gamma(0.5, size=n), 0.5, 0.5)
+    check(num.random.gamma(3.0, 2.0, size=n), 6.0, 12.0)
+    check(num.random.beta(2.0, 3.0, size=n), 0.4, 0.04)
+    check(num.random.poisson(4.0, size=n), 4.0, 4.0)
+    check(num.random.poisson(50.0, size=n), 50.0, 50.0)
+    check(num.random.binomial(10, 0.3, size=n), 3.0, 2.1)
+    check(num.random.binomial(1000, 0.6, size=n), 600.0, 240.0)
+
+    a = num.random.poisson(4.0, size=n)
+    assert a.dtype == np.int64 and num.all(a >= 0)
+    b = num.random.binomial(20, 0.5, size=n)
+    assert num.all(b >= 0) and num.all(b <= 20)
+
+
+def test_bernoulli():
+    a = num.random.bernoulli(0.3, size=100000)
+    assert a.dtype == np.bool_
+    assert abs(float(a.astype(np.float64).mean()) - 0.3) < 0.01
+    assert num.all(num.random.bernoulli(1.0, size=1000))
+    assert not num.any(num.random.bernoulli(0.0, size=1000))
+
+    b = num.random.dropout_mask(0.25, size=(300, 300))
+    assert b.dtype == np.float32
+    values = b.__array__()
+    assert set(np.unique(values)) <= {0.0, np.float32(1.0 / 0.75)}
+    assert abs(float(values.astype(np.float64).mean()) - 1.0) < 0.02
+
+
+if __name__ == "__main__":
+    test_uniform()
+    test_normal()
+    test_reproducible()
+    test_fast_random()
+    test_distributions()
+    test_bernoulli()
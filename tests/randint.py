@@ -13,6 +13,8 @@
 # limitations under the License.
 #
 
+import numpy as np
+
 import cunumeric as num
 
 
@@ -23,5 +25,20 @@ def test():
     return
 
 
+def test_dtypes():
+    for dtype in (np.int8, np.int32, np.int64, np.uint8, np.uint32, np.uint64):
+        a = num.random.randint(3, 100, size=10000, dtype=dtype)
+        assert a.dtype == dtype
+        assert num.all(a >= 3)
+        assert num.all(a < 100)
+        assert num.any(a != a[0])
+
+    # Ranges wider than the largest value of a signed type
+    info = np.iinfo(np.int64)
+    a = num.random.randint(info.min, info.max, size=10000, dtype=np.int64)
+    assert num.any(a < 0) and num.any(a > 0)
+
+
 if __name__ == "__main__":
     test()
+    test_dtypes()
@@ -0,0 +1,66 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+
+import cunumeric as num
+
+
+def test_reproducible():
+    a = num.random.default_rng(42).random((1001, 37))
+    b = num.random.default_rng(42).random((1001, 37))
+    assert num.array_equal(a, b)
+    assert num.all(a >= 0) and num.all(a < 1)
+
+
+def test_independent():
+    # Consecutive calls and different seeds draw from different counters
+    rng = num.random.default_rng(3)
+    a = rng.random(1000)
+    b = rng.random(1000)
+    c = num.random.default_rng(4).random(1000)
+    assert not num.array_equal(a, b)
+    assert not num.array_equal(a, c)
+
+    # Generators do not move the global epoch or each other
+    num.random.seed(7)
+    x = num.random.rand(1000)
+    first, second = num.random.default_rng(5).spawn(2)
+    s1 = first.standard_normal(1000)
+    second.standard_normal(1000)
+    num.random.seed(7)
+    assert num.array_equal(x, num.random.rand(1000))
+    assert not num.array_equal(s1, second.standard_normal(1000))
+
+
+def test_distributions():
+    rng = num.random.default_rng(11)
+    n = 100000
+    u = rng.uniform(-2, 3, size=n)
+    assert num.all(u >= -2) and num.all(u <= 3)
+    i = rng.integers(5, 10, size=n, dtype=np.int32)
+    assert i.dtype == np.int32
+    assert num.all(i >= 5) and num.all(i < 10)
+    e = rng.exponential(2.0, size=n)
+    assert abs(float(e.mean()) - 2.0) < 0.1
+    p = rng.permutation(1000)
+    assert num.array_equal(num.sort(p), num.arange(1000))
+    assert isinstance(rng.random(), float)
+
+
+if __name__ == "__main__":
+    test_reproducible()
+    test_independent()
+    test_distributions()
@@ -0,0 +1,62 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import sys
+
+import numpy as np
+
+# Recycling is opt-in, so turn it on before the runtime gets initialized
+sys.argv.append("-cunumeric:recycle-stores")
+
+import cunumeric as num  # noqa E402
+
+
+def test():
+    npa = np.random.rand(1000)
+    npb = np.random.rand(1000)
+    npc = np.random.rand(1000)
+    npd = np.random.rand(1000)
+    a = num.array(npa)
+    b = num.array(npb)
+    c = num.array(npc)
+    d = num.array(npd)
+
+    # The temporaries of every iteration reuse the stores of the last one
+    x = num.zeros(1000)
+    npx = np.zeros(1000)
+    for _ in range(20):
+        x = x * 0.5 + (a * b + c * d)
+        npx = npx * 0.5 + (npa * npb + npc * npd)
+    assert np.allclose(x, npx)
+
+    # A recycled store holds nothing of the array it came from
+    y = a + b
+    del y
+    z = num.zeros(1000)
+    assert np.array_equal(z, np.zeros(1000))
+
+    # Stores that were seen through a view are not recycled
+    v = a * 2.0
+    w = v[:500]
+    del v
+    u = num.ones(1000)
+    assert np.allclose(w, 2.0 * npa[:500])
+    assert np.array_equal(u, np.ones(1000))
+
+    return
+
+
+if __name__ == "__main__":
+    test()
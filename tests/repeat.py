@@ -0,0 +1,51 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+
+import cunumeric as num
+
+
+def test_repeat():
+    anp = np.arange(5 * 7 * 3).reshape(5, 7, 3)
+    a = num.array(anp)
+
+    for repeats in [0, 1, 2, 5]:
+        assert np.array_equal(num.repeat(a, repeats), np.repeat(anp, repeats))
+        for axis in range(-3, 3):
+            assert np.array_equal(
+                num.repeat(a, repeats, axis=axis),
+                np.repeat(anp, repeats, axis=axis),
+            )
+
+    assert np.array_equal(a.repeat(3, axis=1), anp.repeat(3, axis=1))
+    assert np.array_equal(num.repeat(num.array(4), 3), np.repeat(4, 3))
+
+
+def test_slices():
+    anp = np.arange(8 * 6).reshape(8, 6)
+    a = num.array(anp)
+
+    assert np.array_equal(
+        num.repeat(a[1:7, ::2], 3, axis=1), np.repeat(anp[1:7, ::2], 3, axis=1)
+    )
+    assert np.array_equal(
+        num.repeat(a[:, 2:5], 4, axis=0), np.repeat(anp[:, 2:5], 4, axis=0)
+    )
+
+
+if __name__ == "__main__":
+    test_repeat()
+    test_slices()
@@ -61,6 +61,33 @@ def test2():
         assert np.array_equal(bnp, b)
 
 
+def test_views_and_copies():
+    anp = np.arange(7 * 9 * 6).reshape(7, 9, 6)
+    a = num.array(anp)
+
+    # Split-only reshapes, merges and mixed cases with odd extents
+    for shape in [
+        (63, 6),
+        (7, 54),
+        (21, 3, 6),
+        (7, 3, 3, 6),
+        (378,),
+        (14, 27),
+        (6, 63),
+        (2, 3, 63),
+        (27, 2, 7),
+    ]:
+        bnp = np.reshape(anp, shape)
+        b = num.reshape(a, shape)
+        assert np.array_equal(bnp, b)
+
+    # Non-contiguous sources
+    bnp = anp[:, 1:8, :].reshape(49, 6)
+    b = a[:, 1:8, :].reshape(49, 6)
+    assert np.array_equal(bnp, b)
+
+
 if __name__ == "__main__":
     test1()
     test2()
+    test_views_and_copies()
@@ -0,0 +1,42 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+
+import cunumeric as num
+
+
+def test_roll():
+    anp = np.arange(7 * 9 * 4).reshape(7, 9, 4)
+    a = num.array(anp)
+
+    for shift, axis in [
+        (3, None),
+        (-5, None),
+        (2, 0),
+        (-1, 1),
+        (13, 2),
+        ((1, 2), (0, 1)),
+        ((3, -2, 5), (0, 1, 2)),
+        ((1, 1), (1, 1)),
+        (0, 2),
+    ]:
+        assert np.array_equal(
+            num.roll(a, shift, axis=axis), np.roll(anp, shift, axis=axis)
+        )
+
+
+if __name__ == "__main__":
+    test_roll()
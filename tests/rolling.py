@@ -0,0 +1,49 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+from numpy.lib.stride_tricks import sliding_window_view
+
+import cunumeric as num
+
+
+def reference(a, window, op, axis):
+    windows = sliding_window_view(a, window, axis=axis)
+    return getattr(np, op)(windows, axis=-1)
+
+
+def test_1d():
+    np.random.seed(0)
+    a = np.random.rand(10007)
+    for window in (1, 3, 64, 1000, 10007):
+        for op in ("sum", "mean", "min", "max"):
+            res = num.rolling(a, window, op=op)
+            assert np.allclose(res, reference(a, window, op, 0))
+
+
+def test_axes():
+    a = np.random.randint(-100, 100, size=(37, 211))
+    for axis in (0, 1, -1):
+        for op in ("sum", "min", "max"):
+            res = num.rolling(a, 10, op=op, axis=axis)
+            assert res.dtype == a.dtype
+            assert np.array_equal(res, reference(a, 10, op, axis))
+        res = num.rolling(a, 10, axis=axis)
+        assert np.allclose(res, reference(a, 10, "mean", axis))
+
+
+if __name__ == "__main__":
+    test_1d()
+    test_axes()
@@ -0,0 +1,44 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+
+import cunumeric as num
+
+# Enough rows of each length to take the warp-per-row and the block-per-row
+# kernels on GPUs
+SHAPES = ((4103, 100), (1100, 1500), (3, 4100, 33))
+
+
+def test_row_reduction():
+    np.random.seed(0)
+    for shape in SHAPES:
+        a = np.random.rand(*shape).astype(np.float32)
+        b = num.array(a)
+        assert np.allclose(b.sum(axis=-1), a.sum(axis=-1), rtol=1e-4)
+        assert np.array_equal(b.max(axis=-1), a.max(axis=-1))
+        assert np.array_equal(b.min(axis=-1), a.min(axis=-1))
+
+        # Rows of a view that are not contiguous in memory
+        assert np.allclose(
+            b[..., 1:-2].sum(axis=-1), a[..., 1:-2].sum(axis=-1), rtol=1e-4
+        )
+
+        c = np.random.randint(-100, 100, shape)
+        assert np.array_equal(num.array(c).sum(axis=-1), c.sum(axis=-1))
+
+
+if __name__ == "__main__":
+    test_row_reduction()
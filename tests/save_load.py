@@ -0,0 +1,50 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+
+import os
+import tempfile
+
+import numpy as np
+
+import cunumeric as num
+
+
+def test():
+    with tempfile.TemporaryDirectory() as root:
+        for anp in (
+            np.random.rand(1000, 37),
+            np.arange(24 * 5 * 7, dtype=np.int32).reshape(24, 5, 7),
+            np.random.rand(3001) > 0.5,
+        ):
+            filename = os.path.join(root, "array.npy")
+
+            # Arrays that cuNumeric saves load with NumPy and the reverse
+            num.save(filename, num.array(anp))
+            assert np.array_equal(np.load(filename), anp)
+            np.save(filename, anp)
+            assert np.array_equal(num.load(filename), anp)
+
+            # Views of arrays, and file names without the extension
+            num.save(os.path.join(root, "view"), num.array(anp)[1:])
+            assert np.array_equal(
+                num.load(os.path.join(root, "view.npy")), anp[1:]
+            )
+
+    return
+
+
+if __name__ == "__main__":
+    test()
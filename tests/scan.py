@@ -0,0 +1,67 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+import numpy as np
+
+import cunumeric as num
+
+
+def test_cumsum():
+    np.random.seed(12)
+    a = np.random.randint(-100, 100, size=100000)
+    b = num.array(a)
+    assert np.array_equal(num.cumsum(b), np.cumsum(a))
+
+    c = np.random.random((30, 40, 50))
+    d = num.array(c)
+    for axis in (None, 0, 1, 2, -1):
+        assert np.allclose(num.cumsum(d, axis=axis), np.cumsum(c, axis=axis))
+
+    e = np.random.randint(0, 2, size=(100, 20)).astype(np.bool_)
+    f = num.array(e)
+    assert np.array_equal(f.cumsum(axis=0), e.cumsum(axis=0))
+
+
+def test_cumprod():
+    np.random.seed(13)
+    a = np.random.uniform(0.9, 1.1, size=(60, 500))
+    b = num.array(a)
+    for axis in (0, 1):
+        assert np.allclose(b.cumprod(axis=axis), a.cumprod(axis=axis))
+
+    out = num.zeros(a.size)
+    num.cumprod(b, out=out)
+    assert np.allclose(out, np.cumprod(a))
+
+
+def test_accumulate():
+    np.random.seed(14)
+    a = np.random.randint(-1000, 1000, size=(200, 300))
+    b = num.array(a)
+    for axis in (0, 1):
+        assert np.array_equal(
+            num.maximum.accumulate(b, axis=axis),
+            np.maximum.accumulate(a, axis=axis),
+        )
+        assert np.array_equal(
+            num.minimum.accumulate(b, axis=axis),
+            np.minimum.accumulate(a, axis=axis),
+        )
+    assert np.array_equal(num.add.accumulate(b), np.add.accumulate(a))
+
+
+if __name__ == "__main__":
+    test_cumsum()
+    test_cumprod()
+    test_accumulate()
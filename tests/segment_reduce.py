@@ -0,0 +1,96 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+import numpy as np
+
+import cunumeric as num
+
+def identity(op, dtype):
+    if op == "sum":
+        return 0
+    if op == "prod":
+        return 1
+    if dtype.kind == "f":
+        return np.inf if op == "min" else -np.inf
+    info = np.iinfo(dtype)
+    return info.max if op == "min" else info.min
+
+
+UFUNCS = {
+    "sum": np.add,
+    "prod": np.multiply,
+    "min": np.minimum,
+    "max": np.maximum,
+}
+
+
+def segment_reduce(values, labels, k, op):
+    if op == "mean":
+        sums = segment_reduce(values.astype(np.float64), labels, k, "sum")
+        counts = np.bincount(labels, minlength=k).astype(np.float64)
+        with np.errstate(invalid="ignore"):
+            return sums / counts.reshape((k,) + (1,) * (values.ndim - 1))
+    out = np.full((k,) + values.shape[1:], identity(op, values.dtype))
+    out = out.astype(values.dtype)
+    UFUNCS[op].at(out, labels, values)
+    return out
+
+
+def test(n):
+    for dtype in [np.float64, np.float32, np.int64, np.int32]:
+        for (d, k) in [(None, 5), (1, 1), (3, 10), (16, 300)]:
+            print(dtype, d, k)
+            shape = (n,) if d is None else (n, d)
+            values_np = (np.random.rand(*shape) * 10).astype(dtype)
+            labels_np = np.random.randint(0, k, size=n)
+            values_num = num.array(values_np)
+            labels_num = num.array(labels_np)
+            for op in ["sum", "min", "max", "mean"]:
+                out = num.segment_reduce(values_num, labels_num, k, op=op)
+                expected = segment_reduce(values_np, labels_np, k, op)
+                assert out.shape == expected.shape
+                assert num.allclose(out, expected, rtol=1e-4)
+
+    # Products of values near one stay well within range
+    values_np = 1 + np.random.rand(n, 4) / n
+    labels_np = np.random.randint(0, 7, size=n)
+    values_num = num.array(values_np)
+    out = num.segment_reduce(values_num, num.array(labels_np), 7, "prod")
+    assert num.allclose(out, segment_reduce(values_np, labels_np, 7, "prod"))
+
+    # The number of segments defaults to one more than the largest label,
+    # and labels without rows get the identity
+    labels_np = np.array([0, 4, 4, 0])
+    values_np = np.arange(8, dtype=np.float64).reshape(4, 2)
+    out = num.segment_reduce(num.array(values_np), num.array(labels_np))
+    assert num.array_equal(out, segment_reduce(values_np, labels_np, 5, "sum"))
+
+    # The means of the clusters of k-means assignments are its update step
+    points = np.random.rand(n, 3)
+    centroids = np.random.rand(8, 3)
+    labels, sums, counts, _ = num.kmeans_assign(
+        num.array(points), num.array(centroids), return_sums=True
+    )
+    means = num.segment_reduce(num.array(points), labels, 8, op="mean")
+    counts = np.asarray(counts)[:, np.newaxis]
+    nonempty = counts[:, 0] > 0
+    assert num.allclose(
+        np.asarray(means)[nonempty], (np.asarray(sums) / counts)[nonempty]
+    )
+
+    return
+
+
+if __name__ == "__main__":
+    test(10000)
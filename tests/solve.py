@@ -0,0 +1,96 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+
+import numpy as np
+
+import cunumeric as num
+
+
+def test_real(n, nrhs):
+    a = np.random.rand(n, n) + np.eye(n) * n
+    b = np.random.rand(n, nrhs)
+    x = num.linalg.solve(num.array(a), num.array(b))
+    assert num.allclose(x, np.linalg.solve(a, b))
+
+    x = num.linalg.solve(num.array(a), num.array(b[:, 0]))
+    assert num.allclose(x, np.linalg.solve(a, b[:, 0]))
+
+
+def test_complex(n, nrhs):
+    a = np.random.rand(n, n) + np.random.rand(n, n) * 1.0j
+    a += np.eye(n) * n
+    b = np.random.rand(n, nrhs) + np.random.rand(n, nrhs) * 1.0j
+    x = num.linalg.solve(num.array(a), num.array(b))
+    assert num.allclose(x, np.linalg.solve(a, b))
+
+
+def test_pivoting(n):
+    # Reversing the rows moves the dominant diagonal onto the anti-diagonal,
+    # so the factorization only stays stable with row interchanges
+    a = (np.random.rand(n, n) + np.eye(n) * n)[::-1].copy()
+    b = np.random.rand(n)
+    x = num.linalg.solve(num.array(a), num.array(b))
+    assert num.allclose(x, np.linalg.solve(a, b))
+
+
+def test_inv(n):
+    a = np.random.rand(n, n) + np.eye(n) * n
+    assert num.allclose(num.linalg.inv(num.array(a)), np.linalg.inv(a))
+
+    a = np.random.randint(1, 10, size=(n, n)) + np.eye(n, dtype=int) * 10 * n
+    assert num.allclose(num.linalg.inv(num.array(a)), np.linalg.inv(a))
+
+
+def test_batched(batch, n):
+    a = np.random.rand(batch, n, n) + np.eye(n) * n
+    b = np.random.rand(batch, n, 3)
+    x = num.linalg.solve(num.array(a), num.array(b))
+    assert num.allclose(x, np.linalg.solve(a, b))
+
+    x = num.linalg.solve(num.array(a), num.array(b[..., 0]))
+    assert x.shape == (batch, n)
+    assert num.allclose(x, np.linalg.solve(a, b[..., 0]))
+
+    # Reversed rows need pivoting, as in test_pivoting
+    a_rev = a[:, ::-1].copy()
+    x = num.linalg.solve(num.array(a_rev), num.array(b))
+    assert num.allclose(x, np.linalg.solve(a_rev, b))
+
+    assert num.allclose(num.linalg.inv(num.array(a)), np.linalg.inv(a))
+
+    spd = a @ np.swapaxes(a, -1, -2)
+    x = num.linalg.cholesky_solve(num.array(spd), num.array(b))
+    assert num.allclose(x, np.linalg.solve(spd, b))
+
+    # More than one batch dimension
+    a4 = a.reshape((2, batch // 2, n, n))
+    b4 = b.reshape((2, batch // 2, n, 3))
+    x = num.linalg.solve(num.array(a4), num.array(b4))
+    assert num.allclose(x, np.linalg.solve(a4, b4))
+
+
+def test():
+    for n in [8, 9, 255, 512]:
+        test_real(n, 3)
+        test_complex(n, 5)
+        test_pivoting(n)
+        test_inv(n)
+    for n in [1, 3, 5, 8, 17, 32, 33]:
+        test_batched(10, n)
+
+
+if __name__ == "__main__":
+    test()
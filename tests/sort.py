@@ -0,0 +1,101 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+import numpy as np
+
+import cunumeric as num
+
+
+def test_sort():
+    np.random.seed(8)
+    a = np.random.random(100000)
+    a[::97] = np.nan
+    b = num.array(a)
+    assert np.array_equal(num.sort(b), np.sort(a), equal_nan=True)
+
+    c = np.random.randint(0, 50, size=(30, 40, 20))
+    d = num.array(c)
+    for axis in (None, 0, 1, -1):
+        assert np.array_equal(num.sort(d, axis=axis), np.sort(c, axis=axis))
+    d.sort(axis=1)
+    c.sort(axis=1)
+    assert np.array_equal(d, c)
+
+
+def test_argsort():
+    np.random.seed(9)
+    # Many ties check that the sort is stable
+    a = np.random.randint(0, 100, size=100000)
+    b = num.array(a)
+    assert np.array_equal(num.argsort(b), np.argsort(a, kind="stable"))
+
+    c = np.random.random((50, 60))
+    d = num.array(c)
+    for axis in (0, 1):
+        assert np.array_equal(d.argsort(axis=axis), c.argsort(axis=axis))
+
+
+def test_unique():
+    np.random.seed(10)
+    a = np.random.randint(0, 1000, size=(200, 300))
+    assert np.array_equal(num.unique(num.array(a)), np.unique(a))
+
+    c = np.array([3.0, np.nan, 1.0, 3.0, np.nan])
+    assert np.array_equal(
+        num.unique(num.array(c)), np.unique(c), equal_nan=True
+    )
+
+
+def test_unique_counts():
+    np.random.seed(12)
+    a = np.random.randint(-5, 5, size=100000)
+    values, counts = num.unique(num.array(a), return_counts=True)
+    expected_values, expected_counts = np.unique(a, return_counts=True)
+    assert np.array_equal(values, expected_values)
+    assert np.array_equal(counts, expected_counts)
+
+    # Negative zero and every NaN count as one value each
+    b = np.array([0.0, -0.0, np.nan, 2.5, -np.nan, 2.5])
+    values, counts = num.unique(num.array(b), return_counts=True)
+    assert np.array_equal(values, [0.0, 2.5, np.nan], equal_nan=True)
+    assert np.array_equal(counts, [2, 2, 2])
+
+
+def test_searchsorted():
+    np.random.seed(11)
+    a = np.sort(np.random.randint(0, 100, size=1000))
+    v = np.random.randint(-10, 110, size=(20, 30))
+    b = num.array(a)
+    for side in ("left", "right"):
+        assert np.array_equal(
+            num.searchsorted(b, num.array(v), side=side),
+            np.searchsorted(a, v, side=side),
+        )
+    assert num.searchsorted(b, 50) == np.searchsorted(a, 50)
+
+    order = np.random.permutation(1000)
+    c = a[order]
+    sorter = np.argsort(c, kind="stable")
+    assert np.array_equal(
+        num.searchsorted(num.array(c), num.array(v), sorter=sorter),
+        np.searchsorted(c, v, sorter=sorter),
+    )
+
+
+if __name__ == "__main__":
+    test_sort()
+    test_argsort()
+    test_unique()
+    test_unique_counts()
+    test_searchsorted()
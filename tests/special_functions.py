@@ -0,0 +1,69 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import math
+
+import numpy as np
+
+import cunumeric as num
+
+_erf = np.vectorize(math.erf, otypes=[np.float64])
+
+
+def _sigmoid(x):
+    with np.errstate(over="ignore"):
+        return 1.0 / (1.0 + np.exp(-x))
+
+
+def test():
+    np.random.seed(5)
+    xn = np.random.uniform(-6, 6, 10000)
+    references = {
+        "erf": _erf,
+        "expm1": np.expm1,
+        "sigmoid": _sigmoid,
+        "softplus": lambda x: np.logaddexp(0, x),
+    }
+    for dtype in (np.float32, np.float64):
+        x = num.array(xn.astype(dtype))
+        for name, reference in references.items():
+            y = getattr(num, name)(x)
+            assert y.dtype == dtype
+            assert np.allclose(y, reference(xn), rtol=1e-5, atol=1e-6)
+        y = num.log1p(num.abs(x))
+        assert y.dtype == dtype
+        assert np.allclose(y, np.log1p(np.abs(xn)), rtol=1e-5)
+
+    # Small arguments keep their accuracy
+    tiny = np.array([1e-10, -1e-12, 3e-15] * 1000)
+    assert np.allclose(num.expm1(num.array(tiny)), tiny, rtol=1e-12)
+    assert np.allclose(num.log1p(num.array(tiny)), tiny, rtol=1e-12)
+
+    # Large arguments saturate instead of overflowing
+    large = np.array([-1000.0, 1000.0] * 1000)
+    assert np.array_equal(num.sigmoid(num.array(large)), _sigmoid(large))
+    assert np.array_equal(num.softplus(num.array(large)), np.maximum(large, 0))
+
+    # Integers compute in double precision
+    ints = np.arange(-50, 50)
+    y = num.erf(num.array(ints))
+    assert y.dtype == np.float64
+    assert np.allclose(y, _erf(ints))
+
+    return
+
+
+if __name__ == "__main__":
+    test()
@@ -0,0 +1,103 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+
+import cunumeric as num
+
+
+def reference(a, offsets, coefficients):
+    result = a.copy()
+    halo = [
+        (max(0, -min(shifts)), max(0, max(shifts)))
+        for shifts in zip(*offsets)
+    ]
+    interior = tuple(
+        slice(lo, extent - hi) for (lo, hi), extent in zip(halo, a.shape)
+    )
+    acc = np.zeros_like(result[interior])
+    for offset, coefficient in zip(offsets, coefficients):
+        acc += coefficient * a[
+            tuple(
+                slice(lo + shift, extent - hi + shift)
+                for (lo, hi), extent, shift in zip(halo, a.shape, offset)
+            )
+        ]
+    result[interior] = acc
+    return result
+
+
+def check(shape, offsets, coefficients):
+    anp = np.random.rand(*shape)
+    a = num.array(anp)
+    bnp = reference(anp, offsets, coefficients)
+    b = num.stencil(a, offsets, coefficients)
+    assert np.allclose(bnp, b)
+
+
+def test_1d():
+    check((100,), ((-1,), (0,), (1,)), (0.25, 0.5, 0.25))
+    check((50,), ((-2,), (0,), (3,)), (1.0, -2.0, 0.5))
+
+
+def test_2d():
+    offsets = ((0, 0), (-1, 0), (0, 1), (0, -1), (1, 0))
+    check((40, 30), offsets, (0.2,) * 5)
+    offsets = tuple((i, j) for i in range(-1, 2) for j in range(-1, 2))
+    check((33, 65), offsets, tuple(range(9)))
+
+
+def test_3d():
+    offsets = (
+        (0, 0, 0),
+        (-1, 0, 0),
+        (1, 0, 0),
+        (0, -1, 0),
+        (0, 1, 0),
+        (0, 0, -1),
+        (0, 0, 1),
+    )
+    check((12, 10, 14), offsets, (-6.0,) + (1.0,) * 6)
+
+
+def test_double_buffering():
+    offsets = ((0, 0), (-1, 0), (0, 1), (0, -1), (1, 0))
+    coefficients = (0.2,) * 5
+    anp = np.random.rand(20, 20)
+    a = num.array(anp)
+    b = num.empty_like(a)
+    for _ in range(10):
+        anp = reference(anp, offsets, coefficients)
+        num.stencil(a, offsets, coefficients, out=b)
+        a, b = b, a
+    assert np.allclose(anp, a)
+
+
+def test_in_place():
+    offsets = ((-1,), (1,))
+    coefficients = (0.5, 0.5)
+    anp = np.random.rand(64)
+    a = num.array(anp)
+    bnp = reference(anp, offsets, coefficients)
+    num.stencil(a, offsets, coefficients, out=a)
+    assert np.allclose(bnp, a)
+
+
+if __name__ == "__main__":
+    test_1d()
+    test_2d()
+    test_3d()
+    test_double_buffering()
+    test_in_place()
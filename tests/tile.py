@@ -13,6 +13,8 @@
 # limitations under the License.
 #
 
+import numpy as np
+
 import cunumeric as num
 
 
@@ -53,5 +55,32 @@ def test():
     return
 
 
+def test_replication():
+    # Long rows get replicated from the output
+    npa = np.arange(7)
+    a = num.array(npa)
+    for reps in (1, 2, 3, 100, (5, 33), (2, 3, 17)):
+        assert np.array_equal(num.tile(a, reps), np.tile(npa, reps))
+
+    npb = np.random.rand(3, 5)
+    b = num.array(npb)
+    for reps in ((4, 9), (2, 1, 3)):
+        assert np.array_equal(num.tile(b, reps), np.tile(npb, reps))
+
+    # Repeating dimensions of a single element is a broadcast
+    npc = np.random.rand(1, 6)
+    c = num.array(npc)
+    for reps in ((10, 1), (3, 10, 1), 1):
+        assert np.array_equal(num.tile(c, reps), np.tile(npc, reps))
+
+    # The result does not alias the source
+    d = num.tile(c, (4, 1))
+    d[0, 0] = -1.0
+    assert np.array_equal(c, npc)
+
+    return
+
+
 if __name__ == "__main__":
     test()
+    test_replication()
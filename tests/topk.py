@@ -0,0 +1,60 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+
+import numpy as np
+
+import cunumeric as num
+
+
+def check(anp, k, axis, largest):
+    values, indices = num.topk(num.array(anp), k, axis=axis, largest=largest)
+    flat = anp.ravel() if axis is None else anp
+    ax = -1 if axis is None else axis
+    order = np.sort(flat, axis=ax)
+    if largest:
+        order = np.flip(order, ax)
+    expected = np.take(order, np.arange(k), axis=ax)
+    assert np.array_equal(values, expected)
+    assert np.array_equal(
+        np.take_along_axis(flat, np.array(indices), axis=ax), expected
+    )
+
+
+def test():
+    anp = np.random.randn(37, 53)
+    for k in (1, 5, 37):
+        for largest in (True, False):
+            check(anp, k, 0, largest)
+            check(anp, k, 1, largest)
+            check(anp, k, None, largest)
+
+    # Ties are broken in favor of the lower index
+    bnp = np.random.randint(0, 4, size=(6, 1000)).astype(np.int32)
+    values, indices = num.topk(bnp, 3, axis=1)
+    for row in range(bnp.shape[0]):
+        top = np.argsort(-bnp[row], kind="stable")[:3]
+        assert np.array_equal(indices[row], top)
+    check(bnp, 10, None, False)
+
+    cnp = np.random.randn(4, 5, 200).astype(np.float32)
+    check(cnp, 7, -1, True)
+    check(cnp, 3, 1, False)
+
+    return
+
+
+if __name__ == "__main__":
+    test()
@@ -13,6 +13,8 @@
 # limitations under the License.
 #
 
+import numpy as np
+
 import cunumeric as num
 
 
@@ -28,6 +30,22 @@ def test():
     assert num.array_equal(y, [[1, 4, 7], [2, 5, 8], [3, 6, 9]])
     z = num.transpose(y)
     assert num.array_equal(x, z)
+
+    # Materialized permutations of 3-D and 4-D tensors, with tiles that do
+    # not divide the extents
+    anp = np.random.randn(5, 37, 70)
+    a = num.array(anp)
+    for axes in ((0, 2, 1), (2, 1, 0), (1, 0, 2), (2, 0, 1)):
+        assert num.array_equal(
+            a.transpose(axes).copy(), anp.transpose(axes).copy()
+        )
+    bnp = np.arange(3 * 4 * 33 * 40).reshape(3, 4, 33, 40)
+    b = num.array(bnp)
+    for axes in ((0, 1, 3, 2), (3, 2, 1, 0), (1, 3, 0, 2)):
+        assert num.array_equal(
+            num.transpose(b, axes).copy(), np.transpose(bnp, axes).copy()
+        )
+    assert num.array_equal(b.swapaxes(1, 3).copy(), bnp.swapaxes(1, 3))
     return
 
 
@@ -0,0 +1,117 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+
+import numpy as np
+
+import cunumeric as num
+
+
+def test_outer():
+    np.random.seed(15)
+    a = np.random.randint(-50, 50, size=(30,))
+    b = np.random.randint(-50, 50, size=(20, 10))
+    x = num.array(a)
+    y = num.array(b)
+    assert np.array_equal(num.add.outer(x, y), np.add.outer(a, b))
+    assert np.array_equal(num.multiply.outer(y, x), np.multiply.outer(b, a))
+    assert np.array_equal(num.maximum.outer(x, x), np.maximum.outer(a, a))
+    assert np.array_equal(num.less.outer(x, y), np.less.outer(a, b))
+
+    out = num.zeros((30, 30))
+    num.true_divide.outer(x + 100, x + 100, out=out)
+    assert np.allclose(out, np.true_divide.outer(a + 100, a + 100))
+
+
+def test_reduce_where():
+    np.random.seed(16)
+    a = np.random.randint(-100, 100, size=(40, 50))
+    mask = np.random.randint(0, 2, size=(40, 50)).astype(np.bool_)
+    b = num.array(a)
+    m = num.array(mask)
+    for axis in (None, 0, 1):
+        assert np.array_equal(
+            num.add.reduce(b, axis=axis, where=m),
+            np.add.reduce(a, axis=axis, where=mask),
+        )
+        assert np.array_equal(
+            num.maximum.reduce(b, axis=axis, initial=-1000, where=m),
+            np.maximum.reduce(a, axis=axis, initial=-1000, where=mask),
+        )
+        assert np.array_equal(
+            num.minimum.reduce(b, axis=axis, initial=1000, where=m),
+            np.minimum.reduce(a, axis=axis, initial=1000, where=mask),
+        )
+
+    # Masks that broadcast against the source
+    assert np.array_equal(
+        num.multiply.reduce(b % 3 + 1, axis=0, where=m[0]),
+        np.multiply.reduce(a % 3 + 1, axis=0, where=mask[0]),
+    )
+    assert np.array_equal(
+        num.sum(b, axis=1, initial=7, where=m[:, :1]),
+        np.sum(a, axis=1, initial=7, where=mask[:, :1]),
+    )
+
+
+def test_out_where():
+    np.random.seed(17)
+    a = np.random.random((40, 50))
+    b = np.random.random((40, 50))
+    mask = np.random.randint(0, 2, size=(40, 50)).astype(np.bool_)
+    x = num.array(a)
+    y = num.array(b)
+    m = num.array(mask)
+
+    out_np = np.full((40, 50), -1.0)
+    out_num = num.full((40, 50), -1.0)
+    np.add(a, b, out=out_np, where=mask)
+    num.add(x, y, out=out_num, where=m)
+    assert np.array_equal(out_num, out_np)
+
+    # Scalar operands, masks that broadcast and in-place updates
+    np.multiply(a, 3.0, out=out_np, where=mask[0])
+    num.multiply(x, 3.0, out=out_num, where=m[0])
+    assert np.array_equal(out_num, out_np)
+    np.add(out_np, b, out=out_np, where=mask)
+    num.add(out_num, y, out=out_num, where=m)
+    assert np.array_equal(out_num, out_np)
+
+    np.sqrt(a, out=out_np, where=mask)
+    num.sqrt(x, out=out_num, where=m)
+    assert np.array_equal(out_num, out_np)
+    np.negative(out_np, out=out_np, where=mask)
+    num.negative(out_num, out=out_num, where=m)
+    assert np.array_equal(out_num, out_np)
+
+    # An output of another type keeps its values outside of the mask as well
+    c = np.random.randint(0, 100, size=(40, 50))
+    z = num.array(c)
+    out_np = np.zeros((40, 50))
+    out_num = num.zeros((40, 50))
+    np.add(c, c, out=out_np, where=mask)
+    num.add(z, z, out=out_num, where=m)
+    assert np.array_equal(out_num, out_np)
+    np.true_divide(out_np, 3, out=out_np)
+    num.true_divide(out_num, 3, out=out_num)
+    np.add(c, 1, out=out_np, where=mask[:, :1])
+    num.add(z, 1, out=out_num, where=m[:, :1])
+    assert np.array_equal(out_num, out_np)
+
+
+if __name__ == "__main__":
+    test_outer()
+    test_reduce_where()
+    test_out_where()
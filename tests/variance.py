@@ -0,0 +1,53 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+
+import numpy as np
+
+import cunumeric as num
+
+
+def test():
+    # A large offset cancels catastrophically in sum(x * x) - sum(x) ** 2 / n
+    anp = (1e4 + np.random.randn(1000, 100)).astype(np.float32)
+    a = num.array(anp)
+    expected = anp.astype(np.float64).var()
+    assert np.allclose(a.var(), expected, rtol=1e-3)
+    for axis in (0, 1):
+        assert np.allclose(
+            a.var(axis=axis),
+            anp.astype(np.float64).var(axis=axis),
+            rtol=1e-3,
+        )
+
+    bnp = np.random.randn(64, 32)
+    b = num.array(bnp)
+    for ddof in (0, 1, 5):
+        assert np.allclose(b.var(ddof=ddof), bnp.var(ddof=ddof))
+        assert np.allclose(
+            b.var(axis=1, ddof=ddof, keepdims=True),
+            bnp.var(axis=1, ddof=ddof, keepdims=True),
+        )
+
+    hnp = np.random.randn(100).astype(np.float16)
+    h = num.array(hnp)
+    assert h.var().dtype == np.float16
+    assert np.allclose(h.var(), hnp.var(), rtol=1e-2)
+
+    return
+
+
+if __name__ == "__main__":
+    test()
@@ -64,5 +64,36 @@ def test():
     assert np.array_equal(np.where(anp, xnp, ynp), num.where(a, x, y))
 
 
+def test_scalar_branches():
+    anp = np.array([[True, False, True], [False, False, True]])
+    xnp = np.array([[1.0, 2.0, 3.0], [4.0, 5.0, 6.0]])
+    a = num.array(anp)
+    x = num.array(xnp)
+    assert np.array_equal(np.where(anp, xnp, 0.0), num.where(a, x, 0.0))
+    assert np.array_equal(np.where(anp, -1.0, xnp), num.where(a, -1.0, x))
+    assert np.array_equal(np.where(anp, 1.0, 0.0), num.where(a, 1.0, 0.0))
+
+
+def test_putmask():
+    anp = np.arange(12.0).reshape(3, 4)
+    mnp = anp % 3 == 0
+    a = num.array(anp)
+    m = num.array(mnp)
+
+    np.putmask(anp, mnp, -anp)
+    num.putmask(a, m, -a)
+    assert np.array_equal(anp, a)
+
+    np.putmask(anp, mnp, 7.0)
+    num.putmask(a, m, 7.0)
+    assert np.array_equal(anp, a)
+
+    anp[mnp] = 2.0
+    a[m] = 2.0
+    assert np.array_equal(anp, a)
+
+
 if __name__ == "__main__":
     test()
+    test_scalar_branches()
+    test_putmask()
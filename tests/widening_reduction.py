@@ -0,0 +1,67 @@
+# Copyright 2021 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+
+import cunumeric as num
+
+
+def test():
+    npu8 = np.random.randint(0, 256, size=(40, 50)).astype(np.uint8)
+    npu16 = np.random.randint(0, 65536, size=(40, 50)).astype(np.uint16)
+    u8 = num.array(npu8)
+    u16 = num.array(npu16)
+
+    # Sums that would overflow the type of the input
+    for dtype in (np.int32, np.int64, np.uint64, np.float32, np.float64):
+        assert np.allclose(
+            u8.sum(dtype=dtype), npu8.sum(dtype=dtype), rtol=1e-5
+        )
+        assert np.allclose(
+            u16.sum(dtype=dtype), npu16.sum(dtype=dtype), rtol=1e-5
+        )
+        assert np.allclose(
+            num.sum(u16, axis=0, dtype=dtype),
+            np.sum(npu16, axis=0, dtype=dtype),
+            rtol=1e-5,
+        )
+        assert np.allclose(
+            num.sum(u8, axis=1, dtype=dtype),
+            np.sum(npu8, axis=1, dtype=dtype),
+            rtol=1e-5,
+        )
+
+    # Into an output array of a wider type
+    out = num.zeros(50, dtype=np.float32)
+    num.sum(u16, axis=0, out=out)
+    assert np.allclose(out, np.sum(npu16, axis=0, dtype=np.float32))
+
+    # Products of small values
+    npsmall = np.random.randint(1, 3, size=(4, 10)).astype(np.uint8)
+    small = num.array(npsmall)
+    assert np.array_equal(
+        small.prod(axis=1, dtype=np.int64),
+        npsmall.prod(axis=1, dtype=np.int64),
+    )
+
+    # Means accumulate in float64
+    assert np.allclose(u16.mean(), npu16.mean())
+    assert np.allclose(u8.mean(axis=0), npu8.mean(axis=0))
+
+    return
+
+
+if __name__ == "__main__":
+    test()